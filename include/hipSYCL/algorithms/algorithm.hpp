@@ -23,8 +23,13 @@
 #include "hipSYCL/sycl/queue.hpp"
 #include "util/traits.hpp"
 #include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/util/index_space.hpp"
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
 #include "hipSYCL/algorithms/sort/bitonic_sort.hpp"
+#include "hipSYCL/algorithms/sort/radix_sort.hpp"
+#include "hipSYCL/algorithms/sort/radix_select.hpp"
+#include "hipSYCL/algorithms/sort/merge_sort.hpp"
+#include "hipSYCL/algorithms/scan/decoupled_lookback_scan.hpp"
 
 namespace hipsycl::algorithms {
 
@@ -71,6 +76,189 @@ inline bool should_use_memset(const sycl::device& dev) {
   return true;
 }
 
+// Number of elements that are processed together by packet kernels, such
+// that neither the access to an element of T nor of U exceeds 128 bits.
+// 1 if the types cannot be accessed in packets.
+template<class T, class U = T>
+constexpr std::size_t packet_size_for() {
+  if constexpr (std::is_trivially_copyable_v<T> &&
+                std::is_trivially_copyable_v<U> &&
+                std::is_default_constructible_v<U>) {
+    return std::min(util::max_packet_size<T>(), util::max_packet_size<U>());
+  } else {
+    return 1;
+  }
+}
+
+constexpr std::size_t packet_kernel_group_size = 128;
+
+template <std::size_t N, class T>
+sycl::event fill_packets(sycl::queue &q, T *ptr, std::size_t size,
+                         const T &value) {
+  using packet_type = util::packet<T, N>;
+  packet_type p;
+  for(std::size_t i = 0; i < N; ++i)
+    p.elements[i] = value;
+
+  const std::size_t group_size = packet_kernel_group_size;
+  util::data_streamer streamer{q.get_device(),
+                               std::max(size / N, std::size_t{1}), group_size};
+  return q.parallel_for(
+      sycl::nd_range<1>{streamer.get_required_global_size(), group_size},
+      [=](sycl::nd_item<1> idx) {
+        util::data_streamer::run_packets<N>(
+            size, idx,
+            [&](sycl::id<1> i) {
+              *reinterpret_cast<packet_type *>(ptr + i[0]) = p;
+            },
+            [&](sycl::id<1> i) { ptr[i[0]] = value; });
+      });
+}
+
+template <std::size_t N, class T, class U, class UnaryOperation>
+sycl::event transform_packets(sycl::queue &q, const T *input, U *output,
+                              std::size_t size, UnaryOperation op) {
+  using input_packet = util::packet<T, N>;
+  using output_packet = util::packet<U, N>;
+
+  const std::size_t group_size = packet_kernel_group_size;
+  util::data_streamer streamer{q.get_device(),
+                               std::max(size / N, std::size_t{1}), group_size};
+  return q.parallel_for(
+      sycl::nd_range<1>{streamer.get_required_global_size(), group_size},
+      [=](sycl::nd_item<1> idx) {
+        util::data_streamer::run_packets<N>(
+            size, idx,
+            [&](sycl::id<1> i) {
+              input_packet in =
+                  *reinterpret_cast<const input_packet *>(input + i[0]);
+              output_packet out;
+              for (std::size_t j = 0; j < N; ++j)
+                out.elements[j] = op(in.elements[j]);
+              *reinterpret_cast<output_packet *>(output + i[0]) = out;
+            },
+            [&](sycl::id<1> i) { output[i[0]] = op(input[i[0]]); });
+      });
+}
+
+template <std::size_t N, class T1, class T2, class U, class BinaryOperation>
+sycl::event transform_packets(sycl::queue &q, const T1 *input1,
+                              const T2 *input2, U *output, std::size_t size,
+                              BinaryOperation op) {
+  using input1_packet = util::packet<T1, N>;
+  using input2_packet = util::packet<T2, N>;
+  using output_packet = util::packet<U, N>;
+
+  const std::size_t group_size = packet_kernel_group_size;
+  util::data_streamer streamer{q.get_device(),
+                               std::max(size / N, std::size_t{1}), group_size};
+  return q.parallel_for(
+      sycl::nd_range<1>{streamer.get_required_global_size(), group_size},
+      [=](sycl::nd_item<1> idx) {
+        util::data_streamer::run_packets<N>(
+            size, idx,
+            [&](sycl::id<1> i) {
+              input1_packet in1 =
+                  *reinterpret_cast<const input1_packet *>(input1 + i[0]);
+              input2_packet in2 =
+                  *reinterpret_cast<const input2_packet *>(input2 + i[0]);
+              output_packet out;
+              for (std::size_t j = 0; j < N; ++j)
+                out.elements[j] = op(in1.elements[j], in2.elements[j]);
+              *reinterpret_cast<output_packet *>(output + i[0]) = out;
+            },
+            [&](sycl::id<1> i) {
+              output[i[0]] = op(input1[i[0]], input2[i[0]]);
+            });
+      });
+}
+
+
+// Work group shape for multi-dimensional index spaces: Consecutive work items
+// process consecutive elements of the fastest dimension, while the remaining
+// work items of the group are spread over the next dimensions such that
+// accesses to neighboring rows or planes can share caches.
+template<int Dim>
+sycl::range<Dim> get_index_space_group_shape(const sycl::range<Dim>& extents) {
+  constexpr std::size_t group_size = 256;
+  constexpr std::size_t max_row_size = 32;
+  constexpr std::size_t max_middle_size = 4;
+
+  auto round_down_pow2 = [](std::size_t x) {
+    std::size_t result = 1;
+    while(result * 2 <= x)
+      result *= 2;
+    return result;
+  };
+
+  sycl::range<Dim> shape;
+  std::size_t remaining = group_size;
+  for(int d = Dim - 1; d >= 0; --d) {
+    std::size_t max_size = remaining;
+    if(d == Dim - 1)
+      max_size = std::min(max_size, max_row_size);
+    else if(d > 0)
+      max_size = std::min(max_size, max_middle_size);
+    shape[d] = round_down_pow2(std::min(max_size, extents[d]));
+    remaining /= shape[d];
+  }
+  return shape;
+}
+
+template <int Dim, class ForwardIt, class UnaryFunction2>
+sycl::event for_each_in_index_space(sycl::queue &q, ForwardIt first,
+                                    const sycl::range<Dim> &extents,
+                                    UnaryFunction2 f) {
+  using traits = util::index_space_traits<ForwardIt>;
+  auto origin = *first;
+
+  // The OpenMP backend distributes basic parallel_for over threads in
+  // contiguous chunks already, and work groups only add overhead.
+  if(q.get_device().get_backend() == sycl::backend::omp) {
+    return q.parallel_for(extents, [=](sycl::id<Dim> idx) {
+      auto element = traits::get_element(origin, idx);
+      f(element);
+    });
+  }
+
+  sycl::range<Dim> group_shape = get_index_space_group_shape(extents);
+  sycl::range<Dim> global_size = extents;
+  for(int d = 0; d < Dim; ++d)
+    global_size[d] =
+        (extents[d] + group_shape[d] - 1) / group_shape[d] * group_shape[d];
+
+  return q.parallel_for(sycl::nd_range<Dim>{global_size, group_shape},
+                        [=](sycl::nd_item<Dim> item) {
+                          sycl::id<Dim> idx = item.get_global_id();
+                          for(int d = 0; d < Dim; ++d)
+                            if(idx[d] >= extents[d])
+                              return;
+                          auto element = traits::get_element(origin, idx);
+                          f(element);
+                        });
+}
+
+// Offloads for_each over multi-dimensional index spaces, e.g. for loops over
+// std::views::cartesian_product of iota views, as multi-dimensional kernel.
+// Returns false if [first, first + n) is not such an index space.
+template <class ForwardIt, class UnaryFunction2>
+bool try_for_each_in_index_space(sycl::queue &q, ForwardIt first,
+                                 std::size_t n, UnaryFunction2 f,
+                                 sycl::event &evt) {
+  constexpr int Dim = util::index_space_traits<ForwardIt>::dimensions;
+  if constexpr (Dim > 1) {
+    sycl::range<Dim> extents;
+    auto last = first;
+    std::advance(last, n);
+    if(!util::get_index_space_extents(first, last, extents))
+      return false;
+    evt = for_each_in_index_space(q, first, extents, f);
+    return true;
+  } else {
+    return false;
+  }
+}
+
 }
 
 template <class ForwardIt, class UnaryFunction2>
@@ -78,6 +266,10 @@ sycl::event for_each(sycl::queue &q, ForwardIt first, ForwardIt last,
                      UnaryFunction2 f) {
   if(first == last)
     return sycl::event{};
+  sycl::event evt;
+  if (detail::try_for_each_in_index_space(q, first,
+                                          std::distance(first, last), f, evt))
+    return evt;
   return q.parallel_for(sycl::range{std::distance(first, last)},
                         [=](sycl::id<1> id) {
                           auto it = first;
@@ -94,6 +286,10 @@ sycl::event for_each_n(sycl::queue& q,
     // This means it does not respect prior tasks in the task graph!
     // TODO Is this okay? Can we defer this responsibility to the user?
     return sycl::event{};
+  sycl::event evt;
+  if (detail::try_for_each_in_index_space(q, first, static_cast<size_t>(n),
+                                          f, evt))
+    return evt;
   return q.parallel_for(sycl::range{static_cast<size_t>(n)},
                         [=](sycl::id<1> id) {
                           auto it = first;
@@ -108,6 +304,22 @@ sycl::event transform(sycl::queue& q,
                      UnaryOperation unary_op) {
   if(first1 == last1)
     return sycl::event{};
+
+  using value_type1 = typename std::iterator_traits<ForwardIt1>::value_type;
+  using value_type2 = typename std::iterator_traits<ForwardIt2>::value_type;
+  constexpr std::size_t packet_size =
+      detail::packet_size_for<value_type1, value_type2>();
+
+  if constexpr (packet_size > 1 && util::is_contiguous<ForwardIt1>() &&
+                util::is_contiguous<ForwardIt2>()) {
+    const value_type1 *input = &(*first1);
+    value_type2 *output = &(*d_first);
+    if (util::is_packet_aligned<value_type1, packet_size>(input) &&
+        util::is_packet_aligned<value_type2, packet_size>(output))
+      return detail::transform_packets<packet_size>(
+          q, input, output, std::distance(first1, last1), unary_op);
+  }
+
   return q.parallel_for(sycl::range{std::distance(first1, last1)},
                         [=](sycl::id<1> id) {
                           auto input = first1;
@@ -125,6 +337,27 @@ sycl::event transform(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
                       BinaryOperation binary_op) {
   if(first1 == last1)
     return sycl::event{};
+
+  using value_type1 = typename std::iterator_traits<ForwardIt1>::value_type;
+  using value_type2 = typename std::iterator_traits<ForwardIt2>::value_type;
+  using value_type3 = typename std::iterator_traits<ForwardIt3>::value_type;
+  constexpr std::size_t packet_size =
+      std::min(detail::packet_size_for<value_type1, value_type3>(),
+               detail::packet_size_for<value_type2, value_type3>());
+
+  if constexpr (packet_size > 1 && util::is_contiguous<ForwardIt1>() &&
+                util::is_contiguous<ForwardIt2>() &&
+                util::is_contiguous<ForwardIt3>()) {
+    const value_type1 *input1 = &(*first1);
+    const value_type2 *input2 = &(*first2);
+    value_type3 *output = &(*d_first);
+    if (util::is_packet_aligned<value_type1, packet_size>(input1) &&
+        util::is_packet_aligned<value_type2, packet_size>(input2) &&
+        util::is_packet_aligned<value_type3, packet_size>(output))
+      return detail::transform_packets<packet_size>(
+          q, input1, input2, output, std::distance(first1, last1), binary_op);
+  }
+
   return q.parallel_for(sycl::range{std::distance(first1, last1)},
                         [=](sycl::id<1> id) {
                           auto input1 = first1;
@@ -137,6 +370,59 @@ sycl::event transform(sycl::queue &q, ForwardIt1 first1, ForwardIt1 last1,
                         });
 }
 
+// Writes *(input_first + *(map_first + i)) to *(d_first + i) for all
+// i < std::distance(map_first, map_last).
+template <class ForwardIt1, class RandomIt, class ForwardIt2>
+sycl::event gather(sycl::queue &q, ForwardIt1 map_first, ForwardIt1 map_last,
+                   RandomIt input_first, ForwardIt2 d_first) {
+  if(map_first == map_last)
+    return sycl::event{};
+
+  const std::size_t problem_size = std::distance(map_first, map_last);
+  const std::size_t group_size = detail::packet_kernel_group_size;
+  util::data_streamer streamer{q.get_device(), problem_size, group_size};
+  return q.parallel_for(
+      sycl::nd_range<1>{streamer.get_required_global_size(), group_size},
+      [=](sycl::nd_item<1> idx) {
+        util::data_streamer::run(problem_size, idx, [&](sycl::id<1> i) {
+          auto map = map_first;
+          auto output = d_first;
+          std::advance(map, i[0]);
+          std::advance(output, i[0]);
+          auto input = input_first;
+          std::advance(input, *map);
+          *output = *input;
+        });
+      });
+}
+
+// Writes *(first + i) to *(d_first + *(map_first + i)) for all
+// i < std::distance(first, last). If the map contains an index multiple
+// times, it is unspecified which of the elements is written to it.
+template <class ForwardIt1, class ForwardIt2, class RandomIt>
+sycl::event scatter(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
+                    ForwardIt2 map_first, RandomIt d_first) {
+  if(first == last)
+    return sycl::event{};
+
+  const std::size_t problem_size = std::distance(first, last);
+  const std::size_t group_size = detail::packet_kernel_group_size;
+  util::data_streamer streamer{q.get_device(), problem_size, group_size};
+  return q.parallel_for(
+      sycl::nd_range<1>{streamer.get_required_global_size(), group_size},
+      [=](sycl::nd_item<1> idx) {
+        util::data_streamer::run(problem_size, idx, [&](sycl::id<1> i) {
+          auto input = first;
+          auto map = map_first;
+          std::advance(input, i[0]);
+          std::advance(map, i[0]);
+          auto output = d_first;
+          std::advance(output, *map);
+          *output = *input;
+        });
+      });
+}
+
 template <class ForwardIt1, class ForwardIt2>
 sycl::event copy(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
                  ForwardIt2 d_first) {
@@ -154,6 +440,22 @@ sycl::event copy(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
       detail::should_use_memcpy(q.get_device())) {
     return q.memcpy(&(*d_first), &(*first), size * sizeof(value_type1));
   } else {
+    constexpr std::size_t packet_size =
+        detail::packet_size_for<value_type1, value_type2>();
+    if constexpr (packet_size > 1 && util::is_contiguous<ForwardIt1>() &&
+                  util::is_contiguous<ForwardIt2>()) {
+      const value_type1 *input = &(*first);
+      value_type2 *output = &(*d_first);
+      if (util::is_packet_aligned<value_type1, packet_size>(input) &&
+          util::is_packet_aligned<value_type2, packet_size>(output))
+        return detail::transform_packets<packet_size>(
+            q, input, output, size,
+            [](const value_type1 &x) {
+              value_type2 y;
+              y = x;
+              return y;
+            });
+    }
     return q.parallel_for(sycl::range{size},
                           [=](sycl::id<1> id) {
                             auto input = first;
@@ -166,23 +468,254 @@ sycl::event copy(sycl::queue &q, ForwardIt1 first, ForwardIt1 last,
 }
 
 
+// Compacts all elements satisfying pred into the range starting at d_first,
+// preserving their relative order.
+// If num_elements_copied is not nullptr, the number of copied elements is
+// written to it once the returned event has completed. If first==last,
+// *num_elements_copied remains untouched.
 template<class ForwardIt1, class ForwardIt2, class UnaryPredicate >
 sycl::event copy_if(sycl::queue& q,
+                    util::allocation_group &scratch_allocations,
                     ForwardIt1 first, ForwardIt1 last,
                     ForwardIt2 d_first,
-                    UnaryPredicate pred) {
-  if(first == last)
+                    UnaryPredicate pred,
+                    std::size_t* num_elements_copied = nullptr) {
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
     return sycl::event{};
-  return q.parallel_for(sycl::range{std::distance(first, last)},
-                        [=](sycl::id<1> id) {
-                          auto input = first;
-                          auto output = d_first;
-                          std::advance(input, id[0]);
-                          std::advance(output, id[0]);
-                          auto input_v = *input;
-                          if(pred(input_v))
-                            *output = input_v;
-                        });
+
+  auto load = [=](std::size_t i) -> std::size_t {
+    auto input = first;
+    std::advance(input, i);
+    return pred(*input) ? 1 : 0;
+  };
+
+  auto store = [=](std::size_t i, std::size_t exclusive,
+                   std::size_t inclusive) {
+    // The element was selected if the scan has been incremented by it.
+    if(inclusive != exclusive) {
+      auto input = first;
+      auto output = d_first;
+      std::advance(input, i);
+      std::advance(output, exclusive);
+      *output = *input;
+    }
+    if(num_elements_copied && i == problem_size - 1)
+      *num_elements_copied = inclusive;
+  };
+
+  return scanning::decoupled_lookback_scan(
+      q, scratch_allocations, problem_size, sycl::plus<std::size_t>{}, true,
+      std::size_t{0}, load, store);
+}
+
+namespace detail {
+
+// Stable compaction by element index: select(i) decides whether element i is
+// selected. write(i, is_selected, rank) is invoked for every element, where
+// rank is the position of the element among all selected elements if it is
+// selected, and among all rejected elements otherwise.
+template <class Select, class Write>
+sycl::event compact(sycl::queue &q, util::allocation_group &scratch_allocations,
+                    std::size_t problem_size, Select select, Write write,
+                    std::size_t *num_selected,
+                    sycl::event dependency = sycl::event{}) {
+  auto load = [=](std::size_t i) -> std::size_t {
+    return select(i) ? 1 : 0;
+  };
+
+  auto store = [=](std::size_t i, std::size_t exclusive,
+                   std::size_t inclusive) {
+    if(inclusive != exclusive)
+      write(i, true, exclusive);
+    else
+      write(i, false, i - exclusive);
+    if(num_selected && i == problem_size - 1)
+      *num_selected = inclusive;
+  };
+
+  return scanning::decoupled_lookback_scan(
+      q, scratch_allocations, problem_size, sycl::plus<std::size_t>{}, true,
+      std::size_t{0}, load, store, 128, dependency);
+}
+
+// In-place algorithms compact from a copy of the input, because elements
+// may otherwise be overwritten before they are read.
+template <class ForwardIt>
+sycl::event copy_to_scratch(
+    sycl::queue &q, ForwardIt first, std::size_t problem_size,
+    typename std::iterator_traits<ForwardIt>::value_type *scratch) {
+  return q.parallel_for(sycl::range{problem_size}, [=](sycl::id<1> id) {
+    auto input = first;
+    std::advance(input, id[0]);
+    scratch[id[0]] = *input;
+  });
+}
+
+}
+
+// Copies the elements satisfying pred to the range starting at d_first_true,
+// and all others to the range starting at d_first_false, preserving their
+// relative order. If num_true is not nullptr, the number of elements
+// satisfying pred is written to it once the returned event has completed.
+template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
+          class UnaryPredicate>
+sycl::event partition_copy(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first_true, ForwardIt3 d_first_false,
+                           UnaryPredicate pred,
+                           std::size_t *num_true = nullptr) {
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  auto select = [=](std::size_t i) {
+    auto input = first;
+    std::advance(input, i);
+    return pred(*input);
+  };
+  auto write = [=](std::size_t i, bool is_selected, std::size_t rank) {
+    auto input = first;
+    std::advance(input, i);
+    if(is_selected) {
+      auto output = d_first_true;
+      std::advance(output, rank);
+      *output = *input;
+    } else {
+      auto output = d_first_false;
+      std::advance(output, rank);
+      *output = *input;
+    }
+  };
+  return detail::compact(q, scratch_allocations, problem_size, select, write,
+                         num_true);
+}
+
+// Moves the elements satisfying pred before all other elements, preserving
+// the relative order within both groups. If num_true is not nullptr, the
+// number of elements satisfying pred is written to it once the returned
+// event has completed.
+template <class BidirIt, class UnaryPredicate>
+sycl::event stable_partition(sycl::queue &q,
+                             util::allocation_group &scratch_allocations,
+                             BidirIt first, BidirIt last, UnaryPredicate pred,
+                             std::size_t *num_true = nullptr) {
+  using T = typename std::iterator_traits<BidirIt>::value_type;
+
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  T *input = scratch_allocations.obtain<T>(problem_size);
+  T *rejected = scratch_allocations.obtain<T>(problem_size);
+  std::size_t *num_selected = scratch_allocations.obtain<std::size_t>(1);
+
+  sycl::event copy_evt =
+      detail::copy_to_scratch(q, first, problem_size, input);
+
+  auto select = [=](std::size_t i) { return pred(input[i]); };
+  auto write = [=](std::size_t i, bool is_selected, std::size_t rank) {
+    if(is_selected) {
+      auto output = first;
+      std::advance(output, rank);
+      *output = input[i];
+    } else {
+      rejected[rank] = input[i];
+    }
+  };
+  sycl::event compact_evt =
+      detail::compact(q, scratch_allocations, problem_size, select, write,
+                      num_selected, copy_evt);
+
+  // Append the rejected elements after the selected ones
+  return q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(compact_evt);
+    cgh.parallel_for(sycl::range{problem_size}, [=](sycl::id<1> id) {
+      const std::size_t num_selected_elements = *num_selected;
+      if(id[0] < problem_size - num_selected_elements) {
+        auto output = first;
+        std::advance(output, num_selected_elements + id[0]);
+        *output = rejected[id[0]];
+      }
+      if(num_true && id[0] == 0)
+        *num_true = num_selected_elements;
+    });
+  });
+}
+
+// Like stable_partition(). The order within the groups is not part of the
+// guarantees of partition(), but is in practice preserved.
+template <class ForwardIt, class UnaryPredicate>
+sycl::event partition(sycl::queue &q,
+                      util::allocation_group &scratch_allocations,
+                      ForwardIt first, ForwardIt last, UnaryPredicate pred,
+                      std::size_t *num_true = nullptr) {
+  return stable_partition(q, scratch_allocations, first, last, pred, num_true);
+}
+
+// Removes all elements satisfying pred by moving the remaining ones to the
+// front of the range, preserving their relative order. If num_remaining is not
+// nullptr, the number of remaining elements is written to it once the
+// returned event has completed.
+template <class ForwardIt, class UnaryPredicate>
+sycl::event remove_if(sycl::queue &q,
+                      util::allocation_group &scratch_allocations,
+                      ForwardIt first, ForwardIt last, UnaryPredicate pred,
+                      std::size_t *num_remaining = nullptr) {
+  using T = typename std::iterator_traits<ForwardIt>::value_type;
+
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  T *input = scratch_allocations.obtain<T>(problem_size);
+  sycl::event copy_evt =
+      detail::copy_to_scratch(q, first, problem_size, input);
+
+  auto select = [=](std::size_t i) { return !pred(input[i]); };
+  auto write = [=](std::size_t i, bool is_selected, std::size_t rank) {
+    if(is_selected) {
+      auto output = first;
+      std::advance(output, rank);
+      *output = input[i];
+    }
+  };
+  return detail::compact(q, scratch_allocations, problem_size, select, write,
+                         num_remaining, copy_evt);
+}
+
+// Removes all but the first element of each group of consecutive elements
+// that are equal according to p, moving the remaining ones to the front of
+// the range. If num_remaining is not nullptr, the number of remaining
+// elements is written to it once the returned event has completed.
+template <class ForwardIt, class BinaryPredicate = std::equal_to<>>
+sycl::event unique(sycl::queue &q, util::allocation_group &scratch_allocations,
+                   ForwardIt first, ForwardIt last,
+                   BinaryPredicate p = BinaryPredicate{},
+                   std::size_t *num_remaining = nullptr) {
+  using T = typename std::iterator_traits<ForwardIt>::value_type;
+
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  T *input = scratch_allocations.obtain<T>(problem_size);
+  sycl::event copy_evt =
+      detail::copy_to_scratch(q, first, problem_size, input);
+
+  auto select = [=](std::size_t i) {
+    return i == 0 || !p(input[i - 1], input[i]);
+  };
+  auto write = [=](std::size_t i, bool is_selected, std::size_t rank) {
+    if(is_selected) {
+      auto output = first;
+      std::advance(output, rank);
+      *output = input[i];
+    }
+  };
+  return detail::compact(q, scratch_allocations, problem_size, select, write,
+                         num_remaining, copy_evt);
 }
 
 template<class ForwardIt1, class Size, class ForwardIt2 >
@@ -205,6 +738,13 @@ sycl::event fill(sycl::queue &q, ForwardIt first, ForwardIt last,
   using value_type = typename std::iterator_traits<ForwardIt>::value_type;
 
   auto invoke_kernel = [&]() -> sycl::event{
+    constexpr std::size_t packet_size = detail::packet_size_for<value_type>();
+    if constexpr (packet_size > 1 && std::is_same_v<value_type, T> &&
+                  util::is_contiguous<ForwardIt>()) {
+      value_type *ptr = &(*first);
+      if (util::is_packet_aligned<value_type, packet_size>(ptr))
+        return detail::fill_packets<packet_size>(q, ptr, size, value);
+    }
     return q.parallel_for(sycl::range{size},
                         [=](sycl::id<1> id) {
                           auto it = first;
@@ -331,33 +871,6 @@ transform_reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
                  ForwardIt first, ForwardIt last, T* out, T init,
                  BinaryReductionOp reduce, UnaryTransformOp transform);
 
-/*
-// Need transform_reduce functionality for find etc, so forward
-// declare here.
-template <class ForwardIt, class T, class BinaryReductionOp,
-          class UnaryTransformOp>
-sycl::event
-transform_reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
-                 ForwardIt first, ForwardIt last, T* out, T init,
-                 BinaryReductionOp reduce, UnaryTransformOp transform);
-
-template <class ForwardIt, class T>
-sycl::event find(sycl::queue &q, util::allocation_group &scratch_allocations, ForwardIt first, ForwardIt last,
-                 typename std::iterator_traits<ForwardIt>::difference_type* out, const T &value) {
-  using difference_type = typename std::iterator_traits<ForwardIt>::difference_type;
-  
-  return transform_reduce(q, scratch_allocations, first, last, out, std::distance(first, last), sycl::minimum<difference_type>{},)
-}
-
-template <class ForwardIt, class UnaryPredicate>
-sycl::event find_if(sycl::queue &q, util::allocation_group &scratch_allocations, ForwardIt first, ForwardIt last,
-                    typename std::iterator_traits<ForwardIt>::difference_type* out, UnaryPredicate p);
-
-template <class ForwardIt, class UnaryPredicate>
-sycl::event find_if_not(sycl::queue &q, util::allocation_group &scratch_allocations, ForwardIt first, ForwardIt last,
-                        typename std::iterator_traits<ForwardIt>::difference_type* out, UnaryPredicate p);
-*/
-
 namespace detail {
 using early_exit_flag_t = int;
 
@@ -376,17 +889,15 @@ sycl::event early_exit_for_each(sycl::queue &q, std::size_t problem_size,
   std::size_t dispatched_global_size = streamer.get_required_global_size();
 
   auto kernel = [=](sycl::nd_item<1> idx) {
-      const std::size_t item_id = idx.get_global_id(0);
-  
-      util::abortable_data_streamer::run(problem_size, idx, [&](sycl::id<1> idx){
-        
-        if (sycl::detail::__acpp_atomic_load<
-                sycl::access::address_space::global_space>(
-                output_has_exited_early, sycl::memory_order_relaxed,
-                sycl::memory_scope_device)) {
-          return true;
-        }
+      auto has_exited_early = [&](std::size_t) -> bool {
+        return sycl::detail::__acpp_atomic_load<
+            sycl::access::address_space::global_space>(
+            output_has_exited_early, sycl::memory_order_relaxed,
+            sycl::memory_scope_device);
+      };
 
+      util::abortable_data_streamer::run(problem_size, idx, has_exited_early,
+                                         [&](sycl::id<1> idx) {
         if (should_exit(idx)) {
           sycl::detail::__acpp_atomic_store<
               sycl::access::address_space::global_space>(
@@ -404,6 +915,85 @@ sycl::event early_exit_for_each(sycl::queue &q, std::size_t problem_size,
                         kernel);
 }
 
+// predicate must be a callable of type bool(sycl::id<1>).
+// Writes the smallest index for which predicate returns true to
+// output_index, or problem_size if there is none. Work groups skip
+// all indices beyond the smallest index found so far.
+template <class Difference, class Predicate>
+sycl::event find_first_index(sycl::queue &q, std::size_t problem_size,
+                             Difference *output_index, Predicate predicate) {
+
+  std::size_t group_size = 128;
+
+  util::abortable_data_streamer streamer{q.get_device(), problem_size, group_size};
+
+  std::size_t dispatched_global_size = streamer.get_required_global_size();
+
+  auto kernel = [=](sycl::nd_item<1> idx) {
+      auto is_after_match = [&](std::size_t tile_begin) -> bool {
+        return sycl::detail::__acpp_atomic_load<
+                   sycl::access::address_space::global_space>(
+                   output_index, sycl::memory_order_relaxed,
+                   sycl::memory_scope_device) <=
+               static_cast<Difference>(tile_begin);
+      };
+
+      util::abortable_data_streamer::run(problem_size, idx, is_after_match,
+                                         [&](sycl::id<1> idx) {
+        if (predicate(idx)) {
+          // All remaining indices of this work item are larger
+          sycl::detail::__acpp_atomic_fetch_min<
+              sycl::access::address_space::global_space>(
+              output_index, static_cast<Difference>(idx[0]),
+              sycl::memory_order_relaxed, sycl::memory_scope_device);
+          return true;
+        }
+        return false;
+      });
+    };
+
+  auto evt = q.single_task([=]() {
+    *output_index = static_cast<Difference>(problem_size);
+  });
+  return q.parallel_for(sycl::nd_range<1>{dispatched_global_size, group_size}, evt,
+                        kernel);
+}
+
+}
+
+// Writes the offset of the first element satisfying p relative to first
+// to out, or std::distance(first, last) if there is none. If first==last,
+// out is not written.
+template <class ForwardIt, class UnaryPredicate>
+sycl::event
+find_if(sycl::queue &q, ForwardIt first, ForwardIt last,
+        typename std::iterator_traits<ForwardIt>::difference_type *out,
+        UnaryPredicate p) {
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+  return detail::find_first_index(q, problem_size, out,
+                                  [=](sycl::id<1> idx) -> bool {
+                                    auto it = first;
+                                    std::advance(it, idx[0]);
+                                    return p(*it);
+                                  });
+}
+
+template <class ForwardIt, class UnaryPredicate>
+sycl::event
+find_if_not(sycl::queue &q, ForwardIt first, ForwardIt last,
+            typename std::iterator_traits<ForwardIt>::difference_type *out,
+            UnaryPredicate p) {
+  return find_if(q, first, last, out, [=](const auto &x) { return !p(x); });
+}
+
+template <class ForwardIt, class T>
+sycl::event find(sycl::queue &q, ForwardIt first, ForwardIt last,
+                 typename std::iterator_traits<ForwardIt>::difference_type *out,
+                 const T &value) {
+  return find_if(q, first, last, out,
+                 [=](const auto &x) { return x == value; });
 }
 
 template <class ForwardIt, class UnaryPredicate>
@@ -453,15 +1043,167 @@ sycl::event none_of(sycl::queue &q,
   });
 }
 
-template <class RandomIt, class Compare>
-void sort(sycl::queue &q, RandomIt first, RandomIt last,
-          Compare comp = std::less<>{}) {
+namespace detail {
+
+// Below this size, the fixed number of kernels and the scratch
+// memory of radix sort do not pay off.
+constexpr std::size_t radix_sort_min_problem_size = 4096;
+
+template <class Key, class Compare>
+bool should_use_radix_sort(std::size_t problem_size) {
+  if constexpr (sorting::is_radix_sortable<Key, Compare>()) {
+    return problem_size >= radix_sort_min_problem_size &&
+           sorting::is_radix_sortable_size(problem_size);
+  } else {
+    return false;
+  }
+}
+
+}
+
+template <class RandomIt, class Compare = std::less<>>
+sycl::event sort(sycl::queue &q, RandomIt first, RandomIt last,
+                 Compare comp = Compare{}) {
   std::size_t problem_size = std::distance(first, last);
   if(problem_size == 0)
     return sycl::event{};
   
   return sorting::bitonic_sort(q, first, last, comp);
 }
+
+// Uses radix sort for arithmetic keys with std::less or std::greater,
+// and merge sort otherwise. The sort is stable.
+template <class RandomIt, class Compare = std::less<>>
+sycl::event stable_sort(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        RandomIt first, RandomIt last,
+                        Compare comp = Compare{}) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  if(detail::should_use_radix_sort<key_type, Compare>(problem_size))
+    return sorting::radix_sort(q, scratch_allocations, first, last, comp);
+  return sorting::merge_sort(q, scratch_allocations, first, last, comp);
+}
+
+template <class RandomIt, class Compare = std::less<>>
+sycl::event sort(sycl::queue &q, util::allocation_group &scratch_allocations,
+                 RandomIt first, RandomIt last, Compare comp = Compare{}) {
+  return stable_sort(q, scratch_allocations, first, last, comp);
+}
+
+// Sorts the keys, and applies the same permutation to the values
+// starting at values_first.
+template <class KeyIt, class ValueIt, class Compare = std::less<>>
+sycl::event sort_by_key(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        KeyIt keys_first, KeyIt keys_last,
+                        ValueIt values_first, Compare comp = Compare{}) {
+  using key_type = typename std::iterator_traits<KeyIt>::value_type;
+
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  if(detail::should_use_radix_sort<key_type, Compare>(problem_size))
+    return sorting::radix_sort_by_key(q, scratch_allocations, keys_first,
+                                      keys_last, values_first, comp);
+  return sorting::bitonic_sort_by_key(q, keys_first, keys_last, values_first,
+                                      comp);
+}
+
+// Moves the element that would be at nth if the range was sorted to nth,
+// such that no element before nth is greater and no element after nth is
+// less than it. Uses radix selection for arithmetic keys with std::less or
+// std::greater, and sorts the range otherwise.
+template <class RandomIt, class Compare = std::less<>>
+sycl::event nth_element(sycl::queue &q,
+                        util::allocation_group &scratch_allocations,
+                        RandomIt first, RandomIt nth, RandomIt last,
+                        Compare comp = Compare{}) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+
+  std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0 || nth == last)
+    return sycl::event{};
+
+  if constexpr (sorting::is_radix_sortable<key_type, Compare>()) {
+    if(sorting::is_radix_selectable_size(problem_size))
+      return sorting::radix_nth_element(q, scratch_allocations, first, nth,
+                                        last, comp);
+  }
+  return sort(q, scratch_allocations, first, last, comp);
+}
+
+// Sorts the elements that would be in [first, middle) if the range was
+// sorted into [first, middle). The order of the remaining elements is
+// unspecified.
+template <class RandomIt, class Compare = std::less<>>
+sycl::event partial_sort(sycl::queue &q,
+                         util::allocation_group &scratch_allocations,
+                         RandomIt first, RandomIt middle, RandomIt last,
+                         Compare comp = Compare{}) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+
+  std::size_t problem_size = std::distance(first, last);
+  std::size_t num_sorted = std::distance(first, middle);
+  if(problem_size == 0 || num_sorted == 0)
+    return sycl::event{};
+
+  if constexpr (sorting::is_radix_sortable<key_type, Compare>()) {
+    if(num_sorted < problem_size &&
+       sorting::is_radix_selectable_size(problem_size)) {
+      auto nth = first;
+      std::advance(nth, num_sorted - 1);
+      sycl::event select_evt = sorting::radix_nth_element(
+          q, scratch_allocations, first, nth, last, comp);
+      // The sorts do not take dependencies
+      if(!q.is_in_order())
+        select_evt.wait();
+      return sort(q, scratch_allocations, first, middle, comp);
+    }
+  }
+  return sort(q, scratch_allocations, first, last, comp);
+}
+
+// Batched nth_element() for num_rows rows of row_size consecutive elements
+// starting at first, e.g. the rows of a dense matrix: For each row, moves
+// the element at position nth of the sorted row to position nth of the
+// row. All rows are processed by a single kernel launch. Requires
+// arithmetic keys with std::less or std::greater.
+template <class RandomIt, class Compare = std::less<>>
+sycl::event nth_element_rows(sycl::queue &q,
+                             util::allocation_group &scratch_allocations,
+                             RandomIt first, std::size_t num_rows,
+                             std::size_t row_size, std::size_t nth,
+                             Compare comp = Compare{}) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+  static_assert(sorting::is_radix_sortable<key_type, Compare>(),
+                "nth_element_rows() requires a radix-sortable key type and "
+                "comparator");
+  return sorting::radix_nth_element_rows(q, scratch_allocations, first,
+                                         num_rows, row_size, nth, comp);
+}
+
+// Writes the k first elements in the order given by comp of each of
+// num_rows rows of row_size consecutive elements starting at first to k
+// consecutive elements per row starting at d_first, in unspecified order
+// within each output row. All rows are processed by a single kernel launch.
+// Requires arithmetic keys with std::less or std::greater.
+template <class RandomIt, class OutputIt, class Compare = std::less<>>
+sycl::event top_k_rows(sycl::queue &q, RandomIt first, std::size_t num_rows,
+                       std::size_t row_size, std::size_t k, OutputIt d_first,
+                       Compare comp = Compare{}) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+  static_assert(sorting::is_radix_sortable<key_type, Compare>(),
+                "top_k_rows() requires a radix-sortable key type and "
+                "comparator");
+  return sorting::radix_top_k_rows(q, first, num_rows, row_size, k, d_first,
+                                   comp);
+}
 }
 
 #endif
@@ -0,0 +1,184 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef ACPP_ALGORITHMS_PRIVATIZED_HISTOGRAM
+#define ACPP_ALGORITHMS_PRIVATIZED_HISTOGRAM
+
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include "hipSYCL/sycl/libkernel/accessor.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_ref.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/util/memory_streaming.hpp"
+
+namespace hipsycl::algorithms::histogramming {
+
+namespace detail {
+
+// Histograms with at most this many bins get multiple copies per work group,
+// each shared by only some of the sub-groups, to reduce contention of
+// local memory atomics.
+constexpr std::size_t max_num_sub_group_privatized_bins = 256;
+constexpr std::size_t num_sub_group_private_copies = 8;
+
+template<class Counter>
+using global_counter_ref =
+    sycl::atomic_ref<Counter, sycl::memory_order::relaxed,
+                     sycl::memory_scope::device,
+                     sycl::access::address_space::global_space>;
+
+template<class Counter>
+using local_counter_ref =
+    sycl::atomic_ref<Counter, sycl::memory_order::relaxed,
+                     sycl::memory_scope::work_group,
+                     sycl::access::address_space::local_space>;
+
+template <class Counter, class Load, class BinIndex>
+sycl::event thread_privatized_histogram(
+    sycl::queue &q, util::allocation_group &scratch_allocations,
+    std::size_t problem_size, Counter *bins, std::size_t num_bins, Load load,
+    BinIndex bin_index) {
+  const std::size_t num_threads = std::min(
+      problem_size, static_cast<std::size_t>(
+                        q.get_device()
+                            .get_info<sycl::info::device::max_compute_units>()));
+
+  Counter *private_bins =
+      scratch_allocations.obtain<Counter>(num_threads * num_bins);
+
+  auto count_evt = q.parallel_for(
+      sycl::range<1>{num_threads}, [=](sycl::id<1> idx) {
+        Counter *my_bins = private_bins + idx[0] * num_bins;
+        for(std::size_t i = 0; i < num_bins; ++i)
+          my_bins[i] = 0;
+
+        const std::size_t begin = idx[0] * problem_size / num_threads;
+        const std::size_t end = (idx[0] + 1) * problem_size / num_threads;
+        for(std::size_t i = begin; i < end; ++i) {
+          std::size_t bin = bin_index(load(i));
+          if(bin < num_bins)
+            ++my_bins[bin];
+        }
+      });
+
+  return q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(count_evt);
+    cgh.parallel_for(sycl::range<1>{num_bins}, [=](sycl::id<1> idx) {
+      Counter sum = 0;
+      for(std::size_t t = 0; t < num_threads; ++t)
+        sum += private_bins[t * num_bins + idx[0]];
+      bins[idx[0]] += sum;
+    });
+  });
+}
+
+} // detail
+
+/// Counts how many of the \c problem_size elements fall into each of the
+/// \c num_bins bins, and adds the counts to \c bins.
+///
+/// \c load must be a callable of type T(std::size_t) returning the i-th
+/// element, and \c bin_index a callable of type std::size_t(T) returning the
+/// bin of an element. Elements for which bin_index returns a value
+/// >= num_bins are not counted.
+///
+/// On host devices, every thread counts a contiguous part of the input into
+/// its own histogram, and the histograms are summed up afterwards.
+/// On other devices, each work group counts into copies of the histogram
+/// in local memory using local atomics, which are then merged with global
+/// atomics. Small histograms get multiple copies per work group, each
+/// shared by a subset of the sub-groups. If the histogram does
+/// not fit into local memory, elements are counted with global atomics
+/// directly.
+template <class Counter, class Load, class BinIndex>
+sycl::event privatized_histogram(sycl::queue &q,
+                                 util::allocation_group &scratch_allocations,
+                                 std::size_t problem_size, Counter *bins,
+                                 std::size_t num_bins, Load load,
+                                 BinIndex bin_index,
+                                 std::size_t group_size = 256) {
+  static_assert(std::is_integral_v<Counter>,
+                "Histogram counters must be of integral type");
+
+  if(problem_size == 0 || num_bins == 0)
+    return sycl::event{};
+
+  sycl::device dev = q.get_device();
+  if(dev.is_host())
+    return detail::thread_privatized_histogram(
+        q, scratch_allocations, problem_size, bins, num_bins, load, bin_index);
+
+  const std::size_t num_copies =
+      num_bins <= detail::max_num_sub_group_privatized_bins
+          ? detail::num_sub_group_private_copies
+          : 1;
+  const std::size_t local_bins_size = num_copies * num_bins;
+  const bool use_local_memory =
+      local_bins_size * sizeof(Counter) <=
+      dev.get_info<sycl::info::device::local_mem_size>() / 2;
+
+  util::data_streamer streamer{dev, problem_size, group_size};
+  const std::size_t global_size = streamer.get_required_global_size();
+
+  if(!use_local_memory) {
+    return q.parallel_for(
+        sycl::nd_range<1>{global_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          util::data_streamer::run(problem_size, idx, [&](sycl::id<1> i) {
+            std::size_t bin = bin_index(load(i[0]));
+            if(bin < num_bins)
+              detail::global_counter_ref<Counter>{bins[bin]}.fetch_add(
+                  Counter{1});
+          });
+        });
+  }
+
+  return q.submit([&](sycl::handler &cgh) {
+    sycl::local_accessor<Counter> local_bins{sycl::range<1>{local_bins_size},
+                                             cgh};
+
+    cgh.parallel_for(
+        sycl::nd_range<1>{global_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_linear_id();
+          for(std::size_t i = lid; i < local_bins_size; i += group_size)
+            local_bins[i] = 0;
+          sycl::group_barrier(idx.get_group());
+
+          const std::size_t copy =
+              idx.get_sub_group().get_group_linear_id() % num_copies;
+          const std::size_t copy_offset = copy * num_bins;
+
+          util::data_streamer::run(problem_size, idx, [&](sycl::id<1> i) {
+            std::size_t bin = bin_index(load(i[0]));
+            if(bin < num_bins)
+              detail::local_counter_ref<Counter>{
+                  local_bins[copy_offset + bin]}
+                  .fetch_add(Counter{1});
+          });
+          sycl::group_barrier(idx.get_group());
+
+          for(std::size_t bin = lid; bin < num_bins; bin += group_size) {
+            Counter sum = 0;
+            for(std::size_t c = 0; c < num_copies; ++c)
+              sum += local_bins[c * num_bins + bin];
+            if(sum != 0)
+              detail::global_counter_ref<Counter>{bins[bin]}.fetch_add(sum);
+          }
+        });
+  });
+}
+
+}
+
+#endif
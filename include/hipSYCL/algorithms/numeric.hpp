@@ -11,10 +11,13 @@
 #ifndef HIPSYCL_ALGORITHMS_NUMERIC_HPP
 #define HIPSYCL_ALGORITHMS_NUMERIC_HPP
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <functional>
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 #include "hipSYCL/algorithms/util/allocation_cache.hpp"
 #include "hipSYCL/sycl/libkernel/accessor.hpp"
@@ -23,7 +26,13 @@
 #include "hipSYCL/sycl/queue.hpp"
 #include "hipSYCL/algorithms/reduction/reduction_descriptor.hpp"
 #include "hipSYCL/algorithms/reduction/reduction_engine.hpp"
+#include "hipSYCL/algorithms/reduction/segmented_reduction.hpp"
+#include "hipSYCL/algorithms/reduction/threading_model/vectorized_accumulation.hpp"
 #include "hipSYCL/algorithms/util/memory_streaming.hpp"
+#include "hipSYCL/algorithms/util/traits.hpp"
+#include "hipSYCL/algorithms/scan/decoupled_lookback_scan.hpp"
+#include "hipSYCL/algorithms/scan/blocked_scan.hpp"
+#include "hipSYCL/algorithms/histogram/privatized_histogram.hpp"
 
 namespace hipsycl::algorithms {
 
@@ -47,7 +56,40 @@ HIPSYCL_ALGORITHMS_DEFINE_KNOWN_IDENTITY(std::multiplies<T>, T{1})
 HIPSYCL_ALGORITHMS_DEFINE_KNOWN_IDENTITY(sycl::plus<T>, T{})
 HIPSYCL_ALGORITHMS_DEFINE_KNOWN_IDENTITY(sycl::multiplies<T>, T{1})
 HIPSYCL_ALGORITHMS_DEFINE_KNOWN_IDENTITY(sycl::minimum<T>, std::numeric_limits<T>::max())
-HIPSYCL_ALGORITHMS_DEFINE_KNOWN_IDENTITY(sycl::maximum<T>, std::numeric_limits<T>::min())
+HIPSYCL_ALGORITHMS_DEFINE_KNOWN_IDENTITY(sycl::maximum<T>, std::numeric_limits<T>::lowest())
+
+// Operators for which the threading model may use multiple independent
+// accumulators per thread. For floating point additions, this changes
+// the rounding of the result, so have to opt in by defining
+// HIPSYCL_ALGORITHMS_ALLOW_FP_REASSOCIATION.
+template<class T, class Op>
+struct is_vectorizable_reduction {
+  static constexpr bool value = false;
+};
+
+#ifdef HIPSYCL_ALGORITHMS_ALLOW_FP_REASSOCIATION
+#define HIPSYCL_ALGORITHMS_IS_REASSOCIATION_ALLOWED(T) std::is_arithmetic_v<T>
+#else
+#define HIPSYCL_ALGORITHMS_IS_REASSOCIATION_ALLOWED(T) std::is_integral_v<T>
+#endif
+
+#define HIPSYCL_ALGORITHMS_DEFINE_VECTORIZABLE_REDUCTION(op, condition)        \
+  template <class T> struct is_vectorizable_reduction<T, op> {                 \
+    static constexpr bool value = condition;                                   \
+  };
+
+HIPSYCL_ALGORITHMS_DEFINE_VECTORIZABLE_REDUCTION(
+    std::plus<T>, HIPSYCL_ALGORITHMS_IS_REASSOCIATION_ALLOWED(T))
+HIPSYCL_ALGORITHMS_DEFINE_VECTORIZABLE_REDUCTION(
+    sycl::plus<T>, HIPSYCL_ALGORITHMS_IS_REASSOCIATION_ALLOWED(T))
+// min/max results do not depend on the order of evaluation
+HIPSYCL_ALGORITHMS_DEFINE_VECTORIZABLE_REDUCTION(sycl::minimum<T>,
+                                                 std::is_arithmetic_v<T>)
+HIPSYCL_ALGORITHMS_DEFINE_VECTORIZABLE_REDUCTION(sycl::maximum<T>,
+                                                 std::is_arithmetic_v<T>)
+
+#undef HIPSYCL_ALGORITHMS_DEFINE_VECTORIZABLE_REDUCTION
+#undef HIPSYCL_ALGORITHMS_IS_REASSOCIATION_ALLOWED
 
 
 template<class T, class BinaryOp>
@@ -61,6 +103,8 @@ auto get_reduction_operator_configuration(const BinaryOp& op) {
 }
 
 
+// k is invoked as k(sycl::id<1>, reducer) for each index and must combine
+// exactly one value into the reducer.
 template <class T, class Kernel,
           class BinaryReductionOp>
 sycl::event wg_model_reduction(sycl::queue &q,
@@ -98,8 +142,8 @@ sycl::event wg_model_reduction(sycl::queue &q,
   reduction::wg_model::group_horizontal_reducer<group_reduction_type>
       horizontal_reducer{
           group_reduction_type{main_kernel_local_mem, local_size}};
-  reduction::wg_hierarchical_reduction_engine engine{horizontal_reducer,
-                                                     &scratch_allocations};
+  reduction::wg_hierarchical_reduction_engine engine{
+      horizontal_reducer, &scratch_allocations, true};
 
   util::data_streamer streamer{q.get_device(), problem_size, local_size};
 
@@ -110,14 +154,34 @@ sycl::event wg_model_reduction(sycl::queue &q,
 
   auto main_kernel = engine.make_main_reducing_kernel(
       [=](sycl::nd_item<1> idx, auto &reducer) {
-
-        util::data_streamer::run(problem_size, idx, [&](sycl::id<1> i){
-          k(i, reducer);
-        });
+        if constexpr (decltype(operator_config)::has_known_identity()) {
+          util::data_streamer::run(problem_size, idx, [&](sycl::id<1> i){
+            k(i, reducer);
+          });
+        } else {
+          // Without identity, reducers need to track whether they have
+          // received a value; seeding them from the first element avoids
+          // checking this for every element.
+          using reducer_type = std::decay_t<decltype(reducer)>;
+          reduction::wg_model::seeding_reducer_view<reducer_type> seeding{
+              reducer};
+          reduction::wg_model::seeded_reducer_view<reducer_type> seeded{
+              reducer};
+          util::data_streamer::run_peeled(
+              problem_size, idx, [&](sycl::id<1> i) { k(i, seeding); },
+              [&](sycl::id<1> i) { k(i, seeded); });
+        }
       },
       plan);
 
+  // Single-pass reductions count finished groups
+  sycl::event counter_initialization;
+  if(plan[0].single_pass_counters)
+    counter_initialization = q.memset(plan[0].single_pass_counters, 0,
+                                      sizeof(unsigned) * plan[0].data_plan.size());
+
   last_event = q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(counter_initialization);
     sycl::local_accessor<char> acc{sycl::range<1>{main_kernel_local_mem}, cgh};
     cgh.parallel_for(sycl::nd_range<1>{dispatched_global_size, local_size},
                     main_kernel);
@@ -158,12 +222,28 @@ sycl::event threading_model_reduction(sycl::queue &q,
   reduction::threading_reduction_engine engine{thread_info_query,
                                                &scratch_allocations};
   auto plan = engine.create_plan(n, reduction_descriptor);
-  auto main_kernel = engine.make_main_reducing_kernel(k, plan);
-  
-  last_event = q.submit([&](sycl::handler &cgh) {
-    cgh.parallel_for(sycl::range<1>{n},
-                     main_kernel);
-  });
+
+  if constexpr (detail::is_vectorizable_reduction<T, BinaryReductionOp>::value) {
+    // Let each work item process a chunk of the input with independent
+    // accumulators instead of updating the per-thread result for each
+    // element.
+    auto main_kernel = engine.make_main_reducing_kernel(
+        reduction::threading_model::make_chunked_accumulation_kernel<
+            sycl::id<1>>(operator_config, n, k),
+        plan);
+    last_event = q.submit([&](sycl::handler &cgh) {
+      cgh.parallel_for(
+          sycl::range<1>{reduction::threading_model::get_num_chunks(n)},
+          main_kernel);
+    });
+  } else {
+    auto main_kernel = engine.make_main_reducing_kernel(k, plan);
+
+    last_event = q.submit([&](sycl::handler &cgh) {
+      cgh.parallel_for(sycl::range<1>{n},
+                       main_kernel);
+    });
+  }
 
   engine.run_additional_kernels(single_task_launcher, plan);
   
@@ -190,6 +270,40 @@ sycl::event transform_reduce_impl(sycl::queue &q,
 
 }
 
+template <class T, class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryTransformOp>
+sycl::event transform_scan_impl(sycl::queue &q,
+                                util::allocation_group &scratch_allocations,
+                                ForwardIt1 first, ForwardIt1 last,
+                                ForwardIt2 d_first, BinaryOp op,
+                                UnaryTransformOp transform, bool has_init,
+                                T init, bool is_inclusive) {
+  if(first == last)
+    return sycl::event{};
+
+  std::size_t n = std::distance(first, last);
+  auto load = [=](std::size_t i) -> T {
+    auto input = first;
+    std::advance(input, i);
+    return transform(*input);
+  };
+  auto store = [=](std::size_t i, const T& exclusive, const T& inclusive) {
+    auto output = d_first;
+    std::advance(output, i);
+    *output = is_inclusive ? inclusive : exclusive;
+  };
+
+  sycl::device dev = q.get_device();
+  if(dev.is_host()) {
+    std::size_t num_blocks =
+        dev.get_info<sycl::info::device::max_compute_units>() * 4;
+    return scanning::blocked_scan(q, scratch_allocations, n, op, has_init,
+                                  init, load, store, num_blocks);
+  }
+  return scanning::decoupled_lookback_scan(q, scratch_allocations, n, op,
+                                           has_init, init, load, store);
+}
+
 }
 
 // Note: All transform_reduce variants defined here behave slightly different than STL
@@ -272,6 +386,362 @@ sycl::event reduce(sycl::queue &q, util::allocation_group &scratch_allocations,
                 typename std::iterator_traits<ForwardIt>::value_type{});
 }
 
+// Note: For all scan variants, ForwardIt2 may be equal to ForwardIt1 to perform
+// an in-place scan.
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryTransformOp, class T>
+sycl::event transform_inclusive_scan(sycl::queue &q,
+                                     util::allocation_group &scratch_allocations,
+                                     ForwardIt1 first, ForwardIt1 last,
+                                     ForwardIt2 d_first, BinaryOp binary_op,
+                                     UnaryTransformOp unary_op, T init) {
+  return detail::transform_scan_impl<T>(q, scratch_allocations, first, last,
+                                        d_first, binary_op, unary_op, true,
+                                        init, true);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryTransformOp>
+sycl::event transform_inclusive_scan(sycl::queue &q,
+                                     util::allocation_group &scratch_allocations,
+                                     ForwardIt1 first, ForwardIt1 last,
+                                     ForwardIt2 d_first, BinaryOp binary_op,
+                                     UnaryTransformOp unary_op) {
+  using T = std::decay_t<std::invoke_result_t<
+      UnaryTransformOp,
+      typename std::iterator_traits<ForwardIt1>::reference>>;
+  return detail::transform_scan_impl<T>(q, scratch_allocations, first, last,
+                                        d_first, binary_op, unary_op, false,
+                                        T{}, true);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp,
+          class UnaryTransformOp>
+sycl::event transform_exclusive_scan(sycl::queue &q,
+                                     util::allocation_group &scratch_allocations,
+                                     ForwardIt1 first, ForwardIt1 last,
+                                     ForwardIt2 d_first, T init,
+                                     BinaryOp binary_op,
+                                     UnaryTransformOp unary_op) {
+  return detail::transform_scan_impl<T>(q, scratch_allocations, first, last,
+                                        d_first, binary_op, unary_op, true,
+                                        init, false);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp, class T>
+sycl::event inclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, BinaryOp binary_op, T init) {
+  return transform_inclusive_scan(q, scratch_allocations, first, last, d_first,
+                                  binary_op, [](auto x) { return x; }, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+sycl::event inclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, BinaryOp binary_op) {
+  using T = typename std::iterator_traits<ForwardIt1>::value_type;
+  return detail::transform_scan_impl<T>(q, scratch_allocations, first, last,
+                                        d_first, binary_op,
+                                        [](auto x) { return x; }, false, T{},
+                                        true);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+sycl::event inclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first) {
+  return inclusive_scan(q, scratch_allocations, first, last, d_first,
+                        std::plus<>{});
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp>
+sycl::event exclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, T init, BinaryOp binary_op) {
+  return transform_exclusive_scan(q, scratch_allocations, first, last, d_first,
+                                  init, binary_op, [](auto x) { return x; });
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+sycl::event exclusive_scan(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt1 first, ForwardIt1 last,
+                           ForwardIt2 d_first, T init) {
+  return exclusive_scan(q, scratch_allocations, first, last, d_first, init,
+                        std::plus<>{});
+}
+
+// Reduces the segments [first + offsets_first[s], first + offsets_first[s+1])
+// for all s < std::distance(offsets_first, offsets_last) - 1, e.g. the rows
+// of a CSR matrix, and stores the result for segment s, combined with init,
+// in d_first[s]. Empty segments produce init.
+template <class ForwardIt1, class OffsetIt, class ForwardIt2, class T,
+          class BinaryOp>
+sycl::event segmented_reduce(sycl::queue &q, ForwardIt1 first,
+                             OffsetIt offsets_first, OffsetIt offsets_last,
+                             ForwardIt2 d_first, T init, BinaryOp binary_op) {
+  std::size_t num_offsets = std::distance(offsets_first, offsets_last);
+  if(num_offsets < 2)
+    return sycl::event{};
+  const std::size_t num_segments = num_offsets - 1;
+
+  auto get_segment = [=](std::size_t s) {
+    auto offset = offsets_first;
+    std::advance(offset, s);
+    std::size_t begin = *offset;
+    ++offset;
+    return std::make_pair(begin, static_cast<std::size_t>(*offset));
+  };
+  auto load = [=](std::size_t i) -> T {
+    auto input = first;
+    std::advance(input, i);
+    return *input;
+  };
+  auto store = [=](std::size_t s, const T& result) {
+    auto output = d_first;
+    std::advance(output, s);
+    *output = result;
+  };
+
+  return reduction::segmented_reduction(
+      q, num_segments, detail::get_reduction_operator_configuration<T>(binary_op),
+      true, init, [=]() { return num_segments; }, get_segment, load, store);
+}
+
+template <class ForwardIt1, class OffsetIt, class ForwardIt2, class T>
+sycl::event segmented_reduce(sycl::queue &q, ForwardIt1 first,
+                             OffsetIt offsets_first, OffsetIt offsets_last,
+                             ForwardIt2 d_first, T init) {
+  return segmented_reduce(q, first, offsets_first, offsets_last, d_first, init,
+                          std::plus<T>{});
+}
+
+// For each group of consecutive equal keys in [keys_first, keys_last), stores
+// the key in keys_out and the reduction of the corresponding values in
+// values_out. If num_segments_out is not nullptr, the number of groups is
+// written to it. num_segments_out must be accessible from the device.
+template <class KeyIt, class ValueIt, class KeyOutIt, class ValueOutIt,
+          class BinaryPredicate, class BinaryOp>
+sycl::event reduce_by_key(sycl::queue &q,
+                          util::allocation_group &scratch_allocations,
+                          KeyIt keys_first, KeyIt keys_last,
+                          ValueIt values_first, KeyOutIt keys_out,
+                          ValueOutIt values_out,
+                          std::size_t *num_segments_out,
+                          BinaryPredicate key_equal, BinaryOp binary_op) {
+  using T = typename std::iterator_traits<ValueIt>::value_type;
+
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  std::size_t *offsets = scratch_allocations.obtain<std::size_t>(problem_size + 1);
+  std::size_t *num_segments = scratch_allocations.obtain<std::size_t>(1);
+
+  // Segment heads are found with a scan over the key boundaries, which
+  // yields the index of each segment and its offset.
+  auto load_head_flag = [=](std::size_t i) -> std::size_t {
+    if(i == 0)
+      return 1;
+    auto key = keys_first;
+    std::advance(key, i - 1);
+    auto previous = *key;
+    ++key;
+    return key_equal(previous, *key) ? 0 : 1;
+  };
+  auto store_head = [=](std::size_t i, std::size_t exclusive,
+                        std::size_t inclusive) {
+    if(inclusive != exclusive) {
+      auto key = keys_first;
+      auto output = keys_out;
+      std::advance(key, i);
+      std::advance(output, exclusive);
+      *output = *key;
+      offsets[exclusive] = i;
+    }
+    if(i == problem_size - 1) {
+      offsets[inclusive] = problem_size;
+      *num_segments = inclusive;
+      if(num_segments_out)
+        *num_segments_out = inclusive;
+    }
+  };
+  sycl::event head_evt = scanning::decoupled_lookback_scan(
+      q, scratch_allocations, problem_size, sycl::plus<std::size_t>{}, true,
+      std::size_t{0}, load_head_flag, store_head);
+
+  auto get_segment = [=](std::size_t s) {
+    return std::make_pair(offsets[s], offsets[s + 1]);
+  };
+  auto load = [=](std::size_t i) -> T {
+    auto input = values_first;
+    std::advance(input, i);
+    return *input;
+  };
+  auto store = [=](std::size_t s, const T& result) {
+    auto output = values_out;
+    std::advance(output, s);
+    *output = result;
+  };
+
+  // The number of segments is only known on the device, so the
+  // reduction is sized for the worst case of one segment per element.
+  return reduction::segmented_reduction(
+      q, problem_size, detail::get_reduction_operator_configuration<T>(binary_op),
+      false, T{}, [=]() { return *num_segments; }, get_segment, load, store,
+      head_evt);
+}
+
+template <class KeyIt, class ValueIt, class KeyOutIt, class ValueOutIt>
+sycl::event reduce_by_key(sycl::queue &q,
+                          util::allocation_group &scratch_allocations,
+                          KeyIt keys_first, KeyIt keys_last,
+                          ValueIt values_first, KeyOutIt keys_out,
+                          ValueOutIt values_out,
+                          std::size_t *num_segments_out = nullptr) {
+  using T = typename std::iterator_traits<ValueIt>::value_type;
+  return reduce_by_key(q, scratch_allocations, keys_first, keys_last,
+                       values_first, keys_out, values_out, num_segments_out,
+                       std::equal_to<>{}, std::plus<T>{});
+}
+
+// Adds the number of elements in [first, last) that fall into each bin to
+// bins[0], ..., bins[num_bins-1]. bin_index must return the bin of an element;
+// elements for which it returns a value >= num_bins are not counted.
+template <class ForwardIt, class Counter, class BinIndex>
+sycl::event histogram(sycl::queue &q,
+                      util::allocation_group &scratch_allocations,
+                      ForwardIt first, ForwardIt last, Counter *bins,
+                      std::size_t num_bins, BinIndex bin_index) {
+  std::size_t problem_size = std::distance(first, last);
+  auto load = [=](std::size_t i) {
+    auto input = first;
+    std::advance(input, i);
+    return *input;
+  };
+  return histogramming::privatized_histogram(q, scratch_allocations,
+                                             problem_size, bins, num_bins,
+                                             load, bin_index);
+}
+
+// Histogram with num_bins bins of equal width in [lower, upper). Elements
+// outside of this interval are not counted.
+template <class ForwardIt, class Counter, class T>
+sycl::event histogram_even(sycl::queue &q,
+                           util::allocation_group &scratch_allocations,
+                           ForwardIt first, ForwardIt last, Counter *bins,
+                           std::size_t num_bins, T lower, T upper) {
+  const double scale = static_cast<double>(num_bins) /
+                       (static_cast<double>(upper) - static_cast<double>(lower));
+  auto bin_index = [=](const auto &x) -> std::size_t {
+    if(!(x >= lower && x < upper))
+      return num_bins;
+    auto bin = static_cast<std::size_t>(
+        (static_cast<double>(x) - static_cast<double>(lower)) * scale);
+    // Guard against rounding up at the upper end of the interval
+    return bin < num_bins ? bin : num_bins - 1;
+  };
+  return histogram(q, scratch_allocations, first, last, bins, num_bins,
+                   bin_index);
+}
+
+namespace detail {
+
+template <std::size_t N, class T, class U, class BinaryOp>
+sycl::event adjacent_difference_packets(sycl::queue &q, const T *input,
+                                        U *output, std::size_t size,
+                                        BinaryOp op) {
+  using input_packet = util::packet<T, N>;
+  using output_packet = util::packet<U, N>;
+
+  auto difference = [=](std::size_t i) -> U {
+    return i == 0 ? U(input[0]) : U(op(input[i], input[i - 1]));
+  };
+
+  const std::size_t group_size = 128;
+  util::data_streamer streamer{q.get_device(),
+                               std::max(size / N, std::size_t{1}), group_size};
+  return q.parallel_for(
+      sycl::nd_range<1>{streamer.get_required_global_size(), group_size},
+      [=](sycl::nd_item<1> idx) {
+        util::data_streamer::run_packets<N>(
+            size, idx,
+            [&](sycl::id<1> i) {
+              // Only the predecessor of the first element is outside of the
+              // packet
+              input_packet in =
+                  *reinterpret_cast<const input_packet *>(input + i[0]);
+              output_packet out;
+              out.elements[0] = difference(i[0]);
+              for(std::size_t j = 1; j < N; ++j)
+                out.elements[j] = op(in.elements[j], in.elements[j - 1]);
+              *reinterpret_cast<output_packet *>(output + i[0]) = out;
+            },
+            [&](sycl::id<1> i) { output[i[0]] = difference(i[0]); });
+      });
+}
+
+}
+
+// Writes *first to *d_first, and op(*(first + i), *(first + i - 1)) to
+// *(d_first + i) for all 0 < i < std::distance(first, last). The input and
+// output ranges must not overlap.
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+sycl::event adjacent_difference(sycl::queue &q, ForwardIt1 first,
+                                ForwardIt1 last, ForwardIt2 d_first,
+                                BinaryOp op) {
+  if(first == last)
+    return sycl::event{};
+
+  using value_type1 = typename std::iterator_traits<ForwardIt1>::value_type;
+  using value_type2 = typename std::iterator_traits<ForwardIt2>::value_type;
+  constexpr std::size_t packet_size =
+      std::min(util::max_packet_size<value_type1>(),
+               util::max_packet_size<value_type2>());
+
+  const std::size_t problem_size = std::distance(first, last);
+  if constexpr (packet_size > 1 && util::is_contiguous<ForwardIt1>() &&
+                util::is_contiguous<ForwardIt2>()) {
+    const value_type1 *input = &(*first);
+    value_type2 *output = &(*d_first);
+    if (util::is_packet_aligned<value_type1, packet_size>(input) &&
+        util::is_packet_aligned<value_type2, packet_size>(output))
+      return detail::adjacent_difference_packets<packet_size>(
+          q, input, output, problem_size, op);
+  }
+
+  const std::size_t group_size = 128;
+  util::data_streamer streamer{q.get_device(), problem_size, group_size};
+  return q.parallel_for(
+      sycl::nd_range<1>{streamer.get_required_global_size(), group_size},
+      [=](sycl::nd_item<1> idx) {
+        util::data_streamer::run(problem_size, idx, [&](sycl::id<1> i) {
+          auto input = first;
+          auto output = d_first;
+          std::advance(input, i[0]);
+          std::advance(output, i[0]);
+          if(i[0] == 0) {
+            *output = *input;
+          } else {
+            auto previous = first;
+            std::advance(previous, i[0] - 1);
+            *output = op(*input, *previous);
+          }
+        });
+      });
+}
+
+template <class ForwardIt1, class ForwardIt2>
+sycl::event adjacent_difference(sycl::queue &q, ForwardIt1 first,
+                                ForwardIt1 last, ForwardIt2 d_first) {
+  return adjacent_difference(q, first, last, d_first, std::minus<>{});
+}
+
 }
 
 #endif
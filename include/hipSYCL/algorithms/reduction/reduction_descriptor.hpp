@@ -95,6 +95,57 @@ private:
   BinaryOp _op;
 };
 
+/// Value of a reduction over N elements at once, which are reduced
+/// element-wise. Has the same layout as T[N], such that the final result
+/// can be written to the user's array directly.
+template<class T, std::size_t N>
+struct reduction_array {
+  T data[N];
+};
+
+/// Operator of reductions over N elements, applying BinaryOp
+/// element-wise. Requires an identity, since work items usually only
+/// contribute to some of the elements.
+template<class T, std::size_t N, class BinaryOp>
+struct array_reduction_binary_operator {
+  array_reduction_binary_operator(BinaryOp op, const T& identity) noexcept
+  : _op{op}, _identity{identity} {}
+
+  using value_type = reduction_array<T, N>;
+  using element_type = T;
+  using binary_operation = BinaryOp;
+  static constexpr std::size_t num_elements = N;
+
+  static constexpr bool has_known_identity() noexcept { return true; }
+
+  value_type operator()(const value_type& a, const value_type& b) const noexcept {
+    value_type result;
+    for(std::size_t i = 0; i < N; ++i)
+      result.data[i] = _op(a.data[i], b.data[i]);
+    return result;
+  }
+
+  void combine_element(value_type& current, std::size_t index,
+                       const T& x) const noexcept {
+    current.data[index] = _op(current.data[index], x);
+  }
+
+  value_type get_identity() const noexcept {
+    value_type result;
+    for(std::size_t i = 0; i < N; ++i)
+      result.data[i] = _identity;
+    return result;
+  }
+
+  T get_element_identity() const noexcept {
+    return _identity;
+  }
+
+private:
+  BinaryOp _op;
+  T _identity;
+};
+
 /// In addition to the operator, provides information about
 /// the reduction as configured by the user. This object
 /// will be provided by the user.
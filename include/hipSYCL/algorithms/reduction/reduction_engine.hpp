@@ -69,7 +69,8 @@ auto configure_descriptor(
       data_plan.is_output_initialized,
       static_cast<value_type*>(data_plan.stage_input),
       static_cast<value_type*>(data_plan.stage_output),
-      global_size};
+      global_size,
+      data_plan.single_pass_counter};
 }
 
 template <class ReductionDescriptor>
@@ -117,6 +118,11 @@ template<class GroupHorizontalReducer>
 class wg_hierarchical_reduction_engine {
   GroupHorizontalReducer _reducer;
   util::allocation_group* _scratch_allocations;
+  bool _allow_single_pass;
+
+  // Upper bound for the number of partial results that each work item
+  // of the last group combines in single-pass reductions
+  static constexpr std::size_t max_single_pass_values_per_work_item = 16;
 
   using reduction_stage_type = wg_model::reduction_stage<GroupHorizontalReducer>;
 
@@ -153,7 +159,8 @@ class wg_hierarchical_reduction_engine {
           [=](auto... wi_reducers) {
             k(direct_kernel_args..., wi_reducers...);
             auto wi_index = detail::get_first(direct_kernel_args...);
-            (group_reducer.finalize(wi_index, descriptors, wi_reducers), ...);
+            group_reducer.finalize_all(wi_index, std::tie(descriptors...),
+                                       std::tie(wi_reducers...));
           },
           group_reducer.generate_wi_reducer(descriptors)...);
     };
@@ -162,7 +169,7 @@ class wg_hierarchical_reduction_engine {
   }
 
   template <class WiIndex, class ConfiguredReductionDescriptor>
-  static void execute_dedicated_reduction(
+  static auto load_dedicated_reduction_input(
       WiIndex wi_index, const GroupHorizontalReducer &group_reducer,
       const ConfiguredReductionDescriptor &descriptor) {
     
@@ -175,7 +182,7 @@ class wg_hierarchical_reduction_engine {
         wi_reducer.combine(descriptor.get_stage_input()[my_id]);
       }
     }
-    group_reducer.finalize(wi_index, descriptor, wi_reducer);
+    return wi_reducer;
   }
 
   template <typename... ConfiguredReductionDescriptors>
@@ -183,8 +190,15 @@ class wg_hierarchical_reduction_engine {
       const GroupHorizontalReducer &group_reducer,
       const ConfiguredReductionDescriptors &...inputs) {
 
+    auto with_unpacked_pack_by_value = [](auto f, auto... args) { f(args...); };
+
     auto kernel = [=](auto first_arg, auto &&...direct_kernel_args) {
-      (execute_dedicated_reduction(first_arg, group_reducer, inputs), ...);
+      with_unpacked_pack_by_value(
+          [&](auto... wi_reducers) {
+            group_reducer.finalize_all(first_arg, std::tie(inputs...),
+                                       std::tie(wi_reducers...));
+          },
+          load_dedicated_reduction_input(first_arg, group_reducer, inputs)...);
     };
 
     return kernel;
@@ -231,11 +245,17 @@ class wg_hierarchical_reduction_engine {
     }
   }
 public:
+  /// If \c allow_single_pass is true, reductions whose group results
+  /// can be combined by a single group are completed by the last group of the
+  /// main kernel instead of by additional kernels. This requires nd_item
+  /// kernels, and the single_pass_counters of the first stage of the plan
+  /// must be zeroed before the main kernel is launched.
   wg_hierarchical_reduction_engine(
       const GroupHorizontalReducer &horizontal_reducer,
-      util::allocation_group *scratch_allocation_group)
+      util::allocation_group *scratch_allocation_group,
+      bool allow_single_pass = false)
       : _scratch_allocations{scratch_allocation_group},
-        _reducer{horizontal_reducer} {}
+        _reducer{horizontal_reducer}, _allow_single_pass{allow_single_pass} {}
 
 
   /// Create reduction plan.
@@ -270,8 +290,11 @@ public:
     common::auto_small_vector<reduction_stage_type> additional_plan;
     
     std::size_t num_groups = detail::ceil_division(global_size, wg_size);
+    const bool is_single_pass =
+        _allow_single_pass && num_groups > 1 && wg_size > 1 &&
+        num_groups <= wg_size * max_single_pass_values_per_work_item;
     // if we only have a single group, we are already done.
-    if(num_groups > 1)
+    if(num_groups > 1 && !is_single_pass)
       determine_stages(num_groups, reduction_wg_size, additional_plan);
   
 
@@ -289,8 +312,32 @@ public:
         stage.data_plan[reduction].is_output_initialized = nullptr;
         stage.data_plan[reduction].stage_input = nullptr;
         stage.data_plan[reduction].stage_output = nullptr;
+        stage.data_plan[reduction].single_pass_counter = nullptr;
       }
     }
+
+    if(is_single_pass) {
+      auto &stage = result_plan[0];
+      stage.single_pass_counters =
+          _scratch_allocations->obtain<unsigned>(num_reductions);
+
+      detail::enumerate_pack(
+          [&](std::size_t reduction_index, const auto &descriptor) {
+            using value_type =
+                typename std::decay_t<decltype(descriptor)>::value_type;
+
+            auto &data = stage.data_plan[reduction_index];
+            data.stage_output =
+                _scratch_allocations->obtain<value_type>(num_groups);
+            if (!descriptor.has_known_identity())
+              data.is_output_initialized =
+                  _scratch_allocations->obtain<initialization_flag_t>(
+                      num_groups);
+            data.single_pass_counter =
+                stage.single_pass_counters + reduction_index;
+          },
+          descriptors...);
+    }
     
     // If we only need the main kernel for the reduction, no scratch is needed.
     if(result_plan.size() > 1) {
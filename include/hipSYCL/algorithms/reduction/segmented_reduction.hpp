@@ -0,0 +1,272 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REDUCTION_SEGMENTED_REDUCTION_HPP
+#define HIPSYCL_REDUCTION_SEGMENTED_REDUCTION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hipSYCL/sycl/libkernel/accessor.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "reduction_descriptor.hpp"
+#include "wg_model/group_reduction_algorithms.hpp"
+#include "wg_model/wi_reducer.hpp"
+
+namespace hipsycl::algorithms::reduction {
+
+namespace detail {
+
+enum class segment_kind : std::uint32_t {
+  none = 0,
+  sub_group = 1,
+  work_group = 2
+};
+
+// Segments with at most this many elements are reduced by a single work item
+constexpr std::size_t segmented_reduction_work_item_threshold = 8;
+// Segments with at most this many elements per sub-group lane are reduced by
+// a sub-group; longer segments by the entire work group.
+constexpr std::size_t segmented_reduction_sub_group_threshold = 16;
+
+template <class OperatorConfig>
+auto finalize_segment(const OperatorConfig &op, bool has_init,
+                      typename OperatorConfig::value_type init,
+                      const wg_model::sequential_reducer<OperatorConfig> &acc,
+                      bool is_initialized) {
+  if(!has_init)
+    return acc.value();
+  if(is_initialized)
+    return op(init, acc.value());
+  return init;
+}
+
+template <class OperatorConfig, class Load>
+auto accumulate_strided(const OperatorConfig &op, std::size_t begin,
+                        std::size_t end, std::size_t stride, Load load) {
+  wg_model::sequential_reducer<OperatorConfig> acc{op};
+  for(std::size_t i = begin; i < end; i += stride)
+    acc.combine(load(i));
+  return acc;
+}
+
+// Tree reduction within a sub-group through local memory. scratch
+// and init_scratch point to the entries of the sub-group.
+template <class OperatorConfig>
+wg_model::sequential_reducer<OperatorConfig>
+sub_group_reduce(sycl::sub_group sg, const OperatorConfig &op,
+                 typename OperatorConfig::value_type *scratch,
+                 initialization_flag_t *init_scratch,
+                 const wg_model::sequential_reducer<OperatorConfig> &acc,
+                 bool &is_initialized) {
+  const std::size_t lid = sg.get_local_linear_id();
+  const std::size_t sg_size = sg.get_local_linear_range();
+
+  scratch[lid] = acc.value();
+  init_scratch[lid] = acc.is_initialized();
+  sycl::group_barrier(sg);
+
+  for(std::size_t i = sg_size / 2; i > 0; i /= 2) {
+    if(lid < i) {
+      if(init_scratch[lid] && init_scratch[lid + i]) {
+        scratch[lid] = op(scratch[lid], scratch[lid + i]);
+      } else if(init_scratch[lid + i]) {
+        scratch[lid] = scratch[lid + i];
+        init_scratch[lid] = true;
+      }
+    }
+    sycl::group_barrier(sg);
+  }
+
+  is_initialized = init_scratch[0];
+  wg_model::sequential_reducer<OperatorConfig> result{op};
+  if(is_initialized)
+    result.combine(scratch[0]);
+  sycl::group_barrier(sg);
+  return result;
+}
+
+} // detail
+
+/// Reduces each of the segments [get_segment(s).first, get_segment(s).second)
+/// of the input for s < get_num_segments() independently.
+///
+/// On devices, work group g is responsible for the segments
+/// [g * group_size, (g+1) * group_size). Short segments are reduced
+/// by individual work items, medium-sized segments by a sub-group, and long
+/// segments by the entire work group, such that distributions with very
+/// differently sized segments do not leave most work items idle.
+/// On host devices, each segment is reduced by a single work item.
+///
+/// \c get_num_segments() is evaluated in the kernel and may return less than
+/// \c max_num_segments, which is used to size the kernel launch. This allows
+/// using segment counts that are computed by preceding kernels.
+/// \c get_segment must be a callable of type
+/// std::pair<std::size_t, std::size_t>(std::size_t s), \c load of type
+/// T(std::size_t i) returning the i-th input element, and \c store of type
+/// void(std::size_t s, T result). If \c has_init is true, \c init is combined
+/// with the result of each segment, and empty segments produce \c init.
+/// Otherwise, the result of empty segments is unspecified.
+template <class OperatorConfig, class SegmentCount, class SegmentBounds,
+          class Load, class Store>
+sycl::event
+segmented_reduction(sycl::queue &q, std::size_t max_num_segments,
+                    const OperatorConfig &op, bool has_init,
+                    typename OperatorConfig::value_type init,
+                    SegmentCount get_num_segments, SegmentBounds get_segment,
+                    Load load, Store store,
+                    sycl::event dependency = sycl::event{},
+                    std::size_t group_size = 128) {
+  using T = typename OperatorConfig::value_type;
+
+  if(max_num_segments == 0)
+    return sycl::event{};
+
+  if(q.get_device().is_host()) {
+    return q.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(dependency);
+      cgh.parallel_for(sycl::range<1>{max_num_segments}, [=](sycl::id<1> idx) {
+        const std::size_t s = idx[0];
+        if(s >= get_num_segments())
+          return;
+        auto bounds = get_segment(s);
+        auto acc = detail::accumulate_strided(op, bounds.first, bounds.second,
+                                              1, load);
+        store(s, detail::finalize_segment(op, has_init, init, acc,
+                                          acc.is_initialized()));
+      });
+    });
+  }
+
+  using descriptor_type = reduction_descriptor<OperatorConfig, T *>;
+  using group_reduction_type =
+      wg_model::group_reductions::generic_local_memory<descriptor_type>;
+  using local_bundle_type =
+      wg_model::group_reductions::local_memory_request_bundle<T>;
+  using local_flag_bundle_type = wg_model::group_reductions::
+      local_memory_request_bundle<initialization_flag_t>;
+  using local_kind_bundle_type =
+      wg_model::group_reductions::local_memory_request_bundle<std::uint32_t>;
+
+  std::size_t local_mem = 0;
+  group_reduction_type group_reduction{local_mem, group_size};
+  local_bundle_type sub_group_scratch{local_mem, group_size};
+  local_flag_bundle_type sub_group_init_scratch{local_mem, group_size};
+  local_kind_bundle_type segment_kinds{local_mem, group_size};
+
+  descriptor_type descriptor{op, nullptr};
+  const std::size_t num_groups =
+      (max_num_segments + group_size - 1) / group_size;
+
+  return q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(dependency);
+    // Only registers the local memory; it is accessed through the
+    // local memory bundles.
+    sycl::local_accessor<char> acc{sycl::range<1>{local_mem}, cgh};
+
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_groups * group_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_linear_id();
+          const std::size_t tile_begin = idx.get_group_linear_id() * group_size;
+          const std::size_t num_segments = get_num_segments();
+
+          auto *kinds =
+              static_cast<std::uint32_t *>(segment_kinds.get_device_address());
+
+          auto sg = idx.get_sub_group();
+          const std::size_t sg_size = sg.get_local_linear_range();
+          const std::size_t sg_lid = sg.get_local_linear_id();
+          const std::size_t num_sub_groups = sg.get_group_linear_range();
+          const std::size_t sg_id = sg.get_group_linear_id();
+
+          // Classify the segments of this tile, and reduce the short ones
+          // right away.
+          detail::segment_kind kind = detail::segment_kind::none;
+          const std::size_t my_segment = tile_begin + lid;
+          if(my_segment < num_segments) {
+            auto bounds = get_segment(my_segment);
+            const std::size_t length = bounds.second - bounds.first;
+            if(length <= detail::segmented_reduction_work_item_threshold) {
+              auto acc = detail::accumulate_strided(op, bounds.first,
+                                                    bounds.second, 1, load);
+              store(my_segment, detail::finalize_segment(
+                                    op, has_init, init, acc,
+                                    acc.is_initialized()));
+            } else if(length <=
+                      detail::segmented_reduction_sub_group_threshold *
+                          sg_size) {
+              kind = detail::segment_kind::sub_group;
+            } else {
+              kind = detail::segment_kind::work_group;
+            }
+          }
+          kinds[lid] = static_cast<std::uint32_t>(kind);
+          sycl::group_barrier(idx.get_group());
+
+          // Medium-sized segments are distributed across sub-groups
+          T *sg_scratch =
+              static_cast<T *>(sub_group_scratch.get_device_address()) +
+              sg_id * sg.get_max_local_range()[0];
+          initialization_flag_t *sg_init_scratch =
+              static_cast<initialization_flag_t *>(
+                  sub_group_init_scratch.get_device_address()) +
+              sg_id * sg.get_max_local_range()[0];
+
+          for(std::size_t i = sg_id; i < group_size; i += num_sub_groups) {
+            if(kinds[i] != static_cast<std::uint32_t>(
+                               detail::segment_kind::sub_group))
+              continue;
+            auto bounds = get_segment(tile_begin + i);
+            auto acc = detail::accumulate_strided(
+                op, bounds.first + sg_lid, bounds.second, sg_size, load);
+            bool is_initialized = false;
+            auto sg_acc = detail::sub_group_reduce(
+                sg, op, sg_scratch, sg_init_scratch, acc, is_initialized);
+            if(sg_lid == 0)
+              store(tile_begin + i, detail::finalize_segment(
+                                        op, has_init, init, sg_acc,
+                                        is_initialized));
+          }
+
+          // Long segments are processed one after another by the
+          // entire work group
+          for(std::size_t i = 0; i < group_size; ++i) {
+            if(kinds[i] != static_cast<std::uint32_t>(
+                               detail::segment_kind::work_group))
+              continue;
+            auto bounds = get_segment(tile_begin + i);
+            auto acc = detail::accumulate_strided(
+                op, bounds.first + lid, bounds.second, group_size, load);
+
+            bool is_leader = false;
+            bool is_initialized = false;
+            T result = group_reduction(idx, descriptor, acc, is_leader,
+                                       is_initialized);
+            if(is_leader) {
+              wg_model::sequential_reducer<OperatorConfig> group_acc{op};
+              if(is_initialized)
+                group_acc.combine(result);
+              store(tile_begin + i, detail::finalize_segment(
+                                        op, has_init, init, group_acc,
+                                        is_initialized));
+            }
+            // The local memory of the group reduction is reused
+            // for the next segment
+            sycl::group_barrier(idx.get_group());
+          }
+        });
+  });
+}
+
+} // namespace hipsycl::algorithms::reduction
+
+#endif
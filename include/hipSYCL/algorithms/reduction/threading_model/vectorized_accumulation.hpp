@@ -0,0 +1,105 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REDUCTION_THREADING_VECTORIZED_ACCUMULATION_HPP
+#define HIPSYCL_REDUCTION_THREADING_VECTORIZED_ACCUMULATION_HPP
+
+#include <cstddef>
+
+#include "cache_line.hpp"
+
+namespace hipsycl::algorithms::reduction::threading_model {
+
+/// Reducer that accumulates into a value owned by the caller, typically a
+/// local variable. Requires an operator with known identity.
+template <class ReductionBinaryOp> class local_accumulator_reducer {
+public:
+  using operator_type = ReductionBinaryOp;
+  using value_type = typename ReductionBinaryOp::value_type;
+
+  local_accumulator_reducer(const ReductionBinaryOp &op,
+                            value_type *accumulator) noexcept
+      : _op{op}, _accumulator{accumulator} {}
+
+  void combine(const value_type &val) noexcept {
+    *_accumulator = _op(*_accumulator, val);
+  }
+
+private:
+  ReductionBinaryOp _op;
+  value_type *_accumulator;
+};
+
+/// Number of independent accumulators used per work item; together they
+/// fill one cache line, which is enough to saturate the SIMD units
+/// without the loop-carried dependency on a single accumulator.
+template <class T>
+constexpr std::size_t num_vector_accumulators =
+    sizeof(T) >= cache_line_size ? 1 : cache_line_size / sizeof(T);
+
+/// Number of elements processed by one work item of a chunked kernel
+constexpr std::size_t vectorized_chunk_size = 4096;
+
+/// Wraps a kernel of the form k(sycl::id<1>, reducer) such that each work
+/// item of the returned kernel processes vectorized_chunk_size consecutive
+/// elements. Element i + l of each block of num_vector_accumulators elements
+/// is combined into accumulator l, so the inner loop can be mapped onto
+/// vector registers by the compiler. The accumulators are only combined
+/// into the reducer of the work item at the end of the chunk.
+///
+/// This changes the order in which elements are combined, and hence may
+/// change the result of non-associative operations.
+///
+/// The returned kernel must be launched with get_num_chunks(n) work items.
+template <class IndexType, class ReductionBinaryOp, class Kernel>
+auto make_chunked_accumulation_kernel(const ReductionBinaryOp &op,
+                                      std::size_t problem_size, Kernel k) {
+  using value_type = typename ReductionBinaryOp::value_type;
+  constexpr std::size_t num_accumulators =
+      num_vector_accumulators<value_type>;
+
+  return [=](IndexType chunk, auto &reducer) {
+    const std::size_t begin = chunk[0] * vectorized_chunk_size;
+    const std::size_t end = (problem_size - begin < vectorized_chunk_size)
+                                ? problem_size
+                                : begin + vectorized_chunk_size;
+
+    value_type accumulators[num_accumulators];
+    for (std::size_t l = 0; l < num_accumulators; ++l)
+      accumulators[l] = op.get_identity();
+
+    std::size_t i = begin;
+    for (; i + num_accumulators <= end; i += num_accumulators) {
+      for (std::size_t l = 0; l < num_accumulators; ++l) {
+        local_accumulator_reducer<ReductionBinaryOp> lane_reducer{
+            op, &accumulators[l]};
+        k(IndexType{i + l}, lane_reducer);
+      }
+    }
+    for (; i < end; ++i) {
+      local_accumulator_reducer<ReductionBinaryOp> lane_reducer{
+          op, &accumulators[0]};
+      k(IndexType{i}, lane_reducer);
+    }
+
+    value_type result = accumulators[0];
+    for (std::size_t l = 1; l < num_accumulators; ++l)
+      result = op(result, accumulators[l]);
+    reducer.combine(result);
+  };
+}
+
+inline std::size_t get_num_chunks(std::size_t problem_size) {
+  return (problem_size + vectorized_chunk_size - 1) / vectorized_chunk_size;
+}
+
+}
+
+#endif
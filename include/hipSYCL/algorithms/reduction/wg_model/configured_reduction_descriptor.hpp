@@ -40,17 +40,29 @@ public:
       // Output of the stage. If nullptr, assumes final stage & overall
       // reduction output
       typename ReductionDescriptor::value_type *stage_output,
-      std::size_t problem_size)
+      std::size_t problem_size,
+      // Counter of finished groups for single-pass reductions, where
+      // stage_output holds the partial results of all groups. nullptr
+      // otherwise.
+      unsigned *single_pass_counter = nullptr)
       : ReductionDescriptor{basic_descriptor},
         _is_input_initialized{is_input_initialized},
         _is_output_initialized{is_output_initialized},
         _stage_input{stage_input}, _stage_output{stage_output},
-        _problem_size{problem_size} {}
+        _problem_size{problem_size}, _single_pass_counter{single_pass_counter} {}
 
   bool is_final_stage() const noexcept {
     return !_stage_output;
   }
 
+  bool is_single_pass() const noexcept {
+    return _single_pass_counter;
+  }
+
+  unsigned *get_single_pass_counter() const noexcept {
+    return _single_pass_counter;
+  }
+
   initialization_flag_t *get_input_initialization_state() const noexcept {
     return _is_input_initialized;
   }
@@ -77,6 +89,7 @@ private:
   typename ReductionDescriptor::value_type *_stage_input;
   typename ReductionDescriptor::value_type *_stage_output;
   std::size_t _problem_size;
+  unsigned *_single_pass_counter;
 };
 
 }
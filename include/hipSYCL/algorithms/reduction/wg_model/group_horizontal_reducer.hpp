@@ -11,11 +11,17 @@
 #ifndef HIPSYCL_REDUCTION_GROUP_HORIZONTAL_REDUCER_HPP
 #define HIPSYCL_REDUCTION_GROUP_HORIZONTAL_REDUCER_HPP
 
+#include <tuple>
+#include <utility>
 #include <vector>
 
+#include "hipSYCL/sycl/libkernel/atomic_ref.hpp"
+#include "hipSYCL/sycl/libkernel/detail/mem_fence.hpp"
+
 #include "../reduction_descriptor.hpp"
 #include "wi_reducer.hpp"
 #include "wg_model_queries.hpp"
+#include "group_reduction_algorithms.hpp"
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -61,6 +67,66 @@ public:
     bool result_is_initialized;
     value_type group_result = _group_reduction(
         wi, descriptor, work_item_reducer, is_leader, result_is_initialized);
+
+    store_group_result(wi, descriptor, group_result, is_leader,
+                       result_is_initialized);
+  }
+
+  // Like finalize(), but for all reductions of a kernel. If the group
+  // reduction algorithm supports it, the group results of all reductions
+  // are computed together, such that the group only passes through
+  // one reduction tree.
+  //
+  // DescriptorTuple and WorkItemReducerTuple are tuples of references to the
+  // configured reduction descriptors and the corresponding work item
+  // reducers, e.g. as created by std::tie().
+  //
+  // Note: Assumes that all threads in the group enter this function!
+  template <class WiIndex, class DescriptorTuple, class WorkItemReducerTuple>
+  void finalize_all(const WiIndex &wi, const DescriptorTuple &descriptors,
+                    const WorkItemReducerTuple &work_item_reducers) const {
+    constexpr std::size_t num_reductions = std::tuple_size_v<DescriptorTuple>;
+
+    if constexpr (GroupReductionAlgorithm::is_fused()) {
+      bool is_leader;
+      auto group_results = _group_reduction.reduce_fused(
+          wi, descriptors, work_item_reducers, is_leader);
+      for_each_reduction<num_reductions>([&](auto i) {
+        store_group_result(wi, std::get<i>(descriptors),
+                           std::get<i>(group_results), is_leader, true);
+      });
+    } else {
+      for_each_reduction<num_reductions>([&](auto i) {
+        finalize(wi, std::get<i>(descriptors), std::get<i>(work_item_reducers));
+      });
+    }
+  }
+
+private:
+  template <std::size_t N, class F>
+  static void for_each_reduction(F &&f) {
+    for_each_reduction(f, std::make_index_sequence<N>{});
+  }
+
+  template <class F, std::size_t... Is>
+  static void for_each_reduction(F &&f, std::index_sequence<Is...>) {
+    (f(std::integral_constant<std::size_t, Is>{}), ...);
+  }
+
+  template <class WiIndex, class ConfiguredReductionDescriptor>
+  void store_group_result(
+      const WiIndex &wi, const ConfiguredReductionDescriptor &descriptor,
+      typename ConfiguredReductionDescriptor::value_type group_result,
+      bool is_leader, bool result_is_initialized) const {
+    using value_type = typename ConfiguredReductionDescriptor::value_type;
+
+    if constexpr (has_group_object<WiIndex>::value) {
+      if (descriptor.is_single_pass()) {
+        finalize_single_pass(wi, descriptor, group_result, is_leader,
+                             result_is_initialized);
+        return;
+      }
+    }
      
     if(is_leader) {
       if(descriptor.is_final_stage()) {
@@ -79,7 +145,57 @@ public:
     }
   }
 
-private:
+  // Stores the group result, and lets the last group to finish combine the
+  // results of all groups. This avoids launching additional kernels.
+  template <class WiIndex, class ConfiguredReductionDescriptor>
+  void finalize_single_pass(
+      const WiIndex &wi, const ConfiguredReductionDescriptor &descriptor,
+      typename ConfiguredReductionDescriptor::value_type group_result,
+      bool is_leader, bool result_is_initialized) const {
+    using value_type = typename ConfiguredReductionDescriptor::value_type;
+
+    value_type *partial_results = descriptor.get_stage_output();
+    initialization_flag_t *is_initialized =
+        descriptor.get_output_initialization_state();
+    const std::size_t num_groups = get_num_groups(wi);
+
+    bool is_last_group = false;
+    if(is_leader) {
+      std::size_t group_id = get_group_linear_id(wi);
+      partial_results[group_id] = group_result;
+      if constexpr (!ConfiguredReductionDescriptor::has_known_identity()){
+        is_initialized[group_id] = result_is_initialized;
+      }
+      // Publishes the partial result, and acquires those of all groups
+      // that have finished before.
+      sycl::atomic_ref<unsigned, sycl::memory_order::acq_rel,
+                       sycl::memory_scope::device,
+                       sycl::access::address_space::global_space>
+          counter{*descriptor.get_single_pass_counter()};
+      is_last_group = (counter.fetch_add(1u) == num_groups - 1);
+    }
+
+    if(!any_of_group(wi, is_last_group))
+      return;
+    sycl::detail::mem_fence<sycl::access::fence_space::global_space>();
+
+    auto wi_reducer = generate_wi_reducer(descriptor);
+    for (std::size_t i = get_local_linear_id(wi); i < num_groups;
+         i += get_local_size(wi)) {
+      if (ConfiguredReductionDescriptor::has_known_identity() ||
+          is_initialized[i])
+        wi_reducer.combine(partial_results[i]);
+    }
+
+    // The group reduction reuses its local memory
+    group_reductions::local_barrier(wi);
+    value_type result = _group_reduction(wi, descriptor, wi_reducer, is_leader,
+                                         result_is_initialized);
+    if(is_leader)
+      reduction::detail::set_reduction_result(descriptor, result,
+                                              result_is_initialized);
+  }
+
   GroupReductionAlgorithm _group_reduction;
 };
 
@@ -8,6 +8,11 @@
  * See file LICENSE in the project root for full license details.
  */
 // SPDX-License-Identifier: BSD-2-Clause
+#include <algorithm>
+#include <array>
+#include <tuple>
+#include <utility>
+
 #include "hipSYCL/sycl/libkernel/detail/local_memory_allocator.hpp"
 #include "hipSYCL/sycl/libkernel/group_functions.hpp"
 
@@ -85,8 +90,30 @@ private:
 template<typename... ReductionDescriptors>
 class generic_local_memory {
 private:
+  static constexpr std::size_t num_reductions = sizeof...(ReductionDescriptors);
 
   void initialize(std::size_t& allocated_local_mem) {
+    if constexpr (is_fused()) {
+      // One local memory array per reduction, all within one allocation.
+      std::size_t size = 0;
+      std::size_t max_align = 4;
+      std::size_t reduction_index = 0;
+      auto add_array = [&](auto value) {
+        using value_type = decltype(value);
+        size = (size + alignof(value_type) - 1) / alignof(value_type) *
+               alignof(value_type);
+        _fused_offsets[reduction_index++] = size;
+        size += sizeof(value_type) * _group_size;
+        max_align = std::max(max_align, alignof(value_type));
+      };
+      (add_array(typename ReductionDescriptors::value_type{}), ...);
+
+      sycl::detail::local_memory_allocator alloc{allocated_local_mem};
+      _addr = alloc.alloc(max_align, size);
+      allocated_local_mem = alloc.get_allocation_size();
+      return;
+    }
+
     local_memory_request_bundle<typename ReductionDescriptors::value_type...> request{
         allocated_local_mem, _group_size};
     _addr = request.get_address();
@@ -101,6 +128,14 @@ private:
     }
   }
 public:
+  // Multiple reductions with known identities are reduced together in
+  // one tree, such that each level of the tree requires only one barrier
+  // for all reductions.
+  static constexpr bool is_fused() {
+    return num_reductions > 1 &&
+           (ReductionDescriptors::has_known_identity() && ...);
+  }
+
   generic_local_memory() = default;
   generic_local_memory(std::size_t& currently_allocated_local_mem_size, std::size_t group_size)
   : _group_size{group_size} {
@@ -190,10 +225,63 @@ public:
     
   }
 
+  // Only available if is_fused() is true. DescriptorTuple and WiReducerTuple
+  // are tuples of references to the configured descriptors of all
+  // reductions and their work item reducers. Returns a tuple of the group
+  // results of all reductions.
+  template <class WiIndex, class DescriptorTuple, class WiReducerTuple>
+  auto reduce_fused(const WiIndex &wi, const DescriptorTuple &descriptors,
+                    const WiReducerTuple &wi_reducers, bool &is_leader) const {
+    return reduce_fused(wi, descriptors, wi_reducers, is_leader,
+                        std::make_index_sequence<num_reductions>{});
+  }
+
 private:
+  template <class WiIndex, class DescriptorTuple, class WiReducerTuple,
+            std::size_t... Is>
+  auto reduce_fused(const WiIndex &wi, const DescriptorTuple &descriptors,
+                    const WiReducerTuple &wi_reducers, bool &is_leader,
+                    std::index_sequence<Is...>) const {
+    static_assert(is_fused());
+    static_assert(std::tuple_size_v<DescriptorTuple> == num_reductions);
+
+    std::size_t my_lid = get_local_linear_id(wi);
+    is_leader = (my_lid == 0);
+
+    char *local_memory = static_cast<char *>(
+        local_memory_request_bundle<>::get_device_address(_addr));
+    auto local_array = [&](auto reduction_index) {
+      using value_type = typename std::decay_t<std::tuple_element_t<
+          decltype(reduction_index)::value, DescriptorTuple>>::value_type;
+      return reinterpret_cast<value_type *>(
+          local_memory + _fused_offsets[reduction_index]);
+    };
+
+    ((local_array(std::integral_constant<std::size_t, Is>{})[my_lid] =
+          std::get<Is>(wi_reducers).value()),
+     ...);
+    local_barrier(wi);
+
+    const int local_size = _group_size;
+    for (int i = local_size / 2; i > 0; i /= 2) {
+      if (my_lid < i) {
+        ([&](auto *data) {
+          data[my_lid] =
+              std::get<Is>(descriptors).get_operator()(data[my_lid],
+                                                       data[my_lid + i]);
+        }(local_array(std::integral_constant<std::size_t, Is>{})),
+         ...);
+      }
+      local_barrier(wi);
+    }
+    return std::make_tuple(
+        local_array(std::integral_constant<std::size_t, Is>{})[0]...);
+  }
+
   sycl::detail::local_memory_allocator::address _addr;
   sycl::detail::local_memory_allocator::address _init_state_addr;
   std::size_t _group_size;
+  std::array<std::size_t, num_reductions> _fused_offsets;
 };
 
 } // namespace hipsycl::algorithms::reduction::wg_model::group_reductions
@@ -22,6 +22,9 @@ struct reduction_stage_data {
   initialization_flag_t *is_output_initialized;
   void *stage_input;
   void *stage_output;
+  // If set, the stage output holds partial results of all groups, and the
+  // last group to finish combines them into the final result.
+  unsigned *single_pass_counter;
 };
 
 template<class HorizontalReducer>
@@ -40,6 +43,9 @@ struct reduction_stage {
   // for dedicated reduction kernel launches. reducers may
   // overwrite this during setup.
   std::size_t local_mem = 0;
+  // Counters of single-pass reductions, one per reduction, or nullptr.
+  // These must be zero-initialized before the stage is launched.
+  unsigned *single_pass_counters = nullptr;
 };
 
 }
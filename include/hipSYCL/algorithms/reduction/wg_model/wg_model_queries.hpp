@@ -15,6 +15,9 @@
 #include "hipSYCL/sycl/libkernel/detail/data_layout.hpp"
 #include "hipSYCL/sycl/libkernel/nd_item.hpp"
 #include "hipSYCL/sycl/libkernel/group.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+
+#include <type_traits>
 
 namespace hipsycl::algorithms::reduction::wg_model {
 
@@ -70,6 +73,46 @@ std::size_t get_local_linear_id(sycl::group<Dim> idx) {
   return idx.get_local_linear_id();
 }
 
+/// Whether group collectives are available for a work item index type
+template<class WiIndex>
+struct has_group_object : std::false_type {};
+
+template<int Dim>
+struct has_group_object<sycl::nd_item<Dim>> : std::true_type {};
+
+template<int Dim>
+struct has_group_object<sycl::group<Dim>> : std::true_type {};
+
+template<int Dim>
+std::size_t get_num_groups(sycl::nd_item<Dim> idx) {
+  return idx.get_group_range().size();
+}
+
+template<int Dim>
+std::size_t get_num_groups(sycl::group<Dim> grp) {
+  return grp.get_group_range().size();
+}
+
+template<int Dim>
+std::size_t get_local_size(sycl::nd_item<Dim> idx) {
+  return idx.get_local_range().size();
+}
+
+template<int Dim>
+std::size_t get_local_size(sycl::group<Dim> grp) {
+  return grp.get_local_range().size();
+}
+
+template<int Dim>
+bool any_of_group(sycl::nd_item<Dim> idx, bool pred) {
+  return sycl::any_of_group(idx.get_group(), pred);
+}
+
+template<int Dim>
+bool any_of_group(sycl::group<Dim> grp, bool pred) {
+  return sycl::any_of_group(grp, pred);
+}
+
 }
 
 #endif
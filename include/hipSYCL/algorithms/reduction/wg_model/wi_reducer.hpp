@@ -14,6 +14,8 @@
 /// This file defines work-item reducers, i.e. classes
 /// that are responsible for handling the reduction within one work item.
 
+#include <cstddef>
+
 #include "../reduction_descriptor.hpp"
 
 namespace hipsycl::algorithms::reduction::wg_model {
@@ -69,6 +71,27 @@ public:
     }
   }
 
+  // Only available for array reductions, i.e. if the operator
+  // is an array_reduction_binary_operator.
+  template<class ElementType>
+  void combine_element(std::size_t index, const ElementType& x) noexcept {
+    _op.combine_element(_data.current_value, index, x);
+  }
+
+  // Starts the reduction with val, discarding the current value.
+  void seed(const value_type& val) noexcept {
+    _data.current_value = val;
+    if constexpr(!is_identity_known) {
+      _data.is_initialized = true;
+    }
+  }
+
+  // Like combine(), but requires that the reducer has been seeded or the
+  // identity is known, so that the initialization state need not be checked.
+  void combine_seeded(const value_type& val) noexcept {
+    _data.current_value = _op(_data.current_value, val);
+  }
+
   const value_type& value() const {
     return _data.current_value;
   }
@@ -87,6 +110,38 @@ private:
       _data;
 };
 
+/// Forwards combine() of user code to seed() of a work item reducer
+template<class WorkItemReducer>
+class seeding_reducer_view {
+public:
+  using value_type = typename WorkItemReducer::value_type;
+
+  seeding_reducer_view(WorkItemReducer& r) noexcept
+  : _reducer{&r} {}
+
+  void combine(const value_type& val) noexcept {
+    _reducer->seed(val);
+  }
+private:
+  WorkItemReducer* _reducer;
+};
+
+/// Forwards combine() of user code to combine_seeded() of a work item reducer
+template<class WorkItemReducer>
+class seeded_reducer_view {
+public:
+  using value_type = typename WorkItemReducer::value_type;
+
+  seeded_reducer_view(WorkItemReducer& r) noexcept
+  : _reducer{&r} {}
+
+  void combine(const value_type& val) noexcept {
+    _reducer->combine_seeded(val);
+  }
+private:
+  WorkItemReducer* _reducer;
+};
+
 }
 
 #endif
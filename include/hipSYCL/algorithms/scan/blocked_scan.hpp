@@ -0,0 +1,92 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_BLOCKED_SCAN
+#define ACPP_ALGORITHMS_BLOCKED_SCAN
+
+#include <cstddef>
+#include <algorithm>
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+namespace hipsycl::algorithms::scanning {
+
+/// Two-pass scan for devices with few, but powerful threads such as CPUs.
+///
+/// The problem is split into \c num_blocks contiguous blocks. The first pass
+/// reduces each block sequentially, then the block aggregates are scanned in a
+/// single task. The second pass scans each block sequentially, starting from
+/// the prefix of the block.
+///
+/// \c load, \c store, \c has_init and \c init have the same semantics as for
+/// decoupled_lookback_scan().
+template <class T, class BinaryOp, class Load, class Store>
+sycl::event blocked_scan(sycl::queue &q,
+                         util::allocation_group &scratch_allocations,
+                         std::size_t problem_size, BinaryOp op, bool has_init,
+                         T init, Load load, Store store,
+                         std::size_t num_blocks) {
+  if(problem_size == 0)
+    return sycl::event{};
+
+  num_blocks = std::max(std::min(num_blocks, problem_size), std::size_t{1});
+  const std::size_t block_size = (problem_size + num_blocks - 1) / num_blocks;
+  num_blocks = (problem_size + block_size - 1) / block_size;
+
+  T* block_aggregates = scratch_allocations.obtain<T>(num_blocks);
+  T* block_prefixes = scratch_allocations.obtain<T>(num_blocks);
+
+  auto reduce_evt =
+      q.parallel_for(sycl::range{num_blocks}, [=](sycl::id<1> idx) {
+        const std::size_t begin = idx[0] * block_size;
+        const std::size_t end = std::min(begin + block_size, problem_size);
+
+        T aggregate = load(begin);
+        for(std::size_t i = begin + 1; i < end; ++i)
+          aggregate = op(aggregate, load(i));
+        block_aggregates[idx[0]] = aggregate;
+      });
+
+  auto block_scan_evt = q.single_task(reduce_evt, [=]() {
+    T running = block_aggregates[0];
+    if(has_init) {
+      block_prefixes[0] = init;
+      running = op(init, running);
+    }
+    for(std::size_t i = 1; i < num_blocks; ++i) {
+      block_prefixes[i] = running;
+      running = op(running, block_aggregates[i]);
+    }
+  });
+
+  return q.parallel_for(
+      sycl::range{num_blocks}, block_scan_evt, [=](sycl::id<1> idx) {
+        const std::size_t begin = idx[0] * block_size;
+        const std::size_t end = std::min(begin + block_size, problem_size);
+
+        bool has_prefix = has_init || idx[0] > 0;
+        T running;
+        if(has_prefix)
+          running = block_prefixes[idx[0]];
+
+        for(std::size_t i = begin; i < end; ++i) {
+          T x = load(i);
+          T inclusive = has_prefix ? op(running, x) : x;
+          store(i, running, inclusive);
+          running = inclusive;
+          has_prefix = true;
+        }
+      });
+}
+
+}
+
+#endif
@@ -0,0 +1,209 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_DECOUPLED_LOOKBACK_SCAN
+#define ACPP_ALGORITHMS_DECOUPLED_LOOKBACK_SCAN
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "hipSYCL/sycl/libkernel/accessor.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_builtins.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+namespace hipsycl::algorithms::scanning {
+
+namespace detail {
+
+using tile_status_t = std::uint32_t;
+
+constexpr tile_status_t tile_status_invalid = 0;
+constexpr tile_status_t tile_status_aggregate_available = 1;
+constexpr tile_status_t tile_status_prefix_available = 2;
+
+template<class T>
+void publish_tile_value(T* values, tile_status_t* status, std::size_t tile,
+                        const T& value, tile_status_t new_status) {
+  values[tile] = value;
+  sycl::detail::__acpp_atomic_store<sycl::access::address_space::global_space>(
+      &status[tile], new_status, sycl::memory_order_release,
+      sycl::memory_scope_device);
+}
+
+inline tile_status_t wait_for_tile_status(tile_status_t* status, std::size_t tile) {
+  tile_status_t s;
+  do {
+    s = sycl::detail::__acpp_atomic_load<
+        sycl::access::address_space::global_space>(
+        &status[tile], sycl::memory_order_acquire, sycl::memory_scope_device);
+  } while(s == tile_status_invalid);
+  return s;
+}
+
+} // detail
+
+/// Single-pass scan based on decoupled lookback (Merrill, Garland:
+/// "Single-pass Parallel Prefix Scan with Decoupled Look-back").
+///
+/// Each work group scans one tile of \c group_size elements in local memory,
+/// publishes the tile aggregate and then inspects predecessor tiles until it
+/// finds one whose inclusive prefix is already known. Tiles are assigned in
+/// the order in which work groups start, so that work groups only
+/// ever wait for work groups that are already running.
+///
+/// \c load must be a callable of type T(std::size_t) returning the i-th input
+/// element. \c store must be a callable of type void(std::size_t i, T exclusive,
+/// T inclusive) and is invoked once per element with its exclusive and
+/// inclusive scan results. If \c has_init is true, \c init is combined
+/// with the first element. Otherwise, the exclusive result argument of the first
+/// element is unspecified.
+///
+/// \c op must be associative. T must be trivially copyable and default-constructible.
+/// The scan starts after \c dependency has completed.
+template <class T, class BinaryOp, class Load, class Store>
+sycl::event decoupled_lookback_scan(sycl::queue &q,
+                                    util::allocation_group &scratch_allocations,
+                                    std::size_t problem_size, BinaryOp op,
+                                    bool has_init, T init, Load load,
+                                    Store store,
+                                    std::size_t group_size = 128,
+                                    sycl::event dependency = sycl::event{}) {
+  if(problem_size == 0)
+    return sycl::event{};
+
+  const std::size_t num_tiles = (problem_size + group_size - 1) / group_size;
+
+  detail::tile_status_t *status =
+      scratch_allocations.obtain<detail::tile_status_t>(num_tiles);
+  T *aggregates = scratch_allocations.obtain<T>(num_tiles);
+  T *inclusive_prefixes = scratch_allocations.obtain<T>(num_tiles);
+  std::size_t *tile_counter = scratch_allocations.obtain<std::size_t>(1);
+
+  auto init_evt = q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(dependency);
+    cgh.parallel_for(sycl::range{num_tiles}, [=](sycl::id<1> idx) {
+      status[idx[0]] = detail::tile_status_invalid;
+      if(idx[0] == 0)
+        *tile_counter = 0;
+    });
+  });
+
+  return q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(init_evt);
+
+    sycl::local_accessor<T> local_values{sycl::range<1>{group_size}, cgh};
+    sycl::local_accessor<T> local_prefix{sycl::range<1>{1}, cgh};
+    sycl::local_accessor<std::size_t> local_tile{sycl::range<1>{1}, cgh};
+
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_tiles * group_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_id(0);
+
+          if(lid == 0) {
+            local_tile[0] = sycl::detail::__acpp_atomic_fetch_add<
+                sycl::access::address_space::global_space>(
+                tile_counter, std::size_t{1}, sycl::memory_order_relaxed,
+                sycl::memory_scope_device);
+          }
+          sycl::group_barrier(idx.get_group());
+
+          const std::size_t tile = local_tile[0];
+          const std::size_t tile_begin = tile * group_size;
+          const std::size_t tile_size =
+              std::min(group_size, problem_size - tile_begin);
+          const std::size_t gid = tile_begin + lid;
+          const bool is_valid = lid < tile_size;
+
+          if(is_valid)
+            local_values[lid] = load(gid);
+          sycl::group_barrier(idx.get_group());
+
+          // Inclusive scan within the tile. Elements beyond the end of the
+          // problem are only ever at the end of the tile, so they
+          // never contribute to valid results.
+          for(std::size_t offset = 1; offset < tile_size; offset *= 2) {
+            T v;
+            const bool participates = is_valid && lid >= offset;
+            if(participates)
+              v = op(local_values[lid - offset], local_values[lid]);
+            sycl::group_barrier(idx.get_group());
+            if(participates)
+              local_values[lid] = v;
+            sycl::group_barrier(idx.get_group());
+          }
+
+          if(lid == 0) {
+            const T aggregate = local_values[tile_size - 1];
+            if(tile == 0) {
+              if(has_init) {
+                local_prefix[0] = init;
+                detail::publish_tile_value(inclusive_prefixes, status, tile,
+                                           op(init, aggregate),
+                                           detail::tile_status_prefix_available);
+              } else {
+                detail::publish_tile_value(inclusive_prefixes, status, tile,
+                                           aggregate,
+                                           detail::tile_status_prefix_available);
+              }
+            } else {
+              detail::publish_tile_value(aggregates, status, tile, aggregate,
+                                         detail::tile_status_aggregate_available);
+
+              std::size_t predecessor = tile - 1;
+              T exclusive_prefix;
+              bool is_first_contribution = true;
+              for(;;) {
+                detail::tile_status_t s =
+                    detail::wait_for_tile_status(status, predecessor);
+
+                const T contribution =
+                    (s == detail::tile_status_prefix_available)
+                        ? inclusive_prefixes[predecessor]
+                        : aggregates[predecessor];
+                exclusive_prefix = is_first_contribution
+                                       ? contribution
+                                       : op(contribution, exclusive_prefix);
+                is_first_contribution = false;
+
+                if(s == detail::tile_status_prefix_available)
+                  break;
+                --predecessor;
+              }
+
+              local_prefix[0] = exclusive_prefix;
+              detail::publish_tile_value(inclusive_prefixes, status, tile,
+                                         op(exclusive_prefix, aggregate),
+                                         detail::tile_status_prefix_available);
+            }
+          }
+          sycl::group_barrier(idx.get_group());
+
+          if(is_valid) {
+            if(tile > 0 || has_init) {
+              const T prefix = local_prefix[0];
+              const T exclusive =
+                  lid > 0 ? op(prefix, local_values[lid - 1]) : prefix;
+              store(gid, exclusive, op(prefix, local_values[lid]));
+            } else {
+              const T exclusive = lid > 0 ? local_values[lid - 1] : T{};
+              store(gid, exclusive, local_values[lid]);
+            }
+          }
+        });
+  });
+}
+
+}
+
+#endif
@@ -35,14 +35,11 @@ inline bool can_compare(std::size_t left_id, std::size_t right_id,
 }
 
 
-} //detail
-
-
-template <class RandomIt, class Comparator>
-sycl::event bitonic_sort(sycl::queue &q, RandomIt first, RandomIt last,
-                         Comparator comp) {
-
-  std::size_t problem_size = std::distance(first, last);
+// CompareAndSwap must be a callable of type void(std::size_t, std::size_t)
+// that swaps the elements at the given positions if they are out of order.
+template <class CompareAndSwap>
+sycl::event bitonic_sort(sycl::queue &q, std::size_t problem_size,
+                         CompareAndSwap compare_and_swap) {
   sycl::event most_recent_event;
   bool is_first_kernel = true;
 
@@ -51,19 +48,15 @@ sycl::event bitonic_sort(sycl::queue &q, RandomIt first, RandomIt last,
     auto k = [=](sycl::id<1> idx) {
       std::size_t a_id = idx.get(0);
       std::size_t b_id = a_id ^ j;
-      if(detail::can_compare(a_id, b_id, problem_size)) {
-        auto a = *detail::advance_to(first, a_id);
-        auto b = *detail::advance_to(first, b_id);
-        if(comp(b, a)) {
-          *detail::advance_to(first, a_id) = b;
-          *detail::advance_to(first, b_id) = a;
-        }
+      if(can_compare(a_id, b_id, problem_size)) {
+        compare_and_swap(a_id, b_id);
       }
     };
     if(is_first_kernel || q.is_in_order())
       most_recent_event = q.parallel_for(problem_size, k);
     else
       most_recent_event = q.parallel_for(problem_size, most_recent_event, k);
+    is_first_kernel = false;
   };
 
   for (std::size_t k = 2; (k >> 1) < problem_size; k *= 2) {
@@ -75,8 +68,49 @@ sycl::event bitonic_sort(sycl::queue &q, RandomIt first, RandomIt last,
   }
 
   return most_recent_event;
+}
+
+} //detail
+
+
+template <class RandomIt, class Comparator>
+sycl::event bitonic_sort(sycl::queue &q, RandomIt first, RandomIt last,
+                         Comparator comp) {
+
+  std::size_t problem_size = std::distance(first, last);
+  return detail::bitonic_sort(
+      q, problem_size, [=](std::size_t a_id, std::size_t b_id) {
+        auto a = *detail::advance_to(first, a_id);
+        auto b = *detail::advance_to(first, b_id);
+        if(comp(b, a)) {
+          *detail::advance_to(first, a_id) = b;
+          *detail::advance_to(first, b_id) = a;
+        }
+      });
 } // bitonic_sort
 
+template <class KeyIt, class ValueIt, class Comparator>
+sycl::event bitonic_sort_by_key(sycl::queue &q, KeyIt keys_first,
+                                KeyIt keys_last, ValueIt values_first,
+                                Comparator comp) {
+
+  std::size_t problem_size = std::distance(keys_first, keys_last);
+  return detail::bitonic_sort(
+      q, problem_size, [=](std::size_t a_id, std::size_t b_id) {
+        auto a = *detail::advance_to(keys_first, a_id);
+        auto b = *detail::advance_to(keys_first, b_id);
+        if(comp(b, a)) {
+          *detail::advance_to(keys_first, a_id) = b;
+          *detail::advance_to(keys_first, b_id) = a;
+
+          auto value_a = *detail::advance_to(values_first, a_id);
+          *detail::advance_to(values_first, a_id) =
+              *detail::advance_to(values_first, b_id);
+          *detail::advance_to(values_first, b_id) = value_a;
+        }
+      });
+}
+
 }
 
 #endif
@@ -0,0 +1,166 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_MERGE_SORT
+#define ACPP_ALGORITHMS_MERGE_SORT
+
+#include <iterator>
+#include <algorithm>
+#include <cstddef>
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+namespace detail {
+
+// Number of elements sorted sequentially by one work item in the first
+// stage, and number of elements produced by one work item in each merge
+// stage.
+constexpr std::size_t merge_sort_items_per_work_item = 8;
+
+template<class RandomIt, class Size>
+RandomIt merge_sort_advance(RandomIt first, Size i) {
+  std::advance(first, i);
+  return first;
+}
+
+// Finds how many of the first diagonal elements of the merged sequence of a and b
+// originate from a. For equal elements, elements from a are taken first,
+// which makes the merge stable.
+template <class InputIt, class Comparator>
+std::size_t merge_path_search(InputIt a, std::size_t a_size, InputIt b,
+                              std::size_t b_size, std::size_t diagonal,
+                              Comparator comp) {
+  std::size_t lo = diagonal > b_size ? diagonal - b_size : 0;
+  std::size_t hi = std::min(diagonal, a_size);
+  while(lo < hi) {
+    std::size_t mid = (lo + hi) / 2;
+    if(comp(*merge_sort_advance(b, diagonal - mid - 1),
+            *merge_sort_advance(a, mid)))
+      hi = mid;
+    else
+      lo = mid + 1;
+  }
+  return lo;
+}
+
+template <class InputIt, class OutputIt, class Comparator>
+sycl::event merge_pass(sycl::queue &q, sycl::event dependency,
+                       InputIt in, OutputIt out, std::size_t problem_size,
+                       std::size_t run_size, Comparator comp) {
+  const std::size_t num_work_items =
+      (problem_size + merge_sort_items_per_work_item - 1) /
+      merge_sort_items_per_work_item;
+
+  return q.parallel_for(
+      sycl::range{num_work_items}, dependency, [=](sycl::id<1> idx) {
+        const std::size_t out_begin = idx[0] * merge_sort_items_per_work_item;
+        // Runs are multiples of merge_sort_items_per_work_item, so the
+        // outputs of one work item never cross the boundary of a pair of runs.
+        const std::size_t pair_begin = out_begin - out_begin % (2 * run_size);
+        const std::size_t a_begin = pair_begin;
+        const std::size_t a_end = std::min(a_begin + run_size, problem_size);
+        const std::size_t b_end = std::min(a_end + run_size, problem_size);
+        const std::size_t out_end = std::min(
+            out_begin + merge_sort_items_per_work_item, b_end);
+
+        InputIt a = merge_sort_advance(in, a_begin);
+        InputIt b = merge_sort_advance(in, a_end);
+        const std::size_t a_size = a_end - a_begin;
+        const std::size_t b_size = b_end - a_end;
+
+        std::size_t i = merge_path_search(a, a_size, b, b_size,
+                                          out_begin - pair_begin, comp);
+        std::size_t j = out_begin - pair_begin - i;
+
+        OutputIt output = merge_sort_advance(out, out_begin);
+        for(std::size_t o = out_begin; o < out_end; ++o, ++output) {
+          if(j >= b_size ||
+             (i < a_size && !comp(*merge_sort_advance(b, j),
+                                  *merge_sort_advance(a, i)))) {
+            *output = *merge_sort_advance(a, i);
+            ++i;
+          } else {
+            *output = *merge_sort_advance(b, j);
+            ++j;
+          }
+        }
+      });
+}
+
+} // detail
+
+/// Stable merge sort for arbitrary comparators. Each work item first sorts
+/// a small chunk sequentially; sorted runs are then merged pairwise where each
+/// work item produces a fixed number of outputs, locating its input range
+/// using a merge path search. Merge stages alternate between the input range
+/// and a scratch buffer obtained from \c scratch_allocations.
+template <class RandomIt, class Comparator>
+sycl::event merge_sort(sycl::queue &q,
+                       util::allocation_group &scratch_allocations,
+                       RandomIt first, RandomIt last, Comparator comp) {
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  constexpr std::size_t chunk_size = detail::merge_sort_items_per_work_item;
+
+  const std::size_t problem_size = std::distance(first, last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  const std::size_t num_chunks = (problem_size + chunk_size - 1) / chunk_size;
+  // Stable insertion sort of each chunk
+  sycl::event last_evt =
+      q.parallel_for(sycl::range{num_chunks}, [=](sycl::id<1> idx) {
+        const std::size_t begin = idx[0] * chunk_size;
+        const std::size_t end = std::min(begin + chunk_size, problem_size);
+        for(std::size_t i = begin + 1; i < end; ++i) {
+          value_type current = *detail::merge_sort_advance(first, i);
+          std::size_t j = i;
+          for(; j > begin; --j) {
+            auto previous = detail::merge_sort_advance(first, j - 1);
+            if(!comp(current, *previous))
+              break;
+            *detail::merge_sort_advance(first, j) = *previous;
+          }
+          *detail::merge_sort_advance(first, j) = current;
+        }
+      });
+
+  if(problem_size <= chunk_size)
+    return last_evt;
+
+  value_type *scratch = scratch_allocations.obtain<value_type>(problem_size);
+
+  bool is_result_in_scratch = false;
+  for(std::size_t run_size = chunk_size; run_size < problem_size;
+      run_size *= 2) {
+    if(is_result_in_scratch)
+      last_evt = detail::merge_pass(q, last_evt, scratch, first, problem_size,
+                                    run_size, comp);
+    else
+      last_evt = detail::merge_pass(q, last_evt, first, scratch, problem_size,
+                                    run_size, comp);
+    is_result_in_scratch = !is_result_in_scratch;
+  }
+
+  if(is_result_in_scratch) {
+    last_evt = q.parallel_for(sycl::range{problem_size}, last_evt,
+                              [=](sycl::id<1> idx) {
+                                *detail::merge_sort_advance(first, idx[0]) =
+                                    scratch[idx[0]];
+                              });
+  }
+  return last_evt;
+}
+
+}
+
+#endif
@@ -0,0 +1,422 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_RADIX_SELECT
+#define ACPP_ALGORITHMS_RADIX_SELECT
+
+#include <iterator>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include "hipSYCL/sycl/libkernel/accessor.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_builtins.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+#include "hipSYCL/algorithms/sort/radix_sort.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+namespace detail {
+
+// Problems up to this size are selected by a single work group, which
+// needs fewer kernel launches than the device-wide selection.
+constexpr std::size_t radix_select_single_group_max_size = 8 * tile_size;
+
+// Mask of the digits above the digit at shift
+inline std::uint64_t get_radix_prefix_mask(int shift) {
+  return shift + radix_bits >= 64 ? std::uint64_t{0}
+                                  : ~std::uint64_t{0} << (shift + radix_bits);
+}
+
+template<class Key>
+constexpr int get_num_radix_select_passes() {
+  return static_cast<int>(sizeof(Key) * 8 / radix_bits);
+}
+
+// Device-wide state of a radix selection
+struct radix_select_state {
+  // Radix bits of the selected key, as far as determined by previous passes
+  std::uint64_t prefix;
+  // Rank of the selected key among the keys that match prefix
+  std::uint64_t rank;
+  // Output positions of the keys that are less than, equal to and greater
+  // than the selected key
+  std::uint32_t partition_offsets[3];
+};
+
+inline int get_partition_category(std::uint64_t bits, std::uint64_t selected) {
+  return bits < selected ? 0 : (bits == selected ? 1 : 2);
+}
+
+// Selects the key at position nth of each of num_rows rows of row_size
+// elements with one work group per row, and writes the first out_row_size
+// elements of the partitioned row r to out + r * out_row_size: first the
+// keys that are less than the selected key, then the keys that are equal
+// to it, then the greater keys, each in unspecified order.
+// Requires nth < out_row_size <= row_size.
+template <bool IsDescending, class KeyIt, class OutIt>
+sycl::event radix_select_rows(sycl::queue &q, sycl::event dependency,
+                              KeyIt first, std::size_t num_rows,
+                              std::size_t row_size, std::size_t nth,
+                              OutIt out, std::size_t out_row_size) {
+  using key_type = typename std::iterator_traits<KeyIt>::value_type;
+  constexpr int num_passes = get_num_radix_select_passes<key_type>();
+
+  return q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(dependency);
+
+    sycl::local_accessor<std::uint32_t> local_hist{sycl::range<1>{radix}, cgh};
+    sycl::local_accessor<std::uint32_t> local_scan{sycl::range<1>{radix}, cgh};
+    sycl::local_accessor<std::uint32_t> local_digit{sycl::range<1>{3}, cgh};
+
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_rows * group_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_id(0);
+          const std::size_t row = idx.get_group_linear_id();
+          auto row_first = first;
+          std::advance(row_first, row * row_size);
+
+          // MSD radix selection: Each pass determines one more digit of the
+          // selected key, and only keys that match the digits so far
+          // contribute to the histogram of the next pass.
+          std::uint64_t prefix = 0;
+          std::uint64_t rank = nth;
+          std::uint32_t num_equal = 0;
+          for(int pass = num_passes - 1; pass >= 0; --pass) {
+            const int shift = pass * radix_bits;
+            const std::uint64_t mask = get_radix_prefix_mask(shift);
+
+            local_hist[lid] = 0;
+            sycl::group_barrier(idx.get_group());
+            for(std::size_t i = lid; i < row_size; i += group_size) {
+              auto it = row_first;
+              std::advance(it, i);
+              const std::uint64_t bits =
+                  to_radix_bits<key_type, IsDescending>(*it);
+              if((bits & mask) == prefix)
+                sycl::detail::__acpp_atomic_fetch_add<
+                    sycl::access::address_space::local_space>(
+                    &local_hist[get_digit(bits, shift)], std::uint32_t{1},
+                    sycl::memory_order_relaxed, sycl::memory_scope_work_group);
+            }
+            sycl::group_barrier(idx.get_group());
+
+            const std::uint32_t count = local_hist[lid];
+            local_scan[lid] = count;
+            sycl::group_barrier(idx.get_group());
+            local_inclusive_scan(idx, &local_scan[0], lid);
+
+            // Exactly one digit contains the key of this rank
+            const std::uint32_t count_before = local_scan[lid] - count;
+            if(count_before <= rank && rank < local_scan[lid]) {
+              local_digit[0] = static_cast<std::uint32_t>(lid);
+              local_digit[1] = count_before;
+              local_digit[2] = count;
+            }
+            sycl::group_barrier(idx.get_group());
+
+            prefix |= static_cast<std::uint64_t>(local_digit[0]) << shift;
+            rank -= local_digit[1];
+            num_equal = local_digit[2];
+            sycl::group_barrier(idx.get_group());
+          }
+
+          if(lid < 3) {
+            const std::uint32_t num_less = static_cast<std::uint32_t>(nth - rank);
+            local_digit[lid] =
+                lid == 0 ? 0 : (lid == 1 ? num_less : num_less + num_equal);
+          }
+          sycl::group_barrier(idx.get_group());
+
+          for(std::size_t i = lid; i < row_size; i += group_size) {
+            auto it = row_first;
+            std::advance(it, i);
+            const auto key = *it;
+            const int category = get_partition_category(
+                to_radix_bits<key_type, IsDescending>(key), prefix);
+            const std::uint32_t pos = sycl::detail::__acpp_atomic_fetch_add<
+                sycl::access::address_space::local_space>(
+                &local_digit[category], std::uint32_t{1},
+                sycl::memory_order_relaxed, sycl::memory_scope_work_group);
+            if(pos < out_row_size) {
+              auto out_it = out;
+              std::advance(out_it, row * out_row_size + pos);
+              *out_it = key;
+            }
+          }
+        });
+  });
+}
+
+// Device-wide radix selection of the key at position nth. Partitions the
+// range into tmp like radix_select_rows() does for out_row_size ==
+// problem_size.
+template <bool IsDescending, class KeyIt, class Key>
+sycl::event radix_select(sycl::queue &q,
+                         util::allocation_group &scratch_allocations,
+                         KeyIt first, std::size_t problem_size,
+                         std::size_t nth, Key *tmp) {
+  constexpr int num_passes = get_num_radix_select_passes<Key>();
+  const std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+  std::uint32_t *hist = scratch_allocations.obtain<std::uint32_t>(radix);
+  radix_select_state *state =
+      scratch_allocations.obtain<radix_select_state>(1);
+
+  sycl::event last_evt =
+      q.parallel_for(sycl::range{radix}, [=](sycl::id<1> idx) {
+        hist[idx[0]] = 0;
+        if(idx[0] == 0) {
+          state->prefix = 0;
+          state->rank = nth;
+        }
+      });
+
+  // Each pass reads the entire range, but only keys that match the digits
+  // determined so far contribute to the histogram.
+  for(int pass = num_passes - 1; pass >= 0; --pass) {
+    const int shift = pass * radix_bits;
+    const std::uint64_t mask = get_radix_prefix_mask(shift);
+
+    auto histogram_evt = q.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(last_evt);
+      sycl::local_accessor<std::uint32_t> local_hist{sycl::range<1>{radix},
+                                                     cgh};
+
+      cgh.parallel_for(
+          sycl::nd_range<1>{num_tiles * group_size, group_size},
+          [=](sycl::nd_item<1> idx) {
+            const std::size_t lid = idx.get_local_id(0);
+            const std::uint64_t prefix = state->prefix;
+            local_hist[lid] = 0;
+            sycl::group_barrier(idx.get_group());
+
+            const std::size_t tile_begin =
+                idx.get_group_linear_id() * tile_size;
+            for(std::size_t k = 0; k < items_per_work_item; ++k) {
+              const std::size_t gid = tile_begin + k * group_size + lid;
+              if(gid < problem_size) {
+                auto it = first;
+                std::advance(it, gid);
+                const std::uint64_t bits =
+                    to_radix_bits<Key, IsDescending>(*it);
+                if((bits & mask) == prefix)
+                  sycl::detail::__acpp_atomic_fetch_add<
+                      sycl::access::address_space::local_space>(
+                      &local_hist[get_digit(bits, shift)], std::uint32_t{1},
+                      sycl::memory_order_relaxed,
+                      sycl::memory_scope_work_group);
+              }
+            }
+            sycl::group_barrier(idx.get_group());
+
+            if(local_hist[lid] > 0)
+              sycl::detail::__acpp_atomic_fetch_add<
+                  sycl::access::address_space::global_space>(
+                  &hist[lid], local_hist[lid], sycl::memory_order_relaxed,
+                  sycl::memory_scope_device);
+          });
+    });
+
+    // Determines the digit of the selected key, and clears the histogram
+    // for the next pass.
+    const bool is_last_pass = pass == 0;
+    last_evt = q.single_task(histogram_evt, [=]() {
+      std::uint64_t rank = state->rank;
+      std::uint32_t count_before = 0;
+      std::uint32_t num_equal = 0;
+      std::uint64_t digit = 0;
+      bool is_found = false;
+      for(std::size_t d = 0; d < radix; ++d) {
+        const std::uint32_t count = hist[d];
+        hist[d] = 0;
+        if(!is_found && rank < count_before + count) {
+          is_found = true;
+          digit = d;
+          num_equal = count;
+        } else if(!is_found) {
+          count_before += count;
+        }
+      }
+      rank -= count_before;
+      state->prefix |= digit << shift;
+      state->rank = rank;
+      if(is_last_pass) {
+        const std::uint32_t num_less = static_cast<std::uint32_t>(nth - rank);
+        state->partition_offsets[0] = 0;
+        state->partition_offsets[1] = num_less;
+        state->partition_offsets[2] = num_less + num_equal;
+      }
+    });
+  }
+
+  return q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(last_evt);
+    sycl::local_accessor<std::uint32_t> local_count{sycl::range<1>{3}, cgh};
+    sycl::local_accessor<std::uint32_t> local_offset{sycl::range<1>{3}, cgh};
+
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_tiles * group_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_id(0);
+          const std::uint64_t selected = state->prefix;
+          if(lid < 3)
+            local_count[lid] = 0;
+          sycl::group_barrier(idx.get_group());
+
+          // Keys are ranked within the tile first, such that each work group
+          // only needs one global atomic operation per category.
+          Key keys[items_per_work_item];
+          int categories[items_per_work_item];
+          std::uint32_t positions[items_per_work_item];
+          const std::size_t tile_begin = idx.get_group_linear_id() * tile_size;
+          for(std::size_t k = 0; k < items_per_work_item; ++k) {
+            const std::size_t gid = tile_begin + k * group_size + lid;
+            if(gid < problem_size) {
+              auto it = first;
+              std::advance(it, gid);
+              keys[k] = *it;
+              categories[k] = get_partition_category(
+                  to_radix_bits<Key, IsDescending>(keys[k]), selected);
+              positions[k] = sycl::detail::__acpp_atomic_fetch_add<
+                  sycl::access::address_space::local_space>(
+                  &local_count[categories[k]], std::uint32_t{1},
+                  sycl::memory_order_relaxed, sycl::memory_scope_work_group);
+            }
+          }
+          sycl::group_barrier(idx.get_group());
+
+          if(lid < 3)
+            local_offset[lid] = sycl::detail::__acpp_atomic_fetch_add<
+                sycl::access::address_space::global_space>(
+                &state->partition_offsets[lid], local_count[lid],
+                sycl::memory_order_relaxed, sycl::memory_scope_device);
+          sycl::group_barrier(idx.get_group());
+
+          for(std::size_t k = 0; k < items_per_work_item; ++k) {
+            const std::size_t gid = tile_begin + k * group_size + lid;
+            if(gid < problem_size)
+              tmp[local_offset[categories[k]] + positions[k]] = keys[k];
+          }
+        });
+  });
+}
+
+template<class KeyIt, class Key>
+sycl::event copy_from_scratch(sycl::queue &q, sycl::event dependency,
+                              const Key *tmp, std::size_t problem_size,
+                              KeyIt first) {
+  return q.parallel_for(sycl::range{problem_size}, dependency,
+                        [=](sycl::id<1> idx) {
+                          auto it = first;
+                          std::advance(it, idx[0]);
+                          *it = tmp[idx[0]];
+                        });
+}
+
+} // detail
+
+/// Returns whether radix_nth_element() and the batched selections support
+/// the given problem size, in addition to the requirements of radix sort,
+/// is_radix_sortable<Key, Comparator>().
+inline bool is_radix_selectable_size(std::size_t problem_size) {
+  // Counts are limited to 32 bits
+  return problem_size <= std::numeric_limits<std::uint32_t>::max();
+}
+
+/// Moves the key that would be at nth if the range was sorted to nth, such
+/// that no key before nth is greater and no key after nth is less than it,
+/// using MSD radix selection. Each pass determines one more digit of the
+/// nth key from a histogram of the remaining candidates, after which a
+/// single sweep partitions the keys around it.
+///
+/// Requires is_radix_sortable<Key, Comparator>() and
+/// is_radix_selectable_size(std::distance(first, last)).
+template <class RandomIt, class Comparator>
+sycl::event radix_nth_element(sycl::queue &q,
+                              util::allocation_group &scratch_allocations,
+                              RandomIt first, RandomIt nth, RandomIt last,
+                              Comparator comp) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+  constexpr bool is_descending =
+      detail::radix_comparator_traits<Comparator, key_type>::is_descending;
+
+  const std::size_t problem_size = std::distance(first, last);
+  const std::size_t nth_pos = std::distance(first, nth);
+  if(nth_pos >= problem_size)
+    return sycl::event{};
+
+  key_type *tmp = scratch_allocations.obtain<key_type>(problem_size);
+  sycl::event select_evt;
+  if(problem_size <= detail::radix_select_single_group_max_size)
+    select_evt = detail::radix_select_rows<is_descending>(
+        q, sycl::event{}, first, 1, problem_size, nth_pos, tmp, problem_size);
+  else
+    select_evt = detail::radix_select<is_descending>(
+        q, scratch_allocations, first, problem_size, nth_pos, tmp);
+  return detail::copy_from_scratch(q, select_evt, tmp, problem_size, first);
+}
+
+/// Batched nth_element for num_rows rows of row_size consecutive keys
+/// starting at first: Moves the key at position nth of each sorted row to
+/// position nth of the row. Each row is processed by one work group, such
+/// that a single launch handles all rows.
+///
+/// Requires is_radix_sortable<Key, Comparator>() and
+/// is_radix_selectable_size(row_size).
+template <class RandomIt, class Comparator>
+sycl::event radix_nth_element_rows(sycl::queue &q,
+                                   util::allocation_group &scratch_allocations,
+                                   RandomIt first, std::size_t num_rows,
+                                   std::size_t row_size, std::size_t nth,
+                                   Comparator comp) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+  constexpr bool is_descending =
+      detail::radix_comparator_traits<Comparator, key_type>::is_descending;
+
+  if(num_rows == 0 || nth >= row_size)
+    return sycl::event{};
+
+  key_type *tmp = scratch_allocations.obtain<key_type>(num_rows * row_size);
+  auto select_evt = detail::radix_select_rows<is_descending>(
+      q, sycl::event{}, first, num_rows, row_size, nth, tmp, row_size);
+  return detail::copy_from_scratch(q, select_evt, tmp, num_rows * row_size,
+                                   first);
+}
+
+/// Batched top-k: Writes the k first keys of each of num_rows rows of
+/// row_size consecutive keys starting at first, in the order given by comp,
+/// to k consecutive elements per row starting at d_first. The order of the
+/// keys within each output row is unspecified. The input is not modified.
+///
+/// Requires is_radix_sortable<Key, Comparator>() and
+/// is_radix_selectable_size(row_size).
+template <class RandomIt, class OutputIt, class Comparator>
+sycl::event radix_top_k_rows(sycl::queue &q, RandomIt first,
+                             std::size_t num_rows, std::size_t row_size,
+                             std::size_t k, OutputIt d_first,
+                             Comparator comp) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+  constexpr bool is_descending =
+      detail::radix_comparator_traits<Comparator, key_type>::is_descending;
+
+  k = std::min(k, row_size);
+  if(num_rows == 0 || k == 0)
+    return sycl::event{};
+  return detail::radix_select_rows<is_descending>(
+      q, sycl::event{}, first, num_rows, row_size, k - 1, d_first, k);
+}
+
+}
+
+#endif
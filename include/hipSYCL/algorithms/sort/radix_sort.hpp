@@ -0,0 +1,462 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#ifndef ACPP_ALGORITHMS_RADIX_SORT
+#define ACPP_ALGORITHMS_RADIX_SORT
+
+#include <iterator>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <algorithm>
+#include "hipSYCL/sycl/libkernel/accessor.hpp"
+#include "hipSYCL/sycl/libkernel/atomic_builtins.hpp"
+#include "hipSYCL/sycl/libkernel/bit_cast.hpp"
+#include "hipSYCL/sycl/libkernel/group_functions.hpp"
+#include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+namespace hipsycl::algorithms::sorting {
+
+namespace detail {
+
+template<class T>
+struct radix_key_traits {
+  static constexpr bool is_supported =
+      (std::is_integral_v<T> || std::is_floating_point_v<T>) &&
+      (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+};
+
+template<class Comparator, class T>
+struct radix_comparator_traits {
+  static constexpr bool is_supported = false;
+  static constexpr bool is_descending = false;
+};
+
+#define ACPP_ALGORITHMS_RADIX_COMPARATOR(comparator, descending)               \
+  template <class T> struct radix_comparator_traits<comparator, T> {           \
+    static constexpr bool is_supported = true;                                 \
+    static constexpr bool is_descending = descending;                          \
+  };
+
+ACPP_ALGORITHMS_RADIX_COMPARATOR(std::less<T>, false)
+ACPP_ALGORITHMS_RADIX_COMPARATOR(std::less<>, false)
+ACPP_ALGORITHMS_RADIX_COMPARATOR(std::greater<T>, true)
+ACPP_ALGORITHMS_RADIX_COMPARATOR(std::greater<>, true)
+
+#undef ACPP_ALGORITHMS_RADIX_COMPARATOR
+
+template<class T>
+using radix_bits_t = std::conditional_t<
+    sizeof(T) == 1, std::uint8_t,
+    std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                       std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                                          std::uint64_t>>>;
+
+// Maps keys to unsigned integers whose natural order matches the key order.
+template<class T, bool IsDescending>
+std::uint64_t to_radix_bits(const T& key) {
+  using bits_t = radix_bits_t<T>;
+  constexpr bits_t sign_bit = bits_t{1} << (sizeof(T) * 8 - 1);
+
+  bits_t bits = sycl::bit_cast<bits_t>(key);
+  if constexpr(std::is_floating_point_v<T>) {
+    bits = (bits & sign_bit) ? static_cast<bits_t>(~bits)
+                             : static_cast<bits_t>(bits | sign_bit);
+  } else if constexpr(std::is_signed_v<T>) {
+    bits = static_cast<bits_t>(bits ^ sign_bit);
+  }
+  if constexpr(IsDescending)
+    bits = static_cast<bits_t>(~bits);
+  return static_cast<std::uint64_t>(bits);
+}
+
+constexpr int radix_bits = 8;
+constexpr std::size_t radix = std::size_t{1} << radix_bits;
+constexpr std::size_t group_size = radix;
+constexpr std::size_t items_per_work_item = 8;
+constexpr std::size_t tile_size = group_size * items_per_work_item;
+
+// Lookback state of one digit in one tile. The upper two bits hold the
+// status, the remaining bits the count.
+using lookback_word_t = std::uint32_t;
+constexpr lookback_word_t lookback_aggregate_available = lookback_word_t{1} << 30;
+constexpr lookback_word_t lookback_prefix_available = lookback_word_t{2} << 30;
+constexpr lookback_word_t lookback_value_mask = (lookback_word_t{1} << 30) - 1;
+
+inline std::size_t get_digit(std::uint64_t bits, int shift) {
+  return static_cast<std::size_t>((bits >> shift) & (radix - 1));
+}
+
+template<int Dim>
+void local_inclusive_scan(sycl::nd_item<Dim> idx, std::uint32_t* data,
+                          std::size_t lid) {
+  for(std::size_t offset = 1; offset < group_size; offset *= 2) {
+    std::uint32_t v = 0;
+    if(lid >= offset)
+      v = data[lid - offset];
+    sycl::group_barrier(idx.get_group());
+    data[lid] += v;
+    sycl::group_barrier(idx.get_group());
+  }
+}
+
+template<bool IsDescending, class KeyInIt, class KeyOutIt, class ValueInIt,
+         class ValueOutIt>
+sycl::event radix_sort_pass(sycl::queue &q, sycl::event dependency,
+                            std::size_t problem_size, int shift,
+                            KeyInIt keys_in, KeyOutIt keys_out,
+                            ValueInIt values_in, ValueOutIt values_out,
+                            bool has_values, const std::uint32_t *digit_bases,
+                            lookback_word_t *lookback,
+                            std::size_t *tile_counter) {
+  using key_type = typename std::iterator_traits<KeyInIt>::value_type;
+  const std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+  return q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(dependency);
+
+    sycl::local_accessor<std::uint64_t> local_bits{sycl::range<1>{tile_size}, cgh};
+    sycl::local_accessor<std::uint32_t> local_idx{sycl::range<1>{tile_size}, cgh};
+    sycl::local_accessor<std::uint32_t> local_scan{sycl::range<1>{group_size}, cgh};
+    sycl::local_accessor<std::uint32_t> local_hist{sycl::range<1>{radix}, cgh};
+    sycl::local_accessor<std::uint32_t> local_digit_start{sycl::range<1>{radix}, cgh};
+    sycl::local_accessor<std::size_t> local_digit_offset{sycl::range<1>{radix}, cgh};
+    sycl::local_accessor<std::size_t> local_tile{sycl::range<1>{1}, cgh};
+
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_tiles * group_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_id(0);
+
+          // Tiles are assigned in the order in which work groups start,
+          // so that we only ever wait for tiles that are already running.
+          if(lid == 0) {
+            local_tile[0] = sycl::detail::__acpp_atomic_fetch_add<
+                sycl::access::address_space::global_space>(
+                tile_counter, std::size_t{1}, sycl::memory_order_relaxed,
+                sycl::memory_scope_device);
+          }
+          local_hist[lid] = 0;
+          sycl::group_barrier(idx.get_group());
+
+          const std::size_t tile = local_tile[0];
+          const std::size_t tile_begin = tile * tile_size;
+          const std::size_t tile_n = std::min(tile_size, problem_size - tile_begin);
+
+          for(std::size_t k = 0; k < items_per_work_item; ++k) {
+            const std::size_t p = k * group_size + lid;
+            std::uint64_t bits = ~std::uint64_t{0};
+            if(p < tile_n) {
+              auto it = keys_in;
+              std::advance(it, tile_begin + p);
+              bits = to_radix_bits<key_type, IsDescending>(*it);
+              sycl::detail::__acpp_atomic_fetch_add<
+                  sycl::access::address_space::local_space>(
+                  &local_hist[get_digit(bits, shift)], std::uint32_t{1},
+                  sycl::memory_order_relaxed, sycl::memory_scope_work_group);
+            }
+            local_bits[p] = bits;
+            local_idx[p] = static_cast<std::uint32_t>(p);
+          }
+
+          // Stable sort of the tile by the current digit using one split
+          // per bit. Elements beyond the end of the problem have all bits set
+          // and therefore end up behind all valid elements.
+          for(int b = 0; b < radix_bits; ++b) {
+            sycl::group_barrier(idx.get_group());
+
+            std::uint64_t my_bits[items_per_work_item];
+            std::uint32_t my_idx[items_per_work_item];
+            std::uint32_t num_zeros = 0;
+            for(std::size_t k = 0; k < items_per_work_item; ++k) {
+              const std::size_t p = lid * items_per_work_item + k;
+              my_bits[k] = local_bits[p];
+              my_idx[k] = local_idx[p];
+              num_zeros += ((my_bits[k] >> (shift + b)) & 1) ? 0 : 1;
+            }
+            local_scan[lid] = num_zeros;
+            sycl::group_barrier(idx.get_group());
+            local_inclusive_scan(idx, &local_scan[0], lid);
+
+            const std::uint32_t total_zeros = local_scan[group_size - 1];
+            std::uint32_t zeros_before = local_scan[lid] - num_zeros;
+            sycl::group_barrier(idx.get_group());
+
+            for(std::size_t k = 0; k < items_per_work_item; ++k) {
+              const std::uint32_t p =
+                  static_cast<std::uint32_t>(lid * items_per_work_item + k);
+              std::uint32_t dst;
+              if((my_bits[k] >> (shift + b)) & 1) {
+                dst = total_zeros + (p - zeros_before);
+              } else {
+                dst = zeros_before;
+                ++zeros_before;
+              }
+              local_bits[dst] = my_bits[k];
+              local_idx[dst] = my_idx[k];
+            }
+          }
+          sycl::group_barrier(idx.get_group());
+
+          // Start of each digit within the sorted tile
+          const std::uint32_t count = local_hist[lid];
+          local_scan[lid] = count;
+          sycl::group_barrier(idx.get_group());
+          local_inclusive_scan(idx, &local_scan[0], lid);
+          local_digit_start[lid] = local_scan[lid] - count;
+
+          // Decoupled lookback for the digit handled by this work item
+          const std::size_t digit = lid;
+          lookback_word_t *my_state = &lookback[tile * radix + digit];
+          std::size_t prefix = 0;
+          if(tile == 0) {
+            sycl::detail::__acpp_atomic_store<
+                sycl::access::address_space::global_space>(
+                my_state, lookback_prefix_available | count,
+                sycl::memory_order_release, sycl::memory_scope_device);
+          } else {
+            sycl::detail::__acpp_atomic_store<
+                sycl::access::address_space::global_space>(
+                my_state, lookback_aggregate_available | count,
+                sycl::memory_order_release, sycl::memory_scope_device);
+
+            std::size_t predecessor = tile - 1;
+            for(;;) {
+              lookback_word_t state;
+              do {
+                state = sycl::detail::__acpp_atomic_load<
+                    sycl::access::address_space::global_space>(
+                    &lookback[predecessor * radix + digit],
+                    sycl::memory_order_acquire, sycl::memory_scope_device);
+              } while((state & ~lookback_value_mask) == 0);
+
+              prefix += state & lookback_value_mask;
+              if(state & lookback_prefix_available)
+                break;
+              --predecessor;
+            }
+
+            sycl::detail::__acpp_atomic_store<
+                sycl::access::address_space::global_space>(
+                my_state,
+                lookback_prefix_available |
+                    static_cast<lookback_word_t>(prefix + count),
+                sycl::memory_order_release, sycl::memory_scope_device);
+          }
+          local_digit_offset[digit] = digit_bases[digit] + prefix;
+          sycl::group_barrier(idx.get_group());
+
+          for(std::size_t k = 0; k < items_per_work_item; ++k) {
+            const std::size_t p = k * group_size + lid;
+            if(p < tile_n) {
+              const std::size_t d = get_digit(local_bits[p], shift);
+              const std::size_t dst =
+                  local_digit_offset[d] + (p - local_digit_start[d]);
+              const std::size_t src = tile_begin + local_idx[p];
+
+              auto key_in = keys_in;
+              auto key_out = keys_out;
+              std::advance(key_in, src);
+              std::advance(key_out, dst);
+              *key_out = *key_in;
+              if(has_values) {
+                auto value_in = values_in;
+                auto value_out = values_out;
+                std::advance(value_in, src);
+                std::advance(value_out, dst);
+                *value_out = *value_in;
+              }
+            }
+          }
+        });
+  });
+}
+
+template <bool IsDescending, class KeyIt, class ValueIt>
+sycl::event radix_sort(sycl::queue &q,
+                       util::allocation_group &scratch_allocations,
+                       KeyIt keys_first, KeyIt keys_last, ValueIt values_first,
+                       bool has_values) {
+  using key_type = typename std::iterator_traits<KeyIt>::value_type;
+  using value_type = typename std::iterator_traits<ValueIt>::value_type;
+
+  const std::size_t problem_size = std::distance(keys_first, keys_last);
+  if(problem_size == 0)
+    return sycl::event{};
+
+  const std::size_t num_passes = sizeof(key_type) * 8 / radix_bits;
+  const std::size_t num_tiles = (problem_size + tile_size - 1) / tile_size;
+
+  key_type* tmp_keys = scratch_allocations.obtain<key_type>(problem_size);
+  value_type* tmp_values =
+      has_values ? scratch_allocations.obtain<value_type>(problem_size)
+                 : nullptr;
+  std::uint32_t *digit_bases =
+      scratch_allocations.obtain<std::uint32_t>(num_passes * radix);
+  lookback_word_t *lookback =
+      scratch_allocations.obtain<lookback_word_t>(num_tiles * radix);
+  std::size_t *tile_counters =
+      scratch_allocations.obtain<std::size_t>(num_passes);
+
+  auto init_evt = q.parallel_for(
+      sycl::range{num_passes * radix}, [=](sycl::id<1> idx) {
+        digit_bases[idx[0]] = 0;
+        if(idx[0] < num_passes)
+          tile_counters[idx[0]] = 0;
+      });
+
+  // Histograms for all passes are computed upfront in a single sweep over the
+  // keys, such that each pass only needs to read and write the data once.
+  auto histogram_evt = q.submit([&](sycl::handler &cgh) {
+    cgh.depends_on(init_evt);
+    sycl::local_accessor<std::uint32_t> local_hist{
+        sycl::range<1>{num_passes * radix}, cgh};
+
+    cgh.parallel_for(
+        sycl::nd_range<1>{num_tiles * group_size, group_size},
+        [=](sycl::nd_item<1> idx) {
+          const std::size_t lid = idx.get_local_id(0);
+          for(std::size_t i = lid; i < num_passes * radix; i += group_size)
+            local_hist[i] = 0;
+          sycl::group_barrier(idx.get_group());
+
+          const std::size_t tile_begin = idx.get_group_linear_id() * tile_size;
+          for(std::size_t k = 0; k < items_per_work_item; ++k) {
+            const std::size_t gid = tile_begin + k * group_size + lid;
+            if(gid < problem_size) {
+              auto it = keys_first;
+              std::advance(it, gid);
+              const std::uint64_t bits =
+                  to_radix_bits<key_type, IsDescending>(*it);
+              for(std::size_t pass = 0; pass < num_passes; ++pass) {
+                sycl::detail::__acpp_atomic_fetch_add<
+                    sycl::access::address_space::local_space>(
+                    &local_hist[pass * radix + get_digit(bits, pass * radix_bits)],
+                    std::uint32_t{1}, sycl::memory_order_relaxed,
+                    sycl::memory_scope_work_group);
+              }
+            }
+          }
+          sycl::group_barrier(idx.get_group());
+
+          for(std::size_t i = lid; i < num_passes * radix; i += group_size) {
+            if(local_hist[i] > 0)
+              sycl::detail::__acpp_atomic_fetch_add<
+                  sycl::access::address_space::global_space>(
+                  &digit_bases[i], local_hist[i], sycl::memory_order_relaxed,
+                  sycl::memory_scope_device);
+          }
+        });
+  });
+
+  sycl::event last_evt = q.parallel_for(
+      sycl::range{num_passes}, histogram_evt, [=](sycl::id<1> idx) {
+        std::uint32_t *bins = digit_bases + idx[0] * radix;
+        std::uint32_t sum = 0;
+        for(std::size_t i = 0; i < radix; ++i) {
+          const std::uint32_t count = bins[i];
+          bins[i] = sum;
+          sum += count;
+        }
+      });
+
+  for(std::size_t pass = 0; pass < num_passes; ++pass) {
+    auto clear_evt = q.parallel_for(sycl::range{num_tiles * radix}, last_evt,
+                                    [=](sycl::id<1> idx) {
+                                      lookback[idx[0]] = 0;
+                                    });
+
+    const int shift = static_cast<int>(pass * radix_bits);
+    const std::uint32_t* pass_digit_bases = digit_bases + pass * radix;
+    if(pass % 2 == 0) {
+      last_evt = radix_sort_pass<IsDescending>(
+          q, clear_evt, problem_size, shift, keys_first, tmp_keys,
+          values_first, tmp_values, has_values, pass_digit_bases, lookback,
+          tile_counters + pass);
+    } else {
+      last_evt = radix_sort_pass<IsDescending>(
+          q, clear_evt, problem_size, shift, tmp_keys, keys_first,
+          tmp_values, values_first, has_values, pass_digit_bases, lookback,
+          tile_counters + pass);
+    }
+  }
+
+  if(num_passes % 2 != 0) {
+    // The sorted data is in the scratch buffers and needs to be moved back
+    last_evt = q.parallel_for(
+        sycl::range{problem_size}, last_evt, [=](sycl::id<1> idx) {
+          auto key_out = keys_first;
+          std::advance(key_out, idx[0]);
+          *key_out = tmp_keys[idx[0]];
+          if(has_values) {
+            auto value_out = values_first;
+            std::advance(value_out, idx[0]);
+            *value_out = tmp_values[idx[0]];
+          }
+        });
+  }
+
+  return last_evt;
+}
+
+} // detail
+
+/// Returns whether radix_sort() and radix_sort_by_key() support the given
+/// key type, comparator and problem size.
+template <class Key, class Comparator>
+constexpr bool is_radix_sortable() {
+  return detail::radix_key_traits<Key>::is_supported &&
+         detail::radix_comparator_traits<Comparator, Key>::is_supported;
+}
+
+inline bool is_radix_sortable_size(std::size_t problem_size) {
+  // Counts in the lookback state are limited to 30 bits
+  return problem_size <= detail::lookback_value_mask;
+}
+
+/// LSD radix sort in the style of Onesweep (Adinets, Merrill: "Onesweep: A
+/// Faster Least Significant Digit Radix Sort for GPUs"). Digit histograms of
+/// all passes are computed in one upfront sweep; each pass then scatters
+/// the keys in a single sweep, using decoupled lookback to obtain digit offsets
+/// of preceding tiles. The sort is stable.
+///
+/// Requires is_radix_sortable<Key, Comparator>() and
+/// is_radix_sortable_size(std::distance(first, last)).
+template <class RandomIt, class Comparator>
+sycl::event radix_sort(sycl::queue &q,
+                       util::allocation_group &scratch_allocations,
+                       RandomIt first, RandomIt last, Comparator comp) {
+  using key_type = typename std::iterator_traits<RandomIt>::value_type;
+  constexpr bool is_descending =
+      detail::radix_comparator_traits<Comparator, key_type>::is_descending;
+  return detail::radix_sort<is_descending>(q, scratch_allocations, first, last,
+                                           first, false);
+}
+
+/// Sorts the range of keys, and applies the same permutation to the range of
+/// values starting at values_first.
+template <class KeyIt, class ValueIt, class Comparator>
+sycl::event radix_sort_by_key(sycl::queue &q,
+                              util::allocation_group &scratch_allocations,
+                              KeyIt keys_first, KeyIt keys_last,
+                              ValueIt values_first, Comparator comp) {
+  using key_type = typename std::iterator_traits<KeyIt>::value_type;
+  constexpr bool is_descending =
+      detail::radix_comparator_traits<Comparator, key_type>::is_descending;
+  return detail::radix_sort<is_descending>(q, scratch_allocations, keys_first,
+                                           keys_last, values_first, true);
+}
+
+}
+
+#endif
@@ -13,6 +13,8 @@
 
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <functional>
 
 #include "hipSYCL/common/small_vector.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
@@ -39,91 +41,216 @@ enum class allocation_type {
   device, shared, host
 };
 
+/// Statistics of an allocation_cache. All sizes are in bytes.
+struct allocation_cache_statistics {
+  /// Number of requests served from cached allocations
+  std::size_t num_cache_hits = 0;
+  /// Number of requests that required a new backend allocation
+  std::size_t num_cache_misses = 0;
+  /// Number of cached allocations that were freed by trimming
+  std::size_t num_trimmed_allocations = 0;
+  /// Size of allocations currently handed out to allocation groups
+  std::size_t in_use_size = 0;
+  /// Size of idle allocations currently held by the cache
+  std::size_t cached_size = 0;
+  /// Maximum of in_use_size + cached_size observed so far
+  std::size_t peak_size = 0;
+};
+
+/// Caches scratch allocations for algorithms.
+///
+/// Allocation sizes are rounded up to power-of-two size classes, such that
+/// requests can be served from a free list per size class instead of searching
+/// all cached allocations. Free lists are sharded by device, with one lock per
+/// shard, to avoid contention between queues operating on different devices.
+///
+/// Idle allocations are only freed by purge() and trim(). The cache is trimmed
+/// to its high-water mark by trim() without arguments; this should only be
+/// invoked when no operations using allocations of this cache are pending,
+/// e.g. after the queue that owns the cache has been waited on.
 class allocation_cache {
   friend class allocation_group;
 public:
   allocation_cache(allocation_type alloc_type)
-  : _alloc_type{alloc_type} {}
+  : allocation_cache{alloc_type,
+                     rt::application::get_settings()
+                             .get<rt::setting::scratch_cache_max_size>() *
+                         1024 * 1024} {}
+
+  /// \param max_cached_size High-water mark in bytes for idle allocations
+  /// held by the cache when trim() is invoked. 0 means unlimited.
+  allocation_cache(allocation_type alloc_type, std::size_t max_cached_size)
+  : _alloc_type{alloc_type}, _max_cached_size{max_cached_size} {}
 
   ~allocation_cache() {
     purge();
   }
 
+  /// Frees all idle allocations.
   void purge() {
-    std::lock_guard<std::mutex> lock{_mutex};
-    
-    for(auto& allocation : _allocations) {
-      _rt.get()->backends()
-          .get(allocation.dev.get_backend())
-          ->get_allocator(allocation.dev)
-          ->free(allocation.ptr);
-    }
-    _allocations.clear();
+    trim_to(0);
+  }
+
+  /// Frees idle allocations, largest first, until at most the configured
+  /// high-water mark remains cached. Has no effect if the high-water mark is 0.
+  void trim() {
+    if(_max_cached_size > 0)
+      trim_to(_max_cached_size);
+  }
+
+  /// Frees idle allocations, largest first, until at most \c max_cached_size
+  /// bytes remain cached.
+  void trim(std::size_t max_cached_size) {
+    trim_to(max_cached_size);
+  }
+
+  allocation_cache_statistics get_statistics() const {
+    allocation_cache_statistics stats;
+    stats.num_cache_hits = _num_cache_hits.load(std::memory_order_relaxed);
+    stats.num_cache_misses = _num_cache_misses.load(std::memory_order_relaxed);
+    stats.num_trimmed_allocations =
+        _num_trimmed_allocations.load(std::memory_order_relaxed);
+    stats.in_use_size = _in_use_size.load(std::memory_order_relaxed);
+    stats.cached_size = _cached_size.load(std::memory_order_relaxed);
+    stats.peak_size = _peak_size.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  std::size_t get_max_cached_size() const {
+    return _max_cached_size;
   }
 private:
-  
+  static constexpr std::size_t min_size_class = 8; // 256 bytes
+  static constexpr std::size_t num_size_classes = 64;
+  static constexpr std::size_t num_shards = 16;
+
+  struct shard {
+    std::mutex mutex;
+    std::vector<allocation> free_lists[num_size_classes];
+  };
+
+  static std::size_t get_size_class(std::size_t size) {
+    std::size_t size_class = min_size_class;
+    while(size_class < num_size_classes - 1 &&
+          (std::size_t{1} << size_class) < size)
+      ++size_class;
+    return size_class;
+  }
+
+  shard& get_shard(rt::device_id dev) {
+    return _shards[std::hash<rt::device_id>{}(dev) % num_shards];
+  }
+
   allocation find_or_alloc(std::size_t min_size, std::size_t min_alignment,
                            rt::device_id dev) {
+    const std::size_t size_class = get_size_class(min_size);
     allocation result;
-    if(!find_allocation(min_size, min_alignment, dev, result)){  
+    if(find_allocation(size_class, min_alignment, dev, result)) {
+      _num_cache_hits.fetch_add(1, std::memory_order_relaxed);
+      _cached_size.fetch_sub(result.size, std::memory_order_relaxed);
+    } else {
+      _num_cache_misses.fetch_add(1, std::memory_order_relaxed);
       result.dev = dev;
-      result.size = min_size;
+      result.size = std::size_t{1} << size_class;
 
       auto allocator = _rt.get()->backends()
                        .get(dev.get_backend())
                        ->get_allocator(dev);
 
       if(_alloc_type == allocation_type::device)
-        result.ptr = allocator->allocate(min_alignment, min_size);
+        result.ptr = allocator->allocate(min_alignment, result.size);
       else if(_alloc_type == allocation_type::shared)
-        result.ptr = allocator->allocate_usm(min_size);
+        result.ptr = allocator->allocate_usm(result.size);
       else
         result.ptr =
-            allocator->allocate_optimized_host(min_alignment, min_size);
+            allocator->allocate_optimized_host(min_alignment, result.size);
+
+      update_peak_size(result.size);
     }
+    _in_use_size.fetch_add(result.size, std::memory_order_relaxed);
     return result;
   }
 
-  bool find_allocation(std::size_t min_size, std::size_t min_alignment,
+  bool find_allocation(std::size_t size_class, std::size_t min_alignment,
                        rt::device_id dev, allocation &out) {
-    std::lock_guard<std::mutex> lock{_mutex};
-
-    bool found = false;
-    std::size_t found_index = 0;
-    for (std::size_t i = 0; i < _allocations.size(); ++i) {
-      const auto& allocation = _allocations[i];
-      if (allocation.dev == dev) {
-        if (allocation.size >= min_size &&
-            reinterpret_cast<std::size_t>(allocation.ptr) % min_alignment ==
-                0) {
-          // If we already have found a candidate: We want the smallest
-          // allocation that has the required size so that larger allocations
-          // remain available for larger requests.
-          if (!found || allocation.size < out.size) {
-            out = allocation;
-            found_index = i;
-          }
-          found = true;
-        }
+    shard& s = get_shard(dev);
+    std::lock_guard<std::mutex> lock{s.mutex};
+
+    auto& free_list = s.free_lists[size_class];
+    // Search from the back, so that recently returned allocations (which are
+    // more likely to still be cached in the memory hierarchy) are reused first.
+    for(std::size_t i = free_list.size(); i-- > 0;) {
+      const auto& allocation = free_list[i];
+      if(allocation.dev == dev &&
+         reinterpret_cast<std::size_t>(allocation.ptr) % min_alignment == 0) {
+        out = allocation;
+        // The allocation is no longer available for other requests,
+        // so remove for now.
+        free_list[i] = free_list.back();
+        free_list.pop_back();
+        return true;
       }
     }
-    if(found) {
-      // The allocation is no longer available for other requests,
-      // so remove for now.
-      _allocations.erase(_allocations.begin() + found_index);
-    }
-    return found;
+    return false;
   }
 
   void return_allocation(const allocation& alloc) {
-    std::lock_guard<std::mutex> lock{_mutex};
-    _allocations.push_back(alloc);
+    {
+      shard& s = get_shard(alloc.dev);
+      std::lock_guard<std::mutex> lock{s.mutex};
+      s.free_lists[get_size_class(alloc.size)].push_back(alloc);
+    }
+    _in_use_size.fetch_sub(alloc.size, std::memory_order_relaxed);
+    _cached_size.fetch_add(alloc.size, std::memory_order_relaxed);
+  }
+
+  void trim_to(std::size_t max_cached_size) {
+    for(std::size_t size_class = num_size_classes; size_class-- > 0;) {
+      for(auto& s : _shards) {
+        if(_cached_size.load(std::memory_order_relaxed) <= max_cached_size &&
+           max_cached_size > 0)
+          return;
+
+        std::lock_guard<std::mutex> lock{s.mutex};
+        auto& free_list = s.free_lists[size_class];
+        while(!free_list.empty() &&
+              (max_cached_size == 0 ||
+               _cached_size.load(std::memory_order_relaxed) >
+                   max_cached_size)) {
+          const allocation& alloc = free_list.back();
+          _rt.get()->backends()
+              .get(alloc.dev.get_backend())
+              ->get_allocator(alloc.dev)
+              ->free(alloc.ptr);
+          _cached_size.fetch_sub(alloc.size, std::memory_order_relaxed);
+          _num_trimmed_allocations.fetch_add(1, std::memory_order_relaxed);
+          free_list.pop_back();
+        }
+      }
+    }
+  }
+
+  void update_peak_size(std::size_t new_allocation_size) {
+    const std::size_t current =
+        _in_use_size.load(std::memory_order_relaxed) +
+        _cached_size.load(std::memory_order_relaxed) + new_allocation_size;
+    std::size_t peak = _peak_size.load(std::memory_order_relaxed);
+    while(current > peak && !_peak_size.compare_exchange_weak(
+                                peak, current, std::memory_order_relaxed))
+      ;
   }
 
   rt::runtime_keep_alive_token _rt;
-  common::auto_small_vector<allocation> _allocations;
-  std::mutex _mutex;
+  shard _shards[num_shards];
   allocation_type _alloc_type;
+  std::size_t _max_cached_size;
+
+  std::atomic<std::size_t> _num_cache_hits = 0;
+  std::atomic<std::size_t> _num_cache_misses = 0;
+  std::atomic<std::size_t> _num_trimmed_allocations = 0;
+  std::atomic<std::size_t> _in_use_size = 0;
+  std::atomic<std::size_t> _cached_size = 0;
+  std::atomic<std::size_t> _peak_size = 0;
 };
 
 /// allocation_group represents allocation requests that belong together
@@ -0,0 +1,201 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_ALGORITHMS_INDEX_SPACE_HPP
+#define HIPSYCL_ALGORITHMS_INDEX_SPACE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#ifdef __cpp_lib_ranges
+#include <ranges>
+#endif
+
+#include "hipSYCL/sycl/libkernel/id.hpp"
+#include "hipSYCL/sycl/libkernel/range.hpp"
+
+namespace hipsycl::algorithms::util {
+
+/// Describes iterators over dense integer index spaces, such as iterators of
+/// std::views::iota or of std::views::cartesian_product of iota views. The
+/// elements of such index spaces can be computed from a multi-dimensional
+/// work item id, instead of by advancing iterators.
+///
+/// dimensions is 0 for all other iterators. Otherwise, get_element(origin, idx)
+/// returns the element at offset idx from the element origin, where the last
+/// dimension varies fastest.
+template <class It, class Enable = void>
+struct index_space_traits {
+  static constexpr int dimensions = 0;
+};
+
+#ifdef __cpp_lib_ranges
+
+namespace detail {
+
+template <class It>
+constexpr bool is_iota_iterator() {
+  using value_type = std::iter_value_t<It>;
+  if constexpr (std::is_integral_v<value_type> &&
+                !std::is_same_v<value_type, bool>) {
+    using view_type = std::ranges::iota_view<value_type, value_type>;
+    return std::is_same_v<It, std::ranges::iterator_t<view_type>>;
+  } else {
+    return false;
+  }
+}
+
+template <class It>
+constexpr bool is_cartesian_iota_iterator(void *) {
+  return false;
+}
+
+template <class It, class... W>
+constexpr bool is_cartesian_iota_iterator(std::tuple<W...> *) {
+#ifdef __cpp_lib_ranges_cartesian_product
+  if constexpr (sizeof...(W) >= 2 && sizeof...(W) <= 3 &&
+                ((std::is_integral_v<W> && !std::is_same_v<W, bool>) && ...)) {
+    using view_type =
+        std::ranges::cartesian_product_view<std::ranges::iota_view<W, W>...>;
+    return std::is_same_v<It, std::ranges::iterator_t<view_type>> ||
+           std::is_same_v<It, std::ranges::iterator_t<const view_type>>;
+  }
+#endif
+  return false;
+}
+
+} // namespace detail
+
+template <class It>
+struct index_space_traits<It, std::enable_if_t<detail::is_iota_iterator<It>()>> {
+  static constexpr int dimensions = 1;
+  using element_type = std::iter_value_t<It>;
+
+  static element_type get_element(const element_type &origin,
+                                  sycl::id<1> idx) noexcept {
+    return static_cast<element_type>(origin + idx[0]);
+  }
+};
+
+template <class It>
+struct index_space_traits<
+    It, std::enable_if_t<detail::is_cartesian_iota_iterator<It>(
+            static_cast<std::iter_value_t<It> *>(nullptr))>> {
+  using element_type = std::iter_value_t<It>;
+  static constexpr int dimensions = std::tuple_size_v<element_type>;
+
+  static element_type get_element(const element_type &origin,
+                                  sycl::id<dimensions> idx) noexcept {
+    return get_element(origin, idx, std::make_index_sequence<dimensions>{});
+  }
+
+private:
+  template <std::size_t... I>
+  static element_type get_element(const element_type &origin,
+                                  sycl::id<dimensions> idx,
+                                  std::index_sequence<I...>) noexcept {
+    return element_type{static_cast<std::tuple_element_t<I, element_type>>(
+        std::get<I>(origin) + idx[I])...};
+  }
+};
+
+#endif // __cpp_lib_ranges
+
+namespace detail {
+
+template <int D, class Element>
+bool index_space_prefix_equals(const Element &a, const Element &b) {
+  if constexpr (D == 0) {
+    return true;
+  } else {
+    return std::get<D - 1>(a) == std::get<D - 1>(b) &&
+           index_space_prefix_equals<D - 1>(a, b);
+  }
+}
+
+// Returns the smallest offset k in [1, n] at which the first D components
+// of the element differ from those of *first, or n if there is none.
+// Relies on the elements being ordered lexicographically.
+template <int D, class It>
+std::size_t find_index_space_prefix_change(It first, std::size_t n) {
+  const auto origin = *first;
+  std::size_t lo = 1;
+  std::size_t hi = n;
+  while (lo < hi) {
+    std::size_t mid = lo + (hi - lo) / 2;
+    if (index_space_prefix_equals<D>(origin, *(first + mid)))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+} // namespace detail
+
+/// Determines the extents of the index space [first, last) if it is a dense
+/// box, i.e. if it consists of complete rows of the underlying index space.
+/// This is not the case e.g. for subranges that start in the middle of a row,
+/// in which case false is returned.
+template <class It, int Dim = index_space_traits<It>::dimensions>
+bool get_index_space_extents(It first, It last, sycl::range<Dim> &extents) {
+  static_assert(Dim > 0, "Not an index space iterator");
+  using traits = index_space_traits<It>;
+
+  auto n = static_cast<std::size_t>(std::distance(first, last));
+  if (n == 0)
+    return false;
+  if constexpr (Dim == 1) {
+    extents = sycl::range<1>{n};
+    return true;
+  } else {
+    // Number of elements per unit step of dimension d - 1, i.e. the product of
+    // the extents of dimensions d and higher.
+    std::size_t stride[Dim + 1];
+    stride[0] = n;
+    stride[Dim] = 1;
+    stride[1] = detail::find_index_space_prefix_change<1>(first, n);
+    if constexpr (Dim == 3)
+      stride[2] = detail::find_index_space_prefix_change<2>(first, n);
+
+    for (int d = 0; d < Dim; ++d) {
+      if (stride[d] % stride[d + 1] != 0)
+        return false;
+      extents[d] = stride[d] / stride[d + 1];
+    }
+
+    // The next rows must start at the same position as the first one, and
+    // the last element must be the opposite corner of the box.
+    const auto origin = *first;
+    for (int d = 1; d < Dim; ++d) {
+      if (stride[d] < n) {
+        sycl::id<Dim> idx;
+        idx[d - 1] = 1;
+        if (*(first + stride[d]) != traits::get_element(origin, idx))
+          return false;
+      }
+    }
+    sycl::id<Dim> last_idx;
+    for (int d = 0; d < Dim; ++d)
+      last_idx[d] = extents[d] - 1;
+    return *(first + (n - 1)) == traits::get_element(origin, last_idx);
+  }
+}
+
+} // namespace hipsycl::algorithms::util
+
+#endif
@@ -15,11 +15,45 @@
 #include "hipSYCL/sycl/device.hpp"
 #include "hipSYCL/sycl/libkernel/nd_item.hpp"
 #include "hipSYCL/sycl/info/device.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
 #include <cstddef>
+#include <cstdint>
 
 
 namespace hipsycl::algorithms::util {
 
+// A packet of N consecutive elements, which is accessed with a single
+// memory access of sizeof(packet) bytes.
+template<class T, std::size_t N>
+struct alignas(N * sizeof(T)) packet {
+  T elements[N];
+};
+
+// The number of elements of T that fit into one 128-bit packet, or 1 if
+// T cannot be accessed in packets.
+template<class T>
+constexpr std::size_t max_packet_size() {
+  if constexpr (sizeof(T) < 16 && 16 % sizeof(T) == 0)
+    return 16 / sizeof(T);
+  else
+    return 1;
+}
+
+template<class T, std::size_t N>
+bool is_packet_aligned(const T* ptr) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignof(packet<T, N>) == 0;
+}
+
+inline std::size_t get_streaming_groups_per_compute_unit() {
+  static const std::size_t groups_per_cu = []() -> std::size_t {
+    std::size_t n = rt::application::get_settings()
+                        .get<rt::setting::streaming_groups_per_compute_unit>();
+    return n > 0 ? n : 4;
+  }();
+  return groups_per_cu;
+}
+
 class data_streamer {
 public:
   data_streamer(rt::device_id dev, std::size_t problem_size,
@@ -35,7 +69,8 @@ public:
     std::size_t desired_num_groups = 0;
     if(!dev.is_host()) {
       desired_num_groups =
-          dev.get_info<sycl::info::device::max_compute_units>() * 4;
+          dev.get_info<sycl::info::device::max_compute_units>() *
+          get_streaming_groups_per_compute_unit();
 
     } else {
       desired_num_groups =
@@ -77,9 +112,96 @@ public:
     );
   };
 
+  // Like run(), but invokes first_f instead of f for the first index
+  // processed by the work item; work items without any indices invoke
+  // neither. This allows seeding per-work-item state from the first element
+  // without checking for it in each iteration.
+  //
+  // F0 and F are callables of signature void(sycl::id<1>).
+  template <class F0, class F>
+  static void run_peeled(std::size_t problem_size, sycl::nd_item<1> idx,
+                         F0 &&first_f, F &&f) noexcept {
+    __acpp_if_target_sscp(
+      if(sycl::jit::introspect<sycl::jit::current_backend, int>() == sycl::jit::backend::host) {
+        run_host_peeled(problem_size, idx, first_f, f);
+      } else {
+        run_device_peeled(problem_size, idx, first_f, f);
+      }
+      return;
+    );
+    __acpp_if_target_device(
+      run_device_peeled(problem_size, idx, first_f, f);
+    );
+    __acpp_if_target_host(
+      run_host_peeled(problem_size, idx, first_f, f);
+    );
+  };
+
+  // Like run(), but f is invoked once per packet of PacketSize consecutive
+  // indices, such that f can access the elements of the packet with one wide
+  // memory access. The indices at the end of the problem space that do not
+  // form a full packet are passed to remainder_f instead. The data_streamer
+  // must have been constructed with a problem size of
+  // max(problem_size / PacketSize, 1), and a group size of at least
+  // PacketSize.
+  //
+  // F is a callable of signature void(sycl::id<1>) that receives the first
+  // index of the packet, RemainderF is a callable of signature
+  // void(sycl::id<1>).
+  template <std::size_t PacketSize, class F, class RemainderF>
+  static void run_packets(std::size_t problem_size, sycl::nd_item<1> idx,
+                          F &&f, RemainderF &&remainder_f) noexcept {
+    const std::size_t num_packets = problem_size / PacketSize;
+    run(num_packets, idx, [&](sycl::id<1> packet_idx) {
+      f(sycl::id<1>{packet_idx[0] * PacketSize});
+    });
+
+    const std::size_t remainder_begin = num_packets * PacketSize;
+    const std::size_t gid = idx.get_global_id(0);
+    if (gid < problem_size - remainder_begin)
+      remainder_f(sycl::id<1>{remainder_begin + gid});
+  }
+
 private:
   static constexpr int cpu_work_per_item = 8;
 
+  template<class F0, class F>
+  static void run_device_peeled(std::size_t problem_size, sycl::nd_item<1> idx,
+                                F0 &&first_f, F &&f) noexcept {
+    const std::size_t gid = idx.get_global_id(0);
+    if(gid >= problem_size)
+      return;
+    first_f(sycl::id<1>{gid});
+    for (std::size_t i = gid + idx.get_global_range(0); i < problem_size;
+         i += idx.get_global_range(0)) {
+      f(sycl::id<1>{i});
+    }
+  }
+
+  template<class F0, class F>
+  static void run_host_peeled(std::size_t problem_size, sycl::nd_item<1> idx,
+                              F0 &&first_f, F &&f) noexcept {
+    const std::size_t gid = idx.get_global_id(0);
+    const std::size_t begin = cpu_work_per_item * gid;
+    if(begin >= problem_size)
+      return;
+    first_f(sycl::id<1>{begin});
+
+    const std::size_t last_group = idx.get_group_range(0) - 1;
+    if (idx.get_group_linear_id() != last_group) {
+#pragma clang unroll
+      for (int i = 1; i < cpu_work_per_item; ++i) {
+        f(sycl::id<1>{begin + i});
+      }
+    } else {
+      for (int i = 1; i < cpu_work_per_item; ++i) {
+        auto pos = begin + i;
+        if (pos < problem_size)
+          f(sycl::id<1>{pos});
+      }
+    }
+  }
+
   template<class F>
   static void run_device(std::size_t problem_size, sycl::nd_item<1> idx, F&& f) noexcept {
     const std::size_t gid = idx.get_global_id(0);
@@ -120,12 +242,14 @@ public:
   abortable_data_streamer(const sycl::device &dev, std::size_t problem_size,
                 std::size_t group_size)
       : _problem_size{problem_size}, _group_size{group_size} {
+    const std::size_t tile_size = group_size * work_per_item_per_tile;
     std::size_t default_num_groups =
-        (problem_size + group_size - 1) / group_size;
+        (problem_size + tile_size - 1) / tile_size;
 
     std::size_t desired_num_groups = 0;
     desired_num_groups =
-        dev.get_info<sycl::info::device::max_compute_units>() * 4;
+        dev.get_info<sycl::info::device::max_compute_units>() *
+        get_streaming_groups_per_compute_unit();
 
     _num_groups = std::min(default_num_groups, desired_num_groups);
   }
@@ -140,24 +264,45 @@ public:
 
   // Only to be called inside kernels.
   //
-  // Ensures that f is broadcast across the entire problem space.
-  // If f() returns true, will attempt to abort execution as quickly
-  // as possible.
-  // 
+  // Ensures that f is broadcast across the entire problem space. The
+  // problem space is split into tiles of consecutive indices, which the work
+  // groups process in increasing order of their position, such that early
+  // positions are processed first. Within a tile, each work item processes
+  // indices in increasing order.
+  //
+  // Before processing a tile, each work item invokes should_abort() with
+  // the first index of the tile, and stops if it returns true. This allows
+  // aborting execution across work groups without having to poll shared
+  // state for each index. If f() returns true, the work item stops
+  // immediately.
+  //
+  // ShouldAbort is a callable of signature bool(std::size_t),
   // F is a callable of signature bool(sycl::id<1>).
-  template <class F>
+  template <class ShouldAbort, class F>
   static void run(std::size_t problem_size, sycl::nd_item<1> idx,
-                  F &&f) noexcept {
+                  ShouldAbort &&should_abort, F &&f) noexcept {
+    const std::size_t group_size = idx.get_local_range(0);
+    const std::size_t tile_size = group_size * work_per_item_per_tile;
+    const std::size_t stride = idx.get_group_range(0) * tile_size;
+    const std::size_t lid = idx.get_local_id(0);
 
-
-    const std::size_t gid = idx.get_global_id(0);
-    for (std::size_t i = gid; i < problem_size; i += idx.get_global_range(0)) {
-      if(f(sycl::id<1>{i}))
+    for (std::size_t tile_begin = idx.get_group_linear_id() * tile_size;
+         tile_begin < problem_size; tile_begin += stride) {
+      if (should_abort(tile_begin))
         return;
+      for (int i = 0; i < work_per_item_per_tile; ++i) {
+        const std::size_t pos = tile_begin + i * group_size + lid;
+        if (pos >= problem_size)
+          return;
+        if (f(sycl::id<1>{pos}))
+          return;
+      }
     }
   };
 
 private:
+  static constexpr int work_per_item_per_tile = 8;
+
   std::size_t _num_groups;
   std::size_t _problem_size;
   std::size_t _group_size;
@@ -11,8 +11,13 @@
 #ifndef HIPSYCL_COMMON_APP_DB_HPP
 #define HIPSYCL_COMMON_APP_DB_HPP
 
+#include <array>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <atomic>
+#include <limits>
 #include <vector>
 #include <string>
 #include <ostream>
@@ -45,10 +50,26 @@ struct kernel_arg_entry {
   std::array<kernel_arg_value_statistics, max_tracked_values> common_values = {};
   std::array<bool, max_tracked_values> was_specialized = {};
 
+  // For pointer arguments: The smallest alignment in bytes that has been
+  // observed, or 0 if no pointer has been observed yet.
+  uint64_t min_pointer_alignment = 0;
+  // For pointer arguments: Whether the argument has been observed to be
+  // equal to another pointer argument of the same kernel invocation.
+  bool has_aliased = false;
+
+  // For non-pointer arguments: The largest observed value, and the smallest
+  // number of trailing zero bits of all observed values.
+  uint64_t max_value = 0;
+  uint64_t min_trailing_zeros = 64;
+
   template<class T>
   void pack(T &pack) {
     pack(common_values);
     pack(was_specialized);
+    pack(min_pointer_alignment);
+    pack(has_aliased);
+    pack(max_value);
+    pack(min_trailing_zeros);
   }
 
   void dump(std::ostream& ostr, int indentation_level=0) const;
@@ -62,10 +83,13 @@ struct kernel_entry {
     pack(num_registered_invocations);
     pack(retained_argument_indices);
     pack(first_iads_invocation_run);
+    pack(kernel_name);
   }
 
   void dump(std::ostream& ostr, int indentation_level=0) const;
 
+  // Backend kernel name, for reporting purposes
+  std::string kernel_name;
   std::vector<kernel_arg_entry> kernel_args;
   std::size_t num_registered_invocations = 0;
   std::vector<int> retained_argument_indices;
@@ -77,12 +101,175 @@ struct kernel_entry {
   uint64_t first_iads_invocation_run = no_usage;
 };
 
+struct jit_build_option_entry {
+  int option = 0;
+  bool is_int_value = false;
+  uint64_t int_value = 0;
+  std::string string_value;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(option);
+    pack(is_int_value);
+    pack(int_value);
+    pack(string_value);
+  }
+};
+
+struct jit_specialized_argument_entry {
+  int param_index = 0;
+  uint64_t value = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(param_index);
+    pack(value);
+  }
+};
+
+// Everything that is needed to repeat the JIT compilation of a binary
+// in a later application run, e.g. to precompile binaries at startup.
+struct jit_recipe {
+  static constexpr int no_backend = -1;
+
+  int backend = no_backend;
+  uint64_t hcf_object = 0;
+  std::string image;
+  std::vector<std::string> kernels;
+  std::vector<jit_build_option_entry> build_options;
+  std::vector<int> build_flags;
+  std::vector<jit_specialized_argument_entry> specialized_args;
+  bool dead_argument_elimination = false;
+  // param_index and alignment of pointer arguments
+  std::vector<jit_specialized_argument_entry> pointer_arg_alignments;
+  std::vector<int> noalias_pointer_args;
+  // param_index and exclusive upper bound or power-of-two divisor
+  // of integer arguments
+  std::vector<jit_specialized_argument_entry> arg_upper_bounds;
+  std::vector<jit_specialized_argument_entry> arg_divisors;
+  std::vector<uint64_t> branch_profile;
+
+  bool is_valid() const {
+    return backend != no_backend;
+  }
+
+  template<class T>
+  void pack(T &pack) {
+    pack(backend);
+    pack(hcf_object);
+    pack(image);
+    pack(kernels);
+    pack(build_options);
+    pack(build_flags);
+    pack(specialized_args);
+    pack(dead_argument_elimination);
+    pack(pointer_arg_alignments);
+    pack(noalias_pointer_args);
+    pack(arg_upper_bounds);
+    pack(arg_divisors);
+    pack(branch_profile);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
+// Hardware resources used by a kernel of a JIT-compiled binary, as reported
+// by the backend after compilation. Fields are 0 if the backend cannot
+// query them.
+struct kernel_resource_usage_entry {
+  std::string kernel_name;
+  // Registers per work item
+  uint64_t num_registers = 0;
+  // Bytes per work item that are spilled to memory
+  uint64_t spill_bytes = 0;
+  // Bytes per work item of private memory that is not held in registers,
+  // including spills
+  uint64_t private_mem_bytes = 0;
+  // Statically allocated local memory per work group in bytes
+  uint64_t local_mem_bytes = 0;
+  // Largest work group size that the kernel can be launched with
+  uint64_t max_group_size = 0;
+  // Theoretical occupancy, in percent of the work items that can be
+  // resident on a compute unit, for the group size and dynamic local
+  // memory of the launch that created the binary
+  uint64_t occupancy = 0;
+  uint64_t occupancy_group_size = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(kernel_name);
+    pack(num_registers);
+    pack(spill_bytes);
+    pack(private_mem_bytes);
+    pack(local_mem_bytes);
+    pack(max_group_size);
+    pack(occupancy);
+    pack(occupancy_group_size);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
 struct binary_entry {
   std::string jit_cache_filename;
+  jit_recipe recipe;
+  // Size of the binary in the persistent cache in bytes, after compression
+  uint64_t binary_size = 0;
+  // Hash of the stored binary, which identifies binaries of different ids
+  // that can share their storage
+  uint64_t content_hash = 0;
+  // Time of the last store or persistent cache hit, in seconds since epoch
+  uint64_t last_used = 0;
+  // Duration of the JIT compilation that produced the binary in ns, or 0 if
+  // unknown
+  uint64_t compilation_time = 0;
+  std::vector<kernel_resource_usage_entry> kernel_resources;
 
   template<class T>
   void pack(T &pack) {
     pack(jit_cache_filename);
+    pack(recipe);
+    pack(binary_size);
+    pack(content_hash);
+    pack(last_used);
+    pack(compilation_time);
+    pack(kernel_resources);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
+// Group size that the runtime has determined for a kernel on a particular
+// device, see rt::group_size_cache
+struct group_size_entry {
+  uint64_t x = 0;
+  uint64_t y = 0;
+  uint64_t z = 0;
+  // Whether the group size was selected by measuring candidate group sizes,
+  // see rt::group_size_autotuner
+  bool is_autotuned = false;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(x);
+    pack(y);
+    pack(z);
+    pack(is_autotuned);
+  }
+
+  void dump(std::ostream& ostr, int indentation_level=0) const;
+};
+
+// Branch counters recorded by instrumented kernels for a kernel
+// configuration, see rt::kernel_adaptivity_engine
+struct branch_profile_entry {
+  std::vector<uint64_t> counters;
+  uint64_t num_profiled_invocations = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(counters);
+    pack(num_profiled_invocations);
   }
 
   void dump(std::ostream& ostr, int indentation_level=0) const;
@@ -97,42 +284,265 @@ struct appdb_data {
   std::unordered_map<rt::kernel_configuration::id_type, binary_entry,
                      rt::kernel_id_hash>
       binaries;
+  std::unordered_map<rt::kernel_configuration::id_type, group_size_entry,
+                     rt::kernel_id_hash>
+      group_sizes;
+  std::unordered_map<rt::kernel_configuration::id_type, branch_profile_entry,
+                     rt::kernel_id_hash>
+      branch_profiles;
 
   template<class T>
   void pack(T &pack) {
     pack(kernels);
     pack(binaries);
+    pack(group_sizes);
     pack(content_version);
+    pack(branch_profiles);
   }
 
   void dump(std::ostream& ostr, int indentation_level=0) const;
 };
 
+/// Folds the statistics that have been accumulated in \c updated since it
+/// was identical to \c base into \c target, which may have been modified
+/// independently in the meantime (e.g. by other threads or processes).
+void merge_kernel_entry_delta(kernel_entry &target, const kernel_entry &base,
+                              const kernel_entry &updated);
+
+/// The kernel argument statistics of an appdb, without binaries or other
+/// entries that are specific to a node. Profiles can be exported from the
+/// appdb of one node and merged into the appdb of another node running the
+/// same application, such that invariant argument detection can specialize
+/// kernels there from their first invocation.
+struct kernel_profile_data {
+  // appdb::format_version of the appdb that the profile was exported from
+  uint64_t format_version = 0;
+  std::unordered_map<rt::kernel_configuration::id_type, kernel_entry,
+                     rt::kernel_id_hash>
+      kernels;
 
+  template<class T>
+  void pack(T &pack) {
+    pack(format_version);
+    pack(kernels);
+  }
+};
+
+/// Writes the kernel entries of \c data to a profile file at \c path.
+/// Returns false if the file could not be written.
+bool export_kernel_profile(const appdb_data &data, const std::string &path);
+
+/// Reads a profile file written by export_kernel_profile(). Returns false if
+/// the file could not be read, or if it has been exported from an appdb with
+/// a different format version.
+bool read_kernel_profile(const std::string &path, kernel_profile_data &out);
+
+/// Adds the statistics of \c profile to the kernel entries of \c data, as if
+/// the invocations recorded in the profile had taken place in a previous
+/// run of the application. Returns the number of merged kernel entries.
+std::size_t merge_kernel_profile(appdb_data &data,
+                                 const kernel_profile_data &profile);
+
+/// Returns the total size of all binaries in the persistent JIT cache that
+/// could be evicted, i.e. all binaries with a cache file that is not shared
+/// with other binaries (such as the packed cache archive).
+uint64_t get_evictable_binaries_size(const appdb_data& data);
+
+/// Removes up to \c max_evictions least recently used binary entries
+/// that could be evicted (see get_evictable_binaries_size()), until their
+/// total size no longer exceeds \c max_size.
+/// Returns the cache files of the removed entries, which the caller is
+/// expected to delete using remove_jit_cache_file().
+std::vector<std::string>
+evict_lru_binaries(appdb_data &data, uint64_t max_size,
+                   std::size_t max_evictions =
+                       std::numeric_limits<std::size_t>::max());
+
+/// Returns the path of the lock file that serializes the JIT compilation of
+/// the binary stored in \c jit_cache_file across processes.
+std::string get_jit_cache_lock_file(const std::string &jit_cache_file);
+
+/// Deletes a persistent JIT cache file along with its shared compilation
+/// lock file, if any.
+void remove_jit_cache_file(const std::string &jit_cache_file);
+
+/// The application database.
+///
+/// The database file consists of a hash index for each type of entry,
+/// followed by the individually serialized entries. The file is
+/// memory-mapped, and entries are only deserialized when they are accessed.
+/// Accessing individual entries with read_entry() and read_write_entry()
+/// is therefore cheap even for large databases, while read_access() and
+/// read_write_access() first load all entries. On destruction, only entries
+/// that have been accessed for writing are serialized again, all other
+/// entries are copied from the mapped file.
+///
+/// Multiple processes may use the same database concurrently. When the
+/// database is stored, the file is locked and modifications are merged
+/// into its current content: Kernel statistics accumulated by this process
+/// are added to the statistics stored by other processes in the meantime,
+/// other modified entries replace the stored ones.
 class appdb  {
 public:
   // DO NOT FORGET TO INCREMENT THIS WHEN ADDING/REMOVING
   // FIELDS OR OTHERWISE CHANGING THE DATA LAYOUT!
-  static const uint64_t format_version = 4;
+  static const uint64_t format_version = 13;
+
+  using id_type = rt::kernel_configuration::id_type;
 
   appdb(const std::string& db_path);
   ~appdb();
 
+  appdb(const appdb&) = delete;
+  appdb& operator=(const appdb&) = delete;
+
   template<class F>
   auto read_access(F&& handler) const{
+    load_all_entries();
     read_lock lock {_lock};
     return handler(_data);
   }
 
   template<class F>
   auto read_write_access(F&& handler) {
+    load_all_entries();
     write_lock lock {_lock};
     _was_modified = true;
+    _are_all_entries_dirty = true;
     return handler(_data);
   }
 
+  /// Invokes handler with a pointer to the entry of type \c Entry
+  /// (e.g. kernel_entry or binary_entry) with the given id, or nullptr if
+  /// there is no such entry.
+  template<class Entry, class F>
+  auto read_entry(const id_type& id, F&& handler) const {
+    {
+      read_lock lock {_lock};
+      const auto& entries = get_entries<Entry>(_data);
+      auto it = entries.find(id);
+      if(it != entries.end())
+        return handler(static_cast<const Entry*>(&it->second));
+      if(!has_unloaded_entry(get_section<Entry>(), id))
+        return handler(static_cast<const Entry*>(nullptr));
+    }
+    write_lock lock {_lock};
+    return handler(static_cast<const Entry*>(load_entry<Entry>(id)));
+  }
+
+  /// Invokes handler with a reference to the entry of type \c Entry with
+  /// the given id, which is created if it does not exist.
+  template<class Entry, class F>
+  auto read_write_entry(const id_type& id, F&& handler) {
+    write_lock lock {_lock};
+    _was_modified = true;
+    _dirty_entries[get_section<Entry>()].insert(id);
+
+    Entry* entry = load_entry<Entry>(id);
+    if(!entry)
+      entry = &get_entries<Entry>(_data)[id];
+    return handler(*entry);
+  }
+
+  /// The number of times the database has been modified and stored before
+  /// it was loaded.
+  std::size_t get_content_version() const {
+    return _content_version;
+  }
+
 private:
-  
+  enum section : int {
+    kernels_section = 0,
+    binaries_section,
+    group_sizes_section,
+    branch_profiles_section,
+    num_sections
+  };
+
+  template<class Entry>
+  static constexpr section get_section() {
+    if constexpr(std::is_same_v<Entry, kernel_entry>)
+      return kernels_section;
+    else if constexpr(std::is_same_v<Entry, binary_entry>)
+      return binaries_section;
+    else if constexpr(std::is_same_v<Entry, group_size_entry>)
+      return group_sizes_section;
+    else {
+      static_assert(std::is_same_v<Entry, branch_profile_entry>,
+                    "Unsupported appdb entry type");
+      return branch_profiles_section;
+    }
+  }
+
+  template<class Entry, class Data>
+  static auto& get_entries(Data& data) {
+    if constexpr(get_section<Entry>() == kernels_section)
+      return data.kernels;
+    else if constexpr(get_section<Entry>() == binaries_section)
+      return data.binaries;
+    else if constexpr(get_section<Entry>() == group_sizes_section)
+      return data.group_sizes;
+    else
+      return data.branch_profiles;
+  }
+
+  struct index_slot {
+    uint64_t id[2];
+    uint64_t offset;
+    // 0 for empty slots
+    uint64_t size;
+  };
+
+  struct section_index {
+    const index_slot* slots = nullptr;
+    uint64_t num_slots = 0;
+  };
+
+  // Returns the serialized entry from the mapped file.
+  bool find_serialized_entry(section s, const id_type &id,
+                             std::string_view &out) const;
+  // Assumes that the lock is held. Returns whether the entry is in the
+  // mapped file, but has not yet been loaded.
+  bool has_unloaded_entry(section s, const id_type &id) const {
+    std::string_view unused;
+    return !_are_all_entries_loaded && find_serialized_entry(s, id, unused);
+  }
+
+  // Assumes that the write lock is held.
+  template<class Entry>
+  Entry* load_entry(const id_type& id) const {
+    auto& entries = get_entries<Entry>(_data);
+    auto it = entries.find(id);
+    if(it != entries.end())
+      return &it->second;
+
+    // Entries that are not in memory after all entries have been loaded
+    // have been removed.
+    std::string_view serialized;
+    if (_are_all_entries_loaded ||
+        !find_serialized_entry(get_section<Entry>(), id, serialized))
+      return nullptr;
+    std::error_code ec;
+    Entry entry = msgpack::unpack<Entry>(
+        reinterpret_cast<const uint8_t *>(serialized.data()),
+        serialized.size(), ec);
+    return &entries.emplace(id, std::move(entry)).first->second;
+  }
+
+  void load_all_entries() const;
+  template<class Entry>
+  void load_all_entries_of_type() const;
+
+  void map_file();
+  void unmap_file();
+  // Serializes the entries, merged with the entries of the database
+  // currently stored in the file.
+  std::string serialize(const appdb& current) const;
+  template<class Entry>
+  void serialize_entries(
+      const appdb &current,
+      std::vector<std::pair<id_type, std::string>> &out) const;
+
   struct write_lock {
   public:
     write_lock(std::atomic<int>& op_counter)
@@ -173,10 +583,24 @@ private:
 
   mutable std::atomic<int> _lock;
   bool _was_modified;
+  bool _are_all_entries_dirty;
+  mutable bool _are_all_entries_loaded;
 
   std::string _db_path;
-
-  appdb_data _data;
+  std::size_t _content_version;
+
+  // Content of the database file, either memory-mapped or read into
+  // _file_buffer
+  const char* _file_data;
+  std::size_t _file_size;
+  bool _is_mapped;
+  std::string _file_buffer;
+  std::array<section_index, num_sections> _indices;
+
+  // Entries that have been loaded from the file or created
+  mutable appdb_data _data;
+  std::array<std::unordered_set<id_type, rt::kernel_id_hash>, num_sections>
+      _dirty_entries;
 };
 
 
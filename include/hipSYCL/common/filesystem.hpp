@@ -43,9 +43,37 @@ std::vector<std::string> list_regular_files(const std::string &directory,
 /// Writes data atomically to filename
 bool atomic_write(const std::string& filename, const std::string& data);
 
+/// Atomically makes filename a hard link to the existing file. Returns false
+/// if the filesystem does not support hard links.
+bool atomic_hard_link(const std::string& existing, const std::string& filename);
+
 /// Removes a file, returns true if successful.
 bool remove(const std::string &filename);
 
+/// Exclusive advisory lock on a file, which synchronizes multiple processes.
+/// The file is created if it does not exist. The lock is released on
+/// destruction, or when the process terminates.
+class file_lock {
+public:
+  /// Blocks until the lock has been acquired.
+  file_lock(const std::string& path);
+  /// Gives up if the lock could not be acquired within timeout_ms
+  /// milliseconds.
+  file_lock(const std::string& path, std::size_t timeout_ms);
+  ~file_lock();
+
+  file_lock(const file_lock&) = delete;
+  file_lock& operator=(const file_lock&) = delete;
+
+  /// Whether the lock is held. This is false if the lock timed out, or if
+  /// the file could not be created.
+  bool is_locked() const {
+    return _fd >= 0;
+  }
+private:
+  int _fd = -1;
+};
+
 class persistent_storage {
 public:
   static persistent_storage& get() {
@@ -15,6 +15,7 @@
 #include <cstddef>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <sstream>
@@ -126,17 +127,20 @@ public:
   }
 
   hcf_container(const std::string& container) {
-    std::string appendix_id {_binary_appendix_id};
-
-    std::size_t appendix_begin = container.find(appendix_id);
-    if(appendix_begin != std::string::npos) {
-      _binary_appendix = container.substr(appendix_begin + appendix_id.length());
-    }
-
-    std::string parseable_data = container;
-    parseable_data.erase(appendix_begin);
+    std::string_view appendix = parse_container(container);
+    _binary_appendix = std::string{appendix};
+  }
 
-    parse(parseable_data);
+  /// Parses a container whose data outlives the hcf_container and all of
+  /// its copies, such as an HCF object embedded into the application
+  /// binary. Unlike the std::string constructor, this does not copy the
+  /// binary appendix; binary attachments are retrieved directly from
+  /// \c container.
+  static hcf_container from_persistent_data(std::string_view container) {
+    hcf_container result;
+    result._external_appendix = result.parse_container(container);
+    result._has_external_appendix = true;
+    return result;
   }
 
   const node* root_node() const {
@@ -148,6 +152,18 @@ public:
   }
 
   bool get_binary_attachment(const node* n, std::string& out) const {
+    std::string_view attachment;
+    if(!get_binary_attachment(n, attachment))
+      return false;
+    out = std::string{attachment};
+    return true;
+  }
+
+  /// Retrieves a view of the binary attachment, which remains valid until
+  /// the hcf_container is modified or destroyed - or, for containers
+  /// constructed with from_persistent_data(), as long as the underlying
+  /// data.
+  bool get_binary_attachment(const node* n, std::string_view& out) const {
     std::size_t start = 0;
     std::size_t size = 0;
 
@@ -183,12 +199,13 @@ public:
     start = std::stoull(*start_entry);
     size = std::stoull(*size_entry);
 
-    if(start + size > _binary_appendix.size()) {
+    std::string_view appendix = get_binary_appendix();
+    if(start + size > appendix.size()) {
       HIPSYCL_DEBUG_ERROR << "hcf: Binary content address is out-of-bounds\n";
       return false;
     }
 
-    out = _binary_appendix.substr(start, size);
+    out = appendix.substr(start, size);
 
     return true;
   }
@@ -199,6 +216,11 @@ public:
     if(!binary_node)
       return false;
 
+    if(_has_external_appendix) {
+      _binary_appendix = std::string{_external_appendix};
+      _has_external_appendix = false;
+    }
+
     std::size_t start = _binary_appendix.size();
     std::size_t length = binary_content.size();
 
@@ -215,9 +237,29 @@ public:
     serialize_node(_root_node, sstr);
     sstr << _binary_appendix_id;
 
-    return sstr.str() + _binary_appendix;
+    std::string result = sstr.str();
+    result += get_binary_appendix();
+    return result;
   }
 private:
+  std::string_view get_binary_appendix() const {
+    if(_has_external_appendix)
+      return _external_appendix;
+    return _binary_appendix;
+  }
+
+  // Parses the text part of the container, and returns the binary appendix
+  std::string_view parse_container(std::string_view container) {
+    std::string_view appendix;
+    std::size_t appendix_begin = container.find(_binary_appendix_id);
+    if(appendix_begin != std::string_view::npos) {
+      appendix = container.substr(appendix_begin +
+                                  std::string_view{_binary_appendix_id}.size());
+      container = container.substr(0, appendix_begin);
+    }
+    parse(container);
+    return appendix;
+  }
 
   void serialize_node(const node& n, std::ostream& out) const {
     for(const auto& p : n.key_value_pairs){
@@ -230,118 +272,80 @@ private:
     }
   }
 
-  void trim_left(std::string& str) const
-  {
-    auto it2 = std::find_if(str.begin(), str.end(), [](char ch) {
-      return !std::isspace<char>(ch, std::locale::classic());
-    });
-    str.erase(str.begin(), it2);
+  static bool is_space(char ch) {
+    return std::isspace<char>(ch, std::locale::classic());
   }
 
-  void trim_right(std::string& str) const
-  {
-    auto it1 = std::find_if(str.rbegin(), str.rend(), [](char ch) {
-      return !std::isspace<char>(ch, std::locale::classic());
-    });
-    str.erase(it1.base(), str.end());
+  static std::string_view trim(std::string_view str) {
+    std::size_t begin = 0;
+    while(begin < str.size() && is_space(str[begin]))
+      ++begin;
+    std::size_t end = str.size();
+    while(end > begin && is_space(str[end - 1]))
+      --end;
+    return str.substr(begin, end - begin);
   }
 
-  bool parse_node_start(const std::string& start_line, std::string& node_id) const {
-    std::string processed_data = start_line;
-    std::string node_start_id = std::string{_node_start_id};
-
-    trim_left(processed_data);
-    
-    if(processed_data.find(node_start_id) != 0) {
-      HIPSYCL_DEBUG_ERROR << "hcf: Invalid node start: " << processed_data
-                          << "\n";
-      return false;
-    }
-
-
-    processed_data.erase(0, node_start_id.length());
-    trim_right(processed_data);
-
-    node_id = processed_data;
-
-    return true;
+  static bool starts_with(std::string_view str, std::string_view prefix) {
+    return str.substr(0, prefix.size()) == prefix;
   }
 
-  bool parse_node_interior(const std::vector<std::string>& lines, 
-                           std::size_t node_start_line,
-                           std::size_t node_end_line,
-                           node& current_node) const {
-
-    if(node_start_line == node_end_line)
-      return true;
+  // Parses all lines in a single pass, keeping track of the currently open
+  // nodes. This avoids splitting the data into separate strings first.
+  bool parse(std::string_view data) {
+    const std::string_view node_start_id{_node_start_id};
+    const std::string_view node_end_id{_node_end_id};
 
-    for(int i = node_start_line; i <  node_end_line; ++i) {
-      assert(i < lines.size());
-      const std::string& current = lines[i];
-
-      if(current.find(_node_start_id) == 0) {
+    _root_node.node_id = "root";
+    // Subnodes are only appended to the innermost open node, so pointers
+    // to the open nodes remain valid.
+    std::vector<node*> open_nodes{&_root_node};
+
+    std::size_t line_begin = 0;
+    while(line_begin < data.size()) {
+      std::size_t line_end = data.find('\n', line_begin);
+      if(line_end == std::string_view::npos)
+        line_end = data.size();
+      std::string_view current =
+          trim(data.substr(line_begin, line_end - line_begin));
+      line_begin = line_end + 1;
+
+      if(current.empty())
+        continue;
+
+      node& current_node = *open_nodes.back();
+      if(starts_with(current, node_start_id)) {
         node new_node;
-
-        if(!parse_node_start(current, new_node.node_id)) {
-          return false;
-        }
-
-        std::size_t num_node_lines = std::string::npos;
-        std::string node_end_marker = _node_end_id + new_node.node_id;
-        
-        for(int j = i + 1; j < node_end_line; ++j) {
-          if(lines[j] == node_end_marker) {
-            num_node_lines = j-i;
-            break;
-          }
-        }
-        if(num_node_lines == std::string::npos) {
-          HIPSYCL_DEBUG_ERROR
-              << "hcf: Syntax error: Did not find expected node end marker: "
-              << node_end_marker << "\n";
-          return false;
-        }
-        if(!parse_node_interior(lines, i+1, i+num_node_lines, new_node))
-          return false;
-
-        current_node.subnodes.push_back(new_node);
-        i += num_node_lines;
-      } else if(current.find("=") != std::string::npos) {
-        std::size_t pos = current.find("=");
-        std::string key = current.substr(0, pos);
-        std::string value = current.substr(pos+1);
-        current_node.key_value_pairs.push_back(std::make_pair(key, value));
-      } else if(current.find(_node_end_id) == 0) {
-        HIPSYCL_DEBUG_ERROR << "hcf: Syntax error: Unexpected node end: " << current
-                          << "\n";
+        new_node.node_id =
+            std::string{trim(current.substr(node_start_id.size()))};
+        current_node.subnodes.push_back(std::move(new_node));
+        open_nodes.push_back(&current_node.subnodes.back());
+      } else if(open_nodes.size() > 1 && starts_with(current, node_end_id) &&
+                current.substr(node_end_id.size()) == current_node.node_id) {
+        open_nodes.pop_back();
+      } else if(current.find('=') != std::string_view::npos) {
+        std::size_t pos = current.find('=');
+        current_node.key_value_pairs.push_back(
+            std::make_pair(std::string{current.substr(0, pos)},
+                           std::string{current.substr(pos + 1)}));
+      } else if(starts_with(current, node_end_id)) {
+        HIPSYCL_DEBUG_ERROR << "hcf: Syntax error: Unexpected node end: "
+                            << current << "\n";
         return false;
       } else {
         HIPSYCL_DEBUG_ERROR << "hcf: Syntax error: Invalid line: " << current
-                          << "\n";
+                            << "\n";
         return false;
       }
-
     }
 
-    return true;
-  }
-
-  bool parse(const std::string& data) {
-    std::stringstream ss(data);
-    std::string line;
-
-    std::vector<std::string> lines;
-    
-    while(std::getline(ss,line)){
-      trim_left(line);
-      trim_right(line);
-
-      if(!line.empty())
-        lines.push_back(line);
+    if(open_nodes.size() > 1) {
+      HIPSYCL_DEBUG_ERROR
+          << "hcf: Syntax error: Did not find expected node end marker: "
+          << _node_end_id << open_nodes.back()->node_id << "\n";
+      return false;
     }
-
-    _root_node.node_id = "root";
-    return parse_node_interior(lines, 0, lines.size(), _root_node);
+    return true;
   }
 
   static constexpr char _binary_appendix_id [] = "__acpp_hcf_binary_appendix";
@@ -351,6 +355,9 @@ private:
 
   node _root_node;
   std::string _binary_appendix;
+  // Binary appendix for containers constructed with from_persistent_data()
+  std::string_view _external_appendix;
+  bool _has_external_appendix = false;
 };
 
 }
@@ -0,0 +1,128 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_COMMON_READ_MOSTLY_MAP_HPP
+#define HIPSYCL_COMMON_READ_MOSTLY_MAP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hipsycl {
+namespace common {
+
+/// Maps keys to non-owning pointers, and allows for lookups that neither
+/// lock nor write to shared memory, concurrently with insertions.
+///
+/// Entries cannot be removed individually. When the table grows, it is
+/// copied to a larger table, and the old table is retired until clear() or
+/// destruction, since concurrent readers may still be probing it.
+///
+/// find() is thread-safe. insert_or_assign() and clear() must be
+/// serialized by the caller, and clear() must not run concurrently with
+/// find().
+template <class Key, class T, class Hash>
+class read_mostly_map {
+public:
+  read_mostly_map() { clear(); }
+
+  read_mostly_map(const read_mostly_map &) = delete;
+  read_mostly_map &operator=(const read_mostly_map &) = delete;
+
+  /// \return The stored pointer, or nullptr if the key is not present.
+  T *find(const Key &key) const {
+    const table *t = _current.load(std::memory_order_acquire);
+    for (std::size_t i = t->first_slot(key);; i = t->next_slot(i)) {
+      T *value = t->slots[i].value.load(std::memory_order_acquire);
+      if (!value)
+        return nullptr;
+      // The key is immutable once the value has been published
+      if (t->slots[i].key == key)
+        return value;
+    }
+  }
+
+  /// \c value must not be nullptr.
+  void insert_or_assign(const Key &key, T *value) {
+    table *t = _current.load(std::memory_order_relaxed);
+    slot *existing = find_slot(*t, key);
+    if (existing->value.load(std::memory_order_relaxed)) {
+      existing->value.store(value, std::memory_order_release);
+      return;
+    }
+
+    // Keep the load factor at most 1/2, such that probe sequences are short
+    if (2 * (_size + 1) > t->slots.size()) {
+      auto grown = std::make_unique<table>(2 * t->slots.size());
+      for (const slot &s : t->slots)
+        if (T *v = s.value.load(std::memory_order_relaxed))
+          publish(*find_slot(*grown, s.key), s.key, v);
+      t = grown.get();
+      _tables.push_back(std::move(grown));
+      _current.store(t, std::memory_order_release);
+    }
+    publish(*find_slot(*t, key), key, value);
+    ++_size;
+  }
+
+  void clear() {
+    _tables.clear();
+    _tables.push_back(std::make_unique<table>(initial_capacity));
+    _current.store(_tables.back().get(), std::memory_order_release);
+    _size = 0;
+  }
+
+  std::size_t size() const { return _size; }
+
+private:
+  static constexpr std::size_t initial_capacity = 64;
+
+  struct slot {
+    std::atomic<T *> value = nullptr;
+    Key key{};
+  };
+
+  struct table {
+    // num_slots must be a power of two
+    explicit table(std::size_t num_slots)
+        : slots(num_slots), mask{num_slots - 1} {}
+
+    std::size_t first_slot(const Key &key) const { return Hash{}(key) & mask; }
+    std::size_t next_slot(std::size_t i) const { return (i + 1) & mask; }
+
+    std::vector<slot> slots;
+    std::size_t mask;
+  };
+
+  // \return The slot of the key if present, otherwise the empty slot where
+  // it would be inserted. Only safe to call from the inserting thread.
+  static slot *find_slot(table &t, const Key &key) {
+    for (std::size_t i = t.first_slot(key);; i = t.next_slot(i)) {
+      slot &s = t.slots[i];
+      if (!s.value.load(std::memory_order_relaxed) || s.key == key)
+        return &s;
+    }
+  }
+
+  static void publish(slot &s, const Key &key, T *value) {
+    s.key = key;
+    s.value.store(value, std::memory_order_release);
+  }
+
+  std::atomic<table *> _current;
+  std::vector<std::unique_ptr<table>> _tables;
+  std::size_t _size = 0;
+};
+
+}
+}
+
+#endif
@@ -29,6 +29,7 @@ struct MDKind {
   static constexpr const char InnerLoop[] = "hipSYCL.loop.inner";
   static constexpr const char WorkItemLoop[] = "hipSYCL.loop.workitem";
   static constexpr const char LoopState[] = "hipSYCL.loop_state";
+  static constexpr const char VectorShape[] = "hipSYCL.vector_shape";
 };
 
 namespace cbs {
@@ -84,6 +85,8 @@ llvm::Loop *updateDtAndLi(llvm::LoopInfo &LI, llvm::DominatorTree &DT, const llv
 bool isBarrier(const llvm::Instruction *I, const SplitterAnnotationInfo &SAA);
 bool blockHasBarrier(const llvm::BasicBlock *BB,
                      const hipsycl::compiler::SplitterAnnotationInfo &SAA);
+bool isTrailingBarrier(const llvm::Instruction *Barrier,
+                       const hipsycl::compiler::SplitterAnnotationInfo &SAA);
 bool hasBarriers(const llvm::Function &F, const hipsycl::compiler::SplitterAnnotationInfo &SAA);
 bool hasOnlyBarrier(const llvm::BasicBlock *BB,
                     const hipsycl::compiler::SplitterAnnotationInfo &SAA);
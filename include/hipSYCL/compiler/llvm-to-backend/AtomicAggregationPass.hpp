@@ -0,0 +1,34 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_ATOMIC_AGGREGATION_PASS_HPP
+#define HIPSYCL_SSCP_ATOMIC_AGGREGATION_PASS_HPP
+
+#include <llvm/IR/PassManager.h>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Replaces calls to the integer __acpp_sscp_atomic_fetch_add_* builtins
+/// with relaxed memory order on global or generic memory by the
+/// corresponding __acpp_sscp_atomic_fetch_add_aggregated_* builtins.
+/// Those combine the additions of all work items of a sub-group that target
+/// the same address into a single atomic operation.
+///
+/// The pass must run before __acpp_sscp_* builtins are resolved.
+class AtomicAggregationPass : public llvm::PassInfoMixin<AtomicAggregationPass> {
+public:
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+};
+
+}
+}
+
+#endif
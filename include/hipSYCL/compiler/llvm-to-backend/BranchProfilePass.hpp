@@ -0,0 +1,61 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_BRANCH_PROFILE_PASS_HPP
+#define HIPSYCL_SSCP_BRANCH_PROFILE_PASS_HPP
+
+#include <llvm/IR/PassManager.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+// Branch profiles are arrays of 64-bit counters. The first counter holds the number of
+// conditional branches in the profiled kernels, followed by the number of times the
+// true and false successor of each branch was taken. Both passes enumerate branches
+// in the same order, so they must run at the same point of the pipeline.
+
+/// Counts taken branches of kernels in the counter array at the given device-accessible
+/// address. Only the first (NumCounters - 1) / 2 branches are counted.
+class BranchProfileInstrumentationPass
+    : public llvm::PassInfoMixin<BranchProfileInstrumentationPass> {
+public:
+  BranchProfileInstrumentationPass(const std::vector<std::string> &KernelNames,
+                                   uint64_t CountersAddress, std::size_t NumCounters,
+                                   unsigned GlobalAddressSpace);
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+
+private:
+  std::vector<std::string> KernelNames;
+  uint64_t CountersAddress;
+  std::size_t NumCounters;
+  unsigned GlobalAddressSpace;
+};
+
+/// Attaches branch weights from a branch profile to the conditional branches of kernels.
+/// Nothing is done if the profile was recorded for a different number of branches.
+class BranchProfileAnnotationPass : public llvm::PassInfoMixin<BranchProfileAnnotationPass> {
+public:
+  BranchProfileAnnotationPass(const std::vector<std::string> &KernelNames,
+                              const std::vector<uint64_t> &Profile);
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+
+private:
+  std::vector<std::string> KernelNames;
+  std::vector<uint64_t> Profile;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_KERNEL_ARGUMENT_ATTRIBUTE_INFERENCE_PASS_HPP
+#define HIPSYCL_SSCP_KERNEL_ARGUMENT_ATTRIBUTE_INFERENCE_PASS_HPP
+
+#include <llvm/IR/PassManager.h>
+
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Infers readonly and noalias attributes for pointer arguments of kernels,
+/// which allows backends to use dedicated paths for read-only global data,
+/// such as non-coherent loads (ld.global.nc) on PTX or scalar loads on AMDGPU.
+///
+/// An argument is readonly if no pointer derived from it is written through
+/// or escapes, following pointers into calls of defined functions. A readonly
+/// argument is additionally noalias if every write of the kernel provably
+/// targets memory that an argument cannot point to: allocas, static local
+/// memory, or other arguments that are already noalias (e.g. due to the
+/// jitopt_iads_pointer_noalias specialization).
+///
+/// The pass should run after backend flavoring, such that the kernels are
+/// the functions that are eventually launched, and before optimization.
+class KernelArgumentAttributeInferencePass
+    : public llvm::PassInfoMixin<KernelArgumentAttributeInferencePass> {
+public:
+  KernelArgumentAttributeInferencePass(const std::vector<std::string> &Kernels,
+                                       unsigned GlobalAddressSpace, unsigned LocalAddressSpace);
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+
+private:
+  std::vector<std::string> KernelNames;
+  unsigned GlobalAddressSpace;
+  unsigned LocalAddressSpace;
+};
+
+}
+}
+
+#endif
@@ -29,6 +29,7 @@
 namespace llvm {
 class Module;
 class Function;
+class Value;
 }
 
 namespace hipsycl {
@@ -69,9 +70,35 @@ public:
   void setS2IRConstant(const std::string& name, const void* ValueBuffer);
   void specializeKernelArgument(const std::string &KernelName, int ParamIndex,
                                 const void *ValueBuffer);
+  // Allows the optimizer to assume that a pointer kernel argument is aligned
+  // to Alignment bytes.
+  void setKernelPointerArgumentAlignment(const std::string &KernelName, int ParamIndex,
+                                         uint64_t Alignment);
+  // Marks a pointer kernel argument as noalias.
+  void setKernelPointerArgumentNoAlias(const std::string &KernelName, int ParamIndex);
+  // Allows the optimizer to assume that an integer kernel argument, interpreted
+  // as unsigned value, is smaller than UpperBound.
+  void setKernelArgumentUpperBound(const std::string &KernelName, int ParamIndex,
+                                   uint64_t UpperBound);
+  // Allows the optimizer to assume that an integer kernel argument is a multiple
+  // of the power of two Divisor.
+  void setKernelArgumentDivisor(const std::string &KernelName, int ParamIndex,
+                                uint64_t Divisor);
+  // Instruments conditional branches of kernels to count how often they are
+  // taken, in an array of NumCounters uint64_t at the device-accessible Address.
+  void setBranchProfileCounters(uint64_t Address, std::size_t NumCounters);
+  // Attaches branch weights from counters recorded by instrumented kernels.
+  void setBranchProfile(const std::vector<uint64_t> &Profile);
   void specializeFunctionCalls(const std::string &FuncName,
                              const std::vector<std::string> &ReplacementCalls,
                              bool OverrideOnlyUndefined=true);
+  // Replaces calls to FuncName by a dispatch on the value of the kernel
+  // argument ParamIndex: If it equals the first element of a candidate,
+  // the candidate's replacement calls are invoked, or FuncName itself if
+  // there are none. The argument must always equal one of the candidates.
+  void specializeFunctionCallsOnArgument(
+      const std::string &KernelName, int ParamIndex, const std::string &FuncName,
+      const std::vector<std::pair<uint64_t, std::vector<std::string>>> &Candidates);
 
   bool setBuildFlag(const std::string &Flag);
   bool setBuildOption(const std::string &Option, const std::string &Value);
@@ -221,13 +248,39 @@ protected:
 
   bool GlobalSizesFitInInt = false;
   bool IsFastMath = false;
+  // Set for tier-0 compilations which should prefer compile time over
+  // code quality
+  bool IsFastCompile = false;
+  // Opt-in staging of overlapping global reads in local memory
+  bool IsLocalMemoryTiling = false;
+  // Opt-in sub-group aggregation of contended atomics
+  bool IsAggregateAtomics = false;
+  bool IsPerformanceRemarks = false;
+  // Opt-in padding of local memory against bank conflicts
+  bool IsLocalMemoryPadding = false;
+
+  uint64_t BranchProfileCountersAddress = 0;
+  std::size_t NumBranchProfileCounters = 0;
+  std::vector<uint64_t> BranchProfile;
 
 private:
 
   void resolveExternalSymbols(llvm::Module& M);
+  // Returns the function or call sequence wrapper that replaces calls to F,
+  // or nullptr after registering an error.
+  llvm::Value *getFunctionCallReplacement(llvm::Module &M, llvm::Function *F,
+                                          const std::vector<std::string> &ReplacementCalls,
+                                          const std::string &WrapperName);
+  // Provides the kernel arguments to function call dispatchers after they
+  // have been inlined into kernels.
+  bool resolveInlineCacheSelectors(llvm::Module &M);
   void setFailedIR(llvm::Module& M);
   void runKernelDeadArgumentElimination(llvm::Module &M, llvm::Function *F, PassHandler &PH,
                                         std::vector<int>& RetainedIndicesOut);
+  // Optimizes modules with many kernels by distributing the kernels across
+  // partitions that are optimized on multiple threads, and linking the results.
+  // Falls back to optimizeFlavoredIR() for small modules.
+  bool optimizeFlavoredIRInPartitions(llvm::Module& M, PassHandler& PH);
 
   int S2IRConstantBackendId;
   
@@ -236,6 +289,10 @@ private:
 
   std::vector<std::string> Errors;
   std::unordered_map<std::string, std::function<void(llvm::Module &)>> SpecializationApplicators;
+  // Functions that may be called after specializations have been applied
+  std::vector<std::string> SpecializationTargets;
+  // Kernel names and parameter indices that select dynamic function calls
+  std::vector<std::pair<std::string, int>> InlineCacheSelectors;
   ExternalSymbolResolver SymbolResolver;
   bool HasExternalSymbolResolver = false;
 
@@ -0,0 +1,61 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_LOCAL_MEMORY_PADDING_PASS_HPP
+#define HIPSYCL_SSCP_LOCAL_MEMORY_PADDING_PASS_HPP
+
+#include <llvm/IR/PassManager.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Pads the rows of local memory tiles that adjacent work items access
+/// column-wise, e.g. a tile[tx][ty] access of a local_accessor, such that
+/// the accesses no longer hit the same local memory bank.
+///
+/// If the stride of an access to the dynamic local memory across adjacent
+/// work items is a power of two that causes bank conflicts, the dynamic
+/// local memory of the kernel is relocated into static local memory with a
+/// layout that inserts padding after each row of that stride. Because the
+/// same mapping applies to all addresses, no knowledge about the extents of
+/// the individual accessors is needed. Kernels are only transformed if all
+/// uses of the dynamic local memory are plain loads and stores, and if the
+/// padded copy fits into the local memory that is assumed to be available
+/// in addition to the dynamic local memory that is still allocated by the
+/// runtime.
+///
+/// The pass must run after inlining, and before __acpp_sscp_* builtins are
+/// resolved.
+class LocalMemoryPaddingPass : public llvm::PassInfoMixin<LocalMemoryPaddingPass> {
+public:
+  LocalMemoryPaddingPass(const std::vector<std::string> &Kernels, int GroupSizeX,
+                         unsigned LocalAddressSpace, std::int64_t KnownLocalMemSize);
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+
+  /// The largest amount of static local memory in bytes that has been
+  /// added to a kernel.
+  std::int64_t getAddedLocalMemSize() const { return AddedLocalMemSize; }
+
+private:
+  std::vector<std::string> KernelNames;
+  int KnownGroupSizeX;
+  unsigned LocalAddressSpace;
+  std::int64_t KnownLocalMemSize;
+  std::int64_t AddedLocalMemSize = 0;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,49 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_LOCAL_MEMORY_TILING_PASS_HPP
+#define HIPSYCL_SSCP_LOCAL_MEMORY_TILING_PASS_HPP
+
+#include <llvm/IR/PassManager.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Stages overlapping global memory reads of 1D kernels into local memory.
+///
+/// If all work items of a group unconditionally load
+/// ptr[group_id * group_size + local_id + c] for several small constants c,
+/// e.g. in stencils, the loaded range is collectively copied into a
+/// local memory tile before the first group barrier, and the loads are
+/// replaced with loads from the tile. This requires the group size to be
+/// known, all other group dimensions to be 1, and that the kernel does not write
+/// memory before the loads. The pass must run after kernels have been
+/// inlined, but before __acpp_sscp_* builtins are resolved.
+class LocalMemoryTilingPass : public llvm::PassInfoMixin<LocalMemoryTilingPass> {
+public:
+  LocalMemoryTilingPass(const std::vector<std::string> &KernelNames, int KnownGroupSizeX,
+                        unsigned LocalAddressSpace, std::int64_t KnownLocalMemSize = -1);
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+
+private:
+  std::vector<std::string> KernelNames;
+  int KnownGroupSizeX;
+  unsigned LocalAddressSpace;
+  std::int64_t KnownLocalMemSize;
+};
+
+}
+}
+
+#endif
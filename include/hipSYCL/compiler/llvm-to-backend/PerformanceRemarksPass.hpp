@@ -0,0 +1,50 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_PERFORMANCE_REMARKS_PASS_HPP
+#define HIPSYCL_SSCP_PERFORMANCE_REMARKS_PASS_HPP
+
+#include <llvm/IR/PassManager.h>
+
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Prints remarks about memory accesses and branches of kernels that are
+/// likely to perform poorly on GPUs. The vector shape of each value with
+/// respect to the work item id in x direction is computed using the
+/// uniformity analysis of CBS, and the pass reports
+///  - global memory accesses that are strided or random across adjacent
+///    work items, and are thus not coalesced,
+///  - local memory accesses whose stride causes bank conflicts,
+///  - divergent branches and loops within loops.
+///
+/// This is only a static approximation: Work items are assumed to vary in
+/// x direction only, and the trip count of loops is unknown.
+///
+/// The pass must run after inlining, and before __acpp_sscp_* builtins are
+/// resolved. Apart from bringing loops into canonical form, it does not
+/// modify the IR.
+class PerformanceRemarksPass : public llvm::PassInfoMixin<PerformanceRemarksPass> {
+public:
+  PerformanceRemarksPass(const std::vector<std::string> &Kernels, unsigned LocalAS);
+  llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM);
+
+private:
+  std::vector<std::string> KernelNames;
+  unsigned LocalAddressSpace;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SSCP_WORK_ITEM_SHAPE_ANALYSIS_HPP
+#define HIPSYCL_SSCP_WORK_ITEM_SHAPE_ANALYSIS_HPP
+
+#include "hipSYCL/compiler/cbs/Region.hpp"
+#include "hipSYCL/compiler/cbs/VectorShape.hpp"
+#include "hipSYCL/compiler/cbs/VectorizationInfo.hpp"
+
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Analysis/PostDominators.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/Function.h>
+
+#include <optional>
+
+namespace hipsycl {
+namespace compiler {
+
+/// Computes how the values of an SSCP kernel vary across adjacent work
+/// items using the uniformity analysis of CBS. The local id in x direction
+/// is the varying dimension, all other __acpp_sscp_get_* builtins are
+/// assumed to be uniform. Pointer shapes are in bytes.
+///
+/// Must be applied to inlined kernels before __acpp_sscp_* builtins are
+/// resolved. Brings the loops of the kernel into canonical form.
+class WorkItemShapeAnalysis {
+public:
+  WorkItemShapeAnalysis(llvm::Function &F);
+
+  WorkItemShapeAnalysis(const WorkItemShapeAnalysis &) = delete;
+  WorkItemShapeAnalysis &operator=(const WorkItemShapeAnalysis &) = delete;
+
+  /// The shape of V, or an empty optional if it could not be determined.
+  std::optional<VectorShape> getShape(const llvm::Value &V) const;
+
+  const llvm::LoopInfo &getLoopInfo() const { return LI; }
+
+  /// Whether canonicalizing the loops has modified the kernel.
+  bool hasModifiedIR() const { return ModifiedIR; }
+
+private:
+  // Initialization order matters: Loops are canonicalized before the
+  // post-dominator tree and the region are constructed.
+  llvm::DominatorTree DT;
+  llvm::LoopInfo LI;
+  bool ModifiedIR;
+  llvm::PostDominatorTree PDT;
+  FunctionRegion RImpl;
+  Region R;
+  VectorizationInfo VecInfo;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_HOST_OBJECT_LOADER_HPP
+#define HIPSYCL_HOST_OBJECT_LOADER_HPP
+
+#include <memory>
+#include <string>
+
+// This header does not depend on LLVM, such that it can be used by the
+// runtime.
+
+namespace hipsycl {
+namespace compiler {
+
+/// Relocatable object emitted by LLVMToHostTranslator with the
+/// host-relocatable-object build flag, which has been linked into
+/// executable memory of the current process.
+class LoadedHostObject {
+public:
+  virtual ~LoadedHostObject() = default;
+  /// Returns nullptr if the symbol does not exist.
+  virtual void *getSymbolAddress(const std::string &Name) = 0;
+};
+
+/// Whether Binary is a relocatable object, as opposed to a shared library.
+bool isHostRelocatableObject(const std::string &Binary);
+
+/// Links the relocatable object in-process. Symbols that are not defined
+/// by the object are resolved against the current process. Returns nullptr
+/// and sets ErrorOut on failure.
+std::unique_ptr<LoadedHostObject> loadHostObject(const std::string &Object,
+                                                 std::string &ErrorOut);
+
+}
+}
+
+#endif
@@ -29,13 +29,24 @@ public:
   virtual bool prepareBackendFlavor(llvm::Module& M) override {return true;}
   virtual bool toBackendFlavor(llvm::Module &M, PassHandler& PH) override;
   virtual bool translateToBackendFormat(llvm::Module &FlavoredModule, std::string &out) override;
+
+  // Initializes the LLVM target of the host for in-process code generation.
+  static void initializeNativeTarget();
+  static bool isUsingLibmvec();
 protected:
   virtual bool applyBuildOption(const std::string &Option, const std::string &Value) override;
+  virtual bool applyBuildFlag(const std::string &Flag) override;
   virtual bool isKernelAfterFlavoring(llvm::Function& F) override;
   virtual AddressSpaceMap getAddressSpaceMap() const override;
   virtual void migrateKernelProperties(llvm::Function* From, llvm::Function* To) override;
 private:
+  // Generates a relocatable object in-process instead of linking a shared
+  // library with clang
+  bool emitRelocatableObject(llvm::Module &FlavoredModule, std::string &out);
+
   std::vector<std::string> KernelNames;
+  unsigned SubGroupSize = 1;
+  bool EmitRelocatableObject = false;
 };
 
 }
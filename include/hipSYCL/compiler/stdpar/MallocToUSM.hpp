@@ -20,7 +20,14 @@ namespace compiler {
 
 class MallocToUSMPass : public llvm::PassInfoMixin<MallocToUSMPass> {
 public:
+  // If AnalyzeAllocations is true, allocations that provably never
+  // reach stdpar algorithms are not moved to USM.
+  MallocToUSMPass(bool AnalyzeAllocations = true)
+  : AnalyzeAllocations{AnalyzeAllocations} {}
+
   llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &AM);
+private:
+  bool AnalyzeAllocations;
 };
 
 }
@@ -28,7 +28,7 @@ namespace compiler {
 /// must be present for correctness:
 ///  - memory accesses such as loads/stores
 ///  - calls to other functions that are not stdpar calls, since we cannot know what these functions
-///    do and our control flow analysis currently cannot continue in other functions
+///    do, unless they defer synchronization to their callers (see below)
 ///  - exit of control flow from the current function
 ///
 /// If a barrier is already present at one of the determined insertion points, no additional
@@ -65,6 +65,19 @@ namespace compiler {
 /// especially in the presence of system USM where stack memory might be used inside kernels too.
 /// In practice, for cases where this becomes relevant we should not offload anyway because the problem
 /// size would be way too small to be an efficient offload use case.
+///
+/// Before barriers are moved, functions that can defer synchronization to their callers are
+/// identified: A function can do so if all its call sites are known (it is only called directly
+/// and its address is not taken) and if, starting from its entry, the search above only encounters
+/// return instructions -- i.e. apart from argument setup, it only calls stdpar functions or other
+/// functions deferring synchronization. This is typically the case for small helper functions
+/// that wrap stdpar calls. Calls to such functions are treated like stdpar calls: They are skipped
+/// when moving barriers, and the search for a synchronization point starts after each of their
+/// call sites. Consequently, when such helpers are called in a loop, synchronization moves to the
+/// first memory access or function exit after the loop. Functions that are visible outside of the
+/// module are made internal if they can be emitted by each module anyway (linkonce), and are
+/// otherwise replaced by an internal clone at all call sites in the module, such that external
+/// callers continue to call a version that synchronizes on exit.
 class SyncElisionPass : public llvm::PassInfoMixin<SyncElisionPass> {
 public:
   llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &AM);
@@ -73,7 +86,8 @@ public:
 /// This pass causes callers of stdpar algorithms to be inlined. This is a simplistic heuristic
 /// to combine more stdpar calls in one function, assuming that often stdpar usage happens from only
 /// a few root functions. Having as many of the stdpar calls as possible in one function is important
-/// because the main SyncElision algorithm currently does not work beyond a single function.
+/// because the main SyncElision algorithm can only look beyond a single function for functions
+/// that defer synchronization entirely to their callers.
 class SyncElisionInliningPass : public llvm::PassInfoMixin<SyncElisionInliningPass> {
 public:
   llvm::PreservedAnalyses run(llvm::Module &M, llvm::ModuleAnalysisManager &AM);
@@ -32,8 +32,9 @@
   public:                                                                      \
     __acpp_hcf_registration##hcf_obj() {                                       \
       this->_id = ::hipsycl::rt::hcf_cache::get().register_hcf_object(         \
-          ::hipsycl::common::hcf_container{std::string{                        \
-              reinterpret_cast<const char *>(hcf_string), hcf_size}});         \
+          ::hipsycl::common::hcf_container::from_persistent_data(              \
+              std::string_view{reinterpret_cast<const char *>(hcf_string),     \
+                               hcf_size}));                                    \
     }                                                                          \
     ~__acpp_hcf_registration##hcf_obj() {                                      \
       ::hipsycl::rt::hcf_cache::get().unregister_hcf_object(this->_id);        \
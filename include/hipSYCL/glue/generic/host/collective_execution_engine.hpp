@@ -24,15 +24,16 @@
 
 #ifdef HIPSYCL_HAS_FIBERS
 
-#include <functional>
+#include <memory>
+#include <vector>
 
-#include <boost/fiber/fiber.hpp>
-#include <boost/fiber/barrier.hpp>
+#include <boost/context/fiber.hpp>
 
 #include "hipSYCL/sycl/libkernel/range.hpp"
 #include "hipSYCL/sycl/libkernel/id.hpp"
 #include "hipSYCL/sycl/libkernel/nd_item.hpp"
 
+#include "fiber_stack_pool.hpp"
 #include "iterate_range.hpp"
 #include "range_decomposition.hpp"
 
@@ -45,6 +46,17 @@ enum class group_execution_iteration {
   sequential
 };
 
+/// Executes the work items of the work groups assigned to the calling thread
+/// such that barriers are supported. Work items that may reach a barrier run
+/// as fibers, which are scheduled one work group at a time: On a barrier, a
+/// work item switches back to the scheduler, which resumes the other
+/// work items of the group in a round-robin fashion until all of them have
+/// reached the barrier or have finished.
+///
+/// As long as no barrier has been encountered, only the first work item of each
+/// group runs in a fiber. If it finishes without reaching a barrier, the
+/// remaining work items run directly, since barriers must be reached by
+/// all work items of a group.
 template<int Dim>
 class collective_execution_engine {
 public:
@@ -54,101 +66,102 @@ public:
       const static_range_decomposition<Dim> &group_range_decomposition,
       int my_group_region)
       : _num_groups{num_groups}, _local_size{local_size}, _offset{offset},
-        _group_barrier{local_size.size()}, _fibers_spawned{false},
-        _fibers(local_size.size()), _groups{group_range_decomposition},
-        _my_group_region{my_group_region} {}
+        _groups{group_range_decomposition},
+        _my_group_region{my_group_region} {
+    _fibers.reserve(local_size.size());
+  }
 
   template <class WorkItemFunction>
   void run_kernel(WorkItemFunction f) {
-    _kernel = f;
-    _fibers_spawned = false;
-    _master_group_position = 0;
-
-    // Try sequential processing (using only one fiber) - if
-    // other fibers need to be spawned, only process first work item
-    // as other work items will be processed by other fibers
-    _fibers[0] = boost::fibers::fiber([this]() {
-      _groups.for_each_local_element(
-          _my_group_region, [this](sycl::id<Dim> group_id) {
-            if (!_fibers_spawned) {
-              iterate_range(_local_size, [&](sycl::id<Dim> local_id) {
-                if (!_fibers_spawned)
-                  execute_work_item(local_id, group_id);
-              });
-            } else {
-              barrier();
-              // Only execute work item 0 from now on
-              execute_work_item(sycl::id<Dim>{}, group_id);
-            }
-            ++_master_group_position;
-          });
-    });
-
-    if (_fibers.size() > 0) {
-      _fibers[0].join();
-      if(_fibers_spawned){
-        for (std::size_t i = 1; i < _fibers.size(); ++i) {
-          _fibers[i].join();
-        }
-      }
-    }
-
+    _groups.for_each_local_element(
+        _my_group_region,
+        [&](sycl::id<Dim> group_id) { run_group(f, group_id); });
   }
 
   void barrier() {
-    if(!_fibers_spawned){
-      // We are still in sequential processing mode,
-      // need to spawn the other fibers
-      spawn_fibers();
-      // Perform additional barrier on master fiber
-      // to participate in the other fibers initial barrier
-      // when entering the first group
-      barrier();
-    }
-    
-    _group_barrier.wait();
+    // Work items outside of fibers are only executed if the group
+    // does not reach barriers.
+    if(!_is_in_fiber)
+      return;
+    // Returns once the scheduler resumes this work item after all
+    // other work items of the group have reached the barrier.
+    _scheduler = std::move(_scheduler).resume();
   }
 
 private:
-  // Spawn remaining fibers
-  void spawn_fibers() {
-
-    std::size_t n = 0;
-    iterate_range(_local_size, [&](sycl::id<Dim> local_id) {
-      // First work item will be processed by master fiber
-      if (n != 0) {
-        
-        std::size_t master_offset = _master_group_position;
-        _fibers[n] = boost::fibers::fiber([local_id, this, master_offset]() {
-          std::size_t current_group = 0;
-          _groups.for_each_local_element(
-              _my_group_region, [&, this](sycl::id<Dim> group_id) {
-                if (current_group >= master_offset) {
-                  barrier();
-                  execute_work_item(local_id, group_id);
-                }
-                ++current_group;
-              });
-        });
+  template <class WorkItemFunction>
+  void run_group(WorkItemFunction &f, sycl::id<Dim> group_id) {
+    _fibers.clear();
+
+    std::size_t first_scheduled_fiber = 0;
+    if(!_has_encountered_barrier) {
+      _fibers.push_back(make_work_item_fiber(f, sycl::id<Dim>{}, group_id));
+      resume(0);
+
+      bool is_first_done = !_fibers[0];
+      std::size_t n = 0;
+      iterate_range(_local_size, [&](sycl::id<Dim> local_id) {
+        if(n++ != 0) {
+          if(is_first_done)
+            f(local_id, group_id);
+          else
+            _fibers.push_back(make_work_item_fiber(f, local_id, group_id));
+        }
+      });
+
+      if(is_first_done)
+        return;
+      _has_encountered_barrier = true;
+      // The first work item is already waiting at the barrier
+      first_scheduled_fiber = 1;
+    } else {
+      iterate_range(_local_size, [&](sycl::id<Dim> local_id) {
+        _fibers.push_back(make_work_item_fiber(f, local_id, group_id));
+      });
+    }
+
+    for(bool is_done = false; !is_done; first_scheduled_fiber = 0) {
+      is_done = true;
+      for(std::size_t i = 0; i < _fibers.size(); ++i) {
+        if(_fibers[i]) {
+          if(i >= first_scheduled_fiber)
+            resume(i);
+          if(_fibers[i])
+            is_done = false;
+        }
       }
-      ++n;
-    });
+    }
+  }
 
-    _fibers_spawned = true;
+  template <class WorkItemFunction>
+  boost::context::fiber make_work_item_fiber(WorkItemFunction &f,
+                                             sycl::id<Dim> local_id,
+                                             sycl::id<Dim> group_id) {
+    return boost::context::fiber{
+        std::allocator_arg, pooled_fiber_stack_allocator{},
+        [this, &f, local_id, group_id](boost::context::fiber &&scheduler) {
+          _scheduler = std::move(scheduler);
+          f(local_id, group_id);
+          return std::move(_scheduler);
+        }};
   }
 
-  void execute_work_item(sycl::id<Dim> local_id, sycl::id<Dim> group_id) {
-    _kernel(local_id, group_id);
+  // Runs the fiber until it reaches a barrier or finishes, in which case
+  // the fiber becomes empty.
+  void resume(std::size_t fiber_index) {
+    _is_in_fiber = true;
+    _fibers[fiber_index] = std::move(_fibers[fiber_index]).resume();
+    _is_in_fiber = false;
   }
 
   sycl::range<Dim> _num_groups;
   sycl::range<Dim> _local_size;
   sycl::id<Dim> _offset;
-  boost::fibers::barrier _group_barrier;
-  bool _fibers_spawned;
-  std::vector<boost::fibers::fiber> _fibers;
-  std::function<void(sycl::id<Dim>, sycl::id<Dim>)> _kernel;
-  std::size_t _master_group_position;
+  std::vector<boost::context::fiber> _fibers;
+  // Continuation of the scheduler while a work item fiber is running
+  boost::context::fiber _scheduler;
+  bool _is_in_fiber = false;
+  bool _has_encountered_barrier = false;
   const static_range_decomposition<Dim> &_groups;
   int _my_group_region;
 };
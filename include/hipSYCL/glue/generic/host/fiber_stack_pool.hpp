@@ -0,0 +1,109 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_FIBER_STACK_POOL_HPP
+#define HIPSYCL_FIBER_STACK_POOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include <boost/context/stack_context.hpp>
+#include <boost/context/stack_traits.hpp>
+
+namespace hipsycl {
+namespace glue {
+namespace host {
+
+/// Per-thread pool of fiber stacks. Since fibers are created for the work items
+/// of each work group, reusing their stacks avoids memory allocations once
+/// the pool has grown to the size of a work group.
+///
+/// The pool never holds more stacks than were in use at the same time, i.e.
+/// than the largest work group executed by the thread. Additionally, at most
+/// max_pooled_bytes are retained per thread; stacks beyond that are freed
+/// when they are returned.
+class fiber_stack_pool {
+public:
+  static constexpr std::size_t max_pooled_bytes = 64 * 1024 * 1024;
+
+  static fiber_stack_pool &get() {
+    static thread_local fiber_stack_pool pool;
+    return pool;
+  }
+
+  fiber_stack_pool(const fiber_stack_pool &) = delete;
+  fiber_stack_pool &operator=(const fiber_stack_pool &) = delete;
+
+  ~fiber_stack_pool() {
+    for(void* stack : _stacks)
+      std::free(stack);
+  }
+
+  boost::context::stack_context allocate() {
+    void* stack = nullptr;
+    if(!_stacks.empty()) {
+      stack = _stacks.back();
+      _stacks.pop_back();
+    } else {
+      stack = std::malloc(_stack_size);
+      if(!stack)
+        throw std::bad_alloc{};
+    }
+    boost::context::stack_context sctx;
+    sctx.size = _stack_size;
+    // Stacks grow downwards
+    sctx.sp = static_cast<char *>(stack) + _stack_size;
+    return sctx;
+  }
+
+  void deallocate(boost::context::stack_context &sctx) noexcept {
+    void* stack = static_cast<char *>(sctx.sp) - sctx.size;
+    if(_stacks.size() >= _max_pooled_stacks) {
+      std::free(stack);
+      return;
+    }
+    try {
+      _stacks.push_back(stack);
+    } catch(...) {
+      std::free(stack);
+    }
+  }
+
+private:
+  fiber_stack_pool()
+  : _stack_size{boost::context::stack_traits::default_size()},
+    _max_pooled_stacks{std::max(std::size_t{1}, max_pooled_bytes / _stack_size)} {}
+
+  std::size_t _stack_size;
+  std::size_t _max_pooled_stacks;
+  std::vector<void*> _stacks;
+};
+
+/// Boost.Context stack allocator that takes stacks from the fiber_stack_pool
+/// of the current thread. Fibers must be destroyed by the thread that
+/// created them.
+struct pooled_fiber_stack_allocator {
+  boost::context::stack_context allocate() {
+    return fiber_stack_pool::get().allocate();
+  }
+
+  void deallocate(boost::context::stack_context &sctx) noexcept {
+    fiber_stack_pool::get().deallocate(sctx);
+  }
+};
+
+}
+}
+} // namespace hipsycl
+
+#endif
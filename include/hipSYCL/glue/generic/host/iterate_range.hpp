@@ -196,19 +196,55 @@ void iterate_partial_range(const sycl::range<Dim> whole_range,
   }
 }
 
+/// Iterates over the part of the range \c r shifted by \c offset, whose
+/// index in the slowest dimension is in [slice_begin, slice_end).
+template <int Dim, class Function>
+void iterate_range_slice(sycl::id<Dim> offset, sycl::range<Dim> r,
+                         std::size_t slice_begin, std::size_t slice_end,
+                         Function f) noexcept {
+  const std::size_t min_i = offset.get(0) + slice_begin;
+  const std::size_t max_i = offset.get(0) + slice_end;
+
+  if constexpr (Dim == 1) {
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      f(sycl::id<Dim>{i});
+    }
+  } else if constexpr (Dim == 2) {
+    const std::size_t min_j = offset.get(1);
+    const std::size_t max_j = offset.get(1) + r.get(1);
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      for (std::size_t j = min_j; j < max_j; ++j) {
+        f(sycl::id<Dim>{i, j});
+      }
+    }
+  } else if constexpr (Dim == 3) {
+    const std::size_t min_j = offset.get(1);
+    const std::size_t min_k = offset.get(2);
+    const std::size_t max_j = offset.get(1) + r.get(1);
+    const std::size_t max_k = offset.get(2) + r.get(2);
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      for (std::size_t j = min_j; j < max_j; ++j) {
+        for (std::size_t k = min_k; k < max_k; ++k) {
+          f(sycl::id<Dim>{i, j, k});
+        }
+      }
+    }
+  }
+}
+
 template <int Dim, class Function>
 void iterate_range_omp_for(sycl::range<Dim> r, Function f) noexcept {
 
   if constexpr (Dim == 1) {
 #ifdef _OPENMP
-    #pragma omp for
+    #pragma omp for schedule(static)
 #endif
     for (std::size_t i = 0; i < r.get(0); ++i) {
       f(sycl::id<Dim>{i});
     }
   } else if constexpr (Dim == 2) {
 #ifdef _OPENMP
-    #pragma omp for collapse(2)
+    #pragma omp for collapse(2) schedule(static)
 #endif
     for (std::size_t i = 0; i < r.get(0); ++i) {
       for (std::size_t j = 0; j < r.get(1); ++j) {
@@ -217,7 +253,7 @@ void iterate_range_omp_for(sycl::range<Dim> r, Function f) noexcept {
     }
   } else if constexpr (Dim == 3) {
 #ifdef _OPENMP
-    #pragma omp for collapse(3)
+    #pragma omp for collapse(3) schedule(static)
 #endif
     for (std::size_t i = 0; i < r.get(0); ++i) {
       for (std::size_t j = 0; j < r.get(1); ++j) {
@@ -238,7 +274,99 @@ void iterate_range_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
 
   if constexpr (Dim == 1) {
 #ifdef _OPENMP
-  #pragma omp for
+  #pragma omp for schedule(static)
+#endif
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      f(sycl::id<Dim>{i});
+    }
+  } else if constexpr (Dim == 2) {
+    const std::size_t min_j = offset.get(1);
+    const std::size_t max_j = offset.get(1) + r.get(1);
+#ifdef _OPENMP
+  #pragma omp for collapse(2) schedule(static)
+#endif
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      for (std::size_t j = min_j; j < max_j; ++j) {
+        f(sycl::id<Dim>{i, j});
+      }
+    }
+  } else if constexpr (Dim == 3) {
+    const std::size_t min_j = offset.get(1);
+    const std::size_t min_k = offset.get(2);
+    const std::size_t max_j = offset.get(1) + r.get(1);
+    const std::size_t max_k = offset.get(2) + r.get(2);
+#ifdef _OPENMP
+  #pragma omp for collapse(3) schedule(static)
+#endif
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      for (std::size_t j = min_j; j < max_j; ++j) {
+        for (std::size_t k = min_k; k < max_k; ++k) {
+          f(sycl::id<Dim>{i, j, k});
+        }
+      }
+    }
+  }
+}
+
+/// Like iterate_range_omp_for(), but without the barrier at the end of the
+/// loop, e.g. to measure the time of the calling thread for its iterations.
+template <int Dim, class Function>
+void iterate_range_omp_for_nowait(sycl::id<Dim> offset, sycl::range<Dim> r,
+                                  Function f) noexcept {
+
+  const std::size_t min_i = offset.get(0);
+  const std::size_t max_i = offset.get(0) + r.get(0);
+
+  if constexpr (Dim == 1) {
+#ifdef _OPENMP
+  #pragma omp for schedule(static) nowait
+#endif
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      f(sycl::id<Dim>{i});
+    }
+  } else if constexpr (Dim == 2) {
+    const std::size_t min_j = offset.get(1);
+    const std::size_t max_j = offset.get(1) + r.get(1);
+#ifdef _OPENMP
+  #pragma omp for collapse(2) schedule(static) nowait
+#endif
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      for (std::size_t j = min_j; j < max_j; ++j) {
+        f(sycl::id<Dim>{i, j});
+      }
+    }
+  } else if constexpr (Dim == 3) {
+    const std::size_t min_j = offset.get(1);
+    const std::size_t min_k = offset.get(2);
+    const std::size_t max_j = offset.get(1) + r.get(1);
+    const std::size_t max_k = offset.get(2) + r.get(2);
+#ifdef _OPENMP
+  #pragma omp for collapse(3) schedule(static) nowait
+#endif
+    for (std::size_t i = min_i; i < max_i; ++i) {
+      for (std::size_t j = min_j; j < max_j; ++j) {
+        for (std::size_t k = min_k; k < max_k; ++k) {
+          f(sycl::id<Dim>{i, j, k});
+        }
+      }
+    }
+  }
+}
+
+/// Like iterate_range_omp_for(), but threads dynamically take chunks of
+/// chunk_size iterations of the collapsed loop, which balances the load
+/// if iterations differ in cost.
+template <int Dim, class Function>
+void iterate_range_omp_for_dynamic(sycl::id<Dim> offset, sycl::range<Dim> r,
+                                   std::size_t chunk_size,
+                                   Function f) noexcept {
+
+  const std::size_t min_i = offset.get(0);
+  const std::size_t max_i = offset.get(0) + r.get(0);
+
+  if constexpr (Dim == 1) {
+#ifdef _OPENMP
+  #pragma omp for schedule(dynamic, chunk_size)
 #endif
     for (std::size_t i = min_i; i < max_i; ++i) {
       f(sycl::id<Dim>{i});
@@ -247,7 +375,7 @@ void iterate_range_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
     const std::size_t min_j = offset.get(1);
     const std::size_t max_j = offset.get(1) + r.get(1);
 #ifdef _OPENMP
-  #pragma omp for collapse(2)
+  #pragma omp for collapse(2) schedule(dynamic, chunk_size)
 #endif
     for (std::size_t i = min_i; i < max_i; ++i) {
       for (std::size_t j = min_j; j < max_j; ++j) {
@@ -260,7 +388,7 @@ void iterate_range_omp_for(sycl::id<Dim> offset, sycl::range<Dim> r,
     const std::size_t max_j = offset.get(1) + r.get(1);
     const std::size_t max_k = offset.get(2) + r.get(2);
 #ifdef _OPENMP
-  #pragma omp for collapse(3)
+  #pragma omp for collapse(3) schedule(dynamic, chunk_size)
 #endif
     for (std::size_t i = min_i; i < max_i; ++i) {
       for (std::size_t j = min_j; j < max_j; ++j) {
@@ -12,6 +12,8 @@
 #ifndef ACPP_GLUE_FCALL_SPECIALIZATION_HPP
 #define ACPP_GLUE_FCALL_SPECIALIZATION_HPP
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -31,6 +33,15 @@ struct fcall_specialized_config {
 using fcall_config_kernel_property_t =
     __acpp_sscp_emit_param_type_annotation_fcall_specialized_config<
         const fcall_specialized_config *>;
+
+/// A function call configuration that an inline-cached binary dispatches
+/// to if the address of the fcall_specialized_config passed as kernel
+/// argument equals selector. The configuration is a copy, since binaries
+/// may be compiled after the original configuration has been destroyed.
+struct fcall_inline_cache_candidate {
+  uint64_t selector = 0;
+  std::shared_ptr<const fcall_specialized_config> config;
+};
 }
 
 #endif
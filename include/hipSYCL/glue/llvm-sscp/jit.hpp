@@ -22,10 +22,12 @@
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include <cstddef>
+#include <cstring>
 #include <vector>
 #include <atomic>
 #include <fstream>
 #include <string>
+#include <unordered_map>
 
 namespace hipsycl {
 namespace glue {
@@ -94,6 +96,26 @@ public:
     return _mapped_data.size();
   }
 
+  // Copies the mapped arguments into a single buffer, with each argument
+  // aligned like a kernel parameter of its size.
+  // \return The size of the packed arguments in bytes
+  std::size_t pack_mapped_args(std::vector<unsigned char> &buffer) const {
+    std::size_t packed_size = 0;
+    buffer.clear();
+    for(std::size_t i = 0; i < _mapped_data.size(); ++i) {
+      std::size_t arg_size = _mapped_sizes[i];
+      std::size_t alignment = 1;
+      while(alignment < 8 && arg_size % (2 * alignment) == 0)
+        alignment *= 2;
+
+      packed_size = (packed_size + alignment - 1) / alignment * alignment;
+      buffer.resize(packed_size + arg_size);
+      std::memcpy(buffer.data() + packed_size, _mapped_data[i], arg_size);
+      packed_size += arg_size;
+    }
+    return packed_size;
+  }
+
   void apply_dead_argument_elimination_mask(
       const std::vector<int> &retained_argument_indices) {
     assert(retained_argument_indices.size() <= _mapped_data.size());
@@ -248,7 +270,28 @@ inline rt::result compile(compiler::LLVMToBackendTranslator *translator,
       translator->specializeKernelArgument(translator->getKernels().front(),
                                           entry.first, &entry.second);
     }
+    for(const auto& entry : config.pointer_argument_alignments()) {
+      translator->setKernelPointerArgumentAlignment(
+          translator->getKernels().front(), entry.first, entry.second);
+    }
+    for(int param_index : config.noalias_pointer_arguments()) {
+      translator->setKernelPointerArgumentNoAlias(
+          translator->getKernels().front(), param_index);
+    }
+    for(const auto& entry : config.argument_upper_bounds()) {
+      translator->setKernelArgumentUpperBound(translator->getKernels().front(),
+                                              entry.first, entry.second);
+    }
+    for(const auto& entry : config.argument_divisors()) {
+      translator->setKernelArgumentDivisor(translator->getKernels().front(),
+                                           entry.first, entry.second);
+    }
   }
+  if(config.branch_profile_counters_address() != 0)
+    translator->setBranchProfileCounters(config.branch_profile_counters_address(),
+                                         config.num_branch_profile_counters());
+  else if(!config.branch_profile().empty())
+    translator->setBranchProfile(config.branch_profile());
   for(const auto& entry : config.function_call_specialization_config()) {
     auto& config = entry.value->function_call_map;
     for(const auto& call_specialization : config) {
@@ -256,6 +299,27 @@ inline rt::result compile(compiler::LLVMToBackendTranslator *translator,
                                           call_specialization.second, false);
     }
   }
+  for(const auto& entry : config.function_call_inline_caches()) {
+    // Candidates that do not specialize a function call the original one
+    std::unordered_map<std::string,
+                       std::vector<std::pair<uint64_t, std::vector<std::string>>>>
+        dispatched_functions;
+    for(const auto& candidate : entry.second)
+      for(const auto& call_specialization : candidate.config->function_call_map)
+        dispatched_functions[call_specialization.first];
+    for(auto& function : dispatched_functions) {
+      for(const auto& candidate : entry.second) {
+        std::vector<std::string> replacement;
+        for(const auto& call_specialization : candidate.config->function_call_map)
+          if(call_specialization.first == function.first)
+            replacement = call_specialization.second;
+        function.second.push_back(std::make_pair(candidate.selector, replacement));
+      }
+      translator->specializeFunctionCallsOnArgument(translator->getKernels().front(),
+                                                    entry.first, function.first,
+                                                    function.second);
+    }
+  }
 
   for(const auto& option : config.build_options()) {
     std::string option_name = rt::to_string(option.first);
@@ -376,36 +440,163 @@ inline rt::result compile_kernel(
 
   assert(translator->getKernels().size() == 1);
 
-  rt::result err = rt::make_success();
+  // Don't hold the appdb lock during compilation; JIT compilation
+  // may run concurrently on background threads.
+  std::vector<int> retained_args;
+  translator->enableDeadArgumentElminiation(translator->getKernels()[0],
+                                            &retained_args);
+  rt::result err = compile(translator, hcf_object, image_name, config, output);
 
   common::filesystem::persistent_storage::get()
       .get_this_app_db()
-      .read_write_access([&](common::db::appdb_data &appdb) {
-        std::vector<int> *retained_args =
-            &(appdb.kernels[binary_id].retained_argument_indices);
-
-        translator->enableDeadArgumentElminiation(translator->getKernels()[0],
-                                                  retained_args);
-        err = compile(translator, hcf_object, image_name, config, output);
-      });
+      .read_write_entry<common::db::kernel_entry>(
+          binary_id, [&](common::db::kernel_entry &entry) {
+            entry.retained_argument_indices = retained_args;
+          });
 
   return err;
 }
 
 inline std::vector<int>
 retrieve_retained_arguments_mask(rt::kernel_configuration::id_type binary_id) {
-  return common::filesystem::persistent_storage::get().get_this_app_db().read_access(
-      [&](const common::db::appdb_data &appdb) {
-        auto it = appdb.kernels.find(binary_id);
-        if(it != appdb.kernels.end()) {
-          return it->second.retained_argument_indices;
-        } else {
-          return std::vector<int>{};
-        }
-      });
+  return common::filesystem::persistent_storage::get()
+      .get_this_app_db()
+      .read_entry<common::db::kernel_entry>(
+          binary_id, [&](const common::db::kernel_entry *entry) {
+            if(entry) {
+              return entry->retained_argument_indices;
+            } else {
+              return std::vector<int>{};
+            }
+          });
 }
 }
 
+namespace precompilation {
+
+// Creates a recipe that allows for repeating the compilation of a binary
+// in a later application run. The recipe is invalid if the configuration
+// cannot be restored from it, e.g. because it contains S2 IR constants,
+// function call specializations or profiling counters which are only
+// known at runtime.
+inline common::db::jit_recipe
+make_recipe(rt::backend_id backend, rt::hcf_object_id hcf_object,
+            const std::string &image_name,
+            const std::vector<std::string> &kernel_names,
+            const rt::kernel_configuration &config,
+            bool dead_argument_elimination) {
+  common::db::jit_recipe recipe;
+  if(!config.s2_ir_entries().empty() ||
+     !config.function_call_specialization_config().empty() ||
+     !config.function_call_inline_caches().empty() ||
+     config.branch_profile_counters_address() != 0)
+    return recipe;
+
+  recipe.backend = static_cast<int>(backend);
+  recipe.hcf_object = hcf_object;
+  recipe.image = image_name;
+  recipe.kernels = kernel_names;
+  recipe.dead_argument_elimination = dead_argument_elimination;
+  for(const auto& option : config.build_options()) {
+    common::db::jit_build_option_entry entry;
+    entry.option = static_cast<int>(option.first);
+    if(option.second.int_value.has_value()) {
+      entry.is_int_value = true;
+      entry.int_value = option.second.int_value.value();
+    } else {
+      entry.string_value = option.second.string_value.value();
+    }
+    recipe.build_options.push_back(entry);
+  }
+  for(const auto& flag : config.build_flags())
+    recipe.build_flags.push_back(static_cast<int>(flag));
+  for(const auto& arg : config.specialized_arguments())
+    recipe.specialized_args.push_back(
+        common::db::jit_specialized_argument_entry{arg.first, arg.second});
+  for(const auto& arg : config.pointer_argument_alignments())
+    recipe.pointer_arg_alignments.push_back(
+        common::db::jit_specialized_argument_entry{arg.first, arg.second});
+  recipe.noalias_pointer_args = config.noalias_pointer_arguments();
+  for(const auto& arg : config.argument_upper_bounds())
+    recipe.arg_upper_bounds.push_back(
+        common::db::jit_specialized_argument_entry{arg.first, arg.second});
+  for(const auto& arg : config.argument_divisors())
+    recipe.arg_divisors.push_back(
+        common::db::jit_specialized_argument_entry{arg.first, arg.second});
+  recipe.branch_profile = config.branch_profile();
+
+  return recipe;
+}
+
+// Stores the recipe for a JIT-compiled binary in the appdb, so that it
+// can be precompiled in later application runs.
+inline void record_recipe(rt::kernel_configuration::id_type binary_id,
+                          rt::backend_id backend, rt::hcf_object_id hcf_object,
+                          const std::string &image_name,
+                          const std::vector<std::string> &kernel_names,
+                          const rt::kernel_configuration &config,
+                          bool dead_argument_elimination) {
+  if(rt::application::get_settings()
+         .get<rt::setting::no_jit_cache_population>())
+    return;
+
+  common::db::jit_recipe recipe =
+      make_recipe(backend, hcf_object, image_name, kernel_names, config,
+                  dead_argument_elimination);
+  if(!recipe.is_valid())
+    return;
+
+  common::filesystem::persistent_storage::get()
+      .get_this_app_db()
+      .read_write_entry<common::db::binary_entry>(
+          binary_id, [&](common::db::binary_entry &entry) {
+            entry.recipe = std::move(recipe);
+          });
+}
+
+inline rt::kernel_configuration
+restore_configuration(const common::db::jit_recipe &recipe) {
+  rt::kernel_configuration config;
+  for(const auto& option : recipe.build_options) {
+    auto o = static_cast<rt::kernel_build_option>(option.option);
+    if(option.is_int_value)
+      config.set_build_option(o, option.int_value);
+    else
+      config.set_build_option(o, option.string_value);
+  }
+  for(auto flag : recipe.build_flags)
+    config.set_build_flag(static_cast<rt::kernel_build_flag>(flag));
+  for(const auto& arg : recipe.specialized_args)
+    config.set_specialized_kernel_argument(arg.param_index, arg.value);
+  for(const auto& arg : recipe.pointer_arg_alignments)
+    config.set_kernel_pointer_argument_alignment(arg.param_index, arg.value);
+  for(int param_index : recipe.noalias_pointer_args)
+    config.set_kernel_pointer_argument_noalias(param_index);
+  for(const auto& arg : recipe.arg_upper_bounds)
+    config.set_kernel_argument_upper_bound(arg.param_index, arg.value);
+  for(const auto& arg : recipe.arg_divisors)
+    config.set_kernel_argument_divisor(arg.param_index, arg.value);
+  if(!recipe.branch_profile.empty())
+    config.set_branch_profile(recipe.branch_profile);
+  return config;
+}
+
+// Repeats the compilation described by the recipe. translator must have been
+// constructed for the kernels of the recipe.
+inline rt::result compile(compiler::LLVMToBackendTranslator *translator,
+                          const common::db::jit_recipe &recipe,
+                          rt::kernel_configuration::id_type binary_id,
+                          std::string &output) {
+  rt::kernel_configuration config = restore_configuration(recipe);
+  if(recipe.dead_argument_elimination)
+    return dead_argument_elimination::compile_kernel(
+        translator, recipe.hcf_object, recipe.image, config, binary_id, output);
+  return jit::compile(translator, recipe.hcf_object, recipe.image, config,
+                      output);
+}
+
+}
+
 }
 }
 }
@@ -14,6 +14,7 @@
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/glue/generic/code_object.hpp"
 #include "hipSYCL/glue/llvm-sscp/s1_ir_constants.hpp"
+#include "hipSYCL/runtime/kernel_capture.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/kernel_launcher.hpp"
@@ -71,8 +72,9 @@ namespace glue {
 
 namespace sscp {
 
-static std::string get_local_hcf_object() {
-  return std::string{
+// The HCF data is embedded in the binary, so it does not need to be copied
+static std::string_view get_local_hcf_object() {
+  return std::string_view{
       reinterpret_cast<const char *>(__acpp_local_sscp_hcf_content),
       __acpp_local_sscp_hcf_object_size};
 }
@@ -81,9 +83,9 @@ static std::string get_local_hcf_object() {
 // macro. We cannot use this macro directly because it expects
 // the object id to be constexpr, which it is not for the SSCP case.
 struct static_hcf_registration {
-  static_hcf_registration(const std::string& hcf_data) {
+  static_hcf_registration(std::string_view hcf_data) {
     this->_hcf_object = rt::hcf_cache::get().register_hcf_object(
-        common::hcf_container{hcf_data});
+        common::hcf_container::from_persistent_data(hcf_data));
   }
 
   ~static_hcf_registration() {
@@ -240,6 +242,43 @@ private:
   const sycl::id<Dimensions> _offset;
 };
 
+template<int Dimensions>
+constexpr auto get_scoped_hierarchical_decomposition() {
+  using namespace sycl::detail;
+  // The sub-group size is only known at JIT time, so the size of
+  // the sub-group level is left unspecified. Sub-groups are only exposed
+  // for 1D kernels, other kernels decompose directly into scalar groups.
+  if constexpr(Dimensions == 1) {
+    return nested_range<unknown_static_range,
+                        nested_range<unknown_static_range>>{};
+  } else {
+    return nested_range<unknown_static_range, nested_range<static_range<1>>>{};
+  }
+}
+
+template<class UserKernel, int Dimensions>
+class scoped_parallel_for {
+public:
+  scoped_parallel_for(const UserKernel& k)
+  : _k{k} {}
+
+  [[clang::annotate("hipsycl_kernel_dimension", Dimensions)]]
+  void operator()() const {
+    using group_properties = sycl::detail::sp_property_descriptor<
+        Dimensions, 0,
+        decltype(get_scoped_hierarchical_decomposition<Dimensions>())>;
+
+    sycl::group<Dimensions> this_group{
+        sycl::detail::get_group_id<Dimensions>(),
+        sycl::detail::get_local_size<Dimensions>(),
+        sycl::detail::get_grid_size<Dimensions>()};
+
+    _k(sycl::detail::sp_group<group_properties>{this_group});
+  };
+private:
+  UserKernel _k;
+};
+
 }
 
 // NOTE: This class no longer follows the backend_kernel_launcher concept,
@@ -292,7 +331,11 @@ public:
     } else if constexpr (type == rt::kernel_type::hierarchical_parallel_for) {
 
     } else if constexpr( type == rt::kernel_type::scoped_parallel_for) {
-      
+
+      configure_launch_with_global_range(data,
+          __sscp_dispatch::scoped_parallel_for<Kernel, Dim>{k}, global_range,
+          local_range, dynamic_local_memory);
+
     } else if constexpr (type == rt::kernel_type::custom) {
       // handled at invoke time
       data.custom_op = k;
@@ -336,7 +379,8 @@ public:
       auto selected_group_size = launch_config.group_size;
       if (launch_config.group_size.size() == 0)
         selected_group_size = invoker->select_group_size(
-            launch_config.global_size, launch_config.group_size);
+            launch_config.global_size, launch_config.group_size,
+            launch_config.sscp_hcf_object_id, launch_config.sscp_kernel_id);
 
       rt::range<3> num_groups;
       for(int i = 0; i < 3; ++i) {
@@ -344,6 +388,10 @@ public:
                         selected_group_size[i];
       }
 
+      if(rt::is_kernel_capture_enabled())
+        rt::capture_kernel_launch(launch_config, node, kernel_config,
+                                  selected_group_size);
+
       std::array<const void*, 1> args{launch_config.kernel_args.data()};
       std::size_t arg_size = launch_config.kernel_args.size();
 
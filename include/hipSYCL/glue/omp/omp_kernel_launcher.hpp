@@ -12,7 +12,9 @@
 #define HIPSYCL_OPENMP_KERNEL_LAUNCHER_HPP
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <tuple>
 #ifdef _OPENMP
 #include <omp.h>
@@ -23,6 +25,7 @@
 #include "hipSYCL/runtime/dag_node.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/omp/omp_queue.hpp"
+#include "hipSYCL/runtime/omp/omp_schedule.hpp"
 #include "hipSYCL/sycl/libkernel/backend.hpp"
 #include "hipSYCL/sycl/exception.hpp"
 #include "hipSYCL/sycl/interop_handle.hpp"
@@ -36,8 +39,11 @@
 #include "hipSYCL/sycl/libkernel/detail/local_memory_allocator.hpp"
 #include "hipSYCL/sycl/libkernel/detail/data_layout.hpp"
 
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/kernel_launcher.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/generic/host_thread_pool.hpp"
 
 #include "../generic/host/collective_execution_engine.hpp"
 #include "../generic/host/iterate_range.hpp"
@@ -117,6 +123,66 @@ inline void iterate_nd_range_omp(Function f, const sycl::id<Dim> &&group_id, con
 }
 #endif
 
+inline bool use_host_thread_pool() {
+  static const bool use_pool =
+      rt::application::get_settings().get<rt::setting::host_thread_pool>();
+  return use_pool;
+}
+
+// Executes f for each id in range r shifted by offset using the host thread
+// pool. The range is split into slices along the slowest dimension.
+template <int Dim, class Function>
+void thread_pool_iterate_range(sycl::id<Dim> offset,
+                               const sycl::range<Dim> r,
+                               Function f) noexcept {
+  // Minimum number of work items per chunk, such that chunk scheduling
+  // overheads remain small compared to the work in a chunk.
+  constexpr std::size_t min_work_items_per_chunk = 1024;
+  // Create multiple chunks per thread for load balancing
+  constexpr std::size_t chunks_per_thread = 4;
+
+  if(r.size() == 0)
+    return;
+
+  rt::host_thread_pool& pool = rt::host_thread_pool::get();
+  const std::size_t num_slices = r.get(0);
+  const std::size_t slice_size = r.size() / num_slices;
+
+  std::size_t slices_per_chunk = std::max(
+      (min_work_items_per_chunk + slice_size - 1) / slice_size,
+      num_slices / (chunks_per_thread * pool.get_num_threads()));
+
+  pool.parallel_for(num_slices, slices_per_chunk,
+                    [&](std::size_t begin, std::size_t end) {
+                      host::iterate_range_slice(offset, r, begin, end, f);
+                    });
+}
+
+// Executes f for each id of r shifted by offset, using the dynamic
+// schedule or measuring the per-thread timings requested by schedule.
+template <int Dim, class Function>
+void parallel_iterate_range_with_schedule(sycl::id<Dim> offset,
+                                          const sycl::range<Dim> r,
+                                          const rt::omp_loop_schedule &schedule,
+                                          Function f) noexcept {
+  if(schedule.dynamic_chunk_size > 0) {
+    parallel_invocation([&](){
+      host::iterate_range_omp_for_dynamic(offset, r,
+                                          schedule.dynamic_chunk_size, f);
+    });
+    return;
+  }
+
+  rt::omp_thread_timings timings;
+  parallel_invocation([&](){
+    auto start = std::chrono::steady_clock::now();
+    host::iterate_range_omp_for_nowait(offset, r, f);
+    timings.add(std::chrono::steady_clock::now() - start);
+  });
+  if(schedule.selector)
+    schedule.selector->record(timings);
+}
+
 template<class Function>
 inline
 void single_task_kernel(Function f) noexcept
@@ -126,10 +192,31 @@ void single_task_kernel(Function f) noexcept
 
 template <int Dim, class Function>
 inline void parallel_for_kernel(Function f,
-                                const sycl::range<Dim> execution_range) noexcept
+                                const sycl::range<Dim> execution_range,
+                                const rt::omp_loop_schedule &schedule = {}) noexcept
 {
   static_assert(Dim > 0 && Dim <= 3, "Only dimensions 1,2,3 are supported");
 
+  if(use_host_thread_pool()) {
+    thread_pool_iterate_range(
+        sycl::id<Dim>{}, execution_range, [&](sycl::id<Dim> idx) {
+          auto this_item = sycl::detail::make_item<Dim>(idx, execution_range);
+
+          f(this_item);
+        });
+    return;
+  }
+
+  if(schedule.dynamic_chunk_size > 0 || schedule.selector) {
+    parallel_iterate_range_with_schedule(
+        sycl::id<Dim>{}, execution_range, schedule, [&](sycl::id<Dim> idx) {
+          auto this_item = sycl::detail::make_item<Dim>(idx, execution_range);
+
+          f(this_item);
+        });
+    return;
+  }
+
   parallel_invocation([=](){
     host::iterate_range_omp_for(execution_range, [&](sycl::id<Dim> idx) {
       auto this_item =
@@ -143,9 +230,31 @@ inline void parallel_for_kernel(Function f,
 template <int Dim, class Function>
 inline void parallel_for_kernel_offset(Function f,
                                        const sycl::range<Dim> execution_range,
-                                       const sycl::id<Dim> offset) noexcept {
+                                       const sycl::id<Dim> offset,
+                                       const rt::omp_loop_schedule &schedule = {}) noexcept {
   static_assert(Dim > 0 && Dim <= 3, "Only dimensions 1,2,3 are supported");
 
+  if(use_host_thread_pool()) {
+    thread_pool_iterate_range(
+        offset, execution_range, [&](sycl::id<Dim> idx) {
+          auto this_item =
+              sycl::detail::make_item<Dim>(idx, execution_range, offset);
+
+          f(this_item);
+        });
+    return;
+  }
+
+  if(schedule.dynamic_chunk_size > 0 || schedule.selector) {
+    parallel_iterate_range_with_schedule(
+        offset, execution_range, schedule, [&](sycl::id<Dim> idx) {
+          auto this_item =
+              sycl::detail::make_item<Dim>(idx, execution_range, offset);
+
+          f(this_item);
+        });
+    return;
+  }
 
   parallel_invocation([=](){
     host::iterate_range_omp_for(offset, execution_range, [&](sycl::id<Dim> idx) {
@@ -374,11 +483,18 @@ public:
         omp_dispatch::single_task_kernel(k);
 
       } else if constexpr (type == rt::kernel_type::basic_parallel_for) {
+        // One per kernel, for ACPP_RT_OMP_AUTO_DYNAMIC_SCHEDULE
+        static rt::omp_schedule_selector schedule_selector;
+
+        rt::omp_loop_schedule schedule = rt::select_omp_loop_schedule(
+            &node->get_execution_hints(), schedule_selector,
+            global_range.size(), omp_dispatch::get_max_num_threads());
 
         if(!is_with_offset) {
-          omp_dispatch::parallel_for_kernel(k, global_range);
+          omp_dispatch::parallel_for_kernel(k, global_range, schedule);
         } else {
-          omp_dispatch::parallel_for_kernel_offset(k, global_range, offset);
+          omp_dispatch::parallel_for_kernel_offset(k, global_range, offset,
+                                                   schedule);
         }
 
       } else if constexpr (type == rt::kernel_type::ndrange_parallel_for) {
@@ -16,6 +16,10 @@
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+
+#include <array>
+#include <optional>
 
 namespace hipsycl {
 namespace rt {
@@ -32,13 +36,53 @@ public:
     void** args,
     std::size_t* arg_sizes,
     std::size_t num_args,
-    std::size_t local_mem_size);
+    std::size_t local_mem_size,
+    backend_allocator* profile_allocator = nullptr);
 
   kernel_configuration::id_type
   finalize_binary_configuration(kernel_configuration &config);
 
   std::string select_image_and_kernels(std::vector<std::string>* kernel_names_out);
+
+  /// Returns true if asynchronous JIT compilation is enabled and the
+  /// configuration produced by finalize_binary_configuration() has been
+  /// specialized for invariant kernel arguments. In this case, the
+  /// less specialized configuration from before argument specialization
+  /// can be used while the specialized binary is compiled in the background.
+  bool has_fallback_configuration() const {
+    return _fallback_config.has_value();
+  }
+
+  const kernel_configuration& get_fallback_configuration() const {
+    return _fallback_config.value();
+  }
+
+  kernel_configuration::id_type get_fallback_configuration_id() const {
+    return _fallback_config_id;
+  }
+
+  /// Returns an id of all inputs that determine the configuration produced by
+  /// finalize_binary_configuration() for the given initial configuration.
+  /// Returns an empty optional if the configuration additionally depends on
+  /// state that changes between launches, e.g. runtime statistics at
+  /// adaptivity level > 1.
+  std::optional<kernel_configuration::id_type>
+  get_launch_cache_id(const kernel_configuration &initial_config) const;
+
+  /// Returns the value that identifies the kernel code in the binary
+  /// configuration. In the single-kernel code model, this is the content hash
+  /// of the kernel if available, such that identical kernels from different
+  /// HCF objects share JIT binaries. Otherwise, it is the HCF object id.
+  hcf_object_id get_code_identity() const;
 private:
+  // Instruments the kernel to record a branch profile, or applies
+  // a previously recorded profile.
+  void apply_branch_profile(kernel_configuration &config,
+                            bool remember_fallback_config);
+  // Identifies an fcall_specialized_config argument of this kernel across
+  // launches
+  kernel_configuration::id_type get_fcall_inline_cache_key(int param_index) const;
+
   hcf_object_id _hcf;
   std::string_view _kernel_name;
   const hcf_kernel_info* _kernel_info;
@@ -49,8 +93,46 @@ private:
   std::size_t* _arg_sizes;
   std::size_t _num_args;
   std::size_t _local_mem_size;
+  // Allocates device-accessible branch profile counters, if the
+  // backend supports profile-guided optimization
+  backend_allocator* _profile_allocator;
 
   int _adaptivity_level;
+  
+  std::optional<kernel_configuration> _fallback_config;
+  kernel_configuration::id_type _fallback_config_id;
+};
+
+/// Remembers code objects and kernel handles of recent SSCP launches
+/// of a queue, keyed by kernel_adaptivity_engine::get_launch_cache_id().
+/// Repeated launches from the same call site can then skip building the
+/// kernel configuration and looking up the kernel cache.
+///
+/// This class is not thread-safe.
+template<class KernelHandle>
+class sscp_launch_cache {
+public:
+  struct entry {
+    kernel_configuration::id_type launch_id = {};
+    const code_object* obj = nullptr;
+    KernelHandle kernel = {};
+  };
+
+  const entry* find(const kernel_configuration::id_type& launch_id) const {
+    for(const auto& e : _entries)
+      if(e.obj && e.launch_id == launch_id)
+        return &e;
+    return nullptr;
+  }
+
+  void insert(const kernel_configuration::id_type &launch_id,
+              const code_object *obj, KernelHandle kernel) {
+    _entries[_next_entry] = entry{launch_id, obj, kernel};
+    _next_entry = (_next_entry + 1) % _entries.size();
+  }
+private:
+  std::array<entry, 8> _entries;
+  std::size_t _next_entry = 0;
 };
 
 }
@@ -0,0 +1,104 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_ALLOCATION_TRACKER_HPP
+#define HIPSYCL_ALLOCATION_TRACKER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "allocator.hpp"
+#include "data.hpp"
+#include "device_id.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Remembers when the device allocations of buffers were last used,
+/// such that the least recently used ones can be evicted to the host
+/// when device memory is exhausted (see ACPP_RT_BUFFER_EVICTION).
+///
+/// Thread safety: Safe
+class buffer_allocation_tracker
+{
+public:
+  /// Records a use of the allocation of \c region on \c dev
+  void register_use(const std::shared_ptr<buffer_data_region> &region,
+                    device_id dev);
+
+  void unregister(const buffer_data_region *region, device_id dev);
+
+  /// Returns the data regions with allocations on \c dev, starting with
+  /// the least recently used one. \c excluded is never returned.
+  std::vector<std::shared_ptr<buffer_data_region>>
+  get_eviction_candidates(device_id dev, const buffer_data_region *excluded);
+
+private:
+  struct device_use {
+    device_id dev;
+    uint64_t last_use;
+  };
+
+  struct entry {
+    std::weak_ptr<buffer_data_region> region;
+    std::vector<device_use> uses;
+  };
+
+  std::mutex _mutex;
+  uint64_t _use_counter = 0;
+  std::unordered_map<const buffer_data_region *, entry> _entries;
+};
+
+/// Keeps the device allocations of destroyed buffers, such that buffers
+/// that are created later, e.g. temporaries in the next iteration of a loop,
+/// can reuse them instead of allocating device memory again
+/// (see ACPP_RT_BUFFER_ALLOCATION_CACHE_SIZE).
+///
+/// Data regions only free their allocations once all operations that use
+/// them have completed and been released, so cached allocations can be handed
+/// out again immediately.
+///
+/// Thread safety: Safe
+class buffer_allocation_cache
+{
+public:
+  /// \param max_cached_size Maximum size in bytes of idle allocations held
+  /// by the cache. If 0, no allocations are cached.
+  buffer_allocation_cache(std::size_t max_cached_size);
+  ~buffer_allocation_cache();
+
+  bool is_enabled() const { return _max_cached_size > 0; }
+
+  /// Returns an allocator that forwards to \c backend_alloc, the allocator
+  /// of \c dev, but serves allocate() from idle allocations and returns
+  /// allocations to the cache when they are freed. The returned allocator
+  /// remains valid for the lifetime of the cache.
+  backend_allocator *get_allocator(device_id dev,
+                                   backend_allocator *backend_alloc);
+
+private:
+  class caching_allocator;
+
+  std::mutex _mutex;
+  std::size_t _max_cached_size;
+  std::atomic<std::size_t> _cached_size = 0;
+  std::vector<std::pair<device_id, std::unique_ptr<caching_allocator>>>
+      _allocators;
+};
+
+}
+}
+
+#endif
@@ -50,6 +50,25 @@ public:
   virtual result mem_advise(const void *addr, std::size_t num_bytes,
                             int advise) const = 0;
 
+  // Hints that a range of USM shared memory should preferably reside in
+  // the memory of this allocator's device, such that the device does not
+  // fault when accessing it after the host has done so. If prefer_device
+  // is false, a previous hint is revoked. Backends that cannot express
+  // such a preference ignore the hint.
+  virtual result set_preferred_device_residency(const void *addr,
+                                                std::size_t num_bytes,
+                                                bool prefer_device) const {
+    return make_success();
+  }
+
+  // Whether existing host memory at ptr can be used directly as
+  // allocation of this backend with the given alignment, instead of
+  // allocating and copying.
+  virtual bool can_alias_host_memory(const void *ptr,
+                                     size_t min_alignment) const {
+    return false;
+  }
+
   virtual ~backend_allocator(){}
 };
 
@@ -56,6 +56,20 @@ public:
     _errors.clear();
   }
 
+  /// Removes errors of the given type among those that were added
+  /// after the first \c num_retained_errors errors. Used to discard errors
+  /// of operations that have been retried successfully.
+  void remove_errors_after(std::size_t num_retained_errors, error_type type) {
+    std::lock_guard<std::mutex> lock{_lock};
+    common::auto_small_vector<result> retained;
+    for(std::size_t i = 0; i < _errors.size(); ++i) {
+      if(i < num_retained_errors ||
+         _errors[i].info().get_error_type() != type)
+        retained.push_back(_errors[i]);
+    }
+    _errors = std::move(retained);
+  }
+
   std::size_t num_errors() const {
     std::lock_guard<std::mutex> lock{_lock};
     return _errors.size();
@@ -11,7 +11,10 @@
 #ifndef HIPSYCL_RUNTIME_BACKEND_HPP
 #define HIPSYCL_RUNTIME_BACKEND_HPP
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -58,6 +61,15 @@ public:
   // priority. It is backend-specific if or how this will affect execution.
   virtual std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) = 0;
+
+  // Like create_inorder_executor(), but the executor only uses
+  // num_compute_units compute units (e.g. SMs on CUDA) of the device, such
+  // that its operations are not starved by large kernels of other queues.
+  // Backends that do not support partitioning devices ignore
+  // num_compute_units.
+  virtual std::unique_ptr<backend_executor>
+  create_partitioned_inorder_executor(device_id dev, int priority,
+                                      std::size_t num_compute_units);
 };
 
 class backend_manager
@@ -73,17 +85,31 @@ public:
   hw_model& hardware_model();
   const hw_model& hardware_model() const;
 
+  // Creates all backends that have not been created yet
   template<class F>
   void for_each_backend(F f)
   {
-    for(auto& b : _backends){
-      f(b.get());
+    if(!_all_backends_created.load(std::memory_order_acquire))
+      create_all_backends();
+
+    for(std::size_t i = 0; i < _backends.size(); ++i){
+      if(backend* b = get_or_create(i))
+        f(b);
     }
   }
 
 private:
+  backend* get_or_create(std::size_t index) const;
+  void create_all_backends();
+
   backend_loader _loader;
-  backend_list_type _backends;
+  // Backends are only created once they are first used, such that
+  // applications do not pay for initializing backends they do not use.
+  // Contains one entry per backend plugin, which remains nullptr if the
+  // backend has not been created yet or its creation failed.
+  mutable backend_list_type _backends;
+  mutable std::vector<std::once_flag> _backend_creation_flags;
+  std::atomic<bool> _all_backends_created = false;
 
   std::unique_ptr<hw_model> _hw_model;
   std::shared_ptr<kernel_cache> _kernel_cache;
@@ -16,6 +16,8 @@
 #include <vector>
 #include <utility>
 
+#include "device_id.hpp"
+
 namespace hipsycl::rt {
 class backend;
 }
@@ -40,18 +42,29 @@ class backend_loader {
 public:
   ~backend_loader();
 
+  /// Enumerates the available backend plugins. Plugins following the
+  /// rt-backend-<name> naming scheme are only opened by create().
   void query_backends();
   
   std::size_t get_num_backends() const;
   std::string get_backend_name(std::size_t index) const;
   bool has_backend(const std::string &name) const;
+  /// Returns false if the backend is not one of the known backends
+  bool get_backend_id(std::size_t index, backend_id &out) const;
 
   backend *create(std::size_t index) const;
   backend *create(const std::string &name) const;
 
 private:
   using handle_t = void*;
-  std::vector<std::pair<std::string, handle_t>> _handles;
+
+  struct plugin {
+    std::string backend_name;
+    std::string path;
+    // nullptr until the plugin is opened
+    mutable handle_t handle;
+  };
+  std::vector<plugin> _plugins;
 };
 
 }
@@ -47,8 +47,12 @@ public:
                                const rt::hcf_kernel_info* kernel_info,
                                const kernel_configuration& config) = 0;
 
+  // Invoked for kernels where the backend may choose the group size,
+  // e.g. basic parallel_for.
   virtual rt::range<3> select_group_size(const rt::range<3> &global_range,
-                                         const rt::range<3> &group_size) const {
+                                         const rt::range<3> &group_size,
+                                         hcf_object_id hcf_object,
+                                         std::string_view kernel_name) const {
     rt::range<3> selected_group_size = group_size;
     if(global_range[1] == 1 && global_range[2] == 1) {
       selected_group_size = rt::range<3>{128,1,1};
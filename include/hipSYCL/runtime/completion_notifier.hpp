@@ -0,0 +1,88 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_COMPLETION_NOTIFIER_HPP
+#define HIPSYCL_COMPLETION_NOTIFIER_HPP
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "dag_node.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Invokes callbacks once nodes have completed, without requiring the
+/// thread that registered the callback to wait.
+///
+/// For submitted nodes, the executor is asked to signal completion using
+/// the notification mechanisms of the backend, e.g. host callbacks of
+/// CUDA/HIP streams or OpenCL event callbacks. Other nodes are observed by
+/// querying their completion, backing off while no node completes.
+/// In both cases, callbacks are invoked by a single notifier thread, which is
+/// only started once the first callback is registered. Callbacks can
+/// therefore use the runtime, which is not allowed in backend callbacks.
+class completion_notifier
+{
+public:
+  using callback = std::function<void()>;
+
+  completion_notifier();
+  ~completion_notifier();
+
+  completion_notifier(const completion_notifier&) = delete;
+  completion_notifier& operator=(const completion_notifier&) = delete;
+
+  /// Invokes \c cb on the notifier thread once \c node has completed.
+  /// The node does not need to be submitted yet, but it must eventually
+  /// be submitted by a flush of the dag. Only submitted nodes can make use of
+  /// the notification mechanisms of the backend.
+  /// Callbacks must not block, since they delay the notification of all
+  /// other nodes.
+  void notify_on_completion(dag_node_ptr node, callback cb);
+
+  /// \return The number of callbacks that have not yet been invoked
+  std::size_t get_num_pending() const;
+private:
+  struct pending_notification {
+    dag_node_ptr node;
+    callback cb;
+  };
+
+  struct backend_callback_data {
+    completion_notifier* notifier;
+    pending_notification notification;
+  };
+
+  // Invoked by the backend once the node has completed
+  static void backend_callback(void* data);
+  // Starts the notifier thread if needed; assumes that _mutex is held
+  void start_thread();
+  void work();
+
+  mutable std::mutex _mutex;
+  std::condition_variable _condition;
+  // Registered, but not yet observed by the notifier thread
+  std::vector<pending_notification> _registered;
+  // Completion was signalled by the backend
+  std::vector<pending_notification> _signalled;
+  std::size_t _num_pending;
+  bool _continue;
+  std::thread _thread;
+};
+
+}
+}
+
+#endif
@@ -13,6 +13,9 @@
 
 #include "../allocator.hpp"
 
+struct CUstream_st;
+struct CUmemPoolHandle_st;
+
 namespace hipsycl {
 namespace rt {
 
@@ -20,6 +23,7 @@ class cuda_allocator : public backend_allocator
 {
 public:
   cuda_allocator(backend_descriptor desc, int cuda_device);
+  ~cuda_allocator();
 
   virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
 
@@ -35,9 +39,19 @@ public:
 
   virtual result mem_advise(const void *addr, std::size_t num_bytes,
                             int advise) const override;
+
+  virtual result set_preferred_device_residency(const void *addr,
+                                                std::size_t num_bytes,
+                                                bool prefer_device) const override;
 private:
+  void init_mem_pool();
+
   backend_descriptor _backend_descriptor;
   int _dev;
+  // Only set if stream-ordered allocation is enabled and supported
+  // by the device
+  CUmemPoolHandle_st* _mem_pool = nullptr;
+  CUstream_st* _allocation_stream = nullptr;
 };
 
 }
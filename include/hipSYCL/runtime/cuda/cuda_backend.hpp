@@ -17,6 +17,7 @@
 #include "cuda_queue.hpp"
 #include "cuda_hardware_manager.hpp"
 #include "cuda_event_pool.hpp"
+#include "../staging_buffer_pool.hpp"
 
 #ifndef HIPSYCL_CUDA_BACKEND_HPP
 #define HIPSYCL_CUDA_BACKEND_HPP
@@ -42,9 +43,15 @@ public:
   virtual ~cuda_backend(){}
 
   cuda_event_pool* get_event_pool(device_id dev) const;
+  staging_buffer_pool* get_staging_buffer_pool(device_id dev) const;
+  cuda_device_timestamps* get_device_timestamps(device_id dev) const;
 
   virtual std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
+
+  virtual std::unique_ptr<backend_executor>
+  create_partitioned_inorder_executor(device_id dev, int priority,
+                                      std::size_t num_compute_units) override;
 private:
   mutable cuda_hardware_manager _hw_manager;
   mutable lazily_constructed_executor<multi_queue_executor> _executor;
@@ -11,8 +11,13 @@
 #ifndef HIPSYCL_CUDA_CODE_OBJECT_HPP
 #define HIPSYCL_CUDA_CODE_OBJECT_HPP
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/error.hpp"
@@ -20,6 +25,7 @@
 #include "hipSYCL/runtime/kernel_cache.hpp"
 
 struct CUmod_st;
+struct CUfunc_st;
 
 namespace hipsycl {
 namespace rt {
@@ -31,6 +37,16 @@ public:
   virtual CUmod_st* get_module() const = 0;
   virtual result get_build_result() const = 0;
   virtual int get_device() const = 0;
+
+  /// Obtains the function handle of a kernel in the module. The handle is
+  /// only looked up in the module on first use, such that kernel launches
+  /// do not need to go through a string-keyed lookup in the driver.
+  result get_kernel(std::string_view kernel_name, CUfunc_st *&f) const;
+private:
+  mutable std::mutex _kernel_lookup_mutex;
+  mutable std::unordered_map<std::string_view, CUfunc_st *> _kernels;
+  // Backing storage for the keys of _kernels
+  mutable std::vector<std::unique_ptr<std::string>> _kernel_names_storage;
 };
 
 class cuda_multipass_executable_object : public cuda_executable_object {
@@ -94,6 +110,10 @@ public:
   virtual CUmod_st* get_module() const override;
   virtual int get_device() const override;
 
+  /// Bytes of spill stores of the kernel as reported by ptxas, or 0 if
+  /// unknown.
+  uint64_t get_spill_store_bytes(std::string_view backend_kernel_name) const;
+
   // Only for adaptivity level >= 1
 private:
   result build(const std::string& source);
@@ -107,6 +127,7 @@ private:
   CUmod_st* _module;
 
   std::vector<int> _retained_arguments;
+  std::unordered_map<std::string, uint64_t> _spill_store_bytes;
 };
 
 }
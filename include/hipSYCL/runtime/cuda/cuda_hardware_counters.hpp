@@ -0,0 +1,64 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_CUDA_HARDWARE_COUNTERS_HPP
+#define HIPSYCL_CUDA_HARDWARE_COUNTERS_HPP
+
+#include <memory>
+#include <mutex>
+
+#include "../error.hpp"
+#include "../instrumentation.hpp"
+
+// Forward declare CUstream_st instead of including cuda_runtime_api.h.
+// It's not possible to include both HIP and CUDA headers since they
+// define conflicting symbols. Therefore we should not include
+// cuda_runtime_api.h in runtime header files.
+struct CUstream_st;
+
+namespace hipsycl {
+namespace rt {
+
+class cupti_device_profiler;
+
+/// Collects hardware counters of the kernels launched on a device between
+/// construction and finish() using the CUPTI range profiler. Only one
+/// collection can be active per device at a time; constructing a second one
+/// blocks until the first has finished.
+///
+/// Kernels are replayed as often as necessary to collect all counters,
+/// which requires waiting for the kernel to complete in finish().
+class cuda_hardware_counter_collection {
+public:
+  /// Requires that the CUDA context of the device is current.
+  cuda_hardware_counter_collection(int device_id);
+  ~cuda_hardware_counter_collection();
+
+  cuda_hardware_counter_collection(const cuda_hardware_counter_collection &) =
+      delete;
+  cuda_hardware_counter_collection &
+  operator=(const cuda_hardware_counter_collection &) = delete;
+
+  /// Waits for the kernels on the stream and retrieves the counters of the
+  /// first kernel launched since construction.
+  /// Returns an error if collection failed or no kernel was launched.
+  result finish(CUstream_st *stream,
+                std::shared_ptr<simple_hardware_counters> &out);
+
+private:
+  cupti_device_profiler *_profiler;
+  std::unique_lock<std::mutex> _lock;
+  bool _is_active;
+};
+
+}
+}
+
+#endif
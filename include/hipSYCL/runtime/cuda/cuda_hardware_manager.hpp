@@ -23,6 +23,8 @@ namespace rt {
 
 class cuda_allocator;
 class cuda_event_pool;
+class staging_buffer_pool;
+class cuda_device_timestamps;
 
 class cuda_hardware_context : public hardware_context
 {
@@ -55,14 +57,24 @@ public:
   virtual ~cuda_hardware_context();
 
   cuda_allocator* get_allocator() const;
+
+  /// Enables direct access from this device to the memory of \c peer_dev
+  /// if supported. Returns whether peer access is available.
+  bool enable_peer_access(int peer_dev);
   cuda_event_pool* get_event_pool() const;
+  staging_buffer_pool* get_staging_buffer_pool() const;
+  /// Returns nullptr unless ACPP_RT_DEVICE_TIMESTAMPS is enabled
+  cuda_device_timestamps* get_device_timestamps() const;
 
   unsigned get_compute_capability() const;
 private:
   std::unique_ptr<cudaDeviceProp> _properties;
   std::unique_ptr<cuda_allocator> _allocator;
   std::unique_ptr<cuda_event_pool> _event_pool;
+  std::unique_ptr<staging_buffer_pool> _staging_pool;
+  std::unique_ptr<cuda_device_timestamps> _device_timestamps;
   int _dev;
+  std::vector<std::size_t> _peer_devices;
 };
 
 class cuda_hardware_manager : public backend_hardware_manager
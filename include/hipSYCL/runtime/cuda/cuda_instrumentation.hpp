@@ -12,11 +12,18 @@
 #define HIPSYCL_CUDA_INSTRUMENTATION_HPP
 
 #include "cuda_event.hpp"
+#include "../generic/device_timestamp_buffer.hpp"
 #include "../generic/host_timestamped_event.hpp"
 #include "../generic/timestamp_delta_instrumentation.hpp"
 #include "../instrumentation.hpp"
 #include "hipSYCL/runtime/event.hpp"
 #include <chrono>
+#include <memory>
+#include <mutex>
+
+struct CUstream_st;
+struct CUmod_st;
+struct CUfunc_st;
 
 namespace hipsycl {
 namespace rt {
@@ -37,6 +44,44 @@ using cuda_execution_finish_timestamp =
     timestamp_delta_instrumentation<instrumentations::execution_finish_timestamp,
                                     cuda_event_time_delta>;
 
+using cuda_device_execution_start_timestamp =
+    device_timestamp_instrumentation<instrumentations::execution_start_timestamp>;
+
+using cuda_device_execution_finish_timestamp =
+    device_timestamp_instrumentation<instrumentations::execution_finish_timestamp>;
+
+/// Records timestamps of the device's global timer into a
+/// device_timestamp_buffer in mapped host memory by enqueuing a
+/// single-thread kernel, see ACPP_RT_DEVICE_TIMESTAMPS. Compared to
+/// event-based timestamps, this requires neither events nor a
+/// synchronization to relate them to a reference event.
+class cuda_device_timestamps {
+public:
+  cuda_device_timestamps(int device_id);
+  ~cuda_device_timestamps();
+
+  /// Enqueues writing the current value of the global timer into a new
+  /// slot of the buffer.
+  result record(CUstream_st *stream, device_timestamp_buffer::slot &out);
+
+  std::shared_ptr<device_timestamp_buffer> get_buffer() const {
+    return _buffer;
+  }
+private:
+  result init();
+  result calibrate();
+
+  int _device_id;
+  std::once_flag _init_flag;
+  result _init_result;
+
+  uint64_t *_host_ptr = nullptr;
+  uint64_t *_device_ptr = nullptr;
+  CUmod_st *_module = nullptr;
+  CUfunc_st *_kernel = nullptr;
+  std::shared_ptr<device_timestamp_buffer> _buffer;
+};
+
 }
 }
 
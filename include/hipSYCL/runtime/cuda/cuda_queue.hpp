@@ -19,10 +19,15 @@
 #include "cuda_code_object.hpp"
 #include "hipSYCL/common/spin_lock.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/adaptivity_engine.hpp"
 #include "hipSYCL/runtime/code_object_invoker.hpp"
 #include "hipSYCL/runtime/cuda/cuda_event.hpp"
+#include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 // Forward declare CUstream_st instead of including cuda_runtime_api.h.
 // It's not possible to include both HIP and CUDA headers since they
@@ -30,6 +35,9 @@
 // cuda_runtime_api.h in runtime header files.
 // Note: CUstream_st* == cudaStream_t.
 struct CUstream_st;
+struct CUgraphExec_st;
+struct CUfunc_st;
+struct CUgreenCtx_st;
 
 namespace hipsycl {
 namespace rt {
@@ -71,6 +79,11 @@ public:
                                std::string_view kernel_name,
                                const rt::hcf_kernel_info* kernel_info,
                                const kernel_configuration& config) override;
+
+  virtual rt::range<3>
+  select_group_size(const rt::range<3> &global_range,
+                    const rt::range<3> &group_size, hcf_object_id hcf_object,
+                    std::string_view kernel_name) const override;
 private:
   cuda_queue* _queue;
 };
@@ -79,6 +92,10 @@ class cuda_queue : public inorder_queue
 {
 public:
   cuda_queue(cuda_backend* be, device_id dev, int priority = 0);
+  // Constructs a queue whose stream only executes on num_compute_units SMs
+  // of the device, if supported by the CUDA version and device.
+  cuda_queue(cuda_backend *be, device_id dev, int priority,
+             std::size_t num_compute_units);
 
   CUstream_st* get_stream() const;
 
@@ -106,6 +123,9 @@ public:
 
   virtual result query_status(inorder_queue_status& status) override;
 
+  virtual result submit_completion_callback(void (*callback)(void *),
+                                            void *user_data) override;
+
   result submit_multipass_kernel_from_code_object(
       const kernel_operation &op, hcf_object_id hcf_object,
       const std::string &backend_kernel_name, const rt::range<3> &grid_size,
@@ -119,14 +139,42 @@ public:
       unsigned local_mem_size, void **args, std::size_t *arg_sizes,
       std::size_t num_args, const kernel_configuration &config);
 
+  // Selects group sizes for SSCP kernels where the runtime is free to
+  // choose, based on previous occupancy queries (see group_size_cache).
+  rt::range<3> select_sscp_group_size(const rt::range<3> &global_range,
+                                      const rt::range<3> &default_group_size,
+                                      hcf_object_id hcf_object,
+                                      std::string_view kernel_name);
+
   const host_timestamped_event& get_timing_reference() const {
     return _reference_event;
   }
+
+  /// Returns nullptr if timestamps are not written by the device,
+  /// see ACPP_RT_DEVICE_TIMESTAMPS.
+  cuda_device_timestamps* get_device_timestamps() const;
 private:
   void activate_device() const;
+  // Creates _stream in a green context restricted to num_compute_units SMs.
+  // Returns false if this is not possible, in which case nothing is created.
+  bool create_partitioned_stream(int priority, std::size_t num_compute_units);
+
+  // Starts, continues or ends graph capture (hints::graph_capture)
+  // depending on the hints of the node that is about to be submitted.
+  // Assumes that _graph_capture_mutex is locked.
+  result update_graph_capture(const dag_node_ptr &node, bool is_capturable);
+  // Ends the active graph capture, if any, and launches the captured graph.
+  // Assumes that _graph_capture_mutex is locked.
+  result end_graph_capture();
+  // Packs the mapped SSCP kernel arguments if packing is enabled for the
+  // kernel. Returns the extra argument for cuLaunchKernel in this case,
+  // or nullptr if the arguments should be passed individually.
+  void **pack_sscp_kernel_args();
 
   const device_id _dev;
   CUstream_st *_stream;
+  // Only set if the queue uses a partition of the device
+  CUgreenCtx_st *_green_ctx = nullptr;
   cuda_multipass_code_object_invoker _multipass_code_object_invoker;
   cuda_sscp_code_object_invoker _sscp_code_object_invoker;
   host_timestamped_event _reference_event;
@@ -137,7 +185,29 @@ private:
   // SSCP submission data
   common::spin_lock _sscp_submission_spin_lock;
   glue::jit::cxx_argument_mapper _arg_mapper;
+  // Minimum number of kernel parameters for which the mapped arguments are
+  // passed to cuLaunchKernel as a single packed buffer; 0 if disabled
+  std::size_t _packed_args_threshold;
+  std::vector<unsigned char> _packed_args;
+  std::size_t _packed_args_size = 0;
+  void* _packed_args_launch_config[5];
   kernel_configuration _config;
+  sscp_launch_cache<CUfunc_st*> _sscp_launch_cache;
+  // hints::cooperative_launch of the kernel that is currently submitted
+  const hints::cooperative_launch* _cooperative_launch = nullptr;
+  // group_size_cache key of the kernel that is currently submitted, if its
+  // group size should be determined from occupancy after compilation
+  std::optional<kernel_configuration::id_type> _pending_group_size_key;
+  // group_size_cache key of the kernel that is currently submitted, if it
+  // is launched with a group size candidate of the group_size_autotuner
+  std::optional<kernel_configuration::id_type> _pending_autotuning_key;
+
+  // Graph capture data
+  std::recursive_mutex _graph_capture_mutex;
+  bool _is_capturing_graph;
+  std::size_t _graph_capture_id;
+  // Instantiated graphs for each capture id, see hints::graph_capture
+  std::unordered_map<std::size_t, CUgraphExec_st*> _graph_execs;
 };
 
 }
@@ -31,7 +31,8 @@ class runtime;
 /// Note: At any given time, there can only exist one dag_builder, otherwise
 /// calculated dependencies may be incorrect!
 ///
-/// Thread safety: Safe
+/// Thread safety: Safe. Command groups that access disjoint data regions
+/// are analyzed concurrently.
 class dag_builder
 {
 public:
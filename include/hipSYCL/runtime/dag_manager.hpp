@@ -11,8 +11,10 @@
 #ifndef HIPSYCL_DAG_MANAGER_HPP
 #define HIPSYCL_DAG_MANAGER_HPP
 
+#include <atomic>
 #include <mutex>
 
+#include "allocation_tracker.hpp"
 #include "dag.hpp"
 #include "dag_builder.hpp"
 #include "dag_direct_scheduler.hpp"
@@ -38,6 +40,10 @@ public:
   // Submits operations asynchronously and
   // wait until they have been submitted
   void flush_sync();
+  // Defers flushing the operations that the calling thread submits
+  // until the outermost batch has ended
+  void begin_submission_batch();
+  void end_submission_batch();
   // Wait for completion of all submitted operations
   void wait();
   void wait(std::size_t node_group_id);
@@ -45,21 +51,47 @@ public:
   node_list_t get_group(std::size_t node_group_id);
 
   void register_submitted_ops(dag_node_ptr);
+  // Executors can push nodes into this queue once their completion is
+  // signalled by the backend, see ACPP_RT_COMPLETION_CALLBACKS.
+  std::shared_ptr<node_completion_queue> get_completion_queue() const;
+
+  buffer_allocation_tracker& get_allocation_tracker()
+  { return _allocation_tracker; }
+
+  buffer_allocation_cache& get_allocation_cache()
+  { return _allocation_cache; }
 private:
   void trigger_flush_opportunity();
+  // Whether the last node of the most recent flush has completed, i.e.
+  // devices have run out of work. Used for ACPP_RT_ADAPTIVE_FLUSH.
+  bool is_starving();
 
   dag_builder* builder() const;
 
+  // Must be destroyed after all DAG nodes, since data regions of buffers
+  // return their allocations to the cache.
+  buffer_allocation_cache _allocation_cache;
   std::unique_ptr<dag_builder> _builder;
   worker_thread _worker;
   
   dag_direct_scheduler _direct_scheduler;
   dag_unbound_scheduler _unbound_scheduler;
   dag_submitted_ops _submitted_ops;
+  buffer_allocation_tracker _allocation_tracker;
 
   // Should only be used for flush_async()
   std::mutex _flush_mutex;
 
+  // State of the adaptive flush policy, see ACPP_RT_ADAPTIVE_FLUSH
+  bool _use_adaptive_flush;
+  std::size_t _max_flush_threshold;
+  std::atomic<std::size_t> _flush_threshold;
+  std::mutex _last_flushed_node_mutex;
+  dag_node_ptr _last_flushed_node;
+
+  // See ACPP_RT_CRITICAL_PATH_SCHEDULING
+  bool _use_critical_path_scheduling;
+
   // TODO: This is not used anywhere
   [[maybe_unused]] runtime* _rt;
 };
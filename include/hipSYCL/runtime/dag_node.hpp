@@ -17,6 +17,7 @@
 #include "hints.hpp"
 #include "event.hpp"
 #include "hipSYCL/common/small_vector.hpp"
+#include "generic/object_pool.hpp"
 
 
 namespace hipsycl {
@@ -56,6 +57,10 @@ public:
   void mark_virtually_submitted();
   /// Only to be called by the backend executor/scheduler
   void cancel();
+  /// Only to be called by the backend executor/scheduler, once the
+  /// operation of the node is known to have completed. Unlike wait(),
+  /// this does not mark requirements as complete.
+  void mark_known_complete();
   /// Only to be called by the backend executor/scheduler
   void assign_to_executor(backend_executor* ctx);
   /// Only to be called by the backend executor/scheduler
@@ -140,6 +145,13 @@ private:
 
 };
 
+/// Nodes are created for every submission; their storage is therefore
+/// recycled through the object_pool.
+template <class... Args> dag_node_ptr make_dag_node(Args &&...args) {
+  return std::allocate_shared<dag_node>(object_pool_allocator<dag_node>{},
+                                        std::forward<Args>(args)...);
+}
+
 }
 }
 
@@ -11,16 +11,41 @@
 #ifndef HIPSYCL_DAG_SUBMITTED_OPS_HPP
 #define HIPSYCL_DAG_SUBMITTED_OPS_HPP
 
+#include <list>
+#include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "dag_node.hpp"
 #include "generic/async_worker.hpp"
 #include "hints.hpp"
+#include "hipSYCL/common/spin_lock.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+/// Collects nodes whose completion was signalled by the backend, e.g. by
+/// host callbacks of CUDA or HIP streams (see ACPP_RT_COMPLETION_CALLBACKS).
+/// This allows removing them from dag_submitted_ops without polling all
+/// submitted nodes.
+class node_completion_queue
+{
+public:
+  /// Can be invoked from backend callback threads
+  void push(dag_node_ptr node) {
+    common::spin_lock_guard lock{_lock};
+    _completed.push_back(std::move(node));
+  }
+
+  void pop_all(std::vector<dag_node_ptr>& out) {
+    common::spin_lock_guard lock{_lock};
+    out.swap(_completed);
+  }
+private:
+  common::spin_lock _lock;
+  std::vector<dag_node_ptr> _completed;
+};
 
 class dag_submitted_ops
 {
@@ -38,12 +63,28 @@ public:
 
   std::size_t get_num_nodes() const;
 
+  // Removes nodes that are known to have completed.
+  void purge_known_completed();
+
+  // Queue into which executors can push completed nodes
+  std::shared_ptr<node_completion_queue> get_completion_queue() const;
+
+  dag_submitted_ops();
   ~dag_submitted_ops();
 private:
-  void purge_known_completed();
   void copy_node_list(std::vector<dag_node_ptr>& out) const;
+  // Removes the nodes of the completion queue; assumes that _lock is held.
+  // Only costs O(number of completed nodes).
+  void erase_signalled_completions();
+  // Assumes that _lock is held
+  void erase_node(std::list<dag_node_ptr>::iterator it);
 
-  std::vector<dag_node_ptr> _ops;
+  // In submission order
+  std::list<dag_node_ptr> _ops;
+  std::unordered_map<const dag_node *, std::list<dag_node_ptr>::iterator>
+      _op_positions;
+  std::shared_ptr<node_completion_queue> _completion_queue;
+  std::vector<dag_node_ptr> _completion_scratch;
   mutable std::mutex _lock;
   worker_thread _updater_thread;
 };
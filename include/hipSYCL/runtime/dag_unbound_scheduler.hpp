@@ -11,6 +11,11 @@
 #ifndef HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 #define HIPSYCL_DAG_UNBOUND_SCHEDULER_HPP
 
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "dag_node.hpp"
 #include "dag_direct_scheduler.hpp"
 
@@ -19,13 +24,36 @@ namespace rt {
 
 class runtime;
 
+/// Assigns nodes that are not bound to a device to the eligible device
+/// with the earliest estimated completion time. This estimate consists
+/// of the time to complete the work that has already been assigned to the
+/// device, and the time to transfer the data that the node accesses as
+/// estimated by the memcpy_model.
 class dag_unbound_scheduler {
 public:
   dag_unbound_scheduler(runtime* rt);
 
   void submit(dag_node_ptr node);
 private:
+  struct device_load {
+    device_id dev;
+    // Nodes assigned to the device that might not have completed yet,
+    // in order of submission
+    std::deque<std::weak_ptr<dag_node>> in_flight;
+    // Estimated time per operation in seconds, measured from the rate at
+    // which operations complete while the device is busy
+    double operation_time;
+    std::chrono::steady_clock::time_point last_update;
+  };
+
+  device_load& get_device_load(device_id dev);
+  // Removes completed nodes and updates the operation time estimate
+  void update_device_load(device_load& load);
+  double estimate_completion_time(const dag_node_ptr &node,
+                                  device_load &load);
+
   std::vector<device_id> _devices;
+  std::vector<device_load> _device_loads;
   rt::dag_direct_scheduler _direct_scheduler;
   runtime* _rt;
 };
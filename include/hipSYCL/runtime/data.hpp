@@ -11,14 +11,19 @@
 #ifndef HIPSYCL_DATA_HPP
 #define HIPSYCL_DATA_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <limits>
 #include <mutex>
+#include <optional>
 #include <vector>
 #include <utility>
 #include <algorithm>
 #include <limits>
 
 #include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/small_vector.hpp"
 #include "hipSYCL/sycl/access.hpp"
 #include "dag_node.hpp"
 #include "device_id.hpp"
@@ -28,6 +33,10 @@
 namespace hipsycl {
 namespace rt {
 
+/// Stores which pages of a 3D page table are available. Each scanline
+/// along the last dimension is stored as a sorted list of runs of available
+/// pages, such that operations cost proportional to the number of
+/// scanlines and distinct runs, instead of the number of pages.
 class range_store
 {
 public:
@@ -68,131 +77,46 @@ public:
   { return entire_range_equals(r, data_state::empty); }
 
 private:
-  template<class Entry_selection_predicate>
-  range<3> find_max_contiguous_rect_extent(
-    id<3> begin,
-    id<3> search_range_end,
-    Entry_selection_predicate p) const
-  {
-    // Find out length of longest contiguous row
-    size_t z_size = 
-      find_z_size(begin, search_range_end, p);
-
-    // Now go to 2D and find out width of surface
-    size_t y_size = 1;
-    if(_size[1] > 1)
-      y_size = find_y_size(begin, search_range_end, z_size, p);
-
-    // Now 3D
-    size_t x_size = 1;
-    if(_size[0] > 1)
-      x_size = find_x_size(begin, search_range_end, z_size, y_size, p);
-
-    return range<3>{x_size, y_size, z_size};
-    
-  }
-
-  template<class Entry_selection_predicate>
-  size_t find_x_size(id<3> begin,
-                     id<3> search_range_end,
-                     size_t z_size,
-                     size_t y_size,
-                     Entry_selection_predicate p) const
-  {
-    for(size_t x_offset = 0; x_offset < search_range_end[0]-begin[0]; ++x_offset){
-      id<3> surface_begin = begin;
-      surface_begin[0] += x_offset;
-
-      if(find_y_size(surface_begin, search_range_end, z_size, p) != y_size){
-        return x_offset;
-      }
-    }
-    return search_range_end[0] - begin[0];
-  }
-
-  template<class Entry_selection_predicate>
-  size_t find_y_size(id<3> begin,
-                    id<3> search_range_end,
-                    size_t z_size,
-                    Entry_selection_predicate p) const
-  {
-    for(size_t y_offset = 0; y_offset < search_range_end[1]-begin[1]; ++y_offset){
-      id<3> row_begin = begin;
-      row_begin[1] += y_offset;
+  /// Half-open interval [begin, end) of pages along the last dimension
+  struct run {
+    std::size_t begin;
+    std::size_t end;
 
-      if(find_z_size(row_begin, search_range_end, p) != z_size){
-        return y_offset;
-      }
+    friend bool operator==(const run& a, const run& b) {
+      return a.begin == b.begin && a.end == b.end;
     }
-    return search_range_end[1] - begin[1];
-  }
+  };
+  /// Sorted, disjoint and non-adjacent runs of available pages
+  using scanline = std::vector<run>;
 
-  template<class Entry_selection_predicate>
-  size_t find_z_size(id<3> begin,
-                    id<3> search_range_end,
-                    Entry_selection_predicate p) const
-  {
-    size_t base_pos = get_index(begin);
-    size_t max_length = search_range_end[2] - begin[2];
-    for(size_t offset = 0; offset < max_length; ++offset)
-    {
-      if(!p(base_pos + offset))
-        return offset;
-    }
-    return max_length;
-  }
+  static void insert_run(scanline &line, run r);
+  static void erase_run(scanline &line, run r);
+  /// Appends the maximal runs of pages in the given state within r to out
+  static void get_runs_in_state(const scanline &line, run r,
+                                data_state desired_state,
+                                std::vector<run> &out);
 
   template<class Function>
-  void for_each_element_in_range(const rect& r,
-    std::vector<data_state>& v,
-    Function f) const
-  {
-    for(size_t x = r.first[0]; x < r.second[0]+r.first[0]; ++x){
-      for(size_t y = r.first[1]; y < r.second[1]+r.first[1]; ++y){
-        for(size_t z = r.first[2]; z < r.second[2]+r.first[2]; ++z){
-
-          id<3> idx{x,y,z};
-          size_t pos = get_index(idx);
-          assert(pos < v.size());
-          f(id<3>{x,y,z}, v[pos]);
-        }
-      }
-    }
+  void for_each_scanline_in_range(const rect& r, Function f) const {
+    for(std::size_t x = r.first[0]; x < r.first[0] + r.second[0]; ++x)
+      for(std::size_t y = r.first[1]; y < r.first[1] + r.second[1]; ++y)
+        f(_scanlines[get_scanline_index(x, y)]);
   }
 
   template<class Function>
-  void for_each_element_in_range(const rect& r, 
-    const std::vector<data_state>& v, 
-    Function f) const
-  {
-    for(size_t x = r.first[0]; x < r.second[0]+r.first[0]; ++x){
-      for(size_t y = r.first[1]; y < r.second[1]+r.first[1]; ++y){
-        for(size_t z = r.first[2]; z < r.second[2]+r.first[2]; ++z){
-
-          id<3> idx{x,y,z};
-          size_t pos = get_index(idx);
-          assert(pos < v.size());
-          f(id<3>{x,y,z}, v[pos]);
-        }
-      }
-    }
+  void for_each_scanline_in_range(const rect& r, Function f) {
+    for(std::size_t x = r.first[0]; x < r.first[0] + r.second[0]; ++x)
+      for(std::size_t y = r.first[1]; y < r.first[1] + r.second[1]; ++y)
+        f(_scanlines[get_scanline_index(x, y)]);
   }
 
-  template<class Function>
-  void for_each_element_in_range(const rect& r, Function f) const
-  { for_each_element_in_range(r, _contained_data, f); }
-
-  template<class Function>
-  void for_each_element_in_range(const rect& r, Function f)
-  { for_each_element_in_range(r, _contained_data, f); }
-
-  size_t get_index(id<3> pos) const
+  std::size_t get_scanline_index(std::size_t x, std::size_t y) const
   {
-    return pos[0] * _size[1] * _size[2] + pos[1] * _size[2] + pos[2]; 
+    return x * _size[1] + y;
   }
 
   range<3> _size;
-  std::vector<data_state> _contained_data;
+  std::vector<scanline> _scanlines;
 };
 
 
@@ -208,9 +132,13 @@ struct data_user
 
 class data_user_tracker
 {
+  // Most data regions only have a handful of users that have not yet
+  // completed.
+  static constexpr std::size_t num_inline_users = 8;
+  using user_list_t = common::small_vector<data_user, num_inline_users>;
 public:
-  using user_iterator = std::vector<data_user>::iterator;
-  using const_user_iterator = std::vector<data_user>::const_iterator;
+  using user_iterator = user_list_t::iterator;
+  using const_user_iterator = user_list_t::const_iterator;
 
   data_user_tracker() = default;
   data_user_tracker(const data_user_tracker& other);
@@ -237,6 +165,13 @@ public:
 
   void release_dead_users();
 
+  /// Mutex that the dag_builder holds while it determines conflicting
+  /// users and registers new users. This allows command groups operating
+  /// on different data to be added to the DAG concurrently.
+  std::mutex& get_dependency_analysis_mutex() const {
+    return _dependency_analysis_lock;
+  }
+
   template<class Predicate>
   void add_user(dag_node_ptr user, 
                 sycl::access::mode mode, 
@@ -246,16 +181,33 @@ public:
                 Predicate replaces_user) {
     std::lock_guard<std::mutex> lock{_lock};
 
-    _users.erase(std::remove_if(_users.begin(), _users.end(), replaces_user), 
-      _users.end());
+    // Once the inline storage is exhausted, completed users are dropped in
+    // bulk as part of the same pass, so that the list does not grow with
+    // the number of submissions between calls to release_dead_users().
+    const bool prune_completed = _users.size() >= num_inline_users;
+    _users.erase(std::remove_if(_users.begin(), _users.end(),
+                                [&](const data_user &u) -> bool {
+                                  if(prune_completed && is_dead_user(u))
+                                    return true;
+                                  return replaces_user(u);
+                                }),
+                 _users.end());
 
     _users.push_back(
       data_user{std::weak_ptr<dag_node>(user), mode, target, offset, range});
   }
 
 private:
-  std::vector<data_user> _users;
+  static bool is_dead_user(const data_user& user) {
+    auto u = user.user.lock();
+    if (!u)
+      return true;
+    return u->is_known_complete();
+  }
+
+  user_list_t _users;
   mutable std::mutex _lock;
+  mutable std::mutex _dependency_analysis_lock;
 };
 
 template <class Memory_descriptor>
@@ -269,6 +221,23 @@ struct data_allocation {
   range_store invalid_pages;
   bool is_owned;
   backend_allocator* managing_allocator;
+  /// If true, only the elements of invalid pages within outdated_elements
+  /// differ from the most recent data, because the allocation was entirely
+  /// valid before these elements were written elsewhere. Otherwise, all
+  /// elements of invalid pages must be considered outdated.
+  bool tracks_outdated_elements = false;
+  /// Disjoint element ranges that may have been written elsewhere
+  std::vector<range_store::rect> outdated_elements = {};
+  /// Version of the data region at which all pages of this allocation were
+  /// known to be valid, or 0. As long as the data region has not been
+  /// written since, page table queries and updates can be skipped.
+  uint64_t validated_version = 0;
+  /// Transfers into this allocation that may not have completed yet.
+  /// Transfers from this allocation need to wait for them.
+  std::vector<std::weak_ptr<dag_node>> pending_updates = {};
+  std::chrono::steady_clock::time_point estimated_update_completion = {};
+  /// Transfers from this allocation that may not have completed yet
+  std::vector<std::weak_ptr<dag_node>> pending_reads = {};
 };
 
 template <class Memory_descriptor> class allocation_list {
@@ -332,6 +301,24 @@ public:
   bool has_match(UnaryPredicate &&selector) const {
     return select_and_handle(selector, [](const auto&){});
   }
+
+  /// Removes the first allocation matching the selector, and passes it
+  /// to \c h after the lock has been released.
+  template <class UnaryPredicate, class Handler>
+  bool remove_and_handle(UnaryPredicate &&selector, Handler &&h) {
+    std::optional<data_allocation<Memory_descriptor>> removed;
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto it = std::find_if(_allocations.begin(), _allocations.end(),
+                             selector);
+      if(it == _allocations.end())
+        return false;
+      removed.emplace(std::move(*it));
+      _allocations.erase(it);
+    }
+    h(*removed);
+    return true;
+  }
 private:
   std::vector<data_allocation<Memory_descriptor>> _allocations;
   mutable std::mutex _mutex;
@@ -469,6 +456,21 @@ public:
                                                     allocator);
   }
 
+  /// Removes the allocation on the given device, and frees it if it is
+  /// owned. The caller must ensure that the allocation is no longer used
+  /// and that its data is not needed anymore, or up-to-date elsewhere.
+  bool remove_allocation(const device_id &d) {
+    return _allocations.remove_and_handle(
+        default_allocation_selector{d}, [](auto &alloc) {
+          if(alloc.memory && alloc.is_owned && alloc.managing_allocator) {
+            HIPSYCL_DEBUG_INFO << "data_region::remove_allocation: Freeing "
+                                  "allocation "
+                               << alloc.memory << std::endl;
+            alloc.managing_allocator->free(alloc.memory);
+          }
+        });
+  }
+
   /// Converts an offset into the data buffer (in element numbers) and the
   /// data length (in element numbers) into an equivalent \c page_range.
   page_range get_page_range(id<3> data_offset, range<3> data_range) const {
@@ -501,9 +503,13 @@ public:
 
     assert(has_allocation(d));
 
+    const uint64_t version = _version.load(std::memory_order_acquire);
     _allocations.select_and_handle(default_allocation_selector{d},
                                    [&](auto &alloc) {
-      alloc.invalid_pages.remove(pr);              
+      if(alloc.validated_version == version)
+        return;
+      alloc.invalid_pages.remove(pr);
+      update_outdated_elements_after_update(alloc, pr, version);
     });
   }
   
@@ -516,11 +522,24 @@ public:
 
     default_allocation_selector argument_match{d};
 
+    const uint64_t previous_version =
+        _version.fetch_add(1, std::memory_order_acq_rel);
+    const uint64_t version = previous_version + 1;
     _allocations.for_each_allocation_while([&](auto &alloc) {
       if (argument_match(alloc)) {
+        if(alloc.validated_version == previous_version) {
+          // Was entirely valid before, and remains so
+          alloc.validated_version = version;
+          return true;
+        }
         alloc.invalid_pages.remove(pr);
+        update_outdated_elements_after_update(alloc, pr, version);
       } else {
+        alloc.validated_version = 0;
         alloc.invalid_pages.add(pr);
+        if(alloc.tracks_outdated_elements)
+          add_outdated_elements(alloc,
+                                std::make_pair(data_offset, data_size));
       }
       return true;
     });
@@ -539,10 +558,20 @@ public:
     range<3> num_pages = pr.second;
 
     // Find outdated regions among pages
+    std::vector<range_store::rect> outdated_elements;
+    bool tracks_outdated_elements = false;
+    const uint64_t version = _version.load(std::memory_order_acquire);
     [[maybe_unused]] bool was_found = _allocations.select_and_handle(
         default_allocation_selector{d}, [&](auto &alloc) {
+          if(alloc.validated_version == version) {
+            out.clear();
+            return;
+          }
           alloc.invalid_pages.intersections_with(
               std::make_pair(first_page, num_pages), out);
+          tracks_outdated_elements = alloc.tracks_outdated_elements;
+          if(tracks_outdated_elements && !out.empty())
+            outdated_elements = alloc.outdated_elements;
         });
     
     assert(was_found);
@@ -565,6 +594,20 @@ public:
         assert(r.first[i]+r.second[i] <= _num_elements[i]);
       }
     }
+
+    // Within the invalid pages, only elements that have been written
+    // elsewhere need to be updated.
+    if(tracks_outdated_elements) {
+      std::vector<range_store::rect> outdated_pages = std::move(out);
+      out.clear();
+      for(const range_store::rect& page_rect : outdated_pages) {
+        for(const range_store::rect& r : outdated_elements) {
+          range_store::rect intersection;
+          if(intersect(page_rect, r, intersection))
+            out.push_back(intersection);
+        }
+      }
+    }
   }
 
   void get_update_source_candidates(
@@ -593,6 +636,53 @@ public:
     }
   }
 
+  struct pending_transfer_state {
+    /// Transfers into the allocation that have not completed yet
+    node_list_t updates;
+    std::chrono::steady_clock::time_point estimated_update_completion;
+    /// Number of transfers from the allocation that have not completed yet
+    std::size_t num_reads = 0;
+  };
+
+  /// Returns the transfers from and to the allocation on the given device
+  /// that are still in progress.
+  pending_transfer_state get_pending_transfers(const device_id &d) {
+    pending_transfer_state state;
+    _allocations.select_and_handle(default_allocation_selector{d},
+                                   [&](auto &alloc) {
+      prune_completed_transfers(alloc.pending_updates);
+      prune_completed_transfers(alloc.pending_reads);
+      for(const auto& weak_node : alloc.pending_updates)
+        if(auto node = weak_node.lock())
+          state.updates.push_back(node);
+      state.estimated_update_completion = alloc.estimated_update_completion;
+      state.num_reads = alloc.pending_reads.size();
+    });
+    return state;
+  }
+
+  /// Registers a transfer into the allocation on the given device
+  void add_pending_update(
+      const device_id &d, const dag_node_ptr &node,
+      std::chrono::steady_clock::time_point estimated_completion) {
+    _allocations.select_and_handle(default_allocation_selector{d},
+                                   [&](auto &alloc) {
+      prune_completed_transfers(alloc.pending_updates);
+      alloc.pending_updates.push_back(node);
+      alloc.estimated_update_completion =
+          std::max(alloc.estimated_update_completion, estimated_completion);
+    });
+  }
+
+  /// Registers a transfer from the allocation on the given device
+  void add_pending_read(const device_id &d, const dag_node_ptr &node) {
+    _allocations.select_and_handle(default_allocation_selector{d},
+                                   [&](auto &alloc) {
+      prune_completed_transfers(alloc.pending_reads);
+      alloc.pending_reads.push_back(node);
+    });
+  }
+
   data_user_tracker& get_users()
   { return _user_tracker; }
 
@@ -601,6 +691,8 @@ public:
 
   std::size_t get_element_size() const { return _element_size; }
 
+  range<3> get_page_size() const { return _page_size; }
+
   range<3> get_num_elements() const { return _num_elements; }
 
   Memory_descriptor get_memory(device_id dev) const
@@ -676,6 +768,102 @@ public:
   }
 
 private:
+  static void
+  prune_completed_transfers(std::vector<std::weak_ptr<dag_node>> &transfers) {
+    transfers.erase(std::remove_if(transfers.begin(), transfers.end(),
+                                   [](const std::weak_ptr<dag_node> &weak_node) {
+                                     auto node = weak_node.lock();
+                                     return !node || node->is_complete();
+                                   }),
+                    transfers.end());
+  }
+
+  // Above this number of outdated element ranges, they are merged into
+  // their bounding box.
+  static constexpr std::size_t max_num_outdated_element_ranges = 16;
+
+  static bool intersect(const range_store::rect &a, const range_store::rect &b,
+                        range_store::rect &out) {
+    for(int i = 0; i < 3; ++i) {
+      std::size_t begin = std::max(a.first[i], b.first[i]);
+      std::size_t end = std::min(a.first[i] + a.second[i],
+                                 b.first[i] + b.second[i]);
+      if(begin >= end)
+        return false;
+      out.first[i] = begin;
+      out.second[i] = end - begin;
+    }
+    return true;
+  }
+
+  static range_store::rect bounding_box(const range_store::rect &a,
+                                        const range_store::rect &b) {
+    range_store::rect result;
+    for(int i = 0; i < 3; ++i) {
+      std::size_t begin = std::min(a.first[i], b.first[i]);
+      std::size_t end = std::max(a.first[i] + a.second[i],
+                                 b.first[i] + b.second[i]);
+      result.first[i] = begin;
+      result.second[i] = end - begin;
+    }
+    return result;
+  }
+
+  static void add_outdated_elements(data_allocation<Memory_descriptor> &alloc,
+                                    range_store::rect r) {
+    auto &ranges = alloc.outdated_elements;
+    // Keep ranges disjoint, such that no element is transferred twice
+    for(std::size_t i = 0; i < ranges.size();) {
+      range_store::rect intersection;
+      if(intersect(ranges[i], r, intersection)) {
+        r = bounding_box(ranges[i], r);
+        ranges.erase(ranges.begin() + i);
+        i = 0;
+      } else {
+        ++i;
+      }
+    }
+    ranges.push_back(r);
+
+    if(ranges.size() > max_num_outdated_element_ranges) {
+      range_store::rect box = ranges[0];
+      for(const auto& range : ranges)
+        box = bounding_box(box, range);
+      ranges.clear();
+      ranges.push_back(box);
+    }
+  }
+
+  // Must be invoked after the pages pr of alloc have been marked as valid
+  void update_outdated_elements_after_update(
+      data_allocation<Memory_descriptor> &alloc, const page_range &pr,
+      uint64_t version) const {
+    if(alloc.invalid_pages.entire_range_empty(
+           std::make_pair(id<3>{0, 0, 0}, _num_pages))) {
+      // Once all pages are valid, element ranges can be tracked precisely
+      alloc.tracks_outdated_elements = true;
+      alloc.outdated_elements.clear();
+      alloc.validated_version = version;
+      return;
+    }
+    if(!alloc.tracks_outdated_elements)
+      return;
+    // Element ranges that are entirely within valid pages are no longer
+    // outdated
+    range_store::rect updated_elements;
+    for(int i = 0; i < 3; ++i) {
+      updated_elements.first[i] = pr.first[i] * _page_size[i];
+      updated_elements.second[i] = pr.second[i] * _page_size[i];
+    }
+    auto &ranges = alloc.outdated_elements;
+    ranges.erase(std::remove_if(ranges.begin(), ranges.end(),
+                                [&](const range_store::rect &r) {
+                                  return bounding_box(r, updated_elements) ==
+                                         updated_elements;
+                                }),
+                 ranges.end());
+  }
+
   std::size_t _element_size;
 
   allocation_list<Memory_descriptor> _allocations;
@@ -699,6 +887,8 @@ private:
       new_alloc.invalid_pages.add(std::make_pair(id<3>{0, 0, 0}, _num_pages));
     } else {
       new_alloc.invalid_pages.remove(std::make_pair(id<3>{0, 0, 0}, _num_pages));
+      new_alloc.tracks_outdated_elements = true;
+      new_alloc.validated_version = _version.load(std::memory_order_acquire);
     }
 
     [[maybe_unused]] bool was_inserted = _allocations.add_if_unique(
@@ -714,12 +904,25 @@ private:
   range<3> _page_size;
   range<3> _num_pages;
   range<3> _num_elements;
+  // Incremented whenever data is written, starts at 1 such that
+  // a validated_version of 0 never matches.
+  std::atomic<uint64_t> _version{1};
 
   data_user_tracker _user_tracker;
 };
 
 using buffer_data_region = data_region<void*>;
 
+/// Determines the page size for a data region without explicitly set page
+/// size. If min_page_bytes is 0, ACPP_RT_BUFFER_MIN_PAGE_SIZE is used.
+/// Regions that are at least twice as large as the minimum page size are
+/// divided along their slowest-varying dimension with more than one
+/// element, such that each page is a contiguous slab of at least
+/// min_page_bytes. Otherwise, the entire region is a single page.
+range<3> get_adaptive_page_size(range<3> num_elements,
+                                std::size_t element_size,
+                                std::size_t min_page_bytes = 0);
+
 
 
 }
@@ -24,7 +24,8 @@ enum class hardware_platform
   cuda,
   level_zero,
   ocl,
-  cpu
+  cpu,
+  remote
 };
 
 enum class api_platform {
@@ -32,7 +33,8 @@ enum class api_platform {
   hip,
   level_zero,
   ocl,
-  omp
+  omp,
+  remote
 };
 
 enum class backend_id {
@@ -40,7 +42,8 @@ enum class backend_id {
   hip,
   level_zero,
   ocl,
-  omp
+  omp,
+  remote
 };
 
 struct backend_descriptor
@@ -66,6 +69,9 @@ struct backend_descriptor
       id = backend_id::level_zero;
     else if (hw_plat == hardware_platform::ocl && sw_plat == api_platform::ocl)
       id = backend_id::ocl;
+    else if (hw_plat == hardware_platform::remote &&
+             sw_plat == api_platform::remote)
+      id = backend_id::remote;
     else
       assert(false && "Invalid combination of hardware/software platform for "
                       "backend descriptor.");
@@ -11,9 +11,16 @@
 #ifndef HIPSYCL_EVENT_POOL_HPP
 #define HIPSYCL_EVENT_POOL_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
 #include <vector>
 #include <mutex>
 #include "error.hpp"
+#include "generic/async_worker.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -22,46 +29,218 @@ namespace rt {
 // - define event_type for native backend type
 // - define method to construct event: result create(event_type&)
 // - define method to destroy event: result destroy(event_type)
+//
+// Events are cached per thread in magazines of up to magazine_size events,
+// such that obtaining and releasing events usually does not require
+// synchronization. Full magazines are exchanged with other threads through
+// a shared depot. When the depot runs empty, a batch of events is created
+// in the background.
 template<class BackendEventFactory>
 class event_pool {
 public:
   using event_type = typename BackendEventFactory::event_type;
 
   event_pool(const BackendEventFactory& event_factory)
-      : _event_factory{event_factory} {}
+      : _depot{std::make_shared<depot>(event_factory)},
+        _id{get_next_pool_id()} {}
 
   ~event_pool() {
-    for(event_type& evt : _available_events) {
-      auto err = _event_factory.destroy(evt);
-      if(!err.is_success()) {
-        register_error(err);
+    if(_refill_worker)
+      _refill_worker->wait();
+    _refill_worker.reset();
+
+    // Events that are still cached by other threads are leaked, since the
+    // backend might no longer be usable when these threads exit.
+    std::lock_guard<std::mutex> lock{_depot->mutex};
+    _depot->is_closed = true;
+    _depot->full_magazines.push_back(std::move(_depot->loose_events));
+    for(magazine& m : _depot->full_magazines) {
+      for(event_type& evt : m) {
+        auto err = _depot->event_factory.destroy(evt);
+        if(!err.is_success()) {
+          register_error(err);
+        }
       }
     }
+    _depot->full_magazines.clear();
   }
 
   // Obtain event from pool. Obtained event
   // must be returned to the pool using release_event()
   // when it is no longer needed.
   result obtain_event(event_type& out) {
-    std::lock_guard<std::mutex> lock {_mutex};
-    if(!_available_events.empty()) {
-      out = _available_events.back();
-      _available_events.pop_back();
-      return make_success();
+    thread_cache* cache = get_thread_cache();
+    if(!cache) {
+      std::lock_guard<std::mutex> lock{_depot->mutex};
+      if(!_depot->loose_events.empty()) {
+        out = _depot->loose_events.back();
+        _depot->loose_events.pop_back();
+        return make_success();
+      }
+    } else {
+      if(cache->loaded.empty()) {
+        std::swap(cache->loaded, cache->previous);
+        if(cache->loaded.empty())
+          refill(cache->loaded);
+      }
+      if(!cache->loaded.empty()) {
+        out = cache->loaded.back();
+        cache->loaded.pop_back();
+        return make_success();
+      }
     }
-    return _event_factory.create(out);
+    return _depot->event_factory.create(out);
   }
 
   // Return event to pool.
   void release_event(event_type evt) {
-    std::lock_guard<std::mutex> lock {_mutex};
-    _available_events.push_back(evt);
+    thread_cache* cache = get_thread_cache();
+    if(!cache) {
+      std::lock_guard<std::mutex> lock{_depot->mutex};
+      _depot->loose_events.push_back(evt);
+      return;
+    }
+
+    if(cache->loaded.size() >= magazine_size) {
+      if(!cache->previous.empty()) {
+        std::lock_guard<std::mutex> lock{_depot->mutex};
+        _depot->full_magazines.push_back(std::move(cache->previous));
+        cache->previous = magazine{};
+      }
+      std::swap(cache->loaded, cache->previous);
+    }
+    if(cache->loaded.capacity() < magazine_size)
+      cache->loaded.reserve(magazine_size);
+    cache->loaded.push_back(evt);
   }
 
 private:
-  BackendEventFactory _event_factory;
-  std::vector<event_type> _available_events;
-  std::mutex _mutex;
+  static constexpr std::size_t magazine_size = 32;
+
+  using magazine = std::vector<event_type>;
+
+  struct depot {
+    depot(const BackendEventFactory& factory)
+    : event_factory{factory} {}
+
+    BackendEventFactory event_factory;
+    std::mutex mutex;
+    std::vector<magazine> full_magazines;
+    // Events released or obtained by threads whose caches have already
+    // been destroyed
+    magazine loose_events;
+    bool is_refill_pending = false;
+    bool is_closed = false;
+  };
+
+  struct thread_cache {
+    uint64_t pool_id;
+    std::shared_ptr<depot> owner;
+    magazine loaded;
+    magazine previous;
+  };
+
+  // The magazines of one thread for all pools of this backend. Returns
+  // the magazines to the depots when the thread exits.
+  struct thread_caches {
+    std::vector<thread_cache> caches;
+
+    ~thread_caches() {
+      for(thread_cache& c : caches) {
+        std::lock_guard<std::mutex> lock{c.owner->mutex};
+        if(c.owner->is_closed)
+          continue;
+        for(magazine* m : {&c.loaded, &c.previous})
+          if(!m->empty())
+            c.owner->full_magazines.push_back(std::move(*m));
+      }
+      is_destroyed() = true;
+    }
+
+    // Trivially destructible, such that it can still be queried while
+    // thread_local objects are destroyed.
+    static bool& is_destroyed() {
+      static thread_local bool destroyed = false;
+      return destroyed;
+    }
+  };
+
+  thread_cache* get_thread_cache() {
+    if(thread_caches::is_destroyed())
+      return nullptr;
+
+    static thread_local thread_caches tls;
+    for(thread_cache& c : tls.caches)
+      if(c.pool_id == _id)
+        return &c;
+
+    // Caches of destroyed pools only hold leaked events
+    for(std::size_t i = 0; i < tls.caches.size();) {
+      bool is_closed;
+      {
+        std::lock_guard<std::mutex> lock{tls.caches[i].owner->mutex};
+        is_closed = tls.caches[i].owner->is_closed;
+      }
+      if(is_closed) {
+        tls.caches[i] = std::move(tls.caches.back());
+        tls.caches.pop_back();
+      } else {
+        ++i;
+      }
+    }
+    tls.caches.push_back(thread_cache{_id, _depot, magazine{}, magazine{}});
+    return &tls.caches.back();
+  }
+
+  // Takes a full magazine from the depot, and creates new events in the
+  // background when the depot is about to run empty.
+  void refill(magazine& out) {
+    bool schedule_refill = false;
+    {
+      std::lock_guard<std::mutex> lock{_depot->mutex};
+      if(!_depot->full_magazines.empty()) {
+        out = std::move(_depot->full_magazines.back());
+        _depot->full_magazines.pop_back();
+      }
+      if(_depot->full_magazines.empty() && !_depot->is_refill_pending) {
+        _depot->is_refill_pending = true;
+        schedule_refill = true;
+        if(!_refill_worker)
+          _refill_worker = std::make_unique<worker_thread>();
+      }
+    }
+
+    if(schedule_refill) {
+      (*_refill_worker)([d = _depot]() {
+        magazine m;
+        m.reserve(magazine_size);
+        for(std::size_t i = 0; i < magazine_size; ++i) {
+          event_type evt;
+          auto err = d->event_factory.create(evt);
+          if(!err.is_success()) {
+            register_error(err);
+            break;
+          }
+          m.push_back(evt);
+        }
+
+        std::lock_guard<std::mutex> lock{d->mutex};
+        if(!m.empty())
+          d->full_magazines.push_back(std::move(m));
+        d->is_refill_pending = false;
+      });
+    }
+  }
+
+  static uint64_t get_next_pool_id() {
+    static std::atomic<uint64_t> next_id = 0;
+    return next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::shared_ptr<depot> _depot;
+  uint64_t _id;
+  // Only created once events need to be created in the background
+  std::unique_ptr<worker_thread> _refill_worker;
 };
 
 }
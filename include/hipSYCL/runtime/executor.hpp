@@ -15,6 +15,7 @@
 #include "device_id.hpp"
 #include "operations.hpp"
 #include "hints.hpp"
+#include "error.hpp"
 
 
 namespace hipsycl {
@@ -42,6 +43,20 @@ public:
   virtual bool can_execute_on_device(const device_id& dev) const = 0;
   virtual bool is_submitted_by_me(const dag_node_ptr& node) const = 0;
 
+  /// Enqueues callback(user_data) to be invoked on a host thread once the
+  /// submitted node has completed, using the completion notification
+  /// mechanisms of the backend. The callback must not invoke backend API
+  /// functions. Returns an error of type feature_not_supported if this is
+  /// not possible for the node.
+  virtual result register_completion_callback(const dag_node_ptr &node,
+                                              void (*callback)(void *),
+                                              void *user_data) {
+    return make_error(
+        __acpp_here(),
+        error_info{"backend_executor: Completion callbacks are not supported",
+                   error_type::feature_not_supported});
+  }
+
   virtual ~backend_executor(){}
 };
 
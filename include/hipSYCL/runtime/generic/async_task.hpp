@@ -0,0 +1,119 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_ASYNC_TASK_HPP
+#define HIPSYCL_ASYNC_TASK_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hipsycl {
+namespace rt {
+
+/// Move-only, type-erased void() callable. Callables that fit into
+/// small_buffer_size bytes and are nothrow move constructible are
+/// stored inline, such that constructing and moving tasks does not
+/// allocate.
+class async_task {
+public:
+  static constexpr std::size_t small_buffer_size = 48;
+
+  async_task() noexcept : _ops{nullptr} {}
+
+  template <class F, class Fd = std::decay_t<F>,
+            std::enable_if_t<!std::is_same_v<Fd, async_task>, int> = 0>
+  async_task(F &&f) : _ops{&get_ops<Fd>()} {
+    if constexpr (is_stored_inline<Fd>())
+      new (&_storage) Fd(std::forward<F>(f));
+    else
+      new (&_storage) Fd*(new Fd(std::forward<F>(f)));
+  }
+
+  async_task(const async_task &) = delete;
+  async_task &operator=(const async_task &) = delete;
+
+  async_task(async_task &&other) noexcept : _ops{other._ops} {
+    if(_ops) {
+      _ops->move(&_storage, &other._storage);
+      other._ops = nullptr;
+    }
+  }
+
+  async_task &operator=(async_task &&other) noexcept {
+    if(this != &other) {
+      reset();
+      _ops = other._ops;
+      if(_ops) {
+        _ops->move(&_storage, &other._storage);
+        other._ops = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  ~async_task() { reset(); }
+
+  void operator()() { _ops->invoke(&_storage); }
+
+  explicit operator bool() const noexcept { return _ops != nullptr; }
+
+  void reset() noexcept {
+    if(_ops) {
+      _ops->destroy(&_storage);
+      _ops = nullptr;
+    }
+  }
+
+private:
+  struct operations {
+    void (*invoke)(void *);
+    // Move-constructs into dest and destroys source
+    void (*move)(void *dest, void *source) noexcept;
+    void (*destroy)(void *) noexcept;
+  };
+
+  template <class F> static constexpr bool is_stored_inline() {
+    return sizeof(F) <= small_buffer_size &&
+           alignof(F) <= alignof(std::max_align_t) &&
+           std::is_nothrow_move_constructible_v<F>;
+  }
+
+  template <class F> static const operations &get_ops() {
+    if constexpr (is_stored_inline<F>()) {
+      static const operations ops{
+          [](void *s) { (*static_cast<F *>(s))(); },
+          [](void *dest, void *source) noexcept {
+            F *f = static_cast<F *>(source);
+            new (dest) F(std::move(*f));
+            f->~F();
+          },
+          [](void *s) noexcept { static_cast<F *>(s)->~F(); }};
+      return ops;
+    } else {
+      static const operations ops{
+          [](void *s) { (**static_cast<F **>(s))(); },
+          [](void *dest, void *source) noexcept {
+            new (dest) F *(*static_cast<F **>(source));
+          },
+          [](void *s) noexcept { delete *static_cast<F **>(s); }};
+      return ops;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char _storage[small_buffer_size];
+  const operations *_ops;
+};
+
+}
+}
+
+#endif
@@ -15,18 +15,24 @@
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
-#include <functional>
-#include <queue>
+
+#include "async_task.hpp"
+#include "mpsc_queue.hpp"
 
 
 namespace hipsycl {
 namespace rt {
 
 /// A worker thread that processes a queue in the background.
+///
+/// Operations are enqueued into a lock-free queue. When running out of work,
+/// the worker thread (as well as threads waiting for the queue to drain)
+/// first spins for a short while before going to sleep, so that
+/// submitting many small operations does not pay for a wake-up each time.
 class worker_thread
 {
 public:
-  using async_function = std::function<void ()>;
+  using async_function = async_task;
 
   /// Construct object
   worker_thread();
@@ -44,7 +50,8 @@ public:
   /// \param f The function to enqueue for execution
   void operator()(async_function f);
 
-  /// \return The number of enqueued operations
+  /// \return The number of enqueued operations that have not yet
+  /// completed, including the currently running operation.
   std::size_t queue_size() const;
 
   /// Stop the worker thread
@@ -60,10 +67,16 @@ private:
 
   std::atomic<bool> _continue;
 
-  std::condition_variable _condition_wait;
-  mutable std::mutex _mutex;
+  mpsc_queue<async_function> _enqueued_operations;
+  // Number of enqueued operations that have not yet completed
+  std::atomic<std::size_t> _num_pending_operations;
 
-  std::queue<async_function> _enqueued_operations;
+  // Only used to park the worker thread or waiting threads
+  std::atomic<bool> _is_worker_parked;
+  std::atomic<int> _num_parked_waiters;
+  std::condition_variable _condition_work;
+  std::condition_variable _condition_idle;
+  std::mutex _mutex;
 };
 
 }
@@ -0,0 +1,153 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_DEVICE_TIMESTAMP_BUFFER_HPP
+#define HIPSYCL_DEVICE_TIMESTAMP_BUFFER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/instrumentation.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// A ring buffer in host memory into which devices write the values of
+/// their clock (in nanoseconds) as part of the operation stream. Device
+/// timestamps are only related to host time when they are read, using a
+/// single reference point pair measured when the buffer is set up.
+///
+/// Slots are reused after all other slots have been allocated, so
+/// timestamps must be read before the buffer wraps around.
+class device_timestamp_buffer {
+public:
+  struct slot {
+    std::size_t index;
+    uint64_t generation;
+  };
+
+  /// \param host_ptr Host-accessible memory for \c num_slots timestamps which
+  /// the device can write to. Not owned by the buffer.
+  device_timestamp_buffer(volatile uint64_t *host_ptr, std::size_t num_slots)
+      : _timestamps{host_ptr}, _num_slots{num_slots},
+        _generations{new std::atomic<uint64_t>[num_slots]} {
+    for(std::size_t i = 0; i < num_slots; ++i) {
+      _timestamps[i] = 0;
+      _generations[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// Allocates the slot for the next timestamp. The device must then write
+  /// its timestamp to element s.index of the memory.
+  slot allocate() {
+    uint64_t ticket = _next_ticket.fetch_add(1, std::memory_order_relaxed);
+    slot s{static_cast<std::size_t>(ticket % _num_slots),
+           ticket / _num_slots + 1};
+    // 0 marks a timestamp that has not yet been written
+    _timestamps[s.index] = 0;
+    _generations[s.index].store(s.generation, std::memory_order_release);
+    return s;
+  }
+
+  /// Waits until the device has written the timestamp of the slot.
+  /// Returns false if the slot has already been reused.
+  bool wait(const slot &s) const {
+    while(is_current(s)) {
+      if(_timestamps[s.index] != 0)
+        return true;
+      std::this_thread::yield();
+    }
+    return false;
+  }
+
+  /// Returns the timestamp of the slot in device time, waiting for it if
+  /// necessary, or an empty optional if the slot has already been reused.
+  std::optional<uint64_t> read(const slot &s) const {
+    if(!wait(s))
+      return {};
+    uint64_t value = _timestamps[s.index];
+    // The slot could have been reused while reading
+    if(!is_current(s))
+      return {};
+    return value;
+  }
+
+  /// Sets the pair of device timestamp and host time that device timestamps
+  /// are related to.
+  void set_reference(uint64_t device_time, profiler_clock::time_point host_time) {
+    _device_reference = device_time;
+    _host_reference = host_time;
+  }
+
+  profiler_clock::time_point to_host_time(uint64_t device_time) const {
+    if(device_time >= _device_reference)
+      return _host_reference +
+             profiler_clock::duration{device_time - _device_reference};
+    return _host_reference -
+           profiler_clock::duration{_device_reference - device_time};
+  }
+
+  std::size_t get_num_slots() const { return _num_slots; }
+
+private:
+  bool is_current(const slot &s) const {
+    return _generations[s.index].load(std::memory_order_acquire) ==
+           s.generation;
+  }
+
+  volatile uint64_t *_timestamps;
+  std::size_t _num_slots;
+  std::unique_ptr<std::atomic<uint64_t>[]> _generations;
+  std::atomic<uint64_t> _next_ticket = 0;
+
+  uint64_t _device_reference = 0;
+  profiler_clock::time_point _host_reference;
+};
+
+/// An instrumentation whose timestamp was written by the device into a
+/// device_timestamp_buffer.
+template <class InstrumentationType>
+class device_timestamp_instrumentation : public InstrumentationType {
+public:
+  device_timestamp_instrumentation(
+      std::shared_ptr<device_timestamp_buffer> buffer,
+      device_timestamp_buffer::slot s)
+      : _buffer{buffer}, _slot{s} {}
+
+  virtual profiler_clock::time_point get_time_point() const override {
+    auto device_time = _buffer->read(_slot);
+    if(!device_time) {
+      register_error(
+          __acpp_here(),
+          error_info{"device_timestamp_instrumentation: Timestamp was "
+                     "overwritten before it was queried; too many timestamps "
+                     "were recorded in the meantime"});
+      return profiler_clock::time_point{};
+    }
+    return _buffer->to_host_time(*device_time);
+  }
+
+  virtual void wait() const override {
+    _buffer->wait(_slot);
+  }
+
+private:
+  std::shared_ptr<device_timestamp_buffer> _buffer;
+  device_timestamp_buffer::slot _slot;
+};
+
+}
+}
+
+#endif
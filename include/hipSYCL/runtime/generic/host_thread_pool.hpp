@@ -0,0 +1,112 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_HOST_THREAD_POOL_HPP
+#define HIPSYCL_HOST_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// Process-wide work-stealing thread pool for data-parallel host work.
+///
+/// parallel_for() splits an iteration space into chunks that are distributed
+/// across per-worker deques. Idle workers steal chunks from other workers,
+/// so that chunks of independent parallel_for() invocations, e.g. from
+/// different host queues, are executed concurrently by the same threads.
+/// The calling thread participates in the execution until all of its
+/// chunks have completed. If the iteration space only consists
+/// of a single chunk, it is executed directly by the calling thread.
+class host_thread_pool {
+public:
+  using chunk_function = void (*)(void *data, std::size_t begin,
+                                  std::size_t end);
+
+  /// Returns the process-wide pool. Its size is determined by the
+  /// \c host_thread_pool_size setting.
+  static host_thread_pool &get();
+
+  /// Creates a pool with \c num_workers worker threads in addition
+  /// to calling threads.
+  explicit host_thread_pool(std::size_t num_workers);
+  ~host_thread_pool();
+
+  host_thread_pool(const host_thread_pool &) = delete;
+  host_thread_pool &operator=(const host_thread_pool &) = delete;
+
+  /// Number of threads that execute chunks, including the calling thread.
+  std::size_t get_num_threads() const { return _workers.size() + 1; }
+
+  /// Invokes f(data, begin, end) for consecutive chunks of at most
+  /// \c chunk_size elements covering [0, n), and returns once all
+  /// chunks have completed.
+  void parallel_for(std::size_t n, std::size_t chunk_size, chunk_function f,
+                    void *data);
+
+  /// Invokes f(begin, end) for chunks of [0, n).
+  template <class F>
+  void parallel_for(std::size_t n, std::size_t chunk_size, F &&f) {
+    parallel_for(
+        n, chunk_size,
+        [](void *data, std::size_t begin, std::size_t end) {
+          (*static_cast<std::remove_reference_t<F> *>(data))(begin, end);
+        },
+        static_cast<void *>(&f));
+  }
+
+private:
+  struct job {
+    chunk_function f;
+    void *data;
+    std::atomic<std::size_t> num_remaining_chunks;
+  };
+
+  struct chunk {
+    job *parent;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  struct alignas(64) chunk_deque {
+    std::mutex mutex;
+    std::deque<chunk> chunks;
+  };
+
+  // Pops from the front of the deque of the given worker, or steals
+  // from the back of other deques.
+  bool try_obtain_chunk(std::size_t preferred_deque, chunk &out);
+  void run_chunk(const chunk &c);
+  void work(std::size_t worker_id);
+
+  std::vector<std::unique_ptr<chunk_deque>> _deques;
+  std::vector<std::thread> _workers;
+
+  std::atomic<std::size_t> _num_queued_chunks;
+  std::atomic<std::size_t> _next_submission_deque;
+
+  std::atomic<bool> _continue;
+  std::atomic<int> _num_parked_workers;
+  std::mutex _mutex;
+  std::condition_variable _condition_work;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_MPSC_QUEUE_HPP
+#define HIPSYCL_MPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace hipsycl {
+namespace rt {
+
+/// Multi-producer single-consumer FIFO queue. Elements are stored in a
+/// lock-free bounded ring buffer (Vyukov's bounded queue), so that push()
+/// and pop() do not lock or allocate in the common case. If the ring buffer
+/// is full, elements are appended to a mutex-protected overflow list instead.
+/// While the overflow list is non-empty, new elements are appended to it as
+/// well, such that the order of elements from each producer is retained.
+///
+/// Only a single thread may call pop() at a time.
+template <class T, std::size_t Capacity = 512> class mpsc_queue {
+  static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 0,
+                "Capacity must be a power of two");
+public:
+  mpsc_queue() : _tail{0}, _head{0}, _has_overflow{false} {
+    for(std::size_t i = 0; i < Capacity; ++i)
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  mpsc_queue(const mpsc_queue &) = delete;
+  mpsc_queue &operator=(const mpsc_queue &) = delete;
+
+  ~mpsc_queue() {
+    T element;
+    while(pop(element))
+      ;
+  }
+
+  void push(T &&element) {
+    if (!_has_overflow.load(std::memory_order_acquire) &&
+        try_push_ring(element))
+      return;
+
+    std::lock_guard<std::mutex> lock{_overflow_mutex};
+    _overflow.push_back(std::move(element));
+    _has_overflow.store(true, std::memory_order_release);
+  }
+
+  /// Returns false if no element is available.
+  bool pop(T &out) {
+    if(try_pop_ring(out))
+      return true;
+
+    if(_has_overflow.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lock{_overflow_mutex};
+      if(!_overflow.empty()) {
+        out = std::move(_overflow.front());
+        _overflow.pop_front();
+        if(_overflow.empty())
+          _has_overflow.store(false, std::memory_order_release);
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  static constexpr std::size_t mask = Capacity - 1;
+
+  bool try_push_ring(T &element) {
+    std::size_t pos = _tail.load(std::memory_order_relaxed);
+    for(;;) {
+      slot &s = _slots[pos & mask];
+      std::size_t seq = s.sequence.load(std::memory_order_acquire);
+      std::intptr_t diff =
+          static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+      if(diff == 0) {
+        if (_tail.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed))
+          break;
+      } else if(diff < 0) {
+        // Ring buffer is full
+        return false;
+      } else {
+        pos = _tail.load(std::memory_order_relaxed);
+      }
+    }
+    slot &s = _slots[pos & mask];
+    new (&s.storage) T(std::move(element));
+    s.sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop_ring(T &out) {
+    slot &s = _slots[_head & mask];
+    std::size_t seq = s.sequence.load(std::memory_order_acquire);
+    if(seq != _head + 1)
+      return false;
+
+    T *element = std::launder(reinterpret_cast<T *>(&s.storage));
+    out = std::move(*element);
+    element->~T();
+    s.sequence.store(_head + Capacity, std::memory_order_release);
+    ++_head;
+    return true;
+  }
+
+  struct slot {
+    std::atomic<std::size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+  };
+
+  slot _slots[Capacity];
+  alignas(64) std::atomic<std::size_t> _tail;
+  // Only accessed by the consumer
+  alignas(64) std::size_t _head;
+
+  std::atomic<bool> _has_overflow;
+  std::mutex _overflow_mutex;
+  std::deque<T> _overflow;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_OBJECT_POOL_HPP
+#define HIPSYCL_OBJECT_POOL_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace hipsycl {
+namespace rt {
+
+/// Recycles memory of small objects that are created and destroyed at
+/// high rates, such as DAG nodes and operations for each submission.
+///
+/// Freed blocks are cached in per-thread free lists, organized in size
+/// classes. Since objects are often destroyed by a different thread than
+/// the one that created them (e.g. when the scheduler purges completed
+/// nodes), free lists that grow too large are moved in batches to a global
+/// free list from which other threads refill their own free lists.
+/// Allocations larger than max_pooled_size directly use operator new.
+class object_pool {
+public:
+  static constexpr std::size_t granularity = 64;
+  static constexpr std::size_t max_pooled_size = 2048;
+
+  static void* allocate(std::size_t size);
+  static void deallocate(void* ptr, std::size_t size) noexcept;
+};
+
+/// Standard allocator using object_pool, e.g. for std::allocate_shared.
+template<class T>
+class object_pool_allocator {
+  static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                "object_pool does not support over-aligned types");
+public:
+  using value_type = T;
+
+  object_pool_allocator() noexcept = default;
+
+  template<class U>
+  object_pool_allocator(const object_pool_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(object_pool::allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    object_pool::deallocate(ptr, n * sizeof(T));
+  }
+
+  template<class U>
+  friend bool operator==(const object_pool_allocator&,
+                         const object_pool_allocator<U>&) noexcept {
+    return true;
+  }
+
+  template<class U>
+  friend bool operator!=(const object_pool_allocator&,
+                         const object_pool_allocator<U>&) noexcept {
+    return false;
+  }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SPIN_WAIT_HPP
+#define HIPSYCL_SPIN_WAIT_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+namespace hipsycl {
+namespace rt {
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+// Spins and then yields until the predicate becomes true. Returns
+// false if the predicate did not become true; the caller should then
+// go to sleep.
+template<class Predicate>
+bool spin_until(Predicate p) {
+  constexpr int num_spin_iterations = 1024;
+  constexpr int num_yield_iterations = 64;
+
+  for(int i = 0; i < num_spin_iterations; ++i) {
+    if(p())
+      return true;
+    cpu_relax();
+  }
+  for(int i = 0; i < num_yield_iterations; ++i) {
+    if(p())
+      return true;
+    std::this_thread::yield();
+  }
+  return p();
+}
+
+/// Predicts the duration of waits from the durations of previous waits,
+/// using an exponential moving average. Thread-safe; concurrent updates
+/// may be lost, which only affects the accuracy of the prediction.
+class wait_duration_predictor {
+public:
+  /// Returns the predicted duration in ns, or 0 if nothing has been
+  /// recorded so far.
+  uint64_t get_predicted_duration() const {
+    return _predicted_ns.load(std::memory_order_relaxed);
+  }
+
+  void record(uint64_t duration_ns) {
+    uint64_t previous = _predicted_ns.load(std::memory_order_relaxed);
+    // Waits of zero ns are recorded as 1 ns to distinguish them from the
+    // absence of history
+    uint64_t updated = previous == 0 ? duration_ns + 1
+                                     : (3 * previous + duration_ns) / 4 + 1;
+    _predicted_ns.store(updated, std::memory_order_relaxed);
+  }
+private:
+  std::atomic<uint64_t> _predicted_ns{0};
+};
+
+/// Polls is_complete() for up to max_spin_ns, and then invokes
+/// blocking_wait(). Spinning avoids the wake-up latency of blocking waits,
+/// but occupies a CPU core. Therefore, waits that are predicted to take
+/// longer than max_spin_ns block right away, and spinning stops after
+/// twice the predicted duration.
+/// blocking_wait() is also invoked if is_complete() returned true, such that
+/// errors are reported by the blocking wait as usual; this is
+/// expected to return immediately.
+template<class Poll, class BlockingWait>
+void hybrid_wait(wait_duration_predictor &predictor, uint64_t max_spin_ns,
+                 Poll is_complete, BlockingWait blocking_wait) {
+  if(max_spin_ns == 0) {
+    blocking_wait();
+    return;
+  }
+
+  using clock_type = std::chrono::steady_clock;
+  auto start = clock_type::now();
+  auto elapsed_ns = [&]() -> uint64_t {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               clock_type::now() - start)
+        .count();
+  };
+
+  uint64_t predicted_ns = predictor.get_predicted_duration();
+  if(predicted_ns <= max_spin_ns) {
+    uint64_t spin_ns = predicted_ns == 0
+                           ? max_spin_ns
+                           : std::min(max_spin_ns, 2 * predicted_ns);
+    while(!is_complete() && elapsed_ns() < spin_ns)
+      cpu_relax();
+  }
+  blocking_wait();
+  predictor.record(elapsed_ns());
+}
+
+}
+}
+
+#endif
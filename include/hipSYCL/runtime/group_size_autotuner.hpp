@@ -0,0 +1,99 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_GROUP_SIZE_AUTOTUNER_HPP
+#define HIPSYCL_GROUP_SIZE_AUTOTUNER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "hipSYCL/runtime/event.hpp"
+#include "hipSYCL/runtime/instrumentation.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Selects group sizes of kernels where the runtime is free to choose
+/// the group size by measuring the execution time of several candidate
+/// group sizes across kernel invocations. Once all candidates have been
+/// measured, the fastest one is stored in the group_size_cache, and thus
+/// persisted in the appdb for subsequent application runs.
+///
+/// Keys are the same as for the group_size_cache.
+/// Active if ACPP_ADAPTIVITY_LEVEL >= 3.
+class group_size_autotuner {
+public:
+  struct measurement {
+    std::shared_ptr<dag_node_event> completion_event;
+    std::shared_ptr<instrumentations::execution_start_timestamp> start;
+    std::shared_ptr<instrumentations::execution_finish_timestamp> finish;
+  };
+
+  static group_size_autotuner& get();
+  static bool is_enabled();
+
+  /// Returns the group size that the next invocation of the kernel should be
+  /// measured with, or an empty optional if no measurement is needed at
+  /// the moment, either because tuning has completed or because
+  /// results of previous invocations are still pending.
+  std::optional<range<3>>
+  select_candidate(const kernel_configuration::id_type &key,
+                   const range<3> &global_range, std::size_t max_group_size);
+
+  /// Registers a kernel invocation with a group size returned by
+  /// select_candidate(). Measurements are evaluated once
+  /// their completion event has completed.
+  void add_measurement(const kernel_configuration::id_type &key,
+                       const range<3> &group_size, measurement m);
+  /// Excludes the candidate, e.g. if the kernel could not be launched with it.
+  void discard_candidate(const kernel_configuration::id_type &key,
+                         const range<3> &group_size);
+
+private:
+  group_size_autotuner() = default;
+
+  struct candidate {
+    range<3> group_size;
+    std::size_t num_issued_samples = 0;
+    std::size_t num_completed_samples = 0;
+    // Fastest of the completed samples
+    uint64_t best_duration = 0;
+    bool is_discarded = false;
+  };
+
+  struct tuning_state {
+    std::vector<candidate> candidates;
+    std::vector<std::pair<std::size_t, measurement>> pending_measurements;
+    bool is_complete = false;
+  };
+
+  candidate* find_candidate(tuning_state &state, const range<3> &group_size);
+  void evaluate_completed_measurements(tuning_state &state);
+  void try_complete(const kernel_configuration::id_type &key,
+                    tuning_state &state);
+
+  std::mutex _mutex;
+  std::unordered_map<kernel_configuration::id_type, tuning_state,
+                     kernel_id_hash>
+      _states;
+};
+
+}
+}
+
+#endif
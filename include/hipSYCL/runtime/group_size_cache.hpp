@@ -0,0 +1,79 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_GROUP_SIZE_CACHE_HPP
+#define HIPSYCL_GROUP_SIZE_CACHE_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Group sizes for kernels where the runtime is free to choose the group size
+/// (e.g. basic parallel_for). Backends determine them from the resource usage
+/// of the compiled kernel with the occupancy APIs of the backend. Entries are
+/// persisted in the appdb, so that subsequent application runs directly JIT
+/// compile kernels for the selected group size.
+class group_size_cache {
+public:
+  struct entry {
+    range<3> group_size;
+    // Set if the group size was selected by group_size_autotuner
+    bool is_autotuned = false;
+  };
+
+  static group_size_cache& get();
+
+  /// Identifies a kernel on devices with the given name for kernels of the
+  /// given dimension.
+  static kernel_configuration::id_type
+  get_key(backend_id backend, hcf_object_id hcf_object,
+          std::string_view kernel_name, const std::string &device_name,
+          int dimension);
+
+  /// Dimension of kernels with the given global range, as used for
+  /// the cache key.
+  static int get_dimension(const range<3> &global_range);
+
+  /// Converts a number of work items suggested by an occupancy API
+  /// into a group size of the given dimension.
+  static range<3> make_group_size(std::size_t num_work_items, int dimension);
+
+  /// Returns the group size that was previously stored for this key, if any.
+  std::optional<entry> get(const kernel_configuration::id_type &key);
+  /// Group sizes that are not autotuned do not replace autotuned ones.
+  void store(const kernel_configuration::id_type &key,
+             const range<3> &group_size, bool is_autotuned = false);
+
+private:
+  group_size_cache() = default;
+
+  std::mutex _mutex;
+  // Also contains entries for kernels that we did not find in the appdb,
+  // such that the appdb is only consulted once per kernel.
+  std::unordered_map<kernel_configuration::id_type, std::optional<entry>,
+                     kernel_id_hash>
+      _entries;
+};
+
+}
+}
+
+#endif
@@ -84,6 +84,10 @@ enum class device_uint_property {
   global_mem_cache_line_size,
   global_mem_cache_size,
   global_mem_size,
+  // Theoretical peak bandwidth of global memory in bytes per second. Devices
+  // that do not expose it may report a measured estimate instead (e.g. the
+  // host device), or 0 if it is unknown. Consumers must handle 0.
+  peak_memory_bandwidth,
 
   max_constant_buffer_size,
   max_constant_args,
@@ -97,7 +101,10 @@ enum class device_uint_property {
 };
 
 enum class device_uint_list_property {
-  sub_group_sizes
+  sub_group_sizes,
+  // Indices of devices of the same backend whose memory this device
+  // can access directly (e.g. via NVLink, xGMI or PCIe peer-to-peer)
+  peer_access_devices
 };
 
 class hardware_context
@@ -136,6 +143,23 @@ public:
   virtual hardware_context *get_device(std::size_t index) = 0;
   virtual device_id get_device_id(std::size_t index) const = 0;
 
+  /// Sub-devices are addressed by device indices >= get_num_devices(),
+  /// such that they are not enumerated as root devices.
+  /// \return The number of device indices, including sub-devices
+  virtual std::size_t get_num_device_indices() const {
+    return get_num_devices();
+  }
+  /// \return The indices of the sub-devices that the given device can be
+  /// partitioned into by affinity domain
+  virtual std::vector<std::size_t> get_sub_devices(std::size_t index) const {
+    return {};
+  }
+  /// \return The index of the parent device of a sub-device, or \c index
+  /// itself for root devices
+  virtual std::size_t get_parent_device(std::size_t index) const {
+    return index;
+  }
+
   virtual ~backend_hardware_manager(){}
 };
 
@@ -16,6 +16,7 @@
 #include <type_traits>
 #include <vector>
 #include <cstring>
+#include <limits>
 
 #include "device_id.hpp"
 #include "util.hpp"
@@ -107,6 +108,65 @@ private:
 class coarse_grained_synchronization : public execution_hint
 {};
 
+/// Operations with the same capture id that are submitted consecutively
+/// to the same inorder queue may be recorded into a backend graph
+/// (e.g. a CUDA graph) and launched together. When the same sequence is
+/// captured again, the previously instantiated graph is reused if possible.
+class graph_capture : public execution_hint
+{
+public:
+  // Capture ids starting from this value are reserved for internal use
+  static constexpr std::size_t first_reserved_id =
+      std::numeric_limits<std::size_t>::max() - 15;
+
+  graph_capture() = default;
+  graph_capture(std::size_t capture_id)
+      : _capture_id{capture_id} {}
+
+  std::size_t get_id() const {
+    return _capture_id;
+  }
+private:
+  std::size_t _capture_id;
+};
+
+/// Requests that all work groups of a kernel are resident on the device
+/// at the same time, such that they can synchronize using grid barriers.
+/// If limit_num_groups is set, the number of work groups is reduced to the
+/// maximum number of work groups that can be resident at the same time.
+/// Otherwise, launching more work groups is an error.
+class cooperative_launch : public execution_hint
+{
+public:
+  cooperative_launch() = default;
+  cooperative_launch(bool limit_num_groups)
+      : _limit_num_groups{limit_num_groups} {}
+
+  bool limits_num_groups() const {
+    return _limit_num_groups;
+  }
+private:
+  bool _limit_num_groups = false;
+};
+
+/// Requests that host backends distribute the iterations of a kernel
+/// dynamically across threads in chunks of chunk_size iterations, which
+/// balances the load if iterations differ in cost. If chunk_size is 0,
+/// the backend selects the chunk size.
+class dynamic_schedule : public execution_hint
+{
+public:
+  dynamic_schedule() = default;
+  dynamic_schedule(std::size_t chunk_size)
+      : _chunk_size{chunk_size} {}
+
+  std::size_t get_chunk_size() const {
+    return _chunk_size;
+  }
+private:
+  std::size_t _chunk_size = 0;
+};
+
 class prefer_executor : public execution_hint
 {
 public:
@@ -128,9 +188,34 @@ private:
 
 class instant_execution : public execution_hint {};
 
+/// Set by the runtime for operations on the longest chain of dependent
+/// operations within a flushed batch, see ACPP_RT_CRITICAL_PATH_SCHEDULING.
+class critical_path : public execution_hint {};
+
+/// Priority of the queue that submitted the operation, see
+/// sycl::property::queue::AdaptiveCpp_priority. As for CUDA and HIP
+/// streams, lower values correspond to higher priorities.
+class execution_priority : public execution_hint
+{
+public:
+  execution_priority() = default;
+  execution_priority(int priority)
+      : _priority{priority} {}
+
+  int get_priority() const {
+    return _priority;
+  }
+private:
+  int _priority = 0;
+};
+
 class request_instrumentation_submission_timestamp : public execution_hint {};
 class request_instrumentation_start_timestamp : public execution_hint {};
 class request_instrumentation_finish_timestamp : public execution_hint {};
+/// Requests the collection of hardware counters for kernels. This can
+/// serialize and replay the kernel, and is therefore much more expensive
+/// than timestamps.
+class request_instrumentation_hardware_counters : public execution_hint {};
 
 } // hints
 
@@ -182,6 +267,12 @@ private:
   hints::node_group _node_group;
   
   hints::coarse_grained_synchronization _coarse_grained_synchronization;
+
+  hints::graph_capture _graph_capture;
+
+  hints::cooperative_launch _cooperative_launch;
+
+  hints::dynamic_schedule _dynamic_schedule;
   
   hints::prefer_executor _prefer_executor;
 
@@ -191,8 +282,12 @@ private:
       _request_instrumentation_start_timestamp;
   hints::request_instrumentation_finish_timestamp
       _request_instrumentation_finish_timestamp;
+  hints::request_instrumentation_hardware_counters
+      _request_instrumentation_hardware_counters;
 
   hints::instant_execution _instant_execution;
+  hints::critical_path _critical_path;
+  hints::execution_priority _execution_priority;
 };
 
 #define HIPSYCL_RT_HINTS_MAP_GETTER(name, member)                              \
@@ -210,6 +305,9 @@ HIPSYCL_RT_HINTS_MAP_GETTER(prefer_execution_lane, _prefer_execution_lane);
 HIPSYCL_RT_HINTS_MAP_GETTER(node_group, _node_group);
 HIPSYCL_RT_HINTS_MAP_GETTER(coarse_grained_synchronization,
                             _coarse_grained_synchronization);
+HIPSYCL_RT_HINTS_MAP_GETTER(graph_capture, _graph_capture);
+HIPSYCL_RT_HINTS_MAP_GETTER(cooperative_launch, _cooperative_launch);
+HIPSYCL_RT_HINTS_MAP_GETTER(dynamic_schedule, _dynamic_schedule);
 HIPSYCL_RT_HINTS_MAP_GETTER(prefer_executor, _prefer_executor);
 HIPSYCL_RT_HINTS_MAP_GETTER(request_instrumentation_submission_timestamp,
                             _request_instrumentation_submission_timestamp);
@@ -217,8 +315,12 @@ HIPSYCL_RT_HINTS_MAP_GETTER(request_instrumentation_start_timestamp,
                             _request_instrumentation_start_timestamp);
 HIPSYCL_RT_HINTS_MAP_GETTER(request_instrumentation_finish_timestamp,
                             _request_instrumentation_finish_timestamp);
+HIPSYCL_RT_HINTS_MAP_GETTER(request_instrumentation_hardware_counters,
+                            _request_instrumentation_hardware_counters);
 HIPSYCL_RT_HINTS_MAP_GETTER(instant_execution,
                             _instant_execution);
+HIPSYCL_RT_HINTS_MAP_GETTER(critical_path, _critical_path);
+HIPSYCL_RT_HINTS_MAP_GETTER(execution_priority, _execution_priority);
 }
 }
 
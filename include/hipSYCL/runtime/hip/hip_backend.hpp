@@ -17,6 +17,7 @@
 #include "hip_queue.hpp"
 #include "hip_hardware_manager.hpp"
 #include "hip_event_pool.hpp"
+#include "../staging_buffer_pool.hpp"
 
 #ifndef HIPSYCL_HIP_BACKEND_HPP
 #define HIPSYCL_HIP_BACKEND_HPP
@@ -45,6 +46,7 @@ public:
   create_inorder_executor(device_id dev, int priority) override;
 
   hip_event_pool* get_event_pool(device_id dev) const;
+  staging_buffer_pool* get_staging_buffer_pool(device_id dev) const;
 private:
   mutable hip_hardware_manager _hw_manager;
   mutable lazily_constructed_executor<multi_queue_executor> _executor;
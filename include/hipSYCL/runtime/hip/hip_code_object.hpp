@@ -11,8 +11,12 @@
 #ifndef HIPSYCL_HIP_CODE_OBJECT_HPP
 #define HIPSYCL_HIP_CODE_OBJECT_HPP
 
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/error.hpp"
@@ -21,6 +25,7 @@
 
 
 struct ihipModule_t;
+struct ihipModuleSymbol_t;
 
 namespace hipsycl {
 namespace rt {
@@ -31,6 +36,17 @@ public:
   virtual ihipModule_t* get_module() const = 0;
   virtual result get_build_result() const = 0;
   virtual int get_device() const = 0;
+
+  /// Obtains the function handle of a kernel in the module. The handle is
+  /// only looked up in the module on first use, such that kernel launches
+  /// do not need to go through a string-keyed lookup in the runtime.
+  result get_kernel(std::string_view kernel_name,
+                    ihipModuleSymbol_t *&f) const;
+private:
+  mutable std::mutex _kernel_lookup_mutex;
+  mutable std::unordered_map<std::string_view, ihipModuleSymbol_t *> _kernels;
+  // Backing storage for the keys of _kernels
+  mutable std::vector<std::unique_ptr<std::string>> _kernel_names_storage;
 };
 
 class hip_multipass_executable_object : public hip_executable_object {
@@ -68,7 +84,8 @@ private:
 class hip_sscp_executable_object : public hip_executable_object {
 public:
   virtual ~hip_sscp_executable_object();
-  hip_sscp_executable_object(const std::string &hip_fat_binary,
+  /// hip_fat_binary only needs to remain valid during construction.
+  hip_sscp_executable_object(std::string_view hip_fat_binary,
                              const std::string &target_arch,
                              hcf_object_id source,
                              const std::vector<std::string> &kernel_name,
@@ -92,7 +109,7 @@ public:
   virtual ihipModule_t* get_module() const override;
   virtual int get_device() const override;
 private:
-  result build(const std::string& hip_fat_binary);
+  result build(std::string_view hip_fat_binary);
 
   std::string _target;
   hcf_object_id _origin;
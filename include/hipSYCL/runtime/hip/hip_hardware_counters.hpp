@@ -0,0 +1,64 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_HIP_HARDWARE_COUNTERS_HPP
+#define HIPSYCL_HIP_HARDWARE_COUNTERS_HPP
+
+#include <memory>
+#include <mutex>
+
+#include "../error.hpp"
+#include "../instrumentation.hpp"
+
+struct ihipStream_t;
+
+namespace hipsycl {
+namespace rt {
+
+class rocprofiler_device_profiler;
+
+/// Collects hardware counters of the first kernel launched on a device
+/// between construction and finish() using the rocprofiler-sdk dispatch
+/// counting service. Only one collection can be active per device at a time;
+/// constructing a second one blocks until the first has finished.
+///
+/// Requires that register_tool() has been called before the HIP runtime
+/// was initialized, otherwise no counters are collected.
+class hip_hardware_counter_collection {
+public:
+  hip_hardware_counter_collection(int device_id);
+  ~hip_hardware_counter_collection();
+
+  hip_hardware_counter_collection(const hip_hardware_counter_collection &) =
+      delete;
+  hip_hardware_counter_collection &
+  operator=(const hip_hardware_counter_collection &) = delete;
+
+  /// Waits for the kernels on the stream and retrieves the counters of the
+  /// first kernel launched since construction.
+  /// Returns an error if collection failed or no kernel was launched.
+  result finish(ihipStream_t *stream,
+                std::shared_ptr<simple_hardware_counters> &out);
+
+  /// Registers the runtime as rocprofiler-sdk tool if enabled with
+  /// ACPP_RT_HIP_HARDWARE_COUNTERS. Must be invoked before the first
+  /// call into the HIP runtime.
+  static void register_tool();
+
+private:
+  rocprofiler_device_profiler *_profiler;
+  std::unique_lock<std::mutex> _lock;
+  bool _is_active;
+};
+
+}
+}
+
+#endif
@@ -24,6 +24,7 @@ namespace rt {
 
 class hip_allocator;
 class hip_event_pool;
+class staging_buffer_pool;
 
 class hip_hardware_context : public hardware_context
 {
@@ -56,12 +57,19 @@ public:
   virtual ~hip_hardware_context() {}
 
   hip_allocator* get_allocator() const;
+
+  /// Enables direct access from this device to the memory of \c peer_dev
+  /// if supported. Returns whether peer access is available.
+  bool enable_peer_access(int peer_dev);
   hip_event_pool* get_event_pool() const;
+  staging_buffer_pool* get_staging_buffer_pool() const;
 private:
   std::unique_ptr<hipDeviceProp_t> _properties;
   std::unique_ptr<hip_allocator> _allocator;
   std::unique_ptr<hip_event_pool> _event_pool;
+  std::unique_ptr<staging_buffer_pool> _staging_pool;
   int _dev;
+  std::vector<std::size_t> _peer_devices;
 };
 
 class hip_hardware_manager : public backend_hardware_manager
@@ -15,13 +15,20 @@
 #include "../inorder_queue.hpp"
 #include "../generic/host_timestamped_event.hpp"
 #include "../code_object_invoker.hpp"
+#include "../hints.hpp"
 
 #include "hipSYCL/common/spin_lock.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/adaptivity_engine.hpp"
 #include "hip_instrumentation.hpp"
 
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
 // Avoid including HIP headers to prevent conflicts with CUDA
 struct ihipStream_t;
+struct ihipModuleSymbol_t;
 
 namespace hipsycl {
 namespace rt {
@@ -63,6 +70,11 @@ public:
                                std::string_view kernel_name,
                                const rt::hcf_kernel_info* kernel_info,
                                const kernel_configuration& config) override;
+
+  virtual rt::range<3>
+  select_group_size(const rt::range<3> &global_range,
+                    const rt::range<3> &group_size, hcf_object_id hcf_object,
+                    std::string_view kernel_name) const override;
 private:
   hip_queue* _queue;
 };
@@ -97,6 +109,9 @@ public:
 
   virtual result query_status(inorder_queue_status& status) override;
 
+  virtual result submit_completion_callback(void (*callback)(void *),
+                                            void *user_data) override;
+
   result submit_multipass_kernel_from_code_object(
       const kernel_operation &op, hcf_object_id hcf_object,
       const std::string &backend_kernel_name, const rt::range<3> &grid_size,
@@ -110,12 +125,27 @@ public:
       unsigned local_mem_size, void **args, std::size_t *arg_sizes,
       std::size_t num_args, const kernel_configuration &config);
 
+  // Selects group sizes for SSCP kernels where the runtime is free to
+  // choose, based on previous occupancy queries (see group_size_cache).
+  rt::range<3> select_sscp_group_size(const rt::range<3> &global_range,
+                                      const rt::range<3> &default_group_size,
+                                      hcf_object_id hcf_object,
+                                      std::string_view kernel_name);
+
   const host_timestamped_event& get_timing_reference() const {
     return _reference_event;
   }
 private:
   void activate_device() const;
 
+  // Starts, continues or ends graph capture (hints::graph_capture)
+  // depending on the hints of the node that is about to be submitted.
+  // Assumes that _graph_capture_mutex is locked.
+  result update_graph_capture(const dag_node_ptr &node, bool is_capturable);
+  // Ends the active graph capture, if any, and launches the captured graph.
+  // Assumes that _graph_capture_mutex is locked.
+  result end_graph_capture();
+
   const device_id _dev;
   ihipStream_t* _stream;
   host_timestamped_event _reference_event;
@@ -128,6 +158,23 @@ private:
   common::spin_lock _sscp_submission_spin_lock;
   glue::jit::cxx_argument_mapper _arg_mapper;
   kernel_configuration _config;
+  sscp_launch_cache<ihipModuleSymbol_t*> _sscp_launch_cache;
+  // hints::cooperative_launch of the kernel that is currently submitted
+  const hints::cooperative_launch* _cooperative_launch = nullptr;
+  // group_size_cache key of the kernel that is currently submitted, if its
+  // group size should be determined from occupancy after compilation
+  std::optional<kernel_configuration::id_type> _pending_group_size_key;
+  // group_size_cache key of the kernel that is currently submitted, if it
+  // is launched with a group size candidate of the group_size_autotuner
+  std::optional<kernel_configuration::id_type> _pending_autotuning_key;
+
+  // Graph capture data
+  std::recursive_mutex _graph_capture_mutex;
+  bool _is_capturing_graph;
+  std::size_t _graph_capture_id;
+  // Instantiated graphs (hipGraphExec_t) for each capture id, see
+  // hints::graph_capture. Stored as void* to avoid including HIP headers.
+  std::unordered_map<std::size_t, void*> _graph_execs;
 };
 
 }
@@ -0,0 +1,77 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_DEVICE_MODEL_HPP
+#define HIPSYCL_DEVICE_MODEL_HPP
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include "../device_id.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+class backend_manager;
+class runtime;
+
+struct device_performance_properties {
+  // Time from submission to completion of a minimal device operation in
+  // seconds
+  double operation_latency = 0.0;
+  // Sustained bandwidth of copies within device memory in bytes per second,
+  // counting both bytes read and written
+  double memory_bandwidth = 0.0;
+};
+
+/// Provides measured performance properties of individual devices.
+///
+/// Properties are only available for devices for which calibration
+/// results exist in the persistent storage (see calibrate() and
+/// store_calibration(), or acpp-info --benchmark).
+class device_model
+{
+public:
+  device_model(backend_manager* mgr);
+
+  std::optional<device_performance_properties>
+  get_properties(device_id dev) const;
+
+  /// Measures the properties of all devices and uses them for subsequent
+  /// queries. Operations are submitted directly to the device executors,
+  /// so this should be invoked while no other operations are running.
+  void calibrate(runtime *rt);
+
+  /// Writes calibrated device properties to the persistent storage, from
+  /// where they are loaded by all subsequent applications.
+  bool store_calibration() const;
+
+  static std::string get_calibration_file_path();
+private:
+  void load_calibration() const;
+
+  backend_manager* _backends;
+
+  mutable std::once_flag _load_flag;
+  mutable std::mutex _mutex;
+  mutable std::unordered_map<std::string, device_performance_properties>
+      _calibrated_devices;
+};
+
+/// Returns a key under which calibration results of a device are stored.
+/// It identifies the device by backend, index and name, such that results
+/// are invalidated when the hardware configuration changes.
+std::string get_device_calibration_key(backend_manager *mgr, device_id dev);
+
+}
+}
+
+#endif
@@ -13,6 +13,7 @@
 
 #include <memory>
 #include "memcpy.hpp"
+#include "device.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -22,7 +23,8 @@ class hw_model
 {
 public:
   hw_model(backend_manager* backends)
-  : _memcpy_model{std::make_unique<memcpy_model>(backends)}
+  : _memcpy_model{std::make_unique<memcpy_model>(backends)},
+    _device_model{std::make_unique<device_model>(backends)}
   {}
 
   memcpy_model *get_memcpy_model() const
@@ -30,8 +32,14 @@ public:
     return _memcpy_model.get();
   }
 
+  device_model *get_device_model() const
+  {
+    return _device_model.get();
+  }
+
 private:
   std::unique_ptr<memcpy_model> _memcpy_model;
+  std::unique_ptr<device_model> _device_model;
 };
 
 }
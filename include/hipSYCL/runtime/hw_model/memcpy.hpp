@@ -12,6 +12,10 @@
 #define HIPSYCL_MEMCPY_HPP
 
 #include <vector>
+#include <string>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include "../operations.hpp"
 #include "../util.hpp"
 
@@ -19,12 +23,30 @@ namespace hipsycl {
 namespace rt {
 
 class backend_manager;
+class runtime;
 
+struct memcpy_link_properties {
+  // Fixed cost per transfer in seconds
+  double latency = 0.0;
+  // Sustained bandwidth in bytes per second
+  double bandwidth = 0.0;
+};
+
+/// Models the cost of data transfers between devices as latency plus
+/// transfer size divided by bandwidth.
+///
+/// Links for which calibration results are available in the persistent
+/// storage (see calibrate() and store_calibration(), or acpp-info
+/// --calibrate-memcpy and --benchmark) use the measured properties; other
+/// links use conservative defaults depending on the link type. In particular,
+/// transfers between different non-host devices are assumed to be staged
+/// through the host unless peer access between them is enabled.
 class memcpy_model
 {
 public:
-  memcpy_model(backend_manager* mgr){}
+  memcpy_model(backend_manager* mgr);
 
+  /// Returns the estimated transfer time in seconds
   cost_type estimate_runtime_cost(const memory_location &source,
                                   const memory_location &dest,
                                   range<3> num_elements) const;
@@ -33,6 +55,38 @@ public:
   choose_source(const std::vector<memory_location> &candidate_sources,
                 const memory_location &target, range<3> num_elements) const;
 
+  memcpy_link_properties get_link_properties(device_id source,
+                                             device_id dest) const;
+
+  /// Returns the link properties only if they have been measured
+  std::optional<memcpy_link_properties>
+  get_calibrated_link_properties(device_id source, device_id dest) const;
+
+  /// Measures latency and bandwidth of all links between devices that the
+  /// runtime can carry out transfers for, and uses them for subsequent
+  /// cost estimates. Transfers are submitted directly to the device executors,
+  /// so this should be invoked while no other operations are running.
+  void calibrate(runtime *rt);
+
+  /// Writes calibrated link properties to the persistent storage, from where
+  /// they are loaded by all subsequent applications.
+  bool store_calibration() const;
+
+  static std::string get_calibration_file_path();
+private:
+  void load_calibration() const;
+  bool has_peer_access(device_id source, device_id dest) const;
+  std::string get_device_key(device_id dev) const;
+  std::string get_link_key(device_id source, device_id dest) const;
+  memcpy_link_properties get_default_link_properties(device_id source,
+                                                     device_id dest) const;
+
+  backend_manager* _backends;
+
+  mutable std::once_flag _load_flag;
+  mutable std::mutex _mutex;
+  mutable std::unordered_map<std::string, memcpy_link_properties>
+      _calibrated_links;
 };
 
 
@@ -12,8 +12,10 @@
 #define HIPSYCL_INORDER_EXECUTOR_HPP
 
 #include <atomic>
+#include <mutex>
 
 #include "executor.hpp"
+#include "hipSYCL/common/small_map.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "inorder_queue.hpp"
 
@@ -45,10 +47,39 @@ public:
   bool can_execute_on_device(const device_id& dev) const override;
   bool is_submitted_by_me(const dag_node_ptr& node) const override;
 
+  result register_completion_callback(const dag_node_ptr &node,
+                                      void (*callback)(void *),
+                                      void *user_data) override;
+
   result wait();
 private:
+  // Tags small SSCP kernels that are submitted back-to-back for capture
+  // into a single backend graph, see ACPP_RT_KERNEL_BATCHING_MAX_WORK_ITEMS.
+  void assign_kernel_batch(const dag_node_ptr &node, operation *op,
+                           bool requires_synchronization);
+  // Requests the queue to signal completion of the node to the
+  // node_completion_queue of the runtime, see ACPP_RT_COMPLETION_CALLBACKS.
+  void submit_completion_callback(const dag_node_ptr &node);
+
   std::unique_ptr<inorder_queue> _q;
   std::atomic<std::size_t> _num_submitted_operations;
+  // Whether nodes are given lazily synchronized events,
+  // see ACPP_RT_LAZY_EVENTS
+  bool _use_lazy_events;
+
+  // Highest execution index of each other lane of the same backend that
+  // this queue has waited for
+  std::mutex _lane_synchronization_mutex;
+  common::small_map<const inorder_queue *, std::size_t>
+      _synchronized_lane_indices;
+
+  std::size_t _kernel_batching_max_work_items;
+  std::mutex _kernel_batching_mutex;
+  std::size_t _num_kernels_in_batch;
+  std::size_t _kernel_batch_index;
+  bool _is_previous_node_batched;
+
+  std::atomic<bool> _use_completion_callbacks;
 };
 
 }
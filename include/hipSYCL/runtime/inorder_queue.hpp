@@ -11,6 +11,8 @@
 #ifndef HIPSYCL_INORDER_QUEUE_HPP
 #define HIPSYCL_INORDER_QUEUE_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -37,6 +39,42 @@ private:
   bool _is_complete;
 };
 
+/// Tracks completion of lazily synchronized operations of an in-order queue
+/// (see queue_completion_event) based on their submission order: Once an
+/// operation is known to have completed, all operations that were submitted
+/// before it have completed as well.
+class inorder_queue_completion_tracker {
+public:
+  inorder_queue_completion_tracker()
+  : _num_registered{0}, _num_known_completed{0} {}
+
+  /// Returns the index of a new operation that has already been submitted
+  uint64_t register_operation() {
+    return _num_registered.fetch_add(1, std::memory_order_acq_rel) + 1;
+  }
+
+  /// Index of the most recently registered operation
+  uint64_t get_last_registered() const {
+    return _num_registered.load(std::memory_order_acquire);
+  }
+
+  bool is_known_complete(uint64_t index) const {
+    return index <= _num_known_completed.load(std::memory_order_acquire);
+  }
+
+  void mark_complete_up_to(uint64_t index) {
+    uint64_t current = _num_known_completed.load(std::memory_order_relaxed);
+    while (current < index &&
+           !_num_known_completed.compare_exchange_weak(
+               current, index, std::memory_order_acq_rel))
+      ;
+  }
+
+private:
+  std::atomic<uint64_t> _num_registered;
+  std::atomic<uint64_t> _num_known_completed;
+};
+
 /// Represents an in-order queue. Implementations of this abstract
 /// interface have to be thread-safe.
 class inorder_queue
@@ -65,7 +103,25 @@ public:
 
   virtual result query_status(inorder_queue_status& status) = 0;
 
+  /// Enqueues callback(user_data) to be invoked on a host thread once all
+  /// operations submitted so far have completed. The callback must not
+  /// invoke backend API functions. Returns an error of type
+  /// feature_not_supported if the backend does not support this.
+  virtual result submit_completion_callback(void (*callback)(void *),
+                                            void *user_data) {
+    return make_error(
+        __acpp_here(),
+        error_info{"inorder_queue: Completion callbacks are not supported",
+                   error_type::feature_not_supported});
+  }
+
   virtual ~inorder_queue(){}
+
+  inorder_queue_completion_tracker& get_completion_tracker() {
+    return _completion_tracker;
+  }
+private:
+  inorder_queue_completion_tracker _completion_tracker;
 };
 
 }
@@ -15,6 +15,7 @@
 #include <cstdint>
 #include <chrono>
 #include <future>
+#include <optional>
 #include <vector>
 #include <typeindex>
 #include <type_traits>
@@ -50,6 +51,18 @@ public:
   }
 };
 
+/// Hardware performance counters that can be collected per kernel
+enum class hardware_counter {
+  // Average fraction of active warps or wavefronts relative to the
+  // maximum supported by the hardware, in [0, 1]
+  achieved_occupancy,
+  dram_read_bytes,
+  dram_write_bytes,
+  // Fraction of L2 cache accesses that hit, in [0, 1]
+  l2_hit_rate,
+  num_counters
+};
+
 class instrumentation {
 public:
   /// Waits until an instrumentation has its result available
@@ -142,6 +155,14 @@ public:
   virtual ~execution_finish_timestamp() = default;
 };
 
+class hardware_counters : public instrumentation {
+public:
+  /// Returns an empty optional if the counter could not be collected
+  /// on this device.
+  virtual std::optional<double> get_value(hardware_counter c) const = 0;
+  virtual ~hardware_counters() = default;
+};
+
 }
 
 class simple_submission_timestamp : public instrumentations::submission_timestamp {
@@ -158,6 +179,24 @@ private:
   profiler_clock::time_point _time;
 };
 
+/// Hardware counters whose values are already known when the
+/// instrumentation is added.
+class simple_hardware_counters : public instrumentations::hardware_counters {
+public:
+  void set_value(hardware_counter c, double value) {
+    _values[static_cast<std::size_t>(c)] = value;
+  }
+
+  virtual std::optional<double> get_value(hardware_counter c) const override {
+    return _values[static_cast<std::size_t>(c)];
+  }
+
+  virtual void wait() const override {}
+private:
+  std::optional<double>
+      _values[static_cast<std::size_t>(hardware_counter::num_counters)];
+};
+
 }
 }
 
@@ -0,0 +1,96 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_JIT_CACHE_ARCHIVE_HPP
+#define HIPSYCL_JIT_CACHE_ARCHIVE_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "hipSYCL/common/unordered_dense.hpp"
+#include "kernel_configuration.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Append-only, indexed archive of JIT-compiled binaries of one application.
+/// Storing all binaries in a single file avoids creating one file per binary
+/// in the persistent cache, which is slow on network filesystems.
+///
+/// The archive is a sequence of records, each consisting of a header
+/// with the binary id and size followed by the binary. If a binary with
+/// identical content has been stored before, the record refers to the
+/// earlier binary instead. The archive is
+/// memory-mapped and indexed when it is opened. Binaries appended by other
+/// processes are picked up on lookup misses. Incomplete records at the end
+/// of the file (e.g. due to a crash while writing) are ignored.
+///
+/// This class is thread-safe.
+class jit_cache_archive {
+public:
+  using id_type = kernel_configuration::id_type;
+
+  jit_cache_archive(const std::string &filename);
+  ~jit_cache_archive();
+
+  jit_cache_archive(const jit_cache_archive &) = delete;
+  jit_cache_archive &operator=(const jit_cache_archive &) = delete;
+
+  /// Returns true if the archive could be opened. If false, all lookups fail
+  /// and stores are ignored.
+  bool is_open() const;
+
+  /// Looks up the binary with the given id. On success, \c out is a view
+  /// into the mapped archive of exactly the binary size, which remains valid
+  /// for the lifetime of the archive object.
+  bool lookup(const id_type &id, std::string_view &out);
+  /// Appends a binary to the archive. Returns false on error.
+  bool store(const id_type &id, std::string_view data);
+
+  bool contains(const id_type& id);
+
+  const std::string& get_filename() const {
+    return _filename;
+  }
+private:
+  struct mapping {
+    const char* data;
+    std::size_t size;
+  };
+
+  struct record_location {
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  // Assumes that _mutex is locked. Maps and indexes records that
+  // have been appended since the last call.
+  void refresh();
+  bool lookup_impl(const id_type& id, std::string_view& out) const;
+
+  std::string _filename;
+  int _fd;
+
+  std::vector<mapping> _mappings;
+  std::size_t _indexed_size;
+  ankerl::unordered_dense::map<id_type, record_location, kernel_id_hash> _index;
+  // Content hashes of the binaries stored in the archive
+  ankerl::unordered_dense::map<uint64_t, record_location> _content_index;
+
+  std::mutex _mutex;
+};
+
+}
+}
+
+#endif
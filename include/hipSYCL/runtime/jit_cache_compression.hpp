@@ -0,0 +1,48 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_JIT_CACHE_COMPRESSION_HPP
+#define HIPSYCL_JIT_CACHE_COMPRESSION_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace hipsycl {
+namespace rt {
+
+/// Encodes a JIT-compiled binary for storage in the persistent cache. If
+/// AdaptiveCpp has been built with zstd and level > 0, the binary is
+/// compressed with the given zstd compression level, unless this does not
+/// reduce its size. Otherwise, the binary is stored as is, which is also
+/// the format of entries written by earlier versions.
+std::string encode_jit_cache_entry(std::string_view binary, int level);
+
+/// Restores the binary from an entry produced by encode_jit_cache_entry().
+/// Returns false if the entry is compressed, but cannot be decompressed,
+/// e.g. because AdaptiveCpp has been built without zstd.
+bool decode_jit_cache_entry(std::string_view entry, std::string &out);
+
+/// Like decode_jit_cache_entry(entry, out), but does not copy uncompressed
+/// entries: out then refers to entry itself. Otherwise, the binary is
+/// decompressed into storage, and out refers to storage.
+bool decode_jit_cache_entry(std::string_view entry, std::string_view &out,
+                            std::string &storage);
+
+/// Identifies the content of an encoded entry, such that entries of
+/// different binary ids with the same content can be deduplicated.
+uint64_t get_jit_cache_content_hash(std::string_view entry);
+
+bool is_jit_cache_compression_available();
+
+}
+}
+
+#endif
@@ -8,26 +8,41 @@
  * See file LICENSE in the project root for full license details.
  */
 // SPDX-License-Identifier: BSD-2-Clause
+#include <atomic>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <mutex>
 #include <cassert>
 #include <memory>
 #include <optional>
 #include <array>
+#include <functional>
+#include <vector>
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/common/small_map.hpp"
+#include "hipSYCL/common/read_mostly_map.hpp"
 #include "hipSYCL/common/unordered_dense.hpp"
 #include "hipSYCL/common/stable_running_hash.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/generic/async_worker.hpp"
+#include "hipSYCL/runtime/jit_cache_archive.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 #ifndef HIPSYCL_RT_KERNEL_CACHE_HPP
 #define HIPSYCL_RT_KERNEL_CACHE_HPP
 
 namespace hipsycl {
+namespace common::db {
+struct jit_recipe;
+}
 namespace rt {
 
 enum class compilation_flow {
@@ -55,6 +70,9 @@ using hcf_object_id = std::size_t;
 
 struct jit_output_metadata {
   std::optional<std::vector<int>> kernel_retained_arguments_indices;
+  // Hardware resources of the kernels of the code object, if the backend
+  // can query them
+  std::vector<common::db::kernel_resource_usage_entry> kernel_resource_usage;
 };
 
 class code_object {
@@ -109,7 +127,8 @@ public:
 
   enum annotation_type {
     specialized,
-    fcall_specialized_config
+    fcall_specialized_config,
+    fast_math
   };
 
   std::size_t get_argument_offset(std::size_t i) const;
@@ -123,6 +142,9 @@ public:
 
   const std::vector<std::string> &get_images_containing_kernel() const;
   hcf_object_id get_hcf_object_id() const;
+  // Hash of the kernel IR and its dependencies, if provided by the
+  // compiler. Identical kernels in different HCF objects have the same hash.
+  std::optional<uint64_t> get_content_hash() const;
 
   const std::vector<rt::kernel_build_flag>& get_compilation_flags() const;
   const std::vector<std::pair<rt::kernel_build_option, std::string>> &
@@ -138,6 +160,7 @@ private:
   std::vector<std::vector<annotation_type>> _known_annotations;
 
   std::vector<std::string> _image_providers;
+  std::optional<uint64_t> _content_hash;
   
   std::vector<rt::kernel_build_flag> _compilation_flags;
   std::vector<std::pair<rt::kernel_build_option, std::string>>
@@ -177,7 +200,7 @@ public:
 
   const common::hcf_container* get_hcf(hcf_object_id obj) const;
   
-  hcf_object_id register_hcf_object(const common::hcf_container& obj);
+  hcf_object_id register_hcf_object(common::hcf_container obj);
   void unregister_hcf_object(hcf_object_id id);
 
   struct device_image_id {
@@ -214,6 +237,15 @@ public:
   const hcf_image_info *get_image_info(hcf_object_id obj,
                                        const std::string &image_name) const;
 
+  /// Retrieves a backend binary that was embedded ahead of time into the
+  /// "precompiled-binaries" node of a registered HCF object, e.g. using
+  /// acpp-appdb-tool. Returns false if no such binary exists.
+  bool get_precompiled_binary(const kernel_configuration::id_type &id_of_binary,
+                              std::string &out) const;
+
+  bool has_precompiled_binary(
+      const kernel_configuration::id_type &id_of_binary) const;
+
 private:
   hcf_cache() = default;
 
@@ -247,9 +279,21 @@ private:
 
   ankerl::unordered_dense::map<info_id, std::unique_ptr<hcf_kernel_info>, info_id_hash>
       _hcf_kernel_info;
+  // Lock-free view of _hcf_kernel_info, since kernel infos are looked up
+  // for every SSCP kernel launch.
+  common::read_mostly_map<info_id, const hcf_kernel_info, info_id_hash>
+      _hcf_kernel_info_lookup;
   ankerl::unordered_dense::map<info_id, std::unique_ptr<hcf_image_info>, info_id_hash>
       _hcf_image_info;
 
+  struct precompiled_binary_location {
+    hcf_object_id hcf_id;
+    const common::hcf_container::node* binary_node;
+  };
+  ankerl::unordered_dense::map<kernel_configuration::id_type,
+                               precompiled_binary_location, kernel_id_hash>
+      _precompiled_binaries;
+
   mutable std::mutex _mutex;
 };
 
@@ -301,8 +345,13 @@ public:
   /// Should return true if the compilation was successful. The binary output of JIT compilation
   /// should be stored in the string reference.
   /// \c c Is expected to turn the JIT-compiled binary into a code_object*. Has signature
-  /// code_object*(const std::string&). It is expected to return nullptr on error. The JIT-compiled
-  /// binary will be passed in as string reference.
+  /// code_object*(const std::string&) or code_object*(std::string_view). It is expected to return
+  /// nullptr on error. Constructors that accept a std::string_view may receive a view into the
+  /// mapped packed persistent cache, which avoids copying the binary. Such a view is exactly
+  /// binary.size() bytes long: Consumers must use its size, never a terminating null byte, and
+  /// loaders that only take a const char* must derive the extent of the binary from its format
+  /// and check it against the size. Constructors that need a null-terminated binary must take a
+  /// const std::string&.
   template <class CodeObjectConstructor, class JitCompiler>
   const code_object *get_or_construct_jit_code_object(code_object_id id_of_code_object,
                                                       code_object_id id_of_binary,
@@ -311,39 +360,146 @@ public:
     if(auto* code_object = get_code_object(id_of_code_object)) {
       HIPSYCL_DEBUG_INFO << "kernel_cache: Cache hit for id "
                          << kernel_configuration::to_string(id_of_code_object) << "\n";
+      runtime_statistics::get().add(statistic::kernel_cache_hits);
       return code_object;
     }
     HIPSYCL_DEBUG_INFO << "kernel_cache: Cache MISS for id "
                       << kernel_configuration::to_string(id_of_code_object) << "\n";
+    runtime_statistics::get().add(statistic::kernel_cache_misses);
     
     std::string compiled_binary;
     // TODO: We might want to allow JIT compilation in parallel at some point
     std::lock_guard<std::mutex> lock{_mutex};
 
-    if(!persistent_cache_lookup(id_of_binary, compiled_binary)){
-      if(!jit_compile(compiled_binary))
-        return nullptr;
+    // Another thread might have constructed the object in the meantime
+    if(auto* code_object = get_code_object_impl(id_of_code_object))
+      return code_object;
 
-      if(_is_first_jit_compilation) {
-        _is_first_jit_compilation = false;
-        HIPSYCL_DEBUG_WARNING
-            << "kernel_cache: This application run has resulted in new "
-               "binaries being JIT-compiled. This indicates that the runtime "
-               "optimization process has not yet reached peak performance. You "
-               "may want to run the application again until this warning no "
-               "longer appears to achieve optimal performance."
-            << std::endl;
+    std::string_view binary;
+    std::unique_ptr<common::filesystem::file_lock> shared_compilation_lock;
+    if(!persistent_cache_lookup(id_of_binary, binary, compiled_binary)) {
+      if(!lock_shared_jit_compilation(id_of_binary, shared_compilation_lock,
+                                      compiled_binary)) {
+        trace_span span{"JIT compile", "jit"};
+        runtime_statistics::get().add(statistic::jit_compilations);
+        statistics_timer timer{statistic::jit_compilation_time_ns};
+        if(!jit_compile(compiled_binary))
+          return nullptr;
+
+        emit_first_jit_compilation_warning();
+        persistent_cache_store(id_of_binary, compiled_binary,
+                               timer.get_elapsed_time());
       }
-      persistent_cache_store(id_of_binary, compiled_binary);
+      binary = compiled_binary;
     }
     
-    const code_object* new_object = c(compiled_binary);
+    const code_object* new_object =
+        construct_code_object(c, binary, compiled_binary);
     if(new_object)
-      _code_objects[id_of_code_object] = code_object_ptr{new_object};
+      store_code_object(id_of_code_object, new_object);
     
     return new_object;
   }
 
+  /// Like get_or_construct_jit_code_object(), but never blocks the calling
+  /// thread on JIT compilation: If the binary is neither available from a
+  /// previous background compilation nor from the persistent cache, its
+  /// compilation is scheduled on a background compiler thread and nullptr
+  /// is returned. Callers are expected to fall back to a different code object
+  /// until the binary becomes available. nullptr is also returned if background
+  /// compilation has failed.
+  ///
+  /// \c jit_compiler_factory Has signature F(), and is only invoked if
+  /// compilation needs to be scheduled. It must return a callable with signature
+  /// bool(std::string&) that carries out JIT compilation like the \c jit_compile
+  /// argument of get_or_construct_jit_code_object(). Because it is executed on
+  /// a different thread, the returned callable must not reference any state
+  /// owned by the caller.
+  template <class CodeObjectConstructor, class JitCompilerFactory>
+  const code_object *
+  get_or_schedule_jit_code_object(code_object_id id_of_code_object,
+                                  code_object_id id_of_binary,
+                                  JitCompilerFactory &&jit_compiler_factory,
+                                  CodeObjectConstructor &&c) {
+    if(auto* code_object = get_code_object(id_of_code_object)) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Cache hit for id "
+                         << kernel_configuration::to_string(id_of_code_object) << "\n";
+      runtime_statistics::get().add(statistic::kernel_cache_hits);
+      return code_object;
+    }
+    runtime_statistics::get().add(statistic::kernel_cache_misses);
+
+    std::string compiled_binary;
+    std::string_view binary;
+    std::lock_guard<std::mutex> lock{_mutex};
+
+    auto async_result = _async_jit_results.find(id_of_binary);
+    if(async_result != _async_jit_results.end()) {
+      if(async_result->second.state != async_jit_state::available)
+        return nullptr;
+      compiled_binary = async_result->second.binary;
+      binary = compiled_binary;
+    } else if(!persistent_cache_lookup(id_of_binary, binary, compiled_binary)) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Scheduling background JIT compilation "
+                            "for binary id "
+                         << kernel_configuration::to_string(id_of_binary)
+                         << "\n";
+      schedule_async_jit_compilation(id_of_binary, jit_compiler_factory());
+      return nullptr;
+    }
+
+    // Another thread might have constructed the object in the meantime
+    if(auto* code_object = get_code_object_impl(id_of_code_object))
+      return code_object;
+
+    const code_object* new_object =
+        construct_code_object(c, binary, compiled_binary);
+    if(new_object)
+      store_code_object(id_of_code_object, new_object);
+
+    return new_object;
+  }
+
+  /// Backends can store device-native binaries that the driver has generated
+  /// from a JIT-compiled binary (e.g. SPIR-V) in the persistent cache, such
+  /// that the driver does not need to finalize it again in later application
+  /// runs. \c id_of_native_binary must include everything that the native
+  /// binary depends on apart from the JIT-compiled binary, e.g. the device and
+  /// driver version, and must be distinct from the id of the JIT-compiled
+  /// binary. Unlike other member functions, these can be invoked from code
+  /// object constructors passed to get_or_construct_jit_code_object().
+  bool persistent_native_binary_lookup(code_object_id id_of_native_binary,
+                                       std::string &out) const;
+  void persistent_native_binary_store(code_object_id id_of_native_binary,
+                                      const std::string &data,
+                                      uint64_t compilation_time);
+
+  /// Stores the hardware resources used by a kernel of a JIT-compiled binary
+  /// in the appdb, such that they can be inspected with acpp-appdb-tool, and
+  /// prints them as debug output. Like the native binary functions, this can
+  /// be invoked from code object constructors.
+  void record_kernel_resource_usage(
+      code_object_id id_of_binary,
+      const common::db::kernel_resource_usage_entry &usage);
+
+  /// Repeats the JIT compilation described by a recipe from the appdb, and
+  /// stores the binary in the output string. Returns false on failure.
+  using jit_recipe_compiler = std::function<bool(
+      const common::db::jit_recipe &, code_object_id id_of_binary,
+      std::string &)>;
+
+  /// Backends can register a compiler for recipes recorded in previous
+  /// application runs, such that their binaries can be precompiled.
+  void register_jit_recipe_compiler(backend_id backend,
+                                    jit_recipe_compiler compiler);
+
+  /// JIT-compiles all binaries with recipes in the appdb that are not
+  /// present in the persistent cache and belong to a backend with registered
+  /// recipe compiler. Compilation is distributed across multiple threads;
+  /// this function returns when all binaries have been stored in the
+  /// persistent cache.
+  void precompile_recorded_binaries();
+
   // Unload entire cache and release resources to prepare runtime shutdown.
   void unload();
 
@@ -351,9 +507,63 @@ public:
   static std::string get_persistent_cache_file(code_object_id id_of_binary);
 private:
   bool persistent_cache_lookup(code_object_id id_of_binary, std::string& out) const;
-  void persistent_cache_store(code_object_id id_of_binary, const std::string& data) const;
+  // Like above, but out may refer to the mapped packed cache instead of a copy,
+  // if the entry is not compressed. Otherwise, out refers to storage.
+  bool persistent_cache_lookup(code_object_id id_of_binary,
+                               std::string_view &out,
+                               std::string &storage) const;
+
+  // binary is either a view of storage, or of the mapped packed cache. Only
+  // constructors that accept a std::string_view can use the latter without
+  // copying; see get_or_construct_jit_code_object() for their contract.
+  template <class CodeObjectConstructor>
+  static const code_object *construct_code_object(CodeObjectConstructor &c,
+                                                  std::string_view binary,
+                                                  const std::string &storage) {
+    if constexpr (std::is_invocable_v<CodeObjectConstructor &,
+                                      std::string_view>) {
+      return c(binary);
+    } else {
+      if(binary.data() == storage.data() && binary.size() == storage.size())
+        return c(storage);
+      return c(std::string{binary});
+    }
+  }
+  // compilation_time is the duration of the JIT compilation in ns, which is
+  // recorded in the appdb for analysis purposes.
+  void persistent_cache_store(code_object_id id_of_binary,
+                              const std::string &data,
+                              uint64_t compilation_time);
+  // If ACPP_RT_SHARED_JIT_COMPILATION is enabled, acquires the lock that
+  // serializes the compilation of the binary across all processes that share
+  // the persistent cache. If another process has stored the binary while this
+  // process was waiting for the lock, returns true and stores the binary in
+  // out. Otherwise, the caller is expected to compile and store the binary
+  // before releasing the lock.
+  bool lock_shared_jit_compilation(
+      code_object_id id_of_binary,
+      std::unique_ptr<common::filesystem::file_lock> &lock,
+      std::string &out) const;
+  // Schedules eviction of least recently used binaries from the persistent
+  // cache in the background, if it exceeds the configured maximum size.
+  void schedule_persistent_cache_eviction();
+  void evict_persistent_cache_entries();
+  // Returns the packed persistent cache if it is enabled, nullptr otherwise.
+  jit_cache_archive* get_packed_cache() const;
+  // Whether the binary is present in the persistent cache, given the
+  // cache filename from its appdb entry.
+  bool is_persistently_cached(code_object_id id_of_binary,
+                              const std::string &filename) const;
   
   const code_object* get_code_object_impl(code_object_id id) const;
+  // Assumes that _mutex is locked, and that no object is stored for id yet.
+  void store_code_object(code_object_id id, const code_object* obj);
+
+  using async_jit_compiler = std::function<bool(std::string &)>;
+  // Assumes that _mutex is locked.
+  void schedule_async_jit_compilation(code_object_id id_of_binary,
+                                      async_jit_compiler jit_compile);
+  void emit_first_jit_compilation_warning();
 
   template <class Constructor>
   const code_object *get_or_construct_code_object_impl(code_object_id id,
@@ -362,14 +572,16 @@ private:
     if(existing_code_object) {
       HIPSYCL_DEBUG_INFO << "kernel_cache: Cache hit for id "
                          << kernel_configuration::to_string(id) << "\n";
+      runtime_statistics::get().add(statistic::kernel_cache_hits);
       return existing_code_object;
     }
     HIPSYCL_DEBUG_INFO << "kernel_cache: Cache MISS for id "
                       << kernel_configuration::to_string(id) << "\n";
+    runtime_statistics::get().add(statistic::kernel_cache_misses);
 
     const code_object* new_object = c();
     if(new_object) {
-      _code_objects[id] = code_object_ptr{new_object};
+      store_code_object(id, new_object);
     }
     return new_object;
   }
@@ -378,8 +590,38 @@ private:
 
   ankerl::unordered_dense::map<code_object_id, code_object_ptr, rt::kernel_id_hash>
       _code_objects;
+  // Allows cache hits without locking _mutex. Modified together with
+  // _code_objects, which owns the objects.
+  common::read_mostly_map<code_object_id, const code_object,
+                          rt::kernel_id_hash>
+      _code_object_lookup;
+
+  mutable std::once_flag _packed_cache_init_flag;
+  mutable std::unique_ptr<jit_cache_archive> _packed_cache;
+
+  std::mutex _eviction_mutex;
+  std::unique_ptr<worker_thread> _eviction_worker;
+  std::atomic<bool> _is_eviction_scheduled = false;
   
   bool _is_first_jit_compilation = true;
+
+  enum class async_jit_state {
+    pending,
+    available,
+    failed
+  };
+
+  struct async_jit_result {
+    async_jit_state state = async_jit_state::pending;
+    std::string binary;
+  };
+
+  ankerl::unordered_dense::map<code_object_id, async_jit_result, rt::kernel_id_hash>
+      _async_jit_results;
+  std::vector<std::unique_ptr<worker_thread>> _async_jit_workers;
+  std::size_t _next_async_jit_worker = 0;
+
+  std::unordered_map<backend_id, jit_recipe_compiler> _jit_recipe_compilers;
 };
 
 namespace detail {
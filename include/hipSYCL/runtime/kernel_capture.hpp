@@ -0,0 +1,46 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_KERNEL_CAPTURE_HPP
+#define HIPSYCL_KERNEL_CAPTURE_HPP
+
+#include "hipSYCL/glue/kernel_launcher_data.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+class dag_node;
+
+/// Whether ACPP_RT_KERNEL_CAPTURE selects kernels for capture.
+bool is_kernel_capture_enabled();
+
+/// Captures the launch of an SSCP kernel into ACPP_RT_KERNEL_CAPTURE_DIRECTORY
+/// if it is the first launch of a kernel whose name contains
+/// ACPP_RT_KERNEL_CAPTURE. Must be invoked after embedded pointers have been
+/// initialized and before the kernel is submitted. Waits for the requirements
+/// of node, such that the captured memory contents are those that the
+/// kernel observes. The capture can be replayed with acpp-replay, see
+/// kernel_replay.
+///
+/// Only memory of allocations that are tracked by runtime_statistics, i.e.
+/// USM allocations and device allocations of buffers, is captured, and only
+/// if the kernel receives a pointer to it as a pointer argument. Pointers
+/// stored in captured memory are not relocated on replay.
+void capture_kernel_launch(const glue::kernel_launcher_data &launch_config,
+                           dag_node *node,
+                           const kernel_configuration &config,
+                           const range<3> &group_size);
+
+}
+}
+
+#endif
@@ -39,7 +39,9 @@ enum class kernel_base_config_parameter : int {
   target_arch = 3,
   runtime_device = 4,
   runtime_context = 5,
-  single_kernel = 6
+  single_kernel = 6,
+  runtime_device_name = 7,
+  runtime_driver_version = 8
 };
 
 enum class kernel_build_option : int {
@@ -55,7 +57,9 @@ enum class kernel_build_option : int {
   amdgpu_rocm_device_libs_path,
   amdgpu_rocm_path,
 
-  spirv_dynamic_local_mem_allocation_size
+  spirv_dynamic_local_mem_allocation_size,
+
+  host_sub_group_size
 };
 
 enum class kernel_build_flag : int {
@@ -66,7 +70,28 @@ enum class kernel_build_flag : int {
   ptx_approx_div,
   ptx_approx_sqrt,
 
-  spirv_enable_intel_llvm_spirv_options
+  spirv_enable_intel_llvm_spirv_options,
+
+  // Only run a cheap optimization pipeline to reduce compile time
+  fast_compile,
+
+  // Stage overlapping global memory reads in local memory
+  local_memory_tiling,
+
+  // Combine relaxed global atomic additions to the same address within
+  // sub-groups
+  aggregate_atomics,
+
+  // Print remarks about uncoalesced memory accesses, bank conflicts and
+  // divergent branches
+  performance_remarks,
+
+  // Pad rows of local memory that is accessed column-wise to avoid bank
+  // conflicts
+  local_memory_padding,
+
+  // Generate a relocatable object in-process instead of a shared library
+  host_relocatable_object
 };
 
 
@@ -152,24 +177,103 @@ public:
     s2_ir_configuration_entry entry{config_parameter_name, value};
     for(int i = 0; i < _s2_ir_configurations.size(); ++i) {
       if(_s2_ir_configurations[i].get_name() == config_parameter_name) {
+        // Entries are combined with xor, so hashing the old entry again removes it
+        add_s2_ir_entry_to_hash(_s2_ir_configurations[i]);
+        add_s2_ir_entry_to_hash(entry);
         _s2_ir_configurations[i] = entry;
         return;
       }
     }
+    add_s2_ir_entry_to_hash(entry);
     _s2_ir_configurations.push_back(entry);
   }
 
   void set_specialized_kernel_argument(int param_index, uint64_t buffer_value) {
+    add_indexed_entry_to_hash(param_index, 34, &buffer_value, sizeof(buffer_value));
     _specialized_kernel_args.push_back(
         std::make_pair(param_index, buffer_value));
   }
 
+  /// Asserts that the pointer passed as kernel argument is aligned
+  /// to the given number of bytes
+  void set_kernel_pointer_argument_alignment(int param_index, uint64_t alignment) {
+    add_indexed_entry_to_hash(param_index, 36, &alignment, sizeof(alignment));
+    _pointer_arg_alignments.push_back(std::make_pair(param_index, alignment));
+  }
+
+  /// Asserts that the pointer passed as kernel argument does not alias
+  /// with memory accessed through other pointers
+  void set_kernel_pointer_argument_noalias(int param_index) {
+    add_indexed_entry_to_hash(param_index, 37, "", 0);
+    _noalias_pointer_args.push_back(param_index);
+  }
+
+  /// Asserts that the integer kernel argument is smaller than
+  /// upper_bound when interpreted as unsigned value
+  void set_kernel_argument_upper_bound(int param_index, uint64_t upper_bound) {
+    add_indexed_entry_to_hash(param_index, 38, &upper_bound, sizeof(upper_bound));
+    _arg_upper_bounds.push_back(std::make_pair(param_index, upper_bound));
+  }
+
+  /// Asserts that the integer kernel argument is a multiple of divisor,
+  /// which must be a power of two
+  void set_kernel_argument_divisor(int param_index, uint64_t divisor) {
+    add_indexed_entry_to_hash(param_index, 39, &divisor, sizeof(divisor));
+    _arg_divisors.push_back(std::make_pair(param_index, divisor));
+  }
+
+  /// Instruments the kernel to count taken branches in num_counters
+  /// uint64_t counters at the given address, which must remain
+  /// accessible from the device as long as the binary is used.
+  void set_branch_profile_counters(uint64_t address, std::size_t num_counters) {
+    if(_branch_profile_counters_address != 0)
+      add_indexed_entry_to_hash(0, 40, &_branch_profile_counters_address,
+                                sizeof(_branch_profile_counters_address));
+    _branch_profile_counters_address = address;
+    _num_branch_profile_counters = num_counters;
+    if(_branch_profile_counters_address != 0)
+      add_indexed_entry_to_hash(0, 40, &_branch_profile_counters_address,
+                                sizeof(_branch_profile_counters_address));
+  }
+
+  /// Optimizes the kernel based on branch counters recorded by a kernel
+  /// instrumented with set_branch_profile_counters()
+  void set_branch_profile(const std::vector<uint64_t>& profile) {
+    if(!_branch_profile.empty())
+      add_indexed_entry_to_hash(0, 41, _branch_profile.data(),
+                                _branch_profile.size() * sizeof(uint64_t));
+    _branch_profile = profile;
+    if(!_branch_profile.empty())
+      add_indexed_entry_to_hash(0, 41, _branch_profile.data(),
+                                _branch_profile.size() * sizeof(uint64_t));
+  }
+
+  /// The hash of the function call specialization config is captured here,
+  /// so the config must not change afterwards.
   void set_function_call_specialization_config(
       int param_index, glue::sscp::fcall_config_kernel_property_t config) {
+    uint64_t config_id = config.value->unique_hash;
+    add_indexed_entry_to_hash(_function_call_specializations.size(), 35,
+                              &config_id, sizeof(config_id));
     _function_call_specializations.push_back(config);
   }
 
+  /// Dispatches function calls at runtime based on the address of the
+  /// function call specialization config passed as kernel argument, such
+  /// that a single binary supports all candidate configurations.
+  void set_function_call_inline_cache(
+      int param_index,
+      const std::vector<glue::sscp::fcall_inline_cache_candidate> &candidates) {
+    for(const auto& c : candidates) {
+      uint64_t data[2] = {c.selector, c.config->unique_hash};
+      add_indexed_entry_to_hash(param_index, 42, data, sizeof(data));
+    }
+    _function_call_inline_caches.push_back(std::make_pair(param_index, candidates));
+  }
+
   void set_build_option(kernel_build_option option, const std::string& value) {
+    add_indexed_entry_to_hash(static_cast<uint64_t>(option), 32, value.data(),
+                              value.size());
     int_or_string ios;
     ios.string_value = value;
     _build_options.push_back(std::make_pair(option, ios));
@@ -177,8 +281,11 @@ public:
 
   template<class T, std::enable_if_t<std::is_unsigned_v<T>, int> = 0>
   void set_build_option(kernel_build_option option, T int_value) {
+    uint64_t numeric_value = static_cast<uint64_t>(int_value);
+    add_indexed_entry_to_hash(static_cast<uint64_t>(option), 32, &numeric_value,
+                              sizeof(numeric_value));
     int_or_string ios;
-    ios.int_value = static_cast<uint64_t>(int_value);
+    ios.int_value = numeric_value;
     _build_options.push_back(std::make_pair(option, ios));
   }
 
@@ -188,13 +295,14 @@ public:
   }
 
   void set_build_flag(kernel_build_flag flag) {
+    add_indexed_entry_to_hash(static_cast<uint64_t>(flag), 33, "", 0);
     _build_flags.push_back(flag);
   }
 
   template <class ValueT>
   void append_base_configuration(kernel_base_config_parameter key,
                                  const ValueT &value) {
-    add_entry_to_hash(_base_configuration_result, data_ptr(key), data_size(key),
+    add_entry_to_hash(_id, data_ptr(key), data_size(key),
                       data_ptr(value), data_size(value));
   }
 
@@ -208,48 +316,10 @@ public:
     return std::to_string(id[0])+"."+std::to_string(id[1]);
   }
 
+  /// The id is updated whenever the configuration is modified,
+  /// so this is cheap.
   id_type generate_id() const {
-    id_type result = _base_configuration_result;
-
-    for(const auto& entry : _s2_ir_configurations) {
-      add_entry_to_hash(result, entry.get_name().data(),
-                        entry.get_name().size(), entry.get_data_buffer(),
-                        entry.get_data_size());
-    }
-
-    for(const auto& entry : _build_options) {
-      uint64_t numeric_option_id = static_cast<uint64_t>(entry.first) | (1ull << 32);
-      if(entry.second.int_value.has_value()) {
-        auto numeric_value = entry.second.int_value.value();
-        add_entry_to_hash(result, &numeric_option_id, sizeof(numeric_option_id),
-                        &numeric_value, sizeof(numeric_value));
-      } else {
-        const std::string& string_value = entry.second.string_value.value();
-        add_entry_to_hash(result, &numeric_option_id, sizeof(numeric_option_id),
-                        string_value.data(), string_value.size());
-      }
-    }
-
-    for(const auto& entry : _build_flags) {
-      uint64_t numeric_flag_id = static_cast<uint64_t>(entry) | (1ull << 33);
-      add_entry_to_hash(result, &numeric_flag_id, sizeof(numeric_flag_id),
-                        "", 0);
-    }
-
-    for(const auto& entry : _specialized_kernel_args) {
-      uint64_t numeric_option_id = static_cast<uint64_t>(entry.first) | (1ull << 34);
-      add_entry_to_hash(result, &numeric_option_id, sizeof(numeric_option_id),
-                        &entry.second, sizeof(entry.second));
-    }
-
-    for(int i = 0; i < _function_call_specializations.size(); ++i) {
-      uint64_t numeric_option_id = static_cast<uint64_t>(i) | (1ull << 35);
-      uint64_t config_id = _function_call_specializations[i].value->unique_hash;
-      add_entry_to_hash(result, &numeric_option_id, sizeof(numeric_option_id),
-                        &config_id, sizeof(config_id));
-    }
-
-    return result;
+    return _id;
   }
 
   const auto& s2_ir_entries() const {
@@ -268,10 +338,42 @@ public:
     return _specialized_kernel_args;
   }
 
+  const auto& pointer_argument_alignments() const {
+    return _pointer_arg_alignments;
+  }
+
+  const auto& noalias_pointer_arguments() const {
+    return _noalias_pointer_args;
+  }
+
+  const auto& argument_upper_bounds() const {
+    return _arg_upper_bounds;
+  }
+
+  const auto& argument_divisors() const {
+    return _arg_divisors;
+  }
+
+  uint64_t branch_profile_counters_address() const {
+    return _branch_profile_counters_address;
+  }
+
+  std::size_t num_branch_profile_counters() const {
+    return _num_branch_profile_counters;
+  }
+
+  const auto& branch_profile() const {
+    return _branch_profile;
+  }
+
   const auto& function_call_specialization_config() const {
     return _function_call_specializations;
   }
 
+  const auto& function_call_inline_caches() const {
+    return _function_call_inline_caches;
+  }
+
 private:
   static const void* data_ptr(const char* data) {
     return data_ptr(std::string{data});
@@ -327,15 +429,40 @@ private:
     hash[entry_hash % hash.size()] ^= entry_hash;
   }
 
+  void add_s2_ir_entry_to_hash(const s2_ir_configuration_entry& entry) {
+    add_entry_to_hash(_id, entry.get_name().data(), entry.get_name().size(),
+                      entry.get_data_buffer(), entry.get_data_size());
+  }
+
+  // Entry kinds are distinguished by setting the bit at position kind_bit
+  // in the key (e.g. option, flag or parameter index).
+  void add_indexed_entry_to_hash(uint64_t index, int kind_bit, const void *data,
+                                 std::size_t data_size) {
+    uint64_t numeric_id = index | (1ull << kind_bit);
+    add_entry_to_hash(_id, &numeric_id, sizeof(numeric_id), data, data_size);
+  }
+
 
   std::vector<s2_ir_configuration_entry> _s2_ir_configurations;
   std::vector<kernel_build_flag> _build_flags;
   std::vector<std::pair<kernel_build_option, int_or_string>> _build_options;
   std::vector<std::pair<int, uint64_t>> _specialized_kernel_args;
+  std::vector<std::pair<int, uint64_t>> _pointer_arg_alignments;
+  std::vector<int> _noalias_pointer_args;
+  std::vector<std::pair<int, uint64_t>> _arg_upper_bounds;
+  std::vector<std::pair<int, uint64_t>> _arg_divisors;
+  uint64_t _branch_profile_counters_address = 0;
+  std::size_t _num_branch_profile_counters = 0;
+  std::vector<uint64_t> _branch_profile;
   std::vector<glue::sscp::fcall_config_kernel_property_t>
       _function_call_specializations;
+  std::vector<
+      std::pair<int, std::vector<glue::sscp::fcall_inline_cache_candidate>>>
+      _function_call_inline_caches;
 
-  id_type _base_configuration_result = {};
+  // Entries are combined with xor, so it does not depend on the order of
+  // entries of different kinds and can be updated incrementally.
+  id_type _id = {};
 };
 
 struct kernel_id_hash{
@@ -124,6 +124,25 @@ public:
   const kernel_configuration& get_kernel_configuration() const {
     return _kernel_config;
   }
+
+  kernel_configuration& get_kernel_configuration() {
+    return _kernel_config;
+  }
+
+  const glue::kernel_launcher_data& get_static_data() const {
+    return _static_data;
+  }
+
+  /// Whether this launches a custom operation, i.e. a host task enqueued
+  /// with AdaptiveCpp_enqueue_custom_operation(), instead of a kernel
+  bool is_custom_operation() const {
+    if(_static_data.custom_op)
+      return true;
+    for(const auto& backend_launcher : _kernels)
+      if(backend_launcher->get_kernel_type() == kernel_type::custom)
+        return true;
+    return false;
+  }
 private:
   
   common::auto_small_vector<std::unique_ptr<backend_kernel_launcher>>
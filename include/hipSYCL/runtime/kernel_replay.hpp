@@ -0,0 +1,150 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_KERNEL_REPLAY_HPP
+#define HIPSYCL_KERNEL_REPLAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/glue/kernel_launcher_data.hpp"
+#include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/util.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+class backend_executor;
+class runtime;
+
+/// Memory that a captured kernel accesses through a pointer argument
+struct kernel_capture_allocation {
+  // Address of the allocation in the capturing process
+  uint64_t address = 0;
+  uint64_t size = 0;
+  // allocation_kind of the allocation
+  int kind = 0;
+  // Contents of the allocation before the kernel was launched
+  std::string contents;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(address);
+    pack(size);
+    pack(kind);
+    pack(contents);
+  }
+};
+
+struct kernel_capture_pointer_argument {
+  // Byte offset of the pointer in the kernel arguments
+  uint64_t arg_offset = 0;
+  // Index into kernel_capture_record::allocations
+  uint64_t allocation = 0;
+  // Byte offset of the pointer within the allocation
+  uint64_t allocation_offset = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(arg_offset);
+    pack(allocation);
+    pack(allocation_offset);
+  }
+};
+
+/// Everything needed to repeat a launch of an SSCP kernel outside of the
+/// application, see ACPP_RT_KERNEL_CAPTURE and acpp-replay.
+struct kernel_capture_record {
+  std::string kernel_name;
+  uint64_t hcf_object = 0;
+  // Serialized HCF container of the kernel
+  std::string hcf;
+  int backend = 0;
+  int device_index = 0;
+  // Launch geometry, with flipped indices as in glue::kernel_launcher_data
+  std::vector<uint64_t> global_size;
+  std::vector<uint64_t> group_size;
+  uint64_t local_mem_size = 0;
+  std::string kernel_args;
+  std::vector<kernel_capture_pointer_argument> pointer_args;
+  std::vector<kernel_capture_allocation> allocations;
+  // Build options and flags of the kernel_configuration of the launch. Not
+  // valid if the configuration cannot be restored, e.g. because it
+  // contains S2 IR constants.
+  common::db::jit_recipe configuration;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(kernel_name);
+    pack(hcf_object);
+    pack(hcf);
+    pack(backend);
+    pack(device_index);
+    pack(global_size);
+    pack(group_size);
+    pack(local_mem_size);
+    pack(kernel_args);
+    pack(pointer_args);
+    pack(allocations);
+    pack(configuration);
+  }
+};
+
+result read_kernel_capture(const std::string &filename,
+                           kernel_capture_record &out);
+
+/// Repeats a captured kernel launch on the device that it was captured on.
+class kernel_replay {
+public:
+  /// config replaces the configuration of the captured launch, e.g.
+  /// to compare build options.
+  kernel_replay(runtime *rt, const kernel_capture_record &record,
+                const kernel_configuration &config);
+  ~kernel_replay();
+
+  kernel_replay(const kernel_replay &) = delete;
+  kernel_replay &operator=(const kernel_replay &) = delete;
+
+  /// Registers the HCF of the kernel and uploads the captured memory.
+  result init();
+  /// Uploads the captured memory again, e.g. because a previous launch has
+  /// modified it.
+  result restore_memory();
+  /// Launches the kernel and waits for it to complete.
+  result launch();
+
+  device_id get_device() const { return _dev; }
+
+private:
+  result copy(device_id dest_dev, void *dest, device_id src_dev,
+              const void *src, std::size_t bytes);
+
+  runtime *_rt;
+  const kernel_capture_record &_record;
+  kernel_configuration _config;
+  device_id _dev;
+  std::vector<void *> _allocations;
+  std::unique_ptr<backend_executor> _executor;
+  hcf_object_id _hcf_object = 0;
+  bool _is_hcf_registered = false;
+  glue::kernel_launcher_data _launch_data;
+};
+
+}
+}
+
+#endif
@@ -107,12 +107,29 @@ private:
 class multi_queue_executor : public backend_executor
 {
 public:
+  // Creates a queue for the device with the given priority. As for
+  // backend::create_inorder_executor(), it is backend-specific if or how
+  // the priority affects execution.
   using queue_factory_function =
-      std::function<std::unique_ptr<inorder_queue>(device_id)>;
-
+      std::function<std::unique_ptr<inorder_queue>(device_id, int priority)>;
+
+  // If direction_aware_memcpy_lanes is true, host-to-device,
+  // device-to-host and device-to-device copies are assigned to separate
+  // lanes, such that they do not serialize on the same queue and can use
+  // different copy engines concurrently.
+  // If high_priority_lane is true, an additional kernel lane with the
+  // highest priority is created for kernels of queues with
+  // hints::execution_priority < 0. This lane is also created if
+  // ACPP_RT_CRITICAL_PATH_SCHEDULING is enabled.
+  // If num_host_task_lanes is nonzero, that many additional lanes are
+  // created exclusively for custom operations, such that independent
+  // custom operations do not serialize with each other or with kernels.
   multi_queue_executor(
       const backend& b,
-      queue_factory_function queue_factory);
+      queue_factory_function queue_factory,
+      bool direction_aware_memcpy_lanes = false,
+      bool high_priority_lane = false,
+      std::size_t num_host_task_lanes = 0);
 
   virtual ~multi_queue_executor() {}
 
@@ -141,6 +158,10 @@ public:
   virtual bool can_execute_on_device(const device_id& dev) const override;
   virtual bool is_submitted_by_me(const dag_node_ptr& node) const override;
 
+  virtual result register_completion_callback(const dag_node_ptr &node,
+                                              void (*callback)(void *),
+                                              void *user_data) override;
+
   bool find_assigned_lane_index(const dag_node_ptr& node, std::size_t& index_out) const;
 private:
   
@@ -148,15 +169,37 @@ private:
   struct per_device_data
   {
     backend_execution_lane_range memcpy_lanes;
+    // With direction-aware memcpy lanes, memcpy_lanes is divided into
+    // these sub-ranges.
+    bool has_direction_aware_memcpy_lanes = false;
+    backend_execution_lane_range host_to_device_lanes;
+    backend_execution_lane_range device_to_host_lanes;
+    backend_execution_lane_range device_to_device_lanes;
     backend_execution_lane_range kernel_lanes;
+    // Lanes for custom operations; empty if custom operations are
+    // executed on the kernel lanes.
+    backend_execution_lane_range host_task_lanes{0, 0};
+    // High-priority lane for kernels of high-priority queues and
+    // kernels on the critical path, see ACPP_RT_CRITICAL_PATH_SCHEDULING
+    bool has_high_priority_lane = false;
+    std::size_t high_priority_lane = 0;
     std::vector<std::unique_ptr<inorder_executor>> executors;
 
     moving_statistics submission_statistics;
   };
 
+  // The lanes that op, which must be a data transfer, can be assigned to
+  static backend_execution_lane_range
+  get_memcpy_lanes(const per_device_data &data, operation *op);
+  // Whether op is a custom operation that can use the host task lanes
+  static bool is_host_task(operation *op);
+  // Whether node should be executed on the high-priority lane
+  bool is_high_priority(const dag_node_ptr& node) const;
+
   std::vector<per_device_data> _device_data;
   std::vector<inorder_queue*> _managed_queues;
   backend_id _backend;
+  bool _use_critical_path_lane;
 };
 
 template<class Executor>
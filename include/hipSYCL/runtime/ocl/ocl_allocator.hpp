@@ -23,7 +23,7 @@ class ocl_allocator : public backend_allocator
 {
 public:
   ocl_allocator() = default;
-  ocl_allocator(ocl_usm* usm_provier);
+  ocl_allocator(ocl_usm* usm_provier, device_id dev);
 
   virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
 
@@ -42,6 +42,7 @@ public:
 
 private:
   ocl_usm* _usm;
+  device_id _dev;
 };
 
 }
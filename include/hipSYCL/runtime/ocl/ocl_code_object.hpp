@@ -11,7 +11,11 @@
 #ifndef HIPSYCL_OCL_CODE_OBJECT_HPP
 #define HIPSYCL_OCL_CODE_OBJECT_HPP
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <CL/opencl.hpp>
 
@@ -45,12 +49,40 @@ private:
   ocl_queue* _queue;
 };
 
+class ocl_usm;
+
+/// A kernel object that is used by at most one submission at a time.
+/// Remembers the arguments that have been set, such that arguments that
+/// do not change between launches are not set again.
+class ocl_kernel_instance {
+public:
+  ocl_kernel_instance(const cl::Kernel &kernel, std::string_view kernel_name);
+
+  cl::Kernel& get_kernel() { return _kernel; }
+  std::string_view get_kernel_name() const { return _kernel_name; }
+
+  // value may be nullptr for local memory arguments
+  cl_int set_argument(std::size_t index, std::size_t size, const void *value);
+  cl_int enable_indirect_usm_access(ocl_usm *usm);
+private:
+  struct argument {
+    bool is_set = false;
+    bool is_null = false;
+    std::vector<char> value;
+  };
+
+  cl::Kernel _kernel;
+  std::string_view _kernel_name;
+  bool _has_indirect_usm_access = false;
+  std::vector<argument> _arguments;
+};
 
 class ocl_executable_object : public code_object {
 public:
   ocl_executable_object(const cl::Context &ctx, cl::Device &dev,
                         hcf_object_id source, const std::string &code_image,
-                        const kernel_configuration &config);
+                        const kernel_configuration &config,
+                        const kernel_configuration::id_type &native_binary_id);
   virtual ~ocl_executable_object();
 
   result get_build_result() const;
@@ -71,16 +103,38 @@ public:
   cl::Device get_cl_device() const;
   cl::Context get_cl_context() const;
 
-  // Only works if the module has been built successfully
-  result get_kernel(std::string_view name, cl::Kernel& out) const;
+  // Only works if the module has been built successfully.
+  // The returned kernel must be handed back using release_kernel() once
+  // the kernel launch has been enqueued.
+  result acquire_kernel(std::string_view name,
+                        ocl_kernel_instance *&out) const;
+  void release_kernel(ocl_kernel_instance *kernel) const;
 private:
+  struct kernel_pool {
+    // Never used for launches, such that it can be cloned without
+    // racing with concurrent argument updates
+    cl::Kernel prototype;
+    std::vector<std::unique_ptr<ocl_kernel_instance>> instances;
+    std::vector<ocl_kernel_instance *> available;
+  };
+
+  result create_kernel_instance(std::string_view name,
+                                kernel_pool &pool) const;
+  // Builds _program from the native binary in the persistent cache,
+  // if available.
+  bool load_native_binary(const kernel_configuration::id_type &native_binary_id,
+                          const std::string &options);
+  void store_native_binary(const kernel_configuration::id_type &native_binary_id,
+                           uint64_t build_time);
+
   hcf_object_id _source;
   cl::Context _ctx;
   cl::Device _dev;
   cl::Program _program;
   
   std::vector<std::string> _kernel_names;
-  std::unordered_map<std::string_view, cl::Kernel> _kernel_handles;
+  mutable std::mutex _kernel_pool_mutex;
+  mutable std::unordered_map<std::string_view, kernel_pool> _kernel_pools;
 
   result _build_status;
   kernel_configuration::id_type _id;
@@ -13,6 +13,7 @@
 
 #include <CL/opencl.hpp>
 #include <mutex>
+#include <vector>
 
 #include "../executor.hpp"
 #include "../inorder_queue.hpp"
@@ -60,6 +61,9 @@ public:
 
   virtual result query_status(inorder_queue_status& status) override;
 
+  virtual result submit_completion_callback(void (*callback)(void *),
+                                            void *user_data) override;
+
   ocl_hardware_manager* get_hardware_manager() const;
 
   result submit_sscp_kernel_from_code_object(
@@ -71,13 +75,18 @@ public:
       const kernel_configuration &config);
 
 private:
-  void register_submitted_op(cl::Event);
+  std::shared_ptr<dag_node_event>
+  register_submitted_op(cl::Event, bool is_queue_wide = false);
+  // In out-of-order mode, returns the events of the requirements of node
+  // that have been submitted to this queue. Empty in in-order mode.
+  std::vector<cl::Event> get_same_lane_dependencies(const dag_node_ptr& node) const;
 
   // These member variables have to be thread-safe.
   ocl_hardware_manager* _hw_manager;
   const std::size_t _device_index;
 
   cl::CommandQueue _queue;
+  bool _is_out_of_order;
   ocl_sscp_code_object_invoker _sscp_invoker;
   worker_thread _host_worker;
 
@@ -91,13 +100,24 @@ private:
       return _most_recent_event;
     }
 
+    // is_queue_wide is set to whether the event covers all operations
+    // submitted so far, which is not the case for ordinary operations
+    // in out-of-order queues.
+    auto get_most_recent_event(bool& is_queue_wide) const {
+      std::lock_guard<std::mutex> lock {_mutex};
+      is_queue_wide = _is_most_recent_event_queue_wide;
+      return _most_recent_event;
+    }
+
     template<class T>
-    void set_most_recent_event(const T& x) {
+    void set_most_recent_event(const T& x, bool is_queue_wide) {
       std::lock_guard<std::mutex> lock {_mutex};
       _most_recent_event = x;
+      _is_most_recent_event_queue_wide = is_queue_wide;
     }
   private:
     std::shared_ptr<dag_node_event> _most_recent_event = nullptr;
+    bool _is_most_recent_event_queue_wide = false;
     mutable std::mutex _mutex;
   };
 
@@ -107,6 +127,8 @@ private:
   common::spin_lock _sscp_submission_spin_lock;
   glue::jit::cxx_argument_mapper _arg_mapper;
   kernel_configuration _config;
+  // Wait list of the kernel that is currently being submitted
+  std::vector<cl::Event> _kernel_dependencies;
 };
 
 }
@@ -12,6 +12,11 @@
 #define HIPSYCL_OMP_ALLOCATOR_HPP
 
 #include "../allocator.hpp"
+#include "../settings.hpp"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace hipsycl {
 namespace rt {
@@ -19,7 +24,10 @@ namespace rt {
 class omp_allocator : public backend_allocator 
 {
 public:
-  omp_allocator(const device_id &my_device);
+  /// If \c bound_cpus is non-empty, the device is a NUMA sub-device and
+  /// large allocations are placed on the memory of these CPUs.
+  omp_allocator(const device_id &my_device,
+                std::vector<int> bound_cpus = {});
   
   virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
 
@@ -36,8 +44,21 @@ public:
 
   virtual result mem_advise(const void *addr, std::size_t num_bytes,
                             int advise) const override;
+
+  virtual bool can_alias_host_memory(const void *ptr,
+                                     size_t min_alignment) const override;
 private:
+  // NUMA placement of large allocations
+  void place_pages(void *ptr, size_t size_bytes) const;
+
   device_id _my_device;
+  std::vector<int> _bound_cpus;
+
+  omp_huge_page_policy _huge_page_policy;
+  bool _use_pinned_memory;
+  // Allocations that were mapped with mmap(), and their mapped size
+  std::unordered_map<void *, std::size_t> _mapped_allocations;
+  std::mutex _mapped_allocations_mutex;
 };
 
 }
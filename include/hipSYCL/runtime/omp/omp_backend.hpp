@@ -16,6 +16,9 @@
 #include "omp_allocator.hpp"
 #include "omp_hardware_manager.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace hipsycl {
 namespace rt {
 
@@ -40,8 +43,9 @@ public:
   std::unique_ptr<backend_executor>
   create_inorder_executor(device_id dev, int priority) override;
 private:
-  mutable omp_allocator _allocator;
   mutable omp_hardware_manager _hw;
+  // One allocator per device index, including sub-devices
+  mutable std::vector<std::unique_ptr<omp_allocator>> _allocators;
   mutable lazily_constructed_executor<multi_queue_executor> _executor;
 };
 
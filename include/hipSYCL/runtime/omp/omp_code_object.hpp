@@ -11,6 +11,7 @@
 #ifndef HIPSYCL_OMP_CODE_OBJECT_HPP
 #define HIPSYCL_OMP_CODE_OBJECT_HPP
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -22,6 +23,9 @@
 
 
 namespace hipsycl {
+namespace compiler {
+class LoadedHostObject;
+}
 namespace rt {
 
 class omp_sscp_executable_object : public code_object {
@@ -61,6 +65,8 @@ public:
   supported_backend_kernel_names() const override;
   virtual bool contains(const std::string &backend_kernel_name) const override;
 
+  // Returns the handle of the shared library, or the loaded relocatable
+  // object
   virtual void *get_module() const;
   virtual omp_sscp_kernel *get_kernel(std::string_view backend_kernel_name) const;
 
@@ -72,7 +78,9 @@ private:
   std::string _kernel_cache_path;
 
   result _build_result;
+  // Either the shared library, or the relocatable object is loaded
   void *_module;
+  std::unique_ptr<compiler::LoadedHostObject> _relocatable_object;
 
   std::vector<std::string> _kernel_names;
   std::unordered_map<std::string_view, omp_sscp_kernel*> _kernels;
@@ -13,12 +13,19 @@
 
 #include "../hardware.hpp"
 
+#include <vector>
+
 namespace hipsycl {
 namespace rt {
 
 class omp_hardware_context : public hardware_context
 {
 public:
+  /// Constructs the root device, which uses all CPUs
+  explicit omp_hardware_context(std::size_t num_sub_devices);
+  /// Constructs the sub-device of the given NUMA node
+  omp_hardware_context(std::size_t numa_node, const std::vector<int> &cpus);
+
   virtual bool is_cpu() const override;
   virtual bool is_gpu() const override;
 
@@ -41,18 +48,38 @@ public:
   virtual std::string get_profile() const override;
 
   virtual ~omp_hardware_context() {}
+
+  bool is_sub_device() const { return _is_sub_device; }
+  /// CPUs that kernels of a sub-device are bound to. Empty for the root
+  /// device.
+  const std::vector<int> &get_bound_cpus() const { return _bound_cpus; }
+private:
+  bool _is_sub_device;
+  std::size_t _numa_node;
+  std::size_t _num_sub_devices;
+  std::vector<int> _bound_cpus;
 };
 
+/// Exposes a single root device. If the system has multiple NUMA nodes,
+/// each node is additionally available as sub-device of the root device.
 class omp_hardware_manager : public backend_hardware_manager
 {
 public:
+  omp_hardware_manager();
+
   virtual std::size_t get_num_devices() const override;
   virtual hardware_context *get_device(std::size_t index) override;
   virtual device_id get_device_id(std::size_t index) const override;
 
+  virtual std::size_t get_num_device_indices() const override;
+  virtual std::vector<std::size_t>
+  get_sub_devices(std::size_t index) const override;
+  virtual std::size_t get_parent_device(std::size_t index) const override;
+
   virtual ~omp_hardware_manager(){}
 private:
-  omp_hardware_context _device;
+  // Index 0 is the root device, followed by the sub-devices
+  std::vector<omp_hardware_context> _devices;
 };
 
 } // namespace rt
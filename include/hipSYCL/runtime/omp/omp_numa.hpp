@@ -0,0 +1,66 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_OMP_NUMA_HPP
+#define HIPSYCL_OMP_NUMA_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// NUMA nodes and the CPUs of each node that the process may run on.
+/// On systems where the topology cannot be determined, all CPUs are
+/// treated as a single node.
+class omp_numa_topology {
+public:
+  static const omp_numa_topology& get();
+
+  std::size_t get_num_nodes() const { return _node_cpus.size(); }
+  const std::vector<int> &get_cpus(std::size_t node) const {
+    return _node_cpus[node];
+  }
+  /// CPUs of all nodes, ordered by node. In NUMA mode, OpenMP thread i
+  /// is pinned to the i-th CPU of this list (modulo its size), such that
+  /// consecutive threads share a node.
+  const std::vector<int> &get_ordered_cpus() const { return _ordered_cpus; }
+
+private:
+  omp_numa_topology();
+
+  std::vector<std::vector<int>> _node_cpus;
+  std::vector<int> _ordered_cpus;
+};
+
+/// Whether the NUMA mode of the OpenMP backend is enabled
+bool is_omp_numa_mode_enabled();
+
+/// Pins the calling thread to the given CPU. Returns false if
+/// this is unsupported or fails.
+bool omp_pin_current_thread(int cpu);
+
+/// Pins each thread of a subsequent OpenMP team of the calling thread to
+/// the CPU that corresponds to its thread id in \c cpus (modulo its size).
+/// The calling thread itself is only pinned if \c pin_master is true.
+void omp_numa_pin_team(const std::vector<int> &cpus, bool pin_master);
+
+/// Touches the pages of the given allocation from an OpenMP team of
+/// \c num_threads threads (or the default team size if 0) that is bound
+/// to \c cpus like in omp_numa_pin_team(). Pages are touched using a static
+/// schedule, such that they are placed on the NUMA node of the thread that
+/// processes the corresponding part of the allocation in kernels.
+void omp_numa_first_touch(void *ptr, std::size_t bytes,
+                          const std::vector<int> &cpus, int num_threads = 0);
+
+}
+}
+
+#endif
@@ -17,6 +17,10 @@
 #include "../device_id.hpp"
 #include "hipSYCL/common/spin_lock.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "omp_schedule.hpp"
+
+#include <unordered_map>
+#include <vector>
 
 namespace hipsycl {
 namespace rt {
@@ -40,8 +44,10 @@ public:
                                const rt::hcf_kernel_info* kernel_info,
                                const kernel_configuration& config) override;
   
-  virtual rt::range<3> select_group_size(const rt::range<3> &num_groups,
-                                         const rt::range<3> &group_size) const override;
+  virtual rt::range<3>
+  select_group_size(const rt::range<3> &num_groups,
+                    const rt::range<3> &group_size, hcf_object_id hcf_object,
+                    std::string_view kernel_name) const override;
 
 private:
   omp_queue* _queue;
@@ -50,7 +56,9 @@ private:
 class omp_queue : public inorder_queue
 {
 public:
-  omp_queue(backend_id id);
+  /// If \c bound_cpus is non-empty, kernels are executed by a team of
+  /// threads pinned to these CPUs, e.g. for NUMA sub-devices.
+  omp_queue(device_id dev, std::vector<int> bound_cpus = {});
   virtual ~omp_queue();
 
   /// Inserts an event into the stream
@@ -74,6 +82,9 @@ public:
 
   virtual result query_status(inorder_queue_status& status) override;
 
+  virtual result submit_completion_callback(void (*callback)(void *),
+                                            void *user_data) override;
+
   result submit_sscp_kernel_from_code_object(
       const kernel_operation &op, hcf_object_id hcf_object,
       const std::string_view kernel_name,
@@ -84,8 +95,12 @@ public:
 
   worker_thread& get_worker();
 private:
+  bool can_execute_inline(const kernel_operation& op) const;
+
   const backend_id _backend_id;
+  const device_id _device;
   worker_thread _worker;
+  std::size_t _inline_kernel_max_work_items;
 
   omp_sscp_code_object_invoker _sscp_code_object_invoker;
   std::shared_ptr<kernel_cache> _kernel_cache;
@@ -94,6 +109,8 @@ private:
   common::spin_lock _sscp_submission_spin_lock;
   glue::jit::cxx_argument_mapper _arg_mapper;
   kernel_configuration _config;
+  // For ACPP_RT_OMP_AUTO_DYNAMIC_SCHEDULE, indexed by kernel function
+  std::unordered_map<const void*, omp_schedule_selector> _sscp_schedule_selectors;
 };
 
 }
@@ -0,0 +1,140 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_OMP_SCHEDULE_HPP
+#define HIPSYCL_OMP_SCHEDULE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Accumulates the time that each thread of an OpenMP team spent on its
+/// share of a statically scheduled loop.
+class omp_thread_timings {
+public:
+  void add(std::chrono::steady_clock::duration thread_time) {
+    uint64_t ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(thread_time)
+            .count());
+    _total_ns.fetch_add(ns, std::memory_order_relaxed);
+    _num_threads.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t current_max = _max_ns.load(std::memory_order_relaxed);
+    while (ns > current_max &&
+           !_max_ns.compare_exchange_weak(current_max, ns,
+                                          std::memory_order_relaxed))
+      ;
+  }
+
+  uint64_t get_max_ns() const {
+    return _max_ns.load(std::memory_order_relaxed);
+  }
+
+  uint64_t get_mean_ns() const {
+    uint64_t n = _num_threads.load(std::memory_order_relaxed);
+    return n == 0 ? 0 : _total_ns.load(std::memory_order_relaxed) / n;
+  }
+
+private:
+  std::atomic<uint64_t> _total_ns = 0;
+  std::atomic<uint64_t> _max_ns = 0;
+  std::atomic<uint64_t> _num_threads = 0;
+};
+
+/// Per-kernel state of ACPP_RT_OMP_AUTO_DYNAMIC_SCHEDULE. Kernels start out
+/// with a static schedule, and switch to a dynamic schedule once a launch
+/// has been measured where the slowest thread took considerably longer
+/// than the average thread.
+class omp_schedule_selector {
+public:
+  // Ratio of the slowest thread time to the mean thread time above which
+  // a launch is considered imbalanced
+  static constexpr double max_imbalance = 1.5;
+  // Shorter launches are dominated by noise and fork/join overheads
+  static constexpr uint64_t min_measured_ns = 50000;
+
+  bool uses_dynamic_schedule() const {
+    return _use_dynamic_schedule.load(std::memory_order_relaxed);
+  }
+
+  void record(const omp_thread_timings &timings) {
+    uint64_t max_ns = timings.get_max_ns();
+    if (max_ns < min_measured_ns)
+      return;
+    if (static_cast<double>(max_ns) >
+        max_imbalance * static_cast<double>(timings.get_mean_ns()))
+      _use_dynamic_schedule.store(true, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<bool> _use_dynamic_schedule = false;
+};
+
+/// How the iterations of a host kernel, i.e. work items or, for SSCP
+/// kernels, work groups, are distributed across the OpenMP threads.
+struct omp_loop_schedule {
+  // If 0, iterations are distributed statically. Otherwise, threads
+  // dynamically take chunks of this many iterations.
+  std::size_t dynamic_chunk_size = 0;
+  // If not null, a static schedule should measure per-thread timings
+  // and record them here.
+  omp_schedule_selector *selector = nullptr;
+};
+
+/// Selects the schedule from the hints::dynamic_schedule hint of the kernel,
+/// or automatically based on the previous launches recorded in selector.
+inline omp_loop_schedule
+select_omp_loop_schedule(const execution_hints *hints,
+                         omp_schedule_selector &selector,
+                         std::size_t num_iterations, int num_threads) {
+  static const bool is_auto_schedule_enabled =
+      application::get_settings().get<setting::omp_auto_dynamic_schedule>();
+
+  // Multiple chunks per thread, such that threads finishing early can
+  // take over work of others
+  constexpr std::size_t chunks_per_thread = 16;
+  auto default_chunk_size = [&]() -> std::size_t {
+    return std::max(num_iterations / (chunks_per_thread *
+                                      static_cast<std::size_t>(
+                                          std::max(num_threads, 1))),
+                    std::size_t{1});
+  };
+
+  omp_loop_schedule schedule;
+  if (hints) {
+    if (auto *h = hints->get_hint<hints::dynamic_schedule>()) {
+      schedule.dynamic_chunk_size =
+          h->get_chunk_size() > 0 ? h->get_chunk_size() : default_chunk_size();
+      return schedule;
+    }
+  }
+
+  if (is_auto_schedule_enabled && num_threads > 1) {
+    if (selector.uses_dynamic_schedule())
+      schedule.dynamic_chunk_size = default_chunk_size();
+    else
+      schedule.selector = &selector;
+  }
+  return schedule;
+}
+
+}
+}
+
+#endif
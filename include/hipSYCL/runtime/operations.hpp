@@ -26,11 +26,15 @@
 #include "util.hpp"
 #include "error.hpp"
 #include "hw_model/cost.hpp"
+#include "generic/object_pool.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <ostream>
+#include <vector>
 
 namespace hipsycl {
 namespace rt {
@@ -68,6 +72,16 @@ public:
   operation() = default;
   virtual ~operation() = default;
 
+  // Operations are created for every submission, so their storage
+  // is recycled through the object_pool.
+  static void* operator new(std::size_t size) {
+    return object_pool::allocate(size);
+  }
+
+  static void operator delete(void* ptr, std::size_t size) noexcept {
+    object_pool::deallocate(ptr, size);
+  }
+
   virtual cost_type get_runtime_costs() { return 1.; }
   virtual bool is_requirement() const { return false; }
   virtual bool is_data_transfer() const { return false; }
@@ -171,6 +185,12 @@ public:
   sycl::access::mode get_access_mode() const override
   { return _mode; }
 
+  /// Changes the access mode. Only allowed before the requirement
+  /// has been submitted, and must not weaken the dependencies that
+  /// the requirement has already been given.
+  void set_access_mode(sycl::access::mode mode)
+  { _mode = mode; }
+
   sycl::access::target get_access_target() const override
   { return _target; }
 
@@ -231,6 +251,23 @@ public:
     return _bound_embedded_ptr_id;
   }
 
+  /// Whether the embedded pointer with the given uid is initialized by this
+  /// requirement, either as primary or additional binding.
+  bool is_bound_to(glue::unique_id uid) const {
+    if(_bound_embedded_ptr_id == uid)
+      return true;
+    return std::find(_additional_bound_ids.begin(), _additional_bound_ids.end(),
+                     uid) != _additional_bound_ids.end();
+  }
+
+  /// Whether this requirement accesses the same data in the same way as the
+  /// given requirement, such that a single requirement can serve both.
+  bool is_equivalent_to(const buffer_memory_requirement& other) const {
+    return _mem_region == other._mem_region && _mode == other._mode &&
+           _target == other._target && _offset == other._offset &&
+           _range == other._range;
+  }
+
   void initialize_device_data(void *location) {
     assert(!has_device_ptr());
     _device_data_location = location;
@@ -250,6 +287,15 @@ public:
     _bound_embedded_ptr_id = uid;
   }
 
+  /// Binds an additional embedded pointer/accessor to an already bound
+  /// requirement. Used when multiple accessors of a command group
+  /// access the same data with identical mode, target and range.
+  void bind_additional(glue::unique_id uid) {
+    assert(is_bound());
+    if(!is_bound_to(uid))
+      _additional_bound_ids.push_back(uid);
+  }
+
   /// Given a kernel blob, identifies embedded pointers that are bound
   /// to this requirement and initializes them
   /// \return Whether an embedded pointer was found and initialized
@@ -267,8 +313,12 @@ public:
                               "initialize embedded pointers for requirement "
                            << this << std::endl;
 
-        return glue::kernel_blob::initialize_embedded_pointer(
+        bool found = glue::kernel_blob::initialize_embedded_pointer(
                 blob, blob_size, _bound_embedded_ptr_id, get_device_ptr());
+        for(const auto& uid : _additional_bound_ids)
+          found |= glue::kernel_blob::initialize_embedded_pointer(
+              blob, blob_size, uid, get_device_ptr());
+        return found;
       }
     }
     return false;
@@ -287,8 +337,11 @@ public:
     auto new_req = std::make_unique<buffer_memory_requirement>(
         _mem_region, _offset, _range, _mode, _target);
     
-    if(bind_to_same_id)
+    if(bind_to_same_id) {
       new_req->bind(_bound_embedded_ptr_id);
+      for(const auto& uid : _additional_bound_ids)
+        new_req->bind_additional(uid);
+    }
 
     return new_req;
   }
@@ -324,6 +377,7 @@ private:
 
   void* _device_data_location;
   glue::unique_id _bound_embedded_ptr_id;
+  std::vector<glue::unique_id> _additional_bound_ids;
 };
 
 
@@ -488,8 +542,16 @@ public:
 
   virtual bool has_preferred_backend(backend_id &preferred_backend,
                                      device_id &preferred_device) const override {
-    if (_source.get_device().get_full_backend_descriptor().hw_platform !=
-        hardware_platform::cpu) {
+    const bool is_source_device =
+        _source.get_device().get_full_backend_descriptor().hw_platform !=
+        hardware_platform::cpu;
+    const bool is_dest_device =
+        _dest.get_device().get_full_backend_descriptor().hw_platform !=
+        hardware_platform::cpu;
+    // Device-to-device copies (e.g. peer-to-peer) are carried out on the
+    // destination device, such that consumers on the destination
+    // do not need to wait for the source device.
+    if (is_source_device && !is_dest_device) {
       preferred_backend = _source.get_device().get_backend();
       preferred_device = _source.get_device();
     }
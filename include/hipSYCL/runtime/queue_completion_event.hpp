@@ -22,39 +22,74 @@ namespace hipsycl {
 namespace rt {
 
 
+/// Event that does not interact with the backend when created. Completion
+/// is determined from the completion of the whole queue, or of later
+/// operations of the same queue, which is tracked by the
+/// inorder_queue_completion_tracker of the queue. Only if a backend event is
+/// explicitly requested, e.g. to synchronize with another queue,
+/// a fine-grained event is inserted into the queue at that point.
 template <class FineGrainedBackendEventT, class FineGrainedInorderQueueEventT>
 class queue_completion_event
     : public inorder_queue_event<FineGrainedBackendEventT> {
 public:
   queue_completion_event(inorder_queue* q)
-  : _q{q}, _has_fine_grained_event{false}, _is_complete{false} {}
+  : _q{q}, _index{q->get_completion_tracker().register_operation()},
+    _fine_grained_event_index{0}, _has_fine_grained_event{false},
+    _is_complete{false} {}
 
   virtual ~queue_completion_event(){}
 
   virtual bool is_complete() const override {
     if(_is_complete)
       return true;
+
+    auto& tracker = _q->get_completion_tracker();
+    if(tracker.is_known_complete(_index)) {
+      _is_complete = true;
+      return true;
+    }
     
-    if(_has_fine_grained_event)
-      return _fine_grained_event->is_complete();
+    if(_has_fine_grained_event) {
+      if(!_fine_grained_event->is_complete())
+        return false;
+      tracker.mark_complete_up_to(_fine_grained_event_index);
+      _is_complete = true;
+      return true;
+    }
     
+    // Everything registered up to now is complete if the queue is idle
+    uint64_t last_registered = tracker.get_last_registered();
     inorder_queue_status status;
     auto err = _q->query_status(status);
     if(!err.is_success()) {
       register_error(err);
+      return false;
     }
 
+    if(status.is_complete()) {
+      tracker.mark_complete_up_to(last_registered);
+      _is_complete = true;
+    }
     return status.is_complete();
   }
 
   virtual void wait() override {
-    if(_is_complete)
+    if(is_complete())
       return;
 
-    if(_has_fine_grained_event)
+    auto& tracker = _q->get_completion_tracker();
+    if(_has_fine_grained_event) {
       _fine_grained_event->wait();
-    else
-      _q->wait();
+      tracker.mark_complete_up_to(_fine_grained_event_index);
+    } else {
+      uint64_t last_registered = tracker.get_last_registered();
+      auto err = _q->wait();
+      if(!err.is_success()) {
+        register_error(err);
+        return;
+      }
+      tracker.mark_complete_up_to(last_registered);
+    }
     _is_complete = true;
   }
 
@@ -68,6 +103,10 @@ public:
         // We need to first create an actual fine-grained event
         // to be able to service the request, since this event
         // is not tied to a backend event otherwise.
+        // The new event also covers all operations that have been
+        // registered so far.
+        _fine_grained_event_index =
+            _q->get_completion_tracker().get_last_registered();
         _fine_grained_event = _q->insert_event();
         _has_fine_grained_event = true;
       }
@@ -79,8 +118,11 @@ public:
   }
 private:
   inorder_queue* _q;
+  // Index of this event's operation in the completion tracker of the queue
+  const uint64_t _index;
+  uint64_t _fine_grained_event_index;
   std::atomic<bool> _has_fine_grained_event;
-  std::atomic<bool> _is_complete;
+  mutable std::atomic<bool> _is_complete;
   std::shared_ptr<dag_node_event> _fine_grained_event;
   std::mutex _decay_to_fine_grained_evt_mutex;
 };
@@ -0,0 +1,73 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REMOTE_ALLOCATOR_HPP
+#define HIPSYCL_REMOTE_ALLOCATOR_HPP
+
+#include "../allocator.hpp"
+#include "remote_hardware_manager.hpp"
+
+#include <map>
+#include <mutex>
+
+namespace hipsycl {
+namespace rt {
+
+/// Allocations of all remote devices, by address. Addresses of different
+/// daemons may coincide; the most recent allocation wins.
+class remote_allocation_map {
+public:
+  void insert(const void *ptr, std::size_t bytes, device_id dev);
+  void erase(const void *ptr);
+  /// \return Whether ptr points into an allocation
+  bool find(const void *ptr, device_id &dev) const;
+private:
+  struct allocation {
+    std::size_t bytes;
+    device_id dev;
+  };
+  mutable std::mutex _mutex;
+  std::map<const char *, allocation> _allocations;
+};
+
+/// Allocates device memory on the daemon. The returned pointers are only
+/// valid on the daemon, and must not be dereferenced by the host.
+class remote_allocator : public backend_allocator
+{
+public:
+  remote_allocator(const device_id &my_device,
+                   remote_hardware_context *ctx,
+                   remote_allocation_map *allocations);
+
+  virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
+
+  virtual void *allocate_optimized_host(size_t min_alignment,
+                                        size_t bytes) override;
+
+  virtual void free(void *mem) override;
+
+  virtual void *allocate_usm(size_t bytes) override;
+  virtual bool is_usm_accessible_from(backend_descriptor b) const override;
+
+  virtual result query_pointer(const void *ptr,
+                               pointer_info &out) const override;
+
+  virtual result mem_advise(const void *addr, std::size_t num_bytes,
+                            int advise) const override;
+private:
+  device_id _my_device;
+  remote_hardware_context *_ctx;
+  remote_allocation_map *_allocations;
+};
+
+}
+}
+
+#endif
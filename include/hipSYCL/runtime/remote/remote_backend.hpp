@@ -0,0 +1,56 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REMOTE_BACKEND_HPP
+#define HIPSYCL_REMOTE_BACKEND_HPP
+
+#include "../backend.hpp"
+#include "../multi_queue_executor.hpp"
+#include "remote_allocator.hpp"
+#include "remote_hardware_manager.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// Executes operations on devices of other machines that run
+/// acpp-remote-daemon, see ACPP_RT_REMOTE_DEVICES.
+class remote_backend : public backend
+{
+public:
+  remote_backend();
+
+  virtual api_platform get_api_platform() const override;
+  virtual hardware_platform get_hardware_platform() const override;
+  virtual backend_id get_unique_backend_id() const override;
+
+  virtual backend_hardware_manager* get_hardware_manager() const override;
+  virtual backend_executor* get_executor(device_id dev) const override;
+  virtual backend_allocator *get_allocator(device_id dev) const override;
+
+  virtual std::string get_name() const override;
+
+  virtual ~remote_backend(){}
+
+  std::unique_ptr<backend_executor>
+  create_inorder_executor(device_id dev, int priority) override;
+private:
+  mutable remote_hardware_manager _hw;
+  mutable remote_allocation_map _allocations;
+  mutable std::vector<std::unique_ptr<remote_allocator>> _allocators;
+  mutable lazily_constructed_executor<multi_queue_executor> _executor;
+};
+
+}
+}
+
+#endif
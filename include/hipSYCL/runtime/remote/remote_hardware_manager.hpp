@@ -0,0 +1,148 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REMOTE_HARDWARE_MANAGER_HPP
+#define HIPSYCL_REMOTE_HARDWARE_MANAGER_HPP
+
+#include "../hardware.hpp"
+#include "remote_protocol.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// Performs the hello exchange on a new connection
+result remote_handshake(remote_socket &socket, remote_hello_reply &reply);
+
+/// A daemon that the remote backend is connected to. Requests on the
+/// control connection are serialized.
+class remote_daemon {
+public:
+  explicit remote_daemon(const std::string &address);
+
+  result connect();
+
+  const std::string &get_address() const { return _address; }
+  const std::vector<remote_device_info> &get_devices() const {
+    return _devices;
+  }
+
+  template<class Body>
+  result request(remote_message_type type, Body &&body,
+                 remote_message_type expected_reply, remote_message &reply,
+                 const void *data = nullptr, std::size_t data_size = 0) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _control.request(type, std::forward<Body>(body), expected_reply,
+                            reply, data, data_size);
+  }
+
+  /// Sends a request that is answered by a remote_status_reply. In case of
+  /// success, reply_data contains the data section of the reply.
+  template<class Body>
+  result request_status(remote_message_type type, Body &&body,
+                        std::string *reply_data = nullptr,
+                        const void *data = nullptr,
+                        std::size_t data_size = 0) {
+    remote_message reply;
+    auto err = request(type, std::forward<Body>(body),
+                       remote_message_type::status_reply, reply, data,
+                       data_size);
+    if(!err.is_success())
+      return err;
+    remote_status_reply status;
+    if(!reply.unpack_body(status))
+      return make_error(__acpp_here(),
+                        error_info{"remote_daemon: Received invalid reply"});
+    if(!status.error.empty())
+      return make_error(__acpp_here(),
+                        error_info{"remote_daemon: " + _address + ": " +
+                                   status.error});
+    if(reply_data)
+      *reply_data = std::move(reply.data);
+    return make_success();
+  }
+
+  /// Opens a connection on which the commands of an inorder queue of the
+  /// device are executed
+  result open_stream(uint64_t device, remote_socket &out);
+
+private:
+  std::string _address;
+  std::string _host;
+  uint16_t _port;
+
+  std::mutex _mutex;
+  remote_socket _control;
+  std::vector<remote_device_info> _devices;
+};
+
+class remote_hardware_context : public hardware_context
+{
+public:
+  remote_hardware_context(std::shared_ptr<remote_daemon> daemon,
+                          std::size_t daemon_device_index);
+
+  virtual bool is_cpu() const override;
+  virtual bool is_gpu() const override;
+
+  /// \return The maximum number of kernels that can be executed concurrently
+  virtual std::size_t get_max_kernel_concurrency() const override;
+  /// \return The maximum number of memory transfers that can be executed
+  /// concurrently
+  virtual std::size_t get_max_memcpy_concurrency() const override;
+
+  virtual std::string get_device_name() const override;
+  virtual std::string get_vendor_name() const override;
+  virtual std::string get_device_arch() const override;
+
+  virtual bool has(device_support_aspect aspect) const override;
+  virtual std::size_t get_property(device_uint_property prop) const override;
+  virtual std::vector<std::size_t>
+    get_property(device_uint_list_property prop) const override;
+
+  virtual std::string get_driver_version() const override;
+  virtual std::string get_profile() const override;
+
+  virtual ~remote_hardware_context() {}
+
+  const std::shared_ptr<remote_daemon> &get_daemon() const { return _daemon; }
+  /// Index of the device in the device list of its daemon
+  std::size_t get_daemon_device_index() const { return _daemon_device_index; }
+private:
+  const remote_device_info &info() const;
+
+  std::shared_ptr<remote_daemon> _daemon;
+  std::size_t _daemon_device_index;
+};
+
+/// Exposes the devices of the daemons listed in ACPP_RT_REMOTE_DEVICES, in
+/// the order of the list. Daemons that cannot be reached are skipped.
+class remote_hardware_manager : public backend_hardware_manager
+{
+public:
+  remote_hardware_manager();
+
+  virtual std::size_t get_num_devices() const override;
+  virtual hardware_context *get_device(std::size_t index) override;
+  virtual device_id get_device_id(std::size_t index) const override;
+
+  virtual ~remote_hardware_manager(){}
+private:
+  std::vector<remote_hardware_context> _devices;
+};
+
+}
+}
+
+#endif
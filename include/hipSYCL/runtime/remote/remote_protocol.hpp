@@ -0,0 +1,549 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REMOTE_PROTOCOL_HPP
+#define HIPSYCL_REMOTE_PROTOCOL_HPP
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/msgpack/msgpack.hpp"
+#include "../error.hpp"
+#include "../hardware.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+// Wire protocol between the remote backend and acpp-remote-daemon.
+//
+// Every message consists of a fixed-size header, a msgpack-encoded body and
+// an optional raw data section (e.g. memory contents or kernel arguments),
+// which is not copied into the body so that large transfers are sent
+// directly from and received directly into their buffers.
+//
+// A connection starts with a hello exchange. Afterwards it is either a
+// control connection, on which each request is answered by exactly one
+// reply, or, after open_stream, a stream connection of a device: Stream
+// commands are executed in order on the device and each of them is
+// acknowledged by a completion message, in the same order.
+//
+// Kernel arguments and the data of memory operations are transferred in
+// the byte order and layout of the client, so daemon and client must run on
+// the same architecture.
+
+constexpr uint32_t remote_protocol_version = 1;
+constexpr uint16_t remote_default_port = 47800;
+
+enum class remote_message_type : uint32_t {
+  // Both connection types
+  hello,
+  hello_reply,
+  status_reply,
+  // Control connection
+  allocate,
+  allocate_reply,
+  free,
+  read,
+  write,
+  open_stream,
+  // Stream connection
+  register_hcf,
+  memcpy_to_device,
+  memcpy_from_device,
+  memcpy_on_device,
+  memset,
+  kernel,
+  completion
+};
+
+// Properties are transferred as arrays indexed by the enum values, so these
+// must be updated when properties are added.
+constexpr std::size_t remote_num_uint_properties =
+    static_cast<std::size_t>(device_uint_property::vendor_id) + 1;
+constexpr std::size_t remote_num_support_aspects =
+    static_cast<std::size_t>(
+        device_support_aspect::work_item_independent_forward_progress) + 1;
+
+struct remote_hello {
+  uint32_t version = remote_protocol_version;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(version);
+  }
+};
+
+struct remote_device_info {
+  std::string name;
+  std::string vendor;
+  std::string arch;
+  std::string driver_version;
+  std::string profile;
+  bool is_cpu = false;
+  bool is_gpu = false;
+  uint64_t max_kernel_concurrency = 1;
+  uint64_t max_memcpy_concurrency = 1;
+  std::vector<uint64_t> uint_properties;
+  std::vector<uint64_t> sub_group_sizes;
+  std::vector<uint8_t> support_aspects;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(name);
+    pack(vendor);
+    pack(arch);
+    pack(driver_version);
+    pack(profile);
+    pack(is_cpu);
+    pack(is_gpu);
+    pack(max_kernel_concurrency);
+    pack(max_memcpy_concurrency);
+    pack(uint_properties);
+    pack(sub_group_sizes);
+    pack(support_aspects);
+  }
+};
+
+struct remote_hello_reply {
+  uint32_t version = remote_protocol_version;
+  std::vector<remote_device_info> devices;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(version);
+    pack(devices);
+  }
+};
+
+/// Reply to requests that do not return anything but may fail. An empty
+/// error denotes success.
+struct remote_status_reply {
+  std::string error;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(error);
+  }
+};
+
+struct remote_allocation_request {
+  // Index of the device in the hello_reply of the daemon
+  uint64_t device = 0;
+  uint64_t bytes = 0;
+  uint64_t alignment = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(device);
+    pack(bytes);
+    pack(alignment);
+  }
+};
+
+struct remote_allocation_reply {
+  uint64_t address = 0;
+  std::string error;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(address);
+    pack(error);
+  }
+};
+
+struct remote_free_request {
+  uint64_t device = 0;
+  uint64_t address = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(device);
+    pack(address);
+  }
+};
+
+/// A (possibly strided) region of an allocation, with the semantics of
+/// memory_location
+struct remote_memory_region {
+  // Index of the device in the hello_reply of the daemon
+  uint64_t device = 0;
+  uint64_t address = 0;
+  std::array<uint64_t, 3> offset = {0, 0, 0};
+  std::array<uint64_t, 3> shape = {1, 1, 1};
+  uint64_t element_size = 1;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(device);
+    pack(address);
+    pack(offset);
+    pack(shape);
+    pack(element_size);
+  }
+};
+
+/// Describes a copy between a device region and a packed host buffer of
+/// range elements in the data section (memcpy_to_device, write) or the
+/// reply (memcpy_from_device, read), or between two device regions of the
+/// daemon (memcpy_on_device). Only the region on the device is used for
+/// transfers from or to the host.
+struct remote_memcpy_command {
+  remote_memory_region source;
+  remote_memory_region dest;
+  std::array<uint64_t, 3> range = {1, 1, 1};
+
+  template<class T>
+  void pack(T &pack) {
+    pack(source);
+    pack(dest);
+    pack(range);
+  }
+};
+
+struct remote_stream_request {
+  uint64_t device = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(device);
+  }
+};
+
+/// Registers the HCF object in the data section for subsequent kernels
+struct remote_hcf_registration {
+  uint64_t hcf_object = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(hcf_object);
+  }
+};
+
+struct remote_memset_command {
+  uint64_t address = 0;
+  uint64_t pattern = 0;
+  uint64_t bytes = 0;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(address);
+    pack(pattern);
+    pack(bytes);
+  }
+};
+
+/// Launches an SSCP kernel whose argument buffer is the data section.
+/// Pointers in the arguments, including embedded pointers of accessors,
+/// already refer to device memory of the daemon.
+struct remote_kernel_command {
+  uint64_t hcf_object = 0;
+  std::string kernel_name;
+  std::array<uint64_t, 3> num_groups = {1, 1, 1};
+  std::array<uint64_t, 3> group_size = {1, 1, 1};
+  uint64_t local_mem_size = 0;
+  // Build options and flags of the kernel_configuration of the launch
+  common::db::jit_recipe configuration;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(hcf_object);
+    pack(kernel_name);
+    pack(num_groups);
+    pack(group_size);
+    pack(local_mem_size);
+    pack(configuration);
+  }
+};
+
+/// Acknowledges the stream command with the given index, counting from 1.
+/// For memcpy_from_device, the data section contains the copied elements.
+struct remote_completion {
+  uint64_t command = 0;
+  std::string error;
+
+  template<class T>
+  void pack(T &pack) {
+    pack(command);
+    pack(error);
+  }
+};
+
+struct remote_message {
+  remote_message_type type;
+  std::vector<uint8_t> body;
+  std::string data;
+
+  template<class T>
+  bool unpack_body(T &out) const {
+    std::error_code ec;
+    out = msgpack::unpack<T>(body, ec);
+    return !ec;
+  }
+};
+
+/// Blocking TCP connection that transfers remote_messages
+class remote_socket {
+  static constexpr uint32_t magic = 0x52505341; // "ASPR"
+  static constexpr std::size_t header_size = 24;
+public:
+  remote_socket() = default;
+  explicit remote_socket(int fd)
+  : _fd{fd} {
+    int flag = 1;
+    setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+  }
+
+  remote_socket(const remote_socket &) = delete;
+  remote_socket &operator=(const remote_socket &) = delete;
+
+  remote_socket(remote_socket &&other) noexcept
+  : _fd{std::exchange(other._fd, -1)} {}
+
+  remote_socket &operator=(remote_socket &&other) noexcept {
+    if(this != &other) {
+      close();
+      _fd = std::exchange(other._fd, -1);
+    }
+    return *this;
+  }
+
+  ~remote_socket() { close(); }
+
+  static result connect(const std::string &host, uint16_t port,
+                        remote_socket &out) {
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    std::string service = std::to_string(port);
+    int err = getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses);
+    if(err != 0)
+      return make_error(__acpp_here(),
+                        error_info{"remote_socket: Could not resolve " + host +
+                                   ": " + gai_strerror(err)});
+
+    int fd = -1;
+    for(addrinfo *a = addresses; a; a = a->ai_next) {
+      fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+      if(fd < 0)
+        continue;
+      if(::connect(fd, a->ai_addr, a->ai_addrlen) == 0)
+        break;
+      ::close(fd);
+      fd = -1;
+    }
+    freeaddrinfo(addresses);
+
+    if(fd < 0)
+      return make_error(__acpp_here(),
+                        error_info{"remote_socket: Could not connect to " +
+                                   host + ":" + service});
+    out = remote_socket{fd};
+    return make_success();
+  }
+
+  bool is_valid() const { return _fd >= 0; }
+
+  /// Unblocks threads that are waiting in receive()
+  void shutdown() {
+    if(_fd >= 0)
+      ::shutdown(_fd, SHUT_RDWR);
+  }
+
+  result send(remote_message_type type, const std::vector<uint8_t> &body,
+              const void *data = nullptr, std::size_t data_size = 0) {
+    std::array<unsigned char, header_size> header;
+    encode(header.data(), magic);
+    encode(header.data() + 4, static_cast<uint32_t>(type));
+    encode(header.data() + 8, static_cast<uint64_t>(body.size()));
+    encode(header.data() + 16, static_cast<uint64_t>(data_size));
+
+    std::array<iovec, 3> parts{
+        iovec{header.data(), header.size()},
+        iovec{const_cast<uint8_t *>(body.data()), body.size()},
+        iovec{const_cast<void *>(data), data ? data_size : 0}};
+    if(!write_all(parts.data(), parts.size()))
+      return make_error(
+          __acpp_here(),
+          error_info{"remote_socket: Sending message failed: " +
+                     std::string{std::strerror(errno)}});
+    return make_success();
+  }
+
+  template<class Body, std::enable_if_t<!std::is_same_v<
+                            std::decay_t<Body>, std::vector<uint8_t>>, int> = 0>
+  result send(remote_message_type type, Body &&body,
+              const void *data = nullptr, std::size_t data_size = 0) {
+    // Packing requires a mutable object
+    std::decay_t<Body> packed_body = std::forward<Body>(body);
+    return send(type, msgpack::pack(packed_body), data,
+                data_size);
+  }
+
+  result receive(remote_message &out) {
+    std::array<unsigned char, header_size> header;
+    if(!read_all(header.data(), header.size()))
+      return make_error(__acpp_here(),
+                        error_info{"remote_socket: Connection was closed"});
+    if(decode<uint32_t>(header.data()) != magic)
+      return make_error(__acpp_here(),
+                        error_info{"remote_socket: Received invalid message"});
+
+    out.type = static_cast<remote_message_type>(
+        decode<uint32_t>(header.data() + 4));
+    out.body.resize(decode<uint64_t>(header.data() + 8));
+    out.data.resize(decode<uint64_t>(header.data() + 16));
+    if(!read_all(out.body.data(), out.body.size()) ||
+       !read_all(out.data.data(), out.data.size()))
+      return make_error(__acpp_here(),
+                        error_info{"remote_socket: Connection was closed"});
+    return make_success();
+  }
+
+  /// Sends a request and receives its reply, which must be of type
+  /// expected_reply
+  template<class Body>
+  result request(remote_message_type type, Body &&body,
+                 remote_message_type expected_reply, remote_message &reply,
+                 const void *data = nullptr, std::size_t data_size = 0) {
+    auto err = send(type, std::forward<Body>(body), data, data_size);
+    if(!err.is_success())
+      return err;
+    err = receive(reply);
+    if(!err.is_success())
+      return err;
+    if(reply.type != expected_reply)
+      return make_error(__acpp_here(),
+                        error_info{"remote_socket: Received unexpected reply"});
+    return make_success();
+  }
+
+private:
+  template<class T>
+  static void encode(unsigned char *out, T value) {
+    for(std::size_t i = 0; i < sizeof(T); ++i)
+      out[i] = static_cast<unsigned char>(value >> (8 * i));
+  }
+
+  template<class T>
+  static T decode(const unsigned char *in) {
+    T value = 0;
+    for(std::size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(in[i]) << (8 * i);
+    return value;
+  }
+
+  bool write_all(iovec *parts, std::size_t num_parts) {
+    while(num_parts > 0) {
+      msghdr msg{};
+      msg.msg_iov = parts;
+      msg.msg_iovlen = num_parts;
+      ssize_t written = sendmsg(_fd, &msg, MSG_NOSIGNAL);
+      if(written < 0) {
+        if(errno == EINTR)
+          continue;
+        return false;
+      }
+      std::size_t remaining = static_cast<std::size_t>(written);
+      while(num_parts > 0 && remaining >= parts->iov_len) {
+        remaining -= parts->iov_len;
+        ++parts;
+        --num_parts;
+      }
+      if(num_parts > 0) {
+        parts->iov_base = static_cast<char *>(parts->iov_base) + remaining;
+        parts->iov_len -= remaining;
+      }
+    }
+    return true;
+  }
+
+  bool read_all(void *data, std::size_t size) {
+    char *current = static_cast<char *>(data);
+    while(size > 0) {
+      ssize_t received = recv(_fd, current, size, 0);
+      if(received < 0 && errno == EINTR)
+        continue;
+      if(received <= 0)
+        return false;
+      current += received;
+      size -= static_cast<std::size_t>(received);
+    }
+    return true;
+  }
+
+  void close() {
+    if(_fd >= 0)
+      ::close(_fd);
+    _fd = -1;
+  }
+
+  int _fd = -1;
+};
+
+/// Parses addresses of the form host[:port], where an IPv6 host must be
+/// enclosed in brackets if a port is given.
+inline bool parse_remote_address(const std::string &address, std::string &host,
+                                 uint16_t &port) {
+  port = remote_default_port;
+  std::string port_string;
+  if(!address.empty() && address.front() == '[') {
+    auto end = address.find(']');
+    if(end == std::string::npos)
+      return false;
+    host = address.substr(1, end - 1);
+    if(end + 1 < address.size()) {
+      if(address[end + 1] != ':')
+        return false;
+      port_string = address.substr(end + 2);
+    }
+  } else {
+    auto delimiter = address.find(':');
+    if(delimiter != std::string::npos &&
+       address.find(':', delimiter + 1) == std::string::npos) {
+      host = address.substr(0, delimiter);
+      port_string = address.substr(delimiter + 1);
+    } else {
+      host = address;
+    }
+  }
+  if(host.empty())
+    return false;
+  if(!port_string.empty()) {
+    char *end = nullptr;
+    unsigned long value = std::strtoul(port_string.c_str(), &end, 10);
+    if(*end != '\0' || value == 0 || value > 65535)
+      return false;
+    port = static_cast<uint16_t>(value);
+  }
+  return true;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_REMOTE_QUEUE_HPP
+#define HIPSYCL_REMOTE_QUEUE_HPP
+
+#include "../generic/async_worker.hpp"
+#include "../code_object_invoker.hpp"
+#include "../device_id.hpp"
+#include "../inorder_queue.hpp"
+#include "remote_hardware_manager.hpp"
+#include "remote_protocol.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+/// Stream connection to a device of a daemon. Commands are executed by the
+/// daemon in submission order, and their completions are received on a
+/// thread of the stream. Commands must only be submitted by one thread at a
+/// time.
+class remote_stream {
+public:
+  /// Invoked on completion of a command with the error reported by the
+  /// daemon, which is empty on success, and the data of the completion
+  using completion_handler =
+      std::function<void(const std::string &error, std::string &data)>;
+
+  remote_stream(std::shared_ptr<remote_daemon> daemon, uint64_t device);
+  ~remote_stream();
+
+  remote_stream(const remote_stream &) = delete;
+  remote_stream &operator=(const remote_stream &) = delete;
+
+  /// \param writes_host_memory Whether the handler writes to host memory,
+  /// see wait_for_host_writes()
+  result submit(remote_message_type type, const std::vector<uint8_t> &body,
+                const void *data = nullptr, std::size_t data_size = 0,
+                completion_handler handler = {},
+                bool writes_host_memory = false);
+
+  template<class Body, std::enable_if_t<!std::is_same_v<
+                            std::decay_t<Body>, std::vector<uint8_t>>, int> = 0>
+  result submit(remote_message_type type, Body &&body,
+                const void *data = nullptr, std::size_t data_size = 0,
+                completion_handler handler = {},
+                bool writes_host_memory = false) {
+    // Packing requires a mutable object
+    std::decay_t<Body> packed_body = std::forward<Body>(body);
+    return submit(type, msgpack::pack(packed_body), data,
+                  data_size, std::move(handler), writes_host_memory);
+  }
+
+  /// Invokes f once all previously submitted commands have completed
+  void when_complete(std::function<void()> f);
+
+  void wait();
+  /// Waits until host memory is no longer written by completions, such
+  /// that it can be read for subsequent commands
+  void wait_for_host_writes();
+  bool is_idle() const;
+
+  /// Uploads the HCF object to the daemon, unless this has already been done
+  result register_hcf(hcf_object_id hcf_object);
+
+  const std::shared_ptr<remote_daemon> &get_daemon() const { return _daemon; }
+private:
+  struct pending_command {
+    completion_handler handler;
+    bool writes_host_memory;
+    std::vector<std::function<void()>> on_completion;
+  };
+
+  void receive();
+  void fail(const std::string &error);
+
+  std::shared_ptr<remote_daemon> _daemon;
+  remote_socket _socket;
+  std::thread _receiver;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _completion_cv;
+  std::deque<pending_command> _pending;
+  std::size_t _num_pending_host_writes = 0;
+  uint64_t _num_completed = 0;
+  bool _is_broken = false;
+
+  std::unordered_set<hcf_object_id> _registered_hcf_objects;
+};
+
+class remote_queue;
+
+class remote_sscp_code_object_invoker : public sscp_code_object_invoker {
+public:
+  remote_sscp_code_object_invoker(remote_queue* q)
+  : _queue{q} {}
+
+  virtual ~remote_sscp_code_object_invoker(){}
+
+  virtual result submit_kernel(const kernel_operation& op,
+                               hcf_object_id hcf_object,
+                               const rt::range<3> &num_groups,
+                               const rt::range<3> &group_size,
+                               unsigned local_mem_size, void **args,
+                               std::size_t *arg_sizes, std::size_t num_args,
+                               std::string_view kernel_name,
+                               const rt::hcf_kernel_info* kernel_info,
+                               const kernel_configuration& config) override;
+private:
+  remote_queue* _queue;
+};
+
+/// Forwards operations to a stream of the daemon. Operations are
+/// submitted to the stream by a worker thread, such that the submitting
+/// thread does not block on the network.
+class remote_queue : public inorder_queue
+{
+public:
+  remote_queue(remote_hardware_manager *hw, device_id dev);
+  virtual ~remote_queue();
+
+  /// Inserts an event into the stream
+  virtual std::shared_ptr<dag_node_event> insert_event() override;
+  virtual std::shared_ptr<dag_node_event> create_queue_completion_event() override;
+
+  virtual result submit_memcpy(memcpy_operation&, const dag_node_ptr&) override;
+  virtual result submit_kernel(kernel_operation&, const dag_node_ptr&) override;
+  virtual result submit_prefetch(prefetch_operation &, const dag_node_ptr&) override;
+  virtual result submit_memset(memset_operation&, const dag_node_ptr&) override;
+
+  /// Causes the queue to wait until an event on another queue has occured.
+  /// the other queue must be from the same backend
+  virtual result submit_queue_wait_for(const dag_node_ptr& evt) override;
+  virtual result submit_external_wait_for(const dag_node_ptr& node) override;
+
+  virtual result wait() override;
+
+  virtual device_id get_device() const override;
+  virtual void *get_native_type() const override;
+
+  virtual result query_status(inorder_queue_status& status) override;
+
+  virtual result submit_completion_callback(void (*callback)(void *),
+                                            void *user_data) override;
+
+  result submit_sscp_kernel(hcf_object_id hcf_object,
+                            std::string_view kernel_name,
+                            const rt::hcf_kernel_info *kernel_info,
+                            const rt::range<3> &num_groups,
+                            const rt::range<3> &group_size,
+                            unsigned local_mem_size, void **args,
+                            std::size_t *arg_sizes, std::size_t num_args,
+                            const kernel_configuration &config);
+private:
+  remote_hardware_context *get_context(device_id dev) const;
+  result copy_through_host(const remote_memcpy_command &cmd,
+                           remote_hardware_context *src_ctx,
+                           remote_hardware_context *dest_ctx);
+
+  remote_hardware_manager *_hw;
+  const device_id _device;
+  remote_hardware_context *_ctx;
+  remote_stream _stream;
+  worker_thread _worker;
+
+  remote_sscp_code_object_invoker _sscp_code_object_invoker;
+};
+
+}
+}
+
+#endif
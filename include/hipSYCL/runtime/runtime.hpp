@@ -13,7 +13,9 @@
 
 #include "dag_manager.hpp"
 #include "backend.hpp"
+#include "completion_notifier.hpp"
 #include "settings.hpp"
+#include "runtime_statistics.hpp"
 
 #include <memory>
 #include <iostream>
@@ -39,11 +41,30 @@ public:
 
   const backend_manager &backends() const { return _backends; }
 
+  completion_notifier &completions() { return _completion_notifier; }
+
+  /// Returns the current values of the runtime statistics counters.
+  /// Counters are process-wide and not reset when the runtime is restarted.
+  runtime_statistics_snapshot get_statistics() const {
+    return runtime_statistics::get().get_snapshot();
+  }
+
+  /// Returns the memory held by allocations on the given device, e.g. to
+  /// size work such that device memory is not exhausted.
+  device_memory_usage get_memory_usage(device_id dev) const {
+    return runtime_statistics::get().get_memory_usage(dev);
+  }
+
 private:
+  // Destroyed last, such that the final dump includes the shutdown
+  // of the dag_manager.
+  periodic_statistics_dump _statistics_dump;
   // !! Attention: order is important, as backends have to be still present,
   // when the dag_manager is destructed!
   backend_manager _backends;
   dag_manager _dag_manager;
+  // Destroyed first, since the notifier thread accesses nodes of the dag
+  completion_notifier _completion_notifier;
 };
 
 
@@ -0,0 +1,242 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_RUNTIME_STATISTICS_HPP
+#define HIPSYCL_RUNTIME_STATISTICS_HPP
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "device_id.hpp"
+#include "instrumentation.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+enum class statistic : std::size_t {
+  kernel_launches_cuda,
+  kernel_launches_hip,
+  kernel_launches_level_zero,
+  kernel_launches_ocl,
+  kernel_launches_omp,
+  kernel_launches_remote,
+  kernel_cache_hits,
+  kernel_cache_misses,
+  persistent_cache_hits,
+  persistent_cache_misses,
+  jit_compilations,
+  jit_compilation_time_ns,
+  iads_specializations,
+  migrated_bytes_host_to_device,
+  migrated_bytes_device_to_host,
+  migrated_bytes_device_to_device,
+  allocated_bytes,
+  live_allocated_bytes,
+  cached_dag_nodes,
+  flushed_dag_nodes,
+  flushes,
+  discard_upgraded_requirements,
+  reused_buffer_allocations,
+  // Not a statistic, must remain the last entry
+  num_statistics
+};
+
+constexpr std::size_t num_runtime_statistics =
+    static_cast<std::size_t>(statistic::num_statistics);
+
+/// The backend_allocator function through which memory was allocated
+enum class allocation_kind : std::size_t {
+  device,         // allocate()
+  optimized_host, // allocate_optimized_host()
+  shared,         // allocate_usm()
+  // Not a kind, must remain the last entry
+  num_kinds
+};
+
+constexpr std::size_t num_allocation_kinds =
+    static_cast<std::size_t>(allocation_kind::num_kinds);
+
+/// Memory held by live allocations of one kind. Sizes are in bytes.
+struct memory_usage {
+  uint64_t live_bytes = 0;
+  /// Maximum of live_bytes observed so far
+  uint64_t peak_bytes = 0;
+  uint64_t num_live_allocations = 0;
+  /// Number of allocations made so far, including freed ones
+  uint64_t num_allocations = 0;
+};
+
+/// Memory usage of the allocations made by the allocator of one device.
+/// This includes all memory obtained through backend allocators, e.g. by
+/// buffers, USM, scratch caches and the stdpar memory pool.
+struct device_memory_usage {
+  device_id dev;
+  std::array<memory_usage, num_allocation_kinds> usage{};
+
+  const memory_usage& get(allocation_kind kind) const {
+    return usage[static_cast<std::size_t>(kind)];
+  }
+};
+
+/// Values of all statistics at one point in time
+class runtime_statistics_snapshot {
+public:
+  uint64_t get(statistic s) const {
+    return _values[static_cast<std::size_t>(s)];
+  }
+
+  uint64_t get_kernel_launches(backend_id b) const;
+
+  /// Memory usage of all devices on which memory has been allocated
+  const std::vector<device_memory_usage>& get_memory_usage() const {
+    return _memory_usage;
+  }
+
+  /// Writes all statistics as a single JSON object
+  void dump(std::ostream& ostr) const;
+
+  static const char* get_name(statistic s);
+  static const char* get_name(allocation_kind kind);
+private:
+  friend class runtime_statistics;
+  std::array<uint64_t, num_runtime_statistics> _values{};
+  std::vector<device_memory_usage> _memory_usage;
+};
+
+/// Always-on counters of runtime activity. Threads are distributed across
+/// shards of counters which are updated with relaxed atomics, such that
+/// counting is cheap even when many threads submit work concurrently.
+/// Reading sums up all shards, and is therefore more expensive.
+///
+/// This class is thread-safe.
+class runtime_statistics {
+public:
+  static runtime_statistics& get();
+
+  void add(statistic s, uint64_t value = 1) {
+    get_thread_shard().values[static_cast<std::size_t>(s)].fetch_add(
+        value, std::memory_order_relaxed);
+  }
+
+  void add_kernel_launch(backend_id b);
+
+  /// Records an allocation of the given size for the allocated and live
+  /// bytes statistics and the memory usage of the device. Backend
+  /// allocators should call this for each successful allocation.
+  void register_allocation(const void *ptr, std::size_t bytes,
+                           device_id dev, allocation_kind kind);
+  /// Removes an allocation from the live bytes statistics. Unknown
+  /// pointers are ignored.
+  void register_deallocation(const void* ptr);
+
+  /// Memory usage of the given device. Cheaper than get_snapshot().
+  device_memory_usage get_memory_usage(device_id dev) const;
+
+  /// A live allocation, see find_allocation()
+  struct allocation_range {
+    const void* base;
+    std::size_t bytes;
+    device_id dev;
+    allocation_kind kind;
+  };
+
+  /// Looks up the live allocation that contains ptr. This scans all
+  /// allocations and is only meant for diagnostic tools such as kernel
+  /// capture, not for use on hot paths.
+  std::optional<allocation_range> find_allocation(const void* ptr);
+
+  runtime_statistics_snapshot get_snapshot() const;
+private:
+  runtime_statistics() = default;
+
+  static constexpr std::size_t num_shards = 16;
+
+  struct alignas(64) shard {
+    std::array<std::atomic<uint64_t>, num_runtime_statistics> values{};
+  };
+
+  struct allocation_info {
+    std::size_t bytes;
+    device_id dev;
+    allocation_kind kind;
+  };
+
+  struct alignas(64) allocation_shard {
+    std::mutex mutex;
+    std::unordered_map<const void*, allocation_info> allocations;
+  };
+
+  shard& get_thread_shard();
+  allocation_shard& get_allocation_shard(const void* ptr);
+
+  std::array<shard, num_shards> _shards;
+  std::array<allocation_shard, num_shards> _allocations;
+  std::atomic<std::size_t> _num_threads{0};
+
+  mutable std::mutex _memory_usage_mutex;
+  std::unordered_map<device_id, device_memory_usage> _memory_usage;
+};
+
+/// Adds the lifetime of the object in nanoseconds to a statistic.
+class statistics_timer {
+public:
+  statistics_timer(statistic s)
+  : _statistic{s}, _begin{profiler_clock::now()} {}
+
+  ~statistics_timer() {
+    runtime_statistics::get().add(
+        _statistic, profiler_clock::ns_ticks(profiler_clock::now()) -
+                        profiler_clock::ns_ticks(_begin));
+  }
+
+  // Time since construction in ns
+  uint64_t get_elapsed_time() const {
+    return profiler_clock::ns_ticks(profiler_clock::now()) -
+           profiler_clock::ns_ticks(_begin);
+  }
+
+  statistics_timer(const statistics_timer&) = delete;
+  statistics_timer& operator=(const statistics_timer&) = delete;
+private:
+  statistic _statistic;
+  profiler_clock::time_point _begin;
+};
+
+/// Dumps a snapshot of all statistics in regular intervals and when it
+/// is destroyed, if ACPP_RT_STATISTICS_DUMP_INTERVAL is set.
+class periodic_statistics_dump {
+public:
+  periodic_statistics_dump();
+  ~periodic_statistics_dump();
+private:
+  void dump() const;
+
+  std::size_t _interval_ms;
+  std::string _dump_file;
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _is_shutting_down = false;
+  std::thread _thread;
+};
+
+}
+}
+
+#endif
@@ -26,6 +26,7 @@ namespace rt {
 
 enum class scheduler_type { direct, unbound };
 enum class default_selector_behavior { strict, multigpu, system };
+enum class omp_huge_page_policy { none, transparent, hugetlb_2m, hugetlb_1g };
 
 struct device_visibility_condition{
   int device_index_equality = -1;
@@ -52,6 +53,7 @@ bool has_device_visibility_mask(const visibility_mask_t& mask, backend_id backen
 std::istream &operator>>(std::istream &istr, scheduler_type &out);
 std::istream &operator>>(std::istream &istr, visibility_mask_t &out);
 std::istream &operator>>(std::istream &istr, default_selector_behavior& out);
+std::istream &operator>>(std::istream &istr, omp_huge_page_policy& out);
 
 template <class T>
 bool try_get_environment_variable(const std::string& name, T& out) {
@@ -103,11 +105,72 @@ enum class setting {
   gc_trigger_batch_size,
   ocl_no_shared_context,
   ocl_show_all_devices,
+  ocl_out_of_order_queues,
+  hip_direction_aware_memcpy_lanes,
+  ze_batched_command_lists,
+  ze_copy_engine,
   no_jit_cache_population,
   adaptivity_level,
   jitopt_iads_relative_threshold,
   jitopt_iads_relative_eviction_threshold,
-  jitopt_iads_relative_threshold_min_data
+  jitopt_iads_relative_threshold_min_data,
+  jitopt_iads_statistics_merge_interval,
+  jitopt_tiered_compilation_threshold,
+  jitopt_iads_pointer_noalias,
+  jitopt_iads_value_ranges,
+  jitopt_local_memory_tiling,
+  jitopt_aggregate_atomics,
+  jitopt_performance_remarks,
+  jitopt_local_memory_padding,
+  jitopt_fcall_inline_cache_size,
+  jitopt_pgo_profiled_invocations,
+  async_jit_threads,
+  jit_precompile,
+  packed_jit_cache,
+  jit_cache_max_size,
+  jit_cache_compression_level,
+  shared_jit_compilation,
+  shared_jit_compilation_timeout,
+  kernel_batching_max_work_items,
+  scratch_cache_max_size,
+  device_heap_size,
+  stream_ordered_allocation,
+  mem_pool_release_threshold,
+  mem_pool_opportunistic_reuse,
+  peer_access,
+  pipelined_transfer_chunk_size,
+  staging_buffer_size,
+  staging_pool_size,
+  host_buffer_aliasing,
+  unified_memory_zero_copy,
+  buffer_min_page_size,
+  buffer_eviction,
+  buffer_allocation_cache_size,
+  host_thread_pool,
+  host_thread_pool_size,
+  host_task_lanes,
+  omp_numa_mode,
+  omp_sscp_sub_group_size,
+  omp_in_process_jit,
+  omp_inline_kernel_max_work_items,
+  omp_auto_dynamic_schedule,
+  omp_huge_pages,
+  omp_pinned_memory,
+  streaming_groups_per_compute_unit,
+  lazy_events,
+  adaptive_flush,
+  critical_path_scheduling,
+  completion_callbacks,
+  max_wait_spin_time,
+  trace_file,
+  statistics_dump_interval,
+  statistics_dump_file,
+  kernel_capture,
+  kernel_capture_directory,
+  device_timestamps,
+  cuda_packed_kernel_args,
+  hip_hardware_counters,
+  remote_devices
 };
 
 template <setting S> struct setting_trait {};
@@ -139,6 +202,13 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::sscp_failed_ir_dump_directory,
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::gc_trigger_batch_size, "rt_gc_trigger_batch_size", std::size_t)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_no_shared_context, "rt_ocl_no_shared_context", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_show_all_devices, "rt_ocl_show_all_devices", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ocl_out_of_order_queues,
+                              "rt_ocl_out_of_order_queues", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::hip_direction_aware_memcpy_lanes,
+                              "rt_hip_direction_aware_memcpy_lanes", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ze_batched_command_lists,
+                              "rt_ze_batched_command_lists", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::ze_copy_engine, "rt_ze_copy_engine", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::no_jit_cache_population, "rt_no_jit_cache_population", bool)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::adaptivity_level, "adaptivity_level", int)
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_threshold, "jitopt_iads_relative_threshold", double)
@@ -146,6 +216,115 @@ HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_eviction_threshold,
 HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_relative_threshold_min_data,
                               "jitopt_iads_relative_threshold_min_data",
                               std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_statistics_merge_interval,
+                              "jitopt_iads_statistics_merge_interval",
+                              std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_tiered_compilation_threshold,
+                              "jitopt_tiered_compilation_threshold",
+                              std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_pointer_noalias,
+                              "jitopt_iads_pointer_noalias", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_iads_value_ranges,
+                              "jitopt_iads_value_ranges", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_local_memory_tiling,
+                              "jitopt_local_memory_tiling", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_aggregate_atomics,
+                              "jitopt_aggregate_atomics", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_performance_remarks,
+                              "jitopt_performance_remarks", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_local_memory_padding,
+                              "jitopt_local_memory_padding", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_fcall_inline_cache_size,
+                              "jitopt_fcall_inline_cache_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jitopt_pgo_profiled_invocations,
+                              "jitopt_pgo_profiled_invocations", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::async_jit_threads, "rt_async_jit_threads", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_precompile, "rt_jit_precompile", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::packed_jit_cache, "rt_packed_jit_cache", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_cache_max_size, "rt_jit_cache_max_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::jit_cache_compression_level,
+                              "rt_jit_cache_compression_level", int)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::shared_jit_compilation,
+                              "rt_shared_jit_compilation", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::shared_jit_compilation_timeout,
+                              "rt_shared_jit_compilation_timeout", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::kernel_batching_max_work_items,
+                              "rt_kernel_batching_max_work_items", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::scratch_cache_max_size,
+                              "rt_scratch_cache_max_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::device_heap_size,
+                              "rt_device_heap_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::stream_ordered_allocation,
+                              "rt_stream_ordered_allocation", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::mem_pool_release_threshold,
+                              "rt_mem_pool_release_threshold", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::mem_pool_opportunistic_reuse,
+                              "rt_mem_pool_opportunistic_reuse", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::peer_access, "rt_peer_access", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::pipelined_transfer_chunk_size,
+                              "rt_pipelined_transfer_chunk_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::staging_buffer_size,
+                              "rt_staging_buffer_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::staging_pool_size,
+                              "rt_staging_pool_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::host_buffer_aliasing,
+                              "rt_host_buffer_aliasing", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::unified_memory_zero_copy,
+                              "rt_unified_memory_zero_copy", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::buffer_min_page_size,
+                              "rt_buffer_min_page_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::buffer_eviction,
+                              "rt_buffer_eviction", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::buffer_allocation_cache_size,
+                              "rt_buffer_allocation_cache_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::host_thread_pool,
+                              "rt_host_thread_pool", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::host_thread_pool_size,
+                              "rt_host_thread_pool_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::host_task_lanes,
+                              "rt_host_task_lanes", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_numa_mode,
+                              "rt_omp_numa_mode", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_sscp_sub_group_size,
+                              "rt_omp_sscp_sub_group_size", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_in_process_jit,
+                              "rt_omp_in_process_jit", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_inline_kernel_max_work_items,
+                              "rt_omp_inline_kernel_max_work_items", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_auto_dynamic_schedule,
+                              "rt_omp_auto_dynamic_schedule", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_huge_pages, "rt_omp_huge_pages",
+                              omp_huge_page_policy)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::omp_pinned_memory,
+                              "rt_omp_pinned_memory", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::streaming_groups_per_compute_unit,
+                              "rt_streaming_groups_per_compute_unit",
+                              std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::lazy_events, "rt_lazy_events", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::adaptive_flush, "rt_adaptive_flush", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::critical_path_scheduling,
+                              "rt_critical_path_scheduling", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::completion_callbacks,
+                              "rt_completion_callbacks", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::max_wait_spin_time,
+                              "rt_max_wait_spin_time_us", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::trace_file, "rt_trace_file", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::statistics_dump_interval,
+                              "rt_statistics_dump_interval", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::statistics_dump_file,
+                              "rt_statistics_dump_file", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::kernel_capture, "rt_kernel_capture",
+                              std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::kernel_capture_directory,
+                              "rt_kernel_capture_directory", std::string)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::device_timestamps,
+                              "rt_device_timestamps", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::cuda_packed_kernel_args,
+                              "rt_cuda_packed_kernel_args", std::size_t)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::hip_hardware_counters,
+                              "rt_hip_hardware_counters", bool)
+HIPSYCL_RT_MAKE_SETTING_TRAIT(setting::remote_devices, "rt_remote_devices",
+                              std::string)
 
 class settings
 {
@@ -180,6 +359,14 @@ public:
       return _ocl_no_shared_context;
     } else if constexpr(S == setting::ocl_show_all_devices) {
       return _ocl_show_all_devices;
+    } else if constexpr(S == setting::ocl_out_of_order_queues) {
+      return _ocl_out_of_order_queues;
+    } else if constexpr(S == setting::hip_direction_aware_memcpy_lanes) {
+      return _hip_direction_aware_memcpy_lanes;
+    } else if constexpr(S == setting::ze_batched_command_lists) {
+      return _ze_batched_command_lists;
+    } else if constexpr(S == setting::ze_copy_engine) {
+      return _ze_copy_engine;
     } else if constexpr(S == setting::no_jit_cache_population) {
       return _no_jit_cache_population;
     } else if constexpr(S == setting::adaptivity_level) {
@@ -190,6 +377,120 @@ public:
       return _jitopt_iads_relative_threshold_min_data;
     } else if constexpr(S == setting::jitopt_iads_relative_eviction_threshold) {
       return _jitopt_iads_relative_eviction_threshold;
+    } else if constexpr(S == setting::jitopt_iads_statistics_merge_interval) {
+      return _jitopt_iads_statistics_merge_interval;
+    } else if constexpr(S == setting::jitopt_tiered_compilation_threshold) {
+      return _jitopt_tiered_compilation_threshold;
+    } else if constexpr(S == setting::jitopt_iads_pointer_noalias) {
+      return _jitopt_iads_pointer_noalias;
+    } else if constexpr(S == setting::jitopt_iads_value_ranges) {
+      return _jitopt_iads_value_ranges;
+    } else if constexpr(S == setting::jitopt_local_memory_tiling) {
+      return _jitopt_local_memory_tiling;
+    } else if constexpr(S == setting::jitopt_aggregate_atomics) {
+      return _jitopt_aggregate_atomics;
+    } else if constexpr(S == setting::jitopt_performance_remarks) {
+      return _jitopt_performance_remarks;
+    } else if constexpr(S == setting::jitopt_local_memory_padding) {
+      return _jitopt_local_memory_padding;
+    } else if constexpr(S == setting::jitopt_fcall_inline_cache_size) {
+      return _jitopt_fcall_inline_cache_size;
+    } else if constexpr(S == setting::jitopt_pgo_profiled_invocations) {
+      return _jitopt_pgo_profiled_invocations;
+    } else if constexpr(S == setting::async_jit_threads) {
+      return _async_jit_threads;
+    } else if constexpr(S == setting::jit_precompile) {
+      return _jit_precompile;
+    } else if constexpr(S == setting::packed_jit_cache) {
+      return _packed_jit_cache;
+    } else if constexpr(S == setting::jit_cache_max_size) {
+      return _jit_cache_max_size;
+    } else if constexpr(S == setting::jit_cache_compression_level) {
+      return _jit_cache_compression_level;
+    } else if constexpr(S == setting::shared_jit_compilation) {
+      return _shared_jit_compilation;
+    } else if constexpr(S == setting::shared_jit_compilation_timeout) {
+      return _shared_jit_compilation_timeout;
+    } else if constexpr(S == setting::kernel_batching_max_work_items) {
+      return _kernel_batching_max_work_items;
+    } else if constexpr(S == setting::scratch_cache_max_size) {
+      return _scratch_cache_max_size;
+    } else if constexpr(S == setting::device_heap_size) {
+      return _device_heap_size;
+    } else if constexpr(S == setting::stream_ordered_allocation) {
+      return _stream_ordered_allocation;
+    } else if constexpr(S == setting::mem_pool_release_threshold) {
+      return _mem_pool_release_threshold;
+    } else if constexpr(S == setting::mem_pool_opportunistic_reuse) {
+      return _mem_pool_opportunistic_reuse;
+    } else if constexpr(S == setting::peer_access) {
+      return _peer_access;
+    } else if constexpr(S == setting::pipelined_transfer_chunk_size) {
+      return _pipelined_transfer_chunk_size;
+    } else if constexpr(S == setting::staging_buffer_size) {
+      return _staging_buffer_size;
+    } else if constexpr(S == setting::staging_pool_size) {
+      return _staging_pool_size;
+    } else if constexpr(S == setting::host_buffer_aliasing) {
+      return _host_buffer_aliasing;
+    } else if constexpr(S == setting::unified_memory_zero_copy) {
+      return _unified_memory_zero_copy;
+    } else if constexpr(S == setting::buffer_min_page_size) {
+      return _buffer_min_page_size;
+    } else if constexpr(S == setting::buffer_eviction) {
+      return _buffer_eviction;
+    } else if constexpr(S == setting::buffer_allocation_cache_size) {
+      return _buffer_allocation_cache_size;
+    } else if constexpr(S == setting::host_thread_pool) {
+      return _host_thread_pool;
+    } else if constexpr(S == setting::host_thread_pool_size) {
+      return _host_thread_pool_size;
+    } else if constexpr(S == setting::host_task_lanes) {
+      return _host_task_lanes;
+    } else if constexpr(S == setting::omp_numa_mode) {
+      return _omp_numa_mode;
+    } else if constexpr(S == setting::omp_sscp_sub_group_size) {
+      return _omp_sscp_sub_group_size;
+    } else if constexpr(S == setting::omp_in_process_jit) {
+      return _omp_in_process_jit;
+    } else if constexpr(S == setting::omp_inline_kernel_max_work_items) {
+      return _omp_inline_kernel_max_work_items;
+    } else if constexpr(S == setting::omp_auto_dynamic_schedule) {
+      return _omp_auto_dynamic_schedule;
+    } else if constexpr(S == setting::omp_huge_pages) {
+      return _omp_huge_pages;
+    } else if constexpr(S == setting::omp_pinned_memory) {
+      return _omp_pinned_memory;
+    } else if constexpr(S == setting::streaming_groups_per_compute_unit) {
+      return _streaming_groups_per_compute_unit;
+    } else if constexpr(S == setting::lazy_events) {
+      return _lazy_events;
+    } else if constexpr(S == setting::adaptive_flush) {
+      return _adaptive_flush;
+    } else if constexpr(S == setting::critical_path_scheduling) {
+      return _critical_path_scheduling;
+    } else if constexpr(S == setting::completion_callbacks) {
+      return _completion_callbacks;
+    } else if constexpr(S == setting::max_wait_spin_time) {
+      return _max_wait_spin_time;
+    } else if constexpr(S == setting::trace_file) {
+      return _trace_file;
+    } else if constexpr(S == setting::statistics_dump_interval) {
+      return _statistics_dump_interval;
+    } else if constexpr(S == setting::statistics_dump_file) {
+      return _statistics_dump_file;
+    } else if constexpr(S == setting::kernel_capture) {
+      return _kernel_capture;
+    } else if constexpr(S == setting::kernel_capture_directory) {
+      return _kernel_capture_directory;
+    } else if constexpr(S == setting::device_timestamps) {
+      return _device_timestamps;
+    } else if constexpr(S == setting::cuda_packed_kernel_args) {
+      return _cuda_packed_kernel_args;
+    } else if constexpr(S == setting::hip_hardware_counters) {
+      return _hip_hardware_counters;
+    } else if constexpr(S == setting::remote_devices) {
+      return _remote_devices;
     }
     return typename setting_trait<S>::type{};
   }
@@ -231,6 +532,14 @@ public:
         get_environment_variable_or_default<setting::ocl_no_shared_context>(false);
     _ocl_show_all_devices =
         get_environment_variable_or_default<setting::ocl_show_all_devices>(false);
+    _ocl_out_of_order_queues = get_environment_variable_or_default<
+        setting::ocl_out_of_order_queues>(false);
+    _hip_direction_aware_memcpy_lanes = get_environment_variable_or_default<
+        setting::hip_direction_aware_memcpy_lanes>(true);
+    _ze_batched_command_lists = get_environment_variable_or_default<
+        setting::ze_batched_command_lists>(false);
+    _ze_copy_engine =
+        get_environment_variable_or_default<setting::ze_copy_engine>(true);
     _no_jit_cache_population =
         get_environment_variable_or_default<setting::no_jit_cache_population>(false);
     _adaptivity_level =
@@ -242,6 +551,127 @@ public:
         get_environment_variable_or_default<setting::jitopt_iads_relative_eviction_threshold>(0.1);
     _jitopt_iads_relative_threshold_min_data =
         get_environment_variable_or_default<setting::jitopt_iads_relative_threshold_min_data>(1024);
+    _jitopt_iads_statistics_merge_interval =
+        get_environment_variable_or_default<setting::jitopt_iads_statistics_merge_interval>(256);
+    _jitopt_tiered_compilation_threshold =
+        get_environment_variable_or_default<setting::jitopt_tiered_compilation_threshold>(0);
+    _jitopt_iads_pointer_noalias =
+        get_environment_variable_or_default<setting::jitopt_iads_pointer_noalias>(false);
+    _jitopt_iads_value_ranges =
+        get_environment_variable_or_default<setting::jitopt_iads_value_ranges>(true);
+    _jitopt_local_memory_tiling =
+        get_environment_variable_or_default<setting::jitopt_local_memory_tiling>(false);
+    _jitopt_aggregate_atomics =
+        get_environment_variable_or_default<setting::jitopt_aggregate_atomics>(false);
+    _jitopt_performance_remarks =
+        get_environment_variable_or_default<setting::jitopt_performance_remarks>(false);
+    _jitopt_local_memory_padding =
+        get_environment_variable_or_default<setting::jitopt_local_memory_padding>(false);
+    _jitopt_fcall_inline_cache_size =
+        get_environment_variable_or_default<setting::jitopt_fcall_inline_cache_size>(0);
+    _jitopt_pgo_profiled_invocations =
+        get_environment_variable_or_default<setting::jitopt_pgo_profiled_invocations>(16);
+    _async_jit_threads =
+        get_environment_variable_or_default<setting::async_jit_threads>(0);
+    _jit_precompile =
+        get_environment_variable_or_default<setting::jit_precompile>(false);
+    _packed_jit_cache =
+        get_environment_variable_or_default<setting::packed_jit_cache>(false);
+    _jit_cache_max_size =
+        get_environment_variable_or_default<setting::jit_cache_max_size>(0);
+    _jit_cache_compression_level = get_environment_variable_or_default<
+        setting::jit_cache_compression_level>(3);
+    _shared_jit_compilation =
+        get_environment_variable_or_default<setting::shared_jit_compilation>(
+            false);
+    _shared_jit_compilation_timeout = get_environment_variable_or_default<
+        setting::shared_jit_compilation_timeout>(0);
+    _kernel_batching_max_work_items = get_environment_variable_or_default<
+        setting::kernel_batching_max_work_items>(0);
+    _scratch_cache_max_size = get_environment_variable_or_default<
+        setting::scratch_cache_max_size>(512);
+    _device_heap_size =
+        get_environment_variable_or_default<setting::device_heap_size>(64);
+    _stream_ordered_allocation =
+        get_environment_variable_or_default<setting::stream_ordered_allocation>(
+            false);
+    _mem_pool_release_threshold = get_environment_variable_or_default<
+        setting::mem_pool_release_threshold>(0);
+    _mem_pool_opportunistic_reuse = get_environment_variable_or_default<
+        setting::mem_pool_opportunistic_reuse>(true);
+    _peer_access =
+        get_environment_variable_or_default<setting::peer_access>(true);
+    _pipelined_transfer_chunk_size = get_environment_variable_or_default<
+        setting::pipelined_transfer_chunk_size>(0);
+    _staging_buffer_size =
+        get_environment_variable_or_default<setting::staging_buffer_size>(4);
+    _staging_pool_size =
+        get_environment_variable_or_default<setting::staging_pool_size>(4);
+    _host_buffer_aliasing =
+        get_environment_variable_or_default<setting::host_buffer_aliasing>(
+            false);
+    _unified_memory_zero_copy =
+        get_environment_variable_or_default<setting::unified_memory_zero_copy>(
+            false);
+    _buffer_min_page_size =
+        get_environment_variable_or_default<setting::buffer_min_page_size>(0);
+    _buffer_eviction =
+        get_environment_variable_or_default<setting::buffer_eviction>(true);
+    _buffer_allocation_cache_size = get_environment_variable_or_default<
+        setting::buffer_allocation_cache_size>(0);
+    _host_thread_pool =
+        get_environment_variable_or_default<setting::host_thread_pool>(false);
+    _host_thread_pool_size =
+        get_environment_variable_or_default<setting::host_thread_pool_size>(0);
+    _host_task_lanes =
+        get_environment_variable_or_default<setting::host_task_lanes>(4);
+    _omp_numa_mode =
+        get_environment_variable_or_default<setting::omp_numa_mode>(false);
+    _omp_sscp_sub_group_size =
+        get_environment_variable_or_default<setting::omp_sscp_sub_group_size>(
+            1);
+    _omp_in_process_jit =
+        get_environment_variable_or_default<setting::omp_in_process_jit>(true);
+    _omp_inline_kernel_max_work_items = get_environment_variable_or_default<
+        setting::omp_inline_kernel_max_work_items>(0);
+    _omp_auto_dynamic_schedule =
+        get_environment_variable_or_default<setting::omp_auto_dynamic_schedule>(
+            false);
+    _omp_huge_pages = get_environment_variable_or_default<setting::omp_huge_pages>(
+        omp_huge_page_policy::none);
+    _omp_pinned_memory =
+        get_environment_variable_or_default<setting::omp_pinned_memory>(false);
+    _streaming_groups_per_compute_unit = get_environment_variable_or_default<
+        setting::streaming_groups_per_compute_unit>(4);
+    _lazy_events =
+        get_environment_variable_or_default<setting::lazy_events>(false);
+    _adaptive_flush =
+        get_environment_variable_or_default<setting::adaptive_flush>(false);
+    _critical_path_scheduling = get_environment_variable_or_default<
+        setting::critical_path_scheduling>(false);
+    _completion_callbacks = get_environment_variable_or_default<
+        setting::completion_callbacks>(false);
+    _max_wait_spin_time = get_environment_variable_or_default<
+        setting::max_wait_spin_time>(0);
+    _trace_file =
+        get_environment_variable_or_default<setting::trace_file>(std::string{});
+    _statistics_dump_interval = get_environment_variable_or_default<
+        setting::statistics_dump_interval>(0);
+    _statistics_dump_file = get_environment_variable_or_default<
+        setting::statistics_dump_file>(std::string{});
+    _kernel_capture = get_environment_variable_or_default<
+        setting::kernel_capture>(std::string{});
+    _kernel_capture_directory = get_environment_variable_or_default<
+        setting::kernel_capture_directory>(std::string{"."});
+    _device_timestamps =
+        get_environment_variable_or_default<setting::device_timestamps>(false);
+    _cuda_packed_kernel_args = get_environment_variable_or_default<
+        setting::cuda_packed_kernel_args>(0);
+    _hip_hardware_counters =
+        get_environment_variable_or_default<setting::hip_hardware_counters>(
+            false);
+    _remote_devices = get_environment_variable_or_default<
+        setting::remote_devices>(std::string{});
   }
 
 private:
@@ -268,11 +698,72 @@ private:
   visibility_mask_t _visibility_mask;
   bool _ocl_no_shared_context;
   bool _ocl_show_all_devices;
+  bool _ocl_out_of_order_queues;
+  bool _hip_direction_aware_memcpy_lanes;
+  bool _ze_batched_command_lists;
+  bool _ze_copy_engine;
   bool _no_jit_cache_population;
   int _adaptivity_level;
   double _jitopt_iads_relative_threshold;
   double _jitopt_iads_relative_eviction_threshold;
   std::size_t _jitopt_iads_relative_threshold_min_data;
+  std::size_t _jitopt_iads_statistics_merge_interval;
+  std::size_t _jitopt_tiered_compilation_threshold;
+  bool _jitopt_iads_pointer_noalias;
+  bool _jitopt_iads_value_ranges;
+  bool _jitopt_local_memory_tiling;
+  bool _jitopt_aggregate_atomics;
+  bool _jitopt_performance_remarks;
+  bool _jitopt_local_memory_padding;
+  std::size_t _jitopt_fcall_inline_cache_size;
+  std::size_t _jitopt_pgo_profiled_invocations;
+  std::size_t _async_jit_threads;
+  bool _jit_precompile;
+  bool _packed_jit_cache;
+  std::size_t _jit_cache_max_size;
+  int _jit_cache_compression_level;
+  bool _shared_jit_compilation;
+  std::size_t _shared_jit_compilation_timeout;
+  std::size_t _kernel_batching_max_work_items;
+  std::size_t _scratch_cache_max_size;
+  std::size_t _device_heap_size;
+  bool _stream_ordered_allocation;
+  std::size_t _mem_pool_release_threshold;
+  bool _mem_pool_opportunistic_reuse;
+  bool _peer_access;
+  std::size_t _pipelined_transfer_chunk_size;
+  std::size_t _staging_buffer_size;
+  std::size_t _staging_pool_size;
+  bool _host_buffer_aliasing;
+  bool _unified_memory_zero_copy;
+  std::size_t _buffer_min_page_size;
+  bool _buffer_eviction;
+  std::size_t _buffer_allocation_cache_size;
+  bool _host_thread_pool;
+  std::size_t _host_thread_pool_size;
+  std::size_t _host_task_lanes;
+  bool _omp_numa_mode;
+  std::size_t _omp_sscp_sub_group_size;
+  bool _omp_in_process_jit;
+  std::size_t _omp_inline_kernel_max_work_items;
+  bool _omp_auto_dynamic_schedule;
+  omp_huge_page_policy _omp_huge_pages;
+  bool _omp_pinned_memory;
+  std::size_t _streaming_groups_per_compute_unit;
+  bool _lazy_events;
+  bool _adaptive_flush;
+  bool _critical_path_scheduling;
+  bool _completion_callbacks;
+  std::size_t _max_wait_spin_time;
+  std::string _trace_file;
+  std::size_t _statistics_dump_interval;
+  std::string _statistics_dump_file;
+  std::string _kernel_capture;
+  std::string _kernel_capture_directory;
+  bool _device_timestamps;
+  std::size_t _cuda_packed_kernel_args;
+  bool _hip_hardware_counters;
+  std::string _remote_devices;
 };
 
 }
@@ -11,41 +11,53 @@
 #ifndef HIPSYCL_SIGNAL_CHANNEL_HPP
 #define HIPSYCL_SIGNAL_CHANNEL_HPP
 
-#include <future>
-#include <chrono>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 
+#include "generic/spin_wait.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+/// One-shot signal. Signalling only locks if a thread has started
+/// to sleep in wait(), which keeps it cheap for events that are
+/// never waited on.
 class signal_channel {
 public:
-  signal_channel() {
-    _shared_future = _promise.get_future().share();
-    _has_signalled_flag = false;
-  }
+  signal_channel()
+  : _has_signalled_flag{false}, _num_sleeping_waiters{0} {}
 
   void signal() {
-    _has_signalled_flag = true;
-    _promise.set_value(true);
+    _has_signalled_flag.store(true, std::memory_order_seq_cst);
+    if(_num_sleeping_waiters.load(std::memory_order_seq_cst) > 0) {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _condition.notify_all();
+    }
   }
 
   void wait() {
-    auto future = _shared_future;
-    future.wait();
+    auto has_signalled = [this]() { return this->has_signalled(); };
+    if(spin_until(has_signalled))
+      return;
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    _num_sleeping_waiters.fetch_add(1, std::memory_order_seq_cst);
+    _condition.wait(lock, has_signalled);
+    _num_sleeping_waiters.fetch_sub(1, std::memory_order_relaxed);
   }
 
   bool has_signalled() const {
-    return _has_signalled_flag;
+    // Must be seq_cst such that sleeping waiters and signal() cannot
+    // both miss each other
+    return _has_signalled_flag.load(std::memory_order_seq_cst);
   }
 
 private:
-  std::promise<bool> _promise;
-  std::shared_future<bool> _shared_future;
-  // This flag is a workaround for a serious performance
-  // bug in libstdc++ prior to version 11, where the
-  // future::wait_for(duration(0)) pattern is extremely inefficient
   std::atomic<bool> _has_signalled_flag;
+  std::atomic<int> _num_sleeping_waiters;
+  std::mutex _mutex;
+  std::condition_variable _condition;
 };
 
 }
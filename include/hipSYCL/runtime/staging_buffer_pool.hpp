@@ -0,0 +1,88 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_STAGING_BUFFER_POOL_HPP
+#define HIPSYCL_STAGING_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include "allocator.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+/// Pool of fixed-size pinned host buffers used to stage transfers
+/// between pageable host memory and a device. Buffers are allocated
+/// lazily using \c allocate_optimized_host() of the provided allocator,
+/// up to \c max_buffers buffers.
+class staging_buffer_pool {
+public:
+  staging_buffer_pool(backend_allocator *alloc, std::size_t buffer_size,
+                      std::size_t max_buffers)
+      : _allocator{alloc}, _buffer_size{buffer_size},
+        _max_buffers{max_buffers}, _num_allocated_buffers{0} {}
+
+  ~staging_buffer_pool() {
+    for(void* buff : _available_buffers)
+      _allocator->free(buff);
+  }
+
+  staging_buffer_pool(const staging_buffer_pool&) = delete;
+  staging_buffer_pool& operator=(const staging_buffer_pool&) = delete;
+
+  std::size_t get_buffer_size() const {
+    return _buffer_size;
+  }
+
+  bool is_enabled() const {
+    return _buffer_size > 0 && _max_buffers > 0;
+  }
+
+  // Obtain a buffer of get_buffer_size() bytes from the pool. Returns nullptr
+  // if the pool is exhausted or allocation fails. Obtained buffers must
+  // be returned using release_buffer() once they are no longer used
+  // by the device.
+  void* obtain_buffer() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(!_available_buffers.empty()) {
+      void* buff = _available_buffers.back();
+      _available_buffers.pop_back();
+      return buff;
+    }
+    if(!is_enabled() || _num_allocated_buffers >= _max_buffers)
+      return nullptr;
+
+    void *buff = _allocator->allocate_optimized_host(0, _buffer_size);
+    if(buff)
+      ++_num_allocated_buffers;
+    return buff;
+  }
+
+  void release_buffer(void* buff) {
+    if(!buff)
+      return;
+    std::lock_guard<std::mutex> lock{_mutex};
+    _available_buffers.push_back(buff);
+  }
+
+private:
+  backend_allocator* _allocator;
+  std::size_t _buffer_size;
+  std::size_t _max_buffers;
+  std::size_t _num_allocated_buffers;
+  std::vector<void*> _available_buffers;
+  std::mutex _mutex;
+};
+
+}
+}
+
+#endif
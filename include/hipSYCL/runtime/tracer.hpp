@@ -0,0 +1,136 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_TRACER_HPP
+#define HIPSYCL_TRACER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "device_id.hpp"
+#include "instrumentation.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+class dag_node;
+
+/// Records a timeline of runtime activity if ACPP_RT_TRACE_FILE is set,
+/// and writes it in Chrome trace event format (which can be viewed e.g.
+/// in Perfetto or chrome://tracing) when the runtime shuts down.
+///
+/// Host spans are recorded by each thread into its own buffer without
+/// locking. Device spans are obtained from the execution timestamps of
+/// completed DAG nodes, for which the SYCL queue requests instrumentation
+/// while tracing is enabled.
+///
+/// This class is thread-safe.
+class tracer {
+public:
+  static tracer& get();
+
+  bool is_enabled() const {
+    return _is_enabled;
+  }
+
+  /// Records a span of the calling thread. name and category must
+  /// remain valid until the trace is written, e.g. string literals.
+  void record_host_span(const char *name, const char *category,
+                        profiler_clock::time_point begin,
+                        profiler_clock::time_point end);
+
+  /// Records the execution of a completed node on its device and execution
+  /// lane, if execution timestamps are available.
+  void record_device_span(const std::shared_ptr<dag_node>& node);
+
+  /// Writes all spans recorded so far to the trace file.
+  void write_trace() const;
+
+private:
+  tracer();
+
+  struct event {
+    const char* name;
+    const char* category;
+    uint64_t begin;
+    uint64_t end;
+    // Only for device spans
+    bool is_device_event;
+    device_id dev;
+    const void* lane;
+  };
+
+  // Events of one thread. Only the owning thread appends events, other
+  // threads may read the events published by the size of each chunk.
+  struct thread_buffer {
+    static constexpr std::size_t chunk_size = 4096;
+
+    struct chunk {
+      std::array<event, chunk_size> events;
+      std::atomic<std::size_t> size{0};
+      std::atomic<chunk*> next{nullptr};
+    };
+
+    thread_buffer(std::size_t index)
+    : thread_index{index}, first{new chunk}, current{first.get()} {}
+
+    ~thread_buffer();
+
+    void append(const event& e);
+
+    std::size_t thread_index;
+    std::unique_ptr<chunk> first;
+    chunk* current;
+  };
+
+  void record(const event& e);
+  thread_buffer* get_thread_buffer();
+
+  bool _is_enabled;
+  std::string _trace_file;
+
+  mutable std::mutex _mutex;
+  std::vector<std::unique_ptr<thread_buffer>> _buffers;
+};
+
+/// Records the lifetime of the object as host span, if tracing is enabled.
+class trace_span {
+public:
+  trace_span(const char *name, const char *category = "runtime")
+      : _name{name}, _category{category},
+        _is_active{tracer::get().is_enabled()} {
+    if(_is_active)
+      _begin = profiler_clock::now();
+  }
+
+  ~trace_span() {
+    if(_is_active)
+      tracer::get().record_host_span(_name, _category, _begin,
+                                     profiler_clock::now());
+  }
+
+  trace_span(const trace_span&) = delete;
+  trace_span& operator=(const trace_span&) = delete;
+private:
+  const char* _name;
+  const char* _category;
+  bool _is_active;
+  profiler_clock::time_point _begin;
+};
+
+}
+}
+
+#endif
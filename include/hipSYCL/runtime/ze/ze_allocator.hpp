@@ -22,7 +22,8 @@ namespace rt {
 class ze_allocator : public backend_allocator 
 {
 public:
-  ze_allocator(const ze_hardware_context* dev, const ze_hardware_manager* hw_manager);
+  ze_allocator(const ze_hardware_context *dev,
+               const ze_hardware_manager *hw_manager, device_id dev_id);
 
   virtual void* allocate(size_t min_alignment, size_t size_bytes) override;
 
@@ -44,6 +45,7 @@ private:
   uint32_t _global_mem_ordinal;
 
   const ze_hardware_manager* _hw_manager;
+  device_id _dev_id;
 };
 
 }
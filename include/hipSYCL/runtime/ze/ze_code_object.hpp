@@ -11,7 +11,13 @@
 #ifndef HIPSYCL_ZE_CODE_OBJECT_HPP
 #define HIPSYCL_ZE_CODE_OBJECT_HPP
 
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include <level_zero/ze_api.h>
 
@@ -51,10 +57,42 @@ enum class ze_source_format {
   native
 };
 
+/// A Level Zero kernel handle together with the launch configuration that
+/// was most recently set on it. Kernel arguments are state of the handle,
+/// so a submission needs exclusive access to the instance until the launch
+/// has been appended to a command list. Since consecutive launches through
+/// the same instance often use the same configuration, unchanged group
+/// sizes and arguments are not set again.
+class ze_kernel_instance {
+public:
+  ze_kernel_instance(ze_kernel_handle_t handle, std::string_view kernel_name);
+
+  ze_kernel_handle_t get_handle() const { return _handle; }
+  std::string_view get_kernel_name() const { return _kernel_name; }
+
+  result set_group_size(const rt::range<3> &group_size);
+  // If value is nullptr, the argument is set to a null pointer.
+  result set_argument(std::size_t index, std::size_t size, const void *value);
+private:
+  struct argument {
+    bool is_set = false;
+    bool is_null = false;
+    std::vector<char> value;
+  };
+
+  ze_kernel_handle_t _handle;
+  std::string_view _kernel_name;
+  uint32_t _group_size[3] = {0, 0, 0};
+  std::vector<argument> _arguments;
+};
+
 class ze_executable_object : public code_object {
 public:
+  // If native_binary_id is provided, the device-native binary is loaded from
+  // or stored in the persistent kernel cache using this id.
   ze_executable_object(ze_context_handle_t ctx, ze_device_handle_t dev,
-    hcf_object_id source, ze_source_format fmt, const std::string& code_image);
+    hcf_object_id source, ze_source_format fmt, const std::string& code_image,
+    const std::optional<kernel_configuration::id_type> &native_binary_id = {});
   virtual ~ze_executable_object();
 
   result get_build_result() const;
@@ -72,18 +110,36 @@ public:
 
   ze_device_handle_t get_ze_device() const;
   ze_context_handle_t get_ze_context() const;
-  // This should only be called inside ze_queue, not the user,
-  // so we do not have to worry about thread-safety. Only works
-  // if the module has been built successfully
-  result get_kernel(std::string_view name, ze_kernel_handle_t& out) const;
+  // Obtains exclusive access to an instance of the kernel, which must be
+  // returned using release_kernel() once the launch has been appended to a
+  // command list. Instances are created on demand when multiple threads
+  // submit the same kernel concurrently. Only works if the module has been
+  // built successfully.
+  result acquire_kernel(std::string_view name, ze_kernel_instance *&out) const;
+  void release_kernel(ze_kernel_instance *kernel) const;
 private:
+  struct kernel_pool {
+    std::vector<std::unique_ptr<ze_kernel_instance>> instances;
+    std::vector<ze_kernel_instance *> available;
+  };
+
+  result create_kernel_instance(std::string_view name,
+                                kernel_pool &pool) const;
+  // Creates _module from the native binary in the persistent cache,
+  // if available.
+  bool load_native_binary(const kernel_configuration::id_type &native_binary_id,
+                          const ze_module_desc_t &spirv_desc);
+  void store_native_binary(const kernel_configuration::id_type &native_binary_id,
+                           uint64_t build_time);
+
   ze_source_format _format;
   hcf_object_id _source;
   ze_context_handle_t _ctx;
   ze_device_handle_t _dev;
   ze_module_handle_t _module;
   std::vector<std::string> _kernels;
-  std::unordered_map<std::string_view, ze_kernel_handle_t> _kernel_handles;
+  mutable std::mutex _kernel_pool_mutex;
+  mutable std::unordered_map<std::string_view, kernel_pool> _kernel_pools;
   
   void load_kernel_handles();
 
@@ -95,7 +151,8 @@ public:
   ze_sscp_executable_object(ze_context_handle_t ctx, ze_device_handle_t dev,
                             hcf_object_id source,
                             const std::string &spirv_image,
-                            const kernel_configuration &config);
+                            const kernel_configuration &config,
+                            const kernel_configuration::id_type &native_binary_id);
   ~ze_sscp_executable_object() {}
 
   virtual compilation_flow source_compilation_flow() const override;
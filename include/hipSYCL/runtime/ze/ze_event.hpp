@@ -8,6 +8,7 @@
  * See file LICENSE in the project root for full license details.
  */
 // SPDX-License-Identifier: BSD-2-Clause
+#include <atomic>
 #include <memory>
 #include <level_zero/ze_api.h>
 
@@ -19,13 +20,42 @@
 namespace hipsycl {
 namespace rt {
 
+class ze_queue;
+
+/// A batch of commands that a ze_queue records into regular command lists
+/// (ACPP_RT_ZE_BATCHED_COMMAND_LISTS). The events of commands in the batch
+/// cannot complete before the batch has been submitted, so waiting for them
+/// first needs to make sure that this has happened.
+class ze_command_batch {
+public:
+  ze_command_batch(ze_queue* q)
+  : _queue{q}, _is_submitted{false} {}
+
+  bool is_submitted() const {
+    return _is_submitted.load(std::memory_order_acquire);
+  }
+
+  /// Submits the batch, if it has not yet been submitted.
+  void ensure_submitted();
+
+  /// Only for use by the ze_queue that owns the batch
+  void mark_submitted() {
+    _is_submitted.store(true, std::memory_order_release);
+  }
+private:
+  ze_queue* _queue;
+  std::atomic<bool> _is_submitted;
+};
 
 class ze_node_event : public inorder_queue_event<ze_event_handle_t>
 {
 public:
   /// Takes ownership of supplied ze_event_handle_t
-  ze_node_event(ze_event_handle_t evt, 
-    std::shared_ptr<ze_event_pool_handle_t> pool);
+  ///
+  /// If batch is non-null, the event is signalled by a command of that batch.
+  ze_node_event(ze_event_handle_t evt,
+    std::shared_ptr<ze_event_pool_handle_t> pool,
+    std::shared_ptr<ze_command_batch> batch = nullptr);
   ~ze_node_event();
 
   virtual bool is_complete() const override;
@@ -33,9 +63,15 @@ public:
 
   ze_event_handle_t get_event_handle() const;
   virtual ze_event_handle_t request_backend_event() override;
+
+  /// Submits the command batch that signals this event, if there is one
+  /// and it has not yet been submitted. This must happen before waiting
+  /// for the event on other queues.
+  void ensure_submitted() const;
 private:
   ze_event_handle_t _evt;
   std::shared_ptr<ze_event_pool_handle_t> _pool;
+  std::shared_ptr<ze_command_batch> _batch;
 };
 
 
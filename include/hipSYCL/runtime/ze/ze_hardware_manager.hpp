@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <memory>
+#include <optional>
 #include <level_zero/ze_api.h>
 
 #include "../hardware.hpp"
@@ -100,6 +101,11 @@ public:
   { return _ctx; }
 
   uint32_t get_ze_global_memory_ordinal() const;
+  /// \return The ordinal of the command queue group of the compute engines
+  uint32_t get_ze_compute_queue_ordinal() const;
+  /// \return The ordinal of a command queue group that only supports
+  /// copies, i.e. of dedicated copy engines, if the device has one
+  std::optional<uint32_t> get_ze_copy_queue_ordinal() const;
 
 private:
   ze_driver_handle_t _driver;
@@ -109,6 +115,7 @@ private:
   ze_device_properties_t _props;
   ze_device_compute_properties_t _compute_props;
   std::vector<ze_device_memory_properties_t> _memory_props;
+  std::vector<ze_command_queue_group_properties_t> _queue_group_props;
 };
 
 class ze_hardware_manager : public backend_hardware_manager
@@ -13,6 +13,7 @@
 
 #include <future>
 #include <mutex>
+#include <vector>
 #include <level_zero/ze_api.h>
 
 #include "../executor.hpp"
@@ -22,6 +23,7 @@
 #include "hipSYCL/runtime/event.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "ze_code_object.hpp"
+#include "ze_event.hpp"
 
 
 namespace hipsycl {
@@ -59,8 +61,10 @@ public:
 
   virtual result query_status(inorder_queue_status& status) override;
 
+  /// In batched mode, this is the command list of the compute engine
+  /// that commands are currently recorded into.
   ze_command_list_handle_t get_ze_command_list() const {
-    return _command_list;
+    return _compute_engine.current.list;
   }
 
   ze_hardware_manager* get_hardware_manager() const {
@@ -74,7 +78,42 @@ public:
       unsigned local_mem_size, void **args, std::size_t *arg_sizes,
       std::size_t num_args, const kernel_configuration &config);
 
+  /// Submits the commands of the batch, if it is the batch that is currently
+  /// being recorded. Only relevant if batched command lists are used.
+  void submit_batch(ze_command_batch* batch);
 private:
+  struct command_list_slot {
+    ze_command_list_handle_t list = nullptr;
+    // Only used in batched mode, to find out when the list can be reused
+    ze_fence_handle_t fence = nullptr;
+  };
+
+  // Commands of this queue that are executed on one engine of the device
+  struct engine {
+    uint32_t ordinal = 0;
+    // In batched mode, the regular command list that is being recorded.
+    // Otherwise, an immediate command list.
+    command_list_slot current;
+    // Only used in batched mode
+    ze_command_queue_handle_t command_queue = nullptr;
+    std::size_t num_recorded_commands = 0;
+    std::vector<command_list_slot> in_flight_lists;
+    std::vector<command_list_slot> free_lists;
+  };
+
+  result init_engine(engine &e, uint32_t ordinal);
+  void destroy_engine(engine &e);
+  result obtain_command_list(engine &e, command_list_slot &out);
+  void retire_completed_command_lists(engine &e);
+  engine &get_copy_engine();
+
+  // Must be invoked after a command has been appended to the current
+  // command list of e. In batched mode, decides whether to submit
+  // the batch.
+  result notify_command_recorded(engine& e);
+  result submit_current_batch();
+
+
   const std::vector<std::shared_ptr<dag_node_event>>&
   get_enqueued_synchronization_ops() const;
   
@@ -83,9 +122,16 @@ private:
 
   void register_submitted_op(std::shared_ptr<dag_node_event> evt);
 
-  std::shared_ptr<dag_node_event> create_event();
+  // If is_recorded_command is true, the event is signalled by a command
+  // of the current batch.
+  std::shared_ptr<dag_node_event> create_event(bool is_recorded_command = true);
+
+  bool _is_batched;
+  bool _has_copy_engine;
+  engine _compute_engine;
+  engine _copy_engine;
+  std::shared_ptr<ze_command_batch> _current_batch;
 
-  ze_command_list_handle_t _command_list;
   ze_hardware_manager* _hw_manager;
   const std::size_t _device_index;
 
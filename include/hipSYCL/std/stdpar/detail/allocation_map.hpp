@@ -87,12 +87,63 @@ public:
   static_assert(std::is_trivial_v<UserPayload>, "UserPayload must be trivial type");
 
   allocation_map()
-  : _num_in_progress_operations{0} {}
+  : _num_in_progress_operations{0}, _num_erasures{0} {}
 
   struct value_type : public UserPayload {
     std::size_t allocation_size;
   };
 
+  // Remembers the most recently resolved allocations of get_entry(), such
+  // that repeated lookups of pointers into the same allocations need not
+  // walk the tree. Cached entries are invalidated by any erase(), since
+  // erase() may release tree nodes. Caches are not thread-safe, so each
+  // thread should use its own. This type is trivially destructible, so it
+  // can be used as thread_local even in malloc()/free().
+  class lookup_cache {
+  public:
+    static constexpr int num_entries = 4;
+
+    value_type* find(uint64_t address, uint64_t erase_generation,
+                     uint64_t& root_address) noexcept {
+      for(int i = 0; i < _num_valid_entries; ++i) {
+        auto& e = _entries[i];
+        if(e.erase_generation == erase_generation &&
+           address >= e.root_address &&
+           address < e.root_address + e.allocation_size) {
+          root_address = e.root_address;
+          value_type* result = e.value;
+          // Move to front
+          for(int j = i; j > 0; --j)
+            _entries[j] = _entries[j - 1];
+          _entries[0] = cache_entry{root_address, result->allocation_size,
+                                    erase_generation, result};
+          return result;
+        }
+      }
+      return nullptr;
+    }
+
+    void insert(uint64_t root_address, value_type* value,
+                uint64_t erase_generation) noexcept {
+      if(_num_valid_entries < num_entries)
+        ++_num_valid_entries;
+      for(int j = _num_valid_entries - 1; j > 0; --j)
+        _entries[j] = _entries[j - 1];
+      _entries[0] = cache_entry{root_address, value->allocation_size,
+                                erase_generation, value};
+    }
+  private:
+    struct cache_entry {
+      uint64_t root_address;
+      std::size_t allocation_size;
+      uint64_t erase_generation;
+      value_type* value;
+    };
+
+    cache_entry _entries[num_entries];
+    int _num_valid_entries = 0;
+  };
+
   // Access entry of allocation that address belongs to, or nullptr if the address
   // does not belong to a known allocation.
   value_type* get_entry(uint64_t address, uint64_t& root_address) noexcept {
@@ -102,6 +153,27 @@ public:
     return get_entry(_root, address, num_leaf_attempts, root_address);
   }
 
+  // Like get_entry(), but first consults the provided cache of recently
+  // resolved allocations, and adds the result to it.
+  value_type* get_entry(uint64_t address, uint64_t& root_address,
+                        lookup_cache& cache) noexcept {
+    insert_or_get_entry_lock lock{_num_in_progress_operations};
+    return get_cached_entry(address, root_address, cache);
+  }
+
+  // Resolves the entries of multiple addresses at once, taking the lock
+  // of the map only once. Addresses that fall into an allocation resolved
+  // earlier in the batch or recently before are not looked up in the tree
+  // again. entries[i] is nullptr if addresses[i] does not belong to a
+  // known allocation.
+  void get_entries(const uint64_t *addresses, std::size_t num_addresses,
+                   value_type **entries, uint64_t *root_addresses,
+                   lookup_cache &cache) noexcept {
+    insert_or_get_entry_lock lock{_num_in_progress_operations};
+    for(std::size_t i = 0; i < num_addresses; ++i)
+      entries[i] = get_cached_entry(addresses[i], root_addresses[i], cache);
+  }
+
   // Access entry of allocation that has the given address. Unlike get_entry(),
   // this does not succeed if the address does not point to the base of the allocation.
   value_type* get_entry_of_root_address(uint64_t address) noexcept {
@@ -120,6 +192,7 @@ public:
 
   bool erase(uint64_t address) {
     erase_lock lock{_num_in_progress_operations};
+    _num_erasures.fetch_add(1, std::memory_order_acq_rel);
     return erase(_root, address);
   }
 
@@ -132,6 +205,23 @@ public:
   }
     
 private:
+  // Must be invoked with the insert_or_get_entry_lock held, which
+  // excludes concurrent erase() calls.
+  value_type *get_cached_entry(uint64_t address, uint64_t &root_address,
+                               lookup_cache &cache) noexcept {
+    uint64_t erase_generation = _num_erasures.load(std::memory_order_acquire);
+    if(auto* cached = cache.find(address, erase_generation, root_address))
+      return cached;
+
+    root_address = 0;
+    int num_leaf_attempts = 0;
+    value_type* result =
+        get_entry(_root, address, num_leaf_attempts, root_address);
+    if(result)
+      cache.insert(root_address, result, erase_generation);
+    return result;
+  }
+
   // Useful for debugging/printing
   template<class F>
   void with_decomposed_address(uint64_t address, int current_level, F&& handler) {
@@ -475,6 +565,7 @@ private:
 
   intermediate_node<root_level_idx> _root;
   std::atomic<int> _num_in_progress_operations;
+  std::atomic<uint64_t> _num_erasures;
 };
 
 
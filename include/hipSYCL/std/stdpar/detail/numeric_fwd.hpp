@@ -49,6 +49,61 @@ HIPSYCL_STDPAR_ENTRYPOINT T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
 template <class ForwardIt, class T, class BinaryOp>
 HIPSYCL_STDPAR_ENTRYPOINT T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
                                    ForwardIt last, T init, BinaryOp binary_op);
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first);
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op);
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, T init);
+
+template <class ForwardIt1, class ForwardIt2, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 exclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init);
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 exclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init, BinaryOp binary_op);
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, UnaryOp unary_op);
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, UnaryOp unary_op,
+    T init);
+
+template <class ForwardIt1, class ForwardIt2, class T,
+          class BinaryOp, class UnaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_exclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init,
+    BinaryOp binary_op, UnaryOp unary_op);
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 adjacent_difference(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first);
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 adjacent_difference(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp op);
 }
 
 #endif
@@ -18,6 +18,7 @@
 #include "hipSYCL/std/stdpar/detail/sycl_glue.hpp"
 #include "hipSYCL/std/stdpar/detail/offload_heuristic_db.hpp"
 
+#include "hipSYCL/algorithms/numeric.hpp"
 #include "hipSYCL/glue/reflection.hpp"
 #include "hipSYCL/common/stable_running_hash.hpp"
 
@@ -30,8 +31,11 @@
 #include <algorithm>
 #include <chrono>
 #include <limits>
+#include <memory>
 #include <sys/types.h>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace hipsycl::stdpar {
 
@@ -98,6 +102,113 @@ void for_each_contained_pointer(Handler&& h, const Args&... args) {
   (f(args), ...);
 }
 
+#if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
+/// Invokes h(lookup_result) for each pointer contained in args that belongs
+/// to a stdpar allocation. Pointers are resolved in batches, locking the
+/// allocation map only once per batch.
+template<class Handler, typename... Args>
+void for_each_contained_allocation(Handler&& h, const Args&... args) {
+  constexpr std::size_t max_batch_size = 16;
+  void* ptrs[max_batch_size];
+  unified_shared_memory::allocation_lookup_result results[max_batch_size];
+  std::size_t num_ptrs = 0;
+
+  auto flush = [&](){
+    unified_shared_memory::allocation_lookup(ptrs, num_ptrs, results);
+    for(std::size_t i = 0; i < num_ptrs; ++i)
+      if(results[i].info)
+        h(results[i]);
+    num_ptrs = 0;
+  };
+
+  for_each_contained_pointer([&](void* ptr){
+    ptrs[num_ptrs++] = ptr;
+    if(num_ptrs == max_batch_size)
+      flush();
+  }, args...);
+
+  if(num_ptrs > 0)
+    flush();
+}
+#endif
+
+#if defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
+template<class T>
+constexpr bool is_contiguous_iterator() {
+#if __cplusplus >= 202002L
+  return std::contiguous_iterator<T>;
+#else
+  return std::is_pointer_v<T>;
+#endif
+}
+
+/// Invokes h(ptr, num_bytes) for each contiguous iterator in args, assuming
+/// that each of them refers to problem_size elements. This only holds
+/// for algorithms where all iterator arguments span the entire problem.
+template<class Handler, typename... Args>
+void for_each_contained_range(Handler&& h, std::size_t problem_size,
+                              const Args&... args) {
+  auto f = [&](const auto& arg){
+    using arg_type = std::decay_t<decltype(arg)>;
+    if constexpr (is_contiguous_iterator<arg_type>()) {
+      using value_type = typename std::iterator_traits<arg_type>::value_type;
+      const void* ptr = nullptr;
+      if constexpr (std::is_pointer_v<arg_type>)
+        ptr = static_cast<const void*>(arg);
+#if __cplusplus >= 202002L
+      else
+        ptr = static_cast<const void*>(std::to_address(arg));
+#endif
+      if(ptr)
+        h(ptr, problem_size * sizeof(value_type));
+    }
+  };
+  (f(args), ...);
+}
+
+/// Remembers the most recently prefetched memory ranges of a thread.
+/// Without an allocation map, this is what prevents prefetching
+/// system memory that is already resident on the device again.
+class system_memory_prefetch_tracker {
+public:
+  /// Returns whether [ptr, ptr+num_bytes) needs to be prefetched in
+  /// the offloading batch batch_id, and records the prefetch if so.
+  /// If only_first_use is true, ranges are only prefetched the first
+  /// time they are encountered.
+  bool should_prefetch(const void *ptr, std::size_t num_bytes,
+                       std::size_t batch_id, bool only_first_use) {
+    const char* begin = static_cast<const char*>(ptr);
+    const char* end = begin + num_bytes;
+    for(auto& r : _ranges) {
+      if(r.begin <= begin && end <= r.end) {
+        if(only_first_use || r.batch_id == static_cast<int64_t>(batch_id))
+          return false;
+        r.batch_id = batch_id;
+        return true;
+      }
+    }
+    _ranges[_next_slot] = range{begin, end, static_cast<int64_t>(batch_id)};
+    _next_slot = (_next_slot + 1) % num_tracked_ranges;
+    return true;
+  }
+
+  static system_memory_prefetch_tracker& get() {
+    static thread_local system_memory_prefetch_tracker t;
+    return t;
+  }
+private:
+  static constexpr std::size_t num_tracked_ranges = 16;
+
+  struct range {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    int64_t batch_id = -1;
+  };
+  range _ranges[num_tracked_ranges];
+  std::size_t _next_slot = 0;
+};
+#endif
+
 template<typename... Args>
 bool validate_all_pointers(const Args&... args){
   bool result = true;
@@ -127,7 +238,8 @@ enum prefetch_mode {
   always = 1,
   never = 2,
   after_sync = 3,
-  first = 4
+  first = 4,
+  predictive = 5
 };
 
 inline prefetch_mode get_prefetch_mode() noexcept {
@@ -149,6 +261,8 @@ inline prefetch_mode get_prefetch_mode() noexcept {
         return prefetch_mode::after_sync;
       } else if(prefetch_mode_string == "first") {
         return prefetch_mode::first;
+      } else if(prefetch_mode_string == "predictive") {
+        return prefetch_mode::predictive;
       } else {
         HIPSYCL_DEBUG_ERROR << "Invalid prefetch mode: " << prefetch_mode_string
                             << ", falling back to 'auto'\n";
@@ -178,62 +292,485 @@ inline void prefetch(sycl::queue& q, const void* ptr, std::size_t bytes) noexcep
   }
 }
 
+#if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
+// Allocations that have been used by at least this many offloaded
+// operations are hinted to reside in device memory, unless more than one
+// in device_residency_host_use_ratio of their uses were executed on the
+// host.
+constexpr uint32_t min_offloaded_uses_for_device_residency = 16;
+constexpr uint32_t device_residency_host_use_ratio = 32;
+// Device residency is only revoked once host uses have become
+// significantly more frequent, to avoid flipping hints back and forth.
+constexpr uint32_t device_residency_revocation_host_use_ratio = 8;
+
+inline bool is_device_residency_enabled() {
+  static bool is_enabled = [](){
+    bool enabled = true;
+    rt::try_get_environment_variable("stdpar_device_residency", enabled);
+    return enabled;
+  }();
+  return is_enabled;
+}
+
+inline void
+update_device_residency(sycl::queue &q,
+                        unified_shared_memory::allocation_lookup_result &r) {
+  uint32_t num_offloaded_uses =
+      __atomic_load_n(&(r.info->num_offloaded_uses), __ATOMIC_RELAXED);
+  uint32_t num_host_uses =
+      __atomic_load_n(&(r.info->num_host_uses), __ATOMIC_RELAXED);
+  bool is_device_resident =
+      __atomic_load_n(&(r.info->is_device_resident), __ATOMIC_ACQUIRE);
+
+  bool should_be_device_resident = is_device_resident;
+  if(!is_device_resident)
+    should_be_device_resident =
+        num_offloaded_uses >= min_offloaded_uses_for_device_residency &&
+        static_cast<uint64_t>(num_host_uses) *
+                device_residency_host_use_ratio <= num_offloaded_uses;
+  else
+    should_be_device_resident =
+        static_cast<uint64_t>(num_host_uses) *
+            device_residency_revocation_host_use_ratio <= num_offloaded_uses;
+
+  if(should_be_device_resident == is_device_resident)
+    return;
+  // Only one thread may change the hint
+  if(__atomic_exchange_n(&(r.info->is_device_resident),
+                         should_be_device_resident,
+                         __ATOMIC_ACQ_REL) == should_be_device_resident)
+    return;
+
+  HIPSYCL_DEBUG_INFO << "[stdpar] "
+                     << (should_be_device_resident ? "Setting" : "Revoking")
+                     << " device residency of allocation @" << r.root_address
+                     << " after " << num_offloaded_uses << " offloaded and "
+                     << num_host_uses << " host uses" << std::endl;
+  auto *allocator = q.get_context()
+                        .AdaptiveCpp_runtime()
+                        ->backends()
+                        .get(q.get_device().get_backend())
+                        ->get_allocator(q.get_device().AdaptiveCpp_device_id());
+  rt::result res = allocator->set_preferred_device_residency(
+      r.root_address, r.info->allocation_size, should_be_device_resident);
+  if(!res.is_success())
+    HIPSYCL_DEBUG_WARNING << "[stdpar] Could not change device residency of "
+                             "allocation @"
+                          << r.root_address << std::endl;
+}
+
+inline void record_use(uint32_t *counter) {
+  if(__atomic_load_n(counter, __ATOMIC_RELAXED) <
+     std::numeric_limits<uint32_t>::max())
+    __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+}
+#endif
+
+/// Accounts for the use of the allocations of an algorithm that is
+/// executed on the host, before it is executed.
+template<class AlgorithmType, class Size, typename... Args>
+void prepare_host_execution(AlgorithmType type, Size problem_size,
+                            const Args&... args) {
+#if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
+  if(!is_device_residency_enabled())
+    return;
+
+  auto& q = detail::single_device_dispatch::get_queue();
+  for_each_contained_allocation(
+      [&](unified_shared_memory::allocation_lookup_result &lookup_result) {
+        record_use(&(lookup_result.info->num_host_uses));
+        update_device_residency(q, lookup_result);
+      },
+      args...);
+#endif
+}
+
+// Element-wise algorithms whose offloaded implementations may be distributed
+// across all devices of the multi-device dispatch (ACPP_STDPAR_MULTI_DEVICE).
+template<class AlgorithmCategory>
+struct is_distributable_algorithm : public std::false_type {};
+
+#define HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(category)                       \
+  template <>                                                                  \
+  struct is_distributable_algorithm<algorithm_category::category>              \
+      : public std::true_type {};
+
+HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(for_each)
+HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(for_each_n)
+HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(transform)
+HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(fill)
+HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(fill_n)
+HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(transform_reduce)
+HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM(reduce)
+
+#undef HIPSYCL_STDPAR_DISTRIBUTABLE_ALGORITHM
+
+/// Algorithms whose offload invokers only rely on the queue they are
+/// invoked with, such that they can also be executed on the host queue
+/// when they are not offloaded. All of their iterator arguments span
+/// the entire problem size.
+template<class AlgorithmCategory>
+struct is_host_parallelizable_algorithm : public std::false_type {};
+
+#define HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(category)                 \
+  template <>                                                                  \
+  struct is_host_parallelizable_algorithm<algorithm_category::category>        \
+      : public std::true_type {};
+
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(for_each)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(for_each_n)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(transform)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(copy)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(copy_n)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(fill)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(fill_n)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(generate)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(generate_n)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(replace)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(replace_if)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(replace_copy)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(replace_copy_if)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(transform_reduce)
+HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM(reduce)
+
+#undef HIPSYCL_STDPAR_HOST_PARALLELIZABLE_ALGORITHM
+
+// Problems with fewer elements per device are not distributed, since
+// they cannot amortize the additional synchronization between devices.
+constexpr std::size_t min_distributed_problem_size_per_device = 1 << 20;
+
+inline std::size_t get_num_distribution_devices(std::size_t problem_size) {
+  std::size_t num_devices = stdpar_tls_runtime::get().get_num_devices();
+  if (num_devices > 1 &&
+      problem_size >= num_devices * min_distributed_problem_size_per_device)
+    return num_devices;
+  return 1;
+}
+
+/// Only work submitted to the primary stdpar queue is distributed; in
+/// particular not algorithms that run on the host queue.
+inline std::size_t get_num_distribution_devices(const sycl::queue &q,
+                                                std::size_t problem_size) {
+  if(&q != &stdpar_tls_runtime::get().get_queue())
+    return 1;
+  return get_num_distribution_devices(problem_size);
+}
+
+/// Returns the part of an allocation of the given size that device
+/// \c device_index is responsible for in distributed algorithms.
+inline std::pair<std::size_t, std::size_t>
+get_device_affinity_range(std::size_t allocation_size, std::size_t device_index,
+                          std::size_t num_devices) {
+  return std::make_pair(device_index * allocation_size / num_devices,
+                        (device_index + 1) * allocation_size / num_devices);
+}
+
+/// Splits the iteration space of a distributed algorithm into
+/// slices, such that device d processes [slice_begin[d], slice_begin[d+1]).
+/// If \c affinity points into a known allocation, slice boundaries follow
+/// get_device_affinity_range() of that allocation. This way, repeated
+/// operations on an allocation access the same parts of it on each device,
+/// even if they operate on different subranges.
+template<class Iterator>
+void get_device_slices(Iterator affinity, std::size_t problem_size,
+                       std::size_t num_devices, std::size_t *slice_begin) {
+  for(std::size_t d = 0; d < num_devices; ++d)
+    slice_begin[d] = d * problem_size / num_devices;
+  slice_begin[num_devices] = problem_size;
+
+#ifndef __ACPP_STDPAR_ASSUME_SYSTEM_USM__
+  if constexpr(std::is_pointer_v<Iterator>) {
+    using value_type = std::remove_cv_t<std::remove_pointer_t<Iterator>>;
+    void *ptr = const_cast<void *>(static_cast<const void *>(affinity));
+
+    unified_shared_memory::allocation_lookup_result lookup_result;
+    if(!ptr || !unified_shared_memory::allocation_lookup(ptr, lookup_result))
+      return;
+
+    const std::size_t offset =
+        (static_cast<char *>(ptr) -
+         static_cast<char *>(lookup_result.root_address)) /
+        sizeof(value_type);
+    const std::size_t allocation_size =
+        lookup_result.info->allocation_size / sizeof(value_type);
+    for(std::size_t d = 1; d < num_devices; ++d) {
+      std::size_t affinity_begin =
+          get_device_affinity_range(allocation_size, d, num_devices).first;
+      slice_begin[d] =
+          affinity_begin <= offset
+              ? 0
+              : std::min(affinity_begin - offset, problem_size);
+    }
+  }
+#endif
+}
+
+/// Invokes f(queue, begin, count) to submit the slice of each device of a
+/// distributed algorithm, or once for the entire problem on q if the
+/// problem is not distributed.
+///
+/// The slices of other devices are ordered after all prior work of q,
+/// and subsequent work of q after all slices, such that synchronization
+/// with q remains sufficient.
+template<class Iterator, class SliceInvoker>
+void distribute_across_devices(sycl::queue &q, Iterator affinity,
+                               std::size_t problem_size, SliceInvoker f) {
+  const std::size_t num_devices =
+      get_num_distribution_devices(q, problem_size);
+  if(num_devices == 1) {
+    f(q, std::size_t{0}, problem_size);
+    return;
+  }
+
+  auto& rt = stdpar_tls_runtime::get();
+  std::vector<std::size_t> slice_begin(num_devices + 1);
+  get_device_slices(affinity, problem_size, num_devices, slice_begin.data());
+
+  std::vector<sycl::event> primary_dependencies = q.get_wait_list();
+  std::vector<sycl::event> slice_dependencies;
+  for(std::size_t d = 0; d < num_devices; ++d) {
+    const std::size_t count = slice_begin[d + 1] - slice_begin[d];
+    if(count == 0)
+      continue;
+
+    sycl::queue& device_queue = rt.get_queue(d);
+    if(d > 0 && !primary_dependencies.empty()) {
+      device_queue.submit([&](sycl::handler &cgh) {
+        cgh.depends_on(primary_dependencies);
+        cgh.AdaptiveCpp_enqueue_custom_operation([](auto &) {});
+      });
+    }
+    f(device_queue, slice_begin[d], count);
+    if(d > 0)
+      for(const auto& evt : device_queue.get_wait_list())
+        slice_dependencies.push_back(evt);
+  }
+
+  if(!slice_dependencies.empty()) {
+    q.submit([&](sycl::handler &cgh) {
+      cgh.depends_on(slice_dependencies);
+      cgh.AdaptiveCpp_enqueue_custom_operation([](auto &) {});
+    });
+  }
+}
+
+/// Reduction counterpart of distribute_across_devices(). Invokes
+/// f(queue, scratch_group, begin, count, output, init) to submit the
+/// reduction of each slice into *output, waits for the results,
+/// and returns their combination.
+/// Problems are only distributed if \c op has a known identity, which is
+/// then used as initial value of all slices but the first one.
+template<class T, class BinaryOp, class Iterator, class SliceReducer>
+T distributed_reduce(sycl::queue &q, Iterator affinity,
+                     std::size_t problem_size, T init, BinaryOp op,
+                     SliceReducer f) {
+  if(problem_size == 0) {
+    // Callers rely on all prior operations being complete
+    q.wait();
+    return init;
+  }
+
+  auto &rt = stdpar_tls_runtime::get();
+  using algorithms::util::allocation_type;
+  using algorithms::util::allocation_group;
+  // Using scratch allocation_groups that expire at the end of the scope
+  // is safe because
+  // a) We synchronize before the end, so the allocation_groups also live
+  // until the kernels are complete;
+  // b) We have one allocation cache per thread-local in-order queue of
+  // each device. So, subsequent operations fed from the same cache would
+  // wait for us anyway due to using the same in-order queue.
+  if constexpr(algorithms::detail::identity<T, BinaryOp>::is_known()) {
+    const std::size_t num_devices =
+        get_num_distribution_devices(q, problem_size);
+    if(num_devices > 1) {
+      std::vector<std::size_t> slice_begin(num_devices + 1);
+      get_device_slices(affinity, problem_size, num_devices,
+                        slice_begin.data());
+
+      std::vector<std::unique_ptr<allocation_group>> scratch_groups;
+      std::vector<T *> outputs(num_devices, nullptr);
+      std::vector<sycl::event> primary_dependencies = q.get_wait_list();
+      bool is_first_slice = true;
+      for(std::size_t d = 0; d < num_devices; ++d) {
+        const std::size_t count = slice_begin[d + 1] - slice_begin[d];
+        if(count == 0)
+          continue;
+
+        sycl::queue &device_queue = rt.get_queue(d);
+        rt::device_id dev = device_queue.get_device().AdaptiveCpp_device_id();
+        scratch_groups.push_back(std::make_unique<allocation_group>(
+            &rt.get_scratch_cache<allocation_type::host>(), dev));
+        outputs[d] = scratch_groups.back()->obtain<T>(1);
+        scratch_groups.push_back(std::make_unique<allocation_group>(
+            &rt.get_scratch_cache<allocation_type::device>(), dev));
+
+        if(d > 0 && !primary_dependencies.empty()) {
+          device_queue.submit([&](sycl::handler &cgh) {
+            cgh.depends_on(primary_dependencies);
+            cgh.AdaptiveCpp_enqueue_custom_operation([](auto &) {});
+          });
+        }
+        T slice_init =
+            is_first_slice
+                ? init
+                : algorithms::detail::identity<T, BinaryOp>::get_identity();
+        f(device_queue, *scratch_groups.back(), slice_begin[d], count,
+          outputs[d], slice_init);
+        is_first_slice = false;
+      }
+
+      T result = init;
+      is_first_slice = true;
+      for(std::size_t d = 0; d < num_devices; ++d) {
+        if(!outputs[d])
+          continue;
+        rt.get_queue(d).wait();
+        result = is_first_slice ? *outputs[d] : op(result, *outputs[d]);
+        is_first_slice = false;
+      }
+      return result;
+    }
+  }
+
+  auto output_scratch_group = rt.make_scratch_group<allocation_type::host>(q);
+  auto reduction_scratch_group =
+      rt.make_scratch_group<allocation_type::device>(q);
+
+  T* output = output_scratch_group.obtain<T>(1);
+  f(q, reduction_scratch_group, std::size_t{0}, problem_size, output, init);
+  // We need to wait in any case here, so cannot elide synchronization
+  q.wait();
+  return *output;
+}
+
 template<class AlgorithmType, class Size, typename... Args>
 void prepare_offloading(AlgorithmType type, Size problem_size, const Args&... args) {
   auto& q = detail::single_device_dispatch::get_queue();
   std::size_t current_batch_id = stdpar::detail::stdpar_tls_runtime::get()
                                      .get_current_offloading_batch_id();
 
-#ifndef __ACPP_STDPAR_ASSUME_SYSTEM_USM__
+  std::size_t num_devices = 1;
+  if constexpr (is_distributable_algorithm<
+                    typename AlgorithmType::algorithm_category>::value)
+    num_devices = get_num_distribution_devices(problem_size);
+
   // Use "first" mode in case of automatic prefetch decision for now
   const auto prefetch_mode =
       (get_prefetch_mode() == prefetch_mode::automatic) ? prefetch_mode::first
                                                         : get_prefetch_mode();
 
-  auto prefetch_handler = [&](void* ptr){
-    unified_shared_memory::allocation_lookup_result lookup_result;
-    
-    if(ptr && unified_shared_memory::allocation_lookup(ptr, lookup_result)) {
-      int64_t *most_recent_offload_batch_ptr =
-          &(lookup_result.info->most_recent_offload_batch);
+#ifndef __ACPP_STDPAR_ASSUME_SYSTEM_USM__
 
-      std::size_t prefetch_size = lookup_result.info->allocation_size;
+  auto prefetch_handler =
+      [&](unified_shared_memory::allocation_lookup_result &lookup_result) {
+    int64_t *most_recent_offload_batch_ptr =
+        &(lookup_result.info->most_recent_offload_batch);
 
-      // Need to use atomic builtins until we can use C++ 20 atomic_ref :(
-      int64_t most_recent_offload_batch = __atomic_load_n(
-          most_recent_offload_batch_ptr, __ATOMIC_ACQUIRE);
-      
-      bool should_prefetch = false;
-      if(prefetch_mode == prefetch_mode::first)
-        // an allocation that was never used will still contain the
-        // initialization value of -1
-        should_prefetch = most_recent_offload_batch == -1;
-      else
-        // Never emit multiple prefetches for the same allocation in one batch
-        should_prefetch = most_recent_offload_batch <
-                          static_cast<int64_t>(current_batch_id);
+    std::size_t prefetch_size = lookup_result.info->allocation_size;
 
-      if (should_prefetch) {
-        //sycl::mem_advise(lookup_result.root_address, prefetch_size, 3, q);
+    // Need to use atomic builtins until we can use C++ 20 atomic_ref :(
+    int64_t most_recent_offload_batch = __atomic_load_n(
+        most_recent_offload_batch_ptr, __ATOMIC_ACQUIRE);
+    
+    bool should_prefetch = false;
+    if(prefetch_mode == prefetch_mode::first)
+      // an allocation that was never used will still contain the
+      // initialization value of -1
+      should_prefetch = most_recent_offload_batch == -1;
+    else
+      // Never emit multiple prefetches for the same allocation in one batch
+      should_prefetch = most_recent_offload_batch <
+                        static_cast<int64_t>(current_batch_id);
+
+    if (should_prefetch) {
+      //sycl::mem_advise(lookup_result.root_address, prefetch_size, 3, q);
+      if(num_devices > 1) {
+        // Move each part of the allocation to the device that will
+        // process it in distributed algorithms.
+        for(std::size_t d = 0; d < num_devices; ++d) {
+          auto range =
+              get_device_affinity_range(prefetch_size, d, num_devices);
+          prefetch(stdpar_tls_runtime::get().get_queue(d),
+                   static_cast<char *>(lookup_result.root_address) +
+                       range.first,
+                   range.second - range.first);
+        }
+      } else {
         prefetch(q, lookup_result.root_address, prefetch_size);
-        __atomic_store_n(most_recent_offload_batch_ptr, current_batch_id,
-                          __ATOMIC_RELEASE);
       }
+      __atomic_store_n(most_recent_offload_batch_ptr, current_batch_id,
+                        __ATOMIC_RELEASE);
     }
   };
   
 
+  bool is_prefetching = false;
   if(prefetch_mode == prefetch_mode::after_sync) {
     int submission_id_in_batch = stdpar::detail::stdpar_tls_runtime::get()
                                    .get_num_outstanding_operations();
-    if(submission_id_in_batch == 0)
-      for_each_contained_pointer(prefetch_handler, args...);
+    is_prefetching = submission_id_in_batch == 0;
   } else if (prefetch_mode == prefetch_mode::always ||
-             prefetch_mode == prefetch_mode::first) {
-    for_each_contained_pointer(prefetch_handler, args...);
+             prefetch_mode == prefetch_mode::first ||
+             prefetch_mode == prefetch_mode::predictive) {
+    is_prefetching = true;
   } else if (prefetch_mode == prefetch_mode::never) {
     /* nothing to do */
   }
+
+  // Parts of distributed allocations reside on different devices
+  const bool is_tracking_device_residency =
+      is_device_residency_enabled() && num_devices == 1;
+
+  if(is_prefetching || is_tracking_device_residency) {
+    for_each_contained_allocation(
+        [&](unified_shared_memory::allocation_lookup_result &lookup_result) {
+          if(is_tracking_device_residency) {
+            record_use(&(lookup_result.info->num_offloaded_uses));
+            update_device_residency(q, lookup_result);
+          }
+          if(is_prefetching)
+            prefetch_handler(lookup_result);
+        },
+        args...);
+  }
+#else
+  // System allocations are not known to the runtime, so we can only
+  // prefetch the ranges of algorithms whose iterators span the entire
+  // problem. Devices sharing memory with the host do not benefit from
+  // prefetching.
+  if constexpr (is_host_parallelizable_algorithm<
+                    typename AlgorithmType::algorithm_category>::value) {
+    static const bool is_device_memory_host_unified =
+        q.get_device().get_info<sycl::info::device::host_unified_memory>();
+    if(prefetch_mode == prefetch_mode::never || is_device_memory_host_unified)
+      return;
+    if(prefetch_mode == prefetch_mode::after_sync &&
+       stdpar_tls_runtime::get().get_num_outstanding_operations() != 0)
+      return;
+
+    auto &tracker = system_memory_prefetch_tracker::get();
+    for_each_contained_range(
+        [&](const void *ptr, std::size_t num_bytes) {
+          if(!tracker.should_prefetch(ptr, num_bytes, current_batch_id,
+                                      prefetch_mode == prefetch_mode::first))
+            return;
+          if(num_devices > 1) {
+            // Prefetch the part of the range that each device processes
+            for(std::size_t d = 0; d < num_devices; ++d) {
+              std::size_t begin = d * problem_size / num_devices;
+              std::size_t end = (d + 1) * problem_size / num_devices;
+              std::size_t element_size = num_bytes / problem_size;
+              prefetch(stdpar_tls_runtime::get().get_queue(d),
+                       static_cast<const char *>(ptr) + begin * element_size,
+                       (end - begin) * element_size);
+            }
+          } else {
+            prefetch(q, ptr, num_bytes);
+          }
+        },
+        problem_size, args...);
+  }
 #endif
 }
 
@@ -301,6 +838,22 @@ struct offload_heuristic_state {
     return it->second;
   }
 
+  // Allocations (root address and size) used by an op
+  using allocation_list =
+      std::vector<std::pair<void *, std::size_t>,
+                  libc_allocator<std::pair<void *, std::size_t>>>;
+
+  void set_used_allocations(op_id op, const allocation_list& allocations) {
+    _used_allocations[op] = allocations;
+  }
+
+  const allocation_list* get_used_allocations(op_id op) const {
+    auto it = _used_allocations.find(op);
+    if(it == _used_allocations.end())
+      return nullptr;
+    return &(it->second);
+  }
+
   void set_offloading(bool offloading) {
     _is_currently_offloading = offloading;
 
@@ -357,6 +910,7 @@ private:
   int _num_ops_since_offloading_change;
   op_id _previous_op;
   host_malloc_unordered_pair_map<op_id, op_id> _most_recent_successor;
+  host_malloc_unordered_pair_map<op_id, allocation_list> _used_allocations;
   uint64_t _previous_offloading_change_timestamp;
   uint64_t _time_since_previous_op;
   bool _is_currently_offloading;
@@ -436,21 +990,34 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
 
   auto decide_offloading_viability = [&](std::optional<bool> is_currently_offloading = {}){
 
-    // Instead of hardcoding peak PCIe speeds, this should be measured
-    double data_transfer_time_estimate = 0;
+    // Estimated time to migrate the data of the op to the device, and
+    // back to the host, respectively.
+    double to_device_migration_time_estimate = 0;
+    double to_host_migration_time_estimate = 0;
 
 #if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__)
-    std::size_t used_memory = 0;
-    for_each_contained_pointer([&](void* ptr){
-      unified_shared_memory::allocation_lookup_result lookup_result;
-  
-      if(ptr && unified_shared_memory::allocation_lookup(ptr, lookup_result)) {
-        used_memory += lookup_result.info->allocation_size;
-      }
-    }, args...);
-
-    if(detail::stdpar_tls_runtime::get().get_current_offloading_batch_id() > 0)
-      data_transfer_time_estimate = used_memory / 32.0;
+    // Allocations that have never been used by offloaded operations
+    // still live on the host.
+    std::size_t host_resident_memory = 0;
+    std::size_t device_resident_memory = 0;
+    for_each_contained_allocation(
+        [&](unified_shared_memory::allocation_lookup_result &lookup_result) {
+          int64_t most_recent_offload_batch = __atomic_load_n(
+              &(lookup_result.info->most_recent_offload_batch),
+              __ATOMIC_ACQUIRE);
+          if(most_recent_offload_batch == -1)
+            host_resident_memory += lookup_result.info->allocation_size;
+          else
+            device_resident_memory += lookup_result.info->allocation_size;
+        },
+        args...);
+
+    auto& rt = detail::stdpar_tls_runtime::get();
+    to_device_migration_time_estimate =
+        rt.estimate_data_transfer_time(host_resident_memory);
+    if(rt.get_current_offloading_batch_id() > 0)
+      to_host_migration_time_estimate =
+          rt.estimate_data_transfer_time(device_resident_memory);
 #endif
 
     double host_time_estimate = 0.0;
@@ -482,14 +1049,15 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
     if(host_time_estimate <= 0.0)
       // If we don't have host sampling data, offload.
       return true;
-    
-    if(is_currently_offloading.has_value()){
-      if(is_currently_offloading.value()) {
-        host_time_estimate += data_transfer_time_estimate;
-      } else {
-        offload_time_estimate += data_transfer_time_estimate;
-      }
 
+    // Offloading first needs to migrate data that still lives on the host,
+    // and switching back to the host needs to migrate data that is
+    // already on the device.
+    offload_time_estimate += to_device_migration_time_estimate;
+    if(is_currently_offloading.value_or(false))
+      host_time_estimate += to_host_migration_time_estimate;
+
+    if(is_currently_offloading.has_value()){
       double ratio = host_time_estimate / offload_time_estimate;
       double tolerance = 0.2;
       if(ratio >= (1.0 - tolerance) && ratio <= (1.0 + tolerance))
@@ -525,6 +1093,67 @@ bool should_offload(AlgorithmType type, Size n, const Args &...args) {
 #endif
 }
 
+/// In predictive prefetch mode, remembers the allocations used by the current
+/// op and speculatively prefetches the allocations that the predicted next op
+/// has used previously, such that their migration overlaps with the
+/// execution of the current op.
+template<class AlgorithmType, class Size, typename... Args>
+void prefetch_predicted_successor(AlgorithmType type, Size n,
+                                  const Args&... args) {
+#if !defined(__ACPP_STDPAR_ASSUME_SYSTEM_USM__) &&                             \
+    !defined(__ACPP_STDPAR_UNCONDITIONAL_OFFLOAD__)
+  if(get_prefetch_mode() != prefetch_mode::predictive)
+    return;
+
+  using op_id = offload_heuristic_state::op_id;
+  offload_heuristic_state& state = offload_heuristic_state::get();
+  op_id current = {get_operation_hash(type, n, args...), n};
+
+  offload_heuristic_state::allocation_list used_allocations;
+  for_each_contained_allocation(
+      [&](unified_shared_memory::allocation_lookup_result &lookup_result) {
+        used_allocations.push_back(std::make_pair(
+            lookup_result.root_address, lookup_result.info->allocation_size));
+      },
+      args...);
+  state.set_used_allocations(current, used_allocations);
+
+  auto prediction = state.predict_next(current);
+  if(!prediction.has_value())
+    return;
+  const auto* predicted_allocations =
+      state.get_used_allocations(prediction.value());
+  if(!predicted_allocations)
+    return;
+
+  auto &q = detail::single_device_dispatch::get_queue();
+  std::size_t current_batch_id = stdpar::detail::stdpar_tls_runtime::get()
+                                     .get_current_offloading_batch_id();
+  for(const auto& allocation : *predicted_allocations) {
+    unified_shared_memory::allocation_lookup_result lookup_result;
+    // The allocation might have been freed in the meantime
+    if (!unified_shared_memory::allocation_lookup(allocation.first,
+                                                  lookup_result) ||
+        lookup_result.root_address != allocation.first)
+      continue;
+
+    int64_t *most_recent_offload_batch_ptr =
+        &(lookup_result.info->most_recent_offload_batch);
+    int64_t most_recent_offload_batch = __atomic_load_n(
+        most_recent_offload_batch_ptr, __ATOMIC_ACQUIRE);
+    if (most_recent_offload_batch < static_cast<int64_t>(current_batch_id)) {
+      HIPSYCL_DEBUG_INFO << "[stdpar] Speculatively prefetching allocation @"
+                         << allocation.first << " for predicted next operation"
+                         << std::endl;
+      prefetch(q, lookup_result.root_address,
+               lookup_result.info->allocation_size);
+      __atomic_store_n(most_recent_offload_batch_ptr, current_batch_id,
+                       __ATOMIC_RELEASE);
+    }
+  }
+#endif
+}
+
 struct host_invocation_measurement {
   host_invocation_measurement(uint64_t hash, std::size_t problem_size)
   : _hash{hash}, _problem_size{problem_size} {}
@@ -594,6 +1223,32 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
 #endif
 }
 
+/// Executes an algorithm that is not offloaded. Where possible, the offload
+/// invoker is run on the host queue, such that the algorithm uses all CPU
+/// cores even if the C++ standard library executes it sequentially.
+/// Otherwise, the fallback invoker is used.
+template <class ReturnType, class AlgorithmType, class OffloadInvoker,
+          class FallbackInvoker>
+ReturnType execute_fallback(AlgorithmType, OffloadInvoker &offload_invoker,
+                            FallbackInvoker &fallback_invoker) {
+  if constexpr (is_host_parallelizable_algorithm<
+                    typename AlgorithmType::algorithm_category>::value) {
+    if (sycl::queue *host_queue =
+            stdpar_tls_runtime::get().get_host_queue()) {
+      if constexpr (std::is_void_v<ReturnType>) {
+        offload_invoker(*host_queue);
+        host_queue->wait();
+        return;
+      } else {
+        ReturnType ret = offload_invoker(*host_queue);
+        host_queue->wait();
+        return ret;
+      }
+    }
+  }
+  return fallback_invoker();
+}
+
 #define HIPSYCL_STDPAR_OFFLOAD_NORET(algorithm_type_object, problem_size,      \
                                      offload_invoker, fallback_invoker, ...)   \
   using hipsycl::stdpar::detail::device_instrumentation;                       \
@@ -609,10 +1264,18 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
                            algorithm_type_object, problem_size, __VA_ARGS__);  \
     hipsycl::stdpar::detail::stdpar_tls_runtime::get()                         \
         .increment_num_outstanding_operations();                               \
+    hipsycl::stdpar::detail::prefetch_predicted_successor(                     \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
   } else {                                                                     \
     __acpp_stdpar_barrier();                                                   \
-    host_instrumentation([&]() { fallback_invoker(); }, algorithm_type_object, \
-                         problem_size, __VA_ARGS__);                           \
+    hipsycl::stdpar::detail::prepare_host_execution(                           \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
+    host_instrumentation(                                                      \
+        [&]() {                                                                \
+          hipsycl::stdpar::detail::execute_fallback<void>(                     \
+              algorithm_type_object, offload_invoker, fallback_invoker);       \
+        },                                                                     \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
   }                                                                            \
   __acpp_stdpar_optional_barrier(); /*Compiler might move/elide this call*/
 
@@ -627,19 +1290,29 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
   if (is_offloaded)                                                            \
     hipsycl::stdpar::detail::prepare_offloading(algorithm_type_object,         \
                                                 problem_size, __VA_ARGS__);    \
-  else                                                                         \
+  else {                                                                       \
     __acpp_stdpar_barrier();                                                   \
+    hipsycl::stdpar::detail::prepare_host_execution(                           \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
+  }                                                                            \
   return_type ret =                                                            \
       is_offloaded                                                             \
           ? device_instrumentation([&]() { return offload_invoker(q); },       \
                                    algorithm_type_object, problem_size,        \
                                    __VA_ARGS__)                                \
-          : host_instrumentation([&]() { return fallback_invoker(); },         \
-                                 algorithm_type_object, problem_size,          \
-                                 __VA_ARGS__);                                 \
-  if (is_offloaded)                                                            \
+          : host_instrumentation(                                              \
+                [&]() {                                                        \
+                  return hipsycl::stdpar::detail::execute_fallback<            \
+                      return_type>(algorithm_type_object, offload_invoker,     \
+                                   fallback_invoker);                          \
+                },                                                             \
+                algorithm_type_object, problem_size, __VA_ARGS__);             \
+  if (is_offloaded) {                                                          \
     hipsycl::stdpar::detail::stdpar_tls_runtime::get()                         \
         .increment_num_outstanding_operations();                               \
+    hipsycl::stdpar::detail::prefetch_predicted_successor(                     \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
+  }                                                                            \
   __acpp_stdpar_optional_barrier(); /*Compiler might move/elide this call*/    \
   return ret;
 
@@ -653,15 +1326,21 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
       algorithm_type_object, problem_size, __VA_ARGS__);                       \
   const auto blocking_fallback_invoker = [&]() {                               \
     q.wait();                                                                  \
-    return host_instrumentation([&]() { return fallback_invoker(); },          \
-                                algorithm_type_object, problem_size,           \
-                                __VA_ARGS__);                                  \
+    return host_instrumentation(                                               \
+        [&]() {                                                                \
+          return hipsycl::stdpar::detail::execute_fallback<return_type>(       \
+              algorithm_type_object, offload_invoker, fallback_invoker);       \
+        },                                                                     \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
   };                                                                           \
   if (is_offloaded)                                                            \
     hipsycl::stdpar::detail::prepare_offloading(algorithm_type_object,         \
                                                 problem_size, __VA_ARGS__);    \
-  else                                                                         \
+  else {                                                                       \
     __acpp_stdpar_barrier();                                                   \
+    hipsycl::stdpar::detail::prepare_host_execution(                           \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
+  }                                                                            \
   return_type ret =                                                            \
       is_offloaded                                                             \
           ? device_instrumentation([&]() { return offload_invoker(q); },       \
@@ -678,6 +1357,8 @@ auto device_instrumentation(F&& f, AlgorithmType t, Size n, Args... args) {
         << std::endl;                                                          \
     hipsycl::stdpar::detail::stdpar_tls_runtime::get()                         \
         .finalize_offloading_batch();                                          \
+    hipsycl::stdpar::detail::prefetch_predicted_successor(                     \
+        algorithm_type_object, problem_size, __VA_ARGS__);                     \
   }                                                                            \
   return ret;
 
@@ -51,10 +51,22 @@ struct all_of {};
 struct any_of {};
 struct none_of {};
 struct sort {};
+struct stable_sort {};
+struct partial_sort {};
+struct nth_element {};
+struct partition {};
+struct stable_partition {};
+struct remove_if {};
+struct unique {};
 
 
 struct transform_reduce {};
 struct reduce {};
+struct inclusive_scan {};
+struct exclusive_scan {};
+struct transform_inclusive_scan {};
+struct transform_exclusive_scan {};
+struct adjacent_difference {};
 } // namespace algorithm_type
 
 template<class AlgorithmCategory, class ExecPolicy>
@@ -241,79 +253,101 @@ public:
   static constexpr device_t host_device_id = -1;
   static constexpr device_t offload_device_id = 0;
 
+  /// Runtime model of the form t(n) = latency + time_per_element * n,
+  /// fitted to the samples of one operation on one device.
+  struct runtime_model {
+    double latency = 0.0;
+    double time_per_element = 0.0;
+    bool is_valid = false;
+
+    double operator()(std::size_t problem_size) const {
+      return latency + time_per_element * static_cast<double>(problem_size);
+    }
+  };
+
   double estimate_runtime(uint64_t op_hash, std::size_t problem_size, device_t dev) const {
     auto it = _entries.find(op_hash);
     if(it == _entries.end())
       return 0.0;
 
-    // We attempt to find the closest measurements around the requested problem size,
-    // and then interpolate linearly.
-
-    // First find closest sampling point
-    int64_t delta = std::numeric_limits<int>::max();
-    std::size_t closest_problem_size = 0;
-    double closest_runtime = 0.0;
-    for(auto& e : it->second.entries) {
-      if(e.dev == dev) {
-        // If we find the required problem size exactly, we can just return it.
-        if(e.problem_size == problem_size)
-          return e.runtime;
-
-        int64_t current_delta = std::abs((int64_t)e.problem_size - (int64_t)problem_size);
-        if(current_delta < delta) {
-          delta = current_delta;
-          closest_problem_size = e.problem_size;
-          closest_runtime = e.runtime;
-        }
-      }
-    }
-    // Find 2nd closest sampling point
-    delta = std::numeric_limits<int>::max();
-    std::size_t closest_problem_size2 = 0;
-    double closest_runtime2 = 0.0;
-    for(auto& e : it->second.entries) {
-      if(e.dev == dev) {
-        int64_t current_delta = std::abs((int64_t)e.problem_size - (int64_t)problem_size);
-        if(current_delta < delta && e.problem_size != closest_problem_size) {
-          delta = current_delta;
-          closest_problem_size2 = e.problem_size;
-          closest_runtime2 = e.runtime;
-        }
-      }
-    }
+    // If we find the required problem size exactly, we can just return it.
+    for(auto& e : it->second.entries)
+      if(e.dev == dev && e.problem_size == problem_size)
+        return e.runtime;
 
-    if(closest_problem_size2 < closest_problem_size) {
-      std::swap(closest_problem_size, closest_problem_size2);
-      std::swap(closest_runtime, closest_runtime2);
-    }
-
-    
-    double runtime_lower = closest_runtime;
-    double runtime_upper = closest_runtime2;
-    std::size_t problem_size_lower = closest_problem_size;
-    std::size_t problem_size_upper = closest_problem_size2;
-
-    // If we have neither, then both lower bound and upper bound problem size might still be 0.
-    // We need to catch this case to avoid division by zero.
-    if(problem_size_lower == problem_size_upper) {
+    // Otherwise, predict from the model fitted to all samples of the op.
+    const runtime_model& model = get_runtime_model(op_hash, dev);
+    if(!model.is_valid)
       return 0.0;
-    }
-
-    double delta_x = problem_size_upper - problem_size_lower;
-    double delta_y = runtime_upper - runtime_lower;
-    
-    double m = delta_y / delta_x;
 
-    double result = m * (problem_size - problem_size_lower) + runtime_lower;
-    // If the interpolation results in a negative value, we cannot just return 0, as this
-    // is generally interpreted as "couldn't estimate". In this case however, we could estimate,
-    // but the estimate is just too low due to inaccuracies. So we just return a value that
-    // is smaller than the measurement accuracy.
+    double result = model(problem_size);
+    // 0 is generally interpreted as "couldn't estimate". Here however, we
+    // could estimate, but the estimate is just too low due to inaccuracies.
+    // So we just return a value that is smaller than the measurement accuracy.
     if(result <= 0.0)
       return 1.e-20;
     return result;
   }
 
+  /// Fits t(n) = a + b*n to the samples of an operation on a device by
+  /// least squares, weighting each sample by its number of measurements.
+  /// The model is only valid if at least two different problem sizes
+  /// were sampled.
+  const runtime_model& get_runtime_model(uint64_t op_hash, device_t dev) const {
+    auto& cached = _runtime_models[op_hash];
+    auto model_it = cached.find(dev);
+    if(model_it != cached.end())
+      return model_it->second;
+
+    runtime_model& model = cached[dev];
+
+    auto it = _entries.find(op_hash);
+    if(it == _entries.end())
+      return model;
+
+    double sum_w = 0.0, sum_n = 0.0, sum_t = 0.0, sum_nn = 0.0, sum_nt = 0.0;
+    // Entries are unique per device and problem size
+    std::size_t num_problem_sizes = 0;
+    for(const auto& e : it->second.entries) {
+      if(e.dev != dev || !e.is_sampled() || e.num_samples == 0)
+        continue;
+      ++num_problem_sizes;
+      double w = static_cast<double>(e.num_samples);
+      double n = static_cast<double>(e.problem_size);
+      sum_w += w;
+      sum_n += w * n;
+      sum_t += w * e.runtime;
+      sum_nn += w * n * n;
+      sum_nt += w * n * e.runtime;
+    }
+
+    if(num_problem_sizes < 2)
+      return model;
+
+    double mean_n = sum_n / sum_w;
+    double mean_t = sum_t / sum_w;
+    double var_n = sum_nn / sum_w - mean_n * mean_n;
+    double cov_nt = sum_nt / sum_w - mean_n * mean_t;
+    if(var_n <= 0.0)
+      return model;
+
+    model.time_per_element = cov_nt / var_n;
+    model.latency = mean_t - model.time_per_element * mean_n;
+    if(model.time_per_element < 0.0) {
+      // Measurement noise dominates; the best we can say is that the
+      // runtime does not depend on the problem size.
+      model.time_per_element = 0.0;
+      model.latency = mean_t;
+    } else if(model.latency < 0.0) {
+      // Negative latencies are unphysical and would make the model
+      // predict tiny calls to be free. Fit through the origin instead.
+      model.latency = 0.0;
+      model.time_per_element = sum_nt / sum_nn;
+    }
+    model.is_valid = true;
+    return model;
+  }
+
   void update_entry(uint64_t op_hash, std::size_t problem_size, device_t dev, double runtime) {
 
     uint64_t& op_invocation_count = _kernel_invocation_counts[op_hash];
@@ -327,6 +361,7 @@ public:
     }
 
     auto& e = _entries[op_hash];
+    _runtime_models.erase(op_hash);
 
     offload_heuristic_db_storage::device_entry d_entry {dev, problem_size, runtime, 1};
     
@@ -346,6 +381,9 @@ private:
   host_malloc_unordered_map<uint64_t, offload_heuristic_db_storage::entry>
       _entries;
   host_malloc_unordered_map<uint64_t, uint64_t> _kernel_invocation_counts;
+  mutable host_malloc_unordered_map<
+      uint64_t, host_malloc_unordered_map<device_t, runtime_model>>
+      _runtime_models;
 };
 
 
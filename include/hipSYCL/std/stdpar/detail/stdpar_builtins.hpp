@@ -15,14 +15,7 @@
 #include "stdpar_defs.hpp"
 
 inline void __acpp_stdpar_barrier() noexcept {
-  auto& rt = hipsycl::stdpar::detail::stdpar_tls_runtime::get();
-  int num_ops = rt.get_num_outstanding_operations();
-  if(num_ops > 0) {
-    HIPSYCL_DEBUG_INFO << "[stdpar] Initializing wait for " << num_ops
-                       << " operations" << std::endl;
-    rt.get_queue().wait();
-    rt.finalize_offloading_batch();
-  }
+  hipsycl::stdpar::detail::stdpar_tls_runtime::get().synchronize();
 }
 
 // Compiler does not currently support handling invoke instructions for
@@ -33,6 +26,11 @@ inline void __acpp_stdpar_barrier() noexcept {
 // its calls within the control flow for as long as possible.
 HIPSYCL_STDPAR_NOINLINE
 extern "C" void __acpp_stdpar_optional_barrier() noexcept {
+  // Within hipsycl::stdpar::async(), synchronization is left to the
+  // returned handle.
+  if(hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+         .is_synchronization_deferred())
+    return;
   __acpp_stdpar_barrier();
 }
 
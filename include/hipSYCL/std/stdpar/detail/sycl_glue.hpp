@@ -14,10 +14,13 @@
 
 
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <mutex>
 #include <new>
+#include <optional>
 #include <unistd.h>
 
 #include <hipSYCL/algorithms/util/allocation_cache.hpp>
@@ -34,9 +37,11 @@
 #include "allocation_map.hpp"
 #include "offload_heuristic_db.hpp"
 #include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
 #include "hipSYCL/sycl/info/device.hpp"
 
 extern "C" void *__libc_malloc(size_t);
+extern "C" void *__libc_calloc(size_t, size_t);
 extern "C" void __libc_free(void*);
 
 namespace hipsycl::stdpar::detail {
@@ -50,10 +55,14 @@ inline uint64_t get_time_now() {
   return now;
 }
 
+inline sycl::property_list get_default_queue_properties() {
+  return hipsycl::sycl::property_list{
+      hipsycl::sycl::property::queue::in_order{},
+      hipsycl::sycl::property::queue::AdaptiveCpp_coarse_grained_events{}};
+}
+
 inline sycl::queue construct_default_queue() {
-  return sycl::queue{hipsycl::sycl::property_list{
-        hipsycl::sycl::property::queue::in_order{},
-        hipsycl::sycl::property::queue::AdaptiveCpp_coarse_grained_events{}}};
+  return sycl::queue{get_default_queue_properties()};
 }
 
 class stdpar_tls_runtime {
@@ -71,20 +80,45 @@ private:
                   ->has(rt::device_support_aspect::
                             work_item_independent_forward_progress))
             _has_independent_work_item_forward_progress = true;
+
+          // Prefer measured transfer bandwidths (see acpp-info --benchmark)
+          // over the built-in estimate
+          if (auto link = _queue.get_context()
+                              .AdaptiveCpp_runtime()
+                              ->backends()
+                              .hardware_model()
+                              .get_memcpy_model()
+                              ->get_calibrated_link_properties(
+                                  sycl::detail::get_host_device(), dev))
+            _host_to_device_bandwidth = link->bandwidth;
+
+          init_device_queues();
+          current_instance() = this;
         }
 
   ~stdpar_tls_runtime() {
+    current_instance() = nullptr;
     _device_scratch_cache.purge();
     _shared_scratch_cache.purge();
     _host_scratch_cache.purge();
   }
 
   sycl::queue _queue;
+  // Queues of all devices that element-wise algorithms are distributed
+  // across, starting with _queue.
+  std::vector<sycl::queue, libc_allocator<sycl::queue>> _device_queues;
+  // Queue on the host device for algorithms that are not offloaded;
+  // constructed on first use.
+  std::optional<sycl::queue> _host_queue;
+  bool _is_host_queue_initialized = false;
   algorithms::util::allocation_cache _device_scratch_cache;
   algorithms::util::allocation_cache _shared_scratch_cache;
   algorithms::util::allocation_cache _host_scratch_cache;
   int _outstanding_offloaded_operations = 0;
+  int _deferred_synchronization_depth = 0;
   bool _has_independent_work_item_forward_progress = false;
+  // Bytes per second; roughly peak PCIe bandwidth unless measured
+  double _host_to_device_bandwidth = 32.e9;
 
   offload_heuristic_db _offload_db;
   std::vector<uint64_t, libc_allocator<uint64_t>> _instrumented_ops_in_batch;
@@ -99,6 +133,51 @@ private:
   void reset_num_outstanding_operations() {
     _outstanding_offloaded_operations = 0;
   }
+
+  static stdpar_tls_runtime*& current_instance() {
+    static thread_local stdpar_tls_runtime* instance = nullptr;
+    return instance;
+  }
+
+  void init_device_queues() {
+    _device_queues.push_back(_queue);
+
+    bool use_multi_device = false;
+    if(!rt::try_get_environment_variable("stdpar_multi_device",
+                                         use_multi_device) ||
+       !use_multi_device)
+      return;
+
+    // Only devices of the same backend can access the shared allocations
+    // of the primary device.
+    sycl::device primary_device = _queue.get_device();
+    for(const auto& dev : sycl::device::get_devices()) {
+      if(dev != primary_device && !dev.is_host() &&
+         dev.get_backend() == primary_device.get_backend())
+        _device_queues.push_back(
+            sycl::queue{dev, get_default_queue_properties()});
+    }
+    HIPSYCL_DEBUG_INFO << "[stdpar] Distributing element-wise algorithms "
+                          "across "
+                       << _device_queues.size() << " devices" << std::endl;
+  }
+
+  void init_host_queue() {
+    _is_host_queue_initialized = true;
+
+    bool use_host_queue = true;
+    if(rt::try_get_environment_variable("stdpar_host_parallel_fallback",
+                                        use_host_queue) &&
+       !use_host_queue)
+      return;
+
+    for(const auto& dev : sycl::device::get_devices()) {
+      if(dev.is_host()) {
+        _host_queue = sycl::queue{dev, get_default_queue_properties()};
+        return;
+      }
+    }
+  }
 public:
   const offload_heuristic_db& get_offload_db() const {
     return _offload_db;
@@ -112,10 +191,34 @@ public:
     return _queue;
   }
 
+  /// Number of devices that element-wise algorithms may be distributed
+  /// across. Device 0 is the device of get_queue().
+  std::size_t get_num_devices() const {
+    return _device_queues.size();
+  }
+
+  sycl::queue& get_queue(std::size_t device_index) {
+    return _device_queues[device_index];
+  }
+
+  /// Queue on the host device that algorithms which are not offloaded
+  /// can be executed on, or nullptr if there is no host device or
+  /// ACPP_STDPAR_HOST_PARALLEL_FALLBACK is disabled.
+  sycl::queue* get_host_queue() {
+    if(!_is_host_queue_initialized)
+      init_host_queue();
+    return _host_queue ? &(*_host_queue) : nullptr;
+  }
+
   bool device_has_work_item_independent_forward_progress() const {
     return _has_independent_work_item_forward_progress;
   }
 
+  // Estimated time in ns to migrate the given amount of data to the device
+  double estimate_data_transfer_time(std::size_t num_bytes) const {
+    return static_cast<double>(num_bytes) / _host_to_device_bandwidth * 1.e9;
+  }
+
   int get_num_outstanding_operations() const {
     return _outstanding_offloaded_operations;
   }
@@ -135,6 +238,32 @@ public:
     return offloading_batch_counter().load(std::memory_order_acquire);
   }
 
+  /// Waits for all operations offloaded by this thread, and completes
+  /// the current offloading batch.
+  void synchronize() noexcept {
+    int num_ops = get_num_outstanding_operations();
+    if(num_ops > 0) {
+      HIPSYCL_DEBUG_INFO << "[stdpar] Initializing wait for " << num_ops
+                         << " operations" << std::endl;
+      _queue.wait();
+      finalize_offloading_batch();
+    }
+  }
+
+  /// While synchronization is deferred, syncs that the compiler inserts
+  /// after stdpar calls have no effect. See hipsycl::stdpar::async().
+  void push_deferred_synchronization() {
+    ++_deferred_synchronization_depth;
+  }
+
+  void pop_deferred_synchronization() {
+    --_deferred_synchronization_depth;
+  }
+
+  bool is_synchronization_deferred() const {
+    return _deferred_synchronization_depth > 0;
+  }
+
   void finalize_offloading_batch() noexcept {
 #ifndef __ACPP_STDPAR_UNCONDITIONAL_OFFLOAD__
     uint64_t batch_end = get_time_now();
@@ -155,6 +284,11 @@ public:
 #endif
     reset_num_outstanding_operations();
     ++offloading_batch_counter();
+    // All operations of the batch have completed, so idle scratch memory
+    // can be released safely.
+    _device_scratch_cache.trim();
+    _shared_scratch_cache.trim();
+    _host_scratch_cache.trim();
   }
 
   template<algorithms::util::allocation_type AT>
@@ -169,15 +303,28 @@ public:
 
   template<algorithms::util::allocation_type AT>
   algorithms::util::allocation_group make_scratch_group() {
+    return make_scratch_group<AT>(get_queue());
+  }
+
+  /// Scratch group for the device of q, which must be one of the queues
+  /// returned by get_queue() or get_host_queue().
+  template<algorithms::util::allocation_type AT>
+  algorithms::util::allocation_group make_scratch_group(sycl::queue& q) {
     algorithms::util::allocation_cache& cache = get_scratch_cache<AT>();
     return algorithms::util::allocation_group{
-        &cache, get_queue().get_device().AdaptiveCpp_device_id()};
+        &cache, q.get_device().AdaptiveCpp_device_id()};
   }
 
   static stdpar_tls_runtime& get() {
     static thread_local stdpar_tls_runtime rt;
     return rt;
   }
+
+  /// Returns the runtime of the calling thread without constructing it,
+  /// or nullptr if it does not exist (anymore).
+  static stdpar_tls_runtime* try_get() {
+    return current_instance();
+  }
 };
 
 class single_device_dispatch {
@@ -230,11 +377,28 @@ private:
   uint64_t next_multiple_of(uint64_t a, uint64_t b) {
     return ceil_division(a, b) * b;
   }
+
+  struct free_block {
+    free_block* next;
+  };
 public:
+  // Allocations of up to max_small_object_size bytes are served from slabs,
+  // i.e. pool pages that are carved into blocks of one size class.
+  // Size classes are the powers of two between min_small_object_size
+  // and max_small_object_size.
+  static constexpr std::size_t min_small_object_size = 16;
+  static constexpr std::size_t max_small_object_size = 2048;
+  static constexpr int num_small_object_size_classes = 8;
+
   memory_pool(std::size_t size)
       : _pool_size{size}, _pool{nullptr},
         _free_space_map{size > 0 ? size : 1024},
-        _page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))} {
+        _page_size{static_cast<std::size_t>(sysconf(_SC_PAGESIZE))},
+        _slab_size{_page_size > default_slab_size ? _page_size
+                                                  : default_slab_size},
+        _slab_page_classes{nullptr} {
+    for(int i = 0; i < num_small_object_size_classes; ++i)
+      _shared_free_lists[i] = nullptr;
     init();
   }
 
@@ -245,6 +409,18 @@ public:
     if(size < _page_size)
       size = _page_size;
 
+    // Reuse a block of the same buddy level that the calling thread
+    // has released recently, if possible.
+    int level = get_cached_page_level(size);
+    if(level >= 0) {
+      thread_cache& cache = get_thread_cache();
+      if(cache.num_cached_pages[level] > 0) {
+        --cache.num_cached_pages[level];
+        cache.cached_page_bytes -= get_page_block_size(level);
+        return cache.cached_pages[level][cache.num_cached_pages[level]];
+      }
+    }
+
     uint64_t address = 0;
     if(_free_space_map.claim(size, address)) {
       
@@ -260,16 +436,85 @@ public:
 
   void release(void* ptr, std::size_t size) {
     if(_pool && is_from_pool(ptr)) {
-      uint64_t address = reinterpret_cast<uint64_t>(ptr)-reinterpret_cast<uint64_t>(_base_address);
-      _free_space_map.release(address, size);
+      if(size < _page_size)
+        size = _page_size;
+
+      int level = get_cached_page_level(size);
+      if(level >= 0) {
+        thread_cache& cache = get_thread_cache();
+        const std::size_t block_size = get_page_block_size(level);
+        if (!cache.is_flushed &&
+            cache.num_cached_pages[level] < max_cached_pages_per_level &&
+            cache.cached_page_bytes + block_size <=
+                max_thread_cached_page_bytes) {
+          cache.cached_pages[level][cache.num_cached_pages[level]] = ptr;
+          ++cache.num_cached_pages[level];
+          cache.cached_page_bytes += block_size;
+          return;
+        }
+      }
+
+      release_to_free_space_map(ptr, size);
     }
   }
 
+  /// Claims a block of at least size <= max_small_object_size bytes
+  /// from a slab. Blocks are taken from a free list of the calling thread,
+  /// which is refilled from blocks that were returned by exited threads,
+  /// or by carving a new slab.
+  void* claim_small(std::size_t size) {
+    if(_pool_size == 0 || !_slab_page_classes)
+      return nullptr;
+
+    int size_class = get_size_class(size);
+    thread_cache& cache = get_thread_cache();
+    if(!cache.free_lists[size_class] && !refill(cache, size_class))
+      return nullptr;
+
+    free_block* block = cache.free_lists[size_class];
+    cache.free_lists[size_class] = block->next;
+    --cache.num_free_blocks[size_class];
+    return block;
+  }
+
+  /// Returns a block obtained from claim_small() to the free list of the
+  /// calling thread. Slabs are not returned to the pool.
+  void release_small(void* ptr) {
+    int size_class = get_slab_size_class(ptr);
+    assert(size_class >= 0);
+
+    free_block* block = static_cast<free_block*>(ptr);
+    thread_cache& cache = get_thread_cache();
+    if(cache.is_flushed) {
+      // The thread is exiting - its free list is no longer used
+      std::lock_guard<std::mutex> lock{_shared_free_list_mutex};
+      block->next = _shared_free_lists[size_class];
+      _shared_free_lists[size_class] = block;
+      return;
+    }
+
+    block->next = cache.free_lists[size_class];
+    cache.free_lists[size_class] = block;
+    ++cache.num_free_blocks[size_class];
+    // Threads that free more than they allocate must not hoard blocks
+    if(cache.num_free_blocks[size_class] * get_block_size(size_class) >
+       max_thread_cached_bytes)
+      flush(cache, size_class);
+  }
+
+  /// Whether ptr belongs to a slab, and hence must be released using
+  /// release_small()
+  bool is_small_object(void* ptr) const {
+    return get_slab_size_class(ptr) >= 0;
+  }
+
   ~memory_pool() {
     // Memory pool might be destroyed after runtime shutdown, so rely on OS
     // to clean up for now
     //if(_pool)
     //  sycl::free(_pool, detail::single_device_dispatch::get_queue());
+    if(_slab_page_classes)
+      __libc_free(_slab_page_classes);
   }
 
   std::size_t get_size() const {
@@ -284,6 +529,155 @@ public:
     return ptr >= _base_address && ptr < pool_end;
   }
 private:
+  static constexpr std::size_t default_slab_size = 64 * 1024;
+  static constexpr std::size_t max_thread_cached_bytes = 2 * default_slab_size;
+  // Released blocks of up to 2^(num_cached_page_levels-1) pages are kept
+  // by the releasing thread for reuse, without taking the lock of the free
+  // space map.
+  static constexpr int num_cached_page_levels = 9;
+  static constexpr int max_cached_pages_per_level = 8;
+  static constexpr std::size_t max_thread_cached_page_bytes = 16 * 1024 * 1024;
+
+  // Must be trivially destructible, such that it can still be accessed
+  // by frees from thread_local destructors that run after thread_cache_flusher.
+  struct thread_cache {
+    free_block* free_lists[num_small_object_size_classes];
+    std::size_t num_free_blocks[num_small_object_size_classes];
+    // The blocks are not used to store the list, since they may currently
+    // reside in device memory.
+    void* cached_pages[num_cached_page_levels][max_cached_pages_per_level];
+    int num_cached_pages[num_cached_page_levels];
+    std::size_t cached_page_bytes;
+    bool has_flusher;
+    bool is_flushed;
+  };
+
+  // Moves the free lists of a thread to the shared free lists when the
+  // thread exits.
+  class thread_cache_flusher {
+  public:
+    thread_cache_flusher(memory_pool* pool, thread_cache* cache)
+    : _pool{pool}, _cache{cache} {}
+
+    ~thread_cache_flusher() {
+      for(int i = 0; i < num_small_object_size_classes; ++i)
+        _pool->flush(*_cache, i);
+      for(int i = 0; i < num_cached_page_levels; ++i) {
+        for(int j = 0; j < _cache->num_cached_pages[i]; ++j)
+          _pool->release_to_free_space_map(_cache->cached_pages[i][j],
+                                           _pool->get_page_block_size(i));
+        _cache->num_cached_pages[i] = 0;
+      }
+      _cache->cached_page_bytes = 0;
+      _cache->is_flushed = true;
+    }
+  private:
+    memory_pool* _pool;
+    thread_cache* _cache;
+  };
+
+  thread_cache& get_thread_cache() {
+    static thread_local thread_cache cache;
+    if(!cache.has_flusher) {
+      cache.has_flusher = true;
+      static thread_local thread_cache_flusher flusher{this, &cache};
+      (void)flusher;
+    }
+    return cache;
+  }
+
+  void release_to_free_space_map(void* ptr, std::size_t size) {
+    uint64_t address = reinterpret_cast<uint64_t>(ptr)-reinterpret_cast<uint64_t>(_base_address);
+    _free_space_map.release(address, size);
+  }
+
+  std::size_t get_page_block_size(int level) const {
+    return _page_size << level;
+  }
+
+  int get_cached_page_level(std::size_t size) const {
+    for(int level = 0; level < num_cached_page_levels; ++level)
+      if(get_page_block_size(level) >= size)
+        return level;
+    return -1;
+  }
+
+  static int get_size_class(std::size_t size) {
+    int size_class = 0;
+    while(get_block_size(size_class) < size)
+      ++size_class;
+    return size_class;
+  }
+
+  static constexpr std::size_t get_block_size(int size_class) {
+    return min_small_object_size << size_class;
+  }
+
+  int get_slab_size_class(void* ptr) const {
+    if(!_slab_page_classes || !is_from_pool(ptr))
+      return -1;
+    std::size_t page = ((char*)ptr - (char*)_base_address) / _page_size;
+    return static_cast<int>(
+               __atomic_load_n(&_slab_page_classes[page], __ATOMIC_ACQUIRE)) -
+           1;
+  }
+
+  void flush(thread_cache& cache, int size_class) {
+    free_block* first = cache.free_lists[size_class];
+    if(!first)
+      return;
+    free_block* last = first;
+    while(last->next)
+      last = last->next;
+
+    std::lock_guard<std::mutex> lock{_shared_free_list_mutex};
+    last->next = _shared_free_lists[size_class];
+    _shared_free_lists[size_class] = first;
+    cache.free_lists[size_class] = nullptr;
+    cache.num_free_blocks[size_class] = 0;
+  }
+
+  bool refill(thread_cache& cache, int size_class) {
+    const std::size_t block_size = get_block_size(size_class);
+    const std::size_t num_blocks = _slab_size / block_size;
+    {
+      // Take up to one slab worth of blocks from the shared free list
+      std::lock_guard<std::mutex> lock{_shared_free_list_mutex};
+      free_block* first = _shared_free_lists[size_class];
+      if(first) {
+        free_block* last = first;
+        std::size_t n = 1;
+        for(; n < num_blocks && last->next; ++n)
+          last = last->next;
+        _shared_free_lists[size_class] = last->next;
+        last->next = nullptr;
+        cache.free_lists[size_class] = first;
+        cache.num_free_blocks[size_class] = n;
+        return true;
+      }
+    }
+
+    uint64_t address = 0;
+    if(!_free_space_map.claim(_slab_size, address))
+      return false;
+
+    char* slab = (char*)_base_address + address;
+    std::size_t first_page = address / _page_size;
+    for(std::size_t i = 0; i < _slab_size / _page_size; ++i)
+      __atomic_store_n(&_slab_page_classes[first_page + i],
+                       static_cast<uint8_t>(size_class + 1), __ATOMIC_RELEASE);
+
+    for(std::size_t i = 0; i < num_blocks; ++i) {
+      free_block* block = reinterpret_cast<free_block*>(slab + i * block_size);
+      block->next = (i + 1 < num_blocks)
+                        ? reinterpret_cast<free_block*>(slab +
+                                                        (i + 1) * block_size)
+                        : nullptr;
+    }
+    cache.free_lists[size_class] = reinterpret_cast<free_block*>(slab);
+    cache.num_free_blocks[size_class] = num_blocks;
+    return true;
+  }
 
   void init() {
     HIPSYCL_DEBUG_INFO << "[stdpar] Building a memory pool of size "
@@ -295,6 +689,12 @@ private:
     uint64_t aligned_pool_base = next_multiple_of((uint64_t)_pool, _page_size);
     _base_address = (void*)aligned_pool_base;
     assert(aligned_pool_base % _page_size == 0);
+
+    // One byte per pool page storing the size class + 1 of slab pages,
+    // and 0 otherwise. calloc() leaves untouched parts of the table unmapped.
+    if(_pool && _pool_size > 0)
+      _slab_page_classes = static_cast<uint8_t *>(
+          __libc_calloc(ceil_division(_pool_size, _page_size), 1));
   }
 
 
@@ -303,6 +703,11 @@ private:
   void* _base_address;
   free_space_map _free_space_map;
   std::size_t _page_size;
+  std::size_t _slab_size;
+  uint8_t* _slab_page_classes;
+
+  std::mutex _shared_free_list_mutex;
+  free_block* _shared_free_lists[num_small_object_size_classes];
 };
 
 class unified_shared_memory {
@@ -312,6 +717,13 @@ class unified_shared_memory {
     // heuristic, touches this value - so it may not be up to date
     // if there is no prefetch!
     int64_t most_recent_offload_batch;
+    // Number of offloaded and host-executed stdpar operations that
+    // have used the allocation
+    uint32_t num_offloaded_uses;
+    uint32_t num_host_uses;
+    // Whether the allocation is currently hinted to reside in
+    // device memory
+    bool is_device_resident;
   };
 
   using allocation_map_t = allocation_map<allocation_map_payload>;
@@ -333,6 +745,7 @@ public:
     if(thread_local_storage::get().disabled_stack == 0) {
       
       void* ptr = nullptr;
+      bool is_small_object = false;
       push_disabled();
       if (alignment != 0) {
         ptr = sycl::aligned_alloc_shared(alignment, n,
@@ -348,7 +761,12 @@ public:
           mem_pool = usm_manager.get_memory_pool();
         }
 
-        if(n < mem_pool->get_size() / 2) {
+        if(n <= memory_pool::max_small_object_size) {
+          ptr = mem_pool->claim_small(n);
+          // Small objects are not tracked in the allocation map; they
+          // share pages and are not worth prefetching individually.
+          is_small_object = ptr != nullptr;
+        } else if(n < mem_pool->get_size() / 2) {
           ptr = mem_pool->claim(n);
         }
         // ptr will still be nullptr if pool was not used, or pool allocation
@@ -357,13 +775,18 @@ public:
           ptr = sycl::malloc_shared(n, detail::single_device_dispatch::get_queue());
         }
       }
-      get()._is_initialized = true;
+      // Avoid writing the shared flag on every allocation
+      if(!get()._is_initialized.load(std::memory_order_relaxed))
+        get()._is_initialized = true;
       pop_disabled();
 
-      if(ptr) {
+      if(ptr && !is_small_object) {
         allocation_map_t::value_type v;
         v.allocation_size = n;
         v.most_recent_offload_batch = -1;
+        v.num_offloaded_uses = 0;
+        v.num_host_uses = 0;
+        v.is_device_resident = false;
         get()._allocation_map.insert(reinterpret_cast<uint64_t>(ptr), v);
       }
 
@@ -398,6 +821,19 @@ public:
         return;
 
       push_disabled();
+      // Operations that were launched asynchronously might still
+      // use the allocation.
+      if(auto* rt = stdpar_tls_runtime::try_get();
+         rt && rt->get_num_outstanding_operations() > 0)
+        rt->synchronize();
+
+      memory_pool* mem_pool = get().get_memory_pool();
+      if(mem_pool && mem_pool->is_small_object(ptr)) {
+        mem_pool->release_small(ptr);
+        pop_disabled();
+        return;
+      }
+
       auto* map_entry = get()._allocation_map.get_entry_of_root_address(
               reinterpret_cast<uint64_t>(ptr));
       if (!map_entry) {
@@ -406,7 +842,6 @@ public:
         uint64_t allocation_size = map_entry->allocation_size;
 
         get()._allocation_map.erase(reinterpret_cast<uint64_t>(ptr));
-        memory_pool* mem_pool = get().get_memory_pool();
         if(mem_pool && mem_pool->is_from_pool(ptr)) {
           mem_pool->release(ptr, allocation_size);
         } else {
@@ -426,7 +861,9 @@ public:
 
   static bool allocation_lookup(void* ptr, allocation_lookup_result& result) {
     uint64_t root_address;
-    auto* ret = get()._allocation_map.get_entry(reinterpret_cast<uint64_t>(ptr), root_address);
+    auto *ret = get()._allocation_map.get_entry(
+        reinterpret_cast<uint64_t>(ptr), root_address,
+        thread_local_storage::get().lookup_cache);
     if(!ret)
       return false;
 
@@ -434,6 +871,32 @@ public:
     result.info = ret;
     return true;
   }
+
+  /// Looks up the allocations of multiple pointers at once. results[i].info
+  /// is nullptr if ptrs[i] does not belong to a known allocation.
+  static void allocation_lookup(void *const *ptrs, std::size_t num_ptrs,
+                                allocation_lookup_result *results) {
+    constexpr std::size_t batch_size = 16;
+    uint64_t addresses[batch_size];
+    uint64_t root_addresses[batch_size];
+    allocation_map_t::value_type* entries[batch_size];
+
+    for(std::size_t begin = 0; begin < num_ptrs; begin += batch_size) {
+      std::size_t n = std::min(batch_size, num_ptrs - begin);
+      for(std::size_t i = 0; i < n; ++i)
+        addresses[i] = reinterpret_cast<uint64_t>(ptrs[begin + i]);
+
+      get()._allocation_map.get_entries(
+          addresses, n, entries, root_addresses,
+          thread_local_storage::get().lookup_cache);
+
+      for(std::size_t i = 0; i < n; ++i) {
+        results[begin + i].root_address =
+            reinterpret_cast<void *>(root_addresses[i]);
+        results[begin + i].info = entries[i];
+      }
+    }
+  }
 private:
   memory_pool* get_memory_pool() const {
     return __atomic_load_n(&_memory_pool, __ATOMIC_ACQUIRE);
@@ -507,6 +970,7 @@ private:
 #else
     int disabled_stack = 0;
 #endif
+    allocation_map_t::lookup_cache lookup_cache;
   private:
     thread_local_storage(){}
   };
@@ -31,7 +31,13 @@ template <class ForwardIt, class UnaryFunction2>
 HIPSYCL_STDPAR_ENTRYPOINT void for_each(hipsycl::stdpar::par_unseq, ForwardIt first,
                                         ForwardIt last, UnaryFunction2 f) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::for_each(queue, first, last, f);
+    hipsycl::stdpar::detail::distribute_across_devices(
+        queue, first, std::distance(first, last),
+        [&](auto &slice_queue, std::size_t begin, std::size_t count) {
+          auto slice_first = std::next(first, begin);
+          hipsycl::algorithms::for_each(slice_queue, slice_first,
+                                        std::next(slice_first, count), f);
+        });
   };
 
   auto fallback = [&](){
@@ -53,7 +59,12 @@ ForwardIt for_each_n(hipsycl::stdpar::par_unseq,
   auto offloader = [&](auto& queue) {
     ForwardIt last = first;
     std::advance(last, std::max(n, Size{0}));
-    hipsycl::algorithms::for_each_n(queue, first, n, f);
+    hipsycl::stdpar::detail::distribute_across_devices(
+        queue, first, static_cast<std::size_t>(std::max(n, Size{0})),
+        [&](auto &slice_queue, std::size_t begin, std::size_t count) {
+          hipsycl::algorithms::for_each_n(slice_queue, std::next(first, begin),
+                                          count, f);
+        });
     return last;
   };
 
@@ -78,7 +89,14 @@ ForwardIt2 transform(hipsycl::stdpar::par_unseq,
   auto offloader = [&](auto& queue){
     ForwardIt2 last = d_first;
     std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, d_first, unary_op);
+    hipsycl::stdpar::detail::distribute_across_devices(
+        queue, first1, std::distance(first1, last1),
+        [&](auto &slice_queue, std::size_t begin, std::size_t count) {
+          auto slice_first = std::next(first1, begin);
+          hipsycl::algorithms::transform(slice_queue, slice_first,
+                                         std::next(slice_first, count),
+                                         std::next(d_first, begin), unary_op);
+        });
     return last;
   };
 
@@ -105,8 +123,14 @@ ForwardIt3 transform(hipsycl::stdpar::par_unseq,
   auto offloader = [&](auto &queue) {
     ForwardIt3 last = d_first;
     std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, first2, d_first,
-                                   binary_op);
+    hipsycl::stdpar::detail::distribute_across_devices(
+        queue, first1, std::distance(first1, last1),
+        [&](auto &slice_queue, std::size_t begin, std::size_t count) {
+          auto slice_first = std::next(first1, begin);
+          hipsycl::algorithms::transform(
+              slice_queue, slice_first, std::next(slice_first, count),
+              std::next(first2, begin), std::next(d_first, begin), binary_op);
+        });
     return last;
   };
 
@@ -154,8 +178,28 @@ ForwardIt2 copy_if(hipsycl::stdpar::par_unseq,
                    UnaryPredicate pred) {
   auto offloader = [&](auto& queue){
     ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::copy_if(queue, first, last, d_first, pred);
+    if(first == last)
+      return d_last;
+    // The scratch groups can expire at the end of the scope for the same
+    // reasons as in transform_reduce: We synchronize before, and
+    // the thread-local in-order queue orders us with subsequent users.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_elements_copied =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::copy_if(queue, device_scratch_group, first, last,
+                                 d_first, pred, num_elements_copied);
+    // We need the number of copied elements to construct the result
+    queue.wait();
+
+    std::advance(d_last, *num_elements_copied);
     return d_last;
   };
 
@@ -164,7 +208,7 @@ ForwardIt2 copy_if(hipsycl::stdpar::par_unseq,
                         d_first, pred);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
       hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_if{},
                                  hipsycl::stdpar::par_unseq{}),
       std::distance(first, last), ForwardIt2, offloader, fallback, first,
@@ -199,7 +243,13 @@ HIPSYCL_STDPAR_ENTRYPOINT
 void fill(hipsycl::stdpar::par_unseq,
           ForwardIt first, ForwardIt last, const T& value) {
   auto offloader = [&](auto& queue){
-    hipsycl::algorithms::fill(queue, first, last, value);
+    hipsycl::stdpar::detail::distribute_across_devices(
+        queue, first, std::distance(first, last),
+        [&](auto &slice_queue, std::size_t begin, std::size_t count) {
+          auto slice_first = std::next(first, begin);
+          hipsycl::algorithms::fill(slice_queue, slice_first,
+                                    std::next(slice_first, count), value);
+        });
   };
 
   auto fallback = [&]() {
@@ -220,7 +270,12 @@ HIPSYCL_STDPAR_ENTRYPOINT ForwardIt fill_n(hipsycl::stdpar::par_unseq, ForwardIt
   auto offloader = [&](auto& queue){
     ForwardIt last = first;
     std::advance(last, std::max(count, Size{0}));
-    hipsycl::algorithms::fill_n(queue, first, count, value);
+    hipsycl::stdpar::detail::distribute_across_devices(
+        queue, first, static_cast<std::size_t>(std::max(count, Size{0})),
+        [&](auto &slice_queue, std::size_t begin, std::size_t slice_count) {
+          hipsycl::algorithms::fill_n(slice_queue, std::next(first, begin),
+                                      slice_count, value);
+        });
     return last;
   };
 
@@ -369,20 +424,110 @@ HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 replace_copy_if(
       HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, p, new_value);
 }
 
-/*
 template <class ForwardIt, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find(const hipsycl::stdpar::par_unseq, ForwardIt first,
-                                         ForwardIt last, const T &value);
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find(hipsycl::stdpar::par_unseq,
+                                         ForwardIt first, ForwardIt last,
+                                         const T &value) {
+
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+
+    auto *output = output_scratch_group.template obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::find(queue, first, last, output, value);
+    queue.wait();
+    auto result = first;
+    std::advance(result, *output);
+    return result;
+  };
+
+  auto fallback = [&](){
+    return std::find(hipsycl::stdpar::par_unseq_host_fallback, first, last, value);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::find{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), value);
+}
 
 template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if(const hipsycl::stdpar::par_unseq,
-                                            ForwardIt first, ForwardIt last,
-                                            UnaryPredicate p);
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if(hipsycl::stdpar::par_unseq,
+                                         ForwardIt first, ForwardIt last,
+                                         UnaryPredicate p) {
+
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+
+    auto *output = output_scratch_group.template obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::find_if(queue, first, last, output, p);
+    queue.wait();
+    auto result = first;
+    std::advance(result, *output);
+    return result;
+  };
+
+  auto fallback = [&](){
+    return std::find_if(hipsycl::stdpar::par_unseq_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::find_if{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
 
 template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if_not(const hipsycl::stdpar::par_unseq,
-                                                ForwardIt first, ForwardIt last,
-                                                UnaryPredicate q); */
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if_not(hipsycl::stdpar::par_unseq,
+                                         ForwardIt first, ForwardIt last,
+                                         UnaryPredicate p) {
+
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+
+    auto *output = output_scratch_group.template obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::find_if_not(queue, first, last, output, p);
+    queue.wait();
+    auto result = first;
+    std::advance(result, *output);
+    return result;
+  };
+
+  auto fallback = [&](){
+    return std::find_if_not(hipsycl::stdpar::par_unseq_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::find_if_not{},
+                                 hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
 
 
 template<class ForwardIt, class UnaryPredicate>
@@ -398,10 +543,10 @@ bool all_of(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    auto *output = output_scratch_group.template obtain<
+        hipsycl::algorithms::detail::early_exit_flag_t>(1);
     hipsycl::algorithms::all_of(queue, first, last, output, p);
     queue.wait();
     return static_cast<bool>(*output);
@@ -431,10 +576,10 @@ bool any_of(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    auto *output = output_scratch_group.template obtain<
+        hipsycl::algorithms::detail::early_exit_flag_t>(1);
     hipsycl::algorithms::any_of(queue, first, last, output, p);
     queue.wait();
     return static_cast<bool>(*output);
@@ -464,10 +609,10 @@ bool none_of(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    auto *output = output_scratch_group.template obtain<
+        hipsycl::algorithms::detail::early_exit_flag_t>(1);
     hipsycl::algorithms::none_of(queue, first, last, output, p);
     queue.wait();
     return static_cast<bool>(*output);
@@ -491,7 +636,14 @@ template <class RandomIt>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
                                         RandomIt last) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last);
+    // Subsequent users of the cached scratch memory are ordered after us
+    // by the thread-local in-order queue, so the scratch group may expire
+    // before the sort has completed.
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::sort(queue, sort_scratch_group, first, last);
   };
 
   auto fallback = [&](){
@@ -511,7 +663,14 @@ template <class RandomIt, class Compare>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
                                         RandomIt last, Compare comp) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last, comp);
+    // Subsequent users of the cached scratch memory are ordered after us
+    // by the thread-local in-order queue, so the scratch group may expire
+    // before the sort has completed.
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::sort(queue, sort_scratch_group, first, last, comp);
   };
 
   auto fallback = [&]() {
@@ -527,182 +686,560 @@ HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par_unseq, RandomIt first,
 }
 
 
-
-//////////////////// par policy  /////////////////////////////////////
-
-
-template <class ForwardIt, class UnaryFunction2>
-HIPSYCL_STDPAR_ENTRYPOINT void for_each(hipsycl::stdpar::par, ForwardIt first,
-                                        ForwardIt last, UnaryFunction2 f) {
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq,
+    RandomIt first, RandomIt last) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::for_each(queue, first, last, f);
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::stable_sort(queue, sort_scratch_group, first, last);
   };
 
-  auto fallback = [&](){
-    std::for_each(hipsycl::stdpar::par_host_fallback, first, last, f);
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_unseq_host_fallback, first, last);
   };
 
   HIPSYCL_STDPAR_OFFLOAD_NORET(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::for_each{},
-          hipsycl::stdpar::par{}),
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par_unseq{}),
       std::distance(first, last), offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), f);
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
 }
 
-template<class ForwardIt, class Size, class UnaryFunction2>
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt for_each_n(hipsycl::stdpar::par,
-                    ForwardIt first, Size n, UnaryFunction2 f) {
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par_unseq,
+    RandomIt first, RandomIt last, Compare comp) {
   auto offloader = [&](auto& queue) {
-    ForwardIt last = first;
-    std::advance(last, std::max(n, Size{0}));
-    hipsycl::algorithms::for_each_n(queue, first, n, f);
-    return last;
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::stable_sort(queue, sort_scratch_group, first, last, comp);
   };
 
   auto fallback = [&]() {
-    return std::for_each_n(hipsycl::stdpar::par_host_fallback, first, n,
-                           f);
+    std::stable_sort(hipsycl::stdpar::par_unseq_host_fallback, first, last, comp);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::for_each_n{},
-          hipsycl::stdpar::par{}),
-      n, ForwardIt, offloader, fallback, first, n, f);
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
 
-template <class ForwardIt1, class ForwardIt2, class UnaryOperation>
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt2 transform(hipsycl::stdpar::par,
-                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 d_first,
-                     UnaryOperation unary_op) {
-  
-  auto offloader = [&](auto& queue){
-    ForwardIt2 last = d_first;
-    std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, d_first, unary_op);
-    return last;
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void partial_sort(hipsycl::stdpar::par_unseq,
+    RandomIt first, RandomIt middle,
+    RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::partial_sort(queue, sort_scratch_group, first, middle,
+                                      last);
   };
 
   auto fallback = [&]() {
-    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
-                          last1, d_first, unary_op);
+    std::partial_sort(hipsycl::stdpar::par_unseq_host_fallback, first, middle, last);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::transform{},
-          hipsycl::stdpar::par{}),
-      std::distance(first1, last1), ForwardIt2, offloader, fallback, first1,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), d_first, unary_op);
+          hipsycl::stdpar::algorithm_category::partial_sort{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(middle),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
 }
 
-template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
-          class BinaryOperation>
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt3 transform(hipsycl::stdpar::par,
-                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
-                     ForwardIt3 d_first, BinaryOperation binary_op) {
-
-  auto offloader = [&](auto &queue) {
-    ForwardIt3 last = d_first;
-    std::advance(last, std::distance(first1, last1));
-    hipsycl::algorithms::transform(queue, first1, last1, first2, d_first,
-                                   binary_op);
-    return last;
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void partial_sort(hipsycl::stdpar::par_unseq,
+    RandomIt first, RandomIt middle,
+    RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::partial_sort(queue, sort_scratch_group, first, middle,
+                                      last, comp);
   };
 
   auto fallback = [&]() {
-    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
-                          last1, first2, d_first, binary_op);
+    std::partial_sort(hipsycl::stdpar::par_unseq_host_fallback, first, middle, last, comp);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
       hipsycl::stdpar::algorithm(
-          hipsycl::stdpar::algorithm_category::transform{},
-          hipsycl::stdpar::par{}),
-      std::distance(first1, last1), ForwardIt3, offloader, fallback, first1,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, d_first, binary_op);
+          hipsycl::stdpar::algorithm_category::partial_sort{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(middle),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
 
-template <class ForwardIt1, class ForwardIt2>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 copy(const hipsycl::stdpar::par,
-                                          ForwardIt1 first, ForwardIt1 last,
-                                          ForwardIt2 d_first) {
-  auto offloader = [&](auto& queue){
-    ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::copy(queue, first, last, d_first);
-    return d_last;
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void nth_element(hipsycl::stdpar::par_unseq,
+    RandomIt first, RandomIt nth,
+    RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::nth_element(queue, sort_scratch_group, first, nth,
+                                     last);
   };
 
   auto fallback = [&]() {
-    return std::copy(hipsycl::stdpar::par_host_fallback, first, last,
-                     d_first);
+    std::nth_element(hipsycl::stdpar::par_unseq_host_fallback, first, nth, last);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), ForwardIt2, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::nth_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(nth),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
 }
 
-template<class ForwardIt1, class ForwardIt2, class UnaryPredicate >
-HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt2 copy_if(hipsycl::stdpar::par,
-                   ForwardIt1 first, ForwardIt1 last,
-                   ForwardIt2 d_first,
-                   UnaryPredicate pred) {
-  auto offloader = [&](auto& queue){
-    ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::copy_if(queue, first, last, d_first, pred);
-    return d_last;
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void nth_element(hipsycl::stdpar::par_unseq,
+    RandomIt first, RandomIt nth,
+    RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::nth_element(queue, sort_scratch_group, first, nth,
+                                     last, comp);
   };
 
   auto fallback = [&]() {
-    return std::copy_if(hipsycl::stdpar::par_host_fallback, first, last,
-                        d_first, pred);
+    std::nth_element(hipsycl::stdpar::par_unseq_host_fallback, first, nth, last, comp);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_if{},
-                                 hipsycl::stdpar::par{}),
-      std::distance(first, last), ForwardIt2, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, pred);
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::nth_element{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(nth),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
 
-template<class ForwardIt1, class Size, class ForwardIt2 >
+template <class ForwardIt, class UnaryPredicate>
 HIPSYCL_STDPAR_ENTRYPOINT
-ForwardIt2 copy_n(hipsycl::stdpar::par,
-                   ForwardIt1 first, Size count, ForwardIt2 result ) {
+ForwardIt partition(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+    UnaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
 
-  auto offloader = [&](auto& queue){
-    ForwardIt2 last = result;
-    std::advance(last, std::max(count, Size{0}));
-    hipsycl::algorithms::copy_n(queue, first, count, result);
-    return last;
+    std::size_t* num_true =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::partition(queue, device_scratch_group, first, last, p,
+                                   num_true);
+    // We need the number of elements satisfying p to construct the result
+    queue.wait();
+
+    std::advance(result, *num_true);
+    return result;
   };
 
   auto fallback = [&]() {
-    return std::copy_n(hipsycl::stdpar::par_host_fallback, first, count,
-                       result);
+    return std::partition(hipsycl::stdpar::par_unseq_host_fallback, first, last, p);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_n{},
-                                 hipsycl::stdpar::par{}),
-      count, ForwardIt2, offloader, fallback, first, count, result);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::partition{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
 }
 
-template<class ForwardIt, class T >
+template <class BidirIt, class UnaryPredicate>
 HIPSYCL_STDPAR_ENTRYPOINT
-void fill(hipsycl::stdpar::par,
-          ForwardIt first, ForwardIt last, const T& value) {
-  auto offloader = [&](auto& queue){
+BidirIt stable_partition(hipsycl::stdpar::par_unseq, BidirIt first, BidirIt last,
+    UnaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    BidirIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_true =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::stable_partition(queue, device_scratch_group, first,
+                                          last, p, num_true);
+    // We need the number of elements satisfying p to construct the result
+    queue.wait();
+
+    std::advance(result, *num_true);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::stable_partition(hipsycl::stdpar::par_unseq_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_partition{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), BidirIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt remove_if(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+    UnaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_remaining =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::remove_if(queue, device_scratch_group, first, last, p,
+                                   num_remaining);
+    // We need the number of remaining elements to construct the result
+    queue.wait();
+
+    std::advance(result, *num_remaining);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::remove_if(hipsycl::stdpar::par_unseq_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::remove_if{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt unique(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_remaining =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::unique(queue, device_scratch_group, first, last,
+                                std::equal_to<>{}, num_remaining);
+    // We need the number of remaining elements to construct the result
+    queue.wait();
+
+    std::advance(result, *num_remaining);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::unique(hipsycl::stdpar::par_unseq_host_fallback, first, last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::unique{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class ForwardIt, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt unique(hipsycl::stdpar::par_unseq, ForwardIt first, ForwardIt last,
+    BinaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_remaining =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::unique(queue, device_scratch_group, first, last, p,
+                                num_remaining);
+    // We need the number of remaining elements to construct the result
+    queue.wait();
+
+    std::advance(result, *num_remaining);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::unique(hipsycl::stdpar::par_unseq_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::unique{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+//////////////////// par policy  /////////////////////////////////////
+
+
+template <class ForwardIt, class UnaryFunction2>
+HIPSYCL_STDPAR_ENTRYPOINT void for_each(hipsycl::stdpar::par, ForwardIt first,
+                                        ForwardIt last, UnaryFunction2 f) {
+  auto offloader = [&](auto& queue) {
+    hipsycl::algorithms::for_each(queue, first, last, f);
+  };
+
+  auto fallback = [&](){
+    std::for_each(hipsycl::stdpar::par_host_fallback, first, last, f);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::for_each{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), f);
+}
+
+template<class ForwardIt, class Size, class UnaryFunction2>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt for_each_n(hipsycl::stdpar::par,
+                    ForwardIt first, Size n, UnaryFunction2 f) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt last = first;
+    std::advance(last, std::max(n, Size{0}));
+    hipsycl::algorithms::for_each_n(queue, first, n, f);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::for_each_n(hipsycl::stdpar::par_host_fallback, first, n,
+                           f);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::for_each_n{},
+          hipsycl::stdpar::par{}),
+      n, ForwardIt, offloader, fallback, first, n, f);
+}
+
+template <class ForwardIt1, class ForwardIt2, class UnaryOperation>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 transform(hipsycl::stdpar::par,
+                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 d_first,
+                     UnaryOperation unary_op) {
+  
+  auto offloader = [&](auto& queue){
+    ForwardIt2 last = d_first;
+    std::advance(last, std::distance(first1, last1));
+    hipsycl::algorithms::transform(queue, first1, last1, d_first, unary_op);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
+                          last1, d_first, unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform{},
+          hipsycl::stdpar::par{}),
+      std::distance(first1, last1), ForwardIt2, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), d_first, unary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class ForwardIt3,
+          class BinaryOperation>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt3 transform(hipsycl::stdpar::par,
+                     ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+                     ForwardIt3 d_first, BinaryOperation binary_op) {
+
+  auto offloader = [&](auto &queue) {
+    ForwardIt3 last = d_first;
+    std::advance(last, std::distance(first1, last1));
+    hipsycl::algorithms::transform(queue, first1, last1, first2, d_first,
+                                   binary_op);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform(hipsycl::stdpar::par_host_fallback, first1,
+                          last1, first2, d_first, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform{},
+          hipsycl::stdpar::par{}),
+      std::distance(first1, last1), ForwardIt3, offloader, fallback, first1,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last1), first2, d_first, binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 copy(const hipsycl::stdpar::par,
+                                          ForwardIt1 first, ForwardIt1 last,
+                                          ForwardIt2 d_first) {
+  auto offloader = [&](auto& queue){
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::copy(queue, first, last, d_first);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::copy(hipsycl::stdpar::par_host_fallback, first, last,
+                     d_first);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+}
+
+template<class ForwardIt1, class ForwardIt2, class UnaryPredicate >
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 copy_if(hipsycl::stdpar::par,
+                   ForwardIt1 first, ForwardIt1 last,
+                   ForwardIt2 d_first,
+                   UnaryPredicate pred) {
+  auto offloader = [&](auto& queue){
+    ForwardIt2 d_last = d_first;
+    if(first == last)
+      return d_last;
+    // The scratch groups can expire at the end of the scope for the same
+    // reasons as in transform_reduce: We synchronize before, and
+    // the thread-local in-order queue orders us with subsequent users.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_elements_copied =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::copy_if(queue, device_scratch_group, first, last,
+                                 d_first, pred, num_elements_copied);
+    // We need the number of copied elements to construct the result
+    queue.wait();
+
+    std::advance(d_last, *num_elements_copied);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::copy_if(hipsycl::stdpar::par_host_fallback, first, last,
+                        d_first, pred);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_if{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, pred);
+}
+
+template<class ForwardIt1, class Size, class ForwardIt2 >
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt2 copy_n(hipsycl::stdpar::par,
+                   ForwardIt1 first, Size count, ForwardIt2 result ) {
+
+  auto offloader = [&](auto& queue){
+    ForwardIt2 last = result;
+    std::advance(last, std::max(count, Size{0}));
+    hipsycl::algorithms::copy_n(queue, first, count, result);
+    return last;
+  };
+
+  auto fallback = [&]() {
+    return std::copy_n(hipsycl::stdpar::par_host_fallback, first, count,
+                       result);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::copy_n{},
+                                 hipsycl::stdpar::par{}),
+      count, ForwardIt2, offloader, fallback, first, count, result);
+}
+
+template<class ForwardIt, class T >
+HIPSYCL_STDPAR_ENTRYPOINT
+void fill(hipsycl::stdpar::par,
+          ForwardIt first, ForwardIt last, const T& value) {
+  auto offloader = [&](auto& queue){
     hipsycl::algorithms::fill(queue, first, last, value);
   };
 
@@ -849,46 +1386,136 @@ replace_copy(hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
       HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, old_value, new_value);
 }
 
-template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 replace_copy_if(
-    hipsycl::stdpar::par, ForwardIt1 first,
-    ForwardIt1 last, ForwardIt2 d_first, UnaryPredicate p, const T &new_value) {
+template <class ForwardIt1, class ForwardIt2, class UnaryPredicate, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 replace_copy_if(
+    hipsycl::stdpar::par, ForwardIt1 first,
+    ForwardIt1 last, ForwardIt2 d_first, UnaryPredicate p, const T &new_value) {
+
+  auto offloader = [&](auto &queue) {
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    hipsycl::algorithms::replace_copy_if(queue, first, last, d_first, p,
+                                         new_value);
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::replace_copy_if(hipsycl::stdpar::par_host_fallback, first,
+                                last, d_first, p, new_value);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+                             hipsycl::stdpar::algorithm_category::replace_copy_if{},
+                             hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, p, new_value);
+}
+
+template <class ForwardIt, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find(hipsycl::stdpar::par,
+                                         ForwardIt first, ForwardIt last,
+                                         const T &value) {
+
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+
+    auto *output = output_scratch_group.template obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::find(queue, first, last, output, value);
+    queue.wait();
+    auto result = first;
+    std::advance(result, *output);
+    return result;
+  };
+
+  auto fallback = [&](){
+    return std::find(hipsycl::stdpar::par_host_fallback, first, last, value);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::find{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), value);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if(hipsycl::stdpar::par,
+                                         ForwardIt first, ForwardIt last,
+                                         UnaryPredicate p) {
+
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
 
-  auto offloader = [&](auto &queue) {
-    ForwardIt2 d_last = d_first;
-    std::advance(d_last, std::distance(first, last));
-    hipsycl::algorithms::replace_copy_if(queue, first, last, d_first, p,
-                                         new_value);
-    return d_last;
+    auto *output = output_scratch_group.template obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::find_if(queue, first, last, output, p);
+    queue.wait();
+    auto result = first;
+    std::advance(result, *output);
+    return result;
   };
 
-  auto fallback = [&]() {
-    return std::replace_copy_if(hipsycl::stdpar::par_host_fallback, first,
-                                last, d_first, p, new_value);
+  auto fallback = [&](){
+    return std::find_if(hipsycl::stdpar::par_host_fallback, first, last, p);
   };
 
-  HIPSYCL_STDPAR_OFFLOAD(
-      hipsycl::stdpar::algorithm(
-                             hipsycl::stdpar::algorithm_category::replace_copy_if{},
-                             hipsycl::stdpar::par{}),
-      std::distance(first, last), ForwardIt2, offloader, fallback, first,
-      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, p, new_value);
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::find_if{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
 }
 
-/*
-template <class ForwardIt, class T>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find(const hipsycl::stdpar::par, ForwardIt first,
-                                         ForwardIt last, const T &value);
-
 template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if(const hipsycl::stdpar::par,
-                                            ForwardIt first, ForwardIt last,
-                                            UnaryPredicate p);
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if_not(hipsycl::stdpar::par,
+                                         ForwardIt first, ForwardIt last,
+                                         UnaryPredicate p) {
 
-template <class ForwardIt, class UnaryPredicate>
-HIPSYCL_STDPAR_ENTRYPOINT ForwardIt find_if_not(const hipsycl::stdpar::par,
-                                                ForwardIt first, ForwardIt last,
-                                                UnaryPredicate q); */
+  auto offloader = [&](auto& queue){
+
+    if(std::distance(first, last) == 0)
+      return last;
+
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+
+    auto *output = output_scratch_group.template obtain<
+        typename std::iterator_traits<ForwardIt>::difference_type>(1);
+    hipsycl::algorithms::find_if_not(queue, first, last, output, p);
+    queue.wait();
+    auto result = first;
+    std::advance(result, *output);
+    return result;
+  };
+
+  auto fallback = [&](){
+    return std::find_if_not(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(hipsycl::stdpar::algorithm_category::find_if_not{},
+                                 hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
 
 
 template<class ForwardIt, class UnaryPredicate>
@@ -904,10 +1531,10 @@ bool all_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    auto *output = output_scratch_group.template obtain<
+        hipsycl::algorithms::detail::early_exit_flag_t>(1);
     hipsycl::algorithms::all_of(queue, first, last, output, p);
     queue.wait();
     return static_cast<bool>(*output);
@@ -937,10 +1564,10 @@ bool any_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    auto *output = output_scratch_group.template obtain<
+        hipsycl::algorithms::detail::early_exit_flag_t>(1);
     hipsycl::algorithms::any_of(queue, first, last, output, p);
     queue.wait();
     return static_cast<bool>(*output);
@@ -970,10 +1597,10 @@ bool none_of(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
 
-    auto *output = output_scratch_group
-                      .obtain<hipsycl::algorithms::detail::early_exit_flag_t>(1);
+    auto *output = output_scratch_group.template obtain<
+        hipsycl::algorithms::detail::early_exit_flag_t>(1);
     hipsycl::algorithms::none_of(queue, first, last, output, p);
     queue.wait();
     return static_cast<bool>(*output);
@@ -994,7 +1621,14 @@ template <class RandomIt>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
                                         RandomIt last) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last);
+    // Subsequent users of the cached scratch memory are ordered after us
+    // by the thread-local in-order queue, so the scratch group may expire
+    // before the sort has completed.
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::sort(queue, sort_scratch_group, first, last);
   };
 
   auto fallback = [&](){
@@ -1013,7 +1647,14 @@ template <class RandomIt, class Compare>
 HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
                                     RandomIt last, Compare comp) {
   auto offloader = [&](auto& queue) {
-    hipsycl::algorithms::sort(queue, first, last, comp);
+    // Subsequent users of the cached scratch memory are ordered after us
+    // by the thread-local in-order queue, so the scratch group may expire
+    // before the sort has completed.
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::sort(queue, sort_scratch_group, first, last, comp);
   };
 
   auto fallback = [&]() {
@@ -1027,6 +1668,365 @@ HIPSYCL_STDPAR_ENTRYPOINT void sort(hipsycl::stdpar::par, RandomIt first,
       std::distance(first, last), offloader, fallback, first,
       HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
 }
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par,
+    RandomIt first, RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::stable_sort(queue, sort_scratch_group, first, last);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_host_fallback, first, last);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void stable_sort(hipsycl::stdpar::par,
+    RandomIt first, RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::stable_sort(queue, sort_scratch_group, first, last, comp);
+  };
+
+  auto fallback = [&]() {
+    std::stable_sort(hipsycl::stdpar::par_host_fallback, first, last, comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_sort{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void partial_sort(hipsycl::stdpar::par,
+    RandomIt first, RandomIt middle,
+    RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::partial_sort(queue, sort_scratch_group, first, middle,
+                                      last);
+  };
+
+  auto fallback = [&]() {
+    std::partial_sort(hipsycl::stdpar::par_host_fallback, first, middle, last);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::partial_sort{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(middle),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void partial_sort(hipsycl::stdpar::par,
+    RandomIt first, RandomIt middle,
+    RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::partial_sort(queue, sort_scratch_group, first, middle,
+                                      last, comp);
+  };
+
+  auto fallback = [&]() {
+    std::partial_sort(hipsycl::stdpar::par_host_fallback, first, middle, last, comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::partial_sort{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(middle),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class RandomIt>
+HIPSYCL_STDPAR_ENTRYPOINT void nth_element(hipsycl::stdpar::par,
+    RandomIt first, RandomIt nth,
+    RandomIt last) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::nth_element(queue, sort_scratch_group, first, nth,
+                                     last);
+  };
+
+  auto fallback = [&]() {
+    std::nth_element(hipsycl::stdpar::par_host_fallback, first, nth, last);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::nth_element{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(nth),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class RandomIt, class Compare>
+HIPSYCL_STDPAR_ENTRYPOINT void nth_element(hipsycl::stdpar::par,
+    RandomIt first, RandomIt nth,
+    RandomIt last, Compare comp) {
+  auto offloader = [&](auto& queue) {
+    auto sort_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::nth_element(queue, sort_scratch_group, first, nth,
+                                     last, comp);
+  };
+
+  auto fallback = [&]() {
+    std::nth_element(hipsycl::stdpar::par_host_fallback, first, nth, last, comp);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD_NORET(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::nth_element{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(nth),
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), comp);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt partition(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+    UnaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_true =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::partition(queue, device_scratch_group, first, last, p,
+                                   num_true);
+    // We need the number of elements satisfying p to construct the result
+    queue.wait();
+
+    std::advance(result, *num_true);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::partition(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::partition{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class BidirIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+BidirIt stable_partition(hipsycl::stdpar::par, BidirIt first, BidirIt last,
+    UnaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    BidirIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_true =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::stable_partition(queue, device_scratch_group, first,
+                                          last, p, num_true);
+    // We need the number of elements satisfying p to construct the result
+    queue.wait();
+
+    std::advance(result, *num_true);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::stable_partition(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::stable_partition{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), BidirIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class ForwardIt, class UnaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt remove_if(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+    UnaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_remaining =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::remove_if(queue, device_scratch_group, first, last, p,
+                                   num_remaining);
+    // We need the number of remaining elements to construct the result
+    queue.wait();
+
+    std::advance(result, *num_remaining);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::remove_if(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::remove_if{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
+
+template <class ForwardIt>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt unique(hipsycl::stdpar::par, ForwardIt first, ForwardIt last) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_remaining =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::unique(queue, device_scratch_group, first, last,
+                                std::equal_to<>{}, num_remaining);
+    // We need the number of remaining elements to construct the result
+    queue.wait();
+
+    std::advance(result, *num_remaining);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::unique(hipsycl::stdpar::par_host_fallback, first, last);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::unique{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last));
+}
+
+template <class ForwardIt, class BinaryPredicate>
+HIPSYCL_STDPAR_ENTRYPOINT
+ForwardIt unique(hipsycl::stdpar::par, ForwardIt first, ForwardIt last,
+    BinaryPredicate p) {
+  auto offloader = [&](auto& queue) {
+    ForwardIt result = first;
+    if(first == last)
+      return result;
+    // The scratch groups can expire at the end of the scope, since we
+    // synchronize before.
+    auto output_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::host>(queue);
+    auto device_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+
+    std::size_t* num_remaining =
+        output_scratch_group.template obtain<std::size_t>(1);
+    hipsycl::algorithms::unique(queue, device_scratch_group, first, last, p,
+                                num_remaining);
+    // We need the number of remaining elements to construct the result
+    queue.wait();
+
+    std::advance(result, *num_remaining);
+    return result;
+  };
+
+  auto fallback = [&]() {
+    return std::unique(hipsycl::stdpar::par_host_fallback, first, last, p);
+  };
+
+  HIPSYCL_STDPAR_BLOCKING_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::unique{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), p);
+}
 }
 
 #endif
@@ -0,0 +1,100 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_PSTL_ASYNC_HPP
+#define HIPSYCL_PSTL_ASYNC_HPP
+
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../detail/sycl_glue.hpp"
+#include "../detail/stdpar_builtins.hpp"
+
+namespace hipsycl::stdpar {
+
+/// Handle to the stdpar algorithms launched within a call to async().
+class async_handle {
+public:
+  /// Constructs a handle that does not refer to any work.
+  async_handle() = default;
+
+  async_handle(std::vector<sycl::event> events, std::thread::id owner)
+      : _events{std::move(events)}, _owner{owner} {}
+
+  /// Waits until the algorithms of the async() call have completed.
+  /// When invoked from the thread that called async(), this also waits
+  /// for all stdpar algorithms that the thread has launched since.
+  void wait() {
+    if(_owner == std::this_thread::get_id())
+      detail::stdpar_tls_runtime::get().synchronize();
+    else
+      sycl::event::wait(_events);
+  }
+
+  bool is_complete() const {
+    for(const auto& evt : _events)
+      if(evt.get_info<sycl::info::event::command_execution_status>() !=
+         sycl::info::event_command_status::complete)
+        return false;
+    return true;
+  }
+private:
+  std::vector<sycl::event> _events;
+  std::thread::id _owner;
+};
+
+namespace detail {
+
+class deferred_synchronization_scope {
+public:
+  deferred_synchronization_scope(stdpar_tls_runtime& rt)
+  : _rt{rt} {
+    _rt.push_deferred_synchronization();
+  }
+
+  ~deferred_synchronization_scope() {
+    _rt.pop_deferred_synchronization();
+  }
+
+  deferred_synchronization_scope(const deferred_synchronization_scope &) =
+      delete;
+  deferred_synchronization_scope &
+  operator=(const deferred_synchronization_scope &) = delete;
+private:
+  stdpar_tls_runtime& _rt;
+};
+
+}
+
+/// Invokes f(), and returns without waiting for the offloaded stdpar
+/// algorithms that f launched to complete. This allows the calling thread
+/// to overlap host work with their execution, also across function
+/// boundaries.
+///
+/// The calling thread must not access memory used by these algorithms
+/// until the returned handle has been waited on. The runtime still
+/// synchronizes automatically before algorithms that are executed on
+/// the host or return results that depend on the device, and before
+/// memory is freed by the calling thread.
+template<class F>
+async_handle async(F&& f) {
+  auto& rt = detail::stdpar_tls_runtime::get();
+  {
+    detail::deferred_synchronization_scope scope{rt};
+    f();
+  }
+  return async_handle{rt.get_queue().get_wait_list(),
+                      std::this_thread::get_id()};
+}
+
+}
+
+#endif
@@ -33,33 +33,16 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                     T init) {
   
   auto offloader = [&](auto& queue) {
-    // Note: Using a scratch allocation_group that expires at the end of the scope
-    // is safe because
-    // a) We synchronize before the end, so the allocation_group also lives until
-    // the kernels are complete;
-    // b) We have one allocation cache per thread-local in-order queue. So, subsequent operations
-    // fed from the same cache would wait for us anyway due to using the same in-order queue.
-    // These conditions ensure that no other operations can get access to the 
-    // cached scratch memory while we are using it.
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                            last1, first2, output, init);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
-    if(first1 == last1)
-      return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::distributed_reduce(
+        queue, first1, std::distance(first1, last1), init, std::plus<T>{},
+        [&](auto &slice_queue, auto &scratch_group, std::size_t begin,
+            std::size_t count, T *output, T slice_init) {
+          auto slice_first = std::next(first1, begin);
+          hipsycl::algorithms::transform_reduce(
+              slice_queue, scratch_group, slice_first,
+              std::next(slice_first, count), std::next(first2, begin), output,
+              slice_init);
+        });
   };
 
   auto fallback = [&]() {
@@ -86,26 +69,16 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                     BinaryReductionOp reduce,
                     BinaryTransformOp transform ) {
   auto offloader = [&](auto& queue){
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
-                                          last1, first2, output, init, reduce,
-                                          transform);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
-    if(first1 == last1)
-      return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::distributed_reduce(
+        queue, first1, std::distance(first1, last1), init, reduce,
+        [&](auto &slice_queue, auto &scratch_group, std::size_t begin,
+            std::size_t count, T *output, T slice_init) {
+          auto slice_first = std::next(first1, begin);
+          hipsycl::algorithms::transform_reduce(
+              slice_queue, scratch_group, slice_first,
+              std::next(slice_first, count), std::next(first2, begin), output,
+              slice_init, reduce, transform);
+        });
   };
 
   auto fallback = [&]() {
@@ -133,25 +106,16 @@ T transform_reduce(hipsycl::stdpar::par_unseq,
                     UnaryTransformOp transform ) {
 
   auto offloader = [&](auto& queue) {
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first, last,
-                                          output, init, reduce, transform);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
-    if(first == last)
-      return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::distributed_reduce(
+        queue, first, std::distance(first, last), init, reduce,
+        [&](auto &slice_queue, auto &scratch_group, std::size_t begin,
+            std::size_t count, T *output, T slice_init) {
+          auto slice_first = std::next(first, begin);
+          hipsycl::algorithms::transform_reduce(
+              slice_queue, scratch_group, slice_first,
+              std::next(slice_first, count), output, slice_init, reduce,
+              transform);
+        });
   };
 
   auto fallback = [&]() {
@@ -176,26 +140,16 @@ reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
   using result_type = typename std::iterator_traits<ForwardIt>::value_type;
 
   auto offloader = [&](auto &queue) {
-
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-
-    result_type *output = output_scratch_group.obtain<result_type>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
-                                output);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-
-    if (first == last)
-      return result_type{};
-    else
-      return *output;
+    return hipsycl::stdpar::detail::distributed_reduce(
+        queue, first, std::distance(first, last), result_type{},
+        std::plus<result_type>{},
+        [&](auto &slice_queue, auto &scratch_group, std::size_t begin,
+            std::size_t count, result_type *output, result_type slice_init) {
+          auto slice_first = std::next(first, begin);
+          hipsycl::algorithms::reduce(slice_queue, scratch_group, slice_first,
+                                      std::next(slice_first, count), output,
+                                      slice_init);
+        });
   };
 
   auto fallback = [&](){
@@ -215,27 +169,15 @@ T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
          ForwardIt last, T init) {
 
   auto offloader = [&](auto& queue){
-      
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
-                                output, init);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
-    if(first == last)
-      return init;
-    else
-      return *output;
-
+    return hipsycl::stdpar::detail::distributed_reduce(
+        queue, first, std::distance(first, last), init, std::plus<T>{},
+        [&](auto &slice_queue, auto &scratch_group, std::size_t begin,
+            std::size_t count, T *output, T slice_init) {
+          auto slice_first = std::next(first, begin);
+          hipsycl::algorithms::reduce(slice_queue, scratch_group, slice_first,
+                                      std::next(slice_first, count), output,
+                                      slice_init);
+        });
   };
 
   auto fallback = [&]() {
@@ -256,26 +198,15 @@ T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
          ForwardIt last, T init, BinaryOp binary_op) {
 
   auto offloader = [&](auto& queue){
-      
-    auto output_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
-    auto reduction_scratch_group =
-        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
-            .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
-    
-    T* output = output_scratch_group.obtain<T>(1);
-    hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last, output,
-                                init, binary_op);
-    // We need to wait in any case here, so cannot elide synchronization
-    queue.wait();
-    
-    if(first == last)
-      return init;
-    else
-      return *output;
+    return hipsycl::stdpar::detail::distributed_reduce(
+        queue, first, std::distance(first, last), init, binary_op,
+        [&](auto &slice_queue, auto &scratch_group, std::size_t begin,
+            std::size_t count, T *output, T slice_init) {
+          auto slice_first = std::next(first, begin);
+          hipsycl::algorithms::reduce(slice_queue, scratch_group, slice_first,
+                                      std::next(slice_first, count), output,
+                                      slice_init, binary_op);
+        });
   };
 
   auto fallback = [&]() {
@@ -290,6 +221,323 @@ T reduce(hipsycl::stdpar::par_unseq, ForwardIt first,
       HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), init, binary_op);
 }
 
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                               d_first);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::inclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, binary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                               d_first, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::inclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, T init) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, binary_op, init);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                               d_first, binary_op, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::inclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 exclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::exclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, init);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::exclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                               d_first, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::exclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 exclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init, BinaryOp binary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::exclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, init, binary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::exclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                               d_first, init, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::exclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init, binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, UnaryOp unary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::transform_inclusive_scan(queue, scan_scratch_group, first, last,
+                                                  d_first, binary_op, unary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                                         d_first, binary_op, unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform_inclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op, unary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_inclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, UnaryOp unary_op,
+    T init) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::transform_inclusive_scan(queue, scan_scratch_group, first, last,
+                                                  d_first, binary_op, unary_op, init);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_inclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                                         d_first, binary_op, unary_op, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform_inclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op, unary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T,
+          class BinaryOp, class UnaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_exclusive_scan(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init,
+    BinaryOp binary_op, UnaryOp unary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::transform_exclusive_scan(queue, scan_scratch_group, first, last,
+                                                  d_first, init, binary_op, unary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_exclusive_scan(hipsycl::stdpar::par_unseq_host_fallback, first, last,
+                                         d_first, init, binary_op, unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform_exclusive_scan{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init, binary_op, unary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 adjacent_difference(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first) {
+  auto offloader = [&](auto &queue) {
+    hipsycl::algorithms::adjacent_difference(queue, first, last, d_first);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::adjacent_difference(hipsycl::stdpar::par_unseq_host_fallback, first,
+                                    last, d_first);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::adjacent_difference{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 adjacent_difference(
+    hipsycl::stdpar::par_unseq, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp op) {
+  auto offloader = [&](auto &queue) {
+    hipsycl::algorithms::adjacent_difference(queue, first, last, d_first, op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::adjacent_difference(hipsycl::stdpar::par_unseq_host_fallback, first,
+                                    last, d_first, op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::adjacent_difference{},
+          hipsycl::stdpar::par_unseq{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, op);
+}
+
 
 //////////////////// par policy /////////////////////////////////////
 
@@ -313,13 +561,13 @@ T transform_reduce(hipsycl::stdpar::par,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
     auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
+                hipsycl::algorithms::util::allocation_type::device>(queue);
     
-    T* output = output_scratch_group.obtain<T>(1);
+    T* output = output_scratch_group.template obtain<T>(1);
     hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
                                             last1, first2, output, init);
     // We need to wait in any case here, so cannot elide synchronization
@@ -358,13 +606,13 @@ T transform_reduce(hipsycl::stdpar::par,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
     auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
+                hipsycl::algorithms::util::allocation_type::device>(queue);
     
-    T* output = output_scratch_group.obtain<T>(1);
+    T* output = output_scratch_group.template obtain<T>(1);
     hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first1,
                                           last1, first2, output, init, reduce,
                                           transform);
@@ -405,13 +653,13 @@ T transform_reduce(hipsycl::stdpar::par,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
     auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
+                hipsycl::algorithms::util::allocation_type::device>(queue);
     
-    T* output = output_scratch_group.obtain<T>(1);
+    T* output = output_scratch_group.template obtain<T>(1);
     hipsycl::algorithms::transform_reduce(queue, reduction_scratch_group, first, last,
                                           output, init, reduce, transform);
     // We need to wait in any case here, so cannot elide synchronization
@@ -449,13 +697,13 @@ reduce(hipsycl::stdpar::par, ForwardIt first,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
     auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
+                hipsycl::algorithms::util::allocation_type::device>(queue);
 
-    result_type *output = output_scratch_group.obtain<result_type>(1);
+    result_type *output = output_scratch_group.template obtain<result_type>(1);
     hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
                                 output);
     // We need to wait in any case here, so cannot elide synchronization
@@ -488,13 +736,13 @@ T reduce(hipsycl::stdpar::par, ForwardIt first,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
     auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
+                hipsycl::algorithms::util::allocation_type::device>(queue);
     
-    T* output = output_scratch_group.obtain<T>(1);
+    T* output = output_scratch_group.template obtain<T>(1);
     hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last,
                                 output, init);
     // We need to wait in any case here, so cannot elide synchronization
@@ -529,13 +777,13 @@ T reduce(hipsycl::stdpar::par, ForwardIt first,
     auto output_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::host>();
+                hipsycl::algorithms::util::allocation_type::host>(queue);
     auto reduction_scratch_group =
         hipsycl::stdpar::detail::stdpar_tls_runtime::get()
             .make_scratch_group<
-                hipsycl::algorithms::util::allocation_type::device>();
+                hipsycl::algorithms::util::allocation_type::device>(queue);
     
-    T* output = output_scratch_group.obtain<T>(1);
+    T* output = output_scratch_group.template obtain<T>(1);
     hipsycl::algorithms::reduce(queue, reduction_scratch_group, first, last, output,
                                 init, binary_op);
     // We need to wait in any case here, so cannot elide synchronization
@@ -559,6 +807,323 @@ T reduce(hipsycl::stdpar::par, ForwardIt first,
       HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), init, binary_op);
 }
 
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                               d_first);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::inclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, binary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                               d_first, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::inclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 inclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, T init) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::inclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, binary_op, init);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::inclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                               d_first, binary_op, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::inclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 exclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::exclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, init);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::exclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                               d_first, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::exclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 exclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init, BinaryOp binary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::exclusive_scan(queue, scan_scratch_group, first, last,
+                                        d_first, init, binary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::exclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                               d_first, init, binary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::exclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init, binary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_inclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, UnaryOp unary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::transform_inclusive_scan(queue, scan_scratch_group, first, last,
+                                                  d_first, binary_op, unary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_inclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                                         d_first, binary_op, unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform_inclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op, unary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp,
+          class UnaryOp, class T>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_inclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp binary_op, UnaryOp unary_op,
+    T init) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::transform_inclusive_scan(queue, scan_scratch_group, first, last,
+                                                  d_first, binary_op, unary_op, init);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_inclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                                         d_first, binary_op, unary_op, init);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform_inclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, binary_op, unary_op, init);
+}
+
+template <class ForwardIt1, class ForwardIt2, class T,
+          class BinaryOp, class UnaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 transform_exclusive_scan(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, T init,
+    BinaryOp binary_op, UnaryOp unary_op) {
+  auto offloader = [&](auto &queue) {
+    // The scratch group can expire at the end of the scope even though we do
+    // not synchronize: We have one allocation cache per thread-local in-order
+    // queue, so subsequent users of the cached scratch memory are ordered
+    // after us.
+    auto scan_scratch_group =
+        hipsycl::stdpar::detail::stdpar_tls_runtime::get()
+            .make_scratch_group<
+                hipsycl::algorithms::util::allocation_type::device>(queue);
+    hipsycl::algorithms::transform_exclusive_scan(queue, scan_scratch_group, first, last,
+                                                  d_first, init, binary_op, unary_op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::transform_exclusive_scan(hipsycl::stdpar::par_host_fallback, first, last,
+                                         d_first, init, binary_op, unary_op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::transform_exclusive_scan{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, init, binary_op, unary_op);
+}
+
+template <class ForwardIt1, class ForwardIt2>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 adjacent_difference(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first) {
+  auto offloader = [&](auto &queue) {
+    hipsycl::algorithms::adjacent_difference(queue, first, last, d_first);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::adjacent_difference(hipsycl::stdpar::par_host_fallback, first,
+                                    last, d_first);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::adjacent_difference{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first);
+}
+
+template <class ForwardIt1, class ForwardIt2, class BinaryOp>
+HIPSYCL_STDPAR_ENTRYPOINT ForwardIt2 adjacent_difference(
+    hipsycl::stdpar::par, ForwardIt1 first, ForwardIt1 last,
+    ForwardIt2 d_first, BinaryOp op) {
+  auto offloader = [&](auto &queue) {
+    hipsycl::algorithms::adjacent_difference(queue, first, last, d_first, op);
+    ForwardIt2 d_last = d_first;
+    std::advance(d_last, std::distance(first, last));
+    return d_last;
+  };
+
+  auto fallback = [&]() {
+    return std::adjacent_difference(hipsycl::stdpar::par_host_fallback, first,
+                                    last, d_first, op);
+  };
+
+  HIPSYCL_STDPAR_OFFLOAD(
+      hipsycl::stdpar::algorithm(
+          hipsycl::stdpar::algorithm_category::adjacent_difference{},
+          hipsycl::stdpar::par{}),
+      std::distance(first, last), ForwardIt2, offloader, fallback, first,
+      HIPSYCL_STDPAR_NO_PTR_VALIDATION(last), d_first, op);
+}
+
 
 
 }
@@ -13,5 +13,6 @@
 
 #include "algorithm.hpp"
 #include "numeric.hpp"
+#include "async.hpp"
 
 #endif
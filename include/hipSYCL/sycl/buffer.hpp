@@ -128,6 +128,22 @@ private:
   sycl::range<Dim> _page_size;
 };
 
+/// Divides the buffer into pages of at least min_page_bytes, see
+/// ACPP_EXT_BUFFER_PAGE_SIZE. Ignored if AdaptiveCpp_page_size is set.
+class AdaptiveCpp_adaptive_page_size : public detail::buffer_property
+{
+public:
+  AdaptiveCpp_adaptive_page_size(std::size_t min_page_bytes)
+  : _min_page_bytes{min_page_bytes} {}
+
+  std::size_t get_min_page_bytes() const
+  {
+    return _min_page_bytes;
+  }
+private:
+  std::size_t _min_page_bytes;
+};
+
 class AdaptiveCpp_write_back_node_group : public detail::buffer_property
 {
 public:
@@ -522,10 +538,8 @@ public:
     init_policies_from_properties_or_default(dpol);
 
     if(!_impl->use_external_storage) {
-      // Construct buffer
-      this->init(bufferRange);
-      // Only use hostData for initialization
-      copy_host_content(hostData);
+      // Construct buffer, only using hostData for initialization
+      this->init_from_host_content(bufferRange, hostData);
     } else {
       HIPSYCL_DEBUG_WARNING
           << "buffer: constructed with property use_external_storage, but user "
@@ -704,8 +718,7 @@ public:
           << std::endl;
          this->init(bufferRange, const_cast<T*>(std::data(container)));
       } else {
-        this->init(bufferRange);
-        copy_host_content(std::data(container));
+        this->init_from_host_content(bufferRange, std::data(container));
       }
     } else {
       this->init(bufferRange, std::data(container));
@@ -1135,6 +1148,50 @@ private:
                                     rt::embed_in_range3(get_range()));
   }
 
+  // In host buffer aliasing mode, buffers that would only copy their initial
+  // content can use the host data directly if the OpenMP host device
+  // is the only device.
+  bool can_alias_host_content(const T* data)
+  {
+    if (!rt::application::get_settings()
+             .get<rt::setting::host_buffer_aliasing>())
+      return false;
+    // Respect explicit requests for copy semantics
+    if(this->has_property<detail::buffer_policy::use_external_storage>())
+      return false;
+
+    rt::runtime* rt = _impl->requires_runtime.get();
+    rt::device_id host_device = detail::get_host_device();
+
+    bool has_only_host_device = true;
+    rt->backends().for_each_backend([&](rt::backend* b){
+      if (b->get_unique_backend_id() != host_device.get_backend() &&
+          b->get_hardware_manager()->get_num_devices() > 0)
+        has_only_host_device = false;
+    });
+    if(!has_only_host_device)
+      return false;
+
+    return rt->backends()
+        .get(host_device.get_backend())
+        ->get_allocator(host_device)
+        ->can_alias_host_memory(data, alignof(T));
+  }
+
+  void init_from_host_content(const range<dimensions>& range, const T* data)
+  {
+    if(range.size() > 0 && can_alias_host_content(data)) {
+      HIPSYCL_DEBUG_INFO << "buffer: Aliasing host data @" << data
+                         << " instead of copying it" << std::endl;
+      // The host data is registered as current host allocation,
+      // so no copy operations are ever required for host access.
+      this->init(range, const_cast<std::remove_const_t<T>*>(data));
+    } else {
+      this->init(range);
+      copy_host_content(data);
+    }
+  }
+
   void init_policies_from_properties_or_default(default_policies dpol)
   {
     _impl->destructor_waits = get_policy_from_property_or_default<
@@ -1174,11 +1231,19 @@ private:
   {
     this->_range = range;
 
-    rt::range<3> page_size = rt::embed_in_range3(range);
+    rt::range<3> page_size;
     if (this->has_property<property::buffer::AdaptiveCpp_page_size<dimensions>>()) {
       page_size = rt::embed_in_range3(
           this->get_property<property::buffer::AdaptiveCpp_page_size<dimensions>>()
               .get_page_size());
+    } else {
+      std::size_t min_page_bytes = 0;
+      if (this->has_property<property::buffer::AdaptiveCpp_adaptive_page_size>())
+        min_page_bytes =
+            this->get_property<property::buffer::AdaptiveCpp_adaptive_page_size>()
+                .get_min_page_bytes();
+      page_size = rt::get_adaptive_page_size(rt::embed_in_range3(range),
+                                             sizeof(T), min_page_bytes);
     }
 
     _impl->data = std::make_shared<rt::buffer_data_region>(
@@ -1192,6 +1257,22 @@ private:
     rt::runtime* rt = _impl->requires_runtime.get();
 
     if(!_impl->data->has_allocation(host_device)){
+      const std::size_t num_bytes =
+          _impl->data->get_num_elements().size() * sizeof(T);
+      if(rt::backend_allocator* unified_allocator =
+             get_unified_memory_device_allocator()) {
+        // Unified memory devices can then use the host buffer directly,
+        // instead of allocating device memory and copying.
+        host_ptr = unified_allocator->allocate_optimized_host(alignof(T),
+                                                              num_bytes);
+        if(host_ptr) {
+          _impl->data->add_empty_allocation(host_device, host_ptr,
+                                            unified_allocator,
+                                            true /*takes_ownership*/);
+          return;
+        }
+      }
+
       if(this->has_property<property::buffer::use_optimized_host_memory>()){
         // TODO: Actually may need to use non-host backend here...
         host_ptr =
@@ -1219,6 +1300,34 @@ private:
     }
   }
 
+  // With ACPP_RT_UNIFIED_MEMORY_ZERO_COPY, returns the allocator of the
+  // first device that shares physical memory with the host, or nullptr.
+  rt::backend_allocator* get_unified_memory_device_allocator()
+  {
+    static const bool is_enabled =
+        rt::application::get_settings()
+            .get<rt::setting::unified_memory_zero_copy>();
+    if(!is_enabled)
+      return nullptr;
+
+    rt::runtime* rt = _impl->requires_runtime.get();
+    rt::device_id host_device = detail::get_host_device();
+
+    rt::backend_allocator* result = nullptr;
+    rt->backends().for_each_backend([&](rt::backend* b){
+      if(result || b->get_unique_backend_id() == host_device.get_backend())
+        return;
+      rt::backend_hardware_manager* hw = b->get_hardware_manager();
+      for(std::size_t i = 0; i < hw->get_num_devices() && !result; ++i) {
+        if(hw->get_device(i)->has(
+               rt::device_support_aspect::host_unified_memory))
+          result = b->get_allocator(
+              rt::device_id{b->get_backend_descriptor(), static_cast<int>(i)});
+      }
+    });
+    return result;
+  }
+
   void init(const range<dimensions>& range)
   {
     if(range.size() > 0) {
@@ -0,0 +1,213 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_COROUTINE_HPP
+#define HIPSYCL_COROUTINE_HPP
+
+#include "extensions.hpp"
+
+#ifdef ACPP_EXT_COROUTINES
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "event.hpp"
+#include "queue.hpp"
+
+namespace hipsycl {
+namespace sycl {
+namespace coroutine {
+
+/// Resumes coroutines directly on the thread that observes the completion
+/// of the awaited events, which is usually a runtime thread. Awaiting
+/// coroutines should therefore only perform short amounts of work before
+/// suspending again.
+class inline_executor {
+public:
+  void post(std::coroutine_handle<> h) const {
+    h.resume();
+  }
+};
+
+/// Event loop that resumes coroutines on the thread(s) that invoke run() or
+/// poll(). This allows a single thread to drive many concurrent pipelines
+/// of device work, without any of them blocking the thread.
+class run_loop {
+public:
+  run_loop() = default;
+  run_loop(const run_loop&) = delete;
+  run_loop& operator=(const run_loop&) = delete;
+
+  /// Schedules \c h for resumption by run() or poll(). Thread-safe.
+  void post(std::coroutine_handle<> h) {
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _ready.push_back(h);
+      if(_num_suspended > 0)
+        --_num_suspended;
+    }
+    _condition.notify_one();
+  }
+
+  /// Invoked by awaitables before a coroutine suspends to wait for
+  /// events, such that run() does not return while the coroutine can
+  /// still be resumed.
+  void work_started() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    ++_num_suspended;
+  }
+
+  /// Resumes coroutines as their events complete, until no coroutine
+  /// is suspended on this loop anymore.
+  /// \return The number of resumed coroutines
+  std::size_t run() {
+    std::size_t num_resumed = 0;
+    while(auto h = pop(true)) {
+      h.resume();
+      ++num_resumed;
+    }
+    return num_resumed;
+  }
+
+  /// Resumes the coroutines whose events have completed, without blocking.
+  /// \return The number of resumed coroutines
+  std::size_t poll() {
+    std::size_t num_resumed = 0;
+    while(auto h = pop(false)) {
+      h.resume();
+      ++num_resumed;
+    }
+    return num_resumed;
+  }
+
+  /// \return The number of coroutines that are suspended on this loop
+  /// and whose events have not yet completed.
+  std::size_t get_num_suspended() const {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _num_suspended;
+  }
+private:
+  std::coroutine_handle<> pop(bool block) {
+    std::unique_lock<std::mutex> lock{_mutex};
+    if(block)
+      _condition.wait(lock,
+                      [this]() { return !_ready.empty() || _num_suspended == 0; });
+    if(_ready.empty())
+      return std::coroutine_handle<>{};
+    auto h = _ready.front();
+    _ready.pop_front();
+    return h;
+  }
+
+  mutable std::mutex _mutex;
+  std::condition_variable _condition;
+  std::deque<std::coroutine_handle<>> _ready;
+  std::size_t _num_suspended = 0;
+};
+
+/// Awaitable that resumes the awaiting coroutine through \c Executor once
+/// all events have completed. Completion is observed by the runtime, see
+/// event::AdaptiveCpp_on_completion(), so no thread blocks while waiting.
+template<class Executor>
+class event_awaitable {
+public:
+  event_awaitable(std::vector<event> events, Executor &exec)
+  : _events{std::move(events)}, _exec{&exec} {}
+
+  bool await_ready() const noexcept {
+    for(const auto& evt : _events)
+      if(evt.get_info<info::event::command_execution_status>() !=
+         info::event_command_status::complete)
+        return false;
+    return true;
+  }
+
+  void await_suspend(std::coroutine_handle<> h) {
+    // The coroutine, and with it this awaitable, might be resumed and
+    // destroyed before this function returns, so no members may be
+    // accessed after registering the first callback.
+    std::vector<event> events = std::move(_events);
+    Executor* exec = _exec;
+
+    if constexpr(requires { exec->work_started(); })
+      exec->work_started();
+
+    if(events.empty()) {
+      exec->post(h);
+      return;
+    }
+
+    auto num_remaining =
+        std::make_shared<std::atomic<std::size_t>>(events.size());
+    for(const auto& evt : events) {
+      evt.AdaptiveCpp_on_completion([num_remaining, exec, h]() {
+        if(num_remaining->fetch_sub(1, std::memory_order_acq_rel) == 1)
+          exec->post(h);
+      });
+    }
+  }
+
+  void await_resume() const noexcept {}
+private:
+  std::vector<event> _events;
+  Executor* _exec;
+};
+
+/// Waits for the completion of \c evt, and resumes through \c exec
+template<class Executor>
+event_awaitable<Executor> async_wait(const event& evt, Executor& exec) {
+  return event_awaitable<Executor>{std::vector<event>{evt}, exec};
+}
+
+/// Waits for the completion of all \c events, and resumes through \c exec
+template<class Executor>
+event_awaitable<Executor> async_wait(std::vector<event> events,
+                                     Executor& exec) {
+  return event_awaitable<Executor>{std::move(events), exec};
+}
+
+/// Waits for the completion of all operations submitted to \c q so far,
+/// and resumes through \c exec
+template<class Executor>
+event_awaitable<Executor> async_wait(queue& q, Executor& exec) {
+  return event_awaitable<Executor>{q.get_wait_list(), exec};
+}
+
+namespace detail {
+
+inline inline_executor& get_inline_executor() {
+  static inline_executor exec;
+  return exec;
+}
+
+}
+
+} // coroutine
+
+/// Allows co_await on events; the coroutine is resumed on the thread that
+/// observes the completion of the event.
+inline coroutine::event_awaitable<coroutine::inline_executor>
+operator co_await(const event& evt) {
+  return coroutine::async_wait(evt, coroutine::detail::get_inline_executor());
+}
+
+}
+}
+
+#endif
+
+#endif
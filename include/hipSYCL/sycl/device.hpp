@@ -199,8 +199,20 @@ public:
   std::vector<device> create_sub_devices(info::partition_affinity_domain
                                           affinityDomain) const
   {
-    throw exception{make_error_code(errc::feature_not_supported),
-                    "subdevices are unsupported."};
+    // Sub-devices are currently only backed by NUMA nodes
+    std::vector<std::size_t> sub_devices = get_rt_sub_devices();
+    if ((affinityDomain != info::partition_affinity_domain::numa &&
+         affinityDomain != info::partition_affinity_domain::next_partitionable) ||
+        sub_devices.empty())
+      throw exception{make_error_code(errc::feature_not_supported),
+                      "Device cannot be partitioned by this affinity domain."};
+
+    std::vector<device> result;
+    for (std::size_t index : sub_devices)
+      result.push_back(device{
+          rt::device_id{_device_id.get_full_backend_descriptor(),
+                        static_cast<int>(index)}});
+    return result;
   }
 
   static std::vector<device>
@@ -290,6 +302,22 @@ private:
     }
     return ptr;
   }
+
+  rt::backend_hardware_manager *get_rt_hardware_manager() const {
+    return _requires_runtime.get()
+        ->backends()
+        .get(_device_id.get_backend())
+        ->get_hardware_manager();
+  }
+
+  std::vector<std::size_t> get_rt_sub_devices() const {
+    return get_rt_hardware_manager()->get_sub_devices(_device_id.get_id());
+  }
+
+  bool is_sub_device() const {
+    return get_rt_hardware_manager()->get_parent_device(_device_id.get_id()) !=
+           static_cast<std::size_t>(_device_id.get_id());
+  }
 };
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, device_type) {
@@ -725,8 +753,13 @@ HIPSYCL_SPECIALIZE_GET_INFO(device, preferred_interop_user_sync)
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, parent_device)
 {
-  throw exception{make_error_code(errc::invalid),
-                  "Device is not a subdevice"};
+  if (!is_sub_device())
+    throw exception{make_error_code(errc::invalid),
+                    "Device is not a subdevice"};
+  std::size_t parent =
+      get_rt_hardware_manager()->get_parent_device(_device_id.get_id());
+  return device{rt::device_id{_device_id.get_full_backend_descriptor(),
+                              static_cast<int>(parent)}};
 }
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, partition_max_sub_devices) {
@@ -735,20 +768,39 @@ HIPSYCL_SPECIALIZE_GET_INFO(device, partition_max_sub_devices) {
 }
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, partition_properties)
-{ return std::vector<info::partition_property>{}; }
+{
+  if (get_rt_sub_devices().empty())
+    return std::vector<info::partition_property>{};
+  return std::vector<info::partition_property>{
+    info::partition_property::partition_by_affinity_domain
+  };
+}
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, partition_affinity_domains)
 {
+  if (get_rt_sub_devices().empty())
+    return std::vector<info::partition_affinity_domain>{
+      info::partition_affinity_domain::not_applicable
+    };
   return std::vector<info::partition_affinity_domain>{
-    info::partition_affinity_domain::not_applicable
+    info::partition_affinity_domain::numa,
+    info::partition_affinity_domain::next_partitionable
   };
 }
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, partition_type_property)
-{ return info::partition_property::no_partition; }
+{
+  if (is_sub_device())
+    return info::partition_property::partition_by_affinity_domain;
+  return info::partition_property::no_partition;
+}
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, partition_type_affinity_domain)
-{ return info::partition_affinity_domain::not_applicable; }
+{
+  if (is_sub_device())
+    return info::partition_affinity_domain::numa;
+  return info::partition_affinity_domain::not_applicable;
+}
 
 
 HIPSYCL_SPECIALIZE_GET_INFO(device, reference_count)
@@ -0,0 +1,166 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SYCL_DEVICE_HEAP_HPP
+#define HIPSYCL_SYCL_DEVICE_HEAP_HPP
+
+#include <cstddef>
+
+#include "exception.hpp"
+#include "queue.hpp"
+#include "usm.hpp"
+#include "libkernel/backend.hpp"
+#include "libkernel/sub_group.hpp"
+#include "libkernel/sscp/builtins/device_heap_generic.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+#include "libkernel/sscp/builtins/device_heap.hpp"
+#endif
+
+namespace hipsycl {
+namespace sycl {
+
+/// Device-side view of an AdaptiveCpp_device_heap. Can be captured by
+/// kernels.
+class AdaptiveCpp_device_heap_view {
+public:
+  AdaptiveCpp_device_heap_view() = default;
+  AdaptiveCpp_device_heap_view(__acpp_sscp_device_heap *heap)
+      : _heap{heap} {}
+
+  /// Allocates size bytes, aligned to 16 bytes. Returns nullptr if the heap
+  /// is exhausted.
+  ACPP_KERNEL_TARGET
+  void *malloc(std::size_t size) const noexcept {
+    void *ptr = nullptr;
+    __acpp_backend_switch(
+        ptr = generic_malloc(size),
+        ptr = __acpp_sscp_device_heap_malloc(_heap, size),
+        ptr = generic_malloc(size),
+        ptr = generic_malloc(size));
+    return ptr;
+  }
+
+  /// Like malloc(size), but the work items of the sub-group that invoke it
+  /// together obtain new memory from the heap with a single atomic
+  /// operation. Sizes may differ between work items.
+  ACPP_KERNEL_TARGET
+  void *malloc(const sub_group &sg, std::size_t size) const noexcept {
+    void *ptr = nullptr;
+    __acpp_backend_switch(
+        ptr = generic_malloc(size),
+        ptr = __acpp_sscp_sub_group_device_heap_malloc(_heap, size),
+        ptr = generic_malloc(size),
+        ptr = generic_malloc(size));
+    return ptr;
+  }
+
+  /// Returns memory obtained from malloc() of the same heap. ptr may be
+  /// nullptr. Memory may be freed by another work item or kernel than the
+  /// one that allocated it.
+  ACPP_KERNEL_TARGET
+  void free(void *ptr) const noexcept {
+    __acpp_backend_switch(
+        generic_free(ptr),
+        __acpp_sscp_device_heap_free(_heap, ptr),
+        generic_free(ptr),
+        generic_free(ptr));
+  }
+
+private:
+  ACPP_KERNEL_TARGET
+  void *generic_malloc(std::size_t size) const noexcept {
+    return __acpp_sscp_device_heap_generic_malloc<
+        __acpp_sscp_device_heap_clang_atomics>(
+        _heap, size, [](__acpp_uint64 *ptr, __acpp_uint64 x) {
+          return __acpp_sscp_device_heap_clang_atomics::fetch_add(ptr, x);
+        });
+  }
+
+  ACPP_KERNEL_TARGET
+  void generic_free(void *ptr) const noexcept {
+    __acpp_sscp_device_heap_generic_free<
+        __acpp_sscp_device_heap_clang_atomics>(_heap, ptr);
+  }
+
+  __acpp_sscp_device_heap *_heap = nullptr;
+};
+
+/// A heap in device memory of the device of a queue, from which kernels
+/// can allocate memory dynamically, see ACPP_EXT_DEVICE_HEAP.
+class AdaptiveCpp_device_heap {
+public:
+  /// Allocates a heap of size bytes on the device of q. If size is 0, the
+  /// size given by ACPP_RT_DEVICE_HEAP_SIZE is used.
+  AdaptiveCpp_device_heap(const queue &q, std::size_t size = 0)
+      : _q{q}, _size{size} {
+    if(_size == 0)
+      _size = rt::application::get_settings()
+                  .get<rt::setting::device_heap_size>() *
+              1024 * 1024;
+    if(_size <= __acpp_sscp_device_heap_get_first_block_offset() ||
+       _size > (std::size_t{1} << __acpp_sscp_device_heap_offset_bits))
+      throw exception{make_error_code(errc::invalid),
+                      "device_heap: Invalid heap size"};
+
+    _heap = static_cast<__acpp_sscp_device_heap *>(
+        malloc_device(_size, _q));
+    if(!_heap)
+      throw exception{make_error_code(errc::memory_allocation),
+                      "device_heap: Could not allocate heap"};
+    reset();
+  }
+
+  ~AdaptiveCpp_device_heap() {
+    if(_heap)
+      sycl::free(_heap, _q);
+  }
+
+  AdaptiveCpp_device_heap(const AdaptiveCpp_device_heap &) = delete;
+  AdaptiveCpp_device_heap &operator=(const AdaptiveCpp_device_heap &) = delete;
+
+  /// Frees all allocations. Blocks until the heap has been reset; kernels
+  /// using the heap must have completed.
+  void reset() {
+    __acpp_sscp_device_heap header{};
+    header.capacity = _size;
+    header.bump_offset = __acpp_sscp_device_heap_get_first_block_offset();
+    _q.memcpy(_heap, &header, sizeof(header)).wait();
+  }
+
+  /// Returns the number of bytes of the heap that have been handed out to
+  /// size classes so far, including freed blocks available for reuse.
+  /// Blocks until kernels that have been submitted to the queue of the
+  /// heap have completed.
+  std::size_t get_used_size() {
+    __acpp_sscp_device_heap header;
+    _q.wait();
+    _q.memcpy(&header, _heap, sizeof(header)).wait();
+    return header.bump_offset < _size ? header.bump_offset : _size;
+  }
+
+  std::size_t get_size() const { return _size; }
+
+  AdaptiveCpp_device_heap_view get_view() const {
+    return AdaptiveCpp_device_heap_view{_heap};
+  }
+
+private:
+  queue _q;
+  std::size_t _size;
+  __acpp_sscp_device_heap *_heap = nullptr;
+};
+
+}
+}
+
+#endif
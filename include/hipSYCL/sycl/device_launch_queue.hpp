@@ -0,0 +1,228 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SYCL_DEVICE_LAUNCH_QUEUE_HPP
+#define HIPSYCL_SYCL_DEVICE_LAUNCH_QUEUE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "device.hpp"
+#include "event.hpp"
+#include "exception.hpp"
+#include "handler.hpp"
+#include "info/device.hpp"
+#include "queue.hpp"
+#include "usm.hpp"
+#include "libkernel/atomic_ref.hpp"
+#include "libkernel/backend.hpp"
+#include "libkernel/id.hpp"
+#include "libkernel/memory.hpp"
+#include "libkernel/nd_item.hpp"
+#include "libkernel/nd_range.hpp"
+
+namespace hipsycl {
+namespace sycl {
+
+/// A launch that has been requested by a kernel, see
+/// ACPP_EXT_DEVICE_LAUNCH_QUEUE.
+template <class Args>
+struct AdaptiveCpp_device_launch {
+  std::size_t global_size;
+  Args args;
+};
+
+/// Device-side view of an AdaptiveCpp_device_launch_queue. Can be captured
+/// by kernels.
+template <class Args>
+class AdaptiveCpp_device_launch_queue_view {
+public:
+  AdaptiveCpp_device_launch_queue_view() = default;
+  AdaptiveCpp_device_launch_queue_view(AdaptiveCpp_device_launch<Args> *launches,
+                                       unsigned *num_launches,
+                                       std::size_t capacity)
+      : _launches{launches}, _num_launches{num_launches}, _capacity{capacity} {}
+
+  /// Requests a launch of global_size work items with the given arguments.
+  /// Returns false if the launch queue is full, in which case the launch
+  /// is dropped.
+  ACPP_KERNEL_TARGET
+  bool enqueue(std::size_t global_size, const Args &args) const noexcept {
+    if(global_size == 0)
+      return true;
+    atomic_ref<unsigned, memory_order::relaxed, memory_scope::device,
+               access::address_space::global_space>
+        counter{*_num_launches};
+    // Once the queue is full, the counter keeps growing such that overflows
+    // can be detected on the host.
+    unsigned index = counter.fetch_add(1u);
+    if(index >= _capacity)
+      return false;
+    _launches[index].global_size = global_size;
+    _launches[index].args = args;
+    return true;
+  }
+
+  ACPP_KERNEL_TARGET
+  std::size_t get_capacity() const noexcept { return _capacity; }
+
+private:
+  AdaptiveCpp_device_launch<Args> *_launches = nullptr;
+  unsigned *_num_launches = nullptr;
+  std::size_t _capacity = 0;
+};
+
+/// A queue in device memory into which kernels write launch descriptors.
+/// The launches are executed by a dispatch kernel without transferring the
+/// descriptors to the host, see ACPP_EXT_DEVICE_LAUNCH_QUEUE.
+template <class Args>
+class AdaptiveCpp_device_launch_queue {
+  static_assert(std::is_trivially_copyable_v<Args>,
+                "device_launch_queue: Launch arguments must be trivially "
+                "copyable");
+public:
+  /// Allocates space for capacity launch descriptors on the device of q.
+  AdaptiveCpp_device_launch_queue(const queue &q, std::size_t capacity)
+      : _q{q}, _capacity{capacity} {
+    if (_capacity == 0 ||
+        _capacity >= std::numeric_limits<unsigned>::max() / 2)
+      throw exception{make_error_code(errc::invalid),
+                      "device_launch_queue: Invalid capacity"};
+
+    _launches = malloc_device<AdaptiveCpp_device_launch<Args>>(_capacity, _q);
+    _num_launches = malloc_device<unsigned>(1, _q);
+    if(!_launches || !_num_launches) {
+      release();
+      throw exception{make_error_code(errc::memory_allocation),
+                      "device_launch_queue: Could not allocate launch queue"};
+    }
+    _q.memset(_num_launches, 0, sizeof(unsigned)).wait();
+  }
+
+  ~AdaptiveCpp_device_launch_queue() { release(); }
+
+  AdaptiveCpp_device_launch_queue(const AdaptiveCpp_device_launch_queue &) =
+      delete;
+  AdaptiveCpp_device_launch_queue &
+  operator=(const AdaptiveCpp_device_launch_queue &) = delete;
+
+  AdaptiveCpp_device_launch_queue_view<Args> get_view() const {
+    return AdaptiveCpp_device_launch_queue_view<Args>{_launches, _num_launches,
+                                                      _capacity};
+  }
+
+  /// Submits a kernel that invokes k(id<1>, const Args&) for each work item
+  /// of each launch in the queue, and afterwards empties the queue. The
+  /// dispatch is ordered after deps, and after previously submitted kernels
+  /// if the queue is in-order. The returned event completes when the
+  /// queue has been emptied.
+  ///
+  /// The dispatch kernel is persistent: it is launched with num_groups
+  /// work groups of group_size work items, independent of the number of
+  /// requested work items, which are distributed evenly across all work
+  /// items of the dispatch kernel. If num_groups is 0, a number of groups
+  /// is used that fills the device.
+  template <class Kernel>
+  event dispatch(const std::vector<event> &deps, Kernel k,
+                 std::size_t group_size = 128, std::size_t num_groups = 0) {
+    if(group_size == 0)
+      throw exception{make_error_code(errc::invalid),
+                      "device_launch_queue: Invalid group size"};
+    if(num_groups == 0)
+      num_groups = get_default_num_groups(group_size);
+
+    const std::size_t num_work_items = num_groups * group_size;
+    AdaptiveCpp_device_launch<Args> *launches = _launches;
+    unsigned *num_launches = _num_launches;
+    std::size_t capacity = _capacity;
+
+    event kernel_evt = _q.submit([&](handler &cgh) {
+      cgh.depends_on(deps);
+      cgh.parallel_for(nd_range<1>{num_work_items, group_size},
+                       [=](nd_item<1> idx) {
+        std::size_t gid = idx.get_global_linear_id();
+        std::size_t count = *num_launches;
+        if(count > capacity)
+          count = capacity;
+
+        // Work items are assigned to the concatenation of all launches,
+        // such that small launches do not all end up in the first group.
+        std::size_t base = 0;
+        for(std::size_t l = 0; l < count; ++l) {
+          const std::size_t global_size = launches[l].global_size;
+          std::size_t first = (gid + num_work_items - base % num_work_items) %
+                              num_work_items;
+          for(std::size_t i = first; i < global_size; i += num_work_items)
+            k(id<1>{i}, launches[l].args);
+          base += global_size;
+        }
+      });
+    });
+
+    return _q.submit([&](handler &cgh) {
+      cgh.depends_on(kernel_evt);
+      cgh.memset(num_launches, 0, sizeof(unsigned));
+    });
+  }
+
+  template <class Kernel>
+  event dispatch(Kernel k, std::size_t group_size = 128,
+                 std::size_t num_groups = 0) {
+    return dispatch(std::vector<event>{}, k, group_size, num_groups);
+  }
+
+  /// Returns the number of launches that have been requested since the
+  /// last dispatch, including launches that were dropped because the queue
+  /// was full. Blocks until kernels that have been submitted to the queue
+  /// of the launch queue have completed.
+  std::size_t get_num_requested_launches() {
+    unsigned count = 0;
+    _q.wait();
+    _q.memcpy(&count, _num_launches, sizeof(unsigned)).wait();
+    return count;
+  }
+
+  std::size_t get_capacity() const { return _capacity; }
+
+private:
+  std::size_t get_default_num_groups(std::size_t group_size) const {
+    device dev = _q.get_device();
+    std::size_t num_compute_units =
+        dev.get_info<info::device::max_compute_units>();
+    // The host backend already executes groups in chunks per thread
+    if(dev.is_cpu())
+      return num_compute_units > 0 ? num_compute_units : 1;
+    // Enough groups per compute unit to hide latencies
+    std::size_t groups_per_cu = std::max(std::size_t{1}, 2048 / group_size);
+    return std::max(std::size_t{1}, num_compute_units * groups_per_cu);
+  }
+
+  void release() {
+    if(_launches)
+      sycl::free(_launches, _q);
+    if(_num_launches)
+      sycl::free(_num_launches, _q);
+    _launches = nullptr;
+    _num_launches = nullptr;
+  }
+
+  queue _q;
+  std::size_t _capacity;
+  AdaptiveCpp_device_launch<Args> *_launches = nullptr;
+  unsigned *_num_launches = nullptr;
+};
+
+}
+}
+
+#endif
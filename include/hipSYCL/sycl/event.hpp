@@ -23,10 +23,19 @@
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/instrumentation.hpp"
 #include <cstddef>
+#include <functional>
+#include <optional>
 
 namespace hipsycl {
 namespace sycl {
 
+enum class AdaptiveCpp_hardware_counter {
+  achieved_occupancy,
+  dram_read_bytes,
+  dram_write_bytes,
+  l2_hit_rate
+};
+
 class event {
   friend class handler;
 public:
@@ -67,6 +76,24 @@ public:
     }
   }
 
+  /// Invokes \c f once the event has completed, without waiting for the
+  /// completion. If the event has already completed, \c f is invoked
+  /// immediately on the calling thread, otherwise it is invoked on a
+  /// runtime thread once the backend signals completion.
+  /// \c f must not block or throw.
+  void AdaptiveCpp_on_completion(std::function<void()> f) const
+  {
+    if(!_node || _node->is_complete()) {
+      f();
+      return;
+    }
+    rt::runtime* rt = _requires_runtime.get();
+    // Completion can only be signalled by the backend for submitted nodes
+    if(!_node->is_submitted())
+      rt->dag().flush_sync();
+    rt->completions().notify_on_completion(_node, std::move(f));
+  }
+
   static void wait(const vector_class<event> &eventList)
   {
     rt::runtime_keep_alive_token requires_runtime;
@@ -199,6 +226,47 @@ public:
     }
   }
 
+  /// Returns the value of a hardware counter collected for the kernel of
+  /// this event, or an empty optional if it is not available, e.g. because
+  /// the backend does not support collecting it. Requires that the command
+  /// group was submitted with the AdaptiveCpp_hardware_counters property.
+  std::optional<double>
+  AdaptiveCpp_get_hardware_counter(AdaptiveCpp_hardware_counter c) const {
+    if(!_node)
+      return {};
+    // See get_profiling_info()
+    if(!this->_node->is_submitted())
+      _requires_runtime.get()->dag().flush_sync();
+
+    if (!_node->get_execution_hints()
+             .has_hint<rt::hints::request_instrumentation_hardware_counters>() ||
+        _node->get_operation()->is_requirement())
+      return {};
+
+    auto counters = _node->get_operation()
+                        ->get_instrumentations()
+                        .get<rt::instrumentations::hardware_counters>();
+    if(!counters)
+      return {};
+
+    rt::hardware_counter rt_counter = rt::hardware_counter::achieved_occupancy;
+    switch(c) {
+    case AdaptiveCpp_hardware_counter::achieved_occupancy:
+      rt_counter = rt::hardware_counter::achieved_occupancy;
+      break;
+    case AdaptiveCpp_hardware_counter::dram_read_bytes:
+      rt_counter = rt::hardware_counter::dram_read_bytes;
+      break;
+    case AdaptiveCpp_hardware_counter::dram_write_bytes:
+      rt_counter = rt::hardware_counter::dram_write_bytes;
+      break;
+    case AdaptiveCpp_hardware_counter::l2_hit_rate:
+      rt_counter = rt::hardware_counter::l2_hit_rate;
+      break;
+    }
+    return counters->get_value(rt_counter);
+  }
+
   friend bool operator ==(const event& lhs, const event& rhs)
   { return lhs._node == rhs._node; }
 
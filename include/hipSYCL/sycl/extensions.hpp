@@ -56,6 +56,10 @@
 #define ACPP_EXT_CG_PROPERTY_RETARGET
 #define ACPP_EXT_CG_PROPERTY_PREFER_GROUP_SIZE
 #define ACPP_EXT_CG_PROPERTY_PREFER_EXECUTION_LANE
+#define ACPP_EXT_CG_PROPERTY_GRAPH_CAPTURE
+#define ACPP_EXT_CG_PROPERTY_COOPERATIVE_LAUNCH
+#define ACPP_EXT_CG_PROPERTY_HARDWARE_COUNTERS
+#define ACPP_EXT_CG_PROPERTY_DYNAMIC_SCHEDULE
 #define ACPP_EXT_BUFFER_USM_INTEROP
 #define ACPP_EXT_PREFETCH_HOST
 #define ACPP_EXT_SYNCHRONOUS_MEM_ADVISE
@@ -68,11 +72,27 @@
 #endif
 
 #define ACPP_EXT_UPDATE_DEVICE
+#define ACPP_EXT_BUFFER_PREFETCH
 #define ACPP_EXT_QUEUE_WAIT_LIST
 #define ACPP_EXT_MULTI_DEVICE_QUEUE
 #define ACPP_EXT_COARSE_GRAINED_EVENTS
 #define ACPP_EXT_QUEUE_PRIORITY
+#define ACPP_EXT_QUEUE_COMPUTE_UNIT_PARTITION
 #define ACPP_EXT_SPECIALIZED
 #define ACPP_EXT_DYNAMIC_FUNCTIONS
+#define ACPP_EXT_JIT_FAST_MATH
+#define ACPP_EXT_JOINT_MATRIX
+#define ACPP_EXT_WORK_SPLITTER
+#define ACPP_EXT_SUBMISSION_BATCH
+#define ACPP_EXT_EVENT_COMPLETION_CALLBACK
+#define ACPP_EXT_MPI_INTEROP
+#define ACPP_EXT_STRUCT_OF_ARRAYS
+#define ACPP_EXT_DEVICE_HEAP
+#define ACPP_EXT_DEVICE_LAUNCH_QUEUE
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L &&       \
+    __has_include(<coroutine>)
+ #define ACPP_EXT_COROUTINES
+#endif
 
 #endif
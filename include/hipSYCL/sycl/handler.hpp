@@ -11,6 +11,8 @@
 #ifndef HIPSYCL_HANDLER_HPP
 #define HIPSYCL_HANDLER_HPP
 
+#include <algorithm>
+#include <cstdio>
 #include <memory>
 #include <type_traits>
 #include <unordered_map>
@@ -20,6 +22,7 @@
 #include "context.hpp"
 #include "device.hpp"
 #include "event.hpp"
+#include "kernel_handler.hpp"
 #include "libkernel/sscp/builtins/print.hpp"
 #include "types.hpp"
 #include "usm_query.hpp"
@@ -33,6 +36,7 @@
 #include "libkernel/item.hpp"
 #include "libkernel/nd_item.hpp"
 #include "libkernel/group.hpp"
+#include "libkernel/stream.hpp"
 #include "libkernel/detail/local_memory_allocator.hpp"
 #include "detail/util.hpp"
 
@@ -87,6 +91,31 @@ template <int Dim> struct accessor_data {
   bool is_no_init;
 };
 
+// Host-side owner of the buffer of a sycl::stream
+struct stream_buffer {
+  void *allocation;
+  std::size_t size;
+  rt::backend_allocator *allocator;
+
+  void write_to_stdout() const {
+    const auto *header = static_cast<const stream_buffer_header *>(allocation);
+    std::size_t output_size =
+        std::min(static_cast<std::size_t>(header->write_offset), size);
+    if(output_size < header->write_offset) {
+      HIPSYCL_DEBUG_WARNING << "stream: Output exceeded the buffer size of "
+                            << size << " bytes and was truncated" << std::endl;
+    }
+    std::fwrite(static_cast<const char *>(allocation) +
+                    sizeof(stream_buffer_header),
+                1, output_size, stdout);
+    std::fflush(stdout);
+  }
+
+  void release() const {
+    allocator->free(allocation);
+  }
+};
+
 
 } // namespace detail
 
@@ -94,6 +123,8 @@ class queue;
 
 class handler {
   friend class queue;
+  friend void *detail::allocate_stream_buffer(sycl::handler &cgh,
+                                              std::size_t buffer_size);
 
   template <class AccessorType, int Dim>
   friend void
@@ -133,6 +164,15 @@ class handler {
       mode, AccessorType::access_target
     );
 
+    // Multiple accessors to the same data with identical access mode
+    // and range share one requirement, so that the runtime does not need to
+    // analyze, allocate and update the same data once per accessor.
+    if (rt::buffer_memory_requirement *existing_req =
+            find_equivalent_buffer_requirement(*req)) {
+      existing_req->bind_additional(accessor_id);
+      return;
+    }
+
     // Bind the accessor's embedded pointer to the requirement, such that
     // the scheduler is able to initialize the accessor's data pointer
     // once it has been captured
@@ -141,6 +181,21 @@ class handler {
     _requirements.add_requirement(std::move(req));
   }
 
+  rt::buffer_memory_requirement *find_equivalent_buffer_requirement(
+      const rt::buffer_memory_requirement &req) {
+    for (rt::dag_node_ptr node : _requirements.get()) {
+      rt::operation *op = node->get_operation();
+      if (op->is_requirement() &&
+          rt::cast<rt::requirement>(op)->is_memory_requirement() &&
+          rt::cast<rt::memory_requirement>(op)->is_buffer_requirement()) {
+        auto *bmem_req = rt::cast<rt::buffer_memory_requirement>(op);
+        if (bmem_req->is_bound() && bmem_req->is_equivalent_to(req))
+          return bmem_req;
+      }
+    }
+    return nullptr;
+  }
+
   template <typename dataT, int dimensions, access_mode accessMode,
             access::target accessTarget, access::placeholder isPlaceholder>
   static constexpr std::size_t get_dimensions(
@@ -175,7 +230,7 @@ class handler {
             rt::buffer_memory_requirement *bmem_req =
                 rt::cast<rt::buffer_memory_requirement>(req->get_operation());
             if (bmem_req->is_bound()) {
-              if (bmem_req->get_bound_accessor_id() == acc.get_uid())
+              if (bmem_req->is_bound_to(acc.get_uid()))
                 return bmem_req;
             }
           }
@@ -240,6 +295,8 @@ class handler {
 public:
   ~handler()
   {
+    if(!_stream_buffers.empty())
+      flush_streams();
   }
 
   template <typename dataT, int dimensions, access_mode accessMode,
@@ -299,6 +356,23 @@ public:
     }
   }
 
+  template <auto &SpecName>
+  void set_specialization_constant(
+      typename std::remove_reference_t<decltype(SpecName)>::value_type value) {
+    if (!_specialization_constants.set(
+            detail::get_specialization_constant_key<SpecName>(), value))
+      throw exception{make_error_code(errc::feature_not_supported),
+                      "handler: Too many specialization constants in command "
+                      "group"};
+  }
+
+  template <auto &SpecName>
+  typename std::remove_reference_t<decltype(SpecName)>::value_type
+  get_specialization_constant() {
+    return kernel_handler{_specialization_constants}
+        .get_specialization_constant<SpecName>();
+  }
+
 
   template <typename KernelName = __acpp_unnamed_kernel, typename KernelType>
   void single_task(KernelType kernelFunc)
@@ -535,6 +609,37 @@ public:
         acc);
   }
 
+  /// Asynchronously migrates the given range of the buffer to the device,
+  /// such that subsequent kernels on the device find the data in place.
+  /// Other allocations of the buffer remain valid.
+  template <typename T, int dim, typename AllocatorT>
+  void AdaptiveCpp_prefetch(const buffer<T, dim, AllocatorT> &buff,
+                            const device &dev, sycl::range<dim> range,
+                            sycl::id<dim> offset = {}) {
+    prefetch_buffer(detail::extract_rt_device(dev), buff, range, offset,
+                    true);
+  }
+
+  template <typename T, int dim, typename AllocatorT>
+  void AdaptiveCpp_prefetch(const buffer<T, dim, AllocatorT> &buff,
+                            const device &dev) {
+    prefetch_buffer(detail::extract_rt_device(dev), buff, buff.get_range(),
+                    sycl::id<dim>{}, false);
+  }
+
+  /// Prefetches to the device of the queue
+  template <typename T, int dim, typename AllocatorT>
+  void AdaptiveCpp_prefetch(const buffer<T, dim, AllocatorT> &buff,
+                            sycl::range<dim> range, sycl::id<dim> offset = {}) {
+    prefetch_buffer(get_prefetch_target(), buff, range, offset, true);
+  }
+
+  template <typename T, int dim, typename AllocatorT>
+  void AdaptiveCpp_prefetch(const buffer<T, dim, AllocatorT> &buff) {
+    prefetch_buffer(get_prefetch_target(), buff, buff.get_range(),
+                    sycl::id<dim>{}, false);
+  }
+
   /// \todo fill() on host accessors can be optimized to use
   /// memset() if the accessor describes a large area of
   /// contiguous memory
@@ -746,6 +851,47 @@ public:
   }
 
 private:
+  rt::device_id get_prefetch_target() const {
+    if(!_execution_hints.has_hint<rt::hints::bind_to_device>())
+      throw exception{make_error_code(errc::invalid),
+                      "handler: buffer prefetch without target device is "
+                      "unsupported for queues not bound to devices"};
+    return _execution_hints.get_hint<rt::hints::bind_to_device>()
+        ->get_device_id();
+  }
+
+  template <typename T, int dim, typename AllocatorT>
+  void prefetch_buffer(rt::device_id dev,
+                       const buffer<T, dim, AllocatorT> &buff,
+                       sycl::range<dim> range, sycl::id<dim> offset,
+                       bool has_access_range) {
+    HIPSYCL_DEBUG_INFO << "handler: Spawning async buffer prefetch task"
+                       << std::endl;
+
+    std::shared_ptr<rt::buffer_data_region> data =
+        detail::extract_buffer_data_region(buff);
+    const rt::range<dim> buffer_shape = rt::make_range(buff.get_range());
+
+    // A read access makes the data valid on the target device without
+    // invalidating the other allocations. The resulting data transfers
+    // are scheduled on the memcpy lanes of the device.
+    auto explicit_requirement = rt::make_operation<rt::buffer_memory_requirement>(
+      data,
+      detail::get_effective_offset<T>(data, rt::make_id(offset),
+                                      buffer_shape, has_access_range),
+      detail::get_effective_range<T>(data, rt::make_range(range),
+                                     buffer_shape, has_access_range),
+      access_mode::read, target::device
+    );
+
+    rt::execution_hints hints = _execution_hints;
+    hints.set_hint(rt::hints::bind_to_device{dev});
+
+    rt::dag_node_ptr node = create_task(std::move(explicit_requirement), hints);
+
+    _command_group_nodes.push_back(node);
+  }
+
   template <typename T, int dim, access::mode mode, access::target tgt,
             accessor_variant variant>
   rt::device_id get_explicit_accessor_target(
@@ -974,15 +1120,41 @@ private:
     }
   }
 
+  template <rt::kernel_type KernelType, class KernelFuncType, int Dim>
+  static constexpr bool accepts_kernel_handler() {
+    if constexpr (KernelType == rt::kernel_type::single_task)
+      return std::is_invocable_v<KernelFuncType, kernel_handler>;
+    else if constexpr (KernelType == rt::kernel_type::basic_parallel_for)
+      return std::is_invocable_v<KernelFuncType, sycl::item<Dim>,
+                                 kernel_handler>;
+    else if constexpr (KernelType == rt::kernel_type::ndrange_parallel_for)
+      return std::is_invocable_v<KernelFuncType, sycl::nd_item<Dim>,
+                                 kernel_handler>;
+    else if constexpr (KernelType ==
+                       rt::kernel_type::hierarchical_parallel_for)
+      return std::is_invocable_v<KernelFuncType, sycl::group<Dim>,
+                                 kernel_handler>;
+    else
+      return false;
+  }
+
   // Plain kernel submission without reductions
   template <class KernelName, rt::kernel_type KernelType, class KernelFuncType,
             int Dim>
   void submit_kernel(sycl::id<Dim> offset, sycl::range<Dim> global_range,
                      sycl::range<Dim> local_range, KernelFuncType f) {
-
     std::size_t local_mem_size = _local_mem_allocator.get_allocation_size();
-    rt::dag_node_ptr node = submit_kernel_impl<KernelName, KernelType>(
-        offset, global_range, local_range, f, local_mem_size, _requirements);
+    rt::dag_node_ptr node;
+    if constexpr (accepts_kernel_handler<KernelType, KernelFuncType, Dim>()) {
+      kernel_handler kh{_specialization_constants};
+      auto wrapped_f = [f, kh](auto... args) { f(args..., kh); };
+      node = submit_kernel_impl<KernelName, KernelType>(
+          offset, global_range, local_range, wrapped_f, local_mem_size,
+          _requirements);
+    } else {
+      node = submit_kernel_impl<KernelName, KernelType>(
+          offset, global_range, local_range, f, local_mem_size, _requirements);
+    }
     _command_group_nodes.push_back(node);
   }
 
@@ -1203,7 +1375,7 @@ private:
 #endif
     } else {
 
-      rt::dag_node_ptr node = std::make_shared<rt::dag_node>(
+      rt::dag_node_ptr node = rt::make_dag_node(
           hints, requirements.get(), std::move(op), _rt);
       node->assign_to_device(
           hints.get_hint<rt::hints::bind_to_device>()->get_device_id());
@@ -1223,6 +1395,49 @@ private:
     return create_task(std::move(op), hints, _requirements);
   }
 
+  void* allocate_stream_buffer(std::size_t buffer_size) {
+    if(!_execution_hints.has_hint<rt::hints::bind_to_device>())
+      throw exception{make_error_code(errc::invalid),
+                      "handler: streams are unsupported for queues not bound "
+                      "to devices"};
+    rt::device_id dev =
+        _execution_hints.get_hint<rt::hints::bind_to_device>()->get_device_id();
+    rt::backend_allocator *allocator =
+        detail::select_usm_allocator(_ctx, device{dev});
+
+    void *buffer = allocator->allocate_usm(buffer_size);
+    if(!buffer)
+      throw exception{make_error_code(errc::memory_allocation),
+                      "handler: Could not allocate stream buffer"};
+    static_cast<detail::stream_buffer_header *>(buffer)->write_offset = 0;
+
+    _stream_buffers.push_back(detail::stream_buffer{
+        buffer, buffer_size - sizeof(detail::stream_buffer_header), allocator});
+    return buffer;
+  }
+
+  // Writes the output of streams once the command group has completed,
+  // without waiting for it.
+  void flush_streams() noexcept {
+    std::vector<detail::stream_buffer> buffers = std::move(_stream_buffers);
+    _stream_buffers.clear();
+
+    if(_command_group_nodes.empty()) {
+      // Nothing was submitted, e.g. because the command group threw
+      for(const auto& b : buffers)
+        b.release();
+      return;
+    }
+
+    event{_command_group_nodes.front(), _handler}.AdaptiveCpp_on_completion(
+        [buffers]() {
+          for(const auto& b : buffers) {
+            b.write_to_stdout();
+            b.release();
+          }
+        });
+  }
+
   const context _ctx;
   detail::local_memory_allocator _local_mem_allocator;
   async_handler _handler;
@@ -1242,8 +1457,21 @@ private:
   algorithms::util::allocation_cache* _allocation_cache;
 
   std::weak_ptr<rt::dag_node>* _most_recent_reduction_kernel;
+
+  std::vector<detail::stream_buffer> _stream_buffers;
+
+  detail::specialization_constant_storage _specialization_constants;
 };
 
+namespace detail {
+
+inline void *allocate_stream_buffer(sycl::handler &cgh,
+                                    std::size_t buffer_size) {
+  return cgh.allocate_stream_buffer(buffer_size);
+}
+
+}
+
 namespace detail::handler {
 
 template<class T>
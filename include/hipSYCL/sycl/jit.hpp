@@ -253,7 +253,7 @@ private:
       common::stable_running_hash hash;
       hash(entry.first.data(), entry.first.size());
       for(const auto& s : entry.second)
-        hash(entry.second.data(), entry.second.size());
+        hash(s.data(), s.size());
       _config.unique_hash ^= hash.get_current_hash();
     }
   }
@@ -277,4 +277,29 @@ private:
 
 #endif // IS_DEVICE_PASS_SSCP
 
+namespace hipsycl::sycl::jit {
+
+namespace detail {
+
+template <class T>
+struct __acpp_sscp_emit_param_type_annotation_fast_math {
+  T value;
+};
+
+} // namespace detail
+
+/// Returns a kernel that invokes k, and that the SSCP JIT compiler
+/// compiles with fast math optimizations enabled, regardless of the
+/// fast math setting of the rest of the application.
+/// Has no effect for other compilation flows.
+template<class Kernel>
+auto fast_math(Kernel k) {
+  detail::__acpp_sscp_emit_param_type_annotation_fast_math<char> prop{1};
+  return [prop, k](auto&&... args){
+    k(decltype(args)(args)...);
+  };
+}
+
+}
+
 #endif
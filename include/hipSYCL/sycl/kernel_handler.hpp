@@ -0,0 +1,153 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_KERNEL_HANDLER_HPP
+#define HIPSYCL_KERNEL_HANDLER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "hipSYCL/sycl/libkernel/backend.hpp"
+#include "specialized.hpp"
+
+namespace hipsycl {
+namespace sycl {
+
+template <class T> class specialization_id;
+
+namespace detail {
+
+struct specialization_id_access {
+  template <class T>
+  ACPP_UNIVERSAL_TARGET static constexpr const T &
+  get_default_value(const specialization_id<T> &id) {
+    return id._default_value;
+  }
+};
+
+// Identifies a specialization constant in both host and device code, unlike
+// the address of its specialization_id.
+template <auto &SpecName>
+ACPP_UNIVERSAL_TARGET constexpr uint64_t get_specialization_constant_key() {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ull;
+  for(const char *c = __PRETTY_FUNCTION__; *c != '\0'; ++c) {
+    hash ^= static_cast<unsigned char>(*c);
+    hash *= 1099511628211ull;
+  }
+  // 0 marks unused entries
+  return hash == 0 ? 1 : hash;
+}
+
+// Values of the specialization constants set for a command group.
+// Kernels receive it as sycl::specialized object, such that the SSCP JIT
+// compiler replaces the values with constants.
+struct specialization_constant_storage {
+  static constexpr int max_constants = 8;
+  static constexpr int max_words_per_constant = 4;
+
+  template <class T> static constexpr bool is_storable() {
+    return std::is_trivially_copyable_v<T> &&
+           sizeof(T) <= max_words_per_constant * sizeof(uint64_t);
+  }
+
+  // \return whether there was a free slot for the value
+  template <class T> bool set(uint64_t key, const T &value) {
+    static_assert(is_storable<T>(),
+                  "Specialization constants must be trivially copyable and "
+                  "not larger than 32 bytes");
+    for(int i = 0; i < max_constants; ++i) {
+      if(keys[i] == key || keys[i] == 0) {
+        keys[i] = key;
+        std::memcpy(&words[i][0], &value, sizeof(T));
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <class T>
+  ACPP_UNIVERSAL_TARGET bool get(uint64_t key, T &value) const {
+    for(int i = 0; i < max_constants; ++i) {
+      if(keys[i] == key) {
+        // memcpy is not available in all device compilation flows
+        unsigned char *dest = reinterpret_cast<unsigned char *>(&value);
+        const unsigned char *src =
+            reinterpret_cast<const unsigned char *>(&words[i][0]);
+        for(std::size_t j = 0; j < sizeof(T); ++j)
+          dest[j] = src[j];
+        return true;
+      }
+    }
+    return false;
+  }
+
+  uint64_t keys[max_constants] = {};
+  uint64_t words[max_constants][max_words_per_constant] = {};
+};
+
+}
+
+/// Identifies a SYCL 2020 specialization constant, and provides its default
+/// value. Must be declared constexpr at namespace scope, or as static
+/// constexpr member.
+template <class T> class specialization_id {
+  friend struct detail::specialization_id_access;
+public:
+  using value_type = T;
+
+  template <class... Args>
+  explicit constexpr specialization_id(Args &&...args)
+      : _default_value(std::forward<Args>(args)...) {}
+
+  specialization_id(const specialization_id &) = delete;
+  specialization_id(specialization_id &&) = delete;
+  specialization_id &operator=(const specialization_id &) = delete;
+  specialization_id &operator=(specialization_id &&) = delete;
+private:
+  T _default_value;
+};
+
+/// Passed to kernels that accept it as last argument, and provides access
+/// to specialization constants.
+///
+/// Specialization constants are passed to the kernel like
+/// sycl::specialized arguments, so the SSCP JIT compiler generates code
+/// for their values, e.g. with constant loop bounds.
+/// Other compilation flows read them from the kernel arguments.
+class kernel_handler {
+public:
+  template <auto &SpecName>
+  ACPP_UNIVERSAL_TARGET
+  typename std::remove_reference_t<decltype(SpecName)>::value_type
+  get_specialization_constant() const {
+    using value_type =
+        typename std::remove_reference_t<decltype(SpecName)>::value_type;
+
+    const detail::specialization_constant_storage storage = _constants;
+    value_type value =
+        detail::specialization_id_access::get_default_value(SpecName);
+    storage.get(detail::get_specialization_constant_key<SpecName>(), value);
+    return value;
+  }
+
+  // AdaptiveCpp internal
+  kernel_handler(const detail::specialization_constant_storage &constants)
+      : _constants{constants} {}
+private:
+  specialized<detail::specialization_constant_storage> _constants;
+};
+
+}
+}
+
+#endif
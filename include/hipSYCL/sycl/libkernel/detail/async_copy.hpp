@@ -0,0 +1,84 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_ASYNC_COPY_HPP
+#define HIPSYCL_ASYNC_COPY_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "hipSYCL/sycl/libkernel/backend.hpp"
+
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+#include "hipSYCL/sycl/libkernel/sscp/builtins/async_copy.hpp"
+#endif
+
+namespace hipsycl {
+namespace sycl {
+namespace detail {
+
+// Size of the pieces in which objects of type T can be copied
+// asynchronously, or 0 if T cannot be copied asynchronously.
+template<class T>
+constexpr std::size_t async_copy_chunk_size() {
+  if constexpr(!std::is_trivially_copyable_v<T>)
+    return 0;
+  for(std::size_t chunk = 16; chunk >= 4; chunk /= 2)
+    if(sizeof(T) % chunk == 0 && alignof(T) >= chunk)
+      return chunk;
+  return 0;
+}
+
+/// Starts copying num_elements elements from src with stride src_stride in
+/// global memory to dest in local memory, distributed across the
+/// local_size work items of the group.
+/// Returns true if the copy was started asynchronously; the work items then
+/// need to wait for completion using wait_for_async_copy(). Returns false
+/// if nothing was copied.
+template<class T>
+ACPP_KERNEL_TARGET
+inline bool try_async_copy_to_local(T *dest, const T *src,
+                                    std::size_t num_elements,
+                                    std::size_t src_stride,
+                                    std::size_t local_id,
+                                    std::size_t local_size) {
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+  constexpr std::size_t chunk = async_copy_chunk_size<T>();
+  if constexpr(chunk > 0) {
+    if(__acpp_sscp_is_device) {
+      for(std::size_t i = local_id; i < num_elements; i += local_size) {
+        char *d = reinterpret_cast<char *>(dest + i);
+        const char *s = reinterpret_cast<const char *>(src + i * src_stride);
+        for(std::size_t offset = 0; offset < sizeof(T); offset += chunk)
+          __acpp_sscp_async_copy_global_to_local(d + offset, s + offset,
+                                                 chunk);
+      }
+      __acpp_sscp_async_copy_commit();
+      return true;
+    }
+  }
+#endif
+  return false;
+}
+
+/// Waits for the asynchronous copies started by this work item.
+ACPP_KERNEL_TARGET
+inline void wait_for_async_copy() {
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+  if(__acpp_sscp_is_device)
+    __acpp_sscp_async_copy_wait();
+#endif
+}
+
+}
+}
+}
+
+#endif
@@ -49,6 +49,15 @@ inline void local_device_barrier(
       __syncthreads());
 }
 
+ACPP_KERNEL_TARGET
+inline void grid_device_barrier() {
+  __acpp_backend_switch(
+      assert(false && "device barrier called on CPU, this should not happen"),
+      __acpp_sscp_grid_barrier(),
+      assert(false && "grid barriers require the generic SSCP compiler"),
+      assert(false && "grid barriers require the generic SSCP compiler"));
+}
+
 }
 }
 }
@@ -19,6 +19,9 @@ using __acpp_int32 = int;
 using __acpp_uint32 = unsigned int;
 using __acpp_int64 = long long;
 using __acpp_uint64 = unsigned long long;
+#ifdef __SIZEOF_INT128__
+using __acpp_int128 = __int128;
+#endif
 
 
 #endif
@@ -12,6 +12,9 @@
 #define HIPSYCL_DEVICE_EVENT_HPP
 
 #include "hipSYCL/sycl/libkernel/backend.hpp"
+#include "hipSYCL/sycl/access.hpp"
+#include "detail/async_copy.hpp"
+#include "detail/device_barrier.hpp"
 
 namespace hipsycl {
 namespace sycl {
@@ -23,7 +26,20 @@ public:
   device_event(){}
 
   ACPP_KERNEL_TARGET
-  void wait(){}
+  explicit device_event(bool is_async_copy)
+  : _is_async_copy{is_async_copy} {}
+
+  /// Must be called by all work items of the group that started the copy.
+  ACPP_KERNEL_TARGET
+  void wait(){
+    if(_is_async_copy) {
+      detail::wait_for_async_copy();
+      // Makes the copies of all work items visible to the group
+      detail::local_device_barrier(access::fence_space::local_space);
+    }
+  }
+private:
+  bool _is_async_copy = false;
 };
 
 }
@@ -425,14 +425,7 @@ public:
   device_event async_work_group_copy(local_ptr<dataT> dest,
                                      global_ptr<dataT> src, size_t numElements) const
   {
-    // in hipSYCL, we do not need to distinguish between global and local pointers,
-    // so we can just call the async_work_group_copy() variant that has
-    // global_ptr as dest and local_ptr as source.
-    
-    global_ptr<dataT> global_dest{dest.get()};
-    local_ptr<dataT> local_src{src.get()};
-    
-    return async_work_group_copy(global_dest, local_src, numElements);
+    return async_work_group_copy(dest, src, numElements, size_t{1});
   }
 
   template <typename dataT>
@@ -460,19 +453,28 @@ public:
   device_event async_work_group_copy(local_ptr<dataT> dest,
                                      global_ptr<dataT> src, size_t numElements, size_t srcStride) const
   {
+    bool is_async = false;
     __acpp_if_target_device(
       const size_t physical_local_size = get_local_range().size();
-      
-      for(size_t i = get_local_linear_id(); i < numElements; i += physical_local_size)
-        dest[i] = src[i * srcStride];
-      detail::local_device_barrier(access::fence_space::global_and_local);
+
+      // Where the hardware supports it, the copy bypasses registers and
+      // completes in the background until the returned event is waited on.
+      is_async = detail::try_async_copy_to_local(
+          dest.get(), src.get(), numElements, srcStride,
+          get_local_linear_id(), physical_local_size);
+
+      if(!is_async) {
+        for(size_t i = get_local_linear_id(); i < numElements; i += physical_local_size)
+          dest[i] = src[i * srcStride];
+        detail::local_device_barrier(access::fence_space::global_and_local);
+      }
     );
     __acpp_if_target_host(
       for(size_t i = 0; i < numElements; ++i)
         dest[i] = src[i * srcStride];
     );
 
-    return device_event{};
+    return device_event{is_async};
   }
 
   template <typename dataT>
@@ -497,7 +499,9 @@ public:
 
   template <typename... eventTN>
   ACPP_KERNEL_TARGET
-  void wait_for(eventTN...) const {}
+  void wait_for(eventTN... events) const {
+    (events.wait(), ...);
+  }
 
 private:
 
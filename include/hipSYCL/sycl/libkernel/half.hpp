@@ -219,6 +219,70 @@ namespace detail {
   }
 }
 
+namespace detail {
+
+enum class half_arithmetic_op { add, sub, mul };
+
+template<half_arithmetic_op Op>
+ACPP_UNIVERSAL_TARGET
+inline half apply_half_arithmetic(half a, half b) noexcept {
+  if constexpr(Op == half_arithmetic_op::add)
+    return a + b;
+  else if constexpr(Op == half_arithmetic_op::sub)
+    return a - b;
+  else
+    return a * b;
+}
+
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+template<half_arithmetic_op Op>
+inline void apply_sscp_packed_half_arithmetic(half a0, half a1, half b0,
+                                              half b1, half &r0,
+                                              half &r1) noexcept {
+  auto pack = [](half lo, half hi) {
+    return static_cast<__acpp_uint32>(fp16::as_integer(get_half_storage(lo))) |
+           (static_cast<__acpp_uint32>(fp16::as_integer(get_half_storage(hi)))
+            << 16);
+  };
+  __acpp_uint32 a = pack(a0, a1);
+  __acpp_uint32 b = pack(b0, b1);
+  __acpp_uint32 r;
+  if constexpr(Op == half_arithmetic_op::add)
+    r = __acpp_sscp_half2_add(a, b);
+  else if constexpr(Op == half_arithmetic_op::sub)
+    r = __acpp_sscp_half2_sub(a, b);
+  else
+    r = __acpp_sscp_half2_mul(a, b);
+  r0 = create_half(fp16::create(static_cast<__acpp_uint16>(r & 0xffff)));
+  r1 = create_half(fp16::create(static_cast<__acpp_uint16>(r >> 16)));
+}
+#endif
+
+/// Computes result[i] = a[i] op b[i] for all i < n. With the SSCP compiler,
+/// pairs of elements are processed by packed half precision instructions
+/// on backends that provide them.
+template <half_arithmetic_op Op, class InputA, class InputB, class Output>
+ACPP_UNIVERSAL_TARGET
+inline void elementwise_half_arithmetic(const InputA &a, const InputB &b,
+                                        Output &result, int n) noexcept {
+  int i = 0;
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+  if(!__acpp_sscp_is_host) {
+    for(; i + 1 < n; i += 2) {
+      half r0, r1;
+      apply_sscp_packed_half_arithmetic<Op>(a[i], a[i + 1], b[i], b[i + 1],
+                                            r0, r1);
+      result[i] = r0;
+      result[i + 1] = r1;
+    }
+  }
+#endif
+  for(; i < n; ++i)
+    result[i] = apply_half_arithmetic<Op>(a[i], b[i]);
+}
+
+}
+
 }
 }
 
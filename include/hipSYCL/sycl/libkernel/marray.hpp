@@ -149,9 +149,26 @@ public:
     return result;                                                             \
   }
 
-  HIPSYCL_DEFINE_BINARY_MARRAY_OP_MARRAY_MARRAY(+, DataT)
-  HIPSYCL_DEFINE_BINARY_MARRAY_OP_MARRAY_MARRAY(-, DataT)
-  HIPSYCL_DEFINE_BINARY_MARRAY_OP_MARRAY_MARRAY(*, DataT)
+// Half precision marrays may use packed arithmetic
+#define HIPSYCL_DEFINE_ARITHMETIC_MARRAY_OP_MARRAY_MARRAY(op, T, half_op)      \
+  friend marray<T, NumElements> operator op(const marray &lhs,                 \
+                                            const marray &rhs) {               \
+    marray<T, NumElements> result;                                             \
+    if constexpr (std::is_same_v<T, half>) {                                   \
+      detail::elementwise_half_arithmetic<                                     \
+          detail::half_arithmetic_op::half_op>(lhs, rhs, result,               \
+                                               NumElements);                   \
+    } else {                                                                   \
+      for (int i = 0; i < NumElements; ++i) {                                  \
+        result[i] = lhs[i] op rhs[i];                                          \
+      }                                                                        \
+    }                                                                          \
+    return result;                                                             \
+  }
+
+  HIPSYCL_DEFINE_ARITHMETIC_MARRAY_OP_MARRAY_MARRAY(+, DataT, add)
+  HIPSYCL_DEFINE_ARITHMETIC_MARRAY_OP_MARRAY_MARRAY(-, DataT, sub)
+  HIPSYCL_DEFINE_ARITHMETIC_MARRAY_OP_MARRAY_MARRAY(*, DataT, mul)
   HIPSYCL_DEFINE_BINARY_MARRAY_OP_MARRAY_MARRAY(/, DataT)
   template <typename t = DataT,
             std::enable_if_t<std::is_integral_v<t>, bool> = true>
@@ -0,0 +1,221 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_MATRIX_HPP
+#define HIPSYCL_MATRIX_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "hipSYCL/sycl/libkernel/backend.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix_generic.hpp"
+#include "half.hpp"
+#include "sub_group.hpp"
+
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix.hpp"
+#endif
+
+namespace hipsycl {
+namespace sycl {
+namespace matrix {
+
+enum class use { a, b, accumulator };
+
+enum class layout { row_major, col_major, dynamic };
+
+namespace detail {
+struct joint_matrix_access;
+}
+
+/// A Rows x Cols matrix that is distributed across the work items of a
+/// sub-group. Currently, only 16x16 matrices of half a and b matrices and
+/// float accumulators are supported. The layout of a and b matrices in
+/// memory is part of their type, the layout of accumulators is passed when
+/// loading and storing them.
+template <class Group, class T, use Use, std::size_t Rows, std::size_t Cols,
+          layout Layout = layout::dynamic>
+class joint_matrix {
+  static_assert(std::is_same_v<Group, sub_group>,
+                "joint_matrix is only supported for sub-groups");
+  static_assert(Rows == __acpp_sscp_matrix_tile_extent &&
+                    Cols == __acpp_sscp_matrix_tile_extent,
+                "Only 16x16 joint matrices are supported");
+  static_assert(Use == use::accumulator
+                    ? std::is_same_v<T, float> && Layout == layout::dynamic
+                    : std::is_same_v<T, half> && Layout != layout::dynamic,
+                "Unsupported joint_matrix configuration; a and b matrices "
+                "must be of type half with static layout, accumulators of "
+                "type float with dynamic layout");
+public:
+  joint_matrix() = default;
+private:
+  friend struct detail::joint_matrix_access;
+  __acpp_uint32 _fragment[__acpp_sscp_matrix_fragment_words];
+};
+
+namespace detail {
+
+struct joint_matrix_access {
+  template <class Matrix>
+  ACPP_KERNEL_TARGET
+  static __acpp_uint32 *get(Matrix &m) noexcept {
+    return m._fragment;
+  }
+
+  template <class Matrix>
+  ACPP_KERNEL_TARGET
+  static const __acpp_uint32 *get(const Matrix &m) noexcept {
+    return m._fragment;
+  }
+};
+
+template <use Use, layout Layout>
+using half_matrix = joint_matrix<sub_group, half, Use, 16, 16, Layout>;
+
+using accumulator_matrix =
+    joint_matrix<sub_group, float, use::accumulator, 16, 16>;
+
+ACPP_KERNEL_TARGET
+constexpr __acpp_sscp_matrix_layout get_builtin_layout(layout l) noexcept {
+  return l == layout::col_major ? __acpp_sscp_matrix_layout::col_major
+                                : __acpp_sscp_matrix_layout::row_major;
+}
+
+ACPP_KERNEL_TARGET
+inline const fp16::half_storage *get_half_storage(const half *ptr) noexcept {
+  return reinterpret_cast<const fp16::half_storage *>(ptr);
+}
+
+}
+
+/// Returns whether joint matrices can be used by the sub-group. The
+/// portable implementation that is used without matrix hardware requires
+/// sub-groups of at least 8 work items. On CPUs, this requires setting
+/// the sub-group size of the generic compiler accordingly.
+ACPP_KERNEL_TARGET
+inline bool joint_matrix_is_supported(const sub_group &sg) noexcept {
+  return sg.get_local_linear_range() * __acpp_sscp_matrix_fragment_words >=
+         __acpp_sscp_matrix_tile_extent * __acpp_sscp_matrix_tile_extent;
+}
+
+ACPP_KERNEL_TARGET
+inline void joint_matrix_fill(sub_group sg, detail::accumulator_matrix &m,
+                              float value) noexcept {
+  __acpp_uint32 *frag = detail::joint_matrix_access::get(m);
+  __acpp_backend_switch(
+      __acpp_sscp_matrix_generic_fill_c(frag, value),
+      __acpp_sscp_matrix_fill_c_f32_m16n16k16(frag, value),
+      __acpp_sscp_matrix_generic_fill_c(frag, value),
+      __acpp_sscp_matrix_generic_fill_c(frag, value));
+}
+
+/// Loads an a matrix from ptr. The memory must not be modified until
+/// the last joint_matrix_mad() using the matrix.
+template <layout Layout>
+ACPP_KERNEL_TARGET
+void joint_matrix_load(sub_group sg, detail::half_matrix<use::a, Layout> &m,
+                       const half *ptr, std::size_t stride) noexcept {
+  __acpp_uint32 *frag = detail::joint_matrix_access::get(m);
+  const fp16::half_storage *src = detail::get_half_storage(ptr);
+  constexpr auto l = detail::get_builtin_layout(Layout);
+  __acpp_backend_switch(
+      __acpp_sscp_matrix_generic_load_ab(frag, src, stride, l),
+      __acpp_sscp_matrix_load_a_f16_m16n16k16(frag, src, stride, l),
+      __acpp_sscp_matrix_generic_load_ab(frag, src, stride, l),
+      __acpp_sscp_matrix_generic_load_ab(frag, src, stride, l));
+}
+
+/// Loads a b matrix from ptr. The memory must not be modified until
+/// the last joint_matrix_mad() using the matrix.
+template <layout Layout>
+ACPP_KERNEL_TARGET
+void joint_matrix_load(sub_group sg, detail::half_matrix<use::b, Layout> &m,
+                       const half *ptr, std::size_t stride) noexcept {
+  __acpp_uint32 *frag = detail::joint_matrix_access::get(m);
+  const fp16::half_storage *src = detail::get_half_storage(ptr);
+  constexpr auto l = detail::get_builtin_layout(Layout);
+  __acpp_backend_switch(
+      __acpp_sscp_matrix_generic_load_ab(frag, src, stride, l),
+      __acpp_sscp_matrix_load_b_f16_m16n16k16(frag, src, stride, l),
+      __acpp_sscp_matrix_generic_load_ab(frag, src, stride, l),
+      __acpp_sscp_matrix_generic_load_ab(frag, src, stride, l));
+}
+
+ACPP_KERNEL_TARGET
+inline void joint_matrix_load(sub_group sg, detail::accumulator_matrix &m,
+                              const float *ptr, std::size_t stride,
+                              layout mem_layout) noexcept {
+  __acpp_uint32 *frag = detail::joint_matrix_access::get(m);
+  auto l = detail::get_builtin_layout(mem_layout);
+  __acpp_backend_switch(
+      __acpp_sscp_matrix_generic_load_c(frag, ptr, stride, l,
+                                        sg.get_local_linear_id(),
+                                        sg.get_local_linear_range()),
+      __acpp_sscp_matrix_load_c_f32_m16n16k16(frag, ptr, stride, l),
+      __acpp_sscp_matrix_generic_load_c(frag, ptr, stride, l,
+                                        sg.get_local_linear_id(),
+                                        sg.get_local_linear_range()),
+      __acpp_sscp_matrix_generic_load_c(frag, ptr, stride, l,
+                                        sg.get_local_linear_id(),
+                                        sg.get_local_linear_range()));
+}
+
+ACPP_KERNEL_TARGET
+inline void joint_matrix_store(sub_group sg,
+                               const detail::accumulator_matrix &m,
+                               float *ptr, std::size_t stride,
+                               layout mem_layout) noexcept {
+  const __acpp_uint32 *frag = detail::joint_matrix_access::get(m);
+  auto l = detail::get_builtin_layout(mem_layout);
+  __acpp_backend_switch(
+      __acpp_sscp_matrix_generic_store_c(frag, ptr, stride, l,
+                                         sg.get_local_linear_id(),
+                                         sg.get_local_linear_range()),
+      __acpp_sscp_matrix_store_c_f32_m16n16k16(frag, ptr, stride, l),
+      __acpp_sscp_matrix_generic_store_c(frag, ptr, stride, l,
+                                         sg.get_local_linear_id(),
+                                         sg.get_local_linear_range()),
+      __acpp_sscp_matrix_generic_store_c(frag, ptr, stride, l,
+                                         sg.get_local_linear_id(),
+                                         sg.get_local_linear_range()));
+}
+
+/// Computes d = a * b + c. d may be the same matrix as c.
+template <layout LayoutA, layout LayoutB>
+ACPP_KERNEL_TARGET
+void joint_matrix_mad(sub_group sg, detail::accumulator_matrix &d,
+                      const detail::half_matrix<use::a, LayoutA> &a,
+                      const detail::half_matrix<use::b, LayoutB> &b,
+                      const detail::accumulator_matrix &c) noexcept {
+  __acpp_uint32 *d_frag = detail::joint_matrix_access::get(d);
+  const __acpp_uint32 *a_frag = detail::joint_matrix_access::get(a);
+  const __acpp_uint32 *b_frag = detail::joint_matrix_access::get(b);
+  const __acpp_uint32 *c_frag = detail::joint_matrix_access::get(c);
+  __acpp_backend_switch(
+      __acpp_sscp_matrix_generic_mad(d_frag, a_frag, b_frag, c_frag,
+                                     sg.get_local_linear_id(),
+                                     sg.get_local_linear_range()),
+      __acpp_sscp_matrix_mad_f32_f16_m16n16k16(
+          d_frag, a_frag, detail::get_builtin_layout(LayoutA), b_frag,
+          detail::get_builtin_layout(LayoutB), c_frag),
+      __acpp_sscp_matrix_generic_mad(d_frag, a_frag, b_frag, c_frag,
+                                     sg.get_local_linear_id(),
+                                     sg.get_local_linear_range()),
+      __acpp_sscp_matrix_generic_mad(d_frag, a_frag, b_frag, c_frag,
+                                     sg.get_local_linear_id(),
+                                     sg.get_local_linear_range()));
+}
+
+}
+}
+}
+
+#endif
@@ -302,6 +302,20 @@ struct nd_item
     );
   }
 
+  /// Synchronizes all work items of the kernel. The kernel must be
+  /// submitted with the AdaptiveCpp_cooperative_launch command group
+  /// property. Only supported by the generic SSCP compiler on CUDA and HIP.
+  HIPSYCL_LOOP_SPLIT_BARRIER ACPP_KERNEL_TARGET
+  void AdaptiveCpp_grid_barrier() const
+  {
+    __acpp_if_target_device(
+      detail::grid_device_barrier();
+    );
+    __acpp_if_target_host(
+      assert(false && "grid barriers are not supported on the host backend");
+    );
+  }
+
   template <access::mode accessMode = access::mode::read_write>
   ACPP_KERNEL_TARGET
   void mem_fence(access::fence_space accessSpace =
@@ -11,10 +11,12 @@
 #ifndef HIPSYCL_SYCL_REDUCTION_HPP
 #define HIPSYCL_SYCL_REDUCTION_HPP
 
+#include <cstddef>
 #include <type_traits>
 #include "backend.hpp"
 #include "functional.hpp"
 #include "accessor.hpp"
+#include "span.hpp"
 #include "hipSYCL/sycl/property.hpp"
 
 #include "hipSYCL/algorithms/reduction/reduction_descriptor.hpp"
@@ -42,6 +44,47 @@ auto construct_reduction_op(BinaryOp op, const T& identity) {
         op, identity};
 }
 
+/// Backend reducer implementation for element \c index of a span
+/// reduction, which forwards to the reducer of the entire span.
+template<class SpanReducerImpl>
+class span_element_reducer_impl {
+  using span_operator_type = typename SpanReducerImpl::operator_type;
+public:
+  using value_type = typename span_operator_type::element_type;
+  using binary_operation = typename span_operator_type::binary_operation;
+
+  ACPP_KERNEL_TARGET
+  span_element_reducer_impl(SpanReducerImpl &impl, std::size_t index)
+  : _impl{&impl}, _index{index} {}
+
+  ACPP_KERNEL_TARGET
+  void combine(const value_type& partial) {
+    _impl->combine_element(_index, partial);
+  }
+
+  ACPP_KERNEL_TARGET
+  value_type identity() const {
+    return _impl->identity().data[_index];
+  }
+private:
+  SpanReducerImpl* _impl;
+  std::size_t _index;
+};
+
+template<class T>
+struct is_span_element_reducer_impl : std::false_type {};
+
+template<class SpanReducerImpl>
+struct is_span_element_reducer_impl<span_element_reducer_impl<SpanReducerImpl>>
+    : std::true_type {};
+
+template<class T>
+struct is_reduction_array : std::false_type {};
+
+template<class T, std::size_t N>
+struct is_reduction_array<algorithms::reduction::reduction_array<T, N>>
+    : std::true_type {};
+
 } // namespace detail
 
 
@@ -60,10 +103,15 @@ class initialize_to_identity : public detail::reduction_property
 ///   - defines void combine(const value_type&)
 template <class BackendReducerImpl>
 class reducer {
+  // Element reducers of span reductions are created on the fly by
+  // operator[], and hence own their implementation.
+  static constexpr bool owns_impl =
+      detail::is_span_element_reducer_impl<BackendReducerImpl>::value;
 public:
   using value_type       = typename BackendReducerImpl::value_type;
   using binary_operation = typename BackendReducerImpl::binary_operation;
-  static constexpr int dimensions = 0; // TODO: For span reductions, this should be 1
+  static constexpr int dimensions =
+      detail::is_reduction_array<value_type>::value ? 1 : 0;
 
 
   ACPP_KERNEL_TARGET
@@ -82,15 +130,29 @@ public:
   reducer(BackendReducerImpl &impl)
       : _impl{impl} {}
 
+  template <bool OwnsImpl = owns_impl, std::enable_if_t<OwnsImpl, int> = 0>
+  ACPP_KERNEL_TARGET
+  reducer(BackendReducerImpl &&impl)
+      : _impl{impl} {}
+
   ACPP_KERNEL_TARGET
   reducer& combine(const value_type &partial) {
     _impl.combine(partial);
     return *this;
   }
 
-  // TODO
-  // /* Only available if Dimensions > 0 */
-  // __unspecified__ &operator[](size_t index) const;
+  /* Only available if Dimensions > 0 */
+  // Returns a reducer for element index of the span, which remains valid
+  // as long as this reducer. Since it is returned by value, the
+  // combination operators of the element reducer are also available
+  // for rvalues.
+  template <int D = dimensions, std::enable_if_t<(D > 0), int> = 0>
+  ACPP_KERNEL_TARGET
+  reducer<detail::span_element_reducer_impl<BackendReducerImpl>>
+  operator[](std::size_t index) const {
+    return reducer<detail::span_element_reducer_impl<BackendReducerImpl>>{
+        detail::span_element_reducer_impl<BackendReducerImpl>{_impl, index}};
+  }
 
   /* Only available if identity value is known */
   value_type identity() const {
@@ -98,7 +160,8 @@ public:
   }
 
 private:
-  BackendReducerImpl& _impl;
+  std::conditional_t<owns_impl, BackendReducerImpl, BackendReducerImpl &>
+      _impl;
 };
 
 #define HIPSYCL_ENABLE_REDUCER_OP_IF_TYPE(T)                                   \
@@ -159,6 +222,55 @@ reducer<BackendReducerImpl>& operator++(reducer<BackendReducerImpl> &r) {
   return r.combine(1);
 }
 
+// Overloads for the element reducers of span reductions, which are
+// returned by value from reducer::operator[]
+template <class BackendReducerImpl,
+          HIPSYCL_ENABLE_REDUCER_OP_IF_TYPE(sycl::plus)>
+ACPP_KERNEL_TARGET
+reducer<BackendReducerImpl>& operator+=(reducer<BackendReducerImpl> &&r,
+                const typename reducer<BackendReducerImpl>::value_type &v) {
+  return r.combine(v);
+}
+
+template <class BackendReducerImpl,
+          HIPSYCL_ENABLE_REDUCER_OP_IF_TYPE(sycl::multiplies)>
+ACPP_KERNEL_TARGET
+reducer<BackendReducerImpl>& operator*=(reducer<BackendReducerImpl> &&r,
+                const typename reducer<BackendReducerImpl>::value_type &v) {
+  return r.combine(v);
+}
+
+template <class BackendReducerImpl,
+          HIPSYCL_ENABLE_REDUCER_OP_IF_TYPE(sycl::bit_and)>
+ACPP_KERNEL_TARGET
+reducer<BackendReducerImpl>& operator&=(reducer<BackendReducerImpl> &&r,
+                const typename reducer<BackendReducerImpl>::value_type &v) {
+  return r.combine(v);
+}
+
+template <class BackendReducerImpl,
+          HIPSYCL_ENABLE_REDUCER_OP_IF_TYPE(sycl::bit_or)>
+ACPP_KERNEL_TARGET
+reducer<BackendReducerImpl>& operator|=(reducer<BackendReducerImpl> &&r,
+                const typename reducer<BackendReducerImpl>::value_type &v) {
+  return r.combine(v);
+}
+
+template <class BackendReducerImpl,
+          HIPSYCL_ENABLE_REDUCER_OP_IF_TYPE(sycl::bit_xor)>
+ACPP_KERNEL_TARGET
+reducer<BackendReducerImpl>& operator^=(reducer<BackendReducerImpl> &&r,
+                const typename reducer<BackendReducerImpl>::value_type &v) {
+  return r.combine(v);
+}
+
+template <class BackendReducerImpl,
+          HIPSYCL_ENABLE_REDUCER_OP_IF_TYPE(sycl::plus)>
+ACPP_KERNEL_TARGET
+reducer<BackendReducerImpl>& operator++(reducer<BackendReducerImpl> &&r) {
+  return r.combine(1);
+}
+
 
 class handler;
 
@@ -235,14 +347,40 @@ auto reduction(T *var, const T &identity, BinaryOperation combiner,
   }
 }
 
-/* Unsupported until we have span
+// Span reductions reduce all elements of the span element-wise. Each work
+// item accumulates a private copy of the entire span, which is then
+// combined with the copies of the other work items in the work group
+// reduction. They are therefore intended for small spans, and require
+// a static extent as well as an identity.
+template <typename T, std::size_t Extent, typename BinaryOperation>
+auto reduction(span<T, Extent> vars, const T &identity,
+               BinaryOperation combiner, const property_list &propList = {}) {
+  static_assert(Extent != dynamic_extent,
+                "Span reductions require spans with static extent");
+  using reduction_op_type =
+      algorithms::reduction::array_reduction_binary_operator<T, Extent,
+                                                             BinaryOperation>;
+  reduction_op_type reduction_op{combiner, identity};
+  auto *output =
+      reinterpret_cast<typename reduction_op_type::value_type *>(vars.data());
 
-template <typename T, typename Extent, typename BinaryOperation>
-__unspecified__ reduction(span<T, Extent> vars, BinaryOperation combiner);
+  if(propList.has_property<property::reduction::initialize_to_identity>()) {
+    return algorithms::reduction::reduction_descriptor{
+        reduction_op, reduction_op.get_identity(), output};
+  } else {
+    return algorithms::reduction::reduction_descriptor{reduction_op, output};
+  }
+}
 
-template <typename T, typename Extent, typename BinaryOperation>
-__unspecified__ reduction(span<T, Extent> vars, const T& identity, BinaryOperation combiner);
-*/
+template <typename T, std::size_t Extent, typename BinaryOperation>
+auto reduction(span<T, Extent> vars, BinaryOperation combiner,
+               const property_list &propList = {}) {
+  static_assert(has_known_identity_v<BinaryOperation, T>,
+                "Span reductions require an operator with known identity, "
+                "or an explicitly provided identity");
+  return reduction(vars, sycl::known_identity<BinaryOperation, T>::value,
+                   combiner, propList);
+}
 
 
 }
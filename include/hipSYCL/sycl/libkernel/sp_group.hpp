@@ -20,6 +20,10 @@
 #include "hipSYCL/glue/generic/host/iterate_range.hpp"
 #include <type_traits>
 
+#if ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+#include "hipSYCL/sycl/libkernel/sscp/builtins/barrier.hpp"
+#endif
+
 namespace hipsycl {
 namespace sycl {
 
@@ -36,7 +40,7 @@ struct static_range {
   }
 
   static constexpr bool is_known() {
-    return linear_range() != 0;
+    return linear_range() > 0;
   }
 };
 
@@ -386,7 +390,9 @@ struct sp_group
 
   template <typename... eventTN>
   ACPP_KERNEL_TARGET
-  void wait_for(eventTN...) const noexcept {}
+  void wait_for(eventTN... events) const noexcept {
+    _grp.wait_for(events...);
+  }
 
   ACPP_KERNEL_TARGET
   bool leader() const noexcept {
@@ -1268,7 +1274,9 @@ group_barrier(const detail::sp_group<PropertyDescriptor> &g,
     }
     __syncthreads();
   );
-  __acpp_if_target_sscp(/* todo */);
+  __acpp_if_target_sscp(
+    __acpp_sscp_work_group_barrier(fence_scope, memory_order::seq_cst);
+  );
   __acpp_if_target_host(/* todo */);
 }
 
@@ -1288,7 +1296,9 @@ group_barrier(const detail::sp_sub_group<PropertyDescriptor> &g,
   __acpp_if_target_cuda(
     __syncwarp();
   );
-  __acpp_if_target_sscp(/* todo */);
+  __acpp_if_target_sscp(
+    __acpp_sscp_sub_group_barrier(fence_scope, memory_order::seq_cst);
+  );
   __acpp_if_target_host(/* todo */);
 }
 
@@ -83,6 +83,51 @@ private:
   T _data;
 };
 
+#elif ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
+
+// In the unified host-device pass of SSCP, kernels are only outlined later,
+// so both the host code path and the device code path must be supported.
+// On device, the memory of each work item is kept in a private variable
+// which can be promoted to registers, and no heap allocation takes place.
+template<typename T, class SpGroup>
+class s_private_memory
+{
+  static constexpr int dimensions = SpGroup::dimensions;
+public:
+  template <class SG = SpGroup,
+            std::enable_if_t<detail::is_sp_group_v<SG>, int> = 0>
+  [[deprecated("Use sycl::memory_environment() instead")]]
+  ACPP_KERNEL_TARGET
+  explicit s_private_memory(const SpGroup& grp)
+  : _grp{grp}
+  {
+    __acpp_if_target_host(
+      _host_data.reset(new T [grp.get_logical_local_linear_range()]);
+    );
+  }
+
+  s_private_memory(const s_private_memory&) = delete;
+  s_private_memory& operator=(const s_private_memory&) = delete;
+
+  [[deprecated("Use sycl::memory_environment() instead")]]
+  ACPP_KERNEL_TARGET
+  T& operator()(const detail::sp_item<dimensions>& idx) noexcept
+  {
+    __acpp_if_target_host(
+      return _host_data.get()[detail::linear_id<dimensions>::get(
+          idx.get_local_id(_grp), idx.get_local_range(_grp))];
+    );
+    __acpp_if_target_device(
+      return _device_data;
+    );
+  }
+
+private:
+  T _device_data;
+  std::unique_ptr<T []> _host_data;
+  const SpGroup& _grp;
+};
+
 #else
 
 template<typename T, class SpGroup>
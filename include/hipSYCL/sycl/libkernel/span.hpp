@@ -0,0 +1,227 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SPAN_HPP
+#define HIPSYCL_SPAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+#include "backend.hpp"
+
+namespace hipsycl {
+namespace sycl {
+
+inline constexpr std::size_t dynamic_extent =
+    std::numeric_limits<std::size_t>::max();
+
+namespace detail {
+
+template <class T, std::size_t Extent>
+struct span_storage {
+  constexpr span_storage() noexcept = default;
+  constexpr span_storage(T *ptr, std::size_t) noexcept : ptr{ptr} {}
+
+  constexpr std::size_t size() const noexcept { return Extent; }
+
+  T *ptr = nullptr;
+};
+
+template <class T>
+struct span_storage<T, dynamic_extent> {
+  constexpr span_storage() noexcept = default;
+  constexpr span_storage(T *ptr, std::size_t size) noexcept
+      : ptr{ptr}, num_elements{size} {}
+
+  constexpr std::size_t size() const noexcept { return num_elements; }
+
+  T *ptr = nullptr;
+  std::size_t num_elements = 0;
+};
+
+template <class Container, class ElementType, class = void>
+struct is_span_compatible_container : std::false_type {};
+
+template <class Container, class ElementType>
+struct is_span_compatible_container<
+    Container, ElementType,
+    std::void_t<decltype(std::data(std::declval<Container &>())),
+                decltype(std::size(std::declval<Container &>()))>>
+    : std::is_convertible<std::remove_pointer_t<decltype(std::data(
+                              std::declval<Container &>()))> (*)[],
+                          ElementType (*)[]> {};
+
+}
+
+/// Non-owning view of a contiguous sequence of objects, as std::span
+/// from C++20.
+template <class ElementType, std::size_t Extent = dynamic_extent>
+class span {
+public:
+  using element_type = ElementType;
+  using value_type = std::remove_cv_t<ElementType>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = element_type *;
+  using const_pointer = const element_type *;
+  using reference = element_type &;
+  using const_reference = const element_type &;
+  using iterator = pointer;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  static constexpr size_type extent = Extent;
+
+  template <std::size_t E = Extent,
+            std::enable_if_t<E == 0 || E == dynamic_extent, int> = 0>
+  constexpr span() noexcept {}
+
+  constexpr span(pointer ptr, size_type count) noexcept
+      : _storage{ptr, count} {}
+
+  constexpr span(pointer first, pointer last) noexcept
+      : _storage{first, static_cast<size_type>(last - first)} {}
+
+  template <std::size_t N,
+            std::enable_if_t<Extent == dynamic_extent || Extent == N, int> = 0>
+  constexpr span(element_type (&arr)[N]) noexcept : _storage{arr, N} {}
+
+  template <class T, std::size_t N,
+            std::enable_if_t<(Extent == dynamic_extent || Extent == N) &&
+                                 std::is_convertible_v<T (*)[], element_type (*)[]>,
+                             int> = 0>
+  constexpr span(std::array<T, N> &arr) noexcept : _storage{arr.data(), N} {}
+
+  template <class T, std::size_t N,
+            std::enable_if_t<(Extent == dynamic_extent || Extent == N) &&
+                                 std::is_convertible_v<const T (*)[],
+                                                       element_type (*)[]>,
+                             int> = 0>
+  constexpr span(const std::array<T, N> &arr) noexcept
+      : _storage{arr.data(), N} {}
+
+  template <class Container,
+            std::enable_if_t<
+                Extent == dynamic_extent &&
+                    !std::is_array_v<Container> &&
+                    detail::is_span_compatible_container<Container,
+                                                         element_type>::value,
+                int> = 0>
+  constexpr span(Container &c) : _storage{std::data(c), std::size(c)} {}
+
+  template <class Container,
+            std::enable_if_t<
+                Extent == dynamic_extent &&
+                    !std::is_array_v<Container> &&
+                    detail::is_span_compatible_container<const Container,
+                                                         element_type>::value,
+                int> = 0>
+  constexpr span(const Container &c) : _storage{std::data(c), std::size(c)} {}
+
+  template <class T, std::size_t N,
+            std::enable_if_t<(Extent == dynamic_extent || Extent == N) &&
+                                 std::is_convertible_v<T (*)[],
+                                                       element_type (*)[]>,
+                             int> = 0>
+  constexpr span(const span<T, N> &s) noexcept
+      : _storage{s.data(), s.size()} {}
+
+  constexpr span(const span &other) noexcept = default;
+  constexpr span &operator=(const span &other) noexcept = default;
+
+  template <std::size_t Count>
+  constexpr span<element_type, Count> first() const {
+    return span<element_type, Count>{data(), Count};
+  }
+
+  template <std::size_t Count>
+  constexpr span<element_type, Count> last() const {
+    return span<element_type, Count>{data() + (size() - Count), Count};
+  }
+
+  template <std::size_t Offset, std::size_t Count = dynamic_extent>
+  constexpr auto subspan() const {
+    constexpr std::size_t result_extent =
+        Count != dynamic_extent
+            ? Count
+            : (Extent != dynamic_extent ? Extent - Offset : dynamic_extent);
+    return span<element_type, result_extent>{
+        data() + Offset, Count != dynamic_extent ? Count : size() - Offset};
+  }
+
+  constexpr span<element_type, dynamic_extent> first(size_type count) const {
+    return {data(), count};
+  }
+
+  constexpr span<element_type, dynamic_extent> last(size_type count) const {
+    return {data() + (size() - count), count};
+  }
+
+  constexpr span<element_type, dynamic_extent>
+  subspan(size_type offset, size_type count = dynamic_extent) const {
+    return {data() + offset, count == dynamic_extent ? size() - offset : count};
+  }
+
+  constexpr size_type size() const noexcept { return _storage.size(); }
+
+  constexpr size_type size_bytes() const noexcept {
+    return size() * sizeof(element_type);
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return size() == 0; }
+
+  constexpr reference operator[](size_type idx) const {
+    return _storage.ptr[idx];
+  }
+
+  constexpr reference front() const { return _storage.ptr[0]; }
+
+  constexpr reference back() const { return _storage.ptr[size() - 1]; }
+
+  constexpr pointer data() const noexcept { return _storage.ptr; }
+
+  constexpr iterator begin() const noexcept { return data(); }
+
+  constexpr iterator end() const noexcept { return data() + size(); }
+
+  constexpr reverse_iterator rbegin() const noexcept {
+    return reverse_iterator{end()};
+  }
+
+  constexpr reverse_iterator rend() const noexcept {
+    return reverse_iterator{begin()};
+  }
+
+private:
+  detail::span_storage<element_type, Extent> _storage;
+};
+
+template <class T, std::size_t N>
+span(T (&)[N]) -> span<T, N>;
+
+template <class T, std::size_t N>
+span(std::array<T, N> &) -> span<T, N>;
+
+template <class T, std::size_t N>
+span(const std::array<T, N> &) -> span<const T, N>;
+
+template <class Container>
+span(Container &) -> span<typename Container::value_type>;
+
+template <class Container>
+span(const Container &) -> span<const typename Container::value_type>;
+
+}
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "builtin_config.hpp"
+
+#include <limits>
+#include <type_traits>
+
+#ifndef HIPSYCL_SSCP_ALGORITHM_OP_HPP
+#define HIPSYCL_SSCP_ALGORITHM_OP_HPP
+
+// Helpers for implementations of group algorithm builtins.
+
+template <class T>
+__attribute__((always_inline)) inline T
+__acpp_sscp_apply_algorithm_op(__acpp_sscp_algorithm_op op, T a, T b) {
+  switch (op) {
+  case __acpp_sscp_algorithm_op::plus:
+    return a + b;
+  case __acpp_sscp_algorithm_op::multiply:
+    return a * b;
+  case __acpp_sscp_algorithm_op::min:
+    return a < b ? a : b;
+  case __acpp_sscp_algorithm_op::max:
+    return a < b ? b : a;
+  case __acpp_sscp_algorithm_op::bit_and:
+    if constexpr (std::is_integral_v<T>)
+      return a & b;
+    break;
+  case __acpp_sscp_algorithm_op::bit_or:
+    if constexpr (std::is_integral_v<T>)
+      return a | b;
+    break;
+  case __acpp_sscp_algorithm_op::bit_xor:
+    if constexpr (std::is_integral_v<T>)
+      return a ^ b;
+    break;
+  case __acpp_sscp_algorithm_op::logical_and:
+    return a && b;
+  case __acpp_sscp_algorithm_op::logical_or:
+    return a || b;
+  }
+  return a;
+}
+
+// Note: For floating point min and max, the largest finite values are used
+// instead of infinities, which might not be supported with -ffast-math.
+template <class T>
+__attribute__((always_inline)) inline T
+__acpp_sscp_get_algorithm_op_identity(__acpp_sscp_algorithm_op op) {
+  switch (op) {
+  case __acpp_sscp_algorithm_op::multiply:
+  case __acpp_sscp_algorithm_op::logical_and:
+    return T{1};
+  case __acpp_sscp_algorithm_op::min:
+    return std::numeric_limits<T>::max();
+  case __acpp_sscp_algorithm_op::max:
+    return std::numeric_limits<T>::lowest();
+  case __acpp_sscp_algorithm_op::bit_and:
+    if constexpr (std::is_integral_v<T>)
+      return static_cast<T>(~T{0});
+    break;
+  default:
+    break;
+  }
+  return T{0};
+}
+
+/// Shuffles a value of up to 64 bits using a backend-provided 32 bit shuffle
+/// shuffle(__acpp_uint32 x, __acpp_uint32 arg), e.g. a shuffle that returns
+/// x of the sub-group local id arg below the calling one.
+template <class T, class Shuffle32>
+__attribute__((always_inline)) inline T
+__acpp_sscp_shuffle(T x, __acpp_uint32 arg, Shuffle32 shuffle) {
+  static_assert(sizeof(T) <= 8, "Invalid data type");
+  if constexpr (sizeof(T) == 1) {
+    return __builtin_bit_cast(
+        T, static_cast<__acpp_uint8>(shuffle(
+               __builtin_bit_cast(__acpp_uint8, x), arg)));
+  } else if constexpr (sizeof(T) == 2) {
+    return __builtin_bit_cast(
+        T, static_cast<__acpp_uint16>(shuffle(
+               __builtin_bit_cast(__acpp_uint16, x), arg)));
+  } else if constexpr (sizeof(T) == 4) {
+    return __builtin_bit_cast(
+        T, shuffle(__builtin_bit_cast(__acpp_uint32, x), arg));
+  } else {
+    __acpp_uint32_2 v = __builtin_bit_cast(__acpp_uint32_2, x);
+    v.x = shuffle(v.x, arg);
+    v.y = shuffle(v.y, arg);
+    return __builtin_bit_cast(T, v);
+  }
+}
+
+#endif
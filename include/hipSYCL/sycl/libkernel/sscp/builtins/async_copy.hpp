@@ -0,0 +1,31 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "builtin_config.hpp"
+
+#ifndef HIPSYCL_SSCP_ASYNC_COPY_BUILTINS_HPP
+#define HIPSYCL_SSCP_ASYNC_COPY_BUILTINS_HPP
+
+/// Starts copying size bytes from src in global memory to dest in local
+/// memory. size must be 4, 8 or 16, and both pointers must be aligned to size.
+/// The copy may complete asynchronously, so the data may only be accessed
+/// after __acpp_sscp_async_copy_wait().
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_async_copy_global_to_local(void *dest, const void *src,
+                                       __acpp_uint32 size);
+
+/// Marks the end of a batch of asynchronous copies of this work item.
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_async_copy_commit();
+
+/// Waits until all asynchronous copies started by this work item have
+/// completed. Does not synchronize with other work items.
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_async_copy_wait();
+
+#endif
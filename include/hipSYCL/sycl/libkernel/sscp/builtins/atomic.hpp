@@ -105,6 +105,28 @@ HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_cmp_exch_strong_i64(
     __acpp_sscp_memory_order failure, __acpp_sscp_memory_scope scope,
     __acpp_int64 *ptr, __acpp_int64 *expected, __acpp_int64 desired);
 
+#ifdef __SIZEOF_INT128__
+// 16-byte atomics are currently only provided by the host backend on
+// x86-64, where they require cmpxchg16b. ptr must be 16-byte aligned.
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_atomic_store_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int128 *ptr, __acpp_int128 x);
+
+HIPSYCL_SSCP_BUILTIN __acpp_int128 __acpp_sscp_atomic_load_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int128 *ptr);
+
+HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_cmp_exch_weak_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order success,
+    __acpp_sscp_memory_order failure, __acpp_sscp_memory_scope scope,
+    __acpp_int128 *ptr, __acpp_int128 *expected, __acpp_int128 desired);
+
+HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_cmp_exch_strong_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order success,
+    __acpp_sscp_memory_order failure, __acpp_sscp_memory_scope scope,
+    __acpp_int128 *ptr, __acpp_int128 *expected, __acpp_int128 desired);
+#endif
+
 
 
 HIPSYCL_SSCP_BUILTIN __acpp_int8 __acpp_sscp_atomic_fetch_and_i8(
@@ -202,6 +224,27 @@ HIPSYCL_SSCP_BUILTIN __acpp_f64 __acpp_sscp_atomic_fetch_add_f64(
     __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
     __acpp_sscp_memory_scope scope, __acpp_f64 *ptr, __acpp_f64 x);
 
+// Like __acpp_sscp_atomic_fetch_add_*, but additions of work items of the
+// same sub-group that target the same address may be combined into a single
+// atomic operation. Only valid for relaxed memory order. Calls are
+// substituted by the JIT compiler (see AtomicAggregationPass).
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int32 __acpp_sscp_atomic_fetch_add_aggregated_i32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int32 *ptr, __acpp_int32 x);
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int64 __acpp_sscp_atomic_fetch_add_aggregated_i64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int64 *ptr, __acpp_int64 x);
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint32 __acpp_sscp_atomic_fetch_add_aggregated_u32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint32 *ptr, __acpp_uint32 x);
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint64 __acpp_sscp_atomic_fetch_add_aggregated_u64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint64 *ptr, __acpp_uint64 x);
+
 
 
 HIPSYCL_SSCP_BUILTIN __acpp_int8 __acpp_sscp_atomic_fetch_sub_i8(
@@ -20,4 +20,9 @@ HIPSYCL_SSCP_CONVERGENT_BUILTIN void
 __acpp_sscp_sub_group_barrier(__acpp_sscp_memory_scope fence_scope,
                               __acpp_sscp_memory_order);
 
+/// Synchronizes all work items of the kernel. Requires that all work groups
+/// are resident on the device, i.e. a cooperative launch.
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_grid_barrier();
+
 #endif
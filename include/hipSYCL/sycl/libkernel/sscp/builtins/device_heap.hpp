@@ -0,0 +1,83 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "builtin_config.hpp"
+#include "device_heap_generic.hpp"
+#include "atomic.hpp"
+
+#ifndef HIPSYCL_SSCP_DEVICE_HEAP_BUILTINS_HPP
+#define HIPSYCL_SSCP_DEVICE_HEAP_BUILTINS_HPP
+
+// Dynamic memory allocation from a heap in device memory, see
+// device_heap_generic.hpp for the layout of the heap. All functions return
+// nullptr if the heap is exhausted.
+
+HIPSYCL_SSCP_BUILTIN void *
+__acpp_sscp_device_heap_malloc(__acpp_sscp_device_heap *heap,
+                               __acpp_uint64 size);
+
+/// Like __acpp_sscp_device_heap_malloc, but new blocks for the work items
+/// of a sub-group that invoke it together are obtained with a single
+/// atomic operation. Sizes may differ between work items.
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void *
+__acpp_sscp_sub_group_device_heap_malloc(__acpp_sscp_device_heap *heap,
+                                         __acpp_uint64 size);
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_device_heap_free(__acpp_sscp_device_heap *heap, void *ptr);
+
+/// Atomics for __acpp_sscp_device_heap_generic_* based on the SSCP atomic
+/// builtins, for the implementations of the device heap builtins.
+struct __acpp_sscp_device_heap_builtin_atomics {
+  __attribute__((always_inline)) static __acpp_uint64 load(__acpp_uint64 *ptr) {
+    return static_cast<__acpp_uint64>(__acpp_sscp_atomic_load_i64(
+        __acpp_sscp_address_space::global_space,
+        __acpp_sscp_memory_order::acquire, __acpp_sscp_memory_scope::device,
+        reinterpret_cast<__acpp_int64 *>(ptr)));
+  }
+
+  __attribute__((always_inline)) static void store(__acpp_uint64 *ptr,
+                                                   __acpp_uint64 x) {
+    __acpp_sscp_atomic_store_i64(__acpp_sscp_address_space::global_space,
+                                 __acpp_sscp_memory_order::relaxed,
+                                 __acpp_sscp_memory_scope::device,
+                                 reinterpret_cast<__acpp_int64 *>(ptr),
+                                 static_cast<__acpp_int64>(x));
+  }
+
+  __attribute__((always_inline)) static bool
+  compare_exchange(__acpp_uint64 *ptr, __acpp_uint64 &expected,
+                   __acpp_uint64 desired) {
+    return __acpp_sscp_cmp_exch_weak_i64(
+        __acpp_sscp_address_space::global_space,
+        __acpp_sscp_memory_order::acq_rel, __acpp_sscp_memory_order::acquire,
+        __acpp_sscp_memory_scope::device, reinterpret_cast<__acpp_int64 *>(ptr),
+        reinterpret_cast<__acpp_int64 *>(&expected),
+        static_cast<__acpp_int64>(desired));
+  }
+
+  __attribute__((always_inline)) static __acpp_uint64
+  fetch_add(__acpp_uint64 *ptr, __acpp_uint64 x) {
+    return __acpp_sscp_atomic_fetch_add_u64(
+        __acpp_sscp_address_space::global_space,
+        __acpp_sscp_memory_order::relaxed, __acpp_sscp_memory_scope::device,
+        ptr, x);
+  }
+
+  __attribute__((always_inline)) static __acpp_uint64
+  fetch_add_aggregated(__acpp_uint64 *ptr, __acpp_uint64 x) {
+    return __acpp_sscp_atomic_fetch_add_aggregated_u64(
+        __acpp_sscp_address_space::global_space,
+        __acpp_sscp_memory_order::relaxed, __acpp_sscp_memory_scope::device,
+        ptr, x);
+  }
+};
+
+#endif
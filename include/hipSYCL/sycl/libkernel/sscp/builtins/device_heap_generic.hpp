@@ -0,0 +1,203 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "builtin_config.hpp"
+
+#ifndef HIPSYCL_SSCP_DEVICE_HEAP_GENERIC_HPP
+#define HIPSYCL_SSCP_DEVICE_HEAP_GENERIC_HPP
+
+// Building blocks for the implementations of device heap builtins, which
+// are also used for the host-side initialization of the heap and by
+// compilation flows other than SSCP.
+//
+// The heap is an arena in device memory that starts with a
+// __acpp_sscp_device_heap header. Allocations are rounded up to blocks of
+// power-of-two size classes. Blocks are carved from the unused part of the
+// arena by bumping an offset, and freed blocks are kept in one lock-free
+// free list per size class for reuse. Memory is never returned from a
+// size class to the arena.
+
+#define __acpp_sscp_device_heap_num_size_classes 32
+#define __acpp_sscp_device_heap_min_block_size 32
+// Block headers store the size class; keeps allocations 16-byte aligned
+#define __acpp_sscp_device_heap_block_header_size 16
+// Free list heads are tagged with a counter in their upper bits to avoid
+// ABA problems, which limits offsets into the arena to 40 bits.
+#define __acpp_sscp_device_heap_offset_bits 40
+
+struct __acpp_sscp_device_heap {
+  // Size of the arena in bytes, including this header
+  __acpp_uint64 capacity;
+  // Offset of the unused part of the arena
+  __acpp_uint64 bump_offset;
+  // Tagged offsets of the first free block of each size class, or 0
+  __acpp_uint64 free_lists[__acpp_sscp_device_heap_num_size_classes];
+};
+
+struct __acpp_sscp_device_heap_block {
+  __acpp_uint64 size_class;
+  // Offset of the next free block while the block is in a free list
+  __acpp_uint64 next;
+};
+
+/// Returns the size class of blocks for allocations of size bytes, or
+/// __acpp_sscp_device_heap_num_size_classes if no size class is large
+/// enough.
+__attribute__((always_inline)) inline __acpp_uint32
+__acpp_sscp_device_heap_get_size_class(__acpp_uint64 size) {
+  if (size > (1ull << 62))
+    return __acpp_sscp_device_heap_num_size_classes;
+  __acpp_uint64 block_size = size + __acpp_sscp_device_heap_block_header_size;
+  if (block_size <= __acpp_sscp_device_heap_min_block_size)
+    return 0;
+  // ceil(log2(block_size)) - log2(min_block_size)
+  __acpp_uint32 log2_size = 64 - __builtin_clzll(block_size - 1);
+  __acpp_uint32 size_class = log2_size - 5;
+  return size_class < __acpp_sscp_device_heap_num_size_classes
+             ? size_class
+             : __acpp_sscp_device_heap_num_size_classes;
+}
+
+__attribute__((always_inline)) inline __acpp_uint64
+__acpp_sscp_device_heap_get_block_size(__acpp_uint32 size_class) {
+  return static_cast<__acpp_uint64>(__acpp_sscp_device_heap_min_block_size)
+         << size_class;
+}
+
+/// Returns the offset of the first block that can be allocated in a heap.
+__attribute__((always_inline)) inline __acpp_uint64
+__acpp_sscp_device_heap_get_first_block_offset() {
+  return (sizeof(__acpp_sscp_device_heap) + 15) & ~15ull;
+}
+
+namespace __acpp_sscp_device_heap_detail {
+
+constexpr __acpp_uint64 offset_mask =
+    (1ull << __acpp_sscp_device_heap_offset_bits) - 1;
+
+__attribute__((always_inline)) inline __acpp_sscp_device_heap_block *
+get_block(__acpp_sscp_device_heap *heap, __acpp_uint64 offset) {
+  return reinterpret_cast<__acpp_sscp_device_heap_block *>(
+      reinterpret_cast<char *>(heap) + offset);
+}
+
+template <class Atomics>
+__attribute__((always_inline)) inline __acpp_sscp_device_heap_block *
+pop_free_block(__acpp_sscp_device_heap *heap, __acpp_uint32 size_class) {
+  __acpp_uint64 *head = &heap->free_lists[size_class];
+  __acpp_uint64 old_head = Atomics::load(head);
+  while ((old_head & offset_mask) != 0) {
+    __acpp_sscp_device_heap_block *block =
+        get_block(heap, old_head & offset_mask);
+    // The block might have been allocated by another work item in the
+    // meantime, in which case next is garbage but the exchange fails
+    // because the tag has changed.
+    __acpp_uint64 next = Atomics::load(&block->next);
+    __acpp_uint64 tag = (old_head >> __acpp_sscp_device_heap_offset_bits) + 1;
+    __acpp_uint64 new_head =
+        (next & offset_mask) | (tag << __acpp_sscp_device_heap_offset_bits);
+    if (Atomics::compare_exchange(head, old_head, new_head))
+      return block;
+  }
+  return nullptr;
+}
+
+template <class Atomics>
+__attribute__((always_inline)) inline void
+push_free_block(__acpp_sscp_device_heap *heap, __acpp_uint32 size_class,
+                __acpp_sscp_device_heap_block *block) {
+  __acpp_uint64 *head = &heap->free_lists[size_class];
+  __acpp_uint64 offset = static_cast<__acpp_uint64>(
+      reinterpret_cast<char *>(block) - reinterpret_cast<char *>(heap));
+  __acpp_uint64 old_head = Atomics::load(head);
+  __acpp_uint64 new_head;
+  do {
+    Atomics::store(&block->next, old_head & offset_mask);
+    __acpp_uint64 tag = (old_head >> __acpp_sscp_device_heap_offset_bits) + 1;
+    new_head = offset | (tag << __acpp_sscp_device_heap_offset_bits);
+  } while (!Atomics::compare_exchange(head, old_head, new_head));
+}
+
+}
+
+/// Allocates size bytes from heap. Returns nullptr if the heap is
+/// exhausted.
+///
+/// Atomics must provide load (acquire), store (relaxed) and
+/// compare_exchange (acq_rel, updating the expected value on failure) for
+/// __acpp_uint64, operating at device scope.
+/// \param bump Invoked as bump(&heap->bump_offset, block_size) to
+/// atomically obtain the offset of new blocks, such that sub-group
+/// implementations can aggregate it.
+template <class Atomics, class Bump>
+__attribute__((always_inline)) inline void *
+__acpp_sscp_device_heap_generic_malloc(__acpp_sscp_device_heap *heap,
+                                       __acpp_uint64 size, Bump bump) {
+  using namespace __acpp_sscp_device_heap_detail;
+
+  __acpp_uint32 size_class = __acpp_sscp_device_heap_get_size_class(size);
+  bool is_valid = size_class < __acpp_sscp_device_heap_num_size_classes;
+
+  __acpp_sscp_device_heap_block *block =
+      is_valid ? pop_free_block<Atomics>(heap, size_class) : nullptr;
+  if (!block && is_valid) {
+    __acpp_uint64 block_size = __acpp_sscp_device_heap_get_block_size(size_class);
+    __acpp_uint64 offset = bump(&heap->bump_offset, block_size);
+    // The capacity is constant, and bounded by the offset bits
+    if (offset + block_size <= heap->capacity && offset + block_size > offset)
+      block = get_block(heap, offset);
+  }
+  if (!block)
+    return nullptr;
+
+  block->size_class = size_class;
+  return reinterpret_cast<char *>(block) +
+         __acpp_sscp_device_heap_block_header_size;
+}
+
+template <class Atomics>
+__attribute__((always_inline)) inline void
+__acpp_sscp_device_heap_generic_free(__acpp_sscp_device_heap *heap,
+                                     void *ptr) {
+  using namespace __acpp_sscp_device_heap_detail;
+  if (!ptr)
+    return;
+  auto *block = reinterpret_cast<__acpp_sscp_device_heap_block *>(
+      static_cast<char *>(ptr) - __acpp_sscp_device_heap_block_header_size);
+  push_free_block<Atomics>(heap, static_cast<__acpp_uint32>(block->size_class),
+                           block);
+}
+
+/// Atomics for __acpp_sscp_device_heap_generic_* based on the atomic
+/// builtins of clang, for compilation flows other than SSCP.
+struct __acpp_sscp_device_heap_clang_atomics {
+  __attribute__((always_inline)) static __acpp_uint64 load(__acpp_uint64 *ptr) {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+  }
+
+  __attribute__((always_inline)) static void store(__acpp_uint64 *ptr,
+                                                   __acpp_uint64 x) {
+    __atomic_store_n(ptr, x, __ATOMIC_RELAXED);
+  }
+
+  __attribute__((always_inline)) static bool
+  compare_exchange(__acpp_uint64 *ptr, __acpp_uint64 &expected,
+                   __acpp_uint64 desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, true,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+  }
+
+  __attribute__((always_inline)) static __acpp_uint64
+  fetch_add(__acpp_uint64 *ptr, __acpp_uint64 x) {
+    return __atomic_fetch_add(ptr, x, __ATOMIC_RELAXED);
+  }
+};
+
+#endif
@@ -23,6 +23,15 @@ HIPSYCL_SSCP_BUILTIN __acpp_f16 __acpp_sscp_half_mul(
 HIPSYCL_SSCP_BUILTIN __acpp_f16 __acpp_sscp_half_div(
     __acpp_f16 a, __acpp_f16 b);
 
+// Packed operations on two half values. The value with the lower index
+// is stored in the lower 16 bits.
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_add(
+    __acpp_uint32 a, __acpp_uint32 b);
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_sub(
+    __acpp_uint32 a, __acpp_uint32 b);
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_mul(
+    __acpp_uint32 a, __acpp_uint32 b);
+
 HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_half_lt(__acpp_f16 a,
                                                  __acpp_f16 b);
 HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_half_lte(__acpp_f16 a,
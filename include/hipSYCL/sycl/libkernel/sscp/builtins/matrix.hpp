@@ -0,0 +1,58 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "builtin_config.hpp"
+#include "matrix_generic.hpp"
+
+#ifndef HIPSYCL_SSCP_MATRIX_BUILTINS_HPP
+#define HIPSYCL_SSCP_MATRIX_BUILTINS_HPP
+
+// Matrix multiply-accumulate on 16x16 tiles with f16 inputs and an f32
+// accumulator, executed cooperatively by a sub-group. Fragments are arrays of
+// __acpp_sscp_matrix_fragment_words elements per work item, whose content is
+// backend-specific. The layouts of the a and b fragments passed to mad
+// must be the layouts they were loaded with.
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_a_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout);
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_b_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout);
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f32 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout);
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_store_c_f32_m16n16k16(const __acpp_uint32 *frag,
+                                         __acpp_f32 *ptr,
+                                         __acpp_uint64 stride,
+                                         __acpp_sscp_matrix_layout layout);
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_matrix_fill_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        __acpp_f32 value);
+
+/// Computes d = a * b + c. d may be the same fragment as c.
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_mad_f32_f16_m16n16k16(
+    __acpp_uint32 *d, const __acpp_uint32 *a,
+    __acpp_sscp_matrix_layout a_layout, const __acpp_uint32 *b,
+    __acpp_sscp_matrix_layout b_layout, const __acpp_uint32 *c);
+
+#endif
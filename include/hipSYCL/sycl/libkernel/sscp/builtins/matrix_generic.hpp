@@ -0,0 +1,148 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/detail/half_representation.hpp"
+#include "hipSYCL/sycl/libkernel/detail/int_types.hpp"
+
+#ifndef HIPSYCL_SSCP_MATRIX_GENERIC_HPP
+#define HIPSYCL_SSCP_MATRIX_GENERIC_HPP
+
+// Building blocks for the implementations of matrix builtins. This header
+// only relies on standard C++, so that it can also be used outside of
+// the SSCP compilation flow.
+
+enum class __acpp_sscp_matrix_layout : __acpp_int32 {
+  row_major = 0,
+  col_major = 1
+};
+
+/// Number of 32 bit words of a matrix fragment held by each work item
+constexpr __acpp_uint32 __acpp_sscp_matrix_fragment_words = 32;
+/// Number of rows and columns of all tiles of the m16n16k16 shape
+constexpr __acpp_uint32 __acpp_sscp_matrix_tile_extent = 16;
+
+__attribute__((always_inline)) inline __acpp_uint64
+__acpp_sscp_matrix_offset(__acpp_uint32 row, __acpp_uint32 col,
+                          __acpp_uint64 stride,
+                          __acpp_sscp_matrix_layout layout) {
+  return layout == __acpp_sscp_matrix_layout::row_major ? row * stride + col
+                                                        : col * stride + row;
+}
+
+// The generic implementation does not distribute the a and b matrices across
+// the sub-group. Instead, their fragments refer to the memory they were loaded
+// from, which is read by the mad operation.
+
+__attribute__((always_inline)) inline void
+__acpp_sscp_matrix_generic_load_ab(__acpp_uint32 *frag,
+                                   const hipsycl::fp16::half_storage *ptr,
+                                   __acpp_uint64 stride,
+                                   __acpp_sscp_matrix_layout layout) {
+  __builtin_memcpy(frag, &ptr, sizeof(ptr));
+  __builtin_memcpy(frag + 2, &stride, sizeof(stride));
+  frag[4] = static_cast<__acpp_uint32>(layout);
+}
+
+__attribute__((always_inline)) inline float
+__acpp_sscp_matrix_generic_get_ab(const __acpp_uint32 *frag, __acpp_uint32 row,
+                                  __acpp_uint32 col) {
+  const hipsycl::fp16::half_storage *ptr;
+  __acpp_uint64 stride;
+  __builtin_memcpy(&ptr, frag, sizeof(ptr));
+  __builtin_memcpy(&stride, frag + 2, sizeof(stride));
+  auto layout = static_cast<__acpp_sscp_matrix_layout>(frag[4]);
+  return hipsycl::fp16::promote_to_float(
+      ptr[__acpp_sscp_matrix_offset(row, col, stride, layout)]);
+}
+
+// Element e of the accumulator fragment of a work item holds the element
+// local_id + e * sub_group_size of the tile in row-major order. This
+// requires sub-groups of at least 256 / __acpp_sscp_matrix_fragment_words
+// work items.
+template <class F>
+__attribute__((always_inline)) inline void
+__acpp_sscp_matrix_generic_for_each_accumulator_element(
+    __acpp_uint32 local_id, __acpp_uint32 sub_group_size, F f) {
+  constexpr __acpp_uint32 num_elements =
+      __acpp_sscp_matrix_tile_extent * __acpp_sscp_matrix_tile_extent;
+  for (__acpp_uint32 e = 0; e < __acpp_sscp_matrix_fragment_words; ++e) {
+    __acpp_uint32 idx = local_id + e * sub_group_size;
+    if (idx >= num_elements)
+      break;
+    f(e, idx / __acpp_sscp_matrix_tile_extent,
+      idx % __acpp_sscp_matrix_tile_extent);
+  }
+}
+
+__attribute__((always_inline)) inline float
+__acpp_sscp_matrix_generic_word_to_float(__acpp_uint32 x) {
+  float result;
+  __builtin_memcpy(&result, &x, sizeof(result));
+  return result;
+}
+
+__attribute__((always_inline)) inline __acpp_uint32
+__acpp_sscp_matrix_generic_float_to_word(float x) {
+  __acpp_uint32 result;
+  __builtin_memcpy(&result, &x, sizeof(result));
+  return result;
+}
+
+__attribute__((always_inline)) inline void
+__acpp_sscp_matrix_generic_fill_c(__acpp_uint32 *frag, float value) {
+  for (__acpp_uint32 i = 0; i < __acpp_sscp_matrix_fragment_words; ++i)
+    frag[i] = __acpp_sscp_matrix_generic_float_to_word(value);
+}
+
+__attribute__((always_inline)) inline void
+__acpp_sscp_matrix_generic_load_c(__acpp_uint32 *frag, const float *ptr,
+                                  __acpp_uint64 stride,
+                                  __acpp_sscp_matrix_layout layout,
+                                  __acpp_uint32 local_id,
+                                  __acpp_uint32 sub_group_size) {
+  __acpp_sscp_matrix_generic_for_each_accumulator_element(
+      local_id, sub_group_size,
+      [&](__acpp_uint32 e, __acpp_uint32 row, __acpp_uint32 col) {
+        frag[e] = __acpp_sscp_matrix_generic_float_to_word(
+            ptr[__acpp_sscp_matrix_offset(row, col, stride, layout)]);
+      });
+}
+
+__attribute__((always_inline)) inline void
+__acpp_sscp_matrix_generic_store_c(const __acpp_uint32 *frag, float *ptr,
+                                   __acpp_uint64 stride,
+                                   __acpp_sscp_matrix_layout layout,
+                                   __acpp_uint32 local_id,
+                                   __acpp_uint32 sub_group_size) {
+  __acpp_sscp_matrix_generic_for_each_accumulator_element(
+      local_id, sub_group_size,
+      [&](__acpp_uint32 e, __acpp_uint32 row, __acpp_uint32 col) {
+        ptr[__acpp_sscp_matrix_offset(row, col, stride, layout)] =
+            __acpp_sscp_matrix_generic_word_to_float(frag[e]);
+      });
+}
+
+__attribute__((always_inline)) inline void
+__acpp_sscp_matrix_generic_mad(__acpp_uint32 *d, const __acpp_uint32 *a,
+                               const __acpp_uint32 *b, const __acpp_uint32 *c,
+                               __acpp_uint32 local_id,
+                               __acpp_uint32 sub_group_size) {
+  __acpp_sscp_matrix_generic_for_each_accumulator_element(
+      local_id, sub_group_size,
+      [&](__acpp_uint32 e, __acpp_uint32 row, __acpp_uint32 col) {
+        float acc = __acpp_sscp_matrix_generic_word_to_float(c[e]);
+        for (__acpp_uint32 k = 0; k < __acpp_sscp_matrix_tile_extent; ++k)
+          acc += __acpp_sscp_matrix_generic_get_ab(a, row, k) *
+                 __acpp_sscp_matrix_generic_get_ab(b, k, col);
+        d[e] = __acpp_sscp_matrix_generic_float_to_word(acc);
+      });
+}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "builtin_config.hpp"
+#include "algorithm_op.hpp"
+#include "barrier.hpp"
+#include "subgroup.hpp"
+#include "hipSYCL/sycl/libkernel/detail/half_representation.hpp"
+
+#ifndef HIPSYCL_SSCP_REDUCTION_GENERIC_HPP
+#define HIPSYCL_SSCP_REDUCTION_GENERIC_HPP
+
+// Building blocks for the implementations of reduction builtins.
+
+/// Work group reduction composed of sub-group reductions. The totals of the
+/// sub-groups are exchanged through buffer, which must be local memory with
+/// room for one element per sub-group.
+///
+/// \param sub_group_reduce Invoked as sub_group_reduce(op, x)
+template <class T, class LocalPtr, class SubGroupReduce>
+__attribute__((always_inline)) inline T
+__acpp_sscp_work_group_reduce_from_sub_groups(__acpp_sscp_algorithm_op op,
+                                              T x, LocalPtr buffer,
+                                              SubGroupReduce sub_group_reduce) {
+  __acpp_uint32 lid = __acpp_sscp_get_subgroup_local_id();
+  __acpp_uint32 sg_id = __acpp_sscp_get_subgroup_id();
+  __acpp_uint32 num_sgs = __acpp_sscp_get_num_subgroups();
+
+  T total = sub_group_reduce(op, x);
+  if (num_sgs == 1)
+    return total;
+
+  if (lid == 0)
+    buffer[sg_id] = total;
+  __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope::work_group,
+                                 __acpp_sscp_memory_order::acq_rel);
+
+  if (sg_id == 0) {
+    if (num_sgs <= __acpp_sscp_get_subgroup_max_size()) {
+      total = lid < num_sgs ? T{buffer[lid]}
+                            : __acpp_sscp_get_algorithm_op_identity<T>(op);
+      total = sub_group_reduce(op, total);
+    } else {
+      total = buffer[0];
+      for (__acpp_uint32 i = 1; i < num_sgs; ++i)
+        total = __acpp_sscp_apply_algorithm_op(op, total, T{buffer[i]});
+    }
+    if (lid == 0)
+      buffer[0] = total;
+  }
+  __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope::work_group,
+                                 __acpp_sscp_memory_order::acq_rel);
+
+  T result = buffer[0];
+  // The buffer might be reused by the next reduction
+  __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope::work_group,
+                                 __acpp_sscp_memory_order::acq_rel);
+  return result;
+}
+
+/// Defines the reduction builtins in terms of the functions
+/// work_group_reduce(op, x) and sub_group_reduce(op, x) of the backend.
+/// Half precision values are reduced in single precision.
+#define HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(suffix, type)                   \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type __acpp_sscp_work_group_reduce_##suffix( \
+      __acpp_sscp_algorithm_op op, type x) {                                   \
+    return work_group_reduce(op, x);                                           \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type __acpp_sscp_sub_group_reduce_##suffix(  \
+      __acpp_sscp_algorithm_op op, type x) {                                   \
+    return sub_group_reduce(op, x);                                            \
+  }
+
+#define HIPSYCL_SSCP_DEFINE_ALL_REDUCTION_BUILTINS()                           \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(i8, __acpp_int8)                      \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(i16, __acpp_int16)                    \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(i32, __acpp_int32)                    \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(i64, __acpp_int64)                    \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(u8, __acpp_uint8)                     \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(u16, __acpp_uint16)                   \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(u32, __acpp_uint32)                   \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(u64, __acpp_uint64)                   \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(f32, __acpp_f32)                      \
+  HIPSYCL_SSCP_DEFINE_REDUCTION_BUILTINS(f64, __acpp_f64)                      \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f16                                   \
+  __acpp_sscp_work_group_reduce_f16(__acpp_sscp_algorithm_op op,              \
+                                    __acpp_f16 x) {                            \
+    return hipsycl::fp16::create(                                              \
+        work_group_reduce(op, hipsycl::fp16::promote_to_float(x)));            \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f16                                   \
+  __acpp_sscp_sub_group_reduce_f16(__acpp_sscp_algorithm_op op,               \
+                                   __acpp_f16 x) {                             \
+    return hipsycl::fp16::create(                                              \
+        sub_group_reduce(op, hipsycl::fp16::promote_to_float(x)));             \
+  }
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "builtin_config.hpp"
+#include "algorithm_op.hpp"
+#include "barrier.hpp"
+#include "subgroup.hpp"
+#include "hipSYCL/sycl/libkernel/detail/half_representation.hpp"
+
+#ifndef HIPSYCL_SSCP_SCAN_GENERIC_HPP
+#define HIPSYCL_SSCP_SCAN_GENERIC_HPP
+
+// Building blocks for the implementations of scan builtins.
+
+/// Sub-group scan in log2(sub-group size) steps, each of which combines
+/// the value with that of the work item 2^step below it.
+template <class T, class ShuffleUp32>
+__attribute__((always_inline)) inline T
+__acpp_sscp_sub_group_shuffle_scan(__acpp_sscp_algorithm_op op, T x,
+                                   bool inclusive, ShuffleUp32 shuffle_up) {
+  __acpp_uint32 lid = __acpp_sscp_get_subgroup_local_id();
+  __acpp_uint32 max_size = __acpp_sscp_get_subgroup_max_size();
+  T scan = x;
+  for (__acpp_uint32 delta = 1; delta < max_size; delta *= 2) {
+    T other = __acpp_sscp_shuffle(scan, delta, shuffle_up);
+    if (lid >= delta)
+      scan = __acpp_sscp_apply_algorithm_op(op, other, scan);
+  }
+  if (inclusive)
+    return scan;
+
+  T previous = __acpp_sscp_shuffle(scan, 1, shuffle_up);
+  return lid == 0 ? __acpp_sscp_get_algorithm_op_identity<T>(op) : previous;
+}
+
+/// Work group scan composed of sub-group scans. The totals of the sub-groups
+/// are exchanged through buffer, which must be local memory with room for
+/// one element per sub-group.
+///
+/// \param sub_group_scan Invoked as sub_group_scan(op, x, inclusive)
+template <class T, class LocalPtr, class SubGroupScan>
+__attribute__((always_inline)) inline T
+__acpp_sscp_work_group_scan_from_sub_groups(__acpp_sscp_algorithm_op op, T x,
+                                            bool inclusive, LocalPtr buffer,
+                                            SubGroupScan sub_group_scan) {
+  __acpp_uint32 lid = __acpp_sscp_get_subgroup_local_id();
+  __acpp_uint32 sg_id = __acpp_sscp_get_subgroup_id();
+  __acpp_uint32 num_sgs = __acpp_sscp_get_num_subgroups();
+  const T identity = __acpp_sscp_get_algorithm_op_identity<T>(op);
+
+  T scan = sub_group_scan(op, x, inclusive);
+  if (lid == __acpp_sscp_get_subgroup_size() - 1)
+    buffer[sg_id] =
+        inclusive ? scan : __acpp_sscp_apply_algorithm_op(op, scan, x);
+  __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope::work_group,
+                                 __acpp_sscp_memory_order::acq_rel);
+
+  // Turn the sub-group totals into their inclusive scan
+  if (sg_id == 0) {
+    if (num_sgs <= __acpp_sscp_get_subgroup_max_size()) {
+      T total = lid < num_sgs ? buffer[lid] : identity;
+      total = sub_group_scan(op, total, true);
+      if (lid < num_sgs)
+        buffer[lid] = total;
+    } else if (lid == 0) {
+      T total = buffer[0];
+      for (__acpp_uint32 i = 1; i < num_sgs; ++i) {
+        total = __acpp_sscp_apply_algorithm_op(op, total, T{buffer[i]});
+        buffer[i] = total;
+      }
+    }
+  }
+  __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope::work_group,
+                                 __acpp_sscp_memory_order::acq_rel);
+
+  T result =
+      sg_id > 0 ? __acpp_sscp_apply_algorithm_op(op, T{buffer[sg_id - 1]}, scan)
+                : scan;
+  // The buffer might be reused by the next scan
+  __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope::work_group,
+                                 __acpp_sscp_memory_order::acq_rel);
+  return result;
+}
+
+/// Defines the scan builtins for a type in terms of the functions
+/// work_group_scan(op, x, inclusive) and sub_group_scan(op, x, inclusive)
+/// of the backend.
+#define HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(suffix, type)                        \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __acpp_sscp_work_group_inclusive_scan_##suffix(                          \
+          __acpp_sscp_algorithm_op op, type x) {                               \
+    return work_group_scan(op, x, true);                                       \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __acpp_sscp_work_group_exclusive_scan_##suffix(                          \
+          __acpp_sscp_algorithm_op op, type x) {                               \
+    return work_group_scan(op, x, false);                                      \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __acpp_sscp_sub_group_inclusive_scan_##suffix(                           \
+          __acpp_sscp_algorithm_op op, type x) {                               \
+    return sub_group_scan(op, x, true);                                        \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN type                                         \
+      __acpp_sscp_sub_group_exclusive_scan_##suffix(                           \
+          __acpp_sscp_algorithm_op op, type x) {                               \
+    return sub_group_scan(op, x, false);                                       \
+  }
+
+/// Defines the half precision scan builtins, which scan in single precision.
+#define HIPSYCL_SSCP_DEFINE_F16_SCAN_BUILTINS()                                \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f16                                   \
+  __acpp_sscp_work_group_inclusive_scan_f16(__acpp_sscp_algorithm_op op,       \
+                                            __acpp_f16 x) {                    \
+    return hipsycl::fp16::create(                                              \
+        work_group_scan(op, hipsycl::fp16::promote_to_float(x), true));        \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f16                                   \
+  __acpp_sscp_work_group_exclusive_scan_f16(__acpp_sscp_algorithm_op op,       \
+                                            __acpp_f16 x) {                    \
+    return hipsycl::fp16::create(                                              \
+        work_group_scan(op, hipsycl::fp16::promote_to_float(x), false));       \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f16                                   \
+  __acpp_sscp_sub_group_inclusive_scan_f16(__acpp_sscp_algorithm_op op,        \
+                                           __acpp_f16 x) {                     \
+    return hipsycl::fp16::create(                                              \
+        sub_group_scan(op, hipsycl::fp16::promote_to_float(x), true));         \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f16                                   \
+  __acpp_sscp_sub_group_exclusive_scan_f16(__acpp_sscp_algorithm_op op,        \
+                                           __acpp_f16 x) {                     \
+    return hipsycl::fp16::create(                                              \
+        sub_group_scan(op, hipsycl::fp16::promote_to_float(x), false));        \
+  }
+
+#define HIPSYCL_SSCP_DEFINE_ALL_SCAN_BUILTINS()                                \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(i8, __acpp_int8)                           \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(i16, __acpp_int16)                         \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(i32, __acpp_int32)                         \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(i64, __acpp_int64)                         \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(u8, __acpp_uint8)                          \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(u16, __acpp_uint16)                        \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(u32, __acpp_uint32)                        \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(u64, __acpp_uint64)                        \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(f32, __acpp_f32)                           \
+  HIPSYCL_SSCP_DEFINE_SCAN_BUILTINS(f64, __acpp_f64)                           \
+  HIPSYCL_SSCP_DEFINE_F16_SCAN_BUILTINS()
+
+#endif
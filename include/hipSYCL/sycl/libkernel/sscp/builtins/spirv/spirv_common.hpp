@@ -39,6 +39,12 @@ enum MemorySemanticsMaskFlag : __acpp_uint32 {
   ImageMemory = 0x800
 };
 
+enum GroupOperation : __acpp_uint32 {
+  Reduce = 0,
+  InclusiveScan = 1,
+  ExclusiveScan = 2
+};
+
 }
 
 
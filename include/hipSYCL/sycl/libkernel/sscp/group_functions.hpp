@@ -34,6 +34,7 @@
 #include "builtins/broadcast.hpp"
 #include "builtins/collpredicate.hpp"
 #include "builtins/reduction.hpp"
+#include "builtins/scan.hpp"
 #include "builtins/shuffle.hpp"
 
 namespace hipsycl {
@@ -328,7 +329,7 @@ HIPSYCL_SSCP_MAP_GROUP_BINARY_IDENTITY(__acpp_sscp_algorithm_op::multiply, T{1})
 // TODO This is not really correct for floating point - those should use infinity. But then, what about
 // compilation with -ffast-math?
 HIPSYCL_SSCP_MAP_GROUP_BINARY_IDENTITY(__acpp_sscp_algorithm_op::min, T{std::numeric_limits<T>::max()})
-HIPSYCL_SSCP_MAP_GROUP_BINARY_IDENTITY(__acpp_sscp_algorithm_op::max, T{std::numeric_limits<T>::min()})
+HIPSYCL_SSCP_MAP_GROUP_BINARY_IDENTITY(__acpp_sscp_algorithm_op::max, T{std::numeric_limits<T>::lowest()})
 HIPSYCL_SSCP_MAP_GROUP_BINARY_IDENTITY(__acpp_sscp_algorithm_op::bit_and, ~T{0})
 HIPSYCL_SSCP_MAP_GROUP_BINARY_IDENTITY(__acpp_sscp_algorithm_op::bit_or, T{0})
 HIPSYCL_SSCP_MAP_GROUP_BINARY_IDENTITY(__acpp_sscp_algorithm_op::bit_xor, T{0})
@@ -556,36 +557,189 @@ T __acpp_joint_reduce(Group g, Ptr first, Ptr last, T init,
   return binary_op(__acpp_joint_reduce(g, first, last, binary_op), init);
 }
 
-// exclusive_scan
+// scans
+
+#define HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(builtin_prefix)                      \
+  template <class T>                                                           \
+  HIPSYCL_BUILTIN T builtin_prefix(__acpp_sscp_algorithm_op op, T x) {         \
+    if constexpr (std::is_same_v<T, half>) {                                   \
+      return detail::create_half(                                              \
+          builtin_prefix##_f16(op, detail::get_half_storage(x)));              \
+    } else if constexpr (std::is_same_v<T, float>) {                           \
+      return builtin_prefix##_f32(op, x);                                      \
+    } else if constexpr (std::is_same_v<T, double>) {                          \
+      return builtin_prefix##_f64(op, x);                                      \
+    } else if constexpr (std::is_signed_v<T>) {                                \
+      if constexpr (sizeof(T) == 1) {                                          \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i8(op, maybe_bit_cast<__acpp_int8>(x)));          \
+      } else if constexpr (sizeof(T) == 2) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i16(op, maybe_bit_cast<__acpp_int16>(x)));        \
+      } else if constexpr (sizeof(T) == 4) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i32(op, maybe_bit_cast<__acpp_int32>(x)));        \
+      } else {                                                                 \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_i64(op, maybe_bit_cast<__acpp_int64>(x)));        \
+      }                                                                        \
+    } else {                                                                   \
+      if constexpr (sizeof(T) == 1) {                                          \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u8(op, maybe_bit_cast<__acpp_uint8>(x)));         \
+      } else if constexpr (sizeof(T) == 2) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u16(op, maybe_bit_cast<__acpp_uint16>(x)));       \
+      } else if constexpr (sizeof(T) == 4) {                                   \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u32(op, maybe_bit_cast<__acpp_uint32>(x)));       \
+      } else {                                                                 \
+        return maybe_bit_cast<T>(                                              \
+            builtin_prefix##_u64(op, maybe_bit_cast<__acpp_uint64>(x)));       \
+      }                                                                        \
+    }                                                                          \
+  }
 
+template <class T>
+inline constexpr bool is_scalar_scan_type_v =
+    std::is_arithmetic_v<T> || std::is_same_v<T, half>;
 
-template <int Dim, typename V, typename T, typename BinaryOperation>
-HIPSYCL_BUILTIN T __acpp_exclusive_scan_over_group(
-    group<Dim> g, V x, T init, BinaryOperation binary_op);
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__acpp_sscp_work_group_inclusive_scan)
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__acpp_sscp_work_group_exclusive_scan)
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__acpp_sscp_sub_group_inclusive_scan)
+HIPSYCL_SSCP_DEFINE_SCAN_DISPATCH(__acpp_sscp_sub_group_exclusive_scan)
+
+template <int Dim, typename T, typename BinaryOperation,
+          std::enable_if_t<is_scalar_scan_type_v<T>, int> = 0>
+HIPSYCL_BUILTIN T __acpp_sscp_inclusive_scan(group<Dim> g, T x,
+                                             BinaryOperation binary_op) {
+  return __acpp_sscp_work_group_inclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
+
+template <typename T, typename BinaryOperation,
+          std::enable_if_t<is_scalar_scan_type_v<T>, int> = 0>
+HIPSYCL_BUILTIN T __acpp_sscp_inclusive_scan(sub_group g, T x,
+                                             BinaryOperation binary_op) {
+  return __acpp_sscp_sub_group_inclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
+
+template <int Dim, typename T, typename BinaryOperation,
+          std::enable_if_t<is_scalar_scan_type_v<T>, int> = 0>
+HIPSYCL_BUILTIN T __acpp_sscp_exclusive_scan(group<Dim> g, T x,
+                                             BinaryOperation binary_op) {
+  return __acpp_sscp_work_group_exclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
+
+template <typename T, typename BinaryOperation,
+          std::enable_if_t<is_scalar_scan_type_v<T>, int> = 0>
+HIPSYCL_BUILTIN T __acpp_sscp_exclusive_scan(sub_group g, T x,
+                                             BinaryOperation binary_op) {
+  return __acpp_sscp_sub_group_exclusive_scan(
+      sscp_binary_operation_v<BinaryOperation>, x);
+}
+
+template <typename Group, typename T, int N, typename BinaryOperation>
+HIPSYCL_BUILTIN vec<T, N> __acpp_sscp_inclusive_scan(Group g, vec<T, N> x,
+                                                     BinaryOperation binary_op) {
+  vec<T, N> result;
+  for(int i = 0; i < N; ++i)
+    result[i] = __acpp_sscp_inclusive_scan(g, x[i], binary_op);
+  return result;
+}
+
+template <typename Group, typename T, int N, typename BinaryOperation>
+HIPSYCL_BUILTIN marray<T, N>
+__acpp_sscp_inclusive_scan(Group g, marray<T, N> x, BinaryOperation binary_op) {
+  marray<T, N> result;
+  for(int i = 0; i < N; ++i)
+    result[i] = __acpp_sscp_inclusive_scan(g, x[i], binary_op);
+  return result;
+}
+
+template <typename Group, typename T, int N, typename BinaryOperation>
+HIPSYCL_BUILTIN vec<T, N> __acpp_sscp_exclusive_scan(Group g, vec<T, N> x,
+                                                     BinaryOperation binary_op) {
+  vec<T, N> result;
+  for(int i = 0; i < N; ++i)
+    result[i] = __acpp_sscp_exclusive_scan(g, x[i], binary_op);
+  return result;
+}
+
+template <typename Group, typename T, int N, typename BinaryOperation>
+HIPSYCL_BUILTIN marray<T, N>
+__acpp_sscp_exclusive_scan(Group g, marray<T, N> x, BinaryOperation binary_op) {
+  marray<T, N> result;
+  for(int i = 0; i < N; ++i)
+    result[i] = __acpp_sscp_exclusive_scan(g, x[i], binary_op);
+  return result;
+}
 
+// exclusive_scan
 
-template <typename V, typename T, typename BinaryOperation>
+template <typename Group, typename V, typename T, typename BinaryOperation,
+          std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN T __acpp_exclusive_scan_over_group(
-    sub_group g, V x, T init, BinaryOperation binary_op);
+    Group g, V x, T init, BinaryOperation binary_op) {
+  // The exclusive scan yields the identity for the first work item
+  return binary_op(init,
+                   __acpp_sscp_exclusive_scan(g, static_cast<T>(x), binary_op));
+}
 
 template <typename Group, typename T, typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN T
-__acpp_exclusive_scan_over_group(Group g, T x, BinaryOperation binary_op);
+__acpp_exclusive_scan_over_group(Group g, T x, BinaryOperation binary_op) {
+  return __acpp_sscp_exclusive_scan(g, x, binary_op);
+}
 
 template <typename Group, typename InPtr, typename OutPtr, typename T,
           typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN OutPtr
 __acpp_joint_exclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               T init, BinaryOperation binary_op);
+                               T init, BinaryOperation binary_op) {
+  const size_t lrange       = g.get_local_range().size();
+  const size_t num_elements = last - first;
+  const size_t lid          = g.get_local_linear_id();
+
+  // Each iteration scans one element per work item, and carries the
+  // total of all elements so far over to the next iteration.
+  T carry = init;
+  for (size_t offset = 0; offset < num_elements; offset += lrange) {
+    const size_t i = offset + lid;
+    T local = sscp_binary_operation_identity<
+        T, sscp_binary_operation_v<BinaryOperation>>::get();
+    if (i < num_elements)
+      local = first[i];
+
+    T scan = __acpp_sscp_exclusive_scan(g, local, binary_op);
+    if (i < num_elements)
+      result[i] = binary_op(carry, scan);
+    carry = binary_op(carry, __acpp_group_broadcast(
+                                 g, binary_op(scan, local),
+                                 static_cast<typename Group::linear_id_type>(
+                                     lrange - 1)));
+  }
+  return result + num_elements;
+}
 
 template <typename Group, typename InPtr, typename OutPtr,
           typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN OutPtr
 __acpp_joint_exclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               BinaryOperation binary_op);
+                               BinaryOperation binary_op) {
+  using value_type =
+      std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+  return __acpp_joint_exclusive_scan(
+      g, first, last, result,
+      sscp_binary_operation_identity<
+          value_type, sscp_binary_operation_v<BinaryOperation>>::get(),
+      binary_op);
+}
 
 // inclusive_scan
 
@@ -594,30 +748,57 @@ template <typename Group, typename InPtr, typename OutPtr, typename T,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN OutPtr
 __acpp_joint_inclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               BinaryOperation binary_op, T init);
+                               BinaryOperation binary_op, T init) {
+  const size_t lrange       = g.get_local_range().size();
+  const size_t num_elements = last - first;
+  const size_t lid          = g.get_local_linear_id();
+
+  T carry = init;
+  for (size_t offset = 0; offset < num_elements; offset += lrange) {
+    const size_t i = offset + lid;
+    T local = sscp_binary_operation_identity<
+        T, sscp_binary_operation_v<BinaryOperation>>::get();
+    if (i < num_elements)
+      local = first[i];
+
+    T scan = __acpp_sscp_inclusive_scan(g, local, binary_op);
+    if (i < num_elements)
+      result[i] = binary_op(carry, scan);
+    carry = binary_op(carry, __acpp_group_broadcast(
+                                 g, scan,
+                                 static_cast<typename Group::linear_id_type>(
+                                     lrange - 1)));
+  }
+  return result + num_elements;
+}
 
 template <typename Group, typename InPtr, typename OutPtr,
           typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN OutPtr
 __acpp_joint_inclusive_scan(Group g, InPtr first, InPtr last, OutPtr result,
-                               BinaryOperation binary_op);
-
-template <int Dim, typename T, typename BinaryOperation>
-HIPSYCL_BUILTIN
-T __acpp_inclusive_scan_over_group(
-    group<Dim> g, T x, BinaryOperation binary_op);
+                               BinaryOperation binary_op) {
+  using value_type =
+      std::remove_cv_t<std::remove_reference_t<decltype(*first)>>;
+  return __acpp_joint_inclusive_scan(
+      g, first, last, result, binary_op,
+      sscp_binary_operation_identity<
+          value_type, sscp_binary_operation_v<BinaryOperation>>::get());
+}
 
-template <typename T, typename BinaryOperation>
-HIPSYCL_BUILTIN T __acpp_inclusive_scan_over_group(
-    sub_group g, T x, BinaryOperation binary_op);
+template <typename Group, typename T, typename BinaryOperation,
+          std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
+HIPSYCL_BUILTIN T
+__acpp_inclusive_scan_over_group(Group g, T x, BinaryOperation binary_op) {
+  return __acpp_sscp_inclusive_scan(g, x, binary_op);
+}
 
 template <typename Group, typename V, typename T, typename BinaryOperation,
           std::enable_if_t<is_group_v<std::decay_t<Group>>, bool> = true>
 HIPSYCL_BUILTIN T __acpp_inclusive_scan_over_group(
     Group g, V x, T init, BinaryOperation binary_op) {
-  auto scan = __acpp_inclusive_scan_over_group(g, T{x}, binary_op);
-  return binary_op(scan, init);
+  return binary_op(init,
+                   __acpp_sscp_inclusive_scan(g, static_cast<T>(x), binary_op));
 }
 
 // shift_left
@@ -11,12 +11,11 @@
 #ifndef HIPSYCL_OUTPUT_STREAM_HPP
 #define HIPSYCL_OUTPUT_STREAM_HPP
 
-#include <cstdio>
+#include <cstddef>
 
 #include "hipSYCL/sycl/libkernel/backend.hpp"
-#ifdef ACPP_LIBKERNEL_IS_DEVICE_PASS_SSCP
-#include "hipSYCL/sycl/libkernel/sscp/builtins/print.hpp"
-#endif
+#include "hipSYCL/sycl/libkernel/atomic_builtins.hpp"
+#include "hipSYCL/sycl/libkernel/memory.hpp"
 
 #include "id.hpp"
 #include "range.hpp"
@@ -30,20 +29,25 @@
 namespace hipsycl {
 namespace sycl {
 
+class handler;
+
 namespace detail {
 
-template<typename... Args>
-void print(const char* s, Args... args) {
-  __acpp_backend_switch(
-    printf(s, args...),
-    if constexpr(sizeof...(args) == 0) {
-      __acpp_sscp_print(s);
-    } else {
-      __acpp_sscp_print("Type not yet supported for printing with generic target\n");
-    },
-    printf(s, args...),
-    printf(s, args...));
-}
+// Output of streams is not printed by the device. Instead, it is appended
+// to a buffer in shared USM, which the host writes to stdout once the
+// command group has completed. The buffer starts with this header, followed
+// by the output.
+struct stream_buffer_header {
+  // Offset of the next output; may exceed the buffer size if output was
+  // truncated.
+  unsigned long long write_offset;
+};
+
+// Allocates a zero-initialized stream buffer of buffer_size bytes, and
+// registers it with the command group. Defined in handler.hpp.
+void *allocate_stream_buffer(sycl::handler &cgh, std::size_t buffer_size);
+
+struct stream_writer;
 
 }
 
@@ -80,11 +84,21 @@ const stream_manipulator defaultfloat = stream_manipulator::defaultfloat;
 //__width_manipulator__ setw(int width);
 
 class stream {
+  friend struct detail::stream_writer;
 public:
   ACPP_UNIVERSAL_TARGET
-  stream(size_t totalBufferSize, size_t workItemBufferSize, handler&)
-  : _total_buff_size{totalBufferSize}, _work_item_buff_size{workItemBufferSize}
-  {}
+  stream(size_t totalBufferSize, size_t workItemBufferSize, handler& cgh)
+  : _total_buff_size{totalBufferSize}, _work_item_buff_size{workItemBufferSize},
+    _header{nullptr}, _data{nullptr}
+  {
+    __acpp_if_target_host(
+      void *buffer = detail::allocate_stream_buffer(
+          cgh, sizeof(detail::stream_buffer_header) + totalBufferSize);
+      _header = static_cast<detail::stream_buffer_header *>(buffer);
+      _data = static_cast<char *>(buffer) +
+              sizeof(detail::stream_buffer_header);
+    );
+  }
   /* -- common interface members -- */
   ACPP_UNIVERSAL_TARGET
   size_t get_size() const { return _total_buff_size; }
@@ -100,111 +114,232 @@ public:
 private:
   size_t _total_buff_size;
   size_t _work_item_buff_size;
+  detail::stream_buffer_header* _header;
+  char* _data;
 };
 
-#if ACPP_LIBKERNEL_IS_DEVICE_PASS_HIP &&                                    \
-    !defined(HIPSYCL_EXPERIMENTAL_ROCM_PRINTF)
+namespace detail {
 
-template<class T>
-[[deprecated("sycl::stream in hipSYCL requires backend printf() support, "
-    "printf is however still experimental in AMD ROCm when compiling with clang. "
-    "Define HIPSYCL_EXPERIMENTAL_ROCM_PRINTF to attempt to use it. Otherwise, "
-    "uses of the stream class will be transformed into no operations.")]]
-ACPP_KERNEL_TARGET
-const stream& operator<<(const stream& os, T v) {
-  return os;
-}
+struct stream_writer {
+  // Output of a single call is never interleaved with output of other
+  // work items. Output that does not fit into the buffer is dropped.
+  ACPP_KERNEL_TARGET
+  static void write(const stream &os, const char *data, std::size_t size) {
+    if(size == 0)
+      return;
+    unsigned long long offset =
+        __acpp_atomic_fetch_add<access::address_space::global_space>(
+            &os._header->write_offset, static_cast<unsigned long long>(size),
+            memory_order::relaxed, memory_scope::device);
+    if(offset >= os._total_buff_size)
+      return;
+    std::size_t remaining = os._total_buff_size - offset;
+    if(size > remaining)
+      size = remaining;
+    for(std::size_t i = 0; i < size; ++i)
+      os._data[offset + i] = data[i];
+  }
+
+  ACPP_KERNEL_TARGET
+  static void write_string(const stream &os, const char *s) {
+    std::size_t size = 0;
+    while(s[size] != '\0')
+      ++size;
+    write(os, s, size);
+  }
+
+  ACPP_KERNEL_TARGET
+  static void write_char(const stream &os, char c) {
+    write(os, &c, 1);
+  }
+
+  ACPP_KERNEL_TARGET
+  static void write_unsigned(const stream &os, unsigned long long v,
+                             bool is_negative = false) {
+    // Sufficient for the sign and all decimal digits of 64 bit integers
+    constexpr int max_size = 21;
+    char buffer[max_size];
+    int pos = max_size;
+    do {
+      buffer[--pos] = static_cast<char>('0' + v % 10);
+      v /= 10;
+    } while(v != 0);
+    if(is_negative)
+      buffer[--pos] = '-';
+    write(os, buffer + pos, max_size - pos);
+  }
+
+  ACPP_KERNEL_TARGET
+  static void write_signed(const stream &os, long long v) {
+    if(v < 0)
+      // Avoids overflow for the smallest value
+      write_unsigned(os, 0ull - static_cast<unsigned long long>(v), true);
+    else
+      write_unsigned(os, static_cast<unsigned long long>(v));
+  }
+
+  ACPP_KERNEL_TARGET
+  static void write_pointer(const stream &os, const void *ptr) {
+    constexpr int max_size = 2 + 2 * sizeof(void*);
+    char buffer[max_size];
+    int pos = max_size;
+    auto v = reinterpret_cast<unsigned long long>(ptr);
+    do {
+      buffer[--pos] = "0123456789abcdef"[v % 16];
+      v /= 16;
+    } while(v != 0);
+    buffer[--pos] = 'x';
+    buffer[--pos] = '0';
+    write(os, buffer + pos, max_size - pos);
+  }
+
+  // Equivalent to printf("%f") for values below 1e18, and printf("%e")
+  // otherwise.
+  ACPP_KERNEL_TARGET
+  static void write_floating(const stream &os, double v) {
+    if(v != v) {
+      write_string(os, "nan");
+      return;
+    }
+    if(v < 0) {
+      write_char(os, '-');
+      v = -v;
+    }
+    if(v > 1.7976931348623157e308) {
+      write_string(os, "inf");
+      return;
+    }
+
+    int exponent = 0;
+    const bool is_scientific = v >= 1e18;
+    if(is_scientific) {
+      while(v >= 10.0) {
+        v /= 10.0;
+        ++exponent;
+      }
+    }
+
+    constexpr unsigned long long fraction_scale = 1000000;
+    auto integral = static_cast<unsigned long long>(v);
+    auto fraction = static_cast<unsigned long long>(
+        (v - static_cast<double>(integral)) * fraction_scale + 0.5);
+    if(fraction >= fraction_scale) {
+      fraction -= fraction_scale;
+      ++integral;
+      if(is_scientific && integral == 10) {
+        integral = 1;
+        ++exponent;
+      }
+    }
+
+    write_unsigned(os, integral);
+    char buffer[7];
+    buffer[0] = '.';
+    for(int i = 6; i > 0; --i) {
+      buffer[i] = static_cast<char>('0' + fraction % 10);
+      fraction /= 10;
+    }
+    write(os, buffer, 7);
+
+    if(is_scientific) {
+      write_string(os, "e+");
+      if(exponent < 100)
+        write_char(os, '0' + exponent / 10);
+      write_unsigned(os, exponent < 100 ? exponent % 10 : exponent);
+    }
+  }
+};
 
-#else
+}
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, stream_manipulator manip) {
   if(manip == endl)
-    detail::print("\n");
+    detail::stream_writer::write_char(os, '\n');
   // Other stream_manipulators are not yet supported
   return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, char v){
-  detail::print("%c", v); return os;
+  detail::stream_writer::write_char(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, unsigned char v){
-  detail::print("%hhu", v); return os;
+  detail::stream_writer::write_unsigned(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, short v){
-  detail::print("%hd", v); return os;
+  detail::stream_writer::write_signed(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, unsigned short v){
-  detail::print("%hu", v); return os;
+  detail::stream_writer::write_unsigned(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, int v){
-  detail::print("%d", v); return os;
+  detail::stream_writer::write_signed(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, unsigned int v){
-  detail::print("%u", v); return os;
+  detail::stream_writer::write_unsigned(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, long v){
-  detail::print("%ld", v); return os;
+  detail::stream_writer::write_signed(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, unsigned long v){
-  detail::print("%lu", v); return os;
+  detail::stream_writer::write_unsigned(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, long long v){
-  detail::print("%lld", v); return os;
+  detail::stream_writer::write_signed(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, unsigned long long v){
-  detail::print("%llu", v); return os;
+  detail::stream_writer::write_unsigned(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, char* v) {
-  detail::print(v); return os;
+  detail::stream_writer::write_string(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, const char* v) {
-  detail::print(v); return os;
+  detail::stream_writer::write_string(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, float v){
-  detail::print("%f", v); return os;
+  detail::stream_writer::write_floating(os, v); return os;
 }
 
 ACPP_KERNEL_TARGET
 inline const stream& operator<<(const stream& os, double v){
-  detail::print("%f", v); return os;
+  detail::stream_writer::write_floating(os, v); return os;
 }
 
 template<class T>
 ACPP_KERNEL_TARGET
 const stream& operator<<(const stream& os, T* v) {
-  detail::print("%p", v); return os;
+  detail::stream_writer::write_pointer(os, v); return os;
 }
 
 template<class T>
 ACPP_KERNEL_TARGET
 const stream& operator<<(const stream& os, const T* v){
-  detail::print("%p", v); return os;
+  detail::stream_writer::write_pointer(os, v); return os;
 }
 
 template<int Dim>
@@ -314,8 +449,6 @@ const stream& operator<<(const stream& os, multi_ptr<ElementType, Space> v){
   return os;
 }
 
-#endif
-
 }
 }
 
@@ -569,9 +569,26 @@ public:
             std::enable_if_t<std::is_integral_v<t>, bool> = true>
   HIPSYCL_DEFINE_BINARY_VEC_OP_VEC_VEC(%, t)
 
-  HIPSYCL_DEFINE_BINARY_VEC_OP_VEC_VEC(+, T)
-  HIPSYCL_DEFINE_BINARY_VEC_OP_VEC_VEC(-, T)
-  HIPSYCL_DEFINE_BINARY_VEC_OP_VEC_VEC(*, T)
+// Half precision vectors may use packed arithmetic
+#define HIPSYCL_DEFINE_ARITHMETIC_VEC_OP_VEC_VEC(op, t, half_op)               \
+  ACPP_UNIVERSAL_TARGET                                                     \
+  friend vec<t, N> operator op(const vec &lhs, const vec &rhs) {               \
+    vec<t, N> result;                                                          \
+    if constexpr (std::is_same_v<t, half>) {                                   \
+      detail::elementwise_half_arithmetic<                                     \
+          detail::half_arithmetic_op::half_op>(lhs._data, rhs._data,           \
+                                               result._data, N);               \
+    } else {                                                                   \
+      for (int i = 0; i < N; ++i) {                                            \
+        result._data[i] = lhs._data[i] op rhs._data[i];                        \
+      }                                                                        \
+    }                                                                          \
+    return result;                                                             \
+  }
+
+  HIPSYCL_DEFINE_ARITHMETIC_VEC_OP_VEC_VEC(+, T, add)
+  HIPSYCL_DEFINE_ARITHMETIC_VEC_OP_VEC_VEC(-, T, sub)
+  HIPSYCL_DEFINE_ARITHMETIC_VEC_OP_VEC_VEC(*, T, mul)
   HIPSYCL_DEFINE_BINARY_VEC_OP_VEC_VEC(/, T)
 
   template <typename t = T,
@@ -0,0 +1,189 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SYCL_MPI_HPP
+#define HIPSYCL_SYCL_MPI_HPP
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+#include "backend.hpp"
+#include "event.hpp"
+#include "exception.hpp"
+#include "interop_handle.hpp"
+#include "queue.hpp"
+
+// MPICH >= 4.1 allows enqueuing communication into CUDA/HIP streams
+#ifdef MPIX_STREAM_NULL
+ #define ACPP_MPI_STREAM_TRIGGERED
+#endif
+
+namespace hipsycl {
+namespace sycl {
+namespace mpi {
+
+/// Communicator whose operations are ordered with the other operations of
+/// an in-order queue, such that buffers produced or consumed by kernels can
+/// be communicated without waiting for the queue.
+///
+/// On CUDA and HIP devices, communication is enqueued into the stream of the
+/// queue using the stream-triggered operations of the MPI implementation,
+/// so it does not require synchronization with the host. On the OpenMP
+/// backend, communication is performed by the worker thread of the queue,
+/// which requires at least MPI_THREAD_SERIALIZED.
+class stream_communicator {
+public:
+  /// Collective over \c comm. \c q must be an in-order queue.
+  stream_communicator(queue &q, MPI_Comm comm)
+  : _q{q}, _comm{MPI_COMM_NULL}, _is_stream_triggered{false} {
+    if(!q.is_in_order())
+      throw exception{make_error_code(errc::invalid),
+                      "mpi::stream_communicator: Queue must be in-order"};
+
+    backend b = q.get_device().get_backend();
+    if(b == backend::omp) {
+      int provided = MPI_THREAD_SINGLE;
+      MPI_Query_thread(&provided);
+      if(provided < MPI_THREAD_SERIALIZED)
+        throw exception{make_error_code(errc::feature_not_supported),
+                        "mpi::stream_communicator: MPI must be initialized "
+                        "with at least MPI_THREAD_SERIALIZED"};
+      check(MPI_Comm_dup(comm, &_comm), "MPI_Comm_dup()");
+      return;
+    }
+#ifdef ACPP_MPI_STREAM_TRIGGERED
+    if(b == backend::cuda || b == backend::hip) {
+      rt::inorder_executor* exec = q.AdaptiveCpp_inorder_executor();
+      if(!exec)
+        throw exception{make_error_code(errc::feature_not_supported),
+                        "mpi::stream_communicator: Queue does not have a "
+                        "dedicated backend stream"};
+      void* native_stream = exec->get_queue()->get_native_type();
+
+      MPI_Info info;
+      check(MPI_Info_create(&info), "MPI_Info_create()");
+      MPI_Info_set(info, "type",
+                   b == backend::cuda ? "cudaStream_t" : "hipStream_t");
+      MPIX_Info_set_hex(info, "value", &native_stream, sizeof(native_stream));
+      int err = MPIX_Stream_create(info, &_stream);
+      MPI_Info_free(&info);
+      check(err, "MPIX_Stream_create()");
+      check(MPIX_Stream_comm_create(comm, _stream, &_comm),
+            "MPIX_Stream_comm_create()");
+
+      _is_stream_triggered = true;
+      return;
+    }
+#endif
+    throw exception{make_error_code(errc::feature_not_supported),
+                    "mpi::stream_communicator: Backend of the queue does not "
+                    "support queue-ordered communication with this MPI "
+                    "implementation"};
+  }
+
+  /// Waits for the queue, such that all communication has completed.
+  ~stream_communicator() {
+    _q.wait();
+    MPI_Comm_free(&_comm);
+#ifdef ACPP_MPI_STREAM_TRIGGERED
+    if(_is_stream_triggered)
+      MPIX_Stream_free(&_stream);
+#endif
+  }
+
+  stream_communicator(const stream_communicator&) = delete;
+  stream_communicator& operator=(const stream_communicator&) = delete;
+
+  /// The communicator that is used for the queue-ordered operations.
+  /// Must not be used for communication outside of the queue.
+  MPI_Comm get_native() const noexcept {
+    return _comm;
+  }
+
+  event send(const void *buf, int count, MPI_Datatype type, int dest, int tag,
+             const std::vector<event> &dependencies = {}) {
+    MPI_Comm comm = _comm;
+    if(_is_stream_triggered)
+      return enqueue([=](interop_handle&){
+#ifdef ACPP_MPI_STREAM_TRIGGERED
+        MPIX_Send_enqueue(buf, count, type, dest, tag, comm);
+#endif
+      }, dependencies);
+    return enqueue([=](interop_handle&){
+      MPI_Send(buf, count, type, dest, tag, comm);
+    }, dependencies);
+  }
+
+  event recv(void *buf, int count, MPI_Datatype type, int source, int tag,
+             const std::vector<event> &dependencies = {}) {
+    MPI_Comm comm = _comm;
+    if(_is_stream_triggered)
+      return enqueue([=](interop_handle&){
+#ifdef ACPP_MPI_STREAM_TRIGGERED
+        MPIX_Recv_enqueue(buf, count, type, source, tag, comm,
+                          MPI_STATUS_IGNORE);
+#endif
+      }, dependencies);
+    return enqueue([=](interop_handle&){
+      MPI_Recv(buf, count, type, source, tag, comm, MPI_STATUS_IGNORE);
+    }, dependencies);
+  }
+
+  /// Sends and receives concurrently, e.g. for halo exchanges between
+  /// neighboring ranks.
+  event sendrecv(const void *send_buf, int send_count, MPI_Datatype send_type,
+                 int dest, int send_tag, void *recv_buf, int recv_count,
+                 MPI_Datatype recv_type, int source, int recv_tag,
+                 const std::vector<event> &dependencies = {}) {
+    MPI_Comm comm = _comm;
+    if(_is_stream_triggered)
+      return enqueue([=](interop_handle&){
+#ifdef ACPP_MPI_STREAM_TRIGGERED
+        MPI_Request requests[2];
+        MPIX_Isend_enqueue(send_buf, send_count, send_type, dest, send_tag,
+                           comm, &requests[0]);
+        MPIX_Irecv_enqueue(recv_buf, recv_count, recv_type, source, recv_tag,
+                           comm, &requests[1]);
+        MPIX_Waitall_enqueue(2, requests, MPI_STATUSES_IGNORE);
+#endif
+      }, dependencies);
+    return enqueue([=](interop_handle&){
+      MPI_Sendrecv(send_buf, send_count, send_type, dest, send_tag, recv_buf,
+                   recv_count, recv_type, source, recv_tag, comm,
+                   MPI_STATUS_IGNORE);
+    }, dependencies);
+  }
+private:
+  template<class F>
+  event enqueue(F f, const std::vector<event>& dependencies) {
+    return _q.AdaptiveCpp_enqueue_custom_operation(f, dependencies);
+  }
+
+  static void check(int err, const char* operation) {
+    if(err != MPI_SUCCESS)
+      throw exception{make_error_code(errc::runtime),
+                      std::string{"mpi::stream_communicator: "} + operation +
+                          " failed"};
+  }
+
+  queue _q;
+  MPI_Comm _comm;
+  bool _is_stream_triggered;
+#ifdef ACPP_MPI_STREAM_TRIGGERED
+  MPIX_Stream _stream;
+#endif
+};
+
+}
+}
+}
+
+#endif
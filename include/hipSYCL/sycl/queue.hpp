@@ -21,6 +21,7 @@
 #include "hipSYCL/runtime/inorder_executor.hpp"
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 #include "hipSYCL/sycl/backend.hpp"
 #include "types.hpp"
 #include "exception.hpp"
@@ -37,6 +38,7 @@
 
 #include <cstddef>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -82,6 +84,29 @@ struct AdaptiveCpp_prefer_execution_lane : public detail::cg_property{
 
 struct AdaptiveCpp_coarse_grained_events : public detail::cg_property {};
 
+struct AdaptiveCpp_graph_capture : public detail::cg_property{
+  AdaptiveCpp_graph_capture(std::size_t capture_id)
+  : id{capture_id} {}
+
+  const std::size_t id;
+};
+
+struct AdaptiveCpp_cooperative_launch : public detail::cg_property{
+  AdaptiveCpp_cooperative_launch(bool limit_num_groups = false)
+  : limit_num_groups{limit_num_groups} {}
+
+  const bool limit_num_groups;
+};
+
+struct AdaptiveCpp_hardware_counters : public detail::cg_property {};
+
+struct AdaptiveCpp_dynamic_schedule : public detail::cg_property{
+  AdaptiveCpp_dynamic_schedule(std::size_t chunk_size = 0)
+  : chunk_size{chunk_size} {}
+
+  const std::size_t chunk_size;
+};
+
 // backwards compatibility
 template<int Dim>
 using hipSYCL_prefer_group_size = AdaptiveCpp_prefer_group_size<Dim>;
@@ -112,6 +137,13 @@ struct AdaptiveCpp_priority : public detail::queue_property {
 
 struct AdaptiveCpp_retargetable : public detail::queue_property {};
 
+struct AdaptiveCpp_compute_unit_partition : public detail::queue_property {
+  AdaptiveCpp_compute_unit_partition(std::size_t num_compute_units)
+  : num_compute_units{num_compute_units} {}
+
+  std::size_t num_compute_units;
+};
+
 // backwards compatibility
 using hipSYCL_coarse_grained_events = AdaptiveCpp_coarse_grained_events;
 using hipSYCL_priority = AdaptiveCpp_priority;
@@ -142,6 +174,10 @@ class queue : public detail::property_carrying_object
     // Note: This must not be a weak_ptr, since in the case of instant submissions,
     // the lifetime of nodes is not guaranteed to exceed task runtime.
     rt::dag_node_ptr previous_submission = nullptr;
+    // Set if nodes of this queue might still be cached in the DAG builder.
+    // Not needed for emulated in-order queues, which track
+    // previous_submission instead.
+    std::atomic<bool> has_unflushed_nodes = false;
     std::mutex lock;
     std::size_t node_group_id = -1;
     std::shared_ptr<rt::backend_executor> dedicated_inorder_executor = nullptr;
@@ -354,8 +390,11 @@ public:
         rt::inorder_executor* exec = AdaptiveCpp_inorder_executor();
         assert(exec);
         // Need to ensure everything is submitted before waiting on the stream
-        // in case we have non-instant operations
-        _impl->requires_runtime.get()->dag().flush_sync();
+        // in case we have non-instant operations. Instant operations have
+        // already been submitted to the executor, so if we only have those,
+        // the DAG does not need to be flushed.
+        if(_impl->has_unflushed_nodes.exchange(false))
+          _impl->requires_runtime.get()->dag().flush_sync();
         
         auto err = exec->wait();
         if(!err.is_success()) {
@@ -367,6 +406,9 @@ public:
       _impl->requires_runtime.get()->dag().flush_sync();
       _impl->requires_runtime.get()->dag().wait(_impl->node_group_id);
     }
+    // No operations of this queue can use scratch memory anymore,
+    // so it is safe to free idle scratch allocations now.
+    _impl->allocation_cache.trim();
   }
 
   void wait_and_throw() {
@@ -425,6 +467,42 @@ public:
             property::command_group::AdaptiveCpp_coarse_grained_events>()) {
       hints.set_hint(rt::hints::coarse_grained_synchronization{});
     }
+    if (prop_list.has_property<
+            property::command_group::AdaptiveCpp_graph_capture>()) {
+
+      std::size_t capture_id =
+          prop_list
+              .get_property<property::command_group::AdaptiveCpp_graph_capture>()
+              .id;
+
+      hints.set_hint(rt::hints::graph_capture{capture_id});
+    }
+    if (prop_list.has_property<
+            property::command_group::AdaptiveCpp_cooperative_launch>()) {
+
+      bool limit_num_groups =
+          prop_list
+              .get_property<
+                  property::command_group::AdaptiveCpp_cooperative_launch>()
+              .limit_num_groups;
+
+      hints.set_hint(rt::hints::cooperative_launch{limit_num_groups});
+    }
+    if (prop_list.has_property<
+            property::command_group::AdaptiveCpp_hardware_counters>()) {
+      hints.set_hint(rt::hints::request_instrumentation_hardware_counters{});
+    }
+    if (prop_list.has_property<
+            property::command_group::AdaptiveCpp_dynamic_schedule>()) {
+
+      std::size_t chunk_size =
+          prop_list
+              .get_property<
+                  property::command_group::AdaptiveCpp_dynamic_schedule>()
+              .chunk_size;
+
+      hints.set_hint(rt::hints::dynamic_schedule{chunk_size});
+    }
     // Should always have node_group hint from default hints
     assert(hints.has_hint<rt::hints::node_group>());
 
@@ -989,6 +1067,20 @@ public:
     });  
   }
 
+  template <typename T, int dim, typename AllocatorT>
+  event AdaptiveCpp_prefetch(const buffer<T, dim, AllocatorT> &buff) {
+    return this->submit(
+        [&](sycl::handler &cgh) { cgh.AdaptiveCpp_prefetch(buff); });
+  }
+
+  template <typename T, int dim, typename AllocatorT>
+  event AdaptiveCpp_prefetch(const buffer<T, dim, AllocatorT> &buff,
+                             range<dim> r, id<dim> offset = {}) {
+    return this->submit([&](sycl::handler &cgh) {
+      cgh.AdaptiveCpp_prefetch(buff, r, offset);
+    });
+  }
+
   template <typename T, int dim, access_mode mode, target tgt,
             accessor_variant isPlaceholder>
   event fill(accessor<T, dim, mode, tgt, isPlaceholder> dest, const T &src) {
@@ -998,6 +1090,32 @@ public:
     });  
   }
 
+  /// Operations that the calling thread submits until the matching
+  /// AdaptiveCpp_end_submission_batch() are passed to the scheduler
+  /// together in a single DAG flush. Batches can be nested.
+  void AdaptiveCpp_begin_submission_batch() {
+    _impl->requires_runtime.get()->dag().begin_submission_batch();
+  }
+
+  void AdaptiveCpp_end_submission_batch() {
+    _impl->requires_runtime.get()->dag().end_submission_batch();
+  }
+
+  std::vector<event> AdaptiveCpp_submit_batch(
+      const std::vector<std::function<void(sycl::handler &)>> &cgfs) {
+    struct batch_guard {
+      batch_guard(queue* q) : _q{q} { _q->AdaptiveCpp_begin_submission_batch(); }
+      ~batch_guard() { _q->AdaptiveCpp_end_submission_batch(); }
+      queue* _q;
+    } guard{this};
+
+    std::vector<event> events;
+    events.reserve(cgfs.size());
+    for(const auto& cgf : cgfs)
+      events.push_back(this->submit(cgf));
+    return events;
+  }
+
   std::size_t AdaptiveCpp_hash_code() const {
     return _impl->node_group_id;
   }
@@ -1040,7 +1158,10 @@ private:
         cgh.depends_on(event{previous, _impl->handler});
     }
     
-    cgf(cgh);
+    {
+      rt::trace_span span{"command group"};
+      cgf(cgh);
+    }
 
     rt::dag_node_ptr node = this->extract_dag_node(cgh);
     if (is_in_order()) {
@@ -1053,6 +1174,8 @@ private:
         // builder.
 #if ACPP_ALLOW_INSTANT_SUBMISSION
         _impl->requires_runtime.get()->dag().flush_sync();
+#else
+        _impl->has_unflushed_nodes = true;
 #endif
       }
     }
@@ -1102,7 +1225,9 @@ private:
 
     _impl->default_hints.set_hint(rt::hints::node_group{_impl->node_group_id});
 
-    if (this->has_property<property::queue::enable_profiling>()) {
+    // Device activity can only be traced if execution timestamps are available
+    if (this->has_property<property::queue::enable_profiling>() ||
+        rt::tracer::get().is_enabled()) {
       _impl->default_hints.set_hint(
           rt::hints::request_instrumentation_submission_timestamp{});
       _impl->default_hints.set_hint(
@@ -1121,20 +1246,33 @@ private:
 
     _impl->is_in_order = this->has_property<property::queue::in_order>();
 
+    int priority = 0;
+    if(this->has_property<property::queue::AdaptiveCpp_priority>()) {
+      priority = this->get_property<property::queue::AdaptiveCpp_priority>().priority;
+      // Allows executors that are shared between queues to place
+      // operations on lanes with matching priority
+      _impl->default_hints.set_hint(rt::hints::execution_priority{priority});
+    }
+
     if(_impl->is_in_order && get_devices().size() == 1) {
-      int priority = 0;
-      if(this->has_property<property::queue::AdaptiveCpp_priority>()) {
-        priority = this->get_property<property::queue::AdaptiveCpp_priority>().priority;
-      }
 
       rt::device_id rt_dev = detail::extract_rt_device(this->get_device());
+      rt::backend *b =
+          _impl->requires_runtime.get()->backends().get(rt_dev.get_backend());
       // Dedicated executor may not be supported by all backends,
       // so this might return nullptr.
-      _impl->dedicated_inorder_executor =
-          _impl->requires_runtime.get()
-              ->backends()
-              .get(rt_dev.get_backend())
-              ->create_inorder_executor(rt_dev, priority);
+      if (this->has_property<
+              property::queue::AdaptiveCpp_compute_unit_partition>()) {
+        _impl->dedicated_inorder_executor =
+            b->create_partitioned_inorder_executor(
+                rt_dev, priority,
+                this->get_property<
+                        property::queue::AdaptiveCpp_compute_unit_partition>()
+                    .num_compute_units);
+      } else {
+        _impl->dedicated_inorder_executor =
+            b->create_inorder_executor(rt_dev, priority);
+      }
       
       if(_impl->dedicated_inorder_executor) {
         _impl->default_hints.set_hint(
@@ -0,0 +1,186 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_SYCL_STRUCT_OF_ARRAYS_HPP
+#define HIPSYCL_SYCL_STRUCT_OF_ARRAYS_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "exception.hpp"
+#include "queue.hpp"
+#include "usm.hpp"
+#include "libkernel/backend.hpp"
+#include "hipSYCL/glue/reflection.hpp"
+
+namespace hipsycl {
+namespace sycl {
+
+namespace detail::soa {
+
+template <class S, class Member>
+ACPP_UNIVERSAL_TARGET auto &access_member(S &s, Member m) {
+  return s.*m;
+}
+
+template <class S, class Member, class... Members>
+ACPP_UNIVERSAL_TARGET auto &access_member(S &s, Member m, Members... rest) {
+  return access_member(s.*m, rest...);
+}
+
+}
+
+/// Device-side view of an AdaptiveCpp_struct_of_arrays. Can be captured by
+/// kernels.
+///
+/// The scalar member at byte offset o within T of element idx is stored at
+/// byte o * size() + idx * sizeof(member). Since the members of T do not
+/// overlap, the arrays of all members fit into size() * sizeof(T) bytes.
+template <class T>
+class AdaptiveCpp_struct_of_arrays_view {
+public:
+  AdaptiveCpp_struct_of_arrays_view() = default;
+  AdaptiveCpp_struct_of_arrays_view(unsigned char *data, std::size_t size)
+      : _data{data}, _size{size} {}
+
+  /// Accesses a scalar member of the element idx. Members of nested structs
+  /// are accessed by passing a chain of member pointers, e.g.
+  /// get(idx, &particle::position, &vec3::x).
+  template <class... Members>
+  ACPP_UNIVERSAL_TARGET auto &get(std::size_t idx, Members... members) const {
+    static_assert(sizeof...(Members) > 0, "No member was specified");
+
+    // Only the address of the member is computed, the object is never
+    // accessed. This is folded into a constant offset by the compiler.
+    alignas(T) unsigned char storage[sizeof(T)];
+    auto &m = detail::soa::access_member(*reinterpret_cast<T *>(storage),
+                                         members...);
+    using member_type = std::remove_reference_t<decltype(m)>;
+    static_assert(std::is_scalar_v<member_type>,
+                  "Only scalar members can be accessed, since the members of "
+                  "nested structs are stored in separate arrays");
+
+    std::size_t offset =
+        reinterpret_cast<unsigned char *>(&m) - storage;
+    return *reinterpret_cast<member_type *>(_data + offset * _size +
+                                            idx * sizeof(member_type));
+  }
+
+  ACPP_UNIVERSAL_TARGET std::size_t size() const { return _size; }
+
+private:
+  unsigned char *_data = nullptr;
+  std::size_t _size = 0;
+};
+
+/// Stores an array of structs of type T in device memory as one array per
+/// scalar member, such that kernels that only access some members do not
+/// load the other members. The members of T are determined using struct
+/// reflection, see ACPP_EXT_STRUCT_OF_ARRAYS.
+template <class T>
+class AdaptiveCpp_struct_of_arrays {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "struct_of_arrays: Element type must be trivially copyable");
+public:
+  AdaptiveCpp_struct_of_arrays(std::size_t size, const queue &q)
+      : _q{q}, _size{size}, _data{nullptr} {
+    if(_size > 0)
+      _data = malloc_device<unsigned char>(_size * sizeof(T), _q);
+  }
+
+  ~AdaptiveCpp_struct_of_arrays() {
+    if(_data)
+      sycl::free(_data, _q);
+  }
+
+  AdaptiveCpp_struct_of_arrays(const AdaptiveCpp_struct_of_arrays &) = delete;
+  AdaptiveCpp_struct_of_arrays &
+  operator=(const AdaptiveCpp_struct_of_arrays &) = delete;
+
+  /// Transposes size() elements from src into device memory. Blocks until
+  /// the copy has completed.
+  void copy_from(const T *src) {
+    if(_size == 0)
+      return;
+    init_layout(src[0]);
+
+    std::vector<unsigned char> staging(_size * sizeof(T));
+    const unsigned char *src_bytes = reinterpret_cast<const unsigned char *>(src);
+    for(const member &m : _members) {
+      unsigned char *member_array = staging.data() + m.offset * _size;
+      for(std::size_t i = 0; i < _size; ++i)
+        std::memcpy(member_array + i * m.size,
+                    src_bytes + i * sizeof(T) + m.offset, m.size);
+    }
+    _q.memcpy(_data, staging.data(), staging.size()).wait();
+  }
+
+  /// Transposes the elements in device memory back into size() elements
+  /// at dest. Blocks until the copy has completed.
+  void copy_to(T *dest) {
+    if(_size == 0)
+      return;
+    init_layout(dest[0]);
+
+    std::vector<unsigned char> staging(_size * sizeof(T));
+    _q.memcpy(staging.data(), _data, staging.size()).wait();
+
+    unsigned char *dest_bytes = reinterpret_cast<unsigned char *>(dest);
+    for(const member &m : _members) {
+      const unsigned char *member_array = staging.data() + m.offset * _size;
+      for(std::size_t i = 0; i < _size; ++i)
+        std::memcpy(dest_bytes + i * sizeof(T) + m.offset,
+                    member_array + i * m.size, m.size);
+    }
+  }
+
+  AdaptiveCpp_struct_of_arrays_view<T> get_view() const {
+    return AdaptiveCpp_struct_of_arrays_view<T>{_data, _size};
+  }
+
+  std::size_t size() const { return _size; }
+
+private:
+  struct member {
+    std::size_t offset;
+    std::size_t size;
+  };
+
+  void init_layout(const T &element) {
+    if(!_members.empty())
+      return;
+
+    glue::reflection::introspect_flattened_struct introspection{element};
+    if(introspection.get_num_members() == 0)
+      throw exception{make_error_code(errc::feature_not_supported),
+                      "struct_of_arrays: Struct reflection is not available"};
+
+    for(int i = 0; i < introspection.get_num_members(); ++i) {
+      member m{static_cast<std::size_t>(introspection.get_member_offset(i)),
+               static_cast<std::size_t>(introspection.get_member_size(i))};
+      if(m.offset + m.size > sizeof(T))
+        throw exception{make_error_code(errc::invalid),
+                        "struct_of_arrays: Invalid struct layout"};
+      _members.push_back(m);
+    }
+  }
+
+  queue _q;
+  std::size_t _size;
+  unsigned char *_data;
+  std::vector<member> _members;
+};
+
+}
+}
+
+#endif
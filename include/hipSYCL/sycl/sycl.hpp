@@ -33,6 +33,7 @@
 
 #include "libkernel/backend.hpp"
 #include "libkernel/bit_cast.hpp"
+#include "libkernel/span.hpp"
 #include "libkernel/range.hpp"
 #include "libkernel/id.hpp"
 #include "libkernel/accessor.hpp"
@@ -60,6 +61,7 @@
 #include "libkernel/group_functions_alias.hpp"
 #include "libkernel/functional.hpp"
 #include "libkernel/reduction.hpp"
+#include "libkernel/matrix.hpp"
 
 #include "version.hpp"
 #include "types.hpp"
@@ -77,7 +79,10 @@
 #include "interop_handle.hpp"
 #include "buffer_explicit_behavior.hpp"
 #include "specialized.hpp"
+#include "kernel_handler.hpp"
 #include "jit.hpp"
+#include "work_splitter.hpp"
+#include "coroutine.hpp"
 
 // Support SYCL_EXTERNAL for SSCP - we cannot have SYCL_EXTERNAL if accelerated CPU
 // is active at the same time :(
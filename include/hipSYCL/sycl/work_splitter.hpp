@@ -0,0 +1,167 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef HIPSYCL_WORK_SPLITTER_HPP
+#define HIPSYCL_WORK_SPLITTER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "device.hpp"
+#include "event.hpp"
+#include "exception.hpp"
+#include "handler.hpp"
+#include "info/event.hpp"
+#include "queue.hpp"
+#include "libkernel/id.hpp"
+#include "libkernel/range.hpp"
+
+namespace hipsycl {
+namespace sycl {
+
+/// Splits the iteration space of a command group along dimension 0 across
+/// multiple devices, see ACPP_EXT_WORK_SPLITTER.
+class AdaptiveCpp_work_splitter {
+public:
+  AdaptiveCpp_work_splitter(const std::vector<device> &devices,
+                            std::size_t granularity = 1)
+      : AdaptiveCpp_work_splitter{
+            devices, std::vector<double>(devices.size(), 1.0), granularity} {}
+
+  AdaptiveCpp_work_splitter(const std::vector<device> &devices,
+                            const std::vector<double> &initial_ratios,
+                            std::size_t granularity = 1)
+      : _devices{devices}, _ratios{initial_ratios},
+        _granularity{std::max(granularity, std::size_t{1})} {
+    if(_devices.empty() || _devices.size() != _ratios.size())
+      throw exception{make_error_code(errc::invalid),
+                      "work_splitter: Number of devices and split ratios "
+                      "must match and be non-zero"};
+    normalize_ratios();
+  }
+
+  /// Invokes cgf(cgh, offset, sub_range) once per device in a command group
+  /// that is submitted to q and retargeted to the device. q must be
+  /// constructed with the AdaptiveCpp_retargetable property.
+  template <int Dim, class CommandGroup>
+  std::vector<event> submit(queue &q, range<Dim> r, CommandGroup cgf) {
+    if(q.has_property<property::queue::enable_profiling>())
+      update_ratios();
+    _last_submission.clear();
+
+    std::vector<event> events;
+    std::size_t begin = 0;
+    double cumulative_ratio = 0.0;
+    for(std::size_t i = 0; i < _devices.size(); ++i) {
+      cumulative_ratio += _ratios[i];
+
+      std::size_t end = r[0];
+      if(i + 1 < _devices.size()) {
+        end = static_cast<std::size_t>(cumulative_ratio * r[0]);
+        end = std::min(end / _granularity * _granularity, r[0]);
+        end = std::max(end, begin);
+      }
+      if(end == begin)
+        continue;
+
+      id<Dim> offset;
+      offset[0] = begin;
+      range<Dim> sub_range = r;
+      sub_range[0] = end - begin;
+
+      events.push_back(q.submit(
+          {property::command_group::AdaptiveCpp_retarget{_devices[i]}},
+          [&](handler &cgh) { cgf(cgh, offset, sub_range); }));
+      _last_submission.push_back(
+          submitted_slice{i, events.back(), sub_range.size()});
+
+      begin = end;
+    }
+    return events;
+  }
+
+  /// The fraction of the iteration space assigned to each device
+  const std::vector<double> &get_ratios() const { return _ratios; }
+
+  const std::vector<device> &get_devices() const { return _devices; }
+
+private:
+  struct submitted_slice {
+    std::size_t device_index;
+    event evt;
+    std::size_t num_work_items;
+  };
+
+  // Derives new ratios from the throughput of each device in the previous
+  // submission, if it has completed.
+  void update_ratios() {
+    if(_last_submission.empty())
+      return;
+
+    for(auto &slice : _last_submission)
+      if (slice.evt.get_info<info::event::command_execution_status>() !=
+          info::event_command_status::complete)
+        return;
+
+    std::vector<double> throughput = _ratios;
+    for(auto &slice : _last_submission) {
+      auto start =
+          slice.evt.get_profiling_info<info::event_profiling::command_start>();
+      auto end =
+          slice.evt.get_profiling_info<info::event_profiling::command_end>();
+      if(end > start)
+        throughput[slice.device_index] =
+            static_cast<double>(slice.num_work_items) /
+            static_cast<double>(end - start);
+    }
+    // Devices without a slice keep their share
+    double total_throughput = 0.0;
+    double total_ratio = 0.0;
+    for(auto &slice : _last_submission) {
+      total_throughput += throughput[slice.device_index];
+      total_ratio += _ratios[slice.device_index];
+    }
+    if(total_throughput <= 0.0)
+      return;
+
+    // Smooth updates to be robust against noisy measurements
+    for(auto &slice : _last_submission) {
+      std::size_t i = slice.device_index;
+      double measured_ratio = total_ratio * throughput[i] / total_throughput;
+      _ratios[i] = (1.0 - ratio_update_weight) * _ratios[i] +
+                   ratio_update_weight * measured_ratio;
+    }
+    _last_submission.clear();
+    normalize_ratios();
+  }
+
+  void normalize_ratios() {
+    double sum = 0.0;
+    for(double &ratio : _ratios) {
+      ratio = std::max(ratio, 0.0);
+      sum += ratio;
+    }
+    for(double &ratio : _ratios)
+      ratio = (sum > 0.0) ? ratio / sum : 1.0 / _ratios.size();
+  }
+
+  static constexpr double ratio_update_weight = 0.5;
+
+  std::vector<device> _devices;
+  std::vector<double> _ratios;
+  std::size_t _granularity;
+  std::vector<submitted_slice> _last_submission;
+};
+
+}
+}
+
+#endif
@@ -12,9 +12,19 @@
 #include "hipSYCL/common/appdb.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <type_traits>
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace hipsycl::common::db {
 
 namespace {
@@ -52,9 +62,16 @@ void kernel_arg_value_statistics::dump(std::ostream& ostr, int indentation_level
 void kernel_arg_entry::dump(std::ostream& ostr, int indentation_level) const {
   print_array(ostr, "common_values", common_values, "arg_statistics", indentation_level);
   print_array(ostr, "was_specialized", was_specialized, "bool", indentation_level);
+  print_key_value_pair(ostr, "min_pointer_alignment", min_pointer_alignment,
+                       indentation_level);
+  print_key_value_pair(ostr, "has_aliased", has_aliased, indentation_level);
+  print_key_value_pair(ostr, "max_value", max_value, indentation_level);
+  print_key_value_pair(ostr, "min_trailing_zeros", min_trailing_zeros,
+                       indentation_level);
 }
 
 void kernel_entry::dump(std::ostream& ostr, int indentation_level) const {
+  print_key_value_pair(ostr, "kernel_name", kernel_name, indentation_level);
   print_key_value_pair(ostr, "num_registered_invocations",
                        num_registered_invocations, indentation_level);
   print_array(ostr, "retained_argument_indices", retained_argument_indices,
@@ -64,9 +81,91 @@ void kernel_entry::dump(std::ostream& ostr, int indentation_level) const {
                        first_iads_invocation_run, indentation_level);
 }
 
+void jit_recipe::dump(std::ostream& ostr, int indentation_level) const {
+  print_key_value_pair(ostr, "backend", backend, indentation_level);
+  print_key_value_pair(ostr, "hcf_object", hcf_object, indentation_level);
+  print_key_value_pair(ostr, "image", image, indentation_level);
+  print_key_value_pair(ostr, "kernels", "<array>", indentation_level);
+  for(int i = 0; i < kernels.size(); ++i)
+    print_key_value_pair(ostr, std::to_string(i), kernels[i],
+                         indentation_level + 1);
+  print_key_value_pair(ostr, "build_options", "<map>", indentation_level);
+  for(const auto& option : build_options) {
+    if(option.is_int_value)
+      print_key_value_pair(ostr, std::to_string(option.option),
+                           option.int_value, indentation_level + 1);
+    else
+      print_key_value_pair(ostr, std::to_string(option.option),
+                           option.string_value, indentation_level + 1);
+  }
+  print_array(ostr, "build_flags", build_flags, "int", indentation_level);
+  print_key_value_pair(ostr, "specialized_args", "<map>", indentation_level);
+  for(const auto& arg : specialized_args)
+    print_key_value_pair(ostr, std::to_string(arg.param_index), arg.value,
+                         indentation_level + 1);
+  print_key_value_pair(ostr, "dead_argument_elimination",
+                       dead_argument_elimination, indentation_level);
+  print_key_value_pair(ostr, "pointer_arg_alignments", "<map>", indentation_level);
+  for(const auto& arg : pointer_arg_alignments)
+    print_key_value_pair(ostr, std::to_string(arg.param_index), arg.value,
+                         indentation_level + 1);
+  print_array(ostr, "noalias_pointer_args", noalias_pointer_args, "int",
+              indentation_level);
+  print_key_value_pair(ostr, "arg_upper_bounds", "<map>", indentation_level);
+  for(const auto& arg : arg_upper_bounds)
+    print_key_value_pair(ostr, std::to_string(arg.param_index), arg.value,
+                         indentation_level + 1);
+  print_key_value_pair(ostr, "arg_divisors", "<map>", indentation_level);
+  for(const auto& arg : arg_divisors)
+    print_key_value_pair(ostr, std::to_string(arg.param_index), arg.value,
+                         indentation_level + 1);
+  print_array(ostr, "branch_profile", branch_profile, "uint64", indentation_level);
+}
+
 void binary_entry::dump(std::ostream& ostr, int indentation_level) const {
   print_key_value_pair(ostr, "jit_cache_filename", jit_cache_filename,
                        indentation_level);
+  print_key_value_pair(ostr, "binary_size", binary_size, indentation_level);
+  print_key_value_pair(ostr, "content_hash", content_hash, indentation_level);
+  print_key_value_pair(ostr, "last_used", last_used, indentation_level);
+  print_key_value_pair(ostr, "compilation_time", compilation_time,
+                       indentation_level);
+  if(recipe.is_valid()) {
+    print_key_value_pair(ostr, "recipe", "<jit-recipe>", indentation_level);
+    recipe.dump(ostr, indentation_level + 1);
+  }
+  print_array(ostr, "kernel_resources", kernel_resources, "kernel_resources",
+              indentation_level);
+}
+
+void kernel_resource_usage_entry::dump(std::ostream &ostr,
+                                       int indentation_level) const {
+  print_key_value_pair(ostr, "kernel_name", kernel_name, indentation_level);
+  print_key_value_pair(ostr, "num_registers", num_registers,
+                       indentation_level);
+  print_key_value_pair(ostr, "spill_bytes", spill_bytes, indentation_level);
+  print_key_value_pair(ostr, "private_mem_bytes", private_mem_bytes,
+                       indentation_level);
+  print_key_value_pair(ostr, "local_mem_bytes", local_mem_bytes,
+                       indentation_level);
+  print_key_value_pair(ostr, "max_group_size", max_group_size,
+                       indentation_level);
+  print_key_value_pair(ostr, "occupancy", occupancy, indentation_level);
+  print_key_value_pair(ostr, "occupancy_group_size", occupancy_group_size,
+                       indentation_level);
+}
+
+void group_size_entry::dump(std::ostream& ostr, int indentation_level) const {
+  print_key_value_pair(ostr, "x", x, indentation_level);
+  print_key_value_pair(ostr, "y", y, indentation_level);
+  print_key_value_pair(ostr, "z", z, indentation_level);
+  print_key_value_pair(ostr, "is_autotuned", is_autotuned, indentation_level);
+}
+
+void branch_profile_entry::dump(std::ostream& ostr, int indentation_level) const {
+  print_key_value_pair(ostr, "num_profiled_invocations",
+                       num_profiled_invocations, indentation_level);
+  print_array(ostr, "counters", counters, "uint64", indentation_level);
 }
 
 void appdb_data::dump(std::ostream& ostr, int indentation_level) const {
@@ -94,38 +193,599 @@ void appdb_data::dump(std::ostream& ostr, int indentation_level) const {
     print_key_value_pair(ostr, binary_name, "<binary-entry>", indentation_level+1);
     entry.second.dump(ostr, indentation_level+2);
   }
+
+  print_key_value_pair(ostr, "group_sizes", "<map>", indentation_level);
+
+  for(const auto& entry : group_sizes) {
+    std::string kernel_name = get_id_string(entry.first);
+    print_key_value_pair(ostr, kernel_name, "<group-size-entry>", indentation_level+1);
+    entry.second.dump(ostr, indentation_level+2);
+  }
+
+  print_key_value_pair(ostr, "branch_profiles", "<map>", indentation_level);
+
+  for(const auto& entry : branch_profiles) {
+    std::string kernel_name = get_id_string(entry.first);
+    print_key_value_pair(ostr, kernel_name, "<branch-profile-entry>", indentation_level+1);
+    entry.second.dump(ostr, indentation_level+2);
+  }
+}
+
+void merge_kernel_entry_delta(kernel_entry &target,
+                              const kernel_entry &base,
+                              const kernel_entry &updated) {
+  const uint64_t invocation_delta =
+      updated.num_registered_invocations - base.num_registered_invocations;
+  target.num_registered_invocations += invocation_delta;
+  if(target.kernel_name.empty())
+    target.kernel_name = updated.kernel_name;
+  if(target.retained_argument_indices.empty())
+    target.retained_argument_indices = updated.retained_argument_indices;
+  target.first_iads_invocation_run = std::min(target.first_iads_invocation_run,
+                                              updated.first_iads_invocation_run);
+
+  if(target.kernel_args.size() < updated.kernel_args.size())
+    target.kernel_args.resize(updated.kernel_args.size());
+
+  constexpr int num_slots = common::db::kernel_arg_entry::max_tracked_values;
+
+  for(std::size_t i = 0; i < updated.kernel_args.size(); ++i) {
+    auto& target_arg = target.kernel_args[i];
+    const auto& updated_arg = updated.kernel_args[i];
+
+    if (updated_arg.min_pointer_alignment != 0 &&
+        (target_arg.min_pointer_alignment == 0 ||
+         updated_arg.min_pointer_alignment < target_arg.min_pointer_alignment))
+      target_arg.min_pointer_alignment = updated_arg.min_pointer_alignment;
+    target_arg.has_aliased = target_arg.has_aliased || updated_arg.has_aliased;
+    target_arg.max_value = std::max(target_arg.max_value, updated_arg.max_value);
+    target_arg.min_trailing_zeros =
+        std::min(target_arg.min_trailing_zeros, updated_arg.min_trailing_zeros);
+
+    for(int slot = 0; slot < num_slots; ++slot) {
+      const auto& value_stats = updated_arg.common_values[slot];
+      if(value_stats.count == 0)
+        continue;
+
+      uint64_t base_count = 0;
+      if(i < base.kernel_args.size()) {
+        for(const auto& base_stats : base.kernel_args[i].common_values) {
+          if(base_stats.count > 0 && base_stats.value == value_stats.value)
+            base_count = base_stats.count;
+        }
+      }
+
+      const uint64_t count_delta =
+          value_stats.count > base_count ? value_stats.count - base_count : 0;
+      const bool was_specialized = updated_arg.was_specialized[slot];
+      if(count_delta == 0 && !was_specialized)
+        continue;
+
+      // last_used is relative to the invocation counter of the entry,
+      // so translate it into the invocation count of the target.
+      const uint64_t age = std::min<uint64_t>(
+          updated.num_registered_invocations - value_stats.last_used,
+          target.num_registered_invocations);
+      const uint64_t last_used = target.num_registered_invocations - age;
+
+      int matching_slot = -1;
+      int empty_slot = -1;
+      int eviction_candidate_slot = -1;
+      uint64_t eviction_candidate_last_used_time = last_used;
+      for(int j = 0; j < num_slots; ++j) {
+        const auto& target_stats = target_arg.common_values[j];
+        if(target_stats.count > 0 && target_stats.value == value_stats.value) {
+          matching_slot = j;
+          break;
+        } else if(target_stats.count == 0) {
+          empty_slot = j;
+        } else if (!target_arg.was_specialized[j] &&
+                   target_stats.last_used < eviction_candidate_last_used_time) {
+          eviction_candidate_slot = j;
+          eviction_candidate_last_used_time = target_stats.last_used;
+        }
+      }
+
+      if(matching_slot >= 0) {
+        auto& target_stats = target_arg.common_values[matching_slot];
+        target_stats.count += count_delta;
+        target_stats.last_used = std::max(target_stats.last_used, last_used);
+        target_arg.was_specialized[matching_slot] =
+            target_arg.was_specialized[matching_slot] || was_specialized;
+      } else {
+        int new_slot = empty_slot >= 0 ? empty_slot : eviction_candidate_slot;
+        if(new_slot >= 0) {
+          auto& target_stats = target_arg.common_values[new_slot];
+          target_stats.value = value_stats.value;
+          target_stats.count = std::max<uint64_t>(count_delta, 1);
+          target_stats.last_used = last_used;
+          target_arg.was_specialized[new_slot] = was_specialized;
+        }
+      }
+    }
+  }
+}
+
+namespace {
+
+// "ACPPPRF1" in little endian
+constexpr uint64_t kernel_profile_magic = 0x3146525050504341ull;
+
+}
+
+bool export_kernel_profile(const appdb_data &data, const std::string &path) {
+  kernel_profile_data profile;
+  profile.format_version = appdb::format_version;
+  profile.kernels = data.kernels;
+
+  std::vector<uint8_t> packed = msgpack::pack(profile);
+  std::string serialized(sizeof(kernel_profile_magic) + packed.size(), '\0');
+  std::memcpy(serialized.data(), &kernel_profile_magic,
+              sizeof(kernel_profile_magic));
+  std::memcpy(serialized.data() + sizeof(kernel_profile_magic), packed.data(),
+              packed.size());
+  return filesystem::atomic_write(path, serialized);
+}
+
+bool read_kernel_profile(const std::string &path, kernel_profile_data &out) {
+  std::ifstream file{path, std::ios::in | std::ios::binary};
+  if(!file.is_open())
+    return false;
+  std::vector<uint8_t> content{std::istreambuf_iterator<char>{file},
+                               std::istreambuf_iterator<char>{}};
+
+  uint64_t magic = 0;
+  if(content.size() < sizeof(magic))
+    return false;
+  std::memcpy(&magic, content.data(), sizeof(magic));
+  if(magic != kernel_profile_magic)
+    return false;
+
+  std::error_code ec;
+  kernel_profile_data profile = msgpack::unpack<kernel_profile_data>(
+      content.data() + sizeof(magic), content.size() - sizeof(magic), ec);
+  if(ec || profile.format_version != appdb::format_version)
+    return false;
+  out = std::move(profile);
+  return true;
+}
+
+std::size_t merge_kernel_profile(appdb_data &data,
+                                 const kernel_profile_data &profile) {
+  std::size_t num_merged = 0;
+  for(const auto& entry : profile.kernels) {
+    kernel_entry imported = entry.second;
+    if(imported.num_registered_invocations == 0)
+      continue;
+    // Invocations of the profile count as invocations of previous runs,
+    // whose statistics can be used for specialization right away.
+    if(imported.first_iads_invocation_run != kernel_entry::no_usage)
+      imported.first_iads_invocation_run = 0;
+    merge_kernel_entry_delta(data.kernels[entry.first], kernel_entry{},
+                             imported);
+    ++num_merged;
+  }
+  return num_merged;
+}
+
+namespace {
+
+template<class F>
+void for_each_evictable_binary(const appdb_data& data, F&& handler) {
+  std::unordered_map<std::string, std::size_t> num_file_references;
+  for(const auto& entry : data.binaries)
+    if(!entry.second.jit_cache_filename.empty())
+      ++num_file_references[entry.second.jit_cache_filename];
+
+  for(const auto& entry : data.binaries) {
+    const std::string& filename = entry.second.jit_cache_filename;
+    if(!filename.empty() && num_file_references[filename] == 1)
+      handler(entry.first, entry.second);
+  }
+}
+
+}
+
+uint64_t get_evictable_binaries_size(const appdb_data& data) {
+  uint64_t total_size = 0;
+  for_each_evictable_binary(
+      data, [&](const rt::kernel_configuration::id_type &,
+                const binary_entry &entry) { total_size += entry.binary_size; });
+  return total_size;
+}
+
+std::vector<std::string> evict_lru_binaries(appdb_data &data, uint64_t max_size,
+                                            std::size_t max_evictions) {
+  using candidate =
+      std::pair<rt::kernel_configuration::id_type, const binary_entry *>;
+  std::vector<candidate> candidates;
+  uint64_t total_size = 0;
+  for_each_evictable_binary(
+      data, [&](const rt::kernel_configuration::id_type &id,
+                const binary_entry &entry) {
+        candidates.push_back(std::make_pair(id, &entry));
+        total_size += entry.binary_size;
+      });
+
+  std::vector<std::string> evicted_files;
+  if(total_size <= max_size)
+    return evicted_files;
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const candidate &a, const candidate &b) {
+              return a.second->last_used < b.second->last_used;
+            });
+
+  std::vector<rt::kernel_configuration::id_type> evicted_ids;
+  for(const auto& c : candidates) {
+    if(total_size <= max_size || evicted_ids.size() >= max_evictions)
+      break;
+    total_size -= std::min(total_size, c.second->binary_size);
+    evicted_files.push_back(c.second->jit_cache_filename);
+    evicted_ids.push_back(c.first);
+  }
+
+  for(const auto& id : evicted_ids)
+    data.binaries.erase(id);
+
+  return evicted_files;
+}
+
+std::string get_jit_cache_lock_file(const std::string &jit_cache_file) {
+  return jit_cache_file + ".lock";
+}
+
+void remove_jit_cache_file(const std::string &jit_cache_file) {
+  filesystem::remove(jit_cache_file);
+  filesystem::remove(get_jit_cache_lock_file(jit_cache_file));
+}
+
+namespace {
+
+// "ACPPADB1" in little endian
+constexpr uint64_t appdb_magic = 0x3142444150504341ull;
+
+struct file_header {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t content_version;
+  uint64_t num_sections;
+};
+
+struct section_header {
+  uint64_t index_offset;
+  uint64_t num_slots;
+};
+
+// The hash of the on-disk index must not depend on the standard library
+// implementation.
+uint64_t get_slot_hash(const uint64_t* id) {
+  uint64_t hash = id[0] ^ (id[1] * 0x9e3779b97f4a7c15ull);
+  return hash ^ (hash >> 32);
+}
+
+// Merges an entry modified by this process (updated, which was base when
+// it was loaded) into the entry that is currently stored (target).
+void merge_entry(kernel_entry &target, const kernel_entry &base,
+                 const kernel_entry &updated) {
+  merge_kernel_entry_delta(target, base, updated);
+}
+
+void merge_entry(binary_entry &target, const binary_entry &,
+                 const binary_entry &updated) {
+  uint64_t last_used = std::max(target.last_used, updated.last_used);
+  target = updated;
+  target.last_used = last_used;
+}
+
+template<class Entry>
+void merge_entry(Entry &target, const Entry &, const Entry &updated) {
+  target = updated;
+}
+
+uint64_t get_num_slots(std::size_t num_entries) {
+  if(num_entries == 0)
+    return 0;
+  // Keep the load factor at or below 0.5
+  uint64_t num_slots = 1;
+  while(num_slots < 2 * num_entries)
+    num_slots *= 2;
+  return num_slots;
+}
+
 }
 
 appdb::appdb(const std::string& db_path) 
-: _db_path{db_path}, _lock{0}, _was_modified{false} {
+: _lock{0}, _was_modified{false}, _are_all_entries_dirty{false},
+  _are_all_entries_loaded{false}, _db_path{db_path}, _content_version{0},
+  _file_data{nullptr}, _file_size{0}, _is_mapped{false} {
 
-  if(filesystem::exists(db_path)) {
-    std::ifstream file{_db_path, std::ios::in | std::ios::binary | std::ios::ate};
-    if (!file.is_open())
-      return;
-    std::streamsize file_size = file.tellg();
-    
-    file.seekg(0, std::ios::beg);
+  if(filesystem::exists(db_path))
+    map_file();
+
+  if(_file_size < sizeof(file_header)) {
+    unmap_file();
+    return;
+  }
 
-    std::vector<uint8_t> file_content;
-    file_content.resize(file_size);
-    file.read(reinterpret_cast<char *>(file_content.data()), file_size);
+  file_header header;
+  std::memcpy(&header, _file_data, sizeof(header));
+  bool is_valid = header.magic == appdb_magic &&
+                  header.version == format_version &&
+                  header.num_sections == num_sections &&
+                  _file_size >= sizeof(file_header) +
+                                    num_sections * sizeof(section_header);
 
-    _data = msgpack::unpack<appdb_data>(file_content);
+  std::array<section_index, num_sections> indices;
+  for(int i = 0; i < num_sections && is_valid; ++i) {
+    section_header section;
+    std::memcpy(&section,
+                _file_data + sizeof(file_header) + i * sizeof(section_header),
+                sizeof(section));
+    indices[i].num_slots = section.num_slots;
+    indices[i].slots = reinterpret_cast<const index_slot *>(
+        _file_data + section.index_offset);
+
+    // Number of slots must be a power of two
+    is_valid = (section.num_slots & (section.num_slots - 1)) == 0 &&
+               section.index_offset % alignof(index_slot) == 0 &&
+               section.index_offset <= _file_size &&
+               section.num_slots <=
+                   (_file_size - section.index_offset) / sizeof(index_slot);
+    for(uint64_t j = 0; j < section.num_slots && is_valid; ++j) {
+      const index_slot& slot = indices[i].slots[j];
+      is_valid = slot.offset <= _file_size &&
+                 slot.size <= _file_size - slot.offset;
+    }
   }
+
+  // libacpp-common cannot emit debug output, so invalid databases are
+  // silently treated as empty.
+  if(!is_valid) {
+    unmap_file();
+    return;
+  }
+  _content_version = header.content_version;
+  _data.content_version = header.content_version;
+  _indices = indices;
 }
 
 appdb::~appdb() {
   if(_was_modified) {
-    ++_data.content_version;
+    // Other processes must not store the database between reading
+    // its current content and replacing it.
+    common::filesystem::file_lock lock{_db_path + ".lock"};
+    appdb current{_db_path};
+    _data.content_version =
+        std::max(_content_version, current.get_content_version()) + 1;
+    common::filesystem::atomic_write(_db_path, serialize(current));
+  }
+  unmap_file();
+}
 
-    auto data = msgpack::pack(_data);
-    std::string data_string;
-    data_string.resize(data.size());
-    std::memcpy(data_string.data(), data.data(), data.size());
+void appdb::map_file() {
+#ifndef _WIN32
+  int fd = ::open(_db_path.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd < 0)
+    return;
+  struct stat st;
+  if(fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(ptr != MAP_FAILED) {
+      _file_data = static_cast<const char*>(ptr);
+      _file_size = st.st_size;
+      _is_mapped = true;
+    }
+  }
+  // The mapping remains valid after closing the file, and also after the
+  // file is replaced by atomic_write().
+  ::close(fd);
+  if(_is_mapped)
+    return;
+#endif
+  std::ifstream file{_db_path, std::ios::in | std::ios::binary | std::ios::ate};
+  if (!file.is_open())
+    return;
+  std::streamsize file_size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  _file_buffer.resize(file_size);
+  file.read(_file_buffer.data(), file_size);
+  _file_data = _file_buffer.data();
+  _file_size = _file_buffer.size();
+}
+
+void appdb::unmap_file() {
+#ifndef _WIN32
+  if(_is_mapped)
+    munmap(const_cast<char*>(_file_data), _file_size);
+#endif
+  _is_mapped = false;
+  _file_buffer.clear();
+  _file_data = nullptr;
+  _file_size = 0;
+  _indices = {};
+}
 
-    common::filesystem::atomic_write(_db_path, data_string);
+bool appdb::find_serialized_entry(section s, const id_type &id,
+                                  std::string_view &out) const {
+  const section_index& index = _indices[s];
+  if(index.num_slots == 0)
+    return false;
+
+  const uint64_t mask = index.num_slots - 1;
+  for (uint64_t i = get_slot_hash(id.data()) & mask, num_probes = 0;
+       num_probes < index.num_slots; i = (i + 1) & mask, ++num_probes) {
+    const index_slot& slot = index.slots[i];
+    if(slot.size == 0)
+      return false;
+    if(slot.id[0] == id[0] && slot.id[1] == id[1]) {
+      out = std::string_view{_file_data + slot.offset, slot.size};
+      return true;
+    }
+  }
+  return false;
+}
+
+template<class Entry>
+void appdb::load_all_entries_of_type() const {
+  const section_index& index = _indices[get_section<Entry>()];
+  for(uint64_t i = 0; i < index.num_slots; ++i) {
+    const index_slot& slot = index.slots[i];
+    if(slot.size > 0)
+      load_entry<Entry>(id_type{slot.id[0], slot.id[1]});
+  }
+}
+
+void appdb::load_all_entries() const {
+  {
+    read_lock lock {_lock};
+    if(_are_all_entries_loaded)
+      return;
+  }
+  write_lock lock {_lock};
+  if(_are_all_entries_loaded)
+    return;
+  load_all_entries_of_type<kernel_entry>();
+  load_all_entries_of_type<binary_entry>();
+  load_all_entries_of_type<group_size_entry>();
+  load_all_entries_of_type<branch_profile_entry>();
+  _are_all_entries_loaded = true;
+}
+
+template<class Entry>
+void appdb::serialize_entries(
+    const appdb &current,
+    std::vector<std::pair<id_type, std::string>> &out) const {
+  constexpr section s = get_section<Entry>();
+  auto& entries = get_entries<Entry>(_data);
+
+  auto pack = [](Entry& entry) {
+    auto packed = msgpack::pack(entry);
+    return std::string{reinterpret_cast<const char *>(packed.data()),
+                       packed.size()};
+  };
+
+  // Serialized modified entries of this process, or an empty string for
+  // removed entries
+  std::unordered_map<id_type, std::string, rt::kernel_id_hash> modified;
+  if(_are_all_entries_dirty) {
+    for(auto& entry : entries) {
+      std::string serialized = pack(entry.second);
+      std::string_view base;
+      // Only entries that differ from the loaded state are modified
+      if(!find_serialized_entry(s, entry.first, base) || base != serialized)
+        modified[entry.first] = std::move(serialized);
+    }
+    const section_index& index = _indices[s];
+    for(uint64_t i = 0; i < index.num_slots; ++i) {
+      id_type id{index.slots[i].id[0], index.slots[i].id[1]};
+      if(index.slots[i].size > 0 && entries.find(id) == entries.end())
+        modified[id] = std::string{};
+    }
+  } else {
+    for(const auto& id : _dirty_entries[s]) {
+      auto it = entries.find(id);
+      if(it != entries.end())
+        modified[id] = pack(it->second);
+    }
+  }
+
+  // Keep the entries in the file that we have not modified, including those
+  // stored by other processes since we have loaded the database.
+  const section_index& current_index = current._indices[s];
+  for(uint64_t i = 0; i < current_index.num_slots; ++i) {
+    const index_slot& slot = current_index.slots[i];
+    id_type id{slot.id[0], slot.id[1]};
+    if(slot.size > 0 && modified.find(id) == modified.end())
+      out.emplace_back(
+          id, std::string{current._file_data + slot.offset, slot.size});
+  }
+
+  for(auto& entry : modified) {
+    if(entry.second.empty())
+      continue;
+
+    std::string_view base_serialized;
+    std::string_view current_serialized;
+    bool has_base = find_serialized_entry(s, entry.first, base_serialized);
+    bool has_current =
+        current.find_serialized_entry(s, entry.first, current_serialized);
+
+    if (has_current &&
+        (!has_base || base_serialized != current_serialized)) {
+      // Another process has stored the entry since we have loaded it
+      std::error_code ec;
+      auto unpack = [&](std::string_view serialized) {
+        return msgpack::unpack<Entry>(
+            reinterpret_cast<const uint8_t *>(serialized.data()),
+            serialized.size(), ec);
+      };
+      Entry merged = unpack(current_serialized);
+      Entry base = has_base ? unpack(base_serialized) : Entry{};
+      merge_entry(merged, base, entries.at(entry.first));
+      out.emplace_back(entry.first, pack(merged));
+    } else {
+      out.emplace_back(entry.first, std::move(entry.second));
+    }
   }
 }
 
-}
\ No newline at end of file
+std::string appdb::serialize(const appdb& current) const {
+  // Serialized entries of each section
+  std::array<std::vector<std::pair<id_type, std::string>>, num_sections>
+      sections;
+  serialize_entries<kernel_entry>(current, sections[kernels_section]);
+  serialize_entries<binary_entry>(current, sections[binaries_section]);
+  serialize_entries<group_size_entry>(current, sections[group_sizes_section]);
+  serialize_entries<branch_profile_entry>(current,
+                                          sections[branch_profiles_section]);
+
+  auto align = [](std::size_t offset) {
+    return (offset + alignof(index_slot) - 1) & ~(alignof(index_slot) - 1);
+  };
+
+  std::array<section_header, num_sections> section_headers;
+  std::size_t offset = sizeof(file_header) + sizeof(section_headers);
+  for(int i = 0; i < num_sections; ++i) {
+    section_headers[i].index_offset = offset;
+    section_headers[i].num_slots = get_num_slots(sections[i].size());
+    offset += section_headers[i].num_slots * sizeof(index_slot);
+  }
+
+  std::string result(offset, '\0');
+  file_header header{appdb_magic, format_version, _data.content_version,
+                     num_sections};
+  std::memcpy(result.data(), &header, sizeof(header));
+  std::memcpy(result.data() + sizeof(header), section_headers.data(),
+              sizeof(section_headers));
+
+  for(int i = 0; i < num_sections; ++i) {
+    const uint64_t num_slots = section_headers[i].num_slots;
+    std::vector<index_slot> slots(num_slots, index_slot{{0, 0}, 0, 0});
+
+    for(const auto& entry : sections[i]) {
+      uint64_t mask = num_slots - 1;
+      uint64_t slot = get_slot_hash(entry.first.data()) & mask;
+      while(slots[slot].size != 0)
+        slot = (slot + 1) & mask;
+
+      slots[slot].id[0] = entry.first[0];
+      slots[slot].id[1] = entry.first[1];
+      slots[slot].offset = result.size();
+      slots[slot].size = entry.second.size();
+      result += entry.second;
+      // An empty entry would be confused with an empty slot
+      if(entry.second.empty()) {
+        slots[slot].size = 1;
+        result += '\0';
+      }
+      result.resize(align(result.size()), '\0');
+    }
+    if(num_slots > 0)
+      std::memcpy(result.data() + section_headers[i].index_offset,
+                  slots.data(), num_slots * sizeof(index_slot));
+  }
+  return result;
+}
+
+}
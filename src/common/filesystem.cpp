@@ -20,9 +20,14 @@
 #include <memory>
 #include <random>
 #include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <thread>
 
 #ifndef _WIN32
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/file.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <pwd.h>
@@ -146,6 +151,25 @@ bool atomic_write(const std::string &filename, const std::string &data) {
   return true;
 }
 
+bool atomic_hard_link(const std::string &existing, const std::string &filename) {
+  fs::path p{filename};
+
+  std::string temp_file = std::to_string(random_number<std::size_t>())+".tmp";
+  fs::path tmp_path = p.parent_path() / temp_file;
+
+  std::error_code err;
+  fs::create_hard_link(existing, tmp_path, err);
+  if(err)
+    return false;
+
+  fs::rename(tmp_path, p, err);
+  if(err) {
+    fs::remove(tmp_path, err);
+    return false;
+  }
+  return true;
+}
+
 bool remove(const std::string &filename) {
   try {
     return fs::remove(filename);
@@ -153,6 +177,44 @@ bool remove(const std::string &filename) {
   return false;
 }
 
+file_lock::file_lock(const std::string& path) {
+#ifndef _WIN32
+  _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if(_fd >= 0 && flock(_fd, LOCK_EX) != 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+#endif
+}
+
+file_lock::file_lock(const std::string& path, std::size_t timeout_ms) {
+#ifndef _WIN32
+  _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if(_fd < 0)
+    return;
+
+  auto deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds{timeout_ms};
+  while(flock(_fd, LOCK_EX | LOCK_NB) != 0) {
+    if(errno != EWOULDBLOCK || std::chrono::steady_clock::now() >= deadline) {
+      ::close(_fd);
+      _fd = -1;
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+#endif
+}
+
+file_lock::~file_lock() {
+#ifndef _WIN32
+  if(_fd >= 0) {
+    flock(_fd, LOCK_UN);
+    ::close(_fd);
+  }
+#endif
+}
+
 persistent_storage::persistent_storage() {
 #ifndef _WIN32
 
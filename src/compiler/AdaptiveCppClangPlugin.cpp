@@ -66,6 +66,11 @@ static llvm::cl::opt<bool> StdparNoMallocToUSM{
     "acpp-stdpar-no-malloc-to-usm", llvm::cl::init(false),
     llvm::cl::desc{"Disable hipSYCL C++ standard parallelism malloc-to-usm compiler-side support"}};
 
+static llvm::cl::opt<bool> StdparNoHostOnlyAllocationAnalysis{
+    "acpp-stdpar-no-host-only-allocation-analysis", llvm::cl::init(false),
+    llvm::cl::desc{"Move all allocations to USM in stdpar malloc-to-usm, including "
+                   "those that provably never reach stdpar algorithms"}};
+
 // Register and activate passes
 
 static clang::FrontendPluginRegistry::Add<hipsycl::compiler::FrontendASTAction>
@@ -139,7 +144,7 @@ extern "C" LLVM_ATTRIBUTE_WEAK ::llvm::PassPluginLibraryInfo llvmGetPassPluginIn
           if(EnableStdPar) {
             PB.registerPipelineStartEPCallback([&](llvm::ModulePassManager &MPM, OptLevel Level) {
               if(!StdparNoMallocToUSM) {
-                MPM.addPass(MallocToUSMPass{});
+                MPM.addPass(MallocToUSMPass{!StdparNoHostOnlyAllocationAnalysis});
               }
             });
           
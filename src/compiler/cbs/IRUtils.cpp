@@ -68,17 +68,49 @@ bool hasOnlyBarrier(const llvm::BasicBlock *BB,
   return endsWithBarrier(BB, SAA) && BB->size() == 2;
 }
 
+// Returns true in case no instruction with side effects except for other
+// barriers can be executed after the given barrier until the function returns.
+// Such barriers have no observable effect, as the work group completes anyway.
+bool isTrailingBarrier(const llvm::Instruction *Barrier,
+                       const hipsycl::compiler::SplitterAnnotationInfo &SAA) {
+  llvm::SmallPtrSet<const llvm::BasicBlock *, 8> Visited;
+  llvm::SmallVector<const llvm::Instruction *, 8> WorkList{Barrier->getNextNode()};
+
+  while (!WorkList.empty()) {
+    const llvm::Instruction *I = WorkList.pop_back_val();
+    for (; !I->isTerminator(); I = I->getNextNode()) {
+      if (isBarrier(I, SAA) || llvm::isa<llvm::DbgInfoIntrinsic>(I) || I->isLifetimeStartOrEnd())
+        continue;
+      if (I->mayHaveSideEffects())
+        return false;
+    }
+
+    if (I->getNumSuccessors() == 0 && !llvm::isa<llvm::ReturnInst>(I))
+      return false;
+
+    for (unsigned S = 0; S < I->getNumSuccessors(); ++S)
+      if (Visited.insert(I->getSuccessor(S)).second)
+        WorkList.push_back(&I->getSuccessor(S)->front());
+  }
+  return true;
+}
+
 // Returns true in case the given function is a kernel with work-group
-// barriers inside it.
+// barriers inside it. The implicit entry barrier and barriers at the end of
+// the kernel are ignored, so that such kernels do not require sub-CFG formation.
 bool hasBarriers(const llvm::Function &F, const hipsycl::compiler::SplitterAnnotationInfo &SAA) {
   for (auto &BB : F) {
-    if (blockHasBarrier(&BB, SAA)) {
+    for (auto &I : BB) {
+      if (!isBarrier(&I, SAA))
+        continue;
 
-      // Ignore the implicit entry and exit barriers.
+      // Ignore the implicit entry barrier.
       if (hasOnlyBarrier(&BB, SAA) && &BB == &F.getEntryBlock())
         continue;
 
-      if (hasOnlyBarrier(&BB, SAA) && BB.getTerminator()->getNumSuccessors() == 0)
+      // Ignore the implicit exit barriers, and explicit barriers that are
+      // only followed by code without side effects.
+      if (isTrailingBarrier(&I, SAA))
         continue;
 
       return true;
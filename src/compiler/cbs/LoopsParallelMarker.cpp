@@ -17,6 +17,9 @@
 
 #include <llvm/Analysis/TargetTransformInfo.h>
 #include <llvm/IR/Dominators.h>
+#include <llvm/IR/Instructions.h>
+
+#include <algorithm>
 
 namespace {
 using namespace hipsycl::compiler;
@@ -57,6 +60,78 @@ void markLoopParallel(llvm::Function &F, llvm::Loop *L) {
   }
 }
 
+// summary of the vector shapes annotated by SubCfgFormation for the accesses in a wi-loop
+struct LoopShapeInfo {
+  std::size_t NumShapedAccesses = 0;
+  std::size_t NumVaryingAccesses = 0;
+  std::size_t NumDivergentBranches = 0;
+  // widest scalar type accessed per work-item
+  unsigned WidestAccessBits = 0;
+  bool HasNonScalarAccess = false;
+};
+
+LoopShapeInfo getLoopShapeInfo(const llvm::Function &F, const llvm::Loop *L) {
+  const auto &DL = F.getParent()->getDataLayout();
+  LoopShapeInfo Info;
+  for (auto *BB : L->blocks()) {
+    for (auto &I : *BB) {
+      auto *MD = I.getMetadata(hipsycl::compiler::MDKind::VectorShape);
+      if (!MD || MD->getNumOperands() != 1)
+        continue;
+      auto *Kind = llvm::dyn_cast<llvm::MDString>(MD->getOperand(0));
+      if (!Kind)
+        continue;
+      const bool IsVarying = Kind->getString() == "varying";
+
+      if (llvm::isa<llvm::BranchInst>(I)) {
+        if (IsVarying)
+          ++Info.NumDivergentBranches;
+        continue;
+      }
+
+      ++Info.NumShapedAccesses;
+      if (IsVarying)
+        ++Info.NumVaryingAccesses;
+
+      auto *T = llvm::getLoadStoreType(&I);
+      if (!T->isIntOrPtrTy() && !T->isFloatingPointTy()) {
+        // uniform accesses are not widened
+        if (Kind->getString() != "uniform")
+          Info.HasNonScalarAccess = true;
+        continue;
+      }
+      Info.WidestAccessBits = std::max(
+          Info.WidestAccessBits,
+          static_cast<unsigned>(DL.getTypeSizeInBits(T).getKnownMinValue()));
+    }
+  }
+  return Info;
+}
+
+// If all accesses in the loop are at most strided, the loop vectorizer's own cost model is not
+// required to decide profitability. This is important for nd_range kernels, where the index
+// computations (e.g. through arrayified local memory) often make it unnecessarily pessimistic.
+// Masking for divergent control flow is still left to the vectorizer, which checks its
+// legality for the target.
+unsigned getShapeGuidedVectorWidth(const llvm::Function &F, const llvm::TargetTransformInfo &TTI,
+                                   const llvm::Loop *L) {
+  const auto Info = getLoopShapeInfo(F, L);
+  HIPSYCL_DEBUG_INFO << "[ParallelMarker] loop " << L->getHeader()->getName() << ": "
+                     << Info.NumShapedAccesses << " accesses, " << Info.NumVaryingAccesses
+                     << " varying, " << Info.NumDivergentBranches << " divergent branches\n";
+
+  if (Info.NumShapedAccesses == 0 || Info.NumVaryingAccesses > 0 || Info.HasNonScalarAccess ||
+      Info.WidestAccessBits == 0)
+    return 0;
+
+  const auto RegisterKind = TTI.supportsScalableVectors()
+                                ? llvm::TargetTransformInfo::RGK_ScalableVector
+                                : llvm::TargetTransformInfo::RGK_FixedWidthVector;
+  const unsigned RegisterBits = TTI.getRegisterBitWidth(RegisterKind).getKnownMinValue();
+  const unsigned Width = RegisterBits / Info.WidestAccessBits;
+  return Width >= 2 ? Width : 0;
+}
+
 void addVectorizationHints(const llvm::Function &F, const llvm::TargetTransformInfo &TTI,
                            const llvm::Loop *L) {
   llvm::SmallVector<llvm::MDNode *, 3> PostTransformMD;
@@ -81,6 +156,20 @@ void addVectorizationHints(const llvm::Function &F, const llvm::TargetTransformI
     }
   }
 
+  // derive the vectorization factor from the vector shapes and the target's register width
+  if (!llvm::findOptionMDForLoop(L, "llvm.loop.vectorize.width")) {
+    if (unsigned Width = getShapeGuidedVectorWidth(F, TTI, L)) {
+      HIPSYCL_DEBUG_INFO << "[ParallelMarker] use vector width " << Width << " for loop "
+                         << L->getHeader()->getName() << "\n";
+      auto *MDWidth = llvm::MDNode::get(
+          F.getContext(),
+          {llvm::MDString::get(F.getContext(), "llvm.loop.vectorize.width"),
+           llvm::ConstantAsMetadata::get(
+               llvm::ConstantInt::get(llvm::IntegerType::get(F.getContext(), 32), Width))});
+      PostTransformMD.push_back(MDWidth);
+    }
+  }
+
   if (!PostTransformMD.empty()) {
     auto *LoopID =
         llvm::makePostTransformationMetadata(F.getContext(), L->getLoopID(), {}, PostTransformMD);
@@ -260,6 +260,64 @@ getVectorizationInfo(llvm::Function &F, hipsycl::compiler::Region &R, llvm::Loop
   return VecInfo;
 }
 
+llvm::StringRef getShapeKindName(const hipsycl::compiler::VectorShape &Shape) {
+  if (Shape.isUniform())
+    return "uniform";
+  if (Shape.isContiguous())
+    return "contiguous";
+  if (Shape.isContiguousOrStrided())
+    return "strided";
+  return "varying";
+}
+
+// Annotates memory accesses and conditional branches with their vector shape w.r.t. the
+// innermost wi-loop. Once the local ids are replaced by induction variables, the shapes can
+// no longer be computed, so LoopsParallelMarker relies on these to guide vectorization.
+void annotateVectorShapes(llvm::Function &F, llvm::LoopInfo &LI, llvm::DominatorTree &DT,
+                          llvm::PostDominatorTree &PDT, std::size_t Dim) {
+  std::vector<llvm::BasicBlock *> Blocks;
+  Blocks.reserve(std::distance(F.begin(), F.end()));
+  std::transform(F.begin(), F.end(), std::back_inserter(Blocks), [](auto &BB) { return &BB; });
+
+  auto RImpl = getRegion(F, LI, Blocks);
+  hipsycl::compiler::Region R{*RImpl};
+  hipsycl::compiler::VectorizationInfo VecInfo{F, R};
+
+  // only the innermost dimension varies across the iterations of the innermost wi-loop
+  for (size_t D = 0; D < Dim; ++D) {
+    auto *GV = F.getParent()->getNamedGlobal(LocalIdGlobalNames[D]);
+    if (!GV)
+      continue;
+    const auto Shape = D == Dim - 1 ? hipsycl::compiler::VectorShape::cont()
+                                    : hipsycl::compiler::VectorShape::uni();
+    for (auto *U : GV->users())
+      if (auto *Load = llvm::dyn_cast<llvm::LoadInst>(U); Load && Load->getFunction() == &F)
+        VecInfo.setPinnedShape(*Load, Shape);
+  }
+
+  hipsycl::compiler::VectorizationAnalysis VecAna{VecInfo, LI, DT, PDT};
+  VecAna.analyze();
+
+  auto &Ctx = F.getContext();
+  for (auto &BB : F) {
+    for (auto &I : BB) {
+      const llvm::Value *Shaped = nullptr;
+      if (auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I))
+        Shaped = Load->getPointerOperand();
+      else if (auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I))
+        Shaped = Store->getPointerOperand();
+      else if (auto *Br = llvm::dyn_cast<llvm::BranchInst>(&I); Br && Br->isConditional())
+        Shaped = Br;
+
+      if (!Shaped || !VecInfo.hasKnownShape(*Shaped))
+        continue;
+      I.setMetadata(hipsycl::compiler::MDKind::VectorShape,
+                    llvm::MDNode::get(Ctx, {llvm::MDString::get(
+                                               Ctx, getShapeKindName(VecInfo.getVectorShape(*Shaped)))}));
+    }
+  }
+}
+
 // create the wi-loops around a kernel or subCFG, LastHeader input should be the load block,
 // ContiguousIdx may be any identifyable value (load from undef)
 void createLoopsAround(llvm::Function &F, llvm::BasicBlock *AfterBB,
@@ -1381,6 +1439,8 @@ bool SubCfgFormationPassLegacy::runOnFunction(llvm::Function &F) {
   auto &PDT = getAnalysis<llvm::PostDominatorTreeWrapperPass>().getPostDomTree();
   auto &LI = getAnalysis<llvm::LoopInfoWrapperPass>().getLoopInfo();
 
+  annotateVectorShapes(F, LI, DT, PDT, getRangeDim(F));
+
   if (utils::hasBarriers(F, SAA))
     formSubCfgs(F, LI, DT, PDT, SAA, false);
   else
@@ -1405,6 +1465,8 @@ llvm::PreservedAnalyses SubCfgFormationPass::run(llvm::Function &F,
   auto &PDT = AM.getResult<llvm::PostDominatorTreeAnalysis>(F);
   auto &LI = AM.getResult<llvm::LoopAnalysis>(F);
 
+  annotateVectorShapes(F, LI, DT, PDT, getRangeDim(F));
+
   if (utils::hasBarriers(F, *SAA))
     formSubCfgs(F, LI, DT, PDT, *SAA, IsSscp_);
   else
@@ -0,0 +1,88 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/AtomicAggregationPass.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+// Values of sycl::access::address_space and sycl::memory_order as passed
+// to the __acpp_sscp_atomic_* builtins
+constexpr uint64_t GlobalAddressSpace = 0;
+constexpr uint64_t GenericAddressSpace = 4;
+constexpr uint64_t RelaxedMemoryOrder = 0;
+
+bool isConstantArg(llvm::CallInst *C, unsigned Index, uint64_t Value) {
+  if(auto* CI = llvm::dyn_cast<llvm::ConstantInt>(C->getArgOperand(Index)))
+    return CI->getZExtValue() == Value;
+  return false;
+}
+
+bool isAggregatable(llvm::CallInst *C) {
+  if(C->arg_size() != 5)
+    return false;
+  // Stronger memory orders would need to be provided for all work items,
+  // not only the one performing the combined operation.
+  if(!isConstantArg(C, 1, RelaxedMemoryOrder))
+    return false;
+  return isConstantArg(C, 0, GlobalAddressSpace) || isConstantArg(C, 0, GenericAddressSpace);
+}
+
+bool aggregateCalls(llvm::Module &M, const std::string &Suffix) {
+  llvm::Function *F = M.getFunction("__acpp_sscp_atomic_fetch_add_" + Suffix);
+  if(!F)
+    return false;
+
+  std::vector<llvm::CallInst*> Calls;
+  for(auto* U : F->users())
+    if(auto* C = llvm::dyn_cast<llvm::CallInst>(U))
+      if(C->getCalledFunction() == F && isAggregatable(C))
+        Calls.push_back(C);
+
+  if(Calls.empty())
+    return false;
+
+  llvm::FunctionCallee Aggregated = M.getOrInsertFunction(
+      "__acpp_sscp_atomic_fetch_add_aggregated_" + Suffix, F->getFunctionType());
+  if(auto* AggregatedF = llvm::dyn_cast<llvm::Function>(Aggregated.getCallee()))
+    AggregatedF->addFnAttr(llvm::Attribute::Convergent);
+
+  for(auto* C : Calls) {
+    C->setCalledFunction(Aggregated);
+    C->addFnAttr(llvm::Attribute::Convergent);
+  }
+
+  HIPSYCL_DEBUG_INFO << "AtomicAggregationPass: Aggregating " << Calls.size()
+                     << " calls to " << F->getName().str() << "\n";
+  return true;
+}
+
+}
+
+llvm::PreservedAnalyses AtomicAggregationPass::run(llvm::Module &M,
+                                                   llvm::ModuleAnalysisManager &MAM) {
+  bool Changed = false;
+  for(const char* Suffix : {"i32", "i64", "u32", "u64"})
+    Changed |= aggregateCalls(M, Suffix);
+
+  return Changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+}
+
+}
+}
@@ -0,0 +1,141 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/BranchProfilePass.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/MDBuilder.h>
+#include <llvm/IR/Module.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+llvm::SmallVector<llvm::BranchInst *, 32>
+getConditionalBranches(llvm::Module &M, const std::vector<std::string> &KernelNames) {
+  llvm::SmallVector<llvm::BranchInst *, 32> Branches;
+  for(const auto& Name : KernelNames) {
+    if(auto* F = M.getFunction(Name)) {
+      for(auto& BB : *F)
+        if(auto* BI = llvm::dyn_cast<llvm::BranchInst>(BB.getTerminator()))
+          if(BI->isConditional())
+            Branches.push_back(BI);
+    }
+  }
+  return Branches;
+}
+
+}
+
+BranchProfileInstrumentationPass::BranchProfileInstrumentationPass(
+    const std::vector<std::string> &Kernels, uint64_t Address, std::size_t Size,
+    unsigned GlobalAS)
+    : KernelNames{Kernels}, CountersAddress{Address}, NumCounters{Size},
+      GlobalAddressSpace{GlobalAS} {}
+
+llvm::PreservedAnalyses BranchProfileInstrumentationPass::run(llvm::Module &M,
+                                                              llvm::ModuleAnalysisManager &MAM) {
+  if(CountersAddress == 0 || NumCounters < 3)
+    return llvm::PreservedAnalyses::all();
+
+  auto Branches = getConditionalBranches(M, KernelNames);
+  std::size_t NumInstrumented = std::min(Branches.size(), (NumCounters - 1) / 2);
+
+  llvm::Type *CounterTy = llvm::Type::getInt64Ty(M.getContext());
+#if LLVM_VERSION_MAJOR < 16
+  llvm::Type *CountersPtrTy = llvm::PointerType::get(CounterTy, GlobalAddressSpace);
+#else
+  llvm::Type *CountersPtrTy = llvm::PointerType::get(M.getContext(), GlobalAddressSpace);
+#endif
+  llvm::Constant *Counters = llvm::ConstantExpr::getIntToPtr(
+      llvm::ConstantInt::get(CounterTy, CountersAddress), CountersPtrTy);
+  const llvm::Align CounterAlign{sizeof(uint64_t)};
+
+  // Record the number of branches, such that profiles of different IR can be detected.
+  for(const auto& Name : KernelNames) {
+    if(auto* F = M.getFunction(Name)) {
+      if(F->isDeclaration())
+        continue;
+      llvm::IRBuilder<> Builder{&*F->getEntryBlock().getFirstInsertionPt()};
+      llvm::StoreInst *SI = Builder.CreateAlignedStore(
+          llvm::ConstantInt::get(CounterTy, Branches.size()), Counters, CounterAlign);
+      SI->setAtomic(llvm::AtomicOrdering::Monotonic);
+    }
+  }
+
+  for(std::size_t i = 0; i < NumInstrumented; ++i) {
+    llvm::BranchInst *BI = Branches[i];
+    llvm::IRBuilder<> Builder{BI};
+    llvm::Value *CounterIndex = Builder.CreateSelect(
+        BI->getCondition(), llvm::ConstantInt::get(CounterTy, 1 + 2 * i),
+        llvm::ConstantInt::get(CounterTy, 2 + 2 * i));
+    llvm::Value *Counter = Builder.CreateGEP(CounterTy, Counters, CounterIndex);
+    Builder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, Counter,
+                            llvm::ConstantInt::get(CounterTy, 1), CounterAlign,
+                            llvm::AtomicOrdering::Monotonic);
+  }
+
+  HIPSYCL_DEBUG_INFO << "BranchProfileInstrumentationPass: Instrumented " << NumInstrumented
+                     << " of " << Branches.size() << " conditional branches\n";
+
+  return llvm::PreservedAnalyses::none();
+}
+
+BranchProfileAnnotationPass::BranchProfileAnnotationPass(const std::vector<std::string> &Kernels,
+                                                         const std::vector<uint64_t> &P)
+    : KernelNames{Kernels}, Profile{P} {}
+
+llvm::PreservedAnalyses BranchProfileAnnotationPass::run(llvm::Module &M,
+                                                         llvm::ModuleAnalysisManager &MAM) {
+  if(Profile.empty())
+    return llvm::PreservedAnalyses::all();
+
+  auto Branches = getConditionalBranches(M, KernelNames);
+  if(Profile[0] != Branches.size()) {
+    HIPSYCL_DEBUG_WARNING << "BranchProfileAnnotationPass: Profile was recorded for "
+                          << Profile[0] << " branches, but kernels have " << Branches.size()
+                          << " branches; ignoring profile.\n";
+    return llvm::PreservedAnalyses::all();
+  }
+
+  llvm::MDBuilder MDB{M.getContext()};
+  std::size_t NumAnnotated = 0;
+  for(std::size_t i = 0; i < Branches.size() && 2 + 2 * i < Profile.size(); ++i) {
+    uint64_t TrueCount = Profile[1 + 2 * i];
+    uint64_t FalseCount = Profile[2 + 2 * i];
+    // Branches that were never reached carry no information
+    if(TrueCount == 0 && FalseCount == 0)
+      continue;
+
+    // Branch weights are 32 bit, so scale counts down if necessary
+    uint64_t Scale = std::max(TrueCount, FalseCount) / std::numeric_limits<uint32_t>::max() + 1;
+    Branches[i]->setMetadata(
+        llvm::LLVMContext::MD_prof,
+        MDB.createBranchWeights(static_cast<uint32_t>(TrueCount / Scale),
+                                static_cast<uint32_t>(FalseCount / Scale)));
+    ++NumAnnotated;
+  }
+
+  HIPSYCL_DEBUG_INFO << "BranchProfileAnnotationPass: Attached branch weights to "
+                     << NumAnnotated << " of " << Branches.size() << " conditional branches\n";
+
+  return NumAnnotated > 0 ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+}
+
+}
+}
@@ -0,0 +1,267 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/KernelArgumentAttributeInferencePass.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+struct PointerUsage {
+  bool IsWritten = false;
+  // Pointers derived from the argument may be accessed in ways that we
+  // cannot follow, e.g. after being stored to memory or converted to integers
+  bool IsCaptured = false;
+};
+
+class PointerUsageAnalysis {
+public:
+  PointerUsage getUsage(llvm::Argument *A) {
+    auto It = Results.find(A);
+    if(It != Results.end())
+      return It->second;
+
+    // Pessimistic result for recursive calls while A is being analyzed
+    Results[A] = PointerUsage{true, true};
+    PointerUsage Usage = analyze(A);
+    Results[A] = Usage;
+    return Usage;
+  }
+
+private:
+  PointerUsage analyze(llvm::Value *Ptr) {
+    PointerUsage Usage;
+    llvm::SmallVector<llvm::Value*, 16> Worklist{Ptr};
+    llvm::SmallPtrSet<llvm::Value*, 16> Visited{Ptr};
+
+    auto Follow = [&](llvm::Value* V) {
+      if(Visited.insert(V).second)
+        Worklist.push_back(V);
+    };
+
+    while(!Worklist.empty() && !Usage.IsCaptured) {
+      llvm::Value* V = Worklist.pop_back_val();
+      for(llvm::Use& U : V->uses()) {
+        llvm::User* User = U.getUser();
+
+        if (llvm::isa<llvm::GetElementPtrInst>(User) || llvm::isa<llvm::BitCastInst>(User) ||
+            llvm::isa<llvm::AddrSpaceCastInst>(User) || llvm::isa<llvm::PHINode>(User) ||
+            llvm::isa<llvm::SelectInst>(User)) {
+          Follow(User);
+        } else if(llvm::isa<llvm::LoadInst>(User) || llvm::isa<llvm::ICmpInst>(User)) {
+          // Reading or comparing the pointer is fine
+        } else if(auto* SI = llvm::dyn_cast<llvm::StoreInst>(User)) {
+          if(SI->getValueOperand() == V)
+            Usage.IsCaptured = true;
+          else
+            Usage.IsWritten = true;
+        } else if(auto* RMW = llvm::dyn_cast<llvm::AtomicRMWInst>(User)) {
+          if(RMW->getPointerOperand() == V)
+            Usage.IsWritten = true;
+          else
+            Usage.IsCaptured = true;
+        } else if(auto* CX = llvm::dyn_cast<llvm::AtomicCmpXchgInst>(User)) {
+          if(CX->getPointerOperand() == V)
+            Usage.IsWritten = true;
+          else
+            Usage.IsCaptured = true;
+        } else if(auto* CB = llvm::dyn_cast<llvm::CallBase>(User)) {
+          analyzeCallUse(CB, U, Usage);
+        } else {
+          // ptrtoint, returns, aggregates, ...
+          Usage.IsCaptured = true;
+        }
+      }
+    }
+    return Usage;
+  }
+
+  void analyzeCallUse(llvm::CallBase *CB, llvm::Use &U, PointerUsage &Usage) {
+    if(auto* MT = llvm::dyn_cast<llvm::MemTransferInst>(CB)) {
+      if(&U == &MT->getRawDestUse())
+        Usage.IsWritten = true;
+      else if(&U != &MT->getRawSourceUse())
+        Usage.IsCaptured = true;
+      return;
+    }
+    if(auto* MS = llvm::dyn_cast<llvm::MemSetInst>(CB)) {
+      if(&U == &MS->getRawDestUse())
+        Usage.IsWritten = true;
+      else
+        Usage.IsCaptured = true;
+      return;
+    }
+    if(auto* II = llvm::dyn_cast<llvm::IntrinsicInst>(CB)) {
+      // Lifetime markers, assumptions, debug info
+      if(!II->isAssumeLikeIntrinsic())
+        Usage.IsCaptured = true;
+      return;
+    }
+
+    llvm::Function* Callee = CB->getCalledFunction();
+    if (!Callee || Callee->isDeclaration() || Callee->isVarArg() || !CB->isArgOperand(&U) ||
+        CB->getArgOperandNo(&U) >= Callee->arg_size()) {
+      Usage.IsCaptured = true;
+      return;
+    }
+
+    PointerUsage CalleeUsage = getUsage(Callee->getArg(CB->getArgOperandNo(&U)));
+    Usage.IsWritten |= CalleeUsage.IsWritten;
+    Usage.IsCaptured |= CalleeUsage.IsCaptured;
+  }
+
+  llvm::DenseMap<llvm::Argument*, PointerUsage> Results;
+};
+
+// Collects the pointers that F writes through. Returns false if F might write memory
+// through pointers that cannot be determined.
+bool collectWrittenPointers(llvm::Function &F, llvm::SmallVectorImpl<llvm::Value *> &Out) {
+  for(auto& BB : F) {
+    for(auto& I : BB) {
+      if(!I.mayWriteToMemory())
+        continue;
+
+      if(auto* SI = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+        Out.push_back(SI->getPointerOperand());
+      } else if(auto* RMW = llvm::dyn_cast<llvm::AtomicRMWInst>(&I)) {
+        Out.push_back(RMW->getPointerOperand());
+      } else if(auto* CX = llvm::dyn_cast<llvm::AtomicCmpXchgInst>(&I)) {
+        Out.push_back(CX->getPointerOperand());
+      } else if(auto* MI = llvm::dyn_cast<llvm::MemIntrinsic>(&I)) {
+        Out.push_back(MI->getRawDest());
+      } else if(llvm::isa<llvm::FenceInst>(&I)) {
+        // Only orders memory accesses
+      } else if(auto* CB = llvm::dyn_cast<llvm::CallBase>(&I)) {
+        if(auto* II = llvm::dyn_cast<llvm::IntrinsicInst>(CB))
+          if(II->isAssumeLikeIntrinsic())
+            continue;
+        if(CB->onlyReadsMemory() || CB->onlyAccessesInaccessibleMemory())
+          continue;
+        if(!CB->onlyAccessesArgMemory())
+          return false;
+        for(auto& Arg : CB->args())
+          if(Arg->getType()->isPointerTy())
+            Out.push_back(Arg);
+      } else {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Returns whether memory written through Ptr cannot be memory that A points to.
+bool cannotBeArgumentMemory(const llvm::Value *Ptr, const llvm::Argument *A,
+                            unsigned GlobalAddressSpace, unsigned LocalAddressSpace) {
+  llvm::SmallVector<const llvm::Value*, 8> Objects;
+  llvm::getUnderlyingObjects(Ptr, Objects, nullptr, 0);
+  for(const llvm::Value* Obj : Objects) {
+    if(llvm::isa<llvm::AllocaInst>(Obj))
+      continue;
+    if(auto* GV = llvm::dyn_cast<llvm::GlobalVariable>(Obj))
+      if (LocalAddressSpace != GlobalAddressSpace &&
+          GV->getType()->getPointerAddressSpace() == LocalAddressSpace)
+        continue;
+    if(auto* Other = llvm::dyn_cast<llvm::Argument>(Obj))
+      if(Other != A && Other->getParent() == A->getParent() && Other->hasNoAliasAttr())
+        continue;
+    return false;
+  }
+  return true;
+}
+
+bool isCandidateArgument(llvm::Argument &A, unsigned GlobalAddressSpace,
+                         unsigned LocalAddressSpace) {
+  if(!A.getType()->isPointerTy() || A.hasByValAttr() || A.hasByRefAttr())
+    return false;
+  // Dynamic local memory might be passed as argument on some backends
+  unsigned AS = A.getType()->getPointerAddressSpace();
+  if(LocalAddressSpace != GlobalAddressSpace && AS == LocalAddressSpace)
+    return false;
+  return true;
+}
+
+}
+
+KernelArgumentAttributeInferencePass::KernelArgumentAttributeInferencePass(
+    const std::vector<std::string> &Kernels, unsigned GlobalAS, unsigned LocalAS)
+    : KernelNames{Kernels}, GlobalAddressSpace{GlobalAS}, LocalAddressSpace{LocalAS} {}
+
+llvm::PreservedAnalyses
+KernelArgumentAttributeInferencePass::run(llvm::Module &M, llvm::ModuleAnalysisManager &MAM) {
+  PointerUsageAnalysis Analysis;
+  bool Changed = false;
+
+  for(const auto& Name : KernelNames) {
+    llvm::Function* F = M.getFunction(Name);
+    if(!F || F->isDeclaration())
+      continue;
+
+    llvm::SmallVector<llvm::Argument*, 8> ReadOnlyArgs;
+    for(auto& A : F->args()) {
+      if(!isCandidateArgument(A, GlobalAddressSpace, LocalAddressSpace))
+        continue;
+      PointerUsage Usage = Analysis.getUsage(&A);
+      if(Usage.IsWritten || Usage.IsCaptured)
+        continue;
+      ReadOnlyArgs.push_back(&A);
+      if(!A.onlyReadsMemory()) {
+        HIPSYCL_DEBUG_INFO << "KernelArgumentAttributeInferencePass: Argument " << A.getArgNo()
+                           << " of kernel " << Name << " is read-only\n";
+        A.addAttr(llvm::Attribute::ReadOnly);
+        Changed = true;
+      }
+    }
+
+    if(ReadOnlyArgs.empty())
+      continue;
+
+    // The memory of a read-only argument is not modified during the kernel if
+    // no write can reach it; then accesses through it cannot alias any other access
+    // that modifies memory.
+    llvm::SmallVector<llvm::Value*, 16> WrittenPointers;
+    if(!collectWrittenPointers(*F, WrittenPointers))
+      continue;
+
+    for(auto* A : ReadOnlyArgs) {
+      if(A->hasNoAliasAttr())
+        continue;
+      bool IsNoAlias = true;
+      for(auto* Ptr : WrittenPointers) {
+        if(!cannotBeArgumentMemory(Ptr, A, GlobalAddressSpace, LocalAddressSpace)) {
+          IsNoAlias = false;
+          break;
+        }
+      }
+      if(IsNoAlias) {
+        HIPSYCL_DEBUG_INFO << "KernelArgumentAttributeInferencePass: Argument " << A->getArgNo()
+                           << " of kernel " << Name << " does not alias\n";
+        A->addAttr(llvm::Attribute::NoAlias);
+        Changed = true;
+      }
+    }
+  }
+
+  return Changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+}
+
+}
+}
@@ -10,10 +10,16 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/AddressSpaceInferencePass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/AtomicAggregationPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/DeadArgumentEliminationPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/GlobalSizesFitInI32OptPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/GlobalInliningAttributorPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/KnownGroupSizeOptPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/KernelArgumentAttributeInferencePass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/LocalMemoryPaddingPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/LocalMemoryTilingPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/BranchProfilePass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/PerformanceRemarksPass.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/LLVMToBackend.hpp"
 #include "hipSYCL/compiler/llvm-to-backend/Utils.hpp"
 #include "hipSYCL/compiler/sscp/IRConstantReplacer.hpp"
@@ -25,10 +31,12 @@
 
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <llvm/ADT/APFloat.h>
+#include <llvm/ADT/StringSet.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/DerivedTypes.h>
 #include <llvm/IR/DiagnosticInfo.h>
 #include <llvm/IR/DiagnosticPrinter.h>
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/Support/raw_ostream.h>
@@ -39,7 +47,15 @@
 #include <llvm/Support/Error.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
+#include <llvm/Transforms/IPO/GlobalDCE.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
 #include <string>
+#include <thread>
+#include <unordered_map>
 
 namespace hipsycl {
 namespace compiler {
@@ -85,6 +101,235 @@ void setFastMathFunctionAttribs(llvm::Module& M) {
 }
 
 
+// Per-thread cache of parsed bitcode. Repeated JIT compilations, e.g.
+// respecializations of the same kernel, would otherwise spend a large part of
+// their time reading and parsing the same HCF bitcode and bitcode libraries
+// again. LLVM contexts cannot be shared across threads, so cached modules
+// live in a thread-local context and are cloned for each use.
+class ParsedModuleCache {
+public:
+  static ParsedModuleCache& get() {
+    static thread_local ParsedModuleCache Cache;
+    return Cache;
+  }
+
+  // Must be called before a transformation starts, i.e. while no module
+  // from the cache context is alive. Since LLVM contexts never free types and
+  // constants, the context is recreated after a number of transformations
+  // to bound memory usage.
+  void beginTransformation() {
+    ++NumTransformations;
+    if (NumTransformations > MaxTransformationsPerContext ||
+        Modules.size() > MaxCachedModules) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Resetting parsed module cache\n";
+      Modules.clear();
+      Files.clear();
+      Ctx = std::make_unique<llvm::LLVMContext>();
+      NumTransformations = 1;
+    }
+  }
+
+  llvm::LLVMContext& getContext() {
+    return *Ctx;
+  }
+
+  // Returns a clone of the module contained in Bitcode
+  llvm::Error load(const std::string &Bitcode, std::unique_ptr<llvm::Module> &Out) {
+    std::size_t Hash = std::hash<std::string>{}(Bitcode);
+    auto Candidates = Modules.equal_range(Hash);
+    for(auto It = Candidates.first; It != Candidates.second; ++It) {
+      if(It->second.Bitcode == Bitcode) {
+        Out = llvm::CloneModule(*It->second.M);
+        return llvm::Error::success();
+      }
+    }
+
+    std::unique_ptr<llvm::Module> M;
+    if(auto Err = loadModuleFromString(Bitcode, *Ctx, M))
+      return Err;
+    Out = llvm::CloneModule(*M);
+    Modules.emplace(Hash, CachedModule{Bitcode, std::move(M)});
+    return llvm::Error::success();
+  }
+
+  // Returns nullptr if the file cannot be read
+  const std::string* getFileContent(const std::string& Filename) {
+    auto It = Files.find(Filename);
+    if(It != Files.end())
+      return &It->second;
+
+    auto F = llvm::MemoryBuffer::getFile(Filename);
+    if(F.getError())
+      return nullptr;
+    return &(Files[Filename] = std::string{F.get()->getBuffer()});
+  }
+private:
+  ParsedModuleCache()
+  : Ctx{std::make_unique<llvm::LLVMContext>()} {}
+
+  struct CachedModule {
+    std::string Bitcode;
+    std::unique_ptr<llvm::Module> M;
+  };
+
+  static constexpr std::size_t MaxTransformationsPerContext = 256;
+  static constexpr std::size_t MaxCachedModules = 64;
+
+  // Modules must be destroyed before their context
+  std::unique_ptr<llvm::LLVMContext> Ctx;
+  std::unordered_multimap<std::size_t, CachedModule> Modules;
+  std::unordered_map<std::string, std::string> Files;
+  std::size_t NumTransformations = 0;
+};
+
+// Modules with fewer kernels are optimized on a single thread
+constexpr std::size_t MinKernelsForPartitionedOptimization = 16;
+constexpr std::size_t MinKernelsPerPartition = 4;
+
+// Adds or removes functions from llvm.compiler.used. While kernels are in
+// llvm.compiler.used, they are not removed by GlobalDCE even if they have no
+// definition in the module, such that metadata referring to them stays intact.
+void setRetainedByCompilerUsed(llvm::Module &M,
+                               const llvm::SmallVector<llvm::Function *> &Functions,
+                               bool Retain) {
+  if(Retain) {
+    llvm::SmallVector<llvm::GlobalValue*> Values{Functions.begin(), Functions.end()};
+    llvm::appendToCompilerUsed(M, Values);
+    return;
+  }
+
+  llvm::GlobalVariable* Used = M.getGlobalVariable("llvm.compiler.used");
+  if(!Used || !Used->hasInitializer())
+    return;
+
+  llvm::SmallVector<llvm::GlobalValue*> RemainingValues;
+  if(auto* Init = llvm::dyn_cast<llvm::ConstantArray>(Used->getInitializer())) {
+    for(auto& Op : Init->operands()) {
+      auto* GV = llvm::dyn_cast<llvm::GlobalValue>(Op->stripPointerCasts());
+      if (GV && std::find(Functions.begin(), Functions.end(), GV) == Functions.end())
+        RemainingValues.push_back(GV);
+    }
+  }
+  Used->eraseFromParent();
+  if(!RemainingValues.empty())
+    llvm::appendToCompilerUsed(M, RemainingValues);
+}
+
+void addReferencedGlobals(llvm::User *U, llvm::SmallPtrSetImpl<llvm::Constant *> &Visited,
+                          llvm::SmallVectorImpl<llvm::GlobalValue *> &Worklist) {
+  for(llvm::Value* Op : U->operands()) {
+    if(auto* GV = llvm::dyn_cast<llvm::GlobalValue>(Op)) {
+      if(Visited.insert(GV).second)
+        Worklist.push_back(GV);
+    } else if(auto* C = llvm::dyn_cast<llvm::Constant>(Op)) {
+      // Descend into constant expressions and aggregates
+      if(Visited.insert(C).second)
+        addReferencedGlobals(C, Visited, Worklist);
+    }
+  }
+}
+
+// Returns the names of all declarations that are (transitively) referenced
+// from the given root functions. Declarations that are only used by code
+// that is unreachable from the roots, e.g. by kernels of the same device image
+// that we are not compiling, do not need to be resolved.
+llvm::StringSet<> collectReachableDeclarations(llvm::Module &M,
+                                               const std::vector<std::string> &Roots) {
+  llvm::SmallPtrSet<llvm::Constant*, 32> Visited;
+  llvm::SmallVector<llvm::GlobalValue*, 64> Worklist;
+  for(const auto& Name : Roots) {
+    if(auto* F = M.getFunction(Name))
+      if(Visited.insert(F).second)
+        Worklist.push_back(F);
+  }
+
+  llvm::StringSet<> Result;
+  while(!Worklist.empty()) {
+    llvm::GlobalValue* GV = Worklist.pop_back_val();
+    if(GV->isDeclaration()) {
+      Result.insert(GV->getName());
+    } else if(auto* F = llvm::dyn_cast<llvm::Function>(GV)) {
+      for(auto& BB : *F)
+        for(auto& I : BB)
+          addReferencedGlobals(&I, Visited, Worklist);
+    } else {
+      // Global variables reference their initializer, aliases their aliasee
+      addReferencedGlobals(GV, Visited, Worklist);
+    }
+  }
+  return Result;
+}
+
+// Turns all kernels that are not contained in RetainedKernels into declarations,
+// and removes code that is only used by them.
+void restrictModuleToKernels(llvm::Module &M, const std::vector<std::string> &AllKernels,
+                             const std::vector<std::string> &RetainedKernels,
+                             llvm::ModuleAnalysisManager &MAM) {
+  llvm::SmallVector<llvm::Function*> RemovedKernels;
+  for(const auto& Name : AllKernels) {
+    if (std::find(RetainedKernels.begin(), RetainedKernels.end(), Name) !=
+        RetainedKernels.end())
+      continue;
+    if(auto* F = M.getFunction(Name)) {
+      if(!F->isDeclaration()) {
+        F->deleteBody();
+        RemovedKernels.push_back(F);
+      }
+    }
+  }
+  setRetainedByCompilerUsed(M, RemovedKernels, true);
+  llvm::GlobalDCEPass DCE;
+  DCE.run(M, MAM);
+  setRetainedByCompilerUsed(M, RemovedKernels, false);
+  MAM.clear();
+}
+
+// Prepares a partition that was optimized separately for linking into the
+// module M, which contains the remaining kernels and all module-level
+// metadata.
+void prepareForLinkingIntoModule(llvm::Module &Partition, llvm::Module &M) {
+  // Definitions of non-local symbols that are required by both modules must
+  // only be retained once.
+  auto IsDefinedInM = [&](llvm::GlobalValue& GV) {
+    llvm::GlobalValue* Other = M.getNamedValue(GV.getName());
+    return Other && !Other->isDeclaration();
+  };
+  for(auto& F : Partition) {
+    if(!F.isDeclaration() && !F.hasLocalLinkage() && IsDefinedInM(F))
+      F.deleteBody();
+  }
+  for(auto& GV : Partition.globals()) {
+    if(!GV.isDeclaration() && !GV.hasLocalLinkage() && IsDefinedInM(GV)) {
+      GV.setInitializer(nullptr);
+      GV.setLinkage(llvm::GlobalValue::ExternalLinkage);
+    }
+  }
+  // Named metadata (e.g. kernel annotations) is already present in M
+  llvm::SmallVector<llvm::NamedMDNode*> NamedMD;
+  for(auto& N : Partition.named_metadata())
+    if(N.getName() != "llvm.module.flags")
+      NamedMD.push_back(&N);
+  for(auto* N : NamedMD)
+    Partition.eraseNamedMetadata(N);
+}
+
+// Inserts assume(Fact(Arg)) at the beginning of the kernel, if the parameter
+// is an integer.
+template <class FactBuilder>
+void addKernelArgumentAssumption(llvm::Module &M, const std::string &KernelName,
+                                 int ParamIndex, FactBuilder &&Fact) {
+  if(auto* F = M.getFunction(KernelName)) {
+    if(F->getFunctionType()->getNumParams() > ParamIndex && !F->isDeclaration()) {
+      llvm::Argument* Arg = F->getArg(ParamIndex);
+      if(auto* IT = llvm::dyn_cast<llvm::IntegerType>(Arg->getType())) {
+        llvm::IRBuilder<> Builder{&(*F->getEntryBlock().getFirstInsertionPt())};
+        if(llvm::Value* Condition = Fact(Builder, Arg, IT))
+          Builder.CreateAssumption(Condition);
+      }
+    }
+  }
+}
+
 class InstructionCleanupPass : public llvm::PassInfoMixin<InstructionCleanupPass> {
 public:
 
@@ -133,6 +378,21 @@ bool LLVMToBackendTranslator::setBuildFlag(const std::string &Flag) {
   } else if(Flag == "fast-math") {
     IsFastMath = true;
     return true;
+  } else if(Flag == "fast-compile") {
+    IsFastCompile = true;
+    return true;
+  } else if(Flag == "local-memory-tiling") {
+    IsLocalMemoryTiling = true;
+    return true;
+  } else if(Flag == "aggregate-atomics") {
+    IsAggregateAtomics = true;
+    return true;
+  } else if(Flag == "performance-remarks") {
+    IsPerformanceRemarks = true;
+    return true;
+  } else if(Flag == "local-memory-padding") {
+    IsLocalMemoryPadding = true;
+    return true;
   }
 
   return applyBuildFlag(Flag);
@@ -166,9 +426,10 @@ bool LLVMToBackendTranslator::setBuildToolArguments(const std::string &ToolName,
 }
 
 bool LLVMToBackendTranslator::partialTransformation(const std::string &LLVMIR, std::string &Out) {
-  llvm::LLVMContext ctx;
+  ParsedModuleCache& Cache = ParsedModuleCache::get();
+  Cache.beginTransformation();
   std::unique_ptr<llvm::Module> M;
-  auto err = loadModuleFromString(LLVMIR, ctx, M);
+  auto err = Cache.load(LLVMIR, M);
 
   if (err) {
     this->registerError("LLVMToBackend: Could not load LLVM module");
@@ -191,9 +452,10 @@ bool LLVMToBackendTranslator::partialTransformation(const std::string &LLVMIR, s
 }
 
 bool LLVMToBackendTranslator::fullTransformation(const std::string &LLVMIR, std::string &out) {
-  llvm::LLVMContext ctx;
+  ParsedModuleCache& Cache = ParsedModuleCache::get();
+  Cache.beginTransformation();
   std::unique_ptr<llvm::Module> M;
-  auto err = loadModuleFromString(LLVMIR, ctx, M);
+  auto err = Cache.load(LLVMIR, M);
 
   if (err) {
     this->registerError("LLVMToBackend: Could not load LLVM module");
@@ -275,10 +537,65 @@ bool LLVMToBackendTranslator::prepareIR(llvm::Module &M) {
     MAM.clear();
     llvm::AlwaysInlinerPass AIP;
     AIP.run(M, MAM);
+    if(!resolveInlineCacheSelectors(M))
+      return;
 
     InstructionCleanupPass ICP;
     ICP.run(M, MAM);
 
+    AddressSpaceMap ASMap = getAddressSpaceMap();
+
+    // Remarks should describe the kernel as written, so this runs before
+    // instrumentation and the optimizations below rewrite memory accesses.
+    if (IsPerformanceRemarks) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Analyzing kernels for performance remarks...\n";
+      PerformanceRemarksPass RemarksPass{Kernels, ASMap[AddressSpace::Local]};
+      RemarksPass.run(M, MAM);
+    }
+
+    // Branch profiles refer to branches by index, so instrumentation and
+    // annotation must both see the IR at this point.
+    if (BranchProfileCountersAddress != 0) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Instrumenting branches for profiling...\n";
+      BranchProfileInstrumentationPass BPIP{Kernels, BranchProfileCountersAddress,
+                                            NumBranchProfileCounters,
+                                            ASMap[AddressSpace::Global]};
+      BPIP.run(M, MAM);
+    } else if (!BranchProfile.empty()) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Applying branch profile...\n";
+      BranchProfileAnnotationPass BPAP{Kernels, BranchProfile};
+      BPAP.run(M, MAM);
+    }
+
+    // Padded copies of the dynamic local memory count towards the local
+    // memory that tiling may assume to be in use.
+    if (IsLocalMemoryPadding && KnownGroupSizeY <= 1 && KnownGroupSizeZ <= 1 &&
+        ASMap[AddressSpace::Local] != ASMap[AddressSpace::Generic]) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Applying local memory padding...\n";
+      LocalMemoryPaddingPass PaddingPass{Kernels, KnownGroupSizeX, ASMap[AddressSpace::Local],
+                                         KnownLocalMemSize};
+      PaddingPass.run(M, MAM);
+      if (KnownLocalMemSize > 0)
+        KnownLocalMemSize += PaddingPass.getAddedLocalMemSize();
+    }
+
+    // Tiling needs inlined kernels, but unresolved __acpp_sscp_* builtins.
+    // Static local memory is only private to a work group on backends
+    // with a dedicated local address space.
+    if (IsLocalMemoryTiling && KnownGroupSizeY <= 1 && KnownGroupSizeZ <= 1 &&
+        ASMap[AddressSpace::Local] != ASMap[AddressSpace::Generic]) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Applying local memory tiling...\n";
+      LocalMemoryTilingPass TilingPass{Kernels, KnownGroupSizeX, ASMap[AddressSpace::Local],
+                                       KnownLocalMemSize};
+      TilingPass.run(M, MAM);
+    }
+
+    if (IsAggregateAtomics) {
+      HIPSYCL_DEBUG_INFO << "LLVMToBackend: Aggregating atomics...\n";
+      AtomicAggregationPass AggregationPass;
+      AggregationPass.run(M, MAM);
+    }
+
     HIPSYCL_DEBUG_INFO << "LLVMToBackend: Adding backend-specific flavor to IR...\n";
     FlavoringSuccessful = this->toBackendFlavor(M, PH);
     // Inline again to handle builtin definitions pulled in by backend flavors
@@ -291,6 +608,16 @@ bool LLVMToBackendTranslator::prepareIR(llvm::Module &M) {
       if(IsFastMath)
         setFastMathFunctionAttribs(M);
 
+      // Runs on the flavored kernels, such that the attributes end up on the
+      // parameters of the functions that are actually launched.
+      std::vector<std::string> FlavoredKernels;
+      for(auto& F : M)
+        if(!F.isDeclaration() && isKernelAfterFlavoring(F))
+          FlavoredKernels.push_back(F.getName().str());
+      KernelArgumentAttributeInferencePass ArgAttrPass{FlavoredKernels, ASMap[AddressSpace::Global],
+                                                       ASMap[AddressSpace::Local]};
+      ArgAttrPass.run(M, MAM);
+
       // Remove argument_used hints, which are no longer needed once we enter optimization stage.
       // This is primarily needed for dynamic functions.
       utils::ProcessFunctionAnnotationPass PFA({"argument_used"});
@@ -298,7 +625,7 @@ bool LLVMToBackendTranslator::prepareIR(llvm::Module &M) {
 
       MAM.clear();
 
-      OptimizationSuccessful = optimizeFlavoredIR(M, PH);
+      OptimizationSuccessful = optimizeFlavoredIRInPartitions(M, PH);
 
       if(!OptimizationSuccessful) {
         this->registerError("LLVMToBackend: Optimization failed");
@@ -351,19 +678,128 @@ bool LLVMToBackendTranslator::optimizeFlavoredIR(llvm::Module& M, PassHandler& P
         }
       });
 
+  // O1 mostly avoids the expensive loop and vectorization passes, but still
+  // inlines and simplifies enough to obtain reasonable code.
+  llvm::OptimizationLevel Level =
+      IsFastCompile ? llvm::OptimizationLevel::O1 : llvm::OptimizationLevel::O3;
   llvm::ModulePassManager MPM =
-      PH.PassBuilder->buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+      PH.PassBuilder->buildPerModuleDefaultPipeline(Level);
   MPM.run(M, *PH.ModuleAnalysisManager);
 
   return true;
 }
 
+bool LLVMToBackendTranslator::optimizeFlavoredIRInPartitions(llvm::Module &M,
+                                                             PassHandler &PH) {
+  std::vector<llvm::Function*> DefinedKernels;
+  for(const auto& Name : Kernels)
+    if(auto* F = M.getFunction(Name))
+      if(!F->isDeclaration())
+        DefinedKernels.push_back(F);
+
+  std::size_t NumPartitions =
+      std::min(std::max(std::thread::hardware_concurrency(), 1u),
+               static_cast<unsigned>(DefinedKernels.size() / MinKernelsPerPartition));
+  if (DefinedKernels.size() < MinKernelsForPartitionedOptimization ||
+      NumPartitions < 2)
+    return optimizeFlavoredIR(M, PH);
+
+  HIPSYCL_DEBUG_INFO << "LLVMToBackend: Optimizing " << DefinedKernels.size()
+                     << " kernels in " << NumPartitions << " partitions\n";
+
+  // Distribute kernels, largest first, to the partition with the fewest
+  // instructions. Since all non-kernel functions are inlined, kernel sizes
+  // are a reasonable estimate of optimization cost.
+  std::sort(DefinedKernels.begin(), DefinedKernels.end(),
+            [](llvm::Function *A, llvm::Function *B) {
+              return A->getInstructionCount() > B->getInstructionCount();
+            });
+  std::vector<std::vector<std::string>> PartitionKernels(NumPartitions);
+  std::vector<std::size_t> PartitionSizes(NumPartitions, 0);
+  for(auto* F : DefinedKernels) {
+    std::size_t Target = std::min_element(PartitionSizes.begin(), PartitionSizes.end()) -
+                         PartitionSizes.begin();
+    PartitionKernels[Target].push_back(F->getName().str());
+    PartitionSizes[Target] += F->getInstructionCount() + 1;
+  }
+
+  // LLVM contexts cannot be shared between threads, so partitions are
+  // transferred as bitcode. Partition 0 is optimized in M directly.
+  std::string Bitcode;
+  {
+    llvm::raw_string_ostream OutputStream{Bitcode};
+    llvm::WriteBitcodeToFile(M, OutputStream);
+  }
+
+  std::vector<std::string> OptimizedPartitions(NumPartitions);
+  std::vector<std::string> PartitionErrors(NumPartitions);
+  std::vector<std::thread> Workers;
+  for(std::size_t P = 1; P < NumPartitions; ++P) {
+    Workers.emplace_back([&, P]() {
+      llvm::LLVMContext Ctx;
+      std::unique_ptr<llvm::Module> Partition;
+      if(auto Err = loadModuleFromString(Bitcode, Ctx, Partition)) {
+        llvm::handleAllErrors(std::move(Err), [&](llvm::ErrorInfoBase &EIB) {
+          PartitionErrors[P] = EIB.message();
+        });
+        return;
+      }
+      constructPassBuilderAndMAM([&](llvm::PassBuilder &PB, llvm::ModuleAnalysisManager &MAM) {
+        PassHandler PartitionPH{&PB, &MAM};
+        restrictModuleToKernels(*Partition, Kernels, PartitionKernels[P], MAM);
+        if(!optimizeFlavoredIR(*Partition, PartitionPH)) {
+          PartitionErrors[P] = "LLVMToBackend: Optimization of partition failed";
+          return;
+        }
+        llvm::raw_string_ostream OutputStream{OptimizedPartitions[P]};
+        llvm::WriteBitcodeToFile(*Partition, OutputStream);
+      });
+    });
+  }
+
+  restrictModuleToKernels(M, Kernels, PartitionKernels[0], *PH.ModuleAnalysisManager);
+  bool Success = optimizeFlavoredIR(M, PH);
+
+  for(auto& W : Workers)
+    W.join();
+
+  for(std::size_t P = 1; P < NumPartitions; ++P) {
+    if(!PartitionErrors[P].empty()) {
+      this->registerError(PartitionErrors[P]);
+      Success = false;
+    }
+  }
+  if(!Success)
+    return false;
+
+  for(std::size_t P = 1; P < NumPartitions; ++P) {
+    std::unique_ptr<llvm::Module> Partition;
+    if(auto Err = loadModuleFromString(OptimizedPartitions[P], M.getContext(), Partition)) {
+      llvm::handleAllErrors(std::move(Err), [&](llvm::ErrorInfoBase &EIB) {
+        this->registerError(EIB.message());
+      });
+      return false;
+    }
+    prepareForLinkingIntoModule(*Partition, M);
+    if(!linkBitcode(M, std::move(Partition), "", "", llvm::Linker::Flags::None)) {
+      this->registerError("LLVMToBackend: Linking optimized partition failed");
+      return false;
+    }
+  }
+  PH.ModuleAnalysisManager->clear();
+
+  return true;
+}
+
 bool LLVMToBackendTranslator::linkBitcodeString(llvm::Module &M, const std::string &Bitcode,
                                                 const std::string &ForcedTriple,
                                                 const std::string &ForcedDataLayout,
                                                 bool LinkOnlyNeeded) {
   std::unique_ptr<llvm::Module> OtherModule;
-  auto err = loadModuleFromString(Bitcode, M.getContext(), OtherModule);
+  ParsedModuleCache& Cache = ParsedModuleCache::get();
+  auto err = (&M.getContext() == &Cache.getContext())
+                 ? Cache.load(Bitcode, OtherModule)
+                 : loadModuleFromString(Bitcode, M.getContext(), OtherModule);
 
   if (err) {
     this->registerError("LLVMToBackend: Could not load LLVM module");
@@ -389,14 +825,13 @@ bool LLVMToBackendTranslator::linkBitcodeFile(llvm::Module &M, const std::string
                                               const std::string &ForcedTriple,
                                               const std::string &ForcedDataLayout,
                                               bool LinkOnlyNeeded) {
-  auto F = llvm::MemoryBuffer::getFile(BitcodeFile);
-  if(auto Err = F.getError()) {
+  const std::string* Content = ParsedModuleCache::get().getFileContent(BitcodeFile);
+  if(!Content) {
     this->registerError("LLVMToBackend: Could not open file " + BitcodeFile);
     return false;
   }
   HIPSYCL_DEBUG_INFO << "LLVMToBackend: Linking with bitcode file: " << BitcodeFile << "\n";
-  return linkBitcodeString(M, std::string{F.get()->getBuffer()}, ForcedTriple, ForcedDataLayout,
-                           LinkOnlyNeeded);
+  return linkBitcodeString(M, *Content, ForcedTriple, ForcedDataLayout, LinkOnlyNeeded);
 }
 
 void LLVMToBackendTranslator::setS2IRConstant(const std::string &name, const void *ValueBuffer) {
@@ -469,71 +904,156 @@ void LLVMToBackendTranslator::specializeKernelArgument(const std::string &Kernel
   };
 }
 
+void LLVMToBackendTranslator::setKernelPointerArgumentAlignment(const std::string &KernelName,
+                                                                int ParamIndex,
+                                                                uint64_t Alignment) {
+  std::string Id = KernelName + "__pointer_argument_alignment_" + std::to_string(ParamIndex);
+  SpecializationApplicators[Id] = [=](llvm::Module &M) {
+    if(auto* F = M.getFunction(KernelName)) {
+      if(F->getFunctionType()->getNumParams() > ParamIndex && !F->isDeclaration()) {
+        llvm::Argument* Arg = F->getArg(ParamIndex);
+        if(!Arg->getType()->isPointerTy())
+          return;
+        // Use an assumption instead of a parameter attribute, since the kernel
+        // might be wrapped during backend flavoring and parameter attributes
+        // are not retained during inlining.
+        llvm::IRBuilder<> Builder{&(*F->getEntryBlock().getFirstInsertionPt())};
+        Builder.CreateAlignmentAssumption(M.getDataLayout(), Arg, Alignment);
+      }
+    }
+  };
+}
+
+void LLVMToBackendTranslator::setKernelPointerArgumentNoAlias(const std::string &KernelName,
+                                                              int ParamIndex) {
+  std::string Id = KernelName + "__pointer_argument_noalias_" + std::to_string(ParamIndex);
+  SpecializationApplicators[Id] = [=](llvm::Module &M) {
+    if(auto* F = M.getFunction(KernelName)) {
+      if (F->getFunctionType()->getNumParams() > ParamIndex && !F->isDeclaration() &&
+          F->getArg(ParamIndex)->getType()->isPointerTy())
+        F->addParamAttr(ParamIndex, llvm::Attribute::NoAlias);
+    }
+  };
+}
+
+void LLVMToBackendTranslator::setKernelArgumentUpperBound(const std::string &KernelName,
+                                                          int ParamIndex, uint64_t UpperBound) {
+  std::string Id = KernelName + "__argument_upper_bound_" + std::to_string(ParamIndex);
+  SpecializationApplicators[Id] = [=](llvm::Module &M) {
+    addKernelArgumentAssumption(
+        M, KernelName, ParamIndex,
+        [&](llvm::IRBuilder<> &Builder, llvm::Argument *Arg,
+            llvm::IntegerType *IT) -> llvm::Value * {
+          if(IT->getBitWidth() < 64 && (UpperBound >> IT->getBitWidth()) != 0)
+            return nullptr;
+          return Builder.CreateICmpULT(Arg, llvm::ConstantInt::get(IT, UpperBound));
+        });
+  };
+}
+
+void LLVMToBackendTranslator::setKernelArgumentDivisor(const std::string &KernelName,
+                                                       int ParamIndex, uint64_t Divisor) {
+  std::string Id = KernelName + "__argument_divisor_" + std::to_string(ParamIndex);
+  SpecializationApplicators[Id] = [=](llvm::Module &M) {
+    addKernelArgumentAssumption(
+        M, KernelName, ParamIndex,
+        [&](llvm::IRBuilder<> &Builder, llvm::Argument *Arg,
+            llvm::IntegerType *IT) -> llvm::Value * {
+          if(IT->getBitWidth() < 64 && (Divisor >> IT->getBitWidth()) != 0)
+            return nullptr;
+          // Known-bits analysis understands (Arg & (Divisor-1)) == 0
+          auto* Remainder =
+              Builder.CreateAnd(Arg, llvm::ConstantInt::get(IT, Divisor - 1));
+          return Builder.CreateICmpEQ(Remainder, llvm::ConstantInt::get(IT, 0));
+        });
+  };
+}
+
+void LLVMToBackendTranslator::setBranchProfileCounters(uint64_t Address,
+                                                       std::size_t NumCounters) {
+  BranchProfileCountersAddress = Address;
+  NumBranchProfileCounters = NumCounters;
+}
+
+void LLVMToBackendTranslator::setBranchProfile(const std::vector<uint64_t> &Profile) {
+  BranchProfile = Profile;
+}
+
+llvm::Value *LLVMToBackendTranslator::getFunctionCallReplacement(
+    llvm::Module &M, llvm::Function *F, const std::vector<std::string> &ReplacementCalls,
+    const std::string &WrapperName) {
+  if(ReplacementCalls.size() == 1){
+    llvm::Function* ReplacementF = M.getFunction(ReplacementCalls[0]);
+
+    if(!ReplacementF) {
+      registerError("LLVMToBackend: Could not find function call specialization target " +
+                  ReplacementCalls[0] + ", was the function emitted to device code?");
+      return nullptr;
+    }
+    if(ReplacementF->getFunctionType() != F->getFunctionType()) {
+      registerError("LLVMToBackend: Specialization function " + ReplacementCalls[0] +
+                    " has incompatible type for specialization of " + F->getName().str());
+      return nullptr;
+    }
+    return ReplacementF;
+  }
+
+  llvm::SmallVector<llvm::Function*, 16> ReplacementFs;
+
+  if (!F->getReturnType()->isVoidTy()) {
+    registerError("LLVMToBackend: Specialization of function calls using a function call "
+                  "list is only possible if the original and all replacement functions "
+                  "have void return type.");
+    return nullptr;
+  }
+  for(const auto& FName : ReplacementCalls) {
+    auto* RetrievedF = M.getFunction(FName);
+    if(!RetrievedF) {
+      registerError("LLVMToBackend: Could not find function call specialization target " +
+                    FName + ", was the function emitted to device code?");
+      return nullptr;
+    }
+    if(RetrievedF->getFunctionType() != F->getFunctionType()) {
+      registerError("LLVMToBackend: Specialization function " + FName +
+                  " has incompatible type for specialization of " + F->getName().str());
+      return nullptr;
+    }
+    ReplacementFs.push_back(RetrievedF);
+  }
+  auto ReplacementWrapperFuncCallee =
+      M.getOrInsertFunction(WrapperName, F->getFunctionType(), F->getAttributes());
+  if (auto *ReplacementWrapperF =
+          static_cast<llvm::Function *>(ReplacementWrapperFuncCallee.getCallee())) {
+    auto BB = llvm::BasicBlock::Create(M.getContext(), "entry",
+                                       ReplacementWrapperF);
+    for(auto* F : ReplacementFs) {
+      llvm::SmallVector<llvm::Value*> Args;
+      for(int i = 0; i < F->getFunctionType()->getNumParams(); ++i)
+        Args.push_back(ReplacementWrapperF->getArg(i));
+
+      llvm::CallInst::Create(llvm::FunctionCallee{F},
+                             llvm::ArrayRef<llvm::Value *>{Args}, "", BB);
+    }
+    llvm::ReturnInst::Create(M.getContext(), BB);
+  }
+  return ReplacementWrapperFuncCallee.getCallee();
+}
+
 void LLVMToBackendTranslator::specializeFunctionCalls(
     const std::string &FuncName, const std::vector<std::string> &ReplacementCalls,
     bool OverrideOnlyUndefined) {
   std::string Id = "__specialized_function_call_"+FuncName;
+  SpecializationTargets.insert(SpecializationTargets.end(), ReplacementCalls.begin(),
+                               ReplacementCalls.end());
   SpecializationApplicators[Id] = [=](llvm::Module &M) {
     HIPSYCL_DEBUG_INFO << "LLVMToBackend: Specializing function calls to " << FuncName << " to:\n";
     for(const auto& s : ReplacementCalls)
       HIPSYCL_DEBUG_INFO << "LLVMToBackend:   " << s << "\n";
     if(auto* F = M.getFunction(FuncName)) {
       if((!OverrideOnlyUndefined || F->isDeclaration()) && !ReplacementCalls.empty()) {
-        llvm::Value* ReplacementValue;
-        if(ReplacementCalls.size() == 1){
-          llvm::Function* ReplacementF = M.getFunction(ReplacementCalls[0]);
-          ReplacementValue = ReplacementF;
-
-          if(!ReplacementValue) {
-            registerError("LLVMToBackend: Could not find function call specialization target " +
-                        ReplacementCalls[0] + ", was the function emitted to device code?");
-            return;
-          }
-          if(ReplacementF->getFunctionType() != F->getFunctionType()) {
-            registerError("LLVMToBackend: Specialization function " + ReplacementCalls[0] +
-                          " has incompatible type for specialization of " + FuncName);
-            return;
-          }
-        } else {
-          llvm::SmallVector<llvm::Function*, 16> ReplacementFs;
-
-          if (!F->getReturnType()->isVoidTy()) {
-            registerError("LLVMToBackend: Specialization of function calls using a function call "
-                          "list is only possible if the original and all replacement functions "
-                          "have void return type.");
-            return;
-          }
-          for(const auto& FName : ReplacementCalls) {
-            auto* RetrievedF = M.getFunction(FName);
-            if(!RetrievedF) {
-              registerError("LLVMToBackend: Could not find function call specialization target " +
-                            FName + ", was the function emitted to device code?");
-              return;
-            }
-            if(RetrievedF->getFunctionType() != F->getFunctionType()) {
-              registerError("LLVMToBackend: Specialization function " + FName +
-                          " has incompatible type for specialization of " + FuncName);
-              return;
-            }
-            ReplacementFs.push_back(RetrievedF);
-          }
-          auto ReplacementWrapperFuncCallee = M.getOrInsertFunction(Id, F->getFunctionType(), F->getAttributes());
-          if (auto *ReplacementWrapperF =
-                  static_cast<llvm::Function *>(ReplacementWrapperFuncCallee.getCallee())) {
-            auto BB = llvm::BasicBlock::Create(M.getContext(), "entry",
-                                               ReplacementWrapperF);
-            for(auto* F : ReplacementFs) {
-              llvm::SmallVector<llvm::Value*> Args;
-              for(int i = 0; i < F->getFunctionType()->getNumParams(); ++i)
-                Args.push_back(ReplacementWrapperF->getArg(i));
-
-              llvm::CallInst::Create(llvm::FunctionCallee{F},
-                                     llvm::ArrayRef<llvm::Value *>{Args}, "", BB);
-            }                                            
-            llvm::ReturnInst::Create(M.getContext(), BB);
-          }
-          ReplacementValue  = ReplacementWrapperFuncCallee.getCallee();
-        }
+        llvm::Value* ReplacementValue = getFunctionCallReplacement(M, F, ReplacementCalls, Id);
+        if(!ReplacementValue)
+          return;
 
         F->replaceUsesWithIf(ReplacementValue, [=](llvm::Use& U) {
           return llvm::isa<llvm::CallBase>(U.getUser());
@@ -543,6 +1063,117 @@ void LLVMToBackendTranslator::specializeFunctionCalls(
   };
 }
 
+void LLVMToBackendTranslator::specializeFunctionCallsOnArgument(
+    const std::string &KernelName, int ParamIndex, const std::string &FuncName,
+    const std::vector<std::pair<uint64_t, std::vector<std::string>>> &Candidates) {
+  std::string Id = "__inline_cached_function_call_" + FuncName;
+  // The kernel argument is only available once the dispatcher has been
+  // inlined into the kernel, so the dispatcher obtains it from this function
+  // until then.
+  std::string SelectorName = "__acpp_fcall_inline_cache_selector_" + std::to_string(ParamIndex);
+  for(const auto& C : Candidates)
+    SpecializationTargets.insert(SpecializationTargets.end(), C.second.begin(), C.second.end());
+  if(std::find_if(InlineCacheSelectors.begin(), InlineCacheSelectors.end(), [&](const auto &S) {
+       return S.first == KernelName && S.second == ParamIndex;
+     }) == InlineCacheSelectors.end())
+    InlineCacheSelectors.push_back(std::make_pair(KernelName, ParamIndex));
+
+  SpecializationApplicators[Id] = [=](llvm::Module &M) {
+    HIPSYCL_DEBUG_INFO << "LLVMToBackend: Dispatching function calls to " << FuncName
+                       << " between " << Candidates.size() << " candidates\n";
+    llvm::Function *F = M.getFunction(FuncName);
+    if(!F)
+      return;
+
+    llvm::SmallVector<std::pair<uint64_t, llvm::Value *>, 8> Targets;
+    for(std::size_t i = 0; i < Candidates.size(); ++i) {
+      llvm::Value *Target = F;
+      if(!Candidates[i].second.empty()) {
+        Target = getFunctionCallReplacement(M, F, Candidates[i].second,
+                                            Id + "_" + std::to_string(i));
+        if(!Target)
+          return;
+      }
+      Targets.push_back(std::make_pair(Candidates[i].first, Target));
+    }
+
+    llvm::LLVMContext &Ctx = M.getContext();
+    llvm::Type *SelectorT = llvm::Type::getInt64Ty(Ctx);
+    llvm::FunctionCallee Selector =
+        M.getOrInsertFunction(SelectorName, llvm::FunctionType::get(SelectorT, false));
+
+    auto *DispatchF = llvm::Function::Create(F->getFunctionType(),
+                                             llvm::GlobalValue::InternalLinkage, Id, M);
+    DispatchF->setAttributes(F->getAttributes());
+    llvm::SmallVector<llvm::Value *> Args;
+    for(auto &Arg : DispatchF->args())
+      Args.push_back(&Arg);
+
+    auto *EntryBB = llvm::BasicBlock::Create(Ctx, "entry", DispatchF);
+    // The runtime only selects this binary if the argument is one of
+    // the candidates.
+    auto *DefaultBB = llvm::BasicBlock::Create(Ctx, "unknown_candidate", DispatchF);
+    new llvm::UnreachableInst(Ctx, DefaultBB);
+    auto *SelectorValue = llvm::CallInst::Create(Selector, "", EntryBB);
+    auto *Switch = llvm::SwitchInst::Create(SelectorValue, DefaultBB, Targets.size(), EntryBB);
+    for(const auto &T : Targets) {
+      auto *CaseBB = llvm::BasicBlock::Create(Ctx, "candidate", DispatchF);
+      auto *Call = llvm::CallInst::Create(F->getFunctionType(), T.second, Args, "", CaseBB);
+      if(F->getReturnType()->isVoidTy())
+        llvm::ReturnInst::Create(Ctx, CaseBB);
+      else
+        llvm::ReturnInst::Create(Ctx, Call, CaseBB);
+      Switch->addCase(llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(SelectorT), T.first),
+                      CaseBB);
+    }
+
+    F->replaceUsesWithIf(DispatchF, [=](llvm::Use& U) {
+      auto *CB = llvm::dyn_cast<llvm::CallBase>(U.getUser());
+      return CB && CB->getFunction() != DispatchF;
+    });
+  };
+}
+
+bool LLVMToBackendTranslator::resolveInlineCacheSelectors(llvm::Module &M) {
+  bool Success = true;
+  for(const auto& S : InlineCacheSelectors) {
+    llvm::Function *SelectorF =
+        M.getFunction("__acpp_fcall_inline_cache_selector_" + std::to_string(S.second));
+    llvm::Function *Kernel = M.getFunction(S.first);
+    if(!SelectorF || !Kernel || Kernel->getFunctionType()->getNumParams() <= S.second)
+      continue;
+
+    llvm::Argument *Arg = Kernel->getArg(S.second);
+    llvm::SmallVector<llvm::CallBase *, 8> Calls;
+    for(llvm::User *U : SelectorF->users())
+      if(auto *CB = llvm::dyn_cast<llvm::CallBase>(U))
+        Calls.push_back(CB);
+    for(auto *CB : Calls) {
+      if(CB->getFunction() != Kernel) {
+        registerError("LLVMToBackend: Could not inline dispatch of dynamic function calls into "
+                      "kernel " + S.first);
+        Success = false;
+        continue;
+      }
+      llvm::IRBuilder<> Builder{CB};
+      llvm::Value *Selector = nullptr;
+      if(Arg->getType()->isPointerTy())
+        Selector = Builder.CreatePtrToInt(Arg, CB->getType());
+      else if(Arg->getType()->isIntegerTy())
+        Selector = Builder.CreateZExtOrTrunc(Arg, CB->getType());
+      if(!Selector) {
+        registerError("LLVMToBackend: Kernel argument " + std::to_string(S.second) + " of " +
+                      S.first + " cannot select dynamic function calls");
+        Success = false;
+        continue;
+      }
+      CB->replaceAllUsesWith(Selector);
+      CB->eraseFromParent();
+    }
+  }
+  return Success;
+}
+
 void LLVMToBackendTranslator::provideExternalSymbolResolver(ExternalSymbolResolver Resolver) {
   this->SymbolResolver = Resolver;
   this->HasExternalSymbolResolver = true;
@@ -558,13 +1189,36 @@ void LLVMToBackendTranslator::resolveExternalSymbols(llvm::Module& M) {
     llvm::SmallSet<std::string, 32> AllAttemptedSymbolResolutions;
     llvm::SmallSet<std::string, 16> UnresolvedSymbolsSet;
 
+    // Only symbols that can be reached from the code that we are compiling
+    // need to be resolved. This avoids linking in images that are only needed
+    // by other kernels of the same device image.
+    std::vector<std::string> ReachabilityRoots = OutliningEntrypoints;
+    ReachabilityRoots.insert(ReachabilityRoots.end(), SpecializationTargets.begin(),
+                             SpecializationTargets.end());
+    const bool RestrictToReachableSymbols = !OutliningEntrypoints.empty();
+    llvm::StringSet<> ReachableDeclarations;
+    if(RestrictToReachableSymbols)
+      ReachableDeclarations = collectReachableDeclarations(M, ReachabilityRoots);
+
+    auto isNeeded = [&](const std::string& SymbolName) {
+      return !RestrictToReachableSymbols || ReachableDeclarations.contains(SymbolName);
+    };
+
     // Find out which unresolved symbols are in this IR
     for(auto SymbolName : SymbolResolver.getImportedSymbols()) {
+      if(!isNeeded(SymbolName)) {
+        HIPSYCL_DEBUG_INFO << "LLVMToBackend: Skipping resolution of unreachable symbol "
+                           << SymbolName << "\n";
+        continue;
+      }
       HIPSYCL_DEBUG_INFO << "LLVMToBackend: Attempting to resolve primary symbol " << SymbolName
                          << "\n";
       UnresolvedSymbolsSet.insert(SymbolName);
     }
 
+    if(UnresolvedSymbolsSet.empty())
+      return;
+
     for(;;) {
       std::vector<std::string> Symbols;
       for(auto S : UnresolvedSymbolsSet) {
@@ -581,6 +1235,7 @@ void LLVMToBackendTranslator::resolveExternalSymbols(llvm::Module& M) {
       // symbol definitions to work. So we need to try to resolve the new
       // stuff in the next iteration.
       llvm::SmallSet<std::string, 16> NewUnresolvedSymbolsSet;
+      SymbolListType NewUndefinedSymbols;
 
       for(const auto& IRID : IRs) {
 
@@ -591,15 +1246,21 @@ void LLVMToBackendTranslator::resolveExternalSymbols(llvm::Module& M) {
           HIPSYCL_DEBUG_WARNING
               << "LLVMToBackend: Linking against bitcode to resolve symbols failed\n";
         }
+        NewUndefinedSymbols.insert(NewUndefinedSymbols.end(), NewUndefinedSymbolsFromIR.begin(),
+                                   NewUndefinedSymbolsFromIR.end());
+      }
 
-        for(const auto& S : NewUndefinedSymbolsFromIR) {
-          if(!AllAttemptedSymbolResolutions.contains(S)) {
-            NewUnresolvedSymbolsSet.insert(S);
-            HIPSYCL_DEBUG_INFO << "LLVMToBackend: Attemping resolve symbol " << S
-                                << " as a dependency\n";
-          }
-        }
+      // Since only needed definitions are linked, dependencies of code from the
+      // linked images that we have not pulled in are not reachable either.
+      if(RestrictToReachableSymbols && !NewUndefinedSymbols.empty())
+        ReachableDeclarations = collectReachableDeclarations(M, ReachabilityRoots);
 
+      for(const auto& S : NewUndefinedSymbols) {
+        if(!AllAttemptedSymbolResolutions.contains(S) && isNeeded(S)) {
+          NewUnresolvedSymbolsSet.insert(S);
+          HIPSYCL_DEBUG_INFO << "LLVMToBackend: Attemping resolve symbol " << S
+                              << " as a dependency\n";
+        }
       }
 
       if(NewUnresolvedSymbolsSet.empty()) {
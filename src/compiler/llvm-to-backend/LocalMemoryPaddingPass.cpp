@@ -0,0 +1,288 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/LocalMemoryPaddingPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/WorkItemShapeAnalysis.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/APInt.h>
+#include <llvm/ADT/MapVector.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Operator.h>
+#include <llvm/Support/MathExtras.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <numeric>
+#include <optional>
+#include <utility>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+constexpr const char *DynamicLocalMemoryBuiltinName = "__acpp_sscp_get_dynamic_local_memory";
+
+// Same assumptions as in PerformanceRemarksPass: Local memory is distributed
+// across 32 banks of 4 bytes.
+constexpr std::int64_t NumLocalMemoryBanks = 32;
+constexpr std::int64_t LocalMemoryBankWidth = 4;
+// See LocalMemoryTilingPass
+constexpr std::int64_t AssumedDeviceLocalMemSize = 32 * 1024;
+
+struct LocalMemoryAccess {
+  llvm::Instruction *I;
+  llvm::Value *Ptr;
+  // The result of the __acpp_sscp_get_dynamic_local_memory() call
+  llvm::Value *Base;
+  std::int64_t Size;
+};
+
+// Loop canonicalization by WorkItemShapeAnalysis inserts these for values
+// that are used outside of their loop.
+bool isLCSSAPhi(llvm::Value *V) {
+  auto *Phi = llvm::dyn_cast<llvm::PHINode>(V);
+  return Phi && Phi->getNumIncomingValues() == 1;
+}
+
+// Collects all loads and stores that are based on the dynamic local memory
+// pointer V. Returns false if V is used in any other way, e.g. stored to
+// memory or passed to a function, because then not all addresses can be
+// remapped.
+bool collectAccesses(llvm::Value *V, llvm::Value *Base, const llvm::DataLayout &DL,
+                     llvm::SmallVectorImpl<LocalMemoryAccess> &Out) {
+  for(llvm::User *U : V->users()) {
+    if(auto *GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(U)) {
+      if(GEP->getPointerOperand() != V ||
+         llvm::any_of(GEP->indices(), [&](llvm::Value *Idx) { return Idx == V; }))
+        return false;
+      if(!collectAccesses(GEP, Base, DL, Out))
+        return false;
+    } else if(llvm::isa<llvm::BitCastInst>(U) || llvm::isa<llvm::AddrSpaceCastInst>(U) ||
+              isLCSSAPhi(U)) {
+      if(!collectAccesses(U, Base, DL, Out))
+        return false;
+    } else if(auto *LI = llvm::dyn_cast<llvm::LoadInst>(U)) {
+      std::int64_t Size = DL.getTypeStoreSize(LI->getType()).getFixedValue();
+      // Remapped accesses must not cross a row boundary, which is guaranteed
+      // for accesses that are aligned to their size.
+      if(LI->getAlign().value() < static_cast<std::uint64_t>(Size))
+        return false;
+      Out.push_back(LocalMemoryAccess{LI, V, Base, Size});
+    } else if(auto *SI = llvm::dyn_cast<llvm::StoreInst>(U)) {
+      if(SI->getPointerOperand() != V)
+        return false;
+      std::int64_t Size = DL.getTypeStoreSize(SI->getValueOperand()->getType()).getFixedValue();
+      if(SI->getAlign().value() < static_cast<std::uint64_t>(Size))
+        return false;
+      Out.push_back(LocalMemoryAccess{SI, V, Base, Size});
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+// The number of bytes after which a padding is needed to resolve the bank
+// conflicts of the access, if it has any.
+std::optional<std::int64_t> getConflictingRowSize(const LocalMemoryAccess &Access,
+                                                  const WorkItemShapeAnalysis &Shapes,
+                                                  int GroupSizeX) {
+  std::optional<VectorShape> Shape = Shapes.getShape(*Access.Ptr);
+  if(!Shape || Shape->isUniform() || Shape->isVarying())
+    return {};
+  const std::int64_t Unit = std::max(Access.Size, LocalMemoryBankWidth);
+  const std::int64_t Stride = std::abs(Shape->getStride());
+  if(Stride == 0 || Stride % Unit != 0 || !llvm::isPowerOf2_64(Stride))
+    return {};
+  const std::int64_t Ways =
+      std::min<std::int64_t>(std::gcd(Stride / Unit, NumLocalMemoryBanks), GroupSizeX);
+  if(Ways <= 1)
+    return {};
+  return Stride;
+}
+
+// Emits the byte offset of V relative to the start of the dynamic local
+// memory Base as i64. Results are cached, such that common GEP chains are
+// only materialized once.
+llvm::Value *emitByteOffset(llvm::Value *V, llvm::Value *Base, const llvm::DataLayout &DL,
+                            llvm::DenseMap<llvm::Value *, llvm::Value *> &Cache) {
+  llvm::Type *OffsetT = llvm::Type::getInt64Ty(V->getContext());
+  if(V == Base)
+    return llvm::ConstantInt::get(OffsetT, 0);
+  auto It = Cache.find(V);
+  if(It != Cache.end())
+    return It->second;
+
+  llvm::Value *Result = nullptr;
+  if(llvm::isa<llvm::CastInst>(V) || isLCSSAPhi(V)) {
+    Result = emitByteOffset(llvm::cast<llvm::Instruction>(V)->getOperand(0), Base, DL, Cache);
+  } else {
+    auto *GEP = llvm::cast<llvm::GetElementPtrInst>(V);
+    llvm::Value *BaseOffset = emitByteOffset(GEP->getPointerOperand(), Base, DL, Cache);
+
+    llvm::MapVector<llvm::Value *, llvm::APInt> VariableOffsets;
+    llvm::APInt ConstantOffset{64, 0};
+    // Only fails for scalable vectors, which cannot be stored in local memory
+    [[maybe_unused]] bool Success =
+        llvm::cast<llvm::GEPOperator>(GEP)->collectOffset(DL, 64, VariableOffsets, ConstantOffset);
+    assert(Success);
+
+    llvm::IRBuilder<> Builder{GEP};
+    Result = Builder.CreateAdd(BaseOffset,
+                               llvm::ConstantInt::get(OffsetT, ConstantOffset.getSExtValue()));
+    for(const auto &Entry : VariableOffsets) {
+      llvm::Value *Idx = Builder.CreateSExtOrTrunc(Entry.first, OffsetT);
+      Result = Builder.CreateAdd(
+          Result, Builder.CreateMul(Idx, llvm::ConstantInt::get(OffsetT, Entry.second.getSExtValue())));
+    }
+  }
+  Cache[V] = Result;
+  return Result;
+}
+
+bool padKernel(llvm::Function &F, int GroupSizeX, unsigned LocalAS, std::int64_t KnownLocalMemSize,
+               std::int64_t &AddedLocalMemSize) {
+  const llvm::DataLayout &DL = F.getParent()->getDataLayout();
+
+  bool UsesDynamicLocalMem = false;
+  for(auto &BB : F)
+    for(auto &I : BB)
+      if(auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+        if(auto *Callee = CB->getCalledFunction())
+          UsesDynamicLocalMem |= Callee->getName() == DynamicLocalMemoryBuiltinName;
+  if(!UsesDynamicLocalMem)
+    return false;
+
+  llvm::SmallVector<LocalMemoryAccess, 16> Accesses;
+  std::int64_t RowSize = 0;
+  std::int64_t PaddingSize = 0;
+  bool ModifiedIR = false;
+  {
+    // Canonicalizes loops, so accesses are only collected afterwards
+    WorkItemShapeAnalysis Shapes{F};
+    ModifiedIR = Shapes.hasModifiedIR();
+    for(auto &BB : F)
+      for(auto &I : BB)
+        if(auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+          if(auto *Callee = CB->getCalledFunction())
+            if(Callee->getName() == DynamicLocalMemoryBuiltinName)
+              if(!collectAccesses(CB, CB, DL, Accesses))
+                return ModifiedIR;
+
+    for(const auto &Access : Accesses) {
+      PaddingSize = std::max(PaddingSize, Access.Size);
+      if(auto Row = getConflictingRowSize(Access, Shapes, GroupSizeX))
+        RowSize = RowSize == 0 ? Row.value() : std::min(RowSize, Row.value());
+    }
+  }
+  // Paddings must retain the alignment of all accesses
+  PaddingSize = std::max(LocalMemoryBankWidth, PaddingSize);
+  if(RowSize == 0 || !llvm::isPowerOf2_64(PaddingSize) || RowSize % PaddingSize != 0)
+    return ModifiedIR;
+
+  const std::int64_t NumRows = (KnownLocalMemSize + RowSize - 1) / RowSize;
+  const std::int64_t PaddedSize = KnownLocalMemSize + NumRows * PaddingSize;
+  if(KnownLocalMemSize + PaddedSize > AssumedDeviceLocalMemSize) {
+    HIPSYCL_DEBUG_INFO << "LocalMemoryPaddingPass: Not padding kernel " << F.getName().str()
+                       << ", padded local memory would exceed " << AssumedDeviceLocalMemSize
+                       << " bytes\n";
+    return ModifiedIR;
+  }
+
+  llvm::LLVMContext &Ctx = F.getContext();
+  llvm::Type *PaddedT = llvm::ArrayType::get(llvm::Type::getInt8Ty(Ctx), PaddedSize);
+  auto *PaddedVar = new llvm::GlobalVariable(
+      *F.getParent(), PaddedT, false, llvm::GlobalValue::InternalLinkage,
+      llvm::UndefValue::get(PaddedT), F.getName() + ".acpp.padded_local_mem", nullptr,
+      llvm::GlobalValue::NotThreadLocal, LocalAS);
+  const llvm::Align BaseAlign{static_cast<std::uint64_t>(std::max<std::int64_t>(16, PaddingSize))};
+  PaddedVar->setAlignment(BaseAlign);
+  // Padded addresses are only aligned to the padding
+  const llvm::Align PaddedAlign{static_cast<std::uint64_t>(PaddingSize)};
+
+  llvm::Type *OffsetT = llvm::Type::getInt64Ty(Ctx);
+  llvm::Type *LocalIndexT = DL.getIndexType(PaddedVar->getType());
+  llvm::DenseMap<llvm::Value *, llvm::Value *> OffsetCache;
+  for(const auto &Access : Accesses) {
+    llvm::Value *Offset = emitByteOffset(Access.Ptr, Access.Base, DL, OffsetCache);
+
+    // Offset + (Offset / RowSize) * PaddingSize; offsets are non-negative
+    llvm::IRBuilder<> Builder{Access.I};
+    llvm::Value *Row = Builder.CreateLShr(Offset, llvm::Log2_64(RowSize));
+    llvm::Value *PaddedOffset = Builder.CreateAdd(
+        Offset, Builder.CreateMul(Row, llvm::ConstantInt::get(OffsetT, PaddingSize)));
+    llvm::Value *NewPtr = Builder.CreateInBoundsGEP(
+        Builder.getInt8Ty(), PaddedVar, Builder.CreateTrunc(PaddedOffset, LocalIndexT));
+    NewPtr = Builder.CreatePointerBitCastOrAddrSpaceCast(NewPtr, Access.Ptr->getType());
+
+    if(auto *LI = llvm::dyn_cast<llvm::LoadInst>(Access.I)) {
+      LI->setOperand(LI->getPointerOperandIndex(), NewPtr);
+      LI->setAlignment(std::min(LI->getAlign(), PaddedAlign));
+    } else if(auto *SI = llvm::dyn_cast<llvm::StoreInst>(Access.I)) {
+      SI->setOperand(SI->getPointerOperandIndex(), NewPtr);
+      SI->setAlignment(std::min(SI->getAlign(), PaddedAlign));
+    }
+  }
+
+  HIPSYCL_DEBUG_INFO << "LocalMemoryPaddingPass: Padding local memory of kernel "
+                     << F.getName().str() << " every " << RowSize << " bytes by " << PaddingSize
+                     << " bytes\n";
+  AddedLocalMemSize = std::max(AddedLocalMemSize, PaddedSize);
+  return true;
+}
+
+}
+
+LocalMemoryPaddingPass::LocalMemoryPaddingPass(const std::vector<std::string> &Kernels,
+                                               int GroupSizeX, unsigned LocalAS,
+                                               std::int64_t LocalMemSize)
+    : KernelNames{Kernels}, KnownGroupSizeX{GroupSizeX}, LocalAddressSpace{LocalAS},
+      KnownLocalMemSize{LocalMemSize} {}
+
+llvm::PreservedAnalyses LocalMemoryPaddingPass::run(llvm::Module &M,
+                                                    llvm::ModuleAnalysisManager &MAM) {
+  // Without knowing the extent of the dynamic local memory, its padded copy
+  // cannot be sized.
+  if(KnownLocalMemSize <= 0 || KnownGroupSizeX < 2)
+    return llvm::PreservedAnalyses::all();
+
+  // Other functions would still access the unpadded dynamic local memory
+  if(auto *DynamicLocalMem = M.getFunction(DynamicLocalMemoryBuiltinName)) {
+    for(llvm::User *U : DynamicLocalMem->users()) {
+      auto *CB = llvm::dyn_cast<llvm::CallBase>(U);
+      if(!CB || CB->getCalledFunction() != DynamicLocalMem ||
+         std::find(KernelNames.begin(), KernelNames.end(),
+                   CB->getFunction()->getName().str()) == KernelNames.end())
+        return llvm::PreservedAnalyses::all();
+    }
+  } else {
+    return llvm::PreservedAnalyses::all();
+  }
+
+  bool Changed = false;
+  for(const auto& Name : KernelNames)
+    if(auto* F = M.getFunction(Name))
+      if(!F->isDeclaration())
+        Changed |= padKernel(*F, KnownGroupSizeX, LocalAddressSpace, KnownLocalMemSize,
+                             AddedLocalMemSize);
+
+  return Changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+}
+
+}
+}
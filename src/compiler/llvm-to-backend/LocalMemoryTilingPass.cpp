@@ -0,0 +1,413 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/LocalMemoryTilingPass.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/CFG.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/BasicBlockUtils.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+constexpr const char *GroupIdBuiltinName = "__acpp_sscp_get_group_id_x";
+constexpr const char *LocalIdBuiltinName = "__acpp_sscp_get_local_id_x";
+constexpr const char *BarrierBuiltinName = "__acpp_sscp_work_group_barrier";
+
+// Values of hipsycl::sycl::memory_scope::work_group and memory_order::seq_cst
+constexpr int MemoryScopeWorkGroup = 2;
+constexpr int MemoryOrderSeqCst = 4;
+
+// Local memory that tiles of one kernel may occupy. This is deliberately
+// far below the local memory size of all supported devices, such that
+// occupancy does not suffer too much.
+constexpr std::int64_t MaxTileBytesPerKernel = 16 * 1024;
+constexpr std::int64_t AssumedDeviceLocalMemSize = 32 * 1024;
+
+// Index into a pointer kernel argument, in units of the loaded type, of the form
+// GroupCoeff * group_id_x + LocalCoeff * local_id_x + Offset.
+struct LinearIndex {
+  std::int64_t GroupCoeff = 0;
+  std::int64_t LocalCoeff = 0;
+  std::int64_t Offset = 0;
+
+  LinearIndex &operator+=(const LinearIndex &Other) {
+    GroupCoeff += Other.GroupCoeff;
+    LocalCoeff += Other.LocalCoeff;
+    Offset += Other.Offset;
+    return *this;
+  }
+
+  LinearIndex &operator*=(std::int64_t Factor) {
+    GroupCoeff *= Factor;
+    LocalCoeff *= Factor;
+    Offset *= Factor;
+    return *this;
+  }
+};
+
+bool isCallTo(llvm::Value *V, llvm::StringRef Name) {
+  if(auto* CB = llvm::dyn_cast<llvm::CallBase>(V))
+    if(auto* F = CB->getCalledFunction())
+      return F->getName() == Name;
+  return false;
+}
+
+bool analyzeIndex(llvm::Value *V, LinearIndex &Out, int Depth = 0) {
+  // Stage 1 index computations are short, so don't bother with deep trees
+  if(Depth > 8)
+    return false;
+
+  if(auto* C = llvm::dyn_cast<llvm::ConstantInt>(V)) {
+    if(C->getBitWidth() > 64)
+      return false;
+    Out = LinearIndex{};
+    Out.Offset = C->getSExtValue();
+    return true;
+  }
+
+  if(isCallTo(V, GroupIdBuiltinName)) {
+    Out = LinearIndex{};
+    Out.GroupCoeff = 1;
+    return true;
+  }
+
+  if(isCallTo(V, LocalIdBuiltinName)) {
+    Out = LinearIndex{};
+    Out.LocalCoeff = 1;
+    return true;
+  }
+
+  if(auto* Cast = llvm::dyn_cast<llvm::CastInst>(V)) {
+    llvm::Value *Src = Cast->getOperand(0);
+    // Extensions commute with the arithmetic only if the latter cannot wrap.
+    // Builtin calls are known to return non-negative values.
+    if(auto* BinOp = llvm::dyn_cast<llvm::OverflowingBinaryOperator>(Src)) {
+      if(llvm::isa<llvm::SExtInst>(Cast) && !BinOp->hasNoSignedWrap())
+        return false;
+      if(llvm::isa<llvm::ZExtInst>(Cast) && !BinOp->hasNoUnsignedWrap())
+        return false;
+    }
+    if(llvm::isa<llvm::SExtInst>(Cast) || llvm::isa<llvm::ZExtInst>(Cast))
+      return analyzeIndex(Src, Out, Depth + 1);
+    return false;
+  }
+
+  auto* BinOp = llvm::dyn_cast<llvm::BinaryOperator>(V);
+  if(!BinOp)
+    return false;
+
+  LinearIndex LHS, RHS;
+  auto Opcode = BinOp->getOpcode();
+  if(Opcode == llvm::Instruction::Add || Opcode == llvm::Instruction::Sub) {
+    if(!analyzeIndex(BinOp->getOperand(0), LHS, Depth + 1) ||
+       !analyzeIndex(BinOp->getOperand(1), RHS, Depth + 1))
+      return false;
+    if(Opcode == llvm::Instruction::Sub)
+      RHS *= -1;
+    LHS += RHS;
+    Out = LHS;
+    return true;
+  } else if(Opcode == llvm::Instruction::Mul || Opcode == llvm::Instruction::Shl) {
+    auto* C = llvm::dyn_cast<llvm::ConstantInt>(BinOp->getOperand(1));
+    if(!C || C->getBitWidth() > 64)
+      return false;
+    std::int64_t Factor = C->getSExtValue();
+    if(Opcode == llvm::Instruction::Shl) {
+      if(Factor < 0 || Factor > 32)
+        return false;
+      Factor = std::int64_t{1} << Factor;
+    }
+    if(!analyzeIndex(BinOp->getOperand(0), LHS, Depth + 1))
+      return false;
+    LHS *= Factor;
+    Out = LHS;
+    return true;
+  }
+  return false;
+}
+
+// Decomposes a pointer into a kernel argument base pointer and an index
+// in units of ElementSize. Returns nullptr if that is not possible.
+llvm::Argument *analyzePointer(llvm::Value *Ptr, const llvm::DataLayout &DL,
+                               std::int64_t ElementSize, LinearIndex &Out) {
+  Out = LinearIndex{};
+  while(true) {
+    if(auto* A = llvm::dyn_cast<llvm::Argument>(Ptr))
+      return A->getType()->isPointerTy() ? A : nullptr;
+
+    auto* GEP = llvm::dyn_cast<llvm::GetElementPtrInst>(Ptr);
+    if(!GEP || GEP->getNumIndices() != 1)
+      return nullptr;
+
+    llvm::Type *SourceTy = GEP->getSourceElementType();
+    if(!SourceTy->isSized())
+      return nullptr;
+    std::int64_t SourceSize = DL.getTypeAllocSize(SourceTy).getFixedValue();
+
+    llvm::Value *Idx = GEP->getOperand(1);
+    LinearIndex Current;
+    if(SourceSize == ElementSize) {
+      if(!analyzeIndex(Idx, Current))
+        return nullptr;
+    } else if(auto* C = llvm::dyn_cast<llvm::ConstantInt>(Idx)) {
+      // Constant byte offsets, as produced by instcombine
+      std::int64_t ByteOffset = C->getSExtValue() * SourceSize;
+      if(ByteOffset % ElementSize != 0)
+        return nullptr;
+      Current.Offset = ByteOffset / ElementSize;
+    } else {
+      return nullptr;
+    }
+    Out += Current;
+    Ptr = GEP->getPointerOperand();
+  }
+}
+
+bool isIgnorableMemoryWrite(llvm::Instruction *I) {
+  if(auto* II = llvm::dyn_cast<llvm::IntrinsicInst>(I)) {
+    auto ID = II->getIntrinsicID();
+    return ID == llvm::Intrinsic::assume || ID == llvm::Intrinsic::lifetime_start ||
+           ID == llvm::Intrinsic::lifetime_end || llvm::isa<llvm::DbgInfoIntrinsic>(II);
+  }
+  if(auto* CB = llvm::dyn_cast<llvm::CallBase>(I))
+    if(auto* F = CB->getCalledFunction())
+      return F->getName().startswith("__acpp_sscp_get_");
+  return false;
+}
+
+struct TileCandidate {
+  llvm::SmallVector<std::pair<llvm::LoadInst *, std::int64_t>, 8> Loads;
+  std::int64_t MinOffset = 0;
+  std::int64_t MaxOffset = 0;
+};
+
+using TileKey = std::pair<llvm::Argument *, llvm::Type *>;
+
+bool tileKernel(llvm::Module &M, llvm::Function &F, int GroupSize, unsigned LocalAS,
+                std::int64_t TileBudget) {
+  llvm::Function *GroupIdF = M.getFunction(GroupIdBuiltinName);
+  llvm::Function *LocalIdF = M.getFunction(LocalIdBuiltinName);
+  if(!GroupIdF || !LocalIdF || F.isDeclaration())
+    return false;
+
+  const llvm::DataLayout &DL = M.getDataLayout();
+  llvm::DominatorTree DT{F};
+
+  llvm::SmallVector<llvm::BasicBlock *, 4> ReturningBlocks;
+  llvm::SmallVector<llvm::Instruction *, 16> MemoryWrites;
+  llvm::SmallVector<std::pair<llvm::LoadInst *, TileKey>, 16> Loads;
+  llvm::SmallVector<LinearIndex, 16> LoadIndices;
+
+  for(auto& BB : F) {
+    if(llvm::isa<llvm::ReturnInst>(BB.getTerminator()))
+      ReturningBlocks.push_back(&BB);
+
+    for(auto& I : BB) {
+      if(I.mayWriteToMemory() && !isIgnorableMemoryWrite(&I))
+        MemoryWrites.push_back(&I);
+
+      auto* LI = llvm::dyn_cast<llvm::LoadInst>(&I);
+      if(!LI || !LI->isSimple())
+        continue;
+      llvm::Type *T = LI->getType();
+      if(!T->isIntegerTy() && !T->isFloatingPointTy())
+        continue;
+
+      LinearIndex Idx;
+      llvm::Argument *Base = analyzePointer(LI->getPointerOperand(), DL,
+                                            DL.getTypeAllocSize(T).getFixedValue(), Idx);
+      if(Base && Idx.GroupCoeff == GroupSize && Idx.LocalCoeff == 1) {
+        Loads.push_back(std::make_pair(LI, TileKey{Base, T}));
+        LoadIndices.push_back(Idx);
+      }
+    }
+  }
+
+  if(Loads.empty() || ReturningBlocks.empty())
+    return false;
+
+  std::map<TileKey, TileCandidate> Candidates;
+  for(std::size_t i = 0; i < Loads.size(); ++i) {
+    llvm::LoadInst *LI = Loads[i].first;
+    // All work items must execute the load, otherwise the tile might
+    // contain addresses that the kernel never accesses.
+    bool IsUnconditional = llvm::all_of(ReturningBlocks, [&](llvm::BasicBlock *BB) {
+      return DT.dominates(LI->getParent(), BB);
+    });
+    // The tile is filled at kernel entry, so nothing may have written
+    // the loaded memory before.
+    bool IsPrecededByWrite = llvm::any_of(MemoryWrites, [&](llvm::Instruction *W) {
+      return llvm::isPotentiallyReachable(W, LI, nullptr, &DT);
+    });
+    if(!IsUnconditional || IsPrecededByWrite)
+      continue;
+
+    auto& C = Candidates[Loads[i].second];
+    std::int64_t Offset = LoadIndices[i].Offset;
+    if(C.Loads.empty()) {
+      C.MinOffset = Offset;
+      C.MaxOffset = Offset;
+    } else {
+      C.MinOffset = std::min(C.MinOffset, Offset);
+      C.MaxOffset = std::max(C.MaxOffset, Offset);
+    }
+    C.Loads.push_back(std::make_pair(LI, Offset));
+  }
+
+  llvm::SmallVector<std::pair<TileKey, TileCandidate *>, 4> Tiles;
+  std::int64_t UsedTileBytes = 0;
+  for(auto& Entry : Candidates) {
+    TileCandidate &C = Entry.second;
+    std::int64_t Halo = C.MaxOffset - C.MinOffset;
+    // Only tile if work items read each others' elements. The halo must not
+    // exceed the group size, since only then the tile does not contain holes,
+    // and it can be filled in two steps.
+    if(Halo == 0 || Halo > GroupSize)
+      continue;
+    std::int64_t TileBytes =
+        (GroupSize + Halo) * DL.getTypeAllocSize(Entry.first.second).getFixedValue();
+    if(UsedTileBytes + TileBytes > TileBudget)
+      continue;
+    UsedTileBytes += TileBytes;
+    Tiles.push_back(std::make_pair(Entry.first, &C));
+  }
+
+  if(Tiles.empty())
+    return false;
+
+  // Skip allocas by hand, BasicBlock::getFirstNonPHIOrDbgOrAlloca() is not
+  // available in LLVM 14.
+  llvm::Instruction *InsertPt = F.getEntryBlock().getFirstNonPHIOrDbg();
+  while(llvm::isa<llvm::AllocaInst>(InsertPt) || llvm::isa<llvm::DbgInfoIntrinsic>(InsertPt))
+    InsertPt = InsertPt->getNextNode();
+  llvm::IRBuilder<> Builder{InsertPt};
+  llvm::Value *GroupId = Builder.CreateCall(GroupIdF);
+  llvm::Value *LocalId = Builder.CreateCall(LocalIdF);
+  llvm::Type *IndexTy = LocalId->getType();
+
+  llvm::SmallVector<std::pair<llvm::GlobalVariable *, llvm::Type *>, 4> TileVars;
+  for(auto& Tile : Tiles) {
+    llvm::Argument *Base = Tile.first.first;
+    llvm::Type *T = Tile.first.second;
+    TileCandidate &C = *Tile.second;
+    std::int64_t Halo = C.MaxOffset - C.MinOffset;
+
+    auto* TileTy = llvm::ArrayType::get(T, GroupSize + Halo);
+    auto* TileVar = new llvm::GlobalVariable(
+        M, TileTy, false, llvm::GlobalValue::InternalLinkage, llvm::UndefValue::get(TileTy),
+        F.getName() + ".acpp.local_tile", nullptr, llvm::GlobalValue::NotThreadLocal, LocalAS);
+    TileVar->setAlignment(DL.getABITypeAlign(T));
+
+    auto copyElement = [&](llvm::IRBuilder<> &B, llvm::Value *TileIdx) {
+      llvm::Value *GroupStart =
+          B.CreateAdd(B.CreateMul(GroupId, llvm::ConstantInt::get(IndexTy, GroupSize)),
+                      llvm::ConstantInt::get(IndexTy, C.MinOffset, true));
+      llvm::Value *Src = B.CreateGEP(T, Base, B.CreateAdd(GroupStart, TileIdx));
+      llvm::Value *Dst =
+          B.CreateGEP(TileTy, TileVar, {llvm::ConstantInt::get(IndexTy, 0), TileIdx});
+      B.CreateStore(B.CreateLoad(T, Src), Dst);
+    };
+
+    // Every work item copies one element, and the first Halo work items
+    // additionally copy the remainder of the tile.
+    copyElement(Builder, LocalId);
+    llvm::Value *CopiesHalo =
+        Builder.CreateICmpULT(LocalId, llvm::ConstantInt::get(IndexTy, Halo));
+    llvm::Instruction *ThenTerm = llvm::SplitBlockAndInsertIfThen(CopiesHalo, InsertPt, false);
+    llvm::IRBuilder<> HaloBuilder{ThenTerm};
+    copyElement(HaloBuilder,
+                HaloBuilder.CreateAdd(LocalId, llvm::ConstantInt::get(IndexTy, GroupSize)));
+    Builder.SetInsertPoint(InsertPt);
+
+    TileVars.push_back(std::make_pair(TileVar, TileTy));
+  }
+
+  llvm::Type *Int32Ty = llvm::Type::getInt32Ty(M.getContext());
+  llvm::FunctionCallee Barrier = M.getOrInsertFunction(
+      BarrierBuiltinName,
+      llvm::FunctionType::get(llvm::Type::getVoidTy(M.getContext()), {Int32Ty, Int32Ty}, false));
+  if(auto* BarrierF = llvm::dyn_cast<llvm::Function>(Barrier.getCallee()))
+    BarrierF->addFnAttr(llvm::Attribute::Convergent);
+  llvm::CallInst *BarrierCall =
+      Builder.CreateCall(Barrier, {llvm::ConstantInt::get(Int32Ty, MemoryScopeWorkGroup),
+                                   llvm::ConstantInt::get(Int32Ty, MemoryOrderSeqCst)});
+  BarrierCall->addFnAttr(llvm::Attribute::Convergent);
+
+  for(std::size_t i = 0; i < Tiles.size(); ++i) {
+    TileCandidate &C = *Tiles[i].second;
+    llvm::GlobalVariable *TileVar = TileVars[i].first;
+    llvm::Type *TileTy = TileVars[i].second;
+
+    for(auto& L : C.Loads) {
+      llvm::LoadInst *LI = L.first;
+      llvm::IRBuilder<> LoadBuilder{LI};
+      llvm::Value *TileIdx = LoadBuilder.CreateAdd(
+          LocalId, llvm::ConstantInt::get(IndexTy, L.second - C.MinOffset));
+      llvm::Value *Ptr = LoadBuilder.CreateGEP(
+          TileTy, TileVar, {llvm::ConstantInt::get(IndexTy, 0), TileIdx});
+      llvm::LoadInst *NewLI = LoadBuilder.CreateAlignedLoad(
+          LI->getType(), Ptr, DL.getABITypeAlign(LI->getType()));
+      LI->replaceAllUsesWith(NewLI);
+      LI->eraseFromParent();
+    }
+    HIPSYCL_DEBUG_INFO << "LocalMemoryTilingPass: Staging " << C.Loads.size()
+                       << " loads from argument " << Tiles[i].first.first->getArgNo()
+                       << " of kernel " << F.getName() << " in local memory tile of "
+                       << TileTy->getArrayNumElements() << " elements\n";
+  }
+
+  return true;
+}
+
+}
+
+LocalMemoryTilingPass::LocalMemoryTilingPass(const std::vector<std::string> &Kernels,
+                                             int GroupSizeX, unsigned LocalAS,
+                                             std::int64_t LocalMemSize)
+    : KernelNames{Kernels}, KnownGroupSizeX{GroupSizeX}, LocalAddressSpace{LocalAS},
+      KnownLocalMemSize{LocalMemSize} {}
+
+llvm::PreservedAnalyses LocalMemoryTilingPass::run(llvm::Module &M,
+                                                   llvm::ModuleAnalysisManager &MAM) {
+  if(KnownGroupSizeX < 2)
+    return llvm::PreservedAnalyses::all();
+
+  std::int64_t TileBudget = MaxTileBytesPerKernel;
+  if(KnownLocalMemSize > 0)
+    TileBudget = std::min(TileBudget, AssumedDeviceLocalMemSize - KnownLocalMemSize);
+  if(TileBudget <= 0)
+    return llvm::PreservedAnalyses::all();
+
+  bool Changed = false;
+  for(const auto& Name : KernelNames) {
+    if(auto* F = M.getFunction(Name))
+      Changed |= tileKernel(M, *F, KnownGroupSizeX, LocalAddressSpace, TileBudget);
+  }
+
+  return Changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+}
+
+}
+}
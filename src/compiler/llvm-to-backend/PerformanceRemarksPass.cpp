@@ -0,0 +1,192 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/PerformanceRemarksPass.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/WorkItemShapeAnalysis.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/Analysis/ValueTracking.h>
+#include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+// Memory that is accessed by adjacent work items at adjacent addresses can
+// be combined into few transactions on GPUs. Local memory is distributed
+// across banks of 4 bytes; work items of a warp accessing different
+// addresses in the same bank are serialized.
+constexpr std::int64_t NumLocalMemoryBanks = 32;
+constexpr std::int64_t LocalMemoryBankWidth = 4;
+
+enum class MemoryKind { Global, Local, Private };
+
+MemoryKind getMemoryKind(const llvm::Value *Ptr, unsigned LocalAS) {
+  if(Ptr->getType()->getPointerAddressSpace() == LocalAS && LocalAS != 0)
+    return MemoryKind::Local;
+
+  const llvm::Value *Obj = llvm::getUnderlyingObject(Ptr);
+  if(llvm::isa<llvm::AllocaInst>(Obj))
+    return MemoryKind::Private;
+  if(auto *GV = llvm::dyn_cast<llvm::GlobalVariable>(Obj))
+    if(GV->getAddressSpace() == LocalAS && LocalAS != 0)
+      return MemoryKind::Local;
+  if(auto *CB = llvm::dyn_cast<llvm::CallBase>(Obj))
+    if(auto *F = CB->getCalledFunction())
+      if(F->getName() == "__acpp_sscp_get_dynamic_local_memory")
+        return MemoryKind::Local;
+  return MemoryKind::Global;
+}
+
+std::string getSourceLocation(const llvm::Instruction &I) {
+  if(const llvm::DebugLoc &Loc = I.getDebugLoc()) {
+    std::string File = "<unknown>";
+    if(auto *Scope = llvm::dyn_cast<llvm::DIScope>(Loc.getScope()))
+      File = Scope->getFilename().str();
+    return File + ":" + std::to_string(Loc.getLine()) + ":" + std::to_string(Loc.getCol());
+  }
+  return "<unknown location, compile with -g>";
+}
+
+class RemarkPrinter {
+public:
+  RemarkPrinter(llvm::StringRef Kernel) : Kernel{Kernel} {}
+
+  void print(const llvm::Instruction &I, const std::string &Message) {
+    std::string Location = getSourceLocation(I);
+    // Inlining and unrolling may produce many instructions for the same
+    // source location
+    if(!Printed.insert(Location + Message).second)
+      return;
+    HIPSYCL_DEBUG_WARNING << "PerformanceRemarks: " << Location << ": " << Message
+                          << " [kernel " << Kernel.str() << "]\n";
+  }
+
+private:
+  llvm::StringRef Kernel;
+  std::set<std::string> Printed;
+};
+
+void checkMemoryAccess(const llvm::Instruction &I, const llvm::Value *Ptr, llvm::Type *AccessedT,
+                       const WorkItemShapeAnalysis &Shapes, const llvm::DataLayout &DL,
+                       unsigned LocalAS, RemarkPrinter &Printer) {
+  std::optional<VectorShape> PtrShape = Shapes.getShape(*Ptr);
+  if(!PtrShape)
+    return;
+  VectorShape Shape = PtrShape.value();
+  // All work items access the same address, which is broadcast
+  if(Shape.isUniform())
+    return;
+
+  MemoryKind Kind = getMemoryKind(Ptr, LocalAS);
+  if(Kind == MemoryKind::Private)
+    return;
+
+  const std::int64_t ElementSize = DL.getTypeStoreSize(AccessedT).getFixedValue();
+  const std::string Access = llvm::isa<llvm::StoreInst>(I) ? "store" : "load";
+
+  if(Kind == MemoryKind::Global) {
+    if(Shape.isVarying()) {
+      Printer.print(I, "Uncoalesced global memory " + Access +
+                           ": addresses of adjacent work items are not affine in the work item id");
+    } else if(std::abs(Shape.getStride()) > ElementSize) {
+      Printer.print(I, "Uncoalesced global memory " + Access + ": adjacent work items access "
+                           "addresses with a stride of " + std::to_string(Shape.getStride()) +
+                           " bytes instead of " + std::to_string(ElementSize));
+    }
+    return;
+  }
+
+  if(Shape.isVarying()) {
+    Printer.print(I, "Local memory " + Access +
+                         " with addresses that are not affine in the work item id may cause "
+                         "bank conflicts");
+    return;
+  }
+  const std::int64_t Unit = std::max(ElementSize, LocalMemoryBankWidth);
+  const std::int64_t Stride = std::abs(Shape.getStride());
+  if(Stride % Unit != 0)
+    return;
+  const std::int64_t Ways = std::gcd(Stride / Unit, NumLocalMemoryBanks);
+  if(Ways > 1)
+    Printer.print(I, std::to_string(Ways) + "-way local memory bank conflict: adjacent work "
+                     "items " + Access + " with a stride of " + std::to_string(Stride) +
+                     " bytes");
+}
+
+bool analyzeKernel(llvm::Function &F, unsigned LocalAS) {
+  WorkItemShapeAnalysis Shapes{F};
+  const llvm::LoopInfo &LI = Shapes.getLoopInfo();
+
+  const llvm::DataLayout &DL = F.getParent()->getDataLayout();
+  RemarkPrinter Printer{F.getName()};
+  for(auto &BB : F) {
+    for(auto &I : BB) {
+      if(auto *Load = llvm::dyn_cast<llvm::LoadInst>(&I)) {
+        checkMemoryAccess(I, Load->getPointerOperand(), Load->getType(), Shapes, DL, LocalAS,
+                          Printer);
+      } else if(auto *Store = llvm::dyn_cast<llvm::StoreInst>(&I)) {
+        checkMemoryAccess(I, Store->getPointerOperand(), Store->getValueOperand()->getType(),
+                          Shapes, DL, LocalAS, Printer);
+      }
+    }
+
+    // Divergent branches outside of loops, e.g. range checks, are usually
+    // cheap.
+    auto *Br = llvm::dyn_cast<llvm::BranchInst>(BB.getTerminator());
+    llvm::Loop *L = LI.getLoopFor(&BB);
+    if(!Br || !Br->isConditional() || !L)
+      continue;
+    std::optional<VectorShape> CondShape = Shapes.getShape(*Br->getCondition());
+    if(!CondShape || CondShape->isUniform())
+      continue;
+    if(L->isLoopExiting(&BB))
+      Printer.print(*Br, "Divergent loop: work items execute different numbers of iterations");
+    else
+      Printer.print(*Br, "Divergent branch within a loop: work items of a sub-group may "
+                         "execute both paths");
+  }
+
+  return Shapes.hasModifiedIR();
+}
+
+}
+
+PerformanceRemarksPass::PerformanceRemarksPass(const std::vector<std::string> &Kernels,
+                                               unsigned LocalAS)
+    : KernelNames{Kernels}, LocalAddressSpace{LocalAS} {}
+
+llvm::PreservedAnalyses PerformanceRemarksPass::run(llvm::Module &M,
+                                                    llvm::ModuleAnalysisManager &MAM) {
+  bool Changed = false;
+  for(const auto& Name : KernelNames)
+    if(auto* F = M.getFunction(Name))
+      if(!F->isDeclaration())
+        Changed |= analyzeKernel(*F, LocalAddressSpace);
+
+  return Changed ? llvm::PreservedAnalyses::none() : llvm::PreservedAnalyses::all();
+}
+
+}
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/WorkItemShapeAnalysis.hpp"
+#include "hipSYCL/compiler/cbs/UniformityAnalysis.hpp"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/Transforms/Utils/LoopSimplify.h>
+#include <llvm/Transforms/Utils/LoopUtils.h>
+
+#include <vector>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+// Builtins that vary with the work item id in x direction
+bool isContiguousBuiltin(llvm::StringRef Name) {
+  return Name == "__acpp_sscp_get_local_id_x" ||
+         Name == "__acpp_sscp_get_subgroup_local_id" ||
+         Name == "__acpp_sscp_get_local_linear_id" ||
+         Name == "__acpp_sscp_get_global_linear_id";
+}
+
+// The divergence analysis of loop live-outs expects canonical loops
+bool canonicalizeLoops(llvm::DominatorTree &DT, llvm::LoopInfo &LI) {
+  bool Changed = false;
+  std::vector<llvm::Loop *> TopLevelLoops{LI.begin(), LI.end()};
+  for(auto *L : TopLevelLoops) {
+    Changed |= llvm::simplifyLoop(L, &DT, &LI, nullptr, nullptr, nullptr, false);
+    Changed |= llvm::formLCSSARecursively(*L, DT, &LI, nullptr);
+  }
+  return Changed;
+}
+
+std::vector<llvm::BasicBlock *> getBlocks(llvm::Function &F) {
+  std::vector<llvm::BasicBlock *> Blocks;
+  for(auto &BB : F)
+    Blocks.push_back(&BB);
+  return Blocks;
+}
+
+}
+
+WorkItemShapeAnalysis::WorkItemShapeAnalysis(llvm::Function &F)
+    : DT{F}, LI{DT}, ModifiedIR{canonicalizeLoops(DT, LI)}, PDT{F}, RImpl{F, getBlocks(F)},
+      R{RImpl}, VecInfo{F, R} {
+
+  for(auto &BB : F)
+    for(auto &I : BB)
+      if(auto *CB = llvm::dyn_cast<llvm::CallBase>(&I))
+        if(auto *Callee = CB->getCalledFunction())
+          if(Callee->getName().startswith("__acpp_sscp_get_"))
+            VecInfo.setPinnedShape(I, isContiguousBuiltin(Callee->getName())
+                                          ? VectorShape::cont()
+                                          : VectorShape::uni());
+
+  VectorizationAnalysis VecAna{VecInfo, LI, DT, PDT};
+  VecAna.analyze();
+}
+
+std::optional<VectorShape> WorkItemShapeAnalysis::getShape(const llvm::Value &V) const {
+  if(!VecInfo.hasKnownShape(V))
+    return {};
+  return VecInfo.getVectorShape(V);
+}
+
+}
+}
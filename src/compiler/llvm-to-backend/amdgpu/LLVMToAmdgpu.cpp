@@ -32,11 +32,14 @@
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Support/Program.h>
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <cassert>
 #include <optional>
 #include <string>
 #include <system_error>
+#include <tuple>
 #include <vector>
 #include <sstream>
 
@@ -128,6 +131,42 @@ public:
                                           std::vector<std::string>& BitcodeFiles,
                                           bool IsFastMath = false,
                                           int ForceCodeObjectModel = -1) {
+    // The device library list only depends on the ROCm installation and the
+    // arguments, so only spawn clang once per process and configuration
+    // instead of for every JIT compilation.
+    static std::mutex Mutex;
+    static std::map<QueryKey, std::vector<std::string>> Results;
+
+    QueryKey Key{RocmPath, DeviceLibsPath, TargetDevice, IsFastMath, ForceCodeObjectModel};
+    {
+      std::lock_guard<std::mutex> Lock{Mutex};
+      auto It = Results.find(Key);
+      if(It != Results.end()) {
+        BitcodeFiles.insert(BitcodeFiles.end(), It->second.begin(), It->second.end());
+        return true;
+      }
+    }
+
+    std::vector<std::string> Result;
+    if (!queryRequiredDeviceLibs(RocmPath, DeviceLibsPath, TargetDevice, Result, IsFastMath,
+                                 ForceCodeObjectModel))
+      return false;
+
+    BitcodeFiles.insert(BitcodeFiles.end(), Result.begin(), Result.end());
+    std::lock_guard<std::mutex> Lock{Mutex};
+    Results.emplace(Key, std::move(Result));
+    return true;
+  }
+
+private:
+  using QueryKey = std::tuple<std::string, std::string, std::string, bool, int>;
+
+  static bool queryRequiredDeviceLibs(const std::string& RocmPath,
+                                      const std::string& DeviceLibsPath,
+                                      const std::string& TargetDevice,
+                                      std::vector<std::string>& BitcodeFiles,
+                                      bool IsFastMath,
+                                      int ForceCodeObjectModel) {
     
 
     llvm::SmallVector<std::string> Invocation;
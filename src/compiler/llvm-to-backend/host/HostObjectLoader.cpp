@@ -0,0 +1,104 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/compiler/llvm-to-backend/host/HostObjectLoader.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHost.hpp"
+
+#include "hipSYCL/common/debug.hpp"
+
+#include <llvm/BinaryFormat/Magic.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <string>
+
+namespace hipsycl {
+namespace compiler {
+
+namespace {
+
+class LLJITHostObject : public LoadedHostObject {
+public:
+  LLJITHostObject(std::unique_ptr<llvm::orc::LLJIT> J) : J{std::move(J)} {}
+
+  void *getSymbolAddress(const std::string &Name) override {
+    auto Sym = J->lookup(Name);
+    if (!Sym) {
+      llvm::consumeError(Sym.takeError());
+      return nullptr;
+    }
+#if LLVM_VERSION_MAJOR < 15
+    return reinterpret_cast<void *>(Sym->getAddress());
+#else
+    return Sym->toPtr<void *>();
+#endif
+  }
+
+private:
+  std::unique_ptr<llvm::orc::LLJIT> J;
+};
+
+}
+
+bool isHostRelocatableObject(const std::string &Binary) {
+  switch (llvm::identify_magic(Binary)) {
+  case llvm::file_magic::elf_relocatable:
+  case llvm::file_magic::macho_object:
+  case llvm::file_magic::coff_object:
+    return true;
+  default:
+    return false;
+  }
+}
+
+std::unique_ptr<LoadedHostObject> loadHostObject(const std::string &Object,
+                                                 std::string &ErrorOut) {
+  LLVMToHostTranslator::initializeNativeTarget();
+
+  auto J = llvm::orc::LLJITBuilder().create();
+  if (!J) {
+    ErrorOut = "Could not create LLJIT: " + llvm::toString(J.takeError());
+    return nullptr;
+  }
+
+  char GlobalPrefix = (*J)->getDataLayout().getGlobalPrefix();
+  auto ProcessSymbols =
+      llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(GlobalPrefix);
+  if (!ProcessSymbols) {
+    ErrorOut = "Could not resolve symbols of the current process: " +
+               llvm::toString(ProcessSymbols.takeError());
+    return nullptr;
+  }
+  (*J)->getMainJITDylib().addGenerator(std::move(*ProcessSymbols));
+
+  // Replaces linking with -lmvec in the shared library flow
+  if (LLVMToHostTranslator::isUsingLibmvec()) {
+    auto Libmvec =
+        llvm::orc::DynamicLibrarySearchGenerator::Load("libmvec.so.1", GlobalPrefix);
+    if (Libmvec)
+      (*J)->getMainJITDylib().addGenerator(std::move(*Libmvec));
+    else
+      HIPSYCL_DEBUG_WARNING << "HostObjectLoader: Could not load libmvec: "
+                            << llvm::toString(Libmvec.takeError()) << "\n";
+  }
+
+  auto Buffer = llvm::MemoryBuffer::getMemBufferCopy(Object, "acpp-sscp-host-object");
+  if (auto Err = (*J)->addObjectFile(std::move(Buffer))) {
+    ErrorOut = "Could not add object file: " + llvm::toString(std::move(Err));
+    return nullptr;
+  }
+
+  return std::make_unique<LLJITHostObject>(std::move(*J));
+}
+
+}
+}
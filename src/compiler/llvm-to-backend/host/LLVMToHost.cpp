@@ -25,8 +25,10 @@
 #include "hipSYCL/glue/llvm-sscp/s2_ir_constants.hpp"
 
 #include <llvm/ADT/SmallVector.h>
+#include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/IR/Attributes.h>
+#include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/CallingConv.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DebugInfo.h>
@@ -36,10 +38,16 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/PassManager.h>
 #include <llvm/Passes/PassBuilder.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/CodeGen.h>
 #include <llvm/Support/FileSystem.h>
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Program.h>
+#include <llvm/Support/TargetSelect.h>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Target/TargetOptions.h>
+#include <llvm/Transforms/Utils/InjectTLIMappings.h>
 #if LLVM_VERSION_MAJOR < 16
 #include <llvm/ADT/Triple.h>
 #include <llvm/Support/Host.h>
@@ -51,6 +59,7 @@
 #include <cassert>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <vector>
@@ -58,9 +67,51 @@
 namespace hipsycl {
 namespace compiler {
 
+namespace {
+
+// Annotates calls to math functions with their vector variants from the
+// vector math library, such that the vectorizer can still vectorize
+// work-item loops that contain them. Most of these calls are in the builtin
+// bitcode library; the annotations are retained when they are inlined.
+void addVectorMathFunctionMappings(llvm::Module &M) {
+  if(!LLVMToHostTranslator::isUsingLibmvec())
+    return;
+
+  llvm::Triple TargetTriple{M.getTargetTriple()};
+  llvm::TargetLibraryInfoImpl TLII{TargetTriple};
+#if LLVM_VERSION_MAJOR < 17
+  TLII.addVectorizableFunctionsFromVecLib(llvm::TargetLibraryInfoImpl::LIBMVEC_X86);
+#else
+  TLII.addVectorizableFunctionsFromVecLib(llvm::TargetLibraryInfoImpl::LIBMVEC_X86,
+                                          TargetTriple);
+#endif
+
+  llvm::FunctionAnalysisManager FAM;
+  FAM.registerPass([&] { return llvm::TargetLibraryAnalysis{TLII}; });
+
+  llvm::InjectTLIMappings InjectMappings;
+  for(auto& F : M)
+    if(!F.isDeclaration())
+      InjectMappings.run(F, FAM);
+}
+
+}
+
 LLVMToHostTranslator::LLVMToHostTranslator(const std::vector<std::string> &KN)
     : LLVMToBackendTranslator{sycl::jit::backend::host, KN, KN}, KernelNames{KN} {}
 
+void LLVMToHostTranslator::initializeNativeTarget() {
+  static std::once_flag Flag;
+  std::call_once(Flag, [](){
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+  });
+}
+
+bool LLVMToHostTranslator::isUsingLibmvec() {
+  return std::string{ACPP_HOST_VECTOR_MATH_LIBRARY} == "libmvec";
+}
+
 bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
 
   for (auto KernelName : KernelNames) {
@@ -89,6 +140,17 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
   if (!this->linkBitcodeFile(M, BuiltinBitcodeFile))
     return false;
 
+  addVectorMathFunctionMappings(M);
+
+  // Hard-wire the sub-group size, such that the builtins for the selected
+  // size are folded before work-item loops are formed.
+  if (auto *SubGroupSizeVar = M.getGlobalVariable("__acpp_cbs_sscp_subgroup_size")) {
+    SubGroupSizeVar->setInitializer(
+        llvm::ConstantInt::get(llvm::Type::getInt32Ty(M.getContext()), SubGroupSize));
+    SubGroupSizeVar->setConstant(true);
+    SubGroupSizeVar->setLinkage(llvm::GlobalValue::InternalLinkage);
+  }
+
   llvm::ModulePassManager MPM;
   PH.ModuleAnalysisManager->clear(); // for some reason we need to reset the analyses... otherwise
                                      // we get a crash at IPSCCP
@@ -110,6 +172,9 @@ bool LLVMToHostTranslator::toBackendFlavor(llvm::Module &M, PassHandler &PH) {
 
 bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule,
                                                     std::string &out) {
+  if(EmitRelocatableObject)
+    return emitRelocatableObject(FlavoredModule, out);
+
   auto InputFile = llvm::sys::fs::TempFile::create("acpp-sscp-host-%%%%%%.bc");
   auto OutputFile = llvm::sys::fs::TempFile::create("acpp-sscp-host-%%%%%%.so");
 
@@ -154,6 +219,9 @@ bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule
                                                     "-o",
                                                     OutputFilename,
                                                     InputFile->TmpName};
+  // Provides the vector variants of math functions
+  if(isUsingLibmvec())
+    Invocation.push_back("-lmvec");
 
   std::string ArgString;
   for (const auto &S : Invocation) {
@@ -181,7 +249,101 @@ bool LLVMToHostTranslator::translateToBackendFormat(llvm::Module &FlavoredModule
   return true;
 }
 
+bool LLVMToHostTranslator::emitRelocatableObject(llvm::Module &FlavoredModule,
+                                                 std::string &out) {
+  initializeNativeTarget();
+
+  llvm::Triple TargetTriple{FlavoredModule.getTargetTriple()};
+  if(TargetTriple.getTriple().empty())
+    TargetTriple = llvm::Triple{llvm::sys::getProcessTriple()};
+
+  std::string Error;
+  const llvm::Target *Target =
+      llvm::TargetRegistry::lookupTarget(TargetTriple.getTriple(), Error);
+  if(!Target) {
+    this->registerError("LLVMToHost: Could not find target: " + Error);
+    return false;
+  }
+
+  // Equivalent of -march=native
+  std::string Features;
+#if LLVM_VERSION_MAJOR < 19
+  llvm::StringMap<bool> HostFeatures;
+  llvm::sys::getHostCPUFeatures(HostFeatures);
+#else
+  llvm::StringMap<bool> HostFeatures = llvm::sys::getHostCPUFeatures();
+#endif
+  for(const auto& Feature : HostFeatures) {
+    if(!Features.empty())
+      Features += ",";
+    Features += (Feature.second ? "+" : "-") + Feature.first().str();
+  }
+
+#if LLVM_VERSION_MAJOR < 16
+  auto CodeModelOverride = llvm::None;
+#else
+  auto CodeModelOverride = std::nullopt;
+#endif
+#if LLVM_VERSION_MAJOR < 18
+  auto OptLevel = llvm::CodeGenOpt::Aggressive;
+  auto FileType = llvm::CGFT_ObjectFile;
+#else
+  auto OptLevel = llvm::CodeGenOptLevel::Aggressive;
+  auto FileType = llvm::CodeGenFileType::ObjectFile;
+#endif
+  std::unique_ptr<llvm::TargetMachine> TM{Target->createTargetMachine(
+      TargetTriple.getTriple(), llvm::sys::getHostCPUName(), Features,
+      llvm::TargetOptions{}, llvm::Reloc::PIC_, CodeModelOverride, OptLevel)};
+  if(!TM) {
+    this->registerError("LLVMToHost: Could not create target machine");
+    return false;
+  }
+  FlavoredModule.setDataLayout(TM->createDataLayout());
+
+  // Optimize for the host CPU, like the clang invocation of the shared
+  // library flow
+  {
+    llvm::LoopAnalysisManager LAM;
+    llvm::FunctionAnalysisManager FAM;
+    llvm::CGSCCAnalysisManager CGAM;
+    llvm::ModuleAnalysisManager MAM;
+    llvm::PassBuilder PB{TM.get()};
+    PB.registerModuleAnalyses(MAM);
+    PB.registerCGSCCAnalyses(CGAM);
+    PB.registerFunctionAnalyses(FAM);
+    PB.registerLoopAnalyses(LAM);
+    PB.crossRegisterProxies(LAM, FAM, CGAM, MAM);
+    PB.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3)
+        .run(FlavoredModule, MAM);
+  }
+
+  llvm::SmallVector<char, 0> Object;
+  llvm::raw_svector_ostream ObjectStream{Object};
+  llvm::legacy::PassManager CodeGenPM;
+  if(TM->addPassesToEmitFile(CodeGenPM, ObjectStream, nullptr, FileType)) {
+    this->registerError("LLVMToHost: Target cannot emit object files");
+    return false;
+  }
+  CodeGenPM.run(FlavoredModule);
+
+  out.assign(Object.begin(), Object.end());
+  return true;
+}
+
+bool LLVMToHostTranslator::applyBuildFlag(const std::string &Flag) {
+  if (Flag == "host-relocatable-object") {
+    this->EmitRelocatableObject = true;
+    return true;
+  }
+  return false;
+}
+
 bool LLVMToHostTranslator::applyBuildOption(const std::string &Option, const std::string &Value) {
+  if (Option == "host-sub-group-size") {
+    this->SubGroupSize = static_cast<unsigned>(std::stoi(Value));
+    return true;
+  }
+
   return false;
 }
 
@@ -33,6 +33,11 @@
 #include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Support/Program.h>
+#ifdef ACPP_LLVMSPIRV_LIBRARY
+#include <LLVMSPIRVLib.h>
+#include <map>
+#include <sstream>
+#endif
 #include <memory>
 #include <cassert>
 #include <string>
@@ -46,31 +51,64 @@ namespace {
 
 static const char* DynamicLocalMemArrayName = "__acpp_sscp_spirv_dynamic_local_mem";
 
+const char* IntelLLVMSpirvExtensions[] = {
+    "SPV_EXT_shader_atomic_float_add", "SPV_EXT_shader_atomic_float_min_max",
+    "SPV_KHR_no_integer_wrap_decoration", "SPV_KHR_float_controls", "SPV_KHR_expect_assume",
+    "SPV_INTEL_subgroups", "SPV_INTEL_media_block_io",
+    "SPV_INTEL_device_side_avc_motion_estimation", "SPV_INTEL_fpga_loop_controls",
+    "SPV_INTEL_fpga_memory_attributes", "SPV_INTEL_fpga_memory_accesses",
+    "SPV_INTEL_unstructured_loop_controls", "SPV_INTEL_fpga_reg", "SPV_INTEL_blocking_pipes",
+    "SPV_INTEL_function_pointers", "SPV_INTEL_kernel_attributes", "SPV_INTEL_io_pipes",
+    "SPV_INTEL_inline_assembly", "SPV_INTEL_arbitrary_precision_integers",
+    "SPV_INTEL_float_controls2", "SPV_INTEL_vector_compute", "SPV_INTEL_fast_composite",
+    "SPV_INTEL_fpga_buffer_location", "SPV_INTEL_joint_matrix",
+    "SPV_INTEL_arbitrary_precision_fixed_point", "SPV_INTEL_arbitrary_precision_floating_point",
+    "SPV_INTEL_variable_length_array", "SPV_INTEL_fp_fast_math_mode",
+    "SPV_INTEL_fpga_cluster_attributes", "SPV_INTEL_loop_fuse",
+    "SPV_INTEL_long_constant_composite", "SPV_INTEL_fpga_invocation_pipelining_attributes",
+    "SPV_INTEL_fpga_dsp_control", "SPV_INTEL_arithmetic_fence", "SPV_INTEL_runtime_aligned",
+    "SPV_INTEL_optnone", "SPV_INTEL_token_type", "SPV_INTEL_bfloat16_conversion",
+    "SPV_INTEL_hw_thread_queries", "SPV_INTEL_memory_access_aliasing",
+    "SPV_EXT_relaxed_printf_string_address_space"};
+
+const char* DefaultLLVMSpirvExtensions[] = {"SPV_EXT_relaxed_printf_string_address_space"};
+
+const char* IntelLLVMSpirvAllowedUnknownIntrinsics = "llvm.genx.";
+
+#ifndef ACPP_LLVMSPIRV_LIBRARY
 void appendIntelLLVMSpirvOptions(llvm::SmallVector<std::string>& out) {
+  std::string Extensions = "-spirv-ext=-all";
+  for(const char* Ext : IntelLLVMSpirvExtensions) {
+    Extensions += ",+";
+    Extensions += Ext;
+  }
   llvm::SmallVector<std::string> Args {"-spirv-max-version=1.3",
       "-spirv-debug-info-version=ocl-100",
       "-spirv-allow-extra-diexpressions",
-      "-spirv-allow-unknown-intrinsics=llvm.genx.",
-      "-spirv-ext=-all,+SPV_EXT_shader_atomic_float_add,+SPV_EXT_shader_atomic_float_min_max,+SPV_"
-      "KHR_no_integer_wrap_decoration,+SPV_KHR_float_controls,+SPV_KHR_expect_assume,+SPV_INTEL_"
-      "subgroups,+SPV_INTEL_media_block_io,+SPV_INTEL_device_side_avc_motion_estimation,+SPV_INTEL_"
-      "fpga_loop_controls,+SPV_INTEL_fpga_memory_attributes,+SPV_INTEL_fpga_memory_accesses,+SPV_"
-      "INTEL_unstructured_loop_controls,+SPV_INTEL_fpga_reg,+SPV_INTEL_blocking_pipes,+SPV_INTEL_"
-      "function_pointers,+SPV_INTEL_kernel_attributes,+SPV_INTEL_io_pipes,+SPV_INTEL_inline_"
-      "assembly,+SPV_INTEL_arbitrary_precision_integers,+SPV_INTEL_float_controls2,+SPV_INTEL_"
-      "vector_compute,+SPV_INTEL_fast_composite,+SPV_INTEL_fpga_buffer_location,+SPV_INTEL_joint_"
-      "matrix,+SPV_INTEL_arbitrary_precision_fixed_point,+SPV_INTEL_arbitrary_precision_floating_"
-      "point,+SPV_INTEL_arbitrary_precision_floating_point,+SPV_INTEL_variable_length_array,+SPV_"
-      "INTEL_fp_fast_math_mode,+SPV_INTEL_fpga_cluster_attributes,+SPV_INTEL_loop_fuse,+SPV_INTEL_"
-      "long_constant_composite,+SPV_INTEL_fpga_invocation_pipelining_attributes,+SPV_INTEL_fpga_"
-      "dsp_control,+SPV_INTEL_arithmetic_fence,+SPV_INTEL_runtime_aligned,"
-      "+SPV_INTEL_optnone,+SPV_INTEL_token_type,+SPV_INTEL_bfloat16_conversion,+SPV_INTEL_joint_"
-      "matrix,+SPV_INTEL_hw_thread_queries,+SPV_INTEL_memory_access_aliasing,+SPV_EXT_relaxed_printf_string_address_space"
+      std::string{"-spirv-allow-unknown-intrinsics="} + IntelLLVMSpirvAllowedUnknownIntrinsics,
+      Extensions
   };
   for(const auto& S : Args) {
     out.push_back(S);
   }
 }
+#else
+template<std::size_t N>
+void enableLLVMSpirvExtensions(SPIRV::TranslatorOpts::ExtensionsStatusMap &Map,
+                               const char* (&Extensions)[N]) {
+  static const std::map<std::string, SPIRV::ExtensionID> ExtensionIDs = {
+#define EXT(X) {#X, SPIRV::ExtensionID::X},
+#include "LLVMSPIRVExtensions.inc"
+#undef EXT
+  };
+  for(const char* Ext : Extensions) {
+    auto It = ExtensionIDs.find(Ext);
+    // Extensions that this translator version does not know are unused anyway
+    if(It != ExtensionIDs.end())
+      Map[It->second] = true;
+  }
+}
+#endif
 
 bool setDynamicLocalMemoryCapacity(llvm::Module& M, unsigned numBytes) {
   llvm::GlobalVariable* GV = M.getGlobalVariable(DynamicLocalMemArrayName);
@@ -217,6 +255,31 @@ bool LLVMToSpirvTranslator::toBackendFlavor(llvm::Module &M, PassHandler& PH) {
 }
 
 bool LLVMToSpirvTranslator::translateToBackendFormat(llvm::Module &FlavoredModule, std::string &out) {
+#ifdef ACPP_LLVMSPIRV_LIBRARY
+  SPIRV::TranslatorOpts::ExtensionsStatusMap Extensions;
+  if(UseIntelLLVMSpirvArgs)
+    enableLLVMSpirvExtensions(Extensions, IntelLLVMSpirvExtensions);
+  else
+    enableLLVMSpirvExtensions(Extensions, DefaultLLVMSpirvExtensions);
+
+  SPIRV::TranslatorOpts Opts{SPIRV::VersionNumber::SPIRV_1_3, Extensions};
+  // Debug info related Intel options are not needed, since debug info is
+  // stripped in toBackendFlavor().
+  if(UseIntelLLVMSpirvArgs)
+    Opts.setSPIRVAllowUnknownIntrinsics({IntelLLVMSpirvAllowedUnknownIntrinsics});
+
+  HIPSYCL_DEBUG_INFO << "LLVMToSpirv: Invoking SPIR-V translator library\n";
+
+  std::ostringstream OutputStream;
+  std::string ErrMsg;
+  if(!llvm::writeSpirv(&FlavoredModule, Opts, OutputStream, ErrMsg)) {
+    this->registerError("LLVMToSpirv: SPIR-V translation failed: " + ErrMsg);
+    return false;
+  }
+
+  out = OutputStream.str();
+  return true;
+#else
 
   auto InputFile = llvm::sys::fs::TempFile::create("acpp-sscp-spirv-%%%%%%.bc");
   auto OutputFile = llvm::sys::fs::TempFile::create("acpp-sscp-spirv-%%%%%%.spv");
@@ -284,6 +347,7 @@ bool LLVMToSpirvTranslator::translateToBackendFormat(llvm::Module &FlavoredModul
   out = ReadResult->get()->getBuffer();
 
   return true;
+#endif
 }
 
 bool LLVMToSpirvTranslator::applyBuildOption(const std::string &Option, const std::string &Value) {
@@ -19,10 +19,15 @@
 #include "hipSYCL/compiler/CompilationState.hpp"
 #include "hipSYCL/compiler/cbs/IRUtils.hpp"
 #include "hipSYCL/compiler/utils/ProcessFunctionAnnotationsPass.hpp"
+#include "hipSYCL/common/config.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/common/stable_running_hash.hpp"
 
 #include <cstddef>
 
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/Function.h>
@@ -36,6 +41,7 @@
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <llvm/Support/CommandLine.h>
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <fstream>
@@ -346,6 +352,94 @@ std::unique_ptr<llvm::Module> generateDeviceIR(llvm::Module &M,
   return DeviceModule;
 }
 
+// Hashes the IR of a kernel together with all functions and global variables
+// it references. Identical kernels in different translation units, e.g. from
+// template instantiations in multiple TUs, obtain the same hash, which allows
+// the runtime to share JIT binaries between them.
+std::string computeKernelContentHash(llvm::Module &DeviceModule,
+                                     const std::string &KernelName) {
+  llvm::Function *Kernel = DeviceModule.getFunction(KernelName);
+  if(!Kernel)
+    return {};
+
+  llvm::SmallPtrSet<const llvm::GlobalValue *, 16> Referenced;
+  llvm::SmallPtrSet<const llvm::Constant *, 16> VisitedConstants;
+  llvm::SmallVector<const llvm::GlobalValue *, 16> Worklist;
+
+  std::function<void(const llvm::Value *)> VisitValue = [&](const llvm::Value *V) {
+    if(auto *GV = llvm::dyn_cast<llvm::GlobalValue>(V)) {
+      if(Referenced.insert(GV).second)
+        Worklist.push_back(GV);
+    } else if(auto *C = llvm::dyn_cast<llvm::Constant>(V)) {
+      if(VisitedConstants.insert(C).second)
+        for(const llvm::Value *Op : C->operands())
+          VisitValue(Op);
+    }
+  };
+
+  VisitValue(Kernel);
+  while(!Worklist.empty()) {
+    const llvm::GlobalValue *GV = Worklist.pop_back_val();
+    if(auto *F = llvm::dyn_cast<llvm::Function>(GV)) {
+      for(const auto &BB : *F)
+        for(const auto &I : BB)
+          for(const llvm::Value *Op : I.operands())
+            VisitValue(Op);
+    } else if(auto *Var = llvm::dyn_cast<llvm::GlobalVariable>(GV)) {
+      if(Var->hasInitializer())
+        VisitValue(Var->getInitializer());
+    } else if(auto *A = llvm::dyn_cast<llvm::GlobalAlias>(GV)) {
+      VisitValue(A->getAliasee());
+    }
+  }
+
+  // Print the kernel and its dependencies as a separate module, such that
+  // attribute groups and metadata are numbered independently of the rest
+  // of the translation unit.
+  llvm::ValueToValueMapTy VMap;
+  std::unique_ptr<llvm::Module> KernelModule =
+      llvm::CloneModule(DeviceModule, VMap, [&](const llvm::GlobalValue *GV) {
+        return Referenced.count(GV) > 0;
+      });
+
+  llvm::SmallPtrSet<const llvm::GlobalValue *, 16> Kept;
+  for(const llvm::GlobalValue *GV : Referenced)
+    Kept.insert(llvm::cast<llvm::GlobalValue>(VMap.lookup(GV)));
+  llvm::SmallVector<llvm::GlobalValue *, 16> Unused;
+  for(auto &GV : KernelModule->global_values())
+    if(!Kept.count(&GV))
+      Unused.push_back(&GV);
+  for(llvm::GlobalValue *GV : Unused) {
+    GV->replaceAllUsesWith(llvm::UndefValue::get(GV->getType()));
+    GV->eraseFromParent();
+  }
+
+  llvm::SmallVector<llvm::NamedMDNode *, 4> UnusedMetadata;
+  for(auto &MD : KernelModule->named_metadata())
+    if(MD.getName() != "llvm.module.flags")
+      UnusedMetadata.push_back(&MD);
+  for(llvm::NamedMDNode *MD : UnusedMetadata)
+    KernelModule->eraseNamedMetadata(MD);
+
+  KernelModule->setModuleIdentifier("");
+  KernelModule->setSourceFileName("");
+
+  std::string KernelIR;
+  llvm::raw_string_ostream OutputStream{KernelIR};
+  KernelModule->print(OutputStream, nullptr);
+  OutputStream.flush();
+
+  // Binaries are cached persistently, so kernels compiled by different
+  // AdaptiveCpp versions must not be considered identical.
+  KernelIR += std::to_string(ACPP_VERSION_MAJOR) + "." +
+              std::to_string(ACPP_VERSION_MINOR) + "." +
+              std::to_string(ACPP_VERSION_PATCH) + ACPP_VERSION_SUFFIX;
+
+  common::stable_running_hash Hash;
+  Hash(KernelIR.data(), KernelIR.size());
+  return std::to_string(Hash.get_current_hash());
+}
+
 std::string
 generateHCF(llvm::Module &DeviceModule, std::size_t HcfObjectId,
             const std::vector<KernelInfo> &Kernels, const std::vector<std::string> &ExportedSymbols,
@@ -381,6 +475,9 @@ generateHCF(llvm::Module &DeviceModule, std::size_t HcfObjectId,
   for(const auto& Kernel : Kernels) {
     auto* K = KernelsNode->add_subnode(Kernel.Name);
     K->set_as_list("image-providers", {std::string{"llvm-ir.global"}});
+    std::string ContentHash = computeKernelContentHash(DeviceModule, Kernel.Name);
+    if(!ContentHash.empty())
+      K->set("content-hash", ContentHash);
     
     auto* FlagsNode = K->add_subnode("compile-flags");
     for(const auto& F : KernelCompileFlags) {
@@ -19,6 +19,7 @@
 #include <llvm/Transforms/Utils/ValueMapper.h>
 #include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
 #include <llvm/ADT/SmallSet.h>
 #include <llvm/IR/InstrTypes.h>
 #include <llvm/IR/PassManager.h>
@@ -113,6 +114,155 @@ void collectAllCallees(llvm::CallGraph& CG, llvm::Function* F, SetT& Out) {
   }
 }
 
+// Determines whether the pointer returned by an allocation call can be proven
+// to never reach a stdpar algorithm, such that the allocation can be
+// served by the regular malloc instead of USM.
+//
+// The pointer (and every pointer derived from it) may only be accessed
+// by loads and stores, compared, passed to memory intrinsics and the
+// free functions, stored to allocas that themselves do not escape, or passed
+// to defined functions that satisfy the same conditions for the
+// corresponding argument. Anything else, in particular stdpar entrypoints,
+// returning the pointer, storing it to memory, indirect calls and calls
+// to declarations, is considered an escape.
+class HostOnlyAllocationAnalysis {
+public:
+  template<class SetT>
+  HostOnlyAllocationAnalysis(const SetT& FreeFunctions, const SetT& StdparEntrypoints)
+  : FreeFunctions{FreeFunctions.begin(), FreeFunctions.end()},
+    StdparEntrypoints{StdparEntrypoints.begin(), StdparEntrypoints.end()} {}
+
+  bool isHostOnly(llvm::CallBase* AllocationCall) {
+    llvm::SmallPtrSet<llvm::Value*, 16> Visited;
+    return isHostOnlyValue(AllocationCall, Visited);
+  }
+
+private:
+  static constexpr int MaxArgumentDepth = 8;
+
+  bool isHostOnlyValue(llvm::Value *V, llvm::SmallPtrSet<llvm::Value *, 16> &Visited,
+                       int Depth = 0) {
+    if(Visited.contains(V))
+      return true;
+    Visited.insert(V);
+
+    for(llvm::User* U : V->users()) {
+      if(llvm::isa<llvm::LoadInst>(U) || llvm::isa<llvm::ICmpInst>(U)) {
+        continue;
+      } else if(auto* SI = llvm::dyn_cast<llvm::StoreInst>(U)) {
+        if(SI->getValueOperand() == V) {
+          // Storing the pointer is only fine into local variables that do not
+          // escape - then all loads from them need to be followed.
+          auto* Alloca = llvm::dyn_cast<llvm::AllocaInst>(
+              SI->getPointerOperand()->stripPointerCasts());
+          if(!Alloca || !isHostOnlyLocalVariable(Alloca, Visited, Depth))
+            return false;
+        }
+      } else if (llvm::isa<llvm::GetElementPtrInst>(U) || llvm::isa<llvm::BitCastInst>(U) ||
+                 llvm::isa<llvm::AddrSpaceCastInst>(U) || llvm::isa<llvm::PHINode>(U) ||
+                 llvm::isa<llvm::SelectInst>(U)) {
+        if(!isHostOnlyValue(U, Visited, Depth))
+          return false;
+      } else if(auto* CE = llvm::dyn_cast<llvm::ConstantExpr>(U)) {
+        if(CE->getOpcode() != llvm::Instruction::BitCast &&
+           CE->getOpcode() != llvm::Instruction::GetElementPtr)
+          return false;
+        if(!isHostOnlyValue(CE, Visited, Depth))
+          return false;
+      } else if(auto* CB = llvm::dyn_cast<llvm::CallBase>(U)) {
+        if(!isHostOnlyCallArgument(CB, V, Depth))
+          return false;
+      } else {
+        // Returns, ptrtoint, stores into aggregates etc.
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool isHostOnlyLocalVariable(llvm::AllocaInst *Alloca,
+                               llvm::SmallPtrSet<llvm::Value *, 16> &Visited, int Depth) {
+    llvm::SmallVector<llvm::Value*, 8> Worklist{Alloca};
+    llvm::SmallPtrSet<llvm::Value*, 8> Addresses;
+    while(!Worklist.empty()) {
+      llvm::Value* Address = Worklist.pop_back_val();
+      if(Addresses.contains(Address))
+        continue;
+      Addresses.insert(Address);
+
+      for(llvm::User* U : Address->users()) {
+        if(auto* LI = llvm::dyn_cast<llvm::LoadInst>(U)) {
+          // The loaded value might be our pointer
+          if(!isHostOnlyValue(LI, Visited, Depth))
+            return false;
+        } else if(auto* SI = llvm::dyn_cast<llvm::StoreInst>(U)) {
+          if(SI->getValueOperand() == Address)
+            return false;
+        } else if(llvm::isa<llvm::BitCastInst>(U) || llvm::isa<llvm::AddrSpaceCastInst>(U)) {
+          Worklist.push_back(U);
+        } else if(auto* II = llvm::dyn_cast<llvm::IntrinsicInst>(U)) {
+          if(!II->isLifetimeStartOrEnd())
+            return false;
+        } else {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool isHostOnlyCallArgument(llvm::CallBase* CB, llvm::Value* V, int Depth) {
+    if(CB->isIndirectCall() || CB->isInlineAsm() || CB->getCalledOperand() == V)
+      return false;
+    if(CB->hasOperandBundles())
+      return false;
+
+    llvm::Function* Callee = CB->getCalledFunction();
+    if(!Callee)
+      return false;
+
+    if(FreeFunctions.contains(Callee))
+      return true;
+
+    if(auto* II = llvm::dyn_cast<llvm::IntrinsicInst>(CB)) {
+      if(llvm::isa<llvm::MemIntrinsic>(II) || II->isLifetimeStartOrEnd() ||
+         llvm::isa<llvm::DbgInfoIntrinsic>(II))
+        return true;
+      return false;
+    }
+
+    if (StdparEntrypoints.contains(Callee) || Callee->isDeclaration() ||
+        Callee->isInterposable() || Callee->isVarArg() || Depth >= MaxArgumentDepth)
+      return false;
+
+    for(unsigned i = 0; i < CB->arg_size(); ++i) {
+      if(CB->getArgOperand(i) == V) {
+        if(i >= Callee->arg_size() || !isHostOnlyArgument(Callee, i, Depth + 1))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  bool isHostOnlyArgument(llvm::Function* F, unsigned ArgNo, int Depth) {
+    auto Key = std::make_pair(F, ArgNo);
+    auto It = ArgumentCache.find(Key);
+    if(It != ArgumentCache.end())
+      return It->second;
+
+    // Recursive calls are assumed to escape, until proven otherwise.
+    ArgumentCache[Key] = false;
+    llvm::SmallPtrSet<llvm::Value*, 16> Visited;
+    bool Result = isHostOnlyValue(F->getArg(ArgNo), Visited, Depth);
+    ArgumentCache[Key] = Result;
+    return Result;
+  }
+
+  llvm::SmallPtrSet<llvm::Function*, 16> FreeFunctions;
+  llvm::SmallPtrSet<llvm::Function*, 16> StdparEntrypoints;
+  llvm::DenseMap<std::pair<llvm::Function*, unsigned>, bool> ArgumentCache;
+};
+
 template <class CallerMapT, class SetT>
 void collectAllCallersFromSet(const CallerMapT &CM, llvm::Function *F, const SetT &Input,
                               SetT &DiscardedOut, SetT &Out) {
@@ -142,8 +292,10 @@ llvm::PreservedAnalyses MallocToUSMPass::run(llvm::Module &M, llvm::ModuleAnalys
 
   static constexpr const char* AllocIdentifier = "hipsycl_stdpar_alloc";
   static constexpr const char* FreeIdentifier = "hipsycl_stdpar_free";
+  static constexpr const char* EntrypointIdentifier = "hipsycl_stdpar_entrypoint";
   llvm::SmallPtrSet<llvm::Function*, 16> ManagedAllocFunctions;
   llvm::SmallPtrSet<llvm::Function*, 16> ManagedFreeFunctions;
+  llvm::SmallPtrSet<llvm::Function*, 16> StdparEntrypoints;
 
   utils::findFunctionsWithStringAnnotations(M, [&](llvm::Function* F, llvm::StringRef Annotation){
     if(F) {
@@ -157,6 +309,9 @@ llvm::PreservedAnalyses MallocToUSMPass::run(llvm::Module &M, llvm::ModuleAnalys
       if(Annotation.compare(FreeIdentifier) == 0) {
         ManagedFreeFunctions.insert(F);
       }
+      if(Annotation.compare(EntrypointIdentifier) == 0) {
+        StdparEntrypoints.insert(F);
+      }
     }
   });
 
@@ -193,6 +348,25 @@ llvm::PreservedAnalyses MallocToUSMPass::run(llvm::Module &M, llvm::ModuleAnalys
     }
   }
 
+  // Find allocations whose memory provably never reaches a stdpar algorithm.
+  // These can use regular malloc, which avoids USM page faults and migrations.
+  llvm::SmallPtrSet<llvm::CallBase*, 16> HostOnlyAllocations;
+  if(AnalyzeAllocations) {
+    HostOnlyAllocationAnalysis HostOnlyAnalysis{ManagedFreeFunctions, StdparEntrypoints};
+    for(auto* MemoryF : ManagedAllocFunctions) {
+      for(llvm::User* U : MemoryF->users()) {
+        if(auto* CB = llvm::dyn_cast<llvm::CallBase>(U)) {
+          if (CB->getCalledFunction() == MemoryF && CB->getFunction() &&
+              !RestrictedEntrypoints.contains(CB->getFunction()) &&
+              !ManagedAllocFunctions.contains(CB->getFunction()) &&
+              !ManagedFreeFunctions.contains(CB->getFunction()) &&
+              HostOnlyAnalysis.isHostOnly(CB))
+            HostOnlyAllocations.insert(CB);
+        }
+      }
+    }
+  }
+
   // Find all functions used from those entrypoints
   llvm::SmallPtrSet<llvm::Function*, 16> RestrictedSubCallgraph;
   for(auto* F: RestrictedEntrypoints)
@@ -282,6 +456,13 @@ llvm::PreservedAnalyses MallocToUSMPass::run(llvm::Module &M, llvm::ModuleAnalys
                                  << F->getName().str() << "\n";
               return true;
             }
+            if(HostOnlyAllocations.contains(CB)) {
+              HIPSYCL_DEBUG_INFO << "[stdpar] MallocToUSM: Allocation in "
+                                 << F->getName().str()
+                                 << " does not reach stdpar algorithms, using regular "
+                                    "allocation\n";
+              return true;
+            }
           }
         }
       }
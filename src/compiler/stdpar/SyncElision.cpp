@@ -22,6 +22,7 @@
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/InstrTypes.h>
 #include <llvm/IR/PassManager.h>
+#include <llvm/Transforms/Utils/Cloning.h>
 
 
 namespace hipsycl {
@@ -82,7 +83,8 @@ void identifyStoresPotentiallyForStdparArgHandling(
                 if (StdparFunctions.contains(CB->getCalledFunction())) {
                   Users.push_back(Current);
                   return true;
-                } else if(CB->getCalledFunction()->getName().startswith("llvm.lifetime")) {
+                } else if (CB->getCalledFunction() &&
+                           CB->getCalledFunction()->getName().startswith("llvm.lifetime")) {
                   return true;
                 }
               }
@@ -138,9 +140,10 @@ bool functionDoesNotAccessMemory(llvm::Function* F){
       return true;
     }
   }
-  // We could improve this logic massively: E.g. a function which does not have ptr arguments,
-  // does not have gobal variable users, contains no inttoptr instructions, and only calls functions
-  // which satisfy these criteria could be assumed to not access memory.
+  // Functions attributed with memory(none) (or readnone in older LLVM), e.g. most math
+  // functions when compiled with -fno-math-errno
+  if(F->doesNotAccessMemory())
+    return true;
   return false;
 }
 
@@ -202,19 +205,20 @@ void forEachReachableInstructionRequiringSync(
   while(Current) {
     if(auto* CB = llvm::dyn_cast<llvm::CallBase>(Current)) {
       llvm::Function* CalledF = CB->getCalledFunction();
-      if(CalledF->getName().equals(BarrierBuiltinName)) {
+      if(CalledF && CalledF->getName().equals(BarrierBuiltinName)) {
         // basic block already contains barrier; nothing to do
         return;
       }
 
       // If we have found a call to an stdpar function, we can skip it --
       // after all, the whole point is to not sync after every stdpar call.
-      // For all other calls, we need a sync because we currently
-      // do not take control flow beyond our own function into account.
-      // We can also safely ignore functions for which we know that they
-      // do not access memory
+      // The same holds for functions that defer synchronization to their callers,
+      // which are also part of StdparFunctions here.
+      // For all other calls, we need a sync because we do not know what
+      // happens inside them. We can also safely ignore functions for which
+      // we know that they do not access memory. Indirect calls always require sync.
       bool CanSkipFunctionCall =
-          StdparFunctions.contains(CalledF) || functionDoesNotAccessMemory(CalledF);
+          CalledF && (StdparFunctions.contains(CalledF) || functionDoesNotAccessMemory(CalledF));
 
       if(!CanSkipFunctionCall) {
         H(Current);
@@ -274,6 +278,127 @@ void forEachReachableInstructionRequiringSync(
     }
   }
 }
+
+// Returns whether all call sites of F are known, and F is thus a candidate
+// for deferring synchronization to its callers.
+bool hasOnlyKnownCallSites(llvm::Function *F) {
+  if(!F || F->isDeclaration() || F->use_empty())
+    return false;
+  if(F->getName().equals(BarrierBuiltinName))
+    return false;
+  for(auto* U : F->users()) {
+    auto* CB = llvm::dyn_cast<llvm::CallBase>(U);
+    // Also excludes functions whose address is taken, or that
+    // are referenced by annotations.
+    if(!CB || CB->getCalledFunction() != F)
+      return false;
+  }
+  return true;
+}
+
+// Returns whether all paths from the entry of F to its returns are free of
+// instructions requiring synchronization, given the functions in SyncFreeFunctions
+// that can be skipped. In this case, F can return with stdpar operations still
+// outstanding, and synchronization can be moved to its call sites instead.
+bool canDeferSyncToCallers(llvm::Function *F,
+                           const llvm::SmallPtrSet<llvm::Function *, 16> &SyncFreeFunctions) {
+  InstToInstListMapT PotentialStoresForStdparArgs;
+  identifyStoresPotentiallyForStdparArgHandling(F, SyncFreeFunctions,
+                                                PotentialStoresForStdparArgs);
+
+  bool RequiresSync = false;
+  llvm::SmallPtrSet<llvm::BasicBlock*, 16> VisitedBlocks;
+  forEachReachableInstructionRequiringSync(
+      &*F->getEntryBlock().getFirstInsertionPt(), SyncFreeFunctions, PotentialStoresForStdparArgs,
+      VisitedBlocks, [&](llvm::Instruction *I) {
+        if(!llvm::isa<llvm::ReturnInst>(I))
+          RequiresSync = true;
+      });
+  return !RequiresSync;
+}
+
+// Identifies functions that (transitively) only call stdpar functions and otherwise
+// do not require synchronization, such as small helper functions wrapping stdpar calls.
+// Functions are considered starting from callers of stdpar functions, and are re-examined
+// whenever one of their callees has been found to defer synchronization. Recursive
+// functions are never found to defer synchronization.
+//
+// SyncFreeFunctions must initially contain the stdpar functions, and is extended
+// by the identified functions, which are also added to DeferredSyncFunctions.
+void identifyFunctionsDeferringSync(llvm::SmallPtrSet<llvm::Function *, 16> &SyncFreeFunctions,
+                                    llvm::SmallPtrSet<llvm::Function *, 16> &DeferredSyncFunctions) {
+  llvm::SmallVector<llvm::Function*, 16> Worklist;
+  auto AddCallers = [&](llvm::Function* F) {
+    for(auto* U : F->users()) {
+      if(auto* CB = llvm::dyn_cast<llvm::CallBase>(U)) {
+        llvm::Function* Caller = CB->getFunction();
+        if(!SyncFreeFunctions.contains(Caller))
+          Worklist.push_back(Caller);
+      }
+    }
+  };
+
+  for(auto* F : SyncFreeFunctions)
+    AddCallers(F);
+
+  while(!Worklist.empty()) {
+    llvm::Function* F = Worklist.pop_back_val();
+    if(SyncFreeFunctions.contains(F) || !hasOnlyKnownCallSites(F))
+      continue;
+    if(canDeferSyncToCallers(F, SyncFreeFunctions)) {
+      HIPSYCL_DEBUG_INFO << "[stdpar] SyncElision: Function " << F->getName()
+                         << " defers synchronization to its callers\n";
+      SyncFreeFunctions.insert(F);
+      DeferredSyncFunctions.insert(F);
+      AddCallers(F);
+    }
+  }
+}
+
+// Functions deferring synchronization must not be called from outside of the module,
+// since those callers would not synchronize. Functions that are visible outside of the
+// module are thus either made internal if every module can emit its own definition anyway
+// (e.g. inline functions and templates), or otherwise replaced by an internal clone
+// at all call sites in this module.
+void internalizeFunctionsDeferringSync(
+    llvm::SmallPtrSet<llvm::Function *, 16> &SyncFreeFunctions,
+    llvm::SmallPtrSet<llvm::Function *, 16> &DeferredSyncFunctions) {
+  llvm::SmallVector<std::pair<llvm::Function*, llvm::Function*>, 16> Clones;
+  
+  for(auto* F : DeferredSyncFunctions) {
+    if(F->hasLocalLinkage())
+      continue;
+    if(F->hasLinkOnceLinkage()) {
+      F->setLinkage(llvm::GlobalValue::InternalLinkage);
+      F->setComdat(nullptr);
+      F->setDLLStorageClass(llvm::GlobalValue::DefaultStorageClass);
+    } else {
+      llvm::ValueToValueMapTy VMap;
+      llvm::Function* Clone = llvm::CloneFunction(F, VMap);
+      Clone->setName(F->getName() + ".acpp_stdpar_deferred_sync");
+      Clone->setLinkage(llvm::GlobalValue::InternalLinkage);
+      Clone->setComdat(nullptr);
+      Clone->setDLLStorageClass(llvm::GlobalValue::DefaultStorageClass);
+      Clones.push_back(std::make_pair(F, Clone));
+    }
+  }
+
+  // Only redirect call sites once all clones exist, such that calls inside
+  // clones are redirected as well.
+  for(auto& FC : Clones) {
+    llvm::Function* F = FC.first;
+    llvm::Function* Clone = FC.second;
+    for(auto* U : llvm::make_early_inc_range(F->users())) {
+      if(auto* CB = llvm::dyn_cast<llvm::CallBase>(U))
+        CB->setCalledFunction(Clone);
+    }
+    // The original function remains for external callers, and synchronizes on exit.
+    SyncFreeFunctions.erase(F);
+    DeferredSyncFunctions.erase(F);
+    SyncFreeFunctions.insert(Clone);
+    DeferredSyncFunctions.insert(Clone);
+  }
+}
 }
 
 
@@ -350,6 +475,26 @@ llvm::PreservedAnalyses SyncElisionPass::run(llvm::Module &M, llvm::ModuleAnalys
       I->eraseFromParent();
     }
 
+    // Functions such as helpers wrapping stdpar calls, which might be called in a loop,
+    // can leave synchronization to their callers. Their call sites are then treated like
+    // stdpar calls.
+    llvm::SmallPtrSet<llvm::Function*, 16> SyncFreeFunctions = StdparFunctions;
+    llvm::SmallPtrSet<llvm::Function*, 16> DeferredSyncFunctions;
+    identifyFunctionsDeferringSync(SyncFreeFunctions, DeferredSyncFunctions);
+    internalizeFunctionsDeferringSync(SyncFreeFunctions, DeferredSyncFunctions);
+
+    for(auto* F : DeferredSyncFunctions) {
+      for(auto* U : F->users()) {
+        if(auto* CB = llvm::dyn_cast<llvm::CallBase>(U)) {
+          HIPSYCL_DEBUG_INFO << "[stdpar] SyncElision: Found call in potential need of "
+                                "synchronization: Call to "
+                             << F->getName() << " in function "
+                             << CB->getParent()->getParent()->getName() << "\n";
+          StdparCallPositions.push_back(CB);
+        }
+      }
+    }
+
     // It can frequently happen that we have store instructions between two stdpar calls.
     // These store instructions can prevent synchronization elision, even if they are just
     // used to set up stdpar arguments (e.g., construct lambda objects).
@@ -357,7 +502,7 @@ llvm::PreservedAnalyses SyncElisionPass::run(llvm::Module &M, llvm::ModuleAnalys
     // and do not interact with the stdpar kernel itself.
     InstToInstListMapT InstructionsPotentiallyForStdparArgHandling;
     identifyStoresPotentiallyForStdparArgHandling(
-        StdparCallPositions, StdparFunctions, InstructionsPotentiallyForStdparArgHandling);
+        StdparCallPositions, SyncFreeFunctions, InstructionsPotentiallyForStdparArgHandling);
 
     for(auto* I : StdparCallPositions) {
       // For the start of our search, we need be move to the next instruction following
@@ -380,8 +525,12 @@ llvm::PreservedAnalyses SyncElisionPass::run(llvm::Module &M, llvm::ModuleAnalys
 
         llvm::SmallPtrSet<llvm::BasicBlock*, 16> VisitedBlocks;
         forEachReachableInstructionRequiringSync(
-            Start, StdparFunctions, InstructionsPotentiallyForStdparArgHandling, VisitedBlocks,
+            Start, SyncFreeFunctions, InstructionsPotentiallyForStdparArgHandling, VisitedBlocks,
             [&](llvm::Instruction *InsertSyncBefore) {
+              // Callers of functions deferring synchronization are responsible for it
+              if (llvm::isa<llvm::ReturnInst>(InsertSyncBefore) &&
+                  DeferredSyncFunctions.contains(InsertSyncBefore->getFunction()))
+                return;
               HIPSYCL_DEBUG_INFO << "[stdpar] SyncElision: Inserting synchronization in function "
                                 << InsertSyncBefore->getParent()->getParent()->getName() << "\n";
               llvm::CallInst::Create(SyncF->getFunctionType(), SyncF, "", InsertSyncBefore);
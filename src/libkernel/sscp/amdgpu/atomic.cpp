@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/sycl/libkernel/sscp/builtins/atomic.hpp"
 #include "hipSYCL/sycl/libkernel/sscp/builtins/builtin_config.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/amdgpu/ockl.hpp"
 
 
 inline constexpr int builtin_memory_order(__acpp_sscp_memory_order o) noexcept {
@@ -619,3 +620,119 @@ HIPSYCL_SSCP_BUILTIN __acpp_f64 __acpp_sscp_atomic_fetch_max_f64(
 }
 
 
+
+// Sub-group aggregated atomics
+
+namespace {
+
+// Number of distinct addresses of a wavefront for which additions are
+// combined. Remaining work items perform their atomic operations
+// individually, such that atomics to mostly distinct addresses are not
+// serialized.
+constexpr int max_aggregated_addresses = 4;
+
+__attribute__((always_inline)) __acpp_uint32 lane_id() {
+  return __builtin_amdgcn_mbcnt_hi(~0u, __builtin_amdgcn_mbcnt_lo(~0u, 0u));
+}
+
+__attribute__((always_inline)) __acpp_uint32 read_first_lane(__acpp_uint32 x) {
+  return static_cast<__acpp_uint32>(
+      __builtin_amdgcn_readfirstlane(static_cast<int>(x)));
+}
+
+__attribute__((always_inline)) __acpp_uint64 read_first_lane(__acpp_uint64 x) {
+  __acpp_uint64 low = read_first_lane(static_cast<__acpp_uint32>(x));
+  __acpp_uint64 high = read_first_lane(static_cast<__acpp_uint32>(x >> 32));
+  return (high << 32) | low;
+}
+
+__attribute__((always_inline)) __acpp_uint32 read_lane(__acpp_uint32 x,
+                                                       __acpp_uint32 lane) {
+  return static_cast<__acpp_uint32>(
+      __builtin_amdgcn_readlane(static_cast<int>(x), static_cast<int>(lane)));
+}
+
+__attribute__((always_inline)) __acpp_uint64 read_lane(__acpp_uint64 x,
+                                                       __acpp_uint32 lane) {
+  __acpp_uint64 low = read_lane(static_cast<__acpp_uint32>(x), lane);
+  __acpp_uint64 high = read_lane(static_cast<__acpp_uint32>(x >> 32), lane);
+  return (high << 32) | low;
+}
+
+// Computes the atomic addition of all active work items of the wavefront
+// that target the same address with a single atomic operation by the
+// lowest of these work items. Unsigned types are used since they provide
+// the same wrap-around results as signed additions.
+template <class T, class AtomicAdd>
+__attribute__((always_inline)) T
+aggregated_fetch_add(T *ptr, T x, AtomicAdd atomic_add) {
+  __acpp_uint64 address = reinterpret_cast<__acpp_uint64>(ptr);
+  __acpp_uint32 lane = lane_id();
+
+  for (int i = 0; i < max_aggregated_addresses; ++i) {
+    // Work items that have been served have left the loop, so the first
+    // active lane provides the next address.
+    if (address == read_first_lane(address)) {
+      // Only work items with this address are active here
+      __acpp_uint64 peers = __builtin_amdgcn_read_exec();
+      __acpp_uint64 lower_peers = peers & ((1ull << lane) - 1);
+
+      T total = 0;
+      T offset = 0;
+      if (!__ockl_wfany_i32(x != read_first_lane(x))) {
+        // All peers add the same value, as in counters and histograms
+        total = x * static_cast<T>(__builtin_popcountll(peers));
+        offset = x * static_cast<T>(__builtin_popcountll(lower_peers));
+      } else {
+        for (__acpp_uint64 remaining = peers; remaining != 0;
+             remaining &= remaining - 1) {
+          __acpp_uint32 source = __builtin_ctzll(remaining);
+          T value = read_lane(x, source);
+          total += value;
+          if (source < lane)
+            offset += value;
+        }
+      }
+
+      T old = 0;
+      if (lane == static_cast<__acpp_uint32>(__builtin_ctzll(peers)))
+        old = atomic_add(ptr, total);
+      return read_first_lane(old) + offset;
+    }
+  }
+  return atomic_add(ptr, x);
+}
+
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint32 __acpp_sscp_atomic_fetch_add_aggregated_u32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint32 *ptr, __acpp_uint32 x) {
+  return aggregated_fetch_add(ptr, x, [&](__acpp_uint32 *p, __acpp_uint32 v) {
+    return __acpp_sscp_atomic_fetch_add_u32(as, order, scope, p, v);
+  });
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint64 __acpp_sscp_atomic_fetch_add_aggregated_u64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint64 *ptr, __acpp_uint64 x) {
+  return aggregated_fetch_add(ptr, x, [&](__acpp_uint64 *p, __acpp_uint64 v) {
+    return __acpp_sscp_atomic_fetch_add_u64(as, order, scope, p, v);
+  });
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int32 __acpp_sscp_atomic_fetch_add_aggregated_i32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int32 *ptr, __acpp_int32 x) {
+  return static_cast<__acpp_int32>(__acpp_sscp_atomic_fetch_add_aggregated_u32(
+      as, order, scope, reinterpret_cast<__acpp_uint32 *>(ptr),
+      static_cast<__acpp_uint32>(x)));
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int64 __acpp_sscp_atomic_fetch_add_aggregated_i64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int64 *ptr, __acpp_int64 x) {
+  return static_cast<__acpp_int64>(__acpp_sscp_atomic_fetch_add_aggregated_u64(
+      as, order, scope, reinterpret_cast<__acpp_uint64 *>(ptr),
+      static_cast<__acpp_uint64>(x)));
+}
@@ -9,6 +9,7 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/sycl/libkernel/sscp/builtins/barrier.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/core.hpp"
 
 __attribute__((always_inline))
 void __acpp_amdgpu_local_barrier() {
@@ -92,3 +93,39 @@ __acpp_sscp_sub_group_barrier(__acpp_sscp_memory_scope fence_scope,
 
   __acpp_amdgpu_mem_fence(fence_scope, order);
 }
+
+// State of grid barriers. All work groups of a cooperative launch pass through
+// the same grid barriers, so the arrival counter is reset to zero when the
+// kernel completes. The generation is only compared for changes and may wrap.
+static __acpp_uint32 __acpp_grid_barrier_arrived = 0;
+static __acpp_uint32 __acpp_grid_barrier_generation = 0;
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_grid_barrier() {
+  __acpp_amdgpu_local_barrier();
+
+  if(__acpp_sscp_get_local_id_x() == 0 && __acpp_sscp_get_local_id_y() == 0 &&
+     __acpp_sscp_get_local_id_z() == 0) {
+    __acpp_uint32 num_groups = __acpp_sscp_get_num_groups_x() *
+                               __acpp_sscp_get_num_groups_y() *
+                               __acpp_sscp_get_num_groups_z();
+    // Must be read before arriving, since the last work group to arrive
+    // increments the generation.
+    __acpp_uint32 generation =
+        __atomic_load_n(&__acpp_grid_barrier_generation, __ATOMIC_ACQUIRE);
+
+    __builtin_amdgcn_fence(__ATOMIC_RELEASE, "agent");
+    if(__atomic_fetch_add(&__acpp_grid_barrier_arrived, 1, __ATOMIC_ACQ_REL) ==
+       num_groups - 1) {
+      __atomic_store_n(&__acpp_grid_barrier_arrived, 0, __ATOMIC_RELAXED);
+      __atomic_fetch_add(&__acpp_grid_barrier_generation, 1, __ATOMIC_RELEASE);
+    } else {
+      while(__atomic_load_n(&__acpp_grid_barrier_generation,
+                            __ATOMIC_ACQUIRE) == generation)
+        __builtin_amdgcn_s_sleep(1);
+    }
+    __builtin_amdgcn_fence(__ATOMIC_ACQUIRE, "agent");
+  }
+
+  __acpp_amdgpu_local_barrier();
+}
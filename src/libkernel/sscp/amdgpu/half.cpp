@@ -13,6 +13,26 @@
 
 using hipsycl::fp16::as_native_float16;
 
+namespace {
+
+// Operations on this type are lowered to packed instructions
+// such as v_pk_add_f16.
+using native_float16x2 = _Float16 __attribute__((ext_vector_type(2)));
+
+inline native_float16x2 as_native_float16x2(__acpp_uint32 x) noexcept {
+  native_float16x2 result;
+  __builtin_memcpy(&result, &x, sizeof(result));
+  return result;
+}
+
+inline __acpp_uint32 as_integer(native_float16x2 x) noexcept {
+  __acpp_uint32 result;
+  __builtin_memcpy(&result, &x, sizeof(result));
+  return result;
+}
+
+}
+
 HIPSYCL_SSCP_BUILTIN __acpp_f16 __acpp_sscp_half_add(__acpp_f16 a,
                                                      __acpp_f16 b) {
   return hipsycl::fp16::create(as_native_float16(a) + as_native_float16(b));
@@ -33,6 +53,21 @@ HIPSYCL_SSCP_BUILTIN __acpp_f16 __acpp_sscp_half_div(__acpp_f16 a,
   return hipsycl::fp16::create(as_native_float16(a) / as_native_float16(b));
 }
 
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_add(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  return as_integer(as_native_float16x2(a) + as_native_float16x2(b));
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_sub(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  return as_integer(as_native_float16x2(a) - as_native_float16x2(b));
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_mul(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  return as_integer(as_native_float16x2(a) * as_native_float16x2(b));
+}
+
 HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_half_lt(__acpp_f16 a, __acpp_f16 b) {
   return as_native_float16(a) < as_native_float16(b);
 }
@@ -0,0 +1,213 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/subgroup.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/amdgpu/oclc.hpp"
+#include "hipSYCL/sycl/libkernel/detail/half_representation.hpp"
+
+namespace {
+
+using native_float16x4 = _Float16 __attribute__((ext_vector_type(4)));
+using native_float16x16 = _Float16 __attribute__((ext_vector_type(16)));
+using float4 = float __attribute__((ext_vector_type(4)));
+using float8 = float __attribute__((ext_vector_type(8)));
+
+enum class matrix_instructions { none, mfma, wmma };
+
+// __oclc_ISA_version is a constant of the device libraries, which are
+// linked at JIT time, so only the code path of the target remains.
+__attribute__((always_inline)) matrix_instructions
+get_matrix_instructions() {
+  int isa = __oclc_ISA_version;
+  // gfx908, gfx90a and gfx94x/gfx950 in wave64 mode
+  if (__oclc_wavefrontsize64 &&
+      (isa == 9008 || isa == 9010 || (isa >= 9400 && isa < 9600)))
+    return matrix_instructions::mfma;
+#if __has_builtin(__builtin_amdgcn_wmma_f32_16x16x16_f16_w32)
+  // RDNA3 in wave32 mode
+  if (!__oclc_wavefrontsize64 && isa >= 11000 && isa < 12000)
+    return matrix_instructions::wmma;
+#endif
+  return matrix_instructions::none;
+}
+
+__attribute__((always_inline)) __acpp_uint32
+get_lane_id() {
+  return __acpp_sscp_get_subgroup_local_id();
+}
+
+// Packs the elements (row(j), col(j)) for j < Count into fragment words
+template <int Count, class Row, class Col>
+__attribute__((always_inline)) void
+load_f16_elements(__acpp_uint32 *frag, const __acpp_f16 *ptr,
+                  __acpp_uint64 stride, __acpp_sscp_matrix_layout layout,
+                  Row row, Col col) {
+  for (int j = 0; j < Count; j += 2) {
+    __acpp_uint32 lo = hipsycl::fp16::as_integer(
+        ptr[__acpp_sscp_matrix_offset(row(j), col(j), stride, layout)]);
+    __acpp_uint32 hi = hipsycl::fp16::as_integer(
+        ptr[__acpp_sscp_matrix_offset(row(j + 1), col(j + 1), stride,
+                                      layout)]);
+    frag[j / 2] = lo | (hi << 16);
+  }
+}
+
+// Element layouts of the instructions:
+// v_mfma_f32_16x16x16f16 (wave64): lane l holds a[l%16][4*(l/16)+j],
+//   b[4*(l/16)+j][l%16] and c[4*(l/16)+j][l%16] for j < 4.
+// v_wmma_f32_16x16x16_f16 (wave32): lane l holds a[l%16][j] and
+//   b[j][l%16] for j < 16, and c[2*j+l/16][l%16] for j < 8.
+template <class F>
+__attribute__((always_inline)) void
+for_each_accumulator_element(matrix_instructions instr, F f) {
+  __acpp_uint32 lane = get_lane_id();
+  if (instr == matrix_instructions::mfma) {
+    for (int j = 0; j < 4; ++j)
+      f(j, 4 * (lane / 16) + j, lane % 16);
+  } else {
+    for (int j = 0; j < 8; ++j)
+      f(j, 2 * j + lane / 16, lane % 16);
+  }
+}
+
+__attribute__((target("mai-insts"))) void
+mfma_f32_16x16x16f16(__acpp_uint32 *d, const __acpp_uint32 *a,
+                     const __acpp_uint32 *b, const __acpp_uint32 *c) {
+  native_float16x4 a_values;
+  native_float16x4 b_values;
+  float4 c_values;
+  __builtin_memcpy(&a_values, a, sizeof(a_values));
+  __builtin_memcpy(&b_values, b, sizeof(b_values));
+  __builtin_memcpy(&c_values, c, sizeof(c_values));
+  float4 d_values = __builtin_amdgcn_mfma_f32_16x16x16f16(a_values, b_values,
+                                                         c_values, 0, 0, 0);
+  __builtin_memcpy(d, &d_values, sizeof(d_values));
+}
+
+#if __has_builtin(__builtin_amdgcn_wmma_f32_16x16x16_f16_w32)
+__attribute__((target("gfx11-insts,wavefrontsize32"))) void
+wmma_f32_16x16x16_f16(__acpp_uint32 *d, const __acpp_uint32 *a,
+                      const __acpp_uint32 *b, const __acpp_uint32 *c) {
+  native_float16x16 a_values;
+  native_float16x16 b_values;
+  float8 c_values;
+  __builtin_memcpy(&a_values, a, sizeof(a_values));
+  __builtin_memcpy(&b_values, b, sizeof(b_values));
+  __builtin_memcpy(&c_values, c, sizeof(c_values));
+  float8 d_values =
+      __builtin_amdgcn_wmma_f32_16x16x16_f16_w32(a_values, b_values, c_values);
+  __builtin_memcpy(d, &d_values, sizeof(d_values));
+}
+#endif
+
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_a_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  matrix_instructions instr = get_matrix_instructions();
+  __acpp_uint32 lane = get_lane_id();
+  if (instr == matrix_instructions::mfma)
+    load_f16_elements<4>(
+        frag, ptr, stride, layout, [&](int) { return lane % 16; },
+        [&](int j) { return 4 * (lane / 16) + j; });
+  else if (instr == matrix_instructions::wmma)
+    load_f16_elements<16>(
+        frag, ptr, stride, layout, [&](int) { return lane % 16; },
+        [&](int j) { return j; });
+  else
+    __acpp_sscp_matrix_generic_load_ab(frag, ptr, stride, layout);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_b_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  matrix_instructions instr = get_matrix_instructions();
+  __acpp_uint32 lane = get_lane_id();
+  if (instr == matrix_instructions::mfma)
+    load_f16_elements<4>(
+        frag, ptr, stride, layout, [&](int j) { return 4 * (lane / 16) + j; },
+        [&](int) { return lane % 16; });
+  else if (instr == matrix_instructions::wmma)
+    load_f16_elements<16>(
+        frag, ptr, stride, layout, [&](int j) { return j; },
+        [&](int) { return lane % 16; });
+  else
+    __acpp_sscp_matrix_generic_load_ab(frag, ptr, stride, layout);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f32 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  matrix_instructions instr = get_matrix_instructions();
+  if (instr == matrix_instructions::none) {
+    __acpp_sscp_matrix_generic_load_c(frag, ptr, stride, layout,
+                                      __acpp_sscp_get_subgroup_local_id(),
+                                      __acpp_sscp_get_subgroup_size());
+    return;
+  }
+  for_each_accumulator_element(instr, [&](int e, __acpp_uint32 row,
+                                          __acpp_uint32 col) {
+    frag[e] = __acpp_sscp_matrix_generic_float_to_word(
+        ptr[__acpp_sscp_matrix_offset(row, col, stride, layout)]);
+  });
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_store_c_f32_m16n16k16(const __acpp_uint32 *frag,
+                                         __acpp_f32 *ptr,
+                                         __acpp_uint64 stride,
+                                         __acpp_sscp_matrix_layout layout) {
+  matrix_instructions instr = get_matrix_instructions();
+  if (instr == matrix_instructions::none) {
+    __acpp_sscp_matrix_generic_store_c(frag, ptr, stride, layout,
+                                       __acpp_sscp_get_subgroup_local_id(),
+                                       __acpp_sscp_get_subgroup_size());
+    return;
+  }
+  for_each_accumulator_element(instr, [&](int e, __acpp_uint32 row,
+                                          __acpp_uint32 col) {
+    ptr[__acpp_sscp_matrix_offset(row, col, stride, layout)] =
+        __acpp_sscp_matrix_generic_word_to_float(frag[e]);
+  });
+}
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_matrix_fill_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        __acpp_f32 value) {
+  __acpp_sscp_matrix_generic_fill_c(frag, value);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_mad_f32_f16_m16n16k16(
+    __acpp_uint32 *d, const __acpp_uint32 *a,
+    __acpp_sscp_matrix_layout a_layout, const __acpp_uint32 *b,
+    __acpp_sscp_matrix_layout b_layout, const __acpp_uint32 *c) {
+  // The layouts were already taken into account when loading a and b
+  matrix_instructions instr = get_matrix_instructions();
+  if (instr == matrix_instructions::mfma)
+    mfma_f32_16x16x16f16(d, a, b, c);
+#if __has_builtin(__builtin_amdgcn_wmma_f32_16x16x16_f16_w32)
+  else if (instr == matrix_instructions::wmma)
+    wmma_f32_16x16x16_f16(d, a, b, c);
+#endif
+  else
+    __acpp_sscp_matrix_generic_mad(d, a, b, c,
+                                   __acpp_sscp_get_subgroup_local_id(),
+                                   __acpp_sscp_get_subgroup_size());
+}
@@ -0,0 +1,173 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/reduction.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/reduction_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/localmem.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/amdgpu/ockl.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/amdgpu/oclc.hpp"
+
+#include <type_traits>
+
+namespace {
+
+// One element per wavefront of the largest possible work group
+__acpp_sscp_local __attribute__((loader_uninitialized))
+__acpp_uint64 reduction_buffer[32];
+
+#define HIPSYCL_AMDGPU_OCKL_REDUCE(name, ockl_function, type)                  \
+  __attribute__((always_inline)) type name(type x) { return ockl_function(x); }
+
+#define HIPSYCL_AMDGPU_OCKL_INTEGER_REDUCTIONS(suffix, type)                   \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_plus, __ockl_wfred_add_##suffix, type) \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_min, __ockl_wfred_min_##suffix, type) \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_max, __ockl_wfred_max_##suffix, type) \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_bit_and, __ockl_wfred_and_##suffix,   \
+                             type)                                             \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_bit_or, __ockl_wfred_or_##suffix,     \
+                             type)                                             \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_bit_xor, __ockl_wfred_xor_##suffix,   \
+                             type)
+
+#define HIPSYCL_AMDGPU_OCKL_FLOAT_REDUCTIONS(suffix, type)                     \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_plus, __ockl_wfred_add_##suffix, type) \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_min, __ockl_wfred_min_##suffix, type) \
+  HIPSYCL_AMDGPU_OCKL_REDUCE(ockl_reduce_max, __ockl_wfred_max_##suffix, type)
+
+HIPSYCL_AMDGPU_OCKL_INTEGER_REDUCTIONS(i32, __acpp_int32)
+HIPSYCL_AMDGPU_OCKL_INTEGER_REDUCTIONS(i64, __acpp_int64)
+HIPSYCL_AMDGPU_OCKL_INTEGER_REDUCTIONS(u32, __acpp_uint32)
+HIPSYCL_AMDGPU_OCKL_INTEGER_REDUCTIONS(u64, __acpp_uint64)
+HIPSYCL_AMDGPU_OCKL_FLOAT_REDUCTIONS(f32, __acpp_f32)
+HIPSYCL_AMDGPU_OCKL_FLOAT_REDUCTIONS(f64, __acpp_f64)
+
+// ds_swizzle in bit mode exchanges values within groups of 32 lanes. The
+// pattern must be an immediate.
+template <int XorMask>
+__attribute__((always_inline)) __acpp_uint32 swizzle_xor(__acpp_uint32 x,
+                                                         __acpp_uint32) {
+  return static_cast<__acpp_uint32>(__builtin_amdgcn_ds_swizzle(
+      static_cast<int>(x), 0x1f | (XorMask << 10)));
+}
+
+template <int XorMask, class T>
+__attribute__((always_inline)) T butterfly_step(__acpp_sscp_algorithm_op op,
+                                                T x) {
+  return __acpp_sscp_apply_algorithm_op(
+      op, x, __acpp_sscp_shuffle(x, 0, swizzle_xor<XorMask>));
+}
+
+__attribute__((always_inline)) __acpp_uint32 read_lane(__acpp_uint32 x,
+                                                       __acpp_uint32 lane) {
+  return static_cast<__acpp_uint32>(
+      __builtin_amdgcn_readlane(static_cast<int>(x), static_cast<int>(lane)));
+}
+
+__attribute__((always_inline)) __acpp_uint32 read_first_lane(__acpp_uint32 x,
+                                                             __acpp_uint32) {
+  return static_cast<__acpp_uint32>(
+      __builtin_amdgcn_readfirstlane(static_cast<int>(x)));
+}
+
+__attribute__((always_inline)) __acpp_uint32 shuffle_down(__acpp_uint32 x,
+                                                          __acpp_uint32 delta) {
+  __acpp_uint32 lid = __acpp_sscp_get_subgroup_local_id();
+  return static_cast<__acpp_uint32>(__builtin_amdgcn_ds_bpermute(
+      static_cast<int>((lid + delta) << 2), static_cast<int>(x)));
+}
+
+// Reduction for operations that ockl does not provide
+template <class T>
+__attribute__((always_inline)) T
+generic_sub_group_reduce(__acpp_sscp_algorithm_op op, T x) {
+  __acpp_uint32 size = __acpp_sscp_get_subgroup_size();
+  __acpp_uint32 max_size = __acpp_sscp_get_subgroup_max_size();
+
+  if (size == max_size) {
+    x = butterfly_step<1>(op, x);
+    x = butterfly_step<2>(op, x);
+    x = butterfly_step<4>(op, x);
+    x = butterfly_step<8>(op, x);
+    x = butterfly_step<16>(op, x);
+    // __oclc_wavefrontsize64 is a constant of the device libraries, which
+    // are linked according to the target device at JIT time.
+    if (__oclc_wavefrontsize64)
+      x = __acpp_sscp_apply_algorithm_op(op, __acpp_sscp_shuffle(x, 0, read_lane),
+                                         __acpp_sscp_shuffle(x, 32, read_lane));
+    return x;
+  }
+
+  // Incomplete wavefronts must not combine values of non-existing work items
+  __acpp_uint32 lid = __acpp_sscp_get_subgroup_local_id();
+  for (__acpp_uint32 delta = max_size / 2; delta > 0; delta /= 2) {
+    T other = __acpp_sscp_shuffle(x, delta, shuffle_down);
+    if (lid + delta < size)
+      x = __acpp_sscp_apply_algorithm_op(op, x, other);
+  }
+  return __acpp_sscp_shuffle(x, 0, read_first_lane);
+}
+
+template <class T>
+__attribute__((always_inline)) T sub_group_reduce(__acpp_sscp_algorithm_op op,
+                                                  T x) {
+  if constexpr (std::is_integral_v<T> && sizeof(T) < 4) {
+    // Sign or zero extension preserves the results of all operations
+    // after truncation
+    using extended_t =
+        std::conditional_t<std::is_signed_v<T>, __acpp_int32, __acpp_uint32>;
+    return static_cast<T>(sub_group_reduce(op, static_cast<extended_t>(x)));
+  } else {
+    // ockl implements these using DPP row operations and permutations for
+    // both wavefront sizes
+    switch (op) {
+    case __acpp_sscp_algorithm_op::plus:
+      return ockl_reduce_plus(x);
+    case __acpp_sscp_algorithm_op::min:
+      return ockl_reduce_min(x);
+    case __acpp_sscp_algorithm_op::max:
+      return ockl_reduce_max(x);
+    case __acpp_sscp_algorithm_op::bit_and:
+      if constexpr (std::is_integral_v<T>)
+        return ockl_reduce_bit_and(x);
+      break;
+    case __acpp_sscp_algorithm_op::bit_or:
+      if constexpr (std::is_integral_v<T>)
+        return ockl_reduce_bit_or(x);
+      break;
+    case __acpp_sscp_algorithm_op::bit_xor:
+      if constexpr (std::is_integral_v<T>)
+        return ockl_reduce_bit_xor(x);
+      break;
+    case __acpp_sscp_algorithm_op::logical_and:
+      return static_cast<T>(
+          ockl_reduce_bit_and(static_cast<__acpp_uint32>(x != 0)));
+    case __acpp_sscp_algorithm_op::logical_or:
+      return static_cast<T>(
+          ockl_reduce_bit_or(static_cast<__acpp_uint32>(x != 0)));
+    default:
+      break;
+    }
+    return generic_sub_group_reduce(op, x);
+  }
+}
+
+template <class T>
+__attribute__((always_inline)) T work_group_reduce(__acpp_sscp_algorithm_op op,
+                                                   T x) {
+  return __acpp_sscp_work_group_reduce_from_sub_groups(
+      op, x,
+      reinterpret_cast<__attribute__((address_space(3))) T *>(
+          &reduction_buffer[0]),
+      [](__acpp_sscp_algorithm_op op, T x) { return sub_group_reduce(op, x); });
+}
+
+}
+
+HIPSYCL_SSCP_DEFINE_ALL_REDUCTION_BUILTINS()
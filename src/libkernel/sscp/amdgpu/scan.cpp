@@ -0,0 +1,102 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/localmem.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/amdgpu/ockl.hpp"
+
+#include <type_traits>
+
+namespace {
+
+// One element per wavefront of the largest possible work group
+__acpp_sscp_local __attribute__((loader_uninitialized))
+__acpp_uint64 scan_buffer[32];
+
+__attribute__((always_inline)) __acpp_uint32 shuffle_up(__acpp_uint32 x,
+                                                        __acpp_uint32 delta) {
+  __acpp_uint32 lid = __acpp_sscp_get_subgroup_local_id();
+  __acpp_uint32 source = lid >= delta ? lid - delta : lid;
+  return static_cast<__acpp_uint32>(__builtin_amdgcn_ds_bpermute(
+      static_cast<int>(source << 2), static_cast<int>(x)));
+}
+
+#define HIPSYCL_AMDGPU_OCKL_SCAN(name, ockl_function, type)                    \
+  __attribute__((always_inline)) type name(type x, bool inclusive) {           \
+    return ockl_function(x, inclusive);                                        \
+  }
+
+#define HIPSYCL_AMDGPU_OCKL_INTEGER_SCANS(suffix, type)                        \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_plus, __ockl_wfscan_add_##suffix, type)   \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_min, __ockl_wfscan_min_##suffix, type)    \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_max, __ockl_wfscan_max_##suffix, type)    \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_bit_and, __ockl_wfscan_and_##suffix, type) \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_bit_or, __ockl_wfscan_or_##suffix, type)  \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_bit_xor, __ockl_wfscan_xor_##suffix, type)
+
+#define HIPSYCL_AMDGPU_OCKL_FLOAT_SCANS(suffix, type)                          \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_plus, __ockl_wfscan_add_##suffix, type)   \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_min, __ockl_wfscan_min_##suffix, type)    \
+  HIPSYCL_AMDGPU_OCKL_SCAN(ockl_scan_max, __ockl_wfscan_max_##suffix, type)
+
+HIPSYCL_AMDGPU_OCKL_INTEGER_SCANS(i32, __acpp_int32)
+HIPSYCL_AMDGPU_OCKL_INTEGER_SCANS(i64, __acpp_int64)
+HIPSYCL_AMDGPU_OCKL_INTEGER_SCANS(u32, __acpp_uint32)
+HIPSYCL_AMDGPU_OCKL_INTEGER_SCANS(u64, __acpp_uint64)
+HIPSYCL_AMDGPU_OCKL_FLOAT_SCANS(f32, __acpp_f32)
+HIPSYCL_AMDGPU_OCKL_FLOAT_SCANS(f64, __acpp_f64)
+
+template <class T>
+__attribute__((always_inline)) T sub_group_scan(__acpp_sscp_algorithm_op op,
+                                                T x, bool inclusive) {
+  // ockl provides DPP-based wavefront scans for 32 and 64 bit types and
+  // the most common operations
+  if constexpr (sizeof(T) >= 4) {
+    switch (op) {
+    case __acpp_sscp_algorithm_op::plus:
+      return ockl_scan_plus(x, inclusive);
+    case __acpp_sscp_algorithm_op::min:
+      return ockl_scan_min(x, inclusive);
+    case __acpp_sscp_algorithm_op::max:
+      return ockl_scan_max(x, inclusive);
+    case __acpp_sscp_algorithm_op::bit_and:
+      if constexpr (std::is_integral_v<T>)
+        return ockl_scan_bit_and(x, inclusive);
+      break;
+    case __acpp_sscp_algorithm_op::bit_or:
+      if constexpr (std::is_integral_v<T>)
+        return ockl_scan_bit_or(x, inclusive);
+      break;
+    case __acpp_sscp_algorithm_op::bit_xor:
+      if constexpr (std::is_integral_v<T>)
+        return ockl_scan_bit_xor(x, inclusive);
+      break;
+    default:
+      break;
+    }
+  }
+  return __acpp_sscp_sub_group_shuffle_scan(op, x, inclusive, shuffle_up);
+}
+
+template <class T>
+__attribute__((always_inline)) T work_group_scan(__acpp_sscp_algorithm_op op,
+                                                 T x, bool inclusive) {
+  return __acpp_sscp_work_group_scan_from_sub_groups(
+      op, x, inclusive,
+      reinterpret_cast<__attribute__((address_space(3))) T *>(&scan_buffer[0]),
+      [](__acpp_sscp_algorithm_op op, T x, bool inclusive) {
+        return sub_group_scan(op, x, inclusive);
+      });
+}
+
+}
+
+HIPSYCL_SSCP_DEFINE_ALL_SCAN_BUILTINS()
@@ -0,0 +1,24 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/async_copy.hpp"
+
+// No asynchronous global to local memory copies are exposed for this
+// backend, so the copy completes immediately.
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_async_copy_global_to_local(void *dest, const void *src,
+                                       __acpp_uint32 size) {
+  __builtin_memcpy(dest, src, size);
+}
+
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_async_copy_commit() {}
+
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_async_copy_wait() {}
@@ -28,6 +28,41 @@ inline constexpr int builtin_memory_order(__acpp_sscp_memory_order o) noexcept {
   return __ATOMIC_RELAXED;
 }
 
+// The failure order of compare-exchange operations must not have release
+// semantics
+inline constexpr int
+builtin_failure_memory_order(__acpp_sscp_memory_order o) noexcept {
+  switch(o){
+    case __acpp_sscp_memory_order::relaxed:
+    case __acpp_sscp_memory_order::release:
+      return __ATOMIC_RELAXED;
+    case __acpp_sscp_memory_order::acquire:
+    case __acpp_sscp_memory_order::acq_rel:
+      return __ATOMIC_ACQUIRE;
+    case __acpp_sscp_memory_order::seq_cst:
+      return __ATOMIC_SEQ_CST;
+  }
+  return __ATOMIC_RELAXED;
+}
+
+// Floating point min/max as compare-exchange loop on the integer
+// representation. The value is only written if it needs to be replaced,
+// so calls that do not change the value only load it.
+template <class T, class Int, class Compare>
+inline T fetch_fp_replace_if(__acpp_sscp_memory_order order, T *ptr, T x,
+                             Compare should_replace) {
+  Int *int_ptr = reinterpret_cast<Int *>(ptr);
+  Int old = __atomic_load_n(int_ptr, builtin_failure_memory_order(order));
+  Int desired = __builtin_bit_cast(Int, x);
+  while (should_replace(__builtin_bit_cast(T, old), x)) {
+    if (__atomic_compare_exchange_n(int_ptr, &old, desired, true,
+                                    builtin_memory_order(order),
+                                    builtin_failure_memory_order(order)))
+      break;
+  }
+  return __builtin_bit_cast(T, old);
+}
+
 
 // ********************** atomic store ***************************
 
@@ -184,6 +219,63 @@ HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_cmp_exch_strong_i64(
                                      builtin_memory_order(success), builtin_memory_order(failure));
 }
 
+// ********************** 16-byte atomics ***************************
+
+#if defined(__x86_64__) && defined(__SIZEOF_INT128__)
+// Issues cmpxchg16b directly. Relying on the compiler would require the cx16
+// target feature, which would prevent inlining into kernels that are not
+// compiled with it, and otherwise results in libatomic calls.
+// The lock prefix makes this a full barrier, so it satisfies all memory orders.
+inline bool cmpxchg16b(__acpp_int128 *ptr, __acpp_int128 *expected,
+                       __acpp_int128 desired) noexcept {
+  __acpp_uint64 expected_lo = static_cast<__acpp_uint64>(*expected);
+  __acpp_uint64 expected_hi = static_cast<__acpp_uint64>(*expected >> 64);
+  bool success;
+  __asm__ __volatile__("lock cmpxchg16b %1"
+                       : "=@ccz"(success), "+m"(*ptr), "+a"(expected_lo),
+                         "+d"(expected_hi)
+                       : "b"(static_cast<__acpp_uint64>(desired)),
+                         "c"(static_cast<__acpp_uint64>(desired >> 64))
+                       : "memory");
+  if(!success)
+    *expected = static_cast<__acpp_int128>(
+        (static_cast<unsigned __int128>(expected_hi) << 64) | expected_lo);
+  return success;
+}
+
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_atomic_store_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int128 *ptr, __acpp_int128 x) {
+  __acpp_int128 expected = *ptr;
+  while(!cmpxchg16b(ptr, &expected, x))
+    ;
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_int128 __acpp_sscp_atomic_load_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int128 *ptr) {
+  // Replaces the value with itself if it happens to be 0, and otherwise
+  // only loads it.
+  __acpp_int128 value = 0;
+  cmpxchg16b(ptr, &value, 0);
+  return value;
+}
+
+HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_cmp_exch_weak_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order success,
+    __acpp_sscp_memory_order failure, __acpp_sscp_memory_scope scope,
+    __acpp_int128 *ptr, __acpp_int128 *expected, __acpp_int128 desired) {
+  return cmpxchg16b(ptr, expected, desired);
+}
+
+HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_cmp_exch_strong_i128(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order success,
+    __acpp_sscp_memory_order failure, __acpp_sscp_memory_scope scope,
+    __acpp_int128 *ptr, __acpp_int128 *expected, __acpp_int128 desired) {
+  return cmpxchg16b(ptr, expected, desired);
+}
+#endif
+
 HIPSYCL_SSCP_BUILTIN __acpp_int8 __acpp_sscp_atomic_fetch_and_i8(
     __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
     __acpp_sscp_memory_scope scope, __acpp_int8 *ptr, __acpp_int8 x) {
@@ -443,23 +535,15 @@ HIPSYCL_SSCP_BUILTIN __acpp_uint64 __acpp_sscp_atomic_fetch_min_u64(
 HIPSYCL_SSCP_BUILTIN __acpp_f32 __acpp_sscp_atomic_fetch_min_f32(
     __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
     __acpp_sscp_memory_scope scope, __acpp_f32 *ptr, __acpp_f32 x) {
-  __acpp_int32 old_i = __acpp_sscp_atomic_load_i32(as, order, scope, (__acpp_int32*)ptr);
-  __acpp_f32 old = *(__acpp_f32*)&old_i;
-  do{
-    if (old < x) return old;
-  } while (!__acpp_sscp_cmp_exch_strong_i32(as, order, order, scope, (__acpp_int32*)ptr, (__acpp_int32*)&old, *(__acpp_int32*)&x));
-  return x;
+  return fetch_fp_replace_if<__acpp_f32, __acpp_int32>(
+      order, ptr, x, [](__acpp_f32 old, __acpp_f32 x) { return x < old; });
 }
 
 HIPSYCL_SSCP_BUILTIN __acpp_f64 __acpp_sscp_atomic_fetch_min_f64(
     __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
     __acpp_sscp_memory_scope scope, __acpp_f64 *ptr, __acpp_f64 x) {
-  __acpp_int64 old_i = __acpp_sscp_atomic_load_i64(as, order, scope, (__acpp_int64*)ptr);
-  __acpp_f64 old = *(__acpp_f64*)&old_i;
-  do{
-    if (old < x) return old;
-  } while (!__acpp_sscp_cmp_exch_strong_i64(as, order, order, scope, (__acpp_int64*)ptr, (__acpp_int64*)&old, *(__acpp_int64*)&x));
-  return x;
+  return fetch_fp_replace_if<__acpp_f64, __acpp_int64>(
+      order, ptr, x, [](__acpp_f64 old, __acpp_f64 x) { return x < old; });
 }
 
 
@@ -514,22 +598,40 @@ HIPSYCL_SSCP_BUILTIN __acpp_uint64 __acpp_sscp_atomic_fetch_max_u64(
 HIPSYCL_SSCP_BUILTIN __acpp_f32 __acpp_sscp_atomic_fetch_max_f32(
     __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
     __acpp_sscp_memory_scope scope, __acpp_f32 *ptr, __acpp_f32 x) {
-  __acpp_int32 old_i = __acpp_sscp_atomic_load_i32(as, order, scope, (__acpp_int32*)ptr);
-  __acpp_f32 old = *(__acpp_f32*)&old_i;
-  do{
-    if (old > x) return old;
-  } while (!__acpp_sscp_cmp_exch_strong_i32(as, order, order, scope, (__acpp_int32*)ptr, (__acpp_int32*)&old, *(__acpp_int32*)&x));
-  return x;
+  return fetch_fp_replace_if<__acpp_f32, __acpp_int32>(
+      order, ptr, x, [](__acpp_f32 old, __acpp_f32 x) { return x > old; });
 }
 
 HIPSYCL_SSCP_BUILTIN __acpp_f64 __acpp_sscp_atomic_fetch_max_f64(
     __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
     __acpp_sscp_memory_scope scope, __acpp_f64 *ptr, __acpp_f64 x) {
-  __acpp_int64 old_i = __acpp_sscp_atomic_load_i64(as, order, scope, (__acpp_int64*)ptr);
-  __acpp_f64 old = *(__acpp_f64*)&old_i;
-  do{
-    if (old > x) return old;
-  } while (!__acpp_sscp_cmp_exch_strong_i64(as, order, order, scope, (__acpp_int64*)ptr, (__acpp_int64*)&old, *(__acpp_int64*)&x));
-  return x;
+  return fetch_fp_replace_if<__acpp_f64, __acpp_int64>(
+      order, ptr, x, [](__acpp_f64 old, __acpp_f64 x) { return x > old; });
 }
 
+
+// Additions are not combined on this backend
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int32 __acpp_sscp_atomic_fetch_add_aggregated_i32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int32 *ptr, __acpp_int32 x) {
+  return __acpp_sscp_atomic_fetch_add_i32(as, order, scope, ptr, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int64 __acpp_sscp_atomic_fetch_add_aggregated_i64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int64 *ptr, __acpp_int64 x) {
+  return __acpp_sscp_atomic_fetch_add_i64(as, order, scope, ptr, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint32 __acpp_sscp_atomic_fetch_add_aggregated_u32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint32 *ptr, __acpp_uint32 x) {
+  return __acpp_sscp_atomic_fetch_add_u32(as, order, scope, ptr, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint64 __acpp_sscp_atomic_fetch_add_aggregated_u64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint64 *ptr, __acpp_uint64 x) {
+  return __acpp_sscp_atomic_fetch_add_u64(as, order, scope, ptr, x);
+}
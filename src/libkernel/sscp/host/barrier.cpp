@@ -11,6 +11,7 @@
 #include "hipSYCL/sycl/libkernel/sscp/builtins/barrier.hpp"
 
 extern "C" [[clang::convergent]] void __acpp_cbs_barrier();
+extern "C" const __acpp_uint32 __acpp_cbs_sscp_subgroup_size;
 
 __attribute__((always_inline)) void
 __acpp_cpu_mem_fence(__acpp_sscp_memory_scope fence_scope,
@@ -32,6 +33,9 @@ __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope fence_scope,
 HIPSYCL_SSCP_CONVERGENT_BUILTIN void
 __acpp_sscp_sub_group_barrier(__acpp_sscp_memory_scope fence_scope,
                               __acpp_sscp_memory_order order) {
-
+  // Sub-groups of more than one work item are emulated with work group
+  // barriers
+  if(__acpp_cbs_sscp_subgroup_size > 1)
+    __acpp_cbs_barrier();
   __acpp_cpu_mem_fence(fence_scope, order);
 }
@@ -11,6 +11,19 @@
 #include "hipSYCL/sycl/libkernel/sscp/builtins/half.hpp"
 #include "hipSYCL/sycl/libkernel/detail/half_representation.hpp"
 
+namespace {
+
+template<class F>
+inline __acpp_uint32 apply_to_half2(__acpp_uint32 a, __acpp_uint32 b, F f) {
+  __acpp_uint16 lo = f(static_cast<__acpp_uint16>(a & 0xffff),
+                       static_cast<__acpp_uint16>(b & 0xffff));
+  __acpp_uint16 hi = f(static_cast<__acpp_uint16>(a >> 16),
+                       static_cast<__acpp_uint16>(b >> 16));
+  return static_cast<__acpp_uint32>(lo) | (static_cast<__acpp_uint32>(hi) << 16);
+}
+
+}
+
 HIPSYCL_SSCP_BUILTIN hipsycl::fp16::half_storage
 __acpp_sscp_half_add(hipsycl::fp16::half_storage a,
                         hipsycl::fp16::half_storage b) {
@@ -35,6 +48,21 @@ __acpp_sscp_half_div(hipsycl::fp16::half_storage a,
   return hipsycl::fp16::builtin_div(a,b);
 }
 
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_add(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  return apply_to_half2(a, b, __acpp_sscp_half_add);
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_sub(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  return apply_to_half2(a, b, __acpp_sscp_half_sub);
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_mul(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  return apply_to_half2(a, b, __acpp_sscp_half_mul);
+}
+
 HIPSYCL_SSCP_BUILTIN bool
 __acpp_sscp_half_lt(hipsycl::fp16::half_storage a,
                        hipsycl::fp16::half_storage b) {
@@ -0,0 +1,114 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/core.hpp"
+
+extern "C" [[clang::convergent]] void __acpp_cbs_barrier();
+
+namespace {
+
+// Work items of a work group are executed by the same thread, so
+// the scan buffer does not need to be shared across threads.
+constexpr __acpp_uint32 scan_buffer_size = 1024;
+thread_local __acpp_uint64 scan_buffer[scan_buffer_size];
+thread_local __acpp_uint64 scan_carry;
+
+__attribute__((always_inline)) __acpp_uint32 get_local_linear_id() {
+  return __acpp_sscp_get_local_id_x() +
+         __acpp_sscp_get_local_size_x() *
+             (__acpp_sscp_get_local_id_y() +
+              __acpp_sscp_get_local_size_y() * __acpp_sscp_get_local_id_z());
+}
+
+__attribute__((always_inline)) __acpp_uint32 get_local_linear_size() {
+  return __acpp_sscp_get_local_size_x() * __acpp_sscp_get_local_size_y() *
+         __acpp_sscp_get_local_size_z();
+}
+
+// Scans buffer[begin, begin + size) sequentially, starting with carry.
+// Returns the combination of carry with all elements.
+template <class T>
+__attribute__((always_inline)) T scan_buffer_range(__acpp_sscp_algorithm_op op,
+                                                   T *buffer,
+                                                   __acpp_uint32 begin,
+                                                   __acpp_uint32 size, T carry,
+                                                   bool inclusive) {
+  for (__acpp_uint32 i = begin; i < begin + size; ++i) {
+    T next = __acpp_sscp_apply_algorithm_op(op, carry, buffer[i]);
+    buffer[i] = inclusive ? next : carry;
+    carry = next;
+  }
+  return carry;
+}
+
+// Work items are executed one after another by work-item loops, so the
+// scan itself is a sequential loop over the values of the work items,
+// executed by the first work item only. The exchange of values between
+// the barriers is part of the (vectorizable) work-item loops.
+template <class T>
+__attribute__((always_inline)) T sub_group_scan(__acpp_sscp_algorithm_op op,
+                                                T x, bool inclusive) {
+  __acpp_uint32 size = __acpp_sscp_get_subgroup_size();
+  if (__acpp_sscp_get_subgroup_max_size() == 1)
+    return inclusive ? x : __acpp_sscp_get_algorithm_op_identity<T>(op);
+
+  __acpp_uint32 lid = get_local_linear_id();
+  __acpp_uint32 base = lid - __acpp_sscp_get_subgroup_local_id();
+  T *buffer = reinterpret_cast<T *>(&scan_buffer[0]);
+
+  buffer[lid] = x;
+  __acpp_cbs_barrier();
+  if (lid == base)
+    scan_buffer_range(op, buffer, base, size,
+                      __acpp_sscp_get_algorithm_op_identity<T>(op), inclusive);
+  __acpp_cbs_barrier();
+  T result = buffer[lid];
+  __acpp_cbs_barrier();
+  return result;
+}
+
+// Work groups that exceed the buffer are processed in chunks.
+template <class T>
+__attribute__((always_inline)) T work_group_scan(__acpp_sscp_algorithm_op op,
+                                                 T x, bool inclusive) {
+  __acpp_uint32 lid = get_local_linear_id();
+  __acpp_uint32 local_size = get_local_linear_size();
+  T *buffer = reinterpret_cast<T *>(&scan_buffer[0]);
+  T *carry = reinterpret_cast<T *>(&scan_carry);
+
+  T result = x;
+  for (__acpp_uint32 chunk = 0; chunk < local_size;
+       chunk += scan_buffer_size) {
+    __acpp_uint32 chunk_size = local_size - chunk < scan_buffer_size
+                                   ? local_size - chunk
+                                   : scan_buffer_size;
+    bool is_in_chunk = lid >= chunk && lid < chunk + chunk_size;
+
+    if (is_in_chunk)
+      buffer[lid - chunk] = x;
+    __acpp_cbs_barrier();
+    if (lid == chunk)
+      *carry = scan_buffer_range(
+          op, buffer, 0, chunk_size,
+          chunk == 0 ? __acpp_sscp_get_algorithm_op_identity<T>(op) : *carry,
+          inclusive);
+    __acpp_cbs_barrier();
+    if (is_in_chunk)
+      result = buffer[lid - chunk];
+    __acpp_cbs_barrier();
+  }
+  return result;
+}
+
+}
+
+HIPSYCL_SSCP_DEFINE_ALL_SCAN_BUILTINS()
@@ -9,31 +9,237 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/sycl/libkernel/sscp/builtins/subgroup.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/algorithm_op.hpp"
 #include "hipSYCL/sycl/libkernel/sscp/builtins/core.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/broadcast.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/collpredicate.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/reduction.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/shuffle.hpp"
+#include "hipSYCL/sycl/libkernel/detail/half_representation.hpp"
+
+extern "C" [[clang::convergent]] void __acpp_cbs_barrier();
+
+// Sub-group size of the kernel. Defined as constant by LLVMToHost, such
+// that all code paths for other sub-group sizes are optimized away
+// before work-item loops are formed.
+extern "C" const __acpp_uint32 __acpp_cbs_sscp_subgroup_size;
+
+namespace {
+
+// Maximum supported work group size for sub-groups with more than
+// one work item
+constexpr __acpp_uint32 max_work_group_size = 1024;
+
+// Work items of a work group are executed by the same thread, so
+// the exchange buffer does not need to be shared across threads.
+thread_local __acpp_uint64 subgroup_exchange_buffer[max_work_group_size];
+
+__attribute__((always_inline)) __acpp_uint32 get_subgroup_size_config() {
+  return __acpp_cbs_sscp_subgroup_size;
+}
+
+__attribute__((always_inline)) __acpp_uint32 get_local_linear_id() {
+  return __acpp_sscp_get_local_id_x() +
+         __acpp_sscp_get_local_size_x() *
+             (__acpp_sscp_get_local_id_y() +
+              __acpp_sscp_get_local_size_y() * __acpp_sscp_get_local_id_z());
+}
+
+__attribute__((always_inline)) __acpp_uint32 get_local_linear_size() {
+  return __acpp_sscp_get_local_size_x() * __acpp_sscp_get_local_size_y() *
+         __acpp_sscp_get_local_size_z();
+}
+
+__attribute__((always_inline)) __acpp_uint32 get_subgroup_base() {
+  __acpp_uint32 lid = get_local_linear_id();
+  return lid - lid % get_subgroup_size_config();
+}
+
+// The last sub-group of a work group might be incomplete
+__attribute__((always_inline)) __acpp_uint32 get_current_subgroup_size() {
+  __acpp_uint32 remaining = get_local_linear_size() - get_subgroup_base();
+  __acpp_uint32 size = get_subgroup_size_config();
+  return remaining < size ? remaining : size;
+}
+
+template <class T> __attribute__((always_inline)) T *get_exchange_buffer() {
+  return reinterpret_cast<T *>(&subgroup_exchange_buffer[0]);
+}
+
+// Publishes x of each work item to the sub-group, and returns the value
+// of the sub-group local id that is selected by source_lane(local_id), or x
+// if this local id is out of range. Since work items are executed by
+// work-item loops, the exchange takes place through a buffer between two
+// work group barriers. This requires all work items of the work group to
+// participate.
+template <class T, class SourceLane>
+__attribute__((always_inline)) T exchange(T x, SourceLane source_lane) {
+  __acpp_uint32 lid = get_local_linear_id();
+  __acpp_uint32 base = get_subgroup_base();
+  __acpp_uint32 size = get_current_subgroup_size();
+  T *buffer = get_exchange_buffer<T>();
+
+  buffer[lid] = x;
+  __acpp_cbs_barrier();
+  __acpp_int64 source = source_lane(static_cast<__acpp_int64>(lid - base));
+  T result = (source >= 0 && source < size) ? buffer[base + source] : x;
+  __acpp_cbs_barrier();
+  return result;
+}
+
+template <class T, class BinaryOp>
+__attribute__((always_inline)) T reduce(T x, BinaryOp op) {
+  if (get_subgroup_size_config() == 1)
+    return x;
+
+  __acpp_uint32 lid = get_local_linear_id();
+  __acpp_uint32 base = get_subgroup_base();
+  __acpp_uint32 size = get_current_subgroup_size();
+  T *buffer = get_exchange_buffer<T>();
+
+  buffer[lid] = x;
+  __acpp_cbs_barrier();
+  T result = buffer[base];
+  for (__acpp_uint32 i = 1; i < size; ++i)
+    result = op(result, buffer[base + i]);
+  __acpp_cbs_barrier();
+  return result;
+}
+
+template <class T>
+__attribute__((always_inline)) T reduce_op(__acpp_sscp_algorithm_op op, T x) {
+  return reduce(x, [op](T a, T b) {
+    return __acpp_sscp_apply_algorithm_op(op, a, b);
+  });
+}
+
+template <class T>
+__attribute__((always_inline)) T select_lane(T value, __acpp_int64 id) {
+  if (get_subgroup_size_config() == 1)
+    return value;
+  return exchange(value, [id](__acpp_int64) { return id; });
+}
+
+template <class T>
+__attribute__((always_inline)) T shift_left(T value, __acpp_uint32 delta) {
+  if (get_subgroup_size_config() == 1)
+    return value;
+  return exchange(value,
+                  [delta](__acpp_int64 local_id) { return local_id + delta; });
+}
+
+template <class T>
+__attribute__((always_inline)) T shift_right(T value, __acpp_uint32 delta) {
+  if (get_subgroup_size_config() == 1)
+    return value;
+  return exchange(value,
+                  [delta](__acpp_int64 local_id) { return local_id - delta; });
+}
+
+template <class T>
+__attribute__((always_inline)) T permute(T value, __acpp_int32 mask) {
+  if (get_subgroup_size_config() == 1)
+    return value;
+  return exchange(value,
+                  [mask](__acpp_int64 local_id) { return local_id ^ mask; });
+}
+
+}
 
 HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_get_subgroup_local_id() {
-  return 0;
+  if (get_subgroup_size_config() == 1)
+    return 0;
+  return get_local_linear_id() % get_subgroup_size_config();
 }
 
 HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_get_subgroup_size() {
-  return 1;
+  if (get_subgroup_size_config() == 1)
+    return 1;
+  return get_current_subgroup_size();
 }
 
 HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_get_subgroup_max_size() {
-  return 1;
+  return get_subgroup_size_config();
 }
 
 HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_get_subgroup_id() {
-  size_t local_tid =
-      __acpp_sscp_get_local_id_x() +
-      __acpp_sscp_get_local_id_y() * (__acpp_sscp_get_local_size_x() +
-      __acpp_sscp_get_local_id_z() * __acpp_sscp_get_local_size_x());
-  return local_tid;
+  return get_local_linear_id() / get_subgroup_size_config();
 }
 
 HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_get_num_subgroups() {
-  auto wg_size = __acpp_sscp_get_local_size_x() *
-                 __acpp_sscp_get_local_size_y() *
-                 __acpp_sscp_get_local_size_z();
-  return wg_size;
+  __acpp_uint32 size = get_subgroup_size_config();
+  return (get_local_linear_size() + size - 1) / size;
+}
+
+#define HIPSYCL_HOST_SUBGROUP_INTEGER_BUILTINS(int_size)                       \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int##int_size                         \
+      __acpp_sscp_sub_group_broadcast_i##int_size(__acpp_int32 sender,         \
+                                                  __acpp_int##int_size x) {    \
+    return select_lane(x, sender);                                             \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int##int_size                         \
+      __acpp_sscp_sub_group_shl_i##int_size(__acpp_int##int_size value,        \
+                                            __acpp_uint32 delta) {             \
+    return shift_left(value, delta);                                           \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int##int_size                         \
+      __acpp_sscp_sub_group_shr_i##int_size(__acpp_int##int_size value,        \
+                                            __acpp_uint32 delta) {             \
+    return shift_right(value, delta);                                          \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int##int_size                         \
+      __acpp_sscp_sub_group_permute_i##int_size(__acpp_int##int_size value,    \
+                                                __acpp_int32 mask) {           \
+    return permute(value, mask);                                               \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int##int_size                         \
+      __acpp_sscp_sub_group_select_i##int_size(__acpp_int##int_size value,     \
+                                               __acpp_int32 id) {              \
+    return select_lane(value, id);                                             \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int##int_size                         \
+      __acpp_sscp_sub_group_reduce_i##int_size(__acpp_sscp_algorithm_op op,    \
+                                               __acpp_int##int_size x) {       \
+    return reduce_op(op, x);                                                   \
+  }                                                                            \
+  HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint##int_size                        \
+      __acpp_sscp_sub_group_reduce_u##int_size(__acpp_sscp_algorithm_op op,    \
+                                               __acpp_uint##int_size x) {      \
+    return reduce_op(op, x);                                                   \
+  }
+
+HIPSYCL_HOST_SUBGROUP_INTEGER_BUILTINS(8)
+HIPSYCL_HOST_SUBGROUP_INTEGER_BUILTINS(16)
+HIPSYCL_HOST_SUBGROUP_INTEGER_BUILTINS(32)
+HIPSYCL_HOST_SUBGROUP_INTEGER_BUILTINS(64)
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f16
+__acpp_sscp_sub_group_reduce_f16(__acpp_sscp_algorithm_op op, __acpp_f16 x) {
+  // Accumulate in single precision
+  return hipsycl::fp16::create(
+      reduce_op(op, hipsycl::fp16::promote_to_float(x)));
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f32
+__acpp_sscp_sub_group_reduce_f32(__acpp_sscp_algorithm_op op, __acpp_f32 x) {
+  return reduce_op(op, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_f64
+__acpp_sscp_sub_group_reduce_f64(__acpp_sscp_algorithm_op op, __acpp_f64 x) {
+  return reduce_op(op, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN bool __acpp_sscp_sub_group_any(bool pred) {
+  return reduce_op(__acpp_sscp_algorithm_op::logical_or,
+                        static_cast<__acpp_int32>(pred));
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN bool __acpp_sscp_sub_group_all(bool pred) {
+  return reduce_op(__acpp_sscp_algorithm_op::logical_and,
+                        static_cast<__acpp_int32>(pred));
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN bool __acpp_sscp_sub_group_none(bool pred) {
+  return !__acpp_sscp_sub_group_any(pred);
 }
@@ -0,0 +1,54 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/async_copy.hpp"
+
+// cp.async requires sm_80. __nvvm_reflect is resolved at JIT time, so
+// the inline assembly is removed for older devices.
+static __attribute__((always_inline)) bool has_cp_async() {
+  return __nvvm_reflect("__CUDA_ARCH") >= 800;
+}
+
+#define HIPSYCL_PTX_CP_ASYNC(size)                                             \
+  asm volatile("cp.async.ca.shared.global [%0], [%1], " #size ";"             \
+               :                                                               \
+               : "r"(shared_address), "l"(src)                                 \
+               : "memory")
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_async_copy_global_to_local(void *dest, const void *src,
+                                       __acpp_uint32 size) {
+  if(!has_cp_async()) {
+    __builtin_memcpy(dest, src, size);
+    return;
+  }
+
+  __acpp_uint64 generic_address = reinterpret_cast<__acpp_uint64>(dest);
+  __acpp_uint64 address;
+  asm("cvta.to.shared.u64 %0, %1;" : "=l"(address) : "l"(generic_address));
+  __acpp_uint32 shared_address = static_cast<__acpp_uint32>(address);
+
+  if(size == 16)
+    HIPSYCL_PTX_CP_ASYNC(16);
+  else if(size == 8)
+    HIPSYCL_PTX_CP_ASYNC(8);
+  else
+    HIPSYCL_PTX_CP_ASYNC(4);
+}
+
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_async_copy_commit() {
+  if(has_cp_async())
+    asm volatile("cp.async.commit_group;" ::: "memory");
+}
+
+HIPSYCL_SSCP_BUILTIN void __acpp_sscp_async_copy_wait() {
+  if(has_cp_async())
+    asm volatile("cp.async.wait_all;" ::: "memory");
+}
@@ -1284,3 +1284,123 @@ HIPSYCL_SSCP_BUILTIN __acpp_f64 __acpp_sscp_atomic_fetch_max_f64(
 }
 
 
+
+// Sub-group aggregated atomics
+
+namespace {
+
+// Like bar.warp.sync, these instructions require ptx 60 or newer,
+// so we cannot use the clang builtins without ptx feature flags.
+__attribute__((always_inline)) __acpp_uint32 active_mask() {
+  __acpp_uint32 mask;
+  asm volatile("activemask.b32 %0;" : "=r"(mask));
+  return mask;
+}
+
+__attribute__((always_inline)) __acpp_uint32 lane_id() {
+  __acpp_uint32 id;
+  asm("mov.u32 %0, %%laneid;" : "=r"(id));
+  return id;
+}
+
+// Returns the mask of lanes in mask whose value equals the value of this lane
+__attribute__((always_inline)) __acpp_uint32 match_any(__acpp_uint64 x,
+                                                       __acpp_uint32 mask) {
+  __acpp_uint32 result;
+  asm volatile("match.any.sync.b64 %0, %1, %2;"
+               : "=r"(result)
+               : "l"(x), "r"(mask));
+  return result;
+}
+
+__attribute__((always_inline)) __acpp_uint32
+shuffle_idx(__acpp_uint32 x, __acpp_uint32 source, __acpp_uint32 mask) {
+  __acpp_uint32 result;
+  asm volatile("shfl.sync.idx.b32 %0, %1, %2, 0x1f, %3;"
+               : "=r"(result)
+               : "r"(x), "r"(source), "r"(mask));
+  return result;
+}
+
+__attribute__((always_inline)) __acpp_uint64
+shuffle_idx(__acpp_uint64 x, __acpp_uint32 source, __acpp_uint32 mask) {
+  __acpp_uint64 low = shuffle_idx(static_cast<__acpp_uint32>(x), source, mask);
+  __acpp_uint64 high =
+      shuffle_idx(static_cast<__acpp_uint32>(x >> 32), source, mask);
+  return (high << 32) | low;
+}
+
+// Computes the atomic addition of all active work items of the warp that
+// target the same address with a single atomic operation by the lowest of
+// these work items. Unsigned types are used since they provide the same
+// wrap-around results as signed additions.
+template <class T, class AtomicAdd>
+__attribute__((always_inline)) T
+aggregated_fetch_add(T *ptr, T x, AtomicAdd atomic_add) {
+  // match.any.sync requires sm_70 or newer
+  if (__nvvm_reflect("__CUDA_ARCH") < 700)
+    return atomic_add(ptr, x);
+
+  __acpp_uint32 lane = lane_id();
+  __acpp_uint32 peers =
+      match_any(reinterpret_cast<__acpp_uint64>(ptr), active_mask());
+  __acpp_uint32 leader = __builtin_ctz(peers);
+  __acpp_uint32 lower_peers = peers & ((1u << lane) - 1);
+
+  T total = 0;
+  T offset = 0;
+  if (match_any(static_cast<__acpp_uint64>(x), peers) == peers) {
+    // All peers add the same value, as in counters and histograms
+    total = x * static_cast<T>(__builtin_popcount(peers));
+    offset = x * static_cast<T>(__builtin_popcount(lower_peers));
+  } else {
+    // All peers iterate over the same lanes, so the shuffles are converged
+    for (__acpp_uint32 remaining = peers; remaining != 0;
+         remaining &= remaining - 1) {
+      __acpp_uint32 source = __builtin_ctz(remaining);
+      T value = shuffle_idx(x, source, peers);
+      total += value;
+      if (source < lane)
+        offset += value;
+    }
+  }
+
+  T old = 0;
+  if (lane == leader)
+    old = atomic_add(ptr, total);
+  return shuffle_idx(old, leader, peers) + offset;
+}
+
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint32 __acpp_sscp_atomic_fetch_add_aggregated_u32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint32 *ptr, __acpp_uint32 x) {
+  return aggregated_fetch_add(ptr, x, [&](__acpp_uint32 *p, __acpp_uint32 v) {
+    return __acpp_sscp_atomic_fetch_add_u32(as, order, scope, p, v);
+  });
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint64 __acpp_sscp_atomic_fetch_add_aggregated_u64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint64 *ptr, __acpp_uint64 x) {
+  return aggregated_fetch_add(ptr, x, [&](__acpp_uint64 *p, __acpp_uint64 v) {
+    return __acpp_sscp_atomic_fetch_add_u64(as, order, scope, p, v);
+  });
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int32 __acpp_sscp_atomic_fetch_add_aggregated_i32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int32 *ptr, __acpp_int32 x) {
+  return static_cast<__acpp_int32>(__acpp_sscp_atomic_fetch_add_aggregated_u32(
+      as, order, scope, reinterpret_cast<__acpp_uint32 *>(ptr),
+      static_cast<__acpp_uint32>(x)));
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int64 __acpp_sscp_atomic_fetch_add_aggregated_i64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int64 *ptr, __acpp_int64 x) {
+  return static_cast<__acpp_int64>(__acpp_sscp_atomic_fetch_add_aggregated_u64(
+      as, order, scope, reinterpret_cast<__acpp_uint64 *>(ptr),
+      static_cast<__acpp_uint64>(x)));
+}
@@ -9,6 +9,7 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/sycl/libkernel/sscp/builtins/barrier.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/core.hpp"
 
 HIPSYCL_SSCP_CONVERGENT_BUILTIN void
 __acpp_sscp_work_group_barrier(__acpp_sscp_memory_scope fence_scope,
@@ -40,3 +41,39 @@ __acpp_sscp_sub_group_barrier(__acpp_sscp_memory_scope fence_scope,
   // TODO: Disable this line if ptx < 60
   asm("bar.warp.sync -1;");
 }
+
+// State of grid barriers. All work groups of a cooperative launch pass through
+// the same grid barriers, so the arrival counter is reset to zero when the
+// kernel completes. The generation is only compared for changes and may wrap.
+static __acpp_uint32 __acpp_grid_barrier_arrived = 0;
+static __acpp_uint32 __acpp_grid_barrier_generation = 0;
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_grid_barrier() {
+  __syncthreads();
+
+  if(__acpp_sscp_get_local_id_x() == 0 && __acpp_sscp_get_local_id_y() == 0 &&
+     __acpp_sscp_get_local_id_z() == 0) {
+    __acpp_uint32 num_groups = __acpp_sscp_get_num_groups_x() *
+                               __acpp_sscp_get_num_groups_y() *
+                               __acpp_sscp_get_num_groups_z();
+    // Must be read before arriving, since the last work group to arrive
+    // increments the generation.
+    __acpp_uint32 generation =
+        __atomic_load_n(&__acpp_grid_barrier_generation, __ATOMIC_ACQUIRE);
+
+    __nvvm_membar_gl();
+    if(__atomic_fetch_add(&__acpp_grid_barrier_arrived, 1, __ATOMIC_ACQ_REL) ==
+       num_groups - 1) {
+      __atomic_store_n(&__acpp_grid_barrier_arrived, 0, __ATOMIC_RELAXED);
+      __atomic_fetch_add(&__acpp_grid_barrier_generation, 1, __ATOMIC_RELEASE);
+    } else {
+      while(__atomic_load_n(&__acpp_grid_barrier_generation,
+                            __ATOMIC_ACQUIRE) == generation)
+        ;
+    }
+    __nvvm_membar_gl();
+  }
+
+  __syncthreads();
+}
@@ -0,0 +1,37 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/device_heap.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/device_heap_generic.hpp"
+
+using atomics = __acpp_sscp_device_heap_builtin_atomics;
+
+HIPSYCL_SSCP_BUILTIN void *
+__acpp_sscp_device_heap_malloc(__acpp_sscp_device_heap *heap,
+                               __acpp_uint64 size) {
+  return __acpp_sscp_device_heap_generic_malloc<atomics>(
+      heap, size, [](__acpp_uint64 *ptr, __acpp_uint64 x) {
+        return atomics::fetch_add(ptr, x);
+      });
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void *
+__acpp_sscp_sub_group_device_heap_malloc(__acpp_sscp_device_heap *heap,
+                                         __acpp_uint64 size) {
+  return __acpp_sscp_device_heap_generic_malloc<atomics>(
+      heap, size, [](__acpp_uint64 *ptr, __acpp_uint64 x) {
+        return atomics::fetch_add_aggregated(ptr, x);
+      });
+}
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_device_heap_free(__acpp_sscp_device_heap *heap, void *ptr) {
+  __acpp_sscp_device_heap_generic_free<atomics>(heap, ptr);
+}
@@ -48,6 +48,33 @@ HIPSYCL_SSCP_BUILTIN __acpp_f16 __acpp_sscp_half_div(__acpp_f16 a,
       hipsycl::fp16::promote_to_float(a), hipsycl::fp16::promote_to_float(b)));
 }
 
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_add(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  __acpp_uint32 result;
+  asm("{add.f16x2 %0,%1,%2;\n}"
+    : "=r"(result)
+    : "r"(a),"r"(b));
+  return result;
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_sub(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  __acpp_uint32 result;
+  asm("{sub.f16x2 %0,%1,%2;\n}"
+    : "=r"(result)
+    : "r"(a),"r"(b));
+  return result;
+}
+
+HIPSYCL_SSCP_BUILTIN __acpp_uint32 __acpp_sscp_half2_mul(__acpp_uint32 a,
+                                                        __acpp_uint32 b) {
+  __acpp_uint32 result;
+  asm("{mul.f16x2 %0,%1,%2;\n}"
+    : "=r"(result)
+    : "r"(a),"r"(b));
+  return result;
+}
+
 HIPSYCL_SSCP_BUILTIN bool __acpp_sscp_half_lt(__acpp_f16 a, __acpp_f16 b) {
   __acpp_uint16 v;
   asm( "{ .reg .pred __$temp3;\n"
@@ -0,0 +1,180 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/subgroup.hpp"
+
+// The wmma instructions require sm_70. The nvvm reflection of the
+// architecture is resolved at JIT time.
+static __attribute__((always_inline)) bool has_wmma() {
+  return __nvvm_reflect("__CUDA_ARCH") >= 700;
+}
+
+#define HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS(constraint, f)                       \
+  constraint(f[0]), constraint(f[1]), constraint(f[2]), constraint(f[3]),      \
+      constraint(f[4]), constraint(f[5]), constraint(f[6]), constraint(f[7])
+
+#define HIPSYCL_PTX_WMMA_LOAD_F16(matrix, layout)                              \
+  asm volatile("wmma.load." #matrix ".sync.aligned." #layout                  \
+               ".m16n16k16.f16 {%0, %1, %2, %3, %4, %5, %6, %7}, [%8], %9;"    \
+               : HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS("=r", frag)                 \
+               : "l"(ptr), "r"(static_cast<__acpp_uint32>(stride))            \
+               : "memory")
+
+#define HIPSYCL_PTX_WMMA_LOAD_F32(layout)                                      \
+  asm volatile("wmma.load.c.sync.aligned." #layout                            \
+               ".m16n16k16.f32 {%0, %1, %2, %3, %4, %5, %6, %7}, [%8], %9;"    \
+               : HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS("=f", values)               \
+               : "l"(ptr), "r"(static_cast<__acpp_uint32>(stride))            \
+               : "memory")
+
+#define HIPSYCL_PTX_WMMA_STORE_F32(layout)                                     \
+  asm volatile("wmma.store.d.sync.aligned." #layout                           \
+               ".m16n16k16.f32 [%0], {%1, %2, %3, %4, %5, %6, %7, %8}, %9;"    \
+               :                                                               \
+               : "l"(ptr), HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS("f", values),     \
+                 "r"(static_cast<__acpp_uint32>(stride))                      \
+               : "memory")
+
+#define HIPSYCL_PTX_WMMA_MMA(a_layout, b_layout)                               \
+  asm volatile("wmma.mma.sync.aligned." #a_layout "." #b_layout               \
+               ".m16n16k16.f32.f32 "                                           \
+               "{%0, %1, %2, %3, %4, %5, %6, %7}, "                            \
+               "{%8, %9, %10, %11, %12, %13, %14, %15}, "                      \
+               "{%16, %17, %18, %19, %20, %21, %22, %23}, "                    \
+               "{%24, %25, %26, %27, %28, %29, %30, %31};"                     \
+               : HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS("=f", d_values)             \
+               : HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS("r", a),                    \
+                 HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS("r", b),                    \
+                 HIPSYCL_PTX_WMMA_FRAGMENT_OPERANDS("f", c_values))
+
+namespace {
+
+// Native fragments of all matrices consist of 8 registers
+constexpr int num_native_fragment_words = 8;
+
+__attribute__((always_inline)) void
+load_accumulator_values(const __acpp_uint32 *frag, float *values) {
+  for (int i = 0; i < num_native_fragment_words; ++i)
+    values[i] = __acpp_sscp_matrix_generic_word_to_float(frag[i]);
+}
+
+__attribute__((always_inline)) void
+store_accumulator_values(const float *values, __acpp_uint32 *frag) {
+  for (int i = 0; i < num_native_fragment_words; ++i)
+    frag[i] = __acpp_sscp_matrix_generic_float_to_word(values[i]);
+}
+
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_a_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  if (!has_wmma()) {
+    __acpp_sscp_matrix_generic_load_ab(frag, ptr, stride, layout);
+    return;
+  }
+  if (layout == __acpp_sscp_matrix_layout::row_major)
+    HIPSYCL_PTX_WMMA_LOAD_F16(a, row);
+  else
+    HIPSYCL_PTX_WMMA_LOAD_F16(a, col);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_b_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  if (!has_wmma()) {
+    __acpp_sscp_matrix_generic_load_ab(frag, ptr, stride, layout);
+    return;
+  }
+  if (layout == __acpp_sscp_matrix_layout::row_major)
+    HIPSYCL_PTX_WMMA_LOAD_F16(b, row);
+  else
+    HIPSYCL_PTX_WMMA_LOAD_F16(b, col);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f32 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  if (!has_wmma()) {
+    __acpp_sscp_matrix_generic_load_c(frag, ptr, stride, layout,
+                                      __acpp_sscp_get_subgroup_local_id(),
+                                      __acpp_sscp_get_subgroup_size());
+    return;
+  }
+  float values[num_native_fragment_words];
+  if (layout == __acpp_sscp_matrix_layout::row_major)
+    HIPSYCL_PTX_WMMA_LOAD_F32(row);
+  else
+    HIPSYCL_PTX_WMMA_LOAD_F32(col);
+  store_accumulator_values(values, frag);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_store_c_f32_m16n16k16(const __acpp_uint32 *frag,
+                                         __acpp_f32 *ptr,
+                                         __acpp_uint64 stride,
+                                         __acpp_sscp_matrix_layout layout) {
+  if (!has_wmma()) {
+    __acpp_sscp_matrix_generic_store_c(frag, ptr, stride, layout,
+                                       __acpp_sscp_get_subgroup_local_id(),
+                                       __acpp_sscp_get_subgroup_size());
+    return;
+  }
+  float values[num_native_fragment_words];
+  load_accumulator_values(frag, values);
+  if (layout == __acpp_sscp_matrix_layout::row_major)
+    HIPSYCL_PTX_WMMA_STORE_F32(row);
+  else
+    HIPSYCL_PTX_WMMA_STORE_F32(col);
+}
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_matrix_fill_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        __acpp_f32 value) {
+  // All elements are equal, so the distribution of native
+  // fragments across the warp does not matter.
+  __acpp_sscp_matrix_generic_fill_c(frag, value);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_mad_f32_f16_m16n16k16(
+    __acpp_uint32 *d, const __acpp_uint32 *a,
+    __acpp_sscp_matrix_layout a_layout, const __acpp_uint32 *b,
+    __acpp_sscp_matrix_layout b_layout, const __acpp_uint32 *c) {
+  if (!has_wmma()) {
+    __acpp_sscp_matrix_generic_mad(d, a, b, c,
+                                   __acpp_sscp_get_subgroup_local_id(),
+                                   __acpp_sscp_get_subgroup_size());
+    return;
+  }
+  float c_values[num_native_fragment_words];
+  float d_values[num_native_fragment_words];
+  load_accumulator_values(c, c_values);
+
+  constexpr auto row = __acpp_sscp_matrix_layout::row_major;
+  if (a_layout == row && b_layout == row)
+    HIPSYCL_PTX_WMMA_MMA(row, row);
+  else if (a_layout == row)
+    HIPSYCL_PTX_WMMA_MMA(row, col);
+  else if (b_layout == row)
+    HIPSYCL_PTX_WMMA_MMA(col, row);
+  else
+    HIPSYCL_PTX_WMMA_MMA(col, col);
+
+  store_accumulator_values(d_values, d);
+}
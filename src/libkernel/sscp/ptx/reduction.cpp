@@ -0,0 +1,150 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/reduction.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/reduction_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/localmem.hpp"
+
+#include <type_traits>
+
+namespace {
+
+// One element per warp of the largest possible block
+__acpp_sscp_local __attribute__((loader_uninitialized))
+__acpp_uint64 reduction_buffer[32];
+
+// Like bar.warp.sync, the shfl.sync and redux.sync builtins require
+// ptx versions which we cannot check for at this point.
+__attribute__((always_inline)) __acpp_uint32 active_mask() {
+  __acpp_uint32 mask;
+  asm volatile("activemask.b32 %0;" : "=r"(mask));
+  return mask;
+}
+
+__attribute__((always_inline)) __acpp_uint32 shuffle_xor(__acpp_uint32 x,
+                                                         __acpp_uint32 mask) {
+  __acpp_uint32 result;
+  asm volatile("shfl.sync.bfly.b32 %0, %1, %2, 0x1f, %3;"
+               : "=r"(result)
+               : "r"(x), "r"(mask), "r"(active_mask()));
+  return result;
+}
+
+__attribute__((always_inline)) __acpp_uint32 shuffle_down(__acpp_uint32 x,
+                                                          __acpp_uint32 delta) {
+  __acpp_uint32 result;
+  asm volatile("shfl.sync.down.b32 %0, %1, %2, 0x1f, %3;"
+               : "=r"(result)
+               : "r"(x), "r"(delta), "r"(active_mask()));
+  return result;
+}
+
+__attribute__((always_inline)) __acpp_uint32 shuffle_idx(__acpp_uint32 x,
+                                                         __acpp_uint32 lane) {
+  __acpp_uint32 result;
+  asm volatile("shfl.sync.idx.b32 %0, %1, %2, 0x1f, %3;"
+               : "=r"(result)
+               : "r"(x), "r"(lane), "r"(active_mask()));
+  return result;
+}
+
+#define HIPSYCL_PTX_REDUX(op, type, x)                                         \
+  {                                                                            \
+    __acpp_uint32 result;                                                      \
+    asm volatile("redux.sync." op "." type " %0, %1, %2;"                      \
+                 : "=r"(result)                                                \
+                 : "r"(x), "r"(active_mask()));                                \
+    return result;                                                             \
+  }
+
+// sm_80 provides single-instruction warp reductions for 32 bit integers.
+// The nvvm reflection of the architecture is resolved at JIT time.
+__attribute__((always_inline)) bool has_redux(__acpp_sscp_algorithm_op op) {
+  return __nvvm_reflect("__CUDA_ARCH") >= 800 &&
+         op != __acpp_sscp_algorithm_op::multiply;
+}
+
+template <bool IsSigned>
+__attribute__((always_inline)) __acpp_uint32
+redux(__acpp_sscp_algorithm_op op, __acpp_uint32 x) {
+  switch (op) {
+  case __acpp_sscp_algorithm_op::plus:
+    HIPSYCL_PTX_REDUX("add", "u32", x)
+  case __acpp_sscp_algorithm_op::min:
+    if constexpr (IsSigned)
+      HIPSYCL_PTX_REDUX("min", "s32", x)
+    else
+      HIPSYCL_PTX_REDUX("min", "u32", x)
+  case __acpp_sscp_algorithm_op::max:
+    if constexpr (IsSigned)
+      HIPSYCL_PTX_REDUX("max", "s32", x)
+    else
+      HIPSYCL_PTX_REDUX("max", "u32", x)
+  case __acpp_sscp_algorithm_op::bit_and:
+    HIPSYCL_PTX_REDUX("and", "b32", x)
+  case __acpp_sscp_algorithm_op::bit_or:
+    HIPSYCL_PTX_REDUX("or", "b32", x)
+  case __acpp_sscp_algorithm_op::bit_xor:
+    HIPSYCL_PTX_REDUX("xor", "b32", x)
+  case __acpp_sscp_algorithm_op::logical_and:
+    HIPSYCL_PTX_REDUX("and", "b32", static_cast<__acpp_uint32>(x != 0))
+  case __acpp_sscp_algorithm_op::logical_or:
+    HIPSYCL_PTX_REDUX("or", "b32", static_cast<__acpp_uint32>(x != 0))
+  default:
+    return x;
+  }
+}
+
+template <class T>
+__attribute__((always_inline)) T sub_group_reduce(__acpp_sscp_algorithm_op op,
+                                                  T x) {
+  if constexpr (std::is_integral_v<T> && sizeof(T) <= 4) {
+    if (has_redux(op)) {
+      // Sign or zero extension preserves the results of all operations
+      // after truncation
+      using extended_t =
+          std::conditional_t<std::is_signed_v<T>, __acpp_int32, __acpp_uint32>;
+      return static_cast<T>(redux<std::is_signed_v<T>>(
+          op, static_cast<__acpp_uint32>(static_cast<extended_t>(x))));
+    }
+  }
+
+  __acpp_uint32 size = __acpp_sscp_get_subgroup_size();
+  if (size == 32) {
+    // Butterfly reduction, after which all work items have the result
+    for (__acpp_uint32 mask = 16; mask > 0; mask /= 2)
+      x = __acpp_sscp_apply_algorithm_op(
+          op, x, __acpp_sscp_shuffle(x, mask, shuffle_xor));
+    return x;
+  }
+
+  // Incomplete warps must not combine values of non-existing work items
+  __acpp_uint32 lid = __acpp_sscp_get_subgroup_local_id();
+  for (__acpp_uint32 delta = 16; delta > 0; delta /= 2) {
+    T other = __acpp_sscp_shuffle(x, delta, shuffle_down);
+    if (lid + delta < size)
+      x = __acpp_sscp_apply_algorithm_op(op, x, other);
+  }
+  return __acpp_sscp_shuffle(x, 0, shuffle_idx);
+}
+
+template <class T>
+__attribute__((always_inline)) T work_group_reduce(__acpp_sscp_algorithm_op op,
+                                                   T x) {
+  return __acpp_sscp_work_group_reduce_from_sub_groups(
+      op, x,
+      reinterpret_cast<__attribute__((address_space(3))) T *>(
+          &reduction_buffer[0]),
+      [](__acpp_sscp_algorithm_op op, T x) { return sub_group_reduce(op, x); });
+}
+
+}
+
+HIPSYCL_SSCP_DEFINE_ALL_REDUCTION_BUILTINS()
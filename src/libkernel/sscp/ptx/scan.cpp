@@ -0,0 +1,57 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/localmem.hpp"
+
+namespace {
+
+// One element per warp of the largest possible block
+__acpp_sscp_local __attribute__((loader_uninitialized))
+__acpp_uint64 scan_buffer[32];
+
+// Like bar.warp.sync, the shfl.sync builtins require ptx 60 or newer,
+// which we cannot check for at this point.
+__attribute__((always_inline)) __acpp_uint32 active_mask() {
+  __acpp_uint32 mask;
+  asm volatile("activemask.b32 %0;" : "=r"(mask));
+  return mask;
+}
+
+__attribute__((always_inline)) __acpp_uint32 shuffle_up(__acpp_uint32 x,
+                                                        __acpp_uint32 delta) {
+  __acpp_uint32 result;
+  asm volatile("shfl.sync.up.b32 %0, %1, %2, 0, %3;"
+               : "=r"(result)
+               : "r"(x), "r"(delta), "r"(active_mask()));
+  return result;
+}
+
+template <class T>
+__attribute__((always_inline)) T sub_group_scan(__acpp_sscp_algorithm_op op,
+                                                T x, bool inclusive) {
+  return __acpp_sscp_sub_group_shuffle_scan(op, x, inclusive, shuffle_up);
+}
+
+template <class T>
+__attribute__((always_inline)) T work_group_scan(__acpp_sscp_algorithm_op op,
+                                                 T x, bool inclusive) {
+  return __acpp_sscp_work_group_scan_from_sub_groups(
+      op, x, inclusive,
+      reinterpret_cast<__attribute__((address_space(3))) T *>(&scan_buffer[0]),
+      [](__acpp_sscp_algorithm_op op, T x, bool inclusive) {
+        return sub_group_scan(op, x, inclusive);
+      });
+}
+
+}
+
+HIPSYCL_SSCP_DEFINE_ALL_SCAN_BUILTINS()
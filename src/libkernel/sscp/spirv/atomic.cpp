@@ -738,3 +738,29 @@ HIPSYCL_SSCP_BUILTIN __acpp_f64 __acpp_sscp_atomic_fetch_max_f64(
   ADDRESS_SPACE_SWITCH(as, ptr, RETURN_ATOMIC_FMAX);
 }
 
+
+// Additions are not combined on this backend
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int32 __acpp_sscp_atomic_fetch_add_aggregated_i32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int32 *ptr, __acpp_int32 x) {
+  return __acpp_sscp_atomic_fetch_add_i32(as, order, scope, ptr, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_int64 __acpp_sscp_atomic_fetch_add_aggregated_i64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_int64 *ptr, __acpp_int64 x) {
+  return __acpp_sscp_atomic_fetch_add_i64(as, order, scope, ptr, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint32 __acpp_sscp_atomic_fetch_add_aggregated_u32(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint32 *ptr, __acpp_uint32 x) {
+  return __acpp_sscp_atomic_fetch_add_u32(as, order, scope, ptr, x);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN __acpp_uint64 __acpp_sscp_atomic_fetch_add_aggregated_u64(
+    __acpp_sscp_address_space as, __acpp_sscp_memory_order order,
+    __acpp_sscp_memory_scope scope, __acpp_uint64 *ptr, __acpp_uint64 x) {
+  return __acpp_sscp_atomic_fetch_add_u64(as, order, scope, ptr, x);
+}
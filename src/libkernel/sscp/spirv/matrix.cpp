@@ -0,0 +1,65 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/matrix_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/subgroup.hpp"
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_a_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  __acpp_sscp_matrix_generic_load_ab(frag, ptr, stride, layout);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_b_f16_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f16 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  __acpp_sscp_matrix_generic_load_ab(frag, ptr, stride, layout);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_load_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        const __acpp_f32 *ptr,
+                                        __acpp_uint64 stride,
+                                        __acpp_sscp_matrix_layout layout) {
+  __acpp_sscp_matrix_generic_load_c(frag, ptr, stride, layout,
+                                    __acpp_sscp_get_subgroup_local_id(),
+                                    __acpp_sscp_get_subgroup_size());
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_store_c_f32_m16n16k16(const __acpp_uint32 *frag,
+                                         __acpp_f32 *ptr,
+                                         __acpp_uint64 stride,
+                                         __acpp_sscp_matrix_layout layout) {
+  __acpp_sscp_matrix_generic_store_c(frag, ptr, stride, layout,
+                                     __acpp_sscp_get_subgroup_local_id(),
+                                     __acpp_sscp_get_subgroup_size());
+}
+
+HIPSYCL_SSCP_BUILTIN void
+__acpp_sscp_matrix_fill_c_f32_m16n16k16(__acpp_uint32 *frag,
+                                        __acpp_f32 value) {
+  __acpp_sscp_matrix_generic_fill_c(frag, value);
+}
+
+HIPSYCL_SSCP_CONVERGENT_BUILTIN void
+__acpp_sscp_matrix_mad_f32_f16_m16n16k16(
+    __acpp_uint32 *d, const __acpp_uint32 *a,
+    __acpp_sscp_matrix_layout a_layout, const __acpp_uint32 *b,
+    __acpp_sscp_matrix_layout b_layout, const __acpp_uint32 *c) {
+  __acpp_sscp_matrix_generic_mad(d, a, b, c,
+                                 __acpp_sscp_get_subgroup_local_id(),
+                                 __acpp_sscp_get_subgroup_size());
+}
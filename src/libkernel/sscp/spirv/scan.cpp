@@ -0,0 +1,122 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/scan_generic.hpp"
+#include "hipSYCL/sycl/libkernel/sscp/builtins/spirv/spirv_common.hpp"
+
+#include <type_traits>
+
+#define HIPSYCL_SPIRV_DECLARE_GROUP_OP(name, type)                             \
+  __attribute__((convergent)) type name(__spv::ScopeFlag scope,                \
+                                        __spv::GroupOperation operation,       \
+                                        type x);
+
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupIAdd, __acpp_int32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupIAdd, __acpp_int64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupIAdd, __acpp_uint32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupIAdd, __acpp_uint64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupFAdd, __acpp_f32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupFAdd, __acpp_f64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupSMin, __acpp_int32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupSMin, __acpp_int64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupUMin, __acpp_uint32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupUMin, __acpp_uint64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupFMin, __acpp_f32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupFMin, __acpp_f64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupSMax, __acpp_int32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupSMax, __acpp_int64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupUMax, __acpp_uint32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupUMax, __acpp_uint64)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupFMax, __acpp_f32)
+HIPSYCL_SPIRV_DECLARE_GROUP_OP(__spirv_GroupFMax, __acpp_f64)
+
+// Provided by SPV_INTEL_subgroups
+__attribute__((convergent)) __acpp_uint32
+__spirv_SubgroupShuffleUpINTEL(__acpp_uint32 previous, __acpp_uint32 current,
+                               __acpp_uint32 delta);
+
+namespace {
+
+// One element per sub-group, sufficient for work groups of 2048 work items
+// with a sub-group size of 8.
+__spirv_local __attribute__((loader_uninitialized))
+__acpp_uint64 scan_buffer[256];
+
+__attribute__((always_inline)) __acpp_uint32 shuffle_up(__acpp_uint32 x,
+                                                        __acpp_uint32 delta) {
+  return __spirv_SubgroupShuffleUpINTEL(x, x, delta);
+}
+
+// The group instructions of the Groups capability support only these
+// operations; others would require SPV_KHR_uniform_group_instructions.
+template <class T>
+__attribute__((always_inline)) bool
+has_native_scan(__acpp_sscp_algorithm_op op) {
+  return sizeof(T) >= 4 && (op == __acpp_sscp_algorithm_op::plus ||
+                            op == __acpp_sscp_algorithm_op::min ||
+                            op == __acpp_sscp_algorithm_op::max);
+}
+
+template <class T>
+__attribute__((always_inline)) T native_scan(__spv::ScopeFlag scope,
+                                             __acpp_sscp_algorithm_op op, T x,
+                                             bool inclusive) {
+  __spv::GroupOperation operation = inclusive
+                                        ? __spv::GroupOperation::InclusiveScan
+                                        : __spv::GroupOperation::ExclusiveScan;
+  if constexpr (sizeof(T) >= 4) {
+    if (op == __acpp_sscp_algorithm_op::plus) {
+      if constexpr (std::is_floating_point_v<T>)
+        return __spirv_GroupFAdd(scope, operation, x);
+      else
+        return __spirv_GroupIAdd(scope, operation, x);
+    } else if (op == __acpp_sscp_algorithm_op::min) {
+      if constexpr (std::is_floating_point_v<T>)
+        return __spirv_GroupFMin(scope, operation, x);
+      else if constexpr (std::is_signed_v<T>)
+        return __spirv_GroupSMin(scope, operation, x);
+      else
+        return __spirv_GroupUMin(scope, operation, x);
+    } else if (op == __acpp_sscp_algorithm_op::max) {
+      if constexpr (std::is_floating_point_v<T>)
+        return __spirv_GroupFMax(scope, operation, x);
+      else if constexpr (std::is_signed_v<T>)
+        return __spirv_GroupSMax(scope, operation, x);
+      else
+        return __spirv_GroupUMax(scope, operation, x);
+    }
+  }
+  return x;
+}
+
+template <class T>
+__attribute__((always_inline)) T sub_group_scan(__acpp_sscp_algorithm_op op,
+                                                T x, bool inclusive) {
+  if (has_native_scan<T>(op))
+    return native_scan(__spv::ScopeFlag::Subgroup, op, x, inclusive);
+  return __acpp_sscp_sub_group_shuffle_scan(op, x, inclusive, shuffle_up);
+}
+
+template <class T>
+__attribute__((always_inline)) T work_group_scan(__acpp_sscp_algorithm_op op,
+                                                 T x, bool inclusive) {
+  if (has_native_scan<T>(op))
+    return native_scan(__spv::ScopeFlag::Workgroup, op, x, inclusive);
+  return __acpp_sscp_work_group_scan_from_sub_groups(
+      op, x, inclusive, reinterpret_cast<__spirv_local T *>(&scan_buffer[0]),
+      [](__acpp_sscp_algorithm_op op, T x, bool inclusive) {
+        return sub_group_scan(op, x, inclusive);
+      });
+}
+
+}
+
+HIPSYCL_SSCP_DEFINE_ALL_SCAN_BUILTINS()
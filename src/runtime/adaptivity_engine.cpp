@@ -15,8 +15,15 @@
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/glue/llvm-sscp/jit.hpp"
 #include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
 #include "hipSYCL/common/filesystem.hpp"
+#include <algorithm>
+#include <atomic>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 
 namespace hipsycl {
@@ -33,6 +40,34 @@ void access_appdb(common::db::appdb& db, bool needs_write_access, F&& handler) {
   }
 }
 
+// Pointer arguments are only specialized on alignments in this range
+constexpr uint64_t min_specialized_pointer_alignment = 16;
+constexpr uint64_t max_specialized_pointer_alignment = 256;
+// Integer arguments are only specialized on being multiples of powers of two
+// in this range.
+constexpr uint64_t min_specialized_divisor_log2 = 2;
+constexpr uint64_t max_specialized_divisor_log2 = 8;
+
+// Returns the smallest of a few coarse upper bounds that value is below, or 0.
+// Coarse bounds avoid recompiling each time the largest observed value grows.
+uint64_t get_specialized_upper_bound(uint64_t value) {
+  for(uint64_t bound : {1ull << 16, 1ull << 31})
+    if(value < bound)
+      return bound;
+  return 0;
+}
+
+uint64_t count_trailing_zeros(uint64_t value) {
+  if(value == 0)
+    return 64;
+  uint64_t result = 0;
+  while((value & 1) == 0) {
+    value >>= 1;
+    ++result;
+  }
+  return result;
+}
+
 bool has_annotation(const hcf_kernel_info *info, int param_index,
                     hcf_kernel_info::annotation_type annotation) {
   for(auto a : info->get_known_annotations(param_index)) {
@@ -91,6 +126,7 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
       if (can_use_fraction_of_all_invocations &&
           (fraction_of_all_invocations > relative_specialization_threshold)) {
         is_already_specialized = true;
+        runtime_statistics::get().add(statistic::iads_specializations);
         return true;
       } else
         return false;
@@ -151,6 +187,288 @@ bool is_likely_invariant_argument(common::db::kernel_entry &kernel_entry,
 
   return false;
 }
+
+class iads_statistics_shard;
+
+// The shards of all threads, shared between the registry and the shards.
+// Shards keep it alive, so that threads terminating while or after the
+// registry is destroyed at static destruction time never lock a destroyed
+// mutex. All members are protected by mutex.
+struct iads_statistics_shard_list {
+  std::mutex mutex;
+  std::vector<iads_statistics_shard*> shards;
+  // Cleared before the registry flushes the shards at shutdown. Afterwards,
+  // shards must not touch the appdb anymore.
+  bool is_registry_alive = true;
+};
+
+// Keeps track of all per-thread IADS statistics shards, so that their
+// content can be written back to the appdb at shutdown.
+class iads_statistics_registry {
+public:
+  static iads_statistics_registry& get() {
+    static iads_statistics_registry r;
+    return r;
+  }
+
+  ~iads_statistics_registry();
+
+  std::shared_ptr<iads_statistics_shard_list> get_shard_list() const {
+    return _shard_list;
+  }
+
+  std::size_t get_content_version() const {
+    return _content_version;
+  }
+
+  std::size_t get_merge_interval() const {
+    return _merge_interval;
+  }
+private:
+  iads_statistics_registry()
+      : _shard_list{std::make_shared<iads_statistics_shard_list>()} {
+    // Make sure that persistent storage is constructed before us,
+    // and hence destroyed after we have flushed all shards.
+    auto& appdb =
+        common::filesystem::persistent_storage::get().get_this_app_db();
+    _content_version = appdb.get_content_version();
+    _merge_interval = application::get_settings()
+                          .get<setting::jitopt_iads_statistics_merge_interval>();
+  }
+
+  std::shared_ptr<iads_statistics_shard_list> _shard_list;
+  std::size_t _content_version;
+  std::size_t _merge_interval;
+};
+
+// Thread-local copy of the IADS statistics of all kernels that a thread has
+// submitted. Only the owning thread accesses a shard during submission,
+// so the lock is uncontended except while the registry flushes at shutdown.
+class iads_statistics_shard {
+public:
+  iads_statistics_shard()
+      : _shard_list{iads_statistics_registry::get().get_shard_list()} {
+    std::lock_guard<std::mutex> lock{_shard_list->mutex};
+    _shard_list->shards.push_back(this);
+  }
+
+  ~iads_statistics_shard() {
+    std::lock_guard<std::mutex> lock{_shard_list->mutex};
+    // Otherwise, the registry has already flushed us at shutdown
+    if(_shard_list->is_registry_alive) {
+      flush();
+      auto &shards = _shard_list->shards;
+      shards.erase(std::remove(shards.begin(), shards.end(), this),
+                   shards.end());
+    }
+  }
+
+  static iads_statistics_shard& get() {
+    static thread_local iads_statistics_shard shard;
+    return shard;
+  }
+
+  template<class F>
+  void access(const kernel_configuration::id_type& kernel_id, F&& handler) {
+    spin_lock lock{_lock};
+
+    auto it = _kernels.find(kernel_id);
+    if(it == _kernels.end()) {
+      local_kernel_statistics stats;
+      auto &appdb =
+          common::filesystem::persistent_storage::get().get_this_app_db();
+      appdb.read_entry<common::db::kernel_entry>(
+          kernel_id, [&](const common::db::kernel_entry *db_entry) {
+            if(db_entry)
+              stats.entry = *db_entry;
+          });
+      stats.snapshot = stats.entry;
+      it = _kernels.emplace(kernel_id, std::move(stats)).first;
+    }
+
+    auto& stats = it->second;
+    handler(stats.entry);
+
+    ++stats.pending_invocations;
+    if(stats.pending_invocations >=
+       iads_statistics_registry::get().get_merge_interval())
+      merge(kernel_id, stats);
+  }
+
+  void flush() {
+    spin_lock lock{_lock};
+    for(auto& entry : _kernels) {
+      if(entry.second.pending_invocations > 0)
+        merge(entry.first, entry.second);
+    }
+  }
+private:
+  struct local_kernel_statistics {
+    // Statistics as seen by this thread; used for specialization decisions
+    common::db::kernel_entry entry;
+    // State of the appdb entry when this thread last synchronized with it
+    common::db::kernel_entry snapshot;
+    std::size_t pending_invocations = 0;
+  };
+
+  void merge(const kernel_configuration::id_type &kernel_id,
+             local_kernel_statistics &stats) {
+    auto &appdb =
+        common::filesystem::persistent_storage::get().get_this_app_db();
+    appdb.read_write_entry<common::db::kernel_entry>(
+        kernel_id, [&](common::db::kernel_entry &db_entry) {
+          if (db_entry.num_registered_invocations ==
+              stats.snapshot.num_registered_invocations) {
+            // No other thread has contributed to this kernel since we last
+            // synchronized, so our local copy is exactly what the appdb would
+            // contain without buffering.
+            db_entry = stats.entry;
+          } else {
+            common::db::merge_kernel_entry_delta(db_entry, stats.snapshot,
+                                                 stats.entry);
+          }
+          // Pick up the statistics from other threads as well
+          stats.entry = db_entry;
+          stats.snapshot = db_entry;
+        });
+    stats.pending_invocations = 0;
+  }
+
+  struct spin_lock {
+    spin_lock(std::atomic<bool>& flag)
+    : _flag{flag} {
+      while(_flag.exchange(true, std::memory_order_acquire))
+        ;
+    }
+
+    ~spin_lock() {
+      _flag.store(false, std::memory_order_release);
+    }
+  private:
+    std::atomic<bool>& _flag;
+  };
+
+  std::shared_ptr<iads_statistics_shard_list> _shard_list;
+  std::atomic<bool> _lock{false};
+  std::unordered_map<kernel_configuration::id_type, local_kernel_statistics,
+                     kernel_id_hash>
+      _kernels;
+};
+
+iads_statistics_registry::~iads_statistics_registry() {
+  std::lock_guard<std::mutex> lock{_shard_list->mutex};
+  // Shards of threads terminating from now on must not flush themselves
+  // anymore, since the appdb is destroyed after us.
+  _shard_list->is_registry_alive = false;
+  for(auto* shard : _shard_list->shards)
+    shard->flush();
+  _shard_list->shards.clear();
+}
+
+// One header counter holding the number of branches,
+// and two counters for each of up to 1023 branches.
+constexpr std::size_t num_branch_profile_counters = 2047;
+
+// Tracks the branch counters of kernel configurations that are currently
+// being profiled in this process.
+class branch_profile_registry {
+public:
+  struct profile_state {
+    // Counters are never freed, since instrumented kernels
+    // might still be running or be launched from the kernel cache.
+    uint64_t* counters = nullptr;
+    std::size_t num_instrumented_invocations = 0;
+    bool is_complete = false;
+    std::vector<uint64_t> profile;
+  };
+
+  static branch_profile_registry& get() {
+    static branch_profile_registry r;
+    return r;
+  }
+
+  template<class F>
+  void access(const kernel_configuration::id_type& id, F&& handler) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    handler(_profiles[id]);
+  }
+private:
+  std::mutex _mutex;
+  std::unordered_map<kernel_configuration::id_type, profile_state,
+                     kernel_id_hash>
+      _profiles;
+};
+
+// Copies counters while instrumented kernels might still be running. This
+// is fine, since a profile only needs to be representative.
+std::vector<uint64_t> read_branch_profile(const uint64_t* counters) {
+  std::vector<uint64_t> profile(num_branch_profile_counters);
+  for(std::size_t i = 0; i < profile.size(); ++i)
+    profile[i] = static_cast<const volatile uint64_t*>(counters)[i];
+
+  // Trailing branches that were never executed do not need to be stored
+  std::size_t size = std::min(profile.size(), 1 + 2 * profile[0]);
+  while(size > 1 && profile[size - 1] == 0 && profile[size - 2] == 0)
+    size -= 2;
+  profile.resize(size);
+  return profile;
+}
+
+// Remembers the function call specialization configs that have been passed
+// to fcall_specialized_config kernel arguments in this process, such that
+// a single binary can dispatch between all of them. Configs are identified
+// by their address, which the binary compares against the kernel argument.
+class fcall_inline_cache_registry {
+public:
+  using candidate_list = std::vector<glue::sscp::fcall_inline_cache_candidate>;
+
+  static fcall_inline_cache_registry& get() {
+    static fcall_inline_cache_registry r;
+    return r;
+  }
+
+  // Adds config to the candidates of the kernel argument identified by key,
+  // unless max_candidates are known already, and returns all candidates.
+  candidate_list observe(const kernel_configuration::id_type &key,
+                         const glue::sscp::fcall_specialized_config *config,
+                         std::size_t max_candidates) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto& candidates = _candidates[key];
+    uint64_t selector = reinterpret_cast<uint64_t>(config);
+    for(auto& c : candidates) {
+      if(c.selector == selector) {
+        // The address has been reused for a different config
+        if(c.config->unique_hash != config->unique_hash)
+          c.config = std::make_shared<const glue::sscp::fcall_specialized_config>(*config);
+        return candidates;
+      }
+    }
+    if(candidates.size() < max_candidates)
+      candidates.push_back(glue::sscp::fcall_inline_cache_candidate{
+          selector, std::make_shared<const glue::sscp::fcall_specialized_config>(*config)});
+    return candidates;
+  }
+
+  // Returns a value that changes whenever the candidates of key change
+  uint64_t get_state(const kernel_configuration::id_type &key) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    common::stable_running_hash hash;
+    auto it = _candidates.find(key);
+    if(it != _candidates.end()) {
+      for(const auto& c : it->second) {
+        uint64_t data[2] = {c.selector, c.config->unique_hash};
+        hash(data, sizeof(data));
+      }
+    }
+    return hash.get_current_hash();
+  }
+private:
+  std::mutex _mutex;
+  std::unordered_map<kernel_configuration::id_type, candidate_list,
+                     kernel_id_hash>
+      _candidates;
+};
+
 }
 
 kernel_adaptivity_engine::kernel_adaptivity_engine(
@@ -158,21 +476,114 @@ kernel_adaptivity_engine::kernel_adaptivity_engine(
     const hcf_kernel_info *kernel_info,
     const glue::jit::cxx_argument_mapper &arg_mapper,
     const range<3> &num_groups, const range<3> &block_size, void **args,
-    std::size_t *arg_sizes, std::size_t num_args, std::size_t local_mem_size)
+    std::size_t *arg_sizes, std::size_t num_args, std::size_t local_mem_size,
+    backend_allocator *profile_allocator)
     : _hcf{hcf_object}, _kernel_name{backend_kernel_name},
       _kernel_info{kernel_info}, _arg_mapper{arg_mapper},
       _num_groups{num_groups}, _block_size{block_size}, _args{args},
       _arg_sizes{arg_sizes}, _num_args{num_args},
-      _local_mem_size(local_mem_size) {
+      _local_mem_size(local_mem_size), _profile_allocator{profile_allocator} {
 
   _adaptivity_level = application::get_settings().get<setting::adaptivity_level>();
 }
 
+std::optional<kernel_configuration::id_type>
+kernel_adaptivity_engine::get_launch_cache_id(
+    const kernel_configuration &initial_config) const {
+  if(_adaptivity_level > 1)
+    return {};
+
+  // This needs to cover all inputs of finalize_binary_configuration()
+  // at adaptivity level <= 1.
+  auto id = initial_config.generate_id();
+  kernel_configuration::extend_hash(
+      id, kernel_base_config_parameter::hcf_object_id, _hcf);
+  kernel_configuration::extend_hash(
+      id, kernel_base_config_parameter::single_kernel, _kernel_name);
+
+  for(int i = 0; i < _kernel_info->get_num_parameters(); ++i) {
+    std::size_t arg_size = _kernel_info->get_argument_size(i);
+    if (has_annotation(_kernel_info, i,
+                       hcf_kernel_info::annotation_type::fcall_specialized_config) &&
+        arg_size == sizeof(glue::sscp::fcall_config_kernel_property_t)) {
+      glue::sscp::fcall_config_kernel_property_t value;
+      std::memcpy(&value, _arg_mapper.get_mapped_args()[i], arg_size);
+      uint64_t key = static_cast<uint64_t>(i) | (1ull << 35);
+      kernel_configuration::extend_hash(id, key, value.value->unique_hash);
+      // Whether a dispatching binary is used depends on the address of the
+      // config and the previously observed configs
+      if(application::get_settings().get<setting::jitopt_fcall_inline_cache_size>() > 1) {
+        uint64_t selector_key = static_cast<uint64_t>(i) | (1ull << 42);
+        kernel_configuration::extend_hash(id, selector_key,
+                                          reinterpret_cast<uint64_t>(value.value));
+        uint64_t state_key = static_cast<uint64_t>(i) | (1ull << 43);
+        kernel_configuration::extend_hash(
+            id, state_key,
+            fcall_inline_cache_registry::get().get_state(get_fcall_inline_cache_key(i)));
+      }
+    }
+  }
+
+  if(_adaptivity_level > 0) {
+    kernel_configuration::extend_hash(
+        id, kernel_build_option::known_group_size_x, _block_size[0]);
+    kernel_configuration::extend_hash(
+        id, kernel_build_option::known_group_size_y, _block_size[1]);
+    kernel_configuration::extend_hash(
+        id, kernel_build_option::known_group_size_z, _block_size[2]);
+    kernel_configuration::extend_hash(
+        id, kernel_build_option::known_local_mem_size, _local_mem_size);
+
+    auto global_size = _num_groups * _block_size;
+    auto int_max = std::numeric_limits<int>::max();
+    bool global_sizes_fit_in_int =
+        global_size[0] * global_size[1] * global_size[2] < int_max;
+    kernel_configuration::extend_hash(
+        id, kernel_build_flag::global_sizes_fit_in_int, global_sizes_fit_in_int);
+
+    for(int i = 0; i < _kernel_info->get_num_parameters(); ++i) {
+      std::size_t arg_size = _kernel_info->get_argument_size(i);
+      if (has_annotation(_kernel_info, i,
+                         hcf_kernel_info::annotation_type::specialized) &&
+          arg_size <= sizeof(uint64_t)) {
+        uint64_t buffer_value = 0;
+        std::memcpy(&buffer_value, _arg_mapper.get_mapped_args()[i], arg_size);
+        uint64_t key = static_cast<uint64_t>(i) | (1ull << 34);
+        kernel_configuration::extend_hash(id, key, buffer_value);
+      }
+    }
+  }
+  return id;
+}
+
+kernel_configuration::id_type
+kernel_adaptivity_engine::get_fcall_inline_cache_key(int param_index) const {
+  kernel_configuration::id_type key = {};
+  kernel_configuration::extend_hash(
+      key, kernel_base_config_parameter::hcf_object_id, _hcf);
+  kernel_configuration::extend_hash(
+      key, kernel_base_config_parameter::single_kernel, _kernel_name);
+  kernel_configuration::extend_hash(key, static_cast<uint64_t>(param_index),
+                                    static_cast<uint64_t>(param_index));
+  return key;
+}
+
+hcf_object_id kernel_adaptivity_engine::get_code_identity() const {
+  // Only the kernel and its dependencies are compiled in the single-kernel
+  // code model, so the rest of the HCF object does not affect the binary.
+  if(_adaptivity_level > 0) {
+    if(auto content_hash = _kernel_info->get_content_hash())
+      return content_hash.value();
+  }
+  return _hcf;
+}
+
 kernel_configuration::id_type
 kernel_adaptivity_engine::finalize_binary_configuration(
     kernel_configuration &config) {
     
-  // At any adaptivity level need to handle function call specializations.
+  // At any adaptivity level need to handle function call specializations
+  // and kernels that request fast math.
   for (int i = 0; i < _kernel_info->get_num_parameters(); ++i) {
     auto &annotations = _kernel_info->get_known_annotations(i);
     std::size_t arg_size = _kernel_info->get_argument_size(i);
@@ -182,11 +593,32 @@ kernel_adaptivity_engine::finalize_binary_configuration(
           arg_size == sizeof(glue::sscp::fcall_config_kernel_property_t)) {
         glue::sscp::fcall_config_kernel_property_t value;
         std::memcpy(&value, _arg_mapper.get_mapped_args()[i], arg_size);
+
+        // If a few configs are used for this kernel, compile a single binary
+        // that dispatches between them instead of one binary per config.
+        std::size_t inline_cache_size =
+            application::get_settings().get<setting::jitopt_fcall_inline_cache_size>();
+        if(inline_cache_size > 1) {
+          auto candidates = fcall_inline_cache_registry::get().observe(
+              get_fcall_inline_cache_key(i), value.value, inline_cache_size);
+          uint64_t selector = reinterpret_cast<uint64_t>(value.value);
+          if (candidates.size() > 1 &&
+              std::any_of(candidates.begin(), candidates.end(),
+                          [&](const auto &c) { return c.selector == selector; })) {
+            config.set_function_call_inline_cache(i, candidates);
+            continue;
+          }
+        }
         config.set_function_call_specialization_config(i, value);
+      } else if (annotation == hcf_kernel_info::annotation_type::fast_math) {
+        config.set_build_flag(kernel_build_flag::fast_math);
       }
     }
   }
 
+  if (application::get_settings().get<setting::jitopt_performance_remarks>())
+    config.set_build_flag(kernel_build_flag::performance_remarks);
+
   if(_adaptivity_level > 0) {
     // Enter single-kernel code model
     config.append_base_configuration(
@@ -210,6 +642,19 @@ kernel_adaptivity_engine::finalize_binary_configuration(
     config.set_build_option(kernel_build_option::known_local_mem_size,
                             _local_mem_size);
 
+    // Local memory tiling relies on the known group size
+    if (application::get_settings().get<setting::jitopt_local_memory_tiling>() &&
+        _block_size[1] == 1 && _block_size[2] == 1)
+      config.set_build_flag(kernel_build_flag::local_memory_tiling);
+
+    if (application::get_settings().get<setting::jitopt_aggregate_atomics>())
+      config.set_build_flag(kernel_build_flag::aggregate_atomics);
+
+    // Local memory padding relies on the known group and local memory size
+    if (application::get_settings().get<setting::jitopt_local_memory_padding>() &&
+        _block_size[1] == 1 && _block_size[2] == 1)
+      config.set_build_flag(kernel_build_flag::local_memory_padding);
+
     // Handle kernel parameter optimization hints
     for(int i = 0; i < _kernel_info->get_num_parameters(); ++i) {
       std::size_t arg_size = _kernel_info->get_argument_size(i);
@@ -225,37 +670,149 @@ kernel_adaptivity_engine::finalize_binary_configuration(
   
   if(_adaptivity_level > 1) {
     auto base_id = config.generate_id();
+    const bool remember_fallback_config =
+        application::get_settings().get<setting::async_jit_threads>() > 0;
+    const std::size_t tier_up_threshold =
+        application::get_settings()
+            .get<setting::jitopt_tiered_compilation_threshold>();
+    // Configuration without IADS, which is the basis for tier-0 binaries
+    std::optional<kernel_configuration> base_config;
+    if(tier_up_threshold > 0)
+      base_config = config;
+    uint64_t num_invocations = 0;
+    bool uses_tier0_binary = false;
+    const bool use_pointer_noalias =
+        application::get_settings().get<setting::jitopt_iads_pointer_noalias>();
+    const bool use_value_ranges =
+        application::get_settings().get<setting::jitopt_iads_value_ranges>();
+
+    auto remember_fallback = [&]() {
+      if(remember_fallback_config && !_fallback_config.has_value()) {
+        _fallback_config = config;
+        _fallback_config_id = base_id;
+      }
+    };
     
     // Automatic application of specialization constants by detecting
     // invariant kernel arguments
-    auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
-    appdb.read_write_access([&](common::db::appdb_data& data){
+    auto process_kernel_entry = [&](common::db::kernel_entry &kernel_entry,
+                                    std::size_t content_version) {
       
-      auto& kernel_entry = data.kernels[base_id];
       if (kernel_entry.first_iads_invocation_run ==
           common::db::kernel_entry::no_usage) {
-        kernel_entry.first_iads_invocation_run = data.content_version;
+        kernel_entry.first_iads_invocation_run = content_version;
       }
+      if(kernel_entry.kernel_name.empty())
+        kernel_entry.kernel_name = _kernel_name;
       ++kernel_entry.num_registered_invocations;
+      num_invocations = kernel_entry.num_registered_invocations;
 
       std::size_t num_kernel_args = _kernel_info->get_num_parameters();
       if(kernel_entry.kernel_args.size() != num_kernel_args)
         kernel_entry.kernel_args.resize(num_kernel_args);
 
+      auto get_pointer_arg = [&](int i) -> uint64_t {
+        if (_kernel_info->get_argument_type(i) !=
+                hcf_kernel_info::argument_type::pointer ||
+            _kernel_info->get_argument_size(i) != sizeof(uint64_t))
+          return 0;
+        uint64_t ptr = 0;
+        std::memcpy(&ptr, _arg_mapper.get_mapped_args()[i], sizeof(uint64_t));
+        return ptr;
+      };
+
+      // Pointer values change frequently, but their alignment and whether
+      // they alias with other arguments are usually stable.
+      auto process_pointer_arg = [&](int i, uint64_t ptr) {
+        auto& arg_entry = kernel_entry.kernel_args[i];
+
+        uint64_t alignment =
+            std::min(ptr & (~ptr + 1), max_specialized_pointer_alignment);
+        if (arg_entry.min_pointer_alignment == 0 ||
+            alignment < arg_entry.min_pointer_alignment)
+          arg_entry.min_pointer_alignment = alignment;
+        bool specialize_alignment =
+            arg_entry.min_pointer_alignment >= min_specialized_pointer_alignment;
+
+        bool specialize_noalias = false;
+        if(use_pointer_noalias) {
+          for(int j = 0; j < num_kernel_args; ++j) {
+            if(j != i && get_pointer_arg(j) == ptr)
+              arg_entry.has_aliased = true;
+          }
+          specialize_noalias = !arg_entry.has_aliased;
+        }
+
+        if(specialize_alignment || specialize_noalias)
+          remember_fallback();
+        if(specialize_alignment) {
+          HIPSYCL_DEBUG_INFO << "adaptivity_engine: Kernel argument " << i
+                             << " is aligned to "
+                             << arg_entry.min_pointer_alignment
+                             << " bytes, specializing." << std::endl;
+          config.set_kernel_pointer_argument_alignment(
+              i, arg_entry.min_pointer_alignment);
+        }
+        if(specialize_noalias) {
+          HIPSYCL_DEBUG_INFO << "adaptivity_engine: Kernel argument " << i
+                             << " does not alias, specializing." << std::endl;
+          config.set_kernel_pointer_argument_noalias(i);
+        }
+      };
+
+      // Arguments that vary can still have stable bounds and divisibility.
+      auto process_value_range = [&](int i, uint64_t value) {
+        auto& arg_entry = kernel_entry.kernel_args[i];
+        arg_entry.max_value = std::max(arg_entry.max_value, value);
+        arg_entry.min_trailing_zeros =
+            std::min(arg_entry.min_trailing_zeros, count_trailing_zeros(value));
+
+        uint64_t upper_bound = get_specialized_upper_bound(arg_entry.max_value);
+        uint64_t divisor_log2 =
+            std::min(arg_entry.min_trailing_zeros, max_specialized_divisor_log2);
+
+        if(upper_bound != 0 || divisor_log2 >= min_specialized_divisor_log2)
+          remember_fallback();
+        if(upper_bound != 0) {
+          HIPSYCL_DEBUG_INFO << "adaptivity_engine: Kernel argument " << i
+                             << " is below " << upper_bound << ", specializing."
+                             << std::endl;
+          config.set_kernel_argument_upper_bound(i, upper_bound);
+        }
+        if(divisor_log2 >= min_specialized_divisor_log2) {
+          HIPSYCL_DEBUG_INFO << "adaptivity_engine: Kernel argument " << i
+                             << " is a multiple of " << (1ull << divisor_log2)
+                             << ", specializing." << std::endl;
+          config.set_kernel_argument_divisor(i, 1ull << divisor_log2);
+        }
+      };
+
       auto process_kernel_arg = [&](int i) {
+        if(uint64_t ptr = get_pointer_arg(i)) {
+          process_pointer_arg(i, ptr);
+          return;
+        }
+
         uint64_t arg_value = 0;
         std::memcpy(&arg_value, _arg_mapper.get_mapped_args()[i],
                     _kernel_info->get_argument_size(i));
         if (_kernel_info->get_argument_type(i) !=
                 hcf_kernel_info::argument_type::pointer &&
-            is_likely_invariant_argument(kernel_entry, i, data.content_version,
+            is_likely_invariant_argument(kernel_entry, i, content_version,
                                          arg_value) &&
             !has_annotation(_kernel_info, i,
                             hcf_kernel_info::annotation_type::specialized)) {
           HIPSYCL_DEBUG_INFO << "adaptivity_engine: Kernel argument " << i
                              << " is invariant or common, specializing."
                              << std::endl;
+          remember_fallback();
           config.set_specialized_kernel_argument(i, arg_value);
+        } else if (use_value_ranges &&
+                   _kernel_info->get_argument_type(i) !=
+                       hcf_kernel_info::argument_type::pointer &&
+                   !has_annotation(_kernel_info, i,
+                                   hcf_kernel_info::annotation_type::specialized)) {
+          process_value_range(i, arg_value);
         } else {
           HIPSYCL_DEBUG_INFO << "adaptivity_engine: Not specializing kernel argument " << i
                              << std::endl;
@@ -271,12 +828,142 @@ kernel_adaptivity_engine::finalize_binary_configuration(
           process_kernel_arg(i);
         }
       }
-    });
+    };
+
+    if(application::get_settings().get<setting::jitopt_iads_statistics_merge_interval>() > 0) {
+      // Operate on thread-local statistics, which are merged into the
+      // appdb in batches.
+      std::size_t content_version =
+          iads_statistics_registry::get().get_content_version();
+      iads_statistics_shard::get().access(
+          base_id, [&](common::db::kernel_entry &kernel_entry) {
+            process_kernel_entry(kernel_entry, content_version);
+          });
+    } else {
+      auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+      appdb.read_write_entry<common::db::kernel_entry>(
+          base_id, [&](common::db::kernel_entry &kernel_entry) {
+            process_kernel_entry(kernel_entry, appdb.get_content_version());
+          });
+    }
+
+    if(base_config.has_value()) {
+      // Tiered compilation: Kernels that have not been invoked often enough
+      // use a cheaply optimized binary without IADS. Once they become hot,
+      // the fully optimized binary replaces it, and the tier-0 binary serves
+      // as fallback while the former is compiled in the background.
+      kernel_configuration tier0_config = base_config.value();
+      tier0_config.set_build_flag(kernel_build_flag::fast_compile);
+
+      if(num_invocations < tier_up_threshold) {
+        uses_tier0_binary = true;
+        HIPSYCL_DEBUG_INFO << "adaptivity_engine: Using tier-0 binary for kernel "
+                           << _kernel_name << " (" << num_invocations << "/"
+                           << tier_up_threshold << " invocations)" << std::endl;
+        config = tier0_config;
+        _fallback_config.reset();
+      } else if(remember_fallback_config) {
+        _fallback_config_id = tier0_config.generate_id();
+        _fallback_config = std::move(tier0_config);
+      }
+    }
+
+    if(_adaptivity_level > 3 && _profile_allocator && !uses_tier0_binary)
+      apply_branch_profile(config, remember_fallback_config);
   }
 
   return config.generate_id();
 }
 
+void kernel_adaptivity_engine::apply_branch_profile(
+    kernel_configuration &config, bool remember_fallback_config) {
+  const std::size_t num_profiled_invocations =
+      application::get_settings().get<setting::jitopt_pgo_profiled_invocations>();
+  if(num_profiled_invocations == 0)
+    return;
+
+  // Profiles are specific to the IR that was instrumented, so they are
+  // associated with the fully specialized configuration.
+  auto profile_id = config.generate_id();
+
+  auto& appdb = common::filesystem::persistent_storage::get().get_this_app_db();
+  std::vector<uint64_t> profile;
+  appdb.read_entry<common::db::branch_profile_entry>(
+      profile_id, [&](const common::db::branch_profile_entry *entry) {
+        if(entry)
+          profile = entry->counters;
+      });
+
+  if(profile.empty()) {
+    uint64_t* instrumentation_counters = nullptr;
+    bool has_completed_profile = false;
+    std::size_t num_invocations = 0;
+
+    branch_profile_registry::get().access(
+        profile_id, [&](branch_profile_registry::profile_state &state) {
+          if(state.is_complete) {
+            profile = state.profile;
+            return;
+          }
+          if(!state.counters) {
+            std::size_t size = num_branch_profile_counters * sizeof(uint64_t);
+            state.counters = static_cast<uint64_t *>(
+                _profile_allocator->allocate_optimized_host(sizeof(uint64_t),
+                                                            size));
+            if(!state.counters) {
+              HIPSYCL_DEBUG_WARNING << "adaptivity_engine: Could not allocate "
+                                       "branch profile counters"
+                                    << std::endl;
+              state.is_complete = true;
+              return;
+            }
+            std::memset(state.counters, 0, size);
+          }
+          // Keep profiling if no instrumented kernel has run yet, e.g.
+          // because the binary has been compiled asynchronously.
+          if (state.num_instrumented_invocations < num_profiled_invocations ||
+              static_cast<volatile uint64_t *>(state.counters)[0] == 0) {
+            ++state.num_instrumented_invocations;
+            instrumentation_counters = state.counters;
+            return;
+          }
+          state.profile = read_branch_profile(state.counters);
+          state.is_complete = true;
+          profile = state.profile;
+          num_invocations = state.num_instrumented_invocations;
+          has_completed_profile = true;
+        });
+
+    if(instrumentation_counters) {
+      HIPSYCL_DEBUG_INFO << "adaptivity_engine: Using instrumented binary to "
+                            "profile branches of kernel "
+                         << _kernel_name << std::endl;
+      config.set_branch_profile_counters(
+          reinterpret_cast<uint64_t>(instrumentation_counters),
+          num_branch_profile_counters);
+      return;
+    }
+
+    if(has_completed_profile) {
+      appdb.read_write_entry<common::db::branch_profile_entry>(
+          profile_id, [&](common::db::branch_profile_entry &entry) {
+            entry.counters = profile;
+            entry.num_profiled_invocations = num_invocations;
+          });
+    }
+  }
+
+  if(!profile.empty()) {
+    HIPSYCL_DEBUG_INFO << "adaptivity_engine: Applying branch profile to kernel "
+                       << _kernel_name << std::endl;
+    if(remember_fallback_config && !_fallback_config.has_value()) {
+      _fallback_config = config;
+      _fallback_config_id = profile_id;
+    }
+    config.set_branch_profile(profile);
+  }
+}
+
 std::string kernel_adaptivity_engine::select_image_and_kernels(
     std::vector<std::string> *kernel_names_out) {
   if(_adaptivity_level > 0) {
@@ -0,0 +1,237 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/allocation_tracker.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/async_errors.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace hipsycl {
+namespace rt {
+
+void buffer_allocation_tracker::register_use(
+    const std::shared_ptr<buffer_data_region> &region, device_id dev) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  entry &e = _entries[region.get()];
+  // The address may have been reused by a new data region
+  if(e.region.lock() != region) {
+    e.region = region;
+    e.uses.clear();
+  }
+
+  const uint64_t use = ++_use_counter;
+  for(auto &u : e.uses) {
+    if(u.dev == dev) {
+      u.last_use = use;
+      return;
+    }
+  }
+  e.uses.push_back(device_use{dev, use});
+}
+
+void buffer_allocation_tracker::unregister(const buffer_data_region *region,
+                                           device_id dev) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _entries.find(region);
+  if(it == _entries.end())
+    return;
+
+  auto &uses = it->second.uses;
+  uses.erase(std::remove_if(uses.begin(), uses.end(),
+                            [&](const device_use &u) { return u.dev == dev; }),
+             uses.end());
+  if(uses.empty())
+    _entries.erase(it);
+}
+
+std::vector<std::shared_ptr<buffer_data_region>>
+buffer_allocation_tracker::get_eviction_candidates(
+    device_id dev, const buffer_data_region *excluded) {
+  std::vector<std::pair<uint64_t, std::shared_ptr<buffer_data_region>>>
+      candidates;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    for(auto it = _entries.begin(); it != _entries.end();) {
+      auto region = it->second.region.lock();
+      if(!region) {
+        it = _entries.erase(it);
+        continue;
+      }
+      if(region.get() != excluded) {
+        for(const auto &u : it->second.uses)
+          if(u.dev == dev)
+            candidates.push_back(std::make_pair(u.last_use, region));
+      }
+      ++it;
+    }
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+
+  std::vector<std::shared_ptr<buffer_data_region>> result;
+  for(auto &c : candidates)
+    result.push_back(std::move(c.second));
+  return result;
+}
+
+class buffer_allocation_cache::caching_allocator : public backend_allocator {
+public:
+  caching_allocator(backend_allocator *backend_alloc,
+                    std::atomic<std::size_t> &cached_size,
+                    std::size_t max_cached_size)
+      : _backend_alloc{backend_alloc}, _cached_size{cached_size},
+        _max_cached_size{max_cached_size} {}
+
+  ~caching_allocator() {
+    purge();
+  }
+
+  void *allocate(size_t min_alignment, size_t size_bytes) override {
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      // Do not waste more than half of a reused allocation
+      for(auto it = _idle.lower_bound(size_bytes);
+          it != _idle.end() && it->first <= 2 * size_bytes; ++it) {
+        if(min_alignment == 0 ||
+           reinterpret_cast<std::uintptr_t>(it->second) % min_alignment == 0) {
+          void *ptr = it->second;
+          _live[ptr] = it->first;
+          _cached_size -= it->first;
+          _idle.erase(it);
+          runtime_statistics::get().add(statistic::reused_buffer_allocations);
+          return ptr;
+        }
+      }
+    }
+
+    const std::size_t num_errors = application::errors().num_errors();
+    void *ptr = _backend_alloc->allocate(min_alignment, size_bytes);
+    if(!ptr && purge() > 0) {
+      ptr = _backend_alloc->allocate(min_alignment, size_bytes);
+      if(ptr)
+        application::errors().remove_errors_after(
+            num_errors, error_type::memory_allocation_error);
+    }
+
+    if(ptr) {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _live[ptr] = size_bytes;
+    }
+    return ptr;
+  }
+
+  void free(void *mem) override {
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto it = _live.find(mem);
+      if(it != _live.end()) {
+        std::size_t size = it->second;
+        _live.erase(it);
+        if(_cached_size.fetch_add(size) + size <= _max_cached_size) {
+          _idle.emplace(size, mem);
+          return;
+        }
+        _cached_size -= size;
+      }
+    }
+    _backend_alloc->free(mem);
+  }
+
+  void *allocate_optimized_host(size_t min_alignment, size_t bytes) override {
+    return _backend_alloc->allocate_optimized_host(min_alignment, bytes);
+  }
+
+  void *allocate_usm(size_t bytes) override {
+    return _backend_alloc->allocate_usm(bytes);
+  }
+
+  bool is_usm_accessible_from(backend_descriptor b) const override {
+    return _backend_alloc->is_usm_accessible_from(b);
+  }
+
+  result query_pointer(const void *ptr, pointer_info &out) const override {
+    return _backend_alloc->query_pointer(ptr, out);
+  }
+
+  result mem_advise(const void *addr, std::size_t num_bytes,
+                    int advise) const override {
+    return _backend_alloc->mem_advise(addr, num_bytes, advise);
+  }
+
+  result set_preferred_device_residency(const void *addr,
+                                        std::size_t num_bytes,
+                                        bool prefer_device) const override {
+    return _backend_alloc->set_preferred_device_residency(addr, num_bytes,
+                                                          prefer_device);
+  }
+
+  bool can_alias_host_memory(const void *ptr,
+                             size_t min_alignment) const override {
+    return _backend_alloc->can_alias_host_memory(ptr, min_alignment);
+  }
+
+private:
+  // Frees all idle allocations, and returns the number of freed allocations.
+  std::size_t purge() {
+    std::multimap<std::size_t, void *> idle;
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      idle.swap(_idle);
+    }
+    for(const auto &entry : idle) {
+      _cached_size -= entry.first;
+      _backend_alloc->free(entry.second);
+    }
+    if(!idle.empty()) {
+      HIPSYCL_DEBUG_INFO << "buffer_allocation_cache: Freed " << idle.size()
+                         << " idle allocations" << std::endl;
+    }
+    return idle.size();
+  }
+
+  backend_allocator *_backend_alloc;
+  std::atomic<std::size_t> &_cached_size;
+  std::size_t _max_cached_size;
+
+  std::mutex _mutex;
+  // Idle allocations by size
+  std::multimap<std::size_t, void *> _idle;
+  // Sizes of allocations that are in use
+  std::unordered_map<void *, std::size_t> _live;
+};
+
+buffer_allocation_cache::buffer_allocation_cache(std::size_t max_cached_size)
+    : _max_cached_size{max_cached_size} {}
+
+buffer_allocation_cache::~buffer_allocation_cache() = default;
+
+backend_allocator *
+buffer_allocation_cache::get_allocator(device_id dev,
+                                       backend_allocator *backend_alloc) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  for(const auto &entry : _allocators)
+    if(entry.first == dev)
+      return entry.second.get();
+
+  _allocators.emplace_back(
+      dev, std::make_unique<caching_allocator>(backend_alloc, _cached_size,
+                                               _max_cached_size));
+  return _allocators.back().second.get();
+}
+
+}
+}
@@ -9,18 +9,32 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/executor.hpp"
 #include "hipSYCL/runtime/hw_model/hw_model.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
 
 #include <algorithm>
+#include <cassert>
+#include <thread>
 
 namespace hipsycl {
 namespace rt {
 
+std::unique_ptr<backend_executor>
+backend::create_partitioned_inorder_executor(device_id dev, int priority,
+                                             std::size_t num_compute_units) {
+  HIPSYCL_DEBUG_WARNING << "backend: " << get_name()
+                        << " does not support partitioning devices, ignoring "
+                           "compute unit partition of "
+                        << num_compute_units << " compute units" << std::endl;
+  return create_inorder_executor(dev, priority);
+}
+
 backend_manager::backend_manager()
   : _hw_model(std::make_unique<hw_model>(this)),
     _kernel_cache{kernel_cache::get()}
@@ -28,21 +42,85 @@ backend_manager::backend_manager()
 
   _loader.query_backends();
 
+  _backends.resize(_loader.get_num_backends());
+  _backend_creation_flags =
+      std::vector<std::once_flag>(_loader.get_num_backends());
+
+  // The CPU backend is always needed, so there is no point in
+  // deferring its creation.
+  bool has_cpu_backend = false;
   for (std::size_t backend_index = 0;
        backend_index < _loader.get_num_backends(); ++backend_index) {
+    backend_id id;
+    if (_loader.get_backend_id(backend_index, id) && id == backend_id::omp) {
+      if (backend *b = get_or_create(backend_index))
+        has_cpu_backend =
+            b->get_hardware_platform() == hardware_platform::cpu;
+    }
+  }
+
+  if(!has_cpu_backend)
+  {
+    HIPSYCL_DEBUG_ERROR << "No CPU backend has been loaded. Terminating." << std::endl;
+    std::terminate();
+  }
+
+  if(application::get_settings().get<setting::jit_precompile>())
+    _kernel_cache->precompile_recorded_binaries();
+}
 
+backend_manager::~backend_manager()
+{
+  _kernel_cache->unload();
+}
+
+backend *backend_manager::get(backend_id id) const {
+  for (std::size_t i = 0; i < _backends.size(); ++i) {
+    backend_id plugin_id;
+    // Plugins for unknown backends need to be created to find out
+    // which backend they implement
+    if (!_loader.get_backend_id(i, plugin_id) || plugin_id == id) {
+      backend *b = get_or_create(i);
+      if (b && b->get_backend_descriptor().id == id)
+        return b;
+    }
+  }
+
+  register_error(
+      __acpp_here(),
+      error_info{"backend_manager: Requested backend is not available.",
+                 error_type::runtime_error});
+
+  return nullptr;
+}
+
+void backend_manager::create_all_backends() {
+  // Creating a backend initializes its runtime library and enumerates its
+  // devices, so pending backends are created concurrently.
+  std::vector<std::thread> creation_threads;
+  for (std::size_t i = 0; i < _backends.size(); ++i)
+    creation_threads.emplace_back([this, i]() { get_or_create(i); });
+  for (auto &t : creation_threads)
+    t.join();
+
+  _all_backends_created.store(true, std::memory_order_release);
+}
+
+backend *backend_manager::get_or_create(std::size_t index) const {
+  assert(index < _backends.size());
+
+  std::call_once(_backend_creation_flags[index], [this, index]() {
     HIPSYCL_DEBUG_INFO << "Registering backend: '"
-                       << _loader.get_backend_name(backend_index) << "'..."
+                       << _loader.get_backend_name(index) << "'..."
                        << std::endl;
-    backend *b = _loader.create(backend_index);
-    if (b) {
-      _backends.emplace_back(std::unique_ptr<backend>(b));
-    } else {
-      HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation failed" << std::endl;
+    backend *b = _loader.create(index);
+    if (!b) {
+      HIPSYCL_DEBUG_ERROR << "backend_manager: Backend creation failed"
+                          << std::endl;
+      return;
     }
-  }
-  
-  this->for_each_backend([](backend *b) {
+    _backends[index] = std::unique_ptr<backend>(b);
+
     HIPSYCL_DEBUG_INFO << "Discovered devices from backend '" << b->get_name()
                        << "': " << std::endl;
     backend_hardware_manager* hw_manager = b->get_hardware_manager();
@@ -58,37 +136,7 @@ backend_manager::backend_manager()
       }
     }
   });
-
-  if(std::none_of(_backends.cbegin(), _backends.cend(), 
-                  [](const std::unique_ptr<backend>& b){
-                    return b->get_hardware_platform() == hardware_platform::cpu;
-                    }))
-  {
-    HIPSYCL_DEBUG_ERROR << "No CPU backend has been loaded. Terminating." << std::endl;
-    std::terminate();
-  }
-}
-
-backend_manager::~backend_manager()
-{
-  _kernel_cache->unload();
-}
-
-backend *backend_manager::get(backend_id id) const {
-  auto it = std::find_if(_backends.begin(), _backends.end(),
-                         [id](const std::unique_ptr<backend> &b) -> bool {
-                           return b->get_backend_descriptor().id == id;
-                         });
-  
-  if(it == _backends.end()){
-    register_error(
-        __acpp_here(),
-        error_info{"backend_manager: Requested backend is not available.",
-                   error_type::runtime_error});
-
-    return nullptr;
-  }
-  return it->get();
+  return _backends[index].get();
 }
 
 hw_model &backend_manager::hardware_model()
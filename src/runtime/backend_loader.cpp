@@ -92,6 +92,40 @@ std::vector<fs::path> get_plugin_search_paths()
   return paths;
 }
 
+bool get_backend_id_from_name(const std::string &name,
+                              hipsycl::rt::backend_id &out) {
+  if(name == "cuda") {
+    out = hipsycl::rt::backend_id::cuda;
+  } else if(name == "hip") {
+    out = hipsycl::rt::backend_id::hip;
+  } else if(name == "ze") {
+    out = hipsycl::rt::backend_id::level_zero;
+  } else if(name == "ocl") {
+    out = hipsycl::rt::backend_id::ocl;
+  } else if(name == "omp") {
+    out = hipsycl::rt::backend_id::omp;
+  } else if(name == "remote") {
+    out = hipsycl::rt::backend_id::remote;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Extracts the backend name from plugin file names of the form
+// [lib]rt-backend-<name>.<ext>, so that plugins do not need to be
+// opened to find out which backend they implement.
+bool get_backend_name_from_filename(const fs::path &p, std::string &out) {
+  const std::string prefix = "rt-backend-";
+  std::string filename = p.stem().string();
+  if(filename.rfind("lib", 0) == 0)
+    filename = filename.substr(3);
+  if(filename.rfind(prefix, 0) != 0 || filename.size() == prefix.size())
+    return false;
+  out = filename.substr(prefix.size());
+  return true;
+}
+
 bool is_plugin_active(const std::string& name)
 {
   auto backends_active = hipsycl::rt::application::get_settings().get<hipsycl::rt::setting::visibility_mask>();
@@ -101,15 +135,8 @@ bool is_plugin_active(const std::string& name)
     return true;
 
   hipsycl::rt::backend_id id;
-  if(name == "cuda") {
-    id = hipsycl::rt::backend_id::cuda;
-  } else if(name == "hip") {
-    id = hipsycl::rt::backend_id::hip;
-  } else if(name == "ze") {
-    id = hipsycl::rt::backend_id::level_zero;
-  } else if(name == "ocl") {
-    id = hipsycl::rt::backend_id::ocl;
-  }
+  if(!get_backend_id_from_name(name, id))
+    return true;
   return backends_active.find(id) != backends_active.cend();
 }
 
@@ -146,13 +173,22 @@ void backend_loader::query_backends() {
         auto p = entry.path();
         if (p.extension().string() == shared_lib_extension) {
           std::string backend_name;
-          void *handle;
-          if (load_plugin(p.string(), handle, backend_name)) {
+          void *handle = nullptr;
+          if (get_backend_name_from_filename(p, backend_name)) {
+            // Opening the plugin is deferred until the backend is created,
+            // since this may already initialize the backend runtime libraries
+            if(!has_backend(backend_name) && is_plugin_active(backend_name)){
+              HIPSYCL_DEBUG_INFO << "backend_loader: Found plugin: " << p
+                                 << " for backend '" << backend_name << "'"
+                                 << std::endl;
+              _plugins.push_back(plugin{backend_name, p.string(), nullptr});
+            }
+          } else if (load_plugin(p.string(), handle, backend_name)) {
             if(!has_backend(backend_name) && is_plugin_active(backend_name)){
               HIPSYCL_DEBUG_INFO << "backend_loader: Successfully opened plugin: " << p
                                 << " for backend '" << backend_name << "'"
                                 << std::endl;
-              _handles.emplace_back(std::make_pair(backend_name, handle));
+              _plugins.push_back(plugin{backend_name, p.string(), handle});
             } else {
               close_library(handle, "backend_loader");
             }
@@ -164,38 +200,52 @@ void backend_loader::query_backends() {
 }
 
 backend_loader::~backend_loader() {
-  for (auto &handle : _handles) {
-    assert(handle.second);
-    close_library(handle.second, "backend_loader");
+  for (auto &p : _plugins) {
+    if(p.handle)
+      close_library(p.handle, "backend_loader");
   }
 }
 
-std::size_t backend_loader::get_num_backends() const { return _handles.size(); }
+std::size_t backend_loader::get_num_backends() const { return _plugins.size(); }
 
 std::string backend_loader::get_backend_name(std::size_t index) const {
-  assert(index < _handles.size());
-  return _handles[index].first;
+  assert(index < _plugins.size());
+  return _plugins[index].backend_name;
 }
 
 bool backend_loader::has_backend(const std::string &name) const {
-  for (const auto &h : _handles) {
-    if (h.first == name)
+  for (const auto &p : _plugins) {
+    if (p.backend_name == name)
       return true;
   }
 
   return false;
 }
 
+bool backend_loader::get_backend_id(std::size_t index, backend_id &out) const {
+  assert(index < _plugins.size());
+  return get_backend_id_from_name(_plugins[index].backend_name, out);
+}
+
 backend *backend_loader::create(std::size_t index) const {
-  assert(index < _handles.size());
-  
-  return create_backend(_handles[index].second);
+  assert(index < _plugins.size());
+  const plugin& p = _plugins[index];
+
+  if(!p.handle) {
+    std::string backend_name;
+    if(!load_plugin(p.path, p.handle, backend_name))
+      return nullptr;
+    HIPSYCL_DEBUG_INFO << "backend_loader: Successfully opened plugin: "
+                       << p.path << " for backend '" << backend_name << "'"
+                       << std::endl;
+  }
+  return create_backend(p.handle);
 }
 
 backend *backend_loader::create(const std::string &name) const {
   
-  for (std::size_t i = 0; i < _handles.size(); ++i) {
-    if (_handles[i].first == name)
+  for (std::size_t i = 0; i < _plugins.size(); ++i) {
+    if (_plugins[i].backend_name == name)
       return create(i);
   }
 
@@ -0,0 +1,169 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+#include "hipSYCL/runtime/completion_notifier.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr std::chrono::microseconds min_backoff{20};
+constexpr std::chrono::microseconds max_backoff{1000};
+
+}
+
+completion_notifier::completion_notifier()
+: _num_pending{0}, _continue{true} {}
+
+completion_notifier::~completion_notifier() {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _continue = false;
+  }
+  _condition.notify_one();
+  if(_thread.joinable())
+    _thread.join();
+}
+
+void completion_notifier::notify_on_completion(dag_node_ptr node,
+                                               callback cb) {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    start_thread();
+    ++_num_pending;
+  }
+
+  backend_executor* executor =
+      node->is_submitted() ? node->get_assigned_executor() : nullptr;
+  if(executor) {
+    auto *data = new backend_callback_data{
+        this, pending_notification{node, std::move(cb)}};
+    auto err = executor->register_completion_callback(
+        node, &completion_notifier::backend_callback, data);
+    if(err.is_success())
+      return;
+
+    HIPSYCL_DEBUG_INFO << "completion_notifier: Backend cannot signal "
+                          "completion of node "
+                       << node.get() << ", falling back to polling"
+                       << std::endl;
+    cb = std::move(data->notification.cb);
+    delete data;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _registered.push_back(pending_notification{std::move(node), std::move(cb)});
+  }
+  _condition.notify_one();
+}
+
+void completion_notifier::backend_callback(void *data) {
+  auto *callback_data = static_cast<backend_callback_data *>(data);
+  completion_notifier *notifier = callback_data->notifier;
+
+  callback_data->notification.node->mark_known_complete();
+  {
+    std::lock_guard<std::mutex> lock{notifier->_mutex};
+    // Moving the node ensures that it is not destroyed here, which
+    // could invoke backend API functions.
+    notifier->_signalled.push_back(std::move(callback_data->notification));
+  }
+  notifier->_condition.notify_one();
+  delete callback_data;
+}
+
+void completion_notifier::start_thread() {
+  if(!_thread.joinable()) {
+    HIPSYCL_DEBUG_INFO << "completion_notifier: Starting notifier thread"
+                       << std::endl;
+    _thread = std::thread{[this](){ work(); }};
+  }
+}
+
+std::size_t completion_notifier::get_num_pending() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _num_pending;
+}
+
+void completion_notifier::work() {
+  std::vector<pending_notification> observed;
+  std::vector<pending_notification> completed;
+  auto backoff = min_backoff;
+  bool made_progress = true;
+
+  while(true) {
+    bool is_shutting_down = false;
+    {
+      std::unique_lock<std::mutex> lock{_mutex};
+      auto has_new_work = [this]() {
+        return !_registered.empty() || !_signalled.empty();
+      };
+
+      if(observed.empty())
+        // Only callbacks that the backend will signal can remain
+        _condition.wait(lock, [&]() {
+          return has_new_work() || (!_continue && _num_pending == 0);
+        });
+      else if(!made_progress && _continue)
+        _condition.wait_for(lock, backoff,
+                            [&]() { return has_new_work() || !_continue; });
+
+      is_shutting_down = !_continue;
+      if(is_shutting_down && _num_pending == 0)
+        return;
+
+      if(!_registered.empty()) {
+        backoff = min_backoff;
+        std::move(_registered.begin(), _registered.end(),
+                  std::back_inserter(observed));
+        _registered.clear();
+      }
+      std::move(_signalled.begin(), _signalled.end(),
+                std::back_inserter(completed));
+      _signalled.clear();
+    }
+
+    // The runtime is going away, so there is no point in backing off.
+    if(is_shutting_down)
+      for(const auto& n : observed)
+        n.node->wait();
+
+    auto first_complete = std::stable_partition(
+        observed.begin(), observed.end(),
+        [](const pending_notification &n) { return !n.node->is_complete(); });
+    const bool has_observed_completion = first_complete != observed.end();
+    std::move(first_complete, observed.end(), std::back_inserter(completed));
+    observed.erase(first_complete, observed.end());
+
+    // Callbacks are invoked without holding the lock, such that they
+    // can register new callbacks.
+    for(auto& n : completed)
+      n.cb();
+
+    if(!completed.empty()) {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _num_pending -= completed.size();
+    }
+    completed.clear();
+
+    made_progress = has_observed_completion;
+    backoff = made_progress ? min_backoff : std::min(2 * backoff, max_backoff);
+  }
+}
+}
+}
@@ -13,18 +13,135 @@
 #include "hipSYCL/runtime/cuda/cuda_allocator.hpp"
 #include "hipSYCL/runtime/cuda/cuda_device_manager.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+
+#include <cstdint>
+#include <limits>
 
 namespace hipsycl {
 namespace rt {
 
 cuda_allocator::cuda_allocator(backend_descriptor desc, int cuda_device)
     : _backend_descriptor{desc}, _dev{cuda_device}
-{}
+{
+  if(application::get_settings().get<setting::stream_ordered_allocation>())
+    init_mem_pool();
+}
+
+cuda_allocator::~cuda_allocator() {
+  if(_allocation_stream) {
+    cuda_device_manager::get().activate_device(_dev);
+    cudaStreamSynchronize(_allocation_stream);
+    cudaStreamDestroy(_allocation_stream);
+  }
+#if CUDART_VERSION >= 11020
+  // If allocations are still outstanding, the pool is released
+  // once they are freed.
+  if(_mem_pool)
+    cudaMemPoolDestroy(_mem_pool);
+#endif
+}
+
+void cuda_allocator::init_mem_pool() {
+#if CUDART_VERSION >= 11020
+  cuda_device_manager::get().activate_device(_dev);
+
+  int supports_pools = 0;
+  cudaError_t err = cudaDeviceGetAttribute(
+      &supports_pools, cudaDevAttrMemoryPoolsSupported, _dev);
+  if(err != cudaSuccess || !supports_pools) {
+    HIPSYCL_DEBUG_WARNING << "cuda_allocator: Device " << _dev
+                          << " does not support memory pools, stream-ordered "
+                             "allocation will not be used."
+                          << std::endl;
+    return;
+  }
+
+  cudaMemPoolProps props{};
+  props.allocType = cudaMemAllocationTypePinned;
+  props.location.type = cudaMemLocationTypeDevice;
+  props.location.id = _dev;
+
+  cudaMemPool_t pool;
+  err = cudaMemPoolCreate(&pool, &props);
+  if(err != cudaSuccess) {
+    register_error(__acpp_here(),
+                   error_info{"cuda_allocator: cudaMemPoolCreate() failed",
+                              error_code{"CUDA", err}});
+    return;
+  }
+
+  std::size_t release_threshold_mib =
+      application::get_settings().get<setting::mem_pool_release_threshold>();
+  std::uint64_t release_threshold =
+      release_threshold_mib == 0
+          ? std::numeric_limits<std::uint64_t>::max()
+          : static_cast<std::uint64_t>(release_threshold_mib) * 1024 * 1024;
+  int opportunistic_reuse =
+      application::get_settings().get<setting::mem_pool_opportunistic_reuse>()
+          ? 1
+          : 0;
+
+  err = cudaMemPoolSetAttribute(pool, cudaMemPoolAttrReleaseThreshold,
+                                &release_threshold);
+  if(err == cudaSuccess)
+    err = cudaMemPoolSetAttribute(pool, cudaMemPoolReuseAllowOpportunistic,
+                                  &opportunistic_reuse);
+  if(err != cudaSuccess) {
+    register_error(__acpp_here(),
+                   error_info{"cuda_allocator: cudaMemPoolSetAttribute() failed",
+                              error_code{"CUDA", err}});
+    cudaMemPoolDestroy(pool);
+    return;
+  }
+
+  cudaStream_t stream;
+  err = cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking);
+  if(err != cudaSuccess) {
+    register_error(__acpp_here(),
+                   error_info{"cuda_allocator: cudaStreamCreateWithFlags() failed",
+                              error_code{"CUDA", err}});
+    cudaMemPoolDestroy(pool);
+    return;
+  }
+
+  _mem_pool = pool;
+  _allocation_stream = stream;
+#else
+  HIPSYCL_DEBUG_WARNING << "cuda_allocator: Stream-ordered allocation requires "
+                           "CUDA 11.2 or newer, ignoring request."
+                        << std::endl;
+#endif
+}
       
 void *cuda_allocator::allocate(size_t min_alignment, size_t size_bytes)
 {
   void *ptr;
   cuda_device_manager::get().activate_device(_dev);
+#if CUDART_VERSION >= 11020
+  if(_mem_pool) {
+    cudaError_t err = cudaMallocFromPoolAsync(&ptr, size_bytes, _mem_pool,
+                                              _allocation_stream);
+    // Allocations are only ordered w.r.t. the allocation stream, but might be
+    // used on any stream once we return.
+    if(err == cudaSuccess)
+      err = cudaStreamSynchronize(_allocation_stream);
+
+    if (err != cudaSuccess) {
+      register_error(__acpp_here(),
+                     error_info{"cuda_allocator: cudaMallocFromPoolAsync() failed",
+                                error_code{"CUDA", err},
+                                error_type::memory_allocation_error});
+      return nullptr;
+    }
+    runtime_statistics::get().register_allocation(
+        ptr, size_bytes, device_id{_backend_descriptor, _dev},
+        allocation_kind::device);
+    return ptr;
+  }
+#endif
   cudaError_t err = cudaMalloc(&ptr, size_bytes);
 
   if (err != cudaSuccess) {
@@ -35,6 +152,9 @@ void *cuda_allocator::allocate(size_t min_alignment, size_t size_bytes)
     return nullptr;
   }
 
+  runtime_statistics::get().register_allocation(
+      ptr, size_bytes, device_id{_backend_descriptor, _dev},
+      allocation_kind::device);
   return ptr;
 }
 
@@ -52,11 +172,14 @@ void *cuda_allocator::allocate_optimized_host(size_t min_alignment,
                               error_type::memory_allocation_error});
     return nullptr;
   }
+  runtime_statistics::get().register_allocation(
+      ptr, bytes, device_id{_backend_descriptor, _dev},
+      allocation_kind::optimized_host);
   return ptr;
 }
 
 void cuda_allocator::free(void *mem) {
-
+  runtime_statistics::get().register_deallocation(mem);
   pointer_info info;
   result query_result = query_pointer(mem, info);
 
@@ -68,6 +191,12 @@ void cuda_allocator::free(void *mem) {
   cudaError_t err;
   if (info.is_optimized_host)
     err = cudaFreeHost(mem);
+#if CUDART_VERSION >= 11020
+  // Memory is only freed once all preceding operations on the allocation
+  // stream have completed, and does not synchronize with the device.
+  else if (_mem_pool && !info.is_usm)
+    err = cudaFreeAsync(mem, _allocation_stream);
+#endif
   else
     err = cudaFree(mem);
   
@@ -93,6 +222,9 @@ void * cuda_allocator::allocate_usm(size_t bytes)
     return nullptr;
   }
 
+  runtime_statistics::get().register_allocation(
+      ptr, bytes, device_id{_backend_descriptor, _dev},
+      allocation_kind::shared);
   return ptr;
 }
 
@@ -157,5 +289,24 @@ result cuda_allocator::mem_advise(const void *addr, std::size_t num_bytes,
   return make_success();
 }
 
+result cuda_allocator::set_preferred_device_residency(const void *addr,
+                                                      std::size_t num_bytes,
+                                                      bool prefer_device) const {
+#ifndef _WIN32
+  cudaError_t err = cudaMemAdvise(
+      addr, num_bytes,
+      prefer_device ? cudaMemAdviseSetPreferredLocation
+                    : cudaMemAdviseUnsetPreferredLocation,
+      _dev);
+  if(err != cudaSuccess) {
+    return make_error(
+      __acpp_here(),
+      error_info{"cuda_allocator: cudaMemAdvise() failed", error_code{"CUDA", err}}
+    );
+  }
+#endif // _WIN32
+  return make_success();
+}
+
 }
 }
@@ -14,6 +14,12 @@
 #include "hipSYCL/runtime/cuda/cuda_event.hpp"
 #include "hipSYCL/runtime/cuda/cuda_queue.hpp"
 #include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/ptx/LLVMToPtxFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
 
 
 HIPSYCL_PLUGIN_API_EXPORT
@@ -34,10 +40,29 @@ namespace rt {
 
 namespace {
 
+void register_jit_recipe_compiler() {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  kernel_cache::get()->register_jit_recipe_compiler(
+      backend_id::cuda,
+      [](const common::db::jit_recipe &recipe,
+         kernel_cache::code_object_id id_of_binary, std::string &out) {
+        std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+            compiler::createLLVMToPtxTranslator(recipe.kernels);
+        return glue::jit::precompilation::compile(
+                   translator.get(), recipe, id_of_binary, out)
+            .is_success();
+      });
+#endif
+}
+
 std::unique_ptr<multi_queue_executor>
 create_multi_queue_executor(cuda_backend *b) {
   return std::make_unique<multi_queue_executor>(
-      *b, [b](device_id dev) { return std::make_unique<cuda_queue>(b, dev); });
+      *b,
+      [b](device_id dev, int priority) {
+        return std::make_unique<cuda_queue>(b, dev, priority);
+      },
+      false, true);
 }
 
 }
@@ -46,7 +71,9 @@ cuda_backend::cuda_backend()
     : _hw_manager{cuda_backend::get_hardware_platform()},
       _executor{[this]() {
         return create_multi_queue_executor(this);
-      }} {}
+      }} {
+  register_jit_recipe_compiler();
+}
 
 api_platform cuda_backend::get_api_platform() const {
   return api_platform::cuda;
@@ -89,6 +116,22 @@ cuda_event_pool* cuda_backend::get_event_pool(device_id dev) const {
       ->get_event_pool();
 }
 
+staging_buffer_pool *
+cuda_backend::get_staging_buffer_pool(device_id dev) const {
+  assert(dev.get_backend() == this->get_unique_backend_id());
+  return static_cast<cuda_hardware_context *>(
+             get_hardware_manager()->get_device(dev.get_id()))
+      ->get_staging_buffer_pool();
+}
+
+cuda_device_timestamps *
+cuda_backend::get_device_timestamps(device_id dev) const {
+  assert(dev.get_backend() == this->get_unique_backend_id());
+  return static_cast<cuda_hardware_context *>(
+             get_hardware_manager()->get_device(dev.get_id()))
+      ->get_device_timestamps();
+}
+
 std::string cuda_backend::get_name() const {
   return "CUDA";
 }
@@ -101,5 +144,14 @@ cuda_backend::create_inorder_executor(device_id dev, int priority) {
   return std::make_unique<inorder_executor>(std::move(q));
 }
 
+std::unique_ptr<backend_executor>
+cuda_backend::create_partitioned_inorder_executor(
+    device_id dev, int priority, std::size_t num_compute_units) {
+  std::unique_ptr<inorder_queue> q =
+      std::make_unique<cuda_queue>(this, dev, priority, num_compute_units);
+
+  return std::make_unique<inorder_executor>(std::move(q));
+}
+
 }
 }
\ No newline at end of file
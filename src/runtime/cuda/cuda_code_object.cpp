@@ -13,6 +13,8 @@
 #include <algorithm>
 #include <cctype>
 #include <cassert>
+#include <cstdint>
+#include <unordered_map>
 
 #include <cuda_runtime_api.h>
 #include <cuda.h>
@@ -63,7 +65,8 @@ void unload_cuda_module(CUmod_st* module, int device) {
 }
 
 result build_cuda_module_from_ptx(CUmod_st *&module, int device,
-                                  const std::string &source) {
+                                  const std::string &source,
+                                  std::string *info_log = nullptr) {
 
   cuda_device_manager::get().activate_device(device);
   // This guarantees that the CUDA runtime API initializes the CUDA
@@ -71,9 +74,10 @@ result build_cuda_module_from_ptx(CUmod_st *&module, int device,
   // API calls which assume that CUDA context has been created.
   cudaFree(0);
 
-  static constexpr std::size_t num_options = 2;
-  std::array<CUjit_option, num_options> option_names{};
-  std::array<void*, num_options> option_vals{};
+  static constexpr std::size_t max_num_options = 5;
+  std::array<CUjit_option, max_num_options> option_names{};
+  std::array<void*, max_num_options> option_vals{};
+  std::size_t num_options = 2;
 
   // set up size of compilation log buffer
   option_names[0] = CU_JIT_ERROR_LOG_BUFFER_SIZE_BYTES;
@@ -85,6 +89,20 @@ result build_cuda_module_from_ptx(CUmod_st *&module, int device,
   std::string error_log_buffer(error_log_buffer_size, '\0');
   option_vals[1] = error_log_buffer.data();
 
+  // The verbose info log contains the ptxas resource usage of each kernel
+  static constexpr std::size_t info_log_buffer_size = 64*1024;
+  std::string info_log_buffer;
+  if(info_log) {
+    info_log_buffer.resize(info_log_buffer_size, '\0');
+    option_names[2] = CU_JIT_INFO_LOG_BUFFER_SIZE_BYTES;
+    option_vals[2] = reinterpret_cast<void*>(info_log_buffer_size);
+    option_names[3] = CU_JIT_INFO_LOG_BUFFER;
+    option_vals[3] = info_log_buffer.data();
+    option_names[4] = CU_JIT_LOG_VERBOSE;
+    option_vals[4] = reinterpret_cast<void*>(1);
+    num_options = 5;
+  }
+
   auto err = cuModuleLoadDataEx(
       &module, source.data(),
       num_options, option_names.data(), option_vals.data());
@@ -102,9 +120,50 @@ result build_cuda_module_from_ptx(CUmod_st *&module, int device,
 
   assert(module);
 
+  if(info_log) {
+    const auto info_log_size = reinterpret_cast<std::size_t>(option_vals[2]);
+    info_log_buffer.resize(std::min(info_log_size, info_log_buffer_size));
+    *info_log = std::move(info_log_buffer);
+  }
+
   return make_success();
 }
 
+// Extracts the spill stores of each kernel from ptxas output of the form
+//   ptxas info    : Function properties for <kernel>
+//       0 bytes stack frame, 8 bytes spill stores, 8 bytes spill loads
+std::unordered_map<std::string, uint64_t>
+parse_ptxas_spill_stores(const std::string &info_log) {
+  std::unordered_map<std::string, uint64_t> result;
+
+  static const std::string function_marker = "Function properties for ";
+  static const std::string spill_marker = " bytes spill stores";
+
+  std::istringstream log{info_log};
+  std::string line;
+  std::string current_function;
+  while(std::getline(log, line)) {
+    auto function_pos = line.find(function_marker);
+    if(function_pos != std::string::npos) {
+      current_function = line.substr(function_pos + function_marker.size());
+      trim_left(current_function);
+      trim_right_space_and_parenthesis(current_function);
+      continue;
+    }
+    auto spill_pos = line.find(spill_marker);
+    if(spill_pos != std::string::npos && !current_function.empty()) {
+      auto number_start = line.find_last_of(", ", spill_pos - 1);
+      number_start = (number_start == std::string::npos) ? 0 : number_start + 1;
+      try {
+        result[current_function] = std::stoull(
+            line.substr(number_start, spill_pos - number_start));
+      } catch(...) {}
+      current_function.clear();
+    }
+  }
+  return result;
+}
+
 std::vector<std::string> extract_kernel_names_from_ptx(const std::string& source) {
 
   std::vector<std::string> kernel_names;
@@ -131,6 +190,30 @@ std::vector<std::string> extract_kernel_names_from_ptx(const std::string& source
 
 }
 
+result cuda_executable_object::get_kernel(std::string_view kernel_name,
+                                          CUfunc_st *&f) const {
+  std::lock_guard<std::mutex> lock{_kernel_lookup_mutex};
+
+  auto it = _kernels.find(kernel_name);
+  if(it != _kernels.end()) {
+    f = it->second;
+    return make_success();
+  }
+
+  // kernel_name is not guaranteed to be null-terminated
+  auto name = std::make_unique<std::string>(kernel_name);
+  CUresult err = cuModuleGetFunction(&f, get_module(), name->c_str());
+  if (err != CUDA_SUCCESS) {
+    return make_error(
+        __acpp_here(),
+        error_info{"cuda_executable_object: could not extract kernel from module",
+                   error_code{"CU", static_cast<int>(err)}});
+  }
+
+  _kernels[*name] = f;
+  _kernel_names_storage.push_back(std::move(name));
+  return make_success();
+}
 
 cuda_multipass_executable_object::cuda_multipass_executable_object(hcf_object_id origin,
                                    const std::string &target,
@@ -260,7 +343,19 @@ result cuda_sscp_executable_object::build(const std::string& source) {
   if (_module != nullptr)
     return make_success();
 
-  return build_cuda_module_from_ptx(_module, _device, source);
+  std::string info_log;
+  auto err = build_cuda_module_from_ptx(_module, _device, source, &info_log);
+  if(err.is_success())
+    _spill_store_bytes = parse_ptxas_spill_stores(info_log);
+  return err;
+}
+
+uint64_t cuda_sscp_executable_object::get_spill_store_bytes(
+    std::string_view backend_kernel_name) const {
+  auto it = _spill_store_bytes.find(std::string{backend_kernel_name});
+  if(it == _spill_store_bytes.end())
+    return 0;
+  return it->second;
 }
 
 bool cuda_sscp_executable_object::contains(const std::string &backend_kernel_name) const {
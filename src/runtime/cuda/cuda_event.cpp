@@ -11,6 +11,9 @@
 #include "hipSYCL/runtime/cuda/cuda_event.hpp"
 #include "hipSYCL/runtime/cuda/cuda_event_pool.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/generic/spin_wait.hpp"
 
 #include <cuda_runtime_api.h>
 
@@ -41,12 +44,22 @@ bool cuda_node_event::is_complete() const
 
 void cuda_node_event::wait()
 {
-  auto err = cudaEventSynchronize(_evt);
-  if (err != cudaSuccess) {
-    register_error(__acpp_here(),
-                   error_info{"cuda_node_event: cudaEventSynchronize() failed",
-                              error_code{"CUDA", err}});
-  }
+  static wait_duration_predictor predictor;
+  static const uint64_t max_spin_ns =
+      1000 * application::get_settings().get<setting::max_wait_spin_time>();
+
+  hybrid_wait(
+      predictor, max_spin_ns,
+      [this]() { return cudaEventQuery(_evt) != cudaErrorNotReady; },
+      [this]() {
+        auto err = cudaEventSynchronize(_evt);
+        if (err != cudaSuccess) {
+          register_error(
+              __acpp_here(),
+              error_info{"cuda_node_event: cudaEventSynchronize() failed",
+                         error_code{"CUDA", err}});
+        }
+      });
 }
 
 cuda_node_event::backend_event_type cuda_node_event::get_event() const
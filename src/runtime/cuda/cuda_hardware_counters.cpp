@@ -0,0 +1,330 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/cuda/cuda_hardware_counters.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <cuda.h>
+#include <cuda_runtime_api.h>
+#include <cupti_profiler_host.h>
+#include <cupti_profiler_target.h>
+#include <cupti_range_profiler.h>
+#include <cupti_target.h>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Perfworks metrics in the order of the corresponding hardware_counter values
+constexpr std::array<const char *, 4> metric_names = {
+    "sm__warps_active.avg.pct_of_peak_sustained_active",
+    "dram__bytes_read.sum",
+    "dram__bytes_write.sum",
+    "lts__t_sector_hit_rate.pct"};
+
+constexpr std::array<hardware_counter, 4> metric_counters = {
+    hardware_counter::achieved_occupancy, hardware_counter::dram_read_bytes,
+    hardware_counter::dram_write_bytes, hardware_counter::l2_hit_rate};
+
+// Metrics reported in percent are converted to fractions
+constexpr std::array<double, 4> metric_scales = {0.01, 1.0, 1.0, 0.01};
+
+result make_cupti_error(const std::string &msg, CUptiResult err) {
+  return make_error(__acpp_here(),
+                    error_info{"cuda_hardware_counters: " + msg,
+                               error_code{"CUPTI", static_cast<int>(err)}});
+}
+
+}
+
+/// Profiler state of a CUDA context. The range profiler is enabled once and
+/// remains enabled; only the collection between start and stop incurs
+/// overhead.
+class cupti_device_profiler {
+public:
+  result init(CUcontext ctx, int device_id) {
+    static std::once_flag profiler_init_flag;
+    CUptiResult init_err = CUPTI_SUCCESS;
+    std::call_once(profiler_init_flag, [&]() {
+      CUpti_Profiler_Initialize_Params params = {
+          CUpti_Profiler_Initialize_Params_STRUCT_SIZE};
+      init_err = cuptiProfilerInitialize(&params);
+    });
+    if(init_err != CUPTI_SUCCESS)
+      return make_cupti_error("cuptiProfilerInitialize() failed", init_err);
+
+    CUpti_Device_GetChipName_Params chip_params = {
+        CUpti_Device_GetChipName_Params_STRUCT_SIZE};
+    chip_params.deviceIndex = static_cast<size_t>(device_id);
+    CUptiResult err = cuptiDeviceGetChipName(&chip_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not query chip name", err);
+
+    CUpti_Profiler_GetCounterAvailability_Params availability_params = {
+        CUpti_Profiler_GetCounterAvailability_Params_STRUCT_SIZE};
+    availability_params.ctx = ctx;
+    err = cuptiProfilerGetCounterAvailability(&availability_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not query counter availability", err);
+    std::vector<uint8_t> availability_image(
+        availability_params.counterAvailabilityImageSize);
+    availability_params.pCounterAvailabilityImage = availability_image.data();
+    err = cuptiProfilerGetCounterAvailability(&availability_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not query counter availability", err);
+
+    CUpti_Profiler_Host_Initialize_Params host_params = {
+        CUpti_Profiler_Host_Initialize_Params_STRUCT_SIZE};
+    host_params.profilerType = CUPTI_PROFILER_TYPE_RANGE_PROFILER;
+    host_params.pChipName = chip_params.pChipName;
+    host_params.pCounterAvailabilityImage = availability_image.data();
+    err = cuptiProfilerHostInitialize(&host_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("cuptiProfilerHostInitialize() failed", err);
+    _host_object = host_params.pHostObject;
+
+    CUpti_Profiler_Host_ConfigAddMetrics_Params add_metrics_params = {
+        CUpti_Profiler_Host_ConfigAddMetrics_Params_STRUCT_SIZE};
+    add_metrics_params.pHostObject = _host_object;
+    add_metrics_params.ppMetricNames = metric_names.data();
+    add_metrics_params.numMetrics = metric_names.size();
+    err = cuptiProfilerHostConfigAddMetrics(&add_metrics_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not add metrics to configuration", err);
+
+    CUpti_Profiler_Host_GetConfigImageSize_Params config_size_params = {
+        CUpti_Profiler_Host_GetConfigImageSize_Params_STRUCT_SIZE};
+    config_size_params.pHostObject = _host_object;
+    err = cuptiProfilerHostGetConfigImageSize(&config_size_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not query config image size", err);
+    _config_image.resize(config_size_params.configImageSize);
+
+    CUpti_Profiler_Host_GetConfigImage_Params config_params = {
+        CUpti_Profiler_Host_GetConfigImage_Params_STRUCT_SIZE};
+    config_params.pHostObject = _host_object;
+    config_params.pConfigImage = _config_image.data();
+    config_params.configImageSize = _config_image.size();
+    err = cuptiProfilerHostGetConfigImage(&config_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not create config image", err);
+
+    CUpti_RangeProfiler_Enable_Params enable_params = {
+        CUpti_RangeProfiler_Enable_Params_STRUCT_SIZE};
+    enable_params.ctx = ctx;
+    err = cuptiRangeProfilerEnable(&enable_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not enable range profiler", err);
+    _range_profiler = enable_params.pRangeProfilerObject;
+
+    CUpti_RangeProfiler_GetCounterDataSize_Params data_size_params = {
+        CUpti_RangeProfiler_GetCounterDataSize_Params_STRUCT_SIZE};
+    data_size_params.pRangeProfilerObject = _range_profiler;
+    data_size_params.pMetricNames = metric_names.data();
+    data_size_params.numMetrics = metric_names.size();
+    data_size_params.maxNumOfRanges = 1;
+    data_size_params.maxNumRangeTreeNodes = 1;
+    err = cuptiRangeProfilerGetCounterDataSize(&data_size_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not query counter data size", err);
+    _counter_data_image.resize(data_size_params.counterDataSize);
+
+    return make_success();
+  }
+
+  result start() {
+    // The counter data image is reinitialized such that it only contains
+    // the range of the upcoming kernel.
+    CUpti_RangeProfiler_CounterDataImage_Initialize_Params data_params = {
+        CUpti_RangeProfiler_CounterDataImage_Initialize_Params_STRUCT_SIZE};
+    data_params.pRangeProfilerObject = _range_profiler;
+    data_params.pCounterData = _counter_data_image.data();
+    data_params.counterDataSize = _counter_data_image.size();
+    CUptiResult err = cuptiRangeProfilerCounterDataImageInitialize(&data_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not initialize counter data image", err);
+
+    CUpti_RangeProfiler_SetConfig_Params config_params = {
+        CUpti_RangeProfiler_SetConfig_Params_STRUCT_SIZE};
+    config_params.pRangeProfilerObject = _range_profiler;
+    config_params.configSize = _config_image.size();
+    config_params.pConfig = _config_image.data();
+    config_params.counterDataImageSize = _counter_data_image.size();
+    config_params.pCounterDataImage = _counter_data_image.data();
+    // Each kernel is a separate range, and is replayed until all
+    // counters have been collected.
+    config_params.range = CUPTI_AutoRange;
+    config_params.replayMode = CUPTI_KernelReplay;
+    config_params.maxRangesPerPass = 1;
+    config_params.numNestingLevels = 1;
+    config_params.minNestingLevel = 1;
+    config_params.passIndex = 0;
+    config_params.targetNestingLevel = 0;
+    err = cuptiRangeProfilerSetConfig(&config_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not set range profiler config", err);
+
+    CUpti_RangeProfiler_Start_Params start_params = {
+        CUpti_RangeProfiler_Start_Params_STRUCT_SIZE};
+    start_params.pRangeProfilerObject = _range_profiler;
+    err = cuptiRangeProfilerStart(&start_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not start range profiler", err);
+    return make_success();
+  }
+
+  result stop(std::shared_ptr<simple_hardware_counters> &out) {
+    CUpti_RangeProfiler_Stop_Params stop_params = {
+        CUpti_RangeProfiler_Stop_Params_STRUCT_SIZE};
+    stop_params.pRangeProfilerObject = _range_profiler;
+    CUptiResult err = cuptiRangeProfilerStop(&stop_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not stop range profiler", err);
+
+    CUpti_RangeProfiler_DecodeData_Params decode_params = {
+        CUpti_RangeProfiler_DecodeData_Params_STRUCT_SIZE};
+    decode_params.pRangeProfilerObject = _range_profiler;
+    err = cuptiRangeProfilerDecodeData(&decode_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not decode counter data", err);
+
+    CUpti_RangeProfiler_GetCounterDataInfo_Params info_params = {
+        CUpti_RangeProfiler_GetCounterDataInfo_Params_STRUCT_SIZE};
+    info_params.pCounterDataImage = _counter_data_image.data();
+    info_params.counterDataImageSize = _counter_data_image.size();
+    err = cuptiRangeProfilerGetCounterDataInfo(&info_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not query counter data info", err);
+    if(info_params.numTotalRanges == 0)
+      return make_error(
+          __acpp_here(),
+          error_info{"cuda_hardware_counters: No kernel was profiled"});
+
+    std::array<double, metric_names.size()> values;
+    CUpti_Profiler_Host_EvaluateToGpuValues_Params eval_params = {
+        CUpti_Profiler_Host_EvaluateToGpuValues_Params_STRUCT_SIZE};
+    eval_params.pHostObject = _host_object;
+    eval_params.pCounterDataImage = _counter_data_image.data();
+    eval_params.counterDataImageSize = _counter_data_image.size();
+    eval_params.ppMetricNames = metric_names.data();
+    eval_params.numMetrics = metric_names.size();
+    eval_params.rangeIndex = 0;
+    eval_params.pMetricValues = values.data();
+    err = cuptiProfilerHostEvaluateToGpuValues(&eval_params);
+    if(err != CUPTI_SUCCESS)
+      return make_cupti_error("Could not evaluate metrics", err);
+
+    out = std::make_shared<simple_hardware_counters>();
+    for(std::size_t i = 0; i < values.size(); ++i)
+      out->set_value(metric_counters[i], values[i] * metric_scales[i]);
+    return make_success();
+  }
+
+  std::mutex& get_mutex() {
+    return _mutex;
+  }
+
+  // The profiler object of each device is created on first use. Returns
+  // nullptr if the device does not support profiling; the failure is only
+  // reported once.
+  static cupti_device_profiler* get(int device_id) {
+    static std::mutex mutex;
+    // Never destroyed, since the CUDA contexts may already be gone
+    // at static destruction time.
+    static auto* profilers =
+        new std::unordered_map<int, std::unique_ptr<cupti_device_profiler>>{};
+
+    std::lock_guard<std::mutex> lock{mutex};
+    auto it = profilers->find(device_id);
+    if(it != profilers->end())
+      return it->second.get();
+
+    CUcontext ctx = nullptr;
+    cuCtxGetCurrent(&ctx);
+
+    auto profiler = std::make_unique<cupti_device_profiler>();
+    result res = ctx ? profiler->init(ctx, device_id)
+                     : make_error(__acpp_here(),
+                                  error_info{"cuda_hardware_counters: No "
+                                             "current CUDA context"});
+    if(!res.is_success()) {
+      HIPSYCL_DEBUG_WARNING
+          << "cuda_hardware_counters: Hardware counters are not available "
+             "for device "
+          << device_id << ", ignoring requests to collect them" << std::endl;
+      register_error(res);
+      profiler.reset();
+    }
+    auto* ptr = profiler.get();
+    profilers->emplace(device_id, std::move(profiler));
+    return ptr;
+  }
+
+private:
+  std::mutex _mutex;
+  CUpti_Profiler_Host_Object *_host_object = nullptr;
+  CUpti_RangeProfiler_Object *_range_profiler = nullptr;
+  std::vector<uint8_t> _config_image;
+  std::vector<uint8_t> _counter_data_image;
+};
+
+cuda_hardware_counter_collection::cuda_hardware_counter_collection(
+    int device_id)
+    : _profiler{cupti_device_profiler::get(device_id)}, _is_active{false} {
+  if(!_profiler)
+    return;
+
+  _lock = std::unique_lock<std::mutex>{_profiler->get_mutex()};
+  result res = _profiler->start();
+  if(!res.is_success()) {
+    register_error(res);
+    return;
+  }
+  _is_active = true;
+}
+
+cuda_hardware_counter_collection::~cuda_hardware_counter_collection() {
+  if(_is_active) {
+    std::shared_ptr<simple_hardware_counters> unused;
+    _profiler->stop(unused);
+  }
+}
+
+result cuda_hardware_counter_collection::finish(
+    CUstream_st *stream, std::shared_ptr<simple_hardware_counters> &out) {
+  if(!_is_active)
+    return make_error(
+        __acpp_here(),
+        error_info{"cuda_hardware_counters: Collection is not active"});
+  _is_active = false;
+
+  auto err = cudaStreamSynchronize(stream);
+  if(err != cudaSuccess) {
+    std::shared_ptr<simple_hardware_counters> unused;
+    _profiler->stop(unused);
+    return make_error(__acpp_here(),
+                      error_info{"cuda_hardware_counters: Could not wait for "
+                                 "profiled kernel",
+                                 error_code{"CUDA", err}});
+  }
+  return _profiler->stop(out);
+}
+
+}
+}
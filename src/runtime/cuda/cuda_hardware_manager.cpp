@@ -10,7 +10,10 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/cuda/cuda_hardware_manager.hpp"
 #include "hipSYCL/runtime/cuda/cuda_event_pool.hpp"
+#include "hipSYCL/runtime/cuda/cuda_instrumentation.hpp"
+#include "hipSYCL/runtime/staging_buffer_pool.hpp"
 #include "hipSYCL/runtime/cuda/cuda_allocator.hpp"
+#include "hipSYCL/runtime/cuda/cuda_device_manager.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
@@ -56,6 +59,18 @@ cuda_hardware_manager::cuda_hardware_manager(hardware_platform hw_platform)
     _devices.emplace_back(dev);
   }
 
+  if (application::get_settings().get<setting::peer_access>()) {
+    for (int dev = 0; dev < num_devices; ++dev) {
+      for (int peer = 0; peer < num_devices; ++peer) {
+        if (dev != peer && _devices[dev].enable_peer_access(peer)) {
+          HIPSYCL_DEBUG_INFO << "cuda_hardware_manager: Enabled peer access "
+                                "from device "
+                             << dev << " to device " << peer << std::endl;
+        }
+      }
+    }
+  }
+
 }
 
 
@@ -101,6 +116,36 @@ cuda_hardware_context::cuda_hardware_context(int dev)
   _allocator = std::make_unique<cuda_allocator>(
       backend_descriptor{hardware_platform::cuda, api_platform::cuda}, _dev);
   _event_pool = std::make_unique<cuda_event_pool>(_dev);
+  _staging_pool = std::make_unique<staging_buffer_pool>(
+      _allocator.get(),
+      application::get_settings().get<setting::staging_buffer_size>() * 1024 *
+          1024,
+      application::get_settings().get<setting::staging_pool_size>());
+  if(application::get_settings().get<setting::device_timestamps>())
+    _device_timestamps = std::make_unique<cuda_device_timestamps>(_dev);
+}
+
+bool cuda_hardware_context::enable_peer_access(int peer_dev) {
+  cuda_device_manager::get().activate_device(_dev);
+
+  int can_access = 0;
+  auto err = cudaDeviceCanAccessPeer(&can_access, _dev, peer_dev);
+  if (err != cudaSuccess || !can_access)
+    return false;
+
+  err = cudaDeviceEnablePeerAccess(peer_dev, 0);
+  if (err == cudaErrorPeerAccessAlreadyEnabled) {
+    // Clear error state
+    cudaGetLastError();
+  } else if (err != cudaSuccess) {
+    print_warning(
+        __acpp_here(),
+        error_info{"cuda_hardware_manager: Could not enable peer access",
+                   error_code{"CUDA", err}});
+    return false;
+  }
+  _peer_devices.push_back(static_cast<std::size_t>(peer_dev));
+  return true;
 }
 
 cuda_allocator* cuda_hardware_context::get_allocator() const {
@@ -111,6 +156,14 @@ cuda_event_pool* cuda_hardware_context::get_event_pool() const {
   return _event_pool.get();
 }
 
+staging_buffer_pool* cuda_hardware_context::get_staging_buffer_pool() const {
+  return _staging_pool.get();
+}
+
+cuda_device_timestamps* cuda_hardware_context::get_device_timestamps() const {
+  return _device_timestamps.get();
+}
+
 bool cuda_hardware_context::is_cpu() const {
   return !is_gpu();
 }
@@ -147,7 +200,7 @@ bool cuda_hardware_context::has(device_support_aspect aspect) const {
     return false;
     break;
   case device_support_aspect::host_unified_memory:
-    return false;
+    return _properties->integrated != 0;
     break;
   case device_support_aspect::error_correction:
     return false; // TODO
@@ -341,6 +394,11 @@ cuda_hardware_context::get_property(device_uint_property prop) const {
   case device_uint_property::global_mem_size:
     return _properties->totalGlobalMem;
     break;
+  case device_uint_property::peak_memory_bandwidth:
+    // memoryClockRate is in kHz; the factor 2 accounts for double data rate
+    return static_cast<std::size_t>(_properties->memoryClockRate) * 1000 * 2 *
+           (_properties->memoryBusWidth / 8);
+    break;
   case device_uint_property::max_constant_buffer_size:
     return _properties->totalConstMem;
     break;
@@ -371,6 +429,9 @@ cuda_hardware_context::get_property(device_uint_list_property prop) const {
     return std::vector<std::size_t>{
         static_cast<std::size_t>(_properties->warpSize)};
     break;
+  case device_uint_list_property::peer_access_devices:
+    return _peer_devices;
+    break;
   }
   assert(false && "Invalid device property");
   std::terminate();
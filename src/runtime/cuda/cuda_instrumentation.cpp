@@ -11,7 +11,9 @@
 #include "hipSYCL/runtime/cuda/cuda_instrumentation.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/cuda/cuda_event.hpp"
+#include "hipSYCL/runtime/cuda/cuda_device_manager.hpp"
 
+#include <cuda.h>
 #include <cuda_runtime_api.h>
 
 #include <cassert>
@@ -43,6 +45,137 @@ cuda_event_time_delta::operator()(const dag_node_event& t0,
       std::chrono::duration<float, std::milli>{ms});
 }
 
+namespace {
+
+// Writes the global timer to the location given by the argument
+constexpr const char* timestamp_kernel_ptx = R"(
+.version 6.0
+.target sm_50
+.address_size 64
+
+.visible .entry __acpp_write_globaltimer(.param .u64 __acpp_timestamp_ptr)
+{
+  .reg .b64 %rd<4>;
+
+  ld.param.u64 %rd1, [__acpp_timestamp_ptr];
+  cvta.to.global.u64 %rd2, %rd1;
+  mov.u64 %rd3, %globaltimer;
+  st.volatile.global.u64 [%rd2], %rd3;
+  ret;
+}
+)";
+
+// Since slots are only reused after all others, this bounds the number of
+// timestamps that can be recorded before the first of them is queried.
+constexpr std::size_t num_timestamp_slots = 1024 * 1024;
+
+}
+
+cuda_device_timestamps::cuda_device_timestamps(int device_id)
+: _device_id{device_id} {}
+
+cuda_device_timestamps::~cuda_device_timestamps() {
+  if(_module)
+    cuModuleUnload(_module);
+  if(_host_ptr)
+    cudaFreeHost(_host_ptr);
+}
+
+result cuda_device_timestamps::init() {
+  cuda_device_manager::get().activate_device(_device_id);
+
+  // The last element is used for calibration
+  const std::size_t num_bytes = (num_timestamp_slots + 1) * sizeof(uint64_t);
+  void* host_ptr = nullptr;
+  cudaError_t err = cudaHostAlloc(&host_ptr, num_bytes,
+                                  cudaHostAllocMapped | cudaHostAllocPortable);
+  if(err != cudaSuccess)
+    return make_error(__acpp_here(),
+                      error_info{"cuda_device_timestamps: Could not allocate "
+                                 "timestamp buffer",
+                                 error_code{"CUDA", err}});
+  _host_ptr = static_cast<uint64_t*>(host_ptr);
+
+  void* device_ptr = nullptr;
+  err = cudaHostGetDevicePointer(&device_ptr, host_ptr, 0);
+  if(err != cudaSuccess)
+    return make_error(__acpp_here(),
+                      error_info{"cuda_device_timestamps: Could not map "
+                                 "timestamp buffer",
+                                 error_code{"CUDA", err}});
+  _device_ptr = static_cast<uint64_t*>(device_ptr);
+
+  CUresult cu_err = cuModuleLoadData(&_module, timestamp_kernel_ptx);
+  if(cu_err != CUDA_SUCCESS)
+    return make_error(__acpp_here(),
+                      error_info{"cuda_device_timestamps: Could not load "
+                                 "timestamp kernel",
+                                 error_code{"CU", static_cast<int>(cu_err)}});
+
+  cu_err = cuModuleGetFunction(&_kernel, _module, "__acpp_write_globaltimer");
+  if(cu_err != CUDA_SUCCESS)
+    return make_error(__acpp_here(),
+                      error_info{"cuda_device_timestamps: Could not find "
+                                 "timestamp kernel",
+                                 error_code{"CU", static_cast<int>(cu_err)}});
+
+  _buffer = std::make_shared<device_timestamp_buffer>(_host_ptr,
+                                                      num_timestamp_slots);
+  return calibrate();
 }
+
+result cuda_device_timestamps::calibrate() {
+  volatile uint64_t* calibration_slot = _host_ptr + num_timestamp_slots;
+  uint64_t* device_calibration_slot = _device_ptr + num_timestamp_slots;
+  void* args[] = {&device_calibration_slot};
+
+  // The device time corresponds to a host time between launch and
+  // completion of the kernel; use the shortest of several round trips
+  // to minimize the error.
+  profiler_clock::duration best_round_trip = profiler_clock::duration::max();
+  for(int i = 0; i < 5; ++i) {
+    *calibration_slot = 0;
+    auto before = profiler_clock::now();
+    CUresult err = cuLaunchKernel(_kernel, 1, 1, 1, 1, 1, 1, 0, nullptr, args,
+                                  nullptr);
+    if(err == CUDA_SUCCESS)
+      err = cuCtxSynchronize();
+    auto after = profiler_clock::now();
+    if(err != CUDA_SUCCESS)
+      return make_error(__acpp_here(),
+                        error_info{"cuda_device_timestamps: Could not "
+                                   "calibrate timestamps",
+                                   error_code{"CU", static_cast<int>(err)}});
+
+    if(after - before < best_round_trip) {
+      best_round_trip = after - before;
+      _buffer->set_reference(*calibration_slot,
+                             before + (after - before) / 2);
+    }
+  }
+  return make_success();
 }
 
+result cuda_device_timestamps::record(CUstream_st *stream,
+                                      device_timestamp_buffer::slot &out) {
+  std::call_once(_init_flag, [this]() { _init_result = init(); });
+  if(!_init_result.is_success())
+    return _init_result;
+
+  device_timestamp_buffer::slot s = _buffer->allocate();
+  uint64_t* target = _device_ptr + s.index;
+  void* args[] = {&target};
+
+  CUresult err =
+      cuLaunchKernel(_kernel, 1, 1, 1, 1, 1, 1, 0, stream, args, nullptr);
+  if(err != CUDA_SUCCESS)
+    return make_error(__acpp_here(),
+                      error_info{"cuda_device_timestamps: Could not enqueue "
+                                 "timestamp kernel",
+                                 error_code{"CU", static_cast<int>(err)}});
+  out = s;
+  return make_success();
+}
+
+}
+}
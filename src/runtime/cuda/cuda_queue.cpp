@@ -18,7 +18,14 @@
 #include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/code_object_invoker.hpp"
 #include "hipSYCL/runtime/cuda/cuda_instrumentation.hpp"
+#ifdef HIPSYCL_WITH_CUPTI
+#include "hipSYCL/runtime/cuda/cuda_hardware_counters.hpp"
+#endif
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/generic/object_pool.hpp"
+#include "hipSYCL/runtime/generic/spin_wait.hpp"
+#include "hipSYCL/runtime/group_size_autotuner.hpp"
+#include "hipSYCL/runtime/group_size_cache.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/cuda/cuda_queue.hpp"
 #include "hipSYCL/runtime/cuda/cuda_backend.hpp"
@@ -45,7 +52,9 @@
 #include <cuda_runtime.h> //for make_cudaPitchedPtr
 #include <cuda.h> // For kernels launched from modules
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
 
 namespace hipsycl {
@@ -53,6 +62,170 @@ namespace rt {
 
 namespace {
 
+bool is_pageable_host_memory(backend_allocator *alloc, const void *ptr) {
+  pointer_info info;
+  // Host pointers that are unknown to CUDA are pageable
+  bool is_pageable = !alloc->query_pointer(ptr, info).is_success();
+  // Clear error state in case the query failed
+  if(is_pageable)
+    cudaGetLastError();
+  return is_pageable;
+}
+
+// Copies between pageable host memory and the device by bouncing through
+// two pinned staging buffers in alternation, such that the host-side copy of
+// one chunk overlaps with the DMA transfer of the other. Like the driver's
+// pageable copy path, this only returns once the host side of the transfer
+// has completed. If no staging buffers are available, nothing is submitted
+// and is_staged is set to false.
+result submit_staged_memcpy(cudaStream_t stream, cuda_event_pool *evt_pool,
+                            staging_buffer_pool *pool, void *dest,
+                            const void *src, std::size_t bytes,
+                            cudaMemcpyKind kind, bool &is_staged) {
+  is_staged = false;
+
+  void* staging[2] = {pool->obtain_buffer(), pool->obtain_buffer()};
+  cudaEvent_t events[2] = {nullptr, nullptr};
+
+  auto release_resources = [&]() {
+    for(int i = 0; i < 2; ++i) {
+      if(events[i])
+        evt_pool->release_event(events[i]);
+      pool->release_buffer(staging[i]);
+    }
+  };
+
+  if(!staging[0] || !staging[1]) {
+    release_resources();
+    return make_success();
+  }
+  for(int i = 0; i < 2; ++i) {
+    auto evt_result = evt_pool->obtain_event(events[i]);
+    if(!evt_result.is_success()) {
+      events[i] = nullptr;
+      release_resources();
+      return evt_result;
+    }
+  }
+  is_staged = true;
+
+  const std::size_t chunk_size = pool->get_buffer_size();
+  const std::size_t num_chunks = (bytes + chunk_size - 1) / chunk_size;
+  auto get_chunk_size = [&](std::size_t chunk) {
+    return std::min(chunk_size, bytes - chunk * chunk_size);
+  };
+  char* dest_bytes = static_cast<char*>(dest);
+  const char* src_bytes = static_cast<const char*>(src);
+
+  cudaError_t err = cudaSuccess;
+  if(kind == cudaMemcpyHostToDevice) {
+    // The host data might be produced by preceding operations in the stream
+    err = cudaStreamSynchronize(stream);
+    for(std::size_t i = 0; i < num_chunks && err == cudaSuccess; ++i) {
+      int buff = i % 2;
+      // Wait until the previous transfer from this staging buffer has completed
+      if(i >= 2)
+        err = cudaEventSynchronize(events[buff]);
+      if(err != cudaSuccess)
+        break;
+      std::memcpy(staging[buff], src_bytes + i * chunk_size, get_chunk_size(i));
+      err = cudaMemcpyAsync(dest_bytes + i * chunk_size, staging[buff],
+                            get_chunk_size(i), kind, stream);
+      if(err == cudaSuccess)
+        err = cudaEventRecord(events[buff], stream);
+    }
+  } else {
+    auto submit_chunk = [&](std::size_t chunk) {
+      int buff = chunk % 2;
+      err = cudaMemcpyAsync(staging[buff], src_bytes + chunk * chunk_size,
+                            get_chunk_size(chunk), kind, stream);
+      if(err == cudaSuccess)
+        err = cudaEventRecord(events[buff], stream);
+    };
+    for(std::size_t i = 0; i < std::min(num_chunks, std::size_t{2}) &&
+                           err == cudaSuccess; ++i)
+      submit_chunk(i);
+    for(std::size_t i = 0; i < num_chunks && err == cudaSuccess; ++i) {
+      int buff = i % 2;
+      err = cudaEventSynchronize(events[buff]);
+      if(err != cudaSuccess)
+        break;
+      std::memcpy(dest_bytes + i * chunk_size, staging[buff], get_chunk_size(i));
+      if(i + 2 < num_chunks)
+        submit_chunk(i + 2);
+    }
+  }
+
+  // Staging buffers can only be reused once the device has stopped
+  // accessing them.
+  for(int i = 0; i < 2; ++i) {
+    cudaError_t sync_err = cudaEventSynchronize(events[i]);
+    if(err == cudaSuccess)
+      err = sync_err;
+  }
+  release_resources();
+
+  if(err != cudaSuccess) {
+    return make_error(__acpp_here(),
+                      error_info{"cuda_queue: Staged memcpy failed",
+                                  error_code{"CUDA", err}});
+  }
+  return make_success();
+}
+
+// Operations that record instrumentation events cannot be captured,
+// since the events need to be recorded individually.
+bool may_capture_graph(const dag_node_ptr& node) {
+  if(!node)
+    return false;
+  const auto& node_hints = node->get_execution_hints();
+  return node_hints.has_hint<hints::graph_capture>() &&
+         !node_hints.has_hint<hints::request_instrumentation_start_timestamp>() &&
+         !node_hints.has_hint<hints::request_instrumentation_finish_timestamp>() &&
+         !node_hints.has_hint<hints::request_instrumentation_hardware_counters>();
+}
+
+common::db::kernel_resource_usage_entry
+query_kernel_resource_usage(const cuda_sscp_executable_object *obj,
+                            std::string_view kernel_name, int device,
+                            std::size_t group_size,
+                            std::size_t local_mem_size) {
+  common::db::kernel_resource_usage_entry usage;
+  usage.kernel_name = std::string{kernel_name};
+  usage.spill_bytes = obj->get_spill_store_bytes(kernel_name);
+
+  CUfunction f;
+  if(!obj->get_kernel(kernel_name, f).is_success())
+    return usage;
+
+  auto get_attribute = [&](CUfunction_attribute attr) -> uint64_t {
+    int value = 0;
+    if(cuFuncGetAttribute(&value, attr, f) != CUDA_SUCCESS || value < 0)
+      return 0;
+    return static_cast<uint64_t>(value);
+  };
+  usage.num_registers = get_attribute(CU_FUNC_ATTRIBUTE_NUM_REGS);
+  usage.private_mem_bytes = get_attribute(CU_FUNC_ATTRIBUTE_LOCAL_SIZE_BYTES);
+  usage.local_mem_bytes = get_attribute(CU_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES);
+  usage.max_group_size = get_attribute(CU_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK);
+
+  int num_blocks = 0;
+  int max_threads_per_sm = 0;
+  if(group_size > 0 &&
+     cuOccupancyMaxActiveBlocksPerMultiprocessor(
+         &num_blocks, f, static_cast<int>(group_size), local_mem_size) ==
+         CUDA_SUCCESS &&
+     cudaDeviceGetAttribute(&max_threads_per_sm,
+                            cudaDevAttrMaxThreadsPerMultiProcessor,
+                            device) == cudaSuccess &&
+     max_threads_per_sm > 0) {
+    usage.occupancy = static_cast<uint64_t>(num_blocks) * group_size * 100 /
+                      static_cast<uint64_t>(max_threads_per_sm);
+    usage.occupancy_group_size = group_size;
+  }
+  return usage;
+}
+
 void host_synchronization_callback(cudaStream_t stream, cudaError_t status,
                                    void *userData) {
   
@@ -90,7 +263,21 @@ public:
             std::make_shared<cuda_submission_timestamp>(profiler_clock::now()));
     }
 
-    if (_node->get_execution_hints().has_hint<
+    cuda_device_timestamps* device_timestamps = _queue->get_device_timestamps();
+    if (device_timestamps &&
+        _node->get_execution_hints().has_hint<
+            rt::hints::request_instrumentation_start_timestamp>()) {
+      device_timestamp_buffer::slot start;
+      auto err = device_timestamps->record(_queue->get_stream(), start);
+      if(err.is_success()) {
+        op.get_instrumentations()
+            .add_instrumentation<instrumentations::execution_start_timestamp>(
+                std::make_shared<cuda_device_execution_start_timestamp>(
+                    device_timestamps->get_buffer(), start));
+      } else {
+        register_error(err);
+      }
+    } else if (_node->get_execution_hints().has_hint<
                 rt::hints::request_instrumentation_start_timestamp>()) {
 
       _task_start = _queue->insert_event();
@@ -106,7 +293,21 @@ public:
     if(!_node)
       return;
     
-    if (_node->get_execution_hints()
+    cuda_device_timestamps* device_timestamps = _queue->get_device_timestamps();
+    if (device_timestamps &&
+        _node->get_execution_hints()
+            .has_hint<rt::hints::request_instrumentation_finish_timestamp>()) {
+      device_timestamp_buffer::slot finish;
+      auto err = device_timestamps->record(_queue->get_stream(), finish);
+      if(err.is_success()) {
+        _operation->get_instrumentations()
+            .add_instrumentation<instrumentations::execution_finish_timestamp>(
+                std::make_shared<cuda_device_execution_finish_timestamp>(
+                    device_timestamps->get_buffer(), finish));
+      } else {
+        register_error(err);
+      }
+    } else if (_node->get_execution_hints()
             .has_hint<rt::hints::request_instrumentation_finish_timestamp>()) {
       std::shared_ptr<dag_node_event> task_finish = _queue->insert_event();
 
@@ -131,28 +332,130 @@ private:
   std::shared_ptr<dag_node_event> _task_start;
 };
 
-result launch_kernel_from_module(CUmodule module,
-                                 std::string_view kernel_name,
+#ifdef HIPSYCL_WITH_CUPTI
+// Collects hardware counters of the kernel launched during the lifetime
+// of the guard, if requested.
+class cuda_hardware_counter_guard {
+public:
+  cuda_hardware_counter_guard(cuda_queue *q, operation &op, dag_node *node)
+      : _queue{q}, _operation{&op} {
+    if (node && node->get_execution_hints()
+                    .has_hint<hints::request_instrumentation_hardware_counters>())
+      _collection = std::make_unique<cuda_hardware_counter_collection>(
+          q->get_device().get_id());
+  }
+
+  ~cuda_hardware_counter_guard() {
+    if(!_collection)
+      return;
+
+    std::shared_ptr<simple_hardware_counters> counters;
+    auto res = _collection->finish(_queue->get_stream(), counters);
+    if(res.is_success()) {
+      _operation->get_instrumentations()
+          .add_instrumentation<instrumentations::hardware_counters>(counters);
+    } else {
+      HIPSYCL_DEBUG_WARNING << "cuda_queue: Could not collect hardware "
+                               "counters: "
+                            << res.what() << std::endl;
+    }
+  }
+
+private:
+  cuda_queue *_queue;
+  operation *_operation;
+  std::unique_ptr<cuda_hardware_counter_collection> _collection;
+};
+#endif
+
+// Determines the number of work groups of a cooperative launch. Fails if
+// more work groups are requested than can be resident on the device
+// simultaneously, unless the cooperative launch permits reducing the number
+// of work groups.
+result get_cooperative_grid_size(CUfunction f,
+                                 const hints::cooperative_launch &cooperative,
                                  const rt::range<3> &grid_size,
                                  const rt::range<3> &block_size,
-                                 unsigned shared_memory, cudaStream_t stream,
-                                 void **kernel_args) {
-  CUfunction f;
-  CUresult err = cuModuleGetFunction(&f, module, kernel_name.data());
-
+                                 unsigned shared_memory,
+                                 rt::range<3> &cooperative_grid_size) {
+  int num_groups_per_sm = 0;
+  CUresult err = cuOccupancyMaxActiveBlocksPerMultiprocessor(
+      &num_groups_per_sm, f, static_cast<int>(block_size.size()),
+      shared_memory);
   if (err != CUDA_SUCCESS) {
     return make_error(__acpp_here(),
-                      error_info{"cuda_queue: could not extract kernel from module",
+                      error_info{"cuda_queue: could not query kernel occupancy",
                                  error_code{"CU", static_cast<int>(err)}});
   }
 
-  err = cuLaunchKernel(f, static_cast<unsigned>(grid_size.get(0)),
-                       static_cast<unsigned>(grid_size.get(1)),
-                       static_cast<unsigned>(grid_size.get(2)),
-                       static_cast<unsigned>(block_size.get(0)),
-                       static_cast<unsigned>(block_size.get(1)),
-                       static_cast<unsigned>(block_size.get(2)),
-                       shared_memory, stream, kernel_args, nullptr);
+  CUdevice dev;
+  int num_sms = 0;
+  err = cuCtxGetDevice(&dev);
+  if (err == CUDA_SUCCESS)
+    err = cuDeviceGetAttribute(&num_sms,
+                               CU_DEVICE_ATTRIBUTE_MULTIPROCESSOR_COUNT, dev);
+  if (err != CUDA_SUCCESS) {
+    return make_error(
+        __acpp_here(),
+        error_info{"cuda_queue: could not query multiprocessor count",
+                   error_code{"CU", static_cast<int>(err)}});
+  }
+
+  const std::size_t max_num_groups =
+      static_cast<std::size_t>(num_groups_per_sm) * num_sms;
+  cooperative_grid_size = grid_size;
+  if (grid_size.size() <= max_num_groups)
+    return make_success();
+
+  const std::size_t num_groups_yz = grid_size.get(1) * grid_size.get(2);
+  if (!cooperative.limits_num_groups() || num_groups_yz > max_num_groups) {
+    return make_error(
+        __acpp_here(),
+        error_info{"cuda_queue: cooperative launch of " +
+                   std::to_string(grid_size.size()) +
+                   " work groups exceeds the maximum number of " +
+                   std::to_string(max_num_groups) +
+                   " simultaneously resident work groups"});
+  }
+  cooperative_grid_size[0] = max_num_groups / num_groups_yz;
+  return make_success();
+}
+
+// If extra is not nullptr, it contains the kernel arguments as packed buffer
+// (see cuLaunchKernel()), and kernel_args is ignored.
+result launch_kernel(CUfunction f, const rt::range<3> &grid_size,
+                     const rt::range<3> &block_size, unsigned shared_memory,
+                     cudaStream_t stream, void **kernel_args, void **extra,
+                     const hints::cooperative_launch *cooperative) {
+  CUresult err;
+  if (cooperative) {
+    // cuLaunchCooperativeKernel() does not support packed arguments
+    assert(!extra);
+    rt::range<3> cooperative_grid_size;
+    auto grid_err = get_cooperative_grid_size(f, *cooperative, grid_size,
+                                              block_size, shared_memory,
+                                              cooperative_grid_size);
+    if (!grid_err.is_success())
+      return grid_err;
+
+    err = cuLaunchCooperativeKernel(
+        f, static_cast<unsigned>(cooperative_grid_size.get(0)),
+        static_cast<unsigned>(cooperative_grid_size.get(1)),
+        static_cast<unsigned>(cooperative_grid_size.get(2)),
+        static_cast<unsigned>(block_size.get(0)),
+        static_cast<unsigned>(block_size.get(1)),
+        static_cast<unsigned>(block_size.get(2)), shared_memory, stream,
+        kernel_args);
+  } else {
+    err = cuLaunchKernel(f, static_cast<unsigned>(grid_size.get(0)),
+                         static_cast<unsigned>(grid_size.get(1)),
+                         static_cast<unsigned>(grid_size.get(2)),
+                         static_cast<unsigned>(block_size.get(0)),
+                         static_cast<unsigned>(block_size.get(1)),
+                         static_cast<unsigned>(block_size.get(2)),
+                         shared_memory, stream, extra ? nullptr : kernel_args,
+                         extra);
+  }
 
   if (err != CUDA_SUCCESS) {
     return make_error(__acpp_here(),
@@ -162,20 +465,75 @@ result launch_kernel_from_module(CUmodule module,
   
   return make_success();
 }
+
+result launch_kernel_from_module(const cuda_executable_object *obj,
+                                 std::string_view kernel_name,
+                                 const rt::range<3> &grid_size,
+                                 const rt::range<3> &block_size,
+                                 unsigned shared_memory, cudaStream_t stream,
+                                 void **kernel_args, void **extra,
+                                 const hints::cooperative_launch *cooperative) {
+  CUfunction f;
+  result err = obj->get_kernel(kernel_name, f);
+
+  if (!err.is_success())
+    return err;
+
+  return launch_kernel(f, grid_size, block_size, shared_memory, stream,
+                       kernel_args, extra, cooperative);
+}
+}
+
+
+void **cuda_queue::pack_sscp_kernel_args() {
+  if (_packed_args_threshold == 0 || _cooperative_launch ||
+      _arg_mapper.get_mapped_num_args() < _packed_args_threshold)
+    return nullptr;
+
+  // The buffer is reused across launches, so packing does not allocate
+  // once it has grown to the largest argument size.
+  _packed_args_size = _arg_mapper.pack_mapped_args(_packed_args);
+  _packed_args_launch_config[0] = CU_LAUNCH_PARAM_BUFFER_POINTER;
+  _packed_args_launch_config[1] = _packed_args.data();
+  _packed_args_launch_config[2] = CU_LAUNCH_PARAM_BUFFER_SIZE;
+  _packed_args_launch_config[3] = &_packed_args_size;
+  _packed_args_launch_config[4] = CU_LAUNCH_PARAM_END;
+  return _packed_args_launch_config;
 }
 
+cuda_device_timestamps* cuda_queue::get_device_timestamps() const {
+  return _backend->get_device_timestamps(_dev);
+}
 
 void cuda_queue::activate_device() const {
   cuda_device_manager::get().activate_device(_dev.get_id());
 }
 
 cuda_queue::cuda_queue(cuda_backend *be, device_id dev, int priority)
+    : cuda_queue{be, dev, priority, 0} {}
+
+cuda_queue::cuda_queue(cuda_backend *be, device_id dev, int priority,
+                       std::size_t num_compute_units)
     : _dev{dev}, _stream{nullptr},
       _multipass_code_object_invoker{this},
       _sscp_code_object_invoker{this}, _backend{be},
-      _kernel_cache{kernel_cache::get()} {
+      _kernel_cache{kernel_cache::get()},
+      _packed_args_threshold{application::get_settings()
+                                 .get<setting::cuda_packed_kernel_args>()},
+      _is_capturing_graph{false}, _graph_capture_id{0} {
   this->activate_device();
 
+  if(num_compute_units > 0) {
+    if(create_partitioned_stream(priority, num_compute_units)) {
+      _reference_event = host_timestamped_event{this};
+      return;
+    }
+    HIPSYCL_DEBUG_WARNING
+        << "cuda_queue: Could not restrict queue to " << num_compute_units
+        << " SMs, falling back to a stream using the entire device"
+        << std::endl;
+  }
+
   cudaError_t err;
   if(priority == 0) {
     err = cudaStreamCreateWithFlags(&_stream, cudaStreamNonBlocking);
@@ -196,16 +554,146 @@ cuda_queue::cuda_queue(cuda_backend *be, device_id dev, int priority)
 CUstream_st* cuda_queue::get_stream() const { return _stream; }
 
 cuda_queue::~cuda_queue() {
+  {
+    std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+    auto capture_err = end_graph_capture();
+    if(!capture_err.is_success())
+      register_error(capture_err);
+  }
+  for(auto& graph_exec : _graph_execs) {
+    if(graph_exec.second)
+      cudaGraphExecDestroy(graph_exec.second);
+  }
+
   auto err = cudaStreamDestroy(_stream);
   if (err != cudaSuccess) {
     register_error(__acpp_here(),
                    error_info{"cuda_queue: Couldn't destroy stream",
                               error_code{"CUDA", err}});
   }
+#if CUDA_VERSION >= 12040
+  if(_green_ctx) {
+    CUresult green_ctx_err = cuGreenCtxDestroy(_green_ctx);
+    if(green_ctx_err != CUDA_SUCCESS) {
+      register_error(__acpp_here(),
+                     error_info{"cuda_queue: Couldn't destroy green context",
+                                error_code{"CU", static_cast<int>(green_ctx_err)}});
+    }
+  }
+#endif
+}
+
+#if CUDA_VERSION >= 12040
+namespace {
+
+// SMs that are not yet used by partitioned queues of each device, such that
+// partitions of different queues are disjoint as long as enough SMs remain.
+class sm_partition_registry {
+public:
+  static sm_partition_registry& get() {
+    static sm_partition_registry r;
+    return r;
+  }
+
+  // Stores an SM resource with at least num_sms SMs in result
+  CUresult carve(CUdevice dev, unsigned num_sms, CUdevResource &result) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _remaining.find(dev);
+    if(it == _remaining.end()) {
+      CUdevResource all_sms;
+      CUresult err =
+          cuDeviceGetDevResource(dev, &all_sms, CU_DEV_RESOURCE_TYPE_SM);
+      if(err != CUDA_SUCCESS)
+        return err;
+      it = _remaining.emplace(dev, all_sms).first;
+    }
+
+    if(it->second.sm.smCount >= num_sms) {
+      unsigned num_groups = 1;
+      CUdevResource remaining;
+      CUresult err = cuDevSmResourceSplitByCount(
+          &result, &num_groups, &it->second, &remaining, 0, num_sms);
+      if(err == CUDA_SUCCESS && num_groups == 1) {
+        it->second = remaining;
+        return CUDA_SUCCESS;
+      }
+    }
+
+    // Not enough unused SMs left; share SMs of the entire device with
+    // other partitions instead.
+    HIPSYCL_DEBUG_WARNING << "cuda_queue: Not enough unused SMs left for "
+                             "partition of "
+                          << num_sms
+                          << " SMs, partition will overlap with other queues"
+                          << std::endl;
+    CUdevResource all_sms;
+    CUresult err =
+        cuDeviceGetDevResource(dev, &all_sms, CU_DEV_RESOURCE_TYPE_SM);
+    if(err != CUDA_SUCCESS)
+      return err;
+    unsigned num_groups = 1;
+    return cuDevSmResourceSplitByCount(&result, &num_groups, &all_sms,
+                                       nullptr, 0, num_sms);
+  }
+private:
+  std::mutex _mutex;
+  std::unordered_map<CUdevice, CUdevResource> _remaining;
+};
+
+}
+#endif
+
+bool cuda_queue::create_partitioned_stream(int priority,
+                                           std::size_t num_compute_units) {
+#if CUDA_VERSION >= 12040
+  CUdevice dev;
+  CUresult err = cuDeviceGet(&dev, _dev.get_id());
+  if(err != CUDA_SUCCESS)
+    return false;
+
+  CUdevResource sms;
+  err = sm_partition_registry::get().carve(
+      dev, static_cast<unsigned>(num_compute_units), sms);
+  if(err != CUDA_SUCCESS)
+    return false;
+
+  CUdevResourceDesc desc;
+  err = cuDevResourceGenerateDesc(&desc, &sms, 1);
+  if(err != CUDA_SUCCESS)
+    return false;
+
+  CUgreenCtx green_ctx;
+  err = cuGreenCtxCreate(&green_ctx, desc, dev, CU_GREEN_CTX_DEFAULT_STREAM);
+  if(err != CUDA_SUCCESS)
+    return false;
+
+  CUstream stream;
+  err = cuGreenCtxStreamCreate(&stream, green_ctx, CU_STREAM_NON_BLOCKING,
+                               priority);
+  if(err != CUDA_SUCCESS) {
+    cuGreenCtxDestroy(green_ctx);
+    return false;
+  }
+
+  HIPSYCL_DEBUG_INFO << "cuda_queue: Created stream restricted to "
+                     << sms.sm.smCount << " SMs" << std::endl;
+  _green_ctx = green_ctx;
+  _stream = stream;
+  return true;
+#else
+  return false;
+#endif
 }
 
 /// Inserts an event into the stream
 std::shared_ptr<dag_node_event> cuda_queue::insert_event() {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success()) {
+    register_error(capture_err);
+    return nullptr;
+  }
+
   cudaEvent_t evt;
   auto event_creation_result =
       _backend->get_event_pool(_dev)->obtain_event(evt);
@@ -222,8 +710,10 @@ std::shared_ptr<dag_node_event> cuda_queue::insert_event() {
     return nullptr;
   }
 
-  return std::make_shared<cuda_node_event>(_dev, evt,
-                                           _backend->get_event_pool(_dev));
+  // Events are created for most operations, so their storage is recycled
+  return std::allocate_shared<cuda_node_event>(
+      object_pool_allocator<cuda_node_event>{}, _dev, evt,
+      _backend->get_event_pool(_dev));
 }
 
 std::shared_ptr<dag_node_event> cuda_queue::create_queue_completion_event() {
@@ -290,9 +780,35 @@ result cuda_queue::submit_memcpy(memcpy_operation & op, const dag_node_ptr& node
 
   assert(dimension >= 1 && dimension <= 3);
 
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  // Only device-to-device copies are captured, since copies from pageable
+  // host memory are not supported in graphs.
+  auto capture_err = update_graph_capture(
+      node, copy_kind == cudaMemcpyDeviceToDevice);
+  if(!capture_err.is_success())
+    return capture_err;
 
   cuda_instrumentation_guard instrumentation{this, op, node.get()};
 
+  if (dimension == 1 && (copy_kind == cudaMemcpyHostToDevice ||
+                         copy_kind == cudaMemcpyDeviceToHost)) {
+    staging_buffer_pool *pool = _backend->get_staging_buffer_pool(_dev);
+    void *host_ptr = copy_kind == cudaMemcpyHostToDevice
+                         ? op.source().get_access_ptr()
+                         : op.dest().get_access_ptr();
+    if (pool->is_enabled() &&
+        op.get_num_transferred_bytes() >= pool->get_buffer_size() &&
+        is_pageable_host_memory(_backend->get_allocator(_dev), host_ptr)) {
+      bool is_staged = false;
+      auto staging_result = submit_staged_memcpy(
+          get_stream(), _backend->get_event_pool(_dev), pool,
+          op.dest().get_access_ptr(), op.source().get_access_ptr(),
+          op.get_num_transferred_bytes(), copy_kind, is_staged);
+      if (!staging_result.is_success() || is_staged)
+        return staging_result;
+    }
+  }
+
   cudaError_t err = cudaSuccess;
   if (dimension == 1) {
     err = cudaMemcpyAsync(
@@ -347,17 +863,35 @@ result cuda_queue::submit_kernel(kernel_operation &op, const dag_node_ptr& node)
 
   this->activate_device();
 
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  _pending_group_size_key.reset();
+  _pending_autotuning_key.reset();
+  _cooperative_launch =
+      node ? node->get_execution_hints().get_hint<hints::cooperative_launch>()
+           : nullptr;
+  // Cooperative launches cannot be recorded into graphs
+  auto capture_err = update_graph_capture(node, !_cooperative_launch);
+  if(!capture_err.is_success())
+    return capture_err;
+
   rt::backend_kernel_launch_capabilities cap;
   cap.provide_multipass_invoker(&_multipass_code_object_invoker);
   cap.provide_sscp_invoker(&_sscp_code_object_invoker);
   
   cuda_instrumentation_guard instrumentation{this, op, node.get()};
+#ifdef HIPSYCL_WITH_CUPTI
+  cuda_hardware_counter_guard counters{this, op, node.get()};
+#endif
   return op.get_launcher().invoke(backend_id::cuda, this, cap, node.get());
 }
 
 result cuda_queue::submit_prefetch(prefetch_operation& op, const dag_node_ptr& node) {
 #ifndef _WIN32
-  
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = update_graph_capture(node, false);
+  if(!capture_err.is_success())
+    return capture_err;
+
   cudaError_t err = cudaSuccess;
   
   cuda_instrumentation_guard instrumentation{this, op, node.get()};
@@ -384,6 +918,11 @@ result cuda_queue::submit_prefetch(prefetch_operation& op, const dag_node_ptr& n
 
 result cuda_queue::submit_memset(memset_operation &op, const dag_node_ptr& node) {
 
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = update_graph_capture(node, true);
+  if(!capture_err.is_success())
+    return capture_err;
+
   cuda_instrumentation_guard instrumentation{this, op, node.get()};
   
   cudaError_t err = cudaMemsetAsync(op.get_pointer(), op.get_pattern(),
@@ -402,6 +941,11 @@ result cuda_queue::submit_memset(memset_operation &op, const dag_node_ptr& node)
 /// Causes the queue to wait until an event on another queue has occured.
 /// the other queue must be from the same backend
 result cuda_queue::submit_queue_wait_for(const dag_node_ptr& node) {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success())
+    return capture_err;
+
   auto evt = node->get_event();
   assert(dynamic_is<inorder_queue_event<cudaEvent_t>>(evt.get()));
 
@@ -419,6 +963,10 @@ result cuda_queue::submit_queue_wait_for(const dag_node_ptr& node) {
 }
 
 result cuda_queue::submit_external_wait_for(const dag_node_ptr& node) {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success())
+    return capture_err;
 
   dag_node_ptr* user_data = new dag_node_ptr;
   assert(user_data);
@@ -438,8 +986,22 @@ result cuda_queue::submit_external_wait_for(const dag_node_ptr& node) {
 }
 
 result cuda_queue::wait() {
+  {
+    std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+    auto capture_err = end_graph_capture();
+    if(!capture_err.is_success())
+      return capture_err;
+  }
+
+  static wait_duration_predictor predictor;
+  static const uint64_t max_spin_ns =
+      1000 * application::get_settings().get<setting::max_wait_spin_time>();
 
-  auto err = cudaStreamSynchronize(_stream);
+  cudaError_t err = cudaSuccess;
+  hybrid_wait(
+      predictor, max_spin_ns,
+      [this]() { return cudaStreamQuery(_stream) != cudaErrorNotReady; },
+      [&]() { err = cudaStreamSynchronize(_stream); });
 
   if(err != cudaSuccess) {
     return make_error(__acpp_here(),
@@ -535,8 +1097,14 @@ result cuda_queue::submit_multipass_kernel_from_code_object(
                       error_info{"cuda_queue: Code object construction failed"});
   }
 
-  CUmodule cumodule = static_cast<const cuda_executable_object*>(obj)->get_module();
-  assert(cumodule);
+  const auto *cuda_obj = static_cast<const cuda_executable_object *>(obj);
+  assert(cuda_obj->get_module());
+
+  if(launch_cache_id.has_value()) {
+    CUfunction f;
+    if (cuda_obj->get_kernel(kernel_name, f).is_success())
+      _sscp_launch_cache.insert(launch_cache_id.value(), obj, f);
+  }
 
   // Need to find out full backend kernel name. This is necessary because
   // we don't know the *exact* kernel name until we know that we are in the clang 13+
@@ -553,9 +1121,9 @@ result cuda_queue::submit_multipass_kernel_from_code_object(
                       error_info{"cuda_queue: Could not discover full kernel "
                                  "name from partial backend kernel name"});
 
-  return launch_kernel_from_module(cumodule, full_kernel_name, grid_size,
+  return launch_kernel_from_module(cuda_obj, full_kernel_name, grid_size,
                                    block_size, dynamic_shared_mem, _stream,
-                                   kernel_args);
+                                   kernel_args, nullptr, _cooperative_launch);
 }
 
 result cuda_queue::submit_sscp_kernel_from_code_object(
@@ -597,7 +1165,27 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
 
   kernel_adaptivity_engine adaptivity_engine{
       hcf_object, kernel_name, kernel_info, _arg_mapper, num_groups,
-      group_size, args,        arg_sizes,   num_args, local_mem_size};
+      group_size, args,        arg_sizes,   num_args, local_mem_size,
+      _backend->get_allocator(_dev)};
+
+  std::optional<kernel_configuration::id_type> launch_cache_id;
+  // Launches that still determine their group size can not be cached
+  if(!_pending_group_size_key.has_value() && !_pending_autotuning_key.has_value())
+    launch_cache_id = adaptivity_engine.get_launch_cache_id(initial_config);
+  if(launch_cache_id.has_value()) {
+    if(const auto* cached_launch = _sscp_launch_cache.find(launch_cache_id.value())) {
+      const code_object* obj = cached_launch->obj;
+      if(obj->get_jit_output_metadata().kernel_retained_arguments_indices.has_value()) {
+        _arg_mapper.apply_dead_argument_elimination_mask(
+            obj->get_jit_output_metadata()
+                .kernel_retained_arguments_indices.value());
+      }
+      return launch_kernel(cached_launch->kernel, num_groups, group_size,
+                           local_mem_size, _stream,
+                           _arg_mapper.get_mapped_args(),
+                           pack_sscp_kernel_args(), _cooperative_launch);
+    }
+  }
 
   _config = initial_config;
   _config.append_base_configuration(
@@ -606,7 +1194,8 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
       kernel_base_config_parameter::compilation_flow,
       compilation_flow::sscp);
   _config.append_base_configuration(
-      kernel_base_config_parameter::hcf_object_id, hcf_object);
+      kernel_base_config_parameter::hcf_object_id,
+      adaptivity_engine.get_code_identity());
   
   for(const auto& flag : kernel_info->get_compilation_flags())
     _config.set_build_flag(flag);
@@ -619,44 +1208,63 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
   _config.set_build_option(kernel_build_option::ptx_target_device,
                           compute_capability);
 
-  auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_device, device);
+  kernel_configuration::id_type binary_configuration_id;
+  kernel_configuration::id_type code_object_configuration_id;
+  auto select_configuration_id = [&](kernel_configuration::id_type binary_id) {
+    binary_configuration_id = binary_id;
+    code_object_configuration_id = binary_id;
+    kernel_configuration::extend_hash(
+        code_object_configuration_id,
+        kernel_base_config_parameter::runtime_device, device);
+  };
+  select_configuration_id(
+      adaptivity_engine.finalize_binary_configuration(_config));
 
   auto get_image_and_kernel_names =
       [&](std::vector<std::string> &contained_kernels) -> std::string {
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
-    
+  // Returns a self-contained JIT compiler for the currently selected
+  // configuration, which can also be executed on a background thread.
+  auto make_jit_compiler = [&]() {
     std::vector<std::string> kernel_names;
     std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
-    // Construct PTX translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      compiler::createLLVMToPtxTranslator(kernel_names);
+    return [=, config = _config](std::string &compiled_image) -> bool {
+      // Construct PTX translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
+        compiler::createLLVMToPtxTranslator(kernel_names);
+
+      // Lower kernels to PTX
+      rt::result err;
+      if(kernel_names.size() == 1) {
+        err = glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_configuration_id, compiled_image);
+      } else {
+        err = glue::jit::compile(translator.get(),
+          hcf_object, selected_image_name, config, compiled_image);
+      }
 
-    // Lower kernels to PTX
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, compiled_image);
-    } else {
-      err = glue::jit::compile(translator.get(),
-        hcf_object, selected_image_name, _config, compiled_image);
-    }
+      if(!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      glue::jit::precompilation::record_recipe(
+          binary_configuration_id, backend_id::cuda, hcf_object,
+          selected_image_name, kernel_names, config,
+          kernel_names.size() == 1);
+      return true;
+    };
+  };
 
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+    return make_jit_compiler()(compiled_image);
   };
 
+  // Takes a std::string instead of a std::string_view, because
+  // cuModuleLoadDataEx() requires PTX to be null-terminated.
   auto code_object_constructor = [&](const std::string& ptx_image) -> code_object* {
 
     std::vector<std::string> kernel_names;
@@ -683,12 +1291,32 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
           glue::jit::dead_argument_elimination::
               retrieve_retained_arguments_mask(binary_configuration_id);
 
+    auto usage = query_kernel_resource_usage(
+        exec_obj, kernel_name, device, group_size.size(), local_mem_size);
+    _kernel_cache->record_kernel_resource_usage(binary_configuration_id, usage);
+    exec_obj->get_jit_output_metadata().kernel_resource_usage.push_back(usage);
+
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id,
-      jit_compiler, code_object_constructor);
+  const code_object *obj = nullptr;
+  if(adaptivity_engine.has_fallback_configuration()) {
+    obj = _kernel_cache->get_or_schedule_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if(!obj) {
+      // The specialized binary is still being compiled; use the less
+      // specialized configuration in the meantime.
+      _config = adaptivity_engine.get_fallback_configuration();
+      select_configuration_id(
+          adaptivity_engine.get_fallback_configuration_id());
+    }
+  }
+
+  if(!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        jit_compiler, code_object_constructor);
 
   if(!obj) {
     return make_error(__acpp_here(),
@@ -700,12 +1328,53 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
         obj->get_jit_output_metadata()
             .kernel_retained_arguments_indices.value());
   }
-  CUmodule cumodule = static_cast<const cuda_executable_object*>(obj)->get_module();
-  assert(cumodule);
+  const auto *cuda_obj = static_cast<const cuda_executable_object *>(obj);
+  assert(cuda_obj->get_module());
+
+  if(_pending_group_size_key.has_value()) {
+    CUfunction f;
+    int min_grid_size = 0;
+    int block_size = 0;
+    if (cuda_obj->get_kernel(kernel_name, f).is_success() &&
+        cuOccupancyMaxPotentialBlockSize(&min_grid_size, &block_size, f,
+                                         nullptr, local_mem_size,
+                                         0) == CUDA_SUCCESS &&
+        block_size > 0) {
+      group_size_cache::get().store(
+          _pending_group_size_key.value(),
+          group_size_cache::make_group_size(
+              block_size, group_size_cache::get_dimension(group_size)));
+    }
+    _pending_group_size_key.reset();
+  }
 
-  return launch_kernel_from_module(cumodule, kernel_name, num_groups,
-                                   group_size, local_mem_size, _stream,
-                                   _arg_mapper.get_mapped_args());
+  std::shared_ptr<dag_node_event> autotuning_start;
+  if(_pending_autotuning_key.has_value())
+    autotuning_start = insert_event();
+
+  auto launch_err = launch_kernel_from_module(
+      cuda_obj, kernel_name, num_groups, group_size, local_mem_size, _stream,
+      _arg_mapper.get_mapped_args(), pack_sscp_kernel_args(),
+      _cooperative_launch);
+
+  if(_pending_autotuning_key.has_value()) {
+    if(launch_err.is_success()) {
+      auto autotuning_finish = insert_event();
+      group_size_autotuner::get().add_measurement(
+          _pending_autotuning_key.value(), group_size,
+          group_size_autotuner::measurement{
+              autotuning_finish,
+              std::make_shared<cuda_execution_start_timestamp>(
+                  _reference_event, autotuning_start),
+              std::make_shared<cuda_execution_finish_timestamp>(
+                  _reference_event, autotuning_start, autotuning_finish)});
+    } else {
+      group_size_autotuner::get().discard_candidate(
+          _pending_autotuning_key.value(), group_size);
+    }
+    _pending_autotuning_key.reset();
+  }
+  return launch_err;
 
 #else
   return make_error(
@@ -716,6 +1385,41 @@ result cuda_queue::submit_sscp_kernel_from_code_object(
 #endif
 }
 
+rt::range<3> cuda_queue::select_sscp_group_size(
+    const rt::range<3> &global_range, const rt::range<3> &default_group_size,
+    hcf_object_id hcf_object, std::string_view kernel_name) {
+  cuda_hardware_context *ctx = static_cast<cuda_hardware_context *>(
+      this->_backend->get_hardware_manager()->get_device(_dev.get_id()));
+
+  auto key = group_size_cache::get_key(
+      backend_id::cuda, hcf_object, kernel_name, ctx->get_device_name(),
+      group_size_cache::get_dimension(global_range));
+
+  auto cached_group_size = group_size_cache::get().get(key);
+
+  // Timing events cannot be recorded while capturing graphs
+  if (group_size_autotuner::is_enabled() && !_is_capturing_graph &&
+      !(cached_group_size.has_value() && cached_group_size->is_autotuned)) {
+    auto candidate = group_size_autotuner::get().select_candidate(
+        key, global_range,
+        ctx->get_property(device_uint_property::max_group_size));
+    if(candidate.has_value()) {
+      _pending_autotuning_key = key;
+      return candidate.value();
+    }
+  }
+
+  if(cached_group_size.has_value()) {
+    // Prefer the default for small problem sizes, where the cached group size
+    // would leave work items without work.
+    if(global_range.size() >= cached_group_size->group_size.size())
+      return cached_group_size->group_size;
+    return default_group_size;
+  }
+  _pending_group_size_key = key;
+  return default_group_size;
+}
+
 device_id cuda_queue::get_device() const {
   return _dev;
 }
@@ -728,7 +1432,35 @@ cuda_multipass_code_object_invoker::cuda_multipass_code_object_invoker(
     cuda_queue *q)
     : _queue{q} {}
 
+result cuda_queue::submit_completion_callback(void (*callback)(void *),
+                                              void *user_data) {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  // The callback would otherwise become part of the captured graph
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success())
+    return capture_err;
+
+  this->activate_device();
+  auto err = cudaLaunchHostFunc(_stream, callback, user_data);
+  if (err != cudaSuccess) {
+    return make_error(
+        __acpp_here(),
+        error_info{"cuda_queue: Couldn't submit completion callback",
+                   error_code{"CUDA", err}});
+  }
+  return make_success();
+}
+
 result cuda_queue::query_status(inorder_queue_status &status) {
+  {
+    // Querying a capturing stream is not allowed. Captured operations
+    // have not been launched yet, so they cannot be complete.
+    std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+    if(_is_capturing_graph) {
+      status = inorder_queue_status{false};
+      return make_success();
+    }
+  }
   auto err = cudaStreamQuery(_stream);
   if(err == cudaSuccess) {
     status = inorder_queue_status{true};
@@ -743,6 +1475,96 @@ result cuda_queue::query_status(inorder_queue_status &status) {
   return make_success();
 }
 
+result cuda_queue::update_graph_capture(const dag_node_ptr &node,
+                                        bool is_capturable) {
+  bool capture_node = is_capturable && may_capture_graph(node);
+
+  if(_is_capturing_graph) {
+    if (capture_node &&
+        node->get_execution_hints().get_hint<hints::graph_capture>()->get_id() ==
+            _graph_capture_id)
+      return make_success();
+
+    auto err = end_graph_capture();
+    if(!err.is_success())
+      return err;
+  }
+
+  if(capture_node) {
+    // Relaxed mode, since other threads might need to carry out
+    // e.g. allocations while we are capturing.
+    auto err = cudaStreamBeginCapture(_stream, cudaStreamCaptureModeRelaxed);
+    if(err != cudaSuccess) {
+      HIPSYCL_DEBUG_WARNING
+          << "cuda_queue: Could not begin graph capture, submitting operations "
+             "directly: "
+          << cudaGetErrorString(err) << std::endl;
+      return make_success();
+    }
+    _is_capturing_graph = true;
+    _graph_capture_id =
+        node->get_execution_hints().get_hint<hints::graph_capture>()->get_id();
+  }
+  return make_success();
+}
+
+result cuda_queue::end_graph_capture() {
+  if(!_is_capturing_graph)
+    return make_success();
+  _is_capturing_graph = false;
+
+  cudaGraph_t graph;
+  auto err = cudaStreamEndCapture(_stream, &graph);
+  if(err != cudaSuccess) {
+    return make_error(__acpp_here(),
+                      error_info{"cuda_queue: Could not end graph capture",
+                                 error_code{"CUDA", err}});
+  }
+
+  cudaGraphExec_t& graph_exec = _graph_execs[_graph_capture_id];
+  if(graph_exec) {
+    // Try to update the previously instantiated graph with the parameters
+    // of the new capture; this only succeeds if the topology is unchanged.
+#if CUDART_VERSION >= 12000
+    cudaGraphExecUpdateResultInfo update_info;
+    err = cudaGraphExecUpdate(graph_exec, graph, &update_info);
+#else
+    cudaGraphNode_t error_node;
+    cudaGraphExecUpdateResult update_result;
+    err = cudaGraphExecUpdate(graph_exec, graph, &error_node, &update_result);
+#endif
+    if(err != cudaSuccess) {
+      HIPSYCL_DEBUG_INFO << "cuda_queue: Captured graph for capture id "
+                         << _graph_capture_id
+                         << " has changed, instantiating new graph"
+                         << std::endl;
+      cudaGraphExecDestroy(graph_exec);
+      graph_exec = nullptr;
+    }
+  }
+
+  if(!graph_exec) {
+    err = cudaGraphInstantiateWithFlags(&graph_exec, graph, 0);
+    if(err != cudaSuccess) {
+      graph_exec = nullptr;
+      cudaGraphDestroy(graph);
+      return make_error(__acpp_here(),
+                        error_info{"cuda_queue: Could not instantiate graph",
+                                   error_code{"CUDA", err}});
+    }
+  }
+
+  err = cudaGraphLaunch(graph_exec, _stream);
+  cudaGraphDestroy(graph);
+  if(err != cudaSuccess) {
+    return make_error(__acpp_here(),
+                      error_info{"cuda_queue: Could not launch graph",
+                                 error_code{"CUDA", err}});
+  }
+
+  return make_success();
+}
+
 result cuda_multipass_code_object_invoker::submit_kernel(
     const kernel_operation& op,
     hcf_object_id hcf_object,
@@ -776,6 +1598,14 @@ result cuda_sscp_code_object_invoker::submit_kernel(
       op, hcf_object, kernel_name, kernel_info, num_groups, group_size,
       local_mem_size, args, arg_sizes, num_args, config);
 }
+
+rt::range<3> cuda_sscp_code_object_invoker::select_group_size(
+    const rt::range<3> &global_range, const rt::range<3> &group_size,
+    hcf_object_id hcf_object, std::string_view kernel_name) const {
+  auto default_group_size = sscp_code_object_invoker::select_group_size(
+      global_range, group_size, hcf_object, kernel_name);
+  return _queue->select_sscp_group_size(global_range, default_group_size,
+                                        hcf_object, kernel_name);
+}
 }
 }
-
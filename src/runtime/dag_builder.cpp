@@ -13,11 +13,16 @@
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/dag_builder.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 #include "hipSYCL/sycl/access.hpp"
 
+#include <algorithm>
 #include <mutex>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 // TODO: Implement the following optimization:
 // - Reorder requirements such that larger accesses come first. This will cause
@@ -130,6 +135,120 @@ void add_to_data_users(dag_node_ptr node, const requirements_list& reqs)
   }
 }
 
+// Locks the user trackers of all data regions that are accessed by op
+// and its requirements. Locks are acquired in address order to
+// prevent deadlocks between concurrent submissions.
+common::auto_small_vector<std::unique_lock<std::mutex>>
+lock_data_regions(operation *op, const requirements_list &reqs) {
+  common::auto_small_vector<data_user_tracker *> trackers;
+
+  auto add_tracker = [&](operation* req_op) {
+    if(req_op->is_requirement() &&
+       cast<requirement>(req_op)->is_memory_requirement()) {
+      auto *mem_req = cast<memory_requirement>(req_op);
+      if(mem_req->is_buffer_requirement())
+        trackers.push_back(&cast<buffer_memory_requirement>(mem_req)
+                                ->get_data_region()
+                                ->get_users());
+    }
+  };
+
+  add_tracker(op);
+  for(const dag_node_ptr& req : reqs.get())
+    add_tracker(req->get_operation());
+
+  std::sort(trackers.begin(), trackers.end());
+  trackers.erase(std::unique(trackers.begin(), trackers.end()),
+                 trackers.end());
+
+  common::auto_small_vector<std::unique_lock<std::mutex>> locks;
+  for(auto* tracker : trackers)
+    locks.emplace_back(tracker->get_dependency_analysis_mutex());
+  return locks;
+}
+
+bool is_discard_access(sycl::access::mode mode) {
+  return mode == sycl::access::mode::discard_write ||
+         mode == sycl::access::mode::discard_read_write;
+}
+
+bool contains_range(const buffer_memory_requirement *outer,
+                    const buffer_memory_requirement *inner) {
+  auto outer_offset = outer->get_access_offset3d();
+  auto outer_range = outer->get_access_range3d();
+  auto inner_offset = inner->get_access_offset3d();
+  auto inner_range = inner->get_access_range3d();
+
+  for(int i = 0; i < 3; ++i) {
+    if(inner_offset[i] < outer_offset[i])
+      return false;
+    if(inner_offset[i] + inner_range[i] > outer_offset[i] + outer_range[i])
+      return false;
+  }
+  return true;
+}
+
+// Write-only accesses do not observe the previous content of the data,
+// but still require it to be migrated since elements that the kernel does not
+// write must be preserved. If the entire range is discarded by a later
+// access of the same DAG before anything reads it, these elements can never
+// be observed, and the access can be turned into a discard access.
+void upgrade_overwritten_requirements_to_discard(const dag &d) {
+  std::unordered_map<buffer_data_region *,
+                     std::vector<buffer_memory_requirement *>>
+      accesses;
+
+  auto add_access = [&](operation *op) {
+    if(op->is_requirement() &&
+       cast<requirement>(op)->is_memory_requirement()) {
+      auto *mem_req = cast<memory_requirement>(op);
+      if(mem_req->is_buffer_requirement()) {
+        auto *buff_req = cast<buffer_memory_requirement>(mem_req);
+        accesses[buff_req->get_data_region().get()].push_back(buff_req);
+      }
+    }
+  };
+
+  // Command groups are stored in submission order
+  for(const dag_node_ptr &node : d.get_command_groups()) {
+    add_access(node->get_operation());
+    for(auto weak_req : node->get_requirements())
+      if(auto req = weak_req.lock())
+        add_access(req->get_operation());
+  }
+
+  for(auto &region_accesses : accesses) {
+    auto &reqs = region_accesses.second;
+    for(std::size_t i = 0; i < reqs.size(); ++i) {
+      if(reqs[i]->get_access_mode() != sycl::access::mode::write)
+        continue;
+
+      for(std::size_t j = i + 1; j < reqs.size(); ++j) {
+        if(!reqs[j]->intersects_with(reqs[i]))
+          continue;
+
+        sycl::access::mode mode = reqs[j]->get_access_mode();
+        if(is_discard_access(mode) && contains_range(reqs[j], reqs[i])) {
+          HIPSYCL_DEBUG_INFO
+              << "dag_builder: Upgrading write requirement on data region "
+              << region_accesses.first
+              << " to discard_write, since it is overwritten by a later "
+                 "discard access"
+              << std::endl;
+          reqs[i]->set_access_mode(sycl::access::mode::discard_write);
+          runtime_statistics::get().add(
+              statistic::discard_upgraded_requirements);
+          break;
+        }
+        // Other write-only or discard accesses do not observe the data
+        // either and can be skipped, anything else might read it.
+        if(mode != sycl::access::mode::write && !is_discard_access(mode))
+          break;
+      }
+    }
+  }
+}
+
 }
 
 
@@ -144,6 +263,7 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
                                      const requirements_list& requirements,
                                      const execution_hints& hints)
 {
+  trace_span span{"dag_builder"};
   assert(op);
 
   // Calculate additional requirements:
@@ -180,7 +300,7 @@ dag_node_ptr dag_builder::build_node(std::unique_ptr<operation> op,
     }
   };
 
-  auto operation_node = std::make_shared<dag_node>(
+  auto operation_node = make_dag_node(
       hints, requirements.get(), std::move(op), _rt);
   
   bool is_req = operation_node->get_operation()->is_requirement();
@@ -218,10 +338,17 @@ dag_builder::add_command_group(std::unique_ptr<operation> op,
 {
   assert(op);
 
-  std::lock_guard<std::mutex> lock{_mutex};
+  // Only the accessed data regions need to be locked during dependency
+  // analysis. The builder lock is acquired while the region locks are
+  // still held, such that nodes are added to the DAG after all nodes that
+  // they depend on.
+  auto region_locks = lock_data_regions(op.get(), requirements);
 
   auto node = this->build_node(std::move(op), requirements, hints);
+
+  std::lock_guard<std::mutex> lock{_mutex};
   _current_dag.add_command_group(node);
+  runtime_statistics::get().add(statistic::cached_dag_nodes);
 
   return node;
 }
@@ -240,6 +367,7 @@ dag dag_builder::finish_and_reset()
   std::lock_guard<std::mutex> lock{_mutex};
 
   dag final_dag = std::exchange(_current_dag, {});
+  upgrade_overwritten_requirements_to_discard(final_dag);
 
   HIPSYCL_DEBUG_INFO << "dag_builder: DAG contains operations: " << std::endl;
   int operation_index = 0;
@@ -9,6 +9,8 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include <algorithm>
+#include <chrono>
+#include <limits>
 
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/hints.hpp"
@@ -19,9 +21,15 @@
 #include "hipSYCL/runtime/executor.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/dag_manager.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/async_errors.hpp"
 #include "hipSYCL/runtime/generic/multi_event.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -76,23 +84,217 @@ void initialize_memory_access(buffer_memory_requirement *bmem_req,
                      << device_pointer << std::endl;
 }
 
+std::pair<backend_executor *, device_id>
+select_executor(runtime *rt, dag_node_ptr node, operation *op);
+void submit(backend_executor *executor, dag_node_ptr node, operation *op);
+
+// Whether operations accessing the data region might not have completed yet.
+// This includes operations that have not been submitted yet.
+bool is_in_use(buffer_data_region &region) {
+  bool in_use = false;
+  region.get_users().for_each_user([&](data_user &user) {
+    if(auto user_ptr = user.user.lock())
+      if(!user_ptr->is_complete())
+        in_use = true;
+  });
+  return in_use;
+}
+
+// Frees the allocation of region on dev, after copying data to the host that
+// is not up-to-date on any other device. Returns false if the allocation
+// cannot be evicted.
+bool evict_allocation(runtime *rt,
+                      const std::shared_ptr<buffer_data_region> &region,
+                      device_id dev) {
+  bool is_owned = false;
+  region->find_and_handle_allocation(
+      dev, [&](const auto &alloc) { is_owned = alloc.is_owned; });
+  // Non-owned allocations may still be used by the application
+  if(!is_owned || is_in_use(*region))
+    return false;
+
+  const device_id host{
+      backend_descriptor{hardware_platform::cpu, api_platform::omp}, 0};
+  const range<3> num_elements = region->get_num_elements();
+
+  if(!region->has_allocation(host)) {
+    backend_allocator *host_allocator =
+        rt->backends().get(host.get_backend())->get_allocator(host);
+    void *ptr = host_allocator->allocate(
+        0, num_elements.size() * region->get_element_size());
+    if(!ptr)
+      return false;
+    region->add_empty_allocation(host, ptr, host_allocator);
+  }
+
+  auto is_valid_on = [&](device_id d, const range_store::rect &r) {
+    bool is_valid = false;
+    region->find_and_handle_allocation(d, [&](const auto &alloc) {
+      is_valid = alloc.invalid_pages.entire_range_empty(
+          region->get_page_range(r.first, r.second));
+    });
+    return is_valid;
+  };
+
+  std::vector<range_store::rect> outdated_regions;
+  region->get_outdated_regions(host, id<3>{}, num_elements, outdated_regions);
+
+  std::vector<range_store::rect> rescued_regions;
+  for(const auto &r : outdated_regions) {
+    if(!region->has_initialized_content(r.first, r.second))
+      continue;
+
+    bool is_valid_elsewhere = false;
+    region->for_each_allocation_while([&](const auto &alloc) {
+      if(alloc.dev != dev && alloc.dev != host &&
+         alloc.invalid_pages.entire_range_empty(
+             region->get_page_range(r.first, r.second)))
+        is_valid_elsewhere = true;
+      return !is_valid_elsewhere;
+    });
+    if(is_valid_elsewhere)
+      continue;
+    // The data might be distributed across multiple devices, which is
+    // not supported yet.
+    if(!is_valid_on(dev, r))
+      return false;
+    rescued_regions.push_back(r);
+  }
+
+  HIPSYCL_DEBUG_INFO << "dag_direct_scheduler: Evicting allocation of data "
+                        "region "
+                     << region.get() << " on device " << dev.get_id()
+                     << ", copying " << rescued_regions.size()
+                     << " regions to host" << std::endl;
+
+  node_list_t copies;
+  for(const auto &r : rescued_regions) {
+    execution_hints hints;
+    hints.set_hint(hints::bind_to_device{host});
+    auto node = make_dag_node(
+        hints, node_list_t{},
+        std::make_unique<memcpy_operation>(memory_location{dev, r.first, region},
+                                           memory_location{host, r.first, region},
+                                           r.second),
+        rt);
+    node->assign_to_device(host);
+    std::pair<backend_executor *, device_id> execution_config =
+        select_executor(rt, node, node->get_operation());
+    node->assign_to_device(execution_config.second);
+    submit(execution_config.first, node, node->get_operation());
+    rt->dag().register_submitted_ops(node);
+    copies.push_back(node);
+
+    runtime_statistics::get().add(statistic::migrated_bytes_device_to_host,
+                                  r.second.size() * region->get_element_size());
+  }
+  for(const auto &node : copies)
+    node->wait();
+  for(const auto &r : rescued_regions)
+    region->mark_range_valid(host, r.first, r.second);
+
+  region->remove_allocation(dev);
+  rt->dag().get_allocation_tracker().unregister(region.get(), dev);
+  return true;
+}
+
+// Evicts least-recently used allocations of other data regions on dev until
+// the allocation succeeds.
+void *allocate_with_eviction(runtime *rt, backend_allocator *allocator,
+                             const std::shared_ptr<buffer_data_region> &region,
+                             device_id dev, std::size_t num_bytes) {
+  auto candidates =
+      rt->dag().get_allocation_tracker().get_eviction_candidates(
+          dev, region.get());
+  for(const auto &candidate : candidates) {
+    if(evict_allocation(rt, candidate, dev)) {
+      void *ptr = allocator->allocate(0, num_bytes);
+      if(ptr)
+        return ptr;
+    }
+  }
+  return nullptr;
+}
+
+// With ACPP_RT_UNIFIED_MEMORY_ZERO_COPY, devices that share physical memory
+// with the host use the host allocation of the data region directly if it
+// is accessible from the device, instead of allocating device memory and
+// copying data between both allocations.
+bool try_alias_host_allocation(runtime *rt, backend_allocator *allocator,
+                               const std::shared_ptr<buffer_data_region> &region,
+                               device_id target_dev) {
+  static const bool is_enabled =
+      application::get_settings().get<setting::unified_memory_zero_copy>();
+  if(!is_enabled || target_dev.is_host())
+    return false;
+
+  const device_id host{
+      backend_descriptor{hardware_platform::cpu, api_platform::omp}, 0};
+  if(!region->has_allocation(host))
+    return false;
+
+  hardware_context *ctx = rt->backends()
+                              .get(target_dev.get_backend())
+                              ->get_hardware_manager()
+                              ->get_device(target_dev.get_id());
+  if(!ctx->has(device_support_aspect::host_unified_memory))
+    return false;
+
+  void *host_ptr = region->get_memory(host);
+  pointer_info info;
+  if(!allocator->query_pointer(host_ptr, info).is_success() ||
+     !(info.is_optimized_host || info.is_usm))
+    return false;
+
+  HIPSYCL_DEBUG_INFO << "dag_direct_scheduler: Using host allocation "
+                     << host_ptr << " of data region " << region.get()
+                     << " directly on unified memory device "
+                     << target_dev.get_id() << std::endl;
+  // The host allocation remains the owner of the memory
+  region->add_empty_allocation(target_dev, host_ptr, allocator, false);
+  return true;
+}
+
 result ensure_allocation_exists(runtime *rt,
                                 buffer_memory_requirement *bmem_req,
                                 device_id target_dev) {
   assert(bmem_req);
   if (!bmem_req->get_data_region()->has_allocation(target_dev)) {
+    backend_allocator *allocator =
+        rt->backends().get(target_dev.get_backend())->get_allocator(target_dev);
+    buffer_allocation_cache &cache = rt->dag().get_allocation_cache();
+    if(!target_dev.is_host() && cache.is_enabled())
+      allocator = cache.get_allocator(target_dev, allocator);
+
+    if(try_alias_host_allocation(rt, allocator, bmem_req->get_data_region(),
+                                 target_dev)) {
+      if(!target_dev.is_host())
+        rt->dag().get_allocation_tracker().register_use(
+            bmem_req->get_data_region(), target_dev);
+      return make_success();
+    }
     const std::size_t num_bytes =
         bmem_req->get_data_region()->get_num_elements().size() *
         bmem_req->get_data_region()->get_element_size();
 
-    backend_allocator *allocator =
-        rt->backends().get(target_dev.get_backend())->get_allocator(target_dev);
+    const std::size_t num_errors = application::errors().num_errors();
     // Currently we just pass 0 for the alignment which should
     // cause backends to align to the largest supported type.
     // TODO: A better solution might be to select a custom alignment
     // best on sizeof(T). This requires querying backend alignment capabilities.
     void *ptr = allocator->allocate(0, num_bytes);
 
+    if(!ptr && !target_dev.is_host() &&
+       application::get_settings().get<setting::buffer_eviction>()) {
+      ptr = allocate_with_eviction(rt, allocator, bmem_req->get_data_region(),
+                                   target_dev, num_bytes);
+      // Only report the allocation failure once, or not at all if the
+      // allocation succeeded after eviction.
+      application::errors().remove_errors_after(
+          ptr ? num_errors : num_errors + 1,
+          error_type::memory_allocation_error);
+    }
+
     if(!ptr)
       return register_error(
                  __acpp_here(),
@@ -104,32 +306,130 @@ result ensure_allocation_exists(runtime *rt,
                                                       allocator);
   }
 
+  if(!target_dev.is_host())
+    rt->dag().get_allocation_tracker().register_use(
+        bmem_req->get_data_region(), target_dev);
+
   return make_success();
 }
 
+// Splits the transfer of region into chunks along the outermost dimension
+// that has more than one element. Chunks are at most max_chunk_size bytes,
+// but at least one page (in the split dimension) large, and
+// chunk boundaries are aligned to page boundaries.
+std::vector<range_store::rect>
+split_into_transfer_chunks(const range_store::rect &region,
+                           std::size_t element_size, range<3> page_size,
+                           std::size_t max_chunk_size) {
+  int split_dim = 0;
+  while(split_dim < 2 && region.second[split_dim] <= 1)
+    ++split_dim;
+
+  std::size_t slice_size = element_size;
+  for(int i = split_dim + 1; i < 3; ++i)
+    slice_size *= region.second[i];
+
+  std::size_t slices_per_chunk = std::max(max_chunk_size / slice_size,
+                                          std::size_t{1});
+  std::size_t split_page_size = page_size[split_dim];
+  slices_per_chunk = std::max(slices_per_chunk / split_page_size,
+                              std::size_t{1}) * split_page_size;
+
+  std::vector<range_store::rect> chunks;
+  const std::size_t begin = region.first[split_dim];
+  const std::size_t end = begin + region.second[split_dim];
+  for(std::size_t chunk_begin = begin; chunk_begin < end;) {
+    // Align the end of the chunk to page boundaries
+    std::size_t chunk_end = std::min(
+        (chunk_begin / split_page_size) * split_page_size + slices_per_chunk,
+        end);
+    range_store::rect chunk = region;
+    chunk.first[split_dim] = chunk_begin;
+    chunk.second[split_dim] = chunk_end - chunk_begin;
+    chunks.push_back(chunk);
+    chunk_begin = chunk_end;
+  }
+  return chunks;
+}
+
+// Chooses the source of a data transfer that is expected to complete
+// first. Sources that are themselves still being updated can only start
+// once their update has completed, and transfers from the same source are
+// assumed to share its bandwidth. When data is replicated to many devices,
+// this causes devices that have already received the data to forward it
+// to other devices, if peer transfers are cheap enough.
+device_id choose_update_source(
+    runtime *rt, const std::shared_ptr<buffer_data_region> &data_region,
+    const std::vector<std::pair<device_id, range_store::rect>> &candidates,
+    device_id target_device, const range_store::rect &region,
+    std::chrono::steady_clock::time_point now,
+    buffer_data_region::pending_transfer_state &source_state,
+    double &estimated_time) {
+  const memcpy_model *model =
+      rt->backends().hardware_model().get_memcpy_model();
+
+  std::size_t best_candidate = 0;
+  estimated_time = std::numeric_limits<double>::max();
+  for(std::size_t i = 0; i < candidates.size(); ++i) {
+    device_id source = candidates[i].first;
+    auto state = data_region->get_pending_transfers(source);
+
+    double delay = 0.0;
+    if(!state.updates.empty() && state.estimated_update_completion > now)
+      delay = std::chrono::duration<double>(state.estimated_update_completion -
+                                            now)
+                  .count();
+    double time =
+        delay + model->estimate_runtime_cost(
+                    memory_location{source, region.first, data_region},
+                    memory_location{target_device, region.first, data_region},
+                    region.second) *
+                    static_cast<double>(state.num_reads + 1);
+    if(time < estimated_time) {
+      estimated_time = time;
+      best_candidate = i;
+      source_state = std::move(state);
+    }
+  }
+  return candidates[best_candidate].first;
+}
+
 void for_each_explicit_operation(
-    dag_node_ptr node, std::function<void(operation *)> explicit_op_handler) {
+    runtime *rt, dag_node_ptr node,
+    std::function<void(dag_node_ptr, operation *)> explicit_op_handler) {
   if (node->is_submitted())
     return;
   
   if (!node->get_operation()->is_requirement()) {
-    explicit_op_handler(node->get_operation());
+    explicit_op_handler(node, node->get_operation());
     return;
   } else {
     execute_if_buffer_requirement(node,
                                   [&](buffer_memory_requirement *bmem_req) {
           
           device_id target_device = node->get_assigned_device();
+          auto data_region = bmem_req->get_data_region();
 
           std::vector<range_store::rect> outdated_regions;
-          bmem_req->get_data_region()->get_outdated_regions(
+          data_region->get_outdated_regions(
               target_device, bmem_req->get_access_offset3d(),
               bmem_req->get_access_range3d(), outdated_regions);
 
+          const std::size_t chunk_size =
+              application::get_settings()
+                  .get<setting::pipelined_transfer_chunk_size>() *
+              1024 * 1024;
+
+          const auto now = std::chrono::steady_clock::now();
+          double max_estimated_time = 0.0;
+
+          std::vector<std::unique_ptr<operation>> transfers;
+          // Source device and transfers that each transfer must wait for
+          std::vector<std::pair<device_id, node_list_t>> transfer_sources;
           for (range_store::rect region : outdated_regions) {
             std::vector<std::pair<device_id, range_store::rect>> update_sources;
 
-            bmem_req->get_data_region()->get_update_source_candidates(
+            data_region->get_update_source_candidates(
                 target_device, region, update_sources);
 
             if (update_sources.empty()) {
@@ -142,18 +442,103 @@ void for_each_explicit_operation(
               return;
             }
 
-            // Just use first source for now:
-            memory_location src{update_sources[0].first,
-                                update_sources[0].second.first,
-                                bmem_req->get_data_region()};
-            memory_location dest{target_device, region.first,
-                                 bmem_req->get_data_region()};
-            std::unique_ptr<operation> op =
-                std::make_unique<memcpy_operation>(src, dest, region.second);
-
-            explicit_op_handler(op.get());
-            /// TODO This has to be changed once we support multi-operation nodes
-            node->assign_effective_operation(std::move(op));
+            // If a valid source shares its memory with the target
+            // allocation (see try_alias_host_allocation()), the data is
+            // already in place once pending updates of the source are done.
+            void *target_ptr = data_region->get_memory(target_device);
+            auto aliased_source = std::find_if(
+                update_sources.begin(), update_sources.end(),
+                [&](const auto &source) {
+                  return data_region->get_memory(source.first) == target_ptr;
+                });
+            if (aliased_source != update_sources.end()) {
+              for (const auto &update :
+                   data_region->get_pending_transfers(aliased_source->first)
+                       .updates)
+                node->add_requirement(update);
+              continue;
+            }
+
+            buffer_data_region::pending_transfer_state source_state;
+            double estimated_time = 0.0;
+            device_id source_device = choose_update_source(
+                rt, data_region, update_sources, target_device, region, now,
+                source_state, estimated_time);
+            max_estimated_time = std::max(max_estimated_time, estimated_time);
+
+            std::vector<range_store::rect> chunks;
+            if (chunk_size > 0 &&
+                region.second.size() * data_region->get_element_size() >
+                    chunk_size)
+              chunks = split_into_transfer_chunks(
+                  region, data_region->get_element_size(),
+                  data_region->get_page_size(), chunk_size);
+            else
+              chunks.push_back(region);
+
+            statistic direction = statistic::migrated_bytes_device_to_device;
+            if(source_device.is_host() && !target_device.is_host())
+              direction = statistic::migrated_bytes_host_to_device;
+            else if(!source_device.is_host() && target_device.is_host())
+              direction = statistic::migrated_bytes_device_to_host;
+            runtime_statistics::get().add(
+                direction, region.second.size() * data_region->get_element_size());
+
+            for(const auto& chunk : chunks) {
+              transfers.push_back(std::make_unique<memcpy_operation>(
+                  memory_location{source_device, chunk.first, data_region},
+                  memory_location{target_device, chunk.first, data_region},
+                  chunk.second));
+              transfer_sources.push_back(
+                  std::make_pair(source_device, source_state.updates));
+            }
+          }
+
+          // Nodes can only carry out a single operation, so all transfers
+          // except for the last one are submitted as separate nodes, on
+          // different execution lanes if possible. The requirement node
+          // then carries out the last transfer, and depends on all other
+          // transfers.
+          for(std::size_t i = 0; i + 1 < transfers.size(); ++i) {
+            execution_hints hints = node->get_execution_hints();
+            hints.set_hint(hints::prefer_execution_lane{i});
+
+            node_list_t reqs;
+            node->for_each_nonvirtual_requirement(
+                [&](dag_node_ptr req) { reqs.push_back(req); });
+
+            for(const auto& update : transfer_sources[i].second)
+              reqs.push_back(update);
+
+            auto transfer_node = make_dag_node(
+                hints, reqs, std::move(transfers[i]), rt);
+            transfer_node->assign_to_device(target_device);
+            explicit_op_handler(transfer_node,
+                                transfer_node->get_operation());
+            if(transfer_node->is_submitted()) {
+              rt->dag().register_submitted_ops(transfer_node);
+              node->add_requirement(transfer_node);
+              data_region->add_pending_read(transfer_sources[i].first,
+                                            transfer_node);
+            }
+          }
+          if(!transfers.empty()) {
+            for(const auto& update : transfer_sources.back().second)
+              node->add_requirement(update);
+
+            operation* last_transfer = transfers.back().get();
+            node->assign_effective_operation(std::move(transfers.back()));
+            explicit_op_handler(node, last_transfer);
+            if(node->is_submitted()) {
+              data_region->add_pending_read(transfer_sources.back().first,
+                                            node);
+              // The requirement node depends on all transfers
+              data_region->add_pending_update(
+                  target_device, node,
+                  now + std::chrono::duration_cast<
+                            std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(max_estimated_time)));
+            }
           }
         });
   }
@@ -254,7 +639,7 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
                   bmem_req->get_access_range3d());
         });
     if(has_initialized_content){
-      for_each_explicit_operation(req, [&](operation *op) {
+      for_each_explicit_operation(rt, req, [&](dag_node_ptr node, operation *op) {
         if (!op->is_data_transfer()) {
           res = make_error(
               __acpp_here(),
@@ -264,7 +649,7 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
                   error_type::feature_not_supported});
         } else {
           std::pair<backend_executor *, device_id> execution_config =
-              select_executor(rt, req, op);
+              select_executor(rt, node, op);
           // TODO What if we need to copy between two device backends through
           // host?
           
@@ -291,9 +676,9 @@ result submit_requirement(runtime* rt, dag_node_ptr req) {
           // We CANNOT assign_to_device the original device after the submit call,
           // since the executors need to know which device actually has processed
           // the operation to setup dependencies correctly.
-          auto original_device = req->get_assigned_device();
-          req->assign_to_device(execution_config.second);
-          submit(execution_config.first, req, op);
+          auto original_device = node->get_assigned_device();
+          node->assign_to_device(execution_config.second);
+          submit(execution_config.first, node, op);
         }
       });
     }
@@ -336,6 +721,7 @@ dag_direct_scheduler::dag_direct_scheduler(runtime* rt)
 : _rt{rt} {}
 
 void dag_direct_scheduler::submit(dag_node_ptr node) {
+  trace_span span{"scheduler"};
   if (!node->get_execution_hints().has_hint<hints::bind_to_device>()) {
     register_error(__acpp_here(),
                    error_info{"dag_direct_scheduler: Direct scheduler does not "
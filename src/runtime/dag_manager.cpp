@@ -8,8 +8,11 @@
  * See file LICENSE in the project root for full license details.
  */
 // SPDX-License-Identifier: BSD-2-Clause
+#include <algorithm>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/runtime/application.hpp"
@@ -21,10 +24,75 @@
 #include "hipSYCL/runtime/settings.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Nesting depth of submission batches of the current thread
+thread_local std::size_t submission_batch_depth = 0;
+
+// Invokes f for all command groups that node depends on, looking through
+// requirement nodes which connect command groups that access the same data.
+template <class F>
+void for_each_command_group_requirement(const dag_node_ptr &node, F &&f) {
+  for(const auto &weak_req : node->get_requirements()) {
+    if(auto req = weak_req.lock()) {
+      if(req->get_operation()->is_requirement())
+        for_each_command_group_requirement(req, f);
+      else
+        f(req);
+    }
+  }
+}
+
+// Marks the nodes on the longest chain of dependent command groups in the
+// DAG with the critical_path hint. Each operation is assumed to take the same
+// amount of time. Nothing is marked if the chain covers all command groups,
+// since there is no independent work competing with it.
+void mark_critical_path(const dag &d) {
+  const node_list_t &command_groups = d.get_command_groups();
+  const std::size_t num_nodes = command_groups.size();
+  if(num_nodes < 2)
+    return;
+
+  std::unordered_map<const dag_node *, std::size_t> node_indices;
+  for(std::size_t i = 0; i < num_nodes; ++i)
+    node_indices[command_groups[i].get()] = i;
+
+  // Command groups are ordered such that requirements come first
+  std::vector<std::size_t> chain_length(num_nodes, 1);
+  std::vector<std::size_t> predecessor(num_nodes, num_nodes);
+  std::size_t chain_end = 0;
+  for(std::size_t i = 0; i < num_nodes; ++i) {
+    for_each_command_group_requirement(
+        command_groups[i], [&](const dag_node_ptr &req) {
+          auto it = node_indices.find(req.get());
+          if(it != node_indices.end() && it->second < i &&
+             chain_length[it->second] + 1 > chain_length[i]) {
+            chain_length[i] = chain_length[it->second] + 1;
+            predecessor[i] = it->second;
+          }
+        });
+    if(chain_length[i] > chain_length[chain_end])
+      chain_end = i;
+  }
+
+  if(chain_length[chain_end] < 2 || chain_length[chain_end] == num_nodes)
+    return;
+
+  HIPSYCL_DEBUG_INFO << "dag_manager: Critical path consists of "
+                     << chain_length[chain_end] << " out of " << num_nodes
+                     << " operations" << std::endl;
+  for(std::size_t i = chain_end; i < num_nodes; i = predecessor[i])
+    command_groups[i]->get_execution_hints().set_hint(hints::critical_path{});
+}
+
+}
+
 
 dag_build_guard::~dag_build_guard()
 {
@@ -32,8 +100,20 @@ dag_build_guard::~dag_build_guard()
 }
 
 dag_manager::dag_manager(runtime *rt)
-    : _builder{std::make_unique<dag_builder>(rt)},
-      _direct_scheduler{rt}, _unbound_scheduler{rt}, _rt{rt} {
+    : _allocation_cache{application::get_settings()
+                            .get<setting::buffer_allocation_cache_size>() *
+                        1024 * 1024},
+      _builder{std::make_unique<dag_builder>(rt)},
+      _direct_scheduler{rt}, _unbound_scheduler{rt},
+      _use_adaptive_flush{
+          application::get_settings().get<setting::adaptive_flush>()},
+      _max_flush_threshold{std::max(
+          application::get_settings().get<setting::max_cached_nodes>(),
+          std::size_t{1})},
+      _flush_threshold{_max_flush_threshold},
+      _use_critical_path_scheduling{
+          application::get_settings().get<setting::critical_path_scheduling>()},
+      _rt{rt} {
   HIPSYCL_DEBUG_INFO << "dag_manager: DAG manager is alive!" << std::endl;
 }
 
@@ -44,6 +124,12 @@ dag_manager::~dag_manager()
   flush_sync();
   wait();
 
+  if(tracer::get().is_enabled()) {
+    // Make sure that device spans of all nodes are recorded
+    _submitted_ops.purge_known_completed();
+    tracer::get().write_trace();
+  }
+
   HIPSYCL_DEBUG_INFO << "dag_manager: Shutdown." << std::endl;
 }
 
@@ -66,12 +152,23 @@ void dag_manager::flush_async()
   // actually ensuring submission, or introduce dependencies in nodes during submission
   //  to other nodes that have not yet been submitted.
   std::lock_guard<std::mutex> lock{_flush_mutex};
+  trace_span span{"flush"};
 
   if(_builder->get_current_dag_size() > 0){
     dag new_dag = _builder->finish_and_reset();
 
     if(new_dag.num_nodes() > 0) {
+      runtime_statistics::get().add(statistic::flushes);
+      runtime_statistics::get().add(statistic::flushed_dag_nodes,
+                                    new_dag.num_nodes());
+
+      if(_use_adaptive_flush && !new_dag.get_command_groups().empty()) {
+        std::lock_guard<std::mutex> node_lock{_last_flushed_node_mutex};
+        _last_flushed_node = new_dag.get_command_groups().back();
+      }
+
       _worker([this, new_dag](){
+        trace_span span{"flush [async]"};
         HIPSYCL_DEBUG_INFO << "dag_manager [async]: Flushing!" << std::endl;
         
         for(dag_node_ptr req : new_dag.get_memory_requirements()){
@@ -96,6 +193,9 @@ void dag_manager::flush_async()
             assert(false && "Non-buffer requirements are unsupported");
         }
 
+        if(_use_critical_path_scheduling)
+          mark_critical_path(new_dag);
+
         // Go!!!
         scheduler_type stype =
             application::get_settings().get<setting::scheduler_type>();
@@ -157,15 +257,56 @@ void dag_manager::register_submitted_ops(dag_node_ptr node) {
   this->_submitted_ops.update_with_submission(node);
 }
 
+std::shared_ptr<node_completion_queue>
+dag_manager::get_completion_queue() const {
+  return _submitted_ops.get_completion_queue();
+}
+
+void dag_manager::begin_submission_batch() {
+  ++submission_batch_depth;
+}
+
+void dag_manager::end_submission_batch() {
+  assert(submission_batch_depth > 0);
+  if(--submission_batch_depth == 0) {
+    HIPSYCL_DEBUG_INFO << "dag_manager: Submission batch complete" << std::endl;
+    // Flush unconditionally, since the batch is typically
+    // followed by waiting for its results.
+    flush_async();
+  }
+}
+
 void dag_manager::trigger_flush_opportunity()
 {
   HIPSYCL_DEBUG_INFO << "dag_manager: Checking DAG flush opportunity..."
                      << std::endl;
 
+  if(submission_batch_depth > 0)
+    return;
+
   if (application::get_settings().get<setting::scheduler_type>() ==
       scheduler_type::direct) {
     // Direct scheduler always needs flushing
     flush_async();
+  } else if(_use_adaptive_flush) {
+    std::size_t dag_size = builder()->get_current_dag_size();
+    if(dag_size == 0)
+      return;
+
+    std::size_t threshold = _flush_threshold.load(std::memory_order_relaxed);
+    if(is_starving()) {
+      // Devices are idle, so waiting for more work to accumulate
+      // only delays execution.
+      _flush_threshold.store(std::max(threshold / 2, std::size_t{1}),
+                             std::memory_order_relaxed);
+      flush_async();
+    } else if(dag_size > threshold) {
+      // Devices still had work when the batch was full, so larger batches
+      // reduce scheduling overhead without starving them.
+      _flush_threshold.store(std::min(2 * threshold, _max_flush_threshold),
+                             std::memory_order_relaxed);
+      flush_async();
+    }
   } else {
     if (builder()->get_current_dag_size() >
         application::get_settings().get<setting::max_cached_nodes>())
@@ -173,6 +314,21 @@ void dag_manager::trigger_flush_opportunity()
   }
 }
 
+bool dag_manager::is_starving() {
+  dag_node_ptr last_node;
+  {
+    std::lock_guard<std::mutex> lock{_last_flushed_node_mutex};
+    last_node = _last_flushed_node;
+  }
+  // Nothing has been flushed yet
+  if(!last_node)
+    return true;
+  // The node might still be processed by the worker thread
+  if(!last_node->is_submitted())
+    return false;
+  return last_node->is_complete();
+}
+
 node_list_t dag_manager::get_group(std::size_t node_group_id) {
   return _submitted_ops.get_group(node_group_id);
 }
@@ -88,6 +88,10 @@ void dag_node::cancel() {
   this->_is_cancelled = true;
 }
 
+void dag_node::mark_known_complete() {
+  this->_is_complete = true;
+}
+
 void dag_node::assign_to_executor(backend_executor *ctx)
 {
   this->_assigned_executor = ctx;
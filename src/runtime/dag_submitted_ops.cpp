@@ -9,24 +9,18 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include <cassert>
+#include <iterator>
 
 #include "hipSYCL/runtime/dag_submitted_ops.hpp"
 #include "hipSYCL/runtime/dag_node.hpp"
 #include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 namespace hipsycl {
 namespace rt {
 
-namespace {
-
-void erase_known_completed_nodes(std::vector<dag_node_ptr> &ops) {
-  ops.erase(std::remove_if(ops.begin(), ops.end(),
-                           [&](dag_node_ptr node) -> bool {
-                             return node->is_known_complete();
-                           }),
-            ops.end());
-}
-}
+dag_submitted_ops::dag_submitted_ops()
+: _completion_queue{std::make_shared<node_completion_queue>()} {}
 
 dag_submitted_ops::~dag_submitted_ops() {
   this->purge_known_completed();
@@ -34,13 +28,42 @@ dag_submitted_ops::~dag_submitted_ops() {
 
 void dag_submitted_ops::copy_node_list(std::vector<dag_node_ptr>& out) const {
   std::lock_guard lock{_lock};
-  out = _ops;
+  out.assign(_ops.begin(), _ops.end());
+}
+
+void dag_submitted_ops::erase_node(std::list<dag_node_ptr>::iterator it) {
+  tracer& t = tracer::get();
+  if(t.is_enabled())
+    t.record_device_span(*it);
+  _op_positions.erase(it->get());
+  _ops.erase(it);
+}
+
+void dag_submitted_ops::erase_signalled_completions() {
+  _completion_queue->pop_all(_completion_scratch);
+  for(const dag_node_ptr& node : _completion_scratch) {
+    auto pos = _op_positions.find(node.get());
+    // The node might have been removed already by a full purge
+    if(pos != _op_positions.end())
+      erase_node(pos->second);
+  }
+  _completion_scratch.clear();
 }
 
 void dag_submitted_ops::purge_known_completed() {
   std::lock_guard lock{_lock};
 
-  erase_known_completed_nodes(_ops);
+  erase_signalled_completions();
+  for(auto it = _ops.begin(); it != _ops.end();) {
+    auto current = it++;
+    if((*current)->is_known_complete())
+      erase_node(current);
+  }
+}
+
+std::shared_ptr<node_completion_queue>
+dag_submitted_ops::get_completion_queue() const {
+  return _completion_queue;
 }
 
 std::size_t dag_submitted_ops::get_num_nodes() const {
@@ -70,15 +93,24 @@ void dag_submitted_ops::update_with_submission(dag_node_ptr single_node) {
   std::lock_guard lock{_lock};
 
   assert(single_node->is_submitted());
+  // Keeps the number of tracked nodes low when the backend signals
+  // completions, such that garbage collection is rarely triggered.
+  erase_signalled_completions();
+  // The completion might already have been signalled before registration,
+  // in which case there is nothing left to track.
+  if(single_node->is_known_complete()) {
+    tracer& t = tracer::get();
+    if(t.is_enabled())
+      t.record_device_span(single_node);
+    return;
+  }
   _ops.push_back(single_node);
+  _op_positions[single_node.get()] = std::prev(_ops.end());
 }
 
 void dag_submitted_ops::wait_for_all() {
   std::vector<dag_node_ptr> current_ops;
-  {
-    std::lock_guard lock{_lock};
-    current_ops = _ops;
-  }
+  this->copy_node_list(current_ops);
   
   for(dag_node_ptr node : current_ops) {
     assert(node->is_submitted());
@@ -91,10 +123,7 @@ void dag_submitted_ops::wait_for_group(std::size_t node_group) {
                      << node_group << std::endl;
   
   std::vector<dag_node_ptr> current_ops;
-  {
-    std::lock_guard lock{_lock};  
-    current_ops = _ops;
-  }
+  this->copy_node_list(current_ops);
 
   // Iterate in reverse order over the nodes, since current_ops
   // will contain the nodes in submission order.
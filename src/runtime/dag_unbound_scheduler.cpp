@@ -16,14 +16,147 @@
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/util.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
+#include "hipSYCL/runtime/serialization/serialization.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <limits>
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// Estimated time per operation for devices without measurements
+constexpr double default_operation_time = 1.e-4;
+// Weight of new measurements of the operation time
+constexpr double operation_time_update_weight = 0.2;
+
+// Estimates the time needed to make the data that node accesses
+// available on dev.
+double estimate_transfer_time(runtime *rt, const dag_node_ptr &node,
+                              device_id dev) {
+  const memcpy_model *model =
+      rt->backends().hardware_model().get_memcpy_model();
+
+  double transfer_time = 0.0;
+  for(const auto& weak_req : node->get_requirements()) {
+    auto req = weak_req.lock();
+    if(!req || !req->get_operation()->is_requirement())
+      continue;
+    auto *r = cast<requirement>(req->get_operation());
+    if(!r->is_memory_requirement() ||
+       !cast<memory_requirement>(r)->is_buffer_requirement())
+      continue;
+
+    auto *bmem_req = cast<buffer_memory_requirement>(r);
+    sycl::access::mode mode = bmem_req->get_access_mode();
+    if (mode == sycl::access::mode::discard_write ||
+        mode == sycl::access::mode::discard_read_write)
+      continue;
+
+    auto data_region = bmem_req->get_data_region();
+    id<3> offset = bmem_req->get_access_offset3d();
+    range<3> range = bmem_req->get_access_range3d();
+    if(!data_region->has_initialized_content(offset, range))
+      continue;
+
+    std::size_t num_outdated_elements = 0;
+    if(data_region->has_allocation(dev)) {
+      std::vector<range_store::rect> outdated_regions;
+      data_region->get_outdated_regions(dev, offset, range, outdated_regions);
+      for(const auto& region : outdated_regions)
+        num_outdated_elements += region.second.size();
+    } else {
+      num_outdated_elements = range.size();
+    }
+    if(num_outdated_elements == 0)
+      continue;
+
+    // Assume that the data is transferred from the allocation
+    // with the cheapest link
+    double bytes = static_cast<double>(num_outdated_elements *
+                                       data_region->get_element_size());
+    double best_time = std::numeric_limits<double>::max();
+    data_region->for_each_allocation_while([&](const auto &alloc) {
+      if(alloc.dev != dev) {
+        memcpy_link_properties link =
+            model->get_link_properties(alloc.dev, dev);
+        best_time = std::min(best_time, link.latency + bytes / link.bandwidth);
+      }
+      return true;
+    });
+    if(best_time != std::numeric_limits<double>::max())
+      transfer_time += best_time;
+  }
+  return transfer_time;
+}
+
+}
+
 dag_unbound_scheduler::dag_unbound_scheduler(runtime* rt)
 : _direct_scheduler{rt}, _rt{rt} {}
 
+dag_unbound_scheduler::device_load &
+dag_unbound_scheduler::get_device_load(device_id dev) {
+  for(auto& load : _device_loads)
+    if(load.dev == dev)
+      return load;
+
+  device_load load;
+  load.dev = dev;
+  load.operation_time = default_operation_time;
+  // Until operations of this application have been measured, account for
+  // the calibrated latency of the device, if available.
+  if (auto props =
+          _rt->backends().hardware_model().get_device_model()->get_properties(
+              dev))
+    load.operation_time += props->operation_latency;
+  load.last_update = std::chrono::steady_clock::now();
+  _device_loads.push_back(load);
+  return _device_loads.back();
+}
+
+void dag_unbound_scheduler::update_device_load(device_load &load) {
+  auto now = std::chrono::steady_clock::now();
+
+  // Nodes on a device mostly complete in submission order, so it is
+  // sufficient to only check the oldest ones.
+  std::size_t num_completed = 0;
+  while(!load.in_flight.empty()) {
+    auto node = load.in_flight.front().lock();
+    if(node && !node->is_complete())
+      break;
+    load.in_flight.pop_front();
+    ++num_completed;
+  }
+
+  if(num_completed > 0) {
+    double elapsed =
+        std::chrono::duration<double>(now - load.last_update).count();
+    load.operation_time =
+        (1.0 - operation_time_update_weight) * load.operation_time +
+        operation_time_update_weight * elapsed / num_completed;
+    load.last_update = now;
+  }
+  // Only measure time during which the device has work
+  if(load.in_flight.empty())
+    load.last_update = now;
+}
+
+double dag_unbound_scheduler::estimate_completion_time(
+    const dag_node_ptr &node, device_load &load) {
+  update_device_load(load);
+  return static_cast<double>(load.in_flight.size() + 1) * load.operation_time +
+         estimate_transfer_time(_rt, node, load.dev);
+}
+
 void dag_unbound_scheduler::submit(dag_node_ptr node) {
+  trace_span span{"scheduler"};
   if(_devices.empty()) {
     // We cannot query this in the constructor, because
     // when schedulers are constructed the runtime is typically
@@ -56,13 +189,24 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
       node->cancel();
       return;
     }
-    // Round-robin as placeholder. This is not intended
-    // for anything practical, it's a _placeholder_
-    static std::size_t dev = 0;
-    ++dev;
 
-    rt::device_id target_dev = eligible_devices[dev % eligible_devices.size()];
+    std::size_t best_device = 0;
+    double best_completion_time = std::numeric_limits<double>::max();
+    for(std::size_t i = 0; i < eligible_devices.size(); ++i) {
+      double completion_time = estimate_completion_time(
+          node, get_device_load(eligible_devices[i]));
+      if(completion_time < best_completion_time) {
+        best_completion_time = completion_time;
+        best_device = i;
+      }
+    }
+
+    rt::device_id target_dev = eligible_devices[best_device];
+    HIPSYCL_DEBUG_INFO << "dag_unbound_scheduler: Assigning node " << node.get()
+                       << " to device " << target_dev << ", estimated completion in " << best_completion_time
+                       << "s" << std::endl;
     node->get_execution_hints().set_hint(rt::hints::bind_to_device{target_dev});
+    get_device_load(target_dev).in_flight.push_back(node);
   }
 
   _direct_scheduler.submit(node);
@@ -70,4 +214,3 @@ void dag_unbound_scheduler::submit(dag_node_ptr node) {
 
 }
 }
-
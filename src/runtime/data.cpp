@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include <cassert>
 #include <algorithm>
+#include <iterator>
 #include "hipSYCL/runtime/data.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/application.hpp"
@@ -45,7 +46,7 @@ const std::vector<data_user>
 data_user_tracker::get_users() const
 { 
   std::lock_guard<std::mutex> lock{_lock};
-  return _users;
+  return std::vector<data_user>(_users.begin(), _users.end());
 }
 
 
@@ -60,34 +61,131 @@ bool data_user_tracker::has_user(dag_node_ptr user) const
 void data_user_tracker::release_dead_users()
 {
   std::lock_guard<std::mutex> lock{_lock};
-  _users.erase(std::remove_if(_users.begin(), _users.end(),
-                              [](const data_user &user) -> bool {
-                                auto u = user.user.lock();
-                                if (!u)
-                                  return true;
-                                return u->is_known_complete();
-                              }),
+  _users.erase(std::remove_if(_users.begin(), _users.end(), is_dead_user),
                _users.end());
 }
 
+range<3> get_adaptive_page_size(range<3> num_elements,
+                                std::size_t element_size,
+                                std::size_t min_page_bytes) {
+  // Bounds the size of the page table for very small minimum page sizes
+  constexpr std::size_t max_num_adaptive_pages = 4096;
+
+  if(min_page_bytes == 0)
+    min_page_bytes =
+        application::get_settings().get<setting::buffer_min_page_size>();
+
+  const std::size_t total_bytes = num_elements.size() * element_size;
+  if(min_page_bytes == 0 || total_bytes / 2 < min_page_bytes)
+    return num_elements;
+
+  int dim = 0;
+  while(dim < 2 && num_elements[dim] == 1)
+    ++dim;
+
+  std::size_t slice_bytes = element_size;
+  for(int i = dim + 1; i < 3; ++i)
+    slice_bytes *= num_elements[i];
+
+  std::size_t slices_per_page =
+      std::max((min_page_bytes + slice_bytes - 1) / slice_bytes,
+               (num_elements[dim] + max_num_adaptive_pages - 1) /
+                   max_num_adaptive_pages);
+  if(slices_per_page >= num_elements[dim])
+    return num_elements;
+
+  range<3> page_size = num_elements;
+  page_size[dim] = slices_per_page;
+  return page_size;
+}
+
 range_store::range_store(range<3> size)
-: _size{size}, _contained_data(size.size())
+: _size{size}, _scanlines(size[0] * size[1])
 {}
 
+void range_store::insert_run(scanline &line, run r) {
+  if(r.begin >= r.end)
+    return;
+  // First run that overlaps or is adjacent to r
+  auto first = std::lower_bound(
+      line.begin(), line.end(), r.begin,
+      [](const run &current, std::size_t pos) { return current.end < pos; });
+  // First run that starts after r and is not adjacent to it
+  auto last = std::upper_bound(
+      first, line.end(), r.end,
+      [](std::size_t pos, const run &current) { return pos < current.begin; });
+
+  if(first != last) {
+    r.begin = std::min(r.begin, first->begin);
+    r.end = std::max(r.end, std::prev(last)->end);
+    *first = r;
+    line.erase(std::next(first), last);
+  } else {
+    line.insert(first, r);
+  }
+}
+
+void range_store::erase_run(scanline &line, run r) {
+  if(r.begin >= r.end)
+    return;
+  // First run that overlaps r
+  auto first = std::upper_bound(
+      line.begin(), line.end(), r.begin,
+      [](std::size_t pos, const run &current) { return pos < current.end; });
+  // First run that starts at or after the end of r
+  auto last = std::lower_bound(
+      first, line.end(), r.end,
+      [](const run &current, std::size_t pos) { return current.begin < pos; });
+
+  if(first == last)
+    return;
+
+  run head{first->begin, r.begin};
+  run tail{r.end, std::prev(last)->end};
+
+  auto pos = line.erase(first, last);
+  if(tail.begin < tail.end)
+    pos = line.insert(pos, tail);
+  if(head.begin < head.end)
+    line.insert(pos, head);
+}
+
+void range_store::get_runs_in_state(const scanline &line, run r,
+                                    data_state desired_state,
+                                    std::vector<run> &out) {
+  auto it = std::upper_bound(
+      line.begin(), line.end(), r.begin,
+      [](std::size_t pos, const run &current) { return pos < current.end; });
+
+  if(desired_state == data_state::available) {
+    for(; it != line.end() && it->begin < r.end; ++it)
+      out.push_back(run{std::max(it->begin, r.begin), std::min(it->end, r.end)});
+  } else {
+    std::size_t current = r.begin;
+    for(; it != line.end() && it->begin < r.end; ++it) {
+      if(it->begin > current)
+        out.push_back(run{current, it->begin});
+      current = std::max(current, it->end);
+    }
+    if(current < r.end)
+      out.push_back(run{current, r.end});
+  }
+}
+
 void range_store::add(const rect& r)
 {
-  this->for_each_element_in_range(r,
-    [](id<3>, data_state& s){
-      s = data_state::available;
-    });
+  run z_range{r.first[2], r.first[2] + r.second[2]};
+  this->for_each_scanline_in_range(r, [&](scanline& line){
+    insert_run(line, z_range);
+  });
 }
 
 void range_store::remove(const rect& r)
 {
-  this->for_each_element_in_range(r, 
-    [](id<3>, data_state& s){
-      s = data_state::empty;
-    });
+  run z_range{r.first[2], r.first[2] + r.second[2]};
+  this->for_each_scanline_in_range(r, [&](scanline& line){
+    erase_run(line, z_range);
+  });
 }
 
 range<3> range_store::get_size() const
@@ -98,63 +196,108 @@ void range_store::intersections_with(const rect& r,
                                     std::vector<rect>& out) const
 {
   out.clear();
-  
-  id<3> rect_begin = r.first;
-  id<3> rect_max = 
-    rect_begin + id<3>{r.second[0], r.second[1], r.second[2]};
-
-
-  std::vector<data_state> visited_entries(_contained_data.size(), data_state::empty);
-
-  this->for_each_element_in_range(r, [&](id<3> pos, const data_state& entry){
-    size_t linear_pos = get_index(pos);
-    // Look for a potential new rect, if
-    // * the starting position is of the state desired by the user
-    // * the start position isn't covered already by another rect
-    //   that was found previously
-    if(entry == desired_state && 
-      visited_entries[linear_pos] == data_state::empty) {
-        
-      // Find the largest contiguous rect for which all entries
-      // are both of \c desired_state and unvisited
-      range<3> rect_size = 
-        find_max_contiguous_rect_extent(pos, rect_max, 
-          [this,&visited_entries,desired_state](size_t linear_pos){
-            return this->_contained_data[linear_pos] == desired_state
-              && visited_entries[linear_pos] == data_state::empty;
-          });
-
-      rect found_rect = std::make_pair(pos, rect_size);
-      out.push_back(found_rect);
-
-      // Mark all pages inside the rect as visited
-      this->for_each_element_in_range(
-        found_rect, 
-        visited_entries,
-        [&](id<3> pos, data_state& entry){
-
-          entry = data_state::available;
-      });
+
+  const std::size_t num_x = r.second[0];
+  const std::size_t num_y = r.second[1];
+  const run z_range{r.first[2], r.first[2] + r.second[2]};
+  if(num_x == 0 || num_y == 0 || z_range.begin >= z_range.end)
+    return;
+
+  // Runs of the desired state within r for each scanline of r, and whether
+  // they have already been covered by a returned rect
+  std::vector<std::vector<run>> runs(num_x * num_y);
+  std::vector<std::vector<bool>> is_covered(num_x * num_y);
+  for(std::size_t x = 0; x < num_x; ++x) {
+    for(std::size_t y = 0; y < num_y; ++y) {
+      std::size_t line = x * num_y + y;
+      get_runs_in_state(
+          _scanlines[get_scanline_index(r.first[0] + x, r.first[1] + y)],
+          z_range, desired_state, runs[line]);
+      is_covered[line].resize(runs[line].size(), false);
     }
-  });
+  }
+
+  // Returns the index of an uncovered run in the given scanline that is
+  // equal to current, or -1 if there is none
+  auto find_uncovered_run = [&](std::size_t line, run current) -> long {
+    const auto& line_runs = runs[line];
+    auto it = std::lower_bound(
+        line_runs.begin(), line_runs.end(), current.begin,
+        [](const run &candidate, std::size_t pos) {
+          return candidate.begin < pos;
+        });
+    if(it == line_runs.end() || !(*it == current))
+      return -1;
+    long idx = it - line_runs.begin();
+    return is_covered[line][idx] ? -1 : idx;
+  };
+
+  for(std::size_t x = 0; x < num_x; ++x) {
+    for(std::size_t y = 0; y < num_y; ++y) {
+      std::size_t line = x * num_y + y;
+      for(std::size_t i = 0; i < runs[line].size(); ++i) {
+        if(is_covered[line][i])
+          continue;
+        const run current = runs[line][i];
+
+        // Grow the rect along y while the next scanline contains the
+        // same run, and then along x while the entire next surface does.
+        std::size_t y_size = 1;
+        while(y + y_size < num_y &&
+              find_uncovered_run(x * num_y + y + y_size, current) >= 0)
+          ++y_size;
+
+        std::size_t x_size = 1;
+        for(; x + x_size < num_x; ++x_size) {
+          bool surface_matches = true;
+          for(std::size_t dy = 0; dy < y_size && surface_matches; ++dy)
+            surface_matches =
+                find_uncovered_run((x + x_size) * num_y + y + dy, current) >= 0;
+          if(!surface_matches)
+            break;
+        }
+
+        for(std::size_t dx = 0; dx < x_size; ++dx) {
+          for(std::size_t dy = 0; dy < y_size; ++dy) {
+            std::size_t covered_line = (x + dx) * num_y + y + dy;
+            is_covered[covered_line][find_uncovered_run(covered_line,
+                                                        current)] = true;
+          }
+        }
+
+        out.push_back(std::make_pair(
+            id<3>{r.first[0] + x, r.first[1] + y, current.begin},
+            range<3>{x_size, y_size, current.end - current.begin}));
+      }
+    }
+  }
 }
 
 bool range_store::entire_range_equals(
     const rect& r, data_state desired_state) const
 {
-  for(size_t x = r.first[0]; x < r.second[0]+r.first[0]; ++x){
-    for(size_t y = r.first[1]; y < r.second[1]+r.first[1]; ++y){
-      for(size_t z = r.first[2]; z < r.second[2]+r.first[2]; ++z){
-
-        id<3> idx{x,y,z};
-        size_t pos = get_index(idx);
-        if(_contained_data[pos] != desired_state)
-          return false;
-      }
+  const run z_range{r.first[2], r.first[2] + r.second[2]};
+  if(z_range.begin >= z_range.end)
+    return true;
+
+  bool result = true;
+  this->for_each_scanline_in_range(r, [&](const scanline& line){
+    if(!result)
+      return;
+    // First run that ends after the beginning of the range
+    auto it = std::upper_bound(
+        line.begin(), line.end(), z_range.begin,
+        [](std::size_t pos, const run &current) { return pos < current.end; });
+    if(desired_state == data_state::available) {
+      // Runs are non-adjacent, so a single run must cover the range
+      result = it != line.end() && it->begin <= z_range.begin &&
+               it->end >= z_range.end;
+    } else {
+      result = it == line.end() || it->begin >= z_range.end;
     }
-  }
+  });
 
-  return true;
+  return result;
 }
 
 }
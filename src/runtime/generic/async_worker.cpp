@@ -9,6 +9,7 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/generic/async_worker.hpp"
+#include "hipSYCL/runtime/generic/spin_wait.hpp"
 #include "hipSYCL/common/debug.hpp"
 
 #include <cassert>
@@ -18,7 +19,8 @@ namespace hipsycl {
 namespace rt {
 
 worker_thread::worker_thread()
-    : _continue{true}
+    : _continue{true}, _num_pending_operations{0}, _is_worker_parked{false},
+      _num_parked_waiters{0}
 {
   _worker_thread = std::thread{[this](){ work(); } };
 }
@@ -28,20 +30,24 @@ worker_thread::~worker_thread()
 {
   halt();
 
-  assert(_enqueued_operations.empty());
+  assert(queue_size() == 0);
 }
 
 void worker_thread::wait()
 {
+  auto is_idle = [this]() {
+    return _num_pending_operations.load(std::memory_order_acquire) == 0;
+  };
+  if(spin_until(is_idle))
+    return;
+
   std::unique_lock<std::mutex> lock(_mutex);
-  if(!_enqueued_operations.empty())
-  {
-    // Before going to sleep, wake up the other thread to avoid deadlocks
-    _condition_wait.notify_all();
-    // Wait until no operation is pending
-    _condition_wait.wait(lock, [this]{return _enqueued_operations.empty();});
-  }
-  assert(_enqueued_operations.empty());
+  _num_parked_waiters.fetch_add(1, std::memory_order_seq_cst);
+  // Wait until no operation is pending
+  _condition_idle.wait(lock, [this]{
+    return _num_pending_operations.load(std::memory_order_seq_cst) == 0;
+  });
+  _num_parked_waiters.fetch_sub(1, std::memory_order_relaxed);
 }
 
 
@@ -52,7 +58,7 @@ void worker_thread::halt()
   {
     std::unique_lock<std::mutex> lock(_mutex);
     _continue = false;
-    _condition_wait.notify_all();
+    _condition_work.notify_all();
   }
   if(_worker_thread.joinable())
     _worker_thread.join();
@@ -61,66 +67,61 @@ void worker_thread::halt()
 void worker_thread::work()
 {
   // This is the main function executed by the worker thread.
-  // The loop is executed as long as there are enqueued operations,
-  // (_is_operation_pending) or we should wait for new operations
-  // (_continue).
-  while(_continue || queue_size() > 0)
-  {
-    {
-      std::unique_lock<std::mutex> lock(_mutex);
-
-      // Before going to sleep, wake up the other thread in case it is is waiting
-      // for the queue to get empty
-      _condition_wait.notify_all();
-      // Wait until we have work, or until _continue becomes false
-      _condition_wait.wait(lock,
-                           [this](){
-        return _enqueued_operations.size()>0 || !_continue;
-      });
-    }
-
-    // In any way, process the pending operations
-
-    async_function operation = [](){};
-    bool has_operation = false;
-
-    {
-      std::lock_guard<std::mutex> lock(_mutex);
-
-      if(!_enqueued_operations.empty())
-      {
-        operation = _enqueued_operations.front();
-        has_operation = true;
+  // The loop is executed as long as there are pending operations,
+  // or we should wait for new operations (_continue).
+  auto has_work = [this]() {
+    return _num_pending_operations.load(std::memory_order_seq_cst) > 0 ||
+           !_continue.load(std::memory_order_acquire);
+  };
+
+  async_function operation;
+  for(;;) {
+    if(_enqueued_operations.pop(operation)) {
+      operation();
+      // Release resources held by the operation before signalling completion
+      operation.reset();
+
+      if (_num_pending_operations.fetch_sub(1, std::memory_order_seq_cst) ==
+              1 &&
+          _num_parked_waiters.load(std::memory_order_seq_cst) > 0) {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _condition_idle.notify_all();
       }
+      continue;
     }
 
-    operation();
-
-    {
-      std::lock_guard<std::mutex> lock{_mutex};
-      if(has_operation)
-        _enqueued_operations.pop();
-    }
+    if (!_continue.load(std::memory_order_acquire) &&
+        _num_pending_operations.load(std::memory_order_acquire) == 0)
+      return;
 
-    _condition_wait.notify_all();
+    // Operations might be pending, but not yet visible in the queue if
+    // the producer is still in the process of pushing them.
+    if(spin_until(has_work) &&
+       _num_pending_operations.load(std::memory_order_acquire) > 0)
+      continue;
 
+    std::unique_lock<std::mutex> lock(_mutex);
+    _is_worker_parked.store(true, std::memory_order_seq_cst);
+    // Wait until we have work, or until _continue becomes false
+    _condition_work.wait(lock, has_work);
+    _is_worker_parked.store(false, std::memory_order_relaxed);
   }
 }
 
 void worker_thread::operator()(worker_thread::async_function f)
 {
-  std::unique_lock<std::mutex> lock(_mutex);
-
-  _enqueued_operations.push(f);
+  _num_pending_operations.fetch_add(1, std::memory_order_seq_cst);
+  _enqueued_operations.push(std::move(f));
 
-  lock.unlock();
-  _condition_wait.notify_all();
+  if(_is_worker_parked.load(std::memory_order_seq_cst)) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _condition_work.notify_one();
+  }
 }
 
 std::size_t worker_thread::queue_size() const
 {
-  std::lock_guard<std::mutex> lock(_mutex);
-  return _enqueued_operations.size();
+  return _num_pending_operations.load(std::memory_order_acquire);
 }
 
 
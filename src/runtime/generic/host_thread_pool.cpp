@@ -0,0 +1,176 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/generic/host_thread_pool.hpp"
+#include "hipSYCL/runtime/generic/spin_wait.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+
+namespace hipsycl {
+namespace rt {
+
+host_thread_pool &host_thread_pool::get() {
+  static host_thread_pool pool{[]() -> std::size_t {
+    std::size_t num_threads =
+        application::get_settings().get<setting::host_thread_pool_size>();
+    if(num_threads == 0)
+      num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    // The calling thread also executes chunks
+    return num_threads - 1;
+  }()};
+  return pool;
+}
+
+host_thread_pool::host_thread_pool(std::size_t num_workers)
+    : _num_queued_chunks{0}, _next_submission_deque{0}, _continue{true},
+      _num_parked_workers{0} {
+  for(std::size_t i = 0; i < num_workers; ++i)
+    _deques.emplace_back(std::make_unique<chunk_deque>());
+
+  HIPSYCL_DEBUG_INFO << "host_thread_pool: Spawning " << num_workers
+                     << " worker threads" << std::endl;
+  for(std::size_t i = 0; i < num_workers; ++i)
+    _workers.emplace_back([this, i]() { work(i); });
+}
+
+host_thread_pool::~host_thread_pool() {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _continue = false;
+    _condition_work.notify_all();
+  }
+  for(auto& t : _workers)
+    if(t.joinable())
+      t.join();
+}
+
+void host_thread_pool::parallel_for(std::size_t n, std::size_t chunk_size,
+                                    chunk_function f, void *data) {
+  if(n == 0)
+    return;
+  chunk_size = std::max(chunk_size, std::size_t{1});
+
+  const std::size_t num_chunks = (n + chunk_size - 1) / chunk_size;
+  if(num_chunks == 1 || _workers.empty()) {
+    f(data, 0, n);
+    return;
+  }
+
+  job j;
+  j.f = f;
+  j.data = data;
+  j.num_remaining_chunks.store(num_chunks, std::memory_order_relaxed);
+
+  // Distribute chunks in contiguous blocks across the deques, starting at
+  // a rotating position such that concurrent submissions spread out.
+  const std::size_t num_deques = _workers.size();
+  const std::size_t first_deque =
+      _next_submission_deque.fetch_add(1, std::memory_order_relaxed) %
+      num_deques;
+  const std::size_t chunks_per_deque =
+      (num_chunks + num_deques - 1) / num_deques;
+
+  // Publish the number of chunks first, such that the counter never
+  // underflows when chunks are obtained immediately after being pushed.
+  _num_queued_chunks.fetch_add(num_chunks, std::memory_order_seq_cst);
+
+  for(std::size_t d = 0; d < num_deques; ++d) {
+    const std::size_t first_chunk = d * chunks_per_deque;
+    if(first_chunk >= num_chunks)
+      break;
+    const std::size_t last_chunk =
+        std::min(first_chunk + chunks_per_deque, num_chunks);
+
+    chunk_deque &target = *_deques[(first_deque + d) % num_deques];
+    std::lock_guard<std::mutex> lock{target.mutex};
+    for(std::size_t c = first_chunk; c < last_chunk; ++c)
+      target.chunks.push_back(
+          chunk{&j, c * chunk_size, std::min((c + 1) * chunk_size, n)});
+  }
+
+  if(_num_parked_workers.load(std::memory_order_seq_cst) > 0) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _condition_work.notify_all();
+  }
+
+  // Help executing chunks until all chunks of this job have completed.
+  // This might also execute chunks of other jobs.
+  chunk c;
+  while(j.num_remaining_chunks.load(std::memory_order_acquire) > 0) {
+    if(try_obtain_chunk(first_deque, c))
+      run_chunk(c);
+    else
+      cpu_relax();
+  }
+}
+
+bool host_thread_pool::try_obtain_chunk(std::size_t preferred_deque,
+                                        chunk &out) {
+  if(_num_queued_chunks.load(std::memory_order_acquire) == 0)
+    return false;
+
+  const std::size_t num_deques = _deques.size();
+  for(std::size_t i = 0; i < num_deques; ++i) {
+    chunk_deque &d = *_deques[(preferred_deque + i) % num_deques];
+    std::lock_guard<std::mutex> lock{d.mutex};
+    if(!d.chunks.empty()) {
+      // Take work from the front of our own deque, and steal from the
+      // back of others to keep chunks of one job on one thread
+      // contiguous.
+      if(i == 0) {
+        out = d.chunks.front();
+        d.chunks.pop_front();
+      } else {
+        out = d.chunks.back();
+        d.chunks.pop_back();
+      }
+      _num_queued_chunks.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void host_thread_pool::run_chunk(const chunk &c) {
+  job* parent = c.parent;
+  parent->f(parent->data, c.begin, c.end);
+  // The job object might be destroyed as soon as the last chunk
+  // completes, so it must not be accessed afterwards.
+  parent->num_remaining_chunks.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void host_thread_pool::work(std::size_t worker_id) {
+  auto has_work = [this]() {
+    return _num_queued_chunks.load(std::memory_order_seq_cst) > 0 ||
+           !_continue.load(std::memory_order_acquire);
+  };
+
+  chunk c;
+  while(_continue.load(std::memory_order_acquire)) {
+    if(try_obtain_chunk(worker_id, c)) {
+      run_chunk(c);
+      continue;
+    }
+
+    if(spin_until(has_work))
+      continue;
+
+    std::unique_lock<std::mutex> lock{_mutex};
+    _num_parked_workers.fetch_add(1, std::memory_order_seq_cst);
+    _condition_work.wait(lock, has_work);
+    _num_parked_workers.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+}
+}
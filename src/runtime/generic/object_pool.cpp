@@ -0,0 +1,138 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/generic/object_pool.hpp"
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr std::size_t num_size_classes =
+    object_pool::max_pooled_size / object_pool::granularity;
+// Number of blocks that are moved between thread-local and global free lists
+// at once
+constexpr std::size_t batch_size = 32;
+// Blocks beyond this number per size class are returned to the system
+constexpr std::size_t max_global_blocks = 4096;
+
+std::size_t get_size_class(std::size_t size) {
+  return (size + object_pool::granularity - 1) / object_pool::granularity - 1;
+}
+
+std::size_t get_block_size(std::size_t size_class) {
+  return (size_class + 1) * object_pool::granularity;
+}
+
+using free_lists = std::array<std::vector<void*>, num_size_classes>;
+
+class global_free_lists {
+public:
+  static global_free_lists& get() {
+    // Intentionally leaked, since thread-local free lists might still be
+    // returned during static destruction.
+    static global_free_lists* lists = new global_free_lists;
+    return *lists;
+  }
+
+  // Moves up to batch_size blocks into out
+  void refill(std::size_t size_class, std::vector<void*>& out) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto& blocks = _lists[size_class];
+    while(!blocks.empty() && out.size() < batch_size) {
+      out.push_back(blocks.back());
+      blocks.pop_back();
+    }
+  }
+
+  // Takes ownership of the last num_blocks blocks of in
+  void release(std::size_t size_class, std::vector<void*>& in,
+               std::size_t num_blocks) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto& blocks = _lists[size_class];
+    for(std::size_t i = 0; i < num_blocks && !in.empty(); ++i) {
+      if(blocks.size() < max_global_blocks)
+        blocks.push_back(in.back());
+      else
+        ::operator delete(in.back());
+      in.pop_back();
+    }
+  }
+private:
+  std::mutex _mutex;
+  free_lists _lists;
+};
+
+// Objects might still be destroyed after thread-local objects of the thread,
+// e.g. during static destruction. Those bypass the pool.
+thread_local bool is_local_free_lists_destroyed = false;
+
+class thread_local_free_lists {
+public:
+  ~thread_local_free_lists() {
+    for(std::size_t i = 0; i < num_size_classes; ++i)
+      global_free_lists::get().release(i, _lists[i], _lists[i].size());
+    is_local_free_lists_destroyed = true;
+  }
+
+  std::vector<void*>& get(std::size_t size_class) {
+    return _lists[size_class];
+  }
+private:
+  free_lists _lists;
+};
+
+thread_local thread_local_free_lists local_free_lists;
+
+}
+
+void* object_pool::allocate(std::size_t size) {
+  if(size == 0 || size > max_pooled_size || is_local_free_lists_destroyed)
+    return ::operator new(size);
+
+  const std::size_t size_class = get_size_class(size);
+  auto& blocks = local_free_lists.get(size_class);
+  if(blocks.empty())
+    global_free_lists::get().refill(size_class, blocks);
+
+  if(!blocks.empty()) {
+    void* ptr = blocks.back();
+    blocks.pop_back();
+    return ptr;
+  }
+  return ::operator new(get_block_size(size_class));
+}
+
+void object_pool::deallocate(void* ptr, std::size_t size) noexcept {
+  if(!ptr)
+    return;
+  if(size == 0 || size > max_pooled_size || is_local_free_lists_destroyed) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  const std::size_t size_class = get_size_class(size);
+  auto& blocks = local_free_lists.get(size_class);
+  try {
+    blocks.push_back(ptr);
+  } catch(...) {
+    ::operator delete(ptr);
+    return;
+  }
+  if(blocks.size() > 2 * batch_size)
+    global_free_lists::get().release(size_class, blocks, batch_size);
+}
+
+}
+}
@@ -0,0 +1,191 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/group_size_autotuner.hpp"
+#include "hipSYCL/runtime/group_size_cache.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <limits>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Number of measured invocations per candidate. The fastest one counts,
+// to limit the influence of e.g. cold caches.
+constexpr std::size_t num_samples_per_candidate = 3;
+
+std::vector<range<3>> get_candidate_group_sizes(const range<3> &global_range,
+                                                std::size_t max_group_size) {
+  std::vector<range<3>> all_candidates;
+  int dimension = group_size_cache::get_dimension(global_range);
+  if(dimension == 1) {
+    all_candidates = {
+        {64, 1, 1}, {128, 1, 1}, {256, 1, 1}, {512, 1, 1}, {1024, 1, 1}};
+  } else if(dimension == 2) {
+    all_candidates = {{8, 8, 1},   {16, 8, 1},  {16, 16, 1},
+                      {32, 8, 1},  {32, 16, 1}, {64, 4, 1},
+                      {32, 32, 1}};
+  } else {
+    all_candidates = {
+        {8, 8, 4}, {16, 8, 4}, {8, 8, 8}, {32, 4, 4}, {16, 16, 4}};
+  }
+
+  std::vector<range<3>> result;
+  for(const auto& c : all_candidates) {
+    if(c.size() > max_group_size || c.size() > global_range.size())
+      continue;
+    result.push_back(c);
+  }
+  return result;
+}
+
+}
+
+group_size_autotuner& group_size_autotuner::get() {
+  static group_size_autotuner tuner;
+  return tuner;
+}
+
+bool group_size_autotuner::is_enabled() {
+  static const bool is_enabled =
+      application::get_settings().get<setting::adaptivity_level>() > 2;
+  return is_enabled;
+}
+
+std::optional<range<3>> group_size_autotuner::select_candidate(
+    const kernel_configuration::id_type &key, const range<3> &global_range,
+    std::size_t max_group_size) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _states.find(key);
+  if(it == _states.end()) {
+    tuning_state state;
+    for(const auto& group_size :
+        get_candidate_group_sizes(global_range, max_group_size))
+      state.candidates.push_back(candidate{group_size});
+    // Nothing to tune if there are no alternatives
+    state.is_complete = state.candidates.size() < 2;
+    it = _states.emplace(key, std::move(state)).first;
+  }
+
+  tuning_state &state = it->second;
+  if(state.is_complete)
+    return {};
+
+  evaluate_completed_measurements(state);
+  try_complete(key, state);
+  if(state.is_complete)
+    return {};
+
+  candidate* selected = nullptr;
+  for(auto& c : state.candidates) {
+    if(!c.is_discarded && c.num_issued_samples < num_samples_per_candidate &&
+       (!selected || c.num_issued_samples < selected->num_issued_samples))
+      selected = &c;
+  }
+  if(!selected)
+    // All samples issued, but not all of them have completed yet.
+    return {};
+
+  ++selected->num_issued_samples;
+  return selected->group_size;
+}
+
+void group_size_autotuner::add_measurement(
+    const kernel_configuration::id_type &key, const range<3> &group_size,
+    measurement m) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _states.find(key);
+  if(it == _states.end())
+    return;
+  tuning_state &state = it->second;
+  for(std::size_t i = 0; i < state.candidates.size(); ++i) {
+    if(state.candidates[i].group_size == group_size) {
+      state.pending_measurements.emplace_back(i, std::move(m));
+      return;
+    }
+  }
+}
+
+void group_size_autotuner::discard_candidate(
+    const kernel_configuration::id_type &key, const range<3> &group_size) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _states.find(key);
+  if(it == _states.end())
+    return;
+  if(candidate* c = find_candidate(it->second, group_size))
+    c->is_discarded = true;
+}
+
+group_size_autotuner::candidate *
+group_size_autotuner::find_candidate(tuning_state &state,
+                                     const range<3> &group_size) {
+  for(auto& c : state.candidates)
+    if(c.group_size == group_size)
+      return &c;
+  return nullptr;
+}
+
+void group_size_autotuner::evaluate_completed_measurements(
+    tuning_state &state) {
+  auto &pending = state.pending_measurements;
+  for(std::size_t i = 0; i < pending.size();) {
+    if(!pending[i].second.completion_event->is_complete()) {
+      ++i;
+      continue;
+    }
+
+    candidate &c = state.candidates[pending[i].first];
+    uint64_t duration =
+        profiler_clock::ns_ticks(pending[i].second.finish->get_time_point()) -
+        profiler_clock::ns_ticks(pending[i].second.start->get_time_point());
+    if(c.num_completed_samples == 0 || duration < c.best_duration)
+      c.best_duration = duration;
+    ++c.num_completed_samples;
+
+    pending[i] = std::move(pending.back());
+    pending.pop_back();
+  }
+}
+
+void group_size_autotuner::try_complete(
+    const kernel_configuration::id_type &key, tuning_state &state) {
+  const candidate* best = nullptr;
+  for(const auto& c : state.candidates) {
+    if(c.is_discarded)
+      continue;
+    if(c.num_completed_samples < num_samples_per_candidate)
+      return;
+    if(!best || c.best_duration < best->best_duration)
+      best = &c;
+  }
+
+  state.is_complete = true;
+  state.pending_measurements.clear();
+  if(!best)
+    return;
+
+  HIPSYCL_DEBUG_INFO << "group_size_autotuner: Kernel "
+                     << kernel_configuration::to_string(key)
+                     << " is fastest with group size " << best->group_size[0]
+                     << "x" << best->group_size[1] << "x"
+                     << best->group_size[2] << " (" << best->best_duration
+                     << " ns)" << std::endl;
+  group_size_cache::get().store(key, best->group_size, true);
+}
+
+}
+}
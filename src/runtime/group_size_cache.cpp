@@ -0,0 +1,119 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/group_size_cache.hpp"
+#include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <algorithm>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Base configuration parameter that distinguishes group size cache keys
+// from the ids of kernel configurations
+constexpr int group_size_key_tag = 1000;
+
+}
+
+group_size_cache& group_size_cache::get() {
+  static group_size_cache cache;
+  return cache;
+}
+
+kernel_configuration::id_type group_size_cache::get_key(
+    backend_id backend, hcf_object_id hcf_object, std::string_view kernel_name,
+    const std::string &device_name, int dimension) {
+  kernel_configuration config;
+  config.append_base_configuration(kernel_base_config_parameter::backend_id,
+                                   backend);
+  config.append_base_configuration(kernel_base_config_parameter::hcf_object_id,
+                                   hcf_object);
+  config.append_base_configuration(kernel_base_config_parameter::single_kernel,
+                                   kernel_name);
+  config.append_base_configuration(kernel_base_config_parameter::target_arch,
+                                   device_name);
+
+  kernel_configuration::id_type id = config.generate_id();
+  kernel_configuration::extend_hash(id, group_size_key_tag, dimension);
+  return id;
+}
+
+int group_size_cache::get_dimension(const range<3> &global_range) {
+  if(global_range[1] == 1 && global_range[2] == 1)
+    return 1;
+  if(global_range[2] == 1)
+    return 2;
+  return 3;
+}
+
+range<3> group_size_cache::make_group_size(std::size_t num_work_items,
+                                           int dimension) {
+  num_work_items = std::max(num_work_items, std::size_t{1});
+  if(dimension == 1)
+    return range<3>{num_work_items, 1, 1};
+  // Keep a warp-sized extent in the fastest dimension for coalescing
+  std::size_t x = std::min(num_work_items, std::size_t{32});
+  return range<3>{x, num_work_items / x, 1};
+}
+
+std::optional<group_size_cache::entry>
+group_size_cache::get(const kernel_configuration::id_type &key) {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _entries.find(key);
+  if(it != _entries.end())
+    return it->second;
+
+  std::optional<entry> result;
+  auto &appdb =
+      common::filesystem::persistent_storage::get().get_this_app_db();
+  appdb.read_entry<common::db::group_size_entry>(
+      key, [&](const common::db::group_size_entry *db_entry) {
+        if(db_entry)
+          result = entry{range<3>{db_entry->x, db_entry->y, db_entry->z},
+                         db_entry->is_autotuned};
+      });
+  _entries[key] = result;
+  return result;
+}
+
+void group_size_cache::store(const kernel_configuration::id_type &key,
+                             const range<3> &group_size, bool is_autotuned) {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto &current = _entries[key];
+    if(!is_autotuned && current.has_value() && current->is_autotuned)
+      return;
+    current = entry{group_size, is_autotuned};
+  }
+
+  HIPSYCL_DEBUG_INFO << "group_size_cache: Selecting "
+                     << (is_autotuned ? "autotuned " : "") << "group size "
+                     << group_size[0] << "x" << group_size[1] << "x"
+                     << group_size[2] << " for kernel "
+                     << kernel_configuration::to_string(key) << std::endl;
+
+  auto &appdb =
+      common::filesystem::persistent_storage::get().get_this_app_db();
+  appdb.read_write_entry<common::db::group_size_entry>(
+      key, [&](common::db::group_size_entry &db_entry) {
+        db_entry.x = group_size[0];
+        db_entry.y = group_size[1];
+        db_entry.z = group_size[2];
+        db_entry.is_autotuned = is_autotuned;
+      });
+}
+
+}
+}
@@ -12,18 +12,141 @@
 #include "hipSYCL/runtime/hip/hip_allocator.hpp"
 #include "hipSYCL/runtime/hip/hip_device_manager.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+
+#include <cstdint>
+#include <limits>
+
+#if HIP_VERSION_MAJOR > 5 || (HIP_VERSION_MAJOR == 5 && HIP_VERSION_MINOR >= 2)
+#define ACPP_HIP_HAS_MEM_POOLS 1
+#else
+#define ACPP_HIP_HAS_MEM_POOLS 0
+#endif
 
 namespace hipsycl {
 namespace rt {
 
 hip_allocator::hip_allocator(backend_descriptor desc, int hip_device)
     : _backend_descriptor{desc}, _dev{hip_device}
-{}
+{
+  if(application::get_settings().get<setting::stream_ordered_allocation>())
+    init_mem_pool();
+}
+
+hip_allocator::~hip_allocator() {
+  if(_allocation_stream) {
+    hip_device_manager::get().activate_device(_dev);
+    hipStreamSynchronize(_allocation_stream);
+    hipStreamDestroy(_allocation_stream);
+  }
+#if ACPP_HIP_HAS_MEM_POOLS
+  // If allocations are still outstanding, the pool is released
+  // once they are freed.
+  if(_mem_pool)
+    hipMemPoolDestroy(_mem_pool);
+#endif
+}
+
+void hip_allocator::init_mem_pool() {
+#if ACPP_HIP_HAS_MEM_POOLS
+  hip_device_manager::get().activate_device(_dev);
+
+  int supports_pools = 0;
+  hipError_t err = hipDeviceGetAttribute(
+      &supports_pools, hipDeviceAttributeMemoryPoolsSupported, _dev);
+  if(err != hipSuccess || !supports_pools) {
+    HIPSYCL_DEBUG_WARNING << "hip_allocator: Device " << _dev
+                          << " does not support memory pools, stream-ordered "
+                             "allocation will not be used."
+                          << std::endl;
+    return;
+  }
+
+  hipMemPoolProps props{};
+  props.allocType = hipMemAllocationTypePinned;
+  props.location.type = hipMemLocationTypeDevice;
+  props.location.id = _dev;
+
+  hipMemPool_t pool;
+  err = hipMemPoolCreate(&pool, &props);
+  if(err != hipSuccess) {
+    register_error(__acpp_here(),
+                   error_info{"hip_allocator: hipMemPoolCreate() failed",
+                              error_code{"HIP", err}});
+    return;
+  }
+
+  std::size_t release_threshold_mib =
+      application::get_settings().get<setting::mem_pool_release_threshold>();
+  std::uint64_t release_threshold =
+      release_threshold_mib == 0
+          ? std::numeric_limits<std::uint64_t>::max()
+          : static_cast<std::uint64_t>(release_threshold_mib) * 1024 * 1024;
+  int opportunistic_reuse =
+      application::get_settings().get<setting::mem_pool_opportunistic_reuse>()
+          ? 1
+          : 0;
+
+  err = hipMemPoolSetAttribute(pool, hipMemPoolAttrReleaseThreshold,
+                               &release_threshold);
+  if(err == hipSuccess)
+    err = hipMemPoolSetAttribute(pool, hipMemPoolReuseAllowOpportunistic,
+                                 &opportunistic_reuse);
+  if(err != hipSuccess) {
+    register_error(__acpp_here(),
+                   error_info{"hip_allocator: hipMemPoolSetAttribute() failed",
+                              error_code{"HIP", err}});
+    hipMemPoolDestroy(pool);
+    return;
+  }
+
+  hipStream_t stream;
+  err = hipStreamCreateWithFlags(&stream, hipStreamNonBlocking);
+  if(err != hipSuccess) {
+    register_error(__acpp_here(),
+                   error_info{"hip_allocator: hipStreamCreateWithFlags() failed",
+                              error_code{"HIP", err}});
+    hipMemPoolDestroy(pool);
+    return;
+  }
+
+  _mem_pool = pool;
+  _allocation_stream = stream;
+#else
+  HIPSYCL_DEBUG_WARNING << "hip_allocator: Stream-ordered allocation requires "
+                           "ROCm 5.2 or newer, ignoring request."
+                        << std::endl;
+#endif
+}
       
 void *hip_allocator::allocate(size_t min_alignment, size_t size_bytes)
 {
   void *ptr;
   hip_device_manager::get().activate_device(_dev);
+#if ACPP_HIP_HAS_MEM_POOLS
+  if(_mem_pool) {
+    hipError_t err = hipMallocFromPoolAsync(&ptr, size_bytes, _mem_pool,
+                                             _allocation_stream);
+    // Allocations are only ordered w.r.t. the allocation stream, but might be
+    // used on any stream once we return.
+    if(err == hipSuccess)
+      err = hipStreamSynchronize(_allocation_stream);
+
+    if (err != hipSuccess) {
+      register_error(__acpp_here(),
+                     error_info{"hip_allocator: hipMallocFromPoolAsync() failed",
+                                error_code{"HIP", err},
+                                error_type::memory_allocation_error});
+      return nullptr;
+    }
+    runtime_statistics::get().register_allocation(
+        ptr, size_bytes, device_id{_backend_descriptor, _dev},
+        allocation_kind::device);
+    return ptr;
+  }
+#endif
   hipError_t err = hipMalloc(&ptr, size_bytes);
 
   if (err != hipSuccess) {
@@ -34,6 +157,9 @@ void *hip_allocator::allocate(size_t min_alignment, size_t size_bytes)
     return nullptr;
   }
 
+  runtime_statistics::get().register_allocation(
+      ptr, size_bytes, device_id{_backend_descriptor, _dev},
+      allocation_kind::device);
   return ptr;
 }
 
@@ -51,11 +177,14 @@ void *hip_allocator::allocate_optimized_host(size_t min_alignment,
                               error_type::memory_allocation_error});
     return nullptr;
   }
+  runtime_statistics::get().register_allocation(
+      ptr, bytes, device_id{_backend_descriptor, _dev},
+      allocation_kind::optimized_host);
   return ptr;
 }
 
 void hip_allocator::free(void *mem) {
-
+  runtime_statistics::get().register_deallocation(mem);
   pointer_info info;
   result query_result = query_pointer(mem, info);
 
@@ -67,6 +196,12 @@ void hip_allocator::free(void *mem) {
   hipError_t err;
   if (info.is_optimized_host)
     err = hipHostFree(mem);
+#if ACPP_HIP_HAS_MEM_POOLS
+  // Memory is only freed once all preceding operations on the allocation
+  // stream have completed, and does not synchronize with the device.
+  else if (_mem_pool && !info.is_usm)
+    err = hipFreeAsync(mem, _allocation_stream);
+#endif
   else
     err = hipFree(mem);
   
@@ -92,6 +227,9 @@ void * hip_allocator::allocate_usm(size_t bytes)
     return nullptr;
   }
 
+  runtime_statistics::get().register_allocation(
+      ptr, bytes, device_id{_backend_descriptor, _dev},
+      allocation_kind::shared);
   return ptr;
 }
 
@@ -173,5 +311,24 @@ result hip_allocator::mem_advise(const void *addr, std::size_t num_bytes,
   return make_success();
 }
 
+result hip_allocator::set_preferred_device_residency(const void *addr,
+                                                     std::size_t num_bytes,
+                                                     bool prefer_device) const {
+#ifndef HIPSYCL_RT_NO_HIP_MANAGED_MEMORY
+  hipError_t err = hipMemAdvise(
+      addr, num_bytes,
+      prefer_device ? hipMemAdviseSetPreferredLocation
+                    : hipMemAdviseUnsetPreferredLocation,
+      _dev);
+  if(err != hipSuccess) {
+    return make_error(
+      __acpp_here(),
+      error_info{"hip_allocator: hipMemAdvise() failed", error_code{"HIP", err}}
+    );
+  }
+#endif
+  return make_success();
+}
+
 }
 }
@@ -9,12 +9,19 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/backend_loader.hpp"
+#include "hipSYCL/runtime/application.hpp"
 
 #include "hipSYCL/runtime/hip/hip_backend.hpp"
 #include "hipSYCL/runtime/hip/hip_event.hpp"
 #include "hipSYCL/runtime/hip/hip_target.hpp"
 #include "hipSYCL/runtime/hip/hip_queue.hpp"
 #include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/amdgpu/LLVMToAmdgpuFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
 
 HIPSYCL_PLUGIN_API_EXPORT
 hipsycl::rt::backend *hipsycl_backend_plugin_create() {
@@ -35,10 +42,31 @@ namespace rt {
 
 namespace {
 
+void register_jit_recipe_compiler() {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  kernel_cache::get()->register_jit_recipe_compiler(
+      backend_id::hip,
+      [](const common::db::jit_recipe &recipe,
+         kernel_cache::code_object_id id_of_binary, std::string &out) {
+        std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+            compiler::createLLVMToAmdgpuTranslator(recipe.kernels);
+        return glue::jit::precompilation::compile(
+                   translator.get(), recipe, id_of_binary, out)
+            .is_success();
+      });
+#endif
+}
+
 std::unique_ptr<multi_queue_executor>
 create_multi_queue_executor(hip_backend *b) {
   return std::make_unique<multi_queue_executor>(
-      *b, [b](device_id dev) { return std::make_unique<hip_queue>(b, dev); });
+      *b,
+      [b](device_id dev, int priority) {
+        return std::make_unique<hip_queue>(b, dev, priority);
+      },
+      application::get_settings()
+          .get<setting::hip_direction_aware_memcpy_lanes>(),
+      true);
 }
 
 }
@@ -47,7 +75,9 @@ hip_backend::hip_backend()
     : _hw_manager{hip_backend::get_hardware_platform()},
       _executor{[this]() {
         return create_multi_queue_executor(this);
-      }} {}
+      }} {
+  register_jit_recipe_compiler();
+}
 
 api_platform hip_backend::get_api_platform() const {
   return api_platform::hip;
@@ -98,6 +128,14 @@ hip_event_pool* hip_backend::get_event_pool(device_id dev) const {
       ->get_event_pool();
 }
 
+staging_buffer_pool *
+hip_backend::get_staging_buffer_pool(device_id dev) const {
+  assert(dev.get_backend() == this->get_unique_backend_id());
+  return static_cast<hip_hardware_context *>(
+             get_hardware_manager()->get_device(dev.get_id()))
+      ->get_staging_buffer_pool();
+}
+
 std::string hip_backend::get_name() const {
   return "HIP";
 }
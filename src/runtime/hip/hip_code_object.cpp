@@ -14,6 +14,9 @@
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/hip/hip_device_manager.hpp"
 #include "hipSYCL/runtime/hip/hip_target.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace hipsycl {
@@ -36,12 +39,112 @@ void unload_hip_module(ihipModule_t* module, int device) {
   }
 }
 
+template<class T>
+bool read_at(std::string_view image, std::size_t offset, T& out) {
+  if(offset > image.size() || image.size() - offset < sizeof(T))
+    return false;
+  std::memcpy(&out, image.data() + offset, sizeof(T));
+  return true;
+}
+
+bool add_extent(uint64_t offset, uint64_t size, uint64_t& extent) {
+  if(offset + size < offset)
+    return false;
+  extent = std::max(extent, offset + size);
+  return true;
+}
+
+// Determines how many bytes hipModuleLoadData() reads from an image, based
+// on the headers of the image since the function does not take a size.
+// Supports ELF64 code objects as generated by JIT compilation, and clang
+// offload bundles as embedded for multipass compilation. Returns false
+// if the headers are inconsistent, and sets extent to 0 for other formats.
+bool get_hip_image_extent(std::string_view image, uint64_t& extent) {
+  extent = 0;
+  constexpr std::string_view elf_magic = "\x7f" "ELF";
+  constexpr std::string_view bundle_magic = "__CLANG_OFFLOAD_BUNDLE__";
+
+  if(image.substr(0, elf_magic.size()) == elf_magic) {
+    uint8_t elf_class = 0;
+    uint64_t program_headers_offset = 0, section_headers_offset = 0;
+    uint16_t header_size = 0, program_header_size = 0, num_program_headers = 0;
+    uint16_t section_header_size = 0, num_section_headers = 0;
+    if(!read_at(image, 4, elf_class) || elf_class != 2 /* ELFCLASS64 */ ||
+       !read_at(image, 0x20, program_headers_offset) ||
+       !read_at(image, 0x28, section_headers_offset) ||
+       !read_at(image, 0x34, header_size) ||
+       !read_at(image, 0x36, program_header_size) ||
+       !read_at(image, 0x38, num_program_headers) ||
+       !read_at(image, 0x3a, section_header_size) ||
+       !read_at(image, 0x3c, num_section_headers))
+      return false;
+
+    extent = header_size;
+    if(!add_extent(program_headers_offset,
+                   uint64_t{program_header_size} * num_program_headers, extent) ||
+       !add_extent(section_headers_offset,
+                   uint64_t{section_header_size} * num_section_headers, extent))
+      return false;
+    // Section headers must lie within the image before we can read them
+    if(extent > image.size())
+      return true;
+
+    for(uint16_t i = 0; i < num_section_headers; ++i) {
+      uint64_t header = section_headers_offset + uint64_t{i} * section_header_size;
+      uint32_t type = 0;
+      uint64_t offset = 0, size = 0;
+      if(!read_at(image, header + 0x4, type) ||
+         !read_at(image, header + 0x18, offset) ||
+         !read_at(image, header + 0x20, size))
+        return false;
+      // SHT_NOBITS sections do not occupy space in the image
+      if(type != 8 && !add_extent(offset, size, extent))
+        return false;
+    }
+    return true;
+  } else if(image.substr(0, bundle_magic.size()) == bundle_magic) {
+    uint64_t num_entries = 0;
+    uint64_t pos = bundle_magic.size();
+    if(!read_at(image, pos, num_entries))
+      return false;
+    pos += sizeof(uint64_t);
+    extent = pos;
+    for(uint64_t i = 0; i < num_entries; ++i) {
+      uint64_t offset = 0, size = 0, id_size = 0;
+      if(!read_at(image, pos, offset) ||
+         !read_at(image, pos + 8, size) ||
+         !read_at(image, pos + 16, id_size) ||
+         !add_extent(offset, size, extent))
+        return false;
+      pos += 24;
+      if(!add_extent(pos, id_size, extent))
+        return false;
+      pos += id_size;
+      if(extent > image.size())
+        return true;
+    }
+    return true;
+  }
+  // Other formats, such as compressed offload bundles, are only embedded in
+  // the application and never read from the persistent cache.
+  return true;
+}
+
 result build_hip_module(ihipModule_t *&module, int device,
-                        const std::string &hip_fat_binary) {
+                        std::string_view hip_fat_binary) {
+  // hipModuleLoadData() does not take the size of the image, so make sure
+  // that it does not read beyond it.
+  uint64_t extent = 0;
+  if(!get_hip_image_extent(hip_fat_binary, extent) ||
+     extent > hip_fat_binary.size())
+    return make_error(
+        __acpp_here(),
+        error_info{"hip_executable_object: Code object is truncated"});
+
   // It's unclear if this is actually needed for HIP?
   hip_device_manager::get().activate_device(device);
 
-  auto err = hipModuleLoadData(&module, hip_fat_binary.c_str());
+  auto err = hipModuleLoadData(&module, hip_fat_binary.data());
 
   if(err == hipSuccess)
     return make_success();
@@ -54,6 +157,31 @@ result build_hip_module(ihipModule_t *&module, int device,
 }
 }
 
+result hip_executable_object::get_kernel(std::string_view kernel_name,
+                                         ihipModuleSymbol_t *&f) const {
+  std::lock_guard<std::mutex> lock{_kernel_lookup_mutex};
+
+  auto it = _kernels.find(kernel_name);
+  if(it != _kernels.end()) {
+    f = it->second;
+    return make_success();
+  }
+
+  // kernel_name is not guaranteed to be null-terminated
+  auto name = std::make_unique<std::string>(kernel_name);
+  hipError_t err = hipModuleGetFunction(&f, get_module(), name->c_str());
+  if(err != hipSuccess) {
+    return make_error(
+        __acpp_here(),
+        error_info{"hip_executable_object: could not extract kernel from module",
+                   error_code{"HIP", static_cast<int>(err)}});
+  }
+
+  _kernels[*name] = f;
+  _kernel_names_storage.push_back(std::move(name));
+  return make_success();
+}
+
 hip_multipass_executable_object::~hip_multipass_executable_object() {
   unload_hip_module(_module, _device);
 }
@@ -127,7 +255,7 @@ result hip_multipass_executable_object::build(const std::string& hip_fat_binary)
 }
 
 hip_sscp_executable_object::hip_sscp_executable_object(
-    const std::string &code_image, const std::string &target_arch,
+    std::string_view code_image, const std::string &target_arch,
     hcf_object_id hcf_source, const std::vector<std::string> &kernel_names,
     int device, const kernel_configuration &config)
     : _target{target_arch}, _origin{hcf_source}, _kernel_names{kernel_names},
@@ -179,7 +307,9 @@ bool hip_sscp_executable_object::contains(
     if(name == backend_kernel_name)
       return true;
   }
-  return false;
+  // Other formats, such as compressed offload bundles, are only embedded in
+  // the application and never read from the persistent cache.
+  return true;
 }
 
 ihipModule_t* hip_sscp_executable_object::get_module() const {
@@ -190,7 +320,7 @@ int hip_sscp_executable_object::get_device() const {
   return _device;
 }
 
-result hip_sscp_executable_object::build(const std::string& hip_fat_binary) {
+result hip_sscp_executable_object::build(std::string_view hip_fat_binary) {
   return build_hip_module(_module, _device, hip_fat_binary);
 }
 
@@ -12,6 +12,9 @@
 #include "hipSYCL/runtime/hip/hip_target.hpp"
 #include "hipSYCL/runtime/hip/hip_event_pool.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/generic/spin_wait.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -40,12 +43,22 @@ bool hip_node_event::is_complete() const
 
 void hip_node_event::wait()
 {
-  auto err = hipEventSynchronize(_evt);
-  if (err != hipSuccess) {
-    register_error(__acpp_here(),
-                   error_info{"hip_node_event: hipEventSynchronize() failed",
-                              error_code{"HIP", err}});
-  }
+  static wait_duration_predictor predictor;
+  static const uint64_t max_spin_ns =
+      1000 * application::get_settings().get<setting::max_wait_spin_time>();
+
+  hybrid_wait(
+      predictor, max_spin_ns,
+      [this]() { return hipEventQuery(_evt) != hipErrorNotReady; },
+      [this]() {
+        auto err = hipEventSynchronize(_evt);
+        if (err != hipSuccess) {
+          register_error(
+              __acpp_here(),
+              error_info{"hip_node_event: hipEventSynchronize() failed",
+                         error_code{"HIP", err}});
+        }
+      });
 }
 
 hipEvent_t hip_node_event::get_event() const
@@ -0,0 +1,432 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/hip/hip_hardware_counters.hpp"
+#include "hipSYCL/runtime/hip/hip_target.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <rocprofiler-sdk/registration.h>
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// Derived rocprofiler metrics in the order of the corresponding
+// hardware_counter values
+constexpr std::array<const char *, 4> metric_names = {
+    "OccupancyPercent", "FETCH_SIZE", "WRITE_SIZE", "L2CacheHit"};
+
+constexpr std::array<hardware_counter, 4> metric_counters = {
+    hardware_counter::achieved_occupancy, hardware_counter::dram_read_bytes,
+    hardware_counter::dram_write_bytes, hardware_counter::l2_hit_rate};
+
+// Metrics reported in percent are converted to fractions, and sizes in KiB
+// to bytes.
+constexpr std::array<double, 4> metric_scales = {0.01, 1024.0, 1024.0, 0.01};
+
+// Percentages are averaged across counter instances, sizes are summed
+constexpr std::array<bool, 4> metric_is_average = {true, false, false, true};
+
+// Maximum time to wait for the counter records of a completed kernel
+constexpr auto record_timeout = std::chrono::seconds{5};
+
+result make_rocprofiler_error(const std::string &msg,
+                              rocprofiler_status_t err) {
+  return make_error(
+      __acpp_here(),
+      error_info{"hip_hardware_counters: " + msg + ": " +
+                     rocprofiler_get_status_string(err),
+                 error_code{"rocprofiler", static_cast<int>(err)}});
+}
+
+// Whether the tool has been initialized by rocprofiler-sdk
+std::atomic<bool> is_tool_initialized{false};
+// Number of collections waiting for a dispatch, such that the dispatch
+// callback can return early for all other kernels.
+std::atomic<int> num_armed_profilers{0};
+
+}
+
+/// Profiler state of a HIP device. All kernel dispatches are intercepted
+/// by rocprofiler-sdk, but counters are only collected for the first
+/// dispatch after arm().
+class rocprofiler_device_profiler {
+public:
+  result init(int device_id) {
+    hipDeviceProp_t props;
+    auto hip_err = hipGetDeviceProperties(&props, device_id);
+    if(hip_err != hipSuccess)
+      return make_error(__acpp_here(),
+                        error_info{"hip_hardware_counters: Could not query "
+                                   "device properties",
+                                   error_code{"HIP", hip_err}});
+
+    struct agent_query {
+      const hipDeviceProp_t *props;
+      bool found;
+      rocprofiler_agent_id_t id;
+    } query{&props, false, rocprofiler_agent_id_t{}};
+
+    // Agents are identified by their PCI location, since the order of
+    // HIP devices can differ from the order of agents.
+    auto err = rocprofiler_query_available_agents(
+        ROCPROFILER_AGENT_INFO_VERSION_0,
+        [](rocprofiler_agent_version_t, const void **agents,
+           size_t num_agents, void *user_data) {
+          auto *q = static_cast<agent_query *>(user_data);
+          for(size_t i = 0; i < num_agents; ++i) {
+            const auto *agent = static_cast<const rocprofiler_agent_v0_t *>(
+                agents[i]);
+            if(agent->type == ROCPROFILER_AGENT_TYPE_GPU &&
+               static_cast<int>(agent->location_id >> 8) == q->props->pciBusID &&
+               static_cast<int>(agent->domain) == q->props->pciDomainID) {
+              q->found = true;
+              q->id = agent->id;
+            }
+          }
+          return ROCPROFILER_STATUS_SUCCESS;
+        },
+        sizeof(rocprofiler_agent_v0_t), &query);
+    if(err != ROCPROFILER_STATUS_SUCCESS)
+      return make_rocprofiler_error("Could not query agents", err);
+    if(!query.found)
+      return make_error(
+          __acpp_here(),
+          error_info{"hip_hardware_counters: No rocprofiler agent for device"});
+    _agent = query.id;
+
+    // Only the metrics that the agent supports are collected
+    std::vector<rocprofiler_counter_id_t> counters;
+    struct counter_query {
+      std::vector<rocprofiler_counter_id_t> *counters;
+      std::unordered_map<uint64_t, std::size_t> *metric_indices;
+    } cquery{&counters, &_metric_indices};
+    err = rocprofiler_iterate_agent_supported_counters(
+        _agent,
+        [](rocprofiler_agent_id_t, rocprofiler_counter_id_t *supported,
+           size_t num_supported, void *user_data) {
+          auto *q = static_cast<counter_query *>(user_data);
+          for(size_t i = 0; i < num_supported; ++i) {
+            rocprofiler_counter_info_v0_t info;
+            if(rocprofiler_query_counter_info(
+                   supported[i], ROCPROFILER_COUNTER_INFO_VERSION_0,
+                   static_cast<void *>(&info)) != ROCPROFILER_STATUS_SUCCESS)
+              continue;
+            for(std::size_t m = 0; m < metric_names.size(); ++m) {
+              if(std::strcmp(info.name, metric_names[m]) == 0) {
+                q->counters->push_back(supported[i]);
+                (*q->metric_indices)[supported[i].handle] = m;
+              }
+            }
+          }
+          return ROCPROFILER_STATUS_SUCCESS;
+        },
+        &cquery);
+    if(err != ROCPROFILER_STATUS_SUCCESS)
+      return make_rocprofiler_error("Could not query supported counters", err);
+    if(counters.empty())
+      return make_error(__acpp_here(),
+                        error_info{"hip_hardware_counters: Device does not "
+                                   "support any of the counters"});
+
+    err = rocprofiler_create_profile_config(_agent, counters.data(),
+                                            counters.size(), &_config);
+    if(err != ROCPROFILER_STATUS_SUCCESS)
+      return make_rocprofiler_error("Could not create profile config", err);
+
+    return make_success();
+  }
+
+  void arm() {
+    std::lock_guard<std::mutex> lock{_state_mutex};
+    _is_armed = true;
+    _has_dispatch = false;
+    _has_record = false;
+    _sums.fill(0.0);
+    _counts.fill(0);
+    ++num_armed_profilers;
+  }
+
+  void disarm() {
+    std::lock_guard<std::mutex> lock{_state_mutex};
+    if(_is_armed) {
+      _is_armed = false;
+      --num_armed_profilers;
+    }
+    // Records of a dispatch that is still in flight are ignored
+    _has_dispatch = false;
+  }
+
+  result wait_for_counters(std::shared_ptr<simple_hardware_counters> &out) {
+    std::unique_lock<std::mutex> lock{_state_mutex};
+    bool has_dispatch = _has_dispatch;
+    bool has_record = has_dispatch && _cv.wait_for(lock, record_timeout, [&]() {
+      return _has_record;
+    });
+    lock.unlock();
+    disarm();
+
+    if(!has_dispatch)
+      return make_error(
+          __acpp_here(),
+          error_info{"hip_hardware_counters: No kernel was profiled"});
+    if(!has_record)
+      return make_error(__acpp_here(),
+                        error_info{"hip_hardware_counters: Timed out waiting "
+                                   "for counter records"});
+
+    out = std::make_shared<simple_hardware_counters>();
+    for(std::size_t i = 0; i < metric_names.size(); ++i) {
+      if(_counts[i] == 0)
+        continue;
+      double value = _sums[i];
+      if(metric_is_average[i])
+        value /= static_cast<double>(_counts[i]);
+      out->set_value(metric_counters[i], value * metric_scales[i]);
+    }
+    return make_success();
+  }
+
+  std::mutex& get_mutex() {
+    return _mutex;
+  }
+
+  // Invoked by the dispatch callback for each kernel dispatch to the agent
+  void on_dispatch(uint64_t dispatch_id,
+                   rocprofiler_profile_config_id_t *config) {
+    std::lock_guard<std::mutex> lock{_state_mutex};
+    if(!_is_armed)
+      return;
+    _is_armed = false;
+    --num_armed_profilers;
+    _has_dispatch = true;
+    _dispatch_id = dispatch_id;
+    *config = _config;
+  }
+
+  // Invoked by the record callback once a profiled kernel has completed
+  void on_record(uint64_t dispatch_id, const rocprofiler_record_counter_t *records,
+                 size_t num_records) {
+    std::lock_guard<std::mutex> lock{_state_mutex};
+    if(!_has_dispatch || dispatch_id != _dispatch_id)
+      return;
+    for(size_t i = 0; i < num_records; ++i) {
+      rocprofiler_counter_id_t counter;
+      if(rocprofiler_query_record_counter_id(records[i].id, &counter) !=
+         ROCPROFILER_STATUS_SUCCESS)
+        continue;
+      auto it = _metric_indices.find(counter.handle);
+      if(it == _metric_indices.end())
+        continue;
+      _sums[it->second] += records[i].counter_value;
+      ++_counts[it->second];
+    }
+    _has_record = true;
+    _cv.notify_all();
+  }
+
+  // The profiler object of each device is created on first use. Returns
+  // nullptr if the device does not support profiling; the failure is only
+  // reported once.
+  static rocprofiler_device_profiler* get(int device_id) {
+    std::lock_guard<std::mutex> lock{get_registry_mutex()};
+    auto& profilers = get_profilers();
+    auto it = profilers.find(device_id);
+    if(it != profilers.end())
+      return it->second.get();
+
+    auto profiler = std::make_unique<rocprofiler_device_profiler>();
+    result res =
+        is_tool_initialized
+            ? profiler->init(device_id)
+            : make_error(__acpp_here(),
+                         error_info{"hip_hardware_counters: rocprofiler-sdk "
+                                    "tool is not registered, set "
+                                    "ACPP_RT_HIP_HARDWARE_COUNTERS=1"});
+    if(!res.is_success()) {
+      HIPSYCL_DEBUG_WARNING
+          << "hip_hardware_counters: Hardware counters are not available "
+             "for device "
+          << device_id << ", ignoring requests to collect them" << std::endl;
+      register_error(res);
+      profiler.reset();
+    }
+    auto* ptr = profiler.get();
+    profilers.emplace(device_id, std::move(profiler));
+    return ptr;
+  }
+
+  // Returns the profiler of the agent, or nullptr
+  static rocprofiler_device_profiler* find(rocprofiler_agent_id_t agent) {
+    std::lock_guard<std::mutex> lock{get_registry_mutex()};
+    for(auto& entry : get_profilers())
+      if(entry.second && entry.second->_agent.handle == agent.handle)
+        return entry.second.get();
+    return nullptr;
+  }
+
+private:
+  using profiler_map =
+      std::unordered_map<int, std::unique_ptr<rocprofiler_device_profiler>>;
+
+  static std::mutex& get_registry_mutex() {
+    static std::mutex mutex;
+    return mutex;
+  }
+
+  // Never destroyed, since rocprofiler callbacks may still be invoked
+  // at static destruction time.
+  static profiler_map& get_profilers() {
+    static auto* profilers = new profiler_map{};
+    return *profilers;
+  }
+
+  std::mutex _mutex;
+  rocprofiler_agent_id_t _agent{};
+  rocprofiler_profile_config_id_t _config{};
+  std::unordered_map<uint64_t, std::size_t> _metric_indices;
+
+  std::mutex _state_mutex;
+  std::condition_variable _cv;
+  bool _is_armed = false;
+  bool _has_dispatch = false;
+  bool _has_record = false;
+  uint64_t _dispatch_id = 0;
+  std::array<double, metric_names.size()> _sums{};
+  std::array<std::size_t, metric_names.size()> _counts{};
+};
+
+namespace {
+
+void dispatch_callback(rocprofiler_dispatch_counting_service_data_t dispatch_data,
+                       rocprofiler_profile_config_id_t *config,
+                       rocprofiler_user_data_t *, void *) {
+  if(num_armed_profilers.load(std::memory_order_acquire) == 0)
+    return;
+  if(auto *profiler =
+         rocprofiler_device_profiler::find(dispatch_data.dispatch_info.agent_id))
+    profiler->on_dispatch(dispatch_data.dispatch_info.dispatch_id, config);
+}
+
+void record_callback(rocprofiler_dispatch_counting_service_data_t dispatch_data,
+                     rocprofiler_record_counter_t *records, size_t num_records,
+                     rocprofiler_user_data_t, void *) {
+  if(auto *profiler =
+         rocprofiler_device_profiler::find(dispatch_data.dispatch_info.agent_id))
+    profiler->on_record(dispatch_data.dispatch_info.dispatch_id, records,
+                        num_records);
+}
+
+int tool_init(rocprofiler_client_finalize_t, void *) {
+  rocprofiler_context_id_t ctx{};
+  auto err = rocprofiler_create_context(&ctx);
+  if(err != ROCPROFILER_STATUS_SUCCESS) {
+    register_error(make_rocprofiler_error("Could not create context", err));
+    return -1;
+  }
+  err = rocprofiler_configure_callback_dispatch_counting_service(
+      ctx, dispatch_callback, nullptr, record_callback, nullptr);
+  if(err != ROCPROFILER_STATUS_SUCCESS) {
+    register_error(make_rocprofiler_error(
+        "Could not configure dispatch counting service", err));
+    return -1;
+  }
+  err = rocprofiler_start_context(ctx);
+  if(err != ROCPROFILER_STATUS_SUCCESS) {
+    register_error(make_rocprofiler_error("Could not start context", err));
+    return -1;
+  }
+  is_tool_initialized = true;
+  return 0;
+}
+
+void tool_fini(void *) {
+  is_tool_initialized = false;
+}
+
+rocprofiler_tool_configure_result_t *
+configure_tool(uint32_t, const char *, uint32_t,
+               rocprofiler_client_id_t *client_id) {
+  client_id->name = "AdaptiveCpp";
+  static rocprofiler_tool_configure_result_t cfg{
+      sizeof(rocprofiler_tool_configure_result_t), &tool_init, &tool_fini,
+      nullptr};
+  return &cfg;
+}
+
+}
+
+void hip_hardware_counter_collection::register_tool() {
+  if(!application::get_settings().get<setting::hip_hardware_counters>())
+    return;
+
+  auto err = rocprofiler_force_configure(&configure_tool);
+  if(err != ROCPROFILER_STATUS_SUCCESS)
+    print_warning(
+        __acpp_here(),
+        error_info{"hip_hardware_counters: Could not register with "
+                   "rocprofiler-sdk, hardware counters will not be "
+                   "available: " + std::string{rocprofiler_get_status_string(err)},
+                   error_code{"rocprofiler", static_cast<int>(err)}});
+}
+
+hip_hardware_counter_collection::hip_hardware_counter_collection(
+    int device_id)
+    : _profiler{rocprofiler_device_profiler::get(device_id)},
+      _is_active{false} {
+  if(!_profiler)
+    return;
+
+  _lock = std::unique_lock<std::mutex>{_profiler->get_mutex()};
+  _profiler->arm();
+  _is_active = true;
+}
+
+hip_hardware_counter_collection::~hip_hardware_counter_collection() {
+  if(_is_active)
+    _profiler->disarm();
+}
+
+result hip_hardware_counter_collection::finish(
+    ihipStream_t *stream, std::shared_ptr<simple_hardware_counters> &out) {
+  if(!_is_active)
+    return make_error(
+        __acpp_here(),
+        error_info{"hip_hardware_counters: Collection is not active"});
+  _is_active = false;
+
+  auto err = hipStreamSynchronize(stream);
+  if(err != hipSuccess) {
+    _profiler->disarm();
+    return make_error(__acpp_here(),
+                      error_info{"hip_hardware_counters: Could not wait for "
+                                 "profiled kernel",
+                                 error_code{"HIP", err}});
+  }
+  return _profiler->wait_for_counters(out);
+}
+
+}
+}
@@ -11,9 +11,14 @@
 #include "hipSYCL/runtime/hip/hip_hardware_manager.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
 #include "hipSYCL/runtime/hip/hip_event_pool.hpp"
+#include "hipSYCL/runtime/staging_buffer_pool.hpp"
 #include "hipSYCL/runtime/hip/hip_allocator.hpp"
+#include "hipSYCL/runtime/hip/hip_device_manager.hpp"
 #include "hipSYCL/runtime/hip/hip_target.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#ifdef HIPSYCL_WITH_ROCPROFILER_SDK
+#include "hipSYCL/runtime/hip/hip_hardware_counters.hpp"
+#endif
 #include <exception>
 #include <cstdlib>
 #include <limits>
@@ -23,7 +28,11 @@ namespace rt {
 
 hip_hardware_manager::hip_hardware_manager(hardware_platform hw_platform)
     : _hw_platform(hw_platform) {
-  
+
+#ifdef HIPSYCL_WITH_ROCPROFILER_SDK
+  // rocprofiler-sdk tools must be registered before HIP is initialized
+  hip_hardware_counter_collection::register_tool();
+#endif
   if (has_device_visibility_mask(
           application::get_settings().get<setting::visibility_mask>(),
           backend_id::hip)) {
@@ -52,6 +61,18 @@ hip_hardware_manager::hip_hardware_manager(hardware_platform hw_platform)
     _devices.emplace_back(dev);
   }
 
+  if (application::get_settings().get<setting::peer_access>()) {
+    for (int dev = 0; dev < num_devices; ++dev) {
+      for (int peer = 0; peer < num_devices; ++peer) {
+        if (dev != peer && _devices[dev].enable_peer_access(peer)) {
+          HIPSYCL_DEBUG_INFO << "hip_hardware_manager: Enabled peer access "
+                                "from device "
+                             << dev << " to device " << peer << std::endl;
+        }
+      }
+    }
+  }
+
 }
 
 
@@ -97,6 +118,34 @@ hip_hardware_context::hip_hardware_context(int dev) : _dev{dev} {
   _allocator = std::make_unique<hip_allocator>(
       backend_descriptor{hardware_platform::rocm, api_platform::hip}, _dev);
   _event_pool = std::make_unique<hip_event_pool>(_dev);
+  _staging_pool = std::make_unique<staging_buffer_pool>(
+      _allocator.get(),
+      application::get_settings().get<setting::staging_buffer_size>() * 1024 *
+          1024,
+      application::get_settings().get<setting::staging_pool_size>());
+}
+
+bool hip_hardware_context::enable_peer_access(int peer_dev) {
+  hip_device_manager::get().activate_device(_dev);
+
+  int can_access = 0;
+  auto err = hipDeviceCanAccessPeer(&can_access, _dev, peer_dev);
+  if (err != hipSuccess || !can_access)
+    return false;
+
+  err = hipDeviceEnablePeerAccess(peer_dev, 0);
+  if (err == hipErrorPeerAccessAlreadyEnabled) {
+    // Clear error state
+    hipGetLastError();
+  } else if (err != hipSuccess) {
+    print_warning(
+        __acpp_here(),
+        error_info{"hip_hardware_manager: Could not enable peer access",
+                   error_code{"HIP", err}});
+    return false;
+  }
+  _peer_devices.push_back(static_cast<std::size_t>(peer_dev));
+  return true;
 }
 
 hip_allocator* hip_hardware_context::get_allocator() const {
@@ -107,6 +156,10 @@ hip_event_pool* hip_hardware_context::get_event_pool() const {
   return _event_pool.get();
 }
 
+staging_buffer_pool* hip_hardware_context::get_staging_buffer_pool() const {
+  return _staging_pool.get();
+}
+
 bool hip_hardware_context::is_cpu() const {
   return !is_gpu();
 }
@@ -154,7 +207,7 @@ bool hip_hardware_context::has(device_support_aspect aspect) const {
     return false;
     break;
   case device_support_aspect::host_unified_memory:
-    return false;
+    return _properties->integrated != 0;
     break;
   case device_support_aspect::error_correction:
     return false; // TODO
@@ -348,6 +401,11 @@ hip_hardware_context::get_property(device_uint_property prop) const {
   case device_uint_property::global_mem_size:
     return _properties->totalGlobalMem;
     break;
+  case device_uint_property::peak_memory_bandwidth:
+    // memoryClockRate is in kHz; the factor 2 accounts for double data rate
+    return static_cast<std::size_t>(_properties->memoryClockRate) * 1000 * 2 *
+           (_properties->memoryBusWidth / 8);
+    break;
   case device_uint_property::max_constant_buffer_size:
     return _properties->totalConstMem;
     break;
@@ -378,6 +436,9 @@ hip_hardware_context::get_property(device_uint_list_property prop) const {
     return std::vector<std::size_t>{
         static_cast<std::size_t>(_properties->warpSize)};
     break;
+  case device_uint_list_property::peer_access_devices:
+    return _peer_devices;
+    break;
   }
   assert(false && "Invalid device property");
   std::terminate();
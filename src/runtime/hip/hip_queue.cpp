@@ -16,10 +16,18 @@
 #include "hipSYCL/runtime/hip/hip_queue.hpp"
 #include "hipSYCL/runtime/hip/hip_backend.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/generic/object_pool.hpp"
+#include "hipSYCL/runtime/generic/spin_wait.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/group_size_autotuner.hpp"
+#include "hipSYCL/runtime/group_size_cache.hpp"
 #include "hipSYCL/runtime/hip/hip_event.hpp"
 #include "hipSYCL/runtime/hip/hip_device_manager.hpp"
 #include "hipSYCL/runtime/hip/hip_target.hpp"
 #include "hipSYCL/runtime/hip/hip_code_object.hpp"
+#ifdef HIPSYCL_WITH_ROCPROFILER_SDK
+#include "hipSYCL/runtime/hip/hip_hardware_counters.hpp"
+#endif
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
@@ -31,7 +39,9 @@
 
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <memory>
 
 namespace hipsycl {
@@ -39,6 +49,175 @@ namespace rt {
 
 namespace {
 
+bool is_pageable_host_memory(backend_allocator *alloc, const void *ptr) {
+  pointer_info info;
+  // Host pointers that are unknown to HIP are pageable
+  bool is_pageable = !alloc->query_pointer(ptr, info).is_success();
+  // Clear error state in case the query failed
+  if(is_pageable)
+    hipGetLastError();
+  return is_pageable;
+}
+
+// HIP does not report spills separately, they are part of the private
+// segment size.
+common::db::kernel_resource_usage_entry
+query_kernel_resource_usage(const hip_sscp_executable_object *obj,
+                            std::string_view kernel_name, int device,
+                            std::size_t group_size,
+                            std::size_t local_mem_size) {
+  common::db::kernel_resource_usage_entry usage;
+  usage.kernel_name = std::string{kernel_name};
+
+  hipFunction_t f;
+  if(!obj->get_kernel(kernel_name, f).is_success())
+    return usage;
+
+  auto get_attribute = [&](hipFunction_attribute attr) -> uint64_t {
+    int value = 0;
+    if(hipFuncGetAttribute(&value, attr, f) != hipSuccess || value < 0) {
+      hipGetLastError();
+      return 0;
+    }
+    return static_cast<uint64_t>(value);
+  };
+  usage.num_registers = get_attribute(HIP_FUNC_ATTRIBUTE_NUM_REGS);
+  usage.private_mem_bytes = get_attribute(HIP_FUNC_ATTRIBUTE_LOCAL_SIZE_BYTES);
+  usage.local_mem_bytes = get_attribute(HIP_FUNC_ATTRIBUTE_SHARED_SIZE_BYTES);
+  usage.max_group_size = get_attribute(HIP_FUNC_ATTRIBUTE_MAX_THREADS_PER_BLOCK);
+
+  int num_blocks = 0;
+  int max_threads_per_cu = 0;
+  if(group_size > 0 &&
+     hipModuleOccupancyMaxActiveBlocksPerMultiprocessor(
+         &num_blocks, f, static_cast<int>(group_size), local_mem_size) ==
+         hipSuccess &&
+     hipDeviceGetAttribute(&max_threads_per_cu,
+                           hipDeviceAttributeMaxThreadsPerMultiProcessor,
+                           device) == hipSuccess &&
+     max_threads_per_cu > 0) {
+    usage.occupancy = static_cast<uint64_t>(num_blocks) * group_size * 100 /
+                      static_cast<uint64_t>(max_threads_per_cu);
+    usage.occupancy_group_size = group_size;
+  } else {
+    hipGetLastError();
+  }
+  return usage;
+}
+
+// Copies between pageable host memory and the device by bouncing through
+// two pinned staging buffers in alternation, such that the host-side copy of
+// one chunk overlaps with the DMA transfer of the other. Like the driver's
+// pageable copy path, this only returns once the host side of the transfer
+// has completed. If no staging buffers are available, nothing is submitted
+// and is_staged is set to false.
+result submit_staged_memcpy(hipStream_t stream, hip_event_pool *evt_pool,
+                            staging_buffer_pool *pool, void *dest,
+                            const void *src, std::size_t bytes,
+                            hipMemcpyKind kind, bool &is_staged) {
+  is_staged = false;
+
+  void* staging[2] = {pool->obtain_buffer(), pool->obtain_buffer()};
+  hipEvent_t events[2] = {nullptr, nullptr};
+
+  auto release_resources = [&]() {
+    for(int i = 0; i < 2; ++i) {
+      if(events[i])
+        evt_pool->release_event(events[i]);
+      pool->release_buffer(staging[i]);
+    }
+  };
+
+  if(!staging[0] || !staging[1]) {
+    release_resources();
+    return make_success();
+  }
+  for(int i = 0; i < 2; ++i) {
+    auto evt_result = evt_pool->obtain_event(events[i]);
+    if(!evt_result.is_success()) {
+      events[i] = nullptr;
+      release_resources();
+      return evt_result;
+    }
+  }
+  is_staged = true;
+
+  const std::size_t chunk_size = pool->get_buffer_size();
+  const std::size_t num_chunks = (bytes + chunk_size - 1) / chunk_size;
+  auto get_chunk_size = [&](std::size_t chunk) {
+    return std::min(chunk_size, bytes - chunk * chunk_size);
+  };
+  char* dest_bytes = static_cast<char*>(dest);
+  const char* src_bytes = static_cast<const char*>(src);
+
+  hipError_t err = hipSuccess;
+  if(kind == hipMemcpyHostToDevice) {
+    // The host data might be produced by preceding operations in the stream
+    err = hipStreamSynchronize(stream);
+    for(std::size_t i = 0; i < num_chunks && err == hipSuccess; ++i) {
+      int buff = i % 2;
+      // Wait until the previous transfer from this staging buffer has completed
+      if(i >= 2)
+        err = hipEventSynchronize(events[buff]);
+      if(err != hipSuccess)
+        break;
+      std::memcpy(staging[buff], src_bytes + i * chunk_size, get_chunk_size(i));
+      err = hipMemcpyAsync(dest_bytes + i * chunk_size, staging[buff],
+                            get_chunk_size(i), kind, stream);
+      if(err == hipSuccess)
+        err = hipEventRecord(events[buff], stream);
+    }
+  } else {
+    auto submit_chunk = [&](std::size_t chunk) {
+      int buff = chunk % 2;
+      err = hipMemcpyAsync(staging[buff], src_bytes + chunk * chunk_size,
+                            get_chunk_size(chunk), kind, stream);
+      if(err == hipSuccess)
+        err = hipEventRecord(events[buff], stream);
+    };
+    for(std::size_t i = 0; i < std::min(num_chunks, std::size_t{2}) &&
+                           err == hipSuccess; ++i)
+      submit_chunk(i);
+    for(std::size_t i = 0; i < num_chunks && err == hipSuccess; ++i) {
+      int buff = i % 2;
+      err = hipEventSynchronize(events[buff]);
+      if(err != hipSuccess)
+        break;
+      std::memcpy(dest_bytes + i * chunk_size, staging[buff], get_chunk_size(i));
+      if(i + 2 < num_chunks)
+        submit_chunk(i + 2);
+    }
+  }
+
+  // Staging buffers can only be reused once the device has stopped
+  // accessing them.
+  for(int i = 0; i < 2; ++i) {
+    hipError_t sync_err = hipEventSynchronize(events[i]);
+    if(err == hipSuccess)
+      err = sync_err;
+  }
+  release_resources();
+
+  if(err != hipSuccess) {
+    return make_error(__acpp_here(),
+                      error_info{"hip_queue: Staged memcpy failed",
+                                  error_code{"HIP", err}});
+  }
+  return make_success();
+}
+
+// Operations that record instrumentation events cannot be captured,
+// since the events need to be recorded individually.
+bool may_capture_graph(const dag_node_ptr& node) {
+  if(!node)
+    return false;
+  const auto& node_hints = node->get_execution_hints();
+  return node_hints.has_hint<hints::graph_capture>() &&
+         !node_hints.has_hint<hints::request_instrumentation_start_timestamp>() &&
+         !node_hints.has_hint<hints::request_instrumentation_finish_timestamp>() &&
+         !node_hints.has_hint<hints::request_instrumentation_hardware_counters>();
+}
+
 void host_synchronization_callback(hipStream_t stream, hipError_t status,
                                    void *userData) {
   
@@ -118,32 +297,128 @@ private:
   std::shared_ptr<dag_node_event> _task_start;
 };
 
-result launch_kernel_from_module(ihipModule_t *module,
-                                 std::string_view kernel_name,
+#ifdef HIPSYCL_WITH_ROCPROFILER_SDK
+// Collects hardware counters of the kernel launched during the lifetime
+// of the guard, if requested.
+class hip_hardware_counter_guard {
+public:
+  hip_hardware_counter_guard(hip_queue *q, operation &op, dag_node *node)
+      : _queue{q}, _operation{&op} {
+    if (node && node->get_execution_hints()
+                    .has_hint<hints::request_instrumentation_hardware_counters>())
+      _collection = std::make_unique<hip_hardware_counter_collection>(
+          q->get_device().get_id());
+  }
+
+  ~hip_hardware_counter_guard() {
+    if(!_collection)
+      return;
+
+    std::shared_ptr<simple_hardware_counters> counters;
+    auto res = _collection->finish(_queue->get_stream(), counters);
+    if(res.is_success()) {
+      _operation->get_instrumentations()
+          .add_instrumentation<instrumentations::hardware_counters>(counters);
+    } else {
+      HIPSYCL_DEBUG_WARNING << "hip_queue: Could not collect hardware "
+                               "counters: "
+                            << res.what() << std::endl;
+    }
+  }
+
+private:
+  hip_queue *_queue;
+  operation *_operation;
+  std::unique_ptr<hip_hardware_counter_collection> _collection;
+};
+#endif
+
+// Determines the number of work groups of a cooperative launch. Fails if
+// more work groups are requested than can be resident on the device
+// simultaneously, unless the cooperative launch permits reducing the number
+// of work groups.
+result get_cooperative_grid_size(hipFunction_t f,
+                                 const hints::cooperative_launch &cooperative,
                                  const rt::range<3> &grid_size,
                                  const rt::range<3> &block_size,
                                  unsigned dynamic_shared_mem,
-                                 hipStream_t stream, void **kernel_args,
-                                 std::size_t *arg_sizes, std::size_t num_args) {
-
-  hipFunction_t kernel_func;
-  hipError_t err =
-      hipModuleGetFunction(&kernel_func, module, kernel_name.data());
-
+                                 rt::range<3> &cooperative_grid_size) {
+  int num_groups_per_cu = 0;
+  hipError_t err = hipModuleOccupancyMaxActiveBlocksPerMultiprocessor(
+      &num_groups_per_cu, f, static_cast<int>(block_size.size()),
+      dynamic_shared_mem);
   if(err != hipSuccess) {
     return make_error(__acpp_here(),
-                      error_info{"hip_queue: could not extract kernel from module",
+                      error_info{"hip_queue: could not query kernel occupancy",
                                  error_code{"HIP", static_cast<int>(err)}});
   }
 
-  err = hipModuleLaunchKernel(kernel_func, 
-    static_cast<unsigned>(grid_size.get(0)),
-                       static_cast<unsigned>(grid_size.get(1)),
-                       static_cast<unsigned>(grid_size.get(2)),
-                       static_cast<unsigned>(block_size.get(0)),
-                       static_cast<unsigned>(block_size.get(1)),
-                       static_cast<unsigned>(block_size.get(2)),
-                       dynamic_shared_mem, stream, kernel_args, nullptr);
+  int dev = 0;
+  int num_cus = 0;
+  err = hipGetDevice(&dev);
+  if(err == hipSuccess)
+    err = hipDeviceGetAttribute(&num_cus,
+                                hipDeviceAttributeMultiprocessorCount, dev);
+  if(err != hipSuccess) {
+    return make_error(
+        __acpp_here(),
+        error_info{"hip_queue: could not query compute unit count",
+                   error_code{"HIP", static_cast<int>(err)}});
+  }
+
+  const std::size_t max_num_groups =
+      static_cast<std::size_t>(num_groups_per_cu) * num_cus;
+  cooperative_grid_size = grid_size;
+  if(grid_size.size() <= max_num_groups)
+    return make_success();
+
+  const std::size_t num_groups_yz = grid_size.get(1) * grid_size.get(2);
+  if(!cooperative.limits_num_groups() || num_groups_yz > max_num_groups) {
+    return make_error(
+        __acpp_here(),
+        error_info{"hip_queue: cooperative launch of " +
+                   std::to_string(grid_size.size()) +
+                   " work groups exceeds the maximum number of " +
+                   std::to_string(max_num_groups) +
+                   " simultaneously resident work groups"});
+  }
+  cooperative_grid_size[0] = max_num_groups / num_groups_yz;
+  return make_success();
+}
+
+result launch_kernel(hipFunction_t kernel_func, const rt::range<3> &grid_size,
+                     const rt::range<3> &block_size,
+                     unsigned dynamic_shared_mem, hipStream_t stream,
+                     void **kernel_args,
+                     const hints::cooperative_launch *cooperative) {
+  hipError_t err;
+  if(cooperative) {
+    rt::range<3> cooperative_grid_size;
+    auto grid_err = get_cooperative_grid_size(kernel_func, *cooperative,
+                                              grid_size, block_size,
+                                              dynamic_shared_mem,
+                                              cooperative_grid_size);
+    if(!grid_err.is_success())
+      return grid_err;
+
+    err = hipModuleLaunchCooperativeKernel(
+        kernel_func, static_cast<unsigned>(cooperative_grid_size.get(0)),
+        static_cast<unsigned>(cooperative_grid_size.get(1)),
+        static_cast<unsigned>(cooperative_grid_size.get(2)),
+        static_cast<unsigned>(block_size.get(0)),
+        static_cast<unsigned>(block_size.get(1)),
+        static_cast<unsigned>(block_size.get(2)), dynamic_shared_mem, stream,
+        kernel_args, 0);
+  } else {
+    err = hipModuleLaunchKernel(kernel_func, 
+      static_cast<unsigned>(grid_size.get(0)),
+                         static_cast<unsigned>(grid_size.get(1)),
+                         static_cast<unsigned>(grid_size.get(2)),
+                         static_cast<unsigned>(block_size.get(0)),
+                         static_cast<unsigned>(block_size.get(1)),
+                         static_cast<unsigned>(block_size.get(2)),
+                         dynamic_shared_mem, stream, kernel_args, nullptr);
+  }
 
   if (err != hipSuccess) {
     return make_error(__acpp_here(),
@@ -154,6 +429,25 @@ result launch_kernel_from_module(ihipModule_t *module,
 
   return make_success();
 }
+
+result launch_kernel_from_module(const hip_executable_object *obj,
+                                 std::string_view kernel_name,
+                                 const rt::range<3> &grid_size,
+                                 const rt::range<3> &block_size,
+                                 unsigned dynamic_shared_mem,
+                                 hipStream_t stream, void **kernel_args,
+                                 std::size_t *arg_sizes, std::size_t num_args,
+                                 const hints::cooperative_launch *cooperative) {
+
+  hipFunction_t kernel_func;
+  result err = obj->get_kernel(kernel_name, kernel_func);
+
+  if(!err.is_success())
+    return err;
+
+  return launch_kernel(kernel_func, grid_size, block_size, dynamic_shared_mem,
+                       stream, kernel_args, cooperative);
+}
 }
 
 
@@ -164,7 +458,8 @@ void hip_queue::activate_device() const {
 hip_queue::hip_queue(hip_backend *be, device_id dev, int priority)
     : _dev{dev}, _stream{nullptr}, _backend{be},
       _multipass_code_object_invoker{this}, _sscp_code_object_invoker{this},
-      _kernel_cache{kernel_cache::get()} {
+      _kernel_cache{kernel_cache::get()}, _is_capturing_graph{false},
+      _graph_capture_id{0} {
   this->activate_device();
 
   hipError_t err;
@@ -187,6 +482,17 @@ hip_queue::hip_queue(hip_backend *be, device_id dev, int priority)
 hipStream_t hip_queue::get_stream() const { return _stream; }
 
 hip_queue::~hip_queue() {
+  {
+    std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+    auto capture_err = end_graph_capture();
+    if(!capture_err.is_success())
+      register_error(capture_err);
+  }
+  for(auto& graph_exec : _graph_execs) {
+    if(graph_exec.second)
+      hipGraphExecDestroy(static_cast<hipGraphExec_t>(graph_exec.second));
+  }
+
   auto err = hipStreamDestroy(_stream);
   if (err != hipSuccess) {
     register_error(__acpp_here(),
@@ -197,6 +503,13 @@ hip_queue::~hip_queue() {
 
 /// Inserts an event into the stream
 std::shared_ptr<dag_node_event> hip_queue::insert_event() {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success()) {
+    register_error(capture_err);
+    return nullptr;
+  }
+
   hipEvent_t evt;
   auto event_creation_result =
       _backend->get_event_pool(_dev)->obtain_event(evt);
@@ -213,8 +526,10 @@ std::shared_ptr<dag_node_event> hip_queue::insert_event() {
     return nullptr;
   }
 
-  return std::make_shared<hip_node_event>(_dev, std::move(evt),
-                                          _backend->get_event_pool(_dev));
+  // Events are created for most operations, so their storage is recycled
+  return std::allocate_shared<hip_node_event>(
+      object_pool_allocator<hip_node_event>{}, _dev, std::move(evt),
+      _backend->get_event_pool(_dev));
 }
 
 std::shared_ptr<dag_node_event> hip_queue::create_queue_completion_event() {
@@ -284,8 +599,35 @@ result hip_queue::submit_memcpy(memcpy_operation & op, const dag_node_ptr& node)
   
   assert(dimension >= 1 && dimension <= 3);
 
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  // Only device-to-device copies are captured, since copies from pageable
+  // host memory are not supported in graphs.
+  auto capture_err = update_graph_capture(
+      node, copy_kind == hipMemcpyDeviceToDevice);
+  if(!capture_err.is_success())
+    return capture_err;
+
   hip_instrumentation_guard instrumentation{this, op, node.get()};
 
+  if (dimension == 1 && (copy_kind == hipMemcpyHostToDevice ||
+                         copy_kind == hipMemcpyDeviceToHost)) {
+    staging_buffer_pool *pool = _backend->get_staging_buffer_pool(_dev);
+    void *host_ptr = copy_kind == hipMemcpyHostToDevice
+                         ? op.source().get_access_ptr()
+                         : op.dest().get_access_ptr();
+    if (pool->is_enabled() &&
+        op.get_num_transferred_bytes() >= pool->get_buffer_size() &&
+        is_pageable_host_memory(_backend->get_allocator(_dev), host_ptr)) {
+      bool is_staged = false;
+      auto staging_result = submit_staged_memcpy(
+          get_stream(), _backend->get_event_pool(_dev), pool,
+          op.dest().get_access_ptr(), op.source().get_access_ptr(),
+          op.get_num_transferred_bytes(), copy_kind, is_staged);
+      if (!staging_result.is_success() || is_staged)
+        return staging_result;
+    }
+  }
+
   hipError_t err = hipSuccess;
   if (dimension == 1) {
 
@@ -338,6 +680,17 @@ result hip_queue::submit_memcpy(memcpy_operation & op, const dag_node_ptr& node)
 result hip_queue::submit_kernel(kernel_operation &op, const dag_node_ptr& node) {
 
   this->activate_device();
+
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  _pending_group_size_key.reset();
+  _pending_autotuning_key.reset();
+  _cooperative_launch =
+      node ? node->get_execution_hints().get_hint<hints::cooperative_launch>()
+           : nullptr;
+  // Cooperative launches cannot be recorded into graphs
+  auto capture_err = update_graph_capture(node, !_cooperative_launch);
+  if(!capture_err.is_success())
+    return capture_err;
   
   rt::backend_kernel_launch_capabilities cap;
   
@@ -345,6 +698,9 @@ result hip_queue::submit_kernel(kernel_operation &op, const dag_node_ptr& node)
   cap.provide_sscp_invoker(&_sscp_code_object_invoker);
 
   hip_instrumentation_guard instrumentation{this, op, node.get()};
+#ifdef HIPSYCL_WITH_ROCPROFILER_SDK
+  hip_hardware_counter_guard counters{this, op, node.get()};
+#endif
   return op.get_launcher().invoke(backend_id::hip, this, cap, node.get());
 
   return make_success();
@@ -354,6 +710,11 @@ result hip_queue::submit_prefetch(prefetch_operation& op, const dag_node_ptr& no
   // Need to enable instrumentation even if we cannot enable actual
   // prefetches so that the user will be able to access instrumentation
   // properties of the event.
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = update_graph_capture(node, false);
+  if(!capture_err.is_success())
+    return capture_err;
+
   hip_instrumentation_guard instrumentation{this, op, node.get()};
 #ifdef HIPSYCL_RT_HIP_SUPPORTS_UNIFIED_MEMORY
   
@@ -384,6 +745,11 @@ result hip_queue::submit_prefetch(prefetch_operation& op, const dag_node_ptr& no
 
 result hip_queue::submit_memset(memset_operation &op, const dag_node_ptr& node) {
 
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = update_graph_capture(node, true);
+  if(!capture_err.is_success())
+    return capture_err;
+
   hip_instrumentation_guard instrumentation{this, op, node.get()};
   hipError_t err = hipMemsetAsync(op.get_pointer(), op.get_pattern(),
                                   op.get_num_bytes(), get_stream());
@@ -398,8 +764,22 @@ result hip_queue::submit_memset(memset_operation &op, const dag_node_ptr& node)
 }
 
 result hip_queue::wait() {
+  {
+    std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+    auto capture_err = end_graph_capture();
+    if(!capture_err.is_success())
+      return capture_err;
+  }
+
+  static wait_duration_predictor predictor;
+  static const uint64_t max_spin_ns =
+      1000 * application::get_settings().get<setting::max_wait_spin_time>();
 
-  auto err = hipStreamSynchronize(_stream);
+  hipError_t err = hipSuccess;
+  hybrid_wait(
+      predictor, max_spin_ns,
+      [this]() { return hipStreamQuery(_stream) != hipErrorNotReady; },
+      [&]() { err = hipStreamSynchronize(_stream); });
 
   if(err != hipSuccess) {
     return make_error(__acpp_here(),
@@ -410,7 +790,35 @@ result hip_queue::wait() {
   return make_success();
 }
 
+result hip_queue::submit_completion_callback(void (*callback)(void *),
+                                             void *user_data) {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  // The callback would otherwise become part of the captured graph
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success())
+    return capture_err;
+
+  this->activate_device();
+  auto err = hipLaunchHostFunc(_stream, callback, user_data);
+  if (err != hipSuccess) {
+    return make_error(
+        __acpp_here(),
+        error_info{"hip_queue: Couldn't submit completion callback",
+                   error_code{"HIP", err}});
+  }
+  return make_success();
+}
+
 result hip_queue::query_status(inorder_queue_status &status) {
+  {
+    // Querying a capturing stream is not allowed. Captured operations
+    // have not been launched yet, so they cannot be complete.
+    std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+    if(_is_capturing_graph) {
+      status = inorder_queue_status{false};
+      return make_success();
+    }
+  }
   auto err = hipStreamQuery(_stream);
   if(err == hipSuccess) {
     status = inorder_queue_status{true};
@@ -428,6 +836,11 @@ result hip_queue::query_status(inorder_queue_status &status) {
 /// Causes the queue to wait until an event on another queue has occured.
 /// the other queue must be from the same backend
 result hip_queue::submit_queue_wait_for(const dag_node_ptr& node) {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success())
+    return capture_err;
+
   auto evt = node->get_event();
   assert(dynamic_is<inorder_queue_event<hipEvent_t>>(evt.get()));
 
@@ -444,6 +857,10 @@ result hip_queue::submit_queue_wait_for(const dag_node_ptr& node) {
 }
 
 result hip_queue::submit_external_wait_for(const dag_node_ptr& node) {
+  std::lock_guard<std::recursive_mutex> lock{_graph_capture_mutex};
+  auto capture_err = end_graph_capture();
+  if(!capture_err.is_success())
+    return capture_err;
 
   dag_node_ptr* user_data = new dag_node_ptr;
   assert(user_data);
@@ -462,6 +879,128 @@ result hip_queue::submit_external_wait_for(const dag_node_ptr& node) {
   return make_success();
 }
 
+result hip_queue::update_graph_capture(const dag_node_ptr &node,
+                                       bool is_capturable) {
+  bool capture_node = is_capturable && may_capture_graph(node);
+
+  if(_is_capturing_graph) {
+    if (capture_node &&
+        node->get_execution_hints().get_hint<hints::graph_capture>()->get_id() ==
+            _graph_capture_id)
+      return make_success();
+
+    auto err = end_graph_capture();
+    if(!err.is_success())
+      return err;
+  }
+
+  if(capture_node) {
+    // Relaxed mode, since other threads might need to carry out
+    // e.g. allocations while we are capturing.
+    auto err = hipStreamBeginCapture(_stream, hipStreamCaptureModeRelaxed);
+    if(err != hipSuccess) {
+      HIPSYCL_DEBUG_WARNING
+          << "hip_queue: Could not begin graph capture, submitting operations "
+             "directly: "
+          << hipGetErrorString(err) << std::endl;
+      return make_success();
+    }
+    _is_capturing_graph = true;
+    _graph_capture_id =
+        node->get_execution_hints().get_hint<hints::graph_capture>()->get_id();
+  }
+  return make_success();
+}
+
+result hip_queue::end_graph_capture() {
+  if(!_is_capturing_graph)
+    return make_success();
+  _is_capturing_graph = false;
+
+  hipGraph_t graph;
+  auto err = hipStreamEndCapture(_stream, &graph);
+  if(err != hipSuccess) {
+    return make_error(__acpp_here(),
+                      error_info{"hip_queue: Could not end graph capture",
+                                 error_code{"HIP", err}});
+  }
+
+  hipGraphExec_t graph_exec =
+      static_cast<hipGraphExec_t>(_graph_execs[_graph_capture_id]);
+  if(graph_exec) {
+    // Try to update the previously instantiated graph with the parameters
+    // of the new capture; this only succeeds if the topology is unchanged.
+    hipGraphNode_t error_node;
+    hipGraphExecUpdateResult update_result;
+    err = hipGraphExecUpdate(graph_exec, graph, &error_node, &update_result);
+    if(err != hipSuccess) {
+      HIPSYCL_DEBUG_INFO << "hip_queue: Captured graph for capture id "
+                         << _graph_capture_id
+                         << " has changed, instantiating new graph"
+                         << std::endl;
+      hipGraphExecDestroy(graph_exec);
+      graph_exec = nullptr;
+    }
+  }
+
+  if(!graph_exec) {
+    err = hipGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0);
+    if(err != hipSuccess) {
+      _graph_execs[_graph_capture_id] = nullptr;
+      hipGraphDestroy(graph);
+      return make_error(__acpp_here(),
+                        error_info{"hip_queue: Could not instantiate graph",
+                                   error_code{"HIP", err}});
+    }
+  }
+  _graph_execs[_graph_capture_id] = graph_exec;
+
+  err = hipGraphLaunch(graph_exec, _stream);
+  hipGraphDestroy(graph);
+  if(err != hipSuccess) {
+    return make_error(__acpp_here(),
+                      error_info{"hip_queue: Could not launch graph",
+                                 error_code{"HIP", err}});
+  }
+
+  return make_success();
+}
+
+rt::range<3> hip_queue::select_sscp_group_size(
+    const rt::range<3> &global_range, const rt::range<3> &default_group_size,
+    hcf_object_id hcf_object, std::string_view kernel_name) {
+  hip_hardware_context *ctx = static_cast<hip_hardware_context *>(
+      this->_backend->get_hardware_manager()->get_device(_dev.get_id()));
+
+  auto key = group_size_cache::get_key(
+      backend_id::hip, hcf_object, kernel_name, ctx->get_device_name(),
+      group_size_cache::get_dimension(global_range));
+
+  auto cached_group_size = group_size_cache::get().get(key);
+
+  // Timing events cannot be recorded while capturing graphs
+  if (group_size_autotuner::is_enabled() && !_is_capturing_graph &&
+      !(cached_group_size.has_value() && cached_group_size->is_autotuned)) {
+    auto candidate = group_size_autotuner::get().select_candidate(
+        key, global_range,
+        ctx->get_property(device_uint_property::max_group_size));
+    if(candidate.has_value()) {
+      _pending_autotuning_key = key;
+      return candidate.value();
+    }
+  }
+
+  if(cached_group_size.has_value()) {
+    // Prefer the default for small problem sizes, where the cached group size
+    // would leave work items without work.
+    if(global_range.size() >= cached_group_size->group_size.size())
+      return cached_group_size->group_size;
+    return default_group_size;
+  }
+  _pending_group_size_key = key;
+  return default_group_size;
+}
+
 device_id hip_queue::get_device() const { return _dev; }
 
 void *hip_queue::get_native_type() const {
@@ -558,9 +1097,9 @@ result hip_queue::submit_multipass_kernel_from_code_object(
   // the full kernel name, and don't need to query available kernels in the device image
   // as in the CUDA backend.
   return launch_kernel_from_module(
-      static_cast<const hip_executable_object *>(obj)->get_module(),
+      static_cast<const hip_executable_object *>(obj),
       backend_kernel_name, grid_size, block_size, dynamic_shared_mem, _stream,
-      kernel_args, arg_sizes, num_args);
+      kernel_args, arg_sizes, num_args, _cooperative_launch);
 }
 
 result hip_queue::submit_sscp_kernel_from_code_object(
@@ -598,8 +1137,27 @@ result hip_queue::submit_sscp_kernel_from_code_object(
 
   kernel_adaptivity_engine adaptivity_engine{
       hcf_object, kernel_name, kernel_info, _arg_mapper, num_groups,
-      group_size, args,        arg_sizes,   num_args, local_mem_size};
-  
+      group_size, args,        arg_sizes,   num_args, local_mem_size,
+      _backend->get_allocator(_dev)};
+
+  std::optional<kernel_configuration::id_type> launch_cache_id;
+  // Launches that still determine their group size can not be cached
+  if(!_pending_group_size_key.has_value() && !_pending_autotuning_key.has_value())
+    launch_cache_id = adaptivity_engine.get_launch_cache_id(initial_config);
+  if(launch_cache_id.has_value()) {
+    if(const auto* cached_launch = _sscp_launch_cache.find(launch_cache_id.value())) {
+      const code_object* obj = cached_launch->obj;
+      if(obj->get_jit_output_metadata().kernel_retained_arguments_indices.has_value()) {
+        _arg_mapper.apply_dead_argument_elimination_mask(
+            obj->get_jit_output_metadata()
+                .kernel_retained_arguments_indices.value());
+      }
+      return launch_kernel(cached_launch->kernel, num_groups, group_size,
+                           local_mem_size, _stream,
+                           _arg_mapper.get_mapped_args(), _cooperative_launch);
+    }
+  }
+
   _config = initial_config;
   _config.append_base_configuration(
       kernel_base_config_parameter::backend_id, backend_id::hip);
@@ -607,7 +1165,8 @@ result hip_queue::submit_sscp_kernel_from_code_object(
       kernel_base_config_parameter::compilation_flow,
       compilation_flow::sscp);
   _config.append_base_configuration(
-      kernel_base_config_parameter::hcf_object_id, hcf_object);
+      kernel_base_config_parameter::hcf_object_id,
+      adaptivity_engine.get_code_identity());
 
   for(const auto& flag : kernel_info->get_compilation_flags())
     _config.set_build_flag(flag);
@@ -617,45 +1176,62 @@ result hip_queue::submit_sscp_kernel_from_code_object(
   _config.set_build_option(kernel_build_option::amdgpu_target_device,
                           target_arch_name);
 
-  auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_device, device);
+  kernel_configuration::id_type binary_configuration_id;
+  kernel_configuration::id_type code_object_configuration_id;
+  auto select_configuration_id = [&](kernel_configuration::id_type binary_id) {
+    binary_configuration_id = binary_id;
+    code_object_configuration_id = binary_id;
+    kernel_configuration::extend_hash(
+        code_object_configuration_id,
+        kernel_base_config_parameter::runtime_device, device);
+  };
+  select_configuration_id(
+      adaptivity_engine.finalize_binary_configuration(_config));
 
   auto get_image_and_kernel_names =
       [&](std::vector<std::string> &contained_kernels) -> std::string {
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
-    
+  // Returns a self-contained JIT compiler for the currently selected
+  // configuration, which can also be executed on a background thread.
+  auto make_jit_compiler = [&]() {
     std::vector<std::string> kernel_names;
     std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
-    // Construct amdgpu translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      compiler::createLLVMToAmdgpuTranslator(kernel_names);
+    return [=, config = _config](std::string &compiled_image) -> bool {
+      // Construct amdgpu translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
+        compiler::createLLVMToAmdgpuTranslator(kernel_names);
+
+      // Lower kernels
+      rt::result err;
+      if(kernel_names.size() == 1) {
+        err = glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_configuration_id, compiled_image);
+      } else {
+        err = glue::jit::compile(translator.get(),
+          hcf_object, selected_image_name, config, compiled_image);
+      }
 
-    // Lower kernels
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, compiled_image);
-    } else {
-      err = glue::jit::compile(translator.get(),
-        hcf_object, selected_image_name, _config, compiled_image);
-    }
-    
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+      if(!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      glue::jit::precompilation::record_recipe(
+          binary_configuration_id, backend_id::hip, hcf_object,
+          selected_image_name, kernel_names, config,
+          kernel_names.size() == 1);
+      return true;
+    };
+  };
+
+  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+    return make_jit_compiler()(compiled_image);
   };
 
-  auto code_object_constructor = [&](const std::string& amdgpu_image) -> code_object * {
+  auto code_object_constructor = [&](std::string_view amdgpu_image) -> code_object * {
    
     std::vector<std::string> kernel_names;
     get_image_and_kernel_names(kernel_names);
@@ -680,12 +1256,32 @@ result hip_queue::submit_sscp_kernel_from_code_object(
           glue::jit::dead_argument_elimination::
               retrieve_retained_arguments_mask(binary_configuration_id);
 
+    auto usage = query_kernel_resource_usage(
+        exec_obj, kernel_name, device, group_size.size(), local_mem_size);
+    _kernel_cache->record_kernel_resource_usage(binary_configuration_id, usage);
+    exec_obj->get_jit_output_metadata().kernel_resource_usage.push_back(usage);
+
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id,
-      jit_compiler, code_object_constructor);
+  const code_object *obj = nullptr;
+  if(adaptivity_engine.has_fallback_configuration()) {
+    obj = _kernel_cache->get_or_schedule_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if(!obj) {
+      // The specialized binary is still being compiled; use the less
+      // specialized configuration in the meantime.
+      _config = adaptivity_engine.get_fallback_configuration();
+      select_configuration_id(
+          adaptivity_engine.get_fallback_configuration_id());
+    }
+  }
+
+  if(!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        jit_compiler, code_object_constructor);
 
   
   if(!obj) {
@@ -699,15 +1295,60 @@ result hip_queue::submit_sscp_kernel_from_code_object(
             .kernel_retained_arguments_indices.value());
   }
 
-  ihipModule_t *module =
-      static_cast<const hip_executable_object *>(obj)->get_module();
-  assert(module);
+  const auto *hip_obj = static_cast<const hip_executable_object *>(obj);
+  assert(hip_obj->get_module());
 
-  return launch_kernel_from_module(
-      module, kernel_name, num_groups, group_size, local_mem_size, _stream,
+  if(launch_cache_id.has_value()) {
+    hipFunction_t f;
+    if (hip_obj->get_kernel(kernel_name, f).is_success())
+      _sscp_launch_cache.insert(launch_cache_id.value(), obj, f);
+  }
+
+  if(_pending_group_size_key.has_value()) {
+    hipFunction_t f;
+    int min_grid_size = 0;
+    int block_size = 0;
+    if (hip_obj->get_kernel(kernel_name, f).is_success() &&
+        hipModuleOccupancyMaxPotentialBlockSize(&min_grid_size, &block_size,
+                                                f, local_mem_size,
+                                                0) == hipSuccess &&
+        block_size > 0) {
+      group_size_cache::get().store(
+          _pending_group_size_key.value(),
+          group_size_cache::make_group_size(
+              block_size, group_size_cache::get_dimension(group_size)));
+    }
+    _pending_group_size_key.reset();
+  }
+
+  std::shared_ptr<dag_node_event> autotuning_start;
+  if(_pending_autotuning_key.has_value())
+    autotuning_start = insert_event();
+
+  auto launch_err = launch_kernel_from_module(
+      hip_obj, kernel_name, num_groups, group_size, local_mem_size, _stream,
       _arg_mapper.get_mapped_args(),
       const_cast<std::size_t *>(_arg_mapper.get_mapped_arg_sizes()),
-      _arg_mapper.get_mapped_num_args());
+      _arg_mapper.get_mapped_num_args(), _cooperative_launch);
+
+  if(_pending_autotuning_key.has_value()) {
+    if(launch_err.is_success()) {
+      auto autotuning_finish = insert_event();
+      group_size_autotuner::get().add_measurement(
+          _pending_autotuning_key.value(), group_size,
+          group_size_autotuner::measurement{
+              autotuning_finish,
+              std::make_shared<hip_execution_start_timestamp>(
+                  _reference_event, autotuning_start),
+              std::make_shared<hip_execution_finish_timestamp>(
+                  _reference_event, autotuning_start, autotuning_finish)});
+    } else {
+      group_size_autotuner::get().discard_candidate(
+          _pending_autotuning_key.value(), group_size);
+    }
+    _pending_autotuning_key.reset();
+  }
+  return launch_err;
 #else
   return make_error(
       __acpp_here(),
@@ -754,6 +1395,14 @@ result hip_sscp_code_object_invoker::submit_kernel(
       op, hcf_object, kernel_name, kernel_info, num_groups, group_size,
       local_mem_size, args, arg_sizes, num_args, config);
 }
+
+rt::range<3> hip_sscp_code_object_invoker::select_group_size(
+    const rt::range<3> &global_range, const rt::range<3> &group_size,
+    hcf_object_id hcf_object, std::string_view kernel_name) const {
+  auto default_group_size = sscp_code_object_invoker::select_group_size(
+      global_range, group_size, hcf_object, kernel_name);
+  return _queue->select_sscp_group_size(global_range, default_group_size,
+                                        hcf_object, kernel_name);
+}
 }
 }
-
@@ -0,0 +1,203 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/hw_model/device.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/stable_running_hash.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+constexpr std::size_t latency_calibration_size = 64;
+constexpr std::size_t bandwidth_calibration_size = 256 * 1024 * 1024;
+constexpr int num_calibration_runs = 5;
+
+double time_operation(runtime *rt, backend_executor *executor, device_id dev,
+                      std::unique_ptr<operation> op) {
+  execution_hints hints;
+  hints.set_hint(hints::bind_to_device{dev});
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  dag_node_ptr node = make_dag_node(hints, node_list_t{}, std::move(op), rt);
+  node->assign_to_device(dev);
+  node->assign_to_executor(executor);
+  executor->submit_directly(node, node->get_operation(), node_list_t{});
+  node->get_operation()->get_instrumentations().mark_set_complete();
+  node->wait();
+
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+template<class OperationFactory>
+double min_operation_time(runtime *rt, backend_executor *executor,
+                          device_id dev, OperationFactory f) {
+  double result = std::numeric_limits<double>::max();
+  for(int i = 0; i < num_calibration_runs; ++i)
+    result = std::min(result, time_operation(rt, executor, dev, f()));
+  return result;
+}
+
+}
+
+device_model::device_model(backend_manager* mgr)
+: _backends{mgr} {}
+
+std::optional<device_performance_properties>
+device_model::get_properties(device_id dev) const {
+  std::call_once(_load_flag, [this](){ load_calibration(); });
+
+  std::string key = get_device_calibration_key(_backends, dev);
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _calibrated_devices.find(key);
+  if(it != _calibrated_devices.end())
+    return it->second;
+  return {};
+}
+
+std::string device_model::get_calibration_file_path() {
+  return common::filesystem::join_path(
+      common::filesystem::persistent_storage::get().get_base_dir(),
+      "device_model.txt");
+}
+
+void device_model::load_calibration() const {
+  std::ifstream file{get_calibration_file_path()};
+  if(!file.is_open())
+    return;
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  std::string line;
+  while(std::getline(file, line)) {
+    std::stringstream sstr{line};
+    std::string key;
+    device_performance_properties props;
+    if(sstr >> key >> props.operation_latency >> props.memory_bandwidth) {
+      if(props.memory_bandwidth > 0.0 && props.operation_latency >= 0.0)
+        _calibrated_devices[key] = props;
+    }
+  }
+  HIPSYCL_DEBUG_INFO << "device_model: Loaded " << _calibrated_devices.size()
+                     << " calibrated devices from "
+                     << get_calibration_file_path() << std::endl;
+}
+
+void device_model::calibrate(runtime *rt) {
+  std::call_once(_load_flag, [this](){ load_calibration(); });
+
+  std::vector<device_id> devices;
+  _backends->for_each_backend([&](backend *b) {
+    backend_hardware_manager *hw_mgr = b->get_hardware_manager();
+    for(std::size_t i = 0; i < hw_mgr->get_num_devices(); ++i)
+      devices.push_back(hw_mgr->get_device_id(i));
+  });
+
+  for(device_id dev : devices) {
+    backend *b = _backends->get(dev.get_backend());
+    backend_allocator *allocator = b->get_allocator(dev);
+    backend_executor *executor = b->get_executor(dev);
+
+    void *src = allocator->allocate(64, bandwidth_calibration_size);
+    void *dest = allocator->allocate(64, bandwidth_calibration_size);
+    if(src && dest) {
+      memory_location source{dev, src, id<3>{},
+                             range<3>{1, 1, bandwidth_calibration_size}, 1};
+      memory_location target{dev, dest, id<3>{},
+                             range<3>{1, 1, bandwidth_calibration_size}, 1};
+
+      double latency = min_operation_time(rt, executor, dev, [&]() {
+        return std::make_unique<memset_operation>(dest, 0,
+                                                  latency_calibration_size);
+      });
+      double copy_time = min_operation_time(rt, executor, dev, [&]() {
+        return std::make_unique<memcpy_operation>(
+            source, target, range<3>{1, 1, bandwidth_calibration_size});
+      });
+
+      device_performance_properties props;
+      props.operation_latency = latency;
+      // Each copy both reads and writes the data
+      props.memory_bandwidth = 2.0 * bandwidth_calibration_size /
+                               std::max(copy_time - latency, 1.e-9);
+
+      HIPSYCL_DEBUG_INFO << "device_model: Device "
+                         << get_device_calibration_key(_backends, dev)
+                         << ": operation latency "
+                         << props.operation_latency * 1.e6
+                         << " us, memory bandwidth "
+                         << props.memory_bandwidth * 1.e-9 << " GB/s"
+                         << std::endl;
+
+      std::lock_guard<std::mutex> lock{_mutex};
+      _calibrated_devices[get_device_calibration_key(_backends, dev)] = props;
+    } else {
+      HIPSYCL_DEBUG_WARNING << "device_model: Could not allocate memory for "
+                               "calibration of device "
+                            << get_device_calibration_key(_backends, dev)
+                            << std::endl;
+    }
+
+    if(src)
+      allocator->free(src);
+    if(dest)
+      allocator->free(dest);
+  }
+}
+
+bool device_model::store_calibration() const {
+  std::stringstream sstr;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    sstr.precision(17);
+    for(const auto& dev : _calibrated_devices)
+      sstr << dev.first << " " << dev.second.operation_latency << " "
+           << dev.second.memory_bandwidth << "\n";
+  }
+  return common::filesystem::atomic_write(get_calibration_file_path(),
+                                          sstr.str());
+}
+
+std::string get_device_calibration_key(backend_manager *mgr, device_id dev) {
+  backend *b = mgr->get(dev.get_backend());
+  std::string device_name =
+      b->get_hardware_manager()->get_device(dev.get_id())->get_device_name();
+
+  common::stable_running_hash hash;
+  hash(device_name.data(), device_name.size());
+
+  std::stringstream sstr;
+  sstr << b->get_name() << "." << dev.get_id() << "." << std::hex
+       << hash.get_current_hash();
+  std::string result = sstr.str();
+  std::replace(result.begin(), result.end(), ' ', '_');
+  return result;
+}
+
+}
+}
@@ -9,27 +9,91 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/hw_model/memcpy.hpp"
+#include "hipSYCL/runtime/hw_model/device.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <limits>
+#include <sstream>
 
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+constexpr std::size_t latency_calibration_size = 64;
+constexpr std::size_t bandwidth_calibration_size = 32 * 1024 * 1024;
+constexpr int num_calibration_runs = 5;
+
+double time_transfer(runtime *rt, backend_executor *executor,
+                     device_id executing_device, device_id source_device,
+                     void *source_ptr, device_id dest_device, void *dest_ptr,
+                     std::size_t num_bytes) {
+
+  memory_location source{source_device, source_ptr, id<3>{},
+                         range<3>{1, 1, num_bytes}, 1};
+  memory_location dest{dest_device, dest_ptr, id<3>{},
+                       range<3>{1, 1, num_bytes}, 1};
+
+  execution_hints hints;
+  hints.set_hint(hints::bind_to_device{executing_device});
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  dag_node_ptr node = make_dag_node(
+      hints, node_list_t{},
+      std::make_unique<memcpy_operation>(source, dest,
+                                         range<3>{1, 1, num_bytes}),
+      rt);
+  node->assign_to_device(executing_device);
+  node->assign_to_executor(executor);
+  executor->submit_directly(node, node->get_operation(), node_list_t{});
+  node->get_operation()->get_instrumentations().mark_set_complete();
+  node->wait();
+
+  auto end = std::chrono::high_resolution_clock::now();
+  return std::chrono::duration<double>(end - start).count();
+}
+
+double min_transfer_time(runtime *rt, backend_executor *executor,
+                         device_id executing_device, device_id source_device,
+                         void *source_ptr, device_id dest_device,
+                         void *dest_ptr, std::size_t num_bytes) {
+  double result = std::numeric_limits<double>::max();
+  for(int i = 0; i < num_calibration_runs; ++i)
+    result =
+        std::min(result, time_transfer(rt, executor, executing_device,
+                                       source_device, source_ptr, dest_device,
+                                       dest_ptr, num_bytes));
+  return result;
+}
+
+}
+
+memcpy_model::memcpy_model(backend_manager* mgr)
+: _backends{mgr} {}
 
 cost_type
 memcpy_model::estimate_runtime_cost(const memory_location &source,
                                     const memory_location &dest,
                                     range<3> num_elements) const
 {
-  // Strongly prefer transfers from the same device to the same device
-  if(source.get_device() == dest.get_device())
-    return 1.0;
+  memcpy_link_properties link =
+      get_link_properties(source.get_device(), dest.get_device());
 
-  if (source.get_device().get_full_backend_descriptor().hw_platform ==
-      dest.get_device().get_full_backend_descriptor().hw_platform)
-    return 2.0;
-
-  return 3.0;
+  double num_bytes =
+      static_cast<double>(num_elements.size() * source.get_element_size());
+  return link.latency + num_bytes / link.bandwidth;
 }
 
 memory_location memcpy_model::choose_source(
@@ -50,5 +114,180 @@ memory_location memcpy_model::choose_source(
   return candidate_sources[best_transfer_index];
 }
 
+memcpy_link_properties memcpy_model::get_link_properties(device_id source,
+                                                         device_id dest) const {
+  if(auto link = get_calibrated_link_properties(source, dest))
+    return *link;
+  return get_default_link_properties(source, dest);
+}
+
+std::optional<memcpy_link_properties>
+memcpy_model::get_calibrated_link_properties(device_id source,
+                                             device_id dest) const {
+  std::call_once(_load_flag, [this](){ load_calibration(); });
+
+  if(source != dest) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto it = _calibrated_links.find(get_link_key(source, dest));
+    if(it != _calibrated_links.end())
+      return it->second;
+  }
+  return {};
+}
+
+memcpy_link_properties
+memcpy_model::get_default_link_properties(device_id source,
+                                          device_id dest) const {
+  memcpy_link_properties result;
+  if(source == dest) {
+    // Strongly prefer transfers from the same device to the same device
+    result.latency = 0.0;
+    result.bandwidth = 1.e12;
+  } else if(source.is_host() && dest.is_host()) {
+    result.latency = 1.e-6;
+    result.bandwidth = 10.e9;
+  } else if(source.is_host() || dest.is_host()) {
+    result.latency = 10.e-6;
+    result.bandwidth = 12.e9;
+  } else if(has_peer_access(source, dest)) {
+    result.latency = 10.e-6;
+    result.bandwidth = 25.e9;
+  } else {
+    // Without peer access, assume that the transfer is staged through the
+    // host.
+    result.latency = 20.e-6;
+    result.bandwidth = 6.e9;
+  }
+  return result;
+}
+
+bool memcpy_model::has_peer_access(device_id source, device_id dest) const {
+  if(source.get_backend() != dest.get_backend())
+    return false;
+
+  hardware_context *ctx = _backends->get(dest.get_backend())
+                              ->get_hardware_manager()
+                              ->get_device(dest.get_id());
+  std::vector<std::size_t> peers =
+      ctx->get_property(device_uint_list_property::peer_access_devices);
+  return std::find(peers.begin(), peers.end(),
+                   static_cast<std::size_t>(source.get_id())) != peers.end();
+}
+
+std::string memcpy_model::get_device_key(device_id dev) const {
+  return get_device_calibration_key(_backends, dev);
+}
+
+std::string memcpy_model::get_link_key(device_id source,
+                                       device_id dest) const {
+  return get_device_key(source) + " " + get_device_key(dest);
+}
+
+std::string memcpy_model::get_calibration_file_path() {
+  return common::filesystem::join_path(
+      common::filesystem::persistent_storage::get().get_base_dir(),
+      "memcpy_model.txt");
+}
+
+void memcpy_model::load_calibration() const {
+  std::ifstream file{get_calibration_file_path()};
+  if(!file.is_open())
+    return;
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  std::string line;
+  while(std::getline(file, line)) {
+    std::stringstream sstr{line};
+    std::string source_key, dest_key;
+    memcpy_link_properties link;
+    if(sstr >> source_key >> dest_key >> link.latency >> link.bandwidth) {
+      if(link.bandwidth > 0.0 && link.latency >= 0.0)
+        _calibrated_links[source_key + " " + dest_key] = link;
+    }
+  }
+  HIPSYCL_DEBUG_INFO << "memcpy_model: Loaded " << _calibrated_links.size()
+                     << " calibrated links from "
+                     << get_calibration_file_path() << std::endl;
+}
+
+void memcpy_model::calibrate(runtime *rt) {
+  std::call_once(_load_flag, [this](){ load_calibration(); });
+
+  std::vector<device_id> devices;
+  _backends->for_each_backend([&](backend *b) {
+    backend_hardware_manager *hw_mgr = b->get_hardware_manager();
+    for(std::size_t i = 0; i < hw_mgr->get_num_devices(); ++i)
+      devices.push_back(hw_mgr->get_device_id(i));
+  });
+
+  std::vector<void *> allocations;
+  for(device_id dev : devices)
+    allocations.push_back(_backends->get(dev.get_backend())
+                              ->get_allocator(dev)
+                              ->allocate(64, bandwidth_calibration_size));
+
+  for(std::size_t src = 0; src < devices.size(); ++src) {
+    for(std::size_t dst = 0; dst < devices.size(); ++dst) {
+      device_id source_device = devices[src];
+      device_id dest_device = devices[dst];
+      if(src == dst || !allocations[src] || !allocations[dst])
+        continue;
+      // We cannot copy directly between different device backends
+      if(!source_device.is_host() && !dest_device.is_host() &&
+         source_device.get_backend() != dest_device.get_backend())
+        continue;
+
+      // Transfers involving non-host devices have to be executed by the
+      // backend of the non-host device.
+      device_id executing_device =
+          source_device.is_host() ? dest_device : source_device;
+      backend_executor *executor =
+          _backends->get(executing_device.get_backend())
+              ->get_executor(executing_device);
+
+      double latency = min_transfer_time(
+          rt, executor, executing_device, source_device, allocations[src],
+          dest_device, allocations[dst], latency_calibration_size);
+      double bandwidth_time = min_transfer_time(
+          rt, executor, executing_device, source_device, allocations[src],
+          dest_device, allocations[dst], bandwidth_calibration_size);
+
+      memcpy_link_properties link;
+      link.latency = latency;
+      link.bandwidth = bandwidth_calibration_size /
+                       std::max(bandwidth_time - latency, 1.e-9);
+
+      HIPSYCL_DEBUG_INFO << "memcpy_model: Link " << get_device_key(source_device)
+                         << " -> " << get_device_key(dest_device)
+                         << ": latency " << link.latency * 1.e6
+                         << " us, bandwidth " << link.bandwidth * 1.e-9
+                         << " GB/s" << std::endl;
+
+      std::lock_guard<std::mutex> lock{_mutex};
+      _calibrated_links[get_link_key(source_device, dest_device)] = link;
+    }
+  }
+
+  for(std::size_t i = 0; i < devices.size(); ++i) {
+    if(allocations[i])
+      _backends->get(devices[i].get_backend())
+          ->get_allocator(devices[i])
+          ->free(allocations[i]);
+  }
+}
+
+bool memcpy_model::store_calibration() const {
+  std::stringstream sstr;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    sstr.precision(17);
+    for(const auto& link : _calibrated_links)
+      sstr << link.first << " " << link.second.latency << " "
+           << link.second.bandwidth << "\n";
+  }
+  return common::filesystem::atomic_write(get_calibration_file_path(),
+                                          sstr.str());
+}
+
 }
 }
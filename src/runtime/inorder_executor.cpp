@@ -11,9 +11,16 @@
 #include <cassert>
 
 #include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/dag_manager.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
+#include "hipSYCL/common/small_map.hpp"
 
 namespace hipsycl {
 namespace rt {
@@ -31,7 +38,8 @@ public:
 
   virtual result dispatch_kernel(kernel_operation *op,
                                  const dag_node_ptr& node) final override {
-
+    runtime_statistics::get().add_kernel_launch(
+        _queue->get_device().get_backend());
     return _queue->submit_kernel(*op, node);
   }
 
@@ -54,25 +62,59 @@ private:
   inorder_queue* _queue;
 };
 
-std::size_t get_maximum_execution_index_for_lane(const node_list_t &nodes,
-                                                 inorder_queue *lane) {
-  std::size_t index = 0;
+// Determines for each execution lane the highest execution index out of all
+// requirements that were submitted to it. Since execution lanes are in-order
+// queues, synchronizing with this requirement implies synchronization with
+// all other requirements from the same lane.
+common::small_map<const inorder_queue *, std::size_t>
+get_maximum_execution_indices(const node_list_t &nodes,
+                              backend_id backend) {
+  common::small_map<const inorder_queue *, std::size_t> indices;
   for (const auto &node : nodes) {
     if (node->is_submitted() &&
-        node->get_assigned_device().get_backend() ==
-            lane->get_device().get_backend() &&
-        node->get_assigned_execution_lane() == lane) {
+        node->get_assigned_device().get_backend() == backend) {
+      const inorder_queue *lane =
+          static_cast<inorder_queue *>(node->get_assigned_execution_lane());
+      std::size_t &index = indices[lane];
       if(node->get_assigned_execution_index() > index)
         index = node->get_assigned_execution_index();
     }
   }
-  return index;
+  return indices;
+}
+
+// Maximum number of kernels that are batched together. Batched kernels only
+// start executing once the batch is complete, so this should not be too large.
+constexpr std::size_t max_kernels_per_batch = 32;
+
+struct completion_callback_data {
+  dag_node_ptr node;
+  std::shared_ptr<node_completion_queue> completions;
+};
+
+// Invoked by the backend on a host thread once the node has completed
+void completion_callback(void *user_data) {
+  auto *data = static_cast<completion_callback_data *>(user_data);
+  data->node->mark_known_complete();
+  // Moving the node into the queue ensures that it is not destroyed
+  // in the callback, which must not invoke backend API functions.
+  data->completions->push(std::move(data->node));
+  delete data;
 }
 
 } // anonymous namespace
 
 inorder_executor::inorder_executor(std::unique_ptr<inorder_queue> q)
-: _q{std::move(q)}, _num_submitted_operations{0} {}
+    : _q{std::move(q)}, _num_submitted_operations{0},
+      _use_lazy_events{
+          application::get_settings().get<setting::lazy_events>()},
+      _kernel_batching_max_work_items{
+          application::get_settings()
+              .get<setting::kernel_batching_max_work_items>()},
+      _num_kernels_in_batch{0}, _kernel_batch_index{0},
+      _is_previous_node_batched{false},
+      _use_completion_callbacks{
+          application::get_settings().get<setting::completion_callbacks>()} {}
 
 inorder_executor::~inorder_executor(){}
 
@@ -90,6 +132,7 @@ bool inorder_executor::is_taskgraph() const {
 
 void inorder_executor::submit_directly(const dag_node_ptr& node, operation *op,
                                        const node_list_t &reqs) {
+  trace_span span{"operation_dispatcher"};
   
   HIPSYCL_DEBUG_INFO << "inorder_executor: Processing node " << node.get()
 	  << " with " << reqs.size() << " non-virtual requirement(s) and "
@@ -106,6 +149,13 @@ void inorder_executor::submit_directly(const dag_node_ptr& node, operation *op,
 
   // Submit synchronization mechanisms
   result res;
+  bool has_synchronized = false;
+  auto maximum_execution_indices =
+      get_maximum_execution_indices(reqs, _q->get_device().get_backend());
+  // Waits must be enqueued before they are recorded in
+  // _synchronized_lane_indices, such that concurrent submissions never
+  // rely on a wait that is not yet part of the queue.
+  std::unique_lock<std::mutex> lane_sync_lock{_lane_synchronization_mutex};
   for (auto req : reqs) {
     // The scheduler should not hand us virtual requirements
     assert(!req->is_virtual());
@@ -120,6 +170,7 @@ void inorder_executor::submit_directly(const dag_node_ptr& node, operation *op,
             << " --> Synchronizes with external node: " << req
             << std::endl;
         res = _q->submit_external_wait_for(req);
+        has_synchronized = true;
       } else {
         if (req->get_assigned_execution_lane() == _q.get()) {
           HIPSYCL_DEBUG_INFO
@@ -142,18 +193,30 @@ void inorder_executor::submit_directly(const dag_node_ptr& node, operation *op,
           // Find the maximum execution index out of all our requirements.
           // Since the execution index is incremented after each submission,
           // this allows us to identify the requirement that was submitted last.
-          inorder_queue *req_q = static_cast<inorder_queue *>(
+          const inorder_queue *req_q = static_cast<inorder_queue *>(
               req->get_assigned_execution_lane());
-          std::size_t maximum_execution_index =
-              get_maximum_execution_index_for_lane(reqs, req_q);
-          
-          if(req->get_assigned_execution_index() != maximum_execution_index) {
+          std::size_t execution_index = req->get_assigned_execution_index();
+
+          // Execution indices are monotonic per lane, so if this queue has
+          // already waited for an operation that was submitted to the
+          // lane at the same time or later, the wait is implied.
+          std::size_t &synchronized_index = _synchronized_lane_indices[req_q];
+
+          if(execution_index != maximum_execution_indices[req_q]) {
             HIPSYCL_DEBUG_INFO
                 << "  --> (Skipping unnecessary synchronization; another "
                    "requirement follows in the same inorder queue)"
                 << std::endl;
+          } else if(execution_index <= synchronized_index) {
+            HIPSYCL_DEBUG_INFO
+                << "  --> (Skipping unnecessary synchronization; queue has "
+                   "already synchronized with a later operation of the lane)"
+                << std::endl;
           } else {
             res = _q->submit_queue_wait_for(req);
+            has_synchronized = true;
+            if(res.is_success())
+              synchronized_index = execution_index;
           }
         }
       }
@@ -164,6 +227,10 @@ void inorder_executor::submit_directly(const dag_node_ptr& node, operation *op,
       }
     }
   }
+  lane_sync_lock.unlock();
+
+  if(_kernel_batching_max_work_items > 0)
+    assign_kernel_batch(node, op, has_synchronized);
 
   HIPSYCL_DEBUG_INFO
       << "inorder_executor: Dispatching to lane " << _q.get() << ": "
@@ -177,12 +244,75 @@ void inorder_executor::submit_directly(const dag_node_ptr& node, operation *op,
     return;
   }
 
-  if (node->get_execution_hints()
-          .has_hint<hints::coarse_grained_synchronization>()) {
+  // Nodes that might be captured into a graph cannot be given fine-grained
+  // events, since recording an event would end the capture.
+  const auto& node_hints = node->get_execution_hints();
+  if (_use_lazy_events ||
+      node_hints.has_hint<hints::coarse_grained_synchronization>() ||
+      node_hints.has_hint<hints::graph_capture>()) {
     node->mark_submitted(_q->create_queue_completion_event());
   } else {
     node->mark_submitted(_q->insert_event());
   }
+
+  // Callbacks would be captured into the graph as well
+  if (_use_completion_callbacks.load(std::memory_order_relaxed) &&
+      !node_hints.has_hint<hints::graph_capture>())
+    submit_completion_callback(node);
+}
+
+void inorder_executor::submit_completion_callback(const dag_node_ptr &node) {
+  auto *data = new completion_callback_data{
+      node, node->get_runtime()->dag().get_completion_queue()};
+
+  auto err = _q->submit_completion_callback(completion_callback, data);
+  if(!err.is_success()) {
+    delete data;
+    // Fall back to polling for all further nodes
+    _use_completion_callbacks.store(false, std::memory_order_relaxed);
+    if(err.info().get_error_type() != error_type::feature_not_supported)
+      register_error(err);
+  }
+}
+
+void inorder_executor::assign_kernel_batch(const dag_node_ptr &node,
+                                           operation *op,
+                                           bool requires_synchronization) {
+  std::lock_guard<std::mutex> lock{_kernel_batching_mutex};
+
+  auto& node_hints = node->get_execution_hints();
+  bool is_batchable = false;
+  // User-provided capture ids take precedence
+  if (!node_hints.has_hint<hints::graph_capture>() &&
+      dynamic_is<kernel_operation>(op)) {
+    const auto &launch_data = cast<kernel_operation>(op)
+                                  ->get_launcher()
+                                  .get_static_data();
+    // Only SSCP kernels provide their launch configuration at this point
+    if (launch_data.sscp_kernel_id && !launch_data.custom_op) {
+      is_batchable = launch_data.global_size.size() <=
+                     _kernel_batching_max_work_items;
+    }
+  }
+
+  if(!is_batchable) {
+    _is_previous_node_batched = false;
+    return;
+  }
+
+  if (!_is_previous_node_batched || requires_synchronization ||
+      _num_kernels_in_batch >= max_kernels_per_batch) {
+    ++_kernel_batch_index;
+    _num_kernels_in_batch = 0;
+  }
+  ++_num_kernels_in_batch;
+  _is_previous_node_batched = true;
+
+  // Alternating between two ids causes the queue to end the capture
+  // of the previous batch, while instantiated graphs can still be reused
+  // for repeating sequences of batches.
+  node_hints.set_hint(hints::graph_capture{
+      hints::graph_capture::first_reserved_id + _kernel_batch_index % 2});
 }
 
 inorder_queue* inorder_executor::get_queue() const {
@@ -199,8 +329,27 @@ bool inorder_executor::is_submitted_by_me(const dag_node_ptr& node) const {
   return node->get_assigned_executor() == this;
 }
 
+result inorder_executor::register_completion_callback(
+    const dag_node_ptr &node, void (*callback)(void *), void *user_data) {
+  // Callbacks would be captured into the graph as well
+  if(node->get_assigned_execution_lane() != _q.get() ||
+     node->get_execution_hints().has_hint<hints::graph_capture>())
+    return make_error(
+        __acpp_here(),
+        error_info{"inorder_executor: Cannot register completion callback "
+                   "for node",
+                   error_type::feature_not_supported});
+
+  return _q->submit_completion_callback(callback, user_data);
+}
+
 result inorder_executor::wait() {
-  return _q->wait();
+  auto& tracker = _q->get_completion_tracker();
+  uint64_t last_registered = tracker.get_last_registered();
+  auto err = _q->wait();
+  if(err.is_success())
+    tracker.mark_complete_up_to(last_registered);
+  return err;
 }
 
 }
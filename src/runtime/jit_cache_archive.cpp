@@ -0,0 +1,374 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/jit_cache_archive.hpp"
+#include "hipSYCL/runtime/jit_cache_compression.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// "ACPPJCA1", "ACPPREC1" and "ACPPREC2" in little endian
+constexpr uint64_t archive_magic = 0x3141434a50504341ull;
+constexpr uint64_t legacy_record_magic = 0x3143455250504341ull;
+constexpr uint64_t record_magic = 0x3243455250504341ull;
+// Version 2 adds records that share the binary of an earlier record.
+// Archives of version 1 are upgraded when they are opened, since older
+// readers would otherwise drop the new records as incomplete.
+constexpr uint64_t archive_version = 2;
+
+struct archive_header {
+  uint64_t magic;
+  uint64_t version;
+};
+
+// Records of version 1 archives
+struct legacy_record_header {
+  uint64_t magic;
+  uint64_t id[2];
+  uint64_t size;
+  uint64_t checksum;
+};
+
+struct record_header {
+  uint64_t magic;
+  uint64_t id[2];
+  uint64_t size;
+  uint64_t content_hash;
+  // If non-zero, the record has no binary of its own, but refers to the
+  // binary at this offset in the archive.
+  uint64_t shared_binary_offset;
+  uint64_t checksum;
+};
+
+uint64_t fnv1a(std::initializer_list<uint64_t> values) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for(uint64_t v : values) {
+    hash ^= v;
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+// Checksums over the header fields detect torn headers
+uint64_t header_checksum(const legacy_record_header& h) {
+  return fnv1a({h.magic, h.id[0], h.id[1], h.size});
+}
+
+uint64_t header_checksum(const record_header& h) {
+  return fnv1a({h.magic, h.id[0], h.id[1], h.size, h.content_hash,
+                h.shared_binary_offset});
+}
+
+// Binaries are followed by at least one null byte, and records are padded to
+// multiples of 8 bytes. The null byte only belongs to the record format:
+// Lookups return views of exactly the binary size.
+std::size_t get_record_size(std::size_t header_size, std::size_t binary_size) {
+  std::size_t size = header_size + binary_size + 1;
+  return (size + 7) & ~static_cast<std::size_t>(7);
+}
+
+#ifndef _WIN32
+class file_lock {
+public:
+  file_lock(int fd)
+  : _fd{fd} {
+    _is_locked = (flock(_fd, LOCK_EX) == 0);
+  }
+
+  ~file_lock() {
+    if(_is_locked)
+      flock(_fd, LOCK_UN);
+  }
+
+  bool is_locked() const {
+    return _is_locked;
+  }
+private:
+  int _fd;
+  bool _is_locked;
+};
+
+bool write_all(int fd, const char* data, std::size_t size) {
+  while(size > 0) {
+    ssize_t written = ::write(fd, data, size);
+    if(written < 0)
+      return false;
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+#endif
+
+}
+
+jit_cache_archive::jit_cache_archive(const std::string &filename)
+    : _filename{filename}, _fd{-1}, _indexed_size{0} {
+#ifndef _WIN32
+  _fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if(_fd < 0) {
+    HIPSYCL_DEBUG_WARNING << "jit_cache_archive: Could not open " << filename
+                          << std::endl;
+    return;
+  }
+
+  file_lock lock{_fd};
+  if(!lock.is_locked()) {
+    ::close(_fd);
+    _fd = -1;
+    return;
+  }
+
+  struct stat st;
+  if(fstat(_fd, &st) != 0) {
+    ::close(_fd);
+    _fd = -1;
+    return;
+  }
+
+  if(st.st_size == 0) {
+    archive_header header{archive_magic, archive_version};
+    if(!write_all(_fd, reinterpret_cast<const char *>(&header),
+                  sizeof(header))) {
+      ::close(_fd);
+      _fd = -1;
+      return;
+    }
+  } else {
+    archive_header header;
+    if (static_cast<std::size_t>(st.st_size) < sizeof(header) ||
+        ::pread(_fd, &header, sizeof(header), 0) != sizeof(header) ||
+        header.magic != archive_magic ||
+        (header.version != 1 && header.version != archive_version)) {
+      HIPSYCL_DEBUG_WARNING << "jit_cache_archive: " << filename
+                            << " is not a valid JIT cache archive, ignoring it"
+                            << std::endl;
+      ::close(_fd);
+      _fd = -1;
+      return;
+    }
+    if(header.version != archive_version) {
+      header.version = archive_version;
+      if(::pwrite(_fd, &header, sizeof(header), 0) != sizeof(header)) {
+        ::close(_fd);
+        _fd = -1;
+        return;
+      }
+    }
+  }
+  _indexed_size = sizeof(archive_header);
+
+  std::lock_guard<std::mutex> mutex_lock{_mutex};
+  refresh();
+#endif
+}
+
+jit_cache_archive::~jit_cache_archive() {
+#ifndef _WIN32
+  for(const auto& m : _mappings)
+    munmap(const_cast<char*>(m.data), m.size);
+  if(_fd >= 0)
+    ::close(_fd);
+#endif
+}
+
+bool jit_cache_archive::is_open() const {
+  return _fd >= 0;
+}
+
+bool jit_cache_archive::lookup(const id_type &id, std::string_view &out) {
+  if(!is_open())
+    return false;
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(lookup_impl(id, out))
+    return true;
+  // Another process might have added the binary in the meantime
+  refresh();
+  return lookup_impl(id, out);
+}
+
+bool jit_cache_archive::contains(const id_type& id) {
+  std::string_view data;
+  return lookup(id, data);
+}
+
+bool jit_cache_archive::store(const id_type &id, std::string_view data) {
+#ifndef _WIN32
+  if(!is_open())
+    return false;
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  file_lock archive_lock{_fd};
+  if(!archive_lock.is_locked())
+    return false;
+
+  refresh();
+  std::string_view existing;
+  if(lookup_impl(id, existing))
+    return true;
+
+  // Since we hold the file lock, an incomplete record at the end of the
+  // archive cannot be in the process of being written - drop it.
+  struct stat st;
+  if(fstat(_fd, &st) != 0)
+    return false;
+  if(static_cast<std::size_t>(st.st_size) != _indexed_size) {
+    if(ftruncate(_fd, _indexed_size) != 0)
+      return false;
+  }
+
+  record_header header;
+  header.magic = record_magic;
+  header.id[0] = id[0];
+  header.id[1] = id[1];
+  header.size = data.size();
+  header.content_hash = get_jit_cache_content_hash(data);
+  header.shared_binary_offset = 0;
+
+  // Specializations often result in identical binaries for different ids
+  auto shared = _content_index.find(header.content_hash);
+  if(shared != _content_index.end() && shared->second.size == data.size() &&
+     std::memcmp(_mappings.back().data + shared->second.offset, data.data(),
+                 data.size()) == 0)
+    header.shared_binary_offset = shared->second.offset;
+  header.checksum = header_checksum(header);
+
+  std::size_t binary_size =
+      header.shared_binary_offset != 0 ? 0 : data.size();
+  std::size_t record_size = get_record_size(sizeof(header), binary_size);
+  std::string record(record_size, '\0');
+
+  std::memcpy(record.data(), &header, sizeof(header));
+  std::memcpy(record.data() + sizeof(header), data.data(), binary_size);
+
+  if(::pwrite(_fd, record.data(), record.size(), _indexed_size) !=
+     static_cast<ssize_t>(record.size())) {
+    HIPSYCL_DEBUG_ERROR << "jit_cache_archive: Could not append to "
+                        << _filename << std::endl;
+    return false;
+  }
+
+  refresh();
+  return true;
+#else
+  return false;
+#endif
+}
+
+void jit_cache_archive::refresh() {
+#ifndef _WIN32
+  struct stat st;
+  if(fstat(_fd, &st) != 0)
+    return;
+
+  std::size_t file_size = static_cast<std::size_t>(st.st_size);
+  if(file_size <= _indexed_size)
+    return;
+
+  if(_mappings.empty() || _mappings.back().size < file_size) {
+    void *ptr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, _fd, 0);
+    if(ptr == MAP_FAILED) {
+      HIPSYCL_DEBUG_WARNING << "jit_cache_archive: Could not map " << _filename
+                            << std::endl;
+      return;
+    }
+    // Previous mappings are kept alive, since views into them might
+    // still be in use.
+    _mappings.push_back(mapping{static_cast<const char *>(ptr), file_size});
+  }
+
+  const char* base = _mappings.back().data;
+  std::size_t offset = _indexed_size;
+  while(offset + sizeof(uint64_t) <= file_size) {
+    uint64_t magic;
+    std::memcpy(&magic, base + offset, sizeof(magic));
+
+    if(magic == legacy_record_magic) {
+      legacy_record_header header;
+      if(offset + sizeof(header) > file_size)
+        break;
+      std::memcpy(&header, base + offset, sizeof(header));
+      if(header.checksum != header_checksum(header))
+        break;
+
+      std::size_t record_size = get_record_size(sizeof(header), header.size);
+      if(offset + record_size > file_size)
+        break;
+
+      id_type id{header.id[0], header.id[1]};
+      _index[id] = record_location{offset + sizeof(header),
+                                   static_cast<std::size_t>(header.size)};
+      offset += record_size;
+    } else if(magic == record_magic) {
+      record_header header;
+      if(offset + sizeof(header) > file_size)
+        break;
+      std::memcpy(&header, base + offset, sizeof(header));
+      if(header.checksum != header_checksum(header))
+        break;
+
+      id_type id{header.id[0], header.id[1]};
+      std::size_t record_size;
+      if(header.shared_binary_offset != 0) {
+        // Shared binaries always precede the records referring to them
+        if(header.shared_binary_offset + header.size > offset)
+          break;
+        record_size = get_record_size(sizeof(header), 0);
+        if(offset + record_size > file_size)
+          break;
+        _index[id] =
+            record_location{static_cast<std::size_t>(header.shared_binary_offset),
+                            static_cast<std::size_t>(header.size)};
+      } else {
+        record_size = get_record_size(sizeof(header), header.size);
+        if(offset + record_size > file_size)
+          break;
+        record_location location{offset + sizeof(header),
+                                 static_cast<std::size_t>(header.size)};
+        _index[id] = location;
+        _content_index.emplace(header.content_hash, location);
+      }
+      offset += record_size;
+    } else {
+      break;
+    }
+  }
+  _indexed_size = offset;
+#endif
+}
+
+bool jit_cache_archive::lookup_impl(const id_type &id,
+                                    std::string_view &out) const {
+  auto it = _index.find(id);
+  if(it == _index.end() || _mappings.empty())
+    return false;
+  out = std::string_view{_mappings.back().data + it->second.offset,
+                         it->second.size};
+  return true;
+}
+
+}
+}
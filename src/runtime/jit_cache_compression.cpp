@@ -0,0 +1,128 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/jit_cache_compression.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/stable_running_hash.hpp"
+
+#include <cstring>
+
+#ifdef HIPSYCL_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+// "ACPPJCZ1" in little endian
+constexpr uint64_t compressed_entry_magic = 0x315a434a50504341ull;
+constexpr uint64_t codec_zstd = 1;
+
+struct compressed_entry_header {
+  uint64_t magic;
+  uint64_t codec;
+  uint64_t uncompressed_size;
+};
+
+bool is_compressed(std::string_view entry) {
+  if(entry.size() < sizeof(compressed_entry_header))
+    return false;
+  uint64_t magic;
+  std::memcpy(&magic, entry.data(), sizeof(magic));
+  return magic == compressed_entry_magic;
+}
+
+}
+
+std::string encode_jit_cache_entry(std::string_view binary,
+                                   [[maybe_unused]] int level) {
+#ifdef HIPSYCL_WITH_ZSTD
+  if(level > 0) {
+    std::size_t bound = ZSTD_compressBound(binary.size());
+    std::string entry(sizeof(compressed_entry_header) + bound, '\0');
+    std::size_t compressed_size =
+        ZSTD_compress(entry.data() + sizeof(compressed_entry_header), bound,
+                      binary.data(), binary.size(), level);
+    if(!ZSTD_isError(compressed_size) &&
+       sizeof(compressed_entry_header) + compressed_size < binary.size()) {
+      compressed_entry_header header{compressed_entry_magic, codec_zstd,
+                                     binary.size()};
+      std::memcpy(entry.data(), &header, sizeof(header));
+      entry.resize(sizeof(compressed_entry_header) + compressed_size);
+      return entry;
+    }
+  }
+#endif
+  return std::string{binary};
+}
+
+bool decode_jit_cache_entry(std::string_view entry, std::string &out) {
+  if(!is_compressed(entry)) {
+    out.assign(entry.data(), entry.size());
+    return true;
+  }
+
+  compressed_entry_header header;
+  std::memcpy(&header, entry.data(), sizeof(header));
+  if(header.codec != codec_zstd) {
+    HIPSYCL_DEBUG_ERROR << "jit_cache_compression: Unknown compression codec "
+                        << header.codec << std::endl;
+    return false;
+  }
+#ifdef HIPSYCL_WITH_ZSTD
+  out.resize(header.uncompressed_size);
+  std::size_t size = ZSTD_decompress(
+      out.data(), out.size(), entry.data() + sizeof(header),
+      entry.size() - sizeof(header));
+  if(ZSTD_isError(size) || size != header.uncompressed_size) {
+    HIPSYCL_DEBUG_ERROR << "jit_cache_compression: Could not decompress entry"
+                        << std::endl;
+    out.clear();
+    return false;
+  }
+  return true;
+#else
+  HIPSYCL_DEBUG_ERROR << "jit_cache_compression: Entry is compressed, but "
+                         "AdaptiveCpp has been built without zstd"
+                      << std::endl;
+  return false;
+#endif
+}
+
+bool decode_jit_cache_entry(std::string_view entry, std::string_view &out,
+                            std::string &storage) {
+  if(!is_compressed(entry)) {
+    out = entry;
+    return true;
+  }
+  if(!decode_jit_cache_entry(entry, storage))
+    return false;
+  out = storage;
+  return true;
+}
+
+uint64_t get_jit_cache_content_hash(std::string_view entry) {
+  common::stable_running_hash hash;
+  hash(entry.data(), entry.size());
+  return hash.get_current_hash();
+}
+
+bool is_jit_cache_compression_available() {
+#ifdef HIPSYCL_WITH_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+}
+}
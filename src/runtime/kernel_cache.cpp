@@ -13,18 +13,92 @@
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/jit_cache_compression.hpp"
 #include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdlib>
 #include <fstream>
+#include <iterator>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace hipsycl {
 namespace rt {
 
 namespace {
 
+uint64_t get_current_timestamp() {
+  return std::chrono::duration_cast<std::chrono::seconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+// Records the use of a binary from the persistent cache for LRU eviction
+void touch_persistent_cache_entry(kernel_configuration::id_type id_of_binary) {
+  auto &appdb =
+      common::filesystem::persistent_storage::get().get_this_app_db();
+  bool exists = appdb.read_entry<common::db::binary_entry>(
+      id_of_binary,
+      [](const common::db::binary_entry *entry) { return entry != nullptr; });
+  if(exists)
+    appdb.read_write_entry<common::db::binary_entry>(
+        id_of_binary, [&](common::db::binary_entry &entry) {
+          entry.last_used = get_current_timestamp();
+        });
+}
+
+bool read_persistent_cache_file(const std::string& filename, std::string& out) {
+  std::ifstream file{filename, std::ios::in | std::ios::binary | std::ios::ate};
+  if(!file.is_open())
+    return false;
+
+  std::streamsize file_size = file.tellg();
+  file.seekg(0, std::ios::beg);
+  std::string entry(file_size, '\0');
+  if(!file.read(entry.data(), file_size))
+    return false;
+
+  return decode_jit_cache_entry(entry, out);
+}
+
+// Looks for a file in the persistent cache with the same content as entry,
+// which can then be shared instead of storing the entry again.
+std::string find_identical_persistent_cache_file(const std::string &entry,
+                                                 uint64_t content_hash) {
+  std::vector<std::string> candidates;
+  common::filesystem::persistent_storage::get()
+      .get_this_app_db()
+      .read_access([&](const common::db::appdb_data &appdb) {
+        for(const auto& binary : appdb.binaries)
+          if(binary.second.content_hash == content_hash &&
+             binary.second.binary_size == entry.size() &&
+             !binary.second.jit_cache_filename.empty())
+            candidates.push_back(binary.second.jit_cache_filename);
+      });
+
+  for(const auto& candidate : candidates) {
+    // Entries of the packed cache cannot be hard-linked
+    if(candidate.size() >= 5 &&
+       candidate.compare(candidate.size() - 5, 5, ".pack") == 0)
+      continue;
+    std::ifstream file{candidate, std::ios::in | std::ios::binary};
+    if(!file.is_open())
+      continue;
+    std::string content{std::istreambuf_iterator<char>{file},
+                        std::istreambuf_iterator<char>{}};
+    if(content == entry)
+      return candidate;
+  }
+  return {};
+}
+
 template<class F>
 void for_each_device_image(const common::hcf_container& hcf, F&& handler) {
   if(hcf.root_node()->has_subnode("images")) {
@@ -54,6 +128,9 @@ hcf_kernel_info::hcf_kernel_info(
     return;
   _image_providers = kernel_node->get_as_list("image-providers");
 
+  if(auto *content_hash = kernel_node->get_value("content-hash"))
+    _content_hash = std::stoull(*content_hash);
+
   // investigate parameters
   auto *parameters_node = kernel_node->get_subnode("parameters");
 
@@ -104,6 +181,8 @@ hcf_kernel_info::hcf_kernel_info(
           } else if(entry.first == "fcall_specialized_config") {
             _known_annotations.back().push_back(
                 annotation_type::fcall_specialized_config);
+          } else if(entry.first == "fast_math") {
+            _known_annotations.back().push_back(annotation_type::fast_math);
           } else {
             _string_annotations.back().push_back(entry.first);
           }
@@ -175,6 +254,10 @@ hcf_object_id hcf_kernel_info::get_hcf_object_id() const {
   return _id;
 }
 
+std::optional<uint64_t> hcf_kernel_info::get_content_hash() const {
+  return _content_hash;
+}
+
 const std::vector<kernel_build_flag> &
 hcf_kernel_info::get_compilation_flags() const {
   return _compilation_flags;
@@ -238,7 +321,7 @@ hcf_cache& hcf_cache::get() {
   return c;
 }
 
-hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
+hcf_object_id hcf_cache::register_hcf_object(common::hcf_container obj) {
 
   std::lock_guard<std::mutex> lock{_mutex};
 
@@ -258,12 +341,13 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
         << ", this should not happen. Some kernels might be unavailable."
         << std::endl;
   } else {
-    common::hcf_container* stored_obj = new common::hcf_container{obj};
+    common::hcf_container *stored_obj =
+        new common::hcf_container{std::move(obj)};
     _hcf_objects[id] = std::unique_ptr<common::hcf_container>{stored_obj};
     // Check if the HCF exports some symbols
     for_each_exported_symbol_list(
-        // Don't use obj here, since we have copied it into the cache, and need
-        // to ensure that the pointers to image nodes are stable
+        // Use the object stored in the cache, since obj has been moved from
+        // and the pointers to image nodes need to be stable
         *stored_obj,
         [&](const common::hcf_container::node *image_node,
             const std::vector<std::string> &exported_symbols) {
@@ -298,8 +382,10 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
                 << " original index = "
                 << kernel_info->get_original_argument_index(i) << std::endl;
           }
-          _hcf_kernel_info[generate_info_id(id, kernel_name)] =
-              std::move(kernel_info);
+          info_id kernel_info_id = generate_info_id(id, kernel_name);
+          _hcf_kernel_info_lookup.insert_or_assign(kernel_info_id,
+                                                   kernel_info.get());
+          _hcf_kernel_info[kernel_info_id] = std::move(kernel_info);
         }
       }
     }
@@ -318,6 +404,31 @@ hcf_object_id hcf_cache::register_hcf_object(const common::hcf_container &obj) {
         }
       }
     }
+    // Backend binaries that were embedded ahead of time, keyed by the
+    // id of the binary
+    if(auto *binaries_node =
+           stored_obj->root_node()->get_subnode("precompiled-binaries")) {
+      for(const auto& binary_name : binaries_node->get_subnodes()) {
+        const auto* binary_node = binaries_node->get_subnode(binary_name);
+        std::size_t separator = binary_name.find('.');
+        if(separator == std::string::npos ||
+           !binary_node->has_binary_data_attached()) {
+          HIPSYCL_DEBUG_WARNING << "hcf_cache: Ignoring invalid precompiled "
+                                   "binary node "
+                                << binary_name << " in HCF object " << id
+                                << std::endl;
+          continue;
+        }
+        kernel_configuration::id_type binary_id{
+            std::strtoull(binary_name.c_str(), nullptr, 10),
+            std::strtoull(binary_name.c_str() + separator + 1, nullptr, 10)};
+        HIPSYCL_DEBUG_INFO << "hcf_cache: Registering precompiled binary "
+                           << binary_name << " from HCF object " << id
+                           << std::endl;
+        _precompiled_binaries[binary_id] =
+            precompiled_binary_location{id, binary_node};
+      }
+    }
   }
 
   std::string hcf_dump_dir =
@@ -370,6 +481,14 @@ void hcf_cache::unregister_hcf_object(hcf_object_id id) {
                 symbol_providers.end());
           }
         });
+    // Precompiled binaries reference data of the HCF, so they need to go too.
+    std::vector<kernel_configuration::id_type> removed_binaries;
+    for(const auto& entry : _precompiled_binaries)
+      if(entry.second.hcf_id == id)
+        removed_binaries.push_back(entry.first);
+    for(const auto& binary_id : removed_binaries)
+      _precompiled_binaries.erase(binary_id);
+
     // Then we can remove the HCF itself.
     // Note: We don't necessarily need to remove the HCF kernel info, since
     // just maintaining this data won't have any side effects as long as 
@@ -378,6 +497,25 @@ void hcf_cache::unregister_hcf_object(hcf_object_id id) {
   }
 }
 
+bool hcf_cache::get_precompiled_binary(
+    const kernel_configuration::id_type &id_of_binary, std::string &out) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+
+  auto it = _precompiled_binaries.find(id_of_binary);
+  if(it == _precompiled_binaries.end())
+    return false;
+  auto hcf = _hcf_objects.find(it->second.hcf_id);
+  if(hcf == _hcf_objects.end())
+    return false;
+  return hcf->second->get_binary_attachment(it->second.binary_node, out);
+}
+
+bool hcf_cache::has_precompiled_binary(
+    const kernel_configuration::id_type &id_of_binary) const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _precompiled_binaries.find(id_of_binary) != _precompiled_binaries.end();
+}
+
 const common::hcf_container* hcf_cache::get_hcf(hcf_object_id obj) const {
   std::lock_guard<std::mutex> lock{_mutex};
 
@@ -390,11 +528,7 @@ const common::hcf_container* hcf_cache::get_hcf(hcf_object_id obj) const {
 const hcf_kernel_info *
 hcf_cache::get_kernel_info(hcf_object_id obj,
                            std::string_view kernel_name) const {
-  std::lock_guard<std::mutex> lock{_mutex};
-  auto it = _hcf_kernel_info.find(generate_info_id(obj, kernel_name));
-  if(it == _hcf_kernel_info.end())
-    return nullptr;
-  return it->second.get();
+  return _hcf_kernel_info_lookup.find(generate_info_id(obj, kernel_name));
 }
 
 const hcf_kernel_info *
@@ -424,21 +558,212 @@ std::shared_ptr<kernel_cache> kernel_cache::get() {
 }
 
 void kernel_cache::unload() {
+  std::vector<std::unique_ptr<worker_thread>> async_jit_workers;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    async_jit_workers = std::move(_async_jit_workers);
+    _async_jit_workers.clear();
+  }
+  // Wait for outstanding background compilations outside of the lock,
+  // since they need to store their results in the cache.
+  async_jit_workers.clear();
+  // Background compilations might have scheduled eviction, so the
+  // eviction worker can only be shut down afterwards.
+  std::unique_ptr<worker_thread> eviction_worker;
+  {
+    std::lock_guard<std::mutex> lock{_eviction_mutex};
+    eviction_worker = std::move(_eviction_worker);
+  }
+  eviction_worker.reset();
+
   std::lock_guard<std::mutex> lock{_mutex};
 
+  _code_object_lookup.clear();
   _code_objects.clear();
+  _async_jit_results.clear();
 }
 
-const code_object* kernel_cache::get_code_object(code_object_id id) const {
+void kernel_cache::register_jit_recipe_compiler(backend_id backend,
+                                                jit_recipe_compiler compiler) {
   std::lock_guard<std::mutex> lock{_mutex};
+  _jit_recipe_compilers[backend] = compiler;
+}
+
+bool kernel_cache::is_persistently_cached(
+    code_object_id id_of_binary, const std::string &filename) const {
+  if(hcf_cache::get().has_precompiled_binary(id_of_binary))
+    return true;
+  if(filename.empty())
+    return false;
+  if(auto* packed_cache = get_packed_cache()) {
+    if(filename == packed_cache->get_filename())
+      return packed_cache->contains(id_of_binary);
+  }
+  return common::filesystem::exists(filename);
+}
+
+void kernel_cache::precompile_recorded_binaries() {
+  struct precompilation_task {
+    code_object_id id_of_binary;
+    common::db::jit_recipe recipe;
+    jit_recipe_compiler compiler;
+  };
+  std::vector<precompilation_task> tasks;
+
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    common::filesystem::persistent_storage::get()
+        .get_this_app_db()
+        .read_access([&](const common::db::appdb_data &appdb) {
+          for(const auto& entry : appdb.binaries) {
+            const auto& recipe = entry.second.recipe;
+            if(!recipe.is_valid())
+              continue;
+            auto compiler = _jit_recipe_compilers.find(
+                static_cast<backend_id>(recipe.backend));
+            if(compiler == _jit_recipe_compilers.end())
+              continue;
+            if(is_persistently_cached(entry.first,
+                                      entry.second.jit_cache_filename))
+              continue;
+            tasks.push_back(
+                precompilation_task{entry.first, recipe, compiler->second});
+          }
+        });
+  }
+
+  if(tasks.empty())
+    return;
+
+  HIPSYCL_DEBUG_INFO << "kernel_cache: Precompiling " << tasks.size()
+                     << " binaries recorded in previous application runs"
+                     << std::endl;
+
+  std::size_t num_workers =
+      std::min(tasks.size(),
+               std::max(std::size_t{1},
+                        static_cast<std::size_t>(
+                            std::thread::hardware_concurrency())));
+  std::atomic<std::size_t> num_failed = 0;
+  {
+    std::vector<std::unique_ptr<worker_thread>> workers;
+    for(std::size_t i = 0; i < num_workers; ++i)
+      workers.emplace_back(std::make_unique<worker_thread>());
+
+    for(std::size_t i = 0; i < tasks.size(); ++i) {
+      (*workers[i % num_workers])([this, &num_failed, &task = tasks[i]]() {
+        std::string compiled_binary;
+        std::unique_ptr<common::filesystem::file_lock> shared_compilation_lock;
+        if (lock_shared_jit_compilation(task.id_of_binary,
+                                        shared_compilation_lock,
+                                        compiled_binary))
+          return;
+        trace_span span{"JIT precompile", "jit"};
+        uint64_t begin = profiler_clock::ns_ticks(profiler_clock::now());
+        if (task.compiler(task.recipe, task.id_of_binary, compiled_binary)) {
+          uint64_t end = profiler_clock::ns_ticks(profiler_clock::now());
+          persistent_cache_store(task.id_of_binary, compiled_binary,
+                                 end - begin);
+        } else {
+          ++num_failed;
+        }
+      });
+    }
+    // Destroying the workers waits for all compilations to complete.
+  }
+
+  if(num_failed > 0) {
+    HIPSYCL_DEBUG_WARNING << "kernel_cache: Precompilation has failed for "
+                          << num_failed << " of " << tasks.size()
+                          << " binaries" << std::endl;
+  }
+}
+
+void kernel_cache::emit_first_jit_compilation_warning() {
+  if(_is_first_jit_compilation) {
+    _is_first_jit_compilation = false;
+    HIPSYCL_DEBUG_WARNING
+        << "kernel_cache: This application run has resulted in new "
+           "binaries being JIT-compiled. This indicates that the runtime "
+           "optimization process has not yet reached peak performance. You "
+           "may want to run the application again until this warning no "
+           "longer appears to achieve optimal performance."
+        << std::endl;
+  }
+}
+
+void kernel_cache::schedule_async_jit_compilation(
+    code_object_id id_of_binary, async_jit_compiler jit_compile) {
+
+  _async_jit_results[id_of_binary].state = async_jit_state::pending;
+
+  if(_async_jit_workers.empty()) {
+    std::size_t num_workers = std::max(
+        std::size_t{1},
+        application::get_settings().get<setting::async_jit_threads>());
+    for(std::size_t i = 0; i < num_workers; ++i)
+      _async_jit_workers.emplace_back(std::make_unique<worker_thread>());
+  }
+
+  auto& worker = *_async_jit_workers[_next_async_jit_worker];
+  _next_async_jit_worker =
+      (_next_async_jit_worker + 1) % _async_jit_workers.size();
+
+  worker([this, id_of_binary, jit_compile]() {
+    std::string compiled_binary;
+    bool success = false;
+    uint64_t compilation_time = 0;
+    std::unique_ptr<common::filesystem::file_lock> shared_compilation_lock;
+    if(lock_shared_jit_compilation(id_of_binary, shared_compilation_lock,
+                                   compiled_binary)) {
+      success = true;
+    } else {
+      {
+        trace_span span{"JIT compile [async]", "jit"};
+        runtime_statistics::get().add(statistic::jit_compilations);
+        statistics_timer timer{statistic::jit_compilation_time_ns};
+        success = jit_compile(compiled_binary);
+        compilation_time = timer.get_elapsed_time();
+      }
+
+      if(success)
+        persistent_cache_store(id_of_binary, compiled_binary, compilation_time);
+    }
+    shared_compilation_lock.reset();
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto& result = _async_jit_results[id_of_binary];
+    if(success) {
+      emit_first_jit_compilation_warning();
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Background JIT compilation for "
+                            "binary id "
+                         << kernel_configuration::to_string(id_of_binary)
+                         << " has completed" << std::endl;
+      result.binary = std::move(compiled_binary);
+      result.state = async_jit_state::available;
+    } else {
+      HIPSYCL_DEBUG_WARNING << "kernel_cache: Background JIT compilation for "
+                               "binary id "
+                            << kernel_configuration::to_string(id_of_binary)
+                            << " has failed" << std::endl;
+      result.state = async_jit_state::failed;
+    }
+  });
+}
+
+const code_object* kernel_cache::get_code_object(code_object_id id) const {
+  trace_span span{"kernel_cache lookup", "jit"};
   return get_code_object_impl(id);
 }
 
 const code_object* kernel_cache::get_code_object_impl(code_object_id id) const {
-  auto it = _code_objects.find(id);
-  if(it == _code_objects.end())
-    return nullptr;
-  return it->second.get();
+  return _code_object_lookup.find(id);
+}
+
+void kernel_cache::store_code_object(code_object_id id,
+                                     const code_object *obj) {
+  _code_objects[id] = code_object_ptr{obj};
+  _code_object_lookup.insert_or_assign(id, obj);
 }
 
 std::string kernel_cache::get_persistent_cache_file(code_object_id id_of_binary) {
@@ -447,65 +772,299 @@ std::string kernel_cache::get_persistent_cache_file(code_object_id id_of_binary)
   return join_path(cache_dir, kernel_configuration::to_string(id_of_binary)+".jit");
 }
 
+jit_cache_archive* kernel_cache::get_packed_cache() const {
+  std::call_once(_packed_cache_init_flag, [this]() {
+    if(!application::get_settings().get<setting::packed_jit_cache>())
+      return;
+
+    using namespace common::filesystem;
+    std::string filename =
+        join_path(persistent_storage::get().get_this_app_dir(), "jit.pack");
+    auto archive = std::make_unique<jit_cache_archive>(filename);
+    if(archive->is_open()) {
+      _packed_cache = std::move(archive);
+    } else {
+      HIPSYCL_DEBUG_WARNING
+          << "kernel_cache: Could not open packed persistent cache " << filename
+          << ", falling back to one file per binary" << std::endl;
+    }
+  });
+  return _packed_cache.get();
+}
+
 bool kernel_cache::persistent_cache_lookup(code_object_id id_of_binary,
                                            std::string &out) const {
+  std::string_view binary;
+  if(!persistent_cache_lookup(id_of_binary, binary, out))
+    return false;
+  if(binary.data() != out.data())
+    out.assign(binary.data(), binary.size());
+  return true;
+}
+
+bool kernel_cache::persistent_cache_lookup(code_object_id id_of_binary,
+                                           std::string_view &out,
+                                           std::string &storage) const {
+  trace_span span{"persistent cache lookup", "jit"};
+  // Binaries that are shipped with the application take precedence
+  if(hcf_cache::get().get_precompiled_binary(id_of_binary, storage)) {
+    out = storage;
+    HIPSYCL_DEBUG_INFO << "kernel_cache: Found precompiled binary for id "
+                       << kernel_configuration::to_string(id_of_binary)
+                       << " in HCF object" << std::endl;
+    runtime_statistics::get().add(statistic::persistent_cache_hits);
+    return true;
+  }
+
+  if(auto* packed_cache = get_packed_cache()) {
+    std::string_view entry;
+    if(packed_cache->lookup(id_of_binary, entry)) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Persistent cache hit for id "
+                         << kernel_configuration::to_string(id_of_binary)
+                         << " in packed cache " << packed_cache->get_filename()
+                         << std::endl;
+      // Uncompressed entries are used directly from the mapped packed cache
+      if(decode_jit_cache_entry(entry, out, storage)) {
+        touch_persistent_cache_entry(id_of_binary);
+        runtime_statistics::get().add(statistic::persistent_cache_hits);
+        return true;
+      }
+    }
+  }
+
   std::string filename;
 
   bool filename_lookup_succeeded =
       common::filesystem::persistent_storage::get()
           .get_this_app_db()
-          .read_access([&](const common::db::appdb_data &appdb) {
-            auto binary = appdb.binaries.find(id_of_binary);
-            if (binary == appdb.binaries.end())
-              return false;
+          .read_entry<common::db::binary_entry>(
+              id_of_binary, [&](const common::db::binary_entry *binary) {
+                if(!binary)
+                  return false;
 
-            filename = binary->second.jit_cache_filename;
-            return true;
-          });
+                filename = binary->jit_cache_filename;
+                return true;
+              });
 
-  if(!filename_lookup_succeeded)
+  if(!filename_lookup_succeeded) {
+    runtime_statistics::get().add(statistic::persistent_cache_misses);
     return false;
+  }
 
-  std::ifstream file{filename, std::ios::in | std::ios::binary | std::ios::ate};
-  
-  if(!file.is_open())
+  if(!read_persistent_cache_file(filename, storage)) {
+    runtime_statistics::get().add(statistic::persistent_cache_misses);
     return false;
+  }
+  out = storage;
 
   HIPSYCL_DEBUG_INFO << "kernel_cache: Persistent cache hit for id "
                      << kernel_configuration::to_string(id_of_binary)
                      << " in file " << filename << std::endl;
 
-  std::streamsize file_size = file.tellg();
-  file.seekg(0, std::ios::beg);
-  out.resize(file_size);
-  file.read(out.data(), file_size);
-  
+  touch_persistent_cache_entry(id_of_binary);
+  runtime_statistics::get().add(statistic::persistent_cache_hits);
   return true;
 }
 
 void kernel_cache::persistent_cache_store(code_object_id id_of_binary,
-                                          const std::string &data) const {
+                                          const std::string &data,
+                                          uint64_t compilation_time) {
   if(application::get_settings().get<setting::no_jit_cache_population>())
     return;
 
-  std::string filename = get_persistent_cache_file(id_of_binary);
+  static const int compression_level =
+      application::get_settings().get<setting::jit_cache_compression_level>();
+  std::string stored_binary = encode_jit_cache_entry(data, compression_level);
+  uint64_t content_hash = get_jit_cache_content_hash(stored_binary);
 
-  HIPSYCL_DEBUG_INFO << "kernel_cache: Storing compiled binary with id "
-                     << kernel_configuration::to_string(id_of_binary)
-                     << " in persistent cache file " << filename << std::endl;
-  
+  std::string filename;
+  if(auto* packed_cache = get_packed_cache()) {
+    filename = packed_cache->get_filename();
+
+    HIPSYCL_DEBUG_INFO << "kernel_cache: Storing compiled binary with id "
+                       << kernel_configuration::to_string(id_of_binary)
+                       << " in packed persistent cache " << filename
+                       << std::endl;
+
+    if(!packed_cache->store(id_of_binary, stored_binary)) {
+      HIPSYCL_DEBUG_ERROR
+          << "Could not store JIT result in packed persistent kernel cache "
+          << filename << std::endl;
+      return;
+    }
+  } else {
+    filename = get_persistent_cache_file(id_of_binary);
+
+    HIPSYCL_DEBUG_INFO << "kernel_cache: Storing compiled binary with id "
+                       << kernel_configuration::to_string(id_of_binary)
+                       << " in persistent cache file " << filename << std::endl;
+
+    std::string identical_file =
+        find_identical_persistent_cache_file(stored_binary, content_hash);
+    if(!identical_file.empty() &&
+       (identical_file == filename ||
+        common::filesystem::atomic_hard_link(identical_file, filename))) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Binary is identical to "
+                         << identical_file << ", sharing its storage"
+                         << std::endl;
+    } else if(!common::filesystem::atomic_write(filename, stored_binary)) {
+      HIPSYCL_DEBUG_ERROR
+          << "Could not store JIT result in persistent kernel cache in file "
+          << filename << std::endl;
+    }
+  }
 
-  if(!common::filesystem::atomic_write(filename, data)) {
-    HIPSYCL_DEBUG_ERROR
-        << "Could not store JIT result in persistent kernel cache in file "
-        << filename << std::endl;
+  common::filesystem::persistent_storage::get()
+      .get_this_app_db()
+      .read_write_entry<common::db::binary_entry>(
+          id_of_binary, [&](common::db::binary_entry &entry) {
+            entry.jit_cache_filename = filename;
+            entry.binary_size = stored_binary.size();
+            entry.content_hash = content_hash;
+            entry.last_used = get_current_timestamp();
+            entry.compilation_time = compilation_time;
+          });
+
+  schedule_persistent_cache_eviction();
+}
+
+void kernel_cache::record_kernel_resource_usage(
+    code_object_id id_of_binary,
+    const common::db::kernel_resource_usage_entry &usage) {
+  HIPSYCL_DEBUG_INFO << "kernel_cache: Kernel " << usage.kernel_name
+                     << " in binary "
+                     << kernel_configuration::to_string(id_of_binary)
+                     << " uses " << usage.num_registers << " registers, "
+                     << usage.spill_bytes << " spill bytes, "
+                     << usage.private_mem_bytes << " private memory bytes, "
+                     << usage.local_mem_bytes
+                     << " local memory bytes; occupancy " << usage.occupancy
+                     << "% at group size " << usage.occupancy_group_size
+                     << std::endl;
+  if(usage.spill_bytes > 0) {
+    HIPSYCL_DEBUG_WARNING << "kernel_cache: Kernel " << usage.kernel_name
+                          << " spills " << usage.spill_bytes
+                          << " bytes per work item to memory" << std::endl;
   }
 
+  if(application::get_settings().get<setting::no_jit_cache_population>())
+    return;
+
   common::filesystem::persistent_storage::get()
       .get_this_app_db()
-      .read_write_access([&](common::db::appdb_data &appdb) {
-        appdb.binaries[id_of_binary].jit_cache_filename = filename;
-      });
+      .read_write_entry<common::db::binary_entry>(
+          id_of_binary, [&](common::db::binary_entry &entry) {
+            for(auto& existing : entry.kernel_resources) {
+              if(existing.kernel_name == usage.kernel_name) {
+                existing = usage;
+                return;
+              }
+            }
+            entry.kernel_resources.push_back(usage);
+          });
+}
+
+bool kernel_cache::persistent_native_binary_lookup(
+    code_object_id id_of_native_binary, std::string &out) const {
+  // Does not need _mutex, since the persistent cache is synchronized
+  // by the appdb.
+  return persistent_cache_lookup(id_of_native_binary, out);
+}
+
+void kernel_cache::persistent_native_binary_store(
+    code_object_id id_of_native_binary, const std::string &data,
+    uint64_t compilation_time) {
+  persistent_cache_store(id_of_native_binary, data, compilation_time);
+}
+
+bool kernel_cache::lock_shared_jit_compilation(
+    code_object_id id_of_binary,
+    std::unique_ptr<common::filesystem::file_lock> &lock,
+    std::string &out) const {
+  static const bool is_enabled =
+      application::get_settings().get<setting::shared_jit_compilation>();
+  if(!is_enabled)
+    return false;
+
+  static const std::size_t timeout_ms =
+      1000 *
+      application::get_settings().get<setting::shared_jit_compilation_timeout>();
+
+  std::string filename = get_persistent_cache_file(id_of_binary);
+  {
+    trace_span span{"JIT compile lock", "jit"};
+    if(timeout_ms > 0)
+      lock = std::make_unique<common::filesystem::file_lock>(
+          common::db::get_jit_cache_lock_file(filename), timeout_ms);
+    else
+      lock = std::make_unique<common::filesystem::file_lock>(
+          common::db::get_jit_cache_lock_file(filename));
+  }
+
+  if(!lock->is_locked()) {
+    HIPSYCL_DEBUG_WARNING << "kernel_cache: Could not acquire shared JIT "
+                             "compilation lock for binary id "
+                          << kernel_configuration::to_string(id_of_binary)
+                          << ", compiling locally" << std::endl;
+    lock.reset();
+    return false;
+  }
+
+  if(persistent_cache_lookup(id_of_binary, out))
+    return true;
+
+  // Other processes only add the binary to the appdb when they store it on
+  // exit, so the cache file of the binary needs to be checked directly.
+  if(!read_persistent_cache_file(filename, out))
+    return false;
+
+  HIPSYCL_DEBUG_INFO << "kernel_cache: Binary id "
+                     << kernel_configuration::to_string(id_of_binary)
+                     << " has been compiled by another process, using "
+                     << filename << std::endl;
+  return true;
+}
+
+void kernel_cache::schedule_persistent_cache_eviction() {
+  if(application::get_settings().get<setting::jit_cache_max_size>() == 0)
+    return;
+  // Only one eviction needs to be pending at a time
+  if(_is_eviction_scheduled.exchange(true))
+    return;
+
+  std::lock_guard<std::mutex> lock{_eviction_mutex};
+  if(!_eviction_worker)
+    _eviction_worker = std::make_unique<worker_thread>();
+  (*_eviction_worker)([this]() {
+    _is_eviction_scheduled = false;
+    evict_persistent_cache_entries();
+  });
+}
+
+void kernel_cache::evict_persistent_cache_entries() {
+  uint64_t max_size =
+      static_cast<uint64_t>(
+          application::get_settings().get<setting::jit_cache_max_size>()) *
+      1024 * 1024;
+  // Evict in small batches, such that the appdb is not locked
+  // for long periods of time.
+  constexpr std::size_t batch_size = 16;
+
+  std::vector<std::string> evicted_files;
+  do {
+    common::filesystem::persistent_storage::get()
+        .get_this_app_db()
+        .read_write_access([&](common::db::appdb_data &appdb) {
+          evicted_files =
+              common::db::evict_lru_binaries(appdb, max_size, batch_size);
+        });
+
+    for(const auto& file : evicted_files) {
+      HIPSYCL_DEBUG_INFO << "kernel_cache: Evicting " << file
+                         << " from persistent cache" << std::endl;
+      common::db::remove_jit_cache_file(file);
+    }
+  } while(evicted_files.size() == batch_size);
 }
 
 } // rt
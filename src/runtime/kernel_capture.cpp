@@ -0,0 +1,436 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/kernel_capture.hpp"
+#include "hipSYCL/runtime/kernel_replay.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/filesystem.hpp"
+#include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/code_object_invoker.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_launcher.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_set>
+#include <unistd.h>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+const device_id host_device{
+    backend_descriptor{hardware_platform::cpu, api_platform::omp}, 0};
+
+// Copies bytes between raw pointers on an executor of its own, such that
+// the copy does not wait for, or get batched with, other operations.
+result copy_memory(runtime *rt, backend_executor *executor,
+                   device_id executing_dev, device_id dest_dev, void *dest,
+                   device_id src_dev, const void *src, std::size_t bytes) {
+  if(bytes == 0)
+    return make_success();
+
+  const range<3> shape{1, 1, bytes};
+  execution_hints hints;
+  hints.set_hint(hints::bind_to_device{executing_dev});
+  auto node = make_dag_node(
+      hints, node_list_t{},
+      std::make_unique<memcpy_operation>(
+          memory_location{src_dev, const_cast<void *>(src), id<3>{}, shape, 1},
+          memory_location{dest_dev, dest, id<3>{}, shape, 1}, shape),
+      rt);
+  node->assign_to_device(executing_dev);
+  executor->submit_directly(node, node->get_operation(), {});
+  node->wait();
+
+  if(node->is_cancelled())
+    return make_error(__acpp_here(),
+                      error_info{"kernel_capture: Memory copy has failed"});
+  return make_success();
+}
+
+std::unique_ptr<backend_executor> create_executor(runtime *rt,
+                                                  device_id dev) {
+  backend *b = rt->backends().get(dev.get_backend());
+  if(!b)
+    return nullptr;
+  return b->create_inorder_executor(dev, 0);
+}
+
+class kernel_capture_state {
+public:
+  static kernel_capture_state &get() {
+    static kernel_capture_state state;
+    return state;
+  }
+
+  bool is_enabled() const { return !_filter.empty(); }
+
+  // Returns false if the kernel should not be captured, otherwise the
+  // file name that the capture should be written to.
+  bool select(const std::string &kernel_name, std::string &filename) {
+    if(kernel_name.find(_filter) == std::string::npos)
+      return false;
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(!_captured_kernels.insert(kernel_name).second)
+      return false;
+    filename = common::filesystem::join_path(
+        _directory, "kernel-" + std::to_string(getpid()) + "-" +
+                        std::to_string(_captured_kernels.size()) +
+                        ".acpp-capture");
+    return true;
+  }
+
+private:
+  kernel_capture_state() {
+    _filter = application::get_settings().get<setting::kernel_capture>();
+    _directory =
+        application::get_settings().get<setting::kernel_capture_directory>();
+  }
+
+  std::string _filter;
+  std::string _directory;
+  std::mutex _mutex;
+  std::unordered_set<std::string> _captured_kernels;
+};
+
+// Finds the pointer arguments of the kernel and captures the
+// allocations that they point to.
+result capture_memory(runtime *rt, const glue::kernel_launcher_data &launch_config,
+                      kernel_capture_record &record) {
+  const hcf_kernel_info *info = launch_config.kernel_info;
+  if(!info)
+    return make_error(
+        __acpp_here(),
+        error_info{"kernel_capture: No kernel info available for kernel"});
+
+  for(std::size_t i = 0; i < info->get_num_parameters(); ++i) {
+    if(info->get_argument_type(i) != hcf_kernel_info::pointer ||
+       info->get_argument_size(i) != sizeof(void *))
+      continue;
+    std::size_t arg_offset = info->get_argument_offset(i);
+    if(arg_offset + sizeof(void *) > record.kernel_args.size())
+      continue;
+
+    void *ptr;
+    std::memcpy(&ptr, record.kernel_args.data() + arg_offset, sizeof(void *));
+    auto allocation = runtime_statistics::get().find_allocation(ptr);
+    if(!allocation)
+      continue;
+
+    uint64_t base = reinterpret_cast<uint64_t>(allocation->base);
+    std::size_t index = 0;
+    while(index < record.allocations.size() &&
+          record.allocations[index].address != base)
+      ++index;
+
+    if(index == record.allocations.size()) {
+      kernel_capture_allocation a;
+      a.address = base;
+      a.size = allocation->bytes;
+      a.kind = static_cast<int>(allocation->kind);
+      a.contents.resize(allocation->bytes);
+
+      auto executor = create_executor(rt, allocation->dev);
+      if(!executor)
+        return make_error(
+            __acpp_here(),
+            error_info{"kernel_capture: Could not create executor for copy"});
+      auto err = copy_memory(rt, executor.get(), allocation->dev, host_device,
+                             a.contents.data(), allocation->dev,
+                             allocation->base, allocation->bytes);
+      if(!err.is_success())
+        return err;
+      record.allocations.push_back(std::move(a));
+    }
+
+    kernel_capture_pointer_argument arg;
+    arg.arg_offset = arg_offset;
+    arg.allocation = index;
+    arg.allocation_offset = reinterpret_cast<uint64_t>(ptr) - base;
+    record.pointer_args.push_back(arg);
+  }
+  return make_success();
+}
+
+// Backend parameters are only needed for custom operations, which are
+// never captured.
+result invoke_replayed_kernel(
+    const glue::kernel_launcher_data &launch_config, dag_node *node,
+    const kernel_configuration &kernel_config,
+    const backend_kernel_launch_capabilities &launch_capabilities, void *) {
+  auto sscp_invoker = launch_capabilities.get_sscp_invoker();
+  if(!sscp_invoker)
+    return make_error(
+        __acpp_here(),
+        error_info{"kernel_replay: Backend does not support SSCP kernels"});
+
+  range<3> num_groups;
+  for(int i = 0; i < 3; ++i)
+    num_groups[i] = (launch_config.global_size[i] +
+                     launch_config.group_size[i] - 1) /
+                    launch_config.group_size[i];
+
+  std::array<const void *, 1> args{launch_config.kernel_args.data()};
+  std::size_t arg_size = launch_config.kernel_args.size();
+
+  auto *kernel_op = static_cast<kernel_operation *>(node->get_operation());
+  return sscp_invoker.value()->submit_kernel(
+      *kernel_op, launch_config.sscp_hcf_object_id, num_groups,
+      launch_config.group_size, launch_config.local_mem_size,
+      const_cast<void **>(args.data()), &arg_size, args.size(),
+      launch_config.sscp_kernel_id, launch_config.kernel_info, kernel_config);
+}
+
+}
+
+bool is_kernel_capture_enabled() {
+  static const bool is_enabled = kernel_capture_state::get().is_enabled();
+  return is_enabled;
+}
+
+void capture_kernel_launch(const glue::kernel_launcher_data &launch_config,
+                           dag_node *node,
+                           const kernel_configuration &config,
+                           const range<3> &group_size) {
+  if(!launch_config.sscp_kernel_id)
+    return;
+  std::string kernel_name = launch_config.sscp_kernel_id;
+  std::string filename;
+  if(!kernel_capture_state::get().select(kernel_name, filename))
+    return;
+
+  const common::hcf_container *hcf =
+      hcf_cache::get().get_hcf(launch_config.sscp_hcf_object_id);
+  if(!hcf) {
+    HIPSYCL_DEBUG_WARNING << "kernel_capture: HCF object of kernel "
+                          << kernel_name << " is unavailable, not capturing"
+                          << std::endl;
+    return;
+  }
+
+  // The memory contents must reflect all operations the kernel depends on
+  node->for_each_nonvirtual_requirement([](dag_node_ptr req) { req->wait(); });
+
+  device_id dev = node->get_assigned_device();
+  kernel_capture_record record;
+  record.kernel_name = kernel_name;
+  record.hcf_object = launch_config.sscp_hcf_object_id;
+  record.hcf = hcf->serialize();
+  record.backend = static_cast<int>(dev.get_backend());
+  record.device_index = dev.get_id();
+  for(int i = 0; i < 3; ++i) {
+    record.global_size.push_back(launch_config.global_size[i]);
+    record.group_size.push_back(group_size[i]);
+  }
+  record.local_mem_size = launch_config.local_mem_size;
+  record.kernel_args.assign(
+      reinterpret_cast<const char *>(launch_config.kernel_args.data()),
+      launch_config.kernel_args.size());
+  record.configuration = glue::jit::precompilation::make_recipe(
+      dev.get_backend(), launch_config.sscp_hcf_object_id, std::string{},
+      {kernel_name}, config, false);
+
+  auto err = capture_memory(node->get_runtime(), launch_config, record);
+  if(!err.is_success()) {
+    HIPSYCL_DEBUG_WARNING << "kernel_capture: Could not capture kernel "
+                          << kernel_name << ": " << err.what() << std::endl;
+    return;
+  }
+
+  auto packed = msgpack::pack(record);
+  if(!common::filesystem::atomic_write(
+         filename, std::string{reinterpret_cast<const char *>(packed.data()),
+                               packed.size()})) {
+    HIPSYCL_DEBUG_WARNING << "kernel_capture: Could not write " << filename
+                          << std::endl;
+    return;
+  }
+  HIPSYCL_DEBUG_WARNING << "kernel_capture: Captured launch of kernel "
+                        << kernel_name << " with "
+                        << record.allocations.size() << " allocations to "
+                        << filename << std::endl;
+}
+
+result read_kernel_capture(const std::string &filename,
+                           kernel_capture_record &out) {
+  std::ifstream file{filename, std::ios::in | std::ios::binary};
+  if(!file.is_open())
+    return make_error(__acpp_here(),
+                      error_info{"kernel_replay: Could not open " + filename});
+  std::string data{std::istreambuf_iterator<char>{file},
+                   std::istreambuf_iterator<char>{}};
+
+  std::error_code ec;
+  out = msgpack::unpack<kernel_capture_record>(
+      reinterpret_cast<const uint8_t *>(data.data()), data.size(), ec);
+  if(ec || out.global_size.size() != 3 || out.group_size.size() != 3)
+    return make_error(
+        __acpp_here(),
+        error_info{"kernel_replay: " + filename + " is not a kernel capture"});
+  return make_success();
+}
+
+kernel_replay::kernel_replay(runtime *rt, const kernel_capture_record &record,
+                             const kernel_configuration &config)
+    : _rt{rt}, _record{record}, _config{config} {
+  backend *b = _rt->backends().get(static_cast<backend_id>(record.backend));
+  if(b)
+    _dev = device_id{b->get_backend_descriptor(), record.device_index};
+}
+
+kernel_replay::~kernel_replay() {
+  // Destroying the executor waits for outstanding operations
+  _executor.reset();
+  if(backend *b = _rt->backends().get(_dev.get_backend())) {
+    for(void *ptr : _allocations)
+      if(ptr)
+        b->get_allocator(_dev)->free(ptr);
+  }
+  if(_is_hcf_registered)
+    hcf_cache::get().unregister_hcf_object(_hcf_object);
+}
+
+result kernel_replay::init() {
+  backend *b = _rt->backends().get(static_cast<backend_id>(_record.backend));
+  if(!b || _record.device_index < 0 ||
+     static_cast<std::size_t>(_record.device_index) >=
+         b->get_hardware_manager()->get_num_devices())
+    return make_error(
+        __acpp_here(),
+        error_info{"kernel_replay: The device of the capture is unavailable"});
+
+  _executor = b->create_inorder_executor(_dev, 0);
+  if(!_executor)
+    return make_error(
+        __acpp_here(),
+        error_info{"kernel_replay: Could not create executor for device"});
+
+  _hcf_object = hcf_cache::get().register_hcf_object(
+      common::hcf_container{_record.hcf});
+  _is_hcf_registered = true;
+  if(_hcf_object != _record.hcf_object)
+    return make_error(
+        __acpp_here(),
+        error_info{"kernel_replay: HCF object of the capture is invalid"});
+
+  backend_allocator *allocator = b->get_allocator(_dev);
+  for(const auto &a : _record.allocations) {
+    void *ptr = nullptr;
+    switch(static_cast<allocation_kind>(a.kind)) {
+    case allocation_kind::optimized_host:
+      ptr = allocator->allocate_optimized_host(0, a.size);
+      break;
+    case allocation_kind::shared:
+      ptr = allocator->allocate_usm(a.size);
+      break;
+    default:
+      ptr = allocator->allocate(0, a.size);
+    }
+    if(!ptr)
+      return make_error(
+          __acpp_here(),
+          error_info{"kernel_replay: Could not allocate captured memory"});
+    _allocations.push_back(ptr);
+  }
+
+  auto err = restore_memory();
+  if(!err.is_success())
+    return err;
+
+  _launch_data.type = kernel_type::basic_parallel_for;
+  _launch_data.kernel_args.assign(_record.kernel_args.begin(),
+                                  _record.kernel_args.end());
+  for(const auto &arg : _record.pointer_args) {
+    if(arg.allocation >= _allocations.size() ||
+       arg.arg_offset + sizeof(void *) > _launch_data.kernel_args.size())
+      return make_error(
+          __acpp_here(),
+          error_info{"kernel_replay: Invalid pointer argument in capture"});
+    void *ptr = static_cast<char *>(_allocations[arg.allocation]) +
+                arg.allocation_offset;
+    std::memcpy(_launch_data.kernel_args.data() + arg.arg_offset, &ptr,
+                sizeof(void *));
+  }
+  for(int i = 0; i < 3; ++i) {
+    _launch_data.global_size[i] = _record.global_size[i];
+    _launch_data.group_size[i] = _record.group_size[i];
+  }
+  _launch_data.local_mem_size = static_cast<unsigned>(_record.local_mem_size);
+  _launch_data.sscp_hcf_object_id = _hcf_object;
+  _launch_data.sscp_kernel_id = _record.kernel_name.c_str();
+  _launch_data.kernel_info =
+      hcf_cache::get().get_kernel_info(_hcf_object, _record.kernel_name);
+  _launch_data.sscp_invoker = &invoke_replayed_kernel;
+  if(!_launch_data.kernel_info)
+    return make_error(
+        __acpp_here(),
+        error_info{"kernel_replay: Kernel is not contained in the HCF object"});
+
+  return make_success();
+}
+
+result kernel_replay::restore_memory() {
+  for(std::size_t i = 0; i < _record.allocations.size(); ++i) {
+    const auto &a = _record.allocations[i];
+    auto err = copy(_dev, _allocations[i], host_device, a.contents.data(),
+                    a.contents.size());
+    if(!err.is_success())
+      return err;
+  }
+  return make_success();
+}
+
+result kernel_replay::launch() {
+  kernel_launcher launcher{_launch_data, {}};
+  launcher.get_kernel_configuration() = _config;
+
+  execution_hints hints;
+  hints.set_hint(hints::bind_to_device{_dev});
+  auto node = make_dag_node(
+      hints, node_list_t{},
+      std::make_unique<kernel_operation>(_record.kernel_name.c_str(),
+                                         std::move(launcher),
+                                         requirements_list{_rt}),
+      _rt);
+  node->assign_to_device(_dev);
+  _executor->submit_directly(node, node->get_operation(), {});
+  node->wait();
+
+  if(node->is_cancelled())
+    return make_error(__acpp_here(),
+                      error_info{"kernel_replay: Kernel launch has failed"});
+  return make_success();
+}
+
+result kernel_replay::copy(device_id dest_dev, void *dest, device_id src_dev,
+                           const void *src, std::size_t bytes) {
+  return copy_memory(_rt, _executor.get(), _dev, dest_dev, dest, src_dev, src,
+                     bytes);
+}
+
+}
+}
@@ -18,10 +18,13 @@
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/tracer.hpp"
 
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <thread>
 
 namespace hipsycl {
 namespace rt {
@@ -97,14 +100,22 @@ std::size_t determine_target_lane(const dag_node_ptr& node,
 } // anonymous namespace
 
 multi_queue_executor::multi_queue_executor(
-    const backend &b, queue_factory_function queue_factory)
-    : _backend{b.get_unique_backend_id()} {
-  std::size_t num_devices = b.get_hardware_manager()->get_num_devices();
+    const backend &b, queue_factory_function queue_factory,
+    bool direction_aware_memcpy_lanes, bool high_priority_lane,
+    std::size_t num_host_task_lanes)
+    : _backend{b.get_unique_backend_id()},
+      _use_critical_path_lane{application::get_settings()
+                                  .get<setting::critical_path_scheduling>()} {
+  // Sub-devices need their own queues as well
+  std::size_t num_devices =
+      b.get_hardware_manager()->get_num_device_indices();
 
 
   _device_data.resize(num_devices);
+  std::vector<std::vector<inorder_queue*>> managed_queues(num_devices);
 
-  for (std::size_t dev = 0; dev < num_devices; ++dev) {
+  auto init_device = [&](std::size_t dev) {
+    std::vector<inorder_queue*>& device_queues = managed_queues[dev];
 
     device_id dev_id = b.get_hardware_manager()->get_device_id(dev);
     hardware_context *hw_context = b.get_hardware_manager()->get_device(dev);
@@ -112,26 +123,67 @@ multi_queue_executor::multi_queue_executor(
     std::size_t memcpy_concurrency = hw_context->get_max_memcpy_concurrency();
     std::size_t kernel_concurrency = hw_context->get_max_kernel_concurrency();
 
-    for (std::size_t i = 0; i < memcpy_concurrency; ++i) {
-      std::unique_ptr<inorder_queue> new_queue = queue_factory(dev_id);
-      _managed_queues.push_back(new_queue.get());
+    // Each direction gets its own memcpy_concurrency lanes
+    std::size_t num_memcpy_lanes =
+        direction_aware_memcpy_lanes ? 3 * memcpy_concurrency
+                                     : memcpy_concurrency;
+
+    for (std::size_t i = 0; i < num_memcpy_lanes; ++i) {
+      std::unique_ptr<inorder_queue> new_queue = queue_factory(dev_id, 0);
+      device_queues.push_back(new_queue.get());
       _device_data[dev].executors.push_back(
           std::make_unique<inorder_executor>(std::move(new_queue)));
     }
 
     _device_data[dev].memcpy_lanes.begin = 0;
-    _device_data[dev].memcpy_lanes.num_lanes = memcpy_concurrency;
+    _device_data[dev].memcpy_lanes.num_lanes = num_memcpy_lanes;
+
+    if(direction_aware_memcpy_lanes) {
+      _device_data[dev].has_direction_aware_memcpy_lanes = true;
+      _device_data[dev].host_to_device_lanes =
+          backend_execution_lane_range{0, memcpy_concurrency};
+      _device_data[dev].device_to_host_lanes =
+          backend_execution_lane_range{memcpy_concurrency, memcpy_concurrency};
+      _device_data[dev].device_to_device_lanes = backend_execution_lane_range{
+          2 * memcpy_concurrency, memcpy_concurrency};
+    }
 
     for(std::size_t i  = 0; i < kernel_concurrency; ++i) {
-      std::unique_ptr<inorder_queue> new_queue = queue_factory(dev_id);
-      _managed_queues.push_back(new_queue.get());
+      std::unique_ptr<inorder_queue> new_queue = queue_factory(dev_id, 0);
+      device_queues.push_back(new_queue.get());
       _device_data[dev].executors.push_back(
           std::make_unique<inorder_executor>(std::move(new_queue)));
     }
 
-    _device_data[dev].kernel_lanes.begin = memcpy_concurrency;
+    _device_data[dev].kernel_lanes.begin = num_memcpy_lanes;
     _device_data[dev].kernel_lanes.num_lanes = kernel_concurrency;
 
+    if(num_host_task_lanes > 0) {
+      _device_data[dev].host_task_lanes.begin =
+          _device_data[dev].executors.size();
+      for(std::size_t i = 0; i < num_host_task_lanes; ++i) {
+        std::unique_ptr<inorder_queue> new_queue = queue_factory(dev_id, 0);
+        device_queues.push_back(new_queue.get());
+        _device_data[dev].executors.push_back(
+            std::make_unique<inorder_executor>(std::move(new_queue)));
+      }
+      _device_data[dev].host_task_lanes.num_lanes = num_host_task_lanes;
+    }
+
+    if (high_priority_lane || _use_critical_path_lane) {
+      // Lower values correspond to higher priorities for CUDA and HIP, and
+      // both clamp the priority to the range supported by the device.
+      std::unique_ptr<inorder_queue> new_queue =
+          queue_factory(dev_id, std::numeric_limits<int>::min());
+      device_queues.push_back(new_queue.get());
+      _device_data[dev].executors.push_back(
+          std::make_unique<inorder_executor>(std::move(new_queue)));
+
+      _device_data[dev].has_high_priority_lane = true;
+      _device_data[dev].high_priority_lane =
+          _device_data[dev].executors.size() - 1;
+    }
+
     const std::size_t max_statistics_size = application::get_settings()
             .get<setting::mqe_lane_statistics_max_size>();
     const double statistics_decay_time_sec = application::get_settings()
@@ -141,21 +193,60 @@ multi_queue_executor::multi_queue_executor(
         max_statistics_size,
         _device_data[dev].executors.size(),
         static_cast<std::size_t>(1e9 * statistics_decay_time_sec)};
+  };
+
+  // Creating queues can be expensive (e.g. creating streams and contexts),
+  // so devices are initialized concurrently.
+  if(num_devices > 1) {
+    std::vector<std::thread> init_threads;
+    for (std::size_t dev = 0; dev < num_devices; ++dev)
+      init_threads.emplace_back(init_device, dev);
+    for(auto& t : init_threads)
+      t.join();
+  } else {
+    for (std::size_t dev = 0; dev < num_devices; ++dev)
+      init_device(dev);
   }
 
+  for(const auto& device_queues : managed_queues)
+    _managed_queues.insert(_managed_queues.end(), device_queues.begin(),
+                           device_queues.end());
+
   HIPSYCL_DEBUG_INFO << "multi_queue_executor: Spawned for backend "
                      << b.get_name() << " with configuration: " << std::endl;
   for(std::size_t i = 0; i < _device_data.size(); ++i) {
     HIPSYCL_DEBUG_INFO << "  device " << i << ": "<< std::endl;
 
-    for(std::size_t j = 0; j < _device_data[i].memcpy_lanes.num_lanes; ++j){
-      std::size_t lane = j + _device_data[i].memcpy_lanes.begin;
-      HIPSYCL_DEBUG_INFO << "    memcpy lane: " << lane << std::endl;
+    auto print_memcpy_lanes = [](backend_execution_lane_range lanes,
+                                 const char *description) {
+      for(std::size_t j = 0; j < lanes.num_lanes; ++j){
+        std::size_t lane = j + lanes.begin;
+        HIPSYCL_DEBUG_INFO << "    " << description << " lane: " << lane
+                           << std::endl;
+      }
+    };
+    if(_device_data[i].has_direction_aware_memcpy_lanes) {
+      print_memcpy_lanes(_device_data[i].host_to_device_lanes,
+                         "host-to-device memcpy");
+      print_memcpy_lanes(_device_data[i].device_to_host_lanes,
+                         "device-to-host memcpy");
+      print_memcpy_lanes(_device_data[i].device_to_device_lanes,
+                         "device-to-device memcpy");
+    } else {
+      print_memcpy_lanes(_device_data[i].memcpy_lanes, "memcpy");
     }
     for(std::size_t j = 0; j < _device_data[i].kernel_lanes.num_lanes; ++j){
       std::size_t lane = j + _device_data[i].kernel_lanes.begin;
       HIPSYCL_DEBUG_INFO << "    kernel lane: " << lane << std::endl;
     }
+    for(std::size_t j = 0; j < _device_data[i].host_task_lanes.num_lanes; ++j){
+      std::size_t lane = j + _device_data[i].host_task_lanes.begin;
+      HIPSYCL_DEBUG_INFO << "    host task lane: " << lane << std::endl;
+    }
+    if(_device_data[i].has_high_priority_lane) {
+      HIPSYCL_DEBUG_INFO << "    high-priority kernel lane: "
+                         << _device_data[i].high_priority_lane << std::endl;
+    }
   }
 }
 
@@ -189,6 +280,7 @@ multi_queue_executor::get_kernel_execution_lane_range(device_id dev) const {
 void multi_queue_executor::submit_directly(
     const dag_node_ptr& node, operation *op,
     const node_list_t &reqs) {
+  trace_span span{"operation_dispatcher"};
 
   HIPSYCL_DEBUG_INFO << "multi_queue_executor: Processing node " << node.get()
 	  << " with " << reqs.size() << " non-virtual requirement(s) and "
@@ -200,12 +292,25 @@ void multi_queue_executor::submit_directly(
     return;
 
   std::size_t op_target_lane;
+  const per_device_data &device_data =
+      _device_data[node->get_assigned_device().get_id()];
 
   if (op->is_data_transfer()) {
     op_target_lane = determine_target_lane(
         node, reqs, this,
         _device_data[node->get_assigned_device().get_id()].submission_statistics,
-        _device_data[node->get_assigned_device().get_id()].memcpy_lanes);
+        get_memcpy_lanes(device_data, op));
+  } else if (device_data.host_task_lanes.num_lanes > 0 && is_host_task(op)) {
+    // Custom operations may block for a long time, e.g. on I/O, so they
+    // get their own lanes. Lanes whose last operations are dependencies
+    // are preferred, otherwise the least recently used lane.
+    op_target_lane = determine_target_lane(
+        node, reqs, this, device_data.submission_statistics,
+        device_data.host_task_lanes);
+  } else if (device_data.has_high_priority_lane && is_high_priority(node) &&
+             !node->get_execution_hints()
+                  .has_hint<hints::prefer_execution_lane>()) {
+    op_target_lane = device_data.high_priority_lane;
   } else {
     op_target_lane = determine_target_lane(
         node, reqs, this,
@@ -226,6 +331,41 @@ void multi_queue_executor::submit_directly(
   return executor->submit_directly(node, op, reqs);
 }
 
+backend_execution_lane_range
+multi_queue_executor::get_memcpy_lanes(const per_device_data &data,
+                                       operation *op) {
+  if(!data.has_direction_aware_memcpy_lanes)
+    return data.memcpy_lanes;
+
+  // memcpy_operation is the only data transfer
+  memcpy_operation *memcpy_op = static_cast<memcpy_operation *>(op);
+  bool is_from_host = memcpy_op->source().get_device().is_host();
+  bool is_to_host = memcpy_op->dest().get_device().is_host();
+
+  if(is_from_host && !is_to_host)
+    return data.host_to_device_lanes;
+  else if(!is_from_host && is_to_host)
+    return data.device_to_host_lanes;
+  // Host-to-host copies are unusual on device executors; they do not
+  // need a copy engine, so they can share the device-to-device lanes.
+  return data.device_to_device_lanes;
+}
+
+bool multi_queue_executor::is_host_task(operation *op) {
+  if(!dynamic_is<kernel_operation>(op))
+    return false;
+  return cast<kernel_operation>(op)->get_launcher().is_custom_operation();
+}
+
+bool multi_queue_executor::is_high_priority(const dag_node_ptr &node) const {
+  const execution_hints &node_hints = node->get_execution_hints();
+  if(_use_critical_path_lane && node_hints.has_hint<hints::critical_path>())
+    return true;
+  if(auto *priority = node_hints.get_hint<hints::execution_priority>())
+    return priority->get_priority() < 0;
+  return false;
+}
+
 bool multi_queue_executor::can_execute_on_device(const device_id &dev) const {
   return _backend == dev.get_backend();
 }
@@ -244,6 +384,24 @@ bool multi_queue_executor::is_submitted_by_me(const dag_node_ptr& node) const {
   return false;
 }
 
+result multi_queue_executor::register_completion_callback(
+    const dag_node_ptr &node, void (*callback)(void *), void *user_data) {
+  if(node->is_submitted()) {
+    std::size_t dev_id = node->get_assigned_device().get_id();
+    if(dev_id < _device_data.size()) {
+      for(const auto& executor : _device_data[dev_id].executors) {
+        if(executor->get_queue() == node->get_assigned_execution_lane())
+          return executor->register_completion_callback(node, callback,
+                                                        user_data);
+      }
+    }
+  }
+  return make_error(
+      __acpp_here(),
+      error_info{"multi_queue_executor: Node was not submitted to any lane",
+                 error_type::feature_not_supported});
+}
+
 bool multi_queue_executor::find_assigned_lane_index(
     const dag_node_ptr &node, std::size_t &index_out) const {
   if(!node->is_submitted())
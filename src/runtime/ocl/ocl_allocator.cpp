@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
 
 #include "hipSYCL/runtime/ocl/ocl_allocator.hpp"
 #include <cstddef>
@@ -17,8 +18,8 @@
 namespace hipsycl {
 namespace rt {
 
-ocl_allocator::ocl_allocator(ocl_usm* usm)
-: _usm{usm} {}
+ocl_allocator::ocl_allocator(ocl_usm* usm, device_id dev)
+: _usm{usm}, _dev{dev} {}
 
 void* ocl_allocator::allocate(size_t min_alignment, size_t size_bytes) {
   if(!_usm->is_available()) {
@@ -37,6 +38,8 @@ void* ocl_allocator::allocate(size_t min_alignment, size_t size_bytes) {
                               error_type::memory_allocation_error});
     return nullptr;
   }
+  runtime_statistics::get().register_allocation(
+      ptr, size_bytes, _dev, allocation_kind::device);
   return ptr;
 }
 
@@ -57,10 +60,13 @@ void *ocl_allocator::allocate_optimized_host(size_t min_alignment,
                               error_type::memory_allocation_error});
     return nullptr;
   }
+  runtime_statistics::get().register_allocation(
+      ptr, bytes, _dev, allocation_kind::optimized_host);
   return ptr;
 }
 
 void ocl_allocator::free(void *mem) {
+  runtime_statistics::get().register_deallocation(mem);
   if(!_usm->is_available()) {
     register_error(__acpp_here(),
                    error_info{"ocl_allocator: OpenCL device does not have valid USM provider",
@@ -92,6 +98,8 @@ void *ocl_allocator::allocate_usm(size_t bytes) {
                               error_type::memory_allocation_error});
     return nullptr;
   }
+  runtime_statistics::get().register_allocation(
+      ptr, bytes, _dev, allocation_kind::shared);
   return ptr;
 }
 
@@ -18,6 +18,13 @@
 #include "hipSYCL/runtime/ocl/ocl_backend.hpp"
 #include "hipSYCL/runtime/ocl/ocl_hardware_manager.hpp"
 #include "hipSYCL/runtime/ocl/ocl_queue.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/spirv/LLVMToSpirvFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
+
 #include <memory>
 
 HIPSYCL_PLUGIN_API_EXPORT
@@ -37,9 +44,26 @@ namespace rt {
 
 namespace {
 
+void register_jit_recipe_compiler() {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  kernel_cache::get()->register_jit_recipe_compiler(
+      backend_id::ocl,
+      [](const common::db::jit_recipe &recipe,
+         kernel_cache::code_object_id id_of_binary, std::string &out) {
+        std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+            compiler::createLLVMToSpirvTranslator(recipe.kernels);
+        return glue::jit::precompilation::compile(
+                   translator.get(), recipe, id_of_binary, out)
+            .is_success();
+      });
+#endif
+}
+
 std::unique_ptr<multi_queue_executor>
 create_multi_queue_executor(ocl_backend *b, ocl_hardware_manager* mgr) {
-  return std::make_unique<multi_queue_executor>(*b, [b, mgr](device_id dev) {
+  // Queue priorities are not supported
+  return std::make_unique<multi_queue_executor>(*b, [b, mgr](device_id dev,
+                                                             int) {
     return std::make_unique<ocl_queue>(mgr, static_cast<std::size_t>(dev.get_id()));
   });
 }
@@ -49,7 +73,9 @@ create_multi_queue_executor(ocl_backend *b, ocl_hardware_manager* mgr) {
 ocl_backend::ocl_backend()
 : _executor([this](){
   return create_multi_queue_executor(this, &_hw_manager);
-}) {}
+}) {
+  register_jit_recipe_compiler();
+}
 
 ocl_backend::~ocl_backend(){}
 
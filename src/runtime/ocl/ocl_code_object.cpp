@@ -9,11 +9,17 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/ocl/ocl_code_object.hpp"
+#include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/string_utils.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/ocl/ocl_queue.hpp"
+#include "hipSYCL/runtime/ocl/ocl_usm.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
 
 namespace hipsycl {
 namespace rt {
@@ -33,24 +39,49 @@ result ocl_sscp_code_object_invoker::submit_kernel(
       local_mem_size, args, arg_sizes, num_args, config);
 }
 
-ocl_executable_object::ocl_executable_object(const cl::Context& ctx, cl::Device& dev,
-    hcf_object_id source, const std::string& code_image, const kernel_configuration &config)
-: _source{source}, _ctx{ctx}, _dev{dev}, _id{config.generate_id()} {
+ocl_kernel_instance::ocl_kernel_instance(const cl::Kernel &kernel,
+                                         std::string_view kernel_name)
+    : _kernel{kernel}, _kernel_name{kernel_name} {}
 
-  std::vector<char> ir(code_image.size());
-  std::memcpy(ir.data(), code_image.data(), code_image.size());
+cl_int ocl_kernel_instance::set_argument(std::size_t index, std::size_t size,
+                                         const void *value) {
+  if(index >= _arguments.size())
+    _arguments.resize(index + 1);
 
-  cl_int err = 0;
-  _program = cl::Program(_ctx, ir, false, &err);
+  argument& arg = _arguments[index];
+  if (arg.is_set && arg.value.size() == size && arg.is_null == !value &&
+      (!value || std::memcmp(arg.value.data(), value, size) == 0))
+    return CL_SUCCESS;
 
+  cl_int err =
+      _kernel.setArg(static_cast<cl_uint>(index), size, value);
   if(err != CL_SUCCESS) {
-    _build_status = register_error(
-        __acpp_here(),
-        error_info{"ocl_code_object: Construction of CL program failed",
-                   error_code{"CL", static_cast<int>(err)}});
-    return;
+    arg.is_set = false;
+    return err;
   }
-  
+
+  arg.is_set = true;
+  arg.is_null = !value;
+  arg.value.resize(size);
+  if(value)
+    std::memcpy(arg.value.data(), value, size);
+  return CL_SUCCESS;
+}
+
+cl_int ocl_kernel_instance::enable_indirect_usm_access(ocl_usm *usm) {
+  if(_has_indirect_usm_access)
+    return CL_SUCCESS;
+  cl_int err = usm->enable_indirect_usm_access(_kernel);
+  if(err == CL_SUCCESS)
+    _has_indirect_usm_access = true;
+  return err;
+}
+
+ocl_executable_object::ocl_executable_object(const cl::Context& ctx, cl::Device& dev,
+    hcf_object_id source, const std::string& code_image, const kernel_configuration &config,
+    const kernel_configuration::id_type& native_binary_id)
+: _source{source}, _ctx{ctx}, _dev{dev}, _id{config.generate_id()} {
+
   std::string options_string="-cl-uniform-work-group-size";
   for(const auto& flag : config.build_flags()) {
     if(flag == kernel_build_flag::fast_math) {
@@ -58,28 +89,52 @@ ocl_executable_object::ocl_executable_object(const cl::Context& ctx, cl::Device&
     }
   }
 
-  err = _program.build(
-      _dev, options_string.c_str());
+  if(!load_native_binary(native_binary_id, options_string)) {
+    std::vector<char> ir(code_image.size());
+    std::memcpy(ir.data(), code_image.data(), code_image.size());
 
-  if(err != CL_SUCCESS) {
-    std::string build_log = "<build log not available>";
-    cl_int access_build_log_err =
-        _program.getBuildInfo(_dev, CL_PROGRAM_BUILD_LOG, &build_log);
-
-    std::string msg = "ocl_code_object: Building CL program failed.";
-    if(access_build_log_err == CL_SUCCESS)
-      msg += " Build log: " + build_log;
-    
-    _build_status = register_error(
-        __acpp_here(), error_info{msg,
-                                     error_code{"CL", static_cast<int>(err)}});
-    return;
+    cl_int err = 0;
+    _program = cl::Program(_ctx, ir, false, &err);
+
+    if(err != CL_SUCCESS) {
+      _build_status = register_error(
+          __acpp_here(),
+          error_info{"ocl_code_object: Construction of CL program failed",
+                     error_code{"CL", static_cast<int>(err)}});
+      return;
+    }
+
+    auto build_start = std::chrono::high_resolution_clock::now();
+    err = _program.build(
+        _dev, options_string.c_str());
+
+    if(err != CL_SUCCESS) {
+      std::string build_log = "<build log not available>";
+      cl_int access_build_log_err =
+          _program.getBuildInfo(_dev, CL_PROGRAM_BUILD_LOG, &build_log);
+
+      std::string msg = "ocl_code_object: Building CL program failed.";
+      if(access_build_log_err == CL_SUCCESS)
+        msg += " Build log: " + build_log;
+      
+      _build_status = register_error(
+          __acpp_here(), error_info{msg,
+                                       error_code{"CL", static_cast<int>(err)}});
+      return;
+    }
+    auto build_end = std::chrono::high_resolution_clock::now();
+
+    store_native_binary(
+        native_binary_id,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(build_end -
+                                                             build_start)
+            .count());
   }
 
   // clCreateKernelsInProgram seems to not work reliably
   //err = _program.createKernels(&kernels);
   std::string concatenated_name_list;
-  err = _program.getInfo(CL_PROGRAM_KERNEL_NAMES, &concatenated_name_list);
+  cl_int err = _program.getInfo(CL_PROGRAM_KERNEL_NAMES, &concatenated_name_list);
   
   if(err != CL_SUCCESS) {
     _build_status = register_error(
@@ -93,7 +148,6 @@ ocl_executable_object::ocl_executable_object(const cl::Context& ctx, cl::Device&
   _kernel_names =
       common::split_by_delimiter(concatenated_name_list, ';');
   
-  std::vector<cl::Kernel> kernels;
   for(const auto& name : _kernel_names) {
     cl::Kernel k{_program, name.c_str(), &err};
     if(err != CL_SUCCESS) {
@@ -104,7 +158,7 @@ ocl_executable_object::ocl_executable_object(const cl::Context& ctx, cl::Device&
             error_code{"CL", static_cast<int>(err)}});
       return;
     }
-    _kernel_handles[name] = k;
+    _kernel_pools[name].prototype = k;
   }
 
   _build_status = make_success();
@@ -112,6 +166,54 @@ ocl_executable_object::ocl_executable_object(const cl::Context& ctx, cl::Device&
 
 ocl_executable_object::~ocl_executable_object() {}
 
+bool ocl_executable_object::load_native_binary(
+    const kernel_configuration::id_type &native_binary_id,
+    const std::string &options) {
+  std::string native_binary;
+  if(!kernel_cache::get()->persistent_native_binary_lookup(native_binary_id,
+                                                           native_binary))
+    return false;
+
+  cl::Program::Binaries binaries{std::vector<unsigned char>(
+      native_binary.begin(), native_binary.end())};
+  cl_int err = 0;
+  cl::Program program{_ctx, {_dev}, binaries, nullptr, &err};
+  // Programs created from binaries still need to be built
+  if(err == CL_SUCCESS)
+    err = program.build(_dev, options.c_str());
+
+  if(err != CL_SUCCESS) {
+    // This can happen e.g. if the driver rejects binaries of other builds
+    HIPSYCL_DEBUG_WARNING << "ocl_executable_object: Could not build program "
+                             "from cached native binary ("
+                          << err << "), building from SPIR-V instead"
+                          << std::endl;
+    return false;
+  }
+
+  HIPSYCL_DEBUG_INFO << "ocl_executable_object: Built program from cached "
+                        "native binary of size "
+                     << native_binary.size() << std::endl;
+  _program = program;
+  return true;
+}
+
+void ocl_executable_object::store_native_binary(
+    const kernel_configuration::id_type &native_binary_id,
+    uint64_t build_time) {
+  cl::Program::Binaries binaries;
+  cl_int err = _program.getInfo(CL_PROGRAM_BINARIES, &binaries);
+  if(err != CL_SUCCESS || binaries.size() != 1 || binaries[0].empty()) {
+    HIPSYCL_DEBUG_INFO << "ocl_executable_object: Native program binary is "
+                          "not available, not caching it"
+                       << std::endl;
+    return;
+  }
+  kernel_cache::get()->persistent_native_binary_store(
+      native_binary_id, std::string(binaries[0].begin(), binaries[0].end()),
+      build_time);
+}
+
 result ocl_executable_object::get_build_result() const {
   return _build_status;
 }
@@ -146,7 +248,7 @@ ocl_executable_object::supported_backend_kernel_names() const {
 
 bool ocl_executable_object::contains(
     const std::string &backend_kernel_name) const {
-  return _kernel_handles.find(backend_kernel_name) != _kernel_handles.end();
+  return _kernel_pools.find(backend_kernel_name) != _kernel_pools.end();
 }
 
 compilation_flow ocl_executable_object::source_compilation_flow() const {
@@ -166,14 +268,63 @@ cl::Context ocl_executable_object::get_cl_context() const {
   return _ctx;
 }
   
-result ocl_executable_object::get_kernel(std::string_view name, cl::Kernel& out) const {
+result ocl_executable_object::acquire_kernel(std::string_view name,
+                                             ocl_kernel_instance *&out) const {
   if(!_build_status.is_success())
     return _build_status;
-  auto it = _kernel_handles.find(name);
-  if(it == _kernel_handles.end())
+
+  std::lock_guard<std::mutex> lock{_kernel_pool_mutex};
+
+  auto pool = _kernel_pools.find(name);
+  if(pool == _kernel_pools.end())
     return make_error(__acpp_here(),
                       error_info{"ocl_executable_object: Unknown kernel name"});
-  out = it->second;
+
+  if(pool->second.available.empty()) {
+    // All instances are currently used by other submissions
+    result err = create_kernel_instance(pool->first, pool->second);
+    if(!err.is_success())
+      return err;
+  }
+
+  out = pool->second.available.back();
+  pool->second.available.pop_back();
+  return make_success();
+}
+
+void ocl_executable_object::release_kernel(ocl_kernel_instance *kernel) const {
+  std::lock_guard<std::mutex> lock{_kernel_pool_mutex};
+
+  auto pool = _kernel_pools.find(kernel->get_kernel_name());
+  assert(pool != _kernel_pools.end());
+  pool->second.available.push_back(kernel);
+}
+
+result ocl_executable_object::create_kernel_instance(std::string_view name,
+                                                     kernel_pool &pool) const {
+  // Cloning avoids building the kernel from the program again.
+  cl_int err = CL_SUCCESS;
+  cl::Kernel k;
+  cl_kernel cloned_kernel = clCloneKernel(pool.prototype.get(), &err);
+  if(err == CL_SUCCESS) {
+    // Takes ownership of the cloned kernel
+    k = cl::Kernel{cloned_kernel};
+  } else {
+    HIPSYCL_DEBUG_INFO << "ocl_executable_object: clCloneKernel() failed ("
+                       << err << "), constructing new kernel object instead"
+                       << std::endl;
+    // name always refers to an entry of _kernel_names, which is
+    // null-terminated
+    k = cl::Kernel{_program, name.data(), &err};
+    if(err != CL_SUCCESS)
+      return make_error(
+          __acpp_here(),
+          error_info{"ocl_executable_object: Could not construct kernel object",
+                     error_code{"CL", static_cast<int>(err)}});
+  }
+
+  pool.instances.push_back(std::make_unique<ocl_kernel_instance>(k, name));
+  pool.available.push_back(pool.instances.back().get());
   return make_success();
 }
 
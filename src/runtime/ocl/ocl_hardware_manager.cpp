@@ -446,6 +446,9 @@ std::size_t ocl_hardware_context::get_property(device_uint_property prop) const
     return static_cast<std::size_t>(
         info_query<CL_DEVICE_GLOBAL_MEM_SIZE, cl_ulong>(_dev));
     break;
+  case device_uint_property::peak_memory_bandwidth:
+    return 0; // Not exposed by OpenCL
+    break;
   case device_uint_property::max_constant_buffer_size:
     return static_cast<std::size_t>(
         info_query<CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE, cl_ulong>(_dev));
@@ -503,6 +506,9 @@ ocl_hardware_context::get_property(device_uint_list_property prop) const {
 
     return result;
     break;
+  case device_uint_list_property::peer_access_devices:
+    return std::vector<std::size_t>{};
+    break;
   }
   assert(false && "Invalid device property");
   std::terminate();
@@ -561,7 +567,7 @@ void ocl_hardware_context::init_allocator(ocl_hardware_manager *mgr) {
                              "allocations are not possible on that device."
                           << std::endl;
   }
-  _alloc = ocl_allocator{_usm_provider.get()};
+  _alloc = ocl_allocator{_usm_provider.get(), mgr->get_device_id(_dev_id)};
 }
 
 ocl_hardware_manager::ocl_hardware_manager()
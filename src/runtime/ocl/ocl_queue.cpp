@@ -10,6 +10,7 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/runtime/kernel_cache.hpp"
@@ -21,6 +22,7 @@
 #include "hipSYCL/runtime/ocl/ocl_event.hpp"
 #include "hipSYCL/runtime/ocl/ocl_queue.hpp"
 #include "hipSYCL/runtime/ocl/ocl_hardware_manager.hpp"
+#include "hipSYCL/runtime/settings.hpp"
 #include "hipSYCL/common/spin_lock.hpp"
 
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
@@ -38,13 +40,14 @@ namespace rt {
 namespace {
 
 
-result submit_ocl_kernel(cl::Kernel& kernel,
+result submit_ocl_kernel(ocl_kernel_instance& kernel,
                         cl::CommandQueue& queue,
                         const rt::range<3> &group_size,
                         const rt::range<3> &num_groups, void **kernel_args,
                         const std::size_t *arg_sizes, std::size_t num_args,
                         ocl_usm* usm,
                         const hcf_kernel_info *info,
+                        const std::vector<cl::Event>& wait_events,
                         cl::Event* evt_out = nullptr) {
 
   cl_int err = 0;
@@ -53,7 +56,8 @@ result submit_ocl_kernel(cl::Kernel& kernel,
                        << " of size " << arg_sizes[i] << " at " << kernel_args[i]
                        << std::endl;
 
-    err = kernel.setArg(i, static_cast<std::size_t>(arg_sizes[i]), kernel_args[i]);
+    err = kernel.set_argument(i, static_cast<std::size_t>(arg_sizes[i]),
+                              kernel_args[i]);
 
     if(err != CL_SUCCESS) {
       return make_error(
@@ -65,7 +69,7 @@ result submit_ocl_kernel(cl::Kernel& kernel,
 
   // This is necessary for USM pointers, which hipSYCL *always*
   // relies on.
-  err = usm->enable_indirect_usm_access(kernel);
+  err = kernel.enable_indirect_usm_access(usm);
 
   if(err != CL_SUCCESS) {
     return make_error(
@@ -91,8 +95,8 @@ result submit_ocl_kernel(cl::Kernel& kernel,
     }
   }
 
-  err = queue.enqueueNDRangeKernel(kernel, offset, cl_global_size,
-                                   cl_local_size, nullptr, evt_out);
+  err = queue.enqueueNDRangeKernel(kernel.get_kernel(), offset, cl_global_size,
+                                   cl_local_size, &wait_events, evt_out);
 
   if(err != CL_SUCCESS) {
     return make_error(
@@ -119,6 +123,23 @@ ocl_queue::ocl_queue(ocl_hardware_manager* hw_manager, std::size_t device_index)
   cl::Context cl_ctx = dev_ctx->get_cl_context();
 
   cl_int err;
+  _is_out_of_order = false;
+  if(application::get_settings().get<setting::ocl_out_of_order_queues>()) {
+    cl_command_queue_properties supported_props = 0;
+    err = cl_dev.getInfo(CL_DEVICE_QUEUE_ON_HOST_PROPERTIES, &supported_props);
+    if(err == CL_SUCCESS &&
+       (supported_props & CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE)) {
+      props |= CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+      _is_out_of_order = true;
+    } else {
+      HIPSYCL_DEBUG_WARNING
+          << "ocl_queue: Out-of-order queues were requested, but device "
+          << device_index
+          << " does not support them; falling back to in-order queue"
+          << std::endl;
+    }
+  }
+
   _queue = cl::CommandQueue{cl_ctx, cl_dev, props, &err};
   if(err != CL_SUCCESS) {
     register_error(__acpp_here(),
@@ -130,6 +151,27 @@ ocl_queue::ocl_queue(ocl_hardware_manager* hw_manager, std::size_t device_index)
 ocl_queue::~ocl_queue() {}
 
 std::shared_ptr<dag_node_event> ocl_queue::insert_event() {
+  if(_is_out_of_order) {
+    // The rest of the runtime expects events of inorder queues to imply
+    // completion of all operations submitted before. In out-of-order
+    // queues, this only holds for markers.
+    bool is_queue_wide = false;
+    auto evt = _state.get_most_recent_event(is_queue_wide);
+    if(evt && is_queue_wide)
+      return evt;
+
+    cl::Event marker_evt;
+    cl_int err = _queue.enqueueMarkerWithWaitList(nullptr, &marker_evt);
+    if(err != CL_SUCCESS) {
+      register_error(
+            __acpp_here(),
+            error_info{
+                "ocl_queue: enqueueMarkerWithWaitList() failed",
+                error_code{"CL", err}});
+    }
+    return register_submitted_op(marker_evt, true);
+  }
+
   if(!_state.get_most_recent_event()) {
     // Normally, this code path should only be triggered
     // when no work has been submitted to the queue, and so
@@ -163,7 +205,7 @@ std::shared_ptr<dag_node_event> ocl_queue::create_queue_completion_event() {
       this);
 }
 
-result ocl_queue::submit_memcpy(memcpy_operation &op, const dag_node_ptr&) {
+result ocl_queue::submit_memcpy(memcpy_operation &op, const dag_node_ptr& node) {
 
   HIPSYCL_DEBUG_INFO << "ocl_queue: On device "
                      << _hw_manager->get_device_id(_device_index)
@@ -207,12 +249,13 @@ result ocl_queue::submit_memcpy(memcpy_operation &op, const dag_node_ptr&) {
   ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
         _hw_manager->get_device(_device_index));
   ocl_usm* usm = ocl_ctx->get_usm_provider();
+  std::vector<cl::Event> wait_events = get_same_lane_dependencies(node);
 
   if(dimension == 1) {
     
     cl_int err = usm->enqueue_memcpy(_queue, op.dest().get_access_ptr(),
                         op.source().get_access_ptr(),
-                        op.get_num_transferred_bytes(), {}, &evt);
+                        op.get_num_transferred_bytes(), wait_events, &evt);
 
     if(err != CL_SUCCESS) {
       return make_error(
@@ -257,7 +300,7 @@ result ocl_queue::submit_memcpy(memcpy_operation &op, const dag_node_ptr&) {
                    dest_allocation_shape.size() * dest_element_size);
 
         cl_int err = usm->enqueue_memcpy(_queue, current_dest, current_src,
-                                         row_size, {}, &evt);
+                                         row_size, wait_events, &evt);
 
         if(err != CL_SUCCESS) {
           return make_error(
@@ -283,6 +326,8 @@ result ocl_queue::submit_memcpy(memcpy_operation &op, const dag_node_ptr&) {
 
 result ocl_queue::submit_kernel(kernel_operation &op, const dag_node_ptr& node) {
 
+  _kernel_dependencies = get_same_lane_dependencies(node);
+
   rt::backend_kernel_launch_capabilities cap;
   cap.provide_sscp_invoker(&_sscp_invoker);
   
@@ -290,19 +335,20 @@ result ocl_queue::submit_kernel(kernel_operation &op, const dag_node_ptr& node)
   return op.get_launcher().invoke(backend_id::ocl, this, cap, node.get());
 }
 
-result ocl_queue::submit_prefetch(prefetch_operation &op, const dag_node_ptr&) {
+result ocl_queue::submit_prefetch(prefetch_operation &op, const dag_node_ptr& node) {
   ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
         _hw_manager->get_device(_device_index));
   ocl_usm* usm = ocl_ctx->get_usm_provider();
+  std::vector<cl::Event> wait_events = get_same_lane_dependencies(node);
 
   cl::Event evt;
   cl_int err = 0;
   if(op.get_target().is_host()) {
     err = usm->enqueue_prefetch(_queue, op.get_pointer(), op.get_num_bytes(),
-                                CL_MIGRATE_MEM_OBJECT_HOST, {}, &evt);
+                                CL_MIGRATE_MEM_OBJECT_HOST, wait_events, &evt);
   } else {
     err = usm->enqueue_prefetch(_queue, op.get_pointer(), op.get_num_bytes(),
-                                0, {}, &evt);
+                                0, wait_events, &evt);
   }
 
   if(err != CL_SUCCESS) {
@@ -316,14 +362,15 @@ result ocl_queue::submit_prefetch(prefetch_operation &op, const dag_node_ptr&) {
   return make_success();
 }
 
-result ocl_queue::submit_memset(memset_operation& op, const dag_node_ptr&) {
+result ocl_queue::submit_memset(memset_operation& op, const dag_node_ptr& node) {
   ocl_hardware_context *ocl_ctx = static_cast<ocl_hardware_context *>(
         _hw_manager->get_device(_device_index));
   ocl_usm* usm = ocl_ctx->get_usm_provider();
+  std::vector<cl::Event> wait_events = get_same_lane_dependencies(node);
 
   cl::Event evt;
   cl_int err = usm->enqueue_memset(_queue, op.get_pointer(), op.get_pattern(),
-                                   op.get_num_bytes(), {}, &evt);
+                                   op.get_num_bytes(), wait_events, &evt);
   if(err != CL_SUCCESS) {
     return make_error(
           __acpp_here(),
@@ -415,7 +462,8 @@ void* ocl_queue::get_native_type() const {
 }
 
 result ocl_queue::query_status(inorder_queue_status& status) {
-  auto evt = _state.get_most_recent_event();
+  // In out-of-order queues, only markers tell us whether the queue is idle
+  auto evt = _is_out_of_order ? insert_event() : _state.get_most_recent_event();
   if(evt) {
     status = inorder_queue_status{evt->is_complete()};
   } else {
@@ -424,6 +472,46 @@ result ocl_queue::query_status(inorder_queue_status& status) {
   return make_success();
 }
 
+namespace {
+
+struct ocl_completion_callback_data {
+  void (*callback)(void *);
+  void *user_data;
+};
+
+void CL_CALLBACK ocl_completion_callback(cl_event, cl_int, void *data) {
+  auto *callback_data = static_cast<ocl_completion_callback_data *>(data);
+  callback_data->callback(callback_data->user_data);
+  delete callback_data;
+}
+
+}
+
+result ocl_queue::submit_completion_callback(void (*callback)(void *),
+                                             void *user_data) {
+  // Markers complete once all previously submitted operations have
+  // completed, both in in-order and out-of-order queues.
+  cl::Event marker_evt;
+  cl_int err = _queue.enqueueMarkerWithWaitList(nullptr, &marker_evt);
+  if(err != CL_SUCCESS) {
+    return make_error(
+        __acpp_here(),
+        error_info{"ocl_queue: enqueueMarkerWithWaitList() failed",
+                   error_code{"CL", err}});
+  }
+
+  auto *data = new ocl_completion_callback_data{callback, user_data};
+  err = marker_evt.setCallback(CL_COMPLETE, ocl_completion_callback, data);
+  if(err != CL_SUCCESS) {
+    delete data;
+    return make_error(
+        __acpp_here(),
+        error_info{"ocl_queue: clSetEventCallback() failed",
+                   error_code{"CL", err}});
+  }
+  return make_success();
+}
+
 ocl_hardware_manager *ocl_queue::get_hardware_manager() const {
   return _hw_manager;
 }
@@ -472,7 +560,8 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
       kernel_base_config_parameter::compilation_flow,
       compilation_flow::sscp);
   _config.append_base_configuration(
-      kernel_base_config_parameter::hcf_object_id, hcf_object);
+      kernel_base_config_parameter::hcf_object_id,
+      adaptivity_engine.get_code_identity());
   
   for(const auto& flag : kernel_info->get_compilation_flags())
     _config.set_build_flag(flag);
@@ -490,49 +579,75 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
   // TODO: Enable this if we are on Intel
   // config.set_build_flag(kernel_build_flag::spirv_enable_intel_llvm_spirv_options);
 
-  auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_device, dev.get());
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_context, ctx.get());
+  kernel_configuration::id_type binary_configuration_id;
+  kernel_configuration::id_type code_object_configuration_id;
+  auto select_configuration_id = [&](kernel_configuration::id_type binary_id) {
+    binary_configuration_id = binary_id;
+    code_object_configuration_id = binary_id;
+    kernel_configuration::extend_hash(
+        code_object_configuration_id,
+        kernel_base_config_parameter::runtime_device, dev.get());
+    kernel_configuration::extend_hash(
+        code_object_configuration_id,
+        kernel_base_config_parameter::runtime_context, ctx.get());
+  };
+  select_configuration_id(
+      adaptivity_engine.finalize_binary_configuration(_config));
 
  
 
   
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
-    
+  // Returns a self-contained JIT compiler for the currently selected
+  // configuration, which can also be executed on a background thread.
+  auto make_jit_compiler = [&]() {
     std::vector<std::string> kernel_names;
     std::string selected_image_name =
         adaptivity_engine.select_image_and_kernels(&kernel_names);
 
-    // Construct SPIR-V translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
-    
-    // Lower kernels to SPIR-V
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, compiled_image);
-    } else {
-      err = glue::jit::compile(translator.get(),
-        hcf_object, selected_image_name, _config, compiled_image);
-    }
-    
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+    return [=, config = _config](std::string &compiled_image) -> bool {
+      // Construct SPIR-V translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
+        std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
+
+      // Lower kernels to SPIR-V
+      rt::result err;
+      if(kernel_names.size() == 1) {
+        err = glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_configuration_id, compiled_image);
+      } else {
+        err = glue::jit::compile(translator.get(),
+          hcf_object, selected_image_name, config, compiled_image);
+      }
+
+      if(!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      glue::jit::precompilation::record_recipe(
+          binary_configuration_id, backend_id::ocl, hcf_object,
+          selected_image_name, kernel_names, config,
+          kernel_names.size() == 1);
+      return true;
+    };
+  };
+
+  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+    return make_jit_compiler()(compiled_image);
   };
 
   auto code_object_constructor = [&](const std::string& compiled_image) -> code_object* {
+    // The driver-generated binary additionally depends on device and driver
+    kernel_configuration::id_type native_binary_id = binary_configuration_id;
+    kernel_configuration::extend_hash(
+        native_binary_id, kernel_base_config_parameter::runtime_device_name,
+        hw_ctx->get_device_name());
+    kernel_configuration::extend_hash(
+        native_binary_id, kernel_base_config_parameter::runtime_driver_version,
+        hw_ctx->get_driver_version());
+
     ocl_executable_object *exec_obj = new ocl_executable_object{
-        ctx, dev, hcf_object, compiled_image, _config};
+        ctx, dev, hcf_object, compiled_image, _config, native_binary_id};
     result r = exec_obj->get_build_result();
 
     if(!r.is_success()) {
@@ -550,9 +665,24 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id,
-      jit_compiler, code_object_constructor);
+  const code_object *obj = nullptr;
+  if(adaptivity_engine.has_fallback_configuration()) {
+    obj = _kernel_cache->get_or_schedule_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if(!obj) {
+      // The specialized binary is still being compiled; use the less
+      // specialized configuration in the meantime.
+      _config = adaptivity_engine.get_fallback_configuration();
+      select_configuration_id(
+          adaptivity_engine.get_fallback_configuration_id());
+    }
+  }
+
+  if(!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        jit_compiler, code_object_constructor);
 
   if(!obj) {
     return make_error(__acpp_here(),
@@ -566,9 +696,10 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
   }
 
 
-  cl::Kernel kernel;
-  result res = static_cast<const ocl_executable_object *>(obj)->get_kernel(
-      kernel_name, kernel);
+  const ocl_executable_object *exec_obj =
+      static_cast<const ocl_executable_object *>(obj);
+  ocl_kernel_instance* kernel;
+  result res = exec_obj->acquire_kernel(kernel_name, kernel);
   
   if(!res.is_success())
     return res;
@@ -578,10 +709,13 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
 
   cl::Event completion_evt;
   auto submission_err = submit_ocl_kernel(
-      kernel, _queue, group_size, num_groups, _arg_mapper.get_mapped_args(),
+      *kernel, _queue, group_size, num_groups, _arg_mapper.get_mapped_args(),
       const_cast<std::size_t *>(_arg_mapper.get_mapped_arg_sizes()),
       _arg_mapper.get_mapped_num_args(), hw_ctx->get_usm_provider(), kernel_info,
-      &completion_evt);
+      _kernel_dependencies, &completion_evt);
+  // Arguments are captured when the kernel is enqueued, so the kernel
+  // can be reused right away.
+  exec_obj->release_kernel(kernel);
 
   if(!submission_err.is_success())
     return submission_err;
@@ -597,9 +731,35 @@ result ocl_queue::submit_sscp_kernel_from_code_object(
 #endif
 }
 
-void ocl_queue::register_submitted_op(cl::Event evt) {
-  this->_state.set_most_recent_event(std::make_shared<ocl_node_event>(
-      _hw_manager->get_device_id(_device_index), evt));
+std::shared_ptr<dag_node_event>
+ocl_queue::register_submitted_op(cl::Event evt, bool is_queue_wide) {
+  auto node_evt = std::make_shared<ocl_node_event>(
+      _hw_manager->get_device_id(_device_index), evt);
+  this->_state.set_most_recent_event(node_evt,
+                                     is_queue_wide || !_is_out_of_order);
+  return node_evt;
+}
+
+std::vector<cl::Event>
+ocl_queue::get_same_lane_dependencies(const dag_node_ptr &node) const {
+  std::vector<cl::Event> events;
+  if(!_is_out_of_order || !node)
+    return events;
+
+  // Requirements from other lanes are handled by submit_queue_wait_for()
+  // and submit_external_wait_for(), which enqueue barriers.
+  for(const auto& weak_req : node->get_requirements()) {
+    if(auto req = weak_req.lock()) {
+      if (req->get_assigned_execution_lane() ==
+              static_cast<const inorder_queue *>(this) &&
+          !req->is_known_complete()) {
+        auto *req_evt = static_cast<inorder_queue_event<cl::Event> *>(
+            req->get_event().get());
+        events.push_back(req_evt->request_backend_event());
+      }
+    }
+  }
+  return events;
 }
 
 }
@@ -8,20 +8,32 @@
  * See file LICENSE in the project root for full license details.
  */
 // SPDX-License-Identifier: BSD-2-Clause
+#include <cstdint>
 #include <cstdlib>
+#include <mutex>
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/omp/omp_allocator.hpp"
+#include "hipSYCL/runtime/omp/omp_numa.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
 #include "hipSYCL/runtime/util.hpp"
 
 namespace hipsycl {
 namespace rt {
 
-omp_allocator::omp_allocator(const device_id &my_device)
-    : _my_device{my_device} {}
+namespace {
 
-void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+// Allocations smaller than this are not distributed across NUMA nodes
+constexpr std::size_t numa_first_touch_min_size = 1024 * 1024;
+
+void *allocate_host_memory(size_t min_alignment, size_t size_bytes) {
 #if !defined(_WIN32)
   // posix requires alignment to be a multiple of sizeof(void*)
   if (min_alignment < sizeof(void*))
@@ -50,13 +62,162 @@ void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
 #endif
 }
 
+// Allocations of at least this size are mapped with mmap() if huge pages
+// or pinned memory are enabled, such that they can use huge pages
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+constexpr std::size_t huge_page_1g_size = 1024 * 1024 * 1024;
+
+#if !defined(_WIN32)
+void *map_anonymous(std::size_t size_bytes, int extra_flags) {
+  void *ptr = mmap(nullptr, size_bytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  return ptr == MAP_FAILED ? nullptr : ptr;
+}
+
+// Maps memory aligned to huge_page_size, such that the kernel can back it
+// with transparent huge pages
+void *map_huge_page_aligned(std::size_t size_bytes, std::size_t &mapped_size) {
+  mapped_size = next_multiple_of(size_bytes, huge_page_size);
+  char *ptr = static_cast<char *>(
+      map_anonymous(mapped_size + huge_page_size, 0));
+  if (!ptr)
+    return nullptr;
+
+  char *aligned = reinterpret_cast<char *>(next_multiple_of(
+      reinterpret_cast<std::uint64_t>(ptr), huge_page_size));
+  if (aligned != ptr)
+    munmap(ptr, aligned - ptr);
+  munmap(aligned + mapped_size, huge_page_size - (aligned - ptr));
+  return aligned;
+}
+
+void *map_large_allocation(std::size_t size_bytes, omp_huge_page_policy policy,
+                           std::size_t &mapped_size) {
+#ifdef MAP_HUGETLB
+  if (policy == omp_huge_page_policy::hugetlb_2m ||
+      policy == omp_huge_page_policy::hugetlb_1g) {
+    std::size_t page_size = huge_page_size;
+    int flags = MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+    if (policy == omp_huge_page_policy::hugetlb_1g) {
+      page_size = huge_page_1g_size;
+      flags |= 30 << MAP_HUGE_SHIFT;
+    } else {
+      flags |= 21 << MAP_HUGE_SHIFT;
+    }
+#endif
+    mapped_size = next_multiple_of(size_bytes, page_size);
+    if (void *ptr = map_anonymous(mapped_size, flags))
+      return ptr;
+
+    static std::once_flag warning_flag;
+    std::call_once(warning_flag, []() {
+      HIPSYCL_DEBUG_WARNING
+          << "omp_allocator: Could not map memory from hugetlbfs, falling "
+             "back to transparent huge pages. Are huge pages reserved (e.g. "
+             "in /proc/sys/vm/nr_hugepages)?"
+          << std::endl;
+    });
+  }
+#endif
+
+  void *ptr = map_huge_page_aligned(size_bytes, mapped_size);
+#ifdef MADV_HUGEPAGE
+  if (ptr && policy != omp_huge_page_policy::none)
+    madvise(ptr, mapped_size, MADV_HUGEPAGE);
+#endif
+  return ptr;
+}
+#endif
+
+}
+
+omp_allocator::omp_allocator(const device_id &my_device,
+                             std::vector<int> bound_cpus)
+    : _my_device{my_device}, _bound_cpus{std::move(bound_cpus)} {
+  _huge_page_policy =
+      application::get_settings().get<setting::omp_huge_pages>();
+  _use_pinned_memory =
+      application::get_settings().get<setting::omp_pinned_memory>();
+}
+
+void *omp_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+  bool is_mapped = false;
+  std::size_t mapped_size = 0;
+  void *ptr = nullptr;
+#if !defined(_WIN32)
+  // Memory mappings are aligned to at least the huge page size
+  if ((_huge_page_policy != omp_huge_page_policy::none || _use_pinned_memory) &&
+      size_bytes >= huge_page_size && min_alignment <= huge_page_size) {
+    ptr = map_large_allocation(size_bytes, _huge_page_policy, mapped_size);
+    is_mapped = ptr != nullptr;
+  }
+#endif
+  if (!is_mapped)
+    ptr = allocate_host_memory(min_alignment, size_bytes);
+
+  runtime_statistics::get().register_allocation(
+      ptr, size_bytes, _my_device, allocation_kind::device);
+  if (!ptr)
+    return ptr;
+
+  if (is_mapped) {
+    std::lock_guard<std::mutex> lock{_mapped_allocations_mutex};
+    _mapped_allocations[ptr] = mapped_size;
+  }
+
+  if (size_bytes >= numa_first_touch_min_size)
+    place_pages(ptr, size_bytes);
+
+#if !defined(_WIN32)
+  // Only after first touch, since locking faults in all pages on this thread
+  if (is_mapped && _use_pinned_memory && mlock(ptr, mapped_size) != 0) {
+    static std::once_flag warning_flag;
+    std::call_once(warning_flag, []() {
+      HIPSYCL_DEBUG_WARNING
+          << "omp_allocator: Could not lock allocation in memory, it might "
+             "exceed RLIMIT_MEMLOCK (see ulimit -l)"
+          << std::endl;
+    });
+  }
+#endif
+  return ptr;
+}
+
+void omp_allocator::place_pages(void *ptr, size_t size_bytes) const {
+
+  if (!_bound_cpus.empty()) {
+    // Memory of NUMA sub-devices is always placed on their own node
+    omp_numa_first_touch(ptr, size_bytes, _bound_cpus,
+                         static_cast<int>(_bound_cpus.size()));
+  } else if (is_omp_numa_mode_enabled()) {
+    // In NUMA mode, place pages on the nodes of the threads that will
+    // process them in kernels.
+    omp_numa_first_touch(ptr, size_bytes,
+                         omp_numa_topology::get().get_ordered_cpus());
+  }
+}
+
 void *omp_allocator::allocate_optimized_host(size_t min_alignment,
                                              size_t bytes) {
   return this->allocate(min_alignment, bytes);
 };
 
 void omp_allocator::free(void *mem) {
+  runtime_statistics::get().register_deallocation(mem);
 #if !defined(_WIN32)
+  if (_huge_page_policy != omp_huge_page_policy::none || _use_pinned_memory) {
+    std::unique_lock<std::mutex> lock{_mapped_allocations_mutex};
+    auto it = _mapped_allocations.find(mem);
+    if (it != _mapped_allocations.end()) {
+      std::size_t mapped_size = it->second;
+      _mapped_allocations.erase(it);
+      lock.unlock();
+      // Also unlocks pinned memory
+      munmap(mem, mapped_size);
+      return;
+    }
+  }
   std::free(mem);
 #else
   _aligned_free(mem);
@@ -92,5 +253,15 @@ result omp_allocator::mem_advise(const void *addr, std::size_t num_bytes,
   return make_success();
 }
 
+bool omp_allocator::can_alias_host_memory(const void *ptr,
+                                          size_t min_alignment) const {
+  // Host memory is directly accessible by the OpenMP backend, so
+  // it can be used whenever it satisfies the alignment requirement.
+  if(!ptr)
+    return false;
+  return min_alignment <= 1 ||
+         reinterpret_cast<std::uintptr_t>(ptr) % min_alignment == 0;
+}
+
 }
 }
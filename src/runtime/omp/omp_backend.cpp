@@ -16,6 +16,13 @@
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/multi_queue_executor.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/host/LLVMToHostFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
+
 #include <memory>
 
 
@@ -38,26 +45,58 @@ namespace rt {
 
 namespace {
 
-std::unique_ptr<inorder_queue> make_omp_queue(device_id dev) {
-  return std::make_unique<omp_queue>(dev.get_backend());
+void register_jit_recipe_compiler() {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  kernel_cache::get()->register_jit_recipe_compiler(
+      backend_id::omp,
+      [](const common::db::jit_recipe &recipe,
+         kernel_cache::code_object_id id_of_binary, std::string &out) {
+        std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+            compiler::createLLVMToHostTranslator(recipe.kernels);
+        return glue::jit::precompilation::compile(
+                   translator.get(), recipe, id_of_binary, out)
+            .is_success();
+      });
+#endif
+}
+
+std::vector<int> get_bound_cpus(omp_hardware_manager &hw, device_id dev) {
+  auto *ctx =
+      static_cast<omp_hardware_context *>(hw.get_device(dev.get_id()));
+  if(!ctx)
+    return {};
+  return ctx->get_bound_cpus();
+}
+
+std::unique_ptr<inorder_queue> make_omp_queue(omp_hardware_manager &hw,
+                                              device_id dev) {
+  return std::make_unique<omp_queue>(dev, get_bound_cpus(hw, dev));
 }
 
 std::unique_ptr<multi_queue_executor>
-create_multi_queue_executor(omp_backend *b) {
-  return std::make_unique<multi_queue_executor>(*b, [](device_id dev) {
-    return make_omp_queue(dev);
-  });
+create_multi_queue_executor(omp_backend *b, omp_hardware_manager &hw) {
+  // Queue priorities are not supported
+  return std::make_unique<multi_queue_executor>(
+      *b,
+      [&hw](device_id dev, int) { return make_omp_queue(hw, dev); },
+      false, false,
+      application::get_settings().get<setting::host_task_lanes>());
 }
 
 }
 
 omp_backend::omp_backend()
-    : _allocator{device_id{
-          backend_descriptor{omp_backend::get_hardware_platform(), omp_backend::get_api_platform()}, 0}},
-      _hw{},
+    : _hw{},
       _executor([this](){
-        return create_multi_queue_executor(this);
-      }) {}
+        return create_multi_queue_executor(this, _hw);
+      }) {
+  for(std::size_t i = 0; i < _hw.get_num_device_indices(); ++i) {
+    device_id dev = _hw.get_device_id(i);
+    _allocators.emplace_back(
+        std::make_unique<omp_allocator>(dev, get_bound_cpus(_hw, dev)));
+  }
+  register_jit_recipe_compiler();
+}
 
 api_platform omp_backend::get_api_platform() const {
   return api_platform::omp;
@@ -93,7 +132,15 @@ backend_allocator* omp_backend::get_allocator(device_id dev) const {
                               error_type::invalid_parameter_error});
     return nullptr;
   }
-  return &_allocator;
+  if(static_cast<std::size_t>(dev.get_id()) >= _allocators.size()) {
+    register_error(__acpp_here(),
+                   error_info{"omp_backend: Requested device " +
+                                  std::to_string(dev.get_id()) +
+                                  " does not exist.",
+                              error_type::invalid_parameter_error});
+    return nullptr;
+  }
+  return _allocators[dev.get_id()].get();
 }
 
 std::string omp_backend::get_name() const {
@@ -21,6 +21,7 @@
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/compiler/llvm-to-backend/host/HostObjectLoader.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/dylib_loader.hpp"
@@ -68,6 +69,9 @@ omp_sscp_executable_object::omp_sscp_executable_object(
 }
 
 omp_sscp_executable_object::~omp_sscp_executable_object() {
+  // Relocatable objects are not written to a file
+  if (_relocatable_object)
+    return;
   if (_module)
     detail::close_library(_module, "omp_sscp_executable");
   if(!common::filesystem::remove(_kernel_cache_path)) {
@@ -81,7 +85,8 @@ result omp_sscp_executable_object::get_build_result() const {
 }
 
 code_object_state omp_sscp_executable_object::state() const {
-  return _module ? code_object_state::executable : code_object_state::invalid;
+  return (_module || _relocatable_object) ? code_object_state::executable
+                                          : code_object_state::invalid;
 }
 
 code_format omp_sscp_executable_object::format() const {
@@ -107,28 +112,46 @@ omp_sscp_executable_object::supported_backend_kernel_names() const {
   return _kernel_names;
 }
 
-void *omp_sscp_executable_object::get_module() const { return _module; }
+void *omp_sscp_executable_object::get_module() const {
+  if (_relocatable_object)
+    return _relocatable_object.get();
+  return _module;
+}
 
 result omp_sscp_executable_object::build(
     const std::string &source, const std::vector<std::string> &kernel_names) {
     
-  if (_module != nullptr)
+  if (_module != nullptr || _relocatable_object)
     return make_success();
 
-  if (auto result = make_shared_library_from_blob(_module, source, _kernel_cache_path);
-      !result.is_success())
+  if (compiler::isHostRelocatableObject(source)) {
+    std::string error;
+    _relocatable_object = compiler::loadHostObject(source, error);
+    if (!_relocatable_object)
+      return make_error(__acpp_here(),
+                        error_info{"omp_sscp_executable_object: could not load "
+                                   "relocatable kernel object: " + error});
+  } else if (auto result = make_shared_library_from_blob(_module, source,
+                                                         _kernel_cache_path);
+             !result.is_success())
     return result;
 
+  auto get_symbol = [&](const std::string &name) -> void * {
+    if (_relocatable_object)
+      return _relocatable_object->getSymbolAddress(name);
+    return detail::get_symbol_from_library(_module, name,
+                                           "omp_sscp_exectuable_object");
+  };
+
   _kernel_names = kernel_names;
   // find all kernel symbols
   for (const auto &kernel_name : _kernel_names) {
-    if (auto kernel = (omp_sscp_kernel *)detail::get_symbol_from_library(
-            _module, kernel_name, "omp_sscp_exectuable_object")) {
+    if (auto kernel = (omp_sscp_kernel *)get_symbol(kernel_name)) {
       _kernels.emplace(kernel_name, kernel);
     } else {
       return make_error(__acpp_here(),
                         error_info{"omp_sscp_executable_object: could not load "
-                                   "kernel from shared library"});
+                                   "kernel " + kernel_name});
     }
   }
   return make_success();
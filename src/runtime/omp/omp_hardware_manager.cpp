@@ -9,15 +9,86 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include <omp.h>
+#include <chrono>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <new>
 
 #include "hipSYCL/runtime/omp/omp_hardware_manager.hpp"
+#include "hipSYCL/runtime/omp/omp_numa.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+namespace {
+
+// The host does not expose the theoretical peak bandwidth of its memory, so
+// we measure the bandwidth of a parallel copy instead. Each byte is read and
+// written once. Returns 0 if the measurement fails.
+std::size_t measure_host_memory_bandwidth() {
+  // Large enough to not fit into last level caches
+  constexpr std::size_t num_bytes = 128 * 1024 * 1024;
+  constexpr int num_repetitions = 5;
+
+  std::unique_ptr<char[]> src{new (std::nothrow) char[num_bytes]};
+  std::unique_ptr<char[]> dest{new (std::nothrow) char[num_bytes]};
+  if(!src || !dest)
+    return 0;
+
+  const int num_threads = omp_get_max_threads();
+  const std::size_t chunk_size = num_bytes / num_threads;
+  auto for_each_chunk = [&](auto f) {
+#pragma omp parallel num_threads(num_threads)
+    {
+      int tid = omp_get_thread_num();
+      std::size_t begin = tid * chunk_size;
+      std::size_t end = (tid == num_threads - 1) ? num_bytes : begin + chunk_size;
+      f(begin, end);
+    }
+  };
+
+  // Touch pages from the threads that copy them
+  for_each_chunk([&](std::size_t begin, std::size_t end) {
+    std::memset(src.get() + begin, 1, end - begin);
+    std::memset(dest.get() + begin, 0, end - begin);
+  });
+
+  double best_time = 0.0;
+  for(int i = 0; i < num_repetitions; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    for_each_chunk([&](std::size_t begin, std::size_t end) {
+      std::memcpy(dest.get() + begin, src.get() + begin, end - begin);
+    });
+    double time = std::chrono::duration<double>(
+                      std::chrono::steady_clock::now() - start).count();
+    if(i == 0 || time < best_time)
+      best_time = time;
+  }
+
+  if(best_time <= 0.0)
+    return 0;
+  return static_cast<std::size_t>(2.0 * num_bytes / best_time);
+}
+
+// Measured once for the whole host; sub-devices share its memory system.
+std::size_t get_host_memory_bandwidth() {
+  static const std::size_t bandwidth = measure_host_memory_bandwidth();
+  return bandwidth;
+}
+
+}
+
+omp_hardware_context::omp_hardware_context(std::size_t num_sub_devices)
+    : _is_sub_device{false}, _numa_node{0},
+      _num_sub_devices{num_sub_devices} {}
+
+omp_hardware_context::omp_hardware_context(std::size_t numa_node,
+                                           const std::vector<int> &cpus)
+    : _is_sub_device{true}, _numa_node{numa_node}, _num_sub_devices{0},
+      _bound_cpus{cpus} {}
 
 bool omp_hardware_context::is_cpu() const {
   return true;
@@ -37,6 +108,9 @@ std::size_t omp_hardware_context::get_max_memcpy_concurrency() const {
 }
 
 std::string omp_hardware_context::get_device_name() const {
+  if(_is_sub_device)
+    return "hipSYCL OpenMP host device (NUMA node " +
+           std::to_string(_numa_node) + ")";
   return "hipSYCL OpenMP host device";
 }
 
@@ -122,6 +196,8 @@ std::size_t
 omp_hardware_context::get_property(device_uint_property prop) const {
   switch (prop) {
   case device_uint_property::max_compute_units:
+    if(_is_sub_device)
+      return _bound_cpus.size();
     return omp_get_num_procs();
     break;
   case device_uint_property::max_global_size0:
@@ -247,6 +323,9 @@ omp_hardware_context::get_property(device_uint_property prop) const {
   case device_uint_property::global_mem_size:
     return std::numeric_limits<std::size_t>::max(); // TODO
     break;
+  case device_uint_property::peak_memory_bandwidth:
+    return get_host_memory_bandwidth();
+    break;
   case device_uint_property::max_constant_buffer_size:
     return std::numeric_limits<std::size_t>::max();
     break;
@@ -260,7 +339,7 @@ omp_hardware_context::get_property(device_uint_property prop) const {
     return std::numeric_limits<std::size_t>::max();
     break;
   case device_uint_property::partition_max_sub_devices:
-    return 0;
+    return _num_sub_devices;
     break;
   case device_uint_property::vendor_id:
     return std::numeric_limits<std::size_t>::max();
@@ -276,6 +355,9 @@ std::vector<std::size_t> omp_hardware_context::get_property(device_uint_list_pro
   case device_uint_list_property::sub_group_sizes:
     return std::vector<std::size_t>{1};
     break;
+  case device_uint_list_property::peer_access_devices:
+    return std::vector<std::size_t>{};
+    break;
   }
   assert(false && "Invalid device property");
   std::terminate();
@@ -287,11 +369,21 @@ std::string omp_hardware_context::get_profile() const {
   return "FULL_PROFILE";
 }
 
-std::size_t omp_hardware_manager::get_num_devices() const { return 1; }
+omp_hardware_manager::omp_hardware_manager() {
+  const omp_numa_topology& topology = omp_numa_topology::get();
+  // Partitioning is only meaningful if there are multiple NUMA nodes
+  const std::size_t num_sub_devices =
+      topology.get_num_nodes() > 1 ? topology.get_num_nodes() : 0;
+
+  _devices.emplace_back(num_sub_devices);
+  for(std::size_t node = 0; node < num_sub_devices; ++node)
+    _devices.emplace_back(node, topology.get_cpus(node));
+}
 
+std::size_t omp_hardware_manager::get_num_devices() const { return 1; }
 
 hardware_context* omp_hardware_manager::get_device(std::size_t index) {
-  if(index != 0) {
+  if(index >= _devices.size()) {
     register_error(__acpp_here(),
                    error_info{"omp_hardware_manager: Requested device " +
                                   std::to_string(index) + " does not exist.",
@@ -299,7 +391,7 @@ hardware_context* omp_hardware_manager::get_device(std::size_t index) {
     return nullptr;
   }
 
-  return &_device;
+  return &_devices[index];
 }
 
 device_id omp_hardware_manager::get_device_id(std::size_t index) const {
@@ -308,6 +400,22 @@ device_id omp_hardware_manager::get_device_id(std::size_t index) const {
       static_cast<int>(index)};
 }
 
+std::size_t omp_hardware_manager::get_num_device_indices() const {
+  return _devices.size();
+}
+
+std::vector<std::size_t>
+omp_hardware_manager::get_sub_devices(std::size_t index) const {
+  std::vector<std::size_t> result;
+  if(index == 0)
+    for(std::size_t i = 1; i < _devices.size(); ++i)
+      result.push_back(i);
+  return result;
+}
+
+std::size_t omp_hardware_manager::get_parent_device(std::size_t index) const {
+  return 0;
+}
 
 }
 }
@@ -0,0 +1,209 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/omp/omp_numa.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+std::size_t get_page_size() {
+#ifdef __linux__
+  long page_size = sysconf(_SC_PAGESIZE);
+  if(page_size > 0)
+    return static_cast<std::size_t>(page_size);
+#endif
+  return 4096;
+}
+
+#ifdef __linux__
+// Parses CPU lists of the form "0-3,8,10-11"
+std::vector<int> parse_cpu_list(const std::string& list) {
+  std::vector<int> cpus;
+  std::stringstream sstr{list};
+  std::string entry;
+  while(std::getline(sstr, entry, ',')) {
+    if(entry.empty() || entry == "\n")
+      continue;
+    auto dash = entry.find('-');
+    try {
+      if(dash == std::string::npos) {
+        cpus.push_back(std::stoi(entry));
+      } else {
+        int first = std::stoi(entry.substr(0, dash));
+        int last = std::stoi(entry.substr(dash + 1));
+        for(int i = first; i <= last; ++i)
+          cpus.push_back(i);
+      }
+    } catch(...) {
+      HIPSYCL_DEBUG_WARNING << "omp_numa: Could not parse CPU list entry "
+                            << entry << std::endl;
+    }
+  }
+  return cpus;
+}
+#endif
+
+}
+
+omp_numa_topology::omp_numa_topology() {
+#ifdef __linux__
+  cpu_set_t allowed_cpus;
+  CPU_ZERO(&allowed_cpus);
+  bool has_affinity =
+      sched_getaffinity(0, sizeof(allowed_cpus), &allowed_cpus) == 0;
+
+  auto is_allowed = [&](int cpu) {
+    return !has_affinity || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed_cpus));
+  };
+
+  for(int node = 0;; ++node) {
+    std::ifstream file{"/sys/devices/system/node/node" + std::to_string(node) +
+                       "/cpulist"};
+    if(!file.is_open())
+      break;
+    std::string list;
+    std::getline(file, list);
+
+    std::vector<int> cpus;
+    for(int cpu : parse_cpu_list(list))
+      if(is_allowed(cpu))
+        cpus.push_back(cpu);
+    // Skip memory-only nodes and nodes we may not run on
+    if(!cpus.empty())
+      _node_cpus.push_back(cpus);
+  }
+
+  if(_node_cpus.empty()) {
+    std::vector<int> cpus;
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+      if(has_affinity && CPU_ISSET(cpu, &allowed_cpus))
+        cpus.push_back(cpu);
+    if(!cpus.empty())
+      _node_cpus.push_back(cpus);
+  }
+#endif
+  if(_node_cpus.empty()) {
+    std::vector<int> cpus;
+    for(int cpu = 0; cpu < static_cast<int>(std::max(
+                               std::thread::hardware_concurrency(), 1u));
+        ++cpu)
+      cpus.push_back(cpu);
+    _node_cpus.push_back(cpus);
+  }
+
+  for(const auto& cpus : _node_cpus)
+    _ordered_cpus.insert(_ordered_cpus.end(), cpus.begin(), cpus.end());
+
+  HIPSYCL_DEBUG_INFO << "omp_numa: Found " << _node_cpus.size()
+                     << " NUMA node(s) with " << _ordered_cpus.size()
+                     << " CPUs" << std::endl;
+}
+
+const omp_numa_topology& omp_numa_topology::get() {
+  static omp_numa_topology topology;
+  return topology;
+}
+
+bool is_omp_numa_mode_enabled() {
+  static const bool is_enabled =
+      application::get_settings().get<setting::omp_numa_mode>();
+  return is_enabled;
+}
+
+bool omp_pin_current_thread(int cpu) {
+#ifdef __linux__
+  if(cpu < 0 || cpu >= CPU_SETSIZE)
+    return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+void omp_numa_pin_team(const std::vector<int> &cpus, bool pin_master) {
+  if(cpus.empty())
+    return;
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+    int tid = omp_get_thread_num();
+    if(tid != 0 || pin_master)
+      omp_pin_current_thread(cpus[tid % cpus.size()]);
+  }
+#else
+  if(pin_master)
+    omp_pin_current_thread(cpus[0]);
+#endif
+}
+
+void omp_numa_first_touch(void *ptr, std::size_t bytes,
+                          const std::vector<int> &cpus, int num_threads) {
+  if(!ptr || bytes == 0 || cpus.empty())
+    return;
+
+  const std::size_t page_size = get_page_size();
+  const std::size_t num_pages = (bytes + page_size - 1) / page_size;
+  char* data = static_cast<char*>(ptr);
+
+#if defined(__linux__) && defined(_OPENMP)
+  // The calling thread is the master thread of the team used to touch
+  // pages. Pin it only temporarily, since it is a user thread.
+  cpu_set_t original_affinity;
+  bool has_original_affinity =
+      sched_getaffinity(0, sizeof(original_affinity), &original_affinity) == 0;
+
+  if(num_threads <= 0)
+    num_threads = omp_get_max_threads();
+
+#pragma omp parallel num_threads(num_threads)
+  {
+    int tid = omp_get_thread_num();
+    omp_pin_current_thread(cpus[tid % cpus.size()]);
+
+    // Must use the same static schedule as kernels
+#pragma omp for schedule(static)
+    for(std::size_t page = 0; page < num_pages; ++page)
+      data[page * page_size] = 0;
+  }
+
+  if(has_original_affinity)
+    sched_setaffinity(0, sizeof(original_affinity), &original_affinity);
+#else
+  for(std::size_t page = 0; page < num_pages; ++page)
+    data[page * page_size] = 0;
+#endif
+}
+
+}
+}
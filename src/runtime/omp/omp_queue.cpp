@@ -9,6 +9,8 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/omp/omp_queue.hpp"
+#include "hipSYCL/runtime/omp/omp_numa.hpp"
+#include "hipSYCL/runtime/omp/omp_schedule.hpp"
 
 #include "hipSYCL/common/debug.hpp"
 #include "hipSYCL/common/spin_lock.hpp"
@@ -16,6 +18,7 @@
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/event.hpp"
 #include "hipSYCL/runtime/generic/async_worker.hpp"
+#include "hipSYCL/runtime/generic/object_pool.hpp"
 #include "hipSYCL/runtime/hints.hpp"
 #include "hipSYCL/runtime/inorder_queue.hpp"
 #include "hipSYCL/runtime/instrumentation.hpp"
@@ -23,6 +26,7 @@
 #include "hipSYCL/runtime/omp/omp_event.hpp"
 #include "hipSYCL/runtime/operations.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
+#include "hipSYCL/runtime/settings.hpp"
 #include "hipSYCL/runtime/signal_channel.hpp"
 #include "hipSYCL/runtime/util.hpp"
 
@@ -42,6 +46,7 @@
 
 #include <omp.h>
 
+#include <chrono>
 #include <memory>
 
 namespace hipsycl {
@@ -49,6 +54,17 @@ namespace rt {
 
 namespace {
 
+// The kernel that is currently launched by the calling thread, since SSCP
+// kernel launches do not have access to its dag node
+struct omp_kernel_launch_context {
+  const dag_node* node = nullptr;
+  // Set while a kernel is executed on the submitting thread instead of the
+  // worker thread of the queue
+  bool is_inline = false;
+};
+
+thread_local omp_kernel_launch_context current_launch;
+
 bool is_contigous(id<3> offset, range<3> r, range<3> allocation_shape) {
   if (r.size() == 0)
     return true;
@@ -185,11 +201,41 @@ std::size_t get_page_size() {
 #endif
 }
 
+// Sub-group size that maps one sub-group onto the SIMD lanes of a vector
+// register of 32-bit elements.
+std::size_t get_native_sub_group_size() {
+#if defined(__x86_64__) || defined(__i386__)
+  if(__builtin_cpu_supports("avx512f"))
+    return 16;
+  if(__builtin_cpu_supports("avx2"))
+    return 8;
+#endif
+  return 4;
+}
+
+std::size_t get_sscp_sub_group_size() {
+  static const std::size_t sub_group_size = []() -> std::size_t {
+    std::size_t size =
+        application::get_settings().get<setting::omp_sscp_sub_group_size>();
+    if(size == 0)
+      size = get_native_sub_group_size();
+    HIPSYCL_DEBUG_INFO << "omp_queue: Using sub-group size " << size
+                       << " for SSCP kernels" << std::endl;
+    return size;
+  }();
+  return sub_group_size;
+}
+
+// The sub-group builtins of the host backend exchange data through a buffer
+// of a fixed number of work items.
+constexpr std::size_t max_sub_group_exchange_size = 1024;
+
 result
 launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
                       const rt::range<3> &num_groups,
                       const rt::range<3> &local_size, unsigned shared_memory,
-                      void **kernel_args) {
+                      void **kernel_args, bool is_sequential,
+                      const omp_loop_schedule &schedule) {
   if (num_groups.size() == 1 && shared_memory == 0) {
     omp_sscp_executable_object::work_group_info info{
         num_groups, rt::id<3>{0, 0, 0}, local_size, nullptr};
@@ -203,8 +249,11 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
                         << std::endl;
 #endif
 
+  omp_thread_timings timings;
+  const std::size_t dynamic_chunk_size = schedule.dynamic_chunk_size;
+
 #ifdef _OPENMP
-#pragma omp parallel
+#pragma omp parallel if(!is_sequential)
 #endif
   {
     // get page aligned local memory from heap
@@ -214,34 +263,70 @@ launch_kernel_from_so(omp_sscp_executable_object::omp_sscp_kernel *kernel,
     local_memory.resize(shared_memory + page_size);
     auto aligned_local_memory = reinterpret_cast<void*>(next_multiple_of(reinterpret_cast<std::uint64_t>(local_memory.data()), page_size));
 
+    auto run_group = [&](std::size_t i, std::size_t j, std::size_t k) {
+      omp_sscp_executable_object::work_group_info info{
+          num_groups, rt::id<3>{i, j, k}, local_size, aligned_local_memory};
+      kernel(&info, kernel_args);
+    };
+
+    if (dynamic_chunk_size > 0) {
 #ifdef _OPENMP
-#pragma omp for collapse(3)
+#pragma omp for collapse(3) schedule(dynamic, dynamic_chunk_size)
 #endif
-    for (std::size_t k = 0; k < num_groups.get(2); ++k) {
-      for (std::size_t j = 0; j < num_groups.get(1); ++j) {
-        for (std::size_t i = 0; i < num_groups.get(0); ++i) {
-          omp_sscp_executable_object::work_group_info info{
-              num_groups, rt::id<3>{i, j, k}, local_size, aligned_local_memory};
-          kernel(&info, kernel_args);
-        }
-      }
+      for (std::size_t k = 0; k < num_groups.get(2); ++k)
+        for (std::size_t j = 0; j < num_groups.get(1); ++j)
+          for (std::size_t i = 0; i < num_groups.get(0); ++i)
+            run_group(i, j, k);
+    } else {
+      auto start = std::chrono::steady_clock::now();
+      // The end of the parallel region synchronizes the threads anyway
+#ifdef _OPENMP
+#pragma omp for collapse(3) schedule(static) nowait
+#endif
+      for (std::size_t k = 0; k < num_groups.get(2); ++k)
+        for (std::size_t j = 0; j < num_groups.get(1); ++j)
+          for (std::size_t i = 0; i < num_groups.get(0); ++i)
+            run_group(i, j, k);
+      if (schedule.selector)
+        timings.add(std::chrono::steady_clock::now() - start);
     }
   }
+  if (schedule.selector)
+    schedule.selector->record(timings);
   return make_success();
 }
 #endif
 } // namespace
 
-omp_queue::omp_queue(backend_id id)
-    : _backend_id(id), _sscp_code_object_invoker{this},
-      _kernel_cache{kernel_cache::get()} {}
+omp_queue::omp_queue(device_id dev, std::vector<int> bound_cpus)
+    : _backend_id(dev.get_backend()), _device{dev},
+      _sscp_code_object_invoker{this}, _kernel_cache{kernel_cache::get()} {
+  _inline_kernel_max_work_items =
+      application::get_settings()
+          .get<setting::omp_inline_kernel_max_work_items>();
+  if(!bound_cpus.empty()) {
+    // Queues of NUMA sub-devices only run kernels on the CPUs of their node
+    _worker([cpus = std::move(bound_cpus)]() {
+      omp_set_num_threads(static_cast<int>(cpus.size()));
+      omp_numa_pin_team(cpus, true);
+    });
+  } else if(is_omp_numa_mode_enabled()) {
+    // In NUMA mode, the OpenMP team of this queue's worker thread is bound to
+    // CPUs in node order, so that the static schedule of kernels matches
+    // the page placement established by first touch in omp_allocator.
+    _worker([]() {
+      omp_numa_pin_team(omp_numa_topology::get().get_ordered_cpus(), true);
+    });
+  }
+}
 
 omp_queue::~omp_queue() { _worker.halt(); }
 
 std::shared_ptr<dag_node_event> omp_queue::insert_event() {
   HIPSYCL_DEBUG_INFO << "omp_queue: Inserting event into queue..." << std::endl;
 
-  auto evt = std::make_shared<omp_node_event>();
+  auto evt = std::allocate_shared<omp_node_event>(
+      object_pool_allocator<omp_node_event>{});
   auto signal_channel = evt->get_signal_channel();
 
   _worker([signal_channel] { signal_channel->signal(); });
@@ -367,10 +452,27 @@ result omp_queue::submit_kernel(kernel_operation &op, const dag_node_ptr& node)
   rt::dag_node* node_ptr = node.get();
 
   omp_instrumentation_setup instrumentation_setup{op, node};
+
+  if(can_execute_inline(op)) {
+    HIPSYCL_DEBUG_INFO << "omp_queue: Executing kernel on submitting thread"
+                       << std::endl;
+    result err = make_success();
+    {
+      auto instrumentation_guard = instrumentation_setup.instrument_task();
+
+      current_launch = omp_kernel_launch_context{node_ptr, true};
+      err = op.get_launcher().invoke(backend_id, params, cap, node_ptr);
+      current_launch = omp_kernel_launch_context{};
+    }
+    return err;
+  }
+
   _worker([=, &op]() {
     auto instrumentation_guard = instrumentation_setup.instrument_task();
 
+    current_launch = omp_kernel_launch_context{node_ptr, false};
     auto err = op.get_launcher().invoke(backend_id, params, cap, node_ptr);
+    current_launch = omp_kernel_launch_context{};
     if(!err.is_success())
       rt::register_error(err);
   });
@@ -378,6 +480,22 @@ result omp_queue::submit_kernel(kernel_operation &op, const dag_node_ptr& node)
   return make_success();
 }
 
+bool omp_queue::can_execute_inline(const kernel_operation& op) const {
+  if(_inline_kernel_max_work_items == 0)
+    return false;
+
+  const auto &launch_data = op.get_launcher().get_static_data();
+  // Only SSCP kernels provide their launch configuration at this point.
+  // Custom operations might block, e.g. waiting for other operations.
+  if (!launch_data.sscp_kernel_id || launch_data.custom_op ||
+      launch_data.global_size.size() > _inline_kernel_max_work_items)
+    return false;
+
+  // If no previously submitted operation is pending, executing the kernel
+  // right away preserves the in-order semantics of the queue.
+  return _worker.queue_size() == 0;
+}
+
 result omp_queue::submit_sscp_kernel_from_code_object(
     const kernel_operation &op, hcf_object_id hcf_object,
     std::string_view kernel_name, const rt::hcf_kernel_info *kernel_info,
@@ -416,36 +534,62 @@ result omp_queue::submit_sscp_kernel_from_code_object(
       kernel_base_config_parameter::compilation_flow,
       compilation_flow::sscp);
   _config.append_base_configuration(
-      kernel_base_config_parameter::hcf_object_id, hcf_object);
-
-  auto binary_configuration_id =
-      adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
+      kernel_base_config_parameter::hcf_object_id,
+      adaptivity_engine.get_code_identity());
+
+  std::size_t sub_group_size = get_sscp_sub_group_size();
+  if(group_size.size() > max_sub_group_exchange_size)
+    sub_group_size = 1;
+  _config.set_build_option(kernel_build_option::host_sub_group_size,
+                           sub_group_size);
+  if(application::get_settings().get<setting::omp_in_process_jit>())
+    _config.set_build_flag(kernel_build_flag::host_relocatable_object);
+
+  kernel_configuration::id_type binary_configuration_id;
+  kernel_configuration::id_type code_object_configuration_id;
+  auto select_configuration_id = [&](kernel_configuration::id_type binary_id) {
+    binary_configuration_id = binary_id;
+    code_object_configuration_id = binary_id;
+  };
+  select_configuration_id(
+      adaptivity_engine.finalize_binary_configuration(_config));
 
   auto get_image_and_kernel_names =
       [&](std::vector<std::string> &contained_kernels) -> std::string {
     return adaptivity_engine.select_image_and_kernels(&contained_kernels);
   };
 
-  auto jit_compiler = [&](std::string &compiled_image) -> bool {
-    const common::hcf_container *hcf = rt::hcf_cache::get().get_hcf(hcf_object);
-
+  // Returns a self-contained JIT compiler for the currently selected
+  // configuration, which can also be executed on a background thread.
+  auto make_jit_compiler = [&]() {
     std::vector<std::string> kernel_names;
     std::string selected_image_name = get_image_and_kernel_names(kernel_names);
 
-    // Construct Host translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
-        compiler::createLLVMToHostTranslator(kernel_names);
+    return [=, config = _config](std::string &compiled_image) -> bool {
+      const common::hcf_container *hcf = rt::hcf_cache::get().get_hcf(hcf_object);
 
-    // Lower kernels to binary
-    auto err = glue::jit::compile(translator.get(), hcf, selected_image_name,
-                                  _config, compiled_image);
+      // Construct Host translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+          compiler::createLLVMToHostTranslator(kernel_names);
 
-    if (!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+      // Lower kernels to binary
+      auto err = glue::jit::compile(translator.get(), hcf, selected_image_name,
+                                    config, compiled_image);
+
+      if (!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      glue::jit::precompilation::record_recipe(
+          binary_configuration_id, backend_id::omp, hcf_object,
+          selected_image_name, kernel_names, config,
+          false);
+      return true;
+    };
+  };
+
+  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+    return make_jit_compiler()(compiled_image);
   };
 
   auto code_object_constructor =
@@ -470,9 +614,24 @@ result omp_queue::submit_sscp_kernel_from_code_object(
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id, jit_compiler,
-      code_object_constructor);
+  const code_object *obj = nullptr;
+  if(adaptivity_engine.has_fallback_configuration()) {
+    obj = _kernel_cache->get_or_schedule_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if(!obj) {
+      // The specialized binary is still being compiled; use the less
+      // specialized configuration in the meantime.
+      _config = adaptivity_engine.get_fallback_configuration();
+      select_configuration_id(
+          adaptivity_engine.get_fallback_configuration_id());
+    }
+  }
+
+  if(!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        jit_compiler, code_object_constructor);
 
   if (!obj) {
     return make_error(__acpp_here(),
@@ -483,8 +642,16 @@ result omp_queue::submit_sscp_kernel_from_code_object(
       static_cast<const omp_sscp_executable_object *>(obj)->get_kernel(
           kernel_name);
 
+  const bool is_sequential = current_launch.is_inline;
+  omp_loop_schedule schedule = select_omp_loop_schedule(
+      current_launch.node ? &current_launch.node->get_execution_hints()
+                          : nullptr,
+      _sscp_schedule_selectors[reinterpret_cast<const void *>(kernel)],
+      num_groups.size(), is_sequential ? 1 : omp_get_max_threads());
+
   return launch_kernel_from_so(kernel, num_groups, group_size, local_mem_size,
-                               _arg_mapper.get_mapped_args());
+                               _arg_mapper.get_mapped_args(), is_sequential,
+                               schedule);
 
 #else
   return make_error(
@@ -560,6 +727,12 @@ result omp_queue::query_status(inorder_queue_status &status) {
   return make_success();
 }
 
+result omp_queue::submit_completion_callback(void (*callback)(void *),
+                                             void *user_data) {
+  _worker([callback, user_data] { callback(user_data); });
+  return make_success();
+}
+
 result omp_queue::submit_external_wait_for(const dag_node_ptr& node) {
   HIPSYCL_DEBUG_INFO << "omp_queue: Submitting wait for external node..."
                      << std::endl;
@@ -579,8 +752,7 @@ result omp_queue::submit_external_wait_for(const dag_node_ptr& node) {
 worker_thread &omp_queue::get_worker() { return _worker; }
 
 device_id omp_queue::get_device() const {
-  return device_id{
-      backend_descriptor{hardware_platform::cpu, api_platform::omp}, 0};
+  return _device;
 }
 
 void *omp_queue::get_native_type() const { return nullptr; }
@@ -599,7 +771,8 @@ result omp_sscp_code_object_invoker::submit_kernel(
 }
 
 rt::range<3> omp_sscp_code_object_invoker::select_group_size(
-    const rt::range<3> &global_range, const rt::range<3> &group_size) const {
+    const rt::range<3> &global_range, const rt::range<3> &group_size,
+    hcf_object_id hcf_object, std::string_view kernel_name) const {
   rt::range<3> selected_group_size = group_size;
 #ifdef _OPENMP
   const int max_threads = omp_get_max_threads();
@@ -0,0 +1,142 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/remote/remote_allocator.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/runtime/error.hpp"
+
+namespace hipsycl {
+namespace rt {
+
+void remote_allocation_map::insert(const void *ptr, std::size_t bytes,
+                                   device_id dev) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  _allocations[static_cast<const char *>(ptr)] = allocation{bytes, dev};
+}
+
+void remote_allocation_map::erase(const void *ptr) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  _allocations.erase(static_cast<const char *>(ptr));
+}
+
+bool remote_allocation_map::find(const void *ptr, device_id &dev) const {
+  const char *address = static_cast<const char *>(ptr);
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto it = _allocations.upper_bound(address);
+  if(it == _allocations.begin())
+    return false;
+  --it;
+  // Also accept the end of the allocation, like other backends do for
+  // pointers one past the last element
+  if(address > it->first + it->second.bytes)
+    return false;
+  dev = it->second.dev;
+  return true;
+}
+
+remote_allocator::remote_allocator(const device_id &my_device,
+                                   remote_hardware_context *ctx,
+                                   remote_allocation_map *allocations)
+    : _my_device{my_device}, _ctx{ctx}, _allocations{allocations} {}
+
+void *remote_allocator::allocate(size_t min_alignment, size_t size_bytes) {
+  if(size_bytes == 0)
+    return nullptr;
+
+  remote_allocation_request request;
+  request.device = _ctx->get_daemon_device_index();
+  request.bytes = size_bytes;
+  request.alignment = min_alignment;
+
+  remote_message msg;
+  auto err = _ctx->get_daemon()->request(
+      remote_message_type::allocate, request,
+      remote_message_type::allocate_reply, msg);
+  remote_allocation_reply reply;
+  if(err.is_success() && !msg.unpack_body(reply))
+    reply.error = "Received invalid reply";
+  if(!err.is_success() || !reply.error.empty() || reply.address == 0) {
+    register_error(
+        __acpp_here(),
+        error_info{"remote_allocator: Allocation on " +
+                       _ctx->get_daemon()->get_address() + " failed: " +
+                       (err.is_success() ? reply.error : err.what()),
+                   error_type::memory_allocation_error});
+    return nullptr;
+  }
+
+  void *ptr = reinterpret_cast<void *>(reply.address);
+  _allocations->insert(ptr, size_bytes, _my_device);
+  return ptr;
+}
+
+void *remote_allocator::allocate_optimized_host(size_t min_alignment,
+                                                size_t bytes) {
+  register_error(
+      __acpp_here(),
+      error_info{"remote_allocator: Host allocations are not supported by "
+                 "the remote backend",
+                 error_type::feature_not_supported});
+  return nullptr;
+}
+
+void remote_allocator::free(void *mem) {
+  if(!mem)
+    return;
+  _allocations->erase(mem);
+
+  remote_free_request request;
+  request.device = _ctx->get_daemon_device_index();
+  request.address = reinterpret_cast<uint64_t>(mem);
+  auto err = _ctx->get_daemon()->request_status(remote_message_type::free,
+                                                 request);
+  if(!err.is_success())
+    register_error(err);
+}
+
+void *remote_allocator::allocate_usm(size_t bytes) {
+  register_error(
+      __acpp_here(),
+      error_info{"remote_allocator: Shared allocations are not supported by "
+                 "the remote backend",
+                 error_type::feature_not_supported});
+  return nullptr;
+}
+
+bool remote_allocator::is_usm_accessible_from(backend_descriptor b) const {
+  return false;
+}
+
+result remote_allocator::query_pointer(const void *ptr,
+                                       pointer_info &out) const {
+  device_id dev;
+  if(!_allocations->find(ptr, dev))
+    return make_error(
+        __acpp_here(),
+        error_info{"remote_allocator: query_pointer(): Pointer is unknown "
+                   "by backend",
+                   error_type::invalid_parameter_error});
+
+  out.dev = dev;
+  out.is_optimized_host = false;
+  out.is_usm = false;
+  out.is_from_host_backend = false;
+  return make_success();
+}
+
+result remote_allocator::mem_advise(const void *addr, std::size_t num_bytes,
+                                    int advise) const {
+  HIPSYCL_DEBUG_WARNING << "remote_allocator: Ignoring mem_advise() hint"
+                        << std::endl;
+  return make_success();
+}
+
+}
+}
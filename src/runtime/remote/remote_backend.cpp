@@ -0,0 +1,122 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/backend_loader.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/inorder_executor.hpp"
+#include "hipSYCL/runtime/remote/remote_backend.hpp"
+#include "hipSYCL/runtime/remote/remote_queue.hpp"
+#include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/multi_queue_executor.hpp"
+
+#include <memory>
+
+
+HIPSYCL_PLUGIN_API_EXPORT
+hipsycl::rt::backend *hipsycl_backend_plugin_create() {
+  return new hipsycl::rt::remote_backend();
+}
+
+static const char *backend_name = "remote";
+
+HIPSYCL_PLUGIN_API_EXPORT
+const char *hipsycl_backend_plugin_get_name() {
+  return backend_name;
+}
+
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+std::unique_ptr<multi_queue_executor>
+create_multi_queue_executor(remote_backend *b, remote_hardware_manager &hw) {
+  // Queue priorities are not supported
+  return std::make_unique<multi_queue_executor>(
+      *b, [&hw](device_id dev, int) {
+        return std::make_unique<remote_queue>(&hw, dev);
+      });
+}
+
+}
+
+remote_backend::remote_backend()
+    : _hw{},
+      _executor([this](){
+        return create_multi_queue_executor(this, _hw);
+      }) {
+  for(std::size_t i = 0; i < _hw.get_num_devices(); ++i) {
+    _allocators.emplace_back(std::make_unique<remote_allocator>(
+        _hw.get_device_id(i),
+        static_cast<remote_hardware_context *>(_hw.get_device(i)),
+        &_allocations));
+  }
+}
+
+api_platform remote_backend::get_api_platform() const {
+  return api_platform::remote;
+}
+
+hardware_platform remote_backend::get_hardware_platform() const {
+  return hardware_platform::remote;
+}
+
+backend_id remote_backend::get_unique_backend_id() const {
+  return backend_id::remote;
+}
+
+backend_hardware_manager* remote_backend::get_hardware_manager() const {
+  return &_hw;
+}
+
+backend_executor* remote_backend::get_executor(device_id dev) const {
+  if(dev.get_backend() != this->get_unique_backend_id()) {
+    register_error(__acpp_here(),
+                   error_info{"remote_backend: Device id from other backend requested",
+                              error_type::invalid_parameter_error});
+    return nullptr;
+  }
+
+  return _executor.get();
+}
+
+backend_allocator* remote_backend::get_allocator(device_id dev) const {
+  if(dev.get_backend() != this->get_unique_backend_id()) {
+    register_error(__acpp_here(),
+                   error_info{"remote_backend: Device id from other backend requested",
+                              error_type::invalid_parameter_error});
+    return nullptr;
+  }
+  if(static_cast<std::size_t>(dev.get_id()) >= _allocators.size()) {
+    register_error(__acpp_here(),
+                   error_info{"remote_backend: Requested device " +
+                                  std::to_string(dev.get_id()) +
+                                  " does not exist.",
+                              error_type::invalid_parameter_error});
+    return nullptr;
+  }
+  return _allocators[dev.get_id()].get();
+}
+
+std::string remote_backend::get_name() const {
+  return "Remote";
+}
+
+std::unique_ptr<backend_executor>
+remote_backend::create_inorder_executor(device_id dev, int priority) {
+  std::unique_ptr<inorder_queue> q = std::make_unique<remote_queue>(&_hw, dev);
+
+  return std::make_unique<inorder_executor>(std::move(q));
+}
+
+}
+}
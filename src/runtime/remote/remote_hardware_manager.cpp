@@ -0,0 +1,220 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/remote/remote_hardware_manager.hpp"
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+
+#include <sstream>
+
+namespace hipsycl {
+namespace rt {
+
+result remote_handshake(remote_socket &socket, remote_hello_reply &reply) {
+  remote_message msg;
+  auto err = socket.request(remote_message_type::hello, remote_hello{},
+                            remote_message_type::hello_reply, msg);
+  if(!err.is_success())
+    return err;
+  if(!msg.unpack_body(reply))
+    return make_error(__acpp_here(),
+                      error_info{"remote_daemon: Received invalid hello reply"});
+  if(reply.version != remote_protocol_version)
+    return make_error(
+        __acpp_here(),
+        error_info{"remote_daemon: Daemon uses protocol version " +
+                   std::to_string(reply.version) + ", but version " +
+                   std::to_string(remote_protocol_version) + " is required"});
+  return make_success();
+}
+
+remote_daemon::remote_daemon(const std::string &address)
+    : _address{address}, _port{remote_default_port} {}
+
+result remote_daemon::connect() {
+  if(!parse_remote_address(_address, _host, _port))
+    return make_error(__acpp_here(),
+                      error_info{"remote_daemon: Invalid address " + _address,
+                                 error_type::invalid_parameter_error});
+
+  std::lock_guard<std::mutex> lock{_mutex};
+  auto err = remote_socket::connect(_host, _port, _control);
+  if(!err.is_success())
+    return err;
+
+  remote_hello_reply reply;
+  err = remote_handshake(_control, reply);
+  if(!err.is_success())
+    return err;
+
+  for(const auto &dev : reply.devices) {
+    if(dev.uint_properties.size() != remote_num_uint_properties ||
+       dev.support_aspects.size() != remote_num_support_aspects)
+      return make_error(
+          __acpp_here(),
+          error_info{"remote_daemon: Received invalid device description"});
+  }
+  _devices = std::move(reply.devices);
+  return make_success();
+}
+
+result remote_daemon::open_stream(uint64_t device, remote_socket &out) {
+  auto err = remote_socket::connect(_host, _port, out);
+  if(!err.is_success())
+    return err;
+  remote_hello_reply hello;
+  err = remote_handshake(out, hello);
+  if(!err.is_success())
+    return err;
+
+  remote_message reply;
+  err = out.request(remote_message_type::open_stream,
+                    remote_stream_request{device},
+                    remote_message_type::status_reply, reply);
+  if(!err.is_success())
+    return err;
+  remote_status_reply status;
+  if(!reply.unpack_body(status))
+    return make_error(__acpp_here(),
+                      error_info{"remote_daemon: Received invalid reply"});
+  if(!status.error.empty())
+    return make_error(__acpp_here(),
+                      error_info{"remote_daemon: " + _address + ": " +
+                                 status.error});
+  return make_success();
+}
+
+remote_hardware_context::remote_hardware_context(
+    std::shared_ptr<remote_daemon> daemon, std::size_t daemon_device_index)
+    : _daemon{std::move(daemon)}, _daemon_device_index{daemon_device_index} {}
+
+const remote_device_info &remote_hardware_context::info() const {
+  return _daemon->get_devices()[_daemon_device_index];
+}
+
+bool remote_hardware_context::is_cpu() const {
+  return info().is_cpu;
+}
+
+bool remote_hardware_context::is_gpu() const {
+  return info().is_gpu;
+}
+
+std::size_t remote_hardware_context::get_max_kernel_concurrency() const {
+  return info().max_kernel_concurrency;
+}
+
+std::size_t remote_hardware_context::get_max_memcpy_concurrency() const {
+  return info().max_memcpy_concurrency;
+}
+
+std::string remote_hardware_context::get_device_name() const {
+  return info().name + " (on " + _daemon->get_address() + ")";
+}
+
+std::string remote_hardware_context::get_vendor_name() const {
+  return info().vendor;
+}
+
+std::string remote_hardware_context::get_device_arch() const {
+  return info().arch;
+}
+
+bool remote_hardware_context::has(device_support_aspect aspect) const {
+  switch (aspect) {
+  // Memory of the daemon is not accessible from the host, and the
+  // execution on the daemon cannot be timed from here
+  case device_support_aspect::host_unified_memory:
+  case device_support_aspect::usm_host_allocations:
+  case device_support_aspect::usm_atomic_host_allocations:
+  case device_support_aspect::usm_shared_allocations:
+  case device_support_aspect::usm_atomic_shared_allocations:
+  case device_support_aspect::usm_system_allocations:
+  case device_support_aspect::execution_timestamps:
+    return false;
+  default:
+    return info().support_aspects[static_cast<std::size_t>(aspect)] != 0;
+  }
+}
+
+std::size_t
+remote_hardware_context::get_property(device_uint_property prop) const {
+  return info().uint_properties[static_cast<std::size_t>(prop)];
+}
+
+std::vector<std::size_t>
+remote_hardware_context::get_property(device_uint_list_property prop) const {
+  switch (prop) {
+  case device_uint_list_property::sub_group_sizes:
+    return std::vector<std::size_t>{info().sub_group_sizes.begin(),
+                                    info().sub_group_sizes.end()};
+  // Devices of the same daemon are not peers of the client
+  case device_uint_list_property::peer_access_devices:
+    return {};
+  }
+  assert(false && "Unknown device list property");
+  return {};
+}
+
+std::string remote_hardware_context::get_driver_version() const {
+  return "acpp-remote-daemon " + _daemon->get_address() + ": " +
+         info().driver_version;
+}
+
+std::string remote_hardware_context::get_profile() const {
+  return info().profile;
+}
+
+remote_hardware_manager::remote_hardware_manager() {
+  std::stringstream addresses{
+      application::get_settings().get<setting::remote_devices>()};
+  std::string address;
+  while(std::getline(addresses, address, ',')) {
+    if(address.empty())
+      continue;
+
+    auto daemon = std::make_shared<remote_daemon>(address);
+    auto err = daemon->connect();
+    if(!err.is_success()) {
+      HIPSYCL_DEBUG_WARNING << "remote_hardware_manager: Could not connect to "
+                            << address << ", skipping its devices: "
+                            << err.what() << std::endl;
+      continue;
+    }
+
+    HIPSYCL_DEBUG_INFO << "remote_hardware_manager: Daemon " << address
+                       << " provides " << daemon->get_devices().size()
+                       << " device(s)" << std::endl;
+    for(std::size_t i = 0; i < daemon->get_devices().size(); ++i)
+      _devices.emplace_back(daemon, i);
+  }
+}
+
+std::size_t remote_hardware_manager::get_num_devices() const {
+  return _devices.size();
+}
+
+hardware_context *remote_hardware_manager::get_device(std::size_t index) {
+  if(index >= _devices.size())
+    return nullptr;
+  return &(_devices[index]);
+}
+
+device_id remote_hardware_manager::get_device_id(std::size_t index) const {
+  return device_id{
+      backend_descriptor{hardware_platform::remote, api_platform::remote},
+      static_cast<int>(index)};
+}
+
+}
+}
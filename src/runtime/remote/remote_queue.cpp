@@ -0,0 +1,622 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/remote/remote_queue.hpp"
+#include "hipSYCL/runtime/remote/remote_event.hpp"
+
+#include "hipSYCL/common/debug.hpp"
+#include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/error.hpp"
+#include "hipSYCL/runtime/generic/object_pool.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_launcher.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/queue_completion_event.hpp"
+#include "hipSYCL/runtime/signal_channel.hpp"
+
+#include <cstring>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+bool is_remote_device(device_id dev) {
+  return dev.get_backend() == backend_id::remote;
+}
+
+// Accessed part of a host allocation, resolved at submission time
+struct host_region {
+  char *base;
+  id<3> offset;
+  range<3> shape;
+  std::size_t element_size;
+  range<3> r;
+
+  explicit host_region(const memory_location &loc, const range<3> &r)
+      : base{static_cast<char *>(loc.get_base_ptr())},
+        offset{loc.get_access_offset()}, shape{loc.get_allocation_shape()},
+        element_size{loc.get_element_size()}, r{r} {}
+
+  std::size_t get_num_bytes() const { return r.size() * element_size; }
+
+  char *get_row(std::size_t surface, std::size_t row) const {
+    std::size_t linear_index = offset[2] + shape[2] * (offset[1] + row) +
+                               shape[2] * shape[1] * (offset[0] + surface);
+    return base + linear_index * element_size;
+  }
+
+  // Whether the rows follow each other without gaps
+  bool is_contiguous() const {
+    if(r[0] * r[1] <= 1)
+      return true;
+    return r[2] == shape[2] && (r[0] == 1 || r[1] == shape[1]);
+  }
+
+  // Invokes f(row, row_size) for each row, in the order in which they are
+  // packed on the wire
+  template<class F>
+  void for_each_row(F &&f) const {
+    for(std::size_t surface = 0; surface < r[0]; ++surface)
+      for(std::size_t row = 0; row < r[1]; ++row)
+        f(get_row(surface, row), r[2] * element_size);
+  }
+
+  std::string pack() const {
+    std::string packed;
+    packed.reserve(get_num_bytes());
+    for_each_row([&](const char *row, std::size_t row_size) {
+      packed.append(row, row_size);
+    });
+    return packed;
+  }
+
+  void unpack(const std::string &packed) const {
+    const char *current = packed.data();
+    for_each_row([&](char *row, std::size_t row_size) {
+      std::memcpy(row, current, row_size);
+      current += row_size;
+    });
+  }
+};
+
+remote_memory_region make_region(const memory_location &loc,
+                                 remote_hardware_context *ctx) {
+  remote_memory_region region;
+  region.device = ctx ? ctx->get_daemon_device_index() : 0;
+  region.address = reinterpret_cast<uint64_t>(loc.get_base_ptr());
+  for(int i = 0; i < 3; ++i) {
+    region.offset[i] = loc.get_access_offset()[i];
+    region.shape[i] = loc.get_allocation_shape()[i];
+  }
+  region.element_size = loc.get_element_size();
+  return region;
+}
+
+remote_memcpy_command make_memcpy_command(const memcpy_operation &op,
+                                          remote_hardware_context *src_ctx,
+                                          remote_hardware_context *dest_ctx) {
+  remote_memcpy_command cmd;
+  cmd.source = make_region(op.source(), src_ctx);
+  cmd.dest = make_region(op.dest(), dest_ctx);
+  for(int i = 0; i < 3; ++i)
+    cmd.range[i] = op.get_num_transferred_elements()[i];
+  return cmd;
+}
+
+}
+
+remote_stream::remote_stream(std::shared_ptr<remote_daemon> daemon,
+                             uint64_t device)
+    : _daemon{std::move(daemon)} {
+  auto err = _daemon->open_stream(device, _socket);
+  if(!err.is_success()) {
+    register_error(err);
+    _is_broken = true;
+    return;
+  }
+  _receiver = std::thread{[this]() { receive(); }};
+}
+
+remote_stream::~remote_stream() {
+  wait();
+  _socket.shutdown();
+  if(_receiver.joinable())
+    _receiver.join();
+}
+
+result remote_stream::submit(remote_message_type type,
+                             const std::vector<uint8_t> &body,
+                             const void *data, std::size_t data_size,
+                             completion_handler handler,
+                             bool writes_host_memory) {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(_is_broken)
+      return make_error(
+          __acpp_here(),
+          error_info{"remote_stream: Connection to " + _daemon->get_address() +
+                     " is unavailable"});
+    _pending.push_back(
+        pending_command{std::move(handler), writes_host_memory, {}});
+    if(writes_host_memory)
+      ++_num_pending_host_writes;
+  }
+
+  auto err = _socket.send(type, body, data, data_size);
+  if(!err.is_success()) {
+    // Completes the pending commands once the receiver notices the error
+    _socket.shutdown();
+    return err;
+  }
+  return make_success();
+}
+
+void remote_stream::when_complete(std::function<void()> f) {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(!_pending.empty()) {
+      _pending.back().on_completion.push_back(std::move(f));
+      return;
+    }
+  }
+  f();
+}
+
+void remote_stream::wait() {
+  std::unique_lock<std::mutex> lock{_mutex};
+  _completion_cv.wait(lock, [this]() { return _pending.empty(); });
+}
+
+void remote_stream::wait_for_host_writes() {
+  std::unique_lock<std::mutex> lock{_mutex};
+  _completion_cv.wait(lock,
+                      [this]() { return _num_pending_host_writes == 0; });
+}
+
+bool remote_stream::is_idle() const {
+  std::lock_guard<std::mutex> lock{_mutex};
+  return _pending.empty();
+}
+
+result remote_stream::register_hcf(hcf_object_id hcf_object) {
+  if(_registered_hcf_objects.count(hcf_object))
+    return make_success();
+
+  const common::hcf_container *hcf = hcf_cache::get().get_hcf(hcf_object);
+  if(!hcf)
+    return make_error(
+        __acpp_here(),
+        error_info{"remote_stream: Could not obtain HCF object " +
+                   std::to_string(hcf_object)});
+  std::string serialized = hcf->serialize();
+  auto err = submit(remote_message_type::register_hcf,
+                    remote_hcf_registration{hcf_object}, serialized.data(),
+                    serialized.size(),
+                    [this](const std::string &error, std::string &) {
+                      if(!error.empty())
+                        register_error(
+                            __acpp_here(),
+                            error_info{"remote_stream: HCF registration on " +
+                                       _daemon->get_address() +
+                                       " failed: " + error});
+                    });
+  if(err.is_success())
+    _registered_hcf_objects.insert(hcf_object);
+  return err;
+}
+
+void remote_stream::receive() {
+  for(;;) {
+    remote_message msg;
+    auto err = _socket.receive(msg);
+    if(!err.is_success()) {
+      fail("Connection to " + _daemon->get_address() + " was closed");
+      return;
+    }
+    remote_completion completion;
+    if(msg.type != remote_message_type::completion ||
+       !msg.unpack_body(completion) ||
+       completion.command != _num_completed + 1) {
+      fail("Received invalid completion from " + _daemon->get_address());
+      _socket.shutdown();
+      return;
+    }
+
+    // The command is only removed after its handler has run, so that
+    // when_complete() does not consider it complete before
+    completion_handler handler;
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      if(_pending.empty()) {
+        fail("Received unexpected completion from " + _daemon->get_address());
+        _socket.shutdown();
+        return;
+      }
+      handler = _pending.front().handler;
+    }
+    if(handler)
+      handler(completion.error, msg.data);
+    else if(!completion.error.empty())
+      register_error(__acpp_here(),
+                     error_info{"remote_stream: " + _daemon->get_address() +
+                                ": " + completion.error});
+
+    std::vector<std::function<void()>> on_completion;
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      on_completion = std::move(_pending.front().on_completion);
+      if(_pending.front().writes_host_memory)
+        --_num_pending_host_writes;
+      _pending.pop_front();
+      ++_num_completed;
+    }
+    for(auto &f : on_completion)
+      f();
+    _completion_cv.notify_all();
+  }
+}
+
+void remote_stream::fail(const std::string &error) {
+  std::deque<pending_command> pending;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    if(!_is_broken && !_pending.empty())
+      register_error(__acpp_here(), error_info{"remote_stream: " + error});
+    _is_broken = true;
+    pending = std::move(_pending);
+    _pending.clear();
+    _num_pending_host_writes = 0;
+  }
+  // Commands that have not completed are considered failed, but their
+  // dependents must not wait forever
+  std::string no_data;
+  for(auto &cmd : pending) {
+    if(cmd.handler)
+      cmd.handler(error, no_data);
+    for(auto &f : cmd.on_completion)
+      f();
+  }
+  _completion_cv.notify_all();
+}
+
+remote_queue::remote_queue(remote_hardware_manager *hw, device_id dev)
+    : _hw{hw}, _device{dev}, _ctx{get_context(dev)},
+      _stream{_ctx->get_daemon(), _ctx->get_daemon_device_index()},
+      _sscp_code_object_invoker{this} {}
+
+remote_queue::~remote_queue() {
+  _worker.halt();
+  _stream.wait();
+}
+
+remote_hardware_context *remote_queue::get_context(device_id dev) const {
+  return static_cast<remote_hardware_context *>(
+      _hw->get_device(dev.get_id()));
+}
+
+std::shared_ptr<dag_node_event> remote_queue::insert_event() {
+  HIPSYCL_DEBUG_INFO << "remote_queue: Inserting event into queue..."
+                     << std::endl;
+
+  auto evt = std::allocate_shared<remote_node_event>(
+      object_pool_allocator<remote_node_event>{});
+  auto signal_channel = evt->get_signal_channel();
+
+  _worker([this, signal_channel] {
+    _stream.when_complete([signal_channel] { signal_channel->signal(); });
+  });
+
+  return evt;
+}
+
+std::shared_ptr<dag_node_event> remote_queue::create_queue_completion_event() {
+  return std::make_shared<queue_completion_event<
+      std::shared_ptr<signal_channel>, remote_node_event>>(this);
+}
+
+result remote_queue::submit_memcpy(memcpy_operation &op,
+                                   const dag_node_ptr &node) {
+  HIPSYCL_DEBUG_INFO << "remote_queue: Submitting memcpy operation..."
+                     << std::endl;
+
+  device_id src_dev = op.source().get_device();
+  device_id dest_dev = op.dest().get_device();
+  range<3> transferred_range = op.get_num_transferred_elements();
+
+  if(src_dev.is_host() && is_remote_device(dest_dev)) {
+    remote_hardware_context *dest_ctx = get_context(dest_dev);
+    remote_memcpy_command cmd = make_memcpy_command(op, nullptr, dest_ctx);
+    host_region src{op.source(), transferred_range};
+    if(dest_ctx->get_daemon() != _ctx->get_daemon()) {
+      // The stream can only access memory of its own daemon
+      _worker([this, cmd, src, dest_ctx]() {
+        _stream.wait();
+        std::string packed = src.pack();
+        auto err = dest_ctx->get_daemon()->request_status(
+            remote_message_type::write, cmd, nullptr, packed.data(),
+            packed.size());
+        if(!err.is_success())
+          register_error(err);
+      });
+      return make_success();
+    }
+    _worker([this, cmd, src]() {
+      // The host memory may still be written by a previous copy from the
+      // device that has not completed yet
+      _stream.wait_for_host_writes();
+
+      result err = make_success();
+      if(src.is_contiguous()) {
+        err = _stream.submit(remote_message_type::memcpy_to_device, cmd,
+                             src.get_row(0, 0), src.get_num_bytes());
+      } else {
+        std::string packed = src.pack();
+        err = _stream.submit(remote_message_type::memcpy_to_device, cmd,
+                             packed.data(), packed.size());
+      }
+      if(!err.is_success())
+        register_error(err);
+    });
+  } else if(is_remote_device(src_dev) && dest_dev.is_host()) {
+    remote_hardware_context *src_ctx = get_context(src_dev);
+    remote_memcpy_command cmd = make_memcpy_command(op, src_ctx, nullptr);
+    host_region dest{op.dest(), transferred_range};
+    if(src_ctx->get_daemon() != _ctx->get_daemon()) {
+      _worker([this, cmd, dest, src_ctx]() {
+        _stream.wait();
+        std::string data;
+        auto err = src_ctx->get_daemon()->request_status(
+            remote_message_type::read, cmd, &data);
+        if(err.is_success() && data.size() != dest.get_num_bytes())
+          err = make_error(
+              __acpp_here(),
+              error_info{"remote_queue: Copy from device failed: Invalid size"});
+        if(!err.is_success()) {
+          register_error(err);
+          return;
+        }
+        dest.unpack(data);
+      });
+      return make_success();
+    }
+    _worker([this, cmd, dest]() {
+      auto err = _stream.submit(
+          remote_message_type::memcpy_from_device, cmd, nullptr, 0,
+          [dest](const std::string &error, std::string &data) {
+            if(!error.empty() || data.size() != dest.get_num_bytes()) {
+              register_error(
+                  __acpp_here(),
+                  error_info{"remote_queue: Copy from device failed: " +
+                             (error.empty() ? std::string{"Invalid size"}
+                                            : error)});
+              return;
+            }
+            dest.unpack(data);
+          },
+          true);
+      if(!err.is_success())
+        register_error(err);
+    });
+  } else if(is_remote_device(src_dev) && is_remote_device(dest_dev)) {
+    remote_hardware_context *src_ctx = get_context(src_dev);
+    remote_hardware_context *dest_ctx = get_context(dest_dev);
+    if(src_ctx->get_daemon() == dest_ctx->get_daemon() &&
+       src_ctx->get_daemon() == _ctx->get_daemon()) {
+      remote_memcpy_command cmd = make_memcpy_command(op, src_ctx, dest_ctx);
+      _worker([this, cmd]() {
+        auto err = _stream.submit(remote_message_type::memcpy_on_device, cmd);
+        if(!err.is_success())
+          register_error(err);
+      });
+    } else {
+      // Daemons do not connect to each other, so the data is staged
+      // through the host
+      remote_memcpy_command cmd = make_memcpy_command(op, src_ctx, dest_ctx);
+      _worker([this, cmd, src_ctx, dest_ctx]() {
+        _stream.wait();
+        auto err = copy_through_host(cmd, src_ctx, dest_ctx);
+        if(!err.is_success())
+          register_error(err);
+      });
+    }
+  } else {
+    return register_error(
+        __acpp_here(),
+        error_info{"remote_queue: Remote backend can only transfer data "
+                   "between remote devices and the host",
+                   error_type::feature_not_supported});
+  }
+
+  return make_success();
+}
+
+result remote_queue::copy_through_host(const remote_memcpy_command &cmd,
+                                       remote_hardware_context *src_ctx,
+                                       remote_hardware_context *dest_ctx) {
+  std::string data;
+  auto err = src_ctx->get_daemon()->request_status(remote_message_type::read,
+                                                   cmd, &data);
+  if(!err.is_success())
+    return err;
+  return dest_ctx->get_daemon()->request_status(
+      remote_message_type::write, cmd, nullptr, data.data(), data.size());
+}
+
+result remote_queue::submit_kernel(kernel_operation &op,
+                                   const dag_node_ptr &node) {
+  HIPSYCL_DEBUG_INFO << "remote_queue: Submitting kernel..." << std::endl;
+
+  rt::backend_kernel_launch_capabilities cap;
+  cap.provide_sscp_invoker(&_sscp_code_object_invoker);
+
+  bool is_custom_operation = op.get_launcher().is_custom_operation();
+  void *params = this;
+
+  _worker([=, &op]() {
+    // Custom operations expect previous operations to have completed
+    if(is_custom_operation)
+      _stream.wait();
+    auto err =
+        op.get_launcher().invoke(backend_id::remote, params, cap, node.get());
+    if(!err.is_success())
+      rt::register_error(err);
+  });
+
+  return make_success();
+}
+
+result remote_queue::submit_sscp_kernel(
+    hcf_object_id hcf_object, std::string_view kernel_name,
+    const rt::hcf_kernel_info *kernel_info, const rt::range<3> &num_groups,
+    const rt::range<3> &group_size, unsigned local_mem_size, void **args,
+    std::size_t *arg_sizes, std::size_t num_args,
+    const kernel_configuration &config) {
+  // SSCP kernels receive the kernel object as a single argument, with
+  // embedded pointers already referring to allocations of the daemon
+  if(num_args != 1)
+    return make_error(
+        __acpp_here(),
+        error_info{"remote_queue: Unsupported kernel arguments for kernel " +
+                   std::string{kernel_name}});
+
+  remote_kernel_command cmd;
+  cmd.hcf_object = hcf_object;
+  cmd.kernel_name = std::string{kernel_name};
+  for(int i = 0; i < 3; ++i) {
+    cmd.num_groups[i] = num_groups[i];
+    cmd.group_size[i] = group_size[i];
+  }
+  cmd.local_mem_size = local_mem_size;
+  cmd.configuration = glue::jit::precompilation::make_recipe(
+      backend_id::remote, hcf_object, std::string{}, {cmd.kernel_name},
+      config, false);
+  if(!cmd.configuration.is_valid())
+    return make_error(
+        __acpp_here(),
+        error_info{"remote_queue: The configuration of kernel " +
+                       cmd.kernel_name +
+                       " cannot be transferred to the daemon (e.g. because "
+                       "it uses S2 IR constants)",
+                   error_type::feature_not_supported});
+
+  auto err = _stream.register_hcf(hcf_object);
+  if(!err.is_success())
+    return err;
+  return _stream.submit(remote_message_type::kernel, cmd, args[0],
+                        arg_sizes[0]);
+}
+
+result remote_queue::submit_prefetch(prefetch_operation &op,
+                                     const dag_node_ptr &node) {
+  HIPSYCL_DEBUG_INFO
+      << "remote_queue: Received prefetch submission request, ignoring"
+      << std::endl;
+  // There is no shared memory between the host and the daemon
+  return make_success();
+}
+
+result remote_queue::submit_memset(memset_operation &op,
+                                   const dag_node_ptr &node) {
+  if (!op.get_pointer()) {
+    return register_error(
+        __acpp_here(),
+        error_info{
+            "remote_queue: submit_memset(): Invalid argument, pointer is null."});
+  }
+
+  remote_memset_command cmd;
+  cmd.address = reinterpret_cast<uint64_t>(op.get_pointer());
+  cmd.pattern = op.get_pattern();
+  cmd.bytes = op.get_num_bytes();
+  _worker([this, cmd]() {
+    auto err = _stream.submit(remote_message_type::memset, cmd);
+    if(!err.is_success())
+      register_error(err);
+  });
+  return make_success();
+}
+
+/// Causes the queue to wait until an event on another queue has occured.
+/// the other queue must be from the same backend
+result remote_queue::submit_queue_wait_for(const dag_node_ptr &node) {
+  HIPSYCL_DEBUG_INFO << "remote_queue: Submitting wait for other queue..."
+                     << std::endl;
+  auto evt = node->get_event();
+  if (!evt) {
+    return register_error(
+        __acpp_here(),
+        error_info{"remote_queue: event for synchronization is null.",
+                   error_type::invalid_parameter_error});
+  }
+
+  _worker([=]() { evt->wait(); });
+
+  return make_success();
+}
+
+result remote_queue::submit_external_wait_for(const dag_node_ptr &node) {
+  HIPSYCL_DEBUG_INFO << "remote_queue: Submitting wait for external node..."
+                     << std::endl;
+
+  if (!node) {
+    return register_error(
+        __acpp_here(),
+        error_info{"remote_queue: node for synchronization is null.",
+                   error_type::invalid_parameter_error});
+  }
+
+  _worker([=]() { node->wait(); });
+
+  return make_success();
+}
+
+result remote_queue::wait() {
+  _worker.wait();
+  _stream.wait();
+  return make_success();
+}
+
+result remote_queue::query_status(inorder_queue_status &status) {
+  status = inorder_queue_status{_worker.queue_size() == 0 && _stream.is_idle()};
+  return make_success();
+}
+
+result remote_queue::submit_completion_callback(void (*callback)(void *),
+                                                void *user_data) {
+  _worker([this, callback, user_data] {
+    _stream.when_complete([callback, user_data] { callback(user_data); });
+  });
+  return make_success();
+}
+
+device_id remote_queue::get_device() const {
+  return _device;
+}
+
+void *remote_queue::get_native_type() const { return nullptr; }
+
+result remote_sscp_code_object_invoker::submit_kernel(
+    const kernel_operation &op, hcf_object_id hcf_object,
+    const rt::range<3> &num_groups, const rt::range<3> &group_size,
+    unsigned local_mem_size, void **args, std::size_t *arg_sizes,
+    std::size_t num_args, std::string_view kernel_name,
+    const rt::hcf_kernel_info *kernel_info,
+    const kernel_configuration &config) {
+
+  return _queue->submit_sscp_kernel(hcf_object, kernel_name, kernel_info,
+                                    num_groups, group_size, local_mem_size,
+                                    args, arg_sizes, num_args, config);
+}
+
+}
+}
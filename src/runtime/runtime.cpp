@@ -9,6 +9,7 @@
  */
 // SPDX-License-Identifier: BSD-2-Clause
 #include "hipSYCL/runtime/runtime.hpp"
+#include "hipSYCL/runtime/serialization/serialization.hpp"
 #include "hipSYCL/common/debug.hpp"
 
 namespace hipsycl {
@@ -25,6 +26,24 @@ runtime::~runtime()
 {
   HIPSYCL_DEBUG_INFO << "runtime: ******* rt shutdown ********"
                       << std::endl;
+  // Allocations that are still live at this point are either owned by
+  // objects that outlive the runtime, or leaked.
+  for (const auto &dev_usage :
+       runtime_statistics::get().get_snapshot().get_memory_usage()) {
+    for (std::size_t k = 0; k < num_allocation_kinds; ++k) {
+      const memory_usage &usage = dev_usage.usage[k];
+      if (usage.num_allocations == 0)
+        continue;
+      HIPSYCL_DEBUG_INFO
+          << "runtime: Memory usage of " << dev_usage.dev << " ("
+          << runtime_statistics_snapshot::get_name(
+                 static_cast<allocation_kind>(k))
+          << "): " << usage.live_bytes << " bytes in "
+          << usage.num_live_allocations << " live allocations, peak "
+          << usage.peak_bytes << " bytes, " << usage.num_allocations
+          << " allocations in total" << std::endl;
+    }
+  }
 }
 
 
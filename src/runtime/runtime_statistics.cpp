@@ -0,0 +1,317 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/runtime_statistics.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/runtime/serialization/serialization.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+
+namespace hipsycl {
+namespace rt {
+
+uint64_t
+runtime_statistics_snapshot::get_kernel_launches(backend_id b) const {
+  switch(b) {
+  case backend_id::cuda:
+    return get(statistic::kernel_launches_cuda);
+  case backend_id::hip:
+    return get(statistic::kernel_launches_hip);
+  case backend_id::level_zero:
+    return get(statistic::kernel_launches_level_zero);
+  case backend_id::ocl:
+    return get(statistic::kernel_launches_ocl);
+  case backend_id::omp:
+    return get(statistic::kernel_launches_omp);
+  case backend_id::remote:
+    return get(statistic::kernel_launches_remote);
+  }
+  return 0;
+}
+
+void runtime_statistics_snapshot::dump(std::ostream& ostr) const {
+  ostr << "{";
+  for(std::size_t i = 0; i < num_runtime_statistics; ++i) {
+    if(i > 0)
+      ostr << ",";
+    ostr << "\"" << get_name(static_cast<statistic>(i)) << "\":" << _values[i];
+  }
+  ostr << ",\"memory_usage\":{";
+  for(std::size_t i = 0; i < _memory_usage.size(); ++i) {
+    if(i > 0)
+      ostr << ",";
+    ostr << "\"" << _memory_usage[i].dev << "\":{";
+    for(std::size_t k = 0; k < num_allocation_kinds; ++k) {
+      const memory_usage& usage = _memory_usage[i].usage[k];
+      if(k > 0)
+        ostr << ",";
+      ostr << "\"" << get_name(static_cast<allocation_kind>(k)) << "\":{"
+           << "\"live_bytes\":" << usage.live_bytes << ","
+           << "\"peak_bytes\":" << usage.peak_bytes << ","
+           << "\"live_allocations\":" << usage.num_live_allocations << ","
+           << "\"allocations\":" << usage.num_allocations << "}";
+    }
+    ostr << "}";
+  }
+  ostr << "}}";
+}
+
+const char* runtime_statistics_snapshot::get_name(allocation_kind kind) {
+  switch(kind) {
+  case allocation_kind::device:
+    return "device";
+  case allocation_kind::optimized_host:
+    return "optimized_host";
+  case allocation_kind::shared:
+    return "shared";
+  case allocation_kind::num_kinds:
+    break;
+  }
+  return "unknown";
+}
+
+const char* runtime_statistics_snapshot::get_name(statistic s) {
+  switch(s) {
+  case statistic::kernel_launches_cuda:
+    return "kernel_launches_cuda";
+  case statistic::kernel_launches_hip:
+    return "kernel_launches_hip";
+  case statistic::kernel_launches_level_zero:
+    return "kernel_launches_level_zero";
+  case statistic::kernel_launches_ocl:
+    return "kernel_launches_ocl";
+  case statistic::kernel_launches_omp:
+    return "kernel_launches_omp";
+  case statistic::kernel_launches_remote:
+    return "kernel_launches_remote";
+  case statistic::kernel_cache_hits:
+    return "kernel_cache_hits";
+  case statistic::kernel_cache_misses:
+    return "kernel_cache_misses";
+  case statistic::persistent_cache_hits:
+    return "persistent_cache_hits";
+  case statistic::persistent_cache_misses:
+    return "persistent_cache_misses";
+  case statistic::jit_compilations:
+    return "jit_compilations";
+  case statistic::jit_compilation_time_ns:
+    return "jit_compilation_time_ns";
+  case statistic::iads_specializations:
+    return "iads_specializations";
+  case statistic::migrated_bytes_host_to_device:
+    return "migrated_bytes_host_to_device";
+  case statistic::migrated_bytes_device_to_host:
+    return "migrated_bytes_device_to_host";
+  case statistic::migrated_bytes_device_to_device:
+    return "migrated_bytes_device_to_device";
+  case statistic::allocated_bytes:
+    return "allocated_bytes";
+  case statistic::live_allocated_bytes:
+    return "live_allocated_bytes";
+  case statistic::cached_dag_nodes:
+    return "cached_dag_nodes";
+  case statistic::flushed_dag_nodes:
+    return "flushed_dag_nodes";
+  case statistic::flushes:
+    return "flushes";
+  case statistic::discard_upgraded_requirements:
+    return "discard_upgraded_requirements";
+  case statistic::reused_buffer_allocations:
+    return "reused_buffer_allocations";
+  case statistic::num_statistics:
+    break;
+  }
+  return "unknown";
+}
+
+runtime_statistics& runtime_statistics::get() {
+  // Never destroyed, since allocations might still be freed during
+  // destruction of static objects.
+  static runtime_statistics* s = new runtime_statistics;
+  return *s;
+}
+
+runtime_statistics::shard& runtime_statistics::get_thread_shard() {
+  thread_local std::size_t shard_index =
+      _num_threads.fetch_add(1, std::memory_order_relaxed) % num_shards;
+  return _shards[shard_index];
+}
+
+runtime_statistics::allocation_shard&
+runtime_statistics::get_allocation_shard(const void* ptr) {
+  return _allocations[std::hash<const void*>{}(ptr) % num_shards];
+}
+
+void runtime_statistics::add_kernel_launch(backend_id b) {
+  switch(b) {
+  case backend_id::cuda:
+    add(statistic::kernel_launches_cuda);
+    break;
+  case backend_id::hip:
+    add(statistic::kernel_launches_hip);
+    break;
+  case backend_id::level_zero:
+    add(statistic::kernel_launches_level_zero);
+    break;
+  case backend_id::ocl:
+    add(statistic::kernel_launches_ocl);
+    break;
+  case backend_id::omp:
+    add(statistic::kernel_launches_omp);
+    break;
+  case backend_id::remote:
+    add(statistic::kernel_launches_remote);
+    break;
+  }
+}
+
+void runtime_statistics::register_allocation(const void *ptr,
+                                             std::size_t bytes, device_id dev,
+                                             allocation_kind kind) {
+  if(!ptr)
+    return;
+  {
+    allocation_shard& s = get_allocation_shard(ptr);
+    std::lock_guard<std::mutex> lock{s.mutex};
+    s.allocations[ptr] = allocation_info{bytes, dev, kind};
+  }
+  {
+    std::lock_guard<std::mutex> lock{_memory_usage_mutex};
+    auto it = _memory_usage.find(dev);
+    if(it == _memory_usage.end())
+      it = _memory_usage.emplace(dev, device_memory_usage{dev, {}}).first;
+    memory_usage& usage = it->second.usage[static_cast<std::size_t>(kind)];
+    usage.live_bytes += bytes;
+    usage.peak_bytes = std::max(usage.peak_bytes, usage.live_bytes);
+    ++usage.num_live_allocations;
+    ++usage.num_allocations;
+  }
+  add(statistic::allocated_bytes, bytes);
+  add(statistic::live_allocated_bytes, bytes);
+}
+
+void runtime_statistics::register_deallocation(const void* ptr) {
+  if(!ptr)
+    return;
+  allocation_info info;
+  {
+    allocation_shard& s = get_allocation_shard(ptr);
+    std::lock_guard<std::mutex> lock{s.mutex};
+    auto it = s.allocations.find(ptr);
+    if(it == s.allocations.end())
+      return;
+    info = it->second;
+    s.allocations.erase(it);
+  }
+  {
+    std::lock_guard<std::mutex> lock{_memory_usage_mutex};
+    memory_usage &usage =
+        _memory_usage[info.dev].usage[static_cast<std::size_t>(info.kind)];
+    usage.live_bytes -= info.bytes;
+    --usage.num_live_allocations;
+  }
+  // Shards are summed up modulo 2^64, so adding the two's complement
+  // decrements the total.
+  add(statistic::live_allocated_bytes, ~static_cast<uint64_t>(info.bytes) + 1);
+}
+
+std::optional<runtime_statistics::allocation_range>
+runtime_statistics::find_allocation(const void *ptr) {
+  const char* p = static_cast<const char*>(ptr);
+  for(allocation_shard& s : _allocations) {
+    std::lock_guard<std::mutex> lock{s.mutex};
+    for(const auto& entry : s.allocations) {
+      const char* base = static_cast<const char*>(entry.first);
+      if(p >= base && p < base + entry.second.bytes)
+        return allocation_range{entry.first, entry.second.bytes,
+                                entry.second.dev, entry.second.kind};
+    }
+  }
+  return {};
+}
+
+device_memory_usage runtime_statistics::get_memory_usage(device_id dev) const {
+  std::lock_guard<std::mutex> lock{_memory_usage_mutex};
+  auto it = _memory_usage.find(dev);
+  if(it == _memory_usage.end())
+    return device_memory_usage{dev, {}};
+  return it->second;
+}
+
+runtime_statistics_snapshot runtime_statistics::get_snapshot() const {
+  runtime_statistics_snapshot snapshot;
+  for(const auto& s : _shards)
+    for(std::size_t i = 0; i < num_runtime_statistics; ++i)
+      snapshot._values[i] += s.values[i].load(std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock{_memory_usage_mutex};
+    for(const auto& entry : _memory_usage)
+      snapshot._memory_usage.push_back(entry.second);
+  }
+  return snapshot;
+}
+
+periodic_statistics_dump::periodic_statistics_dump()
+    : _interval_ms{application::get_settings()
+                       .get<setting::statistics_dump_interval>()},
+      _dump_file{
+          application::get_settings().get<setting::statistics_dump_file>()} {
+  if(_interval_ms == 0)
+    return;
+
+  _thread = std::thread{[this]() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    while(!_condition.wait_for(lock, std::chrono::milliseconds{_interval_ms},
+                               [this]() { return _is_shutting_down; }))
+      dump();
+  }};
+}
+
+periodic_statistics_dump::~periodic_statistics_dump() {
+  if(_interval_ms == 0)
+    return;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _is_shutting_down = true;
+  }
+  _condition.notify_all();
+  _thread.join();
+  dump();
+}
+
+void periodic_statistics_dump::dump() const {
+  runtime_statistics_snapshot snapshot =
+      runtime_statistics::get().get_snapshot();
+  if(_dump_file.empty()) {
+    std::ostream& ostr = common::output_stream::get().get_stream();
+    ostr << "[AdaptiveCpp statistics] ";
+    snapshot.dump(ostr);
+    ostr << std::endl;
+  } else {
+    // Each dump appends one line, such that the file can be followed
+    // by monitoring tools.
+    std::ofstream out{_dump_file, std::ios::app};
+    if(!out.is_open()) {
+      HIPSYCL_DEBUG_ERROR << "runtime_statistics: Could not open "
+                          << _dump_file << " for writing" << std::endl;
+      return;
+    }
+    snapshot.dump(out);
+    out << "\n";
+  }
+}
+
+}
+}
@@ -37,6 +37,9 @@ std::ostream &operator<<(std::ostream &out, const hardware_platform value) {
   case rt::hardware_platform::ocl:
     out << "OpenCL";
     break;
+  case rt::hardware_platform::remote:
+    out << "Remote";
+    break;
   default:
     out << "<unknown>";
     break;
@@ -61,6 +64,9 @@ std::ostream &operator<<(std::ostream &out, const api_platform value) {
   case rt::api_platform::ocl:
     out << "OpenCL";
     break;
+  case rt::api_platform::remote:
+    out << "Remote";
+    break;
   default:
     out << "<unknown>";
     break;
@@ -85,6 +91,9 @@ std::ostream &operator<<(std::ostream &out, const backend_id value) {
   case rt::backend_id::ocl:
     out << "OpenCL";
     break;
+  case rt::backend_id::remote:
+    out << "Remote";
+    break;
   default:
     out << "<unknown>";
     break;
@@ -165,6 +165,8 @@ std::istream &operator>>(std::istream &istr, visibility_mask_t &out) {
       backend = rt::backend_id::omp;
     } else if (name == "ocl" || name == "opencl") {
       backend = rt::backend_id::ocl;
+    } else if (name == "remote") {
+      backend = rt::backend_id::remote;
     } else {
       istr.setstate(std::ios_base::failbit);
       // Don't use HIPSYCL_DEBUG_WARNING, it will cause recursive init error.
@@ -196,5 +198,21 @@ std::istream &operator>>(std::istream &istr, default_selector_behavior& out) {
   return istr;
 }
 
+std::istream &operator>>(std::istream &istr, omp_huge_page_policy& out) {
+  std::string str;
+  istr >> str;
+  if (str == "none")
+    out = omp_huge_page_policy::none;
+  else if (str == "transparent")
+    out = omp_huge_page_policy::transparent;
+  else if (str == "hugetlb" || str == "hugetlb-2m")
+    out = omp_huge_page_policy::hugetlb_2m;
+  else if (str == "hugetlb-1g")
+    out = omp_huge_page_policy::hugetlb_1g;
+  else
+    istr.setstate(std::ios_base::failbit);
+  return istr;
+}
+
 }
 }
\ No newline at end of file
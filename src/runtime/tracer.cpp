@@ -0,0 +1,232 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "hipSYCL/runtime/tracer.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/settings.hpp"
+#include "hipSYCL/common/debug.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+namespace hipsycl {
+namespace rt {
+
+namespace {
+
+void write_json_string(std::ostream& ostr, const char* str) {
+  ostr << '"';
+  for(const char* c = str; *c != '\0'; ++c) {
+    if(*c == '"' || *c == '\\')
+      ostr << '\\' << *c;
+    else if(static_cast<unsigned char>(*c) < 0x20)
+      ostr << ' ';
+    else
+      ostr << *c;
+  }
+  ostr << '"';
+}
+
+// Trace event timestamps are in microseconds
+void write_microseconds(std::ostream& ostr, uint64_t ns) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%llu.%03llu",
+                static_cast<unsigned long long>(ns / 1000),
+                static_cast<unsigned long long>(ns % 1000));
+  ostr << buffer;
+}
+
+const char* get_operation_name(operation* op, const char*& category) {
+  if(auto* kernel_op = dynamic_cast<kernel_operation*>(op)) {
+    category = "kernel";
+    return kernel_op->get_global_kernel_name();
+  } else if(dynamic_cast<memcpy_operation*>(op)) {
+    category = "memcpy";
+    return "memcpy";
+  } else if(dynamic_cast<memset_operation*>(op)) {
+    category = "memset";
+    return "memset";
+  } else if(dynamic_cast<prefetch_operation*>(op)) {
+    category = "prefetch";
+    return "prefetch";
+  }
+  category = "operation";
+  return "operation";
+}
+
+}
+
+tracer::thread_buffer::~thread_buffer() {
+  chunk* c = first.release();
+  while(c) {
+    chunk* next = c->next.load(std::memory_order_acquire);
+    delete c;
+    c = next;
+  }
+}
+
+void tracer::thread_buffer::append(const event& e) {
+  std::size_t size = current->size.load(std::memory_order_relaxed);
+  if(size == chunk_size) {
+    chunk* next = new chunk;
+    current->next.store(next, std::memory_order_release);
+    current = next;
+    size = 0;
+  }
+  current->events[size] = e;
+  current->size.store(size + 1, std::memory_order_release);
+}
+
+tracer& tracer::get() {
+  // Never destroyed, since spans might still be recorded during
+  // destruction of static objects.
+  static tracer* t = new tracer;
+  return *t;
+}
+
+tracer::tracer() {
+  _trace_file = application::get_settings().get<setting::trace_file>();
+  _is_enabled = !_trace_file.empty();
+}
+
+tracer::thread_buffer* tracer::get_thread_buffer() {
+  thread_local thread_buffer* buffer = nullptr;
+  if(!buffer) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _buffers.push_back(std::make_unique<thread_buffer>(_buffers.size()));
+    buffer = _buffers.back().get();
+  }
+  return buffer;
+}
+
+void tracer::record(const event& e) {
+  get_thread_buffer()->append(e);
+}
+
+void tracer::record_host_span(const char *name, const char *category,
+                              profiler_clock::time_point begin,
+                              profiler_clock::time_point end) {
+  if(!_is_enabled)
+    return;
+  record(event{name, category, profiler_clock::ns_ticks(begin),
+               profiler_clock::ns_ticks(end), false, device_id{}, nullptr});
+}
+
+void tracer::record_device_span(const dag_node_ptr& node) {
+  if(!_is_enabled || !node->is_submitted() || node->is_virtual() ||
+     node->is_cancelled())
+    return;
+
+  const auto& node_hints = node->get_execution_hints();
+  if(!node_hints.has_hint<hints::request_instrumentation_start_timestamp>() ||
+     !node_hints.has_hint<hints::request_instrumentation_finish_timestamp>())
+    return;
+
+  operation* op = node->get_operation();
+  if(op->is_requirement())
+    return;
+
+  auto start = op->get_instrumentations()
+                   .get<instrumentations::execution_start_timestamp>();
+  auto finish = op->get_instrumentations()
+                    .get<instrumentations::execution_finish_timestamp>();
+  if(!start || !finish)
+    return;
+
+  const char* category = nullptr;
+  const char* name = get_operation_name(op, category);
+  record(event{name, category,
+               profiler_clock::ns_ticks(start->get_time_point()),
+               profiler_clock::ns_ticks(finish->get_time_point()), true,
+               node->get_assigned_device(),
+               node->get_assigned_execution_lane()});
+}
+
+void tracer::write_trace() const {
+  if(!_is_enabled)
+    return;
+
+  std::ofstream out{_trace_file};
+  if(!out.is_open()) {
+    HIPSYCL_DEBUG_ERROR << "tracer: Could not open trace file " << _trace_file
+                        << " for writing" << std::endl;
+    return;
+  }
+
+  // Devices are shown as separate processes with one thread per
+  // execution lane.
+  std::vector<device_id> devices;
+  std::unordered_map<const void*, std::size_t> lanes;
+  auto get_device_index = [&](device_id dev) -> std::size_t {
+    for(std::size_t i = 0; i < devices.size(); ++i)
+      if(devices[i] == dev)
+        return i;
+    devices.push_back(dev);
+    return devices.size() - 1;
+  };
+
+  std::size_t num_events = 0;
+  out << "{\"traceEvents\":[\n";
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    for(const auto& buffer : _buffers) {
+      for(const thread_buffer::chunk *c = buffer->first.get(); c;
+          c = c->next.load(std::memory_order_acquire)) {
+        std::size_t size = c->size.load(std::memory_order_acquire);
+        for(std::size_t i = 0; i < size; ++i) {
+          const event& e = c->events[i];
+          std::size_t pid = 0;
+          std::size_t tid = buffer->thread_index;
+          if(e.is_device_event) {
+            pid = get_device_index(e.dev) + 1;
+            tid = lanes.emplace(e.lane, lanes.size()).first->second;
+          }
+
+          if(num_events > 0)
+            out << ",\n";
+          out << "{\"name\":";
+          write_json_string(out, e.name);
+          out << ",\"cat\":";
+          write_json_string(out, e.category);
+          out << ",\"ph\":\"X\",\"ts\":";
+          write_microseconds(out, e.begin);
+          out << ",\"dur\":";
+          write_microseconds(out, e.end > e.begin ? e.end - e.begin : 0);
+          out << ",\"pid\":" << pid << ",\"tid\":" << tid << "}";
+          ++num_events;
+        }
+      }
+    }
+  }
+
+  out << (num_events > 0 ? ",\n" : "")
+      << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,"
+         "\"args\":{\"name\":\"AdaptiveCpp host\"}}";
+  for(std::size_t i = 0; i < devices.size(); ++i) {
+    std::stringstream name;
+    devices[i].dump(name);
+    out << ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << i + 1
+        << ",\"args\":{\"name\":";
+    write_json_string(out, name.str().c_str());
+    out << "}}";
+  }
+  out << "\n]}\n";
+
+  HIPSYCL_DEBUG_INFO << "tracer: Wrote " << num_events << " events to "
+                     << _trace_file << std::endl;
+}
+
+}
+}
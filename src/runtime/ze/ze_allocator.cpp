@@ -13,15 +13,17 @@
 #include "hipSYCL/runtime/ze/ze_allocator.hpp"
 #include "hipSYCL/runtime/error.hpp"
 #include "hipSYCL/runtime/util.hpp"
+#include "hipSYCL/runtime/runtime_statistics.hpp"
 
 namespace hipsycl {
 namespace rt {
 
 ze_allocator::ze_allocator(const ze_hardware_context *device,
-                           const ze_hardware_manager *hw_manager)
+                           const ze_hardware_manager *hw_manager,
+                           device_id dev_id)
     : _ctx{device->get_ze_context()}, _dev{device->get_ze_device()},
       _global_mem_ordinal{device->get_ze_global_memory_ordinal()},
-      _hw_manager{hw_manager} {}
+      _hw_manager{hw_manager}, _dev_id{dev_id} {}
 
 void* ze_allocator::allocate(size_t min_alignment, size_t size_bytes) {
   
@@ -44,6 +46,8 @@ void* ze_allocator::allocate(size_t min_alignment, size_t size_bytes) {
     return nullptr; 
   }
 
+  runtime_statistics::get().register_allocation(
+      out, size_bytes, _dev_id, allocation_kind::device);
   return out;
 }
 
@@ -66,10 +70,13 @@ void* ze_allocator::allocate_optimized_host(size_t min_alignment,
     return nullptr;
   }
 
+  runtime_statistics::get().register_allocation(
+      out, bytes, _dev_id, allocation_kind::optimized_host);
   return out;
 }
   
 void ze_allocator::free(void *mem) {
+  runtime_statistics::get().register_deallocation(mem);
   ze_result_t err = zeMemFree(_ctx, mem);
 
   if(err != ZE_RESULT_SUCCESS) {
@@ -107,6 +114,8 @@ void* ze_allocator::allocate_usm(size_t bytes) {
     return nullptr; 
   }
 
+  runtime_statistics::get().register_allocation(
+      out, bytes, _dev_id, allocation_kind::shared);
   return out;
 }
 
@@ -18,6 +18,12 @@
 #include "hipSYCL/runtime/ze/ze_queue.hpp"
 #include "hipSYCL/runtime/backend_loader.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+#include "hipSYCL/compiler/llvm-to-backend/spirv/LLVMToSpirvFactory.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#endif
 
 HIPSYCL_PLUGIN_API_EXPORT
 hipsycl::rt::backend *hipsycl_backend_plugin_create() {
@@ -37,9 +43,26 @@ namespace rt {
 
 namespace {
 
+void register_jit_recipe_compiler() {
+#ifdef HIPSYCL_WITH_SSCP_COMPILER
+  kernel_cache::get()->register_jit_recipe_compiler(
+      backend_id::level_zero,
+      [](const common::db::jit_recipe &recipe,
+         kernel_cache::code_object_id id_of_binary, std::string &out) {
+        std::unique_ptr<compiler::LLVMToBackendTranslator> translator =
+            compiler::createLLVMToSpirvTranslator(recipe.kernels);
+        return glue::jit::precompilation::compile(
+                   translator.get(), recipe, id_of_binary, out)
+            .is_success();
+      });
+#endif
+}
+
 std::unique_ptr<multi_queue_executor>
 create_multi_queue_executor(ze_backend *b, ze_hardware_manager *mgr) {
-  return std::make_unique<multi_queue_executor>(*b, [b, mgr](device_id dev) {
+  // Queue priorities are not supported
+  return std::make_unique<multi_queue_executor>(*b, [b, mgr](device_id dev,
+                                                             int) {
     return std::make_unique<ze_queue>(mgr,
                                       static_cast<std::size_t>(dev.get_id()));
   });
@@ -60,7 +83,7 @@ ze_backend::ze_backend() {
   for(std::size_t i = 0; i < _hardware_manager->get_num_devices(); ++i) {
     _allocators.push_back(ze_allocator{
         static_cast<ze_hardware_context *>(_hardware_manager->get_device(i)),
-        _hardware_manager.get()});
+        _hardware_manager.get(), _hardware_manager->get_device_id(i)});
   }
 
   _executor =
@@ -68,6 +91,8 @@ ze_backend::ze_backend() {
           [this, hw_mgr = _hardware_manager.get()]() {
             return create_multi_queue_executor(this, hw_mgr);
           });
+
+  register_jit_recipe_compiler();
 }
 
 api_platform ze_backend::get_api_platform() const {
@@ -19,6 +19,8 @@
 #include <bits/stdint-uintn.h>
 #include <level_zero/ze_api.h>
 #include <cassert>
+#include <chrono>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -40,11 +42,10 @@ result ze_sscp_code_object_invoker::submit_kernel(
       local_mem_size, args, arg_sizes, num_args, config);
 }
 
-ze_executable_object::ze_executable_object(ze_context_handle_t ctx,
-                                           ze_device_handle_t dev,
-                                           hcf_object_id source,
-                                           ze_source_format fmt,
-                                           const std::string &code_image)
+ze_executable_object::ze_executable_object(
+    ze_context_handle_t ctx, ze_device_handle_t dev, hcf_object_id source,
+    ze_source_format fmt, const std::string &code_image,
+    const std::optional<kernel_configuration::id_type> &native_binary_id)
     : _source{source}, _format{fmt}, _ctx{ctx}, _dev{dev}, _module{nullptr}
 {
 
@@ -67,36 +68,51 @@ ze_executable_object::ze_executable_object(ze_context_handle_t ctx,
   desc.pBuildFlags = nullptr;
   desc.pConstants = nullptr;
 
-  ze_module_build_log_handle_t build_log;
-  ze_result_t err = zeModuleCreate(ctx, dev, &desc, &_module, &build_log);
+  if(native_binary_id.has_value() &&
+     load_native_binary(native_binary_id.value(), desc)) {
+    _build_status = make_success();
+  } else {
+    auto build_start = std::chrono::high_resolution_clock::now();
 
-  if(err != ZE_RESULT_SUCCESS) {
-    std::size_t build_log_size;
-    std::string build_log_content;
-
-    if (zeModuleBuildLogGetString(build_log, &build_log_size, nullptr) ==
-        ZE_RESULT_SUCCESS) {
-      std::vector<char> build_log_buffer(build_log_size);
-      if (zeModuleBuildLogGetString(build_log, &build_log_size,
-                                    build_log_buffer.data()) ==
+    ze_module_build_log_handle_t build_log;
+    ze_result_t err = zeModuleCreate(ctx, dev, &desc, &_module, &build_log);
+
+    if(err != ZE_RESULT_SUCCESS) {
+      std::size_t build_log_size;
+      std::string build_log_content;
+
+      if (zeModuleBuildLogGetString(build_log, &build_log_size, nullptr) ==
           ZE_RESULT_SUCCESS) {
-        build_log_content = std::string{build_log_buffer.data(), build_log_buffer.size()};
+        std::vector<char> build_log_buffer(build_log_size);
+        if (zeModuleBuildLogGetString(build_log, &build_log_size,
+                                      build_log_buffer.data()) ==
+            ZE_RESULT_SUCCESS) {
+          build_log_content = std::string{build_log_buffer.data(), build_log_buffer.size()};
+        }
       }
-    }
 
-    std::string msg = "ze_executable_object: Couldn't create module handle";
-    if(!build_log_content.empty()) {
-      msg += "\nBuild log: ";
-      msg += build_log_content;
+      std::string msg = "ze_executable_object: Couldn't create module handle";
+      if(!build_log_content.empty()) {
+        msg += "\nBuild log: ";
+        msg += build_log_content;
+      }
+      _build_status = register_error(__acpp_here(),
+                     error_info{msg,
+                                error_code{"ze", static_cast<int>(err)}});
+      zeModuleBuildLogDestroy(build_log);
+      return;
+    } else {
+      zeModuleBuildLogDestroy(build_log);
+      _build_status = make_success();
     }
-    _build_status = register_error(__acpp_here(),
-                   error_info{msg,
-                              error_code{"ze", static_cast<int>(err)}});
-    zeModuleBuildLogDestroy(build_log);
-    return;
-  } else {
-    zeModuleBuildLogDestroy(build_log);
-    _build_status = make_success();
+
+    auto build_end = std::chrono::high_resolution_clock::now();
+    if(native_binary_id.has_value())
+      store_native_binary(
+          native_binary_id.value(),
+          std::chrono::duration_cast<std::chrono::nanoseconds>(build_end -
+                                                               build_start)
+              .count());
   }
 
   HIPSYCL_DEBUG_INFO << "ze_executable_object: Successfully created module "
@@ -104,7 +120,7 @@ ze_executable_object::ze_executable_object(ze_context_handle_t ctx,
                      << code_image.size() << std::endl;
 
   uint32_t num_kernels = 0;
-  err = zeModuleGetKernelNames(_module, &num_kernels, nullptr);
+  ze_result_t err = zeModuleGetKernelNames(_module, &num_kernels, nullptr);
   if (err != ZE_RESULT_SUCCESS) {
     register_error(
         __acpp_here(),
@@ -130,7 +146,124 @@ ze_executable_object::ze_executable_object(ze_context_handle_t ctx,
   load_kernel_handles();  
 }
 
+ze_kernel_instance::ze_kernel_instance(ze_kernel_handle_t handle,
+                                       std::string_view kernel_name)
+    : _handle{handle}, _kernel_name{kernel_name} {}
+
+result ze_kernel_instance::set_group_size(const rt::range<3> &group_size) {
+  uint32_t new_group_size[3] = {static_cast<uint32_t>(group_size[0]),
+                                static_cast<uint32_t>(group_size[1]),
+                                static_cast<uint32_t>(group_size[2])};
+  if(std::equal(new_group_size, new_group_size + 3, _group_size))
+    return make_success();
+
+  ze_result_t err = zeKernelSetGroupSize(_handle, new_group_size[0],
+                                         new_group_size[1], new_group_size[2]);
+  if(err != ZE_RESULT_SUCCESS) {
+    std::fill(_group_size, _group_size + 3, 0);
+    return make_error(
+        __acpp_here(),
+        error_info{"ze_kernel_instance: Could not set kernel group size",
+                   error_code{"ze", static_cast<int>(err)}});
+  }
+  std::copy(new_group_size, new_group_size + 3, _group_size);
+  return make_success();
+}
+
+result ze_kernel_instance::set_argument(std::size_t index, std::size_t size,
+                                        const void *value) {
+  if(index >= _arguments.size())
+    _arguments.resize(index + 1);
+
+  argument& arg = _arguments[index];
+  if (arg.is_set && arg.value.size() == size && arg.is_null == !value &&
+      (!value || std::memcmp(arg.value.data(), value, size) == 0))
+    return make_success();
+
+  ze_result_t err = zeKernelSetArgumentValue(
+      _handle, static_cast<uint32_t>(index), static_cast<uint32_t>(size),
+      value);
+  if(err != ZE_RESULT_SUCCESS) {
+    arg.is_set = false;
+    return make_error(
+        __acpp_here(),
+        error_info{"ze_kernel_instance: Could not set kernel argument",
+                   error_code{"ze", static_cast<int>(err)}});
+  }
+
+  arg.is_set = true;
+  arg.is_null = !value;
+  arg.value.resize(size);
+  if(value)
+    std::memcpy(arg.value.data(), value, size);
+  return make_success();
+}
+
+bool ze_executable_object::load_native_binary(
+    const kernel_configuration::id_type &native_binary_id,
+    const ze_module_desc_t &spirv_desc) {
+  std::string native_binary;
+  if(!kernel_cache::get()->persistent_native_binary_lookup(native_binary_id,
+                                                           native_binary))
+    return false;
+
+  ze_module_desc_t desc = spirv_desc;
+  desc.format = ZE_MODULE_FORMAT_NATIVE;
+  desc.inputSize = native_binary.size();
+  desc.pInputModule = reinterpret_cast<const uint8_t *>(native_binary.data());
+
+  ze_result_t err = zeModuleCreate(_ctx, _dev, &desc, &_module, nullptr);
+  if(err != ZE_RESULT_SUCCESS) {
+    // This can happen e.g. if the driver rejects binaries of other builds
+    HIPSYCL_DEBUG_WARNING << "ze_executable_object: Could not create module "
+                             "from cached native binary ("
+                          << static_cast<int>(err)
+                          << "), building from SPIR-V instead" << std::endl;
+    _module = nullptr;
+    return false;
+  }
+
+  HIPSYCL_DEBUG_INFO << "ze_executable_object: Created module from cached "
+                        "native binary of size "
+                     << native_binary.size() << std::endl;
+  return true;
+}
+
+void ze_executable_object::store_native_binary(
+    const kernel_configuration::id_type &native_binary_id,
+    uint64_t build_time) {
+  std::size_t size = 0;
+  ze_result_t err = zeModuleGetNativeBinary(_module, &size, nullptr);
+  if(err != ZE_RESULT_SUCCESS || size == 0) {
+    HIPSYCL_DEBUG_INFO << "ze_executable_object: Native module binary is not "
+                          "available, not caching it"
+                       << std::endl;
+    return;
+  }
+
+  std::string native_binary(size, '\0');
+  err = zeModuleGetNativeBinary(
+      _module, &size, reinterpret_cast<uint8_t *>(native_binary.data()));
+  if(err != ZE_RESULT_SUCCESS)
+    return;
+  native_binary.resize(size);
+
+  kernel_cache::get()->persistent_native_binary_store(native_binary_id,
+                                                      native_binary, build_time);
+}
+
 ze_executable_object::~ze_executable_object() {
+  for(auto& pool : _kernel_pools) {
+    for(auto& instance : pool.second.instances) {
+      ze_result_t err = zeKernelDestroy(instance->get_handle());
+      if(err != ZE_RESULT_SUCCESS) {
+        register_error(__acpp_here(),
+                   error_info{"ze_executable_object: Couldn't destroy kernel handle",
+                              error_code{"ze", static_cast<int>(err)}});
+      }
+    }
+  }
+
   if(_module) {
     ze_result_t err = zeModuleDestroy(_module);
     if(err != ZE_RESULT_SUCCESS) {
@@ -190,41 +323,83 @@ ze_context_handle_t ze_executable_object::get_ze_context() const {
   return _ctx;
 }
 
-result ze_executable_object::get_kernel(std::string_view kernel_name,
-                                        ze_kernel_handle_t &out) const {
+result ze_executable_object::acquire_kernel(std::string_view kernel_name,
+                                            ze_kernel_instance *&out) const {
   assert(_module);
 
-  auto k = _kernel_handles.find(kernel_name);
-  if(k != _kernel_handles.end()) {
-    out = k->second;
-    HIPSYCL_DEBUG_INFO << "ze_executable_object: Found cached kernel: " << kernel_name
-                    << std::endl;
-    return make_success();
+  std::lock_guard<std::mutex> lock{_kernel_pool_mutex};
+
+  auto pool = _kernel_pools.find(kernel_name);
+  if(pool == _kernel_pools.end())
+    return make_error(__acpp_here(),
+                      error_info{"ze_executable_object: acquire_kernel(): "
+                                 "Attempted to access kernels that is "
+                                 "unavailable"});
+
+  if(pool->second.available.empty()) {
+    // All instances are currently used by other submissions
+    result err = create_kernel_instance(pool->first, pool->second);
+    if(!err.is_success())
+      return err;
+  }
+
+  out = pool->second.available.back();
+  pool->second.available.pop_back();
+  return make_success();
+}
+
+void ze_executable_object::release_kernel(ze_kernel_instance *kernel) const {
+  std::lock_guard<std::mutex> lock{_kernel_pool_mutex};
+
+  auto pool = _kernel_pools.find(kernel->get_kernel_name());
+  assert(pool != _kernel_pools.end());
+  pool->second.available.push_back(kernel);
+}
+
+result ze_executable_object::create_kernel_instance(std::string_view name,
+                                                    kernel_pool &pool) const {
+  // name always refers to an entry of _kernels, which is null-terminated
+  ze_kernel_desc_t desc;
+  desc.stype = ZE_STRUCTURE_TYPE_KERNEL_DESC;
+  desc.pNext = nullptr;
+  desc.flags = 0;
+  desc.pKernelName = name.data();
+
+  ze_kernel_handle_t kernel;
+  ze_result_t err = zeKernelCreate(_module, &desc, &kernel);
+  if(err != ZE_RESULT_SUCCESS)
+    return make_error(__acpp_here(),
+                      error_info{"ze_executable_object: Couldn't create kernel",
+                                 error_code{"ze", static_cast<int>(err)}});
+
+  // This is necessary for USM pointers, which hipSYCL *always*
+  // relies on.
+  err = zeKernelSetIndirectAccess(kernel,
+                                  ZE_KERNEL_INDIRECT_ACCESS_FLAG_HOST |
+                                  ZE_KERNEL_INDIRECT_ACCESS_FLAG_DEVICE |
+                                  ZE_KERNEL_INDIRECT_ACCESS_FLAG_SHARED);
+  if(err != ZE_RESULT_SUCCESS) {
+    zeKernelDestroy(kernel);
+    return make_error(
+        __acpp_here(),
+        error_info{"ze_executable_object: Could not set indirect access flags",
+                   error_code{"ze", static_cast<int>(err)}});
   }
 
-  return make_error(__acpp_here(),
-                    error_info{"ze_executable_object: get_kernel(): Attempted "
-                               "to access kernels that is unavailable"});
+  pool.instances.push_back(std::make_unique<ze_kernel_instance>(kernel, name));
+  pool.available.push_back(pool.instances.back().get());
+
+  HIPSYCL_DEBUG_INFO << "ze_executable_object: Constructed kernel instance "
+                     << pool.instances.size() << " of " << name << std::endl;
+  return make_success();
 }
 
 void ze_executable_object::load_kernel_handles() {
   for(const auto& kernel_name : _kernels) {
-    ze_kernel_desc_t desc;
-    desc.stype = ZE_STRUCTURE_TYPE_KERNEL_DESC;
-    desc.pNext = nullptr;
-    desc.flags = 0;
-    desc.pKernelName = kernel_name.c_str();
-
-    ze_kernel_handle_t kernel;
-    ze_result_t err = zeKernelCreate(_module, &desc, &kernel);
-
-    if(err == ZE_RESULT_SUCCESS) {
-      _kernel_handles[kernel_name] = kernel;
-    
-      HIPSYCL_DEBUG_INFO
-          << "ze_executable_object: Constructed new kernel for cache: "
-          << kernel_name << std::endl;
-    }
+    std::string_view name = kernel_name;
+    kernel_pool pool;
+    if(create_kernel_instance(name, pool).is_success())
+      _kernel_pools[name] = std::move(pool);
   }
 }
 
@@ -232,9 +407,10 @@ void ze_executable_object::load_kernel_handles() {
 ze_sscp_executable_object::ze_sscp_executable_object(ze_context_handle_t ctx, ze_device_handle_t dev,
                           hcf_object_id source,
                           const std::string &spirv_image,
-                          const kernel_configuration &config)
+                          const kernel_configuration &config,
+                          const kernel_configuration::id_type &native_binary_id)
     : ze_executable_object(ctx, dev, source, ze_source_format::spirv,
-                            spirv_image),
+                            spirv_image, native_binary_id),
       _id{config.generate_id()} {}
 
 
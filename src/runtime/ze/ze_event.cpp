@@ -11,14 +11,21 @@
 #include <level_zero/ze_api.h>
 
 #include "hipSYCL/runtime/ze/ze_event.hpp"
+#include "hipSYCL/runtime/ze/ze_queue.hpp"
 #include "hipSYCL/runtime/error.hpp"
 
 namespace hipsycl {
 namespace rt {
 
+void ze_command_batch::ensure_submitted() {
+  if(!is_submitted())
+    _queue->submit_batch(this);
+}
+
 ze_node_event::ze_node_event(ze_event_handle_t evt,
-                             std::shared_ptr<ze_event_pool_handle_t> pool)
-    : _evt{evt}, _pool{pool} {}
+                             std::shared_ptr<ze_event_pool_handle_t> pool,
+                             std::shared_ptr<ze_command_batch> batch)
+    : _evt{evt}, _pool{pool}, _batch{batch} {}
 
 ze_node_event::~ze_node_event() {
   ze_result_t err = zeEventDestroy(_evt);
@@ -31,6 +38,7 @@ ze_node_event::~ze_node_event() {
 }
 
 bool ze_node_event::is_complete() const {
+  ensure_submitted();
   ze_result_t err = zeEventQueryStatus(_evt);
 
   if(err != ZE_RESULT_SUCCESS && err != ZE_RESULT_NOT_READY) {
@@ -43,6 +51,7 @@ bool ze_node_event::is_complete() const {
 }
 
 void ze_node_event::wait() {
+  ensure_submitted();
 
   ze_result_t err = zeEventHostSynchronize(_evt, UINT64_MAX);
 
@@ -61,6 +70,11 @@ ze_event_handle_t ze_node_event::request_backend_event() {
   return get_event_handle();
 }
 
+void ze_node_event::ensure_submitted() const {
+  if(_batch)
+    _batch->ensure_submitted();
+}
+
 }
 }
 
@@ -197,6 +197,32 @@ ze_hardware_context::ze_hardware_context(ze_driver_handle_t driver,
                              error_code{"ze", static_cast<int>(err)}});
     }
   }
+
+  uint32_t num_queue_groups = 0;
+  err = zeDeviceGetCommandQueueGroupProperties(_device, &num_queue_groups,
+                                               nullptr);
+  if(err != ZE_RESULT_SUCCESS) {
+    print_error(__acpp_here(),
+                  error_info{"ze_hardware_context: Could not query number of command queue groups",
+                             error_code{"ze", static_cast<int>(err)}});
+    num_queue_groups = 0;
+  }
+  if(num_queue_groups > 0) {
+    _queue_group_props.resize(num_queue_groups);
+    for(auto& props : _queue_group_props) {
+      props.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_GROUP_PROPERTIES;
+      props.pNext = nullptr;
+    }
+
+    err = zeDeviceGetCommandQueueGroupProperties(_device, &num_queue_groups,
+                                                 _queue_group_props.data());
+    if(err != ZE_RESULT_SUCCESS) {
+      print_error(__acpp_here(),
+                  error_info{"ze_hardware_context: Could not query command queue group properties",
+                             error_code{"ze", static_cast<int>(err)}});
+      _queue_group_props.clear();
+    }
+  }
 }
 
 bool ze_hardware_context::is_cpu() const {
@@ -431,6 +457,15 @@ std::size_t ze_hardware_context::get_property(device_uint_property prop) const {
   case device_uint_property::global_mem_size:
     return _props.maxMemAllocSize; // TODO Is this correct?
     break;
+  case device_uint_property::peak_memory_bandwidth:
+    if(!_memory_props.empty()) {
+      const auto& mem_props = _memory_props[get_ze_global_memory_ordinal()];
+      // maxClockRate is in MHz, maxBusWidth in bits
+      return static_cast<std::size_t>(mem_props.maxClockRate) * 1000000 *
+             (mem_props.maxBusWidth / 8);
+    }
+    return 0;
+    break;
   case device_uint_property::max_constant_buffer_size:
     return 0; // TODO
     break;
@@ -465,6 +500,9 @@ ze_hardware_context::get_property(device_uint_list_property prop) const {
       return result;
     }
     break;
+  case device_uint_list_property::peer_access_devices:
+    return std::vector<std::size_t>{};
+    break;
   }
 
   assert(false && "Invalid device property");
@@ -505,6 +543,25 @@ uint32_t ze_hardware_context::get_ze_global_memory_ordinal() const {
   return result;
 }
 
+uint32_t ze_hardware_context::get_ze_compute_queue_ordinal() const {
+  for(std::size_t i = 0; i < _queue_group_props.size(); ++i) {
+    if(_queue_group_props[i].flags &
+       ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE)
+      return static_cast<uint32_t>(i);
+  }
+  return 0;
+}
+
+std::optional<uint32_t> ze_hardware_context::get_ze_copy_queue_ordinal() const {
+  for(std::size_t i = 0; i < _queue_group_props.size(); ++i) {
+    const auto flags = _queue_group_props[i].flags;
+    if((flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COPY) &&
+       !(flags & ZE_COMMAND_QUEUE_GROUP_PROPERTY_FLAG_COMPUTE))
+      return static_cast<uint32_t>(i);
+  }
+  return {};
+}
+
 ze_hardware_manager::ze_hardware_manager() {
 
   if (has_device_visibility_mask(
@@ -18,6 +18,7 @@
 #include "hipSYCL/common/hcf_container.hpp"
 #include "hipSYCL/runtime/kernel_configuration.hpp"
 #include "hipSYCL/runtime/adaptivity_engine.hpp"
+#include "hipSYCL/runtime/application.hpp"
 #include "hipSYCL/runtime/code_object_invoker.hpp"
 #include "hipSYCL/runtime/device_id.hpp"
 #include "hipSYCL/runtime/error.hpp"
@@ -30,6 +31,7 @@
 #include "hipSYCL/runtime/ze/ze_event.hpp"
 #include "hipSYCL/runtime/util.hpp"
 #include "hipSYCL/runtime/queue_completion_event.hpp"
+#include "hipSYCL/runtime/settings.hpp"
 #include "hipSYCL/common/spin_lock.hpp"
 
 #ifdef HIPSYCL_WITH_SSCP_COMPILER
@@ -44,8 +46,31 @@ namespace rt {
 
 namespace {
 
+// Level Zero reports neither registers nor occupancy.
+common::db::kernel_resource_usage_entry
+query_kernel_resource_usage(const ze_sscp_executable_object *obj,
+                            std::string_view kernel_name) {
+  common::db::kernel_resource_usage_entry usage;
+  usage.kernel_name = std::string{kernel_name};
+
+  ze_kernel_instance *kernel = nullptr;
+  if(!obj->acquire_kernel(kernel_name, kernel).is_success())
+    return usage;
+
+  ze_kernel_properties_t props{};
+  props.stype = ZE_STRUCTURE_TYPE_KERNEL_PROPERTIES;
+  if(zeKernelGetProperties(kernel->get_handle(), &props) == ZE_RESULT_SUCCESS) {
+    usage.spill_bytes = props.spillMemSize;
+    usage.private_mem_bytes = props.privateMemSize;
+    usage.local_mem_bytes = props.localMemSize;
+    usage.max_group_size =
+        static_cast<uint64_t>(props.maxSubgroupSize) * props.maxNumSubgroups;
+  }
+  obj->release_kernel(kernel);
+  return usage;
+}
 
-result submit_ze_kernel(ze_kernel_handle_t kernel,
+result submit_ze_kernel(ze_kernel_instance &kernel,
                         ze_command_list_handle_t command_list,
                         ze_event_handle_t completion_evt,
                         const std::vector<ze_event_handle_t>& wait_events, 
@@ -59,16 +84,9 @@ result submit_ze_kernel(ze_kernel_handle_t kernel,
   HIPSYCL_DEBUG_INFO << "ze_queue: Configuring kernel launch for group size "
                      << group_size[0] << " " << group_size[1] << " "
                      << group_size[2] << std::endl;
-  ze_result_t err =
-      zeKernelSetGroupSize(kernel, static_cast<uint32_t>(group_size[0]),
-                           static_cast<uint32_t>(group_size[1]),
-                           static_cast<uint32_t>(group_size[2]));
-  if(err != ZE_RESULT_SUCCESS) {
-    return make_error(
-        __acpp_here(),
-        error_info{"ze_module_invoker: Could not set kernel group size",
-                   error_code{"ze", static_cast<int>(err)}});
-  }
+  result res = kernel.set_group_size(group_size);
+  if(!res.is_success())
+    return res;
 
   HIPSYCL_DEBUG_INFO << "ze_queue: Configuring kernel launch for group count "
                      << num_groups[0] << " " << num_groups[1] << " "
@@ -95,37 +113,17 @@ result submit_ze_kernel(ze_kernel_handle_t kernel,
       // in as values at kernel_args[i] - it validates that those are non-null.
       // So instead, we need to set the argument to zeKernelSetArgumentValue
       // to null.
-      err = zeKernelSetArgumentValue(
-          kernel, i, static_cast<uint32_t>(arg_sizes[i]), nullptr);
+      res = kernel.set_argument(i, arg_sizes[i], nullptr);
     } else {
-      err = zeKernelSetArgumentValue(
-          kernel, i, static_cast<uint32_t>(arg_sizes[i]), kernel_args[i]);
-    }
-    if(err != ZE_RESULT_SUCCESS) {
-      return make_error(
-          __acpp_here(),
-          error_info{"ze_module_invoker: Could not set kernel argument",
-                     error_code{"ze", static_cast<int>(err)}});
+      res = kernel.set_argument(i, arg_sizes[i], kernel_args[i]);
     }
-  }
-
-  // This is necessary for USM pointers, which hipSYCL *always*
-  // relies on.
-  err = zeKernelSetIndirectAccess(kernel,
-                                  ZE_KERNEL_INDIRECT_ACCESS_FLAG_HOST |
-                                  ZE_KERNEL_INDIRECT_ACCESS_FLAG_DEVICE |
-                                  ZE_KERNEL_INDIRECT_ACCESS_FLAG_SHARED);
-
-  if(err != ZE_RESULT_SUCCESS) {
-    return make_error(
-          __acpp_here(),
-          error_info{"ze_module_invoker: Could not set indirect access flags",
-                     error_code{"ze", static_cast<int>(err)}});
+    if(!res.is_success())
+      return res;
   }
 
   HIPSYCL_DEBUG_INFO << "ze_module_invoker: Submitting kernel!" << std::endl;
-  err = zeCommandListAppendLaunchKernel(
-      command_list, kernel, &group_count, completion_evt,
+  ze_result_t err = zeCommandListAppendLaunchKernel(
+      command_list, kernel.get_handle(), &group_count, completion_evt,
       static_cast<uint32_t>(wait_events.size()),
       const_cast<ze_event_handle_t *>(wait_events.data()));
 
@@ -141,6 +139,10 @@ result submit_ze_kernel(ze_kernel_handle_t kernel,
 
 }
 
+// In batched mode, a batch is submitted once it contains this many commands,
+// or earlier if the previously submitted batches have completed.
+constexpr std::size_t max_commands_per_batch = 64;
+
 ze_queue::ze_queue(ze_hardware_manager *hw_manager, std::size_t device_index)
     : _hw_manager{hw_manager}, _device_index{device_index},
       _sscp_code_object_invoker{this},
@@ -152,40 +154,267 @@ ze_queue::ze_queue(ze_hardware_manager *hw_manager, std::size_t device_index)
   
   assert(hw_context);
 
+  _is_batched =
+      application::get_settings().get<setting::ze_batched_command_lists>();
+  if(_is_batched)
+    _current_batch = std::make_shared<ze_command_batch>(this);
+
+  init_engine(_compute_engine, hw_context->get_ze_compute_queue_ordinal());
+
+  _has_copy_engine = false;
+  auto copy_ordinal = hw_context->get_ze_copy_queue_ordinal();
+  if(copy_ordinal.has_value() &&
+     application::get_settings().get<setting::ze_copy_engine>()) {
+    _has_copy_engine =
+        init_engine(_copy_engine, copy_ordinal.value()).is_success();
+    if(_has_copy_engine) {
+      HIPSYCL_DEBUG_INFO << "ze_queue: Using command queue group "
+                         << copy_ordinal.value() << " for memory copies"
+                         << std::endl;
+    }
+  }
+}
+
+ze_queue::~ze_queue() {
+  if(_is_batched) {
+    std::lock_guard<std::mutex> lock{_mutex};
+    submit_current_batch();
+  }
+
+  destroy_engine(_compute_engine);
+  if(_has_copy_engine)
+    destroy_engine(_copy_engine);
+}
+
+result ze_queue::init_engine(engine &e, uint32_t ordinal) {
+  ze_hardware_context *hw_context =
+      cast<ze_hardware_context>(_hw_manager->get_device(_device_index));
+
+  e.ordinal = ordinal;
+
   ze_command_queue_desc_t desc;
   desc.stype = ZE_STRUCTURE_TYPE_COMMAND_QUEUE_DESC;
   desc.pNext = nullptr;
-  desc.ordinal = 0; // TODO: Query command queue groups and select
-                    // appropriate group
+  desc.ordinal = ordinal;
   desc.index = 0;
   desc.flags = ZE_COMMAND_QUEUE_FLAG_EXPLICIT_ONLY;
   desc.mode  = ZE_COMMAND_QUEUE_MODE_ASYNCHRONOUS; 
   desc.priority = ZE_COMMAND_QUEUE_PRIORITY_NORMAL;
 
-  ze_result_t err = zeCommandListCreateImmediate(hw_context->get_ze_context(),
-                                                 hw_context->get_ze_device(),
-                                                 &desc, &_command_list);
+  if(!_is_batched) {
+    ze_result_t err = zeCommandListCreateImmediate(
+        hw_context->get_ze_context(), hw_context->get_ze_device(), &desc,
+        &e.current.list);
 
+    if(err != ZE_RESULT_SUCCESS) {
+      return register_error(
+          __acpp_here(),
+          error_info{"ze_queue: Could not create immediate command list",
+                     error_code{"ze", static_cast<int>(err)}});
+    }
+    return make_success();
+  }
+
+  ze_result_t err =
+      zeCommandQueueCreate(hw_context->get_ze_context(),
+                           hw_context->get_ze_device(), &desc, &e.command_queue);
   if(err != ZE_RESULT_SUCCESS) {
-    register_error(
+    return register_error(
         __acpp_here(),
-        error_info{"ze_queue: Could not create immediate command list",
+        error_info{"ze_queue: Could not create command queue",
                    error_code{"ze", static_cast<int>(err)}});
   }
+
+  return obtain_command_list(e, e.current);
 }
 
-ze_queue::~ze_queue() {
+void ze_queue::destroy_engine(engine &e) {
+  if(_is_batched && e.command_queue) {
+    ze_result_t err = zeCommandQueueSynchronize(e.command_queue, UINT64_MAX);
+    if(err != ZE_RESULT_SUCCESS) {
+      register_error(
+          __acpp_here(),
+          error_info{"ze_queue: Could not synchronize command queue",
+                     error_code{"ze", static_cast<int>(err)}});
+    }
+  }
+
+  auto destroy_slot = [](command_list_slot& slot){
+    if(slot.fence)
+      zeFenceDestroy(slot.fence);
+    if(slot.list) {
+      ze_result_t err = zeCommandListDestroy(slot.list);
+      if(err != ZE_RESULT_SUCCESS) {
+        register_error(
+            __acpp_here(),
+            error_info{"ze_queue: Could not destroy command list",
+                       error_code{"ze", static_cast<int>(err)}});
+      }
+    }
+  };
 
-  ze_result_t err = zeCommandListDestroy(_command_list);
+  destroy_slot(e.current);
+  for(auto& slot : e.in_flight_lists)
+    destroy_slot(slot);
+  for(auto& slot : e.free_lists)
+    destroy_slot(slot);
+
+  if(e.command_queue) {
+    ze_result_t err = zeCommandQueueDestroy(e.command_queue);
+    if(err != ZE_RESULT_SUCCESS) {
+      register_error(
+          __acpp_here(),
+          error_info{"ze_queue: Could not destroy command queue",
+                     error_code{"ze", static_cast<int>(err)}});
+    }
+  }
+}
+
+result ze_queue::obtain_command_list(engine &e, command_list_slot &out) {
+  retire_completed_command_lists(e);
+  if(!e.free_lists.empty()) {
+    out = e.free_lists.back();
+    e.free_lists.pop_back();
+    return make_success();
+  }
+
+  ze_hardware_context *hw_context =
+      cast<ze_hardware_context>(_hw_manager->get_device(_device_index));
+
+  ze_command_list_desc_t list_desc;
+  list_desc.stype = ZE_STRUCTURE_TYPE_COMMAND_LIST_DESC;
+  list_desc.pNext = nullptr;
+  list_desc.commandQueueGroupOrdinal = e.ordinal;
+  list_desc.flags = 0;
+
+  command_list_slot slot;
+  ze_result_t err =
+      zeCommandListCreate(hw_context->get_ze_context(),
+                          hw_context->get_ze_device(), &list_desc, &slot.list);
   if(err != ZE_RESULT_SUCCESS) {
-    register_error(
+    return register_error(
         __acpp_here(),
-        error_info{"ze_queue: Could not destroy immediate command list",
+        error_info{"ze_queue: Could not create command list",
                    error_code{"ze", static_cast<int>(err)}});
   }
+
+  ze_fence_desc_t fence_desc;
+  fence_desc.stype = ZE_STRUCTURE_TYPE_FENCE_DESC;
+  fence_desc.pNext = nullptr;
+  fence_desc.flags = 0;
+  err = zeFenceCreate(e.command_queue, &fence_desc, &slot.fence);
+  if(err != ZE_RESULT_SUCCESS) {
+    zeCommandListDestroy(slot.list);
+    return register_error(
+        __acpp_here(),
+        error_info{"ze_queue: Could not create fence",
+                   error_code{"ze", static_cast<int>(err)}});
+  }
+
+  out = slot;
+  return make_success();
+}
+
+void ze_queue::retire_completed_command_lists(engine &e) {
+  for(std::size_t i = 0; i < e.in_flight_lists.size();) {
+    command_list_slot slot = e.in_flight_lists[i];
+    if(zeFenceQueryStatus(slot.fence) == ZE_RESULT_SUCCESS &&
+       zeCommandListReset(slot.list) == ZE_RESULT_SUCCESS &&
+       zeFenceReset(slot.fence) == ZE_RESULT_SUCCESS) {
+      e.free_lists.push_back(slot);
+      e.in_flight_lists[i] = e.in_flight_lists.back();
+      e.in_flight_lists.pop_back();
+    } else {
+      ++i;
+    }
+  }
+}
+
+ze_queue::engine &ze_queue::get_copy_engine() {
+  return _has_copy_engine ? _copy_engine : _compute_engine;
+}
+
+result ze_queue::notify_command_recorded(engine &e) {
+  if(!_is_batched)
+    return make_success();
+
+  ++e.num_recorded_commands;
+
+  std::size_t num_batch_commands = _compute_engine.num_recorded_commands;
+  if(_has_copy_engine)
+    num_batch_commands += _copy_engine.num_recorded_commands;
+
+  if(num_batch_commands >= max_commands_per_batch)
+    return submit_current_batch();
+
+  // Don't let the device idle while we are recording commands
+  retire_completed_command_lists(_compute_engine);
+  bool is_idle = _compute_engine.in_flight_lists.empty();
+  if(_has_copy_engine) {
+    retire_completed_command_lists(_copy_engine);
+    is_idle = is_idle && _copy_engine.in_flight_lists.empty();
+  }
+  if(is_idle)
+    return submit_current_batch();
+
+  return make_success();
+}
+
+result ze_queue::submit_current_batch() {
+  if(!_is_batched)
+    return make_success();
+
+  auto submit = [this](engine& e) -> result {
+    if(e.num_recorded_commands == 0)
+      return make_success();
+
+    ze_result_t err = zeCommandListClose(e.current.list);
+    if(err != ZE_RESULT_SUCCESS) {
+      return make_error(
+          __acpp_here(),
+          error_info{"ze_queue: zeCommandListClose() failed",
+                     error_code{"ze", static_cast<int>(err)}});
+    }
+    err = zeCommandQueueExecuteCommandLists(e.command_queue, 1,
+                                            &e.current.list, e.current.fence);
+    if(err != ZE_RESULT_SUCCESS) {
+      return make_error(
+          __acpp_here(),
+          error_info{"ze_queue: zeCommandQueueExecuteCommandLists() failed",
+                     error_code{"ze", static_cast<int>(err)}});
+    }
+    HIPSYCL_DEBUG_INFO << "ze_queue: Submitted batch of "
+                       << e.num_recorded_commands
+                       << " commands to command queue group " << e.ordinal
+                       << std::endl;
+
+    e.in_flight_lists.push_back(e.current);
+    e.num_recorded_commands = 0;
+    return obtain_command_list(e, e.current);
+  };
+
+  // Copies may wait for kernels of the same batch and vice versa, so
+  // the lists of both engines are submitted together.
+  result res = submit(_compute_engine);
+  if(res.is_success() && _has_copy_engine)
+    res = submit(_copy_engine);
+
+  _current_batch->mark_submitted();
+  _current_batch = std::make_shared<ze_command_batch>(this);
+  return res;
 }
 
-std::shared_ptr<dag_node_event> ze_queue::create_event() {
+void ze_queue::submit_batch(ze_command_batch *batch) {
+  std::lock_guard<std::mutex> lock{_mutex};
+  if(_current_batch.get() == batch) {
+    result res = submit_current_batch();
+    if(!res.is_success())
+      register_error(res);
+  }
+}
+
+std::shared_ptr<dag_node_event>
+ze_queue::create_event(bool is_recorded_command) {
 
   ze_event_handle_t evt;
   ze_event_desc_t desc;
@@ -213,7 +442,8 @@ std::shared_ptr<dag_node_event> ze_queue::create_event() {
     return nullptr;
   }
 
-  return std::make_shared<ze_node_event>(evt, pool);
+  return std::make_shared<ze_node_event>(
+      evt, pool, is_recorded_command ? _current_batch : nullptr);
 }
 
 std::shared_ptr<dag_node_event> ze_queue::create_queue_completion_event() {
@@ -226,7 +456,7 @@ std::shared_ptr<dag_node_event> ze_queue::insert_event() {
   std::lock_guard<std::mutex> lock{_mutex};
 
   if(!_last_submitted_op_event) {
-    auto evt = create_event();
+    auto evt = create_event(false);
     ze_result_t err = zeEventHostSignal(
         static_cast<ze_node_event *>(evt.get())->get_event_handle());
     return evt;
@@ -269,9 +499,11 @@ result ze_queue::submit_memcpy(memcpy_operation& op, const dag_node_ptr& node) {
   std::shared_ptr<dag_node_event> completion_evt = create_event();
   std::vector<ze_event_handle_t> wait_events = get_enqueued_event_handles();
 
+  engine& copy_engine = get_copy_engine();
   if(dimension == 1) {
     ze_result_t err = zeCommandListAppendMemoryCopy(
-        _command_list, op.dest().get_access_ptr(), op.source().get_access_ptr(),
+        copy_engine.current.list, op.dest().get_access_ptr(),
+        op.source().get_access_ptr(),
         op.get_num_transferred_bytes(),
         static_cast<ze_node_event *>(completion_evt.get())->get_event_handle(),
         static_cast<uint32_t>(wait_events.size()), wait_events.data());
@@ -282,6 +514,8 @@ result ze_queue::submit_memcpy(memcpy_operation& op, const dag_node_ptr& node) {
           error_info{"ze_queue: zeCommandListAppendMemoryCopy() failed",
                      error_code{"ze", static_cast<int>(err)}});
     }
+    register_submitted_op(completion_evt);
+    return notify_command_recorded(copy_engine);
   } else {
     return make_error(
         __acpp_here(),
@@ -289,9 +523,6 @@ result ze_queue::submit_memcpy(memcpy_operation& op, const dag_node_ptr& node) {
             "ze_queue: Multidimensional memory copies are not yet supported.",
             error_type::unimplemented});
   }
-
-  register_submitted_op(completion_evt);
-  return make_success();
 }
 
 result ze_queue::submit_kernel(kernel_operation& op, const dag_node_ptr& node) {
@@ -315,7 +546,7 @@ result ze_queue::submit_memset(memset_operation& op, const dag_node_ptr& node) {
   
   auto pattern = op.get_pattern();
   ze_result_t err = zeCommandListAppendMemoryFill(
-      _command_list, op.get_pointer(), &pattern, sizeof(decltype(pattern)),
+      _compute_engine.current.list, op.get_pointer(), &pattern, sizeof(decltype(pattern)),
       op.get_num_bytes(),
       static_cast<ze_node_event *>(completion_evt.get())->get_event_handle(),
       static_cast<uint32_t>(wait_events.size()), wait_events.data());
@@ -329,13 +560,16 @@ result ze_queue::submit_memset(memset_operation& op, const dag_node_ptr& node) {
 
   register_submitted_op(completion_evt);
 
-  return make_success();
+  return notify_command_recorded(_compute_engine);
 }
 
 result ze_queue::wait() {
   std::shared_ptr<dag_node_event> _last_event;
   {
     std::lock_guard<std::mutex> lock{_mutex};
+    result res = submit_current_batch();
+    if(!res.is_success())
+      return res;
     _last_event = _last_submitted_op_event;
   }
   if(_last_event)
@@ -344,9 +578,14 @@ result ze_queue::wait() {
 }
 
 result ze_queue::submit_queue_wait_for(const dag_node_ptr& node) {
+  auto evt = node->get_event();
+  // Our commands may only be waited for once the commands that they
+  // depend on have been submitted. This must happen before locking our
+  // mutex, since evt might belong to a batch of this queue.
+  static_cast<ze_node_event *>(evt.get())->ensure_submitted();
+
   std::lock_guard<std::mutex> lock{_mutex};
 
-  auto evt = node->get_event();
   _enqueued_synchronization_ops.push_back(evt);
   return make_success();
 }
@@ -363,7 +602,7 @@ result ze_queue::submit_external_wait_for(const dag_node_ptr& node) {
                      }),
       _external_waits.end());
 
-  auto evt = create_event();
+  auto evt = create_event(false);
   _enqueued_synchronization_ops.push_back(evt);
 
   std::future<void> f = std::async(std::launch::async, [evt, node](){
@@ -384,8 +623,14 @@ result ze_queue::submit_external_wait_for(const dag_node_ptr& node) {
 }
 
 result ze_queue::query_status(inorder_queue_status &status) {
-  std::lock_guard<std::mutex> lock{_mutex};
-  status = inorder_queue_status{this->_last_submitted_op_event->is_complete()};
+  std::shared_ptr<dag_node_event> last_event;
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    last_event = _last_submitted_op_event;
+  }
+  // Querying the event may need to submit the current batch, which
+  // requires the mutex.
+  status = inorder_queue_status{last_event->is_complete()};
   return make_success();
 }
 
@@ -394,7 +639,7 @@ device_id ze_queue::get_device() const {
 }
 
 void* ze_queue::get_native_type() const {
-  return static_cast<void*>(_command_list);
+  return static_cast<void*>(get_ze_command_list());
 }
 
 const std::vector<std::shared_ptr<dag_node_event>>&
@@ -408,7 +653,7 @@ ze_queue::get_enqueued_event_handles() const {
 
   std::vector<ze_event_handle_t> evts;
   if(!wait_events.empty()) {
-    evts.reserve(wait_events.size());
+    evts.resize(wait_events.size());
     for(std::size_t i = 0; i < wait_events.size(); ++i) {
       evts[i] = static_cast<ze_node_event *>(wait_events[i].get())
                     ->get_event_handle();
@@ -466,7 +711,8 @@ result ze_queue::submit_sscp_kernel_from_code_object(
       kernel_base_config_parameter::compilation_flow,
       compilation_flow::sscp);
   _config.append_base_configuration(
-      kernel_base_config_parameter::hcf_object_id, hcf_object);
+      kernel_base_config_parameter::hcf_object_id,
+      adaptivity_engine.get_code_identity());
   
   for(const auto& flag : kernel_info->get_compilation_flags())
     _config.set_build_flag(flag);
@@ -479,47 +725,72 @@ result ze_queue::submit_sscp_kernel_from_code_object(
   _config.set_build_flag(
       kernel_build_flag::spirv_enable_intel_llvm_spirv_options);
 
-  auto binary_configuration_id = adaptivity_engine.finalize_binary_configuration(_config);
-  auto code_object_configuration_id = binary_configuration_id;
-  
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_device, dev);
-  kernel_configuration::extend_hash(
-      code_object_configuration_id,
-      kernel_base_config_parameter::runtime_context, ctx);
-
-  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+  kernel_configuration::id_type binary_configuration_id;
+  kernel_configuration::id_type code_object_configuration_id;
+  auto select_configuration_id = [&](kernel_configuration::id_type binary_id) {
+    binary_configuration_id = binary_id;
+    code_object_configuration_id = binary_id;
+    kernel_configuration::extend_hash(
+        code_object_configuration_id,
+        kernel_base_config_parameter::runtime_device, dev);
+    kernel_configuration::extend_hash(
+        code_object_configuration_id,
+        kernel_base_config_parameter::runtime_context, ctx);
+  };
+  select_configuration_id(
+      adaptivity_engine.finalize_binary_configuration(_config));
 
+  // Returns a self-contained JIT compiler for the currently selected
+  // configuration, which can also be executed on a background thread.
+  auto make_jit_compiler = [&]() {
     std::vector<std::string> kernel_names;
     std::string selected_image_name =
         adaptivity_engine.select_image_and_kernels(&kernel_names);
 
-    // Construct SPIR-V translator to compile the specified kernels
-    std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
-      std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
-    
-    // Lower kernels to SPIR-V
-    rt::result err;
-    if(kernel_names.size() == 1) {
-      err = glue::jit::dead_argument_elimination::compile_kernel(
-          translator.get(), hcf_object, selected_image_name, _config,
-          binary_configuration_id, compiled_image);
-    } else {
-      err = glue::jit::compile(translator.get(),
-        hcf_object, selected_image_name, _config, compiled_image);
-    }
-    
-    if(!err.is_success()) {
-      register_error(err);
-      return false;
-    }
-    return true;
+    return [=, config = _config](std::string &compiled_image) -> bool {
+      // Construct SPIR-V translator to compile the specified kernels
+      std::unique_ptr<compiler::LLVMToBackendTranslator> translator = 
+        std::move(compiler::createLLVMToSpirvTranslator(kernel_names));
+
+      // Lower kernels to SPIR-V
+      rt::result err;
+      if(kernel_names.size() == 1) {
+        err = glue::jit::dead_argument_elimination::compile_kernel(
+            translator.get(), hcf_object, selected_image_name, config,
+            binary_configuration_id, compiled_image);
+      } else {
+        err = glue::jit::compile(translator.get(),
+          hcf_object, selected_image_name, config, compiled_image);
+      }
+
+      if(!err.is_success()) {
+        register_error(err);
+        return false;
+      }
+      glue::jit::precompilation::record_recipe(
+          binary_configuration_id, backend_id::level_zero, hcf_object,
+          selected_image_name, kernel_names, config,
+          kernel_names.size() == 1);
+      return true;
+    };
+  };
+
+  auto jit_compiler = [&](std::string& compiled_image) -> bool {
+    return make_jit_compiler()(compiled_image);
   };
 
   auto code_object_constructor = [&](const std::string& compiled_image) -> code_object* {
+    // The driver-generated binary additionally depends on device and driver
+    kernel_configuration::id_type native_binary_id = binary_configuration_id;
+    kernel_configuration::extend_hash(
+        native_binary_id, kernel_base_config_parameter::runtime_device_name,
+        hw_ctx->get_device_name());
+    kernel_configuration::extend_hash(
+        native_binary_id, kernel_base_config_parameter::runtime_driver_version,
+        hw_ctx->get_driver_version());
+
     ze_sscp_executable_object *exec_obj = new ze_sscp_executable_object{
-        ctx, dev, hcf_object, compiled_image, _config};
+        ctx, dev, hcf_object, compiled_image, _config, native_binary_id};
     result r = exec_obj->get_build_result();
 
     if(!r.is_success()) {
@@ -539,12 +810,31 @@ result ze_queue::submit_sscp_kernel_from_code_object(
           glue::jit::dead_argument_elimination::
               retrieve_retained_arguments_mask(binary_configuration_id);
 
+    auto usage = query_kernel_resource_usage(exec_obj, kernel_name);
+    _kernel_cache->record_kernel_resource_usage(binary_configuration_id, usage);
+    exec_obj->get_jit_output_metadata().kernel_resource_usage.push_back(usage);
+
     return exec_obj;
   };
 
-  const code_object *obj = _kernel_cache->get_or_construct_jit_code_object(
-      code_object_configuration_id, binary_configuration_id,
-      jit_compiler, code_object_constructor);
+  const code_object *obj = nullptr;
+  if(adaptivity_engine.has_fallback_configuration()) {
+    obj = _kernel_cache->get_or_schedule_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        make_jit_compiler, code_object_constructor);
+    if(!obj) {
+      // The specialized binary is still being compiled; use the less
+      // specialized configuration in the meantime.
+      _config = adaptivity_engine.get_fallback_configuration();
+      select_configuration_id(
+          adaptivity_engine.get_fallback_configuration_id());
+    }
+  }
+
+  if(!obj)
+    obj = _kernel_cache->get_or_construct_jit_code_object(
+        code_object_configuration_id, binary_configuration_id,
+        jit_compiler, code_object_constructor);
 
   if(!obj) {
     return make_error(__acpp_here(),
@@ -558,9 +848,9 @@ result ze_queue::submit_sscp_kernel_from_code_object(
   }
 
 
-  ze_kernel_handle_t kernel;
-  result res = static_cast<const ze_executable_object *>(obj)->get_kernel(
-      kernel_name, kernel);
+  const auto *ze_obj = static_cast<const ze_executable_object *>(obj);
+  ze_kernel_instance *kernel = nullptr;
+  result res = ze_obj->acquire_kernel(kernel_name, kernel);
   
   if(!res.is_success())
     return res;
@@ -573,18 +863,20 @@ result ze_queue::submit_sscp_kernel_from_code_object(
                      << std::endl;
 
   auto submission_err = submit_ze_kernel(
-      kernel, get_ze_command_list(),
+      *kernel, get_ze_command_list(),
       static_cast<ze_node_event *>(completion_evt.get())->get_event_handle(),
       wait_events, group_size, num_groups, _arg_mapper.get_mapped_args(),
       const_cast<std::size_t *>(_arg_mapper.get_mapped_arg_sizes()),
       _arg_mapper.get_mapped_num_args(), kernel_info);
+  // The arguments have been captured by the command list
+  ze_obj->release_kernel(kernel);
 
   if(!submission_err.is_success())
     return submission_err;
 
   register_submitted_op(completion_evt);
 
-  return make_success();
+  return notify_command_recorded(_compute_engine);
 #else
   return make_error(
       __acpp_here(),
@@ -8,17 +8,53 @@
  * See file LICENSE in the project root for full license details.
  */
 // SPDX-License-Identifier: BSD-2-Clause
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "hipSYCL/common/filesystem.hpp"
 #include "hipSYCL/common/appdb.hpp"
+#include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/runtime/device_id.hpp"
+#include "hipSYCL/runtime/jit_cache_archive.hpp"
+#include "hipSYCL/runtime/jit_cache_compression.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
 
 
 void usage() {
-  std::cout << "Usage: acpp-appdb-tool </path/to/app.db or /full/path/to/executable> <-p|-c>\n"
+  std::cout << "Usage: acpp-appdb-tool </path/to/app.db or /full/path/to/executable> <-p|-c|-s|-k [n]|-a [n]|-j|-r|-e <max-size>|-b <output.cpp> [targets]|-x <profile>|-i <profile>>\n"
             << "  -p: Print content of app db\n"
-            << "  -c: Clear this app db" << std::endl;
+            << "  -c: Clear this app db\n"
+            << "  -s: Print statistics of the persistent JIT cache entries of this app db\n"
+            << "  -k [n]: List the n (default: all) most frequently invoked kernels with the number\n"
+            << "          of binaries that were generated for them and their JIT compilation time\n"
+            << "  -a [n]: Print the invariant argument detection statistics of the arguments of the\n"
+            << "          n (default: all) most frequently invoked kernels, and flag arguments\n"
+            << "          that thrash between specialized values\n"
+            << "  -j: Print an estimate of the time spent in JIT compilation for this app db\n"
+            << "  -r: Print the registers, spills, memory usage and occupancy of the kernels of\n"
+            << "      the JIT-compiled binaries, and the specializations that the binaries were\n"
+            << "      compiled with\n"
+            << "  -e <max-size>: Evict least recently used binaries of this app db from the\n"
+            << "                 persistent JIT cache until it is at most max-size MiB large\n"
+            << "  -b <output.cpp> [targets]: Write a source file that embeds the binaries of this\n"
+            << "                 app db from the persistent JIT cache into the application when it\n"
+            << "                 is compiled and linked with it. targets is a comma-separated list\n"
+            << "                 (e.g. sm_80,gfx90a,host,spirv) to restrict the embedded binaries.\n"
+            << "  -x <profile>: Export the kernel argument statistics of this app db, without\n"
+            << "                binaries, to a profile file\n"
+            << "  -i <profile>: Merge the kernel argument statistics of a profile file exported\n"
+            << "                with -x into this app db, such that invariant argument detection\n"
+            << "                can specialize kernels from their first invocation" << std::endl;
 }
 
 bool is_appdb(const std::string& path) {
@@ -35,8 +71,449 @@ void print_content(const std::string& path) {
   });
 }
 
+void print_cache_statistics(const std::string& path) {
+  hipsycl::common::db::appdb db{path};
+  db.read_access([](const hipsycl::common::db::appdb_data& data){
+    uint64_t oldest = std::numeric_limits<uint64_t>::max();
+    uint64_t newest = 0;
+    for(const auto& entry : data.binaries) {
+      oldest = std::min(oldest, entry.second.last_used);
+      newest = std::max(newest, entry.second.last_used);
+    }
+
+    std::cout << "Number of binaries: " << data.binaries.size() << "\n";
+    std::cout << "Size of evictable binaries: "
+              << hipsycl::common::db::get_evictable_binaries_size(data)
+              << " bytes\n";
+    if(!data.binaries.empty()) {
+      std::cout << "Oldest last use: " << oldest << "\n";
+      std::cout << "Newest last use: " << newest << "\n";
+    }
+    std::cout << std::flush;
+  });
+}
+
+void evict_binaries(const std::string& path, uint64_t max_size_mb) {
+  hipsycl::common::db::appdb db{path};
+  std::vector<std::string> evicted_files;
+  db.read_write_access([&](hipsycl::common::db::appdb_data& data){
+    evicted_files = hipsycl::common::db::evict_lru_binaries(
+        data, max_size_mb * 1024 * 1024);
+  });
+  for(const auto& file : evicted_files)
+    hipsycl::common::db::remove_jit_cache_file(file);
+  std::cout << "Evicted " << evicted_files.size() << " binaries" << std::endl;
+}
+
+bool export_kernel_profile(const std::string& path,
+                           const std::string& profile_file) {
+  hipsycl::common::db::appdb db{path};
+  bool success = false;
+  std::size_t num_kernels = 0;
+  db.read_access([&](const hipsycl::common::db::appdb_data& data){
+    num_kernels = data.kernels.size();
+    success = hipsycl::common::db::export_kernel_profile(data, profile_file);
+  });
+  if(!success) {
+    std::cout << "Could not write " << profile_file << std::endl;
+    return false;
+  }
+  std::cout << "Exported statistics of " << num_kernels << " kernels to "
+            << profile_file << std::endl;
+  return true;
+}
+
+bool import_kernel_profile(const std::string& path,
+                           const std::string& profile_file) {
+  hipsycl::common::db::kernel_profile_data profile;
+  if(!hipsycl::common::db::read_kernel_profile(profile_file, profile)) {
+    std::cout << "Could not read " << profile_file
+              << "; it might have been exported by a different version of "
+                 "AdaptiveCpp"
+              << std::endl;
+    return false;
+  }
+  hipsycl::common::db::appdb db{path};
+  std::size_t num_merged = 0;
+  db.read_write_access([&](hipsycl::common::db::appdb_data& data){
+    num_merged = hipsycl::common::db::merge_kernel_profile(data, profile);
+  });
+  std::cout << "Merged statistics of " << num_merged << " kernels into "
+            << path << std::endl;
+  return true;
+}
+
+// Returns the name of the target that a binary was compiled for, based on its
+// JIT recipe, or an empty string if it is unknown.
+std::string get_binary_target(const hipsycl::common::db::jit_recipe &recipe) {
+  using hipsycl::rt::backend_id;
+  using hipsycl::rt::kernel_build_option;
+
+  auto get_option = [&](kernel_build_option o) -> std::string {
+    for(const auto& option : recipe.build_options)
+      if(option.option == static_cast<int>(o))
+        return option.is_int_value ? std::to_string(option.int_value)
+                                   : option.string_value;
+    return {};
+  };
+
+  if(recipe.backend == static_cast<int>(backend_id::cuda)) {
+    std::string device = get_option(kernel_build_option::ptx_target_device);
+    return device.empty() ? device : "sm_" + device;
+  } else if(recipe.backend == static_cast<int>(backend_id::hip)) {
+    return get_option(kernel_build_option::amdgpu_target_device);
+  } else if(recipe.backend == static_cast<int>(backend_id::omp)) {
+    return "host";
+  } else if(recipe.backend == static_cast<int>(backend_id::ocl) ||
+            recipe.backend == static_cast<int>(backend_id::level_zero)) {
+    return "spirv";
+  }
+  return {};
+}
+
+// Binaries and JIT compilation time attributed to a kernel name
+struct kernel_binary_statistics {
+  std::size_t num_binaries = 0;
+  std::size_t num_timed_binaries = 0;
+  uint64_t compilation_time = 0;
+};
+
+std::unordered_map<std::string, kernel_binary_statistics>
+get_kernel_binary_statistics(const hipsycl::common::db::appdb_data &data) {
+  std::unordered_map<std::string, kernel_binary_statistics> result;
+  for(const auto& entry : data.binaries) {
+    for(const auto& kernel_name : entry.second.recipe.kernels) {
+      auto& stats = result[kernel_name];
+      ++stats.num_binaries;
+      if(entry.second.compilation_time > 0) {
+        ++stats.num_timed_binaries;
+        stats.compilation_time += entry.second.compilation_time;
+      }
+    }
+  }
+  return result;
+}
+
+using kernel_list = std::vector<std::pair<hipsycl::rt::kernel_configuration::id_type,
+                                          const hipsycl::common::db::kernel_entry *>>;
+
+// Returns at most max_kernels kernel entries, ordered by invocation count
+kernel_list get_hottest_kernels(const hipsycl::common::db::appdb_data &data,
+                                std::size_t max_kernels) {
+  kernel_list result;
+  for(const auto& entry : data.kernels)
+    result.push_back(std::make_pair(entry.first, &entry.second));
+  std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) {
+    return a.second->num_registered_invocations >
+           b.second->num_registered_invocations;
+  });
+  if(result.size() > max_kernels)
+    result.resize(max_kernels);
+  return result;
+}
+
+std::string get_kernel_display_name(const hipsycl::common::db::kernel_entry &entry) {
+  return entry.kernel_name.empty() ? std::string{"<unknown>"} : entry.kernel_name;
+}
+
+void print_hottest_kernels(const std::string& path, std::size_t max_kernels) {
+  hipsycl::common::db::appdb db{path};
+  db.read_access([&](const hipsycl::common::db::appdb_data& data){
+    auto binary_stats = get_kernel_binary_statistics(data);
+
+    std::cout << "invocations  binaries  jit_time[ms]  kernel (id)\n";
+    for(const auto& kernel : get_hottest_kernels(data, max_kernels)) {
+      kernel_binary_statistics stats;
+      auto it = binary_stats.find(kernel.second->kernel_name);
+      if(it != binary_stats.end())
+        stats = it->second;
+
+      std::cout << std::setw(11) << kernel.second->num_registered_invocations
+                << "  " << std::setw(8) << stats.num_binaries << "  "
+                << std::setw(12) << std::fixed << std::setprecision(1)
+                << stats.compilation_time * 1.e-6 << "  "
+                << get_kernel_display_name(*kernel.second) << " ("
+                << hipsycl::rt::kernel_configuration::to_string(kernel.first)
+                << ")\n";
+    }
+    std::cout << std::flush;
+  });
+}
+
+void print_argument_statistics(const std::string& path, std::size_t max_kernels) {
+  using hipsycl::common::db::kernel_arg_entry;
+
+  hipsycl::common::db::appdb db{path};
+  db.read_access([&](const hipsycl::common::db::appdb_data& data){
+    auto binary_stats = get_kernel_binary_statistics(data);
+
+    for(const auto& kernel : get_hottest_kernels(data, max_kernels)) {
+      const auto& entry = *kernel.second;
+      std::size_t num_binaries = 0;
+      auto it = binary_stats.find(entry.kernel_name);
+      if(it != binary_stats.end())
+        num_binaries = it->second.num_binaries;
+
+      std::cout << get_kernel_display_name(entry) << " ("
+                << hipsycl::rt::kernel_configuration::to_string(kernel.first)
+                << "): " << entry.num_registered_invocations
+                << " invocations, " << num_binaries << " binaries\n";
+
+      for(std::size_t i = 0; i < entry.kernel_args.size(); ++i) {
+        const auto& arg = entry.kernel_args[i];
+
+        int num_tracked_values = 0;
+        int num_specialized_values = 0;
+        uint64_t most_common_value = 0;
+        uint64_t most_common_count = 0;
+        for(int j = 0; j < kernel_arg_entry::max_tracked_values; ++j) {
+          if(arg.common_values[j].count == 0)
+            continue;
+          ++num_tracked_values;
+          if(arg.was_specialized[j])
+            ++num_specialized_values;
+          if(arg.common_values[j].count > most_common_count) {
+            most_common_count = arg.common_values[j].count;
+            most_common_value = arg.common_values[j].value;
+          }
+        }
+        // Pointer arguments do not track values
+        if(num_tracked_values == 0)
+          continue;
+
+        double most_common_fraction =
+            entry.num_registered_invocations > 0
+                ? static_cast<double>(most_common_count) /
+                      entry.num_registered_invocations
+                : 0.0;
+
+        std::cout << "  arg " << i << ": " << num_tracked_values
+                  << " tracked values, most common " << most_common_value
+                  << " (" << std::fixed << std::setprecision(1)
+                  << most_common_fraction * 100.0 << "% of invocations), "
+                  << num_specialized_values << " specialized";
+        // Every specialized value results in a separate binary
+        if(num_specialized_values > 1)
+          std::cout << " [THRASHING]";
+        // Values are evicted and counted anew, so that no value may reach
+        // the specialization threshold
+        else if(num_tracked_values == kernel_arg_entry::max_tracked_values)
+          std::cout << " [SATURATED]";
+        std::cout << "\n";
+      }
+    }
+    std::cout << std::flush;
+  });
+}
+
+void print_jit_time_report(const std::string& path) {
+  hipsycl::common::db::appdb db{path};
+  db.read_access([&](const hipsycl::common::db::appdb_data& data){
+    std::size_t num_timed_binaries = 0;
+    uint64_t total_time = 0;
+    std::map<std::string, std::pair<std::size_t, uint64_t>> time_per_target;
+    for(const auto& entry : data.binaries) {
+      if(entry.second.compilation_time == 0)
+        continue;
+      ++num_timed_binaries;
+      total_time += entry.second.compilation_time;
+
+      std::string target = get_binary_target(entry.second.recipe);
+      auto& target_time = time_per_target[target.empty() ? "unknown" : target];
+      ++target_time.first;
+      target_time.second += entry.second.compilation_time;
+    }
+
+    std::cout << "Number of binaries: " << data.binaries.size() << "\n";
+    std::cout << "Binaries with recorded JIT time: " << num_timed_binaries
+              << "\n";
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Recorded JIT time: " << total_time * 1.e-6 << " ms\n";
+    if(num_timed_binaries > 0) {
+      // Binaries from older versions that did not record their compilation
+      // time are assumed to have taken the average time.
+      double mean_time = static_cast<double>(total_time) / num_timed_binaries;
+      std::cout << "Mean JIT time per binary: " << mean_time * 1.e-6 << " ms\n";
+      std::cout << "Estimated total JIT time: "
+                << mean_time * data.binaries.size() * 1.e-6 << " ms\n";
+      for(const auto& target : time_per_target)
+        std::cout << "  " << target.first << ": " << target.second.first
+                  << " binaries, " << target.second.second * 1.e-6 << " ms\n";
+    }
+    std::cout << std::flush;
+  });
+}
+
+// Lists the specializations of a recipe that can increase register pressure
+std::string get_specialization_summary(
+    const hipsycl::common::db::jit_recipe &recipe) {
+  using hipsycl::rt::kernel_build_option;
+
+  std::string summary;
+  auto append = [&](const std::string& s) {
+    if(!summary.empty())
+      summary += ",";
+    summary += s;
+  };
+  if(!recipe.specialized_args.empty())
+    append("specialized_args=" + std::to_string(recipe.specialized_args.size()));
+  if(!recipe.arg_upper_bounds.empty() || !recipe.arg_divisors.empty())
+    append("arg_bounds");
+  for(const auto& option : recipe.build_options) {
+    if(option.option == static_cast<int>(kernel_build_option::known_group_size_x)) {
+      append("known_group_size");
+      break;
+    }
+  }
+  if(!recipe.branch_profile.empty())
+    append("branch_profile");
+  return summary.empty() ? std::string{"-"} : summary;
+}
+
+void print_kernel_resources(const std::string& path) {
+  hipsycl::common::db::appdb db{path};
+  db.read_access([&](const hipsycl::common::db::appdb_data& data){
+    std::size_t num_reported_binaries = 0;
+    std::size_t num_spilling_kernels = 0;
+
+    std::cout << "registers  spill[B]  private[B]  local[B]  max_group  "
+                 "occupancy  target  specializations  kernel (binary id)\n";
+    for(const auto& entry : data.binaries) {
+      if(entry.second.kernel_resources.empty())
+        continue;
+      ++num_reported_binaries;
+
+      std::string target = get_binary_target(entry.second.recipe);
+      std::string specializations =
+          get_specialization_summary(entry.second.recipe);
+      for(const auto& usage : entry.second.kernel_resources) {
+        std::string occupancy = "-";
+        if(usage.occupancy_group_size > 0)
+          occupancy = std::to_string(usage.occupancy) + "%@" +
+                      std::to_string(usage.occupancy_group_size);
+
+        std::cout << std::setw(9) << usage.num_registers << "  "
+                  << std::setw(8) << usage.spill_bytes << "  "
+                  << std::setw(10) << usage.private_mem_bytes << "  "
+                  << std::setw(8) << usage.local_mem_bytes << "  "
+                  << std::setw(9) << usage.max_group_size << "  "
+                  << std::setw(9) << occupancy << "  "
+                  << std::setw(6) << (target.empty() ? "?" : target) << "  "
+                  << std::setw(15) << specializations << "  "
+                  << usage.kernel_name << " ("
+                  << hipsycl::rt::kernel_configuration::to_string(entry.first)
+                  << ")";
+        if(usage.spill_bytes > 0) {
+          std::cout << " [SPILLS]";
+          ++num_spilling_kernels;
+        }
+        std::cout << "\n";
+      }
+    }
+    std::cout << "Binaries with resource information: " << num_reported_binaries
+              << " of " << data.binaries.size() << "\n";
+    std::cout << "Kernels with spills: " << num_spilling_kernels << std::endl;
+  });
+}
+
+bool read_persistent_cache_entry(const hipsycl::rt::kernel_configuration::id_type &id,
+                                 const std::string &filename, std::string &out) {
+  if(filename.empty() || !hipsycl::common::filesystem::exists(filename))
+    return false;
+
+  std::string ending = "/jit.pack";
+  if(filename.size() >= ending.size() &&
+     filename.compare(filename.size() - ending.size(), ending.size(), ending) == 0) {
+    hipsycl::rt::jit_cache_archive archive{filename};
+    std::string_view binary;
+    if(!archive.lookup(id, binary))
+      return false;
+    return hipsycl::rt::decode_jit_cache_entry(binary, out);
+  }
+
+  std::ifstream file{filename, std::ios::in | std::ios::binary};
+  if(!file.is_open())
+    return false;
+  std::stringstream sstr;
+  sstr << file.rdbuf();
+  return hipsycl::rt::decode_jit_cache_entry(sstr.str(), out);
+}
+
+void embed_binaries(const std::string &path, const std::string &output_file,
+                    const std::string &targets) {
+  std::vector<std::string> selected_targets;
+  std::stringstream target_stream{targets};
+  for(std::string target; std::getline(target_stream, target, ',');)
+    if(!target.empty())
+      selected_targets.push_back(target);
+
+  hipsycl::common::hcf_container hcf;
+  auto* binaries_node = hcf.root_node()->add_subnode("precompiled-binaries");
+  std::size_t num_binaries = 0;
+  uint64_t object_id = 0;
+
+  hipsycl::common::db::appdb db{path};
+  db.read_access([&](const hipsycl::common::db::appdb_data& data){
+    for(const auto& entry : data.binaries) {
+      std::string target = get_binary_target(entry.second.recipe);
+      if(!selected_targets.empty() &&
+         std::find(selected_targets.begin(), selected_targets.end(), target) ==
+             selected_targets.end())
+        continue;
+
+      std::string id = hipsycl::rt::kernel_configuration::to_string(entry.first);
+      std::string binary;
+      if(!read_persistent_cache_entry(entry.first,
+                                      entry.second.jit_cache_filename, binary)) {
+        std::cout << "Binary " << id
+                  << " is not present in the persistent JIT cache, skipping"
+                  << std::endl;
+        continue;
+      }
+
+      auto* binary_node = binaries_node->add_subnode(id);
+      binary_node->set("target", target);
+      hcf.attach_binary_content(binary_node, binary);
+      object_id = object_id * 31 + entry.first[0] + entry.first[1];
+      ++num_binaries;
+    }
+  });
+
+  // Set the highest bit to avoid collisions with the (random) ids of HCF
+  // objects generated by the compiler.
+  object_id = (object_id >> 1) | (1ull << 63);
+  std::string object_id_string = std::to_string(object_id);
+  hcf.root_node()->set("object-id", object_id_string);
+  hcf.root_node()->set("generator", "acpp-appdb-tool");
+
+  std::string hcf_data = hcf.serialize();
+
+  std::ofstream out{output_file};
+  if(!out.is_open()) {
+    std::cout << "Could not open " << output_file << " for writing" << std::endl;
+    return;
+  }
+  out << "// Generated by acpp-appdb-tool. Compile and link with the application to\n"
+      << "// provide precompiled binaries for its kernels.\n"
+      << "#include \"hipSYCL/glue/generic/code_object.hpp\"\n\n"
+      << "const unsigned char __acpp_hcf_object_" << object_id_string << " [] = {";
+  static const char* hex_digits = "0123456789abcdef";
+  for(std::size_t i = 0; i < hcf_data.size(); ++i) {
+    unsigned char c = static_cast<unsigned char>(hcf_data[i]);
+    if(i % 16 == 0)
+      out << "\n  ";
+    out << "0x" << hex_digits[c >> 4] << hex_digits[c & 0xf] << ",";
+  }
+  out << "\n};\n"
+      << "ACPP_STATIC_HCF_REGISTRATION(" << object_id_string << "ull, __acpp_hcf_object_"
+      << object_id_string << ", " << hcf_data.size() << ")\n";
+
+  std::cout << "Embedded " << num_binaries << " binaries in " << output_file
+            << std::endl;
+}
+
 int main(int argc, char** argv) {
-  if(argc != 3) {
+  if(argc < 3 || argc > 5) {
     usage();
     return -1;
   }
@@ -64,7 +541,31 @@ int main(int argc, char** argv) {
     print_content(appdb_path);
   else if(command == "-c")
     hipsycl::common::filesystem::remove(appdb_path);
-  else {
+  else if(command == "-s")
+    print_cache_statistics(appdb_path);
+  else if(command == "-k" && argc <= 4)
+    print_hottest_kernels(appdb_path,
+                          argc == 4 ? std::stoull(argv[3])
+                                    : std::numeric_limits<std::size_t>::max());
+  else if(command == "-a" && argc <= 4)
+    print_argument_statistics(
+        appdb_path, argc == 4 ? std::stoull(argv[3])
+                              : std::numeric_limits<std::size_t>::max());
+  else if(command == "-j")
+    print_jit_time_report(appdb_path);
+  else if(command == "-r")
+    print_kernel_resources(appdb_path);
+  else if(command == "-e" && argc == 4)
+    evict_binaries(appdb_path, std::stoull(argv[3]));
+  else if(command == "-b" && argc >= 4)
+    embed_binaries(appdb_path, argv[3], argc == 5 ? argv[4] : "");
+  else if(command == "-x" && argc == 4) {
+    if(!export_kernel_profile(appdb_path, argv[3]))
+      return -1;
+  } else if(command == "-i" && argc == 4) {
+    if(!import_kernel_profile(appdb_path, argv[3]))
+      return -1;
+  } else {
     usage();
     return -1;
   }
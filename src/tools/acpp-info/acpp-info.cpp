@@ -15,6 +15,7 @@
 #include "hipSYCL/runtime/runtime.hpp"
 #include "hipSYCL/runtime/hardware.hpp"
 #include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/hw_model/hw_model.hpp"
 
 using namespace hipsycl;
 
@@ -147,6 +148,7 @@ void list_device_details(rt::device_id dev, rt::backend *b,
   PRINT_DEVICE_UINT_PROPERTY(global_mem_cache_line_size);
   PRINT_DEVICE_UINT_PROPERTY(global_mem_cache_size);
   PRINT_DEVICE_UINT_PROPERTY(global_mem_size);
+  PRINT_DEVICE_UINT_PROPERTY(peak_memory_bandwidth);
   PRINT_DEVICE_UINT_PROPERTY(max_constant_buffer_size);
   PRINT_DEVICE_UINT_PROPERTY(max_constant_args);
   PRINT_DEVICE_UINT_PROPERTY(local_mem_size);
@@ -154,6 +156,7 @@ void list_device_details(rt::device_id dev, rt::backend *b,
   PRINT_DEVICE_UINT_PROPERTY(partition_max_sub_devices);
   PRINT_DEVICE_UINT_PROPERTY(vendor_id);
   PRINT_DEVICE_UINT_LIST_PROPERTY(sub_group_sizes);
+  PRINT_DEVICE_UINT_LIST_PROPERTY(peer_access_devices);
 }
 
 void list_devices(rt::runtime* rt) {
@@ -174,16 +177,95 @@ void list_devices(rt::runtime* rt) {
   });
 }
 
+int calibrate_memcpy_model(rt::runtime* rt) {
+  rt::memcpy_model* model = rt->backends().hardware_model().get_memcpy_model();
+  std::cout << "Measuring data transfer latency and bandwidth..." << std::endl;
+  model->calibrate(rt);
+
+  std::vector<rt::device_id> devices;
+  rt->backends().for_each_backend([&](rt::backend* b){
+    for(std::size_t i = 0; i < b->get_hardware_manager()->get_num_devices(); ++i)
+      devices.push_back(b->get_hardware_manager()->get_device_id(i));
+  });
+  for(const auto& src : devices) {
+    for(const auto& dest : devices) {
+      if(src == dest)
+        continue;
+      rt::memcpy_link_properties link = model->get_link_properties(src, dest);
+      std::cout << "  " << rt->backends().get(src.get_backend())->get_name()
+                << " device " << src.get_id() << " -> "
+                << rt->backends().get(dest.get_backend())->get_name()
+                << " device " << dest.get_id() << ": latency "
+                << link.latency * 1.e6 << " us, bandwidth "
+                << link.bandwidth * 1.e-9 << " GB/s" << std::endl;
+    }
+  }
+
+  if(!model->store_calibration()) {
+    std::cerr << "Could not write calibration results to "
+              << rt::memcpy_model::get_calibration_file_path() << std::endl;
+    return 1;
+  }
+  std::cout << "Calibration results written to "
+            << rt::memcpy_model::get_calibration_file_path() << std::endl;
+  return 0;
+}
+
+int benchmark_devices(rt::runtime* rt) {
+  int result = calibrate_memcpy_model(rt);
+
+  rt::device_model* model = rt->backends().hardware_model().get_device_model();
+  std::cout << "Measuring device operation latency and memory bandwidth..."
+            << std::endl;
+  model->calibrate(rt);
+
+  rt->backends().for_each_backend([&](rt::backend* b){
+    for(std::size_t i = 0; i < b->get_hardware_manager()->get_num_devices(); ++i) {
+      rt::device_id dev = b->get_hardware_manager()->get_device_id(i);
+      std::cout << "  " << b->get_name() << " device " << dev.get_id() << ": ";
+      if(auto props = model->get_properties(dev)) {
+        std::cout << "operation latency " << props->operation_latency * 1.e6
+                  << " us, memory bandwidth "
+                  << props->memory_bandwidth * 1.e-9 << " GB/s";
+      } else {
+        std::cout << "measurement failed";
+      }
+      std::size_t peak_bandwidth =
+          b->get_hardware_manager()->get_device(i)->get_property(
+              rt::device_uint_property::peak_memory_bandwidth);
+      if(peak_bandwidth > 0)
+        std::cout << " (theoretical peak " << peak_bandwidth * 1.e-9
+                  << " GB/s)";
+      std::cout << std::endl;
+    }
+  });
+
+  if(!model->store_calibration()) {
+    std::cerr << "Could not write calibration results to "
+              << rt::device_model::get_calibration_file_path() << std::endl;
+    return 1;
+  }
+  std::cout << "Calibration results written to "
+            << rt::device_model::get_calibration_file_path() << std::endl;
+  return result;
+}
+
 void print_help(const char* exe_name)
 {
     std::cout << "Usage: " << exe_name << " [options]\n\n";
     std::cout << "Options:\n";
     std::cout << "\t-h, --help              Show this message.\n";
     std::cout << "\t-l, --list-devices      Only list backends and devices, without detailed information.\n";
+    std::cout << "\t-c, --calibrate-memcpy  Measure data transfer latency and bandwidth between all devices\n"
+              << "\t                        and store the results for data transfer source selection.\n";
+    std::cout << "\t-b, --benchmark         Additionally measure operation latency and memory bandwidth of each\n"
+              << "\t                        device and store the results for scheduling and offloading decisions.\n";
 }
 
 int main(int argc, char *argv[]) {
   bool print_device_details = true;
+  bool calibrate_memcpy = false;
+  bool benchmark = false;
   for (int arg = 1; arg < argc; arg++) {
     const std::string current_arg{argv[arg]};
     if (current_arg == "-h" || current_arg == "--help") {
@@ -193,6 +275,12 @@ int main(int argc, char *argv[]) {
     else if (current_arg == "-l" || current_arg == "--list-devices") {
       print_device_details = false;
     }
+    else if (current_arg == "-c" || current_arg == "--calibrate-memcpy") {
+      calibrate_memcpy = true;
+    }
+    else if (current_arg == "-b" || current_arg == "--benchmark") {
+      benchmark = true;
+    }
     else {
       std::cerr << "Unknown option: " << argv[arg] << std::endl;
       print_help(argv[0]);
@@ -203,6 +291,11 @@ int main(int argc, char *argv[]) {
   rt::runtime_keep_alive_token rt_token;
   rt::runtime* rt = rt_token.get();
 
+  if (benchmark)
+    return benchmark_devices(rt);
+  if (calibrate_memcpy)
+    return calibrate_memcpy_model(rt);
+
   std::cout << "=================Backend information==================="
             << std::endl;
   list_backends(rt);
@@ -0,0 +1,709 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "hipSYCL/common/hcf_container.hpp"
+#include "hipSYCL/glue/kernel_launcher_data.hpp"
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/allocator.hpp"
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/code_object_invoker.hpp"
+#include "hipSYCL/runtime/dag_node.hpp"
+#include "hipSYCL/runtime/executor.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+#include "hipSYCL/runtime/hints.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_launcher.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+#include "hipSYCL/runtime/remote/remote_protocol.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+
+namespace rt = hipsycl::rt;
+
+namespace {
+
+const rt::device_id host_device{
+    rt::backend_descriptor{rt::hardware_platform::cpu, rt::api_platform::omp},
+    0};
+
+void usage() {
+  std::cout << "Usage: acpp-remote-daemon [options]\n"
+            << "Makes the devices of this machine available to applications\n"
+            << "on other machines, see ACPP_RT_REMOTE_DEVICES.\n"
+            << "  -p <port>: Port to listen on (default: "
+            << rt::remote_default_port << ")\n"
+            << "  -a <address>: Address to listen on (default: all)\n"
+            << "Clients must have the same architecture as this machine.\n"
+            << "The daemon does not authenticate clients, so it should only\n"
+            << "be reachable from trusted networks." << std::endl;
+}
+
+struct daemon_device {
+  rt::device_id dev;
+  rt::backend *b;
+  rt::hardware_context *ctx;
+};
+
+class daemon_state {
+public:
+  explicit daemon_state(rt::runtime *runtime)
+  : _rt{runtime} {
+    _rt->backends().for_each_backend([this](rt::backend *b) {
+      // Devices of other daemons are not forwarded
+      if(b->get_unique_backend_id() == rt::backend_id::remote)
+        return;
+      rt::backend_hardware_manager *hw = b->get_hardware_manager();
+      for(std::size_t i = 0; i < hw->get_num_devices(); ++i)
+        _devices.push_back(
+            daemon_device{hw->get_device_id(i), b, hw->get_device(i)});
+    });
+  }
+
+  rt::runtime *get_runtime() const { return _rt; }
+  const std::vector<daemon_device> &get_devices() const { return _devices; }
+
+  const daemon_device *get_device(uint64_t index) const {
+    if(index >= _devices.size())
+      return nullptr;
+    return &_devices[index];
+  }
+
+  std::vector<rt::remote_device_info> describe_devices() const {
+    std::vector<rt::remote_device_info> result;
+    for(const auto &d : _devices) {
+      rt::remote_device_info info;
+      info.name = d.ctx->get_device_name();
+      info.vendor = d.ctx->get_vendor_name();
+      info.arch = d.ctx->get_device_arch();
+      info.driver_version = d.ctx->get_driver_version();
+      info.profile = d.ctx->get_profile();
+      info.is_cpu = d.ctx->is_cpu();
+      info.is_gpu = d.ctx->is_gpu();
+      info.max_kernel_concurrency = d.ctx->get_max_kernel_concurrency();
+      info.max_memcpy_concurrency = d.ctx->get_max_memcpy_concurrency();
+      for(std::size_t i = 0; i < rt::remote_num_uint_properties; ++i)
+        info.uint_properties.push_back(d.ctx->get_property(
+            static_cast<rt::device_uint_property>(i)));
+      for(auto s : d.ctx->get_property(
+               rt::device_uint_list_property::sub_group_sizes))
+        info.sub_group_sizes.push_back(s);
+      for(std::size_t i = 0; i < rt::remote_num_support_aspects; ++i)
+        info.support_aspects.push_back(
+            d.ctx->has(static_cast<rt::device_support_aspect>(i)) ? 1 : 0);
+      result.push_back(std::move(info));
+    }
+    return result;
+  }
+
+  // HCF objects are shared by all clients. Their ids are derived from their
+  // contents, so objects of different clients with the same id are equal.
+  std::string register_hcf(uint64_t hcf_object, const std::string &data) {
+    std::lock_guard<std::mutex> lock{_hcf_mutex};
+    if(_registered_hcf_objects.count(hcf_object))
+      return {};
+
+    hipsycl::common::hcf_container hcf{data};
+    const std::string *id = hcf.root_node()->get_value("object-id");
+    if(!id || *id != std::to_string(hcf_object))
+      return "Received invalid HCF object";
+    rt::hcf_cache::get().register_hcf_object(std::move(hcf));
+    _registered_hcf_objects.insert(hcf_object);
+    return {};
+  }
+
+  // Executors are not meant to be used by multiple submitting threads
+  std::mutex &get_submission_mutex() { return _submission_mutex; }
+private:
+  rt::runtime *_rt;
+  std::vector<daemon_device> _devices;
+
+  std::mutex _hcf_mutex;
+  std::unordered_set<uint64_t> _registered_hcf_objects;
+
+  std::mutex _submission_mutex;
+};
+
+rt::memory_location make_location(const daemon_device &d,
+                                  const rt::remote_memory_region &region) {
+  return rt::memory_location{
+      d.dev, reinterpret_cast<void *>(region.address),
+      rt::id<3>{region.offset[0], region.offset[1], region.offset[2]},
+      rt::range<3>{region.shape[0], region.shape[1], region.shape[2]},
+      region.element_size};
+}
+
+rt::range<3> make_range(const std::array<uint64_t, 3> &r) {
+  return rt::range<3>{r[0], r[1], r[2]};
+}
+
+rt::memory_location make_host_location(void *data, const rt::range<3> &r,
+                                       std::size_t element_size) {
+  return rt::memory_location{host_device, data, rt::id<3>{}, r, element_size};
+}
+
+// Backend parameters are only needed for custom operations, which cannot
+// be forwarded by clients.
+rt::result invoke_remote_kernel(
+    const hipsycl::glue::kernel_launcher_data &launch_config,
+    rt::dag_node *node, const rt::kernel_configuration &kernel_config,
+    const rt::backend_kernel_launch_capabilities &launch_capabilities,
+    void *) {
+  auto sscp_invoker = launch_capabilities.get_sscp_invoker();
+  if(!sscp_invoker)
+    return rt::make_error(
+        __acpp_here(),
+        rt::error_info{"acpp-remote-daemon: Backend does not support SSCP "
+                       "kernels"});
+
+  rt::range<3> num_groups;
+  for(int i = 0; i < 3; ++i)
+    num_groups[i] = launch_config.global_size[i] / launch_config.group_size[i];
+
+  std::array<const void *, 1> args{launch_config.kernel_args.data()};
+  std::size_t arg_size = launch_config.kernel_args.size();
+
+  auto *kernel_op = static_cast<rt::kernel_operation *>(node->get_operation());
+  return sscp_invoker.value()->submit_kernel(
+      *kernel_op, launch_config.sscp_hcf_object_id, num_groups,
+      launch_config.group_size, launch_config.local_mem_size,
+      const_cast<void **>(args.data()), &arg_size, args.size(),
+      launch_config.sscp_kernel_id, launch_config.kernel_info, kernel_config);
+}
+
+// Submits the operation to the device and returns the node, which is
+// cancelled if the submission has failed
+rt::dag_node_ptr submit(daemon_state &state, rt::backend_executor *executor,
+                        rt::device_id dev, std::unique_ptr<rt::operation> op,
+                        const rt::dag_node_ptr &previous = nullptr) {
+  rt::execution_hints hints;
+  hints.set_hint(rt::hints::bind_to_device{dev});
+  auto node = rt::make_dag_node(hints, rt::node_list_t{}, std::move(op),
+                                state.get_runtime());
+  node->assign_to_device(dev);
+
+  rt::node_list_t reqs;
+  if(previous && !previous->is_cancelled())
+    reqs.push_back(previous);
+
+  std::lock_guard<std::mutex> lock{state.get_submission_mutex()};
+  executor->submit_directly(node, node->get_operation(), reqs);
+  return node;
+}
+
+// Executes a copy between the host and a device synchronously, for the
+// read and write requests of control connections
+std::string copy_synchronously(daemon_state &state, const daemon_device &d,
+                               const rt::memory_location &src,
+                               const rt::memory_location &dest,
+                               const rt::range<3> &r) {
+  rt::backend_executor *executor = d.b->get_executor(d.dev);
+  if(!executor)
+    return "No executor available for device";
+  auto node = submit(state, executor, d.dev,
+                     std::make_unique<rt::memcpy_operation>(src, dest, r));
+  node->wait();
+  if(node->is_cancelled())
+    return "Memory copy has failed";
+  return {};
+}
+
+/// Executes the commands of a stream connection in order on its device,
+/// and acknowledges them from a separate thread once they have completed.
+class stream_session {
+public:
+  stream_session(daemon_state &state, rt::remote_socket &socket,
+                 const daemon_device &d)
+      : _state{state}, _socket{socket}, _device{d} {
+    _executor_storage = d.b->create_inorder_executor(d.dev, 0);
+    _executor = _executor_storage ? _executor_storage.get()
+                                  : d.b->get_executor(d.dev);
+    _completer = std::thread{[this]() { complete(); }};
+  }
+
+  ~stream_session() {
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _is_finished = true;
+    }
+    _cv.notify_all();
+    _completer.join();
+    // Destroying the executor waits for outstanding operations
+    _executor_storage.reset();
+  }
+
+  void run() {
+    for(;;) {
+      rt::remote_message msg;
+      if(!_socket.receive(msg).is_success())
+        return;
+
+      auto cmd = std::make_unique<command>();
+      cmd->index = ++_num_received;
+      execute(msg, *cmd);
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _commands.push_back(std::move(cmd));
+      }
+      _cv.notify_all();
+    }
+  }
+
+private:
+  struct command {
+    uint64_t index = 0;
+    rt::dag_node_ptr node;
+    std::string error;
+    // Buffers that must live until the operation has completed
+    std::string input;
+    std::string output;
+    std::string kernel_name;
+  };
+
+  void execute(rt::remote_message &msg, command &cmd) {
+    using rt::remote_message_type;
+    switch(msg.type) {
+    case remote_message_type::register_hcf: {
+      rt::remote_hcf_registration request;
+      if(!msg.unpack_body(request)) {
+        cmd.error = "Invalid HCF registration";
+        return;
+      }
+      cmd.error = _state.register_hcf(request.hcf_object, msg.data);
+      return;
+    }
+    case remote_message_type::memcpy_to_device:
+    case remote_message_type::memcpy_from_device:
+    case remote_message_type::memcpy_on_device: {
+      rt::remote_memcpy_command request;
+      if(!msg.unpack_body(request)) {
+        cmd.error = "Invalid memcpy command";
+        return;
+      }
+      execute_memcpy(msg, request, cmd);
+      return;
+    }
+    case remote_message_type::memset: {
+      rt::remote_memset_command request;
+      if(!msg.unpack_body(request)) {
+        cmd.error = "Invalid memset command";
+        return;
+      }
+      enqueue(cmd, std::make_unique<rt::memset_operation>(
+                       reinterpret_cast<void *>(request.address),
+                       static_cast<unsigned char>(request.pattern),
+                       request.bytes));
+      return;
+    }
+    case remote_message_type::kernel: {
+      rt::remote_kernel_command request;
+      if(!msg.unpack_body(request)) {
+        cmd.error = "Invalid kernel command";
+        return;
+      }
+      cmd.input = std::move(msg.data);
+      execute_kernel(request, cmd);
+      return;
+    }
+    default:
+      cmd.error = "Unexpected stream command";
+    }
+  }
+
+  void execute_memcpy(rt::remote_message &msg,
+                      const rt::remote_memcpy_command &request, command &cmd) {
+    rt::range<3> r = make_range(request.range);
+    if(msg.type == rt::remote_message_type::memcpy_to_device) {
+      const daemon_device *dest = _state.get_device(request.dest.device);
+      if(!dest) {
+        cmd.error = "Invalid device";
+        return;
+      }
+      if(msg.data.size() != r.size() * request.dest.element_size) {
+        cmd.error = "Invalid size of copied data";
+        return;
+      }
+      cmd.input = std::move(msg.data);
+      enqueue(cmd, std::make_unique<rt::memcpy_operation>(
+                       make_host_location(cmd.input.data(), r,
+                                          request.dest.element_size),
+                       make_location(*dest, request.dest), r));
+    } else if(msg.type == rt::remote_message_type::memcpy_from_device) {
+      const daemon_device *src = _state.get_device(request.source.device);
+      if(!src) {
+        cmd.error = "Invalid device";
+        return;
+      }
+      cmd.output.resize(r.size() * request.source.element_size);
+      enqueue(cmd, std::make_unique<rt::memcpy_operation>(
+                       make_location(*src, request.source),
+                       make_host_location(cmd.output.data(), r,
+                                          request.source.element_size),
+                       r));
+    } else {
+      const daemon_device *src = _state.get_device(request.source.device);
+      const daemon_device *dest = _state.get_device(request.dest.device);
+      if(!src || !dest) {
+        cmd.error = "Invalid device";
+        return;
+      }
+      enqueue(cmd, std::make_unique<rt::memcpy_operation>(
+                       make_location(*src, request.source),
+                       make_location(*dest, request.dest), r));
+    }
+  }
+
+  void execute_kernel(const rt::remote_kernel_command &request,
+                      command &cmd) {
+    cmd.kernel_name = request.kernel_name;
+    const rt::hcf_kernel_info *kernel_info =
+        rt::hcf_cache::get().get_kernel_info(request.hcf_object,
+                                             cmd.kernel_name);
+    if(!kernel_info) {
+      cmd.error = "Kernel " + cmd.kernel_name + " is not registered";
+      return;
+    }
+
+    hipsycl::glue::kernel_launcher_data launch_data;
+    launch_data.type = rt::kernel_type::basic_parallel_for;
+    launch_data.kernel_args.assign(cmd.input.begin(), cmd.input.end());
+    for(int i = 0; i < 3; ++i) {
+      if(request.group_size[i] == 0) {
+        cmd.error = "Invalid group size";
+        return;
+      }
+      launch_data.group_size[i] = request.group_size[i];
+      launch_data.global_size[i] =
+          request.num_groups[i] * request.group_size[i];
+    }
+    launch_data.local_mem_size =
+        static_cast<unsigned>(request.local_mem_size);
+    launch_data.sscp_hcf_object_id = request.hcf_object;
+    launch_data.sscp_kernel_id = cmd.kernel_name.c_str();
+    launch_data.kernel_info = kernel_info;
+    launch_data.sscp_invoker = &invoke_remote_kernel;
+
+    rt::kernel_launcher launcher{launch_data, {}};
+    if(request.configuration.is_valid())
+      launcher.get_kernel_configuration() =
+          hipsycl::glue::jit::precompilation::restore_configuration(
+              request.configuration);
+
+    enqueue(cmd, std::make_unique<rt::kernel_operation>(
+                     cmd.kernel_name.c_str(), std::move(launcher),
+                     rt::requirements_list{_state.get_runtime()}));
+  }
+
+  void enqueue(command &cmd, std::unique_ptr<rt::operation> op) {
+    if(!_executor) {
+      cmd.error = "No executor available for device";
+      return;
+    }
+    cmd.node = submit(_state, _executor, _device.dev, std::move(op), _previous);
+    _previous = cmd.node;
+  }
+
+  void complete() {
+    for(;;) {
+      std::unique_ptr<command> cmd;
+      {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _cv.wait(lock, [this]() { return _is_finished || !_commands.empty(); });
+        if(_commands.empty())
+          return;
+        cmd = std::move(_commands.front());
+        _commands.pop_front();
+      }
+
+      if(cmd->node) {
+        cmd->node->wait();
+        if(cmd->node->is_cancelled())
+          cmd->error = "Operation has failed, see the output of the daemon";
+      }
+
+      rt::remote_completion completion{cmd->index, cmd->error};
+      const bool has_output = cmd->error.empty() && !cmd->output.empty();
+      // If the client has disconnected, the remaining commands are only
+      // waited for
+      _socket.send(rt::remote_message_type::completion, completion,
+                   has_output ? cmd->output.data() : nullptr,
+                   has_output ? cmd->output.size() : 0);
+    }
+  }
+
+  daemon_state &_state;
+  rt::remote_socket &_socket;
+  const daemon_device &_device;
+  std::unique_ptr<rt::backend_executor> _executor_storage;
+  rt::backend_executor *_executor = nullptr;
+  rt::dag_node_ptr _previous;
+  uint64_t _num_received = 0;
+
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::deque<std::unique_ptr<command>> _commands;
+  bool _is_finished = false;
+  std::thread _completer;
+};
+
+/// Allocations of a control connection, which are freed when the client
+/// disconnects
+class control_session {
+public:
+  control_session(daemon_state &state, rt::remote_socket &socket)
+  : _state{state}, _socket{socket} {}
+
+  ~control_session() {
+    for(const auto &a : _allocations)
+      if(const daemon_device *d = _state.get_device(a.first))
+        d->b->get_allocator(d->dev)->free(a.second);
+  }
+
+  /// \return false if the connection has become a stream connection, or was
+  /// closed
+  bool handle(rt::remote_message &msg) {
+    using rt::remote_message_type;
+    switch(msg.type) {
+    case remote_message_type::allocate: {
+      rt::remote_allocation_request request;
+      rt::remote_allocation_reply reply;
+      const daemon_device *d = nullptr;
+      if(!msg.unpack_body(request) || !(d = _state.get_device(request.device)))
+        reply.error = "Invalid allocation request";
+      else {
+        void *ptr = d->b->get_allocator(d->dev)->allocate(request.alignment,
+                                                           request.bytes);
+        if(!ptr)
+          reply.error = "Out of memory";
+        else {
+          _allocations.emplace_back(request.device, ptr);
+          reply.address = reinterpret_cast<uint64_t>(ptr);
+        }
+      }
+      return _socket.send(remote_message_type::allocate_reply, reply)
+          .is_success();
+    }
+    case remote_message_type::free: {
+      rt::remote_free_request request;
+      rt::remote_status_reply reply;
+      if(!msg.unpack_body(request) || !release(request))
+        reply.error = "Invalid free request";
+      return _socket.send(remote_message_type::status_reply, reply)
+          .is_success();
+    }
+    case remote_message_type::read:
+    case remote_message_type::write: {
+      rt::remote_memcpy_command request;
+      rt::remote_status_reply reply;
+      std::string data;
+      if(!msg.unpack_body(request))
+        reply.error = "Invalid copy request";
+      else if(msg.type == remote_message_type::read)
+        reply.error = read(request, data);
+      else
+        reply.error = write(request, msg.data);
+      const bool has_data = reply.error.empty() && !data.empty();
+      return _socket
+          .send(remote_message_type::status_reply, reply,
+                has_data ? data.data() : nullptr, has_data ? data.size() : 0)
+          .is_success();
+    }
+    case remote_message_type::open_stream: {
+      rt::remote_stream_request request;
+      rt::remote_status_reply reply;
+      const daemon_device *d = nullptr;
+      if(!msg.unpack_body(request) || !(d = _state.get_device(request.device)))
+        reply.error = "Invalid device";
+      if(!_socket.send(remote_message_type::status_reply, reply).is_success())
+        return false;
+      if(!d)
+        return true;
+      stream_session stream{_state, _socket, *d};
+      stream.run();
+      return false;
+    }
+    default: {
+      rt::remote_status_reply reply;
+      reply.error = "Unexpected request";
+      return _socket.send(remote_message_type::status_reply, reply)
+          .is_success();
+    }
+    }
+  }
+
+private:
+  bool release(const rt::remote_free_request &request) {
+    void *ptr = reinterpret_cast<void *>(request.address);
+    for(auto it = _allocations.begin(); it != _allocations.end(); ++it) {
+      if(it->first == request.device && it->second == ptr) {
+        const daemon_device *d = _state.get_device(request.device);
+        d->b->get_allocator(d->dev)->free(ptr);
+        _allocations.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::string read(const rt::remote_memcpy_command &request,
+                   std::string &data) {
+    const daemon_device *d = _state.get_device(request.source.device);
+    if(!d)
+      return "Invalid device";
+    rt::range<3> r = make_range(request.range);
+    data.resize(r.size() * request.source.element_size);
+    return copy_synchronously(
+        _state, *d, make_location(*d, request.source),
+        make_host_location(data.data(), r, request.source.element_size), r);
+  }
+
+  std::string write(const rt::remote_memcpy_command &request,
+                    std::string &data) {
+    const daemon_device *d = _state.get_device(request.dest.device);
+    if(!d)
+      return "Invalid device";
+    rt::range<3> r = make_range(request.range);
+    if(data.size() != r.size() * request.dest.element_size)
+      return "Invalid size of copied data";
+    return copy_synchronously(
+        _state, *d,
+        make_host_location(data.data(), r, request.dest.element_size),
+        make_location(*d, request.dest), r);
+  }
+
+  daemon_state &_state;
+  rt::remote_socket &_socket;
+  std::vector<std::pair<uint64_t, void *>> _allocations;
+};
+
+void serve(daemon_state &state, rt::remote_socket socket) {
+  rt::remote_message msg;
+  rt::remote_hello hello;
+  if(!socket.receive(msg).is_success() ||
+     msg.type != rt::remote_message_type::hello || !msg.unpack_body(hello))
+    return;
+
+  rt::remote_hello_reply reply;
+  // Clients with a different protocol version reject the reply
+  if(hello.version == rt::remote_protocol_version)
+    reply.devices = state.describe_devices();
+  if(!socket.send(rt::remote_message_type::hello_reply, reply).is_success())
+    return;
+
+  control_session session{state, socket};
+  while(socket.receive(msg).is_success() && session.handle(msg))
+    ;
+}
+
+int listen_on(const std::string &address, uint16_t port) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+  addrinfo *addresses = nullptr;
+  std::string service = std::to_string(port);
+  int err = getaddrinfo(address.empty() ? nullptr : address.c_str(),
+                        service.c_str(), &hints, &addresses);
+  if(err != 0) {
+    std::cerr << "Could not resolve " << address << ": " << gai_strerror(err)
+              << std::endl;
+    return -1;
+  }
+
+  int fd = -1;
+  for(addrinfo *a = addresses; a; a = a->ai_next) {
+    fd = socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+    if(fd < 0)
+      continue;
+    int flag = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+    if(bind(fd, a->ai_addr, a->ai_addrlen) == 0 && listen(fd, 16) == 0)
+      break;
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(addresses);
+  if(fd < 0)
+    std::cerr << "Could not listen on port " << port << ": "
+              << std::strerror(errno) << std::endl;
+  return fd;
+}
+
+}
+
+int main(int argc, char **argv) {
+  uint16_t port = rt::remote_default_port;
+  std::string address;
+
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if(arg == "-h" || arg == "--help") {
+      usage();
+      return 0;
+    } else if(arg == "-p" && has_value) {
+      unsigned long value = std::strtoul(argv[++i], nullptr, 10);
+      if(value == 0 || value > 65535) {
+        std::cerr << "Invalid port: " << argv[i] << std::endl;
+        return -1;
+      }
+      port = static_cast<uint16_t>(value);
+    } else if(arg == "-a" && has_value) {
+      address = argv[++i];
+    } else {
+      std::cerr << "Invalid argument: " << arg << std::endl;
+      usage();
+      return -1;
+    }
+  }
+
+  rt::runtime_keep_alive_token rt_token;
+  daemon_state state{rt_token.get()};
+
+  std::cout << "Forwarding " << state.get_devices().size() << " device(s):\n";
+  for(const auto &d : state.get_devices())
+    std::cout << "  " << d.ctx->get_device_name() << " ("
+              << d.b->get_name() << ")\n";
+  std::cout << std::flush;
+
+  int listen_fd = listen_on(address, port);
+  if(listen_fd < 0)
+    return -1;
+  std::cout << "Listening on port " << port << std::endl;
+
+  for(;;) {
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if(fd < 0) {
+      if(errno == EINTR || errno == ECONNABORTED)
+        continue;
+      std::cerr << "accept() failed: " << std::strerror(errno) << std::endl;
+      break;
+    }
+    std::thread{[&state, fd]() { serve(state, rt::remote_socket{fd}); }}
+        .detach();
+  }
+  close(listen_fd);
+  return -1;
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "hipSYCL/glue/llvm-sscp/jit.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/kernel_replay.hpp"
+#include "hipSYCL/runtime/runtime.hpp"
+
+namespace rt = hipsycl::rt;
+
+void usage() {
+  std::cout << "Usage: acpp-replay <capture file> [options]\n"
+            << "Repeats a kernel launch that was captured with ACPP_RT_KERNEL_CAPTURE\n"
+            << "and reports its execution time.\n"
+            << "  -n <runs>: Number of timed launches (default: 10)\n"
+            << "  -r: Restore the captured memory before each launch, for kernels that\n"
+            << "      modify their input. Restoring is not included in the timings.\n"
+            << "  -f <flag>: Add a kernel build flag, e.g. fast-math\n"
+            << "  -o <option>=<value>: Set a kernel build option\n"
+            << "  -i: Ignore the build options and flags of the captured launch\n"
+            << "Other JIT options, e.g. ACPP_ADAPTIVITY_LEVEL, are taken from the\n"
+            << "environment as for applications." << std::endl;
+}
+
+bool add_build_option(rt::kernel_configuration &config,
+                      const std::string &arg) {
+  auto pos = arg.find('=');
+  if(pos == std::string::npos)
+    return false;
+  auto option = rt::to_build_option(arg.substr(0, pos));
+  if(!option)
+    return false;
+  config.set_build_option(option.value(), arg.substr(pos + 1));
+  return true;
+}
+
+int main(int argc, char **argv) {
+  if(argc < 2 || std::string{argv[1]} == "-h" ||
+     std::string{argv[1]} == "--help") {
+    usage();
+    return argc < 2 ? -1 : 0;
+  }
+
+  std::string filename = argv[1];
+  std::size_t num_runs = 10;
+  bool restore_memory = false;
+  bool use_captured_configuration = true;
+  std::vector<std::string> build_flags;
+  std::vector<std::string> build_options;
+
+  for(int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    bool has_value = i + 1 < argc;
+    if(arg == "-n" && has_value) {
+      num_runs = std::stoull(argv[++i]);
+    } else if(arg == "-r") {
+      restore_memory = true;
+    } else if(arg == "-f" && has_value) {
+      build_flags.push_back(argv[++i]);
+    } else if(arg == "-o" && has_value) {
+      build_options.push_back(argv[++i]);
+    } else if(arg == "-i") {
+      use_captured_configuration = false;
+    } else {
+      std::cerr << "Invalid argument: " << arg << std::endl;
+      usage();
+      return -1;
+    }
+  }
+
+  rt::kernel_capture_record record;
+  auto err = rt::read_kernel_capture(filename, record);
+  if(!err.is_success()) {
+    std::cerr << err.what() << std::endl;
+    return -1;
+  }
+
+  rt::kernel_configuration config;
+  if(use_captured_configuration && record.configuration.is_valid())
+    config = hipsycl::glue::jit::precompilation::restore_configuration(
+        record.configuration);
+  for(const auto& flag_name : build_flags) {
+    auto flag = rt::to_build_flag(flag_name);
+    if(!flag) {
+      std::cerr << "Unknown build flag: " << flag_name << std::endl;
+      return -1;
+    }
+    config.set_build_flag(flag.value());
+  }
+  for(const auto& option : build_options) {
+    if(!add_build_option(config, option)) {
+      std::cerr << "Invalid build option: " << option << std::endl;
+      return -1;
+    }
+  }
+
+  std::cout << "Kernel: " << record.kernel_name << "\n"
+            << "Global size: " << record.global_size[2] << " x "
+            << record.global_size[1] << " x " << record.global_size[0] << "\n"
+            << "Group size: " << record.group_size[2] << " x "
+            << record.group_size[1] << " x " << record.group_size[0] << "\n"
+            << "Captured allocations: " << record.allocations.size()
+            << std::endl;
+
+  rt::runtime_keep_alive_token rt_token;
+  rt::kernel_replay replay{rt_token.get(), record, config};
+  err = replay.init();
+  if(!err.is_success()) {
+    std::cerr << err.what() << std::endl;
+    return -1;
+  }
+
+  using clock = std::chrono::steady_clock;
+  auto launch = [&](double &elapsed_us) -> bool {
+    if(restore_memory) {
+      auto restore_err = replay.restore_memory();
+      if(!restore_err.is_success()) {
+        std::cerr << restore_err.what() << std::endl;
+        return false;
+      }
+    }
+    auto start = clock::now();
+    auto launch_err = replay.launch();
+    auto stop = clock::now();
+    if(!launch_err.is_success()) {
+      std::cerr << launch_err.what() << std::endl;
+      return false;
+    }
+    elapsed_us =
+        std::chrono::duration<double, std::micro>(stop - start).count();
+    return true;
+  };
+
+  // The first launch includes JIT compilation
+  double first_us = 0;
+  if(!launch(first_us))
+    return -1;
+  std::cout << "First launch (including JIT compilation): " << first_us
+            << " us" << std::endl;
+
+  std::vector<double> timings;
+  for(std::size_t i = 0; i < num_runs; ++i) {
+    double elapsed_us = 0;
+    if(!launch(elapsed_us))
+      return -1;
+    timings.push_back(elapsed_us);
+  }
+
+  if(!timings.empty()) {
+    std::sort(timings.begin(), timings.end());
+    double sum = 0;
+    for(double t : timings)
+      sum += t;
+    std::cout << "Launches: " << timings.size() << "\n"
+              << "  min: " << timings.front() << " us\n"
+              << "  median: " << timings[timings.size() / 2] << " us\n"
+              << "  mean: " << sum / timings.size() << " us\n"
+              << "  max: " << timings.back() << " us" << std::endl;
+  }
+  return 0;
+}
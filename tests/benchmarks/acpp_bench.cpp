@@ -0,0 +1,574 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "acpp_bench.hpp"
+
+#include "hipSYCL/runtime/backend.hpp"
+#include "hipSYCL/runtime/hardware.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+
+namespace acpp_bench {
+
+namespace {
+
+struct registered_benchmark {
+  std::string name;
+  benchmark_function f;
+  std::vector<std::vector<int64_t>> args;
+};
+
+std::vector<registered_benchmark>& get_registry() {
+  static std::vector<registered_benchmark> registry;
+  return registry;
+}
+
+struct options {
+  std::string filter = ".*";
+  double min_time = 0.5;
+  std::size_t repetitions = 1;
+  std::string format = "console";
+  std::string out_file;
+  std::string out_format = "json";
+  bool list_only = false;
+};
+
+struct run_result {
+  std::string name;
+  std::string run_name;
+  std::string run_type;
+  std::string aggregate_name;
+  std::size_t family_index = 0;
+  std::size_t instance_index = 0;
+  std::size_t repetition_index = 0;
+  std::size_t iterations = 0;
+  double real_time = 0.0;
+  double cpu_time = 0.0;
+  double items_per_second = 0.0;
+  double bytes_per_second = 0.0;
+  std::string label;
+  std::map<std::string, double> counters;
+  bool error_occurred = false;
+  std::string error_message;
+};
+
+bool parse_flag(const std::string& arg, const std::string& flag,
+                std::string& value) {
+  std::string prefix = "--" + flag + "=";
+  if(arg.compare(0, prefix.size(), prefix) != 0)
+    return false;
+  value = arg.substr(prefix.size());
+  return true;
+}
+
+std::string make_instance_name(const std::string &name,
+                               const std::vector<int64_t> &args) {
+  std::string result = name;
+  for(int64_t arg : args)
+    result += "/" + std::to_string(arg);
+  return result;
+}
+
+run_result run_once(const registered_benchmark& b,
+                    const std::vector<int64_t>& args,
+                    const options& opts) {
+  const double min_time_ns = opts.min_time * 1.e9;
+  std::size_t iterations = 1;
+  while(true) {
+    state s{iterations, args};
+    b.f(s);
+
+    bool is_done = s.has_error() || s.get_real_time_ns() >= min_time_ns ||
+                   iterations >= 1000000000;
+    if(is_done) {
+      run_result r;
+      r.iterations = s.iterations();
+      r.error_occurred = s.has_error();
+      r.error_message = s.get_error_message();
+      r.label = s.get_label();
+      r.counters = s.counters;
+      if(r.iterations > 0) {
+        r.real_time = s.get_real_time_ns() / r.iterations;
+        r.cpu_time = s.get_cpu_time_ns() / r.iterations;
+      }
+      double seconds = s.get_real_time_ns() * 1.e-9;
+      if(seconds > 0.0) {
+        r.items_per_second = s.get_items_processed() / seconds;
+        r.bytes_per_second = s.get_bytes_processed() / seconds;
+      }
+      return r;
+    }
+
+    // Like Google Benchmark, predict the required number of iterations
+    // with some safety margin, but grow at most by a factor of 10.
+    double multiplier = s.get_real_time_ns() > 0.0
+                            ? min_time_ns * 1.4 / s.get_real_time_ns()
+                            : 10.0;
+    multiplier = std::min(std::max(multiplier, 2.0), 10.0);
+    iterations = static_cast<std::size_t>(
+        std::min(iterations * multiplier, 1.e9));
+  }
+}
+
+std::vector<run_result> compute_aggregates(const std::vector<run_result>& runs) {
+  std::vector<run_result> aggregates;
+  if(runs.size() < 2 || runs.front().error_occurred)
+    return aggregates;
+
+  auto aggregate = [&](const std::string& aggregate_name,
+                       auto&& statistic) {
+    run_result r = runs.front();
+    r.name = r.run_name + "_" + aggregate_name;
+    r.run_type = "aggregate";
+    r.aggregate_name = aggregate_name;
+    r.iterations = runs.size();
+
+    auto apply = [&](auto member) {
+      std::vector<double> values;
+      for(const auto& run : runs)
+        values.push_back(run.*member);
+      return statistic(values);
+    };
+    r.real_time = apply(&run_result::real_time);
+    r.cpu_time = apply(&run_result::cpu_time);
+    r.items_per_second = apply(&run_result::items_per_second);
+    r.bytes_per_second = apply(&run_result::bytes_per_second);
+    for(auto& counter : r.counters) {
+      std::vector<double> values;
+      for(const auto& run : runs)
+        values.push_back(run.counters.at(counter.first));
+      counter.second = statistic(values);
+    }
+    aggregates.push_back(r);
+  };
+
+  auto mean = [](std::vector<double> values) {
+    double sum = 0.0;
+    for(double v : values)
+      sum += v;
+    return sum / values.size();
+  };
+  auto median = [](std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    std::size_t n = values.size();
+    return n % 2 == 0 ? 0.5 * (values[n / 2 - 1] + values[n / 2])
+                      : values[n / 2];
+  };
+  auto stddev = [&](std::vector<double> values) {
+    double m = mean(values);
+    double sum = 0.0;
+    for(double v : values)
+      sum += (v - m) * (v - m);
+    return std::sqrt(sum / (values.size() - 1));
+  };
+
+  aggregate("mean", mean);
+  aggregate("median", median);
+  aggregate("stddev", stddev);
+  return aggregates;
+}
+
+void write_json_string(std::ostream& ostr, const std::string& str) {
+  ostr << '"';
+  for(char c : str) {
+    if(c == '"' || c == '\\')
+      ostr << '\\' << c;
+    else if(static_cast<unsigned char>(c) < 0x20)
+      ostr << ' ';
+    else
+      ostr << c;
+  }
+  ostr << '"';
+}
+
+void write_json(std::ostream& ostr, const std::vector<run_result>& results,
+                const std::string& executable) {
+  std::time_t now = std::time(nullptr);
+  char date[64];
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z",
+                std::localtime(&now));
+
+  ostr << std::setprecision(10);
+  ostr << "{\n  \"context\": {\n    \"date\": ";
+  write_json_string(ostr, date);
+  ostr << ",\n    \"executable\": ";
+  write_json_string(ostr, executable);
+  ostr << ",\n    \"num_cpus\": " << std::thread::hardware_concurrency()
+       << ",\n    \"devices\": [";
+  auto devices = sycl::device::get_devices();
+  for(std::size_t i = 0; i < devices.size(); ++i) {
+    ostr << (i > 0 ? ", " : "") << "{\"tag\": ";
+    write_json_string(ostr, get_device_tag(devices[i]));
+    ostr << ", \"name\": ";
+    write_json_string(ostr, devices[i].get_info<sycl::info::device::name>());
+    ostr << "}";
+  }
+  ostr << "]\n  },\n  \"benchmarks\": [";
+
+  for(std::size_t i = 0; i < results.size(); ++i) {
+    const run_result& r = results[i];
+    ostr << (i > 0 ? "," : "") << "\n    {\n      \"name\": ";
+    write_json_string(ostr, r.name);
+    ostr << ",\n      \"family_index\": " << r.family_index
+         << ",\n      \"per_family_instance_index\": " << r.instance_index
+         << ",\n      \"run_name\": ";
+    write_json_string(ostr, r.run_name);
+    ostr << ",\n      \"run_type\": ";
+    write_json_string(ostr, r.run_type);
+    if(r.run_type == "aggregate") {
+      ostr << ",\n      \"aggregate_name\": ";
+      write_json_string(ostr, r.aggregate_name);
+    } else {
+      ostr << ",\n      \"repetition_index\": " << r.repetition_index;
+    }
+    ostr << ",\n      \"threads\": 1";
+    if(r.error_occurred) {
+      ostr << ",\n      \"error_occurred\": true,\n      \"error_message\": ";
+      write_json_string(ostr, r.error_message);
+    }
+    ostr << ",\n      \"iterations\": " << r.iterations
+         << ",\n      \"real_time\": " << r.real_time
+         << ",\n      \"cpu_time\": " << r.cpu_time
+         << ",\n      \"time_unit\": \"ns\"";
+    if(r.items_per_second > 0.0)
+      ostr << ",\n      \"items_per_second\": " << r.items_per_second;
+    if(r.bytes_per_second > 0.0)
+      ostr << ",\n      \"bytes_per_second\": " << r.bytes_per_second;
+    for(const auto& counter : r.counters) {
+      ostr << ",\n      ";
+      write_json_string(ostr, counter.first);
+      ostr << ": " << counter.second;
+    }
+    if(!r.label.empty()) {
+      ostr << ",\n      \"label\": ";
+      write_json_string(ostr, r.label);
+    }
+    ostr << "\n    }";
+  }
+  ostr << "\n  ]\n}\n";
+}
+
+void write_console_header(std::ostream& ostr) {
+  ostr << std::left << std::setw(60) << "Benchmark" << std::right
+       << std::setw(16) << "Time" << std::setw(16) << "CPU"
+       << std::setw(14) << "Iterations" << "\n"
+       << std::string(106, '-') << "\n";
+}
+
+void write_console_line(std::ostream& ostr, const run_result& r) {
+  ostr << std::left << std::setw(60) << r.name << std::right;
+  if(r.error_occurred) {
+    ostr << " ERROR: " << r.error_message << "\n";
+    return;
+  }
+  ostr << std::fixed << std::setprecision(1) << std::setw(13) << r.real_time
+       << " ns" << std::setw(13) << r.cpu_time << " ns" << std::setw(14)
+       << r.iterations;
+  if(r.items_per_second > 0.0)
+    ostr << " items/s=" << std::setprecision(3) << std::scientific
+         << r.items_per_second;
+  if(r.bytes_per_second > 0.0)
+    ostr << " bytes/s=" << std::setprecision(3) << std::scientific
+         << r.bytes_per_second;
+  for(const auto& counter : r.counters)
+    ostr << " " << counter.first << "=" << std::setprecision(3)
+         << std::scientific << counter.second;
+  if(!r.label.empty())
+    ostr << " " << r.label;
+  ostr << std::defaultfloat << "\n";
+}
+
+}
+
+state::state(std::size_t max_iterations, std::vector<int64_t> args)
+    : _max_iterations{max_iterations}, _args{std::move(args)} {}
+
+void state::pause_timing() {
+  if(!_is_timing)
+    return;
+  _real_time_ns += std::chrono::duration<double, std::nano>(
+                       std::chrono::steady_clock::now() - _real_begin)
+                       .count();
+  _cpu_time_ns += static_cast<double>(std::clock() - _cpu_begin) * 1.e9 /
+                  CLOCKS_PER_SEC;
+  _is_timing = false;
+}
+
+void state::resume_timing() {
+  if(_is_timing)
+    return;
+  _real_begin = std::chrono::steady_clock::now();
+  _cpu_begin = std::clock();
+  _is_timing = true;
+}
+
+void state::skip_with_error(const std::string& message) {
+  _has_error = true;
+  _error_message = message;
+}
+
+void register_benchmark(const std::string &name, benchmark_function f,
+                        std::vector<std::vector<int64_t>> args) {
+  get_registry().push_back(
+      registered_benchmark{name, std::move(f), std::move(args)});
+}
+
+thread_team::thread_team(std::size_t num_threads) {
+  for(std::size_t i = 0; i < num_threads; ++i)
+    _threads.emplace_back([this, i]() { work(i); });
+}
+
+thread_team::~thread_team() {
+  {
+    std::lock_guard<std::mutex> lock{_mutex};
+    _is_shutting_down = true;
+  }
+  _start_condition.notify_all();
+  for(auto& t : _threads)
+    t.join();
+}
+
+void thread_team::run(const std::function<void(std::size_t)>& f) {
+  std::unique_lock<std::mutex> lock{_mutex};
+  _f = f;
+  _num_running = _threads.size();
+  ++_generation;
+  _start_condition.notify_all();
+  _completion_condition.wait(lock, [this]() { return _num_running == 0; });
+}
+
+void thread_team::work(std::size_t thread_index) {
+  std::size_t generation = 0;
+  while(true) {
+    std::function<void(std::size_t)> f;
+    {
+      std::unique_lock<std::mutex> lock{_mutex};
+      _start_condition.wait(lock, [&]() {
+        return _is_shutting_down || _generation != generation;
+      });
+      if(_is_shutting_down)
+        return;
+      generation = _generation;
+      f = _f;
+    }
+    f(thread_index);
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      if(--_num_running == 0)
+        _completion_condition.notify_all();
+    }
+  }
+}
+
+std::string get_device_tag(const sycl::device& dev) {
+  hipsycl::rt::device_id id = dev.AdaptiveCpp_device_id();
+  std::string backend;
+  switch(id.get_backend()) {
+  case hipsycl::rt::backend_id::cuda:
+    backend = "cuda";
+    break;
+  case hipsycl::rt::backend_id::hip:
+    backend = "hip";
+    break;
+  case hipsycl::rt::backend_id::level_zero:
+    backend = "ze";
+    break;
+  case hipsycl::rt::backend_id::ocl:
+    backend = "ocl";
+    break;
+  case hipsycl::rt::backend_id::omp:
+    backend = "omp";
+    break;
+  }
+  return backend + ":" + std::to_string(id.get_id());
+}
+
+double get_peak_memory_bandwidth(const sycl::device& dev) {
+  static std::mutex mutex;
+  static std::map<std::string, double> bandwidths;
+
+  std::lock_guard<std::mutex> lock{mutex};
+  const std::string tag = get_device_tag(dev);
+  auto it = bandwidths.find(tag);
+  if(it != bandwidths.end())
+    return it->second;
+
+  double bandwidth = static_cast<double>(
+      dev.AdaptiveCpp_runtime()
+          ->backends()
+          .get(dev.AdaptiveCpp_device_id().get_backend())
+          ->get_hardware_manager()
+          ->get_device(dev.AdaptiveCpp_device_id().get_id())
+          ->get_property(hipsycl::rt::device_uint_property::peak_memory_bandwidth));
+
+  if(bandwidth == 0.0) {
+    // Best of several copies, each of which reads and writes num_bytes
+    const std::size_t num_bytes = 256 * 1024 * 1024;
+    sycl::queue q{dev, sycl::property::queue::in_order{}};
+    char* src = sycl::malloc_device<char>(num_bytes, q);
+    char* dest = sycl::malloc_device<char>(num_bytes, q);
+    if(src && dest) {
+      q.memset(src, 0, num_bytes);
+      q.memcpy(dest, src, num_bytes);
+      q.wait();
+      double best_time = 0.0;
+      for(int i = 0; i < 5; ++i) {
+        auto begin = std::chrono::steady_clock::now();
+        q.memcpy(dest, src, num_bytes);
+        q.wait();
+        double time = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - begin).count();
+        if(i == 0 || time < best_time)
+          best_time = time;
+      }
+      if(best_time > 0.0)
+        bandwidth = 2.0 * num_bytes / best_time;
+    }
+    if(src)
+      sycl::free(src, q);
+    if(dest)
+      sycl::free(dest, q);
+  }
+
+  bandwidths[tag] = bandwidth;
+  return bandwidth;
+}
+
+void set_roofline_counters(state& s, const sycl::device& dev) {
+  const double seconds = s.get_real_time_ns() * 1.e-9;
+  const double peak = get_peak_memory_bandwidth(dev);
+  s.counters["peak_bytes_per_second"] = peak;
+  if(seconds > 0.0 && peak > 0.0)
+    s.counters["fraction_of_peak_bandwidth"] =
+        s.get_bytes_processed() / seconds / peak;
+}
+
+}
+
+int main(int argc, char** argv) {
+  using namespace acpp_bench;
+
+  options opts;
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    std::string value;
+    if(parse_flag(arg, "benchmark_filter", value))
+      opts.filter = value;
+    else if(parse_flag(arg, "benchmark_min_time", value))
+      // Google Benchmark accepts an optional 's' suffix
+      opts.min_time = std::stod(value);
+    else if(parse_flag(arg, "benchmark_repetitions", value))
+      opts.repetitions = std::max(std::stoul(value), 1ul);
+    else if(parse_flag(arg, "benchmark_format", value))
+      opts.format = value;
+    else if(parse_flag(arg, "benchmark_out", value))
+      opts.out_file = value;
+    else if(parse_flag(arg, "benchmark_out_format", value))
+      opts.out_format = value;
+    else if(arg == "--benchmark_list_tests" ||
+            arg == "--benchmark_list_tests=true")
+      opts.list_only = true;
+    else {
+      std::cerr
+          << "Usage: " << argv[0]
+          << " [--benchmark_filter=<regex>] [--benchmark_min_time=<seconds>]\n"
+             "    [--benchmark_repetitions=<n>] "
+             "[--benchmark_format=<console|json>]\n"
+             "    [--benchmark_out=<file>] "
+             "[--benchmark_out_format=<console|json>]\n"
+             "    [--benchmark_list_tests]\n";
+      return arg == "--help" ? 0 : 1;
+    }
+  }
+
+#ifdef ACPP_BENCH_STDPAR
+  register_stdpar_benchmarks();
+#else
+  register_queue_benchmarks();
+  register_memory_benchmarks();
+  register_runtime_benchmarks();
+  register_algorithms_benchmarks();
+#endif
+
+  std::regex filter{opts.filter};
+  std::vector<run_result> results;
+  const bool print_console = opts.format == "console" && !opts.list_only;
+  if(print_console)
+    write_console_header(std::cout);
+
+  const auto& registry = get_registry();
+  std::size_t family_index = 0;
+  for(const auto& b : registry) {
+    bool has_matching_instance = false;
+    for(std::size_t instance = 0; instance < b.args.size(); ++instance) {
+      std::string run_name = make_instance_name(b.name, b.args[instance]);
+      if(!std::regex_search(run_name, filter))
+        continue;
+      has_matching_instance = true;
+
+      if(opts.list_only) {
+        std::cout << run_name << "\n";
+        continue;
+      }
+
+      std::vector<run_result> runs;
+      for(std::size_t rep = 0; rep < opts.repetitions; ++rep) {
+        run_result r = run_once(b, b.args[instance], opts);
+        r.name = run_name;
+        r.run_name = run_name;
+        r.run_type = "iteration";
+        r.family_index = family_index;
+        r.instance_index = instance;
+        r.repetition_index = rep;
+        if(print_console)
+          write_console_line(std::cout, r);
+        runs.push_back(r);
+      }
+      for(const auto& aggregate : compute_aggregates(runs)) {
+        if(print_console)
+          write_console_line(std::cout, aggregate);
+        runs.push_back(aggregate);
+      }
+      results.insert(results.end(), runs.begin(), runs.end());
+    }
+    if(has_matching_instance)
+      ++family_index;
+  }
+
+  if(opts.list_only)
+    return 0;
+
+  if(opts.format == "json")
+    write_json(std::cout, results, argv[0]);
+
+  if(!opts.out_file.empty()) {
+    std::ofstream out{opts.out_file};
+    if(!out.is_open()) {
+      std::cerr << "Could not open " << opts.out_file << " for writing\n";
+      return 1;
+    }
+    if(opts.out_format == "console") {
+      write_console_header(out);
+      for(const auto& r : results)
+        write_console_line(out, r);
+    } else {
+      write_json(out, results, argv[0]);
+    }
+  }
+
+  return 0;
+}
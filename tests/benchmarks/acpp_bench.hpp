@@ -0,0 +1,142 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#ifndef ACPP_BENCH_HPP
+#define ACPP_BENCH_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sycl/sycl.hpp>
+
+namespace acpp_bench {
+
+// A minimal microbenchmark harness modelled after Google Benchmark: Its
+// command line flags and JSON output follow the same conventions, such that
+// existing tooling (e.g. compare.py) can be used to detect regressions.
+class state {
+public:
+  state(std::size_t max_iterations, std::vector<int64_t> args);
+
+  /// Must be called in a loop around the benchmarked code:
+  /// while(state.keep_running()) { ... }
+  bool keep_running() {
+    if(_iterations == 0 && !_is_timing)
+      resume_timing();
+    if(_iterations < _max_iterations && !_has_error) {
+      ++_iterations;
+      return true;
+    }
+    pause_timing();
+    return false;
+  }
+
+  /// Excludes the following code from the measurement until
+  /// resume_timing() is called.
+  void pause_timing();
+  void resume_timing();
+
+  int64_t range(std::size_t i) const { return _args.at(i); }
+  std::size_t iterations() const { return _iterations; }
+
+  void set_items_processed(int64_t items) { _items_processed = items; }
+  void set_bytes_processed(int64_t bytes) { _bytes_processed = bytes; }
+  void set_label(const std::string& label) { _label = label; }
+  void skip_with_error(const std::string& message);
+
+  /// Additional values reported per benchmark run
+  std::map<std::string, double> counters;
+
+  double get_real_time_ns() const { return _real_time_ns; }
+  double get_cpu_time_ns() const { return _cpu_time_ns; }
+  int64_t get_items_processed() const { return _items_processed; }
+  int64_t get_bytes_processed() const { return _bytes_processed; }
+  const std::string& get_label() const { return _label; }
+  bool has_error() const { return _has_error; }
+  const std::string& get_error_message() const { return _error_message; }
+private:
+  std::size_t _max_iterations;
+  std::size_t _iterations = 0;
+  std::vector<int64_t> _args;
+
+  bool _is_timing = false;
+  std::chrono::steady_clock::time_point _real_begin;
+  std::clock_t _cpu_begin = 0;
+  double _real_time_ns = 0.0;
+  double _cpu_time_ns = 0.0;
+
+  int64_t _items_processed = 0;
+  int64_t _bytes_processed = 0;
+  std::string _label;
+  bool _has_error = false;
+  std::string _error_message;
+};
+
+using benchmark_function = std::function<void(state&)>;
+
+/// Registers a benchmark, which is run once for each of the argument sets.
+/// The arguments are appended to the benchmark name, separated by '/'.
+void register_benchmark(const std::string& name, benchmark_function f,
+                        std::vector<std::vector<int64_t>> args = {{}});
+
+/// Threads that repeatedly execute a function concurrently, such that
+/// multi-threaded benchmarks do not measure thread creation.
+class thread_team {
+public:
+  thread_team(std::size_t num_threads);
+  ~thread_team();
+
+  /// Invokes f(thread_index) on all threads and waits for completion.
+  void run(const std::function<void(std::size_t)>& f);
+private:
+  void work(std::size_t thread_index);
+
+  std::mutex _mutex;
+  std::condition_variable _start_condition;
+  std::condition_variable _completion_condition;
+  std::function<void(std::size_t)> _f;
+  std::size_t _generation = 0;
+  std::size_t _num_running = 0;
+  bool _is_shutting_down = false;
+  std::vector<std::thread> _threads;
+};
+
+/// Returns a short identifier of the device that remains stable
+/// across runs on the same machine, e.g. "cuda:0"
+std::string get_device_tag(const sycl::device& dev);
+
+/// Returns the peak global memory bandwidth of the device in bytes per
+/// second. If the backend does not report it, the bandwidth of a large
+/// device-to-device copy is measured once and used instead.
+double get_peak_memory_bandwidth(const sycl::device& dev);
+
+/// Relates the bytes processed by a completed benchmark to the peak memory
+/// bandwidth of the device, i.e. reports where a memory-bound algorithm lies
+/// relative to the roofline. Must be invoked after the benchmark loop.
+void set_roofline_counters(state& s, const sycl::device& dev);
+
+// Registration functions of the individual benchmark suites
+void register_queue_benchmarks();
+void register_memory_benchmarks();
+void register_runtime_benchmarks();
+void register_algorithms_benchmarks();
+void register_stdpar_benchmarks();
+
+}
+
+#endif
@@ -0,0 +1,300 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "acpp_bench.hpp"
+
+#include "hipSYCL/algorithms/algorithm.hpp"
+#include "hipSYCL/algorithms/numeric.hpp"
+#include "hipSYCL/algorithms/util/allocation_cache.hpp"
+
+#include <random>
+
+namespace algorithms = hipsycl::algorithms;
+
+namespace acpp_bench {
+
+namespace {
+
+// The benchmark argument is the base-2 logarithm of the number of elements
+const std::vector<std::vector<int64_t>> problem_sizes = {
+    {10}, {14}, {18}, {22}, {26}, {30}};
+// Sorting is not bandwidth-bound, and the largest problem sizes would
+// dominate the run time of the suite.
+const std::vector<std::vector<int64_t>> sort_problem_sizes = {
+    {10}, {14}, {18}, {22}, {26}};
+
+template<class T> const char* get_type_name();
+template<> const char* get_type_name<int>() { return "int"; }
+template<> const char* get_type_name<float>() { return "float"; }
+template<> const char* get_type_name<double>() { return "double"; }
+
+std::size_t get_problem_size(const state& s) {
+  return std::size_t{1} << s.range(0);
+}
+
+// Allocates num_arrays device arrays of num_elements elements each, or
+// skips the benchmark if they do not fit into device memory.
+template<class T>
+std::vector<T*> allocate_arrays(state& s, sycl::queue& q,
+                                std::size_t num_elements,
+                                std::size_t num_arrays) {
+  const std::size_t global_mem_size =
+      q.get_device().get_info<sycl::info::device::global_mem_size>();
+  if(num_elements * sizeof(T) > global_mem_size / num_arrays) {
+    s.skip_with_error("Problem size exceeds device memory");
+    return {};
+  }
+
+  std::vector<T*> arrays;
+  for(std::size_t i = 0; i < num_arrays; ++i) {
+    T* ptr = sycl::malloc_device<T>(num_elements, q);
+    if(!ptr) {
+      for(T* allocated : arrays)
+        sycl::free(allocated, q);
+      s.skip_with_error("USM allocation failed");
+      return {};
+    }
+    arrays.push_back(ptr);
+  }
+  return arrays;
+}
+
+template<class T>
+void free_arrays(sycl::queue& q, const std::vector<T*>& arrays) {
+  for(T* ptr : arrays)
+    sycl::free(ptr, q);
+}
+
+// Sets throughput and roofline metrics of an algorithm that processes
+// num_elements elements per iteration and moves bytes_per_element bytes
+// from and to global memory per element.
+void set_throughput(state& s, const sycl::device& dev,
+                    std::size_t num_elements, std::size_t bytes_per_element) {
+  s.set_items_processed(s.iterations() * num_elements);
+  s.set_bytes_processed(s.iterations() * num_elements * bytes_per_element);
+  set_roofline_counters(s, dev);
+}
+
+template<class T>
+void fill(state& s, const sycl::device& dev) {
+  const std::size_t n = get_problem_size(s);
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  auto arrays = allocate_arrays<T>(s, q, n, 1);
+  if(arrays.empty())
+    return;
+  T* data = arrays[0];
+  // Warm up, e.g. to trigger JIT compilation outside of the measurement
+  algorithms::fill(q, data, data + n, T{0}).wait();
+
+  while(s.keep_running()) {
+    algorithms::fill(q, data, data + n, T{1});
+    q.wait();
+  }
+  free_arrays(q, arrays);
+  set_throughput(s, dev, n, sizeof(T));
+}
+
+template<class T>
+void copy(state& s, const sycl::device& dev) {
+  const std::size_t n = get_problem_size(s);
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  auto arrays = allocate_arrays<T>(s, q, n, 2);
+  if(arrays.empty())
+    return;
+  T* src = arrays[0];
+  T* dest = arrays[1];
+  q.fill(src, T{1}, n);
+  algorithms::copy(q, src, src + n, dest).wait();
+
+  while(s.keep_running()) {
+    algorithms::copy(q, src, src + n, dest);
+    q.wait();
+  }
+  free_arrays(q, arrays);
+  set_throughput(s, dev, n, 2 * sizeof(T));
+}
+
+template<class T>
+void reduce(state& s, const sycl::device& dev) {
+  const std::size_t n = get_problem_size(s);
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  auto arrays = allocate_arrays<T>(s, q, n, 1);
+  if(arrays.empty())
+    return;
+  T* data = arrays[0];
+  T* result = sycl::malloc_device<T>(1, q);
+  q.fill(data, T{1}, n);
+
+  algorithms::util::allocation_cache scratch_cache{
+      algorithms::util::allocation_type::device};
+  {
+    algorithms::util::allocation_group scratch{&scratch_cache, dev};
+    algorithms::reduce(q, scratch, data, data + n, result, T{0}).wait();
+  }
+
+  while(s.keep_running()) {
+    algorithms::util::allocation_group scratch{&scratch_cache, dev};
+    algorithms::reduce(q, scratch, data, data + n, result, T{0});
+    q.wait();
+  }
+  sycl::free(result, q);
+  free_arrays(q, arrays);
+  set_throughput(s, dev, n, sizeof(T));
+}
+
+// Dot product of two arrays
+template<class T>
+void transform_reduce(state& s, const sycl::device& dev) {
+  const std::size_t n = get_problem_size(s);
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  auto arrays = allocate_arrays<T>(s, q, n, 2);
+  if(arrays.empty())
+    return;
+  T* a = arrays[0];
+  T* b = arrays[1];
+  T* result = sycl::malloc_device<T>(1, q);
+  q.fill(a, T{1}, n);
+  q.fill(b, T{2}, n);
+
+  algorithms::util::allocation_cache scratch_cache{
+      algorithms::util::allocation_type::device};
+  {
+    algorithms::util::allocation_group scratch{&scratch_cache, dev};
+    algorithms::transform_reduce(q, scratch, a, a + n, b, result, T{0}).wait();
+  }
+
+  while(s.keep_running()) {
+    algorithms::util::allocation_group scratch{&scratch_cache, dev};
+    algorithms::transform_reduce(q, scratch, a, a + n, b, result, T{0});
+    q.wait();
+  }
+  sycl::free(result, q);
+  free_arrays(q, arrays);
+  set_throughput(s, dev, n, 2 * sizeof(T));
+}
+
+// The algorithms library does not provide find_if, whose device
+// implementation in stdpar is based on the same early-exit search as
+// any_of. Only the last element matches, such that the entire input must
+// be searched.
+template<class T>
+void any_of(state& s, const sycl::device& dev) {
+  const std::size_t n = get_problem_size(s);
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  auto arrays = allocate_arrays<T>(s, q, n, 1);
+  if(arrays.empty())
+    return;
+  T* data = arrays[0];
+  auto* result =
+      sycl::malloc_device<algorithms::detail::early_exit_flag_t>(1, q);
+  q.fill(data, T{0}, n);
+  q.fill(data + n - 1, T{1}, 1);
+
+  auto predicate = [](T x) { return x == T{1}; };
+  algorithms::any_of(q, data, data + n, result, predicate).wait();
+
+  while(s.keep_running()) {
+    algorithms::any_of(q, data, data + n, result, predicate);
+    q.wait();
+  }
+  sycl::free(result, q);
+  free_arrays(q, arrays);
+  set_throughput(s, dev, n, sizeof(T));
+}
+
+template<class T>
+void sort(state& s, const sycl::device& dev) {
+  const std::size_t n = get_problem_size(s);
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  auto arrays = allocate_arrays<T>(s, q, n, 2);
+  if(arrays.empty())
+    return;
+  T* input = arrays[0];
+  T* data = arrays[1];
+
+  std::vector<T> host_input(n);
+  std::mt19937 gen{123};
+  std::uniform_int_distribution<int> dist{-1000000, 1000000};
+  for(auto& x : host_input)
+    x = static_cast<T>(dist(gen));
+  q.memcpy(input, host_input.data(), n * sizeof(T));
+
+  algorithms::util::allocation_cache scratch_cache{
+      algorithms::util::allocation_type::device};
+  {
+    q.memcpy(data, input, n * sizeof(T));
+    algorithms::util::allocation_group scratch{&scratch_cache, dev};
+    algorithms::sort(q, scratch, data, data + n).wait();
+  }
+
+  while(s.keep_running()) {
+    s.pause_timing();
+    q.memcpy(data, input, n * sizeof(T)).wait();
+    s.resume_timing();
+
+    algorithms::util::allocation_group scratch{&scratch_cache, dev};
+    algorithms::sort(q, scratch, data, data + n);
+    q.wait();
+  }
+  free_arrays(q, arrays);
+  // Sorting is not memory-bound, so no roofline counters are reported
+  s.set_items_processed(s.iterations() * n);
+}
+
+template<class T>
+void register_typed_benchmarks(const sycl::device& dev, const std::string& tag) {
+  const std::string suffix = std::string{"/"} + get_type_name<T>() + "/" + tag;
+
+  register_benchmark(
+      "algorithms/fill" + suffix,
+      [dev](state &s) { fill<T>(s, dev); }, problem_sizes);
+  register_benchmark(
+      "algorithms/copy" + suffix,
+      [dev](state &s) { copy<T>(s, dev); }, problem_sizes);
+  register_benchmark(
+      "algorithms/reduce" + suffix,
+      [dev](state &s) { reduce<T>(s, dev); }, problem_sizes);
+  register_benchmark(
+      "algorithms/transform_reduce" + suffix,
+      [dev](state &s) { transform_reduce<T>(s, dev); }, problem_sizes);
+  register_benchmark(
+      "algorithms/any_of" + suffix,
+      [dev](state &s) { any_of<T>(s, dev); }, problem_sizes);
+  register_benchmark(
+      "algorithms/sort" + suffix,
+      [dev](state &s) { sort<T>(s, dev); }, sort_problem_sizes);
+}
+
+}
+
+void register_algorithms_benchmarks() {
+  for(const auto& dev : sycl::device::get_devices()) {
+    const std::string tag = get_device_tag(dev);
+
+    register_typed_benchmarks<int>(dev, tag);
+    register_typed_benchmarks<float>(dev, tag);
+    if(dev.has(sycl::aspect::fp64))
+      register_typed_benchmarks<double>(dev, tag);
+  }
+}
+
+}
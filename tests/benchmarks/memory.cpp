@@ -0,0 +1,112 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "acpp_bench.hpp"
+
+namespace acpp_bench {
+
+class usm_kernel;
+class usm_kernel_warmup;
+class buffer_kernel;
+class buffer_kernel_warmup;
+
+namespace {
+
+// Round trip of a kernel that accesses a USM allocation. Together with the
+// buffer benchmark, this shows the overhead of buffer dependency tracking
+// and data management.
+void usm_kernel_round_trip(state& s, const sycl::device& dev) {
+  const std::size_t num_elements = static_cast<std::size_t>(s.range(0));
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  int* data = sycl::malloc_device<int>(num_elements, q);
+  if(!data) {
+    s.skip_with_error("USM allocation failed");
+    return;
+  }
+  q.single_task<usm_kernel_warmup>([=]() { data[0] = 0; }).wait();
+
+  while(s.keep_running()) {
+    q.single_task<usm_kernel>([=]() { data[0] += 1; });
+    q.wait();
+  }
+  sycl::free(data, q);
+}
+
+void buffer_kernel_round_trip(state& s, const sycl::device& dev) {
+  const std::size_t num_elements = static_cast<std::size_t>(s.range(0));
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  sycl::buffer<int> buff{sycl::range<1>{num_elements}};
+  q.submit([&](sycl::handler& cgh) {
+    sycl::accessor acc{buff, cgh, sycl::write_only, sycl::no_init};
+    cgh.single_task<buffer_kernel_warmup>([=]() { acc[0] = 0; });
+  }).wait();
+
+  while(s.keep_running()) {
+    q.submit([&](sycl::handler& cgh) {
+      sycl::accessor acc{buff, cgh, sycl::read_write};
+      cgh.single_task<buffer_kernel>([=]() { acc[0] += 1; });
+    });
+    q.wait();
+  }
+}
+
+// Host to device and device to host copies of USM memory
+void usm_memcpy(state& s, const sycl::device& dev, bool to_device) {
+  const std::size_t num_bytes = static_cast<std::size_t>(s.range(0));
+  sycl::queue q{dev, sycl::property::queue::in_order{}};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+
+  std::vector<char> host_data(num_bytes);
+  char* device_data = sycl::malloc_device<char>(num_bytes, q);
+  if(!device_data) {
+    s.skip_with_error("USM allocation failed");
+    return;
+  }
+
+  while(s.keep_running()) {
+    if(to_device)
+      q.memcpy(device_data, host_data.data(), num_bytes);
+    else
+      q.memcpy(host_data.data(), device_data, num_bytes);
+    q.wait();
+  }
+  sycl::free(device_data, q);
+  s.set_bytes_processed(s.iterations() * num_bytes);
+}
+
+}
+
+void register_memory_benchmarks() {
+  for(const auto& dev : sycl::device::get_devices()) {
+    const std::string tag = get_device_tag(dev);
+
+    register_benchmark(
+        "usm_kernel_round_trip/" + tag,
+        [dev](state &s) { usm_kernel_round_trip(s, dev); }, {{1}, {1 << 20}});
+    register_benchmark(
+        "buffer_kernel_round_trip/" + tag,
+        [dev](state &s) { buffer_kernel_round_trip(s, dev); },
+        {{1}, {1 << 20}});
+    register_benchmark(
+        "usm_memcpy/host_to_device/" + tag,
+        [dev](state &s) { usm_memcpy(s, dev, true); },
+        {{4}, {4096}, {1 << 20}});
+    register_benchmark(
+        "usm_memcpy/device_to_host/" + tag,
+        [dev](state &s) { usm_memcpy(s, dev, false); },
+        {{4}, {4096}, {1 << 20}});
+  }
+}
+
+}
@@ -0,0 +1,184 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "acpp_bench.hpp"
+
+namespace acpp_bench {
+
+class empty_kernel_submit_in_order;
+class empty_kernel_submit_out_of_order;
+class empty_kernel_round_trip_in_order;
+class empty_kernel_round_trip_out_of_order;
+class multi_threaded_submit_in_order;
+class multi_threaded_submit_out_of_order;
+class event_wait_completed_kernel;
+class event_wait_pending_kernel;
+
+namespace {
+
+// Submissions are waited for in batches such that the benchmarks measure
+// submission, and not an ever-growing backlog of work.
+constexpr std::size_t max_pending_submissions = 1024;
+
+sycl::queue make_queue(const sycl::device& dev, bool in_order) {
+  if(in_order)
+    return sycl::queue{dev, sycl::property::queue::in_order{}};
+  return sycl::queue{dev};
+}
+
+// Each kernel name must only be used with this function, since kernel names
+// must be unique.
+template<class KernelName>
+sycl::event submit_empty_kernel(sycl::queue& q) {
+  return q.single_task<KernelName>([=](){});
+}
+
+// Cost of submitting an empty kernel, excluding its execution.
+template<class KernelName>
+void empty_kernel_submit(state& s, const sycl::device& dev, bool in_order) {
+  sycl::queue q = make_queue(dev, in_order);
+  s.set_label(dev.get_info<sycl::info::device::name>());
+  // Warm up, e.g. to trigger JIT compilation outside of the measurement
+  submit_empty_kernel<KernelName>(q);
+  q.wait();
+
+  std::size_t num_pending = 0;
+  while(s.keep_running()) {
+    submit_empty_kernel<KernelName>(q);
+    if(++num_pending == max_pending_submissions) {
+      s.pause_timing();
+      q.wait();
+      num_pending = 0;
+      s.resume_timing();
+    }
+  }
+  q.wait();
+  s.set_items_processed(s.iterations());
+}
+
+// Latency of submitting an empty kernel and waiting for its completion.
+template<class KernelName>
+void empty_kernel_round_trip(state& s, const sycl::device& dev,
+                             bool in_order) {
+  sycl::queue q = make_queue(dev, in_order);
+  s.set_label(dev.get_info<sycl::info::device::name>());
+  submit_empty_kernel<KernelName>(q);
+  q.wait();
+
+  while(s.keep_running()) {
+    submit_empty_kernel<KernelName>(q);
+    q.wait();
+  }
+  s.set_items_processed(s.iterations());
+}
+
+// Throughput of empty kernel submissions to a shared queue from multiple
+// threads.
+template<class KernelName>
+void multi_threaded_submit(state& s, const sycl::device& dev, bool in_order) {
+  const std::size_t num_threads = static_cast<std::size_t>(s.range(0));
+  const std::size_t submissions_per_thread = 64;
+
+  sycl::queue q = make_queue(dev, in_order);
+  s.set_label(dev.get_info<sycl::info::device::name>());
+  submit_empty_kernel<KernelName>(q);
+  q.wait();
+
+  thread_team team{num_threads};
+  while(s.keep_running()) {
+    team.run([&](std::size_t) {
+      for(std::size_t i = 0; i < submissions_per_thread; ++i)
+        submit_empty_kernel<KernelName>(q);
+    });
+    s.pause_timing();
+    q.wait();
+    s.resume_timing();
+  }
+  s.set_items_processed(s.iterations() * num_threads *
+                        submissions_per_thread);
+}
+
+// Wait on an event of an operation that has already completed
+template<class KernelName>
+void event_wait_completed(state& s, const sycl::device& dev) {
+  sycl::queue q{dev};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+  sycl::event evt = submit_empty_kernel<KernelName>(q);
+  evt.wait();
+
+  while(s.keep_running())
+    evt.wait();
+}
+
+// Wait on an event of an operation that was just submitted. Only the
+// wait is measured.
+template<class KernelName>
+void event_wait_pending(state& s, const sycl::device& dev) {
+  sycl::queue q{dev};
+  s.set_label(dev.get_info<sycl::info::device::name>());
+  submit_empty_kernel<KernelName>(q).wait();
+
+  while(s.keep_running()) {
+    s.pause_timing();
+    sycl::event evt = submit_empty_kernel<KernelName>(q);
+    s.resume_timing();
+    evt.wait();
+  }
+}
+
+}
+
+void register_queue_benchmarks() {
+  for(const auto& dev : sycl::device::get_devices()) {
+    const std::string tag = get_device_tag(dev);
+
+    register_benchmark("empty_kernel_submit/in_order/" + tag,
+                       [dev](state &s) {
+                         empty_kernel_submit<empty_kernel_submit_in_order>(
+                             s, dev, true);
+                       });
+    register_benchmark("empty_kernel_submit/out_of_order/" + tag,
+                       [dev](state &s) {
+                         empty_kernel_submit<empty_kernel_submit_out_of_order>(
+                             s, dev, false);
+                       });
+    register_benchmark(
+        "empty_kernel_round_trip/in_order/" + tag, [dev](state &s) {
+          empty_kernel_round_trip<empty_kernel_round_trip_in_order>(s, dev,
+                                                                    true);
+        });
+    register_benchmark(
+        "empty_kernel_round_trip/out_of_order/" + tag, [dev](state &s) {
+          empty_kernel_round_trip<empty_kernel_round_trip_out_of_order>(
+              s, dev, false);
+        });
+    register_benchmark(
+        "multi_threaded_submit/in_order/" + tag,
+        [dev](state &s) {
+          multi_threaded_submit<multi_threaded_submit_in_order>(s, dev, true);
+        },
+        {{1}, {2}, {4}, {8}});
+    register_benchmark(
+        "multi_threaded_submit/out_of_order/" + tag,
+        [dev](state &s) {
+          multi_threaded_submit<multi_threaded_submit_out_of_order>(s, dev,
+                                                                    false);
+        },
+        {{1}, {2}, {4}, {8}});
+    register_benchmark("event_wait/completed/" + tag, [dev](state &s) {
+      event_wait_completed<event_wait_completed_kernel>(s, dev);
+    });
+    register_benchmark("event_wait/pending/" + tag, [dev](state &s) {
+      event_wait_pending<event_wait_pending_kernel>(s, dev);
+    });
+  }
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "acpp_bench.hpp"
+
+#include "hipSYCL/glue/kernel_launcher_data.hpp"
+#include "hipSYCL/runtime/application.hpp"
+#include "hipSYCL/runtime/dag_builder.hpp"
+#include "hipSYCL/runtime/data.hpp"
+#include "hipSYCL/runtime/kernel_cache.hpp"
+#include "hipSYCL/runtime/kernel_configuration.hpp"
+#include "hipSYCL/runtime/kernel_launcher.hpp"
+#include "hipSYCL/runtime/operations.hpp"
+
+#include <memory>
+
+namespace rt = hipsycl::rt;
+
+namespace acpp_bench {
+
+namespace {
+
+class dummy_code_object : public rt::code_object {
+public:
+  rt::code_object_state state() const override {
+    return rt::code_object_state::executable;
+  }
+  rt::code_format format() const override { return rt::code_format::native_isa; }
+  rt::backend_id managing_backend() const override {
+    return rt::backend_id::omp;
+  }
+  rt::hcf_object_id hcf_source() const override { return 0; }
+  std::string target_arch() const override { return "bench"; }
+  rt::compilation_flow source_compilation_flow() const override {
+    return rt::compilation_flow::sscp;
+  }
+  std::vector<std::string> supported_backend_kernel_names() const override {
+    return {};
+  }
+  bool contains(const std::string &) const override { return false; }
+};
+
+rt::kernel_configuration make_configuration(uint64_t seed) {
+  rt::kernel_configuration config;
+  config.append_base_configuration(
+      rt::kernel_base_config_parameter::backend_id, seed);
+  config.set_build_option(rt::kernel_build_option::known_group_size_x,
+                          static_cast<unsigned>(128));
+  config.set_specialized_kernel_argument(0, seed);
+  return config;
+}
+
+// Lookup of a code object that is already in the in-memory kernel cache,
+// as happens for every launch of a JIT-compiled kernel.
+void kernel_cache_hit(state& s) {
+  auto cache = rt::kernel_cache::get();
+  auto id = make_configuration(s.range(0)).generate_id();
+  cache->get_or_construct_code_object(id, []() -> const rt::code_object * {
+    return new dummy_code_object;
+  });
+
+  while(s.keep_running()) {
+    const rt::code_object* obj = cache->get_or_construct_code_object(
+        id, []() -> const rt::code_object * { return nullptr; });
+    if(!obj)
+      s.skip_with_error("kernel_cache lookup missed");
+  }
+}
+
+// Construction of a kernel configuration and its id, which precedes
+// each kernel_cache lookup.
+void kernel_configuration_id(state& s) {
+  uint64_t seed = 0;
+  while(s.keep_running()) {
+    auto id = make_configuration(++seed).generate_id();
+    // Prevent the computation from being optimized away
+    if(id[0] == 0 && id[1] == 0)
+      s.counters["zero_ids"] += 1;
+  }
+}
+
+// Cost of adding a command group with a varying number of buffer
+// requirements to the DAG.
+void dag_builder_add_command_group(state& s) {
+  const std::size_t num_requirements = static_cast<std::size_t>(s.range(0));
+  rt::runtime_keep_alive_token rt;
+
+  rt::device_id dev{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                           rt::api_platform::omp},
+                    0};
+  rt::execution_hints hints;
+  hints.set_hint(rt::hints::bind_to_device{dev});
+
+  const rt::range<3> num_elements{1024, 1, 1};
+  std::vector<std::shared_ptr<rt::buffer_data_region>> regions;
+  for(std::size_t i = 0; i < num_requirements; ++i)
+    regions.push_back(std::make_shared<rt::buffer_data_region>(
+        num_elements, sizeof(int), num_elements));
+
+  rt::dag_builder builder{rt.get()};
+  while(s.keep_running()) {
+    rt::requirements_list reqs{rt.get()};
+    // Each access replaces the previous user of the region, so the
+    // number of tracked users remains constant.
+    for(const auto& region : regions)
+      reqs.add_requirement(std::make_unique<rt::buffer_memory_requirement>(
+          region, rt::id<3>{0, 0, 0}, num_elements,
+          sycl::access::mode::read_write, sycl::access::target::device));
+
+    auto op = rt::make_operation<rt::kernel_operation>(
+        "bench_kernel",
+        rt::kernel_launcher{hipsycl::glue::kernel_launcher_data{},
+                            hipsycl::common::auto_small_vector<
+                                std::unique_ptr<rt::backend_kernel_launcher>>{}},
+        reqs);
+    builder.add_command_group(std::move(op), reqs, hints);
+
+    s.pause_timing();
+    rt::dag d = builder.finish_and_reset();
+    d.for_each_node([](rt::dag_node_ptr node) { node->cancel(); });
+    s.resume_timing();
+  }
+  s.set_items_processed(s.iterations());
+}
+
+}
+
+void register_runtime_benchmarks() {
+  register_benchmark("kernel_cache_hit", kernel_cache_hit, {{1}});
+  register_benchmark("kernel_configuration_id", kernel_configuration_id);
+  register_benchmark("dag_builder_add_command_group",
+                     dag_builder_add_command_group,
+                     {{0}, {1}, {2}, {4}, {8}, {16}, {32}});
+}
+
+}
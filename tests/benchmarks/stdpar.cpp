@@ -0,0 +1,174 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+#include "acpp_bench.hpp"
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// These benchmarks measure the stdpar entry points, including the
+// overheads of offloading decisions and memory management. They are
+// compiled with --acpp-stdpar into the separate acpp-bench-stdpar
+// executable.
+
+namespace acpp_bench {
+
+namespace {
+
+// The benchmark argument is the base-2 logarithm of the number of elements
+const std::vector<std::vector<int64_t>> problem_sizes = {
+    {10}, {14}, {18}, {22}, {26}, {30}};
+const std::vector<std::vector<int64_t>> sort_problem_sizes = {
+    {10}, {14}, {18}, {22}, {26}};
+
+template<class T> const char* get_type_name();
+template<> const char* get_type_name<int>() { return "int"; }
+template<> const char* get_type_name<float>() { return "float"; }
+template<> const char* get_type_name<double>() { return "double"; }
+
+std::size_t get_problem_size(const state& s) {
+  return std::size_t{1} << s.range(0);
+}
+
+// The device that offloaded stdpar algorithms execute on
+const sycl::device& get_stdpar_device() {
+  static sycl::device dev{sycl::default_selector_v};
+  return dev;
+}
+
+void set_throughput(state& s, std::size_t num_elements,
+                    std::size_t bytes_per_element) {
+  s.set_label(get_stdpar_device().get_info<sycl::info::device::name>());
+  s.set_items_processed(s.iterations() * num_elements);
+  s.set_bytes_processed(s.iterations() * num_elements * bytes_per_element);
+  set_roofline_counters(s, get_stdpar_device());
+}
+
+template<class T>
+void fill(state& s) {
+  const std::size_t n = get_problem_size(s);
+  std::vector<T> data(n);
+  // Warm up, e.g. to migrate the data and trigger JIT compilation
+  std::fill(std::execution::par_unseq, data.begin(), data.end(), T{0});
+
+  while(s.keep_running())
+    std::fill(std::execution::par_unseq, data.begin(), data.end(), T{1});
+  set_throughput(s, n, sizeof(T));
+}
+
+template<class T>
+void copy(state& s) {
+  const std::size_t n = get_problem_size(s);
+  std::vector<T> src(n, T{1});
+  std::vector<T> dest(n);
+  std::copy(std::execution::par_unseq, src.begin(), src.end(), dest.begin());
+
+  while(s.keep_running())
+    std::copy(std::execution::par_unseq, src.begin(), src.end(), dest.begin());
+  set_throughput(s, n, 2 * sizeof(T));
+}
+
+template<class T>
+void reduce(state& s) {
+  const std::size_t n = get_problem_size(s);
+  std::vector<T> data(n, T{1});
+  T result = std::reduce(std::execution::par_unseq, data.begin(), data.end());
+
+  while(s.keep_running())
+    result += std::reduce(std::execution::par_unseq, data.begin(), data.end());
+  if(result == T{0})
+    s.counters["zero_results"] += 1;
+  set_throughput(s, n, sizeof(T));
+}
+
+template<class T>
+void transform_reduce(state& s) {
+  const std::size_t n = get_problem_size(s);
+  std::vector<T> a(n, T{1});
+  std::vector<T> b(n, T{2});
+  T result = std::transform_reduce(std::execution::par_unseq, a.begin(),
+                                   a.end(), b.begin(), T{0});
+
+  while(s.keep_running())
+    result += std::transform_reduce(std::execution::par_unseq, a.begin(),
+                                    a.end(), b.begin(), T{0});
+  if(result == T{0})
+    s.counters["zero_results"] += 1;
+  set_throughput(s, n, 2 * sizeof(T));
+}
+
+// Only the last element matches, such that the entire input must be
+// searched.
+template<class T>
+void find_if(state& s) {
+  const std::size_t n = get_problem_size(s);
+  std::vector<T> data(n, T{0});
+  data.back() = T{1};
+  auto predicate = [](T x) { return x == T{1}; };
+  std::find_if(std::execution::par, data.begin(), data.end(), predicate);
+
+  while(s.keep_running()) {
+    auto it = std::find_if(std::execution::par, data.begin(), data.end(),
+                           predicate);
+    if(it == data.end())
+      s.skip_with_error("find_if did not find the matching element");
+  }
+  set_throughput(s, n, sizeof(T));
+}
+
+template<class T>
+void sort(state& s) {
+  const std::size_t n = get_problem_size(s);
+  std::vector<T> input(n);
+  std::mt19937 gen{123};
+  std::uniform_int_distribution<int> dist{-1000000, 1000000};
+  for(auto& x : input)
+    x = static_cast<T>(dist(gen));
+
+  std::vector<T> data = input;
+  std::sort(std::execution::par_unseq, data.begin(), data.end());
+
+  while(s.keep_running()) {
+    s.pause_timing();
+    std::copy(std::execution::par_unseq, input.begin(), input.end(),
+              data.begin());
+    s.resume_timing();
+    std::sort(std::execution::par_unseq, data.begin(), data.end());
+  }
+  s.set_label(get_stdpar_device().get_info<sycl::info::device::name>());
+  s.set_items_processed(s.iterations() * n);
+}
+
+template<class T>
+void register_typed_benchmarks() {
+  const std::string suffix = std::string{"/"} + get_type_name<T>();
+
+  register_benchmark("stdpar/fill" + suffix, fill<T>, problem_sizes);
+  register_benchmark("stdpar/copy" + suffix, copy<T>, problem_sizes);
+  register_benchmark("stdpar/reduce" + suffix, reduce<T>, problem_sizes);
+  register_benchmark("stdpar/transform_reduce" + suffix, transform_reduce<T>,
+                     problem_sizes);
+  register_benchmark("stdpar/find_if" + suffix, find_if<T>, problem_sizes);
+  register_benchmark("stdpar/sort" + suffix, sort<T>, sort_problem_sizes);
+}
+
+}
+
+void register_stdpar_benchmarks() {
+  register_typed_benchmarks<int>();
+  register_typed_benchmarks<float>();
+  if(get_stdpar_device().has(sycl::aspect::fp64))
+    register_typed_benchmarks<double>();
+}
+
+}
@@ -0,0 +1,55 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic
+// RUN: %t | FileCheck %s
+// RUN: %acpp %s -o %t --acpp-targets=generic -O3
+// RUN: %t | FileCheck %s
+
+#include <iostream>
+#include <vector>
+#include <sycl/sycl.hpp>
+#include "hipSYCL/sycl/struct_of_arrays.hpp"
+
+struct vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+struct particle {
+  vec3 position;
+  double mass;
+  int id;
+};
+
+int main() {
+  sycl::queue q;
+  constexpr std::size_t n = 1024;
+
+  std::vector<particle> particles(n);
+  for(std::size_t i = 0; i < n; ++i)
+    particles[i] = particle{{1.0f * i, 2.0f * i, 3.0f * i}, 0.5 * i,
+                            static_cast<int>(i)};
+
+  sycl::AdaptiveCpp_struct_of_arrays<particle> soa{n, q};
+  soa.copy_from(particles.data());
+
+  auto view = soa.get_view();
+  q.parallel_for(sycl::range{n}, [=](sycl::id<1> idx) {
+    view.get(idx[0], &particle::position, &vec3::y) +=
+        static_cast<float>(view.get(idx[0], &particle::mass));
+    view.get(idx[0], &particle::id) *= 2;
+  }).wait();
+
+  std::vector<particle> result(n);
+  soa.copy_to(result.data());
+
+  int num_errors = 0;
+  for(std::size_t i = 0; i < n; ++i) {
+    const particle &p = result[i];
+    if(p.position.x != 1.0f * i || p.position.y != 2.0f * i + 0.5f * i ||
+       p.position.z != 3.0f * i || p.mass != 0.5 * i ||
+       p.id != static_cast<int>(2 * i))
+      ++num_errors;
+  }
+  // CHECK: 0
+  std::cout << num_errors << std::endl;
+}
@@ -21,7 +21,10 @@ __attribute__((noinline)) void test_wrapper() {
 }
 
 int main() {
-  test_wrapper();
+  // Calls through a function pointer prevent test_wrapper() from deferring
+  // synchronization to its callers
+  void (*volatile f)() = test_wrapper;
+  f();
   // CHECK: 0
   printf("%d\n", get_num_enqueued_ops());
 }
@@ -0,0 +1,43 @@
+// RUN: %acpp %s -o %t --acpp-targets=generic -O3 --acpp-stdpar --acpp-stdpar-unconditional-offload
+// RUN: %t | FileCheck %s
+
+#include <cstdio>
+#include "common.hpp"
+
+// Callers of stdpar functions are always inlined, so these helpers
+// get inlined into update() and update_internal().
+__attribute__((noinline)) void axpy() {
+  stdpar_call();
+}
+
+__attribute__((noinline)) void scale() {
+  stdpar_call();
+}
+
+// Only launches stdpar operations, so update() can leave synchronization
+// to its callers.
+__attribute__((noinline)) void update() {
+  axpy();
+  scale();
+}
+
+__attribute__((noinline)) static void update_internal() {
+  axpy();
+}
+
+__attribute__((noinline))
+void solve(int n = 10 /* to avoid the loop being optimized out*/) {
+  for(int i = 0; i < n; ++i) {
+    update();
+    update_internal();
+  }
+  // CHECK: 30
+  printf("%d\n", get_num_enqueued_ops());
+}
+
+int main() {
+  solve();
+  // printf() call to external function will trigger synchronization
+  // CHECK: 0
+  printf("%d\n", get_num_enqueued_ops());
+}
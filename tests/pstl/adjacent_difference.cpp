@@ -0,0 +1,66 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <numeric>
+#include <execution>
+#include <utility>
+#include <vector>
+#include <functional>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_adjacent_difference, enable_unified_shared_memory)
+
+template<class T, class Policy>
+void test_adjacent_difference(Policy&& pol, std::size_t size) {
+  std::vector<T> data(size);
+  for(std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<T>((i * 2654435761u) % 1000);
+
+  std::vector<T> result(size);
+  std::vector<T> reference(size);
+  auto ret = std::adjacent_difference(pol, data.begin(), data.end(),
+                                      result.begin());
+  std::adjacent_difference(data.begin(), data.end(), reference.begin());
+  BOOST_CHECK(ret == result.end());
+  BOOST_CHECK(result == reference);
+
+  ret = std::adjacent_difference(pol, data.begin(), data.end(), result.begin(),
+                                 std::plus<>{});
+  std::adjacent_difference(data.begin(), data.end(), reference.begin(),
+                           std::plus<>{});
+  BOOST_CHECK(ret == result.end());
+  BOOST_CHECK(result == reference);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  test_adjacent_difference<int>(std::execution::par_unseq, 0);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  test_adjacent_difference<int>(std::execution::par_unseq, 1);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_int) {
+  test_adjacent_difference<int>(std::execution::par_unseq, 1003);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_double_large) {
+  test_adjacent_difference<double>(std::execution::par_unseq, 1000 * 1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_int) {
+  test_adjacent_difference<int>(std::execution::par, 1003);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
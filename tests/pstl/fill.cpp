@@ -54,6 +54,11 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(par_unseq_medium_size, T, types::type) {
   test_fill<T>(std::execution::par_unseq, 1000);
 }
 
+// Not a multiple of the packet size of vectorized fill kernels
+BOOST_AUTO_TEST_CASE_TEMPLATE(par_unseq_large_odd_size, T, types::type) {
+  test_fill<T>(std::execution::par_unseq, 100003);
+}
+
 using types = boost::mpl::list<int, non_trivial_copy>;
 BOOST_AUTO_TEST_CASE_TEMPLATE(par_empty, T, types::type) {
   test_fill<T>(std::execution::par, 0);
@@ -0,0 +1,104 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_find_if, enable_unified_shared_memory)
+
+template <class Policy, class Generator, class Predicate>
+void test_find_if(Policy&& pol, std::size_t problem_size, Generator gen, Predicate p) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = gen(i);
+
+  auto ret = std::find_if(pol, data.begin(), data.end(), p);
+  auto ret_host = std::find_if(data.begin(), data.end(), p);
+  BOOST_CHECK(ret == ret_host);
+
+  auto ret_not = std::find_if_not(pol, data.begin(), data.end(), p);
+  auto ret_not_host = std::find_if_not(data.begin(), data.end(), p);
+  BOOST_CHECK(ret_not == ret_not_host);
+
+  if(problem_size > 0) {
+    auto ret_value = std::find(pol, data.begin(), data.end(), data.back());
+    auto ret_value_host = std::find(data.begin(), data.end(), data.back());
+    BOOST_CHECK(ret_value == ret_value_host);
+  }
+}
+
+template<class Policy>
+void empty_tests(Policy&& pol) {
+  test_find_if(pol, 0, [](int i){return i;}, [](int x){ return x > 0;});
+}
+
+template<class Policy>
+void single_element_tests(Policy&& pol) {
+  test_find_if(pol, 1, [](int i){return i;}, [](int x){ return x < 0;});
+  test_find_if(pol, 1, [](int i){return i;}, [](int x){ return x >= 0;});
+}
+
+template<class Policy>
+void medium_size_tests(Policy&& pol) {
+  test_find_if(pol, 1000, [](int i){return i;}, [](int x){ return x < 0;});
+  test_find_if(pol, 1000, [](int i){return i;}, [](int x){ return x > 0;});
+  test_find_if(pol, 1000, [](int i){return i;}, [](int x){ return x > 900;});
+  test_find_if(pol, 1000, [](int i){return i % 7;}, [](int x){ return x == 0;});
+}
+
+template<class Policy>
+void large_size_tests(Policy&& pol) {
+  // Multiple matches in different work groups
+  test_find_if(pol, 1000003, [](int i){return i % 100000;},
+               [](int x){ return x == 99999;});
+  test_find_if(pol, 1000003, [](int i){return i;},
+               [](int x){ return x == 1000002;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  empty_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  single_element_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_medium_size) {
+  medium_size_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_size) {
+  large_size_tests(std::execution::par_unseq);
+}
+
+BOOST_AUTO_TEST_CASE(par_empty) {
+  empty_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_single_element) {
+  single_element_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_medium_size) {
+  medium_size_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_CASE(par_large_size) {
+  large_size_tests(std::execution::par);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
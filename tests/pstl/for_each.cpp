@@ -13,6 +13,14 @@
 #include <execution>
 #include <vector>
 
+#if __has_include(<version>)
+#include <version>
+#endif
+
+#ifdef __cpp_lib_ranges
+#include <ranges>
+#endif
+
 #include <boost/test/unit_test.hpp>
 
 #include "pstl_test_suite.hpp"
@@ -57,4 +65,67 @@ BOOST_AUTO_TEST_CASE(par_incomplete_work_group) {
   }
 }
 
+#ifdef __cpp_lib_ranges
+BOOST_AUTO_TEST_CASE(par_unseq_iota) {
+  std::vector<int> data(1000);
+  auto indices = std::views::iota(0, static_cast<int>(data.size()));
+  int* ptr = data.data();
+  std::for_each(std::execution::par_unseq, indices.begin(), indices.end(),
+                [=](int i) { ptr[i] = 2 * i; });
+  for(int i = 0; i < data.size(); ++i) {
+    BOOST_CHECK(data[i] == 2*i);
+  }
+}
+#endif
+
+#ifdef __cpp_lib_ranges_cartesian_product
+BOOST_AUTO_TEST_CASE(par_unseq_cartesian_product_2d) {
+  const int nx = 37, ny = 45;
+  std::vector<int> data(nx * ny);
+  auto indices = std::views::cartesian_product(std::views::iota(0, nx),
+                                               std::views::iota(0, ny));
+  int* ptr = data.data();
+  std::for_each(std::execution::par_unseq, indices.begin(), indices.end(),
+                [=](auto idx) {
+                  auto [x, y] = idx;
+                  ptr[x * ny + y] = x + 1000 * y;
+                });
+  for(int x = 0; x < nx; ++x)
+    for(int y = 0; y < ny; ++y)
+      BOOST_CHECK(data[x * ny + y] == x + 1000 * y);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_cartesian_product_3d) {
+  const int nx = 5, ny = 7, nz = 33;
+  std::vector<int> data(nx * ny * nz);
+  auto indices = std::views::cartesian_product(std::views::iota(0, nx),
+                                               std::views::iota(1, ny + 1),
+                                               std::views::iota(0, nz));
+  int* ptr = data.data();
+  std::for_each(std::execution::par_unseq, indices.begin(), indices.end(),
+                [=](auto idx) {
+                  auto [x, y, z] = idx;
+                  ptr[(x * ny + y - 1) * nz + z] += 1;
+                });
+  for(int i = 0; i < data.size(); ++i)
+    BOOST_CHECK(data[i] == 1);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_cartesian_product_partial_rows) {
+  const int nx = 10, ny = 20;
+  std::vector<int> data(nx * ny);
+  auto indices = std::views::cartesian_product(std::views::iota(0, nx),
+                                               std::views::iota(0, ny));
+  int* ptr = data.data();
+  // Starts and ends in the middle of rows, so this is not a dense box
+  std::for_each(std::execution::par_unseq, indices.begin() + 5,
+                indices.end() - 7, [=](auto idx) {
+                  auto [x, y] = idx;
+                  ptr[x * ny + y] = 1;
+                });
+  for(int i = 0; i < data.size(); ++i)
+    BOOST_CHECK(data[i] == ((i >= 5 && i < nx * ny - 7) ? 1 : 0));
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
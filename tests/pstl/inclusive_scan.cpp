@@ -0,0 +1,90 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <numeric>
+#include <execution>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_inclusive_scan, enable_unified_shared_memory)
+
+template<class T, class Policy>
+void test_inclusive_scan(Policy&& pol, T init, std::size_t size) {
+  std::vector<T> data(size);
+  for(std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<T>(i % 37);
+
+  std::vector<T> ref(size), res(size);
+
+  std::inclusive_scan(data.begin(), data.end(), ref.begin());
+  auto ret = std::inclusive_scan(pol, data.begin(), data.end(), res.begin());
+  BOOST_CHECK(ret == res.begin() + size);
+  BOOST_CHECK(res == ref);
+
+  std::inclusive_scan(data.begin(), data.end(), ref.begin(), std::plus<>{},
+                      init);
+  std::inclusive_scan(pol, data.begin(), data.end(), res.begin(),
+                      std::plus<>{}, init);
+  BOOST_CHECK(res == ref);
+
+  auto transform = [](T x) { return 2 * x + 1; };
+  std::transform_inclusive_scan(data.begin(), data.end(), ref.begin(),
+                                std::plus<>{}, transform);
+  std::transform_inclusive_scan(pol, data.begin(), data.end(), res.begin(),
+                                std::plus<>{}, transform);
+  BOOST_CHECK(res == ref);
+
+  std::transform_inclusive_scan(data.begin(), data.end(), ref.begin(),
+                                std::plus<>{}, transform, init);
+  std::transform_inclusive_scan(pol, data.begin(), data.end(), res.begin(),
+                                std::plus<>{}, transform, init);
+  BOOST_CHECK(res == ref);
+
+  // in-place
+  std::vector<T> in_place = data;
+  std::inclusive_scan(pol, in_place.begin(), in_place.end(), in_place.begin());
+  std::inclusive_scan(data.begin(), data.end(), ref.begin());
+  BOOST_CHECK(in_place == ref);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  test_inclusive_scan(std::execution::par_unseq, 10, 0);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  test_inclusive_scan(std::execution::par_unseq, 10, 1);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_incomplete_single_work_group) {
+  test_inclusive_scan(std::execution::par_unseq, 10, 127);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_medium_size) {
+  test_inclusive_scan(std::execution::par_unseq, 0, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_size) {
+  test_inclusive_scan(std::execution::par_unseq, 0ll, 1000*1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_medium_size) {
+  test_inclusive_scan(std::execution::par, 3, 1000);
+}
+
+BOOST_AUTO_TEST_CASE(par_large_size) {
+  test_inclusive_scan(std::execution::par, 0ll, 1000*1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
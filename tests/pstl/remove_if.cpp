@@ -0,0 +1,64 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_remove_if, enable_unified_shared_memory)
+
+
+template<class Generator>
+void test_remove_if(std::size_t problem_size, Generator&& gen) {
+  std::vector<int> data_device(problem_size);
+  for(int i = 0; i < problem_size; ++i) {
+    data_device[i] = gen(i);
+  }
+  std::vector<int> data_host = data_device;
+
+  auto p = [](auto x) { return x % 2 == 0; };
+
+  auto ret = std::remove_if(std::execution::par_unseq, data_device.begin(),
+                            data_device.end(), p);
+  auto ret_host = std::remove_if(data_host.begin(), data_host.end(), p);
+
+  BOOST_CHECK(std::distance(data_device.begin(), ret) ==
+              std::distance(data_host.begin(), ret_host));
+  BOOST_CHECK(std::equal(data_device.begin(), ret, data_host.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  test_remove_if(0, [](int i){return i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  test_remove_if(1, [](int i){return i+3;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_none) {
+  test_remove_if(1000, [](int i){return 1;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_all) {
+  test_remove_if(1000, [](int i){return 2*i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large) {
+  test_remove_if(1024*1024+7, [](int i){return i * 7 + i / 3;});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -62,4 +62,20 @@ BOOST_AUTO_TEST_CASE(par_unseq_non_pow2_ascending) {
   test_sort(std::execution::par_unseq, 1000, [](int i){return i;});
 }
 
+BOOST_AUTO_TEST_CASE(par_unseq_large_random) {
+  test_sort(std::execution::par_unseq, 100000,
+            [](int i){return static_cast<int>((i * 2654435761u) >> 3) - (1 << 27);});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_random_greater) {
+  test_sort(std::execution::par_unseq, 100000,
+            [](int i){return static_cast<int>((i * 2654435761u) >> 3) - (1 << 27);},
+            std::greater<>{});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large_custom_comparator) {
+  test_sort(std::execution::par_unseq, 10000, [](int i){return (i * 7919) % 10000;},
+            [](int a, int b){ return a % 100 < b % 100 || (a % 100 == b % 100 && a < b); });
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,118 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <utility>
+#include <vector>
+#include <functional>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_stable_sort, enable_unified_shared_memory)
+
+struct key_value {
+  int key;
+  int value;
+
+  friend bool operator==(const key_value& a, const key_value& b) {
+    return a.key == b.key && a.value == b.value;
+  }
+};
+
+template <class Policy>
+void test_stable_sort(Policy &&pol, std::size_t problem_size, int num_keys) {
+  std::vector<key_value> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = key_value{static_cast<int>((i * 2654435761u) % num_keys), i};
+  std::vector<key_value> host_data = data;
+
+  auto comp = [](const key_value &a, const key_value &b) {
+    return a.key < b.key;
+  };
+  std::stable_sort(pol, data.begin(), data.end(), comp);
+  std::stable_sort(host_data.begin(), host_data.end(), comp);
+  BOOST_CHECK(host_data == data);
+}
+
+template <class Policy>
+void test_partial_sort(Policy &&pol, std::size_t problem_size,
+                       std::size_t middle) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = static_cast<int>((i * 2654435761u) % 1000);
+  std::vector<int> host_data = data;
+
+  std::partial_sort(pol, data.begin(), data.begin() + middle, data.end());
+  std::partial_sort(host_data.begin(), host_data.begin() + middle,
+                    host_data.end());
+  BOOST_CHECK(std::equal(data.begin(), data.begin() + middle,
+                         host_data.begin()));
+}
+
+template <class Policy>
+void test_nth_element(Policy &&pol, std::size_t problem_size,
+                      std::size_t nth) {
+  std::vector<int> data(problem_size);
+  for(int i = 0; i < problem_size; ++i)
+    data[i] = static_cast<int>((i * 2654435761u) % 1000);
+  std::vector<int> host_data = data;
+
+  std::nth_element(pol, data.begin(), data.begin() + nth, data.end(),
+                   std::greater<>{});
+  std::nth_element(host_data.begin(), host_data.begin() + nth,
+                   host_data.end(), std::greater<>{});
+  BOOST_CHECK(data[nth] == host_data[nth]);
+  for(std::size_t i = 0; i < nth; ++i)
+    BOOST_CHECK(data[i] >= data[nth]);
+  for(std::size_t i = nth + 1; i < problem_size; ++i)
+    BOOST_CHECK(data[i] <= data[nth]);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_stable_sort_empty) {
+  test_stable_sort(std::execution::par_unseq, 0, 1);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_stable_sort_single_element) {
+  test_stable_sort(std::execution::par_unseq, 1, 1);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_stable_sort_few_keys) {
+  test_stable_sort(std::execution::par_unseq, 1000, 7);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_stable_sort_large) {
+  test_stable_sort(std::execution::par_unseq, 100000, 97);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_partial_sort) {
+  test_partial_sort(std::execution::par_unseq, 1000, 10);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_nth_element) {
+  test_nth_element(std::execution::par_unseq, 1000, 500);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_nth_element_large) {
+  test_nth_element(std::execution::par_unseq, 100000, 77777);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_nth_element_first) {
+  test_nth_element(std::execution::par_unseq, 100000, 0);
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_partial_sort_large) {
+  test_partial_sort(std::execution::par_unseq, 100000, 1000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <algorithm>
+#include <execution>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "pstl_test_suite.hpp"
+
+BOOST_FIXTURE_TEST_SUITE(pstl_unique, enable_unified_shared_memory)
+
+
+template<class Generator>
+void test_unique(std::size_t problem_size, Generator&& gen) {
+  std::vector<int> data_device(problem_size);
+  for(int i = 0; i < problem_size; ++i) {
+    data_device[i] = gen(i);
+  }
+  std::vector<int> data_host = data_device;
+
+  auto ret = std::unique(std::execution::par_unseq, data_device.begin(),
+                         data_device.end());
+  auto ret_host = std::unique(data_host.begin(), data_host.end());
+
+  BOOST_CHECK(std::distance(data_device.begin(), ret) ==
+              std::distance(data_host.begin(), ret_host));
+  BOOST_CHECK(std::equal(data_device.begin(), ret, data_host.begin()));
+}
+
+template<class Generator>
+void test_unique_pred(std::size_t problem_size, Generator&& gen) {
+  std::vector<int> data_device(problem_size);
+  for(int i = 0; i < problem_size; ++i) {
+    data_device[i] = gen(i);
+  }
+  std::vector<int> data_host = data_device;
+
+  auto p = [](auto a, auto b) { return a / 10 == b / 10; };
+
+  auto ret = std::unique(std::execution::par_unseq, data_device.begin(),
+                         data_device.end(), p);
+  auto ret_host = std::unique(data_host.begin(), data_host.end(), p);
+
+  BOOST_CHECK(std::distance(data_device.begin(), ret) ==
+              std::distance(data_host.begin(), ret_host));
+  BOOST_CHECK(std::equal(data_device.begin(), ret, data_host.begin()));
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_empty) {
+  test_unique(0, [](int i){return i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_single_element) {
+  test_unique(1, [](int i){return i+3;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_all_equal) {
+  test_unique(1000, [](int i){return 1;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_all_different) {
+  test_unique(1000, [](int i){return i;});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_large) {
+  test_unique(1024*1024+7, [](int i){return i / 3 + (i % 7 == 0);});
+}
+
+BOOST_AUTO_TEST_CASE(par_unseq_pred) {
+  test_unique_pred(1024*1024+7, [](int i){return i / 4;});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,6 +14,7 @@
 #include <boost/test/tools/old/interface.hpp>
 #include <vector>
 #include <memory>
+#include <hipSYCL/runtime/allocation_tracker.hpp>
 #include <hipSYCL/runtime/data.hpp>
 #include <hipSYCL/runtime/util.hpp>
 
@@ -79,4 +80,210 @@ BOOST_AUTO_TEST_CASE(page_table) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(page_table_runs) {
+  // Large 1D page table; operations should only depend on the number of
+  // distinct runs of pages
+  const std::size_t num_pages = 10000000;
+  rt::range_store pt(rt::range<3>{1, 1, num_pages});
+  rt::range_store::rect full_range{rt::id<3>{0, 0, 0},
+                                   rt::range<3>{1, 1, num_pages}};
+
+  pt.add(full_range);
+  BOOST_CHECK(pt.entire_range_filled(full_range));
+
+  rt::range_store::rect hole{rt::id<3>{0, 0, 1000}, rt::range<3>{1, 1, 10}};
+  pt.remove(hole);
+  BOOST_CHECK(!pt.entire_range_filled(full_range));
+  BOOST_CHECK(pt.entire_range_empty(hole));
+
+  std::vector<rt::range_store::rect> intersections;
+  pt.intersections_with(full_range, intersections);
+  BOOST_CHECK(intersections.size() == 2);
+  pt.inverted_intersections_with(full_range, intersections);
+  BOOST_REQUIRE(intersections.size() == 1);
+  BOOST_CHECK(intersections[0] == hole);
+
+  // Adjacent runs are merged again
+  pt.add(hole);
+  pt.intersections_with(full_range, intersections);
+  BOOST_REQUIRE(intersections.size() == 1);
+  BOOST_CHECK(intersections[0] == full_range);
+}
+
+BOOST_AUTO_TEST_CASE(outdated_element_ranges) {
+  rt::device_id host{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                            rt::api_platform::omp},
+                     0};
+  rt::device_id dev{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                           rt::api_platform::omp},
+                    12345};
+
+  // A single page, so that all of the data would be considered outdated
+  // without tracking the written elements
+  rt::buffer_data_region region{rt::range<3>{1, 1, 1000}, sizeof(int),
+                                rt::range<3>{1, 1, 1000}};
+  region.add_nonempty_allocation(host, nullptr, nullptr);
+  region.add_empty_allocation(dev, nullptr, nullptr, false);
+
+  region.mark_range_current(dev, rt::id<3>{0, 0, 0},
+                            rt::range<3>{1, 1, 1000});
+  region.mark_range_current(dev, rt::id<3>{0, 0, 100},
+                            rt::range<3>{1, 1, 50});
+
+  // The first write covers all elements
+  std::vector<rt::range_store::rect> outdated;
+  region.get_outdated_regions(host, rt::id<3>{}, rt::range<3>{1, 1, 1000},
+                              outdated);
+  BOOST_REQUIRE(outdated.size() == 1);
+  BOOST_CHECK(outdated[0].second == (rt::range<3>{1, 1, 1000}));
+
+  region.mark_range_valid(host, rt::id<3>{}, rt::range<3>{1, 1, 1000});
+  region.mark_range_current(dev, rt::id<3>{0, 0, 100},
+                            rt::range<3>{1, 1, 50});
+  region.mark_range_current(dev, rt::id<3>{0, 0, 500},
+                            rt::range<3>{1, 1, 10});
+  region.get_outdated_regions(host, rt::id<3>{}, rt::range<3>{1, 1, 1000},
+                              outdated);
+  BOOST_REQUIRE(outdated.size() == 2);
+  BOOST_CHECK(outdated[0] == (rt::range_store::rect{rt::id<3>{0, 0, 100},
+                                                    rt::range<3>{1, 1, 50}}));
+  BOOST_CHECK(outdated[1] == (rt::range_store::rect{rt::id<3>{0, 0, 500},
+                                                    rt::range<3>{1, 1, 10}}));
+
+  region.mark_range_valid(host, rt::id<3>{}, rt::range<3>{1, 1, 1000});
+  region.get_outdated_regions(host, rt::id<3>{}, rt::range<3>{1, 1, 1000},
+                              outdated);
+  BOOST_CHECK(outdated.empty());
+}
+
+BOOST_AUTO_TEST_CASE(replicated_allocation_revalidation) {
+  rt::device_id host{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                            rt::api_platform::omp},
+                     0};
+  rt::device_id dev{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                           rt::api_platform::omp},
+                    12345};
+  const rt::range<3> size{1, 64, 64};
+  rt::buffer_data_region region{size, sizeof(int), rt::range<3>{1, 8, 8}};
+  region.add_nonempty_allocation(host, nullptr, nullptr);
+  region.add_empty_allocation(dev, nullptr, nullptr, false);
+
+  std::vector<rt::range_store::rect> outdated;
+  region.get_outdated_regions(dev, rt::id<3>{}, size, outdated);
+  BOOST_CHECK(!outdated.empty());
+
+  // Replicate, and access again
+  region.mark_range_valid(dev, rt::id<3>{}, size);
+  region.mark_range_valid(dev, rt::id<3>{}, size);
+  region.get_outdated_regions(dev, rt::id<3>{}, size, outdated);
+  BOOST_CHECK(outdated.empty());
+
+  // A small write on the host only invalidates the written elements
+  region.mark_range_current(host, rt::id<3>{0, 10, 10},
+                            rt::range<3>{1, 1, 1});
+  region.get_outdated_regions(dev, rt::id<3>{}, size, outdated);
+  BOOST_REQUIRE(outdated.size() == 1);
+  BOOST_CHECK(outdated[0] == (rt::range_store::rect{rt::id<3>{0, 10, 10},
+                                                    rt::range<3>{1, 1, 1}}));
+  region.get_outdated_regions(host, rt::id<3>{}, size, outdated);
+  BOOST_CHECK(outdated.empty());
+
+  region.mark_range_valid(dev, rt::id<3>{0, 10, 10}, rt::range<3>{1, 1, 1});
+  region.get_outdated_regions(dev, rt::id<3>{}, size, outdated);
+  BOOST_CHECK(outdated.empty());
+}
+
+BOOST_AUTO_TEST_CASE(allocation_eviction_order) {
+  rt::device_id dev{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                           rt::api_platform::omp},
+                    12345};
+  auto make_region = []() {
+    return std::make_shared<rt::buffer_data_region>(
+        rt::range<3>{1, 1, 16}, sizeof(int), rt::range<3>{1, 1, 16});
+  };
+  auto r1 = make_region();
+  auto r2 = make_region();
+  auto r3 = make_region();
+
+  rt::buffer_allocation_tracker tracker;
+  tracker.register_use(r1, dev);
+  tracker.register_use(r2, dev);
+  tracker.register_use(r3, dev);
+  tracker.register_use(r1, dev);
+
+  auto candidates = tracker.get_eviction_candidates(dev, r3.get());
+  BOOST_REQUIRE(candidates.size() == 2);
+  BOOST_CHECK(candidates[0] == r2);
+  BOOST_CHECK(candidates[1] == r1);
+
+  tracker.unregister(r2.get(), dev);
+  candidates.clear();
+  r1.reset();
+  candidates = tracker.get_eviction_candidates(dev, nullptr);
+  BOOST_REQUIRE(candidates.size() == 1);
+  BOOST_CHECK(candidates[0] == r3);
+}
+
+BOOST_AUTO_TEST_CASE(buffer_allocation_reuse) {
+  class counting_allocator : public rt::backend_allocator {
+  public:
+    void *allocate(size_t, size_t size_bytes) override {
+      ++num_allocations;
+      return ::operator new(size_bytes);
+    }
+    void *allocate_optimized_host(size_t, size_t bytes) override {
+      return nullptr;
+    }
+    void free(void *mem) override {
+      ++num_frees;
+      ::operator delete(mem);
+    }
+    void *allocate_usm(size_t) override { return nullptr; }
+    bool is_usm_accessible_from(rt::backend_descriptor) const override {
+      return false;
+    }
+    rt::result query_pointer(const void *, rt::pointer_info &) const override {
+      return rt::make_success();
+    }
+    rt::result mem_advise(const void *, std::size_t, int) const override {
+      return rt::make_success();
+    }
+
+    int num_allocations = 0;
+    int num_frees = 0;
+  };
+
+  rt::device_id dev{rt::backend_descriptor{rt::hardware_platform::cpu,
+                                           rt::api_platform::omp},
+                    12345};
+  counting_allocator backend_alloc;
+  {
+    rt::buffer_allocation_cache cache{1024};
+    rt::backend_allocator *alloc = cache.get_allocator(dev, &backend_alloc);
+    BOOST_CHECK(alloc == cache.get_allocator(dev, &backend_alloc));
+
+    void *a = alloc->allocate(0, 512);
+    alloc->free(a);
+    BOOST_CHECK(backend_alloc.num_frees == 0);
+
+    // Served from the cache, since at most half of the allocation is unused
+    void *b = alloc->allocate(0, 300);
+    BOOST_CHECK(b == a);
+    BOOST_CHECK(backend_alloc.num_allocations == 1);
+
+    // Too small to reuse the idle allocation
+    void *c = alloc->allocate(0, 100);
+    BOOST_CHECK(backend_alloc.num_allocations == 2);
+
+    void *d = alloc->allocate(0, 1000);
+    alloc->free(b);
+    alloc->free(c);
+    // Exceeds the maximum cached size
+    alloc->free(d);
+    BOOST_CHECK(backend_alloc.num_frees == 1);
+  }
+  // Idle allocations are freed with the cache
+  BOOST_CHECK(backend_alloc.num_frees == 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,202 @@
+/*
+ * This file is part of AdaptiveCpp, an implementation of SYCL and C++ standard
+ * parallelism for CPUs and GPUs.
+ *
+ * Copyright The AdaptiveCpp Contributors
+ *
+ * AdaptiveCpp is released under the BSD 2-Clause "Simplified" License.
+ * See file LICENSE in the project root for full license details.
+ */
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "runtime_test_suite.hpp"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+
+#include <hipSYCL/runtime/backend.hpp>
+#include <hipSYCL/runtime/dag_node.hpp>
+#include <hipSYCL/runtime/executor.hpp>
+#include <hipSYCL/runtime/hardware.hpp>
+#include <hipSYCL/runtime/hints.hpp>
+#include <hipSYCL/runtime/operations.hpp>
+#include <hipSYCL/runtime/remote/remote_protocol.hpp>
+#include <hipSYCL/runtime/runtime.hpp>
+
+using namespace hipsycl;
+
+namespace {
+
+const rt::device_id host_device{
+    rt::backend_descriptor{rt::hardware_platform::cpu, rt::api_platform::omp},
+    0};
+
+rt::dag_node_ptr submit(rt::runtime *runtime, rt::backend_executor *executor,
+                        rt::device_id dev, std::unique_ptr<rt::operation> op,
+                        const rt::dag_node_ptr &previous) {
+  rt::execution_hints hints;
+  hints.set_hint(rt::hints::bind_to_device{dev});
+  auto node =
+      rt::make_dag_node(hints, rt::node_list_t{}, std::move(op), runtime);
+  node->assign_to_device(dev);
+
+  rt::node_list_t reqs;
+  if(previous)
+    reqs.push_back(previous);
+  executor->submit_directly(node, node->get_operation(), reqs);
+  return node;
+}
+
+rt::memory_location make_location(rt::device_id dev, void *ptr,
+                                  rt::id<3> offset, rt::range<3> shape) {
+  return rt::memory_location{dev, ptr, offset, shape, sizeof(int)};
+}
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(remote, reset_device_fixture)
+BOOST_AUTO_TEST_CASE(address_parsing) {
+  std::string host;
+  uint16_t port = 0;
+
+  BOOST_CHECK(rt::parse_remote_address("node01", host, port));
+  BOOST_CHECK(host == "node01");
+  BOOST_CHECK(port == rt::remote_default_port);
+
+  BOOST_CHECK(rt::parse_remote_address("node01:1234", host, port));
+  BOOST_CHECK(host == "node01");
+  BOOST_CHECK(port == 1234);
+
+  BOOST_CHECK(rt::parse_remote_address("[::1]:1234", host, port));
+  BOOST_CHECK(host == "::1");
+  BOOST_CHECK(port == 1234);
+
+  BOOST_CHECK(rt::parse_remote_address("::1", host, port));
+  BOOST_CHECK(host == "::1");
+  BOOST_CHECK(port == rt::remote_default_port);
+
+  BOOST_CHECK(!rt::parse_remote_address("", host, port));
+  BOOST_CHECK(!rt::parse_remote_address(":1234", host, port));
+  BOOST_CHECK(!rt::parse_remote_address("node01:port", host, port));
+  BOOST_CHECK(!rt::parse_remote_address("[::1", host, port));
+}
+
+BOOST_AUTO_TEST_CASE(message_transfer) {
+  int fds[2];
+  BOOST_REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  rt::remote_socket sender{fds[0]};
+  rt::remote_socket receiver{fds[1]};
+
+  rt::remote_memcpy_command cmd;
+  cmd.dest.device = 2;
+  cmd.dest.address = 0x1000;
+  cmd.dest.offset = {0, 1, 2};
+  cmd.dest.shape = {1, 4, 8};
+  cmd.dest.element_size = sizeof(int);
+  cmd.range = {1, 2, 3};
+  std::vector<int> data{1, 2, 3, 4, 5, 6};
+
+  BOOST_REQUIRE(sender
+                    .send(rt::remote_message_type::memcpy_to_device, cmd,
+                          data.data(), data.size() * sizeof(int))
+                    .is_success());
+
+  rt::remote_message msg;
+  BOOST_REQUIRE(receiver.receive(msg).is_success());
+  BOOST_CHECK(msg.type == rt::remote_message_type::memcpy_to_device);
+
+  rt::remote_memcpy_command received;
+  BOOST_REQUIRE(msg.unpack_body(received));
+  BOOST_CHECK(received.dest.device == cmd.dest.device);
+  BOOST_CHECK(received.dest.address == cmd.dest.address);
+  BOOST_CHECK(received.dest.offset == cmd.dest.offset);
+  BOOST_CHECK(received.dest.shape == cmd.dest.shape);
+  BOOST_CHECK(received.dest.element_size == cmd.dest.element_size);
+  BOOST_CHECK(received.range == cmd.range);
+  BOOST_REQUIRE(msg.data.size() == data.size() * sizeof(int));
+  BOOST_CHECK(std::memcmp(msg.data.data(), data.data(), msg.data.size()) == 0);
+
+  // A closed connection must be reported instead of blocking
+  sender.shutdown();
+  BOOST_CHECK(!receiver.receive(msg).is_success());
+}
+
+// Requires acpp-remote-daemon instances listed in ACPP_RT_REMOTE_DEVICES
+BOOST_AUTO_TEST_CASE(daemon_memory_operations) {
+  rt::runtime_keep_alive_token keep_alive;
+  rt::runtime *runtime = keep_alive.get();
+
+  rt::backend *b = runtime->backends().get(rt::backend_id::remote);
+  if(!b || b->get_hardware_manager()->get_num_devices() == 0) {
+    BOOST_TEST_MESSAGE("No remote devices available, skipping test");
+    return;
+  }
+
+  rt::device_id dev = b->get_hardware_manager()->get_device_id(0);
+  rt::backend_allocator *allocator = b->get_allocator(dev);
+  rt::backend_executor *executor = b->get_executor(dev);
+
+  constexpr std::size_t num_elements = 4 * 8;
+  std::vector<int> input(num_elements);
+  for(std::size_t i = 0; i < num_elements; ++i)
+    input[i] = static_cast<int>(i);
+
+  int *device_ptr = static_cast<int *>(
+      allocator->allocate(0, num_elements * sizeof(int)));
+  BOOST_REQUIRE(device_ptr);
+
+  rt::pointer_info info;
+  BOOST_CHECK(allocator->query_pointer(device_ptr + 3, info).is_success());
+  BOOST_CHECK(info.dev == dev);
+
+  rt::range<3> shape{1, 4, 8};
+  auto upload = submit(
+      runtime, executor, dev,
+      std::make_unique<rt::memcpy_operation>(
+          make_location(host_device, input.data(), rt::id<3>{}, shape),
+          make_location(dev, device_ptr, rt::id<3>{}, shape), shape),
+      nullptr);
+  auto fill = submit(
+      runtime, executor, dev,
+      std::make_unique<rt::memset_operation>(device_ptr, 0, 2 * sizeof(int)),
+      upload);
+
+  // Read back a 2x3 block at offset (1, 2) of the 4x8 device allocation
+  std::vector<int> block(6, -1);
+  rt::range<3> block_range{1, 2, 3};
+  auto download = submit(
+      runtime, executor, dev,
+      std::make_unique<rt::memcpy_operation>(
+          make_location(dev, device_ptr, rt::id<3>{0, 1, 2}, shape),
+          make_location(host_device, block.data(), rt::id<3>{}, block_range),
+          block_range),
+      fill);
+
+  std::vector<int> output(num_elements, -1);
+  rt::range<3> full_range{1, 1, num_elements};
+  auto download_all = submit(
+      runtime, executor, dev,
+      std::make_unique<rt::memcpy_operation>(
+          make_location(dev, device_ptr, rt::id<3>{}, full_range),
+          make_location(host_device, output.data(), rt::id<3>{}, full_range),
+          full_range),
+      download);
+  download_all->wait();
+
+  BOOST_CHECK(!download->is_cancelled());
+  BOOST_CHECK(!download_all->is_cancelled());
+  for(std::size_t i = 0; i < num_elements; ++i)
+    BOOST_CHECK(output[i] == (i < 2 ? 0 : input[i]));
+  for(std::size_t y = 0; y < 2; ++y)
+    for(std::size_t x = 0; x < 3; ++x)
+      BOOST_CHECK(block[y * 3 + x] == input[(1 + y) * 8 + 2 + x]);
+
+  allocator->free(device_ptr);
+  BOOST_CHECK(!allocator->query_pointer(device_ptr, info).is_success());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
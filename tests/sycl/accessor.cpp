@@ -870,4 +870,30 @@ BOOST_AUTO_TEST_CASE(zero_dim_accessor) {
   BOOST_CHECK(val == 123);
 }
 
+BOOST_AUTO_TEST_CASE(identical_accessors) {
+  namespace s = cl::sycl;
+
+  constexpr std::size_t size = 128;
+  std::vector<int> data(size, 1);
+  {
+    s::buffer<int> buf{data.data(), s::range<1>{size}};
+
+    s::queue q;
+    q.submit([&](s::handler &h) {
+      // Both accessors share a single requirement, but each must still
+      // be initialized with the device pointer.
+      s::accessor<int> acc1{buf, h, s::read_write};
+      s::accessor<int> acc2{buf, h, s::read_write};
+
+      h.parallel_for(s::range<1>{size}, [=](s::id<1> idx) {
+        acc1[idx] += 1;
+        acc2[idx] *= 2;
+      });
+    });
+  }
+
+  for(std::size_t i = 0; i < size; ++i)
+    BOOST_CHECK(data[i] == 4);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -482,4 +482,34 @@ BOOST_AUTO_TEST_CASE(buffer_uninitialized) {
   }
 }
 
+#ifdef ACPP_EXT_SUBMISSION_BATCH
+BOOST_AUTO_TEST_CASE(buffer_overwritten_write_access) {
+  namespace s = cl::sycl;
+
+  const std::size_t size = 1024;
+  std::vector<int> host_data(size, 1);
+  s::queue q;
+  {
+    s::buffer<int> buf{host_data.data(), s::range{size}};
+
+    // The write access only writes half of the buffer, but is entirely
+    // overwritten by the following discard access before anything reads it.
+    q.AdaptiveCpp_begin_submission_batch();
+    q.submit([&](s::handler &cgh) {
+      s::accessor<int, 1, s::access::mode::write> acc{buf, cgh};
+      cgh.parallel_for(s::range{size / 2}, [=](s::id<1> idx) { acc[idx] = 2; });
+    });
+    q.submit([&](s::handler &cgh) {
+      s::accessor acc{buf, cgh, s::write_only, s::no_init};
+      cgh.parallel_for(s::range{size}, [=](s::id<1> idx) {
+        acc[idx] = static_cast<int>(idx[0]);
+      });
+    });
+    q.AdaptiveCpp_end_submission_batch();
+  }
+  for(std::size_t i = 0; i < size; ++i)
+    BOOST_CHECK(host_data[i] == static_cast<int>(i));
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,10 +21,16 @@
 #include "hipSYCL/sycl/property.hpp"
 #include "hipSYCL/sycl/handler.hpp"
 #include "hipSYCL/sycl/queue.hpp"
+#include "hipSYCL/sycl/device_heap.hpp"
+#include "hipSYCL/sycl/device_launch_queue.hpp"
 
 #include "sycl_test_suite.hpp"
 #include <boost/test/tools/old/interface.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 BOOST_FIXTURE_TEST_SUITE(extension_tests, reset_device_fixture)
 
 #ifdef ACPP_EXT_AUTO_PLACEHOLDER_REQUIRE
@@ -415,6 +421,39 @@ BOOST_AUTO_TEST_CASE(scoped_parallelism_odd_group_size) {
   }
 }
 
+#endif
+#if defined(ACPP_EXT_SCOPED_PARALLELISM_V2) && !defined(ACPP_LIBKERNEL_CUDA_NVCXX)
+BOOST_AUTO_TEST_CASE(scoped_parallelism_sub_group_private_memory) {
+  using namespace cl;
+  sycl::queue q;
+  constexpr std::size_t num_groups = 4;
+  constexpr std::size_t group_size = 128;
+  sycl::buffer<int> buff{sycl::range{num_groups * group_size}};
+
+  q.submit([&](sycl::handler& cgh){
+    sycl::accessor acc {buff, cgh, sycl::no_init};
+    cgh.parallel<class ScopedSubGroupPrivateMem>(sycl::range{num_groups},
+      sycl::range{group_size}, [=](auto grp){
+      sycl::distribute_groups(grp, [&](auto subgroup){
+        sycl::memory_environment(subgroup, sycl::require_private_mem<int>(),
+          [&](auto& private_mem){
+          sycl::distribute_items(subgroup, [&](sycl::s_item<1> idx){
+            private_mem(idx) = static_cast<int>(idx.get_global_linear_id());
+          });
+          sycl::group_barrier(subgroup);
+          sycl::distribute_items(subgroup, [&](sycl::s_item<1> idx){
+            acc[idx.get_global_linear_id()] = 2 * private_mem(idx);
+          });
+        });
+      });
+    });
+  });
+  {
+    sycl::host_accessor hacc{buff};
+    for (int i = 0; i < num_groups * group_size; ++i)
+      BOOST_CHECK(hacc[i] == 2 * i);
+  }
+}
 #endif
 #ifdef ACPP_EXT_ENQUEUE_CUSTOM_OPERATION
 
@@ -495,6 +534,39 @@ BOOST_AUTO_TEST_CASE(custom_enqueue) {
   else if(b == sycl::backend::omp)
     test_interop<sycl::backend::omp>(q);
 }
+
+BOOST_AUTO_TEST_CASE(concurrent_host_custom_operations) {
+  sycl::device host_device{sycl::detail::get_host_device()};
+  sycl::queue q1{host_device};
+  sycl::queue q2{host_device};
+
+  // The first operation can only finish once the second one has run,
+  // which requires custom operations to be executed concurrently.
+  std::atomic<bool> second_has_run{false};
+  std::atomic<bool> first_has_observed{false};
+
+  q1.submit([&](sycl::handler &cgh) {
+    cgh.AdaptiveCpp_enqueue_custom_operation([&](sycl::interop_handle &) {
+      auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start <
+             std::chrono::seconds{10}) {
+        if (second_has_run.load()) {
+          first_has_observed = true;
+          return;
+        }
+        std::this_thread::yield();
+      }
+    });
+  });
+  q2.submit([&](sycl::handler &cgh) {
+    cgh.AdaptiveCpp_enqueue_custom_operation(
+        [&](sycl::interop_handle &) { second_has_run = true; });
+  });
+
+  q1.wait();
+  q2.wait();
+  BOOST_CHECK(first_has_observed.load());
+}
 #endif
 #ifdef ACPP_EXT_CG_PROPERTY_RETARGET
 BOOST_AUTO_TEST_CASE(cg_property_retarget) {
@@ -672,6 +744,36 @@ BOOST_AUTO_TEST_CASE(cg_property_prefer_execution_lane) {
 
 #endif
 
+#ifdef ACPP_EXT_CG_PROPERTY_DYNAMIC_SCHEDULE
+
+BOOST_AUTO_TEST_CASE(cg_property_dynamic_schedule) {
+
+  cl::sycl::queue q;
+
+  constexpr std::size_t size = 1024;
+  int *data = cl::sycl::malloc_shared<int>(size, q);
+
+  for(std::size_t chunk_size : {0, 1, 7}) {
+    q.submit(
+        {cl::sycl::property::command_group::AdaptiveCpp_dynamic_schedule{
+            chunk_size}},
+        [&](cl::sycl::handler &cgh) {
+          cgh.parallel_for<class dynamic_schedule_test>(
+              cl::sycl::range<2>{size / 32, 32}, [=](cl::sycl::id<2> idx) {
+                data[idx[0] * 32 + idx[1]] = static_cast<int>(idx[0] + idx[1]);
+              });
+        });
+    q.wait();
+
+    for(std::size_t i = 0; i < size; ++i)
+      BOOST_REQUIRE_EQUAL(data[i], static_cast<int>(i / 32 + i % 32));
+  }
+
+  cl::sycl::free(data, q);
+}
+
+#endif
+
 #ifdef ACPP_EXT_PREFETCH_HOST
 BOOST_AUTO_TEST_CASE(prefetch_host) {
   using namespace cl;
@@ -889,6 +991,34 @@ BOOST_AUTO_TEST_CASE(buffer_page_size) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(buffer_adaptive_page_size) {
+  using namespace cl;
+
+  sycl::queue q;
+
+  const std::size_t size = 1024 * 1024;
+  const std::size_t chunk_size = 256 * 1024;
+  sycl::buffer<int> buff{sycl::range{size},
+                         sycl::property::buffer::AdaptiveCpp_adaptive_page_size{
+                             chunk_size * sizeof(int)}};
+
+  for(std::size_t offset = 0; offset < size; offset += chunk_size) {
+    auto event = q.submit([&](sycl::handler &cgh) {
+      sycl::accessor<int> acc{buff, cgh, sycl::range{chunk_size},
+                              sycl::id{offset}};
+      cgh.parallel_for(sycl::range{chunk_size}, [=](sycl::id<1> idx){
+        acc[idx] = static_cast<int>(idx[0] + offset);
+      });
+    });
+    // Accesses to different pages should not depend on each other
+    BOOST_CHECK(event.get_wait_list().size() == 1);
+  }
+
+  sycl::host_accessor<int> hacc{buff};
+  for(std::size_t i = 0; i < size; ++i)
+    BOOST_REQUIRE(hacc[i] == static_cast<int>(i));
+}
+
 #endif
 #ifdef ACPP_EXT_EXPLICIT_BUFFER_POLICIES
 BOOST_AUTO_TEST_CASE(explicit_buffer_policies) {
@@ -1086,6 +1216,38 @@ BOOST_AUTO_TEST_CASE(update_device) {
     BOOST_CHECK(target_buff[i] == static_cast<int>(i));
 }
 #endif
+#if defined(ACPP_EXT_BUFFER_PREFETCH) && defined(ACPP_EXT_BUFFER_USM_INTEROP)
+BOOST_AUTO_TEST_CASE(buffer_prefetch) {
+  sycl::queue q;
+  sycl::range size{1024};
+  sycl::buffer<int> buff{size};
+  {
+    sycl::host_accessor hacc{buff};
+
+    for(std::size_t i = 0; i < size[0]; ++i){
+      hacc[i] = static_cast<int>(i);
+    }
+  }
+
+  q.AdaptiveCpp_prefetch(buff).wait();
+
+  // Read through USM to observe the data of the device allocation
+  // instead of triggering another update
+  int* dev_ptr = buff.get_pointer(q.get_device());
+  BOOST_CHECK(dev_ptr != nullptr);
+
+  std::vector<int> target_buff(size[0]);
+  q.memcpy(target_buff.data(), dev_ptr, size[0] * sizeof(int)).wait();
+
+  for(std::size_t i = 0; i < size[0]; ++i)
+    BOOST_CHECK(target_buff[i] == static_cast<int>(i));
+
+  // Prefetching must not invalidate the host data
+  sycl::host_accessor hacc{buff, sycl::read_only};
+  for(std::size_t i = 0; i < size[0]; ++i)
+    BOOST_CHECK(hacc[i] == static_cast<int>(i));
+}
+#endif
 #ifdef ACPP_EXT_QUEUE_WAIT_LIST
 
 BOOST_AUTO_TEST_CASE(queue_wait_list) {
@@ -1171,6 +1333,44 @@ BOOST_AUTO_TEST_CASE(coarse_grained_events) {
 }
 #endif
 
+#ifdef ACPP_EXT_QUEUE_PRIORITY
+BOOST_AUTO_TEST_CASE(queue_priority) {
+  using namespace cl;
+  sycl::queue default_q;
+  sycl::queue high_priority_q{sycl::property::queue::AdaptiveCpp_priority{-1}};
+  sycl::queue high_priority_inorder_q{
+      sycl::property_list{sycl::property::queue::AdaptiveCpp_priority{-1},
+                          sycl::property::queue::in_order{}}};
+
+  int *data = sycl::malloc_shared<int>(3, default_q);
+  default_q.single_task([=]() { data[0] = 1; });
+  high_priority_q.single_task([=]() { data[1] = 2; });
+  high_priority_inorder_q.single_task([=]() { data[2] = 3; });
+  default_q.wait();
+  high_priority_q.wait();
+  high_priority_inorder_q.wait();
+
+  BOOST_CHECK(data[0] == 1);
+  BOOST_CHECK(data[1] == 2);
+  BOOST_CHECK(data[2] == 3);
+  sycl::free(data, default_q);
+}
+#endif
+#ifdef ACPP_EXT_QUEUE_COMPUTE_UNIT_PARTITION
+BOOST_AUTO_TEST_CASE(queue_compute_unit_partition) {
+  using namespace cl;
+  sycl::queue q{sycl::property_list{
+      sycl::property::queue::AdaptiveCpp_compute_unit_partition{1},
+      sycl::property::queue::in_order{}}};
+
+  int *data = sycl::malloc_shared<int>(1, q);
+  q.single_task([=]() { data[0] = 42; });
+  q.wait();
+  BOOST_CHECK(data[0] == 42);
+  sycl::free(data, q);
+}
+#endif
+
 #ifdef ACPP_EXT_SPECIALIZED
 BOOST_AUTO_TEST_CASE(sycl_specialized) {
   using namespace cl;
@@ -1223,4 +1423,264 @@ BOOST_AUTO_TEST_CASE(sycl_specialized) {
 }
 #endif
 
+#ifdef ACPP_EXT_JIT_FAST_MATH
+BOOST_AUTO_TEST_CASE(jit_fast_math) {
+  sycl::queue q;
+  constexpr std::size_t size = 1024;
+  float* data = sycl::malloc_shared<float>(size, q);
+
+  q.parallel_for(sycl::range<1>{size}, sycl::jit::fast_math([=](sycl::id<1> idx){
+    data[idx] = static_cast<float>(idx[0]) * 0.5f;
+  })).wait();
+
+  for(std::size_t i = 0; i < size; ++i)
+    BOOST_CHECK(data[i] == static_cast<float>(i) * 0.5f);
+
+  q.single_task(sycl::jit::fast_math([=](){
+    data[0] = 1.0f;
+  })).wait();
+  BOOST_CHECK(data[0] == 1.0f);
+
+  sycl::free(data, q);
+}
+#endif
+
+#ifdef ACPP_EXT_JOINT_MATRIX
+BOOST_AUTO_TEST_CASE(joint_matrix_mad) {
+  namespace mat = sycl::matrix;
+  sycl::queue q;
+  constexpr std::size_t tile = 16;
+  constexpr std::size_t k_size = 2 * tile;
+  constexpr std::size_t group_size = 64;
+
+  sycl::half* a = sycl::malloc_shared<sycl::half>(tile * k_size, q);
+  sycl::half* b = sycl::malloc_shared<sycl::half>(k_size * tile, q);
+  float* c = sycl::malloc_shared<float>(tile * tile, q);
+  int* is_supported = sycl::malloc_shared<int>(1, q);
+
+  for(std::size_t i = 0; i < tile * k_size; ++i)
+    a[i] = static_cast<float>(i % 7) - 3.0f;
+  // b is stored column-major
+  for(std::size_t i = 0; i < k_size * tile; ++i)
+    b[i] = static_cast<float>(i % 5) - 2.0f;
+  for(std::size_t i = 0; i < tile * tile; ++i)
+    c[i] = static_cast<float>(i);
+
+  q.parallel_for(sycl::nd_range<1>{group_size, group_size},
+                 [=](sycl::nd_item<1> idx) {
+    auto sg = idx.get_sub_group();
+    // Only the first sub-group computes the result
+    if(sg.get_group_linear_id() != 0)
+      return;
+    if(!mat::joint_matrix_is_supported(sg)) {
+      is_supported[0] = 0;
+      return;
+    }
+    is_supported[0] = 1;
+
+    mat::joint_matrix<sycl::sub_group, sycl::half, mat::use::a, tile, tile,
+                      mat::layout::row_major> ma;
+    mat::joint_matrix<sycl::sub_group, sycl::half, mat::use::b, tile, tile,
+                      mat::layout::col_major> mb;
+    mat::joint_matrix<sycl::sub_group, float, mat::use::accumulator, tile,
+                      tile> mc;
+    mat::joint_matrix_load(sg, mc, c, tile, mat::layout::row_major);
+    for(std::size_t k = 0; k < k_size; k += tile) {
+      mat::joint_matrix_load(sg, ma, a + k, k_size);
+      mat::joint_matrix_load(sg, mb, b + k, k_size);
+      mat::joint_matrix_mad(sg, mc, ma, mb, mc);
+    }
+    mat::joint_matrix_store(sg, mc, c, tile, mat::layout::col_major);
+  }).wait();
+
+  if(is_supported[0]) {
+    for(std::size_t i = 0; i < tile; ++i) {
+      for(std::size_t j = 0; j < tile; ++j) {
+        float expected = static_cast<float>(i * tile + j);
+        for(std::size_t k = 0; k < k_size; ++k)
+          expected += static_cast<float>(a[i * k_size + k]) *
+                      static_cast<float>(b[j * k_size + k]);
+        BOOST_CHECK(c[j * tile + i] == expected);
+      }
+    }
+  }
+
+  sycl::free(a, q);
+  sycl::free(b, q);
+  sycl::free(c, q);
+  sycl::free(is_supported, q);
+}
+#endif
+
+#ifdef ACPP_EXT_EVENT_COMPLETION_CALLBACK
+BOOST_AUTO_TEST_CASE(event_completion_callback) {
+  sycl::queue q;
+  int *data = sycl::malloc_shared<int>(1, q);
+
+  std::atomic<bool> is_invoked{false};
+  std::atomic<int> observed_value{0};
+  auto evt = q.single_task([=](){ *data = 42; });
+  evt.AdaptiveCpp_on_completion([&](){
+    observed_value = *data;
+    is_invoked = true;
+  });
+  while(!is_invoked)
+    std::this_thread::yield();
+  BOOST_CHECK(observed_value == 42);
+
+  // Callbacks for completed events are invoked immediately
+  bool is_invoked_immediately = false;
+  evt.AdaptiveCpp_on_completion([&](){ is_invoked_immediately = true; });
+  BOOST_CHECK(is_invoked_immediately);
+
+  sycl::free(data, q);
+}
+#endif
+#ifdef ACPP_EXT_COROUTINES
+struct detached_coroutine {
+  struct promise_type {
+    detached_coroutine get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+detached_coroutine run_coroutine_pipeline(sycl::queue &q,
+                                          sycl::coroutine::run_loop &loop,
+                                          int *data) {
+  co_await sycl::coroutine::async_wait(q.single_task([=](){ *data = 1; }),
+                                       loop);
+  *data += 1;
+  co_await sycl::coroutine::async_wait(q.single_task([=](){ *data *= 10; }),
+                                       loop);
+}
+
+BOOST_AUTO_TEST_CASE(coroutine_run_loop) {
+  sycl::queue q{sycl::property::queue::in_order{}};
+  constexpr int num_pipelines = 16;
+  int *data = sycl::malloc_shared<int>(num_pipelines, q);
+
+  sycl::coroutine::run_loop loop;
+  for(int i = 0; i < num_pipelines; ++i)
+    run_coroutine_pipeline(q, loop, data + i);
+  loop.run();
+
+  BOOST_CHECK(loop.get_num_suspended() == 0);
+  for(int i = 0; i < num_pipelines; ++i)
+    BOOST_CHECK(data[i] == 20);
+
+  sycl::free(data, q);
+}
+#endif
+
+#ifdef ACPP_EXT_DEVICE_HEAP
+BOOST_AUTO_TEST_CASE(device_heap) {
+  sycl::queue q;
+  constexpr std::size_t size = 1024;
+  constexpr std::size_t group_size = 64;
+
+  sycl::AdaptiveCpp_device_heap heap{q, 1024 * 1024};
+  auto view = heap.get_view();
+  int* results = sycl::malloc_shared<int>(size, q);
+
+  for(int pass = 0; pass < 2; ++pass) {
+    q.parallel_for(sycl::nd_range<1>{size, group_size},
+                   [=](sycl::nd_item<1> idx) {
+      std::size_t gid = idx.get_global_linear_id();
+      std::size_t count = 1 + gid % 13;
+      int* scratch = static_cast<int*>(
+          pass == 0 ? view.malloc(idx.get_sub_group(), count * sizeof(int))
+                    : view.malloc(count * sizeof(int)));
+      if(!scratch) {
+        results[gid] = -1;
+        return;
+      }
+      for(std::size_t i = 0; i < count; ++i)
+        scratch[i] = static_cast<int>(gid + i);
+      int sum = 0;
+      for(std::size_t i = 0; i < count; ++i)
+        sum += scratch[i];
+      results[gid] = sum;
+      view.free(scratch);
+    }).wait();
+
+    for(std::size_t gid = 0; gid < size; ++gid) {
+      int count = static_cast<int>(1 + gid % 13);
+      BOOST_CHECK_EQUAL(results[gid],
+                        count * static_cast<int>(gid) + count * (count - 1) / 2);
+    }
+  }
+  // The second pass reuses the blocks freed by the first pass
+  std::size_t used_size = heap.get_used_size();
+  BOOST_CHECK_GT(used_size, 0);
+  BOOST_CHECK_LE(used_size, heap.get_size());
+
+  heap.reset();
+  BOOST_CHECK_LT(heap.get_used_size(), used_size);
+
+  q.single_task([=]() {
+    // Larger than the heap
+    results[0] = view.malloc(2 * 1024 * 1024) == nullptr;
+  }).wait();
+  BOOST_CHECK_EQUAL(results[0], 1);
+
+  sycl::free(results, q);
+}
+#endif
+
+#ifdef ACPP_EXT_DEVICE_LAUNCH_QUEUE
+BOOST_AUTO_TEST_CASE(device_launch_queue) {
+  sycl::queue q{sycl::property::queue::in_order{}};
+  constexpr std::size_t num_cells = 256;
+  constexpr std::size_t capacity = 50;
+
+  struct cell_info {
+    std::size_t cell;
+  };
+  sycl::AdaptiveCpp_device_launch_queue<cell_info> launch_queue{q, capacity};
+  auto view = launch_queue.get_view();
+  int* results = sycl::malloc_shared<int>(num_cells * num_cells, q);
+  q.memset(results, 0, num_cells * num_cells * sizeof(int));
+
+  // Every third cell except cell 0 requests as many work items as its index
+  q.parallel_for(sycl::range<1>{num_cells}, [=](sycl::id<1> idx) {
+    if(idx[0] % 3 == 0)
+      view.enqueue(idx[0], cell_info{idx[0]});
+  });
+  const std::size_t num_requests = (num_cells - 1) / 3;
+  BOOST_CHECK_EQUAL(launch_queue.get_num_requested_launches(), num_requests);
+
+  launch_queue.dispatch(
+      [=](sycl::id<1> idx, const cell_info &info) {
+        results[info.cell * num_cells + idx[0]] += 1;
+      },
+      64, 3);
+  q.wait();
+
+  // Launches beyond the capacity are dropped, so it is not known which
+  // cells are executed.
+  std::size_t num_dispatched_cells = 0;
+  for(std::size_t cell = 0; cell < num_cells; ++cell) {
+    int num_executed = 0;
+    for(std::size_t i = 0; i < num_cells; ++i) {
+      int result = results[cell * num_cells + i];
+      BOOST_CHECK(result == 0 || result == 1);
+      if(i >= cell || cell % 3 != 0)
+        BOOST_CHECK_EQUAL(result, 0);
+      num_executed += result;
+    }
+    if(num_executed > 0) {
+      BOOST_CHECK_EQUAL(num_executed, static_cast<int>(cell));
+      ++num_dispatched_cells;
+    }
+  }
+  BOOST_CHECK_EQUAL(num_dispatched_cells, capacity);
+  BOOST_CHECK_EQUAL(launch_queue.get_num_requested_launches(), 0);
+
+  sycl::free(results, q);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -54,6 +54,47 @@ BOOST_AUTO_TEST_CASE(half_arithmetic) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(half_vector_arithmetic) {
+  namespace s = cl::sycl;
+
+  s::queue q;
+  s::vec<s::half, 3> v1{1.0f, 2.0f, 3.0f};
+  s::vec<s::half, 3> v2{0.5f, 4.0f, -2.0f};
+  s::marray<s::half, 3> m1{1.0f, 2.0f, 3.0f};
+  s::marray<s::half, 3> m2{0.5f, 4.0f, -2.0f};
+
+  constexpr std::size_t num_tests = 6;
+  s::buffer<s::vec<s::half, 3>, 1> buff{s::range{num_tests}};
+  q.submit([&](s::handler& cgh){
+    s::accessor acc{buff, cgh};
+    cgh.single_task([=](){
+      acc[0] = v1 + v2;
+      acc[1] = v1 - v2;
+      acc[2] = v1 * v2;
+      auto madd = m1 + m2;
+      auto msub = m1 - m2;
+      auto mmul = m1 * m2;
+      for(int i = 0; i < 3; ++i) {
+        acc[3][i] = madd[i];
+        acc[4][i] = msub[i];
+        acc[5][i] = mmul[i];
+      }
+    });
+  }).wait();
+
+  float f1[] = {1.0f, 2.0f, 3.0f};
+  float f2[] = {0.5f, 4.0f, -2.0f};
+
+  s::host_accessor hacc{buff};
+  for(int offset = 0; offset < 6; offset += 3) {
+    for(int i = 0; i < 3; ++i) {
+      BOOST_CHECK(static_cast<float>(hacc[offset][i]) == f1[i] + f2[i]);
+      BOOST_CHECK(static_cast<float>(hacc[offset + 1][i]) == f1[i] - f2[i]);
+      BOOST_CHECK(static_cast<float>(hacc[offset + 2][i]) == f1[i] * f2[i]);
+    }
+  }
+}
+
 using half_test_types =
   boost::mpl::list<float, double,
                    int, unsigned int,
@@ -86,6 +86,123 @@ BOOST_AUTO_TEST_CASE(basic_parallel_for_nd) {
   }
 }
 
+BOOST_AUTO_TEST_CASE(stream_output) {
+  constexpr size_t num_threads = 4;
+  cl::sycl::queue queue;
+  cl::sycl::buffer<int, 1> buf{cl::sycl::range<1>(num_threads)};
+  queue.submit([&](cl::sycl::handler& cgh) {
+    cl::sycl::stream out{1024, 256, cgh};
+    BOOST_CHECK(out.get_size() == 1024);
+    BOOST_CHECK(out.get_work_item_buffer_size() == 256);
+
+    auto acc = buf.get_access<cl::sycl::access::mode::discard_write>(cgh);
+    cgh.parallel_for<class stream_output>(cl::sycl::range<1>{num_threads},
+      [=](cl::sycl::id<1> tid) {
+        out << "stream_output: " << tid << " " << -1 << " " << 0.5f
+            << cl::sycl::endl;
+        acc[tid] = static_cast<int>(tid[0]);
+      });
+  });
+  // Output exceeding the buffer size is dropped
+  queue.submit([&](cl::sycl::handler& cgh) {
+    cl::sycl::stream out{8, 8, cgh};
+    cgh.single_task<class stream_output_truncated>([=]() {
+      out << "stream_output: truncated" << cl::sycl::endl;
+    });
+  });
+  queue.wait();
+
+  auto acc = buf.get_access<cl::sycl::access::mode::read>();
+  for(int i = 0; i < num_threads; ++i) {
+    BOOST_REQUIRE(acc[i] == i);
+  }
+}
+
+constexpr cl::sycl::specialization_id<int> factor_id{2};
+constexpr cl::sycl::specialization_id<float> unset_id{1.5f};
+
+BOOST_AUTO_TEST_CASE(specialization_constants) {
+  constexpr size_t num_threads = 64;
+  cl::sycl::queue queue;
+  cl::sycl::buffer<float, 1> buf{cl::sycl::range<1>(num_threads)};
+  for(int factor : {3, 4}) {
+    queue.submit([&](cl::sycl::handler& cgh) {
+      BOOST_CHECK(cgh.get_specialization_constant<factor_id>() == 2);
+      cgh.set_specialization_constant<factor_id>(factor);
+      BOOST_CHECK(cgh.get_specialization_constant<factor_id>() == factor);
+
+      auto acc = buf.get_access<cl::sycl::access::mode::discard_write>(cgh);
+      cgh.parallel_for<class specialization_constants>(
+        cl::sycl::range<1>(num_threads),
+        [=](cl::sycl::item<1> tid, cl::sycl::kernel_handler kh) {
+          acc[tid] = kh.get_specialization_constant<factor_id>() * tid[0] +
+                     kh.get_specialization_constant<unset_id>();
+        });
+    });
+    auto acc = buf.get_access<cl::sycl::access::mode::read>();
+    for(int i = 0; i < num_threads; ++i) {
+      BOOST_REQUIRE(acc[i] == factor * i + 1.5f);
+    }
+  }
+
+  int result = 0;
+  {
+    cl::sycl::buffer<int, 1> result_buf{&result, cl::sycl::range<1>(1)};
+    queue.submit([&](cl::sycl::handler& cgh) {
+      auto acc = result_buf.get_access<cl::sycl::access::mode::write>(cgh);
+      cgh.single_task<class specialization_constants_default>(
+        [=](cl::sycl::kernel_handler kh) {
+          acc[0] = kh.get_specialization_constant<factor_id>();
+        });
+    });
+  }
+  BOOST_TEST(result == 2);
+}
+
+BOOST_AUTO_TEST_CASE(async_work_group_copy) {
+  constexpr size_t num_threads = 128;
+  constexpr size_t group_size = 16;
+  constexpr size_t stride = 2;
+  cl::sycl::queue queue;
+  std::vector<int> input(num_threads * stride);
+  for(size_t i = 0; i < input.size(); ++i)
+    input[i] = static_cast<int>(i);
+
+  cl::sycl::buffer<int, 1> in_buf{input.data(), cl::sycl::range<1>(input.size())};
+  cl::sycl::buffer<int, 1> out_buf{cl::sycl::range<1>(2 * num_threads)};
+  queue.submit([&](cl::sycl::handler& cgh) {
+    auto in = in_buf.get_access<cl::sycl::access::mode::read>(cgh);
+    auto out = out_buf.get_access<cl::sycl::access::mode::discard_write>(cgh);
+    cl::sycl::local_accessor<int> contiguous{cl::sycl::range<1>(group_size), cgh};
+    cl::sycl::local_accessor<int> strided{cl::sycl::range<1>(group_size), cgh};
+    cl::sycl::nd_range<1> kernel_range{cl::sycl::range<1>(num_threads),
+      cl::sycl::range<1>(group_size)};
+    cgh.parallel_for<class async_work_group_copy_kernel>(kernel_range,
+      [=](cl::sycl::nd_item<1> tid) {
+        const size_t group_offset = tid.get_group(0) * group_size;
+        cl::sycl::global_ptr<int> src = in.get_pointer();
+        auto e0 = tid.async_work_group_copy(contiguous.get_pointer(),
+                                            src + group_offset, group_size);
+        auto e1 = tid.async_work_group_copy(strided.get_pointer(),
+                                            src + stride * group_offset,
+                                            group_size, stride);
+        tid.wait_for(e0, e1);
+
+        const size_t lid = tid.get_local_id(0);
+        const size_t rev = group_size - 1 - lid;
+        out[2 * tid.get_global_id(0)] = contiguous[rev];
+        out[2 * tid.get_global_id(0) + 1] = strided[rev];
+      });
+  });
+  auto out = out_buf.get_access<cl::sycl::access::mode::read>();
+  for(size_t i = 0; i < num_threads; ++i) {
+    const size_t group_offset = (i / group_size) * group_size;
+    const size_t rev = group_offset + group_size - 1 - i % group_size;
+    BOOST_REQUIRE(out[2 * i] == input[rev]);
+    BOOST_REQUIRE(out[2 * i + 1] == input[stride * rev]);
+  }
+}
+
 #if !defined(__ACPP_ENABLE_LLVM_SSCP_TARGET__)
 BOOST_AUTO_TEST_CASE(hierarchical_dispatch) {
   constexpr size_t local_size = 256;
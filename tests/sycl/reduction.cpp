@@ -11,6 +11,7 @@
 
 #include <numeric>
 #include <algorithm>
+#include <limits>
 #include <type_traits>
 
 #include "hipSYCL/sycl/libkernel/reduction.hpp"
@@ -377,4 +378,127 @@ const int size = 1024;
   sycl::free(result, q);
 }
 
+BOOST_AUTO_TEST_CASE(mixed_type_reductions) {
+  // Reductions of different types and operators, which are reduced
+  // together within each work group.
+  const std::size_t size = 64 * 64 * 64;
+  const std::size_t local_size = 64;
+  sycl::queue q;
+  int* data = sycl::malloc_shared<int>(size, q);
+  for(std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<int>((i * 7919) % 10007) - 5000;
+
+  long long* sum = sycl::malloc_shared<long long>(1, q);
+  int* min = sycl::malloc_shared<int>(1, q);
+  double* max = sycl::malloc_shared<double>(1, q);
+  *sum = 0;
+  *min = std::numeric_limits<int>::max();
+  *max = std::numeric_limits<double>::lowest();
+
+  q.parallel_for(sycl::nd_range<1>{size, local_size},
+                 sycl::reduction(sum, sycl::plus<long long>{}),
+                 sycl::reduction(min, sycl::minimum<int>{}),
+                 sycl::reduction(max, sycl::maximum<double>{}),
+                 [=](sycl::nd_item<1> idx, auto &sum_reducer,
+                     auto &min_reducer, auto &max_reducer) {
+                   int x = data[idx.get_global_linear_id()];
+                   sum_reducer += x;
+                   min_reducer.combine(x);
+                   max_reducer.combine(static_cast<double>(x));
+                 }).wait();
+
+  BOOST_CHECK(*sum == std::accumulate(data, data + size, 0ll));
+  BOOST_CHECK(*min == *std::min_element(data, data + size));
+  BOOST_CHECK(*max == static_cast<double>(*std::max_element(data, data + size)));
+
+  sycl::free(data, q);
+  sycl::free(sum, q);
+  sycl::free(min, q);
+  sycl::free(max, q);
+}
+
+BOOST_AUTO_TEST_CASE(span_reduction) {
+  constexpr std::size_t num_bins = 8;
+  const std::size_t size = 128 * 128 + 17;
+  sycl::queue q;
+  int* data = sycl::malloc_shared<int>(size, q);
+  for(std::size_t i = 0; i < size; ++i)
+    data[i] = static_cast<int>((i * 7919) % 1009);
+
+  int expected_histogram[num_bins] = {};
+  int expected_max[num_bins];
+  for(std::size_t i = 0; i < num_bins; ++i)
+    expected_max[i] = -1;
+  for(std::size_t i = 0; i < size; ++i) {
+    ++expected_histogram[data[i] % num_bins];
+    expected_max[i % num_bins] = std::max(expected_max[i % num_bins], data[i]);
+  }
+
+  int* histogram = sycl::malloc_shared<int>(num_bins, q);
+  int* max = sycl::malloc_shared<int>(num_bins, q);
+  auto verify = [&]() {
+    for(std::size_t i = 0; i < num_bins; ++i) {
+      BOOST_CHECK(histogram[i] == expected_histogram[i]);
+      BOOST_CHECK(max[i] == expected_max[i]);
+    }
+  };
+
+  for(std::size_t i = 0; i < num_bins; ++i) {
+    histogram[i] = 0;
+    max[i] = -1;
+  }
+  q.parallel_for(sycl::range<1>{size},
+                 sycl::reduction(sycl::span<int, num_bins>{histogram, num_bins},
+                                 sycl::plus<int>{}),
+                 sycl::reduction(sycl::span<int, num_bins>{max, num_bins},
+                                 sycl::maximum<int>{}),
+                 [=](sycl::id<1> idx, auto &histogram_reducer,
+                     auto &max_reducer) {
+                   static_assert(
+                       std::decay_t<decltype(histogram_reducer)>::dimensions ==
+                       1);
+                   int x = data[idx[0]];
+                   histogram_reducer[x % num_bins] += 1;
+                   max_reducer[idx[0] % num_bins].combine(x);
+                 }).wait();
+  verify();
+
+  for(std::size_t i = 0; i < num_bins; ++i) {
+    histogram[i] = 1;
+    max[i] = 0;
+  }
+  const std::size_t local_size = 128;
+  const std::size_t nd_size = size - size % local_size;
+  for(std::size_t i = nd_size; i < size; ++i) {
+    --expected_histogram[data[i] % num_bins];
+  }
+  for(std::size_t i = 0; i < num_bins; ++i) {
+    expected_max[i] = -1;
+  }
+  for(std::size_t i = 0; i < nd_size; ++i)
+    expected_max[i % num_bins] = std::max(expected_max[i % num_bins], data[i]);
+
+  q.parallel_for(sycl::nd_range<1>{nd_size, local_size},
+                 sycl::reduction(sycl::span<int, num_bins>{histogram, num_bins},
+                                 sycl::plus<int>{},
+                                 sycl::property_list{sycl::property::reduction::
+                                                         initialize_to_identity{}}),
+                 sycl::reduction(sycl::span<int, num_bins>{max, num_bins}, -1,
+                                 sycl::maximum<int>{},
+                                 sycl::property_list{sycl::property::reduction::
+                                                         initialize_to_identity{}}),
+                 [=](sycl::nd_item<1> idx, auto &histogram_reducer,
+                     auto &max_reducer) {
+                   std::size_t i = idx.get_global_linear_id();
+                   int x = data[i];
+                   ++histogram_reducer[x % num_bins];
+                   max_reducer[i % num_bins].combine(x);
+                 }).wait();
+  verify();
+
+  sycl::free(data, q);
+  sycl::free(histogram, q);
+  sycl::free(max, q);
+}
+
 BOOST_AUTO_TEST_SUITE_END()